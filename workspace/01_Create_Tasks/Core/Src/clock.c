@@ -0,0 +1,493 @@
+/*******************************************************************************
+ *
+ * @file	clock.c
+ * @brief	System clock profiles for the NUCLEO-F446RE, switchable at run
+ * 			time.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	The HSE profiles use the 8 MHz MCO of the on-board ST-LINK in
+ * 			bypass mode (HSE_VALUE). If it does not start, the switch fails
+ * 			and the previous profile is restored.
+ *
+ * 			After a switch SystemCoreClock (and so configCPU_CLOCK_HZ), the
+ * 			HAL time base (TIM1, via HAL_InitTick()), the FreeRTOS tick
+ * 			(SysTick) and the baud rate of every enabled USART are correct
+ * 			for the new clock: a driver that knows the baud rate recomputes
+ * 			the divider in clock_uart_retune(), and the others' dividers are
+ * 			scaled. Other peripherals with their own prescalers
+ * 			can be adjusted in clock_profile_changed_callback().
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clock.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define CLOCK_PLLR				2U
+#define CLOCK_UART_DRAIN_TIMEOUT	100000U	/* Busy-wait iterations (> 1 ms). */
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulHseState;		/* RCC_HSE_OFF or RCC_HSE_BYPASS. */
+	uint32_t ulPllSource;
+	uint32_t ulPllM;
+	uint32_t ulPllN;
+	uint32_t ulPllP;
+	uint32_t ulPllQ;
+	uint32_t ulVoltageScale;
+	uint32_t ulOverDrive;
+	uint32_t ulFlashLatency;	/* At 3.3 V: one wait state per 30 MHz. */
+	uint32_t ulApb1Divider;		/* APB1 45 MHz max. */
+	uint32_t ulApb2Divider;		/* APB2 90 MHz max. */
+} ClockProfileConfig_t;
+
+typedef struct
+{
+	USART_TypeDef *pxInstance;
+	uint8_t ucOnApb2;
+} ClockUart_t;
+
+/* Variables -----------------------------------------------------------------*/
+static const ClockProfileConfig_t xProfiles[CLOCK_PROFILE_COUNT] =
+{
+	/* 16 MHz / 16 * 336 / 4 = 84 MHz. APB1 42 MHz, APB2 84 MHz. */
+	[CLOCK_PROFILE_LOW_POWER] =
+	{
+		RCC_HSE_OFF, RCC_PLLSOURCE_HSI, 16U, 336U, RCC_PLLP_DIV4, 2U,
+		PWR_REGULATOR_VOLTAGE_SCALE3, 0U, FLASH_LATENCY_2,
+		RCC_HCLK_DIV2, RCC_HCLK_DIV1
+	},
+	/* 8 MHz / 4 * 168 / 2 = 168 MHz, the most without over-drive. APB1
+	 * 42 MHz, APB2 84 MHz. */
+	[CLOCK_PROFILE_BALANCED] =
+	{
+		RCC_HSE_BYPASS, RCC_PLLSOURCE_HSE, 4U, 168U, RCC_PLLP_DIV2, 7U,
+		PWR_REGULATOR_VOLTAGE_SCALE1, 0U, FLASH_LATENCY_5,
+		RCC_HCLK_DIV4, RCC_HCLK_DIV2
+	},
+	/* 8 MHz / 4 * 180 / 2 = 180 MHz. APB1 45 MHz, APB2 90 MHz. */
+	[CLOCK_PROFILE_MAX_PERFORMANCE] =
+	{
+		RCC_HSE_BYPASS, RCC_PLLSOURCE_HSE, 4U, 180U, RCC_PLLP_DIV2, 8U,
+		PWR_REGULATOR_VOLTAGE_SCALE1, 1U, FLASH_LATENCY_5,
+		RCC_HCLK_DIV4, RCC_HCLK_DIV2
+	},
+};
+
+static const ClockUart_t xUarts[] =
+{
+	{ USART1, 1U },
+	{ USART2, 0U },
+	{ USART3, 0U },
+	{ UART4, 0U },
+	{ UART5, 0U },
+	{ USART6, 1U },
+};
+
+/* CLOCK_PROFILE_COUNT until the first profile has been applied. */
+static ClockProfile_t eCurrentProfile = CLOCK_PROFILE_COUNT;
+
+/* Private function prototypes -----------------------------------------------*/
+static int32_t clock_apply(const ClockProfileConfig_t *pxProfile);
+static void clock_uarts_drain(void);
+static void clock_uarts_rescale(uint32_t ulOldPclk1, uint32_t ulOldPclk2);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Switches the system clock to a profile.
+ * @param eProfile Profile to apply.
+ * @retval 0 if successful, -1 otherwise (the previous profile, or the
+ * low-power one at startup, is then in effect).
+ * @note Called by SystemClock_Config() at startup and from any task at run
+ * time. The scheduler is suspended during the switch; interrupts keep running,
+ * as the HAL oscillator timeouts rely on the TIM1 time base.
+ */
+int32_t clock_set_profile(ClockProfile_t eProfile)
+{
+	ClockProfile_t ePrevious = eCurrentProfile;
+	ClockProfile_t eFallback;
+	uint32_t ulOldPclk1;
+	uint32_t ulOldPclk2;
+	BaseType_t xSchedulerRunning;
+	int32_t lResult;
+
+	if (eProfile >= CLOCK_PROFILE_COUNT)
+	{
+		return -1;
+	}
+
+	if (eProfile == ePrevious)
+	{
+		return 0;
+	}
+
+	xSchedulerRunning = (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING);
+
+	if (xSchedulerRunning)
+	{
+		vTaskSuspendAll();
+	}
+
+	/* Let the byte being sent go out at the old baud rate. */
+	clock_uarts_drain();
+
+	ulOldPclk1 = HAL_RCC_GetPCLK1Freq();
+	ulOldPclk2 = HAL_RCC_GetPCLK2Freq();
+
+	lResult = clock_apply(&xProfiles[eProfile]);
+
+	if (lResult == 0)
+	{
+		eCurrentProfile = eProfile;
+	}
+	else
+	{
+		/* Most likely the HSE did not start. The HSI profile cannot fail. */
+		eFallback = (ePrevious < CLOCK_PROFILE_COUNT) ? ePrevious : CLOCK_PROFILE_LOW_POWER;
+
+		if (clock_apply(&xProfiles[eFallback]) != 0)
+		{
+			eFallback = CLOCK_PROFILE_LOW_POWER;
+			(void)clock_apply(&xProfiles[eFallback]);
+		}
+
+		eCurrentProfile = eFallback;
+	}
+
+	clock_uarts_rescale(ulOldPclk1, ulOldPclk2);
+
+	if (xSchedulerRunning)
+	{
+		/* Same reload as vPortSetupTimerInterrupt(), for the new core clock. */
+#if (configUSE_DYNAMIC_TICK_RATE == 1)
+		SysTick->LOAD = ((configCPU_CLOCK_HZ / configTICK_RATE_HZ)
+				* (configTICK_RATE_HZ / ulPortGetTickRate())) - 1U;
+#else
+		SysTick->LOAD = (configCPU_CLOCK_HZ / configTICK_RATE_HZ) - 1U;
+#endif
+		SysTick->VAL = 0U;
+
+		(void)xTaskResumeAll();
+	}
+
+	if (eCurrentProfile != ePrevious)
+	{
+		clock_profile_changed_callback(eCurrentProfile);
+	}
+
+	return lResult;
+}
+
+/**
+ * @brief Returns the profile in effect.
+ * @param None
+ * @retval The current profile, CLOCK_PROFILE_COUNT before the first one.
+ */
+ClockProfile_t clock_get_profile(void)
+{
+	return eCurrentProfile;
+}
+
+/**
+ * @brief Returns the system clock of a profile, applied or not.
+ * @param eProfile Profile.
+ * @retval SYSCLK of the profile in Hz, 0 for an invalid profile.
+ * @note RCC_PLLP_DIVx are the divisors themselves.
+ */
+uint32_t clock_get_profile_hz(ClockProfile_t eProfile)
+{
+	const ClockProfileConfig_t *pxProfile;
+	uint32_t ulInputHz;
+
+	if (eProfile >= CLOCK_PROFILE_COUNT)
+	{
+		return 0U;
+	}
+
+	pxProfile = &xProfiles[eProfile];
+	ulInputHz = (pxProfile->ulPllSource == RCC_PLLSOURCE_HSE) ? HSE_VALUE : HSI_VALUE;
+
+	return (ulInputHz / pxProfile->ulPllM) * pxProfile->ulPllN / pxProfile->ulPllP;
+}
+
+/**
+ * @brief Restores the current profile after STOP mode.
+ * @param None
+ * @retval None
+ * @note STOP mode exit leaves the HSI as system clock with the HSE, the PLL
+ * and the over-drive off. Their configuration is retained, so only the enable
+ * bits and the clock switch are needed. Register access only, as it runs with
+ * interrupts disabled from the tickless idle code.
+ */
+void clock_resume_from_stop(void)
+{
+	const ClockProfileConfig_t *pxProfile;
+
+	if ((RCC->CFGR & RCC_CFGR_SWS) == RCC_CFGR_SWS_PLL)
+	{
+		/* Woken before STOP mode was entered. */
+		return;
+	}
+
+	pxProfile = &xProfiles[(eCurrentProfile < CLOCK_PROFILE_COUNT) ?
+			eCurrentProfile : CLOCK_PROFILE_LOW_POWER];
+
+	if (pxProfile->ulHseState != RCC_HSE_OFF)
+	{
+		/* HSEBYP is retained. */
+		RCC->CR |= RCC_CR_HSEON;
+
+		while (!(RCC->CR & RCC_CR_HSERDY))
+		{
+			/* Wait for the HSE. */
+		}
+	}
+
+	RCC->CR |= RCC_CR_PLLON;
+
+	while (!(RCC->CR & RCC_CR_PLLRDY))
+	{
+		/* Wait for the PLL to lock. */
+	}
+
+	if (pxProfile->ulOverDrive && !(PWR->CSR & PWR_CSR_ODSWRDY))
+	{
+		PWR->CR |= PWR_CR_ODEN;
+
+		while (!(PWR->CSR & PWR_CSR_ODRDY))
+		{
+			/* Wait for the regulator. */
+		}
+
+		PWR->CR |= PWR_CR_ODSWEN;
+
+		while (!(PWR->CSR & PWR_CSR_ODSWRDY))
+		{
+			/* Wait for the switch to over-drive. */
+		}
+	}
+
+	RCC->CFGR = (RCC->CFGR & ~RCC_CFGR_SW) | RCC_CFGR_SW_PLL;
+
+	while ((RCC->CFGR & RCC_CFGR_SWS) != RCC_CFGR_SWS_PLL)
+	{
+		/* Wait for the switch. */
+	}
+}
+
+/**
+ * @brief Called after the profile has changed, with the scheduler running
+ * again.
+ * @param eProfile The new profile.
+ * @retval None
+ * @note Weak; override it to adjust peripherals with their own prescalers
+ * (e.g. ADCPRE, to keep the ADC clock within 36 MHz).
+ */
+__weak void clock_profile_changed_callback(ClockProfile_t eProfile)
+{
+	(void)eProfile;
+}
+
+/**
+ * @brief Lets a UART driver set the divider of its USART for the new clock.
+ * @param pxUart Enabled USART whose APB clock changed.
+ * @retval 0 if the divider was set, -1 to have it scaled instead.
+ * @note Weak; a driver that knows its baud rate overrides it (uart.c), since
+ * a divider computed from the rate is exact where a scaled one is rounded
+ * twice. Called before the scheduler resumes, with the transmitters drained.
+ */
+__weak int32_t clock_uart_retune(USART_TypeDef *pxUart)
+{
+	(void)pxUart;
+
+	return -1;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Applies a profile.
+ * @param pxProfile Profile to apply.
+ * @retval 0 if successful, -1 otherwise (running from the HSI then).
+ */
+static int32_t clock_apply(const ClockProfileConfig_t *pxProfile)
+{
+	RCC_OscInitTypeDef RCC_OscInitStruct =
+	{ 0 };
+	RCC_ClkInitTypeDef RCC_ClkInitStruct =
+	{ 0 };
+
+	__HAL_RCC_PWR_CLK_ENABLE();
+
+	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
+			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+
+	/* Run from the HSI while the PLL is reprogrammed. The wait states are
+	 * kept; HAL_RCC_ClockConfig() lowers them after the switch to the PLL. */
+	if (__HAL_RCC_GET_SYSCLK_SOURCE() != RCC_SYSCLKSOURCE_STATUS_HSI)
+	{
+		RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
+		RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+		RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV1;
+		RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+
+		if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, __HAL_FLASH_GET_LATENCY()) != HAL_OK)
+		{
+			return -1;
+		}
+	}
+
+	/* Over-drive can only be left with the system clock off the PLL. */
+	if (__HAL_PWR_GET_FLAG(PWR_FLAG_ODRDY))
+	{
+		if (HAL_PWREx_DisableOverDrive() != HAL_OK)
+		{
+			return -1;
+		}
+	}
+
+	/* The regulator scale can only be changed with the PLL off. */
+	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_OFF;
+
+	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+	{
+		return -1;
+	}
+
+	__HAL_PWR_VOLTAGESCALING_CONFIG(pxProfile->ulVoltageScale);
+
+	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI | RCC_OSCILLATORTYPE_HSE;
+	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
+	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+	RCC_OscInitStruct.HSEState = pxProfile->ulHseState;
+	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+	RCC_OscInitStruct.PLL.PLLSource = pxProfile->ulPllSource;
+	RCC_OscInitStruct.PLL.PLLM = pxProfile->ulPllM;
+	RCC_OscInitStruct.PLL.PLLN = pxProfile->ulPllN;
+	RCC_OscInitStruct.PLL.PLLP = pxProfile->ulPllP;
+	RCC_OscInitStruct.PLL.PLLQ = pxProfile->ulPllQ;
+	RCC_OscInitStruct.PLL.PLLR = CLOCK_PLLR;
+
+	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+	{
+		return -1;
+	}
+
+	/* Over-drive is entered with the PLL locked but not yet selected. */
+	if (pxProfile->ulOverDrive)
+	{
+		if (HAL_PWREx_EnableOverDrive() != HAL_OK)
+		{
+			return -1;
+		}
+	}
+
+	/* Raises the wait states before the switch, updates SystemCoreClock and
+	 * calls HAL_InitTick() for the new TIM1 clock. */
+	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+	RCC_ClkInitStruct.APB1CLKDivider = pxProfile->ulApb1Divider;
+	RCC_ClkInitStruct.APB2CLKDivider = pxProfile->ulApb2Divider;
+
+	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, pxProfile->ulFlashLatency) != HAL_OK)
+	{
+		return -1;
+	}
+
+	/* ART accelerator. HAL_Init() already enables it (stm32f4xx_hal_conf.h);
+	 * with 5 wait states it is what keeps code from flash near zero wait. */
+	__HAL_FLASH_PREFETCH_BUFFER_ENABLE();
+	__HAL_FLASH_INSTRUCTION_CACHE_ENABLE();
+	__HAL_FLASH_DATA_CACHE_ENABLE();
+
+	return 0;
+}
+
+/**
+ * @brief Waits for every enabled transmitter to finish its current frame.
+ * @param None
+ * @retval None
+ * @note A DMA transfer is not stopped, so a few characters of one running over
+ * the switch can still come out at the wrong rate.
+ */
+static void clock_uarts_drain(void)
+{
+	uint32_t ulTimeout;
+	uint32_t x;
+
+	for (x = 0; x < (sizeof(xUarts) / sizeof(xUarts[0])); x++)
+	{
+		if ((xUarts[x].pxInstance->CR1 & (USART_CR1_UE | USART_CR1_TE))
+				!= (USART_CR1_UE | USART_CR1_TE))
+		{
+			continue;
+		}
+
+		ulTimeout = CLOCK_UART_DRAIN_TIMEOUT;
+
+		while (!(xUarts[x].pxInstance->SR & USART_SR_TC) && (ulTimeout > 0U))
+		{
+			ulTimeout--;
+		}
+	}
+}
+
+/**
+ * @brief Scales the baud rate divider of every enabled USART to its new
+ * APB clock.
+ * @param ulOldPclk1 APB1 clock before the switch, in Hz.
+ * @param ulOldPclk2 APB2 clock before the switch, in Hz.
+ * @retval None
+ * @note Scaling the divider (rather than deriving the baud rate back from it)
+ * keeps it stable over repeated switches.
+ */
+static void clock_uarts_rescale(uint32_t ulOldPclk1, uint32_t ulOldPclk2)
+{
+	USART_TypeDef *pxUart;
+	uint32_t ulOldPclk;
+	uint32_t ulNewPclk;
+	uint32_t ulDiv;
+	uint32_t x;
+
+	for (x = 0; x < (sizeof(xUarts) / sizeof(xUarts[0])); x++)
+	{
+		pxUart = xUarts[x].pxInstance;
+
+		if (!(pxUart->CR1 & USART_CR1_UE))
+		{
+			continue;
+		}
+
+		ulOldPclk = xUarts[x].ucOnApb2 ? ulOldPclk2 : ulOldPclk1;
+		ulNewPclk = xUarts[x].ucOnApb2 ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+
+		if ((ulNewPclk == ulOldPclk) || (clock_uart_retune(pxUart) == 0))
+		{
+			continue;
+		}
+
+		/* USARTDIV in 1/16 (or 1/8 with OVER8) units. With OVER8, BRR[2:0] is
+		 * the fraction and BRR[3] must be kept clear. */
+		ulDiv = pxUart->BRR;
+
+		if (pxUart->CR1 & USART_CR1_OVER8)
+		{
+			ulDiv = ((ulDiv >> 4) << 3) | (ulDiv & 0x7U);
+		}
+
+		ulDiv = (uint32_t)((((uint64_t)ulDiv * ulNewPclk) + (ulOldPclk / 2U)) / ulOldPclk);
+
+		if (pxUart->CR1 & USART_CR1_OVER8)
+		{
+			ulDiv = ((ulDiv >> 3) << 4) | (ulDiv & 0x7U);
+		}
+
+		pxUart->BRR = ulDiv;
+	}
+}
@@ -32,6 +32,16 @@
  * This file implements atomic functions by disabling interrupts globally.
  * Implementations with architecture specific atomic instructions can be
  * provided under each compiler directory.
+ *
+ * With configUSE_ATOMIC_EXCLUSIVE_ACCESS set to 1, on ports that provide
+ * exclusive access (portLOAD_EXCLUSIVE() and portSTORE_EXCLUSIVE()), each
+ * operation is a load exclusive / store exclusive loop instead: interrupts stay
+ * enabled, and the operations may be used from interrupts above
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY.  Exception entry and return clear the
+ * exclusive monitor, so the store fails, and the loop retries, whenever another
+ * context may have written the location since the load.  A data memory barrier
+ * on either side orders the operation with the surrounding accesses, as the
+ * critical section does.
  */
 
 #ifndef ATOMIC_H
@@ -84,6 +94,26 @@ extern "C" {
 	#define portFORCE_INLINE
 #endif
 
+#if ( configUSE_ATOMIC_EXCLUSIVE_ACCESS == 1 )
+
+	#ifndef portDATA_MEMORY_BARRIER
+		#define portDATA_MEMORY_BARRIER()	portMEMORY_BARRIER()
+	#endif
+
+	/* Replaces *pulAddress with xNewValue, an expression of ulCurrent, which is
+	loaded with it.  Leaves in ulCurrent the value replaced. */
+	#define atomicREAD_MODIFY_WRITE( pulAddress, ulCurrent, xNewValue )					\
+	{																					\
+		portDATA_MEMORY_BARRIER();														\
+		do																				\
+		{																				\
+			( ulCurrent ) = portLOAD_EXCLUSIVE( ( pulAddress ) );						\
+		} while( portSTORE_EXCLUSIVE( ( pulAddress ), ( xNewValue ) ) != 0U );			\
+		portDATA_MEMORY_BARRIER();														\
+	}
+
+#endif /* configUSE_ATOMIC_EXCLUSIVE_ACCESS */
+
 #define ATOMIC_COMPARE_AND_SWAP_SUCCESS	 0x1U		/**< Compare and swap succeeded, swapped. */
 #define ATOMIC_COMPARE_AND_SWAP_FAILURE	 0x0U		/**< Compare and swap failed, did not swap. */
 
@@ -110,6 +140,24 @@ static portFORCE_INLINE uint32_t Atomic_CompareAndSwap_u32( uint32_t volatile *
 {
 uint32_t ulReturnValue;
 
+#if ( configUSE_ATOMIC_EXCLUSIVE_ACCESS == 1 )
+	portDATA_MEMORY_BARRIER();
+
+	do
+	{
+		if( portLOAD_EXCLUSIVE( pulDestination ) != ulComparand )
+		{
+			/* Nothing to store: release the monitor. */
+			portCLEAR_EXCLUSIVE();
+			ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
+			break;
+		}
+
+		ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+	} while( portSTORE_EXCLUSIVE( pulDestination, ulExchange ) != 0U );
+
+	portDATA_MEMORY_BARRIER();
+#else
 	ATOMIC_ENTER_CRITICAL();
 	{
 		if( *pulDestination == ulComparand )
@@ -123,6 +171,7 @@ uint32_t ulReturnValue;
 		}
 	}
 	ATOMIC_EXIT_CRITICAL();
+#endif /* configUSE_ATOMIC_EXCLUSIVE_ACCESS */
 
 	return ulReturnValue;
 }
@@ -145,12 +194,19 @@ static portFORCE_INLINE void * Atomic_SwapPointers_p32( void * volatile * ppvDes
 {
 void * pReturnValue;
 
+#if ( configUSE_ATOMIC_EXCLUSIVE_ACCESS == 1 )
+uint32_t ulCurrent;
+
+	atomicREAD_MODIFY_WRITE( ( uint32_t volatile * ) ppvDestination, ulCurrent, ( uint32_t ) pvExchange );
+	pReturnValue = ( void * ) ulCurrent;
+#else
 	ATOMIC_ENTER_CRITICAL();
 	{
 		pReturnValue = *ppvDestination;
 		*ppvDestination = pvExchange;
 	}
 	ATOMIC_EXIT_CRITICAL();
+#endif /* configUSE_ATOMIC_EXCLUSIVE_ACCESS */
 
 	return pReturnValue;
 }
@@ -178,6 +234,11 @@ static portFORCE_INLINE uint32_t Atomic_CompareAndSwapPointers_p32( void * volat
 {
 uint32_t ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
 
+#if ( configUSE_ATOMIC_EXCLUSIVE_ACCESS == 1 )
+	ulReturnValue = Atomic_CompareAndSwap_u32( ( uint32_t volatile * ) ppvDestination,
+											   ( uint32_t ) pvExchange,
+											   ( uint32_t ) pvComparand );
+#else
 	ATOMIC_ENTER_CRITICAL();
 	{
 		if( *ppvDestination == pvComparand )
@@ -187,6 +248,7 @@ uint32_t ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
 		}
 	}
 	ATOMIC_EXIT_CRITICAL();
+#endif /* configUSE_ATOMIC_EXCLUSIVE_ACCESS */
 
 	return ulReturnValue;
 }
@@ -210,12 +272,16 @@ static portFORCE_INLINE uint32_t Atomic_Add_u32( uint32_t volatile * pulAddend,
 {
 	uint32_t ulCurrent;
 
+#if ( configUSE_ATOMIC_EXCLUSIVE_ACCESS == 1 )
+	atomicREAD_MODIFY_WRITE( pulAddend, ulCurrent, ulCurrent + ulCount );
+#else
 	ATOMIC_ENTER_CRITICAL();
 	{
 		ulCurrent = *pulAddend;
 		*pulAddend += ulCount;
 	}
 	ATOMIC_EXIT_CRITICAL();
+#endif /* configUSE_ATOMIC_EXCLUSIVE_ACCESS */
 
 	return ulCurrent;
 }
@@ -238,12 +304,16 @@ static portFORCE_INLINE uint32_t Atomic_Subtract_u32( uint32_t volatile * pulAdd
 {
 	uint32_t ulCurrent;
 
+#if ( configUSE_ATOMIC_EXCLUSIVE_ACCESS == 1 )
+	atomicREAD_MODIFY_WRITE( pulAddend, ulCurrent, ulCurrent - ulCount );
+#else
 	ATOMIC_ENTER_CRITICAL();
 	{
 		ulCurrent = *pulAddend;
 		*pulAddend -= ulCount;
 	}
 	ATOMIC_EXIT_CRITICAL();
+#endif /* configUSE_ATOMIC_EXCLUSIVE_ACCESS */
 
 	return ulCurrent;
 }
@@ -263,12 +333,16 @@ static portFORCE_INLINE uint32_t Atomic_Increment_u32( uint32_t volatile * pulAd
 {
 uint32_t ulCurrent;
 
+#if ( configUSE_ATOMIC_EXCLUSIVE_ACCESS == 1 )
+	atomicREAD_MODIFY_WRITE( pulAddend, ulCurrent, ulCurrent + 1U );
+#else
 	ATOMIC_ENTER_CRITICAL();
 	{
 		ulCurrent = *pulAddend;
 		*pulAddend += 1;
 	}
 	ATOMIC_EXIT_CRITICAL();
+#endif /* configUSE_ATOMIC_EXCLUSIVE_ACCESS */
 
 	return ulCurrent;
 }
@@ -288,12 +362,16 @@ static portFORCE_INLINE uint32_t Atomic_Decrement_u32( uint32_t volatile * pulAd
 {
 uint32_t ulCurrent;
 
+#if ( configUSE_ATOMIC_EXCLUSIVE_ACCESS == 1 )
+	atomicREAD_MODIFY_WRITE( pulAddend, ulCurrent, ulCurrent - 1U );
+#else
 	ATOMIC_ENTER_CRITICAL();
 	{
 		ulCurrent = *pulAddend;
 		*pulAddend -= 1;
 	}
 	ATOMIC_EXIT_CRITICAL();
+#endif /* configUSE_ATOMIC_EXCLUSIVE_ACCESS */
 
 	return ulCurrent;
 }
@@ -316,12 +394,16 @@ static portFORCE_INLINE uint32_t Atomic_OR_u32( uint32_t volatile * pulDestinati
 {
 uint32_t ulCurrent;
 
+#if ( configUSE_ATOMIC_EXCLUSIVE_ACCESS == 1 )
+	atomicREAD_MODIFY_WRITE( pulDestination, ulCurrent, ulCurrent | ulValue );
+#else
 	ATOMIC_ENTER_CRITICAL();
 	{
 		ulCurrent = *pulDestination;
 		*pulDestination |= ulValue;
 	}
 	ATOMIC_EXIT_CRITICAL();
+#endif /* configUSE_ATOMIC_EXCLUSIVE_ACCESS */
 
 	return ulCurrent;
 }
@@ -343,12 +425,16 @@ static portFORCE_INLINE uint32_t Atomic_AND_u32( uint32_t volatile * pulDestinat
 {
 uint32_t ulCurrent;
 
+#if ( configUSE_ATOMIC_EXCLUSIVE_ACCESS == 1 )
+	atomicREAD_MODIFY_WRITE( pulDestination, ulCurrent, ulCurrent & ulValue );
+#else
 	ATOMIC_ENTER_CRITICAL();
 	{
 		ulCurrent = *pulDestination;
 		*pulDestination &= ulValue;
 	}
 	ATOMIC_EXIT_CRITICAL();
+#endif /* configUSE_ATOMIC_EXCLUSIVE_ACCESS */
 
 	return ulCurrent;
 }
@@ -370,12 +456,16 @@ static portFORCE_INLINE uint32_t Atomic_NAND_u32( uint32_t volatile * pulDestina
 {
 uint32_t ulCurrent;
 
+#if ( configUSE_ATOMIC_EXCLUSIVE_ACCESS == 1 )
+	atomicREAD_MODIFY_WRITE( pulDestination, ulCurrent, ~( ulCurrent & ulValue ) );
+#else
 	ATOMIC_ENTER_CRITICAL();
 	{
 		ulCurrent = *pulDestination;
 		*pulDestination = ~( ulCurrent & ulValue );
 	}
 	ATOMIC_EXIT_CRITICAL();
+#endif /* configUSE_ATOMIC_EXCLUSIVE_ACCESS */
 
 	return ulCurrent;
 }
@@ -397,12 +487,16 @@ static portFORCE_INLINE uint32_t Atomic_XOR_u32( uint32_t volatile * pulDestinat
 {
 uint32_t ulCurrent;
 
+#if ( configUSE_ATOMIC_EXCLUSIVE_ACCESS == 1 )
+	atomicREAD_MODIFY_WRITE( pulDestination, ulCurrent, ulCurrent ^ ulValue );
+#else
 	ATOMIC_ENTER_CRITICAL();
 	{
 		ulCurrent = *pulDestination;
 		*pulDestination ^= ulValue;
 	}
 	ATOMIC_EXIT_CRITICAL();
+#endif /* configUSE_ATOMIC_EXCLUSIVE_ACCESS */
 
 	return ulCurrent;
 }
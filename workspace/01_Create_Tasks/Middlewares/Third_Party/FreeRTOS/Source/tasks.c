@@ -40,6 +40,10 @@ task.h is included from an application file. */
 #include "timers.h"
 #include "stack_macros.h"
 
+#if( configUSE_TASK_ARENAS == 1 )
+	#include "arena.h"
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
 because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
 for the header files above, but not in this file, in order to generate the
@@ -89,6 +93,14 @@ set then don't fill the stack so there is no unnecessary dependency on memset. *
 	#define tskSET_NEW_STACKS_TO_KNOWN_VALUE	0
 #endif
 
+/* The bytes of a stack guard always keep their known value, and the guard of
+the running task cannot be read: the high water mark is counted from above it. */
+#if( configUSE_MPU_STACK_GUARD == 1 )
+	#define taskSTACK_CHECK_START( pxTCB )	( ( uint8_t * ) portSTACK_GUARD_END( ( pxTCB )->pxStack ) )
+#else
+	#define taskSTACK_CHECK_START( pxTCB )	( ( uint8_t * ) ( pxTCB )->pxStack )
+#endif
+
 /*
  * Macros used by vListTask to indicate which state a task is in.
  */
@@ -143,16 +155,17 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 																										\
 		/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of						\
 		the	same priority get an equal share of the processor time. */									\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );			\
+		taskSELECT_FROM_READY_LIST( uxTopPriority );													\
 		uxTopReadyPriority = uxTopPriority;																\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
 	/*-----------------------------------------------------------*/
 
-	/* Define away taskRESET_READY_PRIORITY() and portRESET_READY_PRIORITY() as
-	they are only required when a port optimised method of task selection is
-	being used. */
+	/* Define away taskRESET_READY_PRIORITY(), taskCLEAR_READY_PRIORITY() and
+	portRESET_READY_PRIORITY() as they are only required when a port optimised
+	method of task selection is being used. */
 	#define taskRESET_READY_PRIORITY( uxPriority )
+	#define taskCLEAR_READY_PRIORITY( uxPriority )
 	#define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )
 
 #else /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
@@ -161,8 +174,59 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	performed in a way that is tailored to the particular microcontroller
 	architecture being used. */
 
-	/* A port optimised version is provided.  Call the port defined macros. */
-	#define taskRECORD_READY_PRIORITY( uxPriority )	portRECORD_READY_PRIORITY( uxPriority, uxTopReadyPriority )
+	/* The width of the words the port macros operate on. */
+	#ifndef portREADY_BITMAP_BITS
+		#define portREADY_BITMAP_BITS 32
+	#endif
+
+	#if( configMAX_PRIORITIES > portREADY_BITMAP_BITS )
+
+		#if( configMAX_PRIORITIES > ( portREADY_BITMAP_BITS * portREADY_BITMAP_BITS ) )
+			#error configMAX_PRIORITIES is too large for a two-level ready priority bitmap.
+		#endif
+
+		/* More priorities than the bits of one word, such as the 56 the
+		CMSIS-RTOS2 osPriority_t values map to, are kept in a two-level
+		bitmap.  Bit n of uxReadyPriorityGroups[ g ] is set while priority
+		( g * portREADY_BITMAP_BITS ) + n has ready tasks, and bit g of
+		uxTopReadyPriority while uxReadyPriorityGroups[ g ] is not zero, so the
+		highest ready priority is still found with the port macro twice,
+		whatever the priorities in use. */
+		#define taskREADY_GROUP( uxPriority )	( ( UBaseType_t ) ( uxPriority ) / ( UBaseType_t ) portREADY_BITMAP_BITS )
+		#define taskREADY_BIT( uxPriority )		( ( UBaseType_t ) ( uxPriority ) % ( UBaseType_t ) portREADY_BITMAP_BITS )
+
+		#define taskRECORD_READY_PRIORITY( uxPriority )																\
+		{																											\
+			portRECORD_READY_PRIORITY( taskREADY_BIT( uxPriority ), uxReadyPriorityGroups[ taskREADY_GROUP( uxPriority ) ] );	\
+			portRECORD_READY_PRIORITY( taskREADY_GROUP( uxPriority ), uxTopReadyPriority );							\
+		}
+
+		#define taskCLEAR_READY_PRIORITY( uxPriority )																\
+		{																											\
+			portRESET_READY_PRIORITY( taskREADY_BIT( uxPriority ), uxReadyPriorityGroups[ taskREADY_GROUP( uxPriority ) ] );	\
+			if( uxReadyPriorityGroups[ taskREADY_GROUP( uxPriority ) ] == ( UBaseType_t ) 0 )						\
+			{																										\
+				portRESET_READY_PRIORITY( taskREADY_GROUP( uxPriority ), uxTopReadyPriority );						\
+			}																										\
+		}
+
+		#define taskGET_HIGHEST_READY_PRIORITY( uxTopPriority )														\
+		{																											\
+		UBaseType_t uxGroup, uxBit;																					\
+																													\
+			portGET_HIGHEST_PRIORITY( uxGroup, uxTopReadyPriority );												\
+			portGET_HIGHEST_PRIORITY( uxBit, uxReadyPriorityGroups[ uxGroup ] );									\
+			( uxTopPriority ) = ( uxGroup * ( UBaseType_t ) portREADY_BITMAP_BITS ) + uxBit;						\
+		}
+
+	#else
+
+		/* A port optimised version is provided.  Call the port defined macros. */
+		#define taskRECORD_READY_PRIORITY( uxPriority )			portRECORD_READY_PRIORITY( uxPriority, uxTopReadyPriority )
+		#define taskCLEAR_READY_PRIORITY( uxPriority )			portRESET_READY_PRIORITY( ( uxPriority ), uxTopReadyPriority )
+		#define taskGET_HIGHEST_READY_PRIORITY( uxTopPriority )	portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority )
+
+	#endif /* configMAX_PRIORITIES > portREADY_BITMAP_BITS */
 
 	/*-----------------------------------------------------------*/
 
@@ -171,9 +235,9 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	UBaseType_t uxTopPriority;																		\
 																									\
 		/* Find the highest priority list that contains ready tasks. */								\
-		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
+		taskGET_HIGHEST_READY_PRIORITY( uxTopPriority );											\
 		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
+		taskSELECT_FROM_READY_LIST( uxTopPriority );												\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 	/*-----------------------------------------------------------*/
@@ -185,7 +249,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	{																									\
 		if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 )	\
 		{																								\
-			portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );							\
+			taskCLEAR_READY_PRIORITY( uxPriority );														\
 		}																								\
 	}
 
@@ -209,16 +273,107 @@ count overflows. */
 	prvResetNextTaskUnblockTime();																	\
 }
 
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+	#if( ( configDELAYED_TASK_WHEEL_SLOTS & ( configDELAYED_TASK_WHEEL_SLOTS - 1 ) ) != 0 )
+		#error configDELAYED_TASK_WHEEL_SLOTS must be a power of two.
+	#endif
+
+	/* The wheel slot that holds the tasks that wake at tick xTime. */
+	#define taskWHEEL_SLOT( xTime )	( &( xDelayedTaskWheel[ ( xTime ) & ( ( TickType_t ) configDELAYED_TASK_WHEEL_SLOTS - ( TickType_t ) 1 ) ] ) )
+
+	/* pdTRUE if pxList is one of the wheel slots, that is, if a task whose
+	state list item is in pxList is delayed. */
+	#define taskIS_WHEEL_SLOT( pxList )	( ( ( pxList ) >= &( xDelayedTaskWheel[ 0 ] ) ) && ( ( pxList ) <= &( xDelayedTaskWheel[ configDELAYED_TASK_WHEEL_SLOTS - 1 ] ) ) )
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	/* A task with a preemption threshold above its priority is only preempted
+	by a task whose priority also exceeds the threshold.  Inheritance may have
+	raised its priority higher still. */
+	#define taskLEVEL_OF( pxTCB )		( ( ( pxTCB )->uxPreemptionThreshold > ( pxTCB )->uxPriority ) ? ( pxTCB )->uxPreemptionThreshold : ( pxTCB )->uxPriority )
+
+#else
+
+	#define taskLEVEL_OF( pxTCB )		( ( pxTCB )->uxPriority )
+
+#endif /* configUSE_PREEMPTION_THRESHOLD */
+
+/* The priority a task made ready must exceed to preempt the running task. */
+#define taskPREEMPTION_LEVEL()			taskLEVEL_OF( pxCurrentTCB )
+
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	/* Wrap-safe deadline order on the tick count. */
+	#define taskEDF_IS_BEFORE( xA, xB )	( ( ( TickType_t ) ( ( xA ) - ( xB ) ) & taskEDF_SIGN_BIT ) != ( TickType_t ) 0 )
+
+	#if( configUSE_16_BIT_TICKS == 1 )
+		#define taskEDF_SIGN_BIT	( ( TickType_t ) 0x8000U )
+	#elif( configUSE_64_BIT_TICKS == 1 )
+		#define taskEDF_SIGN_BIT	( ( TickType_t ) 0x8000000000000000ULL )
+	#else
+		#define taskEDF_SIGN_BIT	( ( TickType_t ) 0x80000000UL )
+	#endif
+
+	/* The ready list of the EDF band is kept in deadline order and is not
+	rotated: the task at its head, the earliest deadline, is the one to run.
+	The other priorities share their processor time round robin. */
+	#define taskSELECT_FROM_READY_LIST( uxPriority )														\
+	{																										\
+		if( ( uxPriority ) == ( UBaseType_t ) configEDF_PRIORITY )											\
+		{																									\
+			pxCurrentTCB = listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_PRIORITY ] ) );	\
+		}																									\
+		else																								\
+		{																									\
+			listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) );			\
+		}																									\
+	}
+
+	#define taskINSERT_INTO_READY_LIST( pxTCB )																\
+	{																										\
+		if( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY )									\
+		{																									\
+			prvEdfInsertReady( pxTCB );																		\
+		}																									\
+		else																								\
+		{																									\
+			vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+		}																									\
+	}
+
+	/* pdTRUE if pxTCB, having just been made ready, should run in place of the
+	running task: a higher priority, or an earlier deadline in the EDF band. */
+	#define taskPREEMPTS_CURRENT( pxTCB )																	\
+		( ( ( pxTCB )->uxPriority > taskPREEMPTION_LEVEL() ) ||												\
+		  ( ( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) &&								\
+			( taskPREEMPTION_LEVEL() == ( UBaseType_t ) configEDF_PRIORITY ) &&								\
+			taskEDF_IS_BEFORE( ( pxTCB )->xEdfDeadline, pxCurrentTCB->xEdfDeadline ) ) )
+
+#else
+
+	#define taskSELECT_FROM_READY_LIST( uxPriority )	listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+	#define taskINSERT_INTO_READY_LIST( pxTCB )			vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) )
+	#define taskPREEMPTS_CURRENT( pxTCB )				( ( pxTCB )->uxPriority > taskPREEMPTION_LEVEL() )
+
+#endif /* configUSE_EDF_SCHEDULING */
+
 /*-----------------------------------------------------------*/
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.  It is inserted at the end of the list, or in deadline order in
+ * the EDF band.
  */
 #define prvAddTaskToReadyList( pxTCB )																\
 	traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
+	taskJOB_RELEASE( pxTCB );																		\
 	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
-	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+	taskINSERT_INTO_READY_LIST( pxTCB );															\
 	tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
 /*-----------------------------------------------------------*/
 
@@ -249,6 +404,140 @@ to its original value when it is released. */
  * and stores task state information, including a pointer to the task's context
  * (the task's run time environment, including register values)
  */
+#if( configUSE_LEAN_TCB == 1 )
+
+typedef struct tskTaskControlBlock 			/* The old naming convention is used to prevent breaking kernel aware debuggers. */
+{
+	/* configUSE_LEAN_TCB: the members the context switch, the tick and the
+	ready lists use come first, the rest follows from the widest type down so
+	no padding is needed, and the bytes are packed together at the end.  The
+	name is a pointer to the string passed at creation, and the trace numbers
+	live in a side table (configLEAN_TCB_DIAGNOSTIC_ENTRIES). */
+	volatile StackType_t	*pxTopOfStack;	/*< Points to the location of the last item placed on the tasks stack.  THIS MUST BE THE FIRST MEMBER OF THE TCB STRUCT. */
+
+	#if ( portUSING_MPU_WRAPPERS == 1 )
+		xMPU_SETTINGS	xMPUSettings;		/*< The MPU settings are defined as part of the port layer.  THIS MUST BE THE SECOND MEMBER OF THE TCB STRUCT. */
+	#endif
+
+	ListItem_t			xStateListItem;	/*< The list that the state list item of a task is reference from denotes the state of that task (Ready, Blocked, Suspended ). */
+	ListItem_t			xEventListItem;		/*< Used to reference a task from an event list. */
+	#if( configUSE_TASK_SNAPSHOTS == 1 )
+		ListItem_t		xTaskListItem;		/*< Links every task into xAllTasksList, in creation order. */
+	#endif
+	UBaseType_t			uxPriority;			/*< The priority of the task.  0 is the lowest priority. */
+
+	#if( configGENERATE_RUN_TIME_STATS == 1 )
+		configRUN_TIME_COUNTER_TYPE	ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+	#endif
+
+	#if( configUSE_SWITCH_STATS == 1 )
+		uint32_t		ulVoluntarySwitches;	/*< Switched out after blocking, suspending itself or yielding. */
+		uint32_t		ulInvoluntarySwitches;	/*< Switched out while still ready. */
+	#endif
+
+	#if( configUSE_QUIESCENT_STATES == 1 )
+		uint32_t		ulQuiescentEpoch;		/*< Grace period epoch when it last left the Ready state. */
+	#endif
+
+	#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+		UBaseType_t		uxPreemptionThreshold;	/*< Once running, only a priority above it preempts the task.  0 for none. */
+		struct tskTaskControlBlock *pxThresholdNext;	/*< Next of the tasks preempted while running above their priority. */
+	#endif
+
+	#if( configUSE_TASK_TIME_SLICE_QUANTA == 1 )
+		TickType_t xTimeSlice;		/*< Round robin quantum, in ticks. */
+		TickType_t xTimeSliceLeft;	/*< Ticks left of the current quantum. */
+	#endif
+
+	#if( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t xEdfDeadline;	/*< Absolute deadline, in ticks, that orders the task in the ready list of configEDF_PRIORITY. */
+	#endif
+
+	#if( configUSE_POSIX_ERRNO == 1 )
+		int iTaskErrno;
+	#endif
+
+	#if ( configUSE_MUTEXES == 1 )
+		UBaseType_t		uxBasePriority;		/*< The priority last assigned to the task - used by the priority inheritance mechanism. */
+		UBaseType_t		uxMutexesHeld;
+	#endif
+
+	#if( configUSE_TASK_NOTIFICATIONS == 1 )
+		volatile uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+	#endif
+
+	StackType_t			*pxStack;			/*< Points to the start of the stack. */
+	const char			*pcTaskName;		/*< The name given to the task when created, not copied.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+	#if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
+		StackType_t		*pxEndOfStack;		/*< Points to the highest valid address for the stack. */
+	#endif
+
+	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+		UBaseType_t		uxCriticalNesting;	/*< Holds the critical section nesting depth for ports that do not maintain their own count in the port layer. */
+	#endif
+
+	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+		TaskHookFunction_t pxTaskTag;
+	#endif
+
+	#if( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
+		void			*pvThreadLocalStoragePointers[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
+	#endif
+
+	#if ( configUSE_NEWLIB_REENTRANT == 1 )
+		/* See the full layout below. */
+		struct	_reent xNewLib_reent;
+	#endif
+
+	#if( configUSE_TASK_NOTIFICATIONS == 1 )
+		volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+	#endif
+
+	#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+		uint8_t	ucStaticallyAllocated; 		/*< Set to pdTRUE if the task is a statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+
+	#if( INCLUDE_xTaskAbortDelay == 1 )
+		uint8_t ucDelayAborted;
+	#endif
+
+	#if( configUSE_TASK_FPU_DECLARATION == 1 )
+		uint8_t ucUsesFPU;	/*< Set to pdTRUE if the task was created with portTASK_USES_FPU_BIT in its priority. */
+	#endif
+
+	#if( configUSE_TASK_ARENAS == 1 )
+		struct ArenaDef_t	*pxArena;	/*< The arena the task owns (arena.h), deleted with it. */
+	#endif
+
+	#if( configUSE_TASK_BUDGETS == 1 )
+		ListItem_t		xBudgetListItem;	/*< Links the task into xBudgetTaskList while it has a budget. */
+		configRUN_TIME_COUNTER_TYPE	ulBudget;		/*< Run time allowed per period, 0 for none. */
+		configRUN_TIME_COUNTER_TYPE	ulBudgetBase;	/*< ulRunTimeCounter when the current period started. */
+		TickType_t		xBudgetPeriod;		/*< The budget period, in ticks. */
+		TickType_t		xBudgetRefillTime;	/*< The tick count at which the next period starts. */
+		UBaseType_t		uxBudgetPriority;	/*< The base priority given back at the end of a demotion. */
+		uint32_t		ulBudgetOverruns;	/*< Periods in which the budget ran out. */
+		uint8_t			ucBudgetAction;		/*< An eTaskBudgetAction. */
+		uint8_t			ucBudgetState;		/*< taskBUDGET_OVERRUN, taskBUDGET_DEMOTED and taskBUDGET_SUSPENDED. */
+	#endif
+
+	#if( configUSE_JOB_STATS == 1 )
+		configRUN_TIME_COUNTER_TYPE	ulJobRelease;		/*< Run time stats clock at the last release. */
+		configRUN_TIME_COUNTER_TYPE	ulJobFirstRelease;	/*< Run time stats clock at the first release since the reset. */
+		configRUN_TIME_COUNTER_TYPE	ulJobRunBase;		/*< ulRunTimeCounter at the last release. */
+		configRUN_TIME_COUNTER_TYPE	ulJobPeriodMin;		/*< Shortest time between two releases. */
+		configRUN_TIME_COUNTER_TYPE	ulJobExecMax;		/*< Longest run time of a job. */
+		configRUN_TIME_COUNTER_TYPE	ulJobExecTotal;		/*< Run time of the ended jobs. */
+		uint32_t		ulJobs;				/*< Releases since the reset. */
+		uint32_t		ulJobsDone;			/*< Jobs released since the reset that have ended. */
+		uint8_t			ucJobState;			/*< taskJOB_ACTIVE and taskJOB_COUNTED. */
+	#endif
+
+} tskTCB;
+
+#else
+
 typedef struct tskTaskControlBlock 			/* The old naming convention is used to prevent breaking kernel aware debuggers. */
 {
 	volatile StackType_t	*pxTopOfStack;	/*< Points to the location of the last item placed on the tasks stack.  THIS MUST BE THE FIRST MEMBER OF THE TCB STRUCT. */
@@ -259,6 +548,9 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 
 	ListItem_t			xStateListItem;	/*< The list that the state list item of a task is reference from denotes the state of that task (Ready, Blocked, Suspended ). */
 	ListItem_t			xEventListItem;		/*< Used to reference a task from an event list. */
+	#if( configUSE_TASK_SNAPSHOTS == 1 )
+		ListItem_t		xTaskListItem;		/*< Links every task into xAllTasksList, in creation order. */
+	#endif
 	UBaseType_t			uxPriority;			/*< The priority of the task.  0 is the lowest priority. */
 	StackType_t			*pxStack;			/*< Points to the start of the stack. */
 	char				pcTaskName[ configMAX_TASK_NAME_LEN ];/*< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
@@ -289,8 +581,26 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 		void			*pvThreadLocalStoragePointers[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
 	#endif
 
+	#if( configUSE_TASK_ARENAS == 1 )
+		struct ArenaDef_t	*pxArena;	/*< The arena the task owns (arena.h), deleted with it. */
+	#endif
+
 	#if( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+		configRUN_TIME_COUNTER_TYPE	ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+	#endif
+
+	#if( configUSE_SWITCH_STATS == 1 )
+		uint32_t		ulVoluntarySwitches;	/*< Switched out after blocking, suspending itself or yielding. */
+		uint32_t		ulInvoluntarySwitches;	/*< Switched out while still ready. */
+	#endif
+
+	#if( configUSE_QUIESCENT_STATES == 1 )
+		uint32_t		ulQuiescentEpoch;		/*< Grace period epoch when it last left the Ready state. */
+	#endif
+
+	#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+		UBaseType_t		uxPreemptionThreshold;	/*< Once running, only a priority above it preempts the task.  0 for none. */
+		struct tskTaskControlBlock *pxThresholdNext;	/*< Next of the tasks preempted while running above their priority. */
 	#endif
 
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
@@ -308,8 +618,8 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 	#endif
 
 	#if( configUSE_TASK_NOTIFICATIONS == 1 )
-		volatile uint32_t ulNotifiedValue;
-		volatile uint8_t ucNotifyState;
+		volatile uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 
 	/* See the comments in FreeRTOS.h with the definition of
@@ -326,12 +636,89 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 		int iTaskErrno;
 	#endif
 
+	#if( configUSE_TASK_FPU_DECLARATION == 1 )
+		uint8_t ucUsesFPU;	/*< Set to pdTRUE if the task was created with portTASK_USES_FPU_BIT in its priority. */
+	#endif
+
+	#if( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t xEdfDeadline;	/*< Absolute deadline, in ticks, that orders the task in the ready list of configEDF_PRIORITY. */
+	#endif
+
+	#if( configUSE_TASK_TIME_SLICE_QUANTA == 1 )
+		TickType_t xTimeSlice;		/*< Round robin quantum, in ticks. */
+		TickType_t xTimeSliceLeft;	/*< Ticks left of the current quantum. */
+	#endif
+
+	#if( configUSE_TASK_BUDGETS == 1 )
+		ListItem_t		xBudgetListItem;	/*< Links the task into xBudgetTaskList while it has a budget. */
+		configRUN_TIME_COUNTER_TYPE	ulBudget;		/*< Run time allowed per period, 0 for none. */
+		configRUN_TIME_COUNTER_TYPE	ulBudgetBase;	/*< ulRunTimeCounter when the current period started. */
+		TickType_t		xBudgetPeriod;		/*< The budget period, in ticks. */
+		TickType_t		xBudgetRefillTime;	/*< The tick count at which the next period starts. */
+		UBaseType_t		uxBudgetPriority;	/*< The base priority given back at the end of a demotion. */
+		uint32_t		ulBudgetOverruns;	/*< Periods in which the budget ran out. */
+		uint8_t			ucBudgetAction;		/*< An eTaskBudgetAction. */
+		uint8_t			ucBudgetState;		/*< taskBUDGET_OVERRUN, taskBUDGET_DEMOTED and taskBUDGET_SUSPENDED. */
+	#endif
+
+	#if( configUSE_JOB_STATS == 1 )
+		configRUN_TIME_COUNTER_TYPE	ulJobRelease;		/*< Run time stats clock at the last release. */
+		configRUN_TIME_COUNTER_TYPE	ulJobFirstRelease;	/*< Run time stats clock at the first release since the reset. */
+		configRUN_TIME_COUNTER_TYPE	ulJobRunBase;		/*< ulRunTimeCounter at the last release. */
+		configRUN_TIME_COUNTER_TYPE	ulJobPeriodMin;		/*< Shortest time between two releases. */
+		configRUN_TIME_COUNTER_TYPE	ulJobExecMax;		/*< Longest run time of a job. */
+		configRUN_TIME_COUNTER_TYPE	ulJobExecTotal;		/*< Run time of the ended jobs. */
+		uint32_t		ulJobs;				/*< Releases since the reset. */
+		uint32_t		ulJobsDone;			/*< Jobs released since the reset that have ended. */
+		uint8_t			ucJobState;			/*< taskJOB_ACTIVE and taskJOB_COUNTED. */
+	#endif
+
 } tskTCB;
 
+#endif /* configUSE_LEAN_TCB */
+
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
 below to enable the use of older kernel aware debuggers. */
 typedef tskTCB TCB_t;
 
+/* The trace numbers are kept in the TCB, or with configUSE_LEAN_TCB in a side
+table of configLEAN_TCB_DIAGNOSTIC_ENTRIES entries that only task creation and
+deletion and the trace functions touch.  Without a table, or once it is full,
+they read as 0. */
+#if( configUSE_TRACE_FACILITY == 1 )
+	#if( configUSE_LEAN_TCB == 0 )
+		#define taskGET_TCB_NUMBER( pxTCB )					( ( pxTCB )->uxTCBNumber )
+		#define taskSET_TCB_NUMBER( pxTCB, uxNumber )		( pxTCB )->uxTCBNumber = ( uxNumber )
+		#define taskGET_TASK_NUMBER( pxTCB )				( ( pxTCB )->uxTaskNumber )
+		#define taskSET_TASK_NUMBER( pxTCB, uxNumber )		( pxTCB )->uxTaskNumber = ( uxNumber )
+	#elif( configLEAN_TCB_DIAGNOSTIC_ENTRIES > 0 )
+		#define taskUSE_DIAGNOSTICS_TABLE					1
+
+		typedef struct xTASK_DIAGNOSTICS
+		{
+			const TCB_t *pxTCB;			/*< NULL while the entry is free. */
+			UBaseType_t uxTCBNumber;
+			UBaseType_t uxTaskNumber;
+		} TaskDiagnostics_t;
+
+		PRIVILEGED_DATA static TaskDiagnostics_t xTaskDiagnostics[ configLEAN_TCB_DIAGNOSTIC_ENTRIES ];
+
+		#define taskGET_TCB_NUMBER( pxTCB )					prvGetTaskDiagnostic( ( pxTCB ), pdFALSE )
+		#define taskSET_TCB_NUMBER( pxTCB, uxNumber )		prvClaimTaskDiagnostics( ( pxTCB ), ( uxNumber ) )
+		#define taskGET_TASK_NUMBER( pxTCB )				prvGetTaskDiagnostic( ( pxTCB ), pdTRUE )
+		#define taskSET_TASK_NUMBER( pxTCB, uxNumber )		prvSetTaskNumber( ( pxTCB ), ( uxNumber ) )
+	#else
+		#define taskGET_TCB_NUMBER( pxTCB )					( ( void ) ( pxTCB ), ( UBaseType_t ) 0U )
+		#define taskSET_TCB_NUMBER( pxTCB, uxNumber )		( ( void ) ( pxTCB ), ( void ) ( uxNumber ) )
+		#define taskGET_TASK_NUMBER( pxTCB )				( ( void ) ( pxTCB ), ( UBaseType_t ) 0U )
+		#define taskSET_TASK_NUMBER( pxTCB, uxNumber )		( ( void ) ( pxTCB ), ( void ) ( uxNumber ) )
+	#endif
+#endif /* configUSE_TRACE_FACILITY */
+
+#ifndef taskUSE_DIAGNOSTICS_TABLE
+	#define taskUSE_DIAGNOSTICS_TABLE						0
+#endif
+
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
 PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
@@ -341,10 +728,20 @@ xDelayedTaskList1 and xDelayedTaskList2 could be move to function scople but
 doing so breaks some kernel aware debuggers and debuggers that rely on removing
 the static qualifier. */
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+	PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
+	PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+	PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
+	PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#else
+	/* With configUSE_DELAYED_TASK_WHEEL set the delayed tasks are instead kept,
+	unsorted, in the wheel slot selected by the low bits of their wake time.  A
+	slot holds every task that wakes at a tick with those low bits, whatever the
+	lap, so each tick only the tasks in one slot are looked at and a task that
+	blocks is added to the end of its slot without a search.  The wake time is
+	compared for equality, so there is no overflow list to switch either. */
+	PRIVILEGED_DATA static List_t xDelayedTaskWheel[ configDELAYED_TASK_WHEEL_SLOTS ];	/*< Delayed tasks, by wake time modulo configDELAYED_TASK_WHEEL_SLOTS. */
+#endif
 PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if( INCLUDE_vTaskDelete == 1 )
@@ -360,6 +757,12 @@ PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been r
 
 #endif
 
+#if( configUSE_TASK_SNAPSHOTS == 1 )
+
+	PRIVILEGED_DATA static List_t xAllTasksList;						/*< Every task not deleted, whatever its state.  Only changed by tasks, in critical sections. */
+
+#endif
+
 /* Global POSIX errno. Its value is changed upon context switching to match
 the errno of the currently running task. */
 #if ( configUSE_POSIX_ERRNO == 1 )
@@ -370,6 +773,9 @@ the errno of the currently running task. */
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks 	= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xTickCount 				= ( TickType_t ) configINITIAL_TICK_COUNT;
 PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority 		= tskIDLE_PRIORITY;
+#if( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 ) && ( configMAX_PRIORITIES > portREADY_BITMAP_BITS ) )
+	PRIVILEGED_DATA static volatile UBaseType_t uxReadyPriorityGroups[ ( configMAX_PRIORITIES + portREADY_BITMAP_BITS - 1 ) / portREADY_BITMAP_BITS ] = { 0 };
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning 		= pdFALSE;
 PRIVILEGED_DATA static volatile TickType_t xPendedTicks 			= ( TickType_t ) 0U;
 PRIVILEGED_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
@@ -378,6 +784,10 @@ PRIVILEGED_DATA static UBaseType_t uxTaskNumber 					= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime		= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
 PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle					= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
 
+#if( configUSE_TASK_REAPER == 1 )
+	PRIVILEGED_DATA static TaskHandle_t xReaperTaskHandle = NULL;	/*< Notified by vTaskDelete() when a task deletes itself. */
+#endif
+
 /* Context switches are held pending while the scheduler is suspended.  Also,
 interrupts must not manipulate the xStateListItem of a TCB, or any of the
 lists the xStateListItem can be referenced from, if the scheduler is suspended.
@@ -392,8 +802,89 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 	/* Do not move these variables to function scope as doing so prevents the
 	code working with debuggers that need to remove the static qualifier. */
-	PRIVILEGED_DATA static uint32_t ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
-	PRIVILEGED_DATA static uint32_t ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
+	PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
+	PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
+
+#endif
+
+#if ( configUSE_SWITCH_STATS == 1 )
+
+	PRIVILEGED_DATA static volatile uint32_t ulSwitchCount = 0UL;				/*< Context switches that changed the running task. */
+	PRIVILEGED_DATA static volatile BaseType_t xYieldIsVoluntary = pdFALSE;	/*< Set by taskYIELD() for the switch it requests. */
+
+#endif
+
+#if ( configUSE_QUIESCENT_STATES == 1 )
+
+	PRIVILEGED_DATA static volatile uint32_t ulGraceEpoch = 0UL;	/*< Incremented by ulTaskGracePeriodStart(). */
+
+#endif
+
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	PRIVILEGED_DATA static TCB_t *pxThresholdPreempted = NULL;	/*< Tasks preempted while running above their priority, the last one first. */
+
+#endif
+
+#if ( configUSE_TICK_STATS == 1 )
+
+	PRIVILEGED_DATA static TickStats_t xTickStats;				/*< Updated by the tick interrupt, read in a critical section. */
+	PRIVILEGED_DATA static uint32_t ulTickUnblocked = 0UL;	/*< Tasks unblocked by the last call of xTaskIncrementTick(). */
+
+#endif
+
+#if ( configUSE_IDLE_SLEEP == 1 )
+
+	PRIVILEGED_DATA static IdleSleepStats_t xIdleSleepStats;	/*< Updated by the idle task with interrupts masked, read in a critical section. */
+
+#endif
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	PRIVILEGED_DATA static List_t xBudgetTaskList;	/*< Every task with a budget, walked by the tick for the periods that end. */
+
+	/* Bits of ucBudgetState. */
+	#define taskBUDGET_OVERRUN		( ( uint8_t ) 0x01U )	/* The budget ran out in this period. */
+	#define taskBUDGET_DEMOTED		( ( uint8_t ) 0x02U )	/* Running at configTASK_BUDGET_BACKGROUND_PRIORITY. */
+	#define taskBUDGET_SUSPENDED	( ( uint8_t ) 0x04U )	/* Moved to the Suspended state. */
+
+	/* Wrap-safe test that the tick count xNow has reached xTime.  It is a
+	comparison rather than an equality so that ticks stepped over by tickless
+	idle do not skip a period. */
+	#define taskBUDGET_IS_DUE( xNow, xTime )	( ( TickType_t ) ( ( xNow ) - ( xTime ) ) <= ( ( TickType_t ) portMAX_DELAY >> 1 ) )
+
+#endif
+
+#if ( configUSE_JOB_STATS == 1 )
+
+	/* Bits of ucJobState. */
+	#define taskJOB_ACTIVE		( ( uint8_t ) 0x01U )	/* Released, not yet switched out blocked or suspended. */
+	#define taskJOB_COUNTED		( ( uint8_t ) 0x02U )	/* Released since the statistics were reset. */
+
+	#define taskJOB_RELEASE( pxTCB )	prvJobRelease( pxTCB )
+
+#else
+
+	#define taskJOB_RELEASE( pxTCB )
+
+#endif
+
+#if ( configUSE_TASK_NAME_INDEX == 1 )
+
+	typedef struct xTASK_NAME_SLOT
+	{
+		uint32_t ulHash;			/*< taskNAME_HASH() of the name. */
+		TCB_t *pxTCB;				/*< NULL while the slot is free. */
+	} TaskNameSlot_t;
+
+	/* Open addressed with linear probing, and never more than one slot short
+	of full so that a probe always ends on a free slot.  Only touched in
+	critical sections. */
+	PRIVILEGED_DATA static TaskNameSlot_t xTaskNameIndex[ configTASK_NAME_INDEX_SIZE ];
+	PRIVILEGED_DATA static UBaseType_t uxTaskNamesIndexed = ( UBaseType_t ) 0U;
+	PRIVILEGED_DATA static UBaseType_t uxTaskNamesNotIndexed = ( UBaseType_t ) 0U;	/*< Tasks created while the index was full. */
+
+	#define taskNAME_INDEX_MASK		( ( uint32_t ) configTASK_NAME_INDEX_SIZE - 1UL )
 
 #endif
 
@@ -414,6 +905,12 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #endif
 
+#if( ( configUSE_TASK_BUDGETS == 1 ) && ( configUSE_TASK_BUDGET_HOOK == 1 ) )
+
+	extern void vApplicationTaskBudgetHook( TaskHandle_t xTask ); /*lint !e526 Symbol not defined as it is an application callback. */
+
+#endif
+
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
 
 	extern void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize ); /*lint !e526 Symbol not defined as it is an application callback. */
@@ -433,6 +930,17 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #endif /* INCLUDE_vTaskSuspend */
 
+/*
+ * Moves a task to the suspended list.  Called from a critical section by
+ * vTaskSuspend() and vTaskSwitchGroups(), and by the budget overrun handling
+ * with interrupts masked, which do the rescheduling.
+ */
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+	static void prvSuspendTask( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif /* INCLUDE_vTaskSuspend */
+
 /*
  * Utility to ready all the lists used by the scheduler.  This is called
  * automatically upon the creation of the first task.
@@ -452,6 +960,19 @@ static void prvInitialiseTaskLists( void ) PRIVILEGED_FUNCTION;
  */
 static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters );
 
+/*
+ * Frees the TCB and stack of the tasks that deleted themselves, each time
+ * vTaskDelete() notifies it.  It runs at configTASK_REAPER_PRIORITY, so the
+ * memory is freed as soon as the task has switched out, not when the idle task
+ * next runs.
+ */
+#if( configUSE_TASK_REAPER == 1 )
+
+	static portTASK_FUNCTION_PROTO( prvReaperTask, pvParameters );
+	static BaseType_t prvCreateReaperTask( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Utility to free all memory allocated by the scheduler to hold a TCB,
  * including the stack pointed to by the TCB.
@@ -466,7 +987,8 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters );
 #endif
 
 /*
- * Used only by the idle task.  This checks to see if anything has been placed
+ * Used by the idle task, and by the reaper task and xTaskCreate() with
+ * configUSE_TASK_REAPER.  This checks to see if anything has been placed
  * in the list of tasks waiting to be deleted.  If so the task is cleaned up
  * and its TCB deleted.
  */
@@ -513,6 +1035,22 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
 
 #endif
 
+#if( taskUSE_DIAGNOSTICS_TABLE == 1 )
+
+	/*
+	 * The side table of the trace numbers of configUSE_LEAN_TCB.  An entry is
+	 * claimed when the task is created, in a critical section, and released
+	 * when its TCB is deleted.
+	 */
+	static void prvClaimTaskDiagnostics( const TCB_t *pxTCB, UBaseType_t uxTCBNumber ) PRIVILEGED_FUNCTION;
+	#if( INCLUDE_vTaskDelete == 1 )
+		static void prvReleaseTaskDiagnostics( const TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+	#endif
+	static UBaseType_t prvGetTaskDiagnostic( const TCB_t *pxTCB, BaseType_t xTaskNumber ) PRIVILEGED_FUNCTION;
+	static void prvSetTaskNumber( const TCB_t *pxTCB, UBaseType_t uxTaskNumber ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Return the amount of time, in ticks, that will pass before the kernel will
  * next move a task from the Blocked state to the Running state.
@@ -528,36 +1066,176 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
 
 #endif
 
-/*
- * Set xNextTaskUnblockTime to the time at which the next Blocked state task
- * will exit the Blocked state.
- */
-static void prvResetNextTaskUnblockTime( void );
-
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+#if ( ( configUSE_TICKLESS_IDLE != 0 ) && ( configUSE_DELAYED_TASK_WHEEL == 1 ) )
 
 	/*
-	 * Helper function used to pad task names with spaces when printing out
-	 * human readable tables of task information.
+	 * Return the number of ticks until the first delayed task wakes, found by
+	 * walking the wheel.  The wheel does not keep track of its earliest wake
+	 * time, so this is only done when the kernel is about to sleep.
 	 */
-	static char *prvWriteNameToBuffer( char *pcBuffer, const char *pcTaskName ) PRIVILEGED_FUNCTION;
+	static TickType_t prvGetTicksToNextWheelUnblock( void ) PRIVILEGED_FUNCTION;
 
 #endif
 
 /*
- * Called after a Task_t structure has been allocated either statically or
- * dynamically to fill in the structure's members.
+ * Move a delayed task whose wake time has come to its ready list.  Returns
+ * pdTRUE if a context switch is required.
  */
-static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
-									const char * const pcName, 		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-									const uint32_t ulStackDepth,
-									void * const pvParameters,
-									UBaseType_t uxPriority,
-									TaskHandle_t * const pxCreatedTask,
-									TCB_t *pxNewTCB,
-									const MemoryRegion_t * const xRegions ) PRIVILEGED_FUNCTION;
+static BaseType_t prvUnblockDelayedTask( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
 
-/*
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	/*
+	 * Insert a task into the ready list of configEDF_PRIORITY, ahead of the
+	 * first task with a later deadline, so tasks with equal deadlines run in
+	 * the order they became ready.
+	 */
+	static void prvEdfInsertReady( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	/*
+	 * The run time of a task, including the time the running task has spent
+	 * since it was switched in, as of the run time counter value ulNow.
+	 */
+	static configRUN_TIME_COUNTER_TYPE prvBudgetRunTime( TCB_t const * const pxTCB, configRUN_TIME_COUNTER_TYPE ulNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Apply the overrun action of a task that has used up its budget.  Called
+	 * from the tick and the context switch only.  Returns pdTRUE if the running
+	 * task was demoted or suspended and so must be switched out.
+	 */
+	static BaseType_t prvBudgetOverrun( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Give back the priority or the Ready state an overrun took away.  Returns
+	 * pdTRUE if the task should now preempt the running task.
+	 */
+	static BaseType_t prvBudgetRestore( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Change the base priority of a task, and the priority it runs at unless
+	 * it inherited a higher one, as vTaskPrioritySet() does but without its
+	 * critical section or yield.
+	 */
+	static void prvBudgetSetPriority( TCB_t * const pxTCB, UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by each tick: starts the periods that are due and charges the
+	 * running task.  Returns pdTRUE if a context switch is required.
+	 */
+	static BaseType_t prvBudgetTick( TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	/*
+	 * pdTRUE if a task with a priority above uxLevel is ready.
+	 */
+	static BaseType_t prvReadyAboveLevel( UBaseType_t uxLevel ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by vTaskSwitchContext() before the highest priority ready task is
+	 * selected: gives the processor back to the last task preempted while
+	 * running above its priority if nothing above its threshold is ready.
+	 * Returns pdFALSE if the usual selection is to be made.
+	 */
+	static BaseType_t prvThresholdSelect( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Removes pxTCB from the tasks preempted while running above their
+	 * priority, if it is one of them.
+	 */
+	static void prvThresholdForget( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( configUSE_JOB_STATS == 1 )
+
+	/*
+	 * Called as a task is added to a ready list: starts a job if the task
+	 * was not in one, that is if it comes out of the Blocked or Suspended
+	 * state rather than changing priority.
+	 */
+	static void prvJobRelease( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( configUSE_TASK_NAME_INDEX == 1 )
+
+	/*
+	 * The task name index.  The hash is the one taskNAME_HASH() computes at
+	 * compile time.  Tasks are added as they are created and removed as they
+	 * are deleted, both in a critical section.  The find compares the names
+	 * of the tasks whose hash matches, unless pcName is NULL.
+	 */
+	static uint32_t prvTaskNameHash( const char *pcName ) PRIVILEGED_FUNCTION;
+	static void prvIndexTaskName( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+	static TCB_t *prvFindTaskName( uint32_t ulHash, const char *pcName ) PRIVILEGED_FUNCTION;
+	#if( INCLUDE_vTaskDelete == 1 )
+		static void prvUnindexTaskName( const TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+	#endif
+
+#endif
+
+#if( configUSE_NOTIFY_GROUPS == 1 )
+
+	/*
+	 * Updates notification uxIndexToNotify of pxTCB for eAction, as
+	 * xTaskGenericNotify() does, in the critical section of a group notify.
+	 * Sets *pxReturn to pdFAIL if the value could not be updated.  Returns
+	 * the state of the notification before, and leaves the task where it is:
+	 * the callers move it if it was waiting.
+	 */
+	static uint8_t prvNotifyGroupMember( TCB_t *pxTCB, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxReturn ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Set xNextTaskUnblockTime to the time at which the next Blocked state task
+ * will exit the Blocked state.
+ */
+static void prvResetNextTaskUnblockTime( void );
+
+#if( INCLUDE_xTaskGetTicksToNextWake == 1 )
+
+	/*
+	 * Lower xTicksToWake to the ticks until the first task of pxList of
+	 * priority uxMinPriority or above is due to wake.  xSorted is pdTRUE for
+	 * the delayed lists, ordered by wake time, so the walk stops at the first
+	 * such task, and pdFALSE for the wheel slots.
+	 */
+	static TickType_t prvGetTicksToWakeWithinList( List_t const * pxList, UBaseType_t uxMinPriority, TickType_t xTicksToWake, BaseType_t xSorted ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+
+	/*
+	 * Helper function used to pad task names with spaces when printing out
+	 * human readable tables of task information.
+	 */
+	static char *prvWriteNameToBuffer( char *pcBuffer, const char *pcTaskName ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called after a Task_t structure has been allocated either statically or
+ * dynamically to fill in the structure's members.
+ */
+static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
+									const char * const pcName, 		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+									const uint32_t ulStackDepth,
+									void * const pvParameters,
+									UBaseType_t uxPriority,
+									TaskHandle_t * const pxCreatedTask,
+									TCB_t *pxNewTCB,
+									const MemoryRegion_t * const xRegions ) PRIVILEGED_FUNCTION;
+
+/*
  * Called after a new task has been created and initialised to place the task
  * under the control of the scheduler.
  */
@@ -740,6 +1418,15 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 	TCB_t *pxNewTCB;
 	BaseType_t xReturn;
 
+		#if( configUSE_TASK_REAPER == 1 )
+		{
+			/* A task that deleted itself is no longer running, so its memory
+			can be freed here if the reaper has not run yet, e.g. because it
+			has a lower priority than the caller. */
+			prvCheckTasksWaitingTermination();
+		}
+		#endif /* configUSE_TASK_REAPER */
+
 		/* If the stack grows down then allocate the stack then the TCB so the stack
 		does not grow into the TCB.  Likewise if the stack grows up then allocate
 		the TCB then the stack. */
@@ -847,6 +1534,59 @@ UBaseType_t x;
 		uxPriority &= ~portPRIVILEGE_BIT;
 	#endif /* portUSING_MPU_WRAPPERS == 1 */
 
+	#if( configUSE_TASK_FPU_DECLARATION == 1 )
+	{
+		/* Is the task declared as using the FPU? */
+		if( ( uxPriority & portTASK_USES_FPU_BIT ) != 0U )
+		{
+			pxNewTCB->ucUsesFPU = pdTRUE;
+		}
+		else
+		{
+			pxNewTCB->ucUsesFPU = pdFALSE;
+		}
+		uxPriority &= ~portTASK_USES_FPU_BIT;
+	}
+	#endif /* configUSE_TASK_FPU_DECLARATION */
+
+	#if( configUSE_EDF_SCHEDULING == 1 )
+	{
+		/* As far ahead as the deadline order can tell, so a task in the EDF
+		band that has not set a deadline yet runs after those that have. */
+		pxNewTCB->xEdfDeadline = xTickCount + ( ( TickType_t ) portMAX_DELAY >> 1 );
+	}
+	#endif /* configUSE_EDF_SCHEDULING */
+
+	#if( configUSE_TASK_TIME_SLICE_QUANTA == 1 )
+	{
+		pxNewTCB->xTimeSlice = ( TickType_t ) configTASK_TIME_SLICE_TICKS;
+		pxNewTCB->xTimeSliceLeft = ( TickType_t ) configTASK_TIME_SLICE_TICKS;
+	}
+	#endif /* configUSE_TASK_TIME_SLICE_QUANTA */
+
+	#if( configUSE_TASK_BUDGETS == 1 )
+	{
+		vListInitialiseItem( &( pxNewTCB->xBudgetListItem ) );
+		listSET_LIST_ITEM_OWNER( &( pxNewTCB->xBudgetListItem ), pxNewTCB );
+		pxNewTCB->ulBudget = 0;
+		pxNewTCB->ulBudgetOverruns = 0UL;
+		pxNewTCB->ucBudgetState = 0U;
+	}
+	#endif /* configUSE_TASK_BUDGETS */
+
+	#if( configUSE_JOB_STATS == 1 )
+	{
+		/* A new task is Ready, so being added to the ready list is not a
+		release: its first job ends uncounted. */
+		pxNewTCB->ulJobPeriodMin = 0;
+		pxNewTCB->ulJobExecMax = 0;
+		pxNewTCB->ulJobExecTotal = 0;
+		pxNewTCB->ulJobs = 0UL;
+		pxNewTCB->ulJobsDone = 0UL;
+		pxNewTCB->ucJobState = taskJOB_ACTIVE;
+	}
+	#endif /* configUSE_JOB_STATS */
+
 	/* Avoid dependency on memset() if it is not required. */
 	#if( tskSET_NEW_STACKS_TO_KNOWN_VALUE == 1 )
 	{
@@ -889,6 +1629,12 @@ UBaseType_t x;
 	#endif /* portSTACK_GROWTH */
 
 	/* Store the task name in the TCB. */
+	#if( configUSE_LEAN_TCB == 1 )
+	{
+		/* The string is not copied, so it must outlive the task. */
+		pxNewTCB->pcTaskName = ( pcName != NULL ) ? pcName : "";
+	}
+	#else
 	if( pcName != NULL )
 	{
 		for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
@@ -918,6 +1664,7 @@ UBaseType_t x;
 		terminator when it is read out. */
 		pxNewTCB->pcTaskName[ 0 ] = 0x00;
 	}
+	#endif /* configUSE_LEAN_TCB */
 
 	/* This is used as an array index so must ensure it's not too large.  First
 	remove the privilege bit if one is present. */
@@ -949,6 +1696,13 @@ UBaseType_t x;
 	listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 	listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
 
+	#if( configUSE_TASK_SNAPSHOTS == 1 )
+	{
+		vListInitialiseItem( &( pxNewTCB->xTaskListItem ) );
+		listSET_LIST_ITEM_OWNER( &( pxNewTCB->xTaskListItem ), pxNewTCB );
+	}
+	#endif /* configUSE_TASK_SNAPSHOTS */
+
 	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
 	{
 		pxNewTCB->uxCriticalNesting = ( UBaseType_t ) 0U;
@@ -967,6 +1721,28 @@ UBaseType_t x;
 	}
 	#endif /* configGENERATE_RUN_TIME_STATS */
 
+	#if ( configUSE_SWITCH_STATS == 1 )
+	{
+		pxNewTCB->ulVoluntarySwitches = 0UL;
+		pxNewTCB->ulInvoluntarySwitches = 0UL;
+	}
+	#endif /* configUSE_SWITCH_STATS */
+
+	#if ( configUSE_QUIESCENT_STATES == 1 )
+	{
+		/* A task created after a grace period started can only see what was
+		published before it. */
+		pxNewTCB->ulQuiescentEpoch = ulGraceEpoch;
+	}
+	#endif /* configUSE_QUIESCENT_STATES */
+
+	#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+	{
+		pxNewTCB->uxPreemptionThreshold = ( UBaseType_t ) 0U;
+		pxNewTCB->pxThresholdNext = NULL;
+	}
+	#endif /* configUSE_PREEMPTION_THRESHOLD */
+
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 	{
 		vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -987,10 +1763,19 @@ UBaseType_t x;
 	}
 	#endif
 
+	#if( configUSE_TASK_ARENAS == 1 )
+	{
+		pxNewTCB->pxArena = NULL;
+	}
+	#endif
+
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 	{
-		pxNewTCB->ulNotifiedValue = 0;
-		pxNewTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		for( x = 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+		{
+			pxNewTCB->ulNotifiedValue[ x ] = 0;
+			pxNewTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+		}
 	}
 	#endif
 
@@ -1123,12 +1908,27 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 		uxTaskNumber++;
 
+		#if( configUSE_TASK_SNAPSHOTS == 1 )
+		{
+			/* Appended, as the list index is never moved, so a snapshot in
+			progress reaches the new task last. */
+			vListInsertEnd( &xAllTasksList, &( pxNewTCB->xTaskListItem ) );
+		}
+		#endif /* configUSE_TASK_SNAPSHOTS */
+
 		#if ( configUSE_TRACE_FACILITY == 1 )
 		{
 			/* Add a counter into the TCB for tracing only. */
-			pxNewTCB->uxTCBNumber = uxTaskNumber;
+			taskSET_TCB_NUMBER( pxNewTCB, uxTaskNumber );
 		}
 		#endif /* configUSE_TRACE_FACILITY */
+
+		#if( configUSE_TASK_NAME_INDEX == 1 )
+		{
+			prvIndexTaskName( pxNewTCB );
+		}
+		#endif
+
 		traceTASK_CREATE( pxNewTCB );
 
 		prvAddTaskToReadyList( pxNewTCB );
@@ -1141,7 +1941,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	{
 		/* If the created task is of a higher priority than the current task
 		then it should run now. */
-		if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+		if( taskPREEMPTS_CURRENT( pxNewTCB ) != pdFALSE )
 		{
 			taskYIELD_IF_USING_PREEMPTION();
 		}
@@ -1195,6 +1995,43 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			not return. */
 			uxTaskNumber++;
 
+			#if( configUSE_TASK_SNAPSHOTS == 1 )
+			{
+				/* A snapshot that points at this task sees uxTaskNumber
+				change and never follows the pointer. */
+				( void ) uxListRemove( &( pxTCB->xTaskListItem ) );
+			}
+			#endif /* configUSE_TASK_SNAPSHOTS */
+
+			#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+			{
+				/* Another task deleted in the middle of its work above its
+				priority is freed below, not given the processor back. */
+				prvThresholdForget( pxTCB );
+			}
+			#endif /* configUSE_PREEMPTION_THRESHOLD */
+
+			#if( configUSE_TASK_NAME_INDEX == 1 )
+			{
+				/* Not found by name from now on, even while it waits for the
+				idle task to free it. */
+				prvUnindexTaskName( pxTCB );
+			}
+			#endif
+
+			#if( configUSE_TASK_BUDGETS == 1 )
+			{
+				if( listIS_CONTAINED_WITHIN( &xBudgetTaskList, &( pxTCB->xBudgetListItem ) ) != pdFALSE )
+				{
+					( void ) uxListRemove( &( pxTCB->xBudgetListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_TASK_BUDGETS */
+
 			if( pxTCB == pxCurrentTCB )
 			{
 				/* A task is deleting itself.  This cannot complete within the
@@ -1209,6 +2046,21 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				check the xTasksWaitingTermination list. */
 				++uxDeletedTasksWaitingCleanUp;
 
+				#if( configUSE_TASK_REAPER == 1 )
+				{
+					/* The reaper can only run once this task has switched
+					out, so it never frees the stack in use. */
+					if( xReaperTaskHandle != NULL )
+					{
+						( void ) xTaskNotifyGive( xReaperTaskHandle );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_TASK_REAPER */
+
 				/* Call the delete hook before portPRE_TASK_DELETE_HOOK() as
 				portPRE_TASK_DELETE_HOOK() does not return in the Win32 port. */
 				traceTASK_DELETE( pxTCB );
@@ -1386,8 +2238,11 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	eTaskState eTaskGetState( TaskHandle_t xTask )
 	{
 	eTaskState eReturn;
-	List_t const * pxStateList, *pxDelayedList, *pxOverflowedDelayedList;
+	List_t const * pxStateList;
 	const TCB_t * const pxTCB = xTask;
+	#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+		List_t const *pxDelayedList, *pxOverflowedDelayedList;
+	#endif
 
 		configASSERT( pxTCB );
 
@@ -1401,12 +2256,20 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			taskENTER_CRITICAL();
 			{
 				pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-				pxDelayedList = pxDelayedTaskList;
-				pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+				#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+				{
+					pxDelayedList = pxDelayedTaskList;
+					pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+				}
+				#endif
 			}
 			taskEXIT_CRITICAL();
 
-			if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+			#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+				if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+			#else
+				if( taskIS_WHEEL_SLOT( pxStateList ) )
+			#endif
 			{
 				/* The task being queried is referenced from one of the Blocked
 				lists. */
@@ -1423,17 +2286,21 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					{
 						#if( configUSE_TASK_NOTIFICATIONS == 1 )
 						{
+						BaseType_t x;
+
 							/* The task does not appear on the event list item of
 							and of the RTOS objects, but could still be in the
-							blocked state if it is waiting on its notification
-							rather than waiting on an object. */
-							if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
-							{
-								eReturn = eBlocked;
-							}
-							else
+							blocked state if it is waiting on one of its
+							notifications rather than waiting on an object. */
+							eReturn = eSuspended;
+
+							for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
 							{
-								eReturn = eSuspended;
+								if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+								{
+									eReturn = eBlocked;
+									break;
+								}
 							}
 						}
 						#else
@@ -1573,6 +2440,22 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			}
 			#endif
 
+			#if( configUSE_TASK_BUDGETS == 1 )
+			{
+				/* A task demoted for overrunning its budget gets the new
+				priority back when its next period starts. */
+				if( ( pxTCB->ucBudgetState & taskBUDGET_DEMOTED ) != 0U )
+				{
+					pxTCB->uxBudgetPriority = uxNewPriority;
+					uxNewPriority = uxCurrentBasePriority;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_TASK_BUDGETS */
+
 			if( uxCurrentBasePriority != uxNewPriority )
 			{
 				/* The priority change may have readied a task of higher
@@ -1664,9 +2547,9 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
 					{
 						/* It is known that the task is in its ready list so
-						there is no need to check again and the port level
-						reset macro can be called directly. */
-						portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
+						there is no need to check again and the bitmap
+						can be cleared directly. */
+						taskCLEAR_READY_PRIORITY( uxPriorityUsedOnEntry );
 					}
 					else
 					{
@@ -1699,72 +2582,314 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* INCLUDE_vTaskPrioritySet */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskSuspend == 1 )
+#if ( configUSE_EDF_SCHEDULING == 1 )
 
-	void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+	void vTaskSetDeadline( TaskHandle_t xTask, TickType_t xDeadline )
 	{
 	TCB_t *pxTCB;
 
 		taskENTER_CRITICAL();
 		{
-			/* If null is passed in here then it is the running task that is
-			being suspended. */
-			pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
-
-			traceTASK_SUSPEND( pxTCB );
+			pxTCB = prvGetTCBFromHandle( xTask );
+			pxTCB->xEdfDeadline = xDeadline;
 
-			/* Remove task from the ready/delayed list and place in the
-			suspended list. */
-			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			/* A ready task in the EDF band moves to its new place in the
+			deadline order.  Another task may then come before the running
+			one, or the task may now come before it. */
+			if( ( pxTCB->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) &&
+				( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ configEDF_PRIORITY ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
 			{
-				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
+				/* Only taskRESET_READY_PRIORITY() clears the band's bit in the
+				ready priority bitmap, so it survives the list being empty in
+				between. */
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				prvEdfInsertReady( pxTCB );
 
-			/* Is the task waiting on an event also? */
-			if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-			{
-				( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+				if( ( xSchedulerRunning != pdFALSE ) &&
+					( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) &&
+					( listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_PRIORITY ] ) ) != pxCurrentTCB ) )
+				{
+					taskYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
+		}
+		taskEXIT_CRITICAL();
+	}
 
-			vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
 
-			#if( configUSE_TASK_NOTIFICATIONS == 1 )
-			{
-				if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
-				{
-					/* The task was blocked to wait for a notification, but is
-					now suspended, so no notification was received. */
-					pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
-				}
-			}
-			#endif
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	TickType_t xTaskGetDeadline( TaskHandle_t xTask )
+	{
+	TCB_t const *pxTCB;
+	TickType_t xReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			xReturn = pxTCB->xEdfDeadline;
 		}
 		taskEXIT_CRITICAL();
 
-		if( xSchedulerRunning != pdFALSE )
+		return xReturn;
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_TIME_SLICE_QUANTA == 1 )
+
+	void vTaskSetTimeSlice( TaskHandle_t xTask, TickType_t xTicks )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( xTicks > ( TickType_t ) 0 );
+
+		if( xTicks == ( TickType_t ) 0 )
 		{
-			/* Reset the next expected unblock time in case it referred to the
-			task that is now in the Suspended state. */
-			taskENTER_CRITICAL();
-			{
-				prvResetNextTaskUnblockTime();
-			}
-			taskEXIT_CRITICAL();
+			xTicks = ( TickType_t ) 1;
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
 
-		if( pxTCB == pxCurrentTCB )
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			pxTCB->xTimeSlice = xTicks;
+			pxTCB->xTimeSliceLeft = xTicks;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TASK_TIME_SLICE_QUANTA */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_TIME_SLICE_QUANTA == 1 )
+
+	TickType_t xTaskGetTimeSlice( TaskHandle_t xTask )
+	{
+	TCB_t const *pxTCB;
+	TickType_t xReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			xReturn = pxTCB->xTimeSlice;
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TASK_TIME_SLICE_QUANTA */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	void vTaskSetBudget( TaskHandle_t xTask, configRUN_TIME_COUNTER_TYPE ulBudget, TickType_t xPeriod, eTaskBudgetAction eAction )
+	{
+	TCB_t *pxTCB;
+	configRUN_TIME_COUNTER_TYPE ulNow;
+	BaseType_t xYieldRequired;
+
+		configASSERT( ( ulBudget == 0 ) || ( xPeriod > ( TickType_t ) 0 ) );
+
+		#if( INCLUDE_vTaskSuspend == 0 )
+		{
+			/* There is no Suspended state to move an overrunning task to. */
+			configASSERT( eAction != eTaskBudgetSuspend );
+		}
+		#endif
+
+		if( xPeriod == ( TickType_t ) 0 )
+		{
+			xPeriod = ( TickType_t ) 1;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			configASSERT( pxTCB != xIdleTaskHandle );
+
+			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+				portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+			#else
+				ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+			#endif
+
+			/* A new budget, or none, starts without the overrun action of the
+			old one. */
+			xYieldRequired = prvBudgetRestore( pxTCB );
+
+			pxTCB->ulBudget = ulBudget;
+			pxTCB->xBudgetPeriod = xPeriod;
+			pxTCB->ucBudgetAction = ( uint8_t ) eAction;
+			pxTCB->ulBudgetBase = prvBudgetRunTime( pxTCB, ulNow );
+			pxTCB->xBudgetRefillTime = xTickCount + xPeriod;
+			pxTCB->ulBudgetOverruns = 0UL;
+
+			if( ulBudget == 0 )
+			{
+				if( listIS_CONTAINED_WITHIN( &xBudgetTaskList, &( pxTCB->xBudgetListItem ) ) != pdFALSE )
+				{
+					( void ) uxListRemove( &( pxTCB->xBudgetListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else if( listIS_CONTAINED_WITHIN( &xBudgetTaskList, &( pxTCB->xBudgetListItem ) ) == pdFALSE )
+			{
+				vListInsertEnd( &xBudgetTaskList, &( pxTCB->xBudgetListItem ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( ( xYieldRequired != pdFALSE ) && ( xSchedulerRunning != pdFALSE ) )
+			{
+				taskYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	void vTaskGetBudget( TaskHandle_t xTask, TaskBudgetStatus_t *pxStatus )
+	{
+	TCB_t const *pxTCB;
+	configRUN_TIME_COUNTER_TYPE ulNow;
+
+		configASSERT( pxStatus );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+				portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+			#else
+				ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+			#endif
+
+			pxStatus->ulBudget = pxTCB->ulBudget;
+			pxStatus->ulUsed = ( pxTCB->ulBudget != 0 ) ? ( prvBudgetRunTime( pxTCB, ulNow ) - pxTCB->ulBudgetBase ) : 0;
+			pxStatus->xPeriod = ( pxTCB->ulBudget != 0 ) ? pxTCB->xBudgetPeriod : ( TickType_t ) 0;
+			pxStatus->ulOverruns = pxTCB->ulBudgetOverruns;
+			pxStatus->xThrottled = ( ( pxTCB->ucBudgetState & ( taskBUDGET_DEMOTED | taskBUDGET_SUSPENDED ) ) != 0U ) ? pdTRUE : pdFALSE;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_JOB_STATS == 1 )
+
+	void vTaskGetJobStats( TaskHandle_t xTask, TaskJobStats_t *pxStats )
+	{
+	TCB_t const *pxTCB;
+
+		configASSERT( pxStats );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			pxStats->ulJobs = pxTCB->ulJobs;
+			pxStats->ulJobsDone = pxTCB->ulJobsDone;
+			pxStats->ulPeriodMin = pxTCB->ulJobPeriodMin;
+			pxStats->ulPeriodMean = ( pxTCB->ulJobs > 1UL ) ? ( ( pxTCB->ulJobRelease - pxTCB->ulJobFirstRelease ) / ( pxTCB->ulJobs - 1UL ) ) : 0;
+			pxStats->ulExecMax = pxTCB->ulJobExecMax;
+			pxStats->ulExecMean = ( pxTCB->ulJobsDone > 0UL ) ? ( pxTCB->ulJobExecTotal / pxTCB->ulJobsDone ) : 0;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_JOB_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_JOB_STATS == 1 )
+
+	void vTaskResetJobStats( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			pxTCB->ulJobPeriodMin = 0;
+			pxTCB->ulJobExecMax = 0;
+			pxTCB->ulJobExecTotal = 0;
+			pxTCB->ulJobs = 0UL;
+			pxTCB->ulJobsDone = 0UL;
+			pxTCB->ucJobState &= ( uint8_t ) ~taskJOB_COUNTED;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_JOB_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+	void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+	{
+	TCB_t *pxTCB;
+
+		taskENTER_CRITICAL();
+		{
+			/* If null is passed in here then it is the running task that is
+			being suspended. */
+			pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
+
+			prvSuspendTask( pxTCB );
+		}
+		taskEXIT_CRITICAL();
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			/* Reset the next expected unblock time in case it referred to the
+			task that is now in the Suspended state. */
+			taskENTER_CRITICAL();
+			{
+				prvResetNextTaskUnblockTime();
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( pxTCB == pxCurrentTCB )
 		{
 			if( xSchedulerRunning != pdFALSE )
 			{
@@ -1800,6 +2925,64 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* INCLUDE_vTaskSuspend */
 /*-----------------------------------------------------------*/
 
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+	static void prvSuspendTask( TCB_t * const pxTCB )
+	{
+		traceTASK_SUSPEND( pxTCB );
+
+		/* Remove task from the ready/delayed list and place in the
+		suspended list. */
+		if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+		{
+			taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Is the task waiting on an event also? */
+		if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+		{
+			( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
+
+		#if( configUSE_TASK_BUDGETS == 1 )
+		{
+			/* Suspended by the application, which a budget period ending
+			must not undo.  prvBudgetOverrun() sets the flag again for its
+			own suspensions. */
+			pxTCB->ucBudgetState &= ( uint8_t ) ~taskBUDGET_SUSPENDED;
+		}
+		#endif /* configUSE_TASK_BUDGETS */
+
+		#if( configUSE_TASK_NOTIFICATIONS == 1 )
+		{
+		BaseType_t x;
+
+			for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+			{
+				if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+				{
+					/* The task was blocked to wait for a notification, but is
+					now suspended, so no notification was received. */
+					pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+				}
+			}
+		}
+		#endif
+	}
+
+#endif /* INCLUDE_vTaskSuspend */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskSuspend == 1 )
 
 	static BaseType_t prvTaskIsTaskSuspended( const TaskHandle_t xTask )
@@ -1897,83 +3080,198 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	}
 
 #endif /* INCLUDE_vTaskSuspend */
-
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) )
+#if ( ( INCLUDE_vTaskSuspend == 1 ) && ( INCLUDE_vTaskSwitchGroups == 1 ) )
 
-	BaseType_t xTaskResumeFromISR( TaskHandle_t xTaskToResume )
+	void vTaskSwitchGroups( const TaskHandle_t * const pxTasksToSuspend, UBaseType_t uxSuspendCount, const TaskHandle_t * const pxTasksToResume, UBaseType_t uxResumeCount )
 	{
-	BaseType_t xYieldRequired = pdFALSE;
-	TCB_t * const pxTCB = xTaskToResume;
-	UBaseType_t uxSavedInterruptStatus;
-
-		configASSERT( xTaskToResume );
+	TCB_t *pxTCB;
+	UBaseType_t uxIndex;
+	BaseType_t xSuspendedSelf = pdFALSE;
 
-		/* RTOS ports that support interrupt nesting have the concept of a
-		maximum	system call (or maximum API call) interrupt priority.
-		Interrupts that are	above the maximum system call priority are keep
-		permanently enabled, even when the RTOS kernel is in a critical section,
-		but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-		is defined in FreeRTOSConfig.h then
-		portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-		failure if a FreeRTOS API function is called from an interrupt that has
-		been assigned a priority above the configured maximum system call
-		priority.  Only FreeRTOS functions that end in FromISR can be called
-		from interrupts	that have been assigned a priority at or (logically)
-		below the maximum system call interrupt priority.  FreeRTOS maintains a
-		separate interrupt safe API to ensure interrupt entry is as fast and as
-		simple as possible.  More information (albeit Cortex-M specific) is
-		provided on the following link:
-		https://www.freertos.org/RTOS-Cortex-M3-M4.html */
-		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+		configASSERT( ( pxTasksToSuspend != NULL ) || ( uxSuspendCount == ( UBaseType_t ) 0 ) );
+		configASSERT( ( pxTasksToResume != NULL ) || ( uxResumeCount == ( UBaseType_t ) 0 ) );
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		/* No other task runs until every task of both groups has changed
+		state, yet interrupts are only masked for one task at a time. */
+		vTaskSuspendAll();
 		{
-			if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+			for( uxIndex = ( UBaseType_t ) 0; uxIndex < uxSuspendCount; uxIndex++ )
 			{
-				traceTASK_RESUME_FROM_ISR( pxTCB );
-
-				/* Check the ready lists can be accessed. */
-				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+				taskENTER_CRITICAL();
 				{
-					/* Ready lists can be accessed so move the task from the
-					suspended list to the ready list directly. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					/* NULL is the calling task, as for vTaskSuspend(). */
+					pxTCB = prvGetTCBFromHandle( pxTasksToSuspend[ uxIndex ] );
+
+					if( pxTCB == pxCurrentTCB )
 					{
-						xYieldRequired = pdTRUE;
+						xSuspendedSelf = pdTRUE;
 					}
 					else
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
 
-					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-					prvAddTaskToReadyList( pxTCB );
-				}
-				else
-				{
-					/* The delayed or ready lists cannot be accessed so the task
-					is held in the pending ready list until the scheduler is
-					unsuspended. */
-					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+					prvSuspendTask( pxTCB );
 				}
+				taskEXIT_CRITICAL();
 			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
-		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-		return xYieldRequired;
-	}
+			/* The task pointed to by pxCurrentTCB is only the caller once the
+			scheduler has started. */
+			configASSERT( ( xSuspendedSelf == pdFALSE ) || ( xSchedulerRunning != pdFALSE ) );
 
-#endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
-/*-----------------------------------------------------------*/
+			for( uxIndex = ( UBaseType_t ) 0; uxIndex < uxResumeCount; uxIndex++ )
+			{
+				pxTCB = pxTasksToResume[ uxIndex ];
+				configASSERT( pxTCB );
 
-void vTaskStartScheduler( void )
-{
+				taskENTER_CRITICAL();
+				{
+					/* The calling task is resumed too if it was suspended
+					above, and so keeps running. */
+					if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+					{
+						traceTASK_RESUME( pxTCB );
+
+						( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+						prvAddTaskToReadyList( pxTCB );
+
+						if( pxTCB == pxCurrentTCB )
+						{
+							xSuspendedSelf = pdFALSE;
+						}
+						else if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						{
+							/* Yield once, from xTaskResumeAll(). */
+							xYieldPending = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				taskEXIT_CRITICAL();
+			}
+
+			if( uxSuspendCount > ( UBaseType_t ) 0 )
+			{
+				/* The next unblock time may have referred to a task now in
+				the Suspended state. */
+				taskENTER_CRITICAL();
+				{
+					prvResetNextTaskUnblockTime();
+				}
+				taskEXIT_CRITICAL();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		if( xTaskResumeAll() == pdFALSE )
+		{
+			/* xTaskResumeAll() does not yield without preemption, but the
+			calling task cannot carry on once it is suspended. */
+			if( xSuspendedSelf != pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* ( INCLUDE_vTaskSuspend == 1 ) && ( INCLUDE_vTaskSwitchGroups == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) )
+
+	BaseType_t xTaskResumeFromISR( TaskHandle_t xTaskToResume )
+	{
+	BaseType_t xYieldRequired = pdFALSE;
+	TCB_t * const pxTCB = xTaskToResume;
+	UBaseType_t uxSavedInterruptStatus;
+
+		configASSERT( xTaskToResume );
+
+		/* RTOS ports that support interrupt nesting have the concept of a
+		maximum	system call (or maximum API call) interrupt priority.
+		Interrupts that are	above the maximum system call priority are keep
+		permanently enabled, even when the RTOS kernel is in a critical section,
+		but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+		is defined in FreeRTOSConfig.h then
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+		failure if a FreeRTOS API function is called from an interrupt that has
+		been assigned a priority above the configured maximum system call
+		priority.  Only FreeRTOS functions that end in FromISR can be called
+		from interrupts	that have been assigned a priority at or (logically)
+		below the maximum system call interrupt priority.  FreeRTOS maintains a
+		separate interrupt safe API to ensure interrupt entry is as fast and as
+		simple as possible.  More information (albeit Cortex-M specific) is
+		provided on the following link:
+		https://www.freertos.org/RTOS-Cortex-M3-M4.html */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+			{
+				traceTASK_RESUME_FROM_ISR( pxTCB );
+
+				/* Check the ready lists can be accessed. */
+				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+				{
+					/* Ready lists can be accessed so move the task from the
+					suspended list to the ready list directly. */
+					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					{
+						xYieldRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					prvAddTaskToReadyList( pxTCB );
+				}
+				else
+				{
+					/* The delayed or ready lists cannot be accessed so the task
+					is held in the pending ready list until the scheduler is
+					unsuspended. */
+					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xYieldRequired;
+	}
+
+#endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+void vTaskStartScheduler( void )
+{
 BaseType_t xReturn;
 
 	/* Add the idle task at the lowest priority. */
@@ -2028,6 +3326,19 @@ BaseType_t xReturn;
 	}
 	#endif /* configUSE_TIMERS */
 
+	#if ( configUSE_TASK_REAPER == 1 )
+	{
+		if( xReturn == pdPASS )
+		{
+			xReturn = prvCreateReaperTask();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_TASK_REAPER */
+
 	if( xReturn == pdPASS )
 	{
 		/* freertos_tasks_c_additions_init() should only be called if the user
@@ -2070,6 +3381,12 @@ BaseType_t xReturn;
 
 		traceTASK_SWITCHED_IN();
 
+		#if( configUSE_MPU_STACK_GUARD == 1 )
+		{
+			portSET_STACK_GUARD( pxCurrentTCB->pxStack );
+		}
+		#endif
+
 		/* Setting up the timer tick is hardware specific and thus in the
 		portable interface. */
 		if( xPortStartScheduler() != pdFALSE )
@@ -2107,7 +3424,7 @@ void vTaskEndScheduler( void )
 }
 /*----------------------------------------------------------*/
 
-void vTaskSuspendAll( void )
+KERNEL_RAM_FUNCTION void vTaskSuspendAll( void )
 {
 	/* A critical section is not required as the variable is of type
 	BaseType_t.  Please read Richard Barry's reply in the following link to a
@@ -2125,6 +3442,15 @@ void vTaskSuspendAll( void )
 	/* Enforces ordering for ports and optimised compilers that may otherwise place
 	the above increment elsewhere. */
 	portMEMORY_BARRIER();
+
+	if( uxSchedulerSuspended == ( UBaseType_t ) 1U )
+	{
+		traceSCHEDULER_SUSPENDED( portGET_RETURN_ADDRESS() );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
 }
 /*----------------------------------------------------------*/
 
@@ -2154,8 +3480,14 @@ void vTaskSuspendAll( void )
 			variable is used as a bit map.  If bits other than the least
 			significant bit are set then there are tasks that have a priority
 			above the idle priority that are in the Ready state.  This takes
-			care of the case where the co-operative scheduler is in use. */
-			if( uxTopReadyPriority > uxLeastSignificantBit )
+			care of the case where the co-operative scheduler is in use.  With
+			the two-level bitmap, the idle priority is bit 0 of the first
+			group. */
+			#if( configMAX_PRIORITIES > portREADY_BITMAP_BITS )
+				if( ( uxTopReadyPriority > uxLeastSignificantBit ) || ( uxReadyPriorityGroups[ 0 ] > uxLeastSignificantBit ) )
+			#else
+				if( uxTopReadyPriority > uxLeastSignificantBit )
+			#endif
 			{
 				uxHigherPriorityReadyTasks = pdTRUE;
 			}
@@ -2182,7 +3514,18 @@ void vTaskSuspendAll( void )
 		}
 		else
 		{
-			xReturn = xNextTaskUnblockTime - xTickCount;
+			#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+			{
+				xReturn = xNextTaskUnblockTime - xTickCount;
+			}
+			#else
+			{
+				/* Also record the wake time for vTaskStepTick(), which
+				checks the time slept against it. */
+				xReturn = prvGetTicksToNextWheelUnblock();
+				xNextTaskUnblockTime = xTickCount + xReturn;
+			}
+			#endif
 		}
 
 		return xReturn;
@@ -2191,7 +3534,54 @@ void vTaskSuspendAll( void )
 #endif /* configUSE_TICKLESS_IDLE */
 /*----------------------------------------------------------*/
 
-BaseType_t xTaskResumeAll( void )
+#if ( ( configUSE_TICKLESS_IDLE != 0 ) && ( configUSE_DELAYED_TASK_WHEEL == 1 ) )
+
+	static TickType_t prvGetTicksToNextWheelUnblock( void )
+	{
+	const TickType_t xConstTickCount = xTickCount;
+	TickType_t xTicksToWake, xTicksToItem, xOffset;
+	List_t const * pxSlot;
+	ListItem_t const * pxItem;
+
+		/* Never report a wake time past the tick count overflow, as the
+		sorted delayed list does not either. */
+		xTicksToWake = portMAX_DELAY - xConstTickCount;
+
+		/* Visit the slots in the order their ticks come round.  Once a task
+		has been found that wakes within xOffset ticks no later slot can hold
+		one that wakes sooner. */
+		for( xOffset = ( TickType_t ) 1; ( xOffset <= ( TickType_t ) configDELAYED_TASK_WHEEL_SLOTS ) && ( xOffset < xTicksToWake ); xOffset++ )
+		{
+			pxSlot = taskWHEEL_SLOT( xConstTickCount + xOffset );
+
+			/* The tick interrupt can remove tasks from the slot unless the
+			scheduler is suspended. */
+			taskENTER_CRITICAL();
+			{
+				for( pxItem = listGET_HEAD_ENTRY( pxSlot ); pxItem != listGET_END_MARKER( pxSlot ); pxItem = listGET_NEXT( pxItem ) )
+				{
+					xTicksToItem = listGET_LIST_ITEM_VALUE( pxItem ) - xConstTickCount;
+
+					if( xTicksToItem < xTicksToWake )
+					{
+						xTicksToWake = xTicksToItem;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		return xTicksToWake;
+	}
+
+#endif /* ( configUSE_TICKLESS_IDLE != 0 ) && ( configUSE_DELAYED_TASK_WHEEL == 1 ) */
+/*----------------------------------------------------------*/
+
+KERNEL_RAM_FUNCTION BaseType_t xTaskResumeAll( void )
 {
 TCB_t *pxTCB = NULL;
 BaseType_t xAlreadyYielded = pdFALSE;
@@ -2211,6 +3601,8 @@ BaseType_t xAlreadyYielded = pdFALSE;
 
 		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 		{
+			traceSCHEDULER_RESUMED();
+
 			if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
 			{
 				/* Move any readied tasks from the pending list into the
@@ -2301,16 +3693,49 @@ BaseType_t xAlreadyYielded = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_64_BIT_TICKS == 1 )
+
+	static TickType_t prvReadTickCount( void )
+	{
+	const volatile uint32_t * const pulTickCount = ( const volatile uint32_t * ) &xTickCount;
+	uint32_t ulHigh, ulLow;
+
+		/* The tick count is only written by the tick interrupt, or with it
+		masked, and the write masks the interrupts that can call the API, so a
+		read never sees half a write.  But a tick can come between the reads of
+		the two words: if the high word changed, the low word wrapped, so read
+		both again.  The words are in little endian order. */
+		do
+		{
+			ulHigh = pulTickCount[ 1 ];
+			ulLow = pulTickCount[ 0 ];
+		} while( ulHigh != pulTickCount[ 1 ] );
+
+		return ( ( ( TickType_t ) ulHigh ) << 32 ) | ( TickType_t ) ulLow;
+	}
+
+#endif /* configUSE_64_BIT_TICKS */
+/*-----------------------------------------------------------*/
+
 TickType_t xTaskGetTickCount( void )
 {
 TickType_t xTicks;
 
-	/* Critical section required if running on a 16 bit processor. */
-	portTICK_TYPE_ENTER_CRITICAL();
+	#if( configUSE_64_BIT_TICKS == 1 )
+	{
+		/* No critical section: see prvReadTickCount(). */
+		xTicks = prvReadTickCount();
+	}
+	#else
 	{
-		xTicks = xTickCount;
+		/* Critical section required if running on a 16 bit processor. */
+		portTICK_TYPE_ENTER_CRITICAL();
+		{
+			xTicks = xTickCount;
+		}
+		portTICK_TYPE_EXIT_CRITICAL();
 	}
-	portTICK_TYPE_EXIT_CRITICAL();
+	#endif /* configUSE_64_BIT_TICKS */
 
 	return xTicks;
 }
@@ -2319,7 +3744,9 @@ TickType_t xTicks;
 TickType_t xTaskGetTickCountFromISR( void )
 {
 TickType_t xReturn;
-UBaseType_t uxSavedInterruptStatus;
+#if( configUSE_64_BIT_TICKS == 0 )
+	UBaseType_t uxSavedInterruptStatus;
+#endif
 
 	/* RTOS ports that support interrupt nesting have the concept of a maximum
 	system call (or maximum API call) interrupt priority.  Interrupts that are
@@ -2337,11 +3764,19 @@ UBaseType_t uxSavedInterruptStatus;
 	link: https://www.freertos.org/RTOS-Cortex-M3-M4.html */
 	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-	uxSavedInterruptStatus = portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR();
+	#if( configUSE_64_BIT_TICKS == 1 )
+	{
+		xReturn = prvReadTickCount();
+	}
+	#else
 	{
-		xReturn = xTickCount;
+		uxSavedInterruptStatus = portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR();
+		{
+			xReturn = xTickCount;
+		}
+		portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 	}
-	portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	#endif /* configUSE_64_BIT_TICKS */
 
 	return xReturn;
 }
@@ -2363,7 +3798,7 @@ TCB_t *pxTCB;
 	queried. */
 	pxTCB = prvGetTCBFromHandle( xTaskToQuery );
 	configASSERT( pxTCB );
-	return &( pxTCB->pcTaskName[ 0 ] );
+	return ( char * ) &( pxTCB->pcTaskName[ 0 ] ); /*lint !e9005 The name is not written through the pointer. */
 }
 /*-----------------------------------------------------------*/
 
@@ -2445,6 +3880,31 @@ TCB_t *pxTCB;
 		/* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
 		configASSERT( strlen( pcNameToQuery ) < configMAX_TASK_NAME_LEN );
 
+		#if( configUSE_TASK_NAME_INDEX == 1 )
+		{
+		uint32_t ulHash = prvTaskNameHash( pcNameToQuery );
+		BaseType_t xIndexComplete;
+
+			taskENTER_CRITICAL();
+			{
+				pxTCB = prvFindTaskName( ulHash, pcNameToQuery );
+
+				/* Only tasks the index had no room for need the lists. */
+				xIndexComplete = ( uxTaskNamesNotIndexed == ( UBaseType_t ) 0U ) ? pdTRUE : pdFALSE;
+			}
+			taskEXIT_CRITICAL();
+
+			if( ( pxTCB != NULL ) || ( xIndexComplete != pdFALSE ) )
+			{
+				return pxTCB;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TASK_NAME_INDEX */
+
 		vTaskSuspendAll();
 		{
 			/* Search the ready lists. */
@@ -2462,15 +3922,28 @@ TCB_t *pxTCB;
 			} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 			/* Search the delayed lists. */
-			if( pxTCB == NULL )
+			#if( configUSE_DELAYED_TASK_WHEEL == 0 )
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
-			}
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+				}
 
-			if( pxTCB == NULL )
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+				}
+			}
+			#else
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+			UBaseType_t uxSlot;
+
+				for( uxSlot = ( UBaseType_t ) 0; ( pxTCB == NULL ) && ( uxSlot < ( UBaseType_t ) configDELAYED_TASK_WHEEL_SLOTS ); uxSlot++ )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( &( xDelayedTaskWheel[ uxSlot ] ), pcNameToQuery );
+				}
 			}
+			#endif
 
 			#if ( INCLUDE_vTaskSuspend == 1 )
 			{
@@ -2500,9 +3973,27 @@ TCB_t *pxTCB;
 #endif /* INCLUDE_xTaskGetHandle */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_NAME_INDEX == 1 )
+
+	TaskHandle_t xTaskGetHandleByHash( uint32_t ulNameHash )
+	{
+	TCB_t *pxTCB;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvFindTaskName( ulNameHash, NULL );
+		}
+		taskEXIT_CRITICAL();
+
+		return pxTCB;
+	}
+
+#endif /* configUSE_TASK_NAME_INDEX */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TRACE_FACILITY == 1 )
 
-	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime )
+	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
 	{
 	UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
 
@@ -2522,8 +4013,21 @@ TCB_t *pxTCB;
 
 				/* Fill in an TaskStatus_t structure with information on each
 				task in the Blocked state. */
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+				{
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				}
+				#else
+				{
+				UBaseType_t uxSlot;
+
+					for( uxSlot = ( UBaseType_t ) 0; uxSlot < ( UBaseType_t ) configDELAYED_TASK_WHEEL_SLOTS; uxSlot++ )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel[ uxSlot ] ), eBlocked );
+					}
+				}
+				#endif
 
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
@@ -2574,7 +4078,82 @@ TCB_t *pxTCB;
 #endif /* configUSE_TRACE_FACILITY */
 /*----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+#if( configUSE_TASK_SNAPSHOTS == 1 )
+
+	void vTaskSnapshotStart( TaskSnapshot_t * const pxSnapshot )
+	{
+		configASSERT( pxSnapshot );
+
+		/* Tasks are only created and deleted by tasks, so neither the list nor
+		uxTaskNumber can change while the scheduler is suspended. */
+		vTaskSuspendAll();
+		{
+			pxSnapshot->uxGeneration = uxTaskNumber;
+			pxSnapshot->pvNext = ( void * ) listGET_HEAD_ENTRY( &xAllTasksList );
+
+			#if ( configGENERATE_RUN_TIME_STATS == 1 )
+			{
+				#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+					portALT_GET_RUN_TIME_COUNTER_VALUE( pxSnapshot->ulTotalRunTime );
+				#else
+					pxSnapshot->ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+				#endif
+			}
+			#endif
+		}
+		( void ) xTaskResumeAll();
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxTaskSnapshotNext( TaskSnapshot_t * const pxSnapshot, TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, const BaseType_t xGetFreeStackSpace )
+	{
+	UBaseType_t uxTask = 0;
+	ListItem_t const * pxItem;
+
+		configASSERT( pxSnapshot );
+		configASSERT( ( pxTaskStatusArray != NULL ) || ( uxArraySize == ( UBaseType_t ) 0 ) );
+
+		/* The scheduler is only suspended for uxArraySize tasks, and
+		interrupts stay enabled. */
+		vTaskSuspendAll();
+		{
+			/* If a task was created or deleted since the snapshot started,
+			pvNext may be the list item of a freed TCB: stop there. */
+			if( pxSnapshot->uxGeneration == uxTaskNumber )
+			{
+				pxItem = ( ListItem_t const * ) pxSnapshot->pvNext;
+
+				while( ( uxTask < uxArraySize ) && ( pxItem != listGET_END_MARKER( &xAllTasksList ) ) )
+				{
+					vTaskGetInfo( ( TaskHandle_t ) listGET_LIST_ITEM_OWNER( pxItem ), &( pxTaskStatusArray[ uxTask ] ), xGetFreeStackSpace, eInvalid );
+					uxTask++;
+					pxItem = listGET_NEXT( pxItem );
+				}
+
+				pxSnapshot->pvNext = ( void * ) pxItem;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return uxTask;
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xTaskSnapshotChanged( const TaskSnapshot_t * const pxSnapshot )
+	{
+		configASSERT( pxSnapshot );
+
+		return ( pxSnapshot->uxGeneration != uxTaskNumber ) ? pdTRUE : pdFALSE;
+	}
+
+#endif /* configUSE_TASK_SNAPSHOTS */
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 
 	TaskHandle_t xTaskGetIdleTaskHandle( void )
 	{
@@ -2624,6 +4203,57 @@ BaseType_t xYieldRequired = pdFALSE;
 }
 /*----------------------------------------------------------*/
 
+#if( INCLUDE_xTaskGetTicksToNextWake == 1 )
+
+	TickType_t xTaskGetTicksToNextWake( UBaseType_t uxMinPriority )
+	{
+	TickType_t xTicksToWake = portMAX_DELAY;
+
+		/* With the scheduler suspended the tick interrupt only counts
+		xPendedTicks, and no task leaves the delayed lists. */
+		vTaskSuspendAll();
+		{
+			#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+			{
+				/* The wake times are taken relative to xTickCount, so the
+				overflow list gives the right distance too. */
+				xTicksToWake = prvGetTicksToWakeWithinList( pxDelayedTaskList, uxMinPriority, xTicksToWake, pdTRUE );
+				xTicksToWake = prvGetTicksToWakeWithinList( pxOverflowDelayedTaskList, uxMinPriority, xTicksToWake, pdTRUE );
+			}
+			#else
+			{
+			UBaseType_t uxSlot;
+
+				for( uxSlot = ( UBaseType_t ) 0U; uxSlot < ( UBaseType_t ) configDELAYED_TASK_WHEEL_SLOTS; uxSlot++ )
+				{
+					xTicksToWake = prvGetTicksToWakeWithinList( &( xDelayedTaskWheel[ uxSlot ] ), uxMinPriority, xTicksToWake, pdFALSE );
+				}
+			}
+			#endif
+
+			/* Ticks pended while the scheduler is suspended have passed
+			already. */
+			if( xTicksToWake == portMAX_DELAY )
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+			else if( xTicksToWake > xPendedTicks )
+			{
+				xTicksToWake -= xPendedTicks;
+			}
+			else
+			{
+				xTicksToWake = ( TickType_t ) 0U;
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return xTicksToWake;
+	}
+
+#endif /* INCLUDE_xTaskGetTicksToNextWake */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskAbortDelay == 1 )
 
 	BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
@@ -2678,7 +4308,7 @@ BaseType_t xYieldRequired = pdFALSE;
 					/* Preemption is on, but a context switch should only be
 					performed if the unblocked task has a priority that is
 					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					if( taskPREEMPTS_CURRENT( pxTCB ) != pdFALSE )
 					{
 						/* Pend the yield to be performed when the scheduler
 						is unsuspended. */
@@ -2704,7 +4334,7 @@ BaseType_t xYieldRequired = pdFALSE;
 #endif /* INCLUDE_xTaskAbortDelay */
 /*----------------------------------------------------------*/
 
-BaseType_t xTaskIncrementTick( void )
+KERNEL_RAM_FUNCTION BaseType_t xTaskIncrementTick( void )
 {
 TCB_t * pxTCB;
 TickType_t xItemValue;
@@ -2714,94 +4344,85 @@ BaseType_t xSwitchRequired = pdFALSE;
 	Increments the tick then checks to see if the new tick value will cause any
 	tasks to be unblocked. */
 	traceTASK_INCREMENT_TICK( xTickCount );
+
+	#if( configUSE_TICK_STATS == 1 )
+	{
+		/* Counted by prvUnblockDelayedTask(), recorded by
+		vTaskRecordTickStats() if this call is the tick interrupt's. */
+		ulTickUnblocked = 0UL;
+	}
+	#endif /* configUSE_TICK_STATS */
+
 	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 	{
 		/* Minor optimisation.  The tick count cannot change in this
 		block. */
 		const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
 
-		/* Increment the RTOS tick, switching the delayed and overflowed
-		delayed lists if it wraps to 0. */
-		xTickCount = xConstTickCount;
-
-		if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
-		{
-			taskSWITCH_DELAYED_LISTS();
-		}
-		else
+		#if( configUSE_DELAYED_TASK_WHEEL == 0 )
 		{
-			mtCOVERAGE_TEST_MARKER();
-		}
+			/* Increment the RTOS tick, switching the delayed and overflowed
+			delayed lists if it wraps to 0.  A 64-bit tick count never
+			wraps. */
+			xTickCount = xConstTickCount;
 
-		/* See if this tick has made a timeout expire.  Tasks are stored in
-		the	queue in the order of their wake time - meaning once one task
-		has been found whose block time has not expired there is no need to
-		look any further down the list. */
-		if( xConstTickCount >= xNextTaskUnblockTime )
-		{
-			for( ;; )
+			#if( configUSE_64_BIT_TICKS == 0 )
 			{
-				if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+				if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
 				{
-					/* The delayed list is empty.  Set xNextTaskUnblockTime
-					to the maximum possible value so it is extremely
-					unlikely that the
-					if( xTickCount >= xNextTaskUnblockTime ) test will pass
-					next time through. */
-					xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-					break;
+					taskSWITCH_DELAYED_LISTS();
 				}
 				else
 				{
-					/* The delayed list is not empty, get the value of the
-					item at the head of the delayed list.  This is the time
-					at which the task at the head of the delayed list must
-					be removed from the Blocked state. */
-					pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-					xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
-
-					if( xConstTickCount < xItemValue )
-					{
-						/* It is not time to unblock this item yet, but the
-						item value is the time at which the task at the head
-						of the blocked list must be removed from the Blocked
-						state -	so record the item value in
-						xNextTaskUnblockTime. */
-						xNextTaskUnblockTime = xItemValue;
-						break; /*lint !e9011 Code structure here is deedmed easier to understand with multiple breaks. */
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-
-					/* It is time to remove the item from the Blocked state. */
-					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_64_BIT_TICKS */
 
-					/* Is the task waiting on an event also?  If so remove
-					it from the event list. */
-					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+			/* See if this tick has made a timeout expire.  Tasks are stored in
+			the	queue in the order of their wake time - meaning once one task
+			has been found whose block time has not expired there is no need to
+			look any further down the list. */
+			if( xConstTickCount >= xNextTaskUnblockTime )
+			{
+				for( ;; )
+				{
+					if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
 					{
-						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+						/* The delayed list is empty.  Set xNextTaskUnblockTime
+						to the maximum possible value so it is extremely
+						unlikely that the
+						if( xTickCount >= xNextTaskUnblockTime ) test will pass
+						next time through. */
+						xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+						break;
 					}
 					else
 					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-
-					/* Place the unblocked task into the appropriate ready
-					list. */
-					prvAddTaskToReadyList( pxTCB );
+						/* The delayed list is not empty, get the value of the
+						item at the head of the delayed list.  This is the time
+						at which the task at the head of the delayed list must
+						be removed from the Blocked state. */
+						pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+						xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+						if( xConstTickCount < xItemValue )
+						{
+							/* It is not time to unblock this item yet, but the
+							item value is the time at which the task at the head
+							of the blocked list must be removed from the Blocked
+							state -	so record the item value in
+							xNextTaskUnblockTime. */
+							xNextTaskUnblockTime = xItemValue;
+							break; /*lint !e9011 Code structure here is deedmed easier to understand with multiple breaks. */
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
 
-					/* A task being unblocked cannot cause an immediate
-					context switch if preemption is turned off. */
-					#if (  configUSE_PREEMPTION == 1 )
-					{
-						/* Preemption is on, but a context switch should
-						only be performed if the unblocked task has a
-						priority that is equal to or higher than the
-						currently executing task. */
-						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						/* It is time to remove the item from the Blocked state. */
+						if( prvUnblockDelayedTask( pxTCB ) != pdFALSE )
 						{
 							xSwitchRequired = pdTRUE;
 						}
@@ -2810,19 +4431,99 @@ BaseType_t xSwitchRequired = pdFALSE;
 							mtCOVERAGE_TEST_MARKER();
 						}
 					}
-					#endif /* configUSE_PREEMPTION */
 				}
 			}
 		}
+		#else
+		{
+		List_t * const pxSlot = taskWHEEL_SLOT( xConstTickCount );
+		ListItem_t *pxItem, *pxNextItem;
+
+			/* Increment the RTOS tick.  The wheel needs nothing doing when it
+			wraps to 0 but the timeouts count the overflows. */
+			xTickCount = xConstTickCount;
+
+			#if( configUSE_64_BIT_TICKS == 0 )
+			{
+				if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+				{
+					xNumOfOverflows++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_64_BIT_TICKS */
+
+			/* Only the tasks in the slot of this tick can wake now.  Those in
+			it that wake on a later lap of the wheel are left where they are. */
+			pxItem = listGET_HEAD_ENTRY( pxSlot );
+
+			while( pxItem != listGET_END_MARKER( pxSlot ) )
+			{
+				pxNextItem = listGET_NEXT( pxItem );
+
+				xItemValue = listGET_LIST_ITEM_VALUE( pxItem );
+
+				if( xItemValue == xConstTickCount )
+				{
+					pxTCB = listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+					if( prvUnblockDelayedTask( pxTCB ) != pdFALSE )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxItem = pxNextItem;
+			}
+		}
+		#endif /* configUSE_DELAYED_TASK_WHEEL */
 
 		/* Tasks of equal priority to the currently running task will share
 		processing time (time slice) if preemption is on, and the application
 		writer has not explicitly turned time slicing off. */
 		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
 		{
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			#if( configUSE_EDF_SCHEDULING == 1 )
+				/* The EDF band is not time sliced. */
+				&& ( pxCurrentTCB->uxPriority != ( UBaseType_t ) configEDF_PRIORITY )
+			#endif
+			#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+				/* Nor is a task running above its priority. */
+				&& ( taskPREEMPTION_LEVEL() == pxCurrentTCB->uxPriority )
+			#endif
+				)
 			{
-				xSwitchRequired = pdTRUE;
+				#if( configUSE_TASK_TIME_SLICE_QUANTA == 1 )
+				{
+					/* Switch only once the running task has used up its own
+					quantum, and give it a whole one for its next turn. */
+					if( pxCurrentTCB->xTimeSliceLeft > ( TickType_t ) 1 )
+					{
+						pxCurrentTCB->xTimeSliceLeft--;
+					}
+					else
+					{
+						pxCurrentTCB->xTimeSliceLeft = pxCurrentTCB->xTimeSlice;
+						xSwitchRequired = pdTRUE;
+					}
+				}
+				#else
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				#endif /* configUSE_TASK_TIME_SLICE_QUANTA */
 			}
 			else
 			{
@@ -2831,6 +4532,19 @@ BaseType_t xSwitchRequired = pdFALSE;
 		}
 		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
+		#if( configUSE_TASK_BUDGETS == 1 )
+		{
+			if( prvBudgetTick( xConstTickCount ) != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TASK_BUDGETS */
+
 		#if ( configUSE_TICK_HOOK == 1 )
 		{
 			/* Guard against the tick hook being called when the pended tick
@@ -2986,8 +4700,13 @@ BaseType_t xSwitchRequired = pdFALSE;
 #endif /* configUSE_APPLICATION_TASK_TAG */
 /*-----------------------------------------------------------*/
 
-void vTaskSwitchContext( void )
+KERNEL_RAM_FUNCTION void vTaskSwitchContext( void )
 {
+#if( configUSE_SWITCH_STATS == 1 )
+	TCB_t *pxSwitchedOutTCB;
+	BaseType_t xVoluntary;
+#endif
+
 	if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
 	{
 		/* The scheduler is currently suspended - do not allow a context
@@ -2997,6 +4716,17 @@ void vTaskSwitchContext( void )
 	else
 	{
 		xYieldPending = pdFALSE;
+
+		#if( configUSE_TASK_FPU_DECLARATION == 1 )
+		{
+			/* The task being switched out executed a floating point
+			instruction without having been declared as using the FPU.  Its
+			context switches now save and restore S16-S31, and its stack must
+			hold the larger FPU frame, neither of which it was sized for. */
+			configASSERT( ( pxCurrentTCB->ucUsesFPU != pdFALSE ) || ( portTASK_HAS_FPU_CONTEXT( pxCurrentTCB->pxTopOfStack ) == pdFALSE ) );
+		}
+		#endif /* configUSE_TASK_FPU_DECLARATION */
+
 		traceTASK_SWITCHED_OUT();
 
 		#if ( configGENERATE_RUN_TIME_STATS == 1 )
@@ -3036,57 +4766,219 @@ void vTaskSwitchContext( void )
 		}
 		#endif
 
-		/* Select a new task to run using either the generic C or port
-		optimised asm code. */
-		taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-		traceTASK_SWITCHED_IN();
+		#if( configUSE_TASK_TIME_SLICE_QUANTA == 1 )
+		{
+			/* A task leaving the Ready state starts its next turn with a whole
+			quantum.  One preempted while ready keeps what it has left, so that
+			frequent preemption cannot keep its peers from their turn. */
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ), &( pxCurrentTCB->xStateListItem ) ) == pdFALSE )
+			{
+				pxCurrentTCB->xTimeSliceLeft = pxCurrentTCB->xTimeSlice;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TASK_TIME_SLICE_QUANTA */
 
-		/* After the new task is switched in, update the global errno. */
-		#if( configUSE_POSIX_ERRNO == 1 )
+		#if( configUSE_SWITCH_STATS == 1 )
 		{
-			FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+			/* A task that left the Ready state blocked, suspended or deleted
+			itself.  One still ready was preempted or ran out of time, unless
+			it called taskYIELD(). */
+			pxSwitchedOutTCB = pxCurrentTCB;
+			xVoluntary = ( ( xYieldIsVoluntary != pdFALSE ) || ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ), &( pxCurrentTCB->xStateListItem ) ) == pdFALSE ) ) ? pdTRUE : pdFALSE;
+			xYieldIsVoluntary = pdFALSE;
 		}
-		#endif
+		#endif /* configUSE_SWITCH_STATS */
 
-		#if ( configUSE_NEWLIB_REENTRANT == 1 )
+		#if( configUSE_QUIESCENT_STATES == 1 )
 		{
-			/* Switch Newlib's _impure_ptr variable to point to the _reent
-			structure specific to this task.
-			See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
-			for additional information. */
-			_impure_ptr = &( pxCurrentTCB->xNewLib_reent );
+			/* A task that blocked, suspended or deleted itself holds no
+			reference it read before (see ulTaskGracePeriodStart()).  One
+			preempted while ready may be in the middle of using one. */
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ), &( pxCurrentTCB->xStateListItem ) ) == pdFALSE )
+			{
+				pxCurrentTCB->ulQuiescentEpoch = ulGraceEpoch;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
-		#endif /* configUSE_NEWLIB_REENTRANT */
-	}
-}
-/*-----------------------------------------------------------*/
+		#endif /* configUSE_QUIESCENT_STATES */
 
-void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait )
-{
-	configASSERT( pxEventList );
+		#if( configUSE_TASK_BUDGETS == 1 )
+		{
+			/* ulRunTimeCounter has just been charged, so an overrun since the
+			last tick is handled before the task can be selected again. */
+			if( ( pxCurrentTCB->ulBudget != 0 ) &&
+				( ( pxCurrentTCB->ucBudgetState & ( taskBUDGET_DEMOTED | taskBUDGET_SUSPENDED ) ) == 0U ) &&
+				( ( pxCurrentTCB->ulRunTimeCounter - pxCurrentTCB->ulBudgetBase ) >= pxCurrentTCB->ulBudget ) )
+			{
+				( void ) prvBudgetOverrun( pxCurrentTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TASK_BUDGETS */
 
-	/* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
-	SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+		#if( configUSE_JOB_STATS == 1 )
+		{
+			/* A task that left the Ready state has ended its job, and
+			ulRunTimeCounter has just been charged with its last slice. */
+			if( ( ( pxCurrentTCB->ucJobState & taskJOB_ACTIVE ) != 0U ) &&
+				( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ), &( pxCurrentTCB->xStateListItem ) ) == pdFALSE ) )
+			{
+				if( ( pxCurrentTCB->ucJobState & taskJOB_COUNTED ) != 0U )
+				{
+				configRUN_TIME_COUNTER_TYPE ulExec = pxCurrentTCB->ulRunTimeCounter - pxCurrentTCB->ulJobRunBase;
 
-	/* Place the event list item of the TCB in the appropriate event list.
-	This is placed in the list in priority order so the highest priority task
-	is the first to be woken by the event.  The queue that contains the event
-	list is locked, preventing simultaneous access from interrupts. */
-	vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+					if( ulExec > pxCurrentTCB->ulJobExecMax )
+					{
+						pxCurrentTCB->ulJobExecMax = ulExec;
+					}
+					pxCurrentTCB->ulJobExecTotal += ulExec;
+					pxCurrentTCB->ulJobsDone++;
+				}
 
-	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-}
-/*-----------------------------------------------------------*/
+				pxCurrentTCB->ucJobState &= ( uint8_t ) ~taskJOB_ACTIVE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_JOB_STATS */
 
-void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xItemValue, const TickType_t xTicksToWait )
-{
-	configASSERT( pxEventList );
+		#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+		{
+			/* A task switched out while still ready and running above its
+			priority was preempted by a task above its threshold, or merely
+			yielded or ran out of time.  Either way it is to get the processor
+			back before any task at or below its threshold, unless it has just
+			been demoted for overrunning its budget. */
+			if( ( taskLEVEL_OF( pxCurrentTCB ) > pxCurrentTCB->uxPriority ) &&
+			#if( configUSE_TASK_BUDGETS == 1 )
+				( ( pxCurrentTCB->ucBudgetState & taskBUDGET_DEMOTED ) == 0U ) &&
+			#endif
+				( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ), &( pxCurrentTCB->xStateListItem ) ) != pdFALSE ) )
+			{
+				pxCurrentTCB->pxThresholdNext = pxThresholdPreempted;
+				pxThresholdPreempted = pxCurrentTCB;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-	the event groups implementation. */
-	configASSERT( uxSchedulerSuspended != 0 );
+			if( prvThresholdSelect() == pdFALSE )
+			{
+				taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-	/* Store the item value in the event list item.  It is safe to access the
+				/* Inheritance can make a task below the first one preempted
+				the highest priority ready task. */
+				if( pxThresholdPreempted != NULL )
+				{
+					prvThresholdForget( pxCurrentTCB );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
+		{
+			/* Select a new task to run using either the generic C or port
+			optimised asm code. */
+			taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		}
+		#endif /* configUSE_PREEMPTION_THRESHOLD */
+		traceTASK_SWITCHED_IN();
+
+		#if( configUSE_SWITCH_STATS == 1 )
+		{
+			if( pxCurrentTCB != pxSwitchedOutTCB )
+			{
+				ulSwitchCount++;
+
+				if( xVoluntary != pdFALSE )
+				{
+					pxSwitchedOutTCB->ulVoluntarySwitches++;
+				}
+				else
+				{
+					pxSwitchedOutTCB->ulInvoluntarySwitches++;
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_SWITCH_STATS */
+
+		#if( configUSE_MPU_STACK_GUARD == 1 )
+		{
+			/* Move the guard under the stack of the task switched in. */
+			portSET_STACK_GUARD( pxCurrentTCB->pxStack );
+		}
+		#endif
+
+		/* After the new task is switched in, update the global errno. */
+		#if( configUSE_POSIX_ERRNO == 1 )
+		{
+			FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+		}
+		#endif
+
+		#if ( configUSE_NEWLIB_REENTRANT == 1 )
+		{
+			/* Switch Newlib's _impure_ptr variable to point to the _reent
+			structure specific to this task.
+			See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
+			for additional information. */
+			_impure_ptr = &( pxCurrentTCB->xNewLib_reent );
+		}
+		#endif /* configUSE_NEWLIB_REENTRANT */
+	}
+}
+/*-----------------------------------------------------------*/
+
+KERNEL_RAM_FUNCTION void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait )
+{
+	configASSERT( pxEventList );
+
+	/* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
+	SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+
+	/* Place the event list item of the TCB in the appropriate event list.
+	This is placed in the list in priority order so the highest priority task
+	is the first to be woken by the event.  The queue that contains the event
+	list is locked, preventing simultaneous access from interrupts. */
+	vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xItemValue, const TickType_t xTicksToWait )
+{
+	configASSERT( pxEventList );
+
+	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+	the event groups implementation. */
+	configASSERT( uxSchedulerSuspended != 0 );
+
+	/* Store the item value in the event list item.  It is safe to access the
 	event list item here as interrupts won't access the event list item of a
 	task that is not in the Blocked state. */
 	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
@@ -3135,7 +5027,7 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xIte
 #endif /* configUSE_TIMERS */
 /*-----------------------------------------------------------*/
 
-BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
+KERNEL_RAM_FUNCTION BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
 {
 TCB_t *pxUnblockedTCB;
 BaseType_t xReturn;
@@ -3183,7 +5075,7 @@ BaseType_t xReturn;
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
 	}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskPREEMPTS_CURRENT( pxUnblockedTCB ) != pdFALSE )
 	{
 		/* Return true if the task removed from the event list has a higher
 		priority than the calling task.  This allows the calling task to know if
@@ -3240,7 +5132,7 @@ TCB_t *pxUnblockedTCB;
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskPREEMPTS_CURRENT( pxUnblockedTCB ) != pdFALSE )
 	{
 		/* The unblocked task has a priority above that of the calling task, so
 		a context switch is required.  This function is called with the
@@ -3251,6 +5143,63 @@ TCB_t *pxUnblockedTCB;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_EVENT_GROUPS_DIRECT_FROM_ISR == 1 )
+
+	BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue )
+	{
+	TCB_t *pxUnblockedTCB;
+	BaseType_t xReturn;
+
+		/* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION WITHIN AN ISR.
+		It is the interrupt version of vTaskRemoveFromUnorderedEventList(), used
+		when event groups set bits directly from interrupts.  Every task level
+		access to the event list is then also made from a critical section, so
+		exclusive access to it is guaranteed here.  The scheduler might be
+		suspended, so the ready lists are handled as in
+		xTaskRemoveFromEventList(). */
+		listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+		pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		configASSERT( pxUnblockedTCB );
+		( void ) uxListRemove( pxEventListItem );
+
+		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+		{
+			( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+			prvAddTaskToReadyList( pxUnblockedTCB );
+
+			#if( configUSE_TICKLESS_IDLE != 0 )
+			{
+				/* See xTaskRemoveFromEventList(). */
+				prvResetNextTaskUnblockTime();
+			}
+			#endif
+		}
+		else
+		{
+			/* The delayed and ready lists cannot be accessed, so hold this task
+			pending until the scheduler is resumed. */
+			vListInsertEnd( &( xPendingReadyList ), pxEventListItem );
+		}
+
+		if( taskPREEMPTS_CURRENT( pxUnblockedTCB ) != pdFALSE )
+		{
+			/* Mark that a yield is pending in case the user is not using the
+			"xHigherPriorityTaskWoken" parameter. */
+			xReturn = pdTRUE;
+			xYieldPending = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EVENT_GROUPS_DIRECT_FROM_ISR */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
 	configASSERT( pxTimeOut );
@@ -3263,7 +5212,7 @@ void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 }
 /*-----------------------------------------------------------*/
 
-void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
+KERNEL_RAM_FUNCTION void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
 	/* For internal use only as it does not use a critical section. */
 	pxTimeOut->xOverflowCount = xNumOfOverflows;
@@ -3271,7 +5220,7 @@ void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut, TickType_t * const pxTicksToWait )
+KERNEL_RAM_FUNCTION BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut, TickType_t * const pxTicksToWait )
 {
 BaseType_t xReturn;
 
@@ -3350,7 +5299,7 @@ void vTaskMissedYield( void )
 		if( xTask != NULL )
 		{
 			pxTCB = xTask;
-			uxReturn = pxTCB->uxTaskNumber;
+			uxReturn = taskGET_TASK_NUMBER( pxTCB );
 		}
 		else
 		{
@@ -3372,7 +5321,7 @@ void vTaskMissedYield( void )
 		if( xTask != NULL )
 		{
 			pxTCB = xTask;
-			pxTCB->uxTaskNumber = uxHandle;
+			taskSET_TASK_NUMBER( pxTCB, uxHandle );
 		}
 	}
 
@@ -3475,7 +5424,11 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 					/* Now the scheduler is suspended, the expected idle
 					time can be sampled again, and this time its value can
 					be used. */
-					configASSERT( xNextTaskUnblockTime >= xTickCount );
+					#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+					{
+						configASSERT( xNextTaskUnblockTime >= xTickCount );
+					}
+					#endif
 					xExpectedIdleTime = prvGetExpectedIdleTime();
 
 					/* Define the following macro to set xExpectedIdleTime to 0
@@ -3502,6 +5455,22 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 			}
 		}
 		#endif /* configUSE_TICKLESS_IDLE */
+
+		#if ( configUSE_IDLE_SLEEP == 1 )
+		{
+			/* Sleep until the next interrupt, unless another task at the idle
+			priority is ready to use the time.  An interrupt that readies a
+			task also ends the sleep, so the switch to it is not delayed. */
+			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) <= ( UBaseType_t ) 1 )
+			{
+				portIDLE_SLEEP();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_IDLE_SLEEP */
 	}
 }
 /*-----------------------------------------------------------*/
@@ -3588,6 +5557,37 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 #endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TASK_ARENAS == 1 )
+
+	void vTaskSetArena( TaskHandle_t xTask, ArenaHandle_t xArena )
+	{
+	TCB_t *pxTCB;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+		configASSERT( pxTCB != NULL );
+
+		/* Replacing an arena would leak it: detach it first. */
+		configASSERT( ( xArena == NULL ) || ( pxTCB->pxArena == NULL ) );
+		pxTCB->pxArena = xArena;
+	}
+
+#endif /* configUSE_TASK_ARENAS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_ARENAS == 1 )
+
+	ArenaHandle_t xTaskGetArena( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		return pxTCB->pxArena;
+	}
+
+#endif /* configUSE_TASK_ARENAS */
+/*-----------------------------------------------------------*/
+
 #if ( portUSING_MPU_WRAPPERS == 1 )
 
 	void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify, const MemoryRegion_t * const xRegions )
@@ -3613,8 +5613,22 @@ UBaseType_t uxPriority;
 		vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
 	}
 
-	vListInitialise( &xDelayedTaskList1 );
-	vListInitialise( &xDelayedTaskList2 );
+	#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+	{
+		vListInitialise( &xDelayedTaskList1 );
+		vListInitialise( &xDelayedTaskList2 );
+	}
+	#else
+	{
+	UBaseType_t uxSlot;
+
+		for( uxSlot = ( UBaseType_t ) 0U; uxSlot < ( UBaseType_t ) configDELAYED_TASK_WHEEL_SLOTS; uxSlot++ )
+		{
+			vListInitialise( &( xDelayedTaskWheel[ uxSlot ] ) );
+		}
+	}
+	#endif
+
 	vListInitialise( &xPendingReadyList );
 
 	#if ( INCLUDE_vTaskDelete == 1 )
@@ -3629,17 +5643,34 @@ UBaseType_t uxPriority;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 
-	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-	using list2. */
-	pxDelayedTaskList = &xDelayedTaskList1;
-	pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	#if( configUSE_TASK_SNAPSHOTS == 1 )
+	{
+		vListInitialise( &xAllTasksList );
+	}
+	#endif /* configUSE_TASK_SNAPSHOTS */
+
+	#if( configUSE_TASK_BUDGETS == 1 )
+	{
+		vListInitialise( &xBudgetTaskList );
+	}
+	#endif /* configUSE_TASK_BUDGETS */
+
+	#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+	{
+		/* Start with pxDelayedTaskList using list1 and the
+		pxOverflowDelayedTaskList using list2. */
+		pxDelayedTaskList = &xDelayedTaskList1;
+		pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
 static void prvCheckTasksWaitingTermination( void )
 {
 
-	/** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
+	/** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK, AND FROM THE REAPER
+	TASK AND xTaskCreate() WITH configUSE_TASK_REAPER **/
 
 	#if ( INCLUDE_vTaskDelete == 1 )
 	{
@@ -3665,6 +5696,63 @@ static void prvCheckTasksWaitingTermination( void )
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TASK_REAPER == 1 )
+
+	static portTASK_FUNCTION( prvReaperTask, pvParameters )
+	{
+		/* Stop warnings. */
+		( void ) pvParameters;
+
+		for( ;; )
+		{
+			/* One notification may stand for several deleted tasks. */
+			( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+			prvCheckTasksWaitingTermination();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvCreateReaperTask( void )
+	{
+	BaseType_t xReturn = pdFAIL;
+
+		#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+			/* Allocated statically here, in case configSUPPORT_DYNAMIC_ALLOCATION
+			is 0, as the extra timer daemons are. */
+			static StaticTask_t xReaperTaskTCB; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+			static StackType_t xReaperTaskStack[ configTASK_REAPER_STACK_DEPTH ]; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+
+			xReaperTaskHandle = xTaskCreateStatic(	prvReaperTask,
+													"Reaper",
+													configTASK_REAPER_STACK_DEPTH,
+													NULL,
+													( ( UBaseType_t ) configTASK_REAPER_PRIORITY ) | portPRIVILEGE_BIT,
+													xReaperTaskStack,
+													&xReaperTaskTCB );
+
+			if( xReaperTaskHandle != NULL )
+			{
+				xReturn = pdPASS;
+			}
+		}
+		#else
+		{
+			xReturn = xTaskCreate(	prvReaperTask,
+									"Reaper",
+									configTASK_REAPER_STACK_DEPTH,
+									NULL,
+									( ( UBaseType_t ) configTASK_REAPER_PRIORITY ) | portPRIVILEGE_BIT,
+									&xReaperTaskHandle );
+		}
+		#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TASK_REAPER */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_TRACE_FACILITY == 1 )
 
 	void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace, eTaskState eState )
@@ -3678,7 +5766,7 @@ static void prvCheckTasksWaitingTermination( void )
 		pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName [ 0 ] );
 		pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
 		pxTaskStatus->pxStackBase = pxTCB->pxStack;
-		pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
+		pxTaskStatus->xTaskNumber = taskGET_TCB_NUMBER( pxTCB );
 
 		#if ( configUSE_MUTEXES == 1 )
 		{
@@ -3700,6 +5788,13 @@ static void prvCheckTasksWaitingTermination( void )
 		}
 		#endif
 
+		#if ( configUSE_SWITCH_STATS == 1 )
+		{
+			pxTaskStatus->ulVoluntarySwitches = pxTCB->ulVoluntarySwitches;
+			pxTaskStatus->ulInvoluntarySwitches = pxTCB->ulInvoluntarySwitches;
+		}
+		#endif
+
 		/* Obtaining the task state is a little fiddly, so is only done if the
 		value of eState passed into this function is eInvalid - otherwise the
 		state is just set to whatever is passed in. */
@@ -3748,7 +5843,7 @@ static void prvCheckTasksWaitingTermination( void )
 			}
 			#else
 			{
-				pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+				pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( taskSTACK_CHECK_START( pxTCB ) );
 			}
 			#endif
 		}
@@ -3838,7 +5933,7 @@ static void prvCheckTasksWaitingTermination( void )
 
 		#if portSTACK_GROWTH < 0
 		{
-			pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+			pucEndOfStack = taskSTACK_CHECK_START( pxTCB );
 		}
 		#else
 		{
@@ -3866,7 +5961,7 @@ static void prvCheckTasksWaitingTermination( void )
 
 		#if portSTACK_GROWTH < 0
 		{
-			pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+			pucEndOfStack = taskSTACK_CHECK_START( pxTCB );
 		}
 		#else
 		{
@@ -3882,6 +5977,23 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_uxTaskGetStackHighWaterMark */
 /*-----------------------------------------------------------*/
 
+#if ( ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) && ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) ) )
+
+	UBaseType_t uxTaskGetStackDepth( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		/* pxStack is the lowest word and pxEndOfStack the highest usable one,
+		whichever way the stack grows.  When the stack grows down the top is
+		aligned, so the depth can be a word less than the one requested. */
+		return ( UBaseType_t ) ( pxTCB->pxEndOfStack - pxTCB->pxStack ) + ( UBaseType_t ) 1;
+	}
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark && ( portSTACK_GROWTH > 0 || configRECORD_STACK_HIGH_ADDRESS ) */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskDelete == 1 )
 
 	static void prvDeleteTCB( TCB_t *pxTCB )
@@ -3891,6 +6003,12 @@ static void prvCheckTasksWaitingTermination( void )
 		want to allocate and clean RAM statically. */
 		portCLEAN_UP_TCB( pxTCB );
 
+		#if( taskUSE_DIAGNOSTICS_TABLE == 1 )
+		{
+			prvReleaseTaskDiagnostics( pxTCB );
+		}
+		#endif
+
 		/* Free up the memory allocated by the scheduler for the task.  It is up
 		to the task to free any memory allocated at the application level.
 		See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
@@ -3901,6 +6019,22 @@ static void prvCheckTasksWaitingTermination( void )
 		}
 		#endif /* configUSE_NEWLIB_REENTRANT */
 
+		/* Everything the task allocated from its arena goes in one go, before
+		the stack the pointers to it may still be on. */
+		#if( configUSE_TASK_ARENAS == 1 )
+		{
+			if( pxTCB->pxArena != NULL )
+			{
+				vArenaDelete( pxTCB->pxArena );
+				pxTCB->pxArena = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
 		{
 			/* The task can only have been allocated dynamically - free both
@@ -3940,223 +6074,370 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-static void prvResetNextTaskUnblockTime( void )
+static BaseType_t prvUnblockDelayedTask( TCB_t * const pxTCB )
 {
-TCB_t *pxTCB;
+BaseType_t xSwitchRequired = pdFALSE;
 
-	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+	( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+	/* Is the task waiting on an event also?  If so remove it from the event
+	list. */
+	if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
 	{
-		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-		the maximum possible value so it is	extremely unlikely that the
-		if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-		there is an item in the delayed list. */
-		xNextTaskUnblockTime = portMAX_DELAY;
+		( void ) uxListRemove( &( pxTCB->xEventListItem ) );
 	}
 	else
 	{
-		/* The new current delayed list is not empty, get the value of
-		the item at the head of the delayed list.  This is the time at
-		which the task at the head of the delayed list should be removed
-		from the Blocked state. */
-		( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+		mtCOVERAGE_TEST_MARKER();
 	}
-}
-/*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+	/* Place the unblocked task into the appropriate ready list. */
+	prvAddTaskToReadyList( pxTCB );
 
-	TaskHandle_t xTaskGetCurrentTaskHandle( void )
+	#if( configUSE_TICK_STATS == 1 )
 	{
-	TaskHandle_t xReturn;
-
-		/* A critical section is not required as this is not called from
-		an interrupt and the current TCB will always be the same for any
-		individual execution thread. */
-		xReturn = pxCurrentTCB;
-
-		return xReturn;
+		ulTickUnblocked++;
 	}
+	#endif /* configUSE_TICK_STATS */
 
-#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
-/*-----------------------------------------------------------*/
-
-#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
-
-	BaseType_t xTaskGetSchedulerState( void )
+	/* A task being unblocked cannot cause an immediate context switch if
+	preemption is turned off. */
+	#if (  configUSE_PREEMPTION == 1 )
 	{
-	BaseType_t xReturn;
-
-		if( xSchedulerRunning == pdFALSE )
+		/* Preemption is on, but a context switch should only be performed if
+		the unblocked task has a priority that is equal to or higher than the
+		currently executing task. */
+		if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
 		{
-			xReturn = taskSCHEDULER_NOT_STARTED;
+			xSwitchRequired = pdTRUE;
 		}
 		else
 		{
-			if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-			{
-				xReturn = taskSCHEDULER_RUNNING;
-			}
-			else
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_PREEMPTION */
+
+	return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	static void prvEdfInsertReady( TCB_t * const pxTCB )
+	{
+	List_t * const pxList = &( pxReadyTasksLists[ configEDF_PRIORITY ] );
+	ListItem_t * const pxNewListItem = &( pxTCB->xStateListItem );
+	ListItem_t *pxIterator;
+
+		/* Walk to the first task with a later deadline.  vListInsert() cannot
+		be used: the deadlines wrap with the tick count, so they are ordered by
+		their signed difference rather than by value. */
+		for( pxIterator = listGET_HEAD_ENTRY( pxList );
+			 pxIterator != ( ListItem_t * ) listGET_END_MARKER( pxList );
+			 pxIterator = listGET_NEXT( pxIterator ) ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM, as in list.c. */
+		{
+			if( taskEDF_IS_BEFORE( pxTCB->xEdfDeadline, ( ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) )->xEdfDeadline ) ) /*lint !e9079 Alignment is known to be fine as the owner is always a TCB. */
 			{
-				xReturn = taskSCHEDULER_SUSPENDED;
+				break;
 			}
 		}
 
-		return xReturn;
+		/* Insert in front of pxIterator, which may be the end marker. */
+		pxNewListItem->pxNext = pxIterator;
+		pxNewListItem->pxPrevious = pxIterator->pxPrevious;
+		pxIterator->pxPrevious->pxNext = pxNewListItem;
+		pxIterator->pxPrevious = pxNewListItem;
+		pxNewListItem->pxContainer = pxList;
+
+		( pxList->uxNumberOfItems )++;
 	}
 
-#endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
+#endif /* configUSE_EDF_SCHEDULING */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if( configUSE_TASK_BUDGETS == 1 )
 
-	BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+	static configRUN_TIME_COUNTER_TYPE prvBudgetRunTime( TCB_t const * const pxTCB, configRUN_TIME_COUNTER_TYPE ulNow )
 	{
-	TCB_t * const pxMutexHolderTCB = pxMutexHolder;
-	BaseType_t xReturn = pdFALSE;
+	configRUN_TIME_COUNTER_TYPE ulRunTime = pxTCB->ulRunTimeCounter;
 
-		/* If the mutex was given back by an interrupt while the queue was
-		locked then the mutex holder might now be NULL.  _RB_ Is this still
-		needed as interrupts can no longer use mutexes? */
-		if( pxMutexHolder != NULL )
+		/* The running task has not been charged yet for the time since it was
+		switched in.  The guard is the one vTaskSwitchContext() has. */
+		if( ( pxTCB == pxCurrentTCB ) && ( ulNow > ulTaskSwitchedInTime ) )
 		{
-			/* If the holder of the mutex has a priority below the priority of
-			the task attempting to obtain the mutex then it will temporarily
-			inherit the priority of the task attempting to obtain the mutex. */
-			if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
+			ulRunTime += ( ulNow - ulTaskSwitchedInTime );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return ulRunTime;
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	static BaseType_t prvBudgetOverrun( TCB_t * const pxTCB )
+	{
+	BaseType_t xSwitchRequired = pdFALSE;
+	UBaseType_t uxBasePriority;
+
+		if( ( pxTCB->ucBudgetState & taskBUDGET_OVERRUN ) == 0U )
+		{
+			pxTCB->ucBudgetState |= taskBUDGET_OVERRUN;
+			pxTCB->ulBudgetOverruns++;
+
+			#if( configUSE_TASK_BUDGET_HOOK == 1 )
 			{
-				/* Adjust the mutex holder state to account for its new
-				priority.  Only reset the event list item value if the value is
-				not being used for anything else. */
-				if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+				vApplicationTaskBudgetHook( pxTCB );
+			}
+			#endif
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if( configUSE_MUTEXES == 1 )
+		{
+			uxBasePriority = pxTCB->uxBasePriority;
+		}
+		#else
+		{
+			uxBasePriority = pxTCB->uxPriority;
+		}
+		#endif
+
+		if( ( pxTCB->ucBudgetAction == ( uint8_t ) eTaskBudgetDemote ) &&
+			( ( pxTCB->ucBudgetState & taskBUDGET_DEMOTED ) == 0U ) &&
+			( uxBasePriority > ( UBaseType_t ) configTASK_BUDGET_BACKGROUND_PRIORITY ) )
+		{
+			pxTCB->uxBudgetPriority = uxBasePriority;
+			pxTCB->ucBudgetState |= taskBUDGET_DEMOTED;
+			prvBudgetSetPriority( pxTCB, ( UBaseType_t ) configTASK_BUDGET_BACKGROUND_PRIORITY );
+
+			if( pxTCB == pxCurrentTCB )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#if( INCLUDE_vTaskSuspend == 1 )
+			else if( ( pxTCB->ucBudgetAction == ( uint8_t ) eTaskBudgetSuspend ) &&
+					 ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+			{
+				/* Only a task still ready is suspended.  One that has blocked
+				is caught by the tick if it runs again in this period. */
+				prvSuspendTask( pxTCB );
+				pxTCB->ucBudgetState |= taskBUDGET_SUSPENDED;
+
+				if( pxTCB == pxCurrentTCB )
 				{
-					listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					xSwitchRequired = pdTRUE;
 				}
 				else
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
+			}
+		#endif /* INCLUDE_vTaskSuspend */
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-				/* If the task being modified is in the ready state it will need
-				to be moved into a new list. */
-				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
-				{
-					if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-					{
-						/* It is known that the task is in its ready list so
-						there is no need to check again and the port level
-						reset macro can be called directly. */
-						portRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority, uxTopReadyPriority );
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
+		return xSwitchRequired;
+	}
 
-					/* Inherit the priority before being moved into the new list. */
-					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
-					prvAddTaskToReadyList( pxMutexHolderTCB );
-				}
-				else
-				{
-					/* Just inherit the priority. */
-					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
-				}
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
 
-				traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+#if( configUSE_TASK_BUDGETS == 1 )
 
-				/* Inheritance occurred. */
-				xReturn = pdTRUE;
+	static BaseType_t prvBudgetRestore( TCB_t * const pxTCB )
+	{
+	BaseType_t xSwitchRequired = pdFALSE;
+
+		if( ( pxTCB->ucBudgetState & taskBUDGET_DEMOTED ) != 0U )
+		{
+			prvBudgetSetPriority( pxTCB, pxTCB->uxBudgetPriority );
+
+			if( ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) && taskPREEMPTS_CURRENT( pxTCB ) )
+			{
+				xSwitchRequired = pdTRUE;
 			}
 			else
 			{
-				if( pxMutexHolderTCB->uxBasePriority < pxCurrentTCB->uxPriority )
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#if( INCLUDE_vTaskSuspend == 1 )
+			else if( ( ( pxTCB->ucBudgetState & taskBUDGET_SUSPENDED ) != 0U ) &&
+					 ( listIS_CONTAINED_WITHIN( &xSuspendedTaskList, &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+			{
+				/* Not already resumed by vTaskResume(). */
+				traceTASK_RESUME( pxTCB );
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				prvAddTaskToReadyList( pxTCB );
+
+				if( taskPREEMPTS_CURRENT( pxTCB ) )
 				{
-					/* The base priority of the mutex holder is lower than the
-					priority of the task attempting to take the mutex, but the
-					current priority of the mutex holder is not lower than the
-					priority of the task attempting to take the mutex.
-					Therefore the mutex holder must have already inherited a
-					priority, but inheritance would have occurred if that had
-					not been the case. */
-					xReturn = pdTRUE;
+					xSwitchRequired = pdTRUE;
 				}
 				else
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
 			}
+		#endif /* INCLUDE_vTaskSuspend */
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxTCB->ucBudgetState = 0U;
+
+		return xSwitchRequired;
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	static void prvBudgetSetPriority( TCB_t * const pxTCB, UBaseType_t uxNewPriority )
+	{
+	const UBaseType_t uxPriorityUsedOnEntry = pxTCB->uxPriority;
+
+		#if ( configUSE_MUTEXES == 1 )
+		{
+			/* A task holding a mutex keeps the priority it inherited until it
+			gives the mutex back, which then leaves it at the new base
+			priority. */
+			if( pxTCB->uxBasePriority == pxTCB->uxPriority )
+			{
+				pxTCB->uxPriority = uxNewPriority;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxTCB->uxBasePriority = uxNewPriority;
+		}
+		#else
+		{
+			pxTCB->uxPriority = uxNewPriority;
+		}
+		#endif
+
+		if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+		{
+			listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
 
-		return xReturn;
+		if( ( pxTCB->uxPriority != uxPriorityUsedOnEntry ) &&
+			( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+		{
+			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				taskCLEAR_READY_PRIORITY( uxPriorityUsedOnEntry );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			prvAddTaskToReadyList( pxTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 	}
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_TASK_BUDGETS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if( configUSE_TASK_BUDGETS == 1 )
 
-	BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
+	static BaseType_t prvBudgetTick( TickType_t xConstTickCount )
 	{
-	TCB_t * const pxTCB = pxMutexHolder;
-	BaseType_t xReturn = pdFALSE;
+	ListItem_t const *pxItem;
+	TCB_t *pxTCB;
+	configRUN_TIME_COUNTER_TYPE ulNow;
+	BaseType_t xSwitchRequired = pdFALSE;
 
-		if( pxMutexHolder != NULL )
+		if( listLIST_IS_EMPTY( &xBudgetTaskList ) == pdFALSE )
 		{
-			/* A task can only have an inherited priority if it holds the mutex.
-			If the mutex is held by a task then it cannot be given from an
-			interrupt, and if a mutex is given by the holding task then it must
-			be the running state task. */
-			configASSERT( pxTCB == pxCurrentTCB );
-			configASSERT( pxTCB->uxMutexesHeld );
-			( pxTCB->uxMutexesHeld )--;
+			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+				portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+			#else
+				ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+			#endif
 
-			/* Has the holder of the mutex inherited the priority of another
-			task? */
-			if( pxTCB->uxPriority != pxTCB->uxBasePriority )
+			/* Start the periods that are due.  The list is not sorted, as the
+			refill times wrap with the tick count, so every budgeted task is
+			looked at on every tick. */
+			for( pxItem = listGET_HEAD_ENTRY( &xBudgetTaskList );
+				 pxItem != listGET_END_MARKER( &xBudgetTaskList );
+				 pxItem = listGET_NEXT( pxItem ) ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM, as in list.c. */
 			{
-				/* Only disinherit if no other mutexes are held. */
-				if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
+				pxTCB = listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9079 Alignment is known to be fine as the owner is always a TCB. */
+
+				if( taskBUDGET_IS_DUE( xConstTickCount, pxTCB->xBudgetRefillTime ) )
 				{
-					/* A task can only have an inherited priority if it holds
-					the mutex.  If the mutex is held by a task then it cannot be
-					given from an interrupt, and if a mutex is given by the
-					holding task then it must be the running state task.  Remove
-					the holding task from the ready/delayed list. */
-					if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+					/* A whole period on, or from now if tickless idle stepped
+					the tick count past it. */
+					pxTCB->xBudgetRefillTime += pxTCB->xBudgetPeriod;
+
+					if( taskBUDGET_IS_DUE( xConstTickCount, pxTCB->xBudgetRefillTime ) )
 					{
-						taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+						pxTCB->xBudgetRefillTime = xConstTickCount + pxTCB->xBudgetPeriod;
 					}
 					else
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
 
-					/* Disinherit the priority before adding the task into the
-					new	ready list. */
-					traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
-					pxTCB->uxPriority = pxTCB->uxBasePriority;
+					pxTCB->ulBudgetBase = prvBudgetRunTime( pxTCB, ulNow );
 
-					/* Reset the event list item value.  It cannot be in use for
-					any other purpose if this task is running, and it must be
-					running to give back the mutex. */
-					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-					prvAddTaskToReadyList( pxTCB );
+					if( prvBudgetRestore( pxTCB ) != pdFALSE )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
 
-					/* Return true to indicate that a context switch is required.
-					This is only actually required in the corner case whereby
-					multiple mutexes were held and the mutexes were given back
-					in an order different to that in which they were taken.
-					If a context switch did not occur when the first mutex was
-					returned, even if a task was waiting on it, then a context
-					switch should occur when the last mutex is returned whether
-					a task is waiting on it or not. */
-					xReturn = pdTRUE;
+			/* Charge the running task, which may never switch out by itself. */
+			pxTCB = pxCurrentTCB;
+
+			if( ( pxTCB->ulBudget != 0 ) &&
+				( ( pxTCB->ucBudgetState & ( taskBUDGET_DEMOTED | taskBUDGET_SUSPENDED ) ) == 0U ) &&
+				( ( prvBudgetRunTime( pxTCB, ulNow ) - pxTCB->ulBudgetBase ) >= pxTCB->ulBudget ) )
+			{
+				if( prvBudgetOverrun( pxTCB ) != pdFALSE )
+				{
+					xSwitchRequired = pdTRUE;
 				}
 				else
 				{
@@ -4173,107 +6454,47 @@ TCB_t *pxTCB;
 			mtCOVERAGE_TEST_MARKER();
 		}
 
-		return xReturn;
+		return xSwitchRequired;
 	}
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_TASK_BUDGETS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if( configUSE_JOB_STATS == 1 )
 
-	void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder, UBaseType_t uxHighestPriorityWaitingTask )
+	static void prvJobRelease( TCB_t * const pxTCB )
 	{
-	TCB_t * const pxTCB = pxMutexHolder;
-	UBaseType_t uxPriorityUsedOnEntry, uxPriorityToUse;
-	const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
+	configRUN_TIME_COUNTER_TYPE ulNow;
+	configRUN_TIME_COUNTER_TYPE ulPeriod;
 
-		if( pxMutexHolder != NULL )
+		/* A task changing priority, or preempted and put back, is still in
+		its job. */
+		if( ( pxTCB->ucJobState & taskJOB_ACTIVE ) == 0U )
 		{
-			/* If pxMutexHolder is not NULL then the holder must hold at least
-			one mutex. */
-			configASSERT( pxTCB->uxMutexesHeld );
+			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+				portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+			#else
+				ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+			#endif
 
-			/* Determine the priority to which the priority of the task that
-			holds the mutex should be set.  This will be the greater of the
-			holding task's base priority and the priority of the highest
-			priority task that is waiting to obtain the mutex. */
-			if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
+			if( pxTCB->ulJobs == 0UL )
 			{
-				uxPriorityToUse = uxHighestPriorityWaitingTask;
+				pxTCB->ulJobFirstRelease = ulNow;
 			}
 			else
 			{
-				uxPriorityToUse = pxTCB->uxBasePriority;
-			}
-
-			/* Does the priority need to change? */
-			if( pxTCB->uxPriority != uxPriorityToUse )
-			{
-				/* Only disinherit if no other mutexes are held.  This is a
-				simplification in the priority inheritance implementation.  If
-				the task that holds the mutex is also holding other mutexes then
-				the other mutexes may have caused the priority inheritance. */
-				if( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld )
-				{
-					/* If a task has timed out because it already holds the
-					mutex it was trying to obtain then it cannot of inherited
-					its own priority. */
-					configASSERT( pxTCB != pxCurrentTCB );
-
-					/* Disinherit the priority, remembering the previous
-					priority to facilitate determining the subject task's
-					state. */
-					traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
-					uxPriorityUsedOnEntry = pxTCB->uxPriority;
-					pxTCB->uxPriority = uxPriorityToUse;
-
-					/* Only reset the event list item value if the value is not
-					being used for anything else. */
-					if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-					{
-						listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-
-					/* If the running task is not the task that holds the mutex
-					then the task that holds the mutex could be in either the
-					Ready, Blocked or Suspended states.  Only remove the task
-					from its current state list if it is in the Ready state as
-					the task's priority is going to change and there is one
-					Ready list per priority. */
-					if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
-					{
-						if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-						{
-							/* It is known that the task is in its ready list so
-							there is no need to check again and the port level
-							reset macro can be called directly. */
-							portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
+				ulPeriod = ulNow - pxTCB->ulJobRelease;
 
-						prvAddTaskToReadyList( pxTCB );
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-				}
-				else
+				if( ( pxTCB->ulJobPeriodMin == 0 ) || ( ulPeriod < pxTCB->ulJobPeriodMin ) )
 				{
-					mtCOVERAGE_TEST_MARKER();
+					pxTCB->ulJobPeriodMin = ulPeriod;
 				}
 			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
+
+			pxTCB->ulJobRelease = ulNow;
+			pxTCB->ulJobRunBase = pxTCB->ulRunTimeCounter;
+			pxTCB->ulJobs++;
+			pxTCB->ucJobState = taskJOB_ACTIVE | taskJOB_COUNTED;
 		}
 		else
 		{
@@ -4281,52 +6502,160 @@ TCB_t *pxTCB;
 		}
 	}
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_JOB_STATS */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if( configUSE_TASK_NAME_INDEX == 1 )
 
-	void vTaskEnterCritical( void )
+	static uint32_t prvTaskNameHash( const char *pcName )
 	{
-		portDISABLE_INTERRUPTS();
+	uint32_t ulHash = 2166136261UL;
+	UBaseType_t x;
 
-		if( xSchedulerRunning != pdFALSE )
+		/* As taskNAME_HASH(): only the characters the TCB keeps. */
+		for( x = ( UBaseType_t ) 0; ( x < ( UBaseType_t ) ( configMAX_TASK_NAME_LEN - 1 ) ) && ( pcName[ x ] != ( char ) 0x00 ); x++ )
 		{
-			( pxCurrentTCB->uxCriticalNesting )++;
+			ulHash = ( ulHash ^ ( uint32_t ) ( uint8_t ) pcName[ x ] ) * 16777619UL;
+		}
 
-			/* This is not the interrupt safe version of the enter critical
-			function so	assert() if it is being called from an interrupt
-			context.  Only API functions that end in "FromISR" can be used in an
-			interrupt.  Only assert if the critical nesting count is 1 to
-			protect against recursive calls if the assert function also uses a
-			critical section. */
-			if( pxCurrentTCB->uxCriticalNesting == 1 )
+		return ulHash;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvIndexTaskName( TCB_t *pxTCB )
+	{
+	uint32_t ulHash = prvTaskNameHash( &( pxTCB->pcTaskName[ 0 ] ) );
+	uint32_t ulSlot = ulHash & taskNAME_INDEX_MASK;
+
+		if( uxTaskNamesIndexed < ( UBaseType_t ) ( configTASK_NAME_INDEX_SIZE - 1 ) )
+		{
+			while( xTaskNameIndex[ ulSlot ].pxTCB != NULL )
 			{
-				portASSERT_IF_IN_ISR();
+				ulSlot = ( ulSlot + 1UL ) & taskNAME_INDEX_MASK;
 			}
+
+			xTaskNameIndex[ ulSlot ].ulHash = ulHash;
+			xTaskNameIndex[ ulSlot ].pxTCB = pxTCB;
+			uxTaskNamesIndexed++;
 		}
 		else
 		{
-			mtCOVERAGE_TEST_MARKER();
+			uxTaskNamesNotIndexed++;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static TCB_t *prvFindTaskName( uint32_t ulHash, const char *pcName )
+	{
+	uint32_t ulSlot = ulHash & taskNAME_INDEX_MASK;
+	TCB_t *pxTCB;
+	UBaseType_t x;
+
+		while( ( pxTCB = xTaskNameIndex[ ulSlot ].pxTCB ) != NULL )
+		{
+			if( xTaskNameIndex[ ulSlot ].ulHash == ulHash )
+			{
+				if( pcName == NULL )
+				{
+					break;
+				}
+
+				/* Both names are cut at configMAX_TASK_NAME_LEN - 1. */
+				for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) ( configMAX_TASK_NAME_LEN - 1 ); x++ )
+				{
+					if( ( pxTCB->pcTaskName[ x ] != pcName[ x ] ) || ( pcName[ x ] == ( char ) 0x00 ) )
+					{
+						break;
+					}
+				}
+
+				if( ( x == ( UBaseType_t ) ( configMAX_TASK_NAME_LEN - 1 ) ) || ( pxTCB->pcTaskName[ x ] == pcName[ x ] ) )
+				{
+					break;
+				}
+			}
+
+			ulSlot = ( ulSlot + 1UL ) & taskNAME_INDEX_MASK;
 		}
+
+		return pxTCB;
 	}
+	/*-----------------------------------------------------------*/
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+	#if( INCLUDE_vTaskDelete == 1 )
+
+	static void prvUnindexTaskName( const TCB_t *pxTCB )
+	{
+	uint32_t ulSlot = prvTaskNameHash( &( pxTCB->pcTaskName[ 0 ] ) ) & taskNAME_INDEX_MASK;
+	uint32_t ulNext;
+	uint32_t ulHome;
+
+		while( ( xTaskNameIndex[ ulSlot ].pxTCB != NULL ) && ( xTaskNameIndex[ ulSlot ].pxTCB != pxTCB ) )
+		{
+			ulSlot = ( ulSlot + 1UL ) & taskNAME_INDEX_MASK;
+		}
+
+		if( xTaskNameIndex[ ulSlot ].pxTCB == NULL )
+		{
+			/* Created while the index was full. */
+			uxTaskNamesNotIndexed--;
+			return;
+		}
+
+		/* Move back the entries after the hole that would no longer be
+		reached from their home slot, so that no tombstones are needed. */
+		for( ulNext = ( ulSlot + 1UL ) & taskNAME_INDEX_MASK; xTaskNameIndex[ ulNext ].pxTCB != NULL; ulNext = ( ulNext + 1UL ) & taskNAME_INDEX_MASK )
+		{
+			ulHome = xTaskNameIndex[ ulNext ].ulHash & taskNAME_INDEX_MASK;
+
+			if( ( ( ulNext - ulHome ) & taskNAME_INDEX_MASK ) >= ( ( ulNext - ulSlot ) & taskNAME_INDEX_MASK ) )
+			{
+				xTaskNameIndex[ ulSlot ] = xTaskNameIndex[ ulNext ];
+				ulSlot = ulNext;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		xTaskNameIndex[ ulSlot ].pxTCB = NULL;
+		uxTaskNamesIndexed--;
+	}
+
+	#endif /* INCLUDE_vTaskDelete */
+
+#endif /* configUSE_TASK_NAME_INDEX */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if( INCLUDE_xTaskGetTicksToNextWake == 1 )
 
-	void vTaskExitCritical( void )
+	static TickType_t prvGetTicksToWakeWithinList( List_t const * pxList, UBaseType_t uxMinPriority, TickType_t xTicksToWake, BaseType_t xSorted )
 	{
-		if( xSchedulerRunning != pdFALSE )
+	ListItem_t const * pxItem;
+	TCB_t const * pxTCB;
+	TickType_t xTicksToItem;
+
+		for( pxItem = listGET_HEAD_ENTRY( pxList ); pxItem != listGET_END_MARKER( pxList ); pxItem = listGET_NEXT( pxItem ) )
 		{
-			if( pxCurrentTCB->uxCriticalNesting > 0U )
+			pxTCB = listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+			if( pxTCB->uxPriority >= uxMinPriority )
 			{
-				( pxCurrentTCB->uxCriticalNesting )--;
+				xTicksToItem = listGET_LIST_ITEM_VALUE( pxItem ) - xTickCount;
 
-				if( pxCurrentTCB->uxCriticalNesting == 0U )
+				if( xTicksToItem < xTicksToWake )
 				{
-					portENABLE_INTERRUPTS();
+					xTicksToWake = xTicksToItem;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( xSorted != pdFALSE )
+				{
+					break;
 				}
 				else
 				{
@@ -4338,52 +6667,463 @@ TCB_t *pxTCB;
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
+
+		return xTicksToWake;
 	}
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+#endif /* INCLUDE_xTaskGetTicksToNextWake */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+static void prvResetNextTaskUnblockTime( void )
+{
+#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+TCB_t *pxTCB;
 
-	static char *prvWriteNameToBuffer( char *pcBuffer, const char *pcTaskName )
+	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
 	{
-	size_t x;
+		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+		the maximum possible value so it is	extremely unlikely that the
+		if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+		there is an item in the delayed list. */
+		xNextTaskUnblockTime = portMAX_DELAY;
+	}
+	else
+	{
+		/* The new current delayed list is not empty, get the value of
+		the item at the head of the delayed list.  This is the time at
+		which the task at the head of the delayed list should be removed
+		from the Blocked state. */
+		( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+	}
+#else
+	/* The wheel is not searched for the next unblock time until
+	prvGetExpectedIdleTime() needs it, so there is nothing to reset. */
+	mtCOVERAGE_TEST_MARKER();
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+}
+/*-----------------------------------------------------------*/
 
-		/* Start by copying the entire string. */
-		strcpy( pcBuffer, pcTaskName );
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
 
-		/* Pad the end of the string with spaces to ensure columns line up when
-		printed out. */
-		for( x = strlen( pcBuffer ); x < ( size_t ) ( configMAX_TASK_NAME_LEN - 1 ); x++ )
+	TaskHandle_t xTaskGetCurrentTaskHandle( void )
+	{
+	TaskHandle_t xReturn;
+
+		/* A critical section is not required as this is not called from
+		an interrupt and the current TCB will always be the same for any
+		individual execution thread. */
+		xReturn = pxCurrentTCB;
+
+		return xReturn;
+	}
+
+#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+
+	BaseType_t xTaskGetSchedulerState( void )
+	{
+	BaseType_t xReturn;
+
+		if( xSchedulerRunning == pdFALSE )
 		{
-			pcBuffer[ x ] = ' ';
+			xReturn = taskSCHEDULER_NOT_STARTED;
+		}
+		else
+		{
+			if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+			{
+				xReturn = taskSCHEDULER_RUNNING;
+			}
+			else
+			{
+				xReturn = taskSCHEDULER_SUSPENDED;
+			}
 		}
 
-		/* Terminate. */
-		pcBuffer[ x ] = ( char ) 0x00;
-
-		/* Return the new end of string. */
-		return &( pcBuffer[ x ] );
+		return xReturn;
 	}
 
-#endif /* ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) */
+#endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+#if ( configUSE_MUTEXES == 1 )
 
-	void vTaskList( char * pcWriteBuffer )
+	BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
 	{
-	TaskStatus_t *pxTaskStatusArray;
-	UBaseType_t uxArraySize, x;
-	char cStatus;
+	TCB_t * const pxMutexHolderTCB = pxMutexHolder;
+	BaseType_t xReturn = pdFALSE;
 
-		/*
-		 * PLEASE NOTE:
-		 *
+		/* If the mutex was given back by an interrupt while the queue was
+		locked then the mutex holder might now be NULL.  _RB_ Is this still
+		needed as interrupts can no longer use mutexes? */
+		if( pxMutexHolder != NULL )
+		{
+			/* If the holder of the mutex has a priority below the priority of
+			the task attempting to obtain the mutex then it will temporarily
+			inherit the priority of the task attempting to obtain the mutex. */
+			if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
+			{
+				/* Adjust the mutex holder state to account for its new
+				priority.  Only reset the event list item value if the value is
+				not being used for anything else. */
+				if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* If the task being modified is in the ready state it will need
+				to be moved into a new list. */
+				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+				{
+					if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+					{
+						/* It is known that the task is in its ready list so
+						there is no need to check again and the bitmap
+						can be cleared directly. */
+						taskCLEAR_READY_PRIORITY( pxMutexHolderTCB->uxPriority );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* Inherit the priority before being moved into the new list. */
+					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+					prvAddTaskToReadyList( pxMutexHolderTCB );
+				}
+				else
+				{
+					/* Just inherit the priority. */
+					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+				}
+
+				traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+
+				/* Inheritance occurred. */
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				if( pxMutexHolderTCB->uxBasePriority < pxCurrentTCB->uxPriority )
+				{
+					/* The base priority of the mutex holder is lower than the
+					priority of the task attempting to take the mutex, but the
+					current priority of the mutex holder is not lower than the
+					priority of the task attempting to take the mutex.
+					Therefore the mutex holder must have already inherited a
+					priority, but inheritance would have occurred if that had
+					not been the case. */
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
+	{
+	TCB_t * const pxTCB = pxMutexHolder;
+	BaseType_t xReturn = pdFALSE;
+
+		if( pxMutexHolder != NULL )
+		{
+			/* A task can only have an inherited priority if it holds the mutex.
+			If the mutex is held by a task then it cannot be given from an
+			interrupt, and if a mutex is given by the holding task then it must
+			be the running state task. */
+			configASSERT( pxTCB == pxCurrentTCB );
+			configASSERT( pxTCB->uxMutexesHeld );
+			( pxTCB->uxMutexesHeld )--;
+
+			/* Has the holder of the mutex inherited the priority of another
+			task? */
+			if( pxTCB->uxPriority != pxTCB->uxBasePriority )
+			{
+				/* Only disinherit if no other mutexes are held. */
+				if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
+				{
+					/* A task can only have an inherited priority if it holds
+					the mutex.  If the mutex is held by a task then it cannot be
+					given from an interrupt, and if a mutex is given by the
+					holding task then it must be the running state task.  Remove
+					the holding task from the ready/delayed list. */
+					if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+					{
+						taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* Disinherit the priority before adding the task into the
+					new	ready list. */
+					traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
+					pxTCB->uxPriority = pxTCB->uxBasePriority;
+
+					/* Reset the event list item value.  It cannot be in use for
+					any other purpose if this task is running, and it must be
+					running to give back the mutex. */
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					prvAddTaskToReadyList( pxTCB );
+
+					/* Return true to indicate that a context switch is required.
+					This is only actually required in the corner case whereby
+					multiple mutexes were held and the mutexes were given back
+					in an order different to that in which they were taken.
+					If a context switch did not occur when the first mutex was
+					returned, even if a task was waiting on it, then a context
+					switch should occur when the last mutex is returned whether
+					a task is waiting on it or not. */
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder, UBaseType_t uxHighestPriorityWaitingTask )
+	{
+	TCB_t * const pxTCB = pxMutexHolder;
+	UBaseType_t uxPriorityUsedOnEntry, uxPriorityToUse;
+	const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
+
+		if( pxMutexHolder != NULL )
+		{
+			/* If pxMutexHolder is not NULL then the holder must hold at least
+			one mutex. */
+			configASSERT( pxTCB->uxMutexesHeld );
+
+			/* Determine the priority to which the priority of the task that
+			holds the mutex should be set.  This will be the greater of the
+			holding task's base priority and the priority of the highest
+			priority task that is waiting to obtain the mutex. */
+			if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
+			{
+				uxPriorityToUse = uxHighestPriorityWaitingTask;
+			}
+			else
+			{
+				uxPriorityToUse = pxTCB->uxBasePriority;
+			}
+
+			/* Does the priority need to change? */
+			if( pxTCB->uxPriority != uxPriorityToUse )
+			{
+				/* Only disinherit if no other mutexes are held.  This is a
+				simplification in the priority inheritance implementation.  If
+				the task that holds the mutex is also holding other mutexes then
+				the other mutexes may have caused the priority inheritance. */
+				if( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld )
+				{
+					/* If a task has timed out because it already holds the
+					mutex it was trying to obtain then it cannot of inherited
+					its own priority. */
+					configASSERT( pxTCB != pxCurrentTCB );
+
+					/* Disinherit the priority, remembering the previous
+					priority to facilitate determining the subject task's
+					state. */
+					traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
+					uxPriorityUsedOnEntry = pxTCB->uxPriority;
+					pxTCB->uxPriority = uxPriorityToUse;
+
+					/* Only reset the event list item value if the value is not
+					being used for anything else. */
+					if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+					{
+						listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* If the running task is not the task that holds the mutex
+					then the task that holds the mutex could be in either the
+					Ready, Blocked or Suspended states.  Only remove the task
+					from its current state list if it is in the Ready state as
+					the task's priority is going to change and there is one
+					Ready list per priority. */
+					if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+					{
+						if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+						{
+							/* It is known that the task is in its ready list so
+							there is no need to check again and the bitmap
+							can be cleared directly. */
+							taskCLEAR_READY_PRIORITY( pxTCB->uxPriority );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						prvAddTaskToReadyList( pxTCB );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+	void vTaskEnterCritical( void )
+	{
+		portDISABLE_INTERRUPTS();
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			( pxCurrentTCB->uxCriticalNesting )++;
+
+			/* This is not the interrupt safe version of the enter critical
+			function so	assert() if it is being called from an interrupt
+			context.  Only API functions that end in "FromISR" can be used in an
+			interrupt.  Only assert if the critical nesting count is 1 to
+			protect against recursive calls if the assert function also uses a
+			critical section. */
+			if( pxCurrentTCB->uxCriticalNesting == 1 )
+			{
+				portASSERT_IF_IN_ISR();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+	void vTaskExitCritical( void )
+	{
+		if( xSchedulerRunning != pdFALSE )
+		{
+			if( pxCurrentTCB->uxCriticalNesting > 0U )
+			{
+				( pxCurrentTCB->uxCriticalNesting )--;
+
+				if( pxCurrentTCB->uxCriticalNesting == 0U )
+				{
+					portENABLE_INTERRUPTS();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+
+	static char *prvWriteNameToBuffer( char *pcBuffer, const char *pcTaskName )
+	{
+	size_t x;
+
+		/* Start by copying the entire string. */
+		strcpy( pcBuffer, pcTaskName );
+
+		/* Pad the end of the string with spaces to ensure columns line up when
+		printed out. */
+		for( x = strlen( pcBuffer ); x < ( size_t ) ( configMAX_TASK_NAME_LEN - 1 ); x++ )
+		{
+			pcBuffer[ x ] = ' ';
+		}
+
+		/* Terminate. */
+		pcBuffer[ x ] = ( char ) 0x00;
+
+		/* Return the new end of string. */
+		return &( pcBuffer[ x ] );
+	}
+
+#endif /* ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	void vTaskList( char * pcWriteBuffer )
+	{
+	TaskStatus_t *pxTaskStatusArray;
+	UBaseType_t uxArraySize, x;
+	char cStatus;
+
+		/*
+		 * PLEASE NOTE:
+		 *
 		 * This function is provided for convenience only, and is used by many
 		 * of the demo applications.  Do not consider it to be part of the
 		 * scheduler.
@@ -4406,775 +7146,1659 @@ TCB_t *pxTCB;
 		 */
 
 
-		/* Make sure the write buffer does not contain a string. */
-		*pcWriteBuffer = ( char ) 0x00;
+		/* Make sure the write buffer does not contain a string. */
+		*pcWriteBuffer = ( char ) 0x00;
+
+		/* Take a snapshot of the number of tasks in case it changes while this
+		function is executing. */
+		uxArraySize = uxCurrentNumberOfTasks;
+
+		/* Allocate an array index for each task.  NOTE!  if
+		configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
+		equate to NULL. */
+		pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+
+		if( pxTaskStatusArray != NULL )
+		{
+			/* Generate the (binary) data. */
+			uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
+
+			/* Create a human readable table from the binary data. */
+			for( x = 0; x < uxArraySize; x++ )
+			{
+				switch( pxTaskStatusArray[ x ].eCurrentState )
+				{
+					case eRunning:		cStatus = tskRUNNING_CHAR;
+										break;
+
+					case eReady:		cStatus = tskREADY_CHAR;
+										break;
+
+					case eBlocked:		cStatus = tskBLOCKED_CHAR;
+										break;
+
+					case eSuspended:	cStatus = tskSUSPENDED_CHAR;
+										break;
+
+					case eDeleted:		cStatus = tskDELETED_CHAR;
+										break;
+
+					case eInvalid:		/* Fall through. */
+					default:			/* Should not get here, but it is included
+										to prevent static checking errors. */
+										cStatus = ( char ) 0x00;
+										break;
+				}
+
+				/* Write the task name to the string, padding with spaces so it
+				can be printed in tabular form more easily. */
+				pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+
+				/* Write the rest of the string. */
+				sprintf( pcWriteBuffer, "\t%c\t%u\t%u\t%u\r\n", cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+				pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+			}
+
+			/* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
+			is 0 then vPortFree() will be #defined to nothing. */
+			vPortFree( pxTaskStatusArray );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*----------------------------------------------------------*/
+
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	void vTaskGetRunTimeStats( char *pcWriteBuffer )
+	{
+	TaskStatus_t *pxTaskStatusArray;
+	UBaseType_t uxArraySize, x;
+	configRUN_TIME_COUNTER_TYPE ulTotalTime, ulStatsAsPercentage;
+
+		#if( configUSE_TRACE_FACILITY != 1 )
+		{
+			#error configUSE_TRACE_FACILITY must also be set to 1 in FreeRTOSConfig.h to use vTaskGetRunTimeStats().
+		}
+		#endif
+
+		/*
+		 * PLEASE NOTE:
+		 *
+		 * This function is provided for convenience only, and is used by many
+		 * of the demo applications.  Do not consider it to be part of the
+		 * scheduler.
+		 *
+		 * vTaskGetRunTimeStats() calls uxTaskGetSystemState(), then formats part
+		 * of the uxTaskGetSystemState() output into a human readable table that
+		 * displays the amount of time each task has spent in the Running state
+		 * in both absolute and percentage terms.
+		 *
+		 * vTaskGetRunTimeStats() has a dependency on the sprintf() C library
+		 * function that might bloat the code size, use a lot of stack, and
+		 * provide different results on different platforms.  An alternative,
+		 * tiny, third party, and limited functionality implementation of
+		 * sprintf() is provided in many of the FreeRTOS/Demo sub-directories in
+		 * a file called printf-stdarg.c (note printf-stdarg.c does not provide
+		 * a full snprintf() implementation!).
+		 *
+		 * It is recommended that production systems call uxTaskGetSystemState()
+		 * directly to get access to raw stats data, rather than indirectly
+		 * through a call to vTaskGetRunTimeStats().
+		 */
+
+		/* Make sure the write buffer does not contain a string. */
+		*pcWriteBuffer = ( char ) 0x00;
+
+		/* Take a snapshot of the number of tasks in case it changes while this
+		function is executing. */
+		uxArraySize = uxCurrentNumberOfTasks;
+
+		/* Allocate an array index for each task.  NOTE!  If
+		configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
+		equate to NULL. */
+		pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+
+		if( pxTaskStatusArray != NULL )
+		{
+			/* Generate the (binary) data. */
+			uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, &ulTotalTime );
+
+			/* For percentage calculations. */
+			ulTotalTime /= 100UL;
+
+			/* Avoid divide by zero errors. */
+			if( ulTotalTime > 0UL )
+			{
+				/* Create a human readable table from the binary data. */
+				for( x = 0; x < uxArraySize; x++ )
+				{
+					/* What percentage of the total run time has the task used?
+					This will always be rounded down to the nearest integer.
+					ulTotalRunTimeDiv100 has already been divided by 100. */
+					ulStatsAsPercentage = pxTaskStatusArray[ x ].ulRunTimeCounter / ulTotalTime;
+
+					/* Write the task name to the string, padding with
+					spaces so it can be printed in tabular form more
+					easily. */
+					pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+
+					if( ulStatsAsPercentage > 0UL )
+					{
+						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
+						{
+							sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned long ) ulStatsAsPercentage );
+						}
+						#else
+						{
+							/* sizeof( int ) == sizeof( long ) so a smaller
+							printf() library can be used. */
+							sprintf( pcWriteBuffer, "\t%u\t\t%u%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+						}
+						#endif
+					}
+					else
+					{
+						/* If the percentage is zero here then the task has
+						consumed less than 1% of the total run time. */
+						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
+						{
+							sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter );
+						}
+						#else
+						{
+							/* sizeof( int ) == sizeof( long ) so a smaller
+							printf() library can be used. */
+							sprintf( pcWriteBuffer, "\t%u\t\t<1%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+						}
+						#endif
+					}
+
+					pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
+			is 0 then vPortFree() will be #defined to nothing. */
+			vPortFree( pxTaskStatusArray );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+TickType_t uxTaskResetEventItemValue( void )
+{
+TickType_t uxReturn;
+
+	uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
+
+	/* Reset the event list item to its normal value - so it can be used with
+	queues and semaphores. */
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	TaskHandle_t pvTaskIncrementMutexHeldCount( void )
+	{
+		/* If xSemaphoreCreateMutex() is called before any tasks have been created
+		then pxCurrentTCB will be NULL. */
+		if( pxCurrentTCB != NULL )
+		{
+			( pxCurrentTCB->uxMutexesHeld )++;
+		}
+
+		return pxCurrentTCB;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+
+	void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority )
+	{
+	TCB_t * const pxTCB = pxCurrentTCB;
+
+		/* The mutex can be taken before the scheduler has a task to raise. */
+		if( pxTCB != NULL )
+		{
+			/* A task above the ceiling could find the mutex held by a task it
+			preempted: the ceiling is too low. */
+			configASSERT( pxTCB->uxBasePriority <= uxCeilingPriority );
+
+			/* The priority may already be higher, inherited or from the
+			ceiling of another mutex held. */
+			if( pxTCB->uxPriority < uxCeilingPriority )
+			{
+				traceTASK_PRIORITY_INHERIT( pxTCB, uxCeilingPriority );
+
+				/* The running task is in its ready list.  It stays the
+				highest priority ready task, so no yield is needed. */
+				if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+				{
+					taskCLEAR_READY_PRIORITY( pxTCB->uxPriority );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxTCB->uxPriority = uxCeilingPriority;
+				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxCeilingPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				prvAddTaskToReadyList( pxTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_MUTEX_PRIORITY_CEILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+
+	BaseType_t xTaskMutexFastTake( TaskHandle_t volatile * const pxMutexHolder )
+	{
+	TCB_t * const pxTCB = pxCurrentTCB;
+
+		/* Before the scheduler has a task to record as the holder the kernel
+		path has to be used. */
+		if( pxTCB == NULL )
+		{
+			return pdFALSE;
+		}
+
+		/* The holder is the lock word of the mutex: NULL means it is
+		available.  Any context switch between the load and the store clears
+		the exclusive monitor, so the store only succeeds if no other task
+		could have changed the holder in between. */
+		do
+		{
+			if( portLOAD_EXCLUSIVE( ( volatile uint32_t * ) pxMutexHolder ) != 0UL )
+			{
+				/* Held - the kernel path blocks and applies priority
+				inheritance. */
+				portCLEAR_EXCLUSIVE();
+				return pdFALSE;
+			}
+		} while( portSTORE_EXCLUSIVE( ( volatile uint32_t * ) pxMutexHolder, ( uint32_t ) pxTCB ) != 0UL );
+
+		/* Only the holder itself changes its held count, so no critical
+		section is needed. */
+		( pxTCB->uxMutexesHeld )++;
+
+		return pdTRUE;
+	}
+
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+
+	BaseType_t xTaskMutexFastGive( TaskHandle_t volatile * const pxMutexHolder, const List_t * const pxWaitingTasks )
+	{
+	TCB_t * const pxTCB = pxCurrentTCB;
+
+		do
+		{
+			/* Fall back to the kernel path if the caller is not the holder,
+			a task has to be woken, or the holder has inherited a priority
+			that it may have to disinherit.  A task blocking on the mutex, or
+			a priority change, needs a context switch, which makes the store
+			below fail and the checks be repeated. */
+			if( ( portLOAD_EXCLUSIVE( ( volatile uint32_t * ) pxMutexHolder ) != ( uint32_t ) pxTCB ) ||
+				( listLIST_IS_EMPTY( pxWaitingTasks ) == pdFALSE ) ||
+				( pxTCB->uxPriority != pxTCB->uxBasePriority ) )
+			{
+				portCLEAR_EXCLUSIVE();
+				return pdFALSE;
+			}
+		} while( portSTORE_EXCLUSIVE( ( volatile uint32_t * ) pxMutexHolder, 0UL ) != 0UL );
+
+		( pxTCB->uxMutexesHeld )--;
+
+		return pdTRUE;
+	}
+
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+	{
+	uint32_t ulReturn;
+
+		configASSERT( uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+		taskENTER_CRITICAL();
+		{
+			/* Only block if the notification count is not already non-zero. */
+			if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] == 0UL )
+			{
+				/* Mark this task as waiting for a notification. */
+				pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskWAITING_NOTIFICATION;
+
+				if( xTicksToWait > ( TickType_t ) 0 )
+				{
+					prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+					traceTASK_NOTIFY_TAKE_BLOCK();
+
+					/* All ports are written to allow a yield in a critical
+					section (some will yield immediately, others wait until the
+					critical section exits) - but it is not something that
+					application code should ever do. */
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		taskENTER_CRITICAL();
+		{
+			traceTASK_NOTIFY_TAKE();
+			ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ];
+
+			if( ulReturn != 0UL )
+			{
+				if( xClearCountOnExit != pdFALSE )
+				{
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] = 0UL;
+				}
+				else
+				{
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] = ulReturn - ( uint32_t ) 1;
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskNOT_WAITING_NOTIFICATION;
+		}
+		taskEXIT_CRITICAL();
+
+		return ulReturn;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	{
+	BaseType_t xReturn;
+
+		configASSERT( uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+		taskENTER_CRITICAL();
+		{
+			/* Only block if a notification is not already pending. */
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] != taskNOTIFICATION_RECEIVED )
+			{
+				/* Clear bits in the task's notification value as bits may get
+				set	by the notifying task or interrupt.  This can be used to
+				clear the value to zero. */
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] &= ~ulBitsToClearOnEntry;
+
+				/* Mark this task as waiting for a notification. */
+				pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskWAITING_NOTIFICATION;
+
+				if( xTicksToWait > ( TickType_t ) 0 )
+				{
+					prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+					traceTASK_NOTIFY_WAIT_BLOCK();
+
+					/* All ports are written to allow a yield in a critical
+					section (some will yield immediately, others wait until the
+					critical section exits) - but it is not something that
+					application code should ever do. */
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		taskENTER_CRITICAL();
+		{
+			traceTASK_NOTIFY_WAIT();
+
+			if( pulNotificationValue != NULL )
+			{
+				/* Output the current notification value, which may or may not
+				have changed. */
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ];
+			}
+
+			/* If ucNotifyValue is set then either the task never entered the
+			blocked state (because a notification was already pending) or the
+			task unblocked because of a notification.  Otherwise the task
+			unblocked because of a timeout. */
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] != taskNOTIFICATION_RECEIVED )
+			{
+				/* A notification was not received. */
+				xReturn = pdFALSE;
+			}
+			else
+			{
+				/* A notification was already pending or a notification was
+				received while the task was waiting. */
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] &= ~ulBitsToClearOnExit;
+				xReturn = pdTRUE;
+			}
+
+			pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskNOT_WAITING_NOTIFICATION;
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+	{
+	TCB_t * pxTCB;
+	BaseType_t xReturn = pdPASS;
+	uint8_t ucOriginalNotifyState;
+
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+		configASSERT( xTaskToNotify );
+		pxTCB = xTaskToNotify;
+
+		taskENTER_CRITICAL();
+		{
+			if( pulPreviousNotificationValue != NULL )
+			{
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
+			}
+
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+
+			switch( eAction )
+			{
+				case eSetBits	:
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
+					break;
+
+				case eIncrement	:
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+					break;
+
+				case eSetValueWithOverwrite	:
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+					break;
+
+				case eSetValueWithoutOverwrite :
+					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
+					{
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+					}
+					else
+					{
+						/* The value could not be written to the task. */
+						xReturn = pdFAIL;
+					}
+					break;
+
+				case eIncrementUpToValue :
+					if( pxTCB->ulNotifiedValue[ uxIndexToNotify ] < ulValue )
+					{
+						( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+					}
+					else
+					{
+						/* The value is already at the limit. */
+						xReturn = pdFAIL;
+					}
+					break;
+
+				case eNoAction:
+					/* The task is being notified without its notify value being
+					updated. */
+					break;
+
+				default:
+					/* Should not get here if all enums are handled.
+					Artificially force an assert by testing a value the
+					compiler can't assume is const. */
+					configASSERT( pxTCB->ulNotifiedValue[ uxIndexToNotify ] == ~0UL );
+
+					break;
+			}
+
+			traceTASK_NOTIFY();
+
+			/* If the task is in the blocked state specifically to wait for a
+			notification then unblock it now. */
+			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			{
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				prvAddTaskToReadyList( pxTCB );
+
+				/* The task should not have been on an event list. */
+				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+				#if( configUSE_TICKLESS_IDLE != 0 )
+				{
+					/* If a task is blocked waiting for a notification then
+					xNextTaskUnblockTime might be set to the blocked task's time
+					out time.  If the task is unblocked for a reason other than
+					a timeout xNextTaskUnblockTime is normally left unchanged,
+					because it will automatically get reset to a new value when
+					the tick count equals xNextTaskUnblockTime.  However if
+					tickless idling is used it might be more important to enter
+					sleep mode at the earliest possible time - so reset
+					xNextTaskUnblockTime here to ensure it is updated at the
+					earliest possible time. */
+					prvResetNextTaskUnblockTime();
+				}
+				#endif
+
+				if( taskPREEMPTS_CURRENT( pxTCB ) != pdFALSE )
+				{
+					/* The notified task has a priority above the currently
+					executing task so a yield is required. */
+					taskYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	TCB_t * pxTCB;
+	uint8_t ucOriginalNotifyState;
+	BaseType_t xReturn = pdPASS;
+	UBaseType_t uxSavedInterruptStatus;
+
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+		configASSERT( xTaskToNotify );
+
+		/* RTOS ports that support interrupt nesting have the concept of a
+		maximum	system call (or maximum API call) interrupt priority.
+		Interrupts that are	above the maximum system call priority are keep
+		permanently enabled, even when the RTOS kernel is in a critical section,
+		but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+		is defined in FreeRTOSConfig.h then
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+		failure if a FreeRTOS API function is called from an interrupt that has
+		been assigned a priority above the configured maximum system call
+		priority.  Only FreeRTOS functions that end in FromISR can be called
+		from interrupts	that have been assigned a priority at or (logically)
+		below the maximum system call interrupt priority.  FreeRTOS maintains a
+		separate interrupt safe API to ensure interrupt entry is as fast and as
+		simple as possible.  More information (albeit Cortex-M specific) is
+		provided on the following link:
+		http://www.freertos.org/RTOS-Cortex-M3-M4.html */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		pxTCB = xTaskToNotify;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( pulPreviousNotificationValue != NULL )
+			{
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
+			}
+
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+
+			switch( eAction )
+			{
+				case eSetBits	:
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
+					break;
+
+				case eIncrement	:
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+					break;
+
+				case eSetValueWithOverwrite	:
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+					break;
+
+				case eSetValueWithoutOverwrite :
+					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
+					{
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+					}
+					else
+					{
+						/* The value could not be written to the task. */
+						xReturn = pdFAIL;
+					}
+					break;
+
+				case eIncrementUpToValue :
+					if( pxTCB->ulNotifiedValue[ uxIndexToNotify ] < ulValue )
+					{
+						( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+					}
+					else
+					{
+						/* The value is already at the limit. */
+						xReturn = pdFAIL;
+					}
+					break;
+
+				case eNoAction :
+					/* The task is being notified without its notify value being
+					updated. */
+					break;
+
+				default:
+					/* Should not get here if all enums are handled.
+					Artificially force an assert by testing a value the
+					compiler can't assume is const. */
+					configASSERT( pxTCB->ulNotifiedValue[ uxIndexToNotify ] == ~0UL );
+					break;
+			}
+
+			traceTASK_NOTIFY_FROM_ISR();
+
+			/* If the task is in the blocked state specifically to wait for a
+			notification then unblock it now. */
+			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			{
+				/* The task should not have been on an event list. */
+				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+				{
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					prvAddTaskToReadyList( pxTCB );
+				}
+				else
+				{
+					/* The delayed and ready lists cannot be accessed, so hold
+					this task pending until the scheduler is resumed. */
+					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+				}
+
+				if( taskPREEMPTS_CURRENT( pxTCB ) != pdFALSE )
+				{
+					/* The notified task has a priority above the currently
+					executing task so a yield is required. */
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+
+					/* Mark that a yield is pending in case the user is not
+					using the "xHigherPriorityTaskWoken" parameter to an ISR
+					safe FreeRTOS function. */
+					xYieldPending = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	TCB_t * pxTCB;
+	uint8_t ucOriginalNotifyState;
+	UBaseType_t uxSavedInterruptStatus;
 
-		/* Take a snapshot of the number of tasks in case it changes while this
-		function is executing. */
-		uxArraySize = uxCurrentNumberOfTasks;
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
-		/* Allocate an array index for each task.  NOTE!  if
-		configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
-		equate to NULL. */
-		pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+		configASSERT( xTaskToNotify );
 
-		if( pxTaskStatusArray != NULL )
+		/* RTOS ports that support interrupt nesting have the concept of a
+		maximum	system call (or maximum API call) interrupt priority.
+		Interrupts that are	above the maximum system call priority are keep
+		permanently enabled, even when the RTOS kernel is in a critical section,
+		but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+		is defined in FreeRTOSConfig.h then
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+		failure if a FreeRTOS API function is called from an interrupt that has
+		been assigned a priority above the configured maximum system call
+		priority.  Only FreeRTOS functions that end in FromISR can be called
+		from interrupts	that have been assigned a priority at or (logically)
+		below the maximum system call interrupt priority.  FreeRTOS maintains a
+		separate interrupt safe API to ensure interrupt entry is as fast and as
+		simple as possible.  More information (albeit Cortex-M specific) is
+		provided on the following link:
+		http://www.freertos.org/RTOS-Cortex-M3-M4.html */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		pxTCB = xTaskToNotify;
+
+		#if( configUSE_NOTIFY_GIVE_FAST_PATH == 1 )
 		{
-			/* Generate the (binary) data. */
-			uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
+		uint32_t ulCount;
 
-			/* Create a human readable table from the binary data. */
-			for( x = 0; x < uxArraySize; x++ )
+			/* 'Giving' is equivalent to incrementing a count in a counting
+			semaphore.  The increment is an exclusive access loop, so it is
+			not lost to a nested interrupt notifying the same task.  The task
+			itself only changes the count and the state in critical sections,
+			which this interrupt cannot run within, so the state read next is
+			current: only a task waiting for the notification needs the masked
+			section below, to be moved to the ready list. */
+			do
 			{
-				switch( pxTaskStatusArray[ x ].eCurrentState )
-				{
-					case eRunning:		cStatus = tskRUNNING_CHAR;
-										break;
+				ulCount = portLOAD_EXCLUSIVE( &( pxTCB->ulNotifiedValue[ uxIndexToNotify ] ) );
+			} while( portSTORE_EXCLUSIVE( &( pxTCB->ulNotifiedValue[ uxIndexToNotify ] ), ulCount + 1UL ) != 0UL );
 
-					case eReady:		cStatus = tskREADY_CHAR;
-										break;
+			if( pxTCB->ucNotifyState[ uxIndexToNotify ] != taskWAITING_NOTIFICATION )
+			{
+				/* Nested interrupts only ever set the state to received. */
+				pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+				traceTASK_NOTIFY_GIVE_FROM_ISR();
+				return;
+			}
+		}
+		#endif /* configUSE_NOTIFY_GIVE_FAST_PATH */
 
-					case eBlocked:		cStatus = tskBLOCKED_CHAR;
-										break;
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			/* Read again: with the fast path, a nested interrupt may have
+			unblocked the task since. */
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
-					case eSuspended:	cStatus = tskSUSPENDED_CHAR;
-										break;
+			#if( configUSE_NOTIFY_GIVE_FAST_PATH == 0 )
+			{
+				/* 'Giving' is equivalent to incrementing a count in a counting
+				semaphore. */
+				( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+			}
+			#endif
 
-					case eDeleted:		cStatus = tskDELETED_CHAR;
-										break;
+			traceTASK_NOTIFY_GIVE_FROM_ISR();
 
-					case eInvalid:		/* Fall through. */
-					default:			/* Should not get here, but it is included
-										to prevent static checking errors. */
-										cStatus = ( char ) 0x00;
-										break;
+			/* If the task is in the blocked state specifically to wait for a
+			notification then unblock it now. */
+			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			{
+				/* The task should not have been on an event list. */
+				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+				{
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					prvAddTaskToReadyList( pxTCB );
+				}
+				else
+				{
+					/* The delayed and ready lists cannot be accessed, so hold
+					this task pending until the scheduler is resumed. */
+					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				/* Write the task name to the string, padding with spaces so it
-				can be printed in tabular form more easily. */
-				pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+				if( taskPREEMPTS_CURRENT( pxTCB ) != pdFALSE )
+				{
+					/* The notified task has a priority above the currently
+					executing task so a yield is required. */
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
 
-				/* Write the rest of the string. */
-				sprintf( pcWriteBuffer, "\t%c\t%u\t%u\t%u\r\n", cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
-				pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+					/* Mark that a yield is pending in case the user is not
+					using the "xHigherPriorityTaskWoken" parameter in an ISR
+					safe FreeRTOS function. */
+					xYieldPending = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
-
-			/* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
-			is 0 then vPortFree() will be #defined to nothing. */
-			vPortFree( pxTaskStatusArray );
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
 		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 	}
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
-/*----------------------------------------------------------*/
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
 
-#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+#if( configUSE_NOTIFY_GROUPS == 1 )
 
-	void vTaskGetRunTimeStats( char *pcWriteBuffer )
+	static uint8_t prvNotifyGroupMember( TCB_t *pxTCB, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxReturn )
 	{
-	TaskStatus_t *pxTaskStatusArray;
-	UBaseType_t uxArraySize, x;
-	uint32_t ulTotalTime, ulStatsAsPercentage;
+	uint8_t ucOriginalNotifyState;
 
-		#if( configUSE_TRACE_FACILITY != 1 )
+		ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+		pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+
+		switch( eAction )
 		{
-			#error configUSE_TRACE_FACILITY must also be set to 1 in FreeRTOSConfig.h to use vTaskGetRunTimeStats().
+			case eSetBits	:
+				pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
+				break;
+
+			case eIncrement	:
+				( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+				break;
+
+			case eSetValueWithOverwrite	:
+				pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+				break;
+
+			case eSetValueWithoutOverwrite :
+				if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
+				{
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+				}
+				else
+				{
+					/* The value could not be written to this task. */
+					*pxReturn = pdFAIL;
+				}
+				break;
+
+			case eIncrementUpToValue :
+				if( pxTCB->ulNotifiedValue[ uxIndexToNotify ] < ulValue )
+				{
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+				}
+				else
+				{
+					/* The value of this task is already at the limit. */
+					*pxReturn = pdFAIL;
+				}
+				break;
+
+			case eNoAction :
+				break;
+
+			default:
+				configASSERT( pxTCB->ulNotifiedValue[ uxIndexToNotify ] == ~0UL );
+				break;
 		}
-		#endif
 
-		/*
-		 * PLEASE NOTE:
-		 *
-		 * This function is provided for convenience only, and is used by many
-		 * of the demo applications.  Do not consider it to be part of the
-		 * scheduler.
-		 *
-		 * vTaskGetRunTimeStats() calls uxTaskGetSystemState(), then formats part
-		 * of the uxTaskGetSystemState() output into a human readable table that
-		 * displays the amount of time each task has spent in the Running state
-		 * in both absolute and percentage terms.
-		 *
-		 * vTaskGetRunTimeStats() has a dependency on the sprintf() C library
-		 * function that might bloat the code size, use a lot of stack, and
-		 * provide different results on different platforms.  An alternative,
-		 * tiny, third party, and limited functionality implementation of
-		 * sprintf() is provided in many of the FreeRTOS/Demo sub-directories in
-		 * a file called printf-stdarg.c (note printf-stdarg.c does not provide
-		 * a full snprintf() implementation!).
-		 *
-		 * It is recommended that production systems call uxTaskGetSystemState()
-		 * directly to get access to raw stats data, rather than indirectly
-		 * through a call to vTaskGetRunTimeStats().
-		 */
+		return ucOriginalNotifyState;
+	}
 
-		/* Make sure the write buffer does not contain a string. */
-		*pcWriteBuffer = ( char ) 0x00;
+#endif /* configUSE_NOTIFY_GROUPS */
+/*-----------------------------------------------------------*/
 
-		/* Take a snapshot of the number of tasks in case it changes while this
-		function is executing. */
-		uxArraySize = uxCurrentNumberOfTasks;
+#if( configUSE_NOTIFY_GROUPS == 1 )
 
-		/* Allocate an array index for each task.  NOTE!  If
-		configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
-		equate to NULL. */
-		pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+	BaseType_t xTaskGenericNotifyGroup( TaskHandle_t const *pxTasksToNotify, UBaseType_t uxTaskCount, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction )
+	{
+	TCB_t * pxTCB;
+	BaseType_t xReturn = pdPASS, xYieldRequired = pdFALSE;
+	UBaseType_t uxTask;
 
-		if( pxTaskStatusArray != NULL )
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+		configASSERT( ( pxTasksToNotify != NULL ) || ( uxTaskCount == ( UBaseType_t ) 0 ) );
+
+		taskENTER_CRITICAL();
 		{
-			/* Generate the (binary) data. */
-			uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, &ulTotalTime );
+			for( uxTask = 0; uxTask < uxTaskCount; uxTask++ )
+			{
+				pxTCB = pxTasksToNotify[ uxTask ];
+				configASSERT( pxTCB );
 
-			/* For percentage calculations. */
-			ulTotalTime /= 100UL;
+				if( prvNotifyGroupMember( pxTCB, uxIndexToNotify, ulValue, eAction, &xReturn ) == taskWAITING_NOTIFICATION )
+				{
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					prvAddTaskToReadyList( pxTCB );
 
-			/* Avoid divide by zero errors. */
-			if( ulTotalTime > 0UL )
-			{
-				/* Create a human readable table from the binary data. */
-				for( x = 0; x < uxArraySize; x++ )
+					/* The task should not have been on an event list. */
+					configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+					/* Only noted: the yield waits for the last member, so a
+					woken task cannot run before the others are ready. */
+					if( taskPREEMPTS_CURRENT( pxTCB ) != pdFALSE )
+					{
+						xYieldRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
 				{
-					/* What percentage of the total run time has the task used?
-					This will always be rounded down to the nearest integer.
-					ulTotalRunTimeDiv100 has already been divided by 100. */
-					ulStatsAsPercentage = pxTaskStatusArray[ x ].ulRunTimeCounter / ulTotalTime;
+					mtCOVERAGE_TEST_MARKER();
+				}
 
-					/* Write the task name to the string, padding with
-					spaces so it can be printed in tabular form more
-					easily. */
-					pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+				traceTASK_NOTIFY();
+			}
+
+			if( xYieldRequired != pdFALSE )
+			{
+				taskYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			#if( configUSE_TICKLESS_IDLE != 0 )
+			{
+				/* As in xTaskGenericNotify(), once for all the members. */
+				prvResetNextTaskUnblockTime();
+			}
+			#endif
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_NOTIFY_GROUPS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_NOTIFY_GROUPS == 1 )
+
+	BaseType_t xTaskGenericNotifyGroupFromISR( TaskHandle_t const *pxTasksToNotify, UBaseType_t uxTaskCount, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	TCB_t * pxTCB;
+	BaseType_t xReturn = pdPASS, xYieldRequired = pdFALSE;
+	UBaseType_t uxTask, uxSavedInterruptStatus;
+
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+		configASSERT( ( pxTasksToNotify != NULL ) || ( uxTaskCount == ( UBaseType_t ) 0 ) );
+
+		/* See xTaskGenericNotifyFromISR(). */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			for( uxTask = 0; uxTask < uxTaskCount; uxTask++ )
+			{
+				pxTCB = pxTasksToNotify[ uxTask ];
+				configASSERT( pxTCB );
 
-					if( ulStatsAsPercentage > 0UL )
+				if( prvNotifyGroupMember( pxTCB, uxIndexToNotify, ulValue, eAction, &xReturn ) == taskWAITING_NOTIFICATION )
+				{
+					/* The task should not have been on an event list. */
+					configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+					if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 					{
-						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
-						}
-						#else
-						{
-							/* sizeof( int ) == sizeof( long ) so a smaller
-							printf() library can be used. */
-							sprintf( pcWriteBuffer, "\t%u\t\t%u%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
-						}
-						#endif
+						( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+						prvAddTaskToReadyList( pxTCB );
 					}
 					else
 					{
-						/* If the percentage is zero here then the task has
-						consumed less than 1% of the total run time. */
-						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
-						}
-						#else
-						{
-							/* sizeof( int ) == sizeof( long ) so a smaller
-							printf() library can be used. */
-							sprintf( pcWriteBuffer, "\t%u\t\t<1%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
-						}
-						#endif
+						/* The delayed and ready lists cannot be accessed, so
+						hold this task pending until the scheduler is
+						resumed. */
+						vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 					}
 
-					pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+					if( taskPREEMPTS_CURRENT( pxTCB ) != pdFALSE )
+					{
+						xYieldRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				traceTASK_NOTIFY_FROM_ISR();
+			}
+
+			if( xYieldRequired != pdFALSE )
+			{
+				if( pxHigherPriorityTaskWoken != NULL )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
 				}
+
+				/* Mark that a yield is pending in case the user is not using
+				the "xHigherPriorityTaskWoken" parameter to an ISR safe
+				FreeRTOS function. */
+				xYieldPending = pdTRUE;
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-			/* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
-			is 0 then vPortFree() will be #defined to nothing. */
-			vPortFree( pxTaskStatusArray );
+		return xReturn;
+	}
+
+#endif /* configUSE_NOTIFY_GROUPS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear )
+	{
+	TCB_t *pxTCB;
+	BaseType_t xReturn;
+
+		configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+		/* If null is passed in here then it is the calling task that is having
+		its notification state cleared. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		taskENTER_CRITICAL();
+		{
+			if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
+			{
+				pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
+				xReturn = pdPASS;
+			}
+			else
+			{
+				xReturn = pdFAIL;
+			}
 		}
-		else
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear, uint32_t ulBitsToClear )
+	{
+	TCB_t *pxTCB;
+	uint32_t ulReturn;
+
+		configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+		/* If null is passed in here then it is the calling task that is having
+		its notification state cleared. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		taskENTER_CRITICAL();
 		{
-			mtCOVERAGE_TEST_MARKER();
+			/* Return the notification as it was before the bits were cleared,
+			then clear the bit mask. */
+			ulReturn = pxTCB->ulNotifiedValue[ uxIndexToClear ];
+			pxTCB->ulNotifiedValue[ uxIndexToClear ] &= ~ulBitsToClear;
 		}
+		taskEXIT_CRITICAL();
+
+		return ulReturn;
 	}
 
-#endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-TickType_t uxTaskResetEventItemValue( void )
-{
-TickType_t uxReturn;
+#if( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
 
-	uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
+	configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
+	{
+		return xIdleTaskHandle->ulRunTimeCounter;
+	}
 
-	/* Reset the event list item to its normal value - so it can be used with
-	queues and semaphores. */
-	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+#endif
+/*-----------------------------------------------------------*/
 
-	return uxReturn;
-}
+#if( configUSE_SWITCH_STATS == 1 )
+
+	uint32_t ulTaskGetSwitchCount( void )
+	{
+		return ulSwitchCount;
+	}
+
+#endif
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if( configUSE_QUIESCENT_STATES == 1 )
 
-	TaskHandle_t pvTaskIncrementMutexHeldCount( void )
+	uint32_t ulTaskGracePeriodStart( void )
 	{
-		/* If xSemaphoreCreateMutex() is called before any tasks have been created
-		then pxCurrentTCB will be NULL. */
-		if( pxCurrentTCB != NULL )
+	uint32_t ulEpoch;
+
+		taskENTER_CRITICAL();
 		{
-			( pxCurrentTCB->uxMutexesHeld )++;
+			ulGraceEpoch++;
+			ulEpoch = ulGraceEpoch;
 		}
+		taskEXIT_CRITICAL();
 
-		return pxCurrentTCB;
+		return ulEpoch;
 	}
 
-#endif /* configUSE_MUTEXES */
+#endif
 /*-----------------------------------------------------------*/
 
-#if( configUSE_TASK_NOTIFICATIONS == 1 )
+#if( configUSE_QUIESCENT_STATES == 1 )
 
-	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+	BaseType_t xTaskGracePeriodElapsed( uint32_t ulEpoch )
 	{
-	uint32_t ulReturn;
-
-		taskENTER_CRITICAL();
+	BaseType_t xElapsed = pdTRUE;
+	UBaseType_t uxPriority;
+	const ListItem_t *pxItem;
+	const TCB_t *pxTCB;
+
+		/* Only a ready task can still be using what it read before the grace
+		period started: a blocked or suspended one passed a quiescent point
+		when it left the Ready state, whenever that was.  The pending ready
+		list is not looked at, as the scheduler is suspended here and its
+		tasks were blocked. */
+		vTaskSuspendAll();
 		{
-			/* Only block if the notification count is not already non-zero. */
-			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			for( uxPriority = ( UBaseType_t ) 0U; ( uxPriority < ( UBaseType_t ) configMAX_PRIORITIES ) && ( xElapsed != pdFALSE ); uxPriority++ )
 			{
-				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
-
-				if( xTicksToWait > ( TickType_t ) 0 )
+				for( pxItem = listGET_HEAD_ENTRY( &( pxReadyTasksLists[ uxPriority ] ) );
+					 pxItem != listGET_END_MARKER( &( pxReadyTasksLists[ uxPriority ] ) );
+					 pxItem = listGET_NEXT( pxItem ) )
 				{
-					prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-					traceTASK_NOTIFY_TAKE_BLOCK();
+					pxTCB = listGET_LIST_ITEM_OWNER( pxItem );
 
-					/* All ports are written to allow a yield in a critical
-					section (some will yield immediately, others wait until the
-					critical section exits) - but it is not something that
-					application code should ever do. */
-					portYIELD_WITHIN_API();
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
+					/* The caller and the idle task read nothing published. */
+					if( ( pxTCB != pxCurrentTCB ) && ( pxTCB != xIdleTaskHandle ) &&
+						( ( int32_t ) ( pxTCB->ulQuiescentEpoch - ulEpoch ) < 0 ) )
+					{
+						xElapsed = pdFALSE;
+						break;
+					}
 				}
 			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
 		}
-		taskEXIT_CRITICAL();
+		( void ) xTaskResumeAll();
+
+		return xElapsed;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	void vTaskPreemptionThresholdSet( TaskHandle_t xTask, UBaseType_t uxThreshold )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( uxThreshold < ( UBaseType_t ) configMAX_PRIORITIES );
+
+		if( uxThreshold >= ( UBaseType_t ) configMAX_PRIORITIES )
+		{
+			uxThreshold = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
 		taskENTER_CRITICAL();
 		{
-			traceTASK_NOTIFY_TAKE();
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
+			pxTCB = prvGetTCBFromHandle( xTask );
+			pxTCB->uxPreemptionThreshold = uxThreshold;
 
-			if( ulReturn != 0UL )
+			/* A lower threshold may let a task that is already ready preempt
+			the caller.  Another task's threshold only matters once it runs. */
+			if( ( pxTCB == pxCurrentTCB ) && ( prvReadyAboveLevel( taskPREEMPTION_LEVEL() ) != pdFALSE ) )
 			{
-				if( xClearCountOnExit != pdFALSE )
-				{
-					pxCurrentTCB->ulNotifiedValue = 0UL;
-				}
-				else
-				{
-					pxCurrentTCB->ulNotifiedValue = ulReturn - ( uint32_t ) 1;
-				}
+				taskYIELD_IF_USING_PREEMPTION();
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
-
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
-
-		return ulReturn;
 	}
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+#endif /* configUSE_PREEMPTION_THRESHOLD */
 /*-----------------------------------------------------------*/
 
-#if( configUSE_TASK_NOTIFICATIONS == 1 )
+#if( configUSE_PREEMPTION_THRESHOLD == 1 )
 
-	BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	UBaseType_t uxTaskPreemptionThresholdGet( TaskHandle_t xTask )
 	{
-	BaseType_t xReturn;
+	TCB_t const *pxTCB;
+	UBaseType_t uxReturn;
 
 		taskENTER_CRITICAL();
 		{
-			/* Only block if a notification is not already pending. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
-			{
-				/* Clear bits in the task's notification value as bits may get
-				set	by the notifying task or interrupt.  This can be used to
-				clear the value to zero. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxReturn = pxTCB->uxPreemptionThreshold;
+		}
+		taskEXIT_CRITICAL();
 
-				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+		return uxReturn;
+	}
 
-				if( xTicksToWait > ( TickType_t ) 0 )
-				{
-					prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-					traceTASK_NOTIFY_WAIT_BLOCK();
+#endif /* configUSE_PREEMPTION_THRESHOLD */
+/*-----------------------------------------------------------*/
 
-					/* All ports are written to allow a yield in a critical
-					section (some will yield immediately, others wait until the
-					critical section exits) - but it is not something that
-					application code should ever do. */
-					portYIELD_WITHIN_API();
-				}
-				else
+#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	KERNEL_RAM_FUNCTION static BaseType_t prvReadyAboveLevel( UBaseType_t uxLevel )
+	{
+	UBaseType_t uxTopPriority;
+	BaseType_t xAbove = pdFALSE;
+
+		#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+		{
+			/* uxTopReadyPriority is never below the highest ready priority,
+			but may be above it until the next selection. */
+			for( uxTopPriority = uxTopReadyPriority; uxTopPriority > uxLevel; uxTopPriority-- )
+			{
+				if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopPriority ] ) ) == pdFALSE )
 				{
-					mtCOVERAGE_TEST_MARKER();
+					xAbove = pdTRUE;
+					break;
 				}
 			}
-			else
+		}
+		#else
+		{
+			taskGET_HIGHEST_READY_PRIORITY( uxTopPriority );
+
+			if( uxTopPriority > uxLevel )
 			{
-				mtCOVERAGE_TEST_MARKER();
+				xAbove = pdTRUE;
 			}
 		}
-		taskEXIT_CRITICAL();
+		#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
-		taskENTER_CRITICAL();
+		return xAbove;
+	}
+
+#endif /* configUSE_PREEMPTION_THRESHOLD */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	KERNEL_RAM_FUNCTION static BaseType_t prvThresholdSelect( void )
+	{
+	TCB_t *pxTCB;
+
+		while( pxThresholdPreempted != NULL )
 		{
-			traceTASK_NOTIFY_WAIT();
+			pxTCB = pxThresholdPreempted;
 
-			if( pulNotificationValue != NULL )
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) == pdFALSE )
 			{
-				/* Output the current notification value, which may or may not
-				have changed. */
-				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
-			}
-
-			/* If ucNotifyValue is set then either the task never entered the
-			blocked state (because a notification was already pending) or the
-			task unblocked because of a notification.  Otherwise the task
-			unblocked because of a timeout. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+				/* Suspended by another task since: it has nothing to finish
+				until it is resumed. */
+				pxThresholdPreempted = pxTCB->pxThresholdNext;
+				pxTCB->pxThresholdNext = NULL;
+			}
+			else if( prvReadyAboveLevel( taskLEVEL_OF( pxTCB ) ) == pdFALSE )
 			{
-				/* A notification was not received. */
-				xReturn = pdFALSE;
+				/* Nothing may preempt it, so it carries on before any other
+				task of its priority or of one up to its threshold. */
+				pxThresholdPreempted = pxTCB->pxThresholdNext;
+				pxTCB->pxThresholdNext = NULL;
+				pxCurrentTCB = pxTCB;
+				return pdTRUE;
 			}
 			else
 			{
-				/* A notification was already pending or a notification was
-				received while the task was waiting. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
-				xReturn = pdTRUE;
+				/* Still preempted; so are the ones below, which have lower
+				thresholds. */
+				break;
 			}
-
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
 		}
-		taskEXIT_CRITICAL();
 
-		return xReturn;
+		return pdFALSE;
 	}
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+#endif /* configUSE_PREEMPTION_THRESHOLD */
 /*-----------------------------------------------------------*/
 
-#if( configUSE_TASK_NOTIFICATIONS == 1 )
+#if( configUSE_PREEMPTION_THRESHOLD == 1 )
 
-	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+	KERNEL_RAM_FUNCTION static void prvThresholdForget( TCB_t * const pxTCB )
 	{
-	TCB_t * pxTCB;
-	BaseType_t xReturn = pdPASS;
-	uint8_t ucOriginalNotifyState;
-
-		configASSERT( xTaskToNotify );
-		pxTCB = xTaskToNotify;
+	TCB_t **ppxLink = &pxThresholdPreempted;
 
-		taskENTER_CRITICAL();
+		/* As many entries as there are tasks preempted one above another,
+		which only their thresholds allow. */
+		while( *ppxLink != NULL )
 		{
-			if( pulPreviousNotificationValue != NULL )
+			if( *ppxLink == pxTCB )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*ppxLink = pxTCB->pxThresholdNext;
+				pxTCB->pxThresholdNext = NULL;
+				break;
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			ppxLink = &( ( *ppxLink )->pxThresholdNext );
+		}
+	}
 
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+#endif /* configUSE_PREEMPTION_THRESHOLD */
+/*-----------------------------------------------------------*/
 
-			switch( eAction )
-			{
-				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
-					break;
+#if( configUSE_TICK_STATS == 1 )
 
-				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
-					break;
+	KERNEL_RAM_FUNCTION static UBaseType_t prvTickStatsBucket( uint32_t ulCycles )
+	{
+	UBaseType_t uxBucket = 0;
 
-				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
-					break;
+		/* Bucket 0 counts 0, bucket n from 2^(n-1) to 2^n - 1, and the last
+		bucket everything longer too. */
+		while( ( uxBucket < ( UBaseType_t ) ( configTICK_STATS_BUCKETS - 1 ) ) && ( ( ulCycles >> uxBucket ) != 0UL ) )
+		{
+			uxBucket++;
+		}
 
-				case eSetValueWithoutOverwrite :
-					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
-					{
-						pxTCB->ulNotifiedValue = ulValue;
-					}
-					else
-					{
-						/* The value could not be written to the task. */
-						xReturn = pdFAIL;
-					}
-					break;
+		return uxBucket;
+	}
+	/*-----------------------------------------------------------*/
 
-				case eNoAction:
-					/* The task is being notified without its notify value being
-					updated. */
-					break;
+	KERNEL_RAM_FUNCTION void vTaskRecordTickStats( uint32_t ulLatencyCycles, uint32_t ulCycles )
+	{
+	uint32_t ulUnblocked = ulTickUnblocked;
 
-				default:
-					/* Should not get here if all enums are handled.
-					Artificially force an assert by testing a value the
-					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0UL );
+		/* Called by the tick interrupt with interrupts masked, so no other
+		writer or reader can run. */
+		xTickStats.ulTicks++;
+		xTickStats.ullTotalCycles += ulCycles;
+		xTickStats.ulCycleHistogram[ prvTickStatsBucket( ulCycles ) ]++;
+		xTickStats.ulLatencyHistogram[ prvTickStatsBucket( ulLatencyCycles ) ]++;
 
-					break;
-			}
+		if( ulCycles > xTickStats.ulMaxCycles )
+		{
+			xTickStats.ulMaxCycles = ulCycles;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-			traceTASK_NOTIFY();
+		if( ulLatencyCycles > xTickStats.ulMaxLatencyCycles )
+		{
+			xTickStats.ulMaxLatencyCycles = ulLatencyCycles;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-			/* If the task is in the blocked state specifically to wait for a
-			notification then unblock it now. */
-			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
-			{
-				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-				prvAddTaskToReadyList( pxTCB );
+		if( ulUnblocked > xTickStats.ulMaxUnblocked )
+		{
+			xTickStats.ulMaxUnblocked = ulUnblocked;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-				/* The task should not have been on an event list. */
-				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+		if( ulUnblocked > ( uint32_t ) ( configTICK_STATS_BUCKETS - 1 ) )
+		{
+			ulUnblocked = ( uint32_t ) ( configTICK_STATS_BUCKETS - 1 );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-				#if( configUSE_TICKLESS_IDLE != 0 )
-				{
-					/* If a task is blocked waiting for a notification then
-					xNextTaskUnblockTime might be set to the blocked task's time
-					out time.  If the task is unblocked for a reason other than
-					a timeout xNextTaskUnblockTime is normally left unchanged,
-					because it will automatically get reset to a new value when
-					the tick count equals xNextTaskUnblockTime.  However if
-					tickless idling is used it might be more important to enter
-					sleep mode at the earliest possible time - so reset
-					xNextTaskUnblockTime here to ensure it is updated at the
-					earliest possible time. */
-					prvResetNextTaskUnblockTime();
-				}
-				#endif
+		xTickStats.ulUnblockedHistogram[ ulUnblocked ]++;
+	}
+	/*-----------------------------------------------------------*/
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-				{
-					/* The notified task has a priority above the currently
-					executing task so a yield is required. */
-					taskYIELD_IF_USING_PREEMPTION();
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
+	void vTaskGetTickStats( TickStats_t *pxTickStats )
+	{
+		configASSERT( pxTickStats );
+
+		/* The critical section holds off the tick interrupt, which runs at the
+		kernel priority. */
+		taskENTER_CRITICAL();
+		{
+			*pxTickStats = xTickStats;
 		}
 		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
 
-		return xReturn;
+	void vTaskResetTickStats( void )
+	{
+		taskENTER_CRITICAL();
+		{
+			( void ) memset( &xTickStats, 0x00, sizeof( xTickStats ) );
+		}
+		taskEXIT_CRITICAL();
 	}
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+#endif /* configUSE_TICK_STATS */
 /*-----------------------------------------------------------*/
 
-#if( configUSE_TASK_NOTIFICATIONS == 1 )
+#if( configUSE_IDLE_SLEEP == 1 )
 
-	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+	void vTaskRecordIdleSleep( BaseType_t xTickWake, uint32_t ulWakeCycles )
 	{
-	TCB_t * pxTCB;
-	uint8_t ucOriginalNotifyState;
-	BaseType_t xReturn = pdPASS;
-	UBaseType_t uxSavedInterruptStatus;
-
-		configASSERT( xTaskToNotify );
-
-		/* RTOS ports that support interrupt nesting have the concept of a
-		maximum	system call (or maximum API call) interrupt priority.
-		Interrupts that are	above the maximum system call priority are keep
-		permanently enabled, even when the RTOS kernel is in a critical section,
-		but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-		is defined in FreeRTOSConfig.h then
-		portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-		failure if a FreeRTOS API function is called from an interrupt that has
-		been assigned a priority above the configured maximum system call
-		priority.  Only FreeRTOS functions that end in FromISR can be called
-		from interrupts	that have been assigned a priority at or (logically)
-		below the maximum system call interrupt priority.  FreeRTOS maintains a
-		separate interrupt safe API to ensure interrupt entry is as fast and as
-		simple as possible.  More information (albeit Cortex-M specific) is
-		provided on the following link:
-		http://www.freertos.org/RTOS-Cortex-M3-M4.html */
-		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+		/* Called by the idle task with interrupts masked, so it can neither
+		be preempted nor switched out. */
+		xIdleSleepStats.ulSleeps++;
 
-		pxTCB = xTaskToNotify;
-
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		if( xTickWake != pdFALSE )
 		{
-			if( pulPreviousNotificationValue != NULL )
-			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
-			}
+			xIdleSleepStats.ulTickWakes++;
+			xIdleSleepStats.ullTotalWakeCycles += ulWakeCycles;
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
-
-			switch( eAction )
+			if( ulWakeCycles > xIdleSleepStats.ulMaxWakeCycles )
 			{
-				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
-					break;
-
-				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
-					break;
-
-				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
-					break;
-
-				case eSetValueWithoutOverwrite :
-					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
-					{
-						pxTCB->ulNotifiedValue = ulValue;
-					}
-					else
-					{
-						/* The value could not be written to the task. */
-						xReturn = pdFAIL;
-					}
-					break;
-
-				case eNoAction :
-					/* The task is being notified without its notify value being
-					updated. */
-					break;
-
-				default:
-					/* Should not get here if all enums are handled.
-					Artificially force an assert by testing a value the
-					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0UL );
-					break;
+				xIdleSleepStats.ulMaxWakeCycles = ulWakeCycles;
 			}
-
-			traceTASK_NOTIFY_FROM_ISR();
-
-			/* If the task is in the blocked state specifically to wait for a
-			notification then unblock it now. */
-			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			else
 			{
-				/* The task should not have been on an event list. */
-				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
-
-				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-				{
-					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-					prvAddTaskToReadyList( pxTCB );
-				}
-				else
-				{
-					/* The delayed and ready lists cannot be accessed, so hold
-					this task pending until the scheduler is resumed. */
-					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
-				}
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-				{
-					/* The notified task has a priority above the currently
-					executing task so a yield is required. */
-					if( pxHigherPriorityTaskWoken != NULL )
-					{
-						*pxHigherPriorityTaskWoken = pdTRUE;
-					}
+	void vTaskGetIdleSleepStats( IdleSleepStats_t *pxIdleSleepStats )
+	{
+		configASSERT( pxIdleSleepStats );
 
-					/* Mark that a yield is pending in case the user is not
-					using the "xHigherPriorityTaskWoken" parameter to an ISR
-					safe FreeRTOS function. */
-					xYieldPending = pdTRUE;
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
-			}
+		taskENTER_CRITICAL();
+		{
+			*pxIdleSleepStats = xIdleSleepStats;
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
 
-		return xReturn;
+	void vTaskResetIdleSleepStats( void )
+	{
+		taskENTER_CRITICAL();
+		{
+			( void ) memset( &xIdleSleepStats, 0x00, sizeof( xIdleSleepStats ) );
+		}
+		taskEXIT_CRITICAL();
 	}
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+#endif /* configUSE_IDLE_SLEEP */
 /*-----------------------------------------------------------*/
 
-#if( configUSE_TASK_NOTIFICATIONS == 1 )
+#if( configUSE_DYNAMIC_TICK_RATE == 1 )
 
-	void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+	KERNEL_RAM_FUNCTION BaseType_t xTaskIncrementTickBy( TickType_t xTicks )
 	{
-	TCB_t * pxTCB;
-	uint8_t ucOriginalNotifyState;
-	UBaseType_t uxSavedInterruptStatus;
-
-		configASSERT( xTaskToNotify );
-
-		/* RTOS ports that support interrupt nesting have the concept of a
-		maximum	system call (or maximum API call) interrupt priority.
-		Interrupts that are	above the maximum system call priority are keep
-		permanently enabled, even when the RTOS kernel is in a critical section,
-		but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-		is defined in FreeRTOSConfig.h then
-		portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-		failure if a FreeRTOS API function is called from an interrupt that has
-		been assigned a priority above the configured maximum system call
-		priority.  Only FreeRTOS functions that end in FromISR can be called
-		from interrupts	that have been assigned a priority at or (logically)
-		below the maximum system call interrupt priority.  FreeRTOS maintains a
-		separate interrupt safe API to ensure interrupt entry is as fast and as
-		simple as possible.  More information (albeit Cortex-M specific) is
-		provided on the following link:
-		http://www.freertos.org/RTOS-Cortex-M3-M4.html */
-		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+	BaseType_t xSwitchRequired = pdFALSE;
+	#if( configUSE_TICK_STATS == 1 )
+		uint32_t ulUnblocked = 0UL;
+	#endif
 
-		pxTCB = xTaskToNotify;
+		configASSERT( xTicks > ( TickType_t ) 0 );
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		/* All but the last tick of the interrupt. */
+		while( xTicks > ( TickType_t ) 1 )
 		{
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
-
-			/* 'Giving' is equivalent to incrementing a count in a counting
-			semaphore. */
-			( pxTCB->ulNotifiedValue )++;
-
-			traceTASK_NOTIFY_GIVE_FROM_ISR();
-
-			/* If the task is in the blocked state specifically to wait for a
-			notification then unblock it now. */
-			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			#if( configUSE_DELAYED_TASK_WHEEL == 0 )
 			{
-				/* The task should not have been on an event list. */
-				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
-
-				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-				{
-					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-					prvAddTaskToReadyList( pxTCB );
-				}
-				else
+			TickType_t xJump;
+
+				/* Step the tick count up to the tick before the next task
+				wakes, as vTaskStepTick() does.  The tick count cannot wrap in
+				the step, as xNextTaskUnblockTime is never past portMAX_DELAY.
+				The wheel does not track its next wake time, so there every
+				tick is processed, each only looking at its own slot. */
+				if( ( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) && ( xNextTaskUnblockTime > xTickCount ) )
 				{
-					/* The delayed and ready lists cannot be accessed, so hold
-					this task pending until the scheduler is resumed. */
-					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
-				}
+					xJump = xNextTaskUnblockTime - xTickCount - ( TickType_t ) 1;
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-				{
-					/* The notified task has a priority above the currently
-					executing task so a yield is required. */
-					if( pxHigherPriorityTaskWoken != NULL )
+					if( xJump > ( xTicks - ( TickType_t ) 1 ) )
 					{
-						*pxHigherPriorityTaskWoken = pdTRUE;
+						xJump = xTicks - ( TickType_t ) 1;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
 					}
 
-					/* Mark that a yield is pending in case the user is not
-					using the "xHigherPriorityTaskWoken" parameter in an ISR
-					safe FreeRTOS function. */
-					xYieldPending = pdTRUE;
+					xTickCount += xJump;
+					xTicks -= xJump;
+					traceINCREASE_TICK_COUNT( xJump );
 				}
 				else
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
 			}
-		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
-	}
-
-#endif /* configUSE_TASK_NOTIFICATIONS */
-/*-----------------------------------------------------------*/
-
-#if( configUSE_TASK_NOTIFICATIONS == 1 )
+			#endif /* configUSE_DELAYED_TASK_WHEEL */
 
-	BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask )
-	{
-	TCB_t *pxTCB;
-	BaseType_t xReturn;
+			if( xTicks > ( TickType_t ) 1 )
+			{
+				/* A task wakes on this tick, or the scheduler is suspended and
+				it is pended. */
+				if( xTaskIncrementTick() != pdFALSE )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 
-		/* If null is passed in here then it is the calling task that is having
-		its notification state cleared. */
-		pxTCB = prvGetTCBFromHandle( xTask );
+				#if( configUSE_TICK_STATS == 1 )
+				{
+					ulUnblocked += ulTickUnblocked;
+				}
+				#endif
 
-		taskENTER_CRITICAL();
-		{
-			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
-			{
-				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
-				xReturn = pdPASS;
+				xTicks--;
 			}
 			else
 			{
-				xReturn = pdFAIL;
+				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		taskEXIT_CRITICAL();
-
-		return xReturn;
-	}
-
-#endif /* configUSE_TASK_NOTIFICATIONS */
-/*-----------------------------------------------------------*/
-
-#if( configUSE_TASK_NOTIFICATIONS == 1 )
-
-	uint32_t ulTaskNotifyValueClear( TaskHandle_t xTask, uint32_t ulBitsToClear )
-	{
-	TCB_t *pxTCB;
-	uint32_t ulReturn;
 
-		/* If null is passed in here then it is the calling task that is having
-		its notification state cleared. */
-		pxTCB = prvGetTCBFromHandle( xTask );
+		if( xTaskIncrementTick() != pdFALSE )
+		{
+			xSwitchRequired = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-		taskENTER_CRITICAL();
+		#if( configUSE_TICK_STATS == 1 )
 		{
-			/* Return the notification as it was before the bits were cleared,
-			then clear the bit mask. */
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
-			pxTCB->ulNotifiedValue &= ~ulBitsToClear;
+			/* Recorded for the whole interrupt. */
+			ulTickUnblocked += ulUnblocked;
 		}
-		taskEXIT_CRITICAL();
+		#endif
 
-		return ulReturn;
+		return xSwitchRequired;
 	}
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+#endif /* configUSE_DYNAMIC_TICK_RATE */
 /*-----------------------------------------------------------*/
 
-#if( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
+#if( configUSE_SWITCH_STATS == 1 )
 
-	uint32_t ulTaskGetIdleRunTimeCounter( void )
+	void vTaskYieldVoluntary( void )
 	{
-		return xIdleTaskHandle->ulRunTimeCounter;
+		/* Cleared by the switch it requests, or by the next one if the yield
+		is held while the scheduler is suspended. */
+		xYieldIsVoluntary = pdTRUE;
+		portYIELD();
 	}
 
 #endif
 /*-----------------------------------------------------------*/
 
-static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely )
+KERNEL_RAM_FUNCTION static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely )
 {
 TickType_t xTimeToWake;
 const TickType_t xConstTickCount = xTickCount;
@@ -5193,14 +8817,30 @@ const TickType_t xConstTickCount = xTickCount;
 	if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
 	{
 		/* The current task must be in a ready list, so there is no need to
-		check, and the port reset macro can be called directly. */
-		portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority ); /*lint !e931 pxCurrentTCB cannot change as it is the calling task.  pxCurrentTCB->uxPriority and uxTopReadyPriority cannot change as called with scheduler suspended or in a critical section. */
+		check, and the bitmap can be cleared directly. */
+		taskCLEAR_READY_PRIORITY( pxCurrentTCB->uxPriority ); /*lint !e931 pxCurrentTCB cannot change as it is the calling task.  pxCurrentTCB->uxPriority and uxTopReadyPriority cannot change as called with scheduler suspended or in a critical section. */
 	}
 	else
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
 
+	#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+	{
+		/* The slot of the current tick has already been processed, so a task
+		that would wake now wakes on the next tick, as it would from the
+		sorted list. */
+		if( xTicksToWait == ( TickType_t ) 0 )
+		{
+			xTicksToWait = ( TickType_t ) 1;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
 	#if ( INCLUDE_vTaskSuspend == 1 )
 	{
 		if( ( xTicksToWait == portMAX_DELAY ) && ( xCanBlockIndefinitely != pdFALSE ) )
@@ -5217,24 +8857,93 @@ const TickType_t xConstTickCount = xTickCount;
 			kernel will manage it correctly. */
 			xTimeToWake = xConstTickCount + xTicksToWait;
 
+			#if( configUSE_64_BIT_TICKS == 1 )
+			{
+				/* The tick count never wraps, so only a block time close to
+				portMAX_DELAY can overflow, and the overflow list is not used: the
+				task waits for ever. */
+				if( xTimeToWake < xConstTickCount )
+				{
+					xTimeToWake = portMAX_DELAY;
+				}
+			}
+			#endif /* configUSE_64_BIT_TICKS */
+
 			/* The list item will be inserted in wake time order. */
 			listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+			#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+			{
+				if( xTimeToWake < xConstTickCount )
+				{
+					/* Wake time has overflowed.  Place this item in the overflow
+					list. */
+					vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+				}
+				else
+				{
+					/* The wake time has not overflowed, so the current block list
+					is used. */
+					vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+					/* If the task entering the blocked state was placed at the
+					head of the list of blocked tasks then xNextTaskUnblockTime
+					needs to be updated too. */
+					if( xTimeToWake < xNextTaskUnblockTime )
+					{
+						xNextTaskUnblockTime = xTimeToWake;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			#else
+			{
+				/* The slot is not sorted, so there is nothing to search. */
+				vListInsertEnd( taskWHEEL_SLOT( xTimeToWake ), &( pxCurrentTCB->xStateListItem ) );
+			}
+			#endif
+		}
+	}
+	#else /* INCLUDE_vTaskSuspend */
+	{
+		/* Calculate the time at which the task should be woken if the event
+		does not occur.  This may overflow but this doesn't matter, the kernel
+		will manage it correctly. */
+		xTimeToWake = xConstTickCount + xTicksToWait;
+
+		#if( configUSE_64_BIT_TICKS == 1 )
+		{
+			/* The tick count never wraps, so only a block time close to
+			portMAX_DELAY can overflow, and the overflow list is not used: the
+			task waits for ever. */
+			if( xTimeToWake < xConstTickCount )
+			{
+				xTimeToWake = portMAX_DELAY;
+			}
+		}
+		#endif /* configUSE_64_BIT_TICKS */
+
+		/* The list item will be inserted in wake time order. */
+		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
+
+		#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+		{
 			if( xTimeToWake < xConstTickCount )
 			{
-				/* Wake time has overflowed.  Place this item in the overflow
-				list. */
+				/* Wake time has overflowed.  Place this item in the overflow list. */
 				vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 			}
 			else
 			{
-				/* The wake time has not overflowed, so the current block list
-				is used. */
+				/* The wake time has not overflowed, so the current block list is used. */
 				vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 
-				/* If the task entering the blocked state was placed at the
-				head of the list of blocked tasks then xNextTaskUnblockTime
-				needs to be updated too. */
+				/* If the task entering the blocked state was placed at the head of the
+				list of blocked tasks then xNextTaskUnblockTime needs to be updated
+				too. */
 				if( xTimeToWake < xNextTaskUnblockTime )
 				{
 					xNextTaskUnblockTime = xTimeToWake;
@@ -5245,33 +8954,81 @@ const TickType_t xConstTickCount = xTickCount;
 				}
 			}
 		}
+		#else
+		{
+			/* The slot is not sorted, so there is nothing to search. */
+			vListInsertEnd( taskWHEEL_SLOT( xTimeToWake ), &( pxCurrentTCB->xStateListItem ) );
+		}
+		#endif
+
+		/* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
+		( void ) xCanBlockIndefinitely;
 	}
-	#else /* INCLUDE_vTaskSuspend */
-	{
-		/* Calculate the time at which the task should be woken if the event
-		does not occur.  This may overflow but this doesn't matter, the kernel
-		will manage it correctly. */
-		xTimeToWake = xConstTickCount + xTicksToWait;
+	#endif /* INCLUDE_vTaskSuspend */
+}
 
-		/* The list item will be inserted in wake time order. */
-		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
+#if( taskUSE_DIAGNOSTICS_TABLE == 1 )
+
+	static void prvClaimTaskDiagnostics( const TCB_t *pxTCB, UBaseType_t uxTCBNumber )
+	{
+	UBaseType_t x;
 
-		if( xTimeToWake < xConstTickCount )
+		for( x = 0; x < ( UBaseType_t ) configLEAN_TCB_DIAGNOSTIC_ENTRIES; x++ )
 		{
-			/* Wake time has overflowed.  Place this item in the overflow list. */
-			vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+			if( xTaskDiagnostics[ x ].pxTCB == NULL )
+			{
+				xTaskDiagnostics[ x ].pxTCB = pxTCB;
+				xTaskDiagnostics[ x ].uxTCBNumber = uxTCBNumber;
+				xTaskDiagnostics[ x ].uxTaskNumber = 0U;
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
-		else
+	}
+	/*-----------------------------------------------------------*/
+
+	#if( INCLUDE_vTaskDelete == 1 )
+
+	static void prvReleaseTaskDiagnostics( const TCB_t *pxTCB )
+	{
+	UBaseType_t x;
+
+		taskENTER_CRITICAL();
 		{
-			/* The wake time has not overflowed, so the current block list is used. */
-			vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+			for( x = 0; x < ( UBaseType_t ) configLEAN_TCB_DIAGNOSTIC_ENTRIES; x++ )
+			{
+				if( xTaskDiagnostics[ x ].pxTCB == pxTCB )
+				{
+					xTaskDiagnostics[ x ].pxTCB = NULL;
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	#endif /* INCLUDE_vTaskDelete */
+	/*-----------------------------------------------------------*/
+
+	static UBaseType_t prvGetTaskDiagnostic( const TCB_t *pxTCB, BaseType_t xTaskNumber )
+	{
+	UBaseType_t x;
+	UBaseType_t uxReturn = 0U;
 
-			/* If the task entering the blocked state was placed at the head of the
-			list of blocked tasks then xNextTaskUnblockTime needs to be updated
-			too. */
-			if( xTimeToWake < xNextTaskUnblockTime )
+		/* The entry of an existing task does not move, so no lock is needed. */
+		for( x = 0; x < ( UBaseType_t ) configLEAN_TCB_DIAGNOSTIC_ENTRIES; x++ )
+		{
+			if( xTaskDiagnostics[ x ].pxTCB == pxTCB )
 			{
-				xNextTaskUnblockTime = xTimeToWake;
+				uxReturn = ( xTaskNumber != pdFALSE ) ? xTaskDiagnostics[ x ].uxTaskNumber : xTaskDiagnostics[ x ].uxTCBNumber;
+				break;
 			}
 			else
 			{
@@ -5279,11 +9036,30 @@ const TickType_t xConstTickCount = xTickCount;
 			}
 		}
 
-		/* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
-		( void ) xCanBlockIndefinitely;
+		return uxReturn;
 	}
-	#endif /* INCLUDE_vTaskSuspend */
-}
+	/*-----------------------------------------------------------*/
+
+	static void prvSetTaskNumber( const TCB_t *pxTCB, UBaseType_t uxTaskNumber )
+	{
+	UBaseType_t x;
+
+		for( x = 0; x < ( UBaseType_t ) configLEAN_TCB_DIAGNOSTIC_ENTRIES; x++ )
+		{
+			if( xTaskDiagnostics[ x ].pxTCB == pxTCB )
+			{
+				xTaskDiagnostics[ x ].uxTaskNumber = uxTaskNumber;
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+#endif /* taskUSE_DIAGNOSTICS_TABLE */
+/*-----------------------------------------------------------*/
 
 /* Code below here allows additional code to be inserted into this source file,
 especially where access to file scope functions and data is needed (for example
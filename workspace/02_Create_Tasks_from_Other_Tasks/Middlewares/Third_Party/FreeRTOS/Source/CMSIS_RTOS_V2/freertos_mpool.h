@@ -29,22 +29,25 @@
 
 /* Memory Pool implementation definitions */
 #define MPOOL_STATUS              0x5EED0000U
+#define MPOOL_NIL                 0xFFFFU   /* No block */
 
-/* Memory Block header */
+/* Memory Block header, overlaid on a free block */
 typedef struct {
-  void *next;                   /* Pointer to next block  */
+  uint32_t next;                /* Index of next free block */
 } MemPoolBlock_t;
 
 /* Memory Pool control block */
 typedef struct MemPoolDef_t {
-  MemPoolBlock_t    *head;      /* Pointer to head block   */
-  SemaphoreHandle_t  sem;       /* Pool semaphore handle   */
+  volatile uint32_t  head;      /* Tag (31:16) and index (15:0) of head block */
+  volatile uint32_t  used;      /* Number of allocated blocks */
+  volatile uint32_t  waiters;   /* Tasks blocked on an empty pool */
+  SemaphoreHandle_t  sem;       /* Wakes tasks blocked on an empty pool */
   uint8_t           *mem_arr;   /* Pool memory array       */
   uint32_t           mem_sz;    /* Pool memory array size  */
   const char        *name;      /* Pointer to name string  */
   uint32_t           bl_sz;     /* Size of a single block  */
   uint32_t           bl_cnt;    /* Number of blocks        */
-  uint32_t           n;         /* Block allocation index  */
+  uint32_t           bl_step;   /* Block size rounded up to 4 bytes */
   volatile uint32_t  status;    /* Object status flags     */
 #if (configSUPPORT_STATIC_ALLOCATION == 1)
   StaticSemaphore_t  mem_sem;   /* Semaphore object memory */
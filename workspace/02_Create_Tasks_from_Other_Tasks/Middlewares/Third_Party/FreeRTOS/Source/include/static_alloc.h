@@ -0,0 +1,170 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Static kernel objects defined at compile time.
+ *
+ * Each staticDEFINE_...() macro, used at file scope, defines the storage of
+ * one kernel object, a global handle named after it, and a creation function
+ * that passes the storage to the matching ...CreateStatic() function.
+ * staticCREATE() calls that function before the scheduler starts, so all of
+ * the memory is in .bss and its size is known at link time:
+
+	staticDEFINE_QUEUE( xYearQueue, 5, sizeof( int32_t ) );
+	staticDEFINE_TASK( xSenderTask, vSenderTask, "Sender", 128, NULL, 1 );
+
+	int main( void )
+	{
+		staticCREATE( xYearQueue );
+		staticCREATE( xSenderTask );
+		vTaskStartScheduler();
+	}
+
+ * Creation cannot fail, as nothing is allocated - staticCREATE() only checks
+ * the handle with configASSERT().  With every object defined this way, and
+ * with the idle and timer task memory supplied by
+ * vApplicationGetIdleTaskMemory() and vApplicationGetTimerTaskMemory() (the
+ * CMSIS-RTOS2 layer provides weak definitions using configMINIMAL_STACK_SIZE
+ * and configTIMER_TASK_STACK_DEPTH), configSUPPORT_DYNAMIC_ALLOCATION can be
+ * set to 0 and the kernel heap is not built.
+ *
+ * The handles are ordinary globals and can be declared extern elsewhere.  The
+ * storage names are derived from the handle name and are private to the file.
+ * Queues are also added to the queue registry under their handle name, when
+ * configQUEUE_REGISTRY_SIZE is not 0.
+ */
+
+#ifndef STATIC_ALLOC_H
+#define STATIC_ALLOC_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include static_alloc.h"
+#endif
+
+#if( configSUPPORT_STATIC_ALLOCATION != 1 )
+	#error configSUPPORT_STATIC_ALLOCATION must be set to 1 to use static_alloc.h
+#endif
+
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+#include "event_groups.h"
+
+/*-----------------------------------------------------------*/
+
+/* Creates the object defined with the given handle name. */
+#define staticCREATE( xName )	do { ( void ) xName##Create(); configASSERT( xName ); } while( 0 )
+
+/*-----------------------------------------------------------*/
+
+#define staticDEFINE_TASK( xName, pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority )	\
+	static StackType_t xName##Stack[ ( ulStackDepth ) ];											\
+	static StaticTask_t xName##TCB;																	\
+	TaskHandle_t xName = NULL;																		\
+	static inline TaskHandle_t xName##Create( void )												\
+	{																								\
+		xName = xTaskCreateStatic( ( pxTaskCode ), ( pcName ), ( ulStackDepth ), ( pvParameters ),	\
+								   ( uxPriority ), xName##Stack, &( xName##TCB ) );					\
+		return xName;																				\
+	}
+
+#define staticDEFINE_QUEUE( xName, uxQueueLength, uxItemSize )										\
+	static uint8_t xName##Storage[ ( uxQueueLength ) * ( uxItemSize ) ];							\
+	static StaticQueue_t xName##Queue;																\
+	QueueHandle_t xName = NULL;																		\
+	static inline QueueHandle_t xName##Create( void )												\
+	{																								\
+		xName = xQueueCreateStatic( ( uxQueueLength ), ( uxItemSize ), xName##Storage, &( xName##Queue ) ); \
+		vQueueAddToRegistry( xName, #xName );														\
+		return xName;																				\
+	}
+
+#define staticDEFINE_BINARY_SEMAPHORE( xName )														\
+	static StaticSemaphore_t xName##Semaphore;														\
+	SemaphoreHandle_t xName = NULL;																	\
+	static inline SemaphoreHandle_t xName##Create( void )											\
+	{																								\
+		xName = xSemaphoreCreateBinaryStatic( &( xName##Semaphore ) );								\
+		return xName;																				\
+	}
+
+#if( configUSE_COUNTING_SEMAPHORES == 1 )
+	#define staticDEFINE_COUNTING_SEMAPHORE( xName, uxMaxCount, uxInitialCount )					\
+		static StaticSemaphore_t xName##Semaphore;													\
+		SemaphoreHandle_t xName = NULL;																\
+		static inline SemaphoreHandle_t xName##Create( void )										\
+		{																							\
+			xName = xSemaphoreCreateCountingStatic( ( uxMaxCount ), ( uxInitialCount ), &( xName##Semaphore ) ); \
+			return xName;																			\
+		}
+#endif /* configUSE_COUNTING_SEMAPHORES */
+
+#if( configUSE_MUTEXES == 1 )
+	#define staticDEFINE_MUTEX( xName )																\
+		static StaticSemaphore_t xName##Semaphore;													\
+		SemaphoreHandle_t xName = NULL;																\
+		static inline SemaphoreHandle_t xName##Create( void )										\
+		{																							\
+			xName = xSemaphoreCreateMutexStatic( &( xName##Semaphore ) );							\
+			return xName;																			\
+		}
+#endif /* configUSE_MUTEXES */
+
+#if( configUSE_RECURSIVE_MUTEXES == 1 )
+	#define staticDEFINE_RECURSIVE_MUTEX( xName )													\
+		static StaticSemaphore_t xName##Semaphore;													\
+		SemaphoreHandle_t xName = NULL;																\
+		static inline SemaphoreHandle_t xName##Create( void )										\
+		{																							\
+			xName = xSemaphoreCreateRecursiveMutexStatic( &( xName##Semaphore ) );					\
+			return xName;																			\
+		}
+#endif /* configUSE_RECURSIVE_MUTEXES */
+
+#if( configUSE_TIMERS == 1 )
+	#define staticDEFINE_TIMER( xName, pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction ) \
+		static StaticTimer_t xName##Timer;															\
+		TimerHandle_t xName = NULL;																	\
+		static inline TimerHandle_t xName##Create( void )											\
+		{																							\
+			xName = xTimerCreateStatic( ( pcTimerName ), ( xTimerPeriodInTicks ), ( uxAutoReload ),	\
+										( pvTimerID ), ( pxCallbackFunction ), &( xName##Timer ) );	\
+			return xName;																			\
+		}
+#endif /* configUSE_TIMERS */
+
+#define staticDEFINE_EVENT_GROUP( xName )															\
+	static StaticEventGroup_t xName##EventGroup;													\
+	EventGroupHandle_t xName = NULL;																\
+	static inline EventGroupHandle_t xName##Create( void )											\
+	{																								\
+		xName = xEventGroupCreateStatic( &( xName##EventGroup ) );									\
+		return xName;																				\
+	}
+
+#endif /* STATIC_ALLOC_H */
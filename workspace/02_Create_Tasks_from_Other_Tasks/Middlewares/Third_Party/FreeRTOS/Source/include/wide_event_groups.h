@@ -0,0 +1,255 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A wide event group is an event group of 64 bits, all of them usable.  An
+ * EventBits_t keeps its top 8 bits for control information, which leaves 24
+ * event bits with configUSE_16_BIT_TICKS 0, and only 8 with 1, so a system
+ * with more event sources has to spread them over several groups, and a task
+ * waiting for all of them has to wait on each group in turn.
+ *
+ * The wait semantics are those of xEventGroupWaitBits(): wait for any or for
+ * all of a set of bits, optionally clearing them on exit.
+ *
+ * - The bits are two 32-bit words.  Where the port provides exclusive
+ *   accesses (portLOAD_EXCLUSIVE and portSTORE_EXCLUSIVE), setting bits with
+ *   no task waiting, and clearing bits, are lock-free read-modify-writes of
+ *   the words.  Otherwise they take a critical section.
+ *
+ * - The waiting tasks are linked through records on their own stacks, and
+ *   block on one entry of their task notification array (see
+ *   configTASK_NOTIFICATION_ARRAY_ENTRIES), the same index for all the tasks
+ *   that wait on the group.  The index belongs to the group while a task waits
+ *   on it.  Index 0 (tskDEFAULT_INDEX_TO_NOTIFY) is also used by the task
+ *   notification functions that do not take an index, and by stream buffers.
+ *
+ * - Setting bits while tasks wait tests each waiting task, and notifies those
+ *   whose condition is met, in a critical section.  That is also what makes
+ *   the FromISR() variants direct, like configUSE_EVENT_GROUPS_DIRECT_FROM_ISR:
+ *   interrupts are masked for a time bounded by the number of waiting tasks.
+ *
+ * There is no xEventGroupSync() equivalent.  Use a barrier (barrier.h) for a
+ * rendezvous.
+ */
+
+#ifndef WIDE_EVENT_GROUPS_H
+#define WIDE_EVENT_GROUPS_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include wide_event_groups.h"
+#endif
+
+#include "task.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * The 64 event bits of a wide event group.
+ */
+typedef uint64_t WideEventBits_t;
+
+/* A task waiting on a wide event group, defined in wide_event_groups.c. */
+struct WideEventWaiter;
+
+/**
+ * The storage of a wide event group, declared by the application and passed
+ * to xWideEventGroupCreateStatic().  Its members must not be accessed directly.
+ */
+typedef struct WideEventGroupDef_t
+{
+	volatile uint32_t ulBits[ 2 ];			/* Bits 0 to 31, then 32 to 63. */
+	struct WideEventWaiter * volatile pxWaiters;
+	UBaseType_t uxIndex;
+} StaticWideEventGroup_t;
+
+/**
+ * Type by which wide event groups are referenced.
+ */
+typedef StaticWideEventGroup_t * WideEventGroupHandle_t;
+
+/**
+ * wide_event_groups.h
+ *
+<pre>
+WideEventGroupHandle_t xWideEventGroupCreateStatic( UBaseType_t uxIndex,
+                                                    StaticWideEventGroup_t *pxEventGroupBuffer );
+</pre>
+ *
+ * Creates a wide event group, with all its bits clear, in pxEventGroupBuffer.
+ *
+ * @param uxIndex The notification index the waiting tasks block on.
+ *
+ * @param pxEventGroupBuffer The storage of the event group.
+ *
+ * @return A handle to the event group.
+ *
+ * Example usage:
+<pre>
+#define SENSOR_BIT( n )		( ( WideEventBits_t ) 1 << ( n ) )
+#define ALL_SENSORS			( ~( WideEventBits_t ) 0 )
+
+static StaticWideEventGroup_t xEventGroupBuffer;
+WideEventGroupHandle_t xEventGroup;
+
+void vSetup( void )
+{
+	xEventGroup = xWideEventGroupCreateStatic( 1, &xEventGroupBuffer );
+}
+
+void vSensorTask( void *pvParameters )
+{
+UBaseType_t uxSensor = ( UBaseType_t ) pvParameters;
+
+	for( ;; )
+	{
+		vReadSensor( uxSensor );
+		( void ) xWideEventGroupSetBits( xEventGroup, SENSOR_BIT( uxSensor ) );
+	}
+}
+
+void vFusionTask( void *pvParameters )
+{
+	for( ;; )
+	{
+		// One wait for all 64 sensors.
+		( void ) xWideEventGroupWaitBits( xEventGroup, ALL_SENSORS, pdTRUE, pdTRUE, portMAX_DELAY );
+		vFuse();
+	}
+}
+</pre>
+ * \defgroup xWideEventGroupCreateStatic xWideEventGroupCreateStatic
+ * \ingroup WideEventGroups
+ */
+WideEventGroupHandle_t xWideEventGroupCreateStatic( UBaseType_t uxIndex, StaticWideEventGroup_t *pxEventGroupBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * wide_event_groups.h
+ *
+<pre>
+WideEventBits_t xWideEventGroupWaitBits( WideEventGroupHandle_t xEventGroup,
+                                         const WideEventBits_t uxBitsToWaitFor,
+                                         const BaseType_t xClearOnExit,
+                                         const BaseType_t xWaitForAllBits,
+                                         TickType_t xTicksToWait );
+</pre>
+ *
+ * Blocks for up to xTicksToWait until any, or all, of uxBitsToWaitFor are set,
+ * as xEventGroupWaitBits() does.  Cannot be called from an interrupt.
+ *
+ * @param uxBitsToWaitFor The bits to test, not 0.
+ *
+ * @param xClearOnExit pdTRUE to clear uxBitsToWaitFor before returning if the
+ * condition was met.  The bits are not cleared on a timeout.
+ *
+ * @param xWaitForAllBits pdTRUE to wait for all of uxBitsToWaitFor, pdFALSE
+ * for any of them.
+ *
+ * @return The bits of the group when the condition was met, before they were
+ * cleared, or when the block time expired.
+ *
+ * \defgroup xWideEventGroupWaitBits xWideEventGroupWaitBits
+ * \ingroup WideEventGroups
+ */
+WideEventBits_t xWideEventGroupWaitBits( WideEventGroupHandle_t xEventGroup, const WideEventBits_t uxBitsToWaitFor, const BaseType_t xClearOnExit, const BaseType_t xWaitForAllBits, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * wide_event_groups.h
+ *
+<pre>
+WideEventBits_t xWideEventGroupSetBits( WideEventGroupHandle_t xEventGroup,
+                                        const WideEventBits_t uxBitsToSet );
+</pre>
+ *
+ * Sets bits and unblocks the tasks whose condition that meets.
+ *
+ * @return The bits of the group once set.  The tasks unblocked may have
+ * cleared some of them since.
+ *
+ * \defgroup xWideEventGroupSetBits xWideEventGroupSetBits
+ * \ingroup WideEventGroups
+ */
+WideEventBits_t xWideEventGroupSetBits( WideEventGroupHandle_t xEventGroup, const WideEventBits_t uxBitsToSet ) PRIVILEGED_FUNCTION;
+
+/**
+ * wide_event_groups.h
+ *
+<pre>
+WideEventBits_t xWideEventGroupSetBitsFromISR( WideEventGroupHandle_t xEventGroup,
+                                               const WideEventBits_t uxBitsToSet,
+                                               BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xWideEventGroupSetBits() that can be called from an interrupt.
+ * It does not defer to the timer service task.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a task of a higher
+ * priority than the interrupted one was unblocked, in which case a context
+ * switch should be requested before the interrupt exits.
+ *
+ * \defgroup xWideEventGroupSetBitsFromISR xWideEventGroupSetBitsFromISR
+ * \ingroup WideEventGroups
+ */
+WideEventBits_t xWideEventGroupSetBitsFromISR( WideEventGroupHandle_t xEventGroup, const WideEventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * wide_event_groups.h
+ *
+<pre>
+WideEventBits_t xWideEventGroupClearBits( WideEventGroupHandle_t xEventGroup,
+                                          const WideEventBits_t uxBitsToClear );
+</pre>
+ *
+ * Clears bits.  Can also be called from an interrupt.
+ *
+ * @return The bits of the group before they were cleared.
+ *
+ * \defgroup xWideEventGroupClearBits xWideEventGroupClearBits
+ * \ingroup WideEventGroups
+ */
+WideEventBits_t xWideEventGroupClearBits( WideEventGroupHandle_t xEventGroup, const WideEventBits_t uxBitsToClear ) PRIVILEGED_FUNCTION;
+
+/**
+ * wide_event_groups.h
+ *
+<pre>
+WideEventBits_t xWideEventGroupGetBits( WideEventGroupHandle_t xEventGroup );
+</pre>
+ *
+ * @return The bits of the group.  Can also be called from an interrupt.
+ *
+ * \defgroup xWideEventGroupGetBits xWideEventGroupGetBits
+ * \ingroup WideEventGroups
+ */
+WideEventBits_t xWideEventGroupGetBits( WideEventGroupHandle_t xEventGroup ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif	/* !defined( WIDE_EVENT_GROUPS_H ) */
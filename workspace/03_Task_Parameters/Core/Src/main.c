@@ -1,6 +1,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
 
 /* Macros --------------------------------------------------------------------*/
@@ -9,12 +10,18 @@
 #define RED		GPIO_PIN_14
 #define BLUE	GPIO_PIN_15
 
+#define STACK_OVERFLOW_DEMO 0	/* 0: tasks run normally, 1: the blue task overflows its stack */
+
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 static void MX_USART2_UART_Init(void);
 int __io_putchar(int ch);
 void vLedControllerTask(void *pvParameters);
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName);
+#if (STACK_OVERFLOW_DEMO == 1)
+static uint32_t prvRecurse(uint32_t ulDepth);
+#endif
 
 /* Data types ----------------------------------------------------------------*/
 UART_HandleTypeDef huart2;
@@ -97,6 +104,14 @@ void vLedControllerTask(void *pvParameters)
 	{
 		HAL_GPIO_TogglePin(GPIOD, *(uint16_t *)pvParameters);
 
+#if (STACK_OVERFLOW_DEMO == 1)
+		/* 64 frames take well over the 400 bytes of the stack. */
+		if (pvParameters == (void *)pBlueLed)
+		{
+			(void)prvRecurse(64U);
+		}
+#endif
+
 		/* Delay to allow observation through the SFR window. */
 		for (i = 0; i < 60000; i++)
 		{
@@ -105,6 +120,44 @@ void vLedControllerTask(void *pvParameters)
 	}
 }
 
+/**
+ * @brief Reports a task that ran into the MPU guard under its stack.
+ * @param xTask Task that overflowed its stack.
+ * @param pcTaskName Name of the task.
+ * @retval None
+ * @note Called from MemManage_Handler(), on the main stack. The context of the
+ * task is lost, so it does not return: the red LED stays on.
+ */
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
+{
+	(void)xTask;
+
+	printf("Stack overflow: %s\r\n", pcTaskName);
+	HAL_GPIO_WritePin(GPIOD, RED, GPIO_PIN_SET);
+
+	__disable_irq();
+	while (1)
+	{
+		/* Do nothing */
+	}
+}
+
+#if (STACK_OVERFLOW_DEMO == 1)
+/**
+ * @brief Recurses to use up the stack.
+ * @param ulDepth Number of frames left.
+ * @retval Sum of the depths, so that no frame can be optimised away.
+ */
+static uint32_t prvRecurse(uint32_t ulDepth)
+{
+	volatile uint32_t ulFrame[8];
+
+	ulFrame[0] = ulDepth;
+
+	return (ulDepth == 0U) ? ulFrame[0] : (prvRecurse(ulDepth - 1U) + ulFrame[0]);
+}
+#endif
+
 /**
  * @brief Retargets the C library printf function to UART.
  * @note This function is typically used when you want printf() output to be
@@ -124,44 +177,9 @@ int __io_putchar(int ch)
  */
 void SystemClock_Config(void)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
-
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-	{
-		Error_Handler();
-	}
-
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
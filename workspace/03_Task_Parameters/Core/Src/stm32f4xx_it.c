@@ -22,6 +22,8 @@
 #include "stm32f4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "FreeRTOS.h"
+#include "task.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -46,6 +48,7 @@
 
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN PFP */
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName);
 
 /* USER CODE END PFP */
 
@@ -100,6 +103,15 @@ void HardFault_Handler(void)
 void MemManage_Handler(void)
 {
   /* USER CODE BEGIN MemoryManagement_IRQn 0 */
+#if (configUSE_MPU_STACK_GUARD == 1)
+  /* The guard belongs to the running task: no need to search for the task. */
+  if (xPortIsStackGuardFault() != pdFALSE)
+  {
+    TaskHandle_t xTask = xTaskGetCurrentTaskHandle();
+
+    vApplicationStackOverflowHook(xTask, pcTaskGetName(xTask));
+  }
+#endif
 
   /* USER CODE END MemoryManagement_IRQn 0 */
   while (1)
@@ -0,0 +1,786 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A two-level segregated fit (TLSF) implementation of pvPortMalloc() and
+ * vPortFree(), whose execution time does not depend on the state of the heap.
+ * Define USE_FreeRTOS_HEAP_TLSF in FreeRTOSConfig.h to build it in place of
+ * heap_4.c; both files can stay in the build.
+ *
+ * heap_4.c searches its address ordered free list for the first block that is
+ * large enough, so the longer the list - the more fragmented the heap - the
+ * longer pvPortMalloc() holds the scheduler suspended.  Here the free blocks
+ * are kept in one list per size class instead.  The first level divides sizes
+ * by powers of two, the second divides each power of two into
+ * 2^configHEAP_TLSF_SL_LOG2 equal ranges, and one bitmap per level tells which
+ * lists hold a block.  A request is rounded up to the next class boundary, so
+ * that any block of the first non-empty list from its class up fits, and that
+ * list is found with two find-first-set operations.  A freed block is merged
+ * at once with the free blocks just below and above it in memory, which each
+ * block header links to, so freeing takes constant time too.
+ *
+ * The rounding means a free block of the request's own class is passed over
+ * even if it would have fitted: a request can fail while the largest free
+ * block, less than 1/2^configHEAP_TLSF_SL_LOG2 larger than it, could hold it.
+ *
+ * The heap_4.c options built on its free list (configUSE_HEAP_SLABS,
+ * configUSE_HEAP_REGIONS and configUSE_HEAP_INSTRUMENTATION) are not
+ * available.  See heap_4.c for the default implementation, and the memory
+ * management pages of http://www.FreeRTOS.org for more information.
+ */
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if defined( USE_FreeRTOS_HEAP_TLSF )
+
+#if defined( USE_FreeRTOS_HEAP_4 )
+	#error Define only one of USE_FreeRTOS_HEAP_4 and USE_FreeRTOS_HEAP_TLSF in FreeRTOSConfig.h.
+#endif
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error heap_tlsf.c requires configSUPPORT_DYNAMIC_ALLOCATION 1, use heap_4.c without it.
+#endif
+
+#if( ( configUSE_HEAP_SLABS == 1 ) || ( configUSE_HEAP_REGIONS == 1 ) || ( configUSE_HEAP_INSTRUMENTATION == 1 ) )
+	#error configUSE_HEAP_SLABS, configUSE_HEAP_REGIONS and configUSE_HEAP_INSTRUMENTATION are heap_4.c options.
+#endif
+
+/* Classes below heapSMALL_BLOCK_SIZE are all portBYTE_ALIGNMENT wide, so the
+first level splits sizes from there on only. */
+#if( portBYTE_ALIGNMENT == 32 )
+	#define heapALIGNMENT_LOG2	5U
+#elif( portBYTE_ALIGNMENT == 16 )
+	#define heapALIGNMENT_LOG2	4U
+#elif( portBYTE_ALIGNMENT == 8 )
+	#define heapALIGNMENT_LOG2	3U
+#elif( portBYTE_ALIGNMENT == 4 )
+	#define heapALIGNMENT_LOG2	2U
+#else
+	#error heap_tlsf.c does not support this portBYTE_ALIGNMENT.
+#endif
+
+#define heapSL_COUNT			( 1U << configHEAP_TLSF_SL_LOG2 )
+#define heapFL_SHIFT			( configHEAP_TLSF_SL_LOG2 + heapALIGNMENT_LOG2 )
+#define heapSMALL_BLOCK_SIZE	( ( size_t ) 1 << heapFL_SHIFT )
+
+/* First level 0 holds the small blocks, level n the blocks of
+[ 2^( heapFL_SHIFT + n - 1 ), 2^( heapFL_SHIFT + n ) ). */
+#define heapFL_COUNT			( configHEAP_TLSF_FL_MAX - heapFL_SHIFT + 2U )
+
+#if( ( configHEAP_TLSF_SL_LOG2 < 1 ) || ( configHEAP_TLSF_SL_LOG2 > 5 ) )
+	#error configHEAP_TLSF_SL_LOG2 must be 1 to 5.
+#endif
+
+/* Sizes are mapped as 32-bit words, which also keeps heapFL_COUNT below 32. */
+#if( ( configHEAP_TLSF_FL_MAX < ( configHEAP_TLSF_SL_LOG2 + heapALIGNMENT_LOG2 ) ) || ( configHEAP_TLSF_FL_MAX > 30 ) )
+	#error configHEAP_TLSF_FL_MAX must be 30 at most, and no less than configHEAP_TLSF_SL_LOG2 plus the log2 of portBYTE_ALIGNMENT.
+#endif
+
+/* Bit 0 of xBlockSize, free as sizes are multiples of portBYTE_ALIGNMENT, is
+set while the block is free. */
+#define heapBLOCK_FREE_BIT		( ( size_t ) 1 )
+
+/* Larger requests cannot be served, whatever the heap: checked before the
+size is rounded up, so it cannot wrap around. */
+#define heapMAXIMUM_REQUEST		( ( size_t ) 1 << configHEAP_TLSF_FL_MAX )
+
+/* Allocate the memory for the heap. */
+#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+	/* The application writer has already defined the array used for the RTOS
+	heap - probably so it can be placed in a special segment or address. */
+	extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#elif( configHEAP_NOINIT == 1 )
+	/* Not cleared at boot: prvHeapInit() writes all the heap needs. */
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ] portNOINIT_DATA;
+#else
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* The header of every block, allocated or free.  The two free list links only
+exist in free blocks: in an allocated block they are the start of the memory
+returned to the application. */
+typedef struct A_TLSF_BLOCK
+{
+	struct A_TLSF_BLOCK *pxPhysicalPrevious;	/*<< The block just below this one in memory, NULL for the first. */
+	size_t xBlockSize;							/*<< Bytes, header included, with heapBLOCK_FREE_BIT. */
+	struct A_TLSF_BLOCK *pxNextFree;			/*<< The next block in the list of the same class. */
+	struct A_TLSF_BLOCK *pxPreviousFree;		/*<< The previous block in that list, NULL for the first. */
+} TlsfBlock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void );
+
+/*
+ * The classes of a block size: prvMappingInsert() gives the class the block
+ * belongs to, prvMappingSearch() rounds the size up first, to give the first
+ * class all blocks of which are at least that large.
+ */
+static void prvMappingInsert( size_t xSize, UBaseType_t *puxFl, UBaseType_t *puxSl );
+static void prvMappingSearch( size_t xSize, UBaseType_t *puxFl, UBaseType_t *puxSl );
+
+/*
+ * The first non-empty list of class ( *puxFl, *puxSl ) or above, NULL if there
+ * is none.  Updates the class to that of the list found.
+ */
+static TlsfBlock_t *prvFindSuitableBlock( UBaseType_t *puxFl, UBaseType_t *puxSl );
+
+/*
+ * Adds a free block to, or takes it out of, the list of its class.
+ */
+static void prvInsertFreeBlock( TlsfBlock_t *pxBlock );
+static void prvRemoveFreeBlock( TlsfBlock_t *pxBlock );
+
+/*
+ * The index of the lowest and highest bit set in a non-zero word.
+ */
+static portFORCE_INLINE UBaseType_t prvFindFirstSet( uint32_t ulWord );
+static portFORCE_INLINE UBaseType_t prvFindLastSet( uint32_t ulWord );
+
+/*-----------------------------------------------------------*/
+
+/* The header up to the free list links, and the smallest block: one that can
+hold the links once free.  Both correctly byte aligned. */
+#define heapHEADER_SIZE			( ( offsetof( TlsfBlock_t, pxNextFree ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+#define heapMINIMUM_BLOCK_SIZE	( ( sizeof( TlsfBlock_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+#define heapBLOCK_SIZE( pxBlock )		( ( pxBlock )->xBlockSize & ~heapBLOCK_FREE_BIT )
+#define heapBLOCK_IS_FREE( pxBlock )	( ( ( pxBlock )->xBlockSize & heapBLOCK_FREE_BIT ) != 0 )
+#define heapNEXT_BLOCK( pxBlock )		( ( TlsfBlock_t * ) ( void * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_SIZE( pxBlock ) ) )
+
+/* The heads of the free lists, and the bitmaps of the non-empty ones: bit fl
+of ulFlBitmap is set when any bit of ulSlBitmaps[ fl ] is, bit sl of
+ulSlBitmaps[ fl ] when pxFreeLists[ fl ][ sl ] is not NULL. */
+static TlsfBlock_t *pxFreeLists[ heapFL_COUNT ][ heapSL_COUNT ];
+static uint32_t ulSlBitmaps[ heapFL_COUNT ];
+static uint32_t ulFlBitmap = 0U;
+
+/* The zero size block that ends the heap.  It is never free, so the last
+block is never merged with what follows. */
+static TlsfBlock_t *pxEnd = NULL;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+number of free bytes remaining, but says nothing about fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+TlsfBlock_t *pxBlock, *pxRemainder;
+UBaseType_t uxFl, uxSl;
+size_t xBlockSize;
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc then the heap will require
+		initialisation to setup the free lists. */
+		if( pxEnd == NULL )
+		{
+			prvHeapInit();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ( xWantedSize > 0 ) && ( xWantedSize <= heapMAXIMUM_REQUEST ) )
+		{
+			/* The wanted size is increased so it can contain the header, and
+			so that the block can still hold the free list links once freed. */
+			xBlockSize = ( xWantedSize + heapHEADER_SIZE + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+			if( xBlockSize < heapMINIMUM_BLOCK_SIZE )
+			{
+				xBlockSize = heapMINIMUM_BLOCK_SIZE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			prvMappingSearch( xBlockSize, &uxFl, &uxSl );
+
+			if( uxFl < heapFL_COUNT )
+			{
+				pxBlock = prvFindSuitableBlock( &uxFl, &uxSl );
+			}
+			else
+			{
+				pxBlock = NULL;
+			}
+
+			if( pxBlock != NULL )
+			{
+				configASSERT( heapBLOCK_SIZE( pxBlock ) >= xBlockSize );
+
+				/* This block is being returned for use so must be taken out
+				of its free list. */
+				prvRemoveFreeBlock( pxBlock );
+
+				/* If the block is larger than required the rest becomes a
+				free block of its own, in the list of its class.  It cannot be
+				merged with the block above: free blocks never border another
+				free block. */
+				if( ( heapBLOCK_SIZE( pxBlock ) - xBlockSize ) >= heapMINIMUM_BLOCK_SIZE )
+				{
+					pxRemainder = ( TlsfBlock_t * ) ( void * ) ( ( ( uint8_t * ) pxBlock ) + xBlockSize );
+					pxRemainder->pxPhysicalPrevious = pxBlock;
+					pxRemainder->xBlockSize = ( heapBLOCK_SIZE( pxBlock ) - xBlockSize ) | heapBLOCK_FREE_BIT;
+					heapNEXT_BLOCK( pxRemainder )->pxPhysicalPrevious = pxRemainder;
+					prvInsertFreeBlock( pxRemainder );
+
+					pxBlock->xBlockSize = xBlockSize;
+				}
+				else
+				{
+					/* The block is allocated and owned by the application. */
+					pxBlock->xBlockSize &= ~heapBLOCK_FREE_BIT;
+				}
+
+				xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+				if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+				{
+					xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xNumberOfSuccessfulAllocations++;
+				pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + heapHEADER_SIZE );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+TlsfBlock_t *pxBlock, *pxNeighbour;
+size_t xBlockSize;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have the header immediately before it.
+		This casting is to keep the compiler from issuing warnings. */
+		pxBlock = ( TlsfBlock_t * ) ( void * ) ( ( ( uint8_t * ) pv ) - heapHEADER_SIZE );
+
+		/* Check the block is actually allocated. */
+		configASSERT( heapBLOCK_IS_FREE( pxBlock ) == 0 );
+		configASSERT( pxBlock->xBlockSize >= heapMINIMUM_BLOCK_SIZE );
+
+		if( heapBLOCK_IS_FREE( pxBlock ) == 0 )
+		{
+			vTaskSuspendAll();
+			{
+				xBlockSize = pxBlock->xBlockSize;
+				xFreeBytesRemaining += xBlockSize;
+				traceFREE( pv, xBlockSize );
+
+				/* Merge with the block below if it is free: the freed block
+				becomes the upper part of it. */
+				pxNeighbour = pxBlock->pxPhysicalPrevious;
+
+				if( ( pxNeighbour != NULL ) && heapBLOCK_IS_FREE( pxNeighbour ) )
+				{
+					prvRemoveFreeBlock( pxNeighbour );
+					xBlockSize += heapBLOCK_SIZE( pxNeighbour );
+					pxBlock = pxNeighbour;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Then with the block above.  pxEnd is never free. */
+				pxNeighbour = ( TlsfBlock_t * ) ( void * ) ( ( ( uint8_t * ) pxBlock ) + xBlockSize );
+
+				if( heapBLOCK_IS_FREE( pxNeighbour ) )
+				{
+					prvRemoveFreeBlock( pxNeighbour );
+					xBlockSize += heapBLOCK_SIZE( pxNeighbour );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxBlock->xBlockSize = xBlockSize | heapBLOCK_FREE_BIT;
+				heapNEXT_BLOCK( pxBlock )->pxPhysicalPrevious = pxBlock;
+				prvInsertFreeBlock( pxBlock );
+				xNumberOfSuccessfulFrees++;
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortRealloc( void *pv, size_t xWantedSize )
+{
+void *pvReturn = NULL;
+size_t xOldSize;
+
+	if( pv == NULL )
+	{
+		pvReturn = pvPortMalloc( xWantedSize );
+	}
+	else if( xWantedSize == 0 )
+	{
+		vPortFree( pv );
+	}
+	else
+	{
+		/* Only a block that already has room stays where it is: resizing it
+		in place would take the list operations of a free and a malloc. */
+		xOldSize = xPortGetAllocationSize( pv );
+
+		if( xWantedSize <= xOldSize )
+		{
+			pvReturn = pv;
+		}
+		else
+		{
+			pvReturn = pvPortMalloc( xWantedSize );
+
+			if( pvReturn != NULL )
+			{
+				( void ) memcpy( pvReturn, pv, xOldSize );
+				vPortFree( pv );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortCalloc( size_t xNum, size_t xSize )
+{
+void *pvReturn = NULL;
+
+	if( ( xSize == 0 ) || ( xNum <= ( ( ( size_t ) -1 ) / xSize ) ) )
+	{
+		pvReturn = pvPortMalloc( xNum * xSize );
+
+		if( pvReturn != NULL )
+		{
+			( void ) memset( pvReturn, 0, xNum * xSize );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetAllocationSize( void *pv )
+{
+const TlsfBlock_t *pxBlock;
+size_t xSize = 0;
+
+	if( pv != NULL )
+	{
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxBlock = ( const TlsfBlock_t * ) ( const void * ) ( ( ( const uint8_t * ) pv ) - heapHEADER_SIZE );
+		configASSERT( heapBLOCK_IS_FREE( pxBlock ) == 0 );
+		xSize = heapBLOCK_SIZE( pxBlock ) - heapHEADER_SIZE;
+	}
+
+	return xSize;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+const TlsfBlock_t *pxBlock;
+UBaseType_t uxFl, uxSl;
+uint32_t ulFlMap, ulSlMap;
+size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+	vTaskSuspendAll();
+	{
+		/* Unlike allocation, this visits every free block.  The bitmaps skip
+		the empty lists, and are all clear if the heap has not been
+		initialised yet. */
+		ulFlMap = ulFlBitmap;
+
+		while( ulFlMap != 0U )
+		{
+			uxFl = prvFindFirstSet( ulFlMap );
+			ulFlMap &= ulFlMap - 1U;
+			ulSlMap = ulSlBitmaps[ uxFl ];
+
+			while( ulSlMap != 0U )
+			{
+				uxSl = prvFindFirstSet( ulSlMap );
+				ulSlMap &= ulSlMap - 1U;
+
+				for( pxBlock = pxFreeLists[ uxFl ][ uxSl ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFree )
+				{
+					xBlocks++;
+
+					if( heapBLOCK_SIZE( pxBlock ) > xMaxSize )
+					{
+						xMaxSize = heapBLOCK_SIZE( pxBlock );
+					}
+
+					if( heapBLOCK_SIZE( pxBlock ) < xMinSize )
+					{
+						xMinSize = heapBLOCK_SIZE( pxBlock );
+					}
+				}
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+	pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+	pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+	taskENTER_CRITICAL();
+	{
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+TlsfBlock_t *pxFirstFreeBlock;
+size_t uxAddress;
+size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+	/* Ensure the heap starts on a correctly aligned boundary. */
+	uxAddress = ( size_t ) ucHeap;
+
+	if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+	{
+		uxAddress += ( portBYTE_ALIGNMENT - 1 );
+		uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		xTotalHeapSize -= uxAddress - ( size_t ) ucHeap;
+	}
+
+	xTotalHeapSize &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+	/* To start with there is a single free block that is sized to take up the
+	entire heap space, minus the space taken by pxEnd.  Only the header of
+	pxEnd is used, but it is given a whole block so that it is a complete
+	object within the heap.  The first block's size must have a first level
+	class. */
+	pxFirstFreeBlock = ( TlsfBlock_t * ) ( void * ) uxAddress;
+	pxFirstFreeBlock->pxPhysicalPrevious = NULL;
+	pxFirstFreeBlock->xBlockSize = ( xTotalHeapSize - heapMINIMUM_BLOCK_SIZE ) | heapBLOCK_FREE_BIT;
+	configASSERT( heapBLOCK_SIZE( pxFirstFreeBlock ) >= heapMINIMUM_BLOCK_SIZE );
+	configASSERT( heapBLOCK_SIZE( pxFirstFreeBlock ) < ( ( size_t ) 2 << configHEAP_TLSF_FL_MAX ) );
+
+	/* pxEnd has no size, so nothing follows it. */
+	pxEnd = heapNEXT_BLOCK( pxFirstFreeBlock );
+	pxEnd->pxPhysicalPrevious = pxFirstFreeBlock;
+	pxEnd->xBlockSize = 0;
+
+	prvInsertFreeBlock( pxFirstFreeBlock );
+
+	/* Only one block exists - and it covers the entire usable heap space. */
+	xMinimumEverFreeBytesRemaining = heapBLOCK_SIZE( pxFirstFreeBlock );
+	xFreeBytesRemaining = heapBLOCK_SIZE( pxFirstFreeBlock );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xSize, UBaseType_t *puxFl, UBaseType_t *puxSl )
+{
+UBaseType_t uxLastSet;
+
+	if( xSize < heapSMALL_BLOCK_SIZE )
+	{
+		/* One class per multiple of portBYTE_ALIGNMENT. */
+		*puxFl = 0;
+		*puxSl = ( UBaseType_t ) ( xSize >> heapALIGNMENT_LOG2 );
+	}
+	else
+	{
+		/* The top bit gives the first level, the configHEAP_TLSF_SL_LOG2 bits
+		below it the second. */
+		uxLastSet = prvFindLastSet( ( uint32_t ) xSize );
+		*puxFl = uxLastSet - heapFL_SHIFT + 1U;
+		*puxSl = ( UBaseType_t ) ( ( xSize >> ( uxLastSet - configHEAP_TLSF_SL_LOG2 ) ) ^ heapSL_COUNT );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingSearch( size_t xSize, UBaseType_t *puxFl, UBaseType_t *puxSl )
+{
+	if( xSize >= heapSMALL_BLOCK_SIZE )
+	{
+		/* Round up to the next class boundary.  This may carry into the next
+		first level, which prvMappingInsert() then picks up. */
+		xSize += ( ( size_t ) 1 << ( prvFindLastSet( ( uint32_t ) xSize ) - configHEAP_TLSF_SL_LOG2 ) ) - 1U;
+	}
+	else
+	{
+		/* Small classes hold a single size each. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	prvMappingInsert( xSize, puxFl, puxSl );
+}
+/*-----------------------------------------------------------*/
+
+static TlsfBlock_t *prvFindSuitableBlock( UBaseType_t *puxFl, UBaseType_t *puxSl )
+{
+uint32_t ulSlMap, ulFlMap;
+
+	/* A list of the same first level, from the class up... */
+	ulSlMap = ulSlBitmaps[ *puxFl ] & ( ( uint32_t ) 0xFFFFFFFFUL << *puxSl );
+
+	if( ulSlMap == 0U )
+	{
+		/* ...or else any list of a higher first level.  heapFL_COUNT is
+		below 32, so the shift is too. */
+		ulFlMap = ulFlBitmap & ( ( uint32_t ) 0xFFFFFFFFUL << ( *puxFl + 1U ) );
+
+		if( ulFlMap == 0U )
+		{
+			return NULL;
+		}
+
+		*puxFl = prvFindFirstSet( ulFlMap );
+		ulSlMap = ulSlBitmaps[ *puxFl ];
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	*puxSl = prvFindFirstSet( ulSlMap );
+
+	return pxFreeLists[ *puxFl ][ *puxSl ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( TlsfBlock_t *pxBlock )
+{
+UBaseType_t uxFl, uxSl;
+
+	prvMappingInsert( heapBLOCK_SIZE( pxBlock ), &uxFl, &uxSl );
+	configASSERT( uxFl < heapFL_COUNT );
+
+	pxBlock->pxPreviousFree = NULL;
+	pxBlock->pxNextFree = pxFreeLists[ uxFl ][ uxSl ];
+
+	if( pxBlock->pxNextFree != NULL )
+	{
+		pxBlock->pxNextFree->pxPreviousFree = pxBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxFreeLists[ uxFl ][ uxSl ] = pxBlock;
+	ulFlBitmap |= ( uint32_t ) 1U << uxFl;
+	ulSlBitmaps[ uxFl ] |= ( uint32_t ) 1U << uxSl;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( TlsfBlock_t *pxBlock )
+{
+UBaseType_t uxFl, uxSl;
+
+	prvMappingInsert( heapBLOCK_SIZE( pxBlock ), &uxFl, &uxSl );
+
+	if( pxBlock->pxNextFree != NULL )
+	{
+		pxBlock->pxNextFree->pxPreviousFree = pxBlock->pxPreviousFree;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlock->pxPreviousFree != NULL )
+	{
+		pxBlock->pxPreviousFree->pxNextFree = pxBlock->pxNextFree;
+	}
+	else
+	{
+		/* The block was the head of its list, which may now be empty. */
+		pxFreeLists[ uxFl ][ uxSl ] = pxBlock->pxNextFree;
+
+		if( pxBlock->pxNextFree == NULL )
+		{
+			ulSlBitmaps[ uxFl ] &= ~( ( uint32_t ) 1U << uxSl );
+
+			if( ulSlBitmaps[ uxFl ] == 0U )
+			{
+				ulFlBitmap &= ~( ( uint32_t ) 1U << uxFl );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static portFORCE_INLINE UBaseType_t prvFindFirstSet( uint32_t ulWord )
+{
+	#if defined( __GNUC__ )
+	{
+		return ( UBaseType_t ) __builtin_ctz( ulWord );
+	}
+	#else
+	{
+	UBaseType_t uxBit = 0;
+
+		while( ( ulWord & 1U ) == 0U )
+		{
+			ulWord >>= 1;
+			uxBit++;
+		}
+
+		return uxBit;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static portFORCE_INLINE UBaseType_t prvFindLastSet( uint32_t ulWord )
+{
+	#if defined( __GNUC__ )
+	{
+		/* A single CLZ instruction on the Cortex-M4. */
+		return ( UBaseType_t ) ( 31 - __builtin_clz( ulWord ) );
+	}
+	#else
+	{
+	UBaseType_t uxBit = 0;
+
+		while( ( ulWord >>= 1 ) != 0U )
+		{
+			uxBit++;
+		}
+
+		return uxBit;
+	}
+	#endif
+}
+
+#endif /* USE_FreeRTOS_HEAP_TLSF */
@@ -41,6 +41,14 @@ task.h is included from an application file. */
 	#include "croutine.h"
 #endif
 
+#if ( configUSE_WAIT_ANY == 1 )
+	#include "wait_any.h"
+#endif
+
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+	#include "registry.h"
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
 because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
 for the header files above, but not in this file, in order to generate the
@@ -74,6 +82,10 @@ typedef struct SemaphoreData
 {
 	TaskHandle_t xMutexHolder;		 /*< The handle of the task that holds the mutex. */
 	UBaseType_t uxRecursiveCallCount;/*< Maintains a count of the number of times a recursive mutex has been recursively 'taken' when the structure is used as a mutex. */
+
+	#if( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+		UBaseType_t uxCeilingPriority;	/*< The priority the holder runs at while it holds the mutex, or 0 if the mutex uses priority inheritance. */
+	#endif
 } SemaphoreData_t;
 
 /* Semaphores do not actually store or copy data, so have an item size of
@@ -81,6 +93,112 @@ zero. */
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH ( ( UBaseType_t ) 0 )
 #define queueMUTEX_GIVE_BLOCK_TIME		 ( ( TickType_t ) 0U )
 
+#if( configUSE_MUTEX_FAST_PATH == 1 )
+	/* The fast path takes and gives a mutex through its holder alone, so the
+	holder, not uxMessagesWaiting, says whether a mutex is available. */
+	#define queueMESSAGES_WAITING( pxQueue ) \
+		( ( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX ) ? \
+			( ( ( pxQueue )->u.xSemaphore.xMutexHolder == NULL ) ? ( UBaseType_t ) 1 : ( UBaseType_t ) 0 ) : \
+			( pxQueue )->uxMessagesWaiting )
+#else
+	#define queueMESSAGES_WAITING( pxQueue ) ( ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#if( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+	/* Only valid once the queue is known to be a mutex. */
+	#define queueMUTEX_CEILING( pxQueue ) ( ( pxQueue )->u.xSemaphore.uxCeilingPriority )
+#else
+	#define queueMUTEX_CEILING( pxQueue ) ( ( UBaseType_t ) 0 )
+#endif
+
+#if( configUSE_WAIT_ANY == 1 )
+	/* A queue that can now be read tells the wait-any object it is a member of,
+	if any. */
+	#define queueNOTIFY_WAIT_ANY( pxQueue ) \
+		if( ( pxQueue )->pxWaitAny != NULL ) \
+		{ \
+			vWaitAnyNotify( ( pxQueue )->pxWaitAny ); \
+		}
+	#define queueNOTIFY_WAIT_ANY_FROM_ISR( pxQueue, pxHigherPriorityTaskWoken ) \
+		if( ( pxQueue )->pxWaitAny != NULL ) \
+		{ \
+			vWaitAnyNotifyFromISR( ( pxQueue )->pxWaitAny, ( pxHigherPriorityTaskWoken ) ); \
+		}
+#else
+	#define queueNOTIFY_WAIT_ANY( pxQueue )
+	#define queueNOTIFY_WAIT_ANY_FROM_ISR( pxQueue, pxHigherPriorityTaskWoken )
+#endif
+
+#if( configUSE_QUEUE_METRICS == 1 )
+	/* Counted within a critical section, or with interrupts masked.  The
+	high-water mark is taken after the items are added, from the count
+	uxQueueMessagesWaiting() returns. */
+	#define queueMETRICS_COUNT( pxQueue, ulField, uxValue ) \
+		( ( pxQueue )->xMetrics.ulField += ( uint32_t ) ( uxValue ) )
+	#define queueMETRICS_HIGH_WATER( pxQueue ) \
+		if( ( uint32_t ) queueMESSAGES_WAITING( pxQueue ) > ( pxQueue )->xMetrics.ulHighWaterMark ) \
+		{ \
+			( pxQueue )->xMetrics.ulHighWaterMark = ( uint32_t ) queueMESSAGES_WAITING( pxQueue ); \
+		}
+	#define queueMETRICS_SENT( pxQueue, uxCount ) \
+		{ \
+			( pxQueue )->xMetrics.ulSends += ( uint32_t ) ( uxCount ); \
+			queueMETRICS_HIGH_WATER( pxQueue ) \
+		}
+
+	/* Batch calls that find the block time expired either drop what is left
+	(no block time given) or time out (after blocking). */
+	#define queueMETRICS_SEND_FAILED( pxQueue, xEntryTimeSet, uxUnsent ) \
+		{ \
+			if( ( xEntryTimeSet ) != pdFALSE ) \
+			{ \
+				( pxQueue )->xMetrics.ulSendTimeouts++; \
+			} \
+			else \
+			{ \
+				( pxQueue )->xMetrics.ulFullDrops += ( uint32_t ) ( uxUnsent ); \
+			} \
+		}
+	#define queueMETRICS_RECEIVE_FAILED( pxQueue, xEntryTimeSet ) \
+		{ \
+			if( ( xEntryTimeSet ) != pdFALSE ) \
+			{ \
+				( pxQueue )->xMetrics.ulReceiveTimeouts++; \
+			} \
+		}
+
+	/* A task about to block counts the block and notes the tick, with the
+	scheduler suspended.  The ticks spent blocked are added once it runs
+	again, whatever woke it. */
+	#define queueMETRICS_BLOCKING( pxQueue, ulField, xBlockedSince ) \
+		{ \
+			( pxQueue )->xMetrics.ulField++; \
+			( xBlockedSince ) = xTaskGetTickCount(); \
+		}
+	#define queueMETRICS_UNBLOCKED( pxQueue, xBlockedSince ) \
+		prvQueueMetricsAdd( &( ( pxQueue )->xMetrics.ulTicksBlocked ), ( uint32_t ) ( xTaskGetTickCount() - ( xBlockedSince ) ) )
+	#define queueMETRICS_TIMED_OUT( pxQueue, ulField ) \
+		prvQueueMetricsAdd( &( ( pxQueue )->xMetrics.ulField ), 1U )
+#else
+	#define queueMETRICS_COUNT( pxQueue, ulField, uxValue )
+	#define queueMETRICS_HIGH_WATER( pxQueue )
+	#define queueMETRICS_SENT( pxQueue, uxCount )
+	#define queueMETRICS_SEND_FAILED( pxQueue, xEntryTimeSet, uxUnsent )
+	#define queueMETRICS_RECEIVE_FAILED( pxQueue, xEntryTimeSet )
+	#define queueMETRICS_BLOCKING( pxQueue, ulField, xBlockedSince )
+	#define queueMETRICS_UNBLOCKED( pxQueue, xBlockedSince )
+	#define queueMETRICS_TIMED_OUT( pxQueue, ulField )
+#endif
+
+#if( configUSE_QUEUE_FAST_COPY == 1 )
+	/* Items of 1, 2, 4 or 8 bytes are copied by prvCopyItem(), chosen when the
+	queue is created. */
+	#define queueCOPY_ITEM( pxQueue, pvDest, pvSource ) prvCopyItem( ( pxQueue ), ( pvDest ), ( pvSource ) )
+#else
+	#define queueCOPY_ITEM( pxQueue, pvDest, pvSource ) \
+		( void ) memcpy( ( void * ) ( pvDest ), ( const void * ) ( pvSource ), ( size_t ) ( pxQueue )->uxItemSize )
+#endif
+
 #if( configUSE_PREEMPTION == 0 )
 	/* If the cooperative scheduler is being used then a yield should not be
 	performed just because a higher priority task has been woken. */
@@ -119,6 +237,10 @@ typedef struct QueueDefinition 		/* The old naming convention is used to prevent
 		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the memory used by the queue was statically allocated to ensure no attempt is made to free the memory. */
 	#endif
 
+	#if ( configUSE_QUEUE_FAST_COPY == 1 )
+		uint8_t ucItemCopy;			/*< The item size if it is 1, 2, 4 or 8, otherwise 0 to copy with a run-time size. */
+	#endif
+
 	#if ( configUSE_QUEUE_SETS == 1 )
 		struct QueueDefinition *pxQueueSetContainer;
 	#endif
@@ -128,6 +250,18 @@ typedef struct QueueDefinition 		/* The old naming convention is used to prevent
 		uint8_t ucQueueType;
 	#endif
 
+	#if ( configUSE_WAIT_ANY == 1 )
+		struct WaitAnyDef_t *pxWaitAny;
+	#endif
+
+	#if ( configUSE_QUEUE_METRICS == 1 )
+		QueueMetrics_t xMetrics;	/*< Counted since creation or the last vQueueResetMetrics(). */
+	#endif
+
+	#if ( configUSE_OBJECT_REGISTRY == 1 )
+		RegistryItem_t xRegistryItem;	/*< Links the queue into the object registry while it has a name. */
+	#endif
+
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -139,8 +273,10 @@ typedef xQUEUE Queue_t;
 /*
  * The queue registry is just a means for kernel aware debuggers to locate
  * queue structures.  It has no other purpose so is an optional component.
+ * With configUSE_OBJECT_REGISTRY set to 1 each queue holds its own registry
+ * item instead (registry.c), and the array below is not used.
  */
-#if ( configQUEUE_REGISTRY_SIZE > 0 )
+#if ( ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_OBJECT_REGISTRY == 0 ) )
 
 	/* The type stored within the queue registry array.  This allows a name
 	to be assigned to each queue making kernel aware debugging a little
@@ -161,7 +297,7 @@ typedef xQUEUE Queue_t;
 	array position being vacant. */
 	PRIVILEGED_DATA QueueRegistryItem_t xQueueRegistry[ configQUEUE_REGISTRY_SIZE ];
 
-#endif /* configQUEUE_REGISTRY_SIZE */
+#endif /* ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_OBJECT_REGISTRY == 0 ) */
 
 /*
  * Unlocks a queue locked by a call to prvLockQueue.  Locking a queue does not
@@ -231,6 +367,24 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	 */
 	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
+
+#if( configUSE_QUEUE_METRICS == 1 )
+	/*
+	 * Adds to one of the counters of a queue from a task, outside of any
+	 * critical section.
+	 */
+	static void prvQueueMetricsAdd( uint32_t * const pulCounter, const uint32_t ulValue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( configUSE_QUEUE_FAST_PATH == 1 )
+	/*
+	 * Send an item to the back of, or receive one from, a data queue in one
+	 * short critical section when that needs no task to be unblocked.  Return
+	 * pdFALSE, having changed nothing, when the full path must be taken.
+	 */
+	portFORCE_INLINE static BaseType_t prvSendFast( Queue_t * const pxQueue, const void * const pvItemToQueue, const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
+	portFORCE_INLINE static BaseType_t prvReceiveFast( Queue_t * const pxQueue, void * const pvBuffer ) PRIVILEGED_FUNCTION;
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -445,6 +599,19 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	pxNewQueue->uxItemSize = uxItemSize;
 	( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
 
+	#if( configUSE_QUEUE_FAST_COPY == 1 )
+	{
+		if( ( uxItemSize == 1U ) || ( uxItemSize == 2U ) || ( uxItemSize == 4U ) || ( uxItemSize == 8U ) )
+		{
+			pxNewQueue->ucItemCopy = ( uint8_t ) uxItemSize;
+		}
+		else
+		{
+			pxNewQueue->ucItemCopy = 0U;
+		}
+	}
+	#endif /* configUSE_QUEUE_FAST_COPY */
+
 	#if ( configUSE_TRACE_FACILITY == 1 )
 	{
 		pxNewQueue->ucQueueType = ucQueueType;
@@ -457,6 +624,24 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	}
 	#endif /* configUSE_QUEUE_SETS */
 
+	#if( configUSE_WAIT_ANY == 1 )
+	{
+		pxNewQueue->pxWaitAny = NULL;
+	}
+	#endif /* configUSE_WAIT_ANY */
+
+	#if( configUSE_QUEUE_METRICS == 1 )
+	{
+		( void ) memset( ( void * ) &( pxNewQueue->xMetrics ), 0x00, sizeof( pxNewQueue->xMetrics ) );
+	}
+	#endif /* configUSE_QUEUE_METRICS */
+
+	#if( configUSE_OBJECT_REGISTRY == 1 )
+	{
+		vRegistryInitialiseItem( &( pxNewQueue->xRegistryItem ), ( void * ) pxNewQueue, registryTYPE_QUEUE );
+	}
+	#endif /* configUSE_OBJECT_REGISTRY */
+
 	traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -477,10 +662,27 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 			/* In case this is a recursive mutex. */
 			pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
 
+			#if( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+			{
+				/* Priority inheritance unless xQueueCreateCeilingMutex() sets
+				a ceiling. */
+				pxNewQueue->u.xSemaphore.uxCeilingPriority = ( UBaseType_t ) 0;
+			}
+			#endif
+
 			traceCREATE_MUTEX( pxNewQueue );
 
 			/* Start with the semaphore in the expected state. */
-			( void ) xQueueGenericSend( pxNewQueue, NULL, ( TickType_t ) 0U, queueSEND_TO_BACK );
+			#if( configUSE_MUTEX_FAST_PATH == 1 )
+			{
+				/* A NULL holder already marks the mutex as available. */
+				pxNewQueue->uxMessagesWaiting = ( UBaseType_t ) 1;
+			}
+			#else
+			{
+				( void ) xQueueGenericSend( pxNewQueue, NULL, ( TickType_t ) 0U, queueSEND_TO_BACK );
+			}
+			#endif
 		}
 		else
 		{
@@ -527,6 +729,57 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreateCeilingMutex( const UBaseType_t uxCeilingPriority )
+	{
+	QueueHandle_t xNewQueue;
+
+		/* A ceiling of 0 would be the inheritance protocol. */
+		configASSERT( ( uxCeilingPriority > ( UBaseType_t ) 0 ) && ( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES ) );
+
+		xNewQueue = xQueueCreateMutex( queueQUEUE_TYPE_MUTEX );
+
+		if( xNewQueue != NULL )
+		{
+			( ( Queue_t * ) xNewQueue )->u.xSemaphore.uxCeilingPriority = uxCeilingPriority;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xNewQueue;
+	}
+
+#endif /* ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreateCeilingMutexStatic( const UBaseType_t uxCeilingPriority, StaticQueue_t *pxStaticQueue )
+	{
+	QueueHandle_t xNewQueue;
+
+		configASSERT( ( uxCeilingPriority > ( UBaseType_t ) 0 ) && ( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES ) );
+
+		xNewQueue = xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, pxStaticQueue );
+
+		if( xNewQueue != NULL )
+		{
+			( ( Queue_t * ) xNewQueue )->u.xSemaphore.uxCeilingPriority = uxCeilingPriority;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xNewQueue;
+	}
+
+#endif /* ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
 
 	TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
@@ -737,15 +990,50 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 #endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueGenericSend( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait, const BaseType_t xCopyPosition )
+KERNEL_RAM_FUNCTION BaseType_t xQueueGenericSend( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait, const BaseType_t xCopyPosition )
 {
 BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
 TimeOut_t xTimeOut;
 Queue_t * const pxQueue = xQueue;
 
+#if( configUSE_QUEUE_METRICS == 1 )
+	TickType_t xBlockedSince = 0;
+#endif
+
 	configASSERT( pxQueue );
 	configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
 	configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+
+	#if( configUSE_MUTEX_FAST_PATH == 1 )
+	{
+		/* A mutex nobody is waiting for, given by a holder that has not
+		inherited a priority, is released without a critical section.  A
+		mutex in a queue set takes the kernel path, which posts it to the
+		set. */
+		if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) &&
+			#if( configUSE_QUEUE_SETS == 1 )
+				( pxQueue->pxQueueSetContainer == NULL ) &&
+			#endif
+			( xTaskMutexFastGive( &( pxQueue->u.xSemaphore.xMutexHolder ), &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE ) )
+		{
+			traceQUEUE_SEND( pxQueue );
+			queueNOTIFY_WAIT_ANY( pxQueue );
+			return pdPASS;
+		}
+	}
+	#endif /* configUSE_MUTEX_FAST_PATH */
+
+	#if( configUSE_QUEUE_FAST_PATH == 1 )
+	{
+		/* Room in the queue and no task to unblock: the send never gets to
+		the block time. */
+		if( prvSendFast( pxQueue, pvItemToQueue, xCopyPosition ) != pdFALSE )
+		{
+			return pdPASS;
+		}
+	}
+	#endif /* configUSE_QUEUE_FAST_PATH */
+
 	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
 	{
 		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
@@ -764,7 +1052,7 @@ Queue_t * const pxQueue = xQueue;
 			highest priority task wanting to access the queue.  If the head item
 			in the queue is to be overwritten then it does not matter if the
 			queue is full. */
-			if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+			if( ( queueMESSAGES_WAITING( pxQueue ) < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
 			{
 				traceQUEUE_SEND( pxQueue );
 
@@ -864,6 +1152,8 @@ Queue_t * const pxQueue = xQueue;
 				}
 				#endif /* configUSE_QUEUE_SETS */
 
+				queueNOTIFY_WAIT_ANY( pxQueue );
+
 				taskEXIT_CRITICAL();
 				return pdPASS;
 			}
@@ -873,6 +1163,7 @@ Queue_t * const pxQueue = xQueue;
 				{
 					/* The queue was full and no block time is specified (or
 					the block time has expired) so leave now. */
+					queueMETRICS_COUNT( pxQueue, ulFullDrops, 1U );
 					taskEXIT_CRITICAL();
 
 					/* Return to the original privilege level before exiting
@@ -908,6 +1199,7 @@ Queue_t * const pxQueue = xQueue;
 			if( prvIsQueueFull( pxQueue ) != pdFALSE )
 			{
 				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				queueMETRICS_BLOCKING( pxQueue, ulSendsBlocked, xBlockedSince );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
 
 				/* Unlocking the queue means queue events can effect the
@@ -926,6 +1218,8 @@ Queue_t * const pxQueue = xQueue;
 				{
 					portYIELD_WITHIN_API();
 				}
+
+				queueMETRICS_UNBLOCKED( pxQueue, xBlockedSince );
 			}
 			else
 			{
@@ -940,6 +1234,7 @@ Queue_t * const pxQueue = xQueue;
 			prvUnlockQueue( pxQueue );
 			( void ) xTaskResumeAll();
 
+			queueMETRICS_TIMED_OUT( pxQueue, ulSendTimeouts );
 			traceQUEUE_SEND_FAILED( pxQueue );
 			return errQUEUE_FULL;
 		}
@@ -947,7 +1242,7 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue, const void * const pvItemToQueue, BaseType_t * const pxHigherPriorityTaskWoken, const BaseType_t xCopyPosition )
+KERNEL_RAM_FUNCTION BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue, const void * const pvItemToQueue, BaseType_t * const pxHigherPriorityTaskWoken, const BaseType_t xCopyPosition )
 {
 BaseType_t xReturn;
 UBaseType_t uxSavedInterruptStatus;
@@ -993,6 +1288,7 @@ Queue_t * const pxQueue = xQueue;
 			called here even though the disinherit function does not check if
 			the scheduler is suspended before accessing the ready lists. */
 			( void ) prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+			queueNOTIFY_WAIT_ANY_FROM_ISR( pxQueue, pxHigherPriorityTaskWoken );
 
 			/* The event list is not altered if the queue is locked.  This will
 			be done when the queue is unlocked later. */
@@ -1100,6 +1396,7 @@ Queue_t * const pxQueue = xQueue;
 		else
 		{
 			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+			queueMETRICS_COUNT( pxQueue, ulFullDrops, 1U );
 			xReturn = errQUEUE_FULL;
 		}
 	}
@@ -1109,7 +1406,7 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken )
+KERNEL_RAM_FUNCTION BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken )
 {
 BaseType_t xReturn;
 UBaseType_t uxSavedInterruptStatus;
@@ -1168,6 +1465,8 @@ Queue_t * const pxQueue = xQueue;
 			priority disinheritance is needed.  Simply increase the count of
 			messages (semaphores) available. */
 			pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+			queueMETRICS_SENT( pxQueue, 1U );
+			queueNOTIFY_WAIT_ANY_FROM_ISR( pxQueue, pxHigherPriorityTaskWoken );
 
 			/* The event list is not altered if the queue is locked.  This will
 			be done when the queue is unlocked later. */
@@ -1265,6 +1564,7 @@ Queue_t * const pxQueue = xQueue;
 		else
 		{
 			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+			queueMETRICS_COUNT( pxQueue, ulFullDrops, 1U );
 			xReturn = errQUEUE_FULL;
 		}
 	}
@@ -1274,12 +1574,16 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait )
+KERNEL_RAM_FUNCTION BaseType_t xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait )
 {
 BaseType_t xEntryTimeSet = pdFALSE;
 TimeOut_t xTimeOut;
 Queue_t * const pxQueue = xQueue;
 
+#if( configUSE_QUEUE_METRICS == 1 )
+	TickType_t xBlockedSince = 0;
+#endif
+
 	/* Check the pointer is not NULL. */
 	configASSERT( ( pxQueue ) );
 
@@ -1287,6 +1591,16 @@ Queue_t * const pxQueue = xQueue;
 	is zero (so no data is copied into the buffer. */
 	configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
 
+	#if( configUSE_QUEUE_FAST_PATH == 1 )
+	{
+		/* As in xQueueGenericSend(). */
+		if( prvReceiveFast( pxQueue, pvBuffer ) != pdFALSE )
+		{
+			return pdPASS;
+		}
+	}
+	#endif /* configUSE_QUEUE_FAST_PATH */
+
 	/* Cannot block if the scheduler is suspended. */
 	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
 	{
@@ -1312,6 +1626,7 @@ Queue_t * const pxQueue = xQueue;
 				prvCopyDataFromQueue( pxQueue, pvBuffer );
 				traceQUEUE_RECEIVE( pxQueue );
 				pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+				queueMETRICS_COUNT( pxQueue, ulReceives, 1U );
 
 				/* There is now space in the queue, were any tasks waiting to
 				post to the queue?  If so, unblock the highest priority waiting
@@ -1375,6 +1690,7 @@ Queue_t * const pxQueue = xQueue;
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
 				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				queueMETRICS_BLOCKING( pxQueue, ulReceivesBlocked, xBlockedSince );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
 				prvUnlockQueue( pxQueue );
 				if( xTaskResumeAll() == pdFALSE )
@@ -1385,6 +1701,8 @@ Queue_t * const pxQueue = xQueue;
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
+
+				queueMETRICS_UNBLOCKED( pxQueue, xBlockedSince );
 			}
 			else
 			{
@@ -1403,6 +1721,7 @@ Queue_t * const pxQueue = xQueue;
 
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
+				queueMETRICS_TIMED_OUT( pxQueue, ulReceiveTimeouts );
 				traceQUEUE_RECEIVE_FAILED( pxQueue );
 				return errQUEUE_EMPTY;
 			}
@@ -1415,7 +1734,7 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue, TickType_t xTicksToWait )
+KERNEL_RAM_FUNCTION BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue, TickType_t xTicksToWait )
 {
 BaseType_t xEntryTimeSet = pdFALSE;
 TimeOut_t xTimeOut;
@@ -1425,6 +1744,10 @@ Queue_t * const pxQueue = xQueue;
 	BaseType_t xInheritanceOccurred = pdFALSE;
 #endif
 
+#if( configUSE_QUEUE_METRICS == 1 )
+	TickType_t xBlockedSince = 0;
+#endif
+
 	/* Check the queue pointer is not NULL. */
 	configASSERT( ( pxQueue ) );
 
@@ -1432,6 +1755,21 @@ Queue_t * const pxQueue = xQueue;
 	0. */
 	configASSERT( pxQueue->uxItemSize == 0 );
 
+	#if( configUSE_MUTEX_FAST_PATH == 1 )
+	{
+		/* An available mutex is taken without a critical section.  Only a
+		held one, or one with a priority ceiling to raise the holder to, goes
+		through the kernel path below. */
+		if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) &&
+			( queueMUTEX_CEILING( pxQueue ) == ( UBaseType_t ) 0 ) &&
+			( xTaskMutexFastTake( &( pxQueue->u.xSemaphore.xMutexHolder ) ) != pdFALSE ) )
+		{
+			traceQUEUE_RECEIVE( pxQueue );
+			return pdPASS;
+		}
+	}
+	#endif /* configUSE_MUTEX_FAST_PATH */
+
 	/* Cannot block if the scheduler is suspended. */
 	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
 	{
@@ -1449,7 +1787,7 @@ Queue_t * const pxQueue = xQueue;
 		{
 			/* Semaphores are queues with an item size of 0, and where the
 			number of messages in the queue is the semaphore's count value. */
-			const UBaseType_t uxSemaphoreCount = pxQueue->uxMessagesWaiting;
+			const UBaseType_t uxSemaphoreCount = queueMESSAGES_WAITING( pxQueue );
 
 			/* Is there data in the queue now?  To be running the calling task
 			must be the highest priority task wanting to access the queue. */
@@ -1460,6 +1798,7 @@ Queue_t * const pxQueue = xQueue;
 				/* Semaphores are queues with a data size of zero and where the
 				messages waiting is the semaphore's count.  Reduce the count. */
 				pxQueue->uxMessagesWaiting = uxSemaphoreCount - ( UBaseType_t ) 1;
+				queueMETRICS_COUNT( pxQueue, ulReceives, 1U );
 
 				#if ( configUSE_MUTEXES == 1 )
 				{
@@ -1468,6 +1807,23 @@ Queue_t * const pxQueue = xQueue;
 						/* Record the information required to implement
 						priority inheritance should it become necessary. */
 						pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+						#if( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+						{
+							/* The holder runs at the ceiling from now on, so
+							no task that takes the mutex can preempt it, and
+							no priority has to be inherited.  Giving the mutex
+							back disinherits the ceiling. */
+							if( queueMUTEX_CEILING( pxQueue ) != ( UBaseType_t ) 0 )
+							{
+								vTaskPriorityRaiseToCeiling( queueMUTEX_CEILING( pxQueue ) );
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						#endif /* configUSE_MUTEX_PRIORITY_CEILING */
 					}
 					else
 					{
@@ -1551,7 +1907,9 @@ Queue_t * const pxQueue = xQueue;
 
 				#if ( configUSE_MUTEXES == 1 )
 				{
-					if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+					/* The holder of a ceiling mutex already runs at a priority
+					no lower than that of any task taking it. */
+					if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( queueMUTEX_CEILING( pxQueue ) == ( UBaseType_t ) 0 ) )
 					{
 						taskENTER_CRITICAL();
 						{
@@ -1566,6 +1924,7 @@ Queue_t * const pxQueue = xQueue;
 				}
 				#endif
 
+				queueMETRICS_BLOCKING( pxQueue, ulReceivesBlocked, xBlockedSince );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
 				prvUnlockQueue( pxQueue );
 				if( xTaskResumeAll() == pdFALSE )
@@ -1576,6 +1935,8 @@ Queue_t * const pxQueue = xQueue;
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
+
+				queueMETRICS_UNBLOCKED( pxQueue, xBlockedSince );
 			}
 			else
 			{
@@ -1621,6 +1982,7 @@ Queue_t * const pxQueue = xQueue;
 				}
 				#endif /* configUSE_MUTEXES */
 
+				queueMETRICS_TIMED_OUT( pxQueue, ulReceiveTimeouts );
 				traceQUEUE_RECEIVE_FAILED( pxQueue );
 				return errQUEUE_EMPTY;
 			}
@@ -1640,6 +2002,10 @@ TimeOut_t xTimeOut;
 int8_t *pcOriginalReadPosition;
 Queue_t * const pxQueue = xQueue;
 
+#if( configUSE_QUEUE_METRICS == 1 )
+	TickType_t xBlockedSince = 0;
+#endif
+
 	/* Check the pointer is not NULL. */
 	configASSERT( ( pxQueue ) );
 
@@ -1742,6 +2108,7 @@ Queue_t * const pxQueue = xQueue;
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
 				traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
+				queueMETRICS_BLOCKING( pxQueue, ulReceivesBlocked, xBlockedSince );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
 				prvUnlockQueue( pxQueue );
 				if( xTaskResumeAll() == pdFALSE )
@@ -1752,6 +2119,8 @@ Queue_t * const pxQueue = xQueue;
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
+
+				queueMETRICS_UNBLOCKED( pxQueue, xBlockedSince );
 			}
 			else
 			{
@@ -1770,6 +2139,7 @@ Queue_t * const pxQueue = xQueue;
 
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
+				queueMETRICS_TIMED_OUT( pxQueue, ulReceiveTimeouts );
 				traceQUEUE_PEEK_FAILED( pxQueue );
 				return errQUEUE_EMPTY;
 			}
@@ -1782,7 +2152,7 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue, void * const pvBuffer, BaseType_t * const pxHigherPriorityTaskWoken )
+KERNEL_RAM_FUNCTION BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue, void * const pvBuffer, BaseType_t * const pxHigherPriorityTaskWoken )
 {
 BaseType_t xReturn;
 UBaseType_t uxSavedInterruptStatus;
@@ -1820,6 +2190,7 @@ Queue_t * const pxQueue = xQueue;
 
 			prvCopyDataFromQueue( pxQueue, pvBuffer );
 			pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+			queueMETRICS_COUNT( pxQueue, ulReceives, 1U );
 
 			/* If the queue is locked the event list will not be modified.
 			Instead update the lock count so the task that unlocks the queue
@@ -1935,7 +2306,7 @@ UBaseType_t uxReturn;
 
 	taskENTER_CRITICAL();
 	{
-		uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+		uxReturn = queueMESSAGES_WAITING( ( Queue_t * ) xQueue );
 	}
 	taskEXIT_CRITICAL();
 
@@ -1952,7 +2323,7 @@ Queue_t * const pxQueue = xQueue;
 
 	taskENTER_CRITICAL();
 	{
-		uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+		uxReturn = pxQueue->uxLength - queueMESSAGES_WAITING( pxQueue );
 	}
 	taskEXIT_CRITICAL();
 
@@ -1966,7 +2337,7 @@ UBaseType_t uxReturn;
 Queue_t * const pxQueue = xQueue;
 
 	configASSERT( pxQueue );
-	uxReturn = pxQueue->uxMessagesWaiting;
+	uxReturn = queueMESSAGES_WAITING( pxQueue );
 
 	return uxReturn;
 } /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
@@ -2071,7 +2442,43 @@ Queue_t * const pxQueue = xQueue;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
+#if( configUSE_QUEUE_FAST_COPY == 1 )
+
+	/* A memcpy() of a constant size is compiled to one or two loads and
+	stores, where the general one is a call that loops on the run-time size.
+	Neither the queue storage nor the caller's buffer need be aligned: the
+	Cortex-M4 handles unaligned word and halfword accesses, and the compiler
+	does not use LDRD or LDM on pointers it cannot prove aligned. */
+	portFORCE_INLINE static void prvCopyItem( const Queue_t * const pxQueue, void * const pvDest, const void * const pvSource )
+	{
+		switch( pxQueue->ucItemCopy )
+		{
+			case 1U:
+				*( ( uint8_t * ) pvDest ) = *( ( const uint8_t * ) pvSource );
+				break;
+
+			case 2U:
+				( void ) memcpy( pvDest, pvSource, 2U );
+				break;
+
+			case 4U:
+				( void ) memcpy( pvDest, pvSource, 4U );
+				break;
+
+			case 8U:
+				( void ) memcpy( pvDest, pvSource, 8U );
+				break;
+
+			default:
+				( void ) memcpy( pvDest, pvSource, ( size_t ) pxQueue->uxItemSize );
+				break;
+		}
+	}
+
+#endif /* configUSE_QUEUE_FAST_COPY */
+/*-----------------------------------------------------------*/
+
+KERNEL_RAM_FUNCTION static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
 {
 BaseType_t xReturn = pdFALSE;
 UBaseType_t uxMessagesWaiting;
@@ -2099,7 +2506,7 @@ UBaseType_t uxMessagesWaiting;
 	}
 	else if( xPosition == queueSEND_TO_BACK )
 	{
-		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+		queueCOPY_ITEM( pxQueue, pxQueue->pcWriteTo, pvItemToQueue ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
 		pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
 		if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
 		{
@@ -2112,7 +2519,7 @@ UBaseType_t uxMessagesWaiting;
 	}
 	else
 	{
-		( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
+		queueCOPY_ITEM( pxQueue, pxQueue->u.xQueue.pcReadFrom, pvItemToQueue ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
 		pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
 		if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
 		{
@@ -2145,12 +2552,13 @@ UBaseType_t uxMessagesWaiting;
 	}
 
 	pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+	queueMETRICS_SENT( pxQueue, 1U );
 
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer )
+KERNEL_RAM_FUNCTION static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer )
 {
 	if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
 	{
@@ -2163,12 +2571,87 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
-		( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+		queueCOPY_ITEM( pxQueue, pvBuffer, pxQueue->u.xQueue.pcReadFrom ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
 	}
 }
 /*-----------------------------------------------------------*/
 
-static void prvUnlockQueue( Queue_t * const pxQueue )
+#if( configUSE_QUEUE_FAST_PATH == 1 )
+
+	/* The checks are those the full path makes in its first critical section,
+	with everything it might have to do besides the copy ruled out: a mutex or
+	semaphore (no item, possibly a priority to disinherit), an overwrite or a
+	send to the front, a task waiting on the other end, and a queue set to
+	notify.  What is left is inlined here instead of going through
+	prvCopyDataToQueue() and prvCopyDataFromQueue(). */
+	portFORCE_INLINE static BaseType_t prvSendFast( Queue_t * const pxQueue, const void * const pvItemToQueue, const BaseType_t xCopyPosition )
+	{
+	BaseType_t xReturn = pdFALSE;
+
+		if( ( xCopyPosition == queueSEND_TO_BACK ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0 ) )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) &&
+					( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+					#if( configUSE_QUEUE_SETS == 1 )
+						&& ( pxQueue->pxQueueSetContainer == NULL )
+					#endif
+					)
+				{
+					traceQUEUE_SEND( pxQueue );
+					queueCOPY_ITEM( pxQueue, pxQueue->pcWriteTo, pvItemToQueue );
+					pxQueue->pcWriteTo += pxQueue->uxItemSize;
+					if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+					{
+						pxQueue->pcWriteTo = pxQueue->pcHead;
+					}
+					pxQueue->uxMessagesWaiting++;
+					queueMETRICS_SENT( pxQueue, 1U );
+					queueNOTIFY_WAIT_ANY( pxQueue );
+					xReturn = pdTRUE;
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	portFORCE_INLINE static BaseType_t prvReceiveFast( Queue_t * const pxQueue, void * const pvBuffer )
+	{
+	BaseType_t xReturn = pdFALSE;
+
+		if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) &&
+					( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE ) )
+				{
+					pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
+					if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
+					{
+						pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+					}
+					queueCOPY_ITEM( pxQueue, pvBuffer, pxQueue->u.xQueue.pcReadFrom );
+					traceQUEUE_RECEIVE( pxQueue );
+					pxQueue->uxMessagesWaiting--;
+					queueMETRICS_COUNT( pxQueue, ulReceives, 1U );
+					xReturn = pdTRUE;
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_FAST_PATH */
+/*-----------------------------------------------------------*/
+
+KERNEL_RAM_FUNCTION static void prvUnlockQueue( Queue_t * const pxQueue )
 {
 	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
 
@@ -2288,13 +2771,13 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
 }
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvIsQueueEmpty( const Queue_t *pxQueue )
+KERNEL_RAM_FUNCTION static BaseType_t prvIsQueueEmpty( const Queue_t *pxQueue )
 {
 BaseType_t xReturn;
 
 	taskENTER_CRITICAL();
 	{
-		if( pxQueue->uxMessagesWaiting == ( UBaseType_t )  0 )
+		if( queueMESSAGES_WAITING( pxQueue ) == ( UBaseType_t ) 0 )
 		{
 			xReturn = pdTRUE;
 		}
@@ -2315,7 +2798,7 @@ BaseType_t xReturn;
 Queue_t * const pxQueue = xQueue;
 
 	configASSERT( pxQueue );
-	if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+	if( queueMESSAGES_WAITING( pxQueue ) == ( UBaseType_t ) 0 )
 	{
 		xReturn = pdTRUE;
 	}
@@ -2328,13 +2811,13 @@ Queue_t * const pxQueue = xQueue;
 } /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvIsQueueFull( const Queue_t *pxQueue )
+KERNEL_RAM_FUNCTION static BaseType_t prvIsQueueFull( const Queue_t *pxQueue )
 {
 BaseType_t xReturn;
 
 	taskENTER_CRITICAL();
 	{
-		if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+		if( queueMESSAGES_WAITING( pxQueue ) == pxQueue->uxLength )
 		{
 			xReturn = pdTRUE;
 		}
@@ -2355,7 +2838,7 @@ BaseType_t xReturn;
 Queue_t * const pxQueue = xQueue;
 
 	configASSERT( pxQueue );
-	if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+	if( queueMESSAGES_WAITING( pxQueue ) == pxQueue->uxLength )
 	{
 		xReturn = pdTRUE;
 	}
@@ -2497,6 +2980,7 @@ Queue_t * const pxQueue = xQueue;
 					mtCOVERAGE_TEST_MARKER();
 				}
 				--( pxQueue->uxMessagesWaiting );
+				queueMETRICS_COUNT( pxQueue, ulReceives, 1U );
 				( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
 
 				xReturn = pdPASS;
@@ -2605,6 +3089,7 @@ Queue_t * const pxQueue = xQueue;
 				mtCOVERAGE_TEST_MARKER();
 			}
 			--( pxQueue->uxMessagesWaiting );
+			queueMETRICS_COUNT( pxQueue, ulReceives, 1U );
 			( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
 
 			if( ( *pxCoRoutineWoken ) == pdFALSE )
@@ -2647,26 +3132,40 @@ Queue_t * const pxQueue = xQueue;
 
 	void vQueueAddToRegistry( QueueHandle_t xQueue, const char *pcQueueName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 	{
-	UBaseType_t ux;
+		#if( configUSE_OBJECT_REGISTRY == 1 )
+		{
+		Queue_t * const pxQueue = xQueue;
+
+			configASSERT( pxQueue );
 
-		/* See if there is an empty space in the registry.  A NULL name denotes
-		a free slot. */
-		for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+			/* Never full: the item is part of the queue. */
+			vRegistryAdd( &( pxQueue->xRegistryItem ), pcQueueName );
+			traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName );
+		}
+		#else
 		{
-			if( xQueueRegistry[ ux ].pcQueueName == NULL )
-			{
-				/* Store the information on this queue. */
-				xQueueRegistry[ ux ].pcQueueName = pcQueueName;
-				xQueueRegistry[ ux ].xHandle = xQueue;
+		UBaseType_t ux;
 
-				traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName );
-				break;
-			}
-			else
+			/* See if there is an empty space in the registry.  A NULL name denotes
+			a free slot. */
+			for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
 			{
-				mtCOVERAGE_TEST_MARKER();
+				if( xQueueRegistry[ ux ].pcQueueName == NULL )
+				{
+					/* Store the information on this queue. */
+					xQueueRegistry[ ux ].pcQueueName = pcQueueName;
+					xQueueRegistry[ ux ].xHandle = xQueue;
+
+					traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName );
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 		}
+		#endif /* configUSE_OBJECT_REGISTRY */
 	}
 
 #endif /* configQUEUE_REGISTRY_SIZE */
@@ -2676,23 +3175,37 @@ Queue_t * const pxQueue = xQueue;
 
 	const char *pcQueueGetName( QueueHandle_t xQueue ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 	{
-	UBaseType_t ux;
 	const char *pcReturn = NULL; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
-		/* Note there is nothing here to protect against another task adding or
-		removing entries from the registry while it is being searched. */
-		for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+		#if( configUSE_OBJECT_REGISTRY == 1 )
 		{
-			if( xQueueRegistry[ ux ].xHandle == xQueue )
-			{
-				pcReturn = xQueueRegistry[ ux ].pcQueueName;
-				break;
-			}
-			else
+		Queue_t * const pxQueue = xQueue;
+
+			configASSERT( pxQueue );
+
+			/* NULL while the queue is not registered. */
+			pcReturn = pxQueue->xRegistryItem.pcName;
+		}
+		#else
+		{
+		UBaseType_t ux;
+
+			/* Note there is nothing here to protect against another task adding or
+			removing entries from the registry while it is being searched. */
+			for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
 			{
-				mtCOVERAGE_TEST_MARKER();
+				if( xQueueRegistry[ ux ].xHandle == xQueue )
+				{
+					pcReturn = xQueueRegistry[ ux ].pcQueueName;
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 		}
+		#endif /* configUSE_OBJECT_REGISTRY */
 
 		return pcReturn;
 	} /*lint !e818 xQueue cannot be a pointer to const because it is a typedef. */
@@ -2702,36 +3215,223 @@ Queue_t * const pxQueue = xQueue;
 
 #if ( configQUEUE_REGISTRY_SIZE > 0 )
 
-	void vQueueUnregisterQueue( QueueHandle_t xQueue )
+	QueueHandle_t xQueueFindByName( const char *pcQueueName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 	{
-	UBaseType_t ux;
+	QueueHandle_t xReturn = NULL;
 
-		/* See if the handle of the queue being unregistered in actually in the
-		registry. */
-		for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+		configASSERT( pcQueueName );
+
+		#if( configUSE_OBJECT_REGISTRY == 1 )
 		{
-			if( xQueueRegistry[ ux ].xHandle == xQueue )
-			{
-				/* Set the name to NULL to show that this slot if free again. */
-				xQueueRegistry[ ux ].pcQueueName = NULL;
+			xReturn = ( QueueHandle_t ) pvRegistryFind( pcQueueName, registryTYPE_QUEUE );
+		}
+		#else
+		{
+		UBaseType_t ux;
 
-				/* Set the handle to NULL to ensure the same queue handle cannot
-				appear in the registry twice if it is added, removed, then
-				added again. */
-				xQueueRegistry[ ux ].xHandle = ( QueueHandle_t ) 0;
-				break;
-			}
-			else
+			/* As pcQueueGetName(), nothing protects the search against
+			concurrent changes to the registry. */
+			for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
 			{
-				mtCOVERAGE_TEST_MARKER();
+				if( ( xQueueRegistry[ ux ].pcQueueName != NULL ) && ( strcmp( xQueueRegistry[ ux ].pcQueueName, pcQueueName ) == 0 ) )
+				{
+					xReturn = xQueueRegistry[ ux ].xHandle;
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 		}
+		#endif /* configUSE_OBJECT_REGISTRY */
 
-	} /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
+		return xReturn;
+	}
+
+#endif /* configQUEUE_REGISTRY_SIZE */
+/*-----------------------------------------------------------*/
+
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+	void vQueueUnregisterQueue( QueueHandle_t xQueue )
+	{
+		#if( configUSE_OBJECT_REGISTRY == 1 )
+		{
+		Queue_t * const pxQueue = xQueue;
+
+			configASSERT( pxQueue );
+
+			/* Unlinked in place, without a search. */
+			vRegistryRemove( &( pxQueue->xRegistryItem ) );
+		}
+		#else
+		{
+		UBaseType_t ux;
+
+			/* See if the handle of the queue being unregistered in actually in the
+			registry. */
+			for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+			{
+				if( xQueueRegistry[ ux ].xHandle == xQueue )
+				{
+					/* Set the name to NULL to show that this slot if free again. */
+					xQueueRegistry[ ux ].pcQueueName = NULL;
+
+					/* Set the handle to NULL to ensure the same queue handle cannot
+					appear in the registry twice if it is added, removed, then
+					added again. */
+					xQueueRegistry[ ux ].xHandle = ( QueueHandle_t ) 0;
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		#endif /* configUSE_OBJECT_REGISTRY */
+	} /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
 
 #endif /* configQUEUE_REGISTRY_SIZE */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_QUEUE_METRICS == 1 )
+
+	void vQueueGetMetrics( QueueHandle_t xQueue, QueueMetrics_t * const pxMetrics )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxMetrics );
+
+		taskENTER_CRITICAL();
+		{
+			*pxMetrics = pxQueue->xMetrics;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_QUEUE_METRICS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_METRICS == 1 )
+
+	void vQueueResetMetrics( QueueHandle_t xQueue )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+
+		taskENTER_CRITICAL();
+		{
+			( void ) memset( ( void * ) &( pxQueue->xMetrics ), 0x00, sizeof( pxQueue->xMetrics ) );
+
+			/* The items already queued are the starting high-water mark. */
+			pxQueue->xMetrics.ulHighWaterMark = ( uint32_t ) queueMESSAGES_WAITING( pxQueue );
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_QUEUE_METRICS */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_QUEUE_METRICS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+
+	UBaseType_t uxQueueGetRegistryMetrics( QueueRegistryMetrics_t * const pxArray, const UBaseType_t uxArraySize )
+	{
+	UBaseType_t uxCount = ( UBaseType_t ) 0;
+	Queue_t *pxQueue;
+
+		configASSERT( !( ( pxArray == NULL ) && ( uxArraySize != ( UBaseType_t ) 0 ) ) );
+
+		#if( configUSE_OBJECT_REGISTRY == 1 )
+		{
+		const RegistryItem_t *pxItem;
+
+			/* The scheduler stays suspended for the walk, so no queue joins
+			or leaves the registry meanwhile. */
+			vTaskSuspendAll();
+			{
+				for( pxItem = pxRegistryGetNext( NULL ); ( pxItem != NULL ) && ( uxCount < uxArraySize ); pxItem = pxRegistryGetNext( pxItem ) )
+				{
+					if( pxItem->ucType == registryTYPE_QUEUE )
+					{
+						pxQueue = ( Queue_t * ) pxItem->pvObject;
+
+						/* One queue at a time, so interrupts are only held
+						off for the copy of a single queue. */
+						taskENTER_CRITICAL();
+						{
+							pxArray[ uxCount ].pcQueueName = pxItem->pcName;
+							pxArray[ uxCount ].xHandle = pxQueue;
+							pxArray[ uxCount ].uxLength = pxQueue->uxLength;
+							pxArray[ uxCount ].uxItemSize = pxQueue->uxItemSize;
+							pxArray[ uxCount ].uxMessagesWaiting = queueMESSAGES_WAITING( pxQueue );
+							pxArray[ uxCount ].xMetrics = pxQueue->xMetrics;
+						}
+						taskEXIT_CRITICAL();
+						uxCount++;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			( void ) xTaskResumeAll();
+		}
+		#else
+		{
+		UBaseType_t ux;
+
+			for( ux = ( UBaseType_t ) 0U; ( ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE ) && ( uxCount < uxArraySize ); ux++ )
+			{
+				/* One entry at a time, so interrupts are only held off for the
+				copy of a single queue. */
+				taskENTER_CRITICAL();
+				{
+					if( xQueueRegistry[ ux ].pcQueueName != NULL )
+					{
+						pxQueue = xQueueRegistry[ ux ].xHandle;
+						pxArray[ uxCount ].pcQueueName = xQueueRegistry[ ux ].pcQueueName;
+						pxArray[ uxCount ].xHandle = pxQueue;
+						pxArray[ uxCount ].uxLength = pxQueue->uxLength;
+						pxArray[ uxCount ].uxItemSize = pxQueue->uxItemSize;
+						pxArray[ uxCount ].uxMessagesWaiting = queueMESSAGES_WAITING( pxQueue );
+						pxArray[ uxCount ].xMetrics = pxQueue->xMetrics;
+						uxCount++;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				taskEXIT_CRITICAL();
+			}
+		}
+		#endif /* configUSE_OBJECT_REGISTRY */
+
+		return uxCount;
+	}
+
+#endif /* ( configUSE_QUEUE_METRICS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_METRICS == 1 )
+
+	static void prvQueueMetricsAdd( uint32_t * const pulCounter, const uint32_t ulValue )
+	{
+		taskENTER_CRITICAL();
+		{
+			*pulCounter += ulValue;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_QUEUE_METRICS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TIMERS == 1 )
 
 	void vQueueWaitForMessageRestricted( QueueHandle_t xQueue, TickType_t xTicksToWait, const BaseType_t xWaitIndefinitely )
@@ -2795,7 +3495,7 @@ Queue_t * const pxQueue = xQueue;
 				/* Cannot add a queue/semaphore to more than one queue set. */
 				xReturn = pdFAIL;
 			}
-			else if( ( ( Queue_t * ) xQueueOrSemaphore )->uxMessagesWaiting != ( UBaseType_t ) 0 )
+			else if( queueMESSAGES_WAITING( ( Queue_t * ) xQueueOrSemaphore ) != ( UBaseType_t ) 0 )
 			{
 				/* Cannot add a queue/semaphore to a queue set if there are already
 				items in the queue/semaphore. */
@@ -2827,7 +3527,7 @@ Queue_t * const pxQueue = xQueue;
 			/* The queue was not a member of the set. */
 			xReturn = pdFAIL;
 		}
-		else if( pxQueueOrSemaphore->uxMessagesWaiting != ( UBaseType_t ) 0 )
+		else if( queueMESSAGES_WAITING( pxQueueOrSemaphore ) != ( UBaseType_t ) 0 )
 		{
 			/* It is dangerous to remove a queue from a set when the queue is
 			not empty because the queue set will still hold pending events for
@@ -2931,6 +3631,762 @@ Queue_t * const pxQueue = xQueue;
 	}
 
 #endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAIT_ANY == 1 )
+
+	static BaseType_t prvQueueIsReady( void *pvQueue )
+	{
+		/* A single word read, so no critical section is needed.  Mutexes are
+		ready while they are free. */
+		return ( queueMESSAGES_WAITING( ( Queue_t * ) pvQueue ) != ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxWaitAnyAddQueue( WaitAnyHandle_t xWaitAny, QueueHandle_t xQueueOrSemaphore )
+	{
+	Queue_t * const pxQueue = xQueueOrSemaphore;
+	UBaseType_t uxReturn;
+
+		configASSERT( pxQueue );
+
+		taskENTER_CRITICAL();
+		{
+			/* Cannot be a member of more than one wait-any object. */
+			configASSERT( pxQueue->pxWaitAny == NULL );
+
+			uxReturn = uxWaitAnyAddMember( xWaitAny, pxQueue, prvQueueIsReady );
+
+			if( uxReturn != ( UBaseType_t ) 0 )
+			{
+				pxQueue->pxWaitAny = xWaitAny;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_WAIT_ANY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_REFERENCES == 1 )
+
+	#if ( configQUEUE_REFERENCE_OWNERSHIP_CHECK == 1 )
+
+		static BaseType_t prvIsReferenceQueued( const Queue_t * const pxQueue, const void * const pvReference )
+		{
+		BaseType_t xReturn = pdFALSE;
+		UBaseType_t uxIndex;
+		const int8_t *pcItem;
+
+			/* Walk the items currently held, oldest first.  Debug builds only, so
+			the O(n) walk inside the critical section is acceptable. */
+			taskENTER_CRITICAL();
+			{
+				pcItem = pxQueue->u.xQueue.pcReadFrom;
+
+				for( uxIndex = 0; uxIndex < pxQueue->uxMessagesWaiting; uxIndex++ )
+				{
+					pcItem += pxQueue->uxItemSize;
+
+					if( pcItem >= pxQueue->u.xQueue.pcTail )
+					{
+						pcItem = pxQueue->pcHead;
+					}
+
+					if( *( void * const * ) pcItem == pvReference ) /*lint !e9087 Cast is safe as the storage holds pointers. */
+					{
+						xReturn = pdTRUE;
+						break;
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			return xReturn;
+		}
+
+	#endif /* configQUEUE_REFERENCE_OWNERSHIP_CHECK */
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xQueueSendRef( QueueHandle_t xQueue, void ** const ppvReference, TickType_t xTicksToWait )
+	{
+	BaseType_t xReturn;
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( ppvReference );
+		configASSERT( *ppvReference );
+
+		/* A reference queue carries exactly one pointer per item. */
+		configASSERT( pxQueue->uxItemSize == sizeof( void * ) );
+
+		#if ( configQUEUE_REFERENCE_OWNERSHIP_CHECK == 1 )
+		{
+			/* The block must not already be owned by the queue - that would mean
+			the caller kept using a reference it had already handed over. */
+			configASSERT( prvIsReferenceQueued( pxQueue, *ppvReference ) == pdFALSE );
+		}
+		#endif
+
+		xReturn = xQueueGenericSend( xQueue, ppvReference, xTicksToWait, queueSEND_TO_BACK );
+
+		if( xReturn == pdPASS )
+		{
+			/* Ownership moved to the queue, so the sender loses its reference. */
+			*ppvReference = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xQueueSendRefFromISR( QueueHandle_t xQueue, void ** const ppvReference, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	BaseType_t xReturn;
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( ppvReference );
+		configASSERT( *ppvReference );
+		configASSERT( pxQueue->uxItemSize == sizeof( void * ) );
+
+		xReturn = xQueueGenericSendFromISR( xQueue, ppvReference, pxHigherPriorityTaskWoken, queueSEND_TO_BACK );
+
+		if( xReturn == pdPASS )
+		{
+			*ppvReference = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xQueueReceiveRef( QueueHandle_t xQueue, void ** const ppvReference, TickType_t xTicksToWait )
+	{
+	BaseType_t xReturn;
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( ppvReference );
+		configASSERT( pxQueue->uxItemSize == sizeof( void * ) );
+
+		#if ( configQUEUE_REFERENCE_OWNERSHIP_CHECK == 1 )
+		{
+			/* Receiving over a live reference would leak the block it points to. */
+			configASSERT( *ppvReference == NULL );
+		}
+		#endif
+
+		xReturn = xQueueReceive( xQueue, ppvReference, xTicksToWait );
+
+		if( xReturn != pdPASS )
+		{
+			*ppvReference = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_REFERENCES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+	static void prvCopyItemsToQueue( Queue_t * const pxQueue, const int8_t *pcItems, UBaseType_t uxCount )
+	{
+	UBaseType_t uxChunk;
+
+		/* Called from within a critical section, or with interrupts masked,
+		with uxCount no larger than the free space.  The ring is filled in at
+		most two contiguous runs - up to the end of the storage area and then
+		from its start. */
+		queueMETRICS_COUNT( pxQueue, ulSends, uxCount );
+
+		while( uxCount > ( UBaseType_t ) 0 )
+		{
+			uxChunk = ( UBaseType_t ) ( ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo ) / ( size_t ) pxQueue->uxItemSize ); /*lint !e946 !e9033 MISRA exception justified as pointer subtraction is the cleanest solution. */
+
+			if( uxChunk > uxCount )
+			{
+				uxChunk = uxCount;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, ( size_t ) ( uxChunk * pxQueue->uxItemSize ) ); /*lint !e961 !e418 !e9087 Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+			pxQueue->pcWriteTo += ( uxChunk * pxQueue->uxItemSize );
+			pcItems += ( uxChunk * pxQueue->uxItemSize );
+			uxCount -= uxChunk;
+
+			if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+			{
+				pxQueue->pcWriteTo = pxQueue->pcHead;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxQueue->uxMessagesWaiting += uxChunk;
+		}
+
+		queueMETRICS_HIGH_WATER( pxQueue );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvCopyItemsFromQueue( Queue_t * const pxQueue, int8_t *pcBuffer, UBaseType_t uxCount )
+	{
+	UBaseType_t uxChunk;
+	int8_t *pcNext;
+
+		/* As prvCopyItemsToQueue().  pcReadFrom points at the item read last,
+		so the oldest item is the one after it. */
+		queueMETRICS_COUNT( pxQueue, ulReceives, uxCount );
+
+		while( uxCount > ( UBaseType_t ) 0 )
+		{
+			pcNext = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize;
+
+			if( pcNext >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+			{
+				pcNext = pxQueue->pcHead;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			uxChunk = ( UBaseType_t ) ( ( size_t ) ( pxQueue->u.xQueue.pcTail - pcNext ) / ( size_t ) pxQueue->uxItemSize ); /*lint !e946 !e9033 MISRA exception justified as pointer subtraction is the cleanest solution. */
+
+			if( uxChunk > uxCount )
+			{
+				uxChunk = uxCount;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			( void ) memcpy( ( void * ) pcBuffer, ( void * ) pcNext, ( size_t ) ( uxChunk * pxQueue->uxItemSize ) ); /*lint !e961 !e418 !e9087 Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+			pxQueue->u.xQueue.pcReadFrom = pcNext + ( ( uxChunk - ( UBaseType_t ) 1 ) * pxQueue->uxItemSize );
+			pcBuffer += ( uxChunk * pxQueue->uxItemSize );
+			uxCount -= uxChunk;
+
+			pxQueue->uxMessagesWaiting -= uxChunk;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvUnblockReceivers( Queue_t * const pxQueue, UBaseType_t uxItemsAdded )
+	{
+	BaseType_t xYieldRequired = pdFALSE;
+
+		#if ( configUSE_QUEUE_SETS == 1 )
+		if( pxQueue->pxQueueSetContainer != NULL )
+		{
+			/* The set holds one handle per item, so post once per item. */
+			while( uxItemsAdded > ( UBaseType_t ) 0 )
+			{
+				if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+				{
+					xYieldRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				uxItemsAdded--;
+			}
+		}
+		else
+		#endif /* configUSE_QUEUE_SETS */
+		{
+			/* Each new item can satisfy one waiting receiver, so wake at most
+			that many.  The caller yields once, whatever the count. */
+			while( ( uxItemsAdded > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+			{
+				if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+				{
+					xYieldRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				uxItemsAdded--;
+			}
+		}
+
+		return xYieldRequired;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvUnblockSenders( Queue_t * const pxQueue, UBaseType_t uxSpacesFreed )
+	{
+	BaseType_t xYieldRequired = pdFALSE;
+
+		while( ( uxSpacesFreed > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+		{
+			if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+			{
+				xYieldRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			uxSpacesFreed--;
+		}
+
+		return xYieldRequired;
+	}
+	/*-----------------------------------------------------------*/
+
+	static int8_t prvAddToQueueLock( int8_t cLock, UBaseType_t uxCount )
+	{
+	UBaseType_t uxLock = ( UBaseType_t ) cLock + uxCount;
+
+		/* prvUnlockQueue() wakes one task per count, so there is no point
+		counting past the int8_t range. */
+		if( uxLock > ( UBaseType_t ) 127 )
+		{
+			uxLock = ( UBaseType_t ) 127;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return ( int8_t ) uxLock;
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, UBaseType_t uxItemCount, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE;
+	TimeOut_t xTimeOut;
+	Queue_t * const pxQueue = xQueue;
+	const int8_t *pcNextItem = ( const int8_t * ) pvItems;
+	UBaseType_t uxSent = ( UBaseType_t ) 0, uxCopied;
+	#if( configUSE_QUEUE_METRICS == 1 )
+		TickType_t xBlockedSince = 0;
+	#endif
+
+		configASSERT( pxQueue );
+		configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0 ) ) );
+
+		/* Semaphores and mutexes carry no data, so batching them makes no
+		sense and would bypass priority inheritance. */
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0 );
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/*lint -save -e904 This function relaxes the coding standard somewhat to
+		allow return statements within the function itself.  This is done in the
+		interest of execution time efficiency. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* Copy as much of the batch as fits in one pass. */
+				uxCopied = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+				if( uxCopied > ( uxItemCount - uxSent ) )
+				{
+					uxCopied = uxItemCount - uxSent;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( uxCopied > ( UBaseType_t ) 0 )
+				{
+					traceQUEUE_SEND( pxQueue );
+					prvCopyItemsToQueue( pxQueue, pcNextItem, uxCopied );
+					pcNextItem += ( uxCopied * pxQueue->uxItemSize );
+					uxSent += uxCopied;
+					queueNOTIFY_WAIT_ANY( pxQueue );
+
+					if( prvUnblockReceivers( pxQueue, uxCopied ) != pdFALSE )
+					{
+						/* Ok to do from within the critical section - the
+						switch is taken when the critical section exits. */
+						queueYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( uxSent == uxItemCount )
+				{
+					taskEXIT_CRITICAL();
+					return ( BaseType_t ) uxSent;
+				}
+				else if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					/* The queue is full and no block time is specified (or
+					the block time has expired) so return what was sent. */
+					queueMETRICS_SEND_FAILED( pxQueue, xEntryTimeSet, uxItemCount - uxSent );
+					taskEXIT_CRITICAL();
+					traceQUEUE_SEND_FAILED( pxQueue );
+					return ( BaseType_t ) uxSent;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					/* The whole batch shares one timeout. */
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueFull( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+					queueMETRICS_BLOCKING( pxQueue, ulSendsBlocked, xBlockedSince );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					queueMETRICS_UNBLOCKED( pxQueue, xBlockedSince );
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* The timeout has expired.  Loop once more so any space freed
+				at the last moment is still used before giving up. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+				xTicksToWait = ( TickType_t ) 0;
+			}
+		} /*lint -restore */
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	UBaseType_t uxSavedInterruptStatus, uxCopied;
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0 ) ) );
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0 );
+
+		/* See the comments in xQueueGenericSendFromISR(). */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			uxCopied = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+			if( uxCopied > uxItemCount )
+			{
+				uxCopied = uxItemCount;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( uxCopied > ( UBaseType_t ) 0 )
+			{
+				const int8_t cTxLock = pxQueue->cTxLock;
+
+				traceQUEUE_SEND_FROM_ISR( pxQueue );
+				prvCopyItemsToQueue( pxQueue, ( const int8_t * ) pvItems, uxCopied );
+				queueNOTIFY_WAIT_ANY_FROM_ISR( pxQueue, pxHigherPriorityTaskWoken );
+
+				/* The event list is not altered if the queue is locked.  This
+				will be done when the queue is unlocked later. */
+				if( cTxLock == queueUNLOCKED )
+				{
+					if( prvUnblockReceivers( pxQueue, uxCopied ) != pdFALSE )
+					{
+						if( pxHigherPriorityTaskWoken != NULL )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					/* One count per item, so the unlocking task wakes as many
+					receivers as there are new items. */
+					pxQueue->cTxLock = prvAddToQueueLock( cTxLock, uxCopied );
+				}
+			}
+			else
+			{
+				traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+			}
+
+			queueMETRICS_COUNT( pxQueue, ulFullDrops, uxItemCount - uxCopied );
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return ( BaseType_t ) uxCopied;
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE;
+	TimeOut_t xTimeOut;
+	Queue_t * const pxQueue = xQueue;
+	UBaseType_t uxCopied;
+	#if( configUSE_QUEUE_METRICS == 1 )
+		TickType_t xBlockedSince = 0;
+	#endif
+
+		configASSERT( pxQueue );
+		configASSERT( !( ( pvBuffer == NULL ) && ( uxMaxItems != ( UBaseType_t ) 0 ) ) );
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0 );
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/*lint -save -e904  This function relaxes the coding standard somewhat to
+		allow return statements within the function itself.  This is done in the
+		interest of execution time efficiency. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				uxCopied = pxQueue->uxMessagesWaiting;
+
+				if( uxCopied > uxMaxItems )
+				{
+					uxCopied = uxMaxItems;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Unlike xQueueSendMultiple(), return as soon as anything is
+				available rather than waiting for a full batch. */
+				if( ( uxCopied > ( UBaseType_t ) 0 ) || ( uxMaxItems == ( UBaseType_t ) 0 ) )
+				{
+					traceQUEUE_RECEIVE( pxQueue );
+					prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxCopied );
+
+					if( prvUnblockSenders( pxQueue, uxCopied ) != pdFALSE )
+					{
+						queueYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					taskEXIT_CRITICAL();
+					return ( BaseType_t ) uxCopied;
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						/* The queue was empty and no block time is specified
+						(or the block time has expired) so leave now. */
+						queueMETRICS_RECEIVE_FAILED( pxQueue, xEntryTimeSet );
+						taskEXIT_CRITICAL();
+						traceQUEUE_RECEIVE_FAILED( pxQueue );
+						return ( BaseType_t ) 0;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						vTaskInternalSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+					queueMETRICS_BLOCKING( pxQueue, ulReceivesBlocked, xBlockedSince );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					queueMETRICS_UNBLOCKED( pxQueue, xBlockedSince );
+				}
+				else
+				{
+					/* The queue contains data again.  Loop back to try and
+					read the data. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* Timed out.  Loop once more without blocking to pick up any
+				data that arrived at the last moment. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+				xTicksToWait = ( TickType_t ) 0;
+			}
+		} /*lint -restore */
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	UBaseType_t uxSavedInterruptStatus, uxCopied;
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( !( ( pvBuffer == NULL ) && ( uxMaxItems != ( UBaseType_t ) 0 ) ) );
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0 );
+
+		/* See the comments in xQueueGenericSendFromISR(). */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			uxCopied = pxQueue->uxMessagesWaiting;
+
+			if( uxCopied > uxMaxItems )
+			{
+				uxCopied = uxMaxItems;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( uxCopied > ( UBaseType_t ) 0 )
+			{
+				const int8_t cRxLock = pxQueue->cRxLock;
+
+				traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+				prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxCopied );
+
+				/* If the queue is locked the event list will not be modified.
+				Instead update the lock count so the task that unlocks the
+				queue will know that ISRs have freed space while it was
+				locked. */
+				if( cRxLock == queueUNLOCKED )
+				{
+					if( prvUnblockSenders( pxQueue, uxCopied ) != pdFALSE )
+					{
+						if( pxHigherPriorityTaskWoken != NULL )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					pxQueue->cRxLock = prvAddToQueueLock( cRxLock, uxCopied );
+				}
+			}
+			else
+			{
+				traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return ( BaseType_t ) uxCopied;
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
 
 
 
@@ -0,0 +1,337 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "light_channel.h"
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build light_channel.c
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+#if( configUSE_PREEMPTION == 0 )
+	/* If the cooperative scheduler is being used then a yield should not be
+	performed just because a higher priority task has been woken. */
+	#define lightchanYIELD_IF_USING_PREEMPTION()
+#else
+	#define lightchanYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
+#endif
+
+/*
+ * Posts ulValue to the notification if the ring is empty and the notification
+ * is free, or to the end of the ring otherwise.  Called in a critical section.
+ * pxHigherPriorityTaskWoken is NULL when called from a task.
+ */
+static BaseType_t prvPost( LightChannelHandle_t xChannel, uint32_t ulValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+LightChannelHandle_t xLightChannelCreateStatic( TaskHandle_t xOwner, UBaseType_t uxIndex, UBaseType_t uxRingLength, uint32_t *pulRingStorage, StaticLightChannel_t *pxChannelBuffer )
+{
+	configASSERT( xOwner );
+	configASSERT( pxChannelBuffer );
+	configASSERT( uxIndex < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
+	configASSERT( ( uxRingLength == ( UBaseType_t ) 0 ) || ( pulRingStorage != NULL ) );
+
+	pxChannelBuffer->xOwner = xOwner;
+	pxChannelBuffer->uxIndex = uxIndex;
+	pxChannelBuffer->pulRing = pulRingStorage;
+	pxChannelBuffer->uxRingLength = uxRingLength;
+	pxChannelBuffer->uxRingHead = ( UBaseType_t ) 0;
+	pxChannelBuffer->uxRingCount = ( UBaseType_t ) 0;
+	vListInitialise( &( pxChannelBuffer->xTasksWaitingToSend ) );
+
+	/* Start from a clean notification, as light semaphores do.  Only the
+	owner can be waiting on this index, and it cannot be while its channel is
+	being created. */
+	taskENTER_CRITICAL();
+	{
+		( void ) xTaskNotifyStateClearIndexed( xOwner, uxIndex );
+		( void ) ulTaskNotifyValueClearIndexed( xOwner, uxIndex, ~( ( uint32_t ) 0 ) );
+	}
+	taskEXIT_CRITICAL();
+
+	return pxChannelBuffer;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xLightChannelSend( LightChannelHandle_t xChannel, uint32_t ulValue, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE, xPosted;
+TimeOut_t xTimeOut;
+
+	configASSERT( xChannel );
+
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( prvPost( xChannel, ulValue, NULL ) != pdFALSE )
+			{
+				taskEXIT_CRITICAL();
+				return pdPASS;
+			}
+			else if( xTicksToWait == ( TickType_t ) 0 )
+			{
+				taskEXIT_CRITICAL();
+				return errQUEUE_FULL;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				vTaskInternalSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		/* Only the owner makes room and only tasks use the event list, so
+		with the scheduler suspended neither changes.  Interrupts may still
+		send, which only fills the channel.  The owner may have received since
+		the critical section above, so post once more before blocking. */
+		vTaskSuspendAll();
+
+		taskENTER_CRITICAL();
+		{
+			xPosted = prvPost( xChannel, ulValue, NULL );
+		}
+		taskEXIT_CRITICAL();
+
+		if( xPosted != pdFALSE )
+		{
+			( void ) xTaskResumeAll();
+			return pdPASS;
+		}
+		else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			vTaskPlaceOnEventList( &( xChannel->xTasksWaitingToSend ), xTicksToWait );
+
+			if( xTaskResumeAll() == pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			( void ) xTaskResumeAll();
+			return errQUEUE_FULL;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xLightChannelSendFromISR( LightChannelHandle_t xChannel, uint32_t ulValue, BaseType_t *pxHigherPriorityTaskWoken )
+{
+BaseType_t xReturn;
+UBaseType_t uxSavedInterruptStatus;
+BaseType_t xWoken = pdFALSE;
+
+	configASSERT( xChannel );
+
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( prvPost( xChannel, ulValue, &xWoken ) != pdFALSE )
+		{
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = errQUEUE_FULL;
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	if( ( pxHigherPriorityTaskWoken != NULL ) && ( xWoken != pdFALSE ) )
+	{
+		*pxHigherPriorityTaskWoken = pdTRUE;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xLightChannelReceive( LightChannelHandle_t xChannel, uint32_t *pulValue, TickType_t xTicksToWait )
+{
+uint32_t ulValue;
+
+	configASSERT( xChannel );
+	configASSERT( pulValue );
+
+	/* A light channel has a single receiver: its owner.  Another task would
+	wait on its own notification, which nothing sends to. */
+	configASSERT( xTaskGetCurrentTaskHandle() == xChannel->xOwner );
+
+	if( xTaskNotifyWaitIndexed( xChannel->uxIndex, 0UL, 0UL, &ulValue, xTicksToWait ) == pdFALSE )
+	{
+		return pdFALSE;
+	}
+
+	*pulValue = ulValue;
+
+	taskENTER_CRITICAL();
+	{
+		/* Messages only go to the ring while it is not empty, so none sent
+		since the wait took the place of the oldest one in it.  The
+		notification is only refilled if it is still free: a message sent to
+		the empty channel after the wait is older than any in the ring. */
+		if( xChannel->uxRingCount != ( UBaseType_t ) 0 )
+		{
+			if( xTaskNotifyIndexed( xChannel->xOwner, xChannel->uxIndex, xChannel->pulRing[ xChannel->uxRingHead ], eSetValueWithoutOverwrite ) != pdFAIL )
+			{
+				xChannel->uxRingHead++;
+
+				if( xChannel->uxRingHead >= xChannel->uxRingLength )
+				{
+					xChannel->uxRingHead = ( UBaseType_t ) 0;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				( xChannel->uxRingCount )--;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* One message left, so one blocked sender may have room.  If another
+		task or an interrupt took it first, that sender blocks again. */
+		if( listLIST_IS_EMPTY( &( xChannel->xTasksWaitingToSend ) ) == pdFALSE )
+		{
+			if( xTaskRemoveFromEventList( &( xChannel->xTasksWaitingToSend ) ) != pdFALSE )
+			{
+				lightchanYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxLightChannelGetRingCount( LightChannelHandle_t xChannel )
+{
+	configASSERT( xChannel );
+
+	return xChannel->uxRingCount;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPost( LightChannelHandle_t xChannel, uint32_t ulValue, BaseType_t *pxHigherPriorityTaskWoken )
+{
+BaseType_t xReturn = pdFALSE;
+
+	if( xChannel->uxRingCount == ( UBaseType_t ) 0 )
+	{
+		/* Fails if the notification still holds an earlier message. */
+		if( pxHigherPriorityTaskWoken == NULL )
+		{
+			xReturn = xTaskNotifyIndexed( xChannel->xOwner, xChannel->uxIndex, ulValue, eSetValueWithoutOverwrite );
+		}
+		else
+		{
+			xReturn = xTaskNotifyIndexedFromISR( xChannel->xOwner, xChannel->uxIndex, ulValue, eSetValueWithoutOverwrite, pxHigherPriorityTaskWoken );
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( ( xReturn == pdFALSE ) && ( xChannel->uxRingCount < xChannel->uxRingLength ) )
+	{
+		UBaseType_t uxTail = xChannel->uxRingHead + xChannel->uxRingCount;
+
+		if( uxTail >= xChannel->uxRingLength )
+		{
+			uxTail -= xChannel->uxRingLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xChannel->pulRing[ uxTail ] = ulValue;
+		( xChannel->uxRingCount )++;
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
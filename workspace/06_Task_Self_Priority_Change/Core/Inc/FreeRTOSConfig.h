@@ -125,6 +125,7 @@ to exclude the API function. */
  * by the application thus the correct define need to be enabled below
  */
 #define USE_FreeRTOS_HEAP_4
+/* #define USE_FreeRTOS_HEAP_TLSF */	/* Instead of HEAP_4: heap_tlsf.c, O(1) malloc and free */
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -168,6 +169,15 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Port optimised task selection: the CM4F port finds the highest ready
+priority with CLZ on a ready-priority bitmap instead of walking the ready
+lists.  The 56 CMSIS-RTOS2 priorities take a two-level bitmap, so selection is
+two CLZs whatever the priorities in use (see README, Task Selection). */
+#undef configUSE_PORT_OPTIMISED_TASK_SELECTION
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
+/* The idle task sleeps the CPU until the next interrupt instead of spinning
+between ticks (see README, Idle Sleep). */
+#define configUSE_IDLE_SLEEP                     1
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
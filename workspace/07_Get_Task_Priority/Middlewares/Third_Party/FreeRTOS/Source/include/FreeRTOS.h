@@ -58,6 +58,30 @@ extern "C" {
 /* Basic FreeRTOS definitions. */
 #include "projdefs.h"
 
+/* Must be defaulted before portable.h sizes HeapInstrumentation_t. */
+#ifndef configUSE_HEAP_INSTRUMENTATION
+	#define configUSE_HEAP_INSTRUMENTATION 0
+#endif
+
+#ifndef configHEAP_INSTRUMENTATION_CALLERS
+	#define configHEAP_INSTRUMENTATION_CALLERS 16
+#endif
+
+#ifndef configHEAP_HISTOGRAM_BUCKETS
+	#define configHEAP_HISTOGRAM_BUCKETS 12
+#endif
+
+/* Must be defaulted before portable.h declares pvPortMallocRegion(). */
+#ifndef configUSE_HEAP_REGIONS
+	/* Build the heap_4.c heap from the memory regions given by the
+	application, instead of the single ucHeap array. */
+	#define configUSE_HEAP_REGIONS 0
+#endif
+
+#ifndef configHEAP_MAX_REGIONS
+	#define configHEAP_MAX_REGIONS 4
+#endif
+
 /* Definitions specific to the port being used. */
 #include "portable.h"
 
@@ -104,6 +128,16 @@ extern "C" {
 	#error Missing definition:  configUSE_16_BIT_TICKS must be defined in FreeRTOSConfig.h as either 1 or 0.  See the Configuration section of the FreeRTOS API documentation for details.
 #endif
 
+#ifndef configUSE_64_BIT_TICKS
+	/* A 64-bit TickType_t, for ports that support it.  The tick count then
+	never wraps, so the delayed task and timer lists are never switched. */
+	#define configUSE_64_BIT_TICKS 0
+#endif
+
+#if( ( configUSE_64_BIT_TICKS == 1 ) && ( configUSE_16_BIT_TICKS == 1 ) )
+	#error configUSE_16_BIT_TICKS and configUSE_64_BIT_TICKS cannot both be set to 1
+#endif
+
 #ifndef configUSE_CO_ROUTINES
 	#define configUSE_CO_ROUTINES 0
 #endif
@@ -124,6 +158,14 @@ extern "C" {
 	#define INCLUDE_vTaskSuspend 0
 #endif
 
+#ifndef INCLUDE_vTaskSwitchGroups
+	#define INCLUDE_vTaskSwitchGroups 0
+#endif
+
+#if( ( INCLUDE_vTaskSwitchGroups == 1 ) && ( INCLUDE_vTaskSuspend != 1 ) )
+	#error INCLUDE_vTaskSuspend must be set to 1 if INCLUDE_vTaskSwitchGroups is set to 1
+#endif
+
 #ifndef INCLUDE_vTaskDelayUntil
 	#define INCLUDE_vTaskDelayUntil 0
 #endif
@@ -140,6 +182,10 @@ extern "C" {
 	#define INCLUDE_xTaskAbortDelay 0
 #endif
 
+#ifndef INCLUDE_xTaskGetTicksToNextWake
+	#define INCLUDE_xTaskGetTicksToNextWake 0
+#endif
+
 #ifndef INCLUDE_xQueueGetMutexHolder
 	#define INCLUDE_xQueueGetMutexHolder 0
 #endif
@@ -261,6 +307,12 @@ hold explicit before calling the code. */
 	#define portSOFTWARE_BARRIER()
 #endif
 
+#ifndef portGET_RETURN_ADDRESS
+	/* Return address of the current function, only evaluated as an argument of
+	the trace macros. */
+	#define portGET_RETURN_ADDRESS() NULL
+#endif
+
 /* The timers module relies on xTaskGetSchedulerState(). */
 #if configUSE_TIMERS == 1
 
@@ -353,6 +405,31 @@ hold explicit before calling the code. */
 	#define traceTASK_SWITCHED_OUT()
 #endif
 
+#ifndef traceENTER_CRITICAL_SECTION
+	/* Called by the port on entering the outermost critical section, with
+	interrupts already masked.  pvCaller is the return address of the call that
+	entered it, if the port defines portGET_RETURN_ADDRESS(), NULL otherwise. */
+	#define traceENTER_CRITICAL_SECTION( pvCaller )
+#endif
+
+#ifndef traceEXIT_CRITICAL_SECTION
+	/* Called by the port on leaving the outermost critical section, just before
+	interrupts are unmasked. */
+	#define traceEXIT_CRITICAL_SECTION()
+#endif
+
+#ifndef traceSCHEDULER_SUSPENDED
+	/* Called when vTaskSuspendAll() suspends the scheduler, not by the nested
+	calls.  pvCaller is as for traceENTER_CRITICAL_SECTION(). */
+	#define traceSCHEDULER_SUSPENDED( pvCaller )
+#endif
+
+#ifndef traceSCHEDULER_RESUMED
+	/* Called when xTaskResumeAll() resumes the scheduler, within a critical
+	section, before the tasks readied meanwhile are moved to the ready lists. */
+	#define traceSCHEDULER_RESUMED()
+#endif
+
 #ifndef traceTASK_PRIORITY_INHERIT
 	/* Called when a task attempts to take a mutex that is already held by a
 	lower priority task.  pxTCBOfMutexHolder is a pointer to the TCB of the task
@@ -394,10 +471,41 @@ hold explicit before calling the code. */
 	#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )
 #endif
 
+/* Set to 1 for the lean TCB layout: the members the scheduler touches come
+first, padding is squeezed out, the task name is stored as a pointer to the
+string passed at creation instead of a configMAX_TASK_NAME_LEN copy, and the
+trace numbers of configUSE_TRACE_FACILITY move to a side table of
+configLEAN_TCB_DIAGNOSTIC_ENTRIES entries (0 for none).  Task names must then
+be string literals or otherwise outlive their task. */
+#ifndef configUSE_LEAN_TCB
+	#define configUSE_LEAN_TCB 0
+#endif
+
+#ifndef configLEAN_TCB_DIAGNOSTIC_ENTRIES
+	#define configLEAN_TCB_DIAGNOSTIC_ENTRIES 0
+#endif
+
 #ifndef configCHECK_FOR_STACK_OVERFLOW
 	#define configCHECK_FOR_STACK_OVERFLOW 0
 #endif
 
+/* Set to 1 to have the port place a no access MPU region at the bottom of
+the stack of the running task, moved on every context switch.  An overflow
+then faults in MemManage_Handler() at the first access past the end of the
+stack, rather than being found at the next switch, and checking costs nothing
+but the store that moves the region. */
+#ifndef configUSE_MPU_STACK_GUARD
+	#define configUSE_MPU_STACK_GUARD 0
+#endif
+
+#if ( configUSE_MPU_STACK_GUARD == 1 ) && !defined( portSET_STACK_GUARD )
+	#error configUSE_MPU_STACK_GUARD is set to 1 but the port does not define portSET_STACK_GUARD().
+#endif
+
+#if ( configUSE_MPU_STACK_GUARD == 1 ) && ( configCHECK_FOR_STACK_OVERFLOW > 1 )
+	#error configCHECK_FOR_STACK_OVERFLOW method 2 reads the guard of the running task: use method 1 or none with configUSE_MPU_STACK_GUARD.
+#endif
+
 #ifndef configRECORD_STACK_HIGH_ADDRESS
 	#define configRECORD_STACK_HIGH_ADDRESS 0
 #endif
@@ -716,6 +824,14 @@ hold explicit before calling the code. */
 	#define configGENERATE_RUN_TIME_STATS 0
 #endif
 
+#ifndef configRUN_TIME_COUNTER_TYPE
+	/* Defaults to uint32_t for backward compatibility.  A fast run time
+	counter wraps a 32-bit total within a minute, so it can be set to uint64_t
+	in FreeRTOSConfig.h, provided portGET_RUN_TIME_COUNTER_VALUE() returns a
+	counter that is also extended to 64 bits. */
+	#define configRUN_TIME_COUNTER_TYPE uint32_t
+#endif
+
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 	#ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
@@ -742,6 +858,215 @@ hold explicit before calling the code. */
 	#define portPRIVILEGE_BIT ( ( UBaseType_t ) 0x00 )
 #endif
 
+#ifndef configUSE_TASK_FPU_DECLARATION
+	#define configUSE_TASK_FPU_DECLARATION 0
+#endif
+
+/* Set to 1, and set configEDF_PRIORITY, to schedule the tasks of that one
+priority earliest deadline first (vTaskSetDeadline()) instead of round robin. */
+#ifndef configUSE_EDF_SCHEDULING
+	#define configUSE_EDF_SCHEDULING 0
+#endif
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+	#ifndef configEDF_PRIORITY
+		#error configEDF_PRIORITY must be defined to the priority scheduled earliest deadline first
+	#endif
+
+	#if ( ( configEDF_PRIORITY ) < 1 ) || ( ( configEDF_PRIORITY ) >= ( configMAX_PRIORITIES ) )
+		#error configEDF_PRIORITY must be above the idle priority and below configMAX_PRIORITIES
+	#endif
+#endif
+
+/* Set to 1 to give each task its own round robin quantum, in ticks
+(vTaskSetTimeSlice()), instead of rotating equal priority tasks every tick. */
+#ifndef configUSE_TASK_TIME_SLICE_QUANTA
+	#define configUSE_TASK_TIME_SLICE_QUANTA 0
+#endif
+
+/* The quantum of a new task, in ticks. */
+#ifndef configTASK_TIME_SLICE_TICKS
+	#define configTASK_TIME_SLICE_TICKS 1
+#endif
+
+#if ( configUSE_TASK_TIME_SLICE_QUANTA == 1 ) && ( ( configTASK_TIME_SLICE_TICKS ) < 1 )
+	#error configTASK_TIME_SLICE_TICKS must be at least 1
+#endif
+
+/* Set to 1 to give tasks an execution time budget per period
+(vTaskSetBudget()).  The run time stats clock charges each task at every tick
+and context switch; one that uses up its budget is demoted, suspended or only
+reported until its next period starts. */
+#ifndef configUSE_TASK_BUDGETS
+	#define configUSE_TASK_BUDGETS 0
+#endif
+
+/* The priority eTaskBudgetDemote runs an overrunning task at. */
+#ifndef configTASK_BUDGET_BACKGROUND_PRIORITY
+	#define configTASK_BUDGET_BACKGROUND_PRIORITY 0
+#endif
+
+/* Set to 1 to have vApplicationTaskBudgetHook() called once per period in
+which a task overruns its budget, from the tick interrupt or the context
+switch. */
+#ifndef configUSE_TASK_BUDGET_HOOK
+	#define configUSE_TASK_BUDGET_HOOK 0
+#endif
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+	#if ( configGENERATE_RUN_TIME_STATS == 0 )
+		#error configUSE_TASK_BUDGETS needs configGENERATE_RUN_TIME_STATS, the clock the budgets are charged from
+	#endif
+
+	#if ( ( configTASK_BUDGET_BACKGROUND_PRIORITY ) >= ( configMAX_PRIORITIES ) )
+		#error configTASK_BUDGET_BACKGROUND_PRIORITY must be below configMAX_PRIORITIES
+	#endif
+#endif
+
+/* Set to 1 to time the jobs of each task (vTaskGetJobStats()).  A job is
+released when the task leaves the Blocked or Suspended state and ends when it
+is switched out after entering one of them again; the run time stats clock
+gives the time between releases and the run time of each job. */
+#ifndef configUSE_JOB_STATS
+	#define configUSE_JOB_STATS 0
+#endif
+
+#if ( configUSE_JOB_STATS == 1 ) && ( configGENERATE_RUN_TIME_STATS == 0 )
+	#error configUSE_JOB_STATS needs configGENERATE_RUN_TIME_STATS, the clock the jobs are timed with
+#endif
+
+/* Set to 1 to keep the task names in a hash table of configTASK_NAME_INDEX_SIZE
+slots, filled as tasks are created and emptied as they are deleted, so that
+xTaskGetHandle() finds a task in a short critical section instead of walking
+every task list with the scheduler suspended.  xTaskGetHandleByHash() takes a
+hash precomputed with taskNAME_HASH().  The size is a power of two, larger than
+the number of tasks that exist at once; tasks created while it is full are
+still found by xTaskGetHandle(), the slow way. */
+#ifndef configUSE_TASK_NAME_INDEX
+	#define configUSE_TASK_NAME_INDEX 0
+#endif
+
+#ifndef configTASK_NAME_INDEX_SIZE
+	#define configTASK_NAME_INDEX_SIZE 32
+#endif
+
+#if ( configUSE_TASK_NAME_INDEX == 1 )
+	#if ( INCLUDE_xTaskGetHandle == 0 )
+		#error configUSE_TASK_NAME_INDEX needs INCLUDE_xTaskGetHandle
+	#endif
+
+	#if ( ( configTASK_NAME_INDEX_SIZE ) < 2 ) || ( ( ( configTASK_NAME_INDEX_SIZE ) & ( ( configTASK_NAME_INDEX_SIZE ) - 1 ) ) != 0 )
+		#error configTASK_NAME_INDEX_SIZE must be a power of two, at least 2
+	#endif
+
+	#if ( configMAX_TASK_NAME_LEN > 33 )
+		#error configUSE_TASK_NAME_INDEX: taskNAME_HASH() hashes 32 characters at most
+	#endif
+#endif
+
+/* Set to 1 to count, per task, the context switches away from it that it
+asked for (it blocked, suspended itself or called taskYIELD()) and those it
+did not (preempted or out of time slice), with the total.  Read them with
+uxTaskGetSystemState() or vTaskGetInfo(). */
+#ifndef configUSE_SWITCH_STATS
+	#define configUSE_SWITCH_STATS 0
+#endif
+
+/* Set to 1 for read-copy-update style grace periods: each task records when
+it last left the Ready state, a point where it holds nothing it read before,
+and ulTaskGracePeriodStart() / xTaskGracePeriodElapsed() tell when every task
+has passed one. */
+#ifndef configUSE_QUIESCENT_STATES
+	#define configUSE_QUIESCENT_STATES 0
+#endif
+
+/* Set to 1 for preemption thresholds (vTaskPreemptionThresholdSet()): once a
+task runs, only a task with a priority above its threshold preempts it, and
+when that one is done the task gets the processor back before any other task
+up to its threshold.  Tasks that share a threshold never preempt one another. */
+#ifndef configUSE_PREEMPTION_THRESHOLD
+	#define configUSE_PREEMPTION_THRESHOLD 0
+#endif
+
+/* Set to 1 to measure every tick interrupt: how long it ran, how many tasks it
+unblocked and how late it was taken after the tick timer expired, as
+histograms.  Read them with vTaskGetTickStats().  The port must time the
+interrupt and pass the result to vTaskRecordTickStats(). */
+#ifndef configUSE_TICK_STATS
+	#define configUSE_TICK_STATS 0
+#endif
+
+#ifndef configTICK_STATS_BUCKETS
+	/* Buckets of each tick histogram: for the cycle counts, 0 then one bucket
+	per power of two; for the tasks unblocked, one bucket per count. */
+	#define configTICK_STATS_BUCKETS 16
+#endif
+
+#if( ( configUSE_TICK_STATS == 1 ) && ( configTICK_STATS_BUCKETS < 2 ) )
+	#error configTICK_STATS_BUCKETS must be at least 2
+#endif
+
+#ifndef portTASK_USES_FPU_BIT
+	#define portTASK_USES_FPU_BIT ( ( UBaseType_t ) 0x00 )
+#endif
+
+#if ( configUSE_TASK_FPU_DECLARATION == 1 ) && !defined( portTASK_HAS_FPU_CONTEXT )
+	#error configUSE_TASK_FPU_DECLARATION is set to 1 but the port does not define portTASK_HAS_FPU_CONTEXT().
+#endif
+
+/* Set to 1 to have xEventGroupSetBitsFromISR() and
+xEventGroupClearBitsFromISR() act on the event group directly instead of
+deferring to the timer service task. */
+#ifndef configUSE_EVENT_GROUPS_DIRECT_FROM_ISR
+	#define configUSE_EVENT_GROUPS_DIRECT_FROM_ISR 0
+#endif
+
+/* Set to 1 to keep active software timers in a hashed timing wheel of
+configTIMER_WHEEL_SLOTS lists instead of a list sorted by expiry time, making
+starting, resetting and stopping a timer O(1). */
+#ifndef configUSE_TIMER_WHEEL
+	#define configUSE_TIMER_WHEEL 0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOTS
+	#define configTIMER_WHEEL_SLOTS 64
+#endif
+
+/* The number of timer service tasks.  Each has its own command queue and active
+timers, and runs at its entry of configTIMER_DAEMON_PRIORITIES, an initialiser
+list such as { 2, 4 }.  A timer runs on daemon 0, the one that also executes
+pended function calls, until vTimerSetDaemon() moves it. */
+#ifndef configTIMER_DAEMONS
+	#define configTIMER_DAEMONS 1
+#endif
+
+#ifndef configTIMER_DAEMON_PRIORITIES
+	#define configTIMER_DAEMON_PRIORITIES { configTIMER_TASK_PRIORITY }
+#endif
+
+/* Set to 1 to count and time the callbacks of each timer service task, see
+vTimerGetDaemonStats(). */
+#ifndef configUSE_TIMER_DAEMON_STATS
+	#define configUSE_TIMER_DAEMON_STATS 0
+#endif
+
+/* Set to 1 to give each software timer a slack, see vTimerSetSlack(), so the
+timer service task merges nearby expiries into one wakeup. */
+#ifndef configUSE_TIMER_SLACK
+	#define configUSE_TIMER_SLACK 0
+#endif
+
+/* Set to 1 to keep delayed tasks in a hashed timing wheel of
+configDELAYED_TASK_WHEEL_SLOTS lists instead of a list sorted by wake time,
+making blocking with a timeout O(1) whatever the number of tasks. */
+#ifndef configUSE_DELAYED_TASK_WHEEL
+	#define configUSE_DELAYED_TASK_WHEEL 0
+#endif
+
+#ifndef configDELAYED_TASK_WHEEL_SLOTS
+	#define configDELAYED_TASK_WHEEL_SLOTS 64
+#endif
+
 #ifndef portYIELD_WITHIN_API
 	#define portYIELD_WITHIN_API portYIELD
 #endif
@@ -762,6 +1087,18 @@ hold explicit before calling the code. */
 	#define configUSE_TICKLESS_IDLE 0
 #endif
 
+/* Set to 1 to let the application slow the tick interrupt down at run time,
+see xPortSetTickRate().  configTICK_RATE_HZ remains the unit of every time in
+ticks, and the fastest rate; at a slower rate each interrupt advances the tick
+count by several ticks. */
+#ifndef configUSE_DYNAMIC_TICK_RATE
+	#define configUSE_DYNAMIC_TICK_RATE 0
+#endif
+
+#if( ( configUSE_DYNAMIC_TICK_RATE == 1 ) && ( configUSE_TICKLESS_IDLE != 0 ) )
+	#error configUSE_DYNAMIC_TICK_RATE cannot be used with configUSE_TICKLESS_IDLE, which sets the SysTick reload itself
+#endif
+
 #ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
 	#define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
 #endif
@@ -834,6 +1171,16 @@ hold explicit before calling the code. */
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
 
+/* Number of notifications, each with its own state and value, that each task
+has.  Index 0 is used by the API functions that do not take an index. */
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+	#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#endif
+
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES < 1
+	#error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
+#endif
+
 #ifndef configUSE_POSIX_ERRNO
 	#define configUSE_POSIX_ERRNO 0
 #endif
@@ -852,6 +1199,18 @@ hold explicit before calling the code. */
 	#define configSUPPORT_DYNAMIC_ALLOCATION 1
 #endif
 
+#ifndef configUSE_NEWLIB_MALLOC_HEAP
+	/* Set to 1 to have sysmem.c route newlib's malloc() family to
+	pvPortMalloc() and vPortFree(), so there is only one heap. */
+	#define configUSE_NEWLIB_MALLOC_HEAP 0
+#endif
+
+#ifndef configUSE_HAL_TIMEBASE_RTOS_TICK
+	/* Set to 1 to have stm32f4xx_hal_timebase_tim.c derive HAL_GetTick() from
+	the RTOS tick count instead of running a 1 kHz timer interrupt of its own. */
+	#define configUSE_HAL_TIMEBASE_RTOS_TICK 0
+#endif
+
 #ifndef configSTACK_DEPTH_TYPE
 	/* Defaults to uint16_t for backward compatibility, but can be overridden
 	in FreeRTOSConfig.h if uint16_t is too restrictive. */
@@ -865,6 +1224,252 @@ hold explicit before calling the code. */
 	#define configMESSAGE_BUFFER_LENGTH_TYPE size_t
 #endif
 
+#ifndef configUSE_QUEUE_REFERENCES
+	#define configUSE_QUEUE_REFERENCES 0
+#endif
+
+#ifndef configQUEUE_REFERENCE_OWNERSHIP_CHECK
+	#define configQUEUE_REFERENCE_OWNERSHIP_CHECK 0
+#endif
+
+#ifndef configUSE_QUEUE_BATCH
+	#define configUSE_QUEUE_BATCH 0
+#endif
+
+#ifndef configUSE_QUEUE_FAST_COPY
+	/* Items of 1, 2, 4 or 8 bytes are copied with loads and stores of that
+	size instead of a memcpy() of the run-time item size. */
+	#define configUSE_QUEUE_FAST_COPY 0
+#endif
+
+#ifndef configUSE_QUEUE_FAST_PATH
+	/* Send to and receive from a queue in one short critical section, without
+	the function calls of the full path, when there is room or an item and no
+	task to unblock. */
+	#define configUSE_QUEUE_FAST_PATH 0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_ZERO_COPY
+	/* Reserve/commit and peek/consume access to the storage of stream and
+	message buffers, so data is written and read in place. */
+	#define configUSE_STREAM_BUFFER_ZERO_COPY 0
+#endif
+
+#ifndef configSTREAM_BUFFER_COPY
+	/* Copies data into and out of the storage of stream and message buffers,
+	outside any critical section.  It can hand large copies to a DMA, but must
+	also work from an ISR and with the scheduler suspended. */
+	#define configSTREAM_BUFFER_COPY( pvDest, pvSrc, xLength ) ( void ) memcpy( ( pvDest ), ( pvSrc ), ( xLength ) )
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_MULTI_PRODUCER
+	/* xStreamBufferSendConcurrent(): any number of tasks and interrupts send
+	to one stream or message buffer, each reserving its bytes with an atomic
+	update and copying them in outside any critical section. */
+	#define configUSE_STREAM_BUFFER_MULTI_PRODUCER 0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_VECTORS
+	/* xStreamBufferSendV() and xStreamBufferReceiveV(): send fragments from
+	several places as one write, and receive into several places, without
+	copying them through a staging buffer first. */
+	#define configUSE_STREAM_BUFFER_VECTORS 0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_HOLD_TIME
+	/* A maximum hold time for stream buffers next to the trigger level, after
+	which the reader receives the bytes even below the trigger level (see
+	xStreamBufferSetHoldTime()). */
+	#define configUSE_STREAM_BUFFER_HOLD_TIME 0
+#endif
+
+#ifndef configUSE_MESSAGE_BUFFER_TIMESTAMPS
+	/* Stamps every message sent to a message buffer with the time it was
+	sent, which the reader can read back, and keeps a histogram of how long
+	the messages received were queued (see xMessageBufferGetLastTimestamp()).
+	Costs sizeof( MessageTimestamp_t ) bytes of storage per message. */
+	#define configUSE_MESSAGE_BUFFER_TIMESTAMPS 0
+#endif
+
+#ifndef configMESSAGE_BUFFER_TIMESTAMP
+	/* The time in microseconds, as a uint64_t, for message buffer timestamps.
+	Must be callable from tasks and ISRs.  The default only advances once per
+	tick, so a free-running microsecond counter resolves shorter delays. */
+	#define configMESSAGE_BUFFER_TIMESTAMP() ( ( uint64_t ) xTaskGetTickCountFromISR() * ( ( uint64_t ) 1000000 / ( uint64_t ) configTICK_RATE_HZ ) )
+#endif
+
+#ifndef configMESSAGE_BUFFER_DELAY_BUCKETS
+	/* Buckets of the queueing delay histogram of each message buffer: the
+	delays of 0, then one bucket per power of two microseconds. */
+	#define configMESSAGE_BUFFER_DELAY_BUCKETS 16
+#endif
+
+#ifndef configUSE_WAIT_ANY
+	/* Wait-any objects, which block a task until any of several queues,
+	semaphores or stream buffers is ready (see wait_any.h). */
+	#define configUSE_WAIT_ANY 0
+#endif
+
+#ifndef configWAIT_ANY_MAX_MEMBERS
+	#define configWAIT_ANY_MAX_MEMBERS 8
+#endif
+
+#ifndef configUSE_KEYED_QUEUES
+	/* Conflating queues that hold the newest item of each key (see
+	keyed_queue.h). */
+	#define configUSE_KEYED_QUEUES 0
+#endif
+
+#ifndef configUSE_TASK_ARENAS
+	/* Bump pointer arenas that can be attached to a task and are deleted with
+	it (see arena.h). */
+	#define configUSE_TASK_ARENAS 0
+#endif
+
+#ifndef configUSE_WIDE_EVENT_GROUPS
+	/* Event groups of 64 usable bits (see wide_event_groups.h). */
+	#define configUSE_WIDE_EVENT_GROUPS 0
+#endif
+
+#ifndef configUSE_NOTIFY_GROUPS
+	/* Notification groups, which notify all their member tasks in one
+	critical section with one yield decision (see notify_group.h). */
+	#define configUSE_NOTIFY_GROUPS 0
+#endif
+
+#ifndef configUSE_HEAP_SLABS
+	#define configUSE_HEAP_SLABS 0
+#endif
+
+#ifndef configHEAP_SLAB_OBJECTS_PER_SLAB
+	#define configHEAP_SLAB_OBJECTS_PER_SLAB 4
+#endif
+
+#ifndef configHEAP_TLSF_FL_MAX
+	/* heap_tlsf.c: blocks up to 2^( configHEAP_TLSF_FL_MAX + 1 ) - 1 bytes,
+	256 KB by default, more than the heap can hold on the STM32F446. */
+	#define configHEAP_TLSF_FL_MAX 17
+#endif
+
+#ifndef configHEAP_TLSF_SL_LOG2
+	/* heap_tlsf.c: each power of two is split into 2^configHEAP_TLSF_SL_LOG2
+	size classes. */
+	#define configHEAP_TLSF_SL_LOG2 3
+#endif
+
+#ifndef configUSE_KERNEL_RAM_FUNCTIONS
+	/* Run the context switch, tick, list and queue paths from SRAM, so they
+	never wait for flash.  Needs port support. */
+	#define configUSE_KERNEL_RAM_FUNCTIONS 0
+#endif
+
+#ifndef configHEAP_NOINIT
+	/* Leave the heap_4.c heap array out of .bss, so the startup code does not
+	clear it.  heap_4.c never reads memory it has not written, but memory from
+	pvPortMalloc() is then not zero, not even on the first allocation.  Needs
+	port support. */
+	#define configHEAP_NOINIT 0
+#endif
+
+#ifndef configUSE_MUTEX_FAST_PATH
+	/* Take and give uncontended mutexes with exclusive accesses on the holder
+	instead of a critical section.  Needs port support. */
+	#define configUSE_MUTEX_FAST_PATH 0
+#endif
+
+#ifndef configUSE_NOTIFY_GIVE_FAST_PATH
+	/* Give task notifications from interrupts with an exclusive access
+	increment, masking interrupts only to unblock a waiting task.  Needs port
+	support. */
+	#define configUSE_NOTIFY_GIVE_FAST_PATH 0
+#endif
+
+#ifndef configUSE_ATOMIC_EXCLUSIVE_ACCESS
+	/* Implement atomic.h with exclusive access loops instead of masking
+	interrupts, where the port provides them. */
+	#ifdef portSTORE_EXCLUSIVE
+		#define configUSE_ATOMIC_EXCLUSIVE_ACCESS 1
+	#else
+		#define configUSE_ATOMIC_EXCLUSIVE_ACCESS 0
+	#endif
+#endif
+
+#ifndef configUSE_MUTEX_PRIORITY_CEILING
+	/* Mutexes created with xSemaphoreCreateMutexWithCeiling() raise their
+	holder to a fixed ceiling priority instead of using priority inheritance. */
+	#define configUSE_MUTEX_PRIORITY_CEILING 0
+#endif
+
+#ifndef configUSE_QUEUE_METRICS
+	/* Each queue counts its sends, receives, blocks, timeouts and drops, for
+	vQueueGetMetrics() and uxQueueGetRegistryMetrics(). */
+	#define configUSE_QUEUE_METRICS 0
+#endif
+
+#ifndef configUSE_TASK_SNAPSHOTS
+	/* Keeps every task on one more list, in creation order, so that
+	uxTaskSnapshotNext() can collect the status of the tasks a few at a time
+	instead of all at once as uxTaskGetSystemState() does. */
+	#define configUSE_TASK_SNAPSHOTS 0
+#endif
+
+#if( ( configUSE_TASK_SNAPSHOTS == 1 ) && ( configUSE_TRACE_FACILITY != 1 ) )
+	#error configUSE_TRACE_FACILITY must be set to 1 to use task snapshots
+#endif
+
+#ifndef configUSE_TASK_REAPER
+	/* A task that deletes itself has its TCB and stack freed by a reaper task
+	as soon as it has switched out, instead of by the idle task, which may not
+	run for a long time under load. */
+	#define configUSE_TASK_REAPER 0
+#endif
+
+#ifndef configTASK_REAPER_PRIORITY
+	#define configTASK_REAPER_PRIORITY ( configMAX_PRIORITIES - 1 )
+#endif
+
+#ifndef configTASK_REAPER_STACK_DEPTH
+	#define configTASK_REAPER_STACK_DEPTH configMINIMAL_STACK_SIZE
+#endif
+
+#if( configUSE_TASK_REAPER == 1 )
+	#if( INCLUDE_vTaskDelete != 1 )
+		#error INCLUDE_vTaskDelete must be set to 1 to use the task reaper
+	#endif
+
+	#if( configUSE_TASK_NOTIFICATIONS != 1 )
+		#error configUSE_TASK_NOTIFICATIONS must be set to 1 to use the task reaper
+	#endif
+
+	#if( configTASK_REAPER_PRIORITY >= configMAX_PRIORITIES )
+		#error configTASK_REAPER_PRIORITY must be less than configMAX_PRIORITIES
+	#endif
+#endif
+
+#ifndef configUSE_IDLE_SLEEP
+	/* The idle task sleeps the CPU with portIDLE_SLEEP() at every iteration,
+	until the next interrupt, instead of spinning.  The tick keeps running, so
+	unlike tickless idle nothing has to be corrected on wake-up.  The port
+	times the wake-ups, see vTaskGetIdleSleepStats(). */
+	#define configUSE_IDLE_SLEEP 0
+#endif
+
+#if( configUSE_IDLE_SLEEP == 1 ) && !defined( portIDLE_SLEEP )
+	#error configUSE_IDLE_SLEEP is set to 1 but the port does not define portIDLE_SLEEP().
+#endif
+
+#ifndef configUSE_OBJECT_REGISTRY
+	/* Registered queues, semaphores, stream buffers and event groups are kept
+	in a hashed index without a size limit (registry.c), instead of the
+	configQUEUE_REGISTRY_SIZE array. */
+	#define configUSE_OBJECT_REGISTRY 0
+#endif
+
+#ifndef configOBJECT_REGISTRY_BUCKETS
+	/* Hash buckets of the object registry, a power of two up to 256. */
+	#define configOBJECT_REGISTRY_BUCKETS 32
+#endif
+
 /* Sanity check the configuration. */
 #if( configUSE_TICKLESS_IDLE != 0 )
 	#if( INCLUDE_vTaskSuspend != 1 )
@@ -876,10 +1481,67 @@ hold explicit before calling the code. */
 	#error configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION cannot both be 0, but can both be 1.
 #endif
 
+#if( ( configUSE_NEWLIB_MALLOC_HEAP == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) )
+	#error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to route newlib malloc() to the FreeRTOS heap
+#endif
+
+#if( ( configUSE_HAL_TIMEBASE_RTOS_TICK == 1 ) && ( INCLUDE_xTaskGetSchedulerState != 1 ) && ( configUSE_TIMERS != 1 ) )
+	#error INCLUDE_xTaskGetSchedulerState or configUSE_TIMERS must be set to 1 to derive the HAL timebase from the RTOS tick
+#endif
+
 #if( ( configUSE_RECURSIVE_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
 	#error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if( configUSE_NOTIFY_GIVE_FAST_PATH == 1 )
+	#if( configUSE_TASK_NOTIFICATIONS != 1 )
+		#error configUSE_TASK_NOTIFICATIONS must be set to 1 to use the notify give fast path
+	#endif
+	#ifndef portSTORE_EXCLUSIVE
+		#error configUSE_NOTIFY_GIVE_FAST_PATH is set to 1 but the port does not provide exclusive access macros
+	#endif
+#endif
+
+#if( configUSE_ATOMIC_EXCLUSIVE_ACCESS == 1 )
+	#ifndef portSTORE_EXCLUSIVE
+		#error configUSE_ATOMIC_EXCLUSIVE_ACCESS is set to 1 but the port does not provide exclusive access macros
+	#endif
+#endif
+
+#if( configUSE_MUTEX_FAST_PATH == 1 )
+	#if( configUSE_MUTEXES != 1 )
+		#error configUSE_MUTEXES must be set to 1 to use the mutex fast path
+	#endif
+	#ifndef portSTORE_EXCLUSIVE
+		#error configUSE_MUTEX_FAST_PATH is set to 1 but the port does not provide exclusive access macros
+	#endif
+#endif
+
+#if( ( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 ) && ( configMESSAGE_BUFFER_DELAY_BUCKETS < 2 ) )
+	#error configMESSAGE_BUFFER_DELAY_BUCKETS must be at least 2
+#endif
+
+#if( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MUTEXES must be set to 1 to use priority ceiling mutexes
+#endif
+
+#if( ( configUSE_OBJECT_REGISTRY == 1 ) && ( configQUEUE_REGISTRY_SIZE < 1 ) )
+	#error configQUEUE_REGISTRY_SIZE must be greater than 0 to use the object registry
+#endif
+
+#if( ( configHEAP_NOINIT == 1 ) && !defined( portNOINIT_DATA ) )
+	#error configHEAP_NOINIT is set to 1 but the port does not provide portNOINIT_DATA
+#endif
+
+#if( configUSE_KERNEL_RAM_FUNCTIONS == 1 )
+	#ifndef portRAM_FUNCTION
+		#error configUSE_KERNEL_RAM_FUNCTIONS is set to 1 but the port does not provide portRAM_FUNCTION
+	#endif
+	#define KERNEL_RAM_FUNCTION portRAM_FUNCTION
+#else
+	#define KERNEL_RAM_FUNCTION
+#endif
+
 #ifndef configINITIAL_TICK_COUNT
 	#define configINITIAL_TICK_COUNT 0
 #endif
@@ -1109,13 +1771,108 @@ typedef struct xSTATIC_LIST
  * are set.  Its contents are somewhat obfuscated in the hope users will
  * recognise that it would be unwise to make direct use of the structure members.
  */
+#if( configUSE_LEAN_TCB == 1 )
+
 typedef struct xSTATIC_TCB
 {
 	void				*pxDummy1;
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 		xMPU_SETTINGS	xDummy2;
 	#endif
-	StaticListItem_t	xDummy3[ 2 ];
+	#if ( configUSE_TASK_SNAPSHOTS == 1 )
+		StaticListItem_t	xDummy3[ 3 ];
+	#else
+		StaticListItem_t	xDummy3[ 2 ];
+	#endif
+	UBaseType_t			uxDummy5;
+	#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		configRUN_TIME_COUNTER_TYPE		ulDummy16;
+	#endif
+	#if ( configUSE_SWITCH_STATS == 1 )
+		uint32_t		ulDummy27[ 2 ];
+	#endif
+	#if ( configUSE_QUIESCENT_STATES == 1 )
+		uint32_t		ulDummy37;
+	#endif
+	#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+		UBaseType_t		uxDummy38;
+		void			*pxDummy39;
+	#endif
+	#if ( configUSE_TASK_TIME_SLICE_QUANTA == 1 )
+		TickType_t		xDummy25[ 2 ];
+	#endif
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xDummy24;
+	#endif
+	#if ( configUSE_POSIX_ERRNO == 1 )
+		int				iDummy22;
+	#endif
+	#if ( configUSE_MUTEXES == 1 )
+		UBaseType_t		uxDummy12[ 2 ];
+	#endif
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		uint32_t 		ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+	#endif
+	void				*pxDummy6;
+	const void			*pxDummy7;
+	#if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
+		void			*pxDummy8;
+	#endif
+	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+		UBaseType_t		uxDummy9;
+	#endif
+	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+		void			*pxDummy14;
+	#endif
+	#if( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
+		void			*pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
+	#endif
+	#if ( configUSE_TASK_ARENAS == 1 )
+		void			*pvDummy26;
+	#endif
+	#if ( configUSE_NEWLIB_REENTRANT == 1 )
+		struct	_reent	xDummy17;
+	#endif
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		uint8_t 		ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+	#endif
+	#if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
+		uint8_t			uxDummy20;
+	#endif
+	#if( INCLUDE_xTaskAbortDelay == 1 )
+		uint8_t ucDummy21;
+	#endif
+	#if ( configUSE_TASK_FPU_DECLARATION == 1 )
+		uint8_t			ucDummy23;
+	#endif
+	#if ( configUSE_TASK_BUDGETS == 1 )
+		StaticListItem_t	xDummy28;
+		configRUN_TIME_COUNTER_TYPE		ulDummy29[ 2 ];
+		TickType_t		xDummy30[ 2 ];
+		UBaseType_t		uxDummy31;
+		uint32_t		ulDummy32;
+		uint8_t			ucDummy33[ 2 ];
+	#endif
+	#if ( configUSE_JOB_STATS == 1 )
+		configRUN_TIME_COUNTER_TYPE		ulDummy34[ 6 ];
+		uint32_t		ulDummy35[ 2 ];
+		uint8_t			ucDummy36;
+	#endif
+} StaticTask_t;
+
+#else
+
+typedef struct xSTATIC_TCB
+{
+	void				*pxDummy1;
+	#if ( portUSING_MPU_WRAPPERS == 1 )
+		xMPU_SETTINGS	xDummy2;
+	#endif
+	#if ( configUSE_TASK_SNAPSHOTS == 1 )
+		StaticListItem_t	xDummy3[ 3 ];
+	#else
+		StaticListItem_t	xDummy3[ 2 ];
+	#endif
 	UBaseType_t			uxDummy5;
 	void				*pxDummy6;
 	uint8_t				ucDummy7[ configMAX_TASK_NAME_LEN ];
@@ -1138,14 +1895,24 @@ typedef struct xSTATIC_TCB
 		void			*pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
 	#endif
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulDummy16;
+		configRUN_TIME_COUNTER_TYPE		ulDummy16;
+	#endif
+	#if ( configUSE_SWITCH_STATS == 1 )
+		uint32_t		ulDummy27[ 2 ];
+	#endif
+	#if ( configUSE_QUIESCENT_STATES == 1 )
+		uint32_t		ulDummy37;
+	#endif
+	#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+		UBaseType_t		uxDummy38;
+		void			*pxDummy39;
 	#endif
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		struct	_reent	xDummy17;
 	#endif
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-		uint32_t 		ulDummy18;
-		uint8_t 		ucDummy19;
+		uint32_t 		ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		uint8_t 		ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 	#if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
 		uint8_t			uxDummy20;
@@ -1157,8 +1924,45 @@ typedef struct xSTATIC_TCB
 	#if ( configUSE_POSIX_ERRNO == 1 )
 		int				iDummy22;
 	#endif
+	#if ( configUSE_TASK_FPU_DECLARATION == 1 )
+		uint8_t			ucDummy23;
+	#endif
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xDummy24;
+	#endif
+	#if ( configUSE_TASK_TIME_SLICE_QUANTA == 1 )
+		TickType_t		xDummy25[ 2 ];
+	#endif
+	#if ( configUSE_TASK_ARENAS == 1 )
+		void			*pvDummy26;
+	#endif
+	#if ( configUSE_TASK_BUDGETS == 1 )
+		StaticListItem_t	xDummy28;
+		configRUN_TIME_COUNTER_TYPE		ulDummy29[ 2 ];
+		TickType_t		xDummy30[ 2 ];
+		UBaseType_t		uxDummy31;
+		uint32_t		ulDummy32;
+		uint8_t			ucDummy33[ 2 ];
+	#endif
+	#if ( configUSE_JOB_STATS == 1 )
+		configRUN_TIME_COUNTER_TYPE		ulDummy34[ 6 ];
+		uint32_t		ulDummy35[ 2 ];
+		uint8_t			ucDummy36;
+	#endif
 } StaticTask_t;
 
+#endif /* configUSE_LEAN_TCB */
+
+/* See the comments above the struct xSTATIC_LIST_ITEM definition.  Mirrors the
+RegistryItem_t held by the objects that can be registered (registry.h). */
+#if( configUSE_OBJECT_REGISTRY == 1 )
+	typedef struct xSTATIC_REGISTRY_ITEM
+	{
+		void *pvDummy1[ 4 ];
+		uint8_t ucDummy2[ 2 ];
+	} StaticRegistryItem_t;
+#endif
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -1183,6 +1987,10 @@ typedef struct xSTATIC_QUEUE
 		UBaseType_t uxDummy2;
 	} u;
 
+	#if( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+		UBaseType_t uxDummy11;
+	#endif
+
 	StaticList_t xDummy3[ 2 ];
 	UBaseType_t uxDummy4[ 3 ];
 	uint8_t ucDummy5[ 2 ];
@@ -1191,6 +1999,10 @@ typedef struct xSTATIC_QUEUE
 		uint8_t ucDummy6;
 	#endif
 
+	#if ( configUSE_QUEUE_FAST_COPY == 1 )
+		uint8_t ucDummy14;
+	#endif
+
 	#if ( configUSE_QUEUE_SETS == 1 )
 		void *pvDummy7;
 	#endif
@@ -1200,6 +2012,18 @@ typedef struct xSTATIC_QUEUE
 		uint8_t ucDummy9;
 	#endif
 
+	#if ( configUSE_WAIT_ANY == 1 )
+		void *pvDummy10;
+	#endif
+
+	#if ( configUSE_QUEUE_METRICS == 1 )
+		uint32_t ulDummy12[ 9 ];
+	#endif
+
+	#if ( configUSE_OBJECT_REGISTRY == 1 )
+		StaticRegistryItem_t xDummy13;
+	#endif
+
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1230,6 +2054,10 @@ typedef struct xSTATIC_EVENT_GROUP
 			uint8_t ucDummy4;
 	#endif
 
+	#if( configUSE_OBJECT_REGISTRY == 1 )
+		StaticRegistryItem_t xDummy5;
+	#endif
+
 } StaticEventGroup_t;
 
 /*
@@ -1251,12 +2079,16 @@ typedef struct xSTATIC_TIMER
 	void				*pvDummy1;
 	StaticListItem_t	xDummy2;
 	TickType_t			xDummy3;
+	#if( configUSE_TIMER_SLACK == 1 )
+		TickType_t		xDummy4;
+	#endif
 	void 				*pvDummy5;
 	TaskFunction_t		pvDummy6;
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t		uxDummy7;
 	#endif
 	uint8_t 			ucDummy8;
+	uint8_t				ucDummy9;
 
 } StaticTimer_t;
 
@@ -1282,6 +2114,22 @@ typedef struct xSTATIC_STREAM_BUFFER
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy4;
 	#endif
+	#if ( configUSE_WAIT_ANY == 1 )
+		void *pvDummy5;
+	#endif
+	#if ( configUSE_OBJECT_REGISTRY == 1 )
+		StaticRegistryItem_t xDummy6;
+	#endif
+	#if ( configUSE_STREAM_BUFFER_HOLD_TIME == 1 )
+		TickType_t xDummy7[ 2 ];
+	#endif
+	#if ( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+		uint64_t ullDummy8;
+		uint32_t ulDummy9[ 2 + configMESSAGE_BUFFER_DELAY_BUCKETS ];
+	#endif
+	#if ( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+		uint32_t ulDummy10[ 2 ];
+	#endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
@@ -0,0 +1,214 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Light semaphores are binary or counting semaphores that only one task, the
+ * owner, ever takes.  Instead of a queue object with event lists, a light
+ * semaphore is one entry of the owner's task notification array (see
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES): the notification value is the count,
+ * giving increments it, and taking decrements it, blocking the owner while it
+ * is zero.  The semaphore itself only records the owner, the notification
+ * index and the maximum count, and takes and gives are as fast as task
+ * notifications.
+ *
+ * ***NOTE***:  Any number of tasks and interrupts may give a light semaphore,
+ * but only its owner may take it.  A take by any other task fails
+ * configASSERT().  Use a semaphore created with xSemaphoreCreateBinary() or
+ * xSemaphoreCreateCounting() when more than one task needs to take it.
+ *
+ * The notification index belongs to the semaphore - the owner must not use it
+ * for anything else.  Index 0 (tskDEFAULT_INDEX_TO_NOTIFY) is also used by the
+ * task notification functions that do not take an index, and by stream
+ * buffers.
+ */
+
+#ifndef LIGHT_SEMAPHORE_H
+#define LIGHT_SEMAPHORE_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include light_semphr.h"
+#endif
+
+#include "task.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * The storage of a light semaphore, declared by the application and passed to
+ * xLightSemaphoreCreateBinaryStatic() or xLightSemaphoreCreateCountingStatic().
+ * Its members must not be accessed directly.
+ */
+typedef struct LightSemaphoreDef_t
+{
+	TaskHandle_t xOwner;
+	UBaseType_t uxIndex;
+	UBaseType_t uxMaxCount;
+} StaticLightSemaphore_t;
+
+/**
+ * Type by which light semaphores are referenced.
+ */
+typedef StaticLightSemaphore_t * LightSemaphoreHandle_t;
+
+/**
+ * light_semphr.h
+ *
+<pre>
+LightSemaphoreHandle_t xLightSemaphoreCreateCountingStatic( TaskHandle_t xOwner,
+                                                            UBaseType_t uxIndex,
+                                                            UBaseType_t uxMaxCount,
+                                                            UBaseType_t uxInitialCount,
+                                                            StaticLightSemaphore_t *pxSemaphoreBuffer );
+</pre>
+ *
+ * Creates a counting light semaphore in pxSemaphoreBuffer.  The owner's
+ * notification at uxIndex is reset to uxInitialCount.
+ *
+ * @param xOwner The only task that may take the semaphore.
+ *
+ * @param uxIndex The owner's notification index used by the semaphore, less
+ * than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
+ * @param uxMaxCount The count at which gives start failing.  At least 1.
+ *
+ * @param uxInitialCount The count the semaphore is created with.
+ *
+ * @param pxSemaphoreBuffer The storage of the semaphore.
+ *
+ * @return A handle to the semaphore.
+ *
+ * Example usage:
+<pre>
+StaticLightSemaphore_t xRxDoneBuffer;
+LightSemaphoreHandle_t xRxDone;
+
+void vSetup( TaskHandle_t xRxTask )
+{
+	// Index 1 of xRxTask's notifications counts up to 4 completed transfers.
+	xRxDone = xLightSemaphoreCreateCountingStatic( xRxTask, 1, 4, 0, &xRxDoneBuffer );
+}
+</pre>
+ * \defgroup xLightSemaphoreCreateCountingStatic xLightSemaphoreCreateCountingStatic
+ * \ingroup LightSemaphores
+ */
+LightSemaphoreHandle_t xLightSemaphoreCreateCountingStatic( TaskHandle_t xOwner, UBaseType_t uxIndex, UBaseType_t uxMaxCount, UBaseType_t uxInitialCount, StaticLightSemaphore_t *pxSemaphoreBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * light_semphr.h
+ *
+<pre>
+LightSemaphoreHandle_t xLightSemaphoreCreateBinaryStatic( TaskHandle_t xOwner,
+                                                          UBaseType_t uxIndex,
+                                                          StaticLightSemaphore_t *pxSemaphoreBuffer );
+</pre>
+ *
+ * Creates a binary light semaphore in pxSemaphoreBuffer.  Like a semaphore
+ * created with xSemaphoreCreateBinary(), it must be given before it can be
+ * taken.
+ *
+ * \defgroup xLightSemaphoreCreateBinaryStatic xLightSemaphoreCreateBinaryStatic
+ * \ingroup LightSemaphores
+ */
+#define xLightSemaphoreCreateBinaryStatic( xOwner, uxIndex, pxSemaphoreBuffer ) xLightSemaphoreCreateCountingStatic( ( xOwner ), ( uxIndex ), 1, 0, ( pxSemaphoreBuffer ) )
+
+/**
+ * light_semphr.h
+ *
+<pre>
+BaseType_t xLightSemaphoreTake( LightSemaphoreHandle_t xSemaphore, TickType_t xTicksToWait );
+</pre>
+ *
+ * Takes the semaphore, blocking for up to xTicksToWait while its count is
+ * zero.  Must only be called by the owner.
+ *
+ * @return pdTRUE if the semaphore was taken, pdFALSE if the block time
+ * expired first.
+ *
+ * \defgroup xLightSemaphoreTake xLightSemaphoreTake
+ * \ingroup LightSemaphores
+ */
+BaseType_t xLightSemaphoreTake( LightSemaphoreHandle_t xSemaphore, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * light_semphr.h
+ *
+<pre>
+BaseType_t xLightSemaphoreGive( LightSemaphoreHandle_t xSemaphore );
+</pre>
+ *
+ * Gives the semaphore, unblocking the owner if it is waiting.  Never blocks.
+ *
+ * @return pdTRUE if the semaphore was given, pdFALSE if its count was already
+ * at the maximum.
+ *
+ * \defgroup xLightSemaphoreGive xLightSemaphoreGive
+ * \ingroup LightSemaphores
+ */
+BaseType_t xLightSemaphoreGive( LightSemaphoreHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
+
+/**
+ * light_semphr.h
+ *
+<pre>
+BaseType_t xLightSemaphoreGiveFromISR( LightSemaphoreHandle_t xSemaphore, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xLightSemaphoreGive() that can be called from an ISR.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if giving the semaphore
+ * unblocked the owner and the owner has a priority above the interrupted task,
+ * in which case a context switch should be requested before the ISR exits.
+ *
+ * @return pdTRUE if the semaphore was given, pdFALSE if its count was already
+ * at the maximum.
+ *
+ * \defgroup xLightSemaphoreGiveFromISR xLightSemaphoreGiveFromISR
+ * \ingroup LightSemaphores
+ */
+BaseType_t xLightSemaphoreGiveFromISR( LightSemaphoreHandle_t xSemaphore, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * light_semphr.h
+ *
+<pre>
+UBaseType_t uxLightSemaphoreGetCount( LightSemaphoreHandle_t xSemaphore );
+</pre>
+ *
+ * @return The current count of the semaphore.
+ *
+ * \defgroup uxLightSemaphoreGetCount uxLightSemaphoreGetCount
+ * \ingroup LightSemaphores
+ */
+UBaseType_t uxLightSemaphoreGetCount( LightSemaphoreHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif	/* !defined( LIGHT_SEMAPHORE_H ) */
@@ -68,6 +68,50 @@ extern "C" {
 struct StreamBufferDef_t;
 typedef struct StreamBufferDef_t * StreamBufferHandle_t;
 
+#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+
+	/**
+	 * The time a message was sent to a message buffer, in microseconds, as
+	 * returned by configMESSAGE_BUFFER_TIMESTAMP().
+	 */
+	typedef uint64_t MessageTimestamp_t;
+
+	/**
+	 * How long the messages received from a message buffer were queued, from
+	 * their send to their receive.  See xMessageBufferGetDelayStats().
+	 */
+	typedef struct xSTREAM_BUFFER_DELAY_STATS
+	{
+		uint32_t ulMessages;		/* Messages received since the statistics were last reset. */
+		uint32_t ulMaxDelayUs;		/* The longest a message was queued. */
+		uint32_t ulDelayHistogram[ configMESSAGE_BUFFER_DELAY_BUCKETS ];	/* [ 0 ] counts delays of 0, [ n ] delays from 2^(n-1) to 2^n - 1 us, and the last bucket also the longer ones. */
+	} StreamBufferDelayStats_t;
+
+#endif /* configUSE_MESSAGE_BUFFER_TIMESTAMPS */
+
+#if( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+	/**
+	 * One fragment of the data sent by xStreamBufferSendV(), as a struct iovec
+	 * of POSIX writev().
+	 */
+	typedef struct xSTREAM_BUFFER_TX_VECTOR
+	{
+		const void *pvData;
+		size_t xLengthBytes;
+	} StreamBufferTxVector_t;
+
+	/**
+	 * One destination of the data received by xStreamBufferReceiveV().
+	 */
+	typedef struct xSTREAM_BUFFER_RX_VECTOR
+	{
+		void *pvData;
+		size_t xLengthBytes;
+	} StreamBufferRxVector_t;
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+
 
 /**
  * message_buffer.h
@@ -717,6 +761,55 @@ size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer );
  */
 size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+BaseType_t xStreamBufferSetHoldTime( StreamBufferHandle_t xStreamBuffer, TickType_t xHoldTicks );
+</pre>
+ *
+ * Sets the longest time bytes wait in the stream buffer for the trigger level
+ * to be reached.  A task blocked reading the stream buffer is unblocked when
+ * it holds at least the trigger level, or once its oldest byte has been in it
+ * for xHoldTicks, whichever comes first.  The pair works like Nagle's
+ * algorithm: under load the reader wakes once per trigger level worth of
+ * bytes, and when the writer goes quiet a few bytes still reach the reader
+ * within xHoldTicks instead of waiting for more to follow.
+ *
+ * The hold is timed by the reader's own block time, so it costs no timer.
+ * The write that puts the first bytes into an empty stream buffer wakes a
+ * reader that is blocked, for it to start timing the hold; while the reader
+ * is still busy with the previous bytes, as under load, no write wakes it
+ * before the trigger level.  The reader's xTicksToWait still bounds the whole
+ * receive, as without a hold time.
+ *
+ * configUSE_STREAM_BUFFER_HOLD_TIME must be set to 1.  Takes effect from the
+ * next receive.  Not for message buffers, whose every message unblocks the
+ * reader.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being updated.
+ *
+ * @param xHoldTicks The longest hold, in ticks.  0, the default, holds bytes
+ * until the trigger level is reached however long it takes.
+ *
+ * @return pdTRUE if the hold time was set, pdFALSE if xStreamBuffer is a
+ * message buffer.
+ *
+ * Example use:
+<pre>
+void vSetupTelemetryStream( StreamBufferHandle_t xStream )
+{
+    // Wake the uplink task for every 128 bytes, or 5 ms after the first byte
+    // of a smaller burst.
+    xStreamBufferSetTriggerLevel( xStream, 128 );
+    xStreamBufferSetHoldTime( xStream, pdMS_TO_TICKS( 5 ) );
+}
+</pre>
+ * \defgroup xStreamBufferSetHoldTime xStreamBufferSetHoldTime
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferSetHoldTime( StreamBufferHandle_t xStreamBuffer, TickType_t xHoldTicks ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -833,6 +926,421 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
  */
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+							 void **ppvData,
+							 size_t xLengthBytes,
+							 TickType_t xTicksToWait );
+</pre>
+ *
+ * Zero-copy send, first half.  Returns a pointer into the stream buffer's own
+ * storage area where up to xLengthBytes can be written in place, for example
+ * by a DMA transfer or a peripheral handler, instead of being copied in by
+ * xStreamBufferSend().  Nothing is visible to the reader until
+ * xStreamBufferCommit() or xStreamBufferCommitFromISR() is called.
+ *
+ * The reserved region never wraps.  On a stream buffer it ends at the end of
+ * the storage area, so fewer bytes than requested may be reserved even when
+ * more are free: commit them and reserve again for the rest, which then
+ * starts at the beginning of the storage area.  On a message buffer the whole
+ * message is reserved or nothing is, and a message that would wrap is not
+ * reserved; use xMessageBufferSend() for it instead.
+ *
+ * Only the single writer may reserve, and it must commit before it reserves
+ * or sends again.  configUSE_STREAM_BUFFER_ZERO_COPY must be set to 1.  May
+ * be called from an interrupt service routine if xTicksToWait is 0.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param ppvData Set to the start of the reserved region, or NULL if 0 is
+ * returned.
+ *
+ * @param xLengthBytes The number of bytes wanted, not 0.
+ *
+ * @param xTicksToWait The maximum time to block waiting for xLengthBytes of
+ * free space (plus the length of a message), as xStreamBufferSend() does.
+ *
+ * @return The number of bytes reserved, 0 if none.
+ *
+ * Example use:
+<pre>
+void vAdcComplete( const uint16_t *pusSamples, size_t xBytes )
+{
+void *pvDestination;
+size_t xReserved;
+
+	while( xBytes > 0 )
+	{
+		xReserved = xStreamBufferReserve( xStreamBuffer, &pvDestination, xBytes, 0 );
+		if( xReserved == 0 )
+		{
+			break;
+		}
+
+		vConvertSamples( pvDestination, pusSamples, xReserved );
+		xStreamBufferCommit( xStreamBuffer, xReserved );
+
+		pusSamples += xReserved / sizeof( uint16_t );
+		xBytes -= xReserved;
+	}
+}
+</pre>
+ * \defgroup xStreamBufferReserve xStreamBufferReserve
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+							 void **ppvData,
+							 size_t xLengthBytes,
+							 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer, size_t xLengthBytes );
+size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+								   size_t xLengthBytes,
+								   BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Zero-copy send, second half.  Makes the first xLengthBytes of the region
+ * returned by xStreamBufferReserve() available to the reader, and unblocks
+ * the reader as xStreamBufferSend() would.  On a message buffer they become
+ * one message.  Committing 0 bytes abandons the reservation.
+ * configUSE_STREAM_BUFFER_ZERO_COPY must be set to 1.
+ *
+ * @param xStreamBuffer The handle of the stream buffer written to.
+ *
+ * @param xLengthBytes The number of bytes written, no more than were
+ * reserved.
+ *
+ * @param pxHigherPriorityTaskWoken (FromISR version only) Set to pdTRUE if
+ * the reader was unblocked and has a priority above the interrupted task.
+ *
+ * @return xLengthBytes.
+ *
+ * \defgroup xStreamBufferCommit xStreamBufferCommit
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer, size_t xLengthBytes ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+								   size_t xLengthBytes,
+								   BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferPeek( StreamBufferHandle_t xStreamBuffer,
+						  const void **ppvData,
+						  TickType_t xTicksToWait );
+</pre>
+ *
+ * Zero-copy receive, first half.  Returns a pointer to the oldest data inside
+ * the stream buffer's storage area so it can be parsed, logged or handed to a
+ * DMA transfer in place instead of being copied out by xStreamBufferReceive().
+ * The data stays in the buffer until xStreamBufferConsume() or
+ * xStreamBufferConsumeFromISR() is called.
+ *
+ * On a stream buffer the region ends at the end of the storage area, so fewer
+ * bytes than are available may be returned: consume them and peek again for
+ * the rest.  On a message buffer the length of the next message is returned.
+ * If that message wraps, which only a message sent with xMessageBufferSend()
+ * can, *ppvData is NULL and the message must be received with
+ * xMessageBufferReceive() (or dropped by consuming it).
+ *
+ * Only the single reader may peek.  configUSE_STREAM_BUFFER_ZERO_COPY must be
+ * set to 1.  May be called from an interrupt service routine if xTicksToWait
+ * is 0.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param ppvData Set to the start of the data, or NULL (see above).
+ *
+ * @param xTicksToWait The maximum time to block waiting for data, as
+ * xStreamBufferReceive() does.
+ *
+ * @return The number of bytes that can be read at *ppvData (stream buffer),
+ * or the length of the next message (message buffer).  0 if the buffer is
+ * empty.
+ *
+ * Example use:
+<pre>
+void vParserTask( void *pvParameters )
+{
+const void *pvData;
+size_t xLength;
+
+	for( ;; )
+	{
+		xLength = xStreamBufferPeek( xStreamBuffer, &pvData, portMAX_DELAY );
+		if( xLength > 0 )
+		{
+			vParse( pvData, xLength );
+			xStreamBufferConsume( xStreamBuffer, xLength );
+		}
+	}
+}
+</pre>
+ * \defgroup xStreamBufferPeek xStreamBufferPeek
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferPeek( StreamBufferHandle_t xStreamBuffer,
+						  const void **ppvData,
+						  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer, size_t xLengthBytes );
+size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+									size_t xLengthBytes,
+									BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Zero-copy receive, second half.  Removes the first xLengthBytes returned by
+ * xStreamBufferPeek(), and unblocks a writer waiting for space as
+ * xStreamBufferReceive() would.  On a message buffer xLengthBytes must be the
+ * length of the next message, which is removed whole.  Consuming 0 bytes
+ * leaves the data in the buffer.  configUSE_STREAM_BUFFER_ZERO_COPY must be
+ * set to 1.
+ *
+ * @param xStreamBuffer The handle of the stream buffer read from.
+ *
+ * @param xLengthBytes The number of bytes no longer needed.
+ *
+ * @param pxHigherPriorityTaskWoken (FromISR version only) Set to pdTRUE if
+ * the writer was unblocked and has a priority above the interrupted task.
+ *
+ * @return xLengthBytes.
+ *
+ * \defgroup xStreamBufferConsume xStreamBufferConsume
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer, size_t xLengthBytes ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+									size_t xLengthBytes,
+									BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferSendConcurrent( StreamBufferHandle_t xStreamBuffer,
+									const void *pvTxData,
+									size_t xDataLengthBytes );
+size_t xStreamBufferSendConcurrentFromISR( StreamBufferHandle_t xStreamBuffer,
+										   const void *pvTxData,
+										   size_t xDataLengthBytes,
+										   BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Sends to a stream buffer that has several writers, with no mutex around the
+ * sends.  Any number of tasks and interrupts may call them at the same time,
+ * while the single reader receives as usual.
+ *
+ * Each send reserves its bytes by moving a reservation index with a compare
+ * and swap (atomic.h), then copies them in while other sends copy theirs.
+ * The last send to finish moves the head over the bytes of all of them, so
+ * the reader only sees bytes that are written, in the order they were
+ * reserved.  The bytes of one send are never split by another.
+ *
+ * The sends never block: as xStreamBufferSendFromISR(), a stream buffer takes
+ * as many bytes as fit, and a message buffer the whole message or nothing.
+ * A buffer written with these functions must not also be written with
+ * xStreamBufferSend(), xStreamBufferSendFromISR() or xStreamBufferReserve().
+ * They do not start a hold time.  configUSE_STREAM_BUFFER_MULTI_PRODUCER must
+ * be set to 1.
+ *
+ * A send preempted between its reservation and its return delays the bytes
+ * reserved after it, until it returns.  It does not hold up the other
+ * writers.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param pvTxData The data to copy in.
+ *
+ * @param xDataLengthBytes The number of bytes to send.
+ *
+ * @param pxHigherPriorityTaskWoken (FromISR version only) Set to pdTRUE if
+ * the reader was unblocked and has a priority above the interrupted task.
+ *
+ * @return The number of bytes sent.
+ *
+ * Example use:
+<pre>
+void vLog( const char *pcLine )
+{
+	// From any task, with no mutex.
+	xStreamBufferSendConcurrent( xLogStream, pcLine, strlen( pcLine ) );
+}
+
+void vUartErrorHandler( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	xStreamBufferSendConcurrentFromISR( xLogStream, "uart: overrun\r\n", 15, &xHigherPriorityTaskWoken );
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+</pre>
+ * \defgroup xStreamBufferSendConcurrent xStreamBufferSendConcurrent
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendConcurrent( StreamBufferHandle_t xStreamBuffer,
+									const void *pvTxData,
+									size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferSendConcurrentFromISR( StreamBufferHandle_t xStreamBuffer,
+										   const void *pvTxData,
+										   size_t xDataLengthBytes,
+										   BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+						   const StreamBufferTxVector_t *pxVectors,
+						   UBaseType_t uxVectorCount,
+						   TickType_t xTicksToWait );
+size_t xStreamBufferSendVFromISR( StreamBufferHandle_t xStreamBuffer,
+								  const StreamBufferTxVector_t *pxVectors,
+								  UBaseType_t uxVectorCount,
+								  BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Gathered send: as xStreamBufferSend() and xStreamBufferSendFromISR() of the
+ * uxVectorCount fragments one after the other, copied straight from where
+ * they are into the buffer.  The reader sees all the bytes sent at once, as
+ * the head only moves after the last fragment.  On a message buffer the
+ * fragments make one message, of their total length, sent whole or not at
+ * all: a header and a payload need neither a staging copy nor two messages.
+ * A stream buffer takes as many bytes as fit, from the first fragment on.
+ * Fragments of 0 bytes are skipped.  configUSE_STREAM_BUFFER_VECTORS must be
+ * set to 1.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param pxVectors The fragments, in the order they are sent.
+ *
+ * @param uxVectorCount The number of fragments.
+ *
+ * @param xTicksToWait (task version only) The longest to wait for space for
+ * all the fragments, as with xStreamBufferSend().
+ *
+ * @param pxHigherPriorityTaskWoken (FromISR version only) Set to pdTRUE if
+ * the reader was unblocked and has a priority above the interrupted task.
+ *
+ * @return The number of bytes sent, 0 if there was no space.
+ *
+ * Example use:
+<pre>
+void vSendPacket( uint8_t ucType, const uint8_t *pucPayload, size_t xLength )
+{
+StreamBufferTxVector_t xVectors[ 2 ];
+
+	xVectors[ 0 ].pvData = &ucType;
+	xVectors[ 0 ].xLengthBytes = sizeof( ucType );
+	xVectors[ 1 ].pvData = pucPayload;
+	xVectors[ 1 ].xLengthBytes = xLength;
+
+	// One message of 1 + xLength bytes.
+	xMessageBufferSendV( xPackets, xVectors, 2, portMAX_DELAY );
+}
+</pre>
+ * \defgroup xStreamBufferSendV xStreamBufferSendV
+ * \ingroup StreamBufferManagement
+ */
+#if( configUSE_STREAM_BUFFER_VECTORS == 1 )
+	size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+							   const StreamBufferTxVector_t *pxVectors,
+							   UBaseType_t uxVectorCount,
+							   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+	size_t xStreamBufferSendVFromISR( StreamBufferHandle_t xStreamBuffer,
+									  const StreamBufferTxVector_t *pxVectors,
+									  UBaseType_t uxVectorCount,
+									  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReceiveV( StreamBufferHandle_t xStreamBuffer,
+							  const StreamBufferRxVector_t *pxVectors,
+							  UBaseType_t uxVectorCount,
+							  TickType_t xTicksToWait );
+size_t xStreamBufferReceiveVFromISR( StreamBufferHandle_t xStreamBuffer,
+									 const StreamBufferRxVector_t *pxVectors,
+									 UBaseType_t uxVectorCount,
+									 BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Scattered receive: as xStreamBufferReceive() and
+ * xStreamBufferReceiveFromISR() into a buffer as long as all the
+ * destinations together, each filled in turn before the next.  A message that
+ * does not fit in them all is left in the message buffer and 0 is returned,
+ * and the last destinations are left untouched if the message is shorter.
+ * configUSE_STREAM_BUFFER_VECTORS must be set to 1.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param pxVectors The destinations, in the order they are filled.
+ *
+ * @param uxVectorCount The number of destinations.
+ *
+ * @param xTicksToWait (task version only) The longest to wait for data, as
+ * with xStreamBufferReceive().
+ *
+ * @param pxHigherPriorityTaskWoken (FromISR version only) Set to pdTRUE if
+ * the writer was unblocked and has a priority above the interrupted task.
+ *
+ * @return The number of bytes received.
+ *
+ * \defgroup xStreamBufferReceiveV xStreamBufferReceiveV
+ * \ingroup StreamBufferManagement
+ */
+#if( configUSE_STREAM_BUFFER_VECTORS == 1 )
+	size_t xStreamBufferReceiveV( StreamBufferHandle_t xStreamBuffer,
+								  const StreamBufferRxVector_t *pxVectors,
+								  UBaseType_t uxVectorCount,
+								  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+	size_t xStreamBufferReceiveVFromISR( StreamBufferHandle_t xStreamBuffer,
+										 const StreamBufferRxVector_t *pxVectors,
+										 UBaseType_t uxVectorCount,
+										 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+void vStreamBufferAddToRegistry( StreamBufferHandle_t xStreamBuffer, const char *pcName );
+void vStreamBufferUnregister( StreamBufferHandle_t xStreamBuffer );
+const char *pcStreamBufferGetName( StreamBufferHandle_t xStreamBuffer );
+StreamBufferHandle_t xStreamBufferFindByName( const char *pcName );
+</pre>
+ *
+ * Gives a stream buffer a name in the object registry, removes it, reads the
+ * name of a stream buffer (NULL if it is not registered) and finds a stream
+ * buffer by its name (NULL if there is none).  Adding a registered stream
+ * buffer renames it, and vStreamBufferDelete() removes it.  The name is only
+ * pointed to, so it must be persistent.  Not to be called from interrupts.
+ * configUSE_OBJECT_REGISTRY must be set to 1.
+ *
+ * \defgroup vStreamBufferAddToRegistry vStreamBufferAddToRegistry
+ * \ingroup StreamBufferManagement
+ */
+#if( configUSE_OBJECT_REGISTRY == 1 )
+	void vStreamBufferAddToRegistry( StreamBufferHandle_t xStreamBuffer, const char *pcName ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	void vStreamBufferUnregister( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+	const char *pcStreamBufferGetName( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	StreamBufferHandle_t xStreamBufferFindByName( const char *pcName ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+#endif
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
 												 size_t xTriggerLevelBytes,
@@ -846,6 +1354,12 @@ StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
 
 size_t xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+	MessageTimestamp_t xStreamBufferGetLastTimestamp( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+	void vStreamBufferGetDelayStats( StreamBufferHandle_t xStreamBuffer, StreamBufferDelayStats_t *pxStats ) PRIVILEGED_FUNCTION;
+	void vStreamBufferResetDelayStats( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 #if( configUSE_TRACE_FACILITY == 1 )
 	void vStreamBufferSetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer, UBaseType_t uxStreamBufferNumber ) PRIVILEGED_FUNCTION;
 	UBaseType_t uxStreamBufferGetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
@@ -0,0 +1,252 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "keyed_queue.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+to include keyed queue functionality. */
+#if( configUSE_KEYED_QUEUES == 1 )
+
+#if( configUSE_COUNTING_SEMAPHORES != 1 )
+	#error configUSE_COUNTING_SEMAPHORES must be set to 1 to use keyed queues
+#endif
+
+#if( configSUPPORT_STATIC_ALLOCATION != 1 )
+	#error configSUPPORT_STATIC_ALLOCATION must be set to 1 to use keyed queues
+#endif
+
+/* Link values other than a key.  The pending keys form a singly linked list
+from ucHead to ucTail through pucLinks. */
+#define keyedqueueNOT_PENDING		( ( uint8_t ) 0xFF )
+#define keyedqueueEND				( ( uint8_t ) 0xFE )
+
+/*
+ * Stores an item and appends its key to the pending list, if it is not on
+ * it.  Called in a critical section.  Returns pdTRUE if the key was appended.
+ */
+static BaseType_t prvStoreItem( KeyedQueueHandle_t xKeyedQueue, UBaseType_t uxKey, const void *pvItem ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+KeyedQueueHandle_t xKeyedQueueCreateStatic( UBaseType_t uxKeys, UBaseType_t uxItemSize, uint8_t *pucStorage, StaticKeyedQueue_t *pxKeyedQueueBuffer )
+{
+UBaseType_t uxKey;
+
+	configASSERT( pxKeyedQueueBuffer );
+	configASSERT( pucStorage );
+	configASSERT( ( uxKeys > ( UBaseType_t ) 0 ) && ( uxKeys <= keyedqueueMAX_KEYS ) );
+	configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+	pxKeyedQueueBuffer->pucLinks = pucStorage;
+	pxKeyedQueueBuffer->pucItems = &( pucStorage[ uxKeys ] );
+	pxKeyedQueueBuffer->uxKeys = uxKeys;
+	pxKeyedQueueBuffer->uxItemSize = uxItemSize;
+	pxKeyedQueueBuffer->ucHead = keyedqueueEND;
+	pxKeyedQueueBuffer->ucTail = keyedqueueEND;
+	pxKeyedQueueBuffer->uxWaiting = ( UBaseType_t ) 0;
+	pxKeyedQueueBuffer->uxConflated = ( UBaseType_t ) 0;
+
+	for( uxKey = 0; uxKey < uxKeys; uxKey++ )
+	{
+		pxKeyedQueueBuffer->pucLinks[ uxKey ] = keyedqueueNOT_PENDING;
+	}
+
+	pxKeyedQueueBuffer->xPending = xSemaphoreCreateCountingStatic( uxKeys, ( UBaseType_t ) 0, &( pxKeyedQueueBuffer->xPendingBuffer ) );
+
+	return pxKeyedQueueBuffer;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvStoreItem( KeyedQueueHandle_t xKeyedQueue, UBaseType_t uxKey, const void *pvItem )
+{
+	( void ) memcpy( ( void * ) &( xKeyedQueue->pucItems[ uxKey * xKeyedQueue->uxItemSize ] ), pvItem, ( size_t ) xKeyedQueue->uxItemSize ); /*lint !e9087 !e418 MISRA exception as the casts are only redundant for some ports. */
+
+	if( xKeyedQueue->pucLinks[ uxKey ] != keyedqueueNOT_PENDING )
+	{
+		/* Overwritten in place: the key keeps its place in the list. */
+		( xKeyedQueue->uxConflated )++;
+		return pdFALSE;
+	}
+
+	xKeyedQueue->pucLinks[ uxKey ] = keyedqueueEND;
+
+	if( xKeyedQueue->ucTail == keyedqueueEND )
+	{
+		xKeyedQueue->ucHead = ( uint8_t ) uxKey;
+	}
+	else
+	{
+		xKeyedQueue->pucLinks[ xKeyedQueue->ucTail ] = ( uint8_t ) uxKey;
+	}
+
+	xKeyedQueue->ucTail = ( uint8_t ) uxKey;
+	( xKeyedQueue->uxWaiting )++;
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xKeyedQueueSend( KeyedQueueHandle_t xKeyedQueue, UBaseType_t uxKey, const void *pvItem )
+{
+BaseType_t xAppended;
+
+	configASSERT( xKeyedQueue );
+	configASSERT( uxKey < xKeyedQueue->uxKeys );
+	configASSERT( pvItem );
+
+	taskENTER_CRITICAL();
+	{
+		xAppended = prvStoreItem( xKeyedQueue, uxKey, pvItem );
+	}
+	taskEXIT_CRITICAL();
+
+	/* The semaphore is given after the key is on the list, so a receiver that
+	takes it always finds a key to remove. */
+	if( xAppended != pdFALSE )
+	{
+		( void ) xSemaphoreGive( xKeyedQueue->xPending );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xAppended;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xKeyedQueueSendFromISR( KeyedQueueHandle_t xKeyedQueue, UBaseType_t uxKey, const void *pvItem, BaseType_t *pxHigherPriorityTaskWoken )
+{
+BaseType_t xAppended;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( xKeyedQueue );
+	configASSERT( uxKey < xKeyedQueue->uxKeys );
+	configASSERT( pvItem );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		xAppended = prvStoreItem( xKeyedQueue, uxKey, pvItem );
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	if( xAppended != pdFALSE )
+	{
+		( void ) xSemaphoreGiveFromISR( xKeyedQueue->xPending, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xAppended;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xKeyedQueueReceive( KeyedQueueHandle_t xKeyedQueue, UBaseType_t *puxKey, void *pvItem, TickType_t xTicksToWait )
+{
+UBaseType_t uxKey;
+
+	configASSERT( xKeyedQueue );
+	configASSERT( pvItem );
+
+	/* Each count is one key on the list, reserved for this receiver. */
+	if( xSemaphoreTake( xKeyedQueue->xPending, xTicksToWait ) == pdFALSE )
+	{
+		return pdFALSE;
+	}
+
+	taskENTER_CRITICAL();
+	{
+		uxKey = ( UBaseType_t ) xKeyedQueue->ucHead;
+		configASSERT( uxKey < xKeyedQueue->uxKeys );
+
+		xKeyedQueue->ucHead = xKeyedQueue->pucLinks[ uxKey ];
+
+		if( xKeyedQueue->ucHead == keyedqueueEND )
+		{
+			xKeyedQueue->ucTail = keyedqueueEND;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xKeyedQueue->pucLinks[ uxKey ] = keyedqueueNOT_PENDING;
+		( xKeyedQueue->uxWaiting )--;
+
+		( void ) memcpy( pvItem, ( void * ) &( xKeyedQueue->pucItems[ uxKey * xKeyedQueue->uxItemSize ] ), ( size_t ) xKeyedQueue->uxItemSize ); /*lint !e9087 !e418 MISRA exception as the casts are only redundant for some ports. */
+	}
+	taskEXIT_CRITICAL();
+
+	if( puxKey != NULL )
+	{
+		*puxKey = uxKey;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxKeyedQueueMessagesWaiting( KeyedQueueHandle_t xKeyedQueue )
+{
+	configASSERT( xKeyedQueue );
+
+	return xKeyedQueue->uxWaiting;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxKeyedQueueGetConflatedCount( KeyedQueueHandle_t xKeyedQueue )
+{
+	configASSERT( xKeyedQueue );
+
+	return xKeyedQueue->uxConflated;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_KEYED_QUEUES */
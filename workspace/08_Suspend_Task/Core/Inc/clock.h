@@ -0,0 +1,42 @@
+/*******************************************************************************
+ *
+ * @file	clock.h
+ * @brief	Interface of the system clock profiles.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+
+/* Data types ----------------------------------------------------------------*/
+typedef enum
+{
+	CLOCK_PROFILE_LOW_POWER = 0,	/* HSI,  84 MHz, scale 3, 2 wait states. */
+	CLOCK_PROFILE_BALANCED,			/* HSE, 168 MHz, scale 1, 5 wait states. */
+	CLOCK_PROFILE_MAX_PERFORMANCE,	/* HSE, 180 MHz, scale 1 + over-drive, 5 wait states. */
+	CLOCK_PROFILE_COUNT
+} ClockProfile_t;
+
+/* Macros --------------------------------------------------------------------*/
+
+/* Profile applied by SystemClock_Config(). The examples keep 84 MHz, as their
+ * busy-wait delays are tuned for it. */
+#ifndef CLOCK_PROFILE_DEFAULT
+#define CLOCK_PROFILE_DEFAULT CLOCK_PROFILE_LOW_POWER
+#endif
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t clock_set_profile(ClockProfile_t eProfile);
+ClockProfile_t clock_get_profile(void);
+uint32_t clock_get_profile_hz(ClockProfile_t eProfile);
+void clock_resume_from_stop(void);
+void clock_profile_changed_callback(ClockProfile_t eProfile);
+int32_t clock_uart_retune(USART_TypeDef *pxUart);
+
+#endif /* CLOCK_H */
@@ -5,6 +5,9 @@
  * 			FreeRTOS application.
  * @author	Kyungjae Lee
  * @date	Jun 7, 2025
+ * @note	With TASK_GROUPS set, the red and blue tasks form a group that is
+ * 			suspended and resumed as a unit by vTaskSuspendGroup() and
+ * 			vTaskResumeGroup().
  *
  ******************************************************************************/
 
@@ -12,8 +15,12 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
 
+/* Macros --------------------------------------------------------------------*/
+#define TASK_GROUPS 1	/* 0: suspend and resume the red task alone, 1: the red and blue tasks as a group */
+
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
@@ -40,6 +47,9 @@ uint32_t uBlueTaskPriority;
 uint32_t uSuspendMonitor;
 uint32_t uResumeMonitor;
 bool bRedTaskSuspended = false;
+#if (TASK_GROUPS == 1)
+TaskHandle_t xLedGroup[2];
+#endif
 
 /**
  * @brief The application entry point.
@@ -78,6 +88,11 @@ int main(void)
 				1,		/* Initially the highest priority. */
 				&xBlueTaskHandle);
 
+#if (TASK_GROUPS == 1)
+	xLedGroup[0] = xRedTaskHandle;
+	xLedGroup[1] = xBlueTaskHandle;
+#endif
+
 	vTaskStartScheduler();
 
 	/* We should never get here as control is now taken by the scheduler */
@@ -111,7 +126,11 @@ void vGreenLedControllerTask(void *pvParameters)
 
 			if (uResumeMonitor >= 30)
 			{
+#if (TASK_GROUPS == 1)
+				vTaskResumeGroup(xLedGroup, 2);
+#else
 				vTaskResume(xRedTaskHandle);
+#endif
 				uResumeMonitor = 0;
 				bRedTaskSuspended = false;
 			}
@@ -140,7 +159,13 @@ void vRedLedControllerTask(void *pvParameters)
 		{
 			bRedTaskSuspended = true;
 			uSuspendMonitor = 0;
+#if (TASK_GROUPS == 1)
+			/* The group includes this task, which stops once the blue task
+			 * is suspended too. */
+			vTaskSuspendGroup(xLedGroup, 2);
+#else
 			vTaskSuspend(NULL);
+#endif
 		}
 	}
 }
@@ -176,44 +201,9 @@ int __io_putchar(int ch)
  */
 void SystemClock_Config(void)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
-
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-	{
-		Error_Handler();
-	}
-
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
@@ -125,6 +125,7 @@ to exclude the API function. */
  * by the application thus the correct define need to be enabled below
  */
 #define USE_FreeRTOS_HEAP_4
+/* #define USE_FreeRTOS_HEAP_TLSF */	/* Instead of HEAP_4: heap_tlsf.c, O(1) malloc and free */
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -168,6 +169,28 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Port optimised task selection: the CM4F port finds the highest ready
+priority with CLZ on a ready-priority bitmap instead of walking the ready
+lists.  The 56 CMSIS-RTOS2 priorities take a two-level bitmap, so selection is
+two CLZs whatever the priorities in use (see README, Task Selection). */
+#undef configUSE_PORT_OPTIMISED_TASK_SELECTION
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
+/* Tasks are created and deleted at run time, so serve TCBs (and the other
+kernel objects) from heap_4's slab classes to keep them from fragmenting the
+heap.  Stacks still come from the first fit allocator. */
+#define configUSE_HEAP_SLABS                     1
+/* Histogram, per caller totals and peak of the heap, printed by
+vPortHeapReport() when the user button is pressed. */
+#define configUSE_HEAP_INSTRUMENTATION           1
+/* Bump pointer arenas attached to a task and deleted with it (arena.h). */
+#define configUSE_TASK_ARENAS                    1
+/* The green and blue tasks never block, so the idle task never runs.  A reaper
+task at the top priority frees the red task's TCB and stack as soon as it has
+deleted itself (see README, Task Reaper). */
+#define configUSE_TASK_REAPER                    1
+/* The idle task sleeps the CPU until the next interrupt instead of spinning
+between ticks (see README, Idle Sleep). */
+#define configUSE_IDLE_SLEEP                     1
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
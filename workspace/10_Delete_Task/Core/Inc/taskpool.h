@@ -0,0 +1,59 @@
+/*******************************************************************************
+ *
+ * @file	taskpool.h
+ * @brief	Interface of the pool of pre-created worker tasks.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef TASKPOOL_H
+#define TASKPOOL_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Data types ----------------------------------------------------------------*/
+/* Runs to the end and returns; the worker then waits for the next job. Must
+ * not call vTaskDelete(NULL). */
+typedef void (*TaskPoolJob_t)(void *pvArg);
+
+typedef struct TaskPool TaskPool_t;
+typedef struct TaskPoolWorker TaskPoolWorker_t;
+
+typedef struct
+{
+	uint32_t ulSpawned;
+	uint32_t ulCompleted;
+	uint32_t ulNoWorker;			/* taskpool_spawn() calls that found none idle. */
+	uint32_t ulMaxBusy;				/* Most workers busy at once. */
+} TaskPoolStats_t;
+
+struct TaskPoolWorker
+{
+	StaticTask_t xTCB;
+	TaskHandle_t xTask;
+	TaskPool_t *pxPool;
+	TaskPoolWorker_t *pxNextIdle;
+	TaskPoolJob_t pxJob;
+	void *pvArg;
+};
+
+struct TaskPool
+{
+	TaskPoolWorker_t *pxIdle;		/* Parked workers, last parked first. */
+	UBaseType_t uxWorkers;
+	UBaseType_t uxBusy;
+	TaskPoolStats_t xStats;
+};
+
+/* Function Prototypes -------------------------------------------------------*/
+BaseType_t taskpool_init(TaskPool_t *pxPool, TaskPoolWorker_t *pxWorkers, StackType_t *puxStacks,
+		UBaseType_t uxWorkers, uint32_t ulStackWords, UBaseType_t uxPriority, const char *pcName);
+BaseType_t taskpool_spawn(TaskPool_t *pxPool, TaskPoolJob_t pxJob, void *pvArg);
+UBaseType_t taskpool_idle_workers(TaskPool_t *pxPool);
+void taskpool_get_stats(TaskPool_t *pxPool, TaskPoolStats_t *pxStats);
+
+#endif /* TASKPOOL_H */
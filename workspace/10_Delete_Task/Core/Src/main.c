@@ -6,6 +6,15 @@
  * @author	Kyungjae Lee
  * @date	Jun 7, 2025
  * @note	A deleted task cannot be resumed.
+ * 			With TASK_POOL set, the red task is a job of a task pool
+ * 			(taskpool.h) instead, spawned again each time it finishes, without
+ * 			creating or deleting a task.
+ *
+ * 			The red task records a sample per iteration in an arena
+ * 			(arena.h) attached to it, and never frees them: deleting the
+ * 			task deletes the arena and all it holds, so the heap report
+ * 			shows nothing left behind. The red job records them in a
+ * 			static arena instead, which it empties when it is done.
  *
  ******************************************************************************/
 
@@ -13,7 +22,18 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
+#include "arena.h"
+#include "taskpool.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define TASK_POOL 1		/* 0: create and delete the red task, 1: run it from a task pool */
+
+#define POOL_WORKERS		2U
+#define POOL_STACK_WORDS	100U
+#define RED_ITERATIONS		50U
+#define RED_ARENA_BYTES		(RED_ITERATIONS * sizeof(RedSample_t))
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
@@ -23,10 +43,21 @@ int __io_putchar(int ch);
 void vBlueLedControllerTask(void *pvParameters);
 void vRedLedControllerTask(void *pvParameters);
 void vGreenLedControllerTask(void *pvParameters);
+void vHeapReportTask(void *pvParameters);
+#if (TASK_POOL == 1)
+static void vRedLedControllerJob(void *pvArg);
+#endif
 
 /* Data types ----------------------------------------------------------------*/
 typedef uint32_t TaskProfiler;
 
+/* What the red task or job records at each iteration. */
+typedef struct
+{
+	uint32_t ulIteration;
+	TaskProfiler uProfile;
+} RedSample_t;
+
 /* Variables -----------------------------------------------------------------*/
 TaskProfiler uRedTaskProfiler;
 TaskProfiler uBlueTaskProfiler;
@@ -40,6 +71,16 @@ uint32_t uRedTaskPriority;
 uint32_t uBlueTaskPriority;
 uint32_t uExecutionMonitor;
 bool bRedTaskDeleted = false;
+char cHeapReport[1024];
+
+#if (TASK_POOL == 1)
+static TaskPool_t xPool;
+static TaskPoolWorker_t xPoolWorkers[POOL_WORKERS];
+static StackType_t uxPoolStacks[POOL_WORKERS * POOL_STACK_WORDS];
+static uint8_t ucRedJobArenaStorage[RED_ARENA_BYTES];
+static StaticArena_t xRedJobArenaBuffer;
+static ArenaHandle_t xRedJobArena;
+#endif
 
 /**
  * @brief The application entry point.
@@ -64,12 +105,26 @@ int main(void)
 				1,		/* higher priority than other tasks. */
 				&xGreenTaskHandle);
 
+#if (TASK_POOL == 1)
+	/* The workers are created once; the red job then runs on whichever is
+	 * parked, with no heap allocation. */
+	xRedJobArena = xArenaCreateStatic(sizeof(ucRedJobArenaStorage), ucRedJobArenaStorage,
+			&xRedJobArenaBuffer);
+
+	if ((taskpool_init(&xPool, xPoolWorkers, uxPoolStacks, POOL_WORKERS, POOL_STACK_WORDS, 1,
+			"Pool Worker") != pdPASS)
+			|| (taskpool_spawn(&xPool, vRedLedControllerJob, NULL) != pdPASS))
+	{
+		Error_Handler();
+	}
+#else
 	xTaskCreate(vRedLedControllerTask,
 				"Red Led Controller",
 				100,
 				NULL,
 				1,
 				&xRedTaskHandle);
+#endif
 
 	xTaskCreate(vBlueLedControllerTask,
 				"Blue Led Controller",
@@ -78,6 +133,13 @@ int main(void)
 				1,		/* Initially the highest priority. */
 				&xBlueTaskHandle);
 
+	xTaskCreate(vHeapReportTask,
+				"Heap Report",
+				256,	/* printf() needs the headroom. */
+				NULL,
+				2,		/* Above the busy tasks so the button is polled. */
+				NULL);
+
 	vTaskStartScheduler();
 
 	/* We should never get here as control is now taken by the scheduler */
@@ -103,23 +165,38 @@ void vGreenLedControllerTask(void *pvParameters)
 }
 
 /**
- * @brief Increments its profiler and suspends itself when condition is met.
+ * @brief Increments its profiler, recording a sample each time, and deletes
+ * itself when condition is met.
  * @retval None
  */
 void vRedLedControllerTask(void *pvParameters)
 {
+	RedSample_t *pxSample;
 	int i;
 
+	/* Owned by the task from here on. If the heap is short, the samples are
+	 * simply not recorded. */
+	vTaskSetArena(NULL, xArenaCreate(RED_ARENA_BYTES));
+
 	while (1)
 	{
 		uRedTaskProfiler++;
 
+		/* A pointer increment: no header, no free list. */
+		pxSample = pvTaskArenaAlloc(sizeof(*pxSample));
+
+		if (pxSample != NULL)
+		{
+			pxSample->ulIteration = uExecutionMonitor;
+			pxSample->uProfile = uRedTaskProfiler;
+		}
+
 		/* Delay introduced for monitoring purpose. */
 		for (i = 0; i < 200000; i++);
 
 		uExecutionMonitor++;
 
-		if (uExecutionMonitor >= 50)
+		if (uExecutionMonitor >= RED_ITERATIONS)
 		{
 			bRedTaskDeleted = true;
 			uExecutionMonitor = 0;
@@ -128,6 +205,42 @@ void vRedLedControllerTask(void *pvParameters)
 	}
 }
 
+#if (TASK_POOL == 1)
+/**
+ * @brief Increments its profiler 50 times, recording a sample each time, then
+ * returns to the pool.
+ * @param pvArg Unused.
+ * @retval None
+ */
+static void vRedLedControllerJob(void *pvArg)
+{
+	RedSample_t *pxSample;
+	int i;
+
+	for (uExecutionMonitor = 0; uExecutionMonitor < RED_ITERATIONS; uExecutionMonitor++)
+	{
+		uRedTaskProfiler++;
+
+		pxSample = pvArenaAlloc(xRedJobArena, sizeof(*pxSample));
+
+		if (pxSample != NULL)
+		{
+			pxSample->ulIteration = uExecutionMonitor;
+			pxSample->uProfile = uRedTaskProfiler;
+		}
+
+		/* Delay introduced for monitoring purpose. */
+		for (i = 0; i < 200000; i++);
+	}
+
+	/* The worker outlives the job, so the job empties the arena itself. */
+	vArenaReset(xRedJobArena);
+
+	uExecutionMonitor = 0;
+	bRedTaskDeleted = true;
+}
+#endif
+
 /**
  * @brief Increments its profiler.
  * @retval None
@@ -140,6 +253,50 @@ void vBlueLedControllerTask(void *pvParameters)
 	}
 }
 
+/**
+ * @brief Prints the heap report over USART2 each time the user button (B1) is
+ * pressed. With TASK_POOL set, also spawns the red job again once it is done.
+ * @retval None
+ */
+void vHeapReportTask(void *pvParameters)
+{
+	GPIO_PinState xLastState = GPIO_PIN_SET;
+	GPIO_PinState xState;
+#if (TASK_POOL == 1)
+	TaskPoolStats_t xStats;
+#endif
+
+	while (1)
+	{
+		vTaskDelay(pdMS_TO_TICKS(50));
+
+#if (TASK_POOL == 1)
+		if (bRedTaskDeleted && (taskpool_spawn(&xPool, vRedLedControllerJob, NULL) == pdPASS))
+		{
+			bRedTaskDeleted = false;
+		}
+#endif
+
+		/* B1 reads low while pressed. */
+		xState = HAL_GPIO_ReadPin(B1_GPIO_Port, B1_Pin);
+
+		if ((xState == GPIO_PIN_RESET) && (xLastState == GPIO_PIN_SET))
+		{
+			vPortHeapReport(cHeapReport, sizeof(cHeapReport));
+			printf("%s\r\n", cHeapReport);
+
+#if (TASK_POOL == 1)
+			/* The heap figures stay put however many jobs have run. */
+			taskpool_get_stats(&xPool, &xStats);
+			printf("Pool: %lu spawned, %lu completed, %lu without a worker, %lu busy at most\r\n",
+					xStats.ulSpawned, xStats.ulCompleted, xStats.ulNoWorker, xStats.ulMaxBusy);
+#endif
+		}
+
+		xLastState = xState;
+	}
+}
+
 /**
  * @brief Retargets the C library printf function to UART.
  * @note This function is typically used when you want printf() output to be
@@ -159,44 +316,9 @@ int __io_putchar(int ch)
  */
 void SystemClock_Config(void)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
-
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-	{
-		Error_Handler();
-	}
-
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
@@ -0,0 +1,203 @@
+/*******************************************************************************
+ *
+ * @file	taskpool.c
+ * @brief	Pool of pre-created worker tasks that run jobs on demand.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	xTaskCreate() takes the TCB and the stack from the heap, fills the
+ * 			stack and initialises the TCB; vTaskDelete() leaves both to the
+ * 			idle task to free. A task that is only needed now and then can run
+ * 			as a job instead:
+ *
+ * 				taskpool_init(&xPool, xWorkers, uxStacks, 2, 128, 1, "Worker");
+ * 				...
+ * 				taskpool_spawn(&xPool, vJob, pvArg);
+ *
+ * 			taskpool_init() creates every worker once, from static storage,
+ * 			and parks it on its task notification. taskpool_spawn() takes a
+ * 			parked worker off the idle list, hands it the function and the
+ * 			argument, and gives its notification: no heap, no stack fill, no
+ * 			clean-up by the idle task. When the job returns, the worker parks
+ * 			itself again.
+ *
+ * 			Workers are never refilled with tskSTACK_FILL_BYTE, so their high
+ * 			water mark is the deepest job they have run, and a job finds its
+ * 			worker's stack as the last job left it.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "taskpool.h"
+
+/* Private function prototypes -----------------------------------------------*/
+static void taskpool_worker_task(void *pvParameters);
+static void taskpool_park(TaskPoolWorker_t *pxWorker);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Creates the workers of a pool, all parked.
+ * @param pxPool Pool.
+ * @param pxWorkers Storage of uxWorkers workers. Must stay valid for good.
+ * @param puxStacks Storage of uxWorkers stacks of ulStackWords each.
+ * @param uxWorkers Number of workers: jobs that can run at once.
+ * @param ulStackWords Stack depth of each worker, for the deepest job.
+ * @param uxPriority Priority the jobs run at.
+ * @param pcName Name shared by the workers. Must outlive them.
+ * @retval pdPASS, or pdFAIL if a worker could not be created.
+ */
+BaseType_t taskpool_init(TaskPool_t *pxPool, TaskPoolWorker_t *pxWorkers, StackType_t *puxStacks,
+		UBaseType_t uxWorkers, uint32_t ulStackWords, UBaseType_t uxPriority, const char *pcName)
+{
+	UBaseType_t i;
+
+	pxPool->pxIdle = NULL;
+	pxPool->uxWorkers = uxWorkers;
+	pxPool->uxBusy = 0U;
+	pxPool->xStats.ulSpawned = 0U;
+	pxPool->xStats.ulCompleted = 0U;
+	pxPool->xStats.ulNoWorker = 0U;
+	pxPool->xStats.ulMaxBusy = 0U;
+
+	for (i = 0U; i < uxWorkers; i++)
+	{
+		pxWorkers[i].pxPool = pxPool;
+		pxWorkers[i].pxJob = NULL;
+		pxWorkers[i].pvArg = NULL;
+		pxWorkers[i].xTask = xTaskCreateStatic(taskpool_worker_task,
+											   pcName,
+											   ulStackWords,
+											   &pxWorkers[i],
+											   uxPriority,
+											   &puxStacks[i * ulStackWords],
+											   &pxWorkers[i].xTCB);
+
+		if (pxWorkers[i].xTask == NULL)
+		{
+			return pdFAIL;
+		}
+
+		/* Idle until the first spawn, whether the scheduler runs yet or not. */
+		taskENTER_CRITICAL();
+		pxWorkers[i].pxNextIdle = pxPool->pxIdle;
+		pxPool->pxIdle = &pxWorkers[i];
+		taskEXIT_CRITICAL();
+	}
+
+	return pdPASS;
+}
+
+/**
+ * @brief Runs a job on a parked worker.
+ * @param pxPool Pool.
+ * @param pxJob Job function.
+ * @param pvArg Argument of the job.
+ * @retval pdPASS, or pdFAIL if every worker is busy.
+ * @note Costs a critical section and one task notification. A job of higher
+ * priority than the caller starts before this returns.
+ */
+BaseType_t taskpool_spawn(TaskPool_t *pxPool, TaskPoolJob_t pxJob, void *pvArg)
+{
+	TaskPoolWorker_t *pxWorker;
+
+	configASSERT(pxJob != NULL);
+
+	taskENTER_CRITICAL();
+	pxWorker = pxPool->pxIdle;
+
+	if (pxWorker != NULL)
+	{
+		pxPool->pxIdle = pxWorker->pxNextIdle;
+		pxWorker->pxJob = pxJob;
+		pxWorker->pvArg = pvArg;
+		pxPool->uxBusy++;
+		pxPool->xStats.ulSpawned++;
+
+		if (pxPool->uxBusy > pxPool->xStats.ulMaxBusy)
+		{
+			pxPool->xStats.ulMaxBusy = pxPool->uxBusy;
+		}
+	}
+	else
+	{
+		pxPool->xStats.ulNoWorker++;
+	}
+	taskEXIT_CRITICAL();
+
+	if (pxWorker == NULL)
+	{
+		return pdFAIL;
+	}
+
+	xTaskNotifyGive(pxWorker->xTask);
+
+	return pdPASS;
+}
+
+/**
+ * @brief Tells how many workers are parked.
+ * @param pxPool Pool.
+ * @retval Number of jobs that can be spawned now.
+ */
+UBaseType_t taskpool_idle_workers(TaskPool_t *pxPool)
+{
+	UBaseType_t uxIdle;
+
+	taskENTER_CRITICAL();
+	uxIdle = pxPool->uxWorkers - pxPool->uxBusy;
+	taskEXIT_CRITICAL();
+
+	return uxIdle;
+}
+
+/**
+ * @brief Reads the statistics of a pool.
+ * @param pxPool Pool.
+ * @param pxStats Where the statistics are written.
+ * @retval None
+ */
+void taskpool_get_stats(TaskPool_t *pxPool, TaskPoolStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = pxPool->xStats;
+	taskEXIT_CRITICAL();
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Waits for a job, runs it and parks again, for good.
+ * @param pvParameters Worker.
+ * @retval None
+ */
+static void taskpool_worker_task(void *pvParameters)
+{
+	TaskPoolWorker_t *pxWorker = (TaskPoolWorker_t *)pvParameters;
+
+	while (1)
+	{
+		(void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+		pxWorker->pxJob(pxWorker->pvArg);
+		taskpool_park(pxWorker);
+	}
+}
+
+/**
+ * @brief Puts a worker whose job has returned back on the idle list.
+ * @param pxWorker Worker.
+ * @retval None
+ */
+static void taskpool_park(TaskPoolWorker_t *pxWorker)
+{
+	TaskPool_t *pxPool = pxWorker->pxPool;
+
+	taskENTER_CRITICAL();
+	pxWorker->pxJob = NULL;
+	pxWorker->pxNextIdle = pxPool->pxIdle;
+	pxPool->pxIdle = pxWorker;
+	pxPool->uxBusy--;
+	pxPool->xStats.ulCompleted++;
+	taskEXIT_CRITICAL();
+}
@@ -0,0 +1,282 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * An arena is a block of memory that objects are carved from by moving a
+ * pointer forward, and that is given back all at once.  It suits a task that
+ * builds many small short-lived objects - the parts of a message it is
+ * parsing, say - and would otherwise have to vPortFree() each one, or leak
+ * them when it is deleted.
+ *
+ * - pvArenaAlloc() rounds the size up to portBYTE_ALIGNMENT and moves the
+ *   pointer: no header, no search, no critical section.  It returns NULL
+ *   once the arena is full; the arena never grows.
+ *
+ * - Nothing is freed one object at a time.  vArenaReset() empties the arena,
+ *   and xArenaGetMark() / vArenaRewind() give back everything allocated since
+ *   the mark, so the objects of one scope go at its end.
+ *
+ * - The arena itself is one allocation from the heap (xArenaCreate()) or
+ *   memory provided by the application (xArenaCreateStatic()), so the shared
+ *   heap does not fragment however many objects come and go.
+ *
+ * - vTaskSetArena() attaches an arena to a task, which can then allocate from
+ *   it with pvTaskArenaAlloc().  The task owns it from then on: the arena is
+ *   deleted with the task, when the kernel frees the TCB.
+ *
+ * An arena is not protected against concurrent use.  Use each from a single
+ * task at a time - its owner for an attached arena - and never from an
+ * interrupt.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include arena.h"
+#endif
+
+#include "task.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * The storage of an arena, declared by the application and passed to
+ * xArenaCreateStatic().  Its members must not be accessed directly.
+ */
+typedef struct ArenaDef_t
+{
+	uint8_t *pucStart;					/* Aligned. */
+	uint8_t *pucNext;
+	uint8_t *pucEnd;
+	size_t xHighWaterMark;				/* Most bytes ever allocated at once. */
+	uint8_t ucStaticallyAllocated;
+} StaticArena_t;
+
+/**
+ * Type by which arenas are referenced.
+ */
+typedef StaticArena_t * ArenaHandle_t;
+
+/**
+ * arena.h
+ *
+<pre>
+ArenaHandle_t xArenaCreate( size_t xSizeBytes );
+</pre>
+ *
+ * Creates an arena of xSizeBytes usable bytes, allocated together with its
+ * storage in one block from the FreeRTOS heap.
+ *
+ * @return A handle to the arena, or NULL if the heap could not provide the
+ * block.
+ *
+ * \defgroup xArenaCreate xArenaCreate
+ * \ingroup Arenas
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	ArenaHandle_t xArenaCreate( size_t xSizeBytes ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * arena.h
+ *
+<pre>
+ArenaHandle_t xArenaCreateStatic( size_t xSizeBytes,
+                                  uint8_t *pucArenaStorage,
+                                  StaticArena_t *pxArenaBuffer );
+</pre>
+ *
+ * Creates an arena in memory provided by the application.
+ *
+ * @param xSizeBytes The size of pucArenaStorage.  Bytes before the first and
+ * after the last portBYTE_ALIGNMENT boundary in it are not used.
+ *
+ * @param pucArenaStorage The memory objects are allocated from.
+ *
+ * @param pxArenaBuffer The storage of the arena.
+ *
+ * @return A handle to the arena.
+ *
+ * Example usage:
+<pre>
+static uint8_t ucStorage[ 512 ];
+static StaticArena_t xArenaBuffer;
+
+void vParserTask( void *pvParameters )
+{
+ArenaHandle_t xArena = xArenaCreateStatic( sizeof( ucStorage ), ucStorage, &xArenaBuffer );
+size_t xMark;
+
+	for( ;; )
+	{
+		xMark = xArenaGetMark( xArena );
+		vParse( xArena );	// Calls pvArenaAlloc( xArena, ... ) for each field.
+		vArenaRewind( xArena, xMark );
+	}
+}
+</pre>
+ * \defgroup xArenaCreateStatic xArenaCreateStatic
+ * \ingroup Arenas
+ */
+ArenaHandle_t xArenaCreateStatic( size_t xSizeBytes, uint8_t *pucArenaStorage, StaticArena_t *pxArenaBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *
+<pre>
+void vArenaDelete( ArenaHandle_t xArena );
+</pre>
+ *
+ * Deletes an arena, and every object allocated from it.  An arena created by
+ * xArenaCreate() goes back to the heap.  Must not be called for an arena
+ * attached to a task; that one is deleted with the task.
+ *
+ * \defgroup vArenaDelete vArenaDelete
+ * \ingroup Arenas
+ */
+void vArenaDelete( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *
+<pre>
+void *pvArenaAlloc( ArenaHandle_t xArena, size_t xWantedSize );
+</pre>
+ *
+ * @return xWantedSize bytes aligned to portBYTE_ALIGNMENT, or NULL if the
+ * arena does not have them left (or xWantedSize is 0).  The malloc failed
+ * hook is not called: the shared heap is not exhausted.
+ *
+ * \defgroup pvArenaAlloc pvArenaAlloc
+ * \ingroup Arenas
+ */
+void *pvArenaAlloc( ArenaHandle_t xArena, size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *
+<pre>
+size_t xArenaGetMark( ArenaHandle_t xArena );
+void vArenaRewind( ArenaHandle_t xArena, size_t xMark );
+void vArenaReset( ArenaHandle_t xArena );
+</pre>
+ *
+ * xArenaGetMark() returns the bytes allocated so far.  vArenaRewind() gives
+ * back everything allocated since xArenaGetMark() returned xMark; marks nest,
+ * and the objects allocated before the mark stay valid.  vArenaReset() gives
+ * back everything, like a rewind to 0.
+ *
+ * \defgroup vArenaRewind vArenaRewind
+ * \ingroup Arenas
+ */
+size_t xArenaGetMark( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+void vArenaRewind( ArenaHandle_t xArena, size_t xMark ) PRIVILEGED_FUNCTION;
+void vArenaReset( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *
+<pre>
+size_t xArenaGetFreeSize( ArenaHandle_t xArena );
+size_t xArenaGetHighWaterMark( ArenaHandle_t xArena );
+</pre>
+ *
+ * @return The bytes left in the arena, and the most bytes it has held at any
+ * one time, alignment padding included.  The high water mark is what the
+ * arena should be sized for.
+ *
+ * \defgroup xArenaGetFreeSize xArenaGetFreeSize
+ * \ingroup Arenas
+ */
+size_t xArenaGetFreeSize( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+size_t xArenaGetHighWaterMark( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *
+<pre>
+void vTaskSetArena( TaskHandle_t xTask, ArenaHandle_t xArena );
+ArenaHandle_t xTaskGetArena( TaskHandle_t xTask );
+</pre>
+ *
+ * vTaskSetArena() attaches xArena to xTask (NULL for the calling task), which
+ * then owns it: when the task is deleted, the arena is deleted too, as if by
+ * vArenaDelete(), when the kernel frees the task's stack and TCB.  A NULL
+ * xArena detaches the task's arena, which the caller then owns again.  A task
+ * has at most one arena; attach another only after detaching the first.
+ *
+ * xTaskGetArena() returns the arena attached to xTask (NULL for the calling
+ * task), or NULL if it has none.
+ *
+ * \defgroup vTaskSetArena vTaskSetArena
+ * \ingroup Arenas
+ */
+void vTaskSetArena( TaskHandle_t xTask, ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+ArenaHandle_t xTaskGetArena( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *
+<pre>
+void *pvTaskArenaAlloc( size_t xWantedSize );
+</pre>
+ *
+ * pvArenaAlloc() from the arena of the calling task.
+ *
+ * @return The memory, or NULL if the task has no arena or it is full.
+ *
+ * Example usage:
+<pre>
+void vWorkerTask( void *pvParameters )
+{
+	vTaskSetArena( NULL, xArenaCreate( 1024 ) );
+
+	for( ;; )
+	{
+		xMessage = pvTaskArenaAlloc( sizeof( Message_t ) );
+		...
+		if( xDone )
+		{
+			// Frees the stack, the TCB and the arena with all it holds.
+			vTaskDelete( NULL );
+		}
+	}
+}
+</pre>
+ * \defgroup pvTaskArenaAlloc pvTaskArenaAlloc
+ * \ingroup Arenas
+ */
+void *pvTaskArenaAlloc( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif	/* !defined( ARENA_H ) */
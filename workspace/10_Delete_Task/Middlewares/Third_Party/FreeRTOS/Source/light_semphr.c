@@ -0,0 +1,133 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "light_semphr.h"
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build light_semphr.c
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/*-----------------------------------------------------------*/
+
+LightSemaphoreHandle_t xLightSemaphoreCreateCountingStatic( TaskHandle_t xOwner, UBaseType_t uxIndex, UBaseType_t uxMaxCount, UBaseType_t uxInitialCount, StaticLightSemaphore_t *pxSemaphoreBuffer )
+{
+	configASSERT( xOwner );
+	configASSERT( pxSemaphoreBuffer );
+	configASSERT( uxIndex < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
+	configASSERT( uxMaxCount != ( UBaseType_t ) 0 );
+	configASSERT( uxInitialCount <= uxMaxCount );
+
+	pxSemaphoreBuffer->xOwner = xOwner;
+	pxSemaphoreBuffer->uxIndex = uxIndex;
+	pxSemaphoreBuffer->uxMaxCount = uxMaxCount;
+
+	/* Start from a clean notification: nothing pending and the initial
+	count as the value.  Only the owner can be waiting on this index, and it
+	cannot be while its semaphore is being created. */
+	taskENTER_CRITICAL();
+	{
+		( void ) xTaskNotifyStateClearIndexed( xOwner, uxIndex );
+		( void ) ulTaskNotifyValueClearIndexed( xOwner, uxIndex, ~( ( uint32_t ) 0 ) );
+
+		if( uxInitialCount != ( UBaseType_t ) 0 )
+		{
+			( void ) xTaskNotifyIndexed( xOwner, uxIndex, ( uint32_t ) uxInitialCount, eSetValueWithOverwrite );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return pxSemaphoreBuffer;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xLightSemaphoreTake( LightSemaphoreHandle_t xSemaphore, TickType_t xTicksToWait )
+{
+BaseType_t xReturn;
+
+	configASSERT( xSemaphore );
+
+	/* A light semaphore has a single waiter: its owner.  Another task would
+	wait on its own notification, which nothing gives. */
+	configASSERT( xTaskGetCurrentTaskHandle() == xSemaphore->xOwner );
+
+	/* Take one count, not all of them, so a counting semaphore keeps the
+	rest. */
+	if( ulTaskNotifyTakeIndexed( xSemaphore->uxIndex, pdFALSE, xTicksToWait ) != 0UL )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xLightSemaphoreGive( LightSemaphoreHandle_t xSemaphore )
+{
+	configASSERT( xSemaphore );
+
+	return xTaskNotifyIndexed( xSemaphore->xOwner, xSemaphore->uxIndex, ( uint32_t ) xSemaphore->uxMaxCount, eIncrementUpToValue );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xLightSemaphoreGiveFromISR( LightSemaphoreHandle_t xSemaphore, BaseType_t *pxHigherPriorityTaskWoken )
+{
+	configASSERT( xSemaphore );
+
+	return xTaskNotifyIndexedFromISR( xSemaphore->xOwner, xSemaphore->uxIndex, ( uint32_t ) xSemaphore->uxMaxCount, eIncrementUpToValue, pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxLightSemaphoreGetCount( LightSemaphoreHandle_t xSemaphore )
+{
+	configASSERT( xSemaphore );
+
+	/* Clearing no bits returns the value unchanged. */
+	return ( UBaseType_t ) ulTaskNotifyValueClearIndexed( xSemaphore->xOwner, xSemaphore->uxIndex, 0UL );
+}
+/*-----------------------------------------------------------*/
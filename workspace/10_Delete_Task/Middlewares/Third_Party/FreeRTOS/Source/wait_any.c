@@ -0,0 +1,177 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "wait_any.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+to include wait-any functionality. */
+#if( configUSE_WAIT_ANY == 1 )
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to use wait-any objects
+#endif
+
+/* Each member is one bit of a UBaseType_t, at least 32 bits wide on the ports
+wait-any objects are used with. */
+#if( configWAIT_ANY_MAX_MEMBERS > 32 )
+	#error configWAIT_ANY_MAX_MEMBERS cannot exceed 32
+#endif
+
+/*-----------------------------------------------------------*/
+
+WaitAnyHandle_t xWaitAnyCreateStatic( TaskHandle_t xOwner, UBaseType_t uxIndex, StaticWaitAny_t *pxWaitAnyBuffer )
+{
+	configASSERT( xOwner );
+	configASSERT( pxWaitAnyBuffer );
+	configASSERT( uxIndex < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
+	configASSERT( ( UBaseType_t ) configWAIT_ANY_MAX_MEMBERS <= ( UBaseType_t ) ( 8 * sizeof( UBaseType_t ) ) );
+
+	pxWaitAnyBuffer->xOwner = xOwner;
+	pxWaitAnyBuffer->uxIndex = uxIndex;
+	pxWaitAnyBuffer->uxOwnerWaiting = pdFALSE;
+	pxWaitAnyBuffer->uxMemberCount = 0;
+
+	return pxWaitAnyBuffer;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxWaitAnyAddMember( WaitAnyHandle_t xWaitAny, void *pvMember, WaitAnyIsReadyFunction_t pxIsReady )
+{
+UBaseType_t uxReturn;
+
+	configASSERT( xWaitAny );
+	configASSERT( pvMember );
+
+	/* Called by uxWaitAnyAddQueue() and uxWaitAnyAddStreamBuffer() from
+	within a critical section. */
+	if( xWaitAny->uxMemberCount < ( UBaseType_t ) configWAIT_ANY_MAX_MEMBERS )
+	{
+		xWaitAny->pvMembers[ xWaitAny->uxMemberCount ] = pvMember;
+		xWaitAny->pxIsReady[ xWaitAny->uxMemberCount ] = pxIsReady;
+		uxReturn = ( ( UBaseType_t ) 1 ) << xWaitAny->uxMemberCount;
+		xWaitAny->uxMemberCount++;
+	}
+	else
+	{
+		uxReturn = 0;
+	}
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxWaitAnyWait( WaitAnyHandle_t xWaitAny, UBaseType_t uxBitsToWaitFor, TickType_t xTicksToWait )
+{
+UBaseType_t uxReady, uxMember;
+TimeOut_t xTimeOut;
+
+	configASSERT( xWaitAny );
+	configASSERT( uxBitsToWaitFor != ( UBaseType_t ) 0 );
+
+	/* Only the owner blocks on the notification the members post to. */
+	configASSERT( xWaitAny->xOwner == xTaskGetCurrentTaskHandle() );
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		/* Forget wakeups for data that has been read since.  From here on
+		every send to a member notifies the owner, so a send after the members
+		are polled below ends the block at once instead of being missed. */
+		( void ) xTaskNotifyStateClearIndexed( NULL, xWaitAny->uxIndex );
+		xWaitAny->uxOwnerWaiting = pdTRUE;
+
+		uxReady = 0;
+
+		for( uxMember = 0; uxMember < xWaitAny->uxMemberCount; uxMember++ )
+		{
+			if( ( ( uxBitsToWaitFor & ( ( ( UBaseType_t ) 1 ) << uxMember ) ) != ( UBaseType_t ) 0 ) &&
+				( xWaitAny->pxIsReady[ uxMember ]( xWaitAny->pvMembers[ uxMember ] ) != pdFALSE ) )
+			{
+				uxReady |= ( ( UBaseType_t ) 1 ) << uxMember;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		if( ( uxReady != ( UBaseType_t ) 0 ) || ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE ) )
+		{
+			break;
+		}
+
+		( void ) xTaskNotifyWaitIndexed( xWaitAny->uxIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+	}
+
+	xWaitAny->uxOwnerWaiting = pdFALSE;
+
+	return uxReady;
+}
+/*-----------------------------------------------------------*/
+
+void vWaitAnyNotify( WaitAnyHandle_t xWaitAny )
+{
+	/* Sends while the owner is not waiting cost only this load. */
+	if( xWaitAny->uxOwnerWaiting != pdFALSE )
+	{
+		( void ) xTaskNotifyIndexed( xWaitAny->xOwner, xWaitAny->uxIndex, ( uint32_t ) 0, eNoAction );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vWaitAnyNotifyFromISR( WaitAnyHandle_t xWaitAny, BaseType_t *pxHigherPriorityTaskWoken )
+{
+	if( xWaitAny->uxOwnerWaiting != pdFALSE )
+	{
+		( void ) xTaskNotifyIndexedFromISR( xWaitAny->xOwner, xWaitAny->uxIndex, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+
+#endif /* configUSE_WAIT_ANY == 1 */
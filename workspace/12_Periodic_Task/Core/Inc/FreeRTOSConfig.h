@@ -125,6 +125,7 @@ to exclude the API function. */
  * by the application thus the correct define need to be enabled below
  */
 #define USE_FreeRTOS_HEAP_4
+/* #define USE_FreeRTOS_HEAP_TLSF */	/* Instead of HEAP_4: heap_tlsf.c, O(1) malloc and free */
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -168,6 +169,45 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Port optimised task selection: the CM4F port finds the highest ready
+priority with CLZ on a ready-priority bitmap instead of walking the ready
+lists.  The 56 CMSIS-RTOS2 priorities take a two-level bitmap, so selection is
+two CLZs whatever the priorities in use (see README, Task Selection). */
+#undef configUSE_PORT_OPTIMISED_TASK_SELECTION
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
+/* Run-time stats on the DWT cycle counter, extended to 64 bits (runstats.c). */
+#define configGENERATE_RUN_TIME_STATS            1
+#define configRUN_TIME_COUNTER_TYPE              uint64_t
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  void runstats_timer_init(void);
+  uint64_t runstats_get_counter(void);
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() runstats_timer_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()         runstats_get_counter()
+/* Record the top of each task stack so uxTaskGetStackDepth() can give the
+depth for the stack report (stackwatch.c). */
+#define configRECORD_STACK_HIGH_ADDRESS          1
+/* Priority 3 holds the control loop and the filter, run earliest deadline
+first; periodic.c sets each release's deadline (see README, EDF). */
+#define configUSE_EDF_SCHEDULING                 1
+#define configEDF_PRIORITY                       3
+/* Lean TCB layout: task names are kept as pointers to their literals and the
+trace numbers, which nothing here reads, are dropped (see README, Lean TCB). */
+#define configUSE_LEAN_TCB                       1
+#define configLEAN_TCB_DIAGNOSTIC_ENTRIES        0
+/* stackwatch.c scans the stacks a few tasks at a time (see README, Task
+Snapshots). */
+#define configUSE_TASK_SNAPSHOTS                 1
+/* The idle task sleeps the CPU until the next interrupt instead of spinning
+between ticks (see README, Idle Sleep). */
+#define configUSE_IDLE_SLEEP                     1
+/* The busy Red and Blue tasks get a CPU budget per period, charged on the
+run-time stats clock, so they cannot starve the tasks at or below their
+priority (see README, Task Budgets). */
+#define configUSE_TASK_BUDGETS                   1
+/* Each task's jobs are timed on the run-time stats clock, for the rate
+monotonic priority advice of rmprio.c (see README, Priority Advice). */
+#define configUSE_JOB_STATS                      1
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,72 @@
+/*******************************************************************************
+ *
+ * @file	rmprio.h
+ * @brief	Interface of the rate monotonic priority advisor.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef RMPRIO_H
+#define RMPRIO_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef RMPRIO_MAX_TASKS
+#define RMPRIO_MAX_TASKS 16U			/* At least the tasks there are, idle included. */
+#endif
+
+#ifndef RMPRIO_MIN_JOBS
+#define RMPRIO_MIN_JOBS 4U				/* Releases for a task to count as periodic. */
+#endif
+
+/* Run time stats counts per microsecond: CPU cycles with runstats.c. */
+#ifndef RMPRIO_COUNTS_PER_US
+#define RMPRIO_COUNTS_PER_US (SystemCoreClock / 1000000U)
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef enum
+{
+	RMPRIO_RATE_MONOTONIC = 0,		/* The shorter the period, the higher the priority. */
+	RMPRIO_DEADLINE_MONOTONIC		/* The same with the deadlines (rmprio_set_deadline()). */
+} RmprioPolicy_t;
+
+/* Advice on one periodic task of the managed priorities. */
+typedef struct
+{
+	const char *pcName;
+	TaskHandle_t xHandle;
+	uint32_t ulPeriodUs;			/* Shortest time between two releases. */
+	uint32_t ulDeadlineUs;			/* From the release; the period unless set. */
+	uint32_t ulExecUs;				/* Longest job. */
+	uint32_t ulResponseUs;			/* Worst case at the advised priority, 0 if over the deadline. */
+	UBaseType_t uxPriority;			/* Base priority now. */
+	UBaseType_t uxAdvised;
+} RmprioAdvice_t;
+
+typedef struct
+{
+	uint32_t ulTasks;				/* Periodic tasks analysed, those above the range included. */
+	uint32_t ulUtilisationPpm;		/* Their execution times over their periods. */
+	uint32_t ulBoundPpm;			/* n(2^(1/n) - 1): below it, rate monotonic always fits. */
+	uint32_t ulMisses;				/* Advised tasks whose response exceeds the deadline. */
+	BaseType_t xSchedulable;		/* pdTRUE if there are none. */
+} RmprioSummary_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+#if (configUSE_JOB_STATS == 1) && (configUSE_TRACE_FACILITY == 1)
+void rmprio_start(void);
+int32_t rmprio_set_deadline(TaskHandle_t xTask, uint32_t ulDeadlineUs);
+UBaseType_t rmprio_evaluate(RmprioPolicy_t ePolicy, UBaseType_t uxLowest, UBaseType_t uxHighest,
+		RmprioAdvice_t *pxAdvice, UBaseType_t uxSize, RmprioSummary_t *pxSummary);
+void rmprio_apply(const RmprioAdvice_t *pxAdvice, UBaseType_t uxCount);
+void rmprio_print(const RmprioAdvice_t *pxAdvice, UBaseType_t uxCount,
+		const RmprioSummary_t *pxSummary);
+#endif
+
+#endif /* RMPRIO_H */
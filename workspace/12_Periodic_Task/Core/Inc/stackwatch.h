@@ -0,0 +1,43 @@
+/*******************************************************************************
+ *
+ * @file	stackwatch.h
+ * @brief	Interface of the stack usage watcher and right-sizing report.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef STACKWATCH_H
+#define STACKWATCH_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef STACKWATCH_MAX_TASKS
+#define STACKWATCH_MAX_TASKS 16U			/* Tasks tracked, deleted ones included. */
+#endif
+
+#ifndef STACKWATCH_MARGIN_PERCENT
+#define STACKWATCH_MARGIN_PERCENT 25U		/* Headroom over the peak seen. */
+#endif
+
+#ifndef STACKWATCH_MARGIN_MIN_WORDS
+#define STACKWATCH_MARGIN_MIN_WORDS 32U		/* At least one exception frame or so. */
+#endif
+
+#ifndef STACKWATCH_SNAPSHOT_TASKS
+#define STACKWATCH_SNAPSHOT_TASKS 4U		/* Tasks per scheduler suspension (configUSE_TASK_SNAPSHOTS). */
+#endif
+
+#ifndef STACKWATCH_REPORTER_STACK_WORDS
+#define STACKWATCH_REPORTER_STACK_WORDS 384U	/* printf() needs the headroom. */
+#endif
+
+/* Function Prototypes -------------------------------------------------------*/
+void stackwatch_sample(void);
+void stackwatch_print(void);
+BaseType_t stackwatch_start_reporter(uint32_t ulPeriodMs, UBaseType_t uxPriority);
+
+#endif /* STACKWATCH_H */
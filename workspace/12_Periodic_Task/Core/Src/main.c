@@ -5,16 +5,53 @@
  * 			application.
  * @author	Kyungjae Lee
  * @date	Jun 7, 2025
+ * @note	The 1 kHz control loop runs on periodic.c above the busy Red and
+ * 			Blue tasks; its jitter and response time histograms are printed
+ * 			every 10 s.
+ *
+ * 			A 5 ms filter with 2 ms of work shares the control loop's
+ * 			priority, scheduled earliest deadline first: a control cycle
+ * 			released during a filter cycle preempts it only when its
+ * 			deadline is earlier. The task set is checked at start-up.
+ *
+ * 			The Red and Blue tasks spin forever. With BUSY_BUDGETS each may
+ * 			use 10 ms of CPU in every 50 ms: Red then runs on at the idle
+ * 			priority and Blue is suspended, until its next period starts.
+ *
+ * 			With RM_ADVICE, the timing report also prints the priorities
+ * 			rate monotonic scheduling would give the periodic tasks below
+ * 			the EDF band, from their measured periods and execution times,
+ * 			and whether they would all meet their deadlines. RM_APPLY sets
+ * 			them, once, if they would.
  *
  ******************************************************************************/
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
+#include "runstats.h"
+#include "stackwatch.h"
+#include "periodic.h"
+#include "rmprio.h"
 
 /* Macros --------------------------------------------------------------------*/
 #define DELAY_1000_MS_TICKS pdMS_TO_TICKS(1000)
+#define CONTROL_PERIOD_TICKS pdMS_TO_TICKS(1)
+#define CONTROL_WCET_US 50U
+#define FILTER_PERIOD_TICKS pdMS_TO_TICKS(5)
+#define FILTER_WORK_US 2000U
+#define FILTER_WCET_US 2100U
+#define TIMING_REPORT_PERIOD_TICKS pdMS_TO_TICKS(10000)
+#define BUSY_BUDGETS 1 /* 0: Red and Blue spin unchecked, 1: each has a CPU budget */
+#define BUSY_BUDGET_US 10000U
+#define BUSY_PERIOD_TICKS pdMS_TO_TICKS(50)
+#define RM_ADVICE 1 /* 0: hand-set priorities only, 1: print the rate monotonic advice */
+#define RM_APPLY 0 /* 0: only print the advice, 1: also apply it once, if schedulable */
+#define RM_LOWEST_PRIORITY 1 /* The priorities managed: those under the EDF band. */
+#define RM_HIGHEST_PRIORITY 2
+#define RM_MAX_ADVICE 8U
 
 /* Data types ----------------------------------------------------------------*/
 typedef uint32_t TaskProfiler;
@@ -23,6 +60,11 @@ typedef uint32_t TaskProfiler;
 TaskProfiler uRedTaskProfiler;
 TaskProfiler uBlueTaskProfiler;
 TaskProfiler uGreenTaskProfiler;
+TaskProfiler uControlTaskProfiler;
+TaskHandle_t xRedTask;
+TaskHandle_t xBlueTask;
+Periodic_t xControlLoop;
+Periodic_t xFilter;
 UART_HandleTypeDef huart2;
 
 /* Private function prototypes -----------------------------------------------*/
@@ -33,6 +75,13 @@ int __io_putchar(int ch);
 void vBlueLedControllerTask(void *pvParameters);
 void vRedLedControllerTask(void *pvParameters);
 void vGreenLedControllerTask(void *pvParameters);
+void vControlLoopTask(void *pvParameters);
+void vFilterTask(void *pvParameters);
+void vTimingReportTask(void *pvParameters);
+static void vPrintBudget(TaskHandle_t xTask, const char *pcName);
+#if (RM_ADVICE == 1)
+static void vPriorityAdvice(void);
+#endif
 
 /**
  * @brief The application entry point.
@@ -62,15 +111,45 @@ int main(void)
 				100,
 				NULL,
 				1,
-				NULL);
+				&xRedTask);
 
 	xTaskCreate(vBlueLedControllerTask,
 				"Blue Led Controller",
 				100,
 				NULL,
 				1,
+				&xBlueTask);
+
+	/* A 1 kHz loop and a 200 Hz filter above the busy tasks, sharing the EDF
+	 * priority, and the report of their timing. */
+	xTaskCreate(vControlLoopTask,
+				"Control Loop",
+				128,
+				NULL,
+				3,
+				NULL);
+
+	xTaskCreate(vFilterTask,
+				"Filter",
+				128,
+				NULL,
+				3,
+				NULL);
+
+	xTaskCreate(vTimingReportTask,
+				"Timing Report",
+				384,
+				NULL,
+				2,
 				NULL);
 
+	/* Print each task's share of the CPU every 2 s. The priority is above the
+	 * busy Red/Blue tasks so the report is not starved. */
+	runstats_start_reporter(2000, 2);
+
+	/* Print the peak use and a recommended depth of every stack every 10 s. */
+	stackwatch_start_reporter(10000, 2);
+
 	vTaskStartScheduler();
 
 	/* We should never get here as control is now taken by the scheduler */
@@ -103,12 +182,154 @@ void vGreenLedControllerTask(void *pvParameters)
 	}
 }
 
+/**
+ * @brief A 1 ms periodic task whose release jitter and response time are
+ * recorded by periodic.c.
+ * @retval None
+ */
+void vControlLoopTask(void *pvParameters)
+{
+	periodic_init(&xControlLoop, CONTROL_PERIOD_TICKS, CONTROL_PERIOD_TICKS,
+			PERIODIC_OVERRUN_SKIP);
+
+	while (1)
+	{
+		periodic_wait(&xControlLoop);
+		uControlTaskProfiler++;
+	}
+}
+
+/**
+ * @brief A 5 ms periodic task that busy-waits 2 ms per cycle, for a load the
+ * control loop has to interleave with.
+ * @retval None
+ */
+void vFilterTask(void *pvParameters)
+{
+	uint32_t ulStart;
+
+	periodic_init(&xFilter, FILTER_PERIOD_TICKS, FILTER_PERIOD_TICKS,
+			PERIODIC_OVERRUN_SKIP);
+
+	while (1)
+	{
+		periodic_wait(&xFilter);
+
+		/* CYCCNT is running for the run-time stats. */
+		ulStart = DWT->CYCCNT;
+
+		while ((DWT->CYCCNT - ulStart) < ((SystemCoreClock / 1000000U) * FILTER_WORK_US))
+		{
+			/* Filter */
+		}
+	}
+}
+
+/**
+ * @brief Prints whether the EDF task set is schedulable, then the timing of
+ * the control loop and the filter every 10 s.
+ * @retval None
+ */
+void vTimingReportTask(void *pvParameters)
+{
+	/* Worst-case execution times with some margin, deadlines at the periods. */
+	static const PeriodicSpec_t xEdfTasks[] =
+	{
+		{ CONTROL_WCET_US, CONTROL_PERIOD_TICKS * 1000U, CONTROL_PERIOD_TICKS * 1000U },
+		{ FILTER_WCET_US, FILTER_PERIOD_TICKS * 1000U, FILTER_PERIOD_TICKS * 1000U },
+	};
+	uint32_t ulDensityPpm;
+	BaseType_t xSchedulable;
+
+	xSchedulable = periodic_edf_schedulable(xEdfTasks, sizeof(xEdfTasks) / sizeof(xEdfTasks[0]),
+			&ulDensityPpm);
+	printf("EDF band: density %lu.%04lu, %s\r\n", ulDensityPpm / 1000000U,
+			(ulDensityPpm % 1000000U) / 100U, (xSchedulable != pdFALSE) ? "schedulable" : "NOT schedulable");
+
+#if (RM_ADVICE == 1)
+	/* Measure the jobs from here on. */
+	rmprio_start();
+#endif
+
+	while (1)
+	{
+		vTaskDelay(TIMING_REPORT_PERIOD_TICKS);
+		periodic_print(&xControlLoop, "Control Loop");
+		periodic_print(&xFilter, "Filter");
+		vPrintBudget(xRedTask, "Red");
+		vPrintBudget(xBlueTask, "Blue");
+#if (RM_ADVICE == 1)
+		vPriorityAdvice();
+#endif
+	}
+}
+
+#if (RM_ADVICE == 1)
+/**
+ * @brief Prints the rate monotonic priorities of the periodic tasks under the
+ * EDF band, and applies them once with RM_APPLY.
+ * @retval None
+ * @note Tasks that never block, as Red, are not periodic and keep their
+ * priority. Blue is released each time its budget period resumes it.
+ */
+static void vPriorityAdvice(void)
+{
+	static RmprioAdvice_t xAdvice[RM_MAX_ADVICE];
+	static BaseType_t xApplied = pdFALSE;
+	RmprioSummary_t xSummary;
+	UBaseType_t uxCount;
+
+	uxCount = rmprio_evaluate(RMPRIO_RATE_MONOTONIC, RM_LOWEST_PRIORITY, RM_HIGHEST_PRIORITY,
+			xAdvice, RM_MAX_ADVICE, &xSummary);
+	rmprio_print(xAdvice, uxCount, &xSummary);
+
+	if ((RM_APPLY == 1) && (xApplied == pdFALSE) && (xSummary.xSchedulable != pdFALSE))
+	{
+		rmprio_apply(xAdvice, uxCount);
+		xApplied = pdTRUE;
+		printf("Priorities: advice applied\r\n");
+	}
+}
+#endif
+
+/**
+ * @brief Prints the CPU budget of a task and how often it ran out.
+ * @param xTask The task.
+ * @param pcName The name to print.
+ * @retval None
+ */
+static void vPrintBudget(TaskHandle_t xTask, const char *pcName)
+{
+	TaskBudgetStatus_t xStatus;
+	const uint32_t ulCyclesPerUs = SystemCoreClock / 1000000U;
+
+	vTaskGetBudget(xTask, &xStatus);
+
+	if (xStatus.ulBudget == 0)
+	{
+		printf("%s: no budget\r\n", pcName);
+		return;
+	}
+
+	printf("%s: budget %lu us per %lu ms, used %lu us, %lu overruns%s\r\n", pcName,
+			(uint32_t)(xStatus.ulBudget / ulCyclesPerUs),
+			(uint32_t)(xStatus.xPeriod * portTICK_PERIOD_MS),
+			(uint32_t)(xStatus.ulUsed / ulCyclesPerUs), xStatus.ulOverruns,
+			(xStatus.xThrottled != pdFALSE) ? ", throttled" : "");
+}
+
 /**
  * @brief A sample task handler to increment its profiler.
  * @retval Nonee
  */
 void vRedLedControllerTask(void *pvParameters)
 {
+#if (BUSY_BUDGETS == 1)
+	/* The run-time stats clock counts CPU cycles. */
+	vTaskSetBudget(NULL, (configRUN_TIME_COUNTER_TYPE)(SystemCoreClock / 1000000U) * BUSY_BUDGET_US,
+			BUSY_PERIOD_TICKS, eTaskBudgetDemote);
+#endif
+
 	while (1)
 	{
 		uRedTaskProfiler++;
@@ -121,6 +342,11 @@ void vRedLedControllerTask(void *pvParameters)
  */
 void vBlueLedControllerTask(void *pvParameters)
 {
+#if (BUSY_BUDGETS == 1)
+	vTaskSetBudget(NULL, (configRUN_TIME_COUNTER_TYPE)(SystemCoreClock / 1000000U) * BUSY_BUDGET_US,
+			BUSY_PERIOD_TICKS, eTaskBudgetSuspend);
+#endif
+
 	while (1)
 	{
 		uBlueTaskProfiler++;
@@ -146,44 +372,9 @@ int __io_putchar(int ch)
  */
 void SystemClock_Config(void)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
-
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-	{
-		Error_Handler();
-	}
-
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
@@ -0,0 +1,488 @@
+/*******************************************************************************
+ *
+ * @file	rmprio.c
+ * @brief	Implementation of the rate monotonic priority advisor.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	Derives task priorities from what the tasks were measured to do,
+ * 			instead of the numbers they were created with. rmprio_start()
+ * 			clears the job statistics of every task (configUSE_JOB_STATS)
+ * 			when the measurement begins; rmprio_evaluate(), at any time
+ * 			after, turns them into advice for the tasks whose base priority
+ * 			is in a managed range:
+ *
+ * 				period		the shortest time between two releases,
+ * 				execution	the longest job, preemptions left out,
+ * 				deadline	rmprio_set_deadline(), else the period.
+ *
+ * 			A task with fewer than RMPRIO_MIN_JOBS releases, such as one
+ * 			that never blocks or waits for something that did not happen,
+ * 			is not periodic and keeps its priority.
+ *
+ * 			The periodic tasks of the range are ordered by period (rate
+ * 			monotonic) or by deadline (deadline monotonic), and given the
+ * 			priorities of the range from the top, one per distinct period
+ * 			or deadline. When there are more of them than priorities, the
+ * 			last ones share the lowest.
+ *
+ * 			The task set is then checked two ways:
+ *
+ * 				bound		the utilisation against n(2^(1/n) - 1), the
+ * 							Liu and Layland bound: below it, rate
+ * 							monotonic meets every deadline at the period.
+ * 				response	the worst-case response time of each task at
+ * 							its advised priority, by response time
+ * 							analysis, against its deadline. Exact for
+ * 							independent tasks, so a set over the bound may
+ * 							still be schedulable.
+ *
+ * 			Periodic tasks above the range are counted as interference at
+ * 			their own priorities; tasks of equal priority as interfering
+ * 			with each other. Blocking on mutexes, interrupts and the
+ * 			kernel are not counted: they come out of the measured execution
+ * 			times only in part, so leave some margin.
+ *
+ * 			rmprio_apply() sets the advised priorities with
+ * 			vTaskPrioritySet().
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rmprio.h"
+
+#if (configUSE_JOB_STATS == 1) && (configUSE_TRACE_FACILITY == 1)
+
+/* Macros --------------------------------------------------------------------*/
+#define RMPRIO_PPM 1000000U
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	TaskHandle_t xTask;
+	uint32_t ulDeadlineUs;
+} RmprioDeadline_t;
+
+/* A periodic task, in the range or above it. */
+typedef struct
+{
+	const char *pcName;
+	TaskHandle_t xHandle;
+	UBaseType_t uxPriority;
+	UBaseType_t uxLevel;			/* Advised in the range, uxPriority above it. */
+	uint32_t ulPeriodUs;
+	uint32_t ulDeadlineUs;
+	uint32_t ulExecUs;
+	uint8_t ucManaged;				/* In the range. */
+} RmprioTask_t;
+
+/* Variables -----------------------------------------------------------------*/
+/* Off the callers' stacks; one caller at a time. */
+static TaskStatus_t xStatus[RMPRIO_MAX_TASKS];
+static RmprioTask_t xTasks[RMPRIO_MAX_TASKS];
+static RmprioDeadline_t xDeadlines[RMPRIO_MAX_TASKS];
+
+/* n(2^(1/n) - 1) in ppm for n = 1 to 10, then ln 2, the limit it decreases to. */
+static const uint32_t ulBoundPpm[] =
+{
+	1000000U, 828427U, 779763U, 756828U, 743492U,
+	734772U, 728627U, 724062U, 720538U, 717735U
+};
+#define RMPRIO_BOUND_LIMIT_PPM 693147U
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t rmprio_collect(UBaseType_t uxLowest, UBaseType_t uxHighest);
+static uint32_t rmprio_deadline(TaskHandle_t xTask, uint32_t ulPeriodUs);
+static uint32_t rmprio_key(const RmprioTask_t *pxTask, RmprioPolicy_t ePolicy);
+static void rmprio_rank(uint32_t ulCount, RmprioPolicy_t ePolicy, UBaseType_t uxLowest,
+		UBaseType_t uxHighest, uint8_t *pucOrder, uint32_t *pulManaged);
+static uint32_t rmprio_response(uint32_t ulCount, uint32_t ulTask);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Starts a measurement: clears the job statistics of every task.
+ * @param None
+ * @retval None
+ * @note Jobs in progress are not counted. Let every task run
+ * RMPRIO_MIN_JOBS periods, at its worst, before rmprio_evaluate().
+ */
+void rmprio_start(void)
+{
+	UBaseType_t uxCount = uxTaskGetSystemState(xStatus, RMPRIO_MAX_TASKS, NULL);
+	UBaseType_t ux;
+
+	for (ux = 0; ux < uxCount; ux++)
+	{
+		vTaskResetJobStats(xStatus[ux].xHandle);
+	}
+}
+
+/**
+ * @brief Gives a task a deadline shorter than its period, for
+ * RMPRIO_DEADLINE_MONOTONIC.
+ * @param xTask The task.
+ * @param ulDeadlineUs From the release, 0 to use the period again.
+ * @retval 0 on success, -1 if RMPRIO_MAX_TASKS tasks have deadlines.
+ */
+int32_t rmprio_set_deadline(TaskHandle_t xTask, uint32_t ulDeadlineUs)
+{
+	RmprioDeadline_t *pxFree = NULL;
+	uint32_t i;
+
+	for (i = 0U; i < RMPRIO_MAX_TASKS; i++)
+	{
+		if (xDeadlines[i].xTask == xTask)
+		{
+			pxFree = &xDeadlines[i];
+			break;
+		}
+
+		if ((pxFree == NULL) && (xDeadlines[i].xTask == NULL))
+		{
+			pxFree = &xDeadlines[i];
+		}
+	}
+
+	if (pxFree == NULL)
+	{
+		return -1;
+	}
+
+	pxFree->xTask = (ulDeadlineUs != 0U) ? xTask : NULL;
+	pxFree->ulDeadlineUs = ulDeadlineUs;
+
+	return 0;
+}
+
+/**
+ * @brief Advises a priority for each periodic task whose base priority is in
+ * a range, and checks the resulting task set.
+ * @param ePolicy Order by period or by deadline.
+ * @param uxLowest Lowest priority of the range; above the idle priority.
+ * @param uxHighest Highest priority of the range.
+ * @param pxAdvice Receives the advice, highest priority first.
+ * @param uxSize Entries pxAdvice holds.
+ * @param pxSummary Receives the utilisation and the verdict; may be NULL.
+ * @retval Entries written.
+ * @note Task context. Suspends the scheduler while the tasks are listed.
+ */
+UBaseType_t rmprio_evaluate(RmprioPolicy_t ePolicy, UBaseType_t uxLowest, UBaseType_t uxHighest,
+		RmprioAdvice_t *pxAdvice, UBaseType_t uxSize, RmprioSummary_t *pxSummary)
+{
+	uint8_t ucOrder[RMPRIO_MAX_TASKS];
+	uint32_t ulCount;
+	uint32_t ulManaged;
+	uint32_t ulUtilisation = 0U;
+	uint32_t ulMisses = 0U;
+	uint32_t ulResponse;
+	RmprioTask_t *pxTask;
+	UBaseType_t uxWritten = 0;
+	uint32_t i;
+
+	configASSERT((uxLowest <= uxHighest) && (uxHighest < configMAX_PRIORITIES));
+
+	ulCount = rmprio_collect(uxLowest, uxHighest);
+	rmprio_rank(ulCount, ePolicy, uxLowest, uxHighest, ucOrder, &ulManaged);
+
+	for (i = 0U; i < ulCount; i++)
+	{
+		ulUtilisation += (uint32_t)(((uint64_t)xTasks[i].ulExecUs * RMPRIO_PPM) / xTasks[i].ulPeriodUs);
+	}
+
+	for (i = 0U; i < ulManaged; i++)
+	{
+		pxTask = &xTasks[ucOrder[i]];
+		ulResponse = rmprio_response(ulCount, ucOrder[i]);
+
+		if (ulResponse == 0U)
+		{
+			ulMisses++;
+		}
+
+		if (uxWritten < uxSize)
+		{
+			pxAdvice[uxWritten].pcName = pxTask->pcName;
+			pxAdvice[uxWritten].xHandle = pxTask->xHandle;
+			pxAdvice[uxWritten].ulPeriodUs = pxTask->ulPeriodUs;
+			pxAdvice[uxWritten].ulDeadlineUs = pxTask->ulDeadlineUs;
+			pxAdvice[uxWritten].ulExecUs = pxTask->ulExecUs;
+			pxAdvice[uxWritten].ulResponseUs = ulResponse;
+			pxAdvice[uxWritten].uxPriority = pxTask->uxPriority;
+			pxAdvice[uxWritten].uxAdvised = pxTask->uxLevel;
+			uxWritten++;
+		}
+	}
+
+	if (pxSummary != NULL)
+	{
+		pxSummary->ulTasks = ulCount;
+		pxSummary->ulUtilisationPpm = ulUtilisation;
+		pxSummary->ulBoundPpm = (ulCount == 0U) ? RMPRIO_PPM
+				: (ulCount <= (sizeof(ulBoundPpm) / sizeof(ulBoundPpm[0])))
+						? ulBoundPpm[ulCount - 1U] : RMPRIO_BOUND_LIMIT_PPM;
+		pxSummary->ulMisses = ulMisses;
+		pxSummary->xSchedulable = (ulMisses == 0U) ? pdTRUE : pdFALSE;
+	}
+
+	return uxWritten;
+}
+
+/**
+ * @brief Sets the advised priorities.
+ * @param pxAdvice Advice from rmprio_evaluate().
+ * @param uxCount Its entries.
+ * @retval None
+ * @note A task holding a mutex keeps an inherited priority until it gives
+ * the mutex back; a budgeted task demoted for an overrun gets the advised
+ * priority at the end of its period.
+ */
+void rmprio_apply(const RmprioAdvice_t *pxAdvice, UBaseType_t uxCount)
+{
+	UBaseType_t ux;
+
+	for (ux = 0; ux < uxCount; ux++)
+	{
+		if (pxAdvice[ux].uxAdvised != pxAdvice[ux].uxPriority)
+		{
+			vTaskPrioritySet(pxAdvice[ux].xHandle, pxAdvice[ux].uxAdvised);
+		}
+	}
+}
+
+/**
+ * @brief Prints the advice and the verdict with printf().
+ * @param pxAdvice Advice from rmprio_evaluate().
+ * @param uxCount Its entries.
+ * @param pxSummary The summary from the same call.
+ * @retval None
+ */
+void rmprio_print(const RmprioAdvice_t *pxAdvice, UBaseType_t uxCount,
+		const RmprioSummary_t *pxSummary)
+{
+	UBaseType_t ux;
+
+	printf("Priorities: %lu periodic tasks, utilisation %lu.%04lu, bound %lu.%04lu, %s\r\n",
+			pxSummary->ulTasks,
+			pxSummary->ulUtilisationPpm / RMPRIO_PPM, (pxSummary->ulUtilisationPpm % RMPRIO_PPM) / 100U,
+			pxSummary->ulBoundPpm / RMPRIO_PPM, (pxSummary->ulBoundPpm % RMPRIO_PPM) / 100U,
+			(pxSummary->xSchedulable != pdFALSE) ? "schedulable" : "NOT schedulable");
+	printf("  %-*s %9s %9s %9s %9s %5s\r\n", configMAX_TASK_NAME_LEN, "Task",
+			"Period", "Exec", "Deadline", "Response", "Prio");
+
+	for (ux = 0; ux < uxCount; ux++)
+	{
+		printf("  %-*.*s %9lu %9lu %9lu ", configMAX_TASK_NAME_LEN, configMAX_TASK_NAME_LEN,
+				pxAdvice[ux].pcName, pxAdvice[ux].ulPeriodUs, pxAdvice[ux].ulExecUs,
+				pxAdvice[ux].ulDeadlineUs);
+
+		if (pxAdvice[ux].ulResponseUs != 0U)
+		{
+			printf("%9lu", pxAdvice[ux].ulResponseUs);
+		}
+		else
+		{
+			printf("%9s", "miss");
+		}
+
+		printf(" %2lu->%lu\r\n", (uint32_t)pxAdvice[ux].uxPriority, (uint32_t)pxAdvice[ux].uxAdvised);
+	}
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Lists the periodic tasks at or above uxLowest in xTasks[].
+ * @param uxLowest Lowest priority of the range.
+ * @param uxHighest Highest priority of the range.
+ * @retval Tasks listed.
+ */
+static uint32_t rmprio_collect(UBaseType_t uxLowest, UBaseType_t uxHighest)
+{
+	UBaseType_t uxCount = uxTaskGetSystemState(xStatus, RMPRIO_MAX_TASKS, NULL);
+	const uint32_t ulCountsPerUs = RMPRIO_COUNTS_PER_US;
+	TaskJobStats_t xJobs;
+	RmprioTask_t *pxTask;
+	uint32_t ulCount = 0U;
+	UBaseType_t ux;
+
+	for (ux = 0; ux < uxCount; ux++)
+	{
+		if (xStatus[ux].uxBasePriority < uxLowest)
+		{
+			continue;
+		}
+
+		vTaskGetJobStats(xStatus[ux].xHandle, &xJobs);
+
+		if ((xJobs.ulJobs < RMPRIO_MIN_JOBS) || (xJobs.ulJobsDone == 0U)
+				|| ((xJobs.ulPeriodMin / ulCountsPerUs) == 0U))
+		{
+			continue;
+		}
+
+		pxTask = &xTasks[ulCount++];
+		pxTask->pcName = xStatus[ux].pcTaskName;
+		pxTask->xHandle = xStatus[ux].xHandle;
+		pxTask->uxPriority = xStatus[ux].uxBasePriority;
+		pxTask->uxLevel = xStatus[ux].uxBasePriority;
+		pxTask->ulPeriodUs = (uint32_t)(xJobs.ulPeriodMin / ulCountsPerUs);
+		pxTask->ulExecUs = (uint32_t)((xJobs.ulExecMax + ulCountsPerUs - 1U) / ulCountsPerUs);
+
+		if (pxTask->ulExecUs == 0U)
+		{
+			pxTask->ulExecUs = 1U;
+		}
+
+		pxTask->ulDeadlineUs = rmprio_deadline(pxTask->xHandle, pxTask->ulPeriodUs);
+		pxTask->ucManaged = (xStatus[ux].uxBasePriority <= uxHighest) ? 1U : 0U;
+	}
+
+	return ulCount;
+}
+
+/**
+ * @brief Returns the deadline of a task.
+ * @param xTask The task.
+ * @param ulPeriodUs Its period.
+ * @retval The deadline set for it, or its period.
+ */
+static uint32_t rmprio_deadline(TaskHandle_t xTask, uint32_t ulPeriodUs)
+{
+	uint32_t i;
+
+	for (i = 0U; i < RMPRIO_MAX_TASKS; i++)
+	{
+		if (xDeadlines[i].xTask == xTask)
+		{
+			return xDeadlines[i].ulDeadlineUs;
+		}
+	}
+
+	return ulPeriodUs;
+}
+
+/**
+ * @brief Returns what a task is ordered by.
+ * @param pxTask The task.
+ * @param ePolicy Order by period or by deadline.
+ * @retval Its period or its deadline, in microseconds.
+ */
+static uint32_t rmprio_key(const RmprioTask_t *pxTask, RmprioPolicy_t ePolicy)
+{
+	return (ePolicy == RMPRIO_DEADLINE_MONOTONIC) ? pxTask->ulDeadlineUs : pxTask->ulPeriodUs;
+}
+
+/**
+ * @brief Orders the tasks of the range and gives them their levels.
+ * @param ulCount Tasks in xTasks[].
+ * @param ePolicy Order by period or by deadline.
+ * @param uxLowest Lowest priority of the range.
+ * @param uxHighest Highest priority of the range.
+ * @param pucOrder Receives the indexes of the tasks of the range, highest
+ * priority first.
+ * @param pulManaged Receives how many there are.
+ * @retval None
+ * @note Ties keep the order of the current priorities, highest first, so
+ * that equal tasks move as little as possible.
+ */
+static void rmprio_rank(uint32_t ulCount, RmprioPolicy_t ePolicy, UBaseType_t uxLowest,
+		UBaseType_t uxHighest, uint8_t *pucOrder, uint32_t *pulManaged)
+{
+	uint32_t ulManaged = 0U;
+	uint32_t ulKey;
+	uint32_t ulPrevKey = 0U;
+	UBaseType_t uxLevel = uxHighest;
+	RmprioTask_t *pxTask;
+	uint32_t i;
+	uint32_t j;
+
+	for (i = 0U; i < ulCount; i++)
+	{
+		if (xTasks[i].ucManaged == 0U)
+		{
+			continue;
+		}
+
+		ulKey = rmprio_key(&xTasks[i], ePolicy);
+
+		/* Insertion sort: there are at most RMPRIO_MAX_TASKS. */
+		for (j = ulManaged; j > 0U; j--)
+		{
+			pxTask = &xTasks[pucOrder[j - 1U]];
+
+			if ((rmprio_key(pxTask, ePolicy) < ulKey)
+					|| ((rmprio_key(pxTask, ePolicy) == ulKey)
+							&& (pxTask->uxPriority >= xTasks[i].uxPriority)))
+			{
+				break;
+			}
+
+			pucOrder[j] = pucOrder[j - 1U];
+		}
+
+		pucOrder[j] = (uint8_t)i;
+		ulManaged++;
+	}
+
+	for (i = 0U; i < ulManaged; i++)
+	{
+		pxTask = &xTasks[pucOrder[i]];
+		ulKey = rmprio_key(pxTask, ePolicy);
+
+		if ((i > 0U) && (ulKey != ulPrevKey) && (uxLevel > uxLowest))
+		{
+			uxLevel--;
+		}
+
+		pxTask->uxLevel = uxLevel;
+		ulPrevKey = ulKey;
+	}
+
+	*pulManaged = ulManaged;
+}
+
+/**
+ * @brief Worst-case response time of a task at its level, by response time
+ * analysis: R = C + sum over the others at or above its level of
+ * ceil(R / T) * C, iterated from R = C until it settles.
+ * @param ulCount Tasks in xTasks[].
+ * @param ulTask Index of the task.
+ * @retval The response time in microseconds, or 0 if it exceeds the
+ * deadline.
+ */
+static uint32_t rmprio_response(uint32_t ulCount, uint32_t ulTask)
+{
+	const RmprioTask_t *pxTask = &xTasks[ulTask];
+	uint64_t ullResponse = pxTask->ulExecUs;
+	uint64_t ullNext;
+	uint32_t i;
+
+	while (ullResponse <= pxTask->ulDeadlineUs)
+	{
+		ullNext = pxTask->ulExecUs;
+
+		for (i = 0U; i < ulCount; i++)
+		{
+			if ((i != ulTask) && (xTasks[i].uxLevel >= pxTask->uxLevel))
+			{
+				ullNext += ((ullResponse + xTasks[i].ulPeriodUs - 1U) / xTasks[i].ulPeriodUs)
+						* xTasks[i].ulExecUs;
+			}
+		}
+
+		if (ullNext == ullResponse)
+		{
+			return (uint32_t)ullResponse;
+		}
+
+		ullResponse = ullNext;
+	}
+
+	return 0U;
+}
+
+#endif /* configUSE_JOB_STATS && configUSE_TRACE_FACILITY */
@@ -0,0 +1,311 @@
+/*******************************************************************************
+ *
+ * @file	stackwatch.c
+ * @brief	Stack usage watcher: peak use of every task stack and of the main
+ * 			stack (MSP), with a recommended depth for each.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Needs, in 'FreeRTOSConfig.h':
+ *
+ * 				configUSE_TRACE_FACILITY 1
+ * 				INCLUDE_uxTaskGetStackHighWaterMark 1
+ * 				configRECORD_STACK_HIGH_ADDRESS 1	(for uxTaskGetStackDepth())
+ *
+ * 			Task stacks are filled with tskSTACK_FILL_BYTE when they are
+ * 			created, so the high water mark is the peak use since then. The
+ * 			MSP is used by main() before the scheduler starts and by every
+ * 			exception after it; the startup code fills the _Min_Stack_Size
+ * 			bytes below _estack with STACKWATCH_MSP_FILL before anything runs,
+ * 			and stackwatch_print() counts the words still holding it.
+ *
+ * 			With configUSE_TASK_SNAPSHOTS, stackwatch_sample() takes
+ * 			STACKWATCH_SNAPSHOT_TASKS tasks per scheduler suspension instead
+ * 			of all of them at once, as the stack scans are long.
+ *
+ * 			The peaks are kept in a table, so a deleted task stays in the
+ * 			report with its last values. A recommendation is only as good as
+ * 			the run behind it: let every task reach its deepest call path
+ * 			(error paths included) before trimming a stack to it.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stackwatch.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define STACKWATCH_MSP_FILL		0xA5A5A5A5UL	/* Must match the startup code. */
+#define STACKWATCH_ROUND_WORDS	8U				/* Recommendations are multiples. */
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	TaskHandle_t xHandle;
+	char cName[configMAX_TASK_NAME_LEN];
+	uint32_t ulDepth;		/* Words. */
+	uint32_t ulPeakUsed;	/* Words. */
+} StackWatchEntry_t;
+
+/* Variables -----------------------------------------------------------------*/
+extern uint32_t _estack;			/* Top of the main stack (linker script). */
+extern uint32_t _Min_Stack_Size;	/* Its size in bytes, as an address. */
+
+static StackWatchEntry_t xStackWatchTable[STACKWATCH_MAX_TASKS];
+static uint32_t ulStackWatchEntries = 0;
+static TaskStatus_t xStackWatchStatus[STACKWATCH_MAX_TASKS];
+
+/* Private function prototypes -----------------------------------------------*/
+static void stackwatch_update(const TaskStatus_t *pxStatus, UBaseType_t uxTasks);
+static StackWatchEntry_t *stackwatch_find_entry(const TaskStatus_t *pxStatus);
+static uint32_t stackwatch_recommend(uint32_t ulUsed);
+static uint32_t stackwatch_msp_used(uint32_t *pulDepth);
+static void stackwatch_reporter_task(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Updates the peak use of every task currently alive.
+ * @param None
+ * @retval None
+ * @note Suspends the scheduler while the task list is walked, or only for
+ * STACKWATCH_SNAPSHOT_TASKS tasks at a time with configUSE_TASK_SNAPSHOTS.
+ * Does not allocate.
+ */
+void stackwatch_sample(void)
+{
+	UBaseType_t uxTasks;
+#if (configUSE_TASK_SNAPSHOTS == 1)
+	TaskSnapshot_t xSnapshot;
+
+	/* A walk cut short by a task being created or deleted is left as it
+	 * is: the next sample covers the tasks it missed. */
+	vTaskSnapshotStart(&xSnapshot);
+
+	while ((uxTasks = uxTaskSnapshotNext(&xSnapshot, xStackWatchStatus,
+			STACKWATCH_SNAPSHOT_TASKS, pdTRUE)) > 0U)
+	{
+		stackwatch_update(xStackWatchStatus, uxTasks);
+	}
+#else
+	/* Returns 0 if there are more tasks than entries. */
+	uxTasks = uxTaskGetSystemState(xStackWatchStatus, STACKWATCH_MAX_TASKS, NULL);
+
+	if (uxTasks == 0U)
+	{
+		printf("Error: More than %u tasks to watch.\r\n", (unsigned int)STACKWATCH_MAX_TASKS);
+		return;
+	}
+
+	stackwatch_update(xStackWatchStatus, uxTasks);
+#endif
+}
+
+/**
+ * @brief Samples, then prints the depth, peak use and recommended depth of
+ * every task stack and of the MSP over USART2.
+ * @param None
+ * @retval None
+ * @note All figures are in words. The recommendation is the peak plus
+ * STACKWATCH_MARGIN_PERCENT (at least STACKWATCH_MARGIN_MIN_WORDS), rounded up
+ * to STACKWATCH_ROUND_WORDS.
+ */
+void stackwatch_print(void)
+{
+	uint32_t ulTotalDepth = 0;
+	uint32_t ulTotalRecommended = 0;
+	uint32_t ulRecommended;
+	uint32_t ulMspDepth;
+	uint32_t ulMspUsed;
+	uint32_t i;
+
+	stackwatch_sample();
+
+	printf("%-*s %6s %6s %6s\r\n", configMAX_TASK_NAME_LEN, "Stack", "Depth", "Peak", "Rec");
+
+	for (i = 0; i < ulStackWatchEntries; i++)
+	{
+		ulRecommended = stackwatch_recommend(xStackWatchTable[i].ulPeakUsed);
+		ulTotalDepth += xStackWatchTable[i].ulDepth;
+		ulTotalRecommended += ulRecommended;
+
+		printf("%-*s %6lu %6lu %6lu%s\r\n",
+				configMAX_TASK_NAME_LEN,
+				xStackWatchTable[i].cName,
+				xStackWatchTable[i].ulDepth,
+				xStackWatchTable[i].ulPeakUsed,
+				ulRecommended,
+				(ulRecommended > xStackWatchTable[i].ulDepth) ? " (grow)" : "");
+	}
+
+	printf("%-*s %6lu %6s %6lu (%ld words to reclaim)\r\n", configMAX_TASK_NAME_LEN, "Tasks total",
+			ulTotalDepth, "", ulTotalRecommended, (int32_t)(ulTotalDepth - ulTotalRecommended));
+
+	/* Per task RAM besides the stack; the layout is set by configUSE_LEAN_TCB. */
+	printf("TCB (%s layout): %u bytes x %lu tasks = %lu bytes\r\n",
+			(configUSE_LEAN_TCB == 1) ? "lean" : "full",
+			(unsigned)sizeof(StaticTask_t),
+			(uint32_t)uxTaskGetNumberOfTasks(),
+			(uint32_t)(sizeof(StaticTask_t) * uxTaskGetNumberOfTasks()));
+
+	/* Reported apart: the MSP is sized by _Min_Stack_Size, not xTaskCreate(). */
+	ulMspUsed = stackwatch_msp_used(&ulMspDepth);
+	ulRecommended = stackwatch_recommend(ulMspUsed);
+
+	printf("%-*s %6lu %6lu %6lu%s\r\n",
+			configMAX_TASK_NAME_LEN,
+			"MSP (ISRs)",
+			ulMspDepth,
+			ulMspUsed,
+			ulRecommended,
+			(ulMspUsed >= ulMspDepth) ? " (full, may have overflowed)" :
+			(ulRecommended > ulMspDepth) ? " (grow)" : "");
+}
+
+/**
+ * @brief Creates a task that prints the stack report periodically.
+ * @param ulPeriodMs Print period in milliseconds.
+ * @param uxPriority Priority of the reporter task. Above the tasks being
+ * watched if they never block.
+ * @retval pdPASS if the task was created.
+ * @note The reporter's own stack is in the report as well.
+ */
+BaseType_t stackwatch_start_reporter(uint32_t ulPeriodMs, UBaseType_t uxPriority)
+{
+	return xTaskCreate(stackwatch_reporter_task,
+					   "StackWatch",
+					   STACKWATCH_REPORTER_STACK_WORDS,
+					   (void *)ulPeriodMs,
+					   uxPriority,
+					   NULL);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Updates the peak use of the tasks given.
+ * @param pxStatus Their status, with the high water marks.
+ * @param uxTasks Number of tasks.
+ * @retval None
+ */
+static void stackwatch_update(const TaskStatus_t *pxStatus, UBaseType_t uxTasks)
+{
+	StackWatchEntry_t *pxEntry;
+	UBaseType_t x;
+	uint32_t ulUsed;
+
+	for (x = 0; x < uxTasks; x++)
+	{
+		pxEntry = stackwatch_find_entry(&pxStatus[x]);
+
+		if (pxEntry == NULL)
+		{
+			continue;
+		}
+
+		ulUsed = pxEntry->ulDepth - pxStatus[x].usStackHighWaterMark;
+
+		if (ulUsed > pxEntry->ulPeakUsed)
+		{
+			pxEntry->ulPeakUsed = ulUsed;
+		}
+	}
+}
+
+/**
+ * @brief Returns the table entry of a task, adding one for a new task.
+ * @param pxStatus Status of the task from uxTaskGetSystemState() or
+ * uxTaskSnapshotNext().
+ * @retval Entry, NULL if the table is full.
+ * @note A new task can reuse the TCB of a deleted one, so an entry is matched
+ * by name as well as by handle.
+ */
+static StackWatchEntry_t *stackwatch_find_entry(const TaskStatus_t *pxStatus)
+{
+	StackWatchEntry_t *pxEntry;
+	uint32_t i;
+
+	for (i = 0; i < ulStackWatchEntries; i++)
+	{
+		pxEntry = &xStackWatchTable[i];
+
+		if ((pxEntry->xHandle == pxStatus->xHandle) &&
+			(strncmp(pxEntry->cName, pxStatus->pcTaskName, configMAX_TASK_NAME_LEN) == 0))
+		{
+			return pxEntry;
+		}
+	}
+
+	if (ulStackWatchEntries >= STACKWATCH_MAX_TASKS)
+	{
+		return NULL;
+	}
+
+	pxEntry = &xStackWatchTable[ulStackWatchEntries++];
+	pxEntry->xHandle = pxStatus->xHandle;
+	strncpy(pxEntry->cName, pxStatus->pcTaskName, configMAX_TASK_NAME_LEN - 1U);
+	pxEntry->cName[configMAX_TASK_NAME_LEN - 1U] = '\0';
+	pxEntry->ulDepth = uxTaskGetStackDepth(pxStatus->xHandle);
+	pxEntry->ulPeakUsed = 0;
+
+	return pxEntry;
+}
+
+/**
+ * @brief Returns the recommended depth for a peak use.
+ * @param ulUsed Peak use in words.
+ * @retval Recommended depth in words.
+ */
+static uint32_t stackwatch_recommend(uint32_t ulUsed)
+{
+	uint32_t ulMargin = (ulUsed * STACKWATCH_MARGIN_PERCENT) / 100U;
+
+	if (ulMargin < STACKWATCH_MARGIN_MIN_WORDS)
+	{
+		ulMargin = STACKWATCH_MARGIN_MIN_WORDS;
+	}
+
+	return ((ulUsed + ulMargin + STACKWATCH_ROUND_WORDS - 1U) / STACKWATCH_ROUND_WORDS) * STACKWATCH_ROUND_WORDS;
+}
+
+/**
+ * @brief Returns the peak use of the main stack since reset.
+ * @param pulDepth Receives the size of the main stack in words.
+ * @retval Peak use in words.
+ * @note The MSP grows down from _estack, so the fill still intact at the
+ * bottom of the area is what was never reached.
+ */
+static uint32_t stackwatch_msp_used(uint32_t *pulDepth)
+{
+	const uint32_t ulDepth = (uint32_t)&_Min_Stack_Size / sizeof(uint32_t);
+	const uint32_t *pulWord = &_estack - ulDepth;
+	uint32_t ulUntouched = 0;
+
+	while ((ulUntouched < ulDepth) && (pulWord[ulUntouched] == STACKWATCH_MSP_FILL))
+	{
+		ulUntouched++;
+	}
+
+	*pulDepth = ulDepth;
+
+	return ulDepth - ulUntouched;
+}
+
+/**
+ * @brief Prints the stack report every period.
+ * @param pvParameters Print period in milliseconds.
+ * @retval None
+ */
+static void stackwatch_reporter_task(void *pvParameters)
+{
+	const TickType_t xPeriodTicks = pdMS_TO_TICKS((uint32_t)pvParameters);
+	TickType_t xLastWakeTicks = xTaskGetTickCount();
+
+	while (1)
+	{
+		vTaskDelayUntil(&xLastWakeTicks, xPeriodTicks);
+		stackwatch_print();
+	}
+}
@@ -45,6 +45,22 @@ defined in linker script */
 .word  _ebss
 /* stack used for SystemInit_ExtMemCtl; always internal RAM used */
 
+/* DWT cycle count at the end of each start-up phase: SystemInit(), the .data
+ * copy, the .bss clear and the constructors. Kept in .noinit, as the stamps
+ * are taken before .bss is cleared; bootprof.c reads them. */
+  .section  .noinit.g_ulBootStamps,"aw",%nobits
+  .align 2
+  .global  g_ulBootStamps
+g_ulBootStamps:
+  .space 16
+
+.macro BOOT_STAMP index
+  ldr r0, =0xE0001004     /* DWT->CYCCNT */
+  ldr r1, [r0]
+  ldr r0, =g_ulBootStamps
+  str r1, [r0, #(\index * 4)]
+.endm
+
 /**
  * @brief  This is the code that gets called when the processor first
  *          starts execution following a reset event. Only the absolutely
@@ -59,43 +75,96 @@ defined in linker script */
   .type  Reset_Handler, %function
 Reset_Handler:  
   ldr   sp, =_estack      /* set stack pointer */
+
+/* Start the DWT cycle counter from 0, so the start-up can be timed from
+ * reset (bootprof.c). The debug domain keeps its state across a system
+ * reset, hence the explicit clear. */
+  ldr r0, =0xE000EDFC     /* CoreDebug->DEMCR */
+  ldr r1, [r0]
+  orr r1, r1, #0x01000000 /* TRCENA */
+  str r1, [r0]
+  ldr r0, =0xE0001000     /* DWT->CTRL */
+  movs r1, #0
+  str r1, [r0, #4]        /* DWT->CYCCNT */
+  ldr r1, [r0]
+  orr r1, r1, #1          /* CYCCNTENA */
+  str r1, [r0]
+
+/* Fill the main stack with a known pattern so its peak use can be measured
+ * (stackwatch.c). Nothing has been pushed yet. */
+  ldr r0, =_estack
+  ldr r1, =_Min_Stack_Size
+  subs r1, r0, r1
+  ldr r2, =0xA5A5A5A5
+  b LoopFillStack
+
+FillStack:
+  str r2, [r1], #4
+
+LoopFillStack:
+  cmp r1, r0
+  bcc FillStack
   
 /* Call the clock system initialization function.*/
   bl  SystemInit  
+  BOOT_STAMP 0
 
-/* Copy the data segment initializers from flash to SRAM */  
+/* Copy the data segment initializers from flash to SRAM: 16 bytes per
+ * LDM/STM pair, then the remaining words. Both ends are word aligned. */
   ldr r0, =_sdata
   ldr r1, =_edata
   ldr r2, =_sidata
-  movs r3, #0
+  b LoopCopyDataBlock
+
+CopyDataBlock:
+  ldmia r2!, {r3, r4, r5, r6}
+  stmia r0!, {r3, r4, r5, r6}
+
+LoopCopyDataBlock:
+  adds r3, r0, #16
+  cmp r3, r1
+  bls CopyDataBlock
   b LoopCopyDataInit
 
 CopyDataInit:
-  ldr r4, [r2, r3]
-  str r4, [r0, r3]
-  adds r3, r3, #4
+  ldr r3, [r2], #4
+  str r3, [r0], #4
 
 LoopCopyDataInit:
-  adds r4, r0, r3
-  cmp r4, r1
+  cmp r0, r1
   bcc CopyDataInit
-  
-/* Zero fill the bss segment. */
+  BOOT_STAMP 1
+
+/* Zero fill the bss segment, 16 bytes per STM. Buffers that need no
+ * clearing belong in .noinit, which is not touched here. */
   ldr r2, =_sbss
   ldr r4, =_ebss
+  movs r0, #0
+  movs r1, #0
   movs r3, #0
+  movs r5, #0
+  b LoopFillZerobssBlock
+
+FillZerobssBlock:
+  stmia r2!, {r0, r1, r3, r5}
+
+LoopFillZerobssBlock:
+  adds r6, r2, #16
+  cmp r6, r4
+  bls FillZerobssBlock
   b LoopFillZerobss
 
 FillZerobss:
-  str  r3, [r2]
-  adds r2, r2, #4
+  str  r3, [r2], #4
 
 LoopFillZerobss:
   cmp r2, r4
   bcc FillZerobss
+  BOOT_STAMP 2
   
 /* Call static constructors */
     bl __libc_init_array
+  BOOT_STAMP 3
 /* Call the application's entry point.*/
   bl  main
   bx  lr    
@@ -119,12 +119,15 @@ to exclude the API function. */
 #define INCLUDE_uxTaskGetStackHighWaterMark  1
 #define INCLUDE_xTaskGetCurrentTaskHandle    1
 #define INCLUDE_eTaskGetState                1
+#define INCLUDE_xTaskGetTicksToNextWake     1   /* Erase gap of flashlog.c. */
+#define INCLUDE_xTaskGetIdleTaskHandle      1   /* Sleep time of energy.c. */
 
 /*
  * The CMSIS-RTOS V2 FreeRTOS wrapper is dependent on the heap implementation used
  * by the application thus the correct define need to be enabled below
  */
 #define USE_FreeRTOS_HEAP_4
+/* #define USE_FreeRTOS_HEAP_TLSF */	/* Instead of HEAP_4: heap_tlsf.c, O(1) malloc and free */
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -168,6 +171,50 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Port optimised task selection: the CM4F port finds the highest ready
+priority with CLZ on a ready-priority bitmap instead of walking the ready
+lists.  The 56 CMSIS-RTOS2 priorities take a two-level bitmap, so selection is
+two CLZs whatever the priorities in use (see README, Task Selection). */
+#undef configUSE_PORT_OPTIMISED_TASK_SELECTION
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
+/* Tickless idle with a board-specific vPortSuppressTicksAndSleep() (STOP mode
+timed by the RTC wakeup timer, see lowpower.c), hence 2 rather than 1. */
+#define configUSE_TICKLESS_IDLE                  2
+/* HAL_GetTick() follows the RTOS tick: no TIM1 interrupt to end each STOP
+entry within a millisecond (see README, HAL Timebase). */
+#define configUSE_HAL_TIMEBASE_RTOS_TICK         1
+/* Keep delayed tasks in a 16-slot timing wheel; the next wake time is then
+found by walking the wheel before each sleep (see README, Delayed Tasks). */
+#define configUSE_DELAYED_TASK_WHEEL             1
+#define configDELAYED_TASK_WHEEL_SLOTS           16
+/* Run-time stats on the DWT cycle counter, extended to 64 bits (runstats.c). */
+#define configGENERATE_RUN_TIME_STATS            1
+#define configRUN_TIME_COUNTER_TYPE              uint64_t
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  void runstats_timer_init(void);
+  uint64_t runstats_get_counter(void);
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() runstats_timer_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()         runstats_get_counter()
+/* No tickless sleep while a background job run from the idle hook has work
+left (idlejob.c). TickType_t is uint32_t on this port. */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  void idlejob_pre_sleep(uint32_t *pxExpectedIdleTime);
+#endif
+#define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING(x) idlejob_pre_sleep(&(x))
+/* CPU load from the time the idle task runs, sampled by the tick hook
+(cpuload.c). */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  void cpuload_task_switched_in(int xIdle);
+#endif
+#define traceTASK_SWITCHED_IN() cpuload_task_switched_in((pxCurrentTCB == xIdleTaskHandle) ? 1 : 0)
+#undef configUSE_TICK_HOOK
+#define configUSE_TICK_HOOK                      1
+/* The energy of each task (energy.c) as telemetry counters, in frames on ITM
+stimulus port 3: USART2 carries printf(). */
+#define ENERGY_TELEMETRY                         1
+#define TELEMETRY_BACKEND                        1   /* TELEMETRY_BACKEND_ITM */
+#define TELEMETRY_MAX_COUNTERS                   12U
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
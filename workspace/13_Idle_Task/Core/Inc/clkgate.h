@@ -0,0 +1,77 @@
+/*******************************************************************************
+ *
+ * @file	clkgate.h
+ * @brief	Interface of the reference-counted peripheral clock gates.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef CLKGATE_H
+#define CLKGATE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Data types ----------------------------------------------------------------*/
+
+/* Peripheral clocks under reference count. "Critical" ones stall in STOP mode
+ * while in use (see clkgate_stop_allowed()). */
+typedef enum
+{
+	CLKGATE_GPIOA = 0,		/* AHB1, GPIOB to GPIOH follow in port order. */
+	CLKGATE_GPIOB,
+	CLKGATE_GPIOC,
+	CLKGATE_GPIOD,
+	CLKGATE_GPIOE,
+	CLKGATE_GPIOF,
+	CLKGATE_GPIOG,
+	CLKGATE_GPIOH,
+	CLKGATE_CRC,			/* AHB1. */
+	CLKGATE_DMA1,			/* AHB1, critical. */
+	CLKGATE_DMA2,			/* AHB1, critical. */
+	CLKGATE_TIM2,			/* APB1, critical. */
+	CLKGATE_TIM3,			/* APB1, critical. */
+	CLKGATE_TIM4,			/* APB1, critical. */
+	CLKGATE_TIM6,			/* APB1, critical. */
+	CLKGATE_TIM7,			/* APB1, critical. */
+	CLKGATE_USART2,			/* APB1, critical. */
+	CLKGATE_USART3,			/* APB1, critical. */
+	CLKGATE_UART4,			/* APB1, critical. */
+	CLKGATE_UART5,			/* APB1, critical. */
+	CLKGATE_TIM1,			/* APB2, critical. */
+	CLKGATE_TIM8,			/* APB2, critical. */
+	CLKGATE_USART1,			/* APB2, critical. */
+	CLKGATE_USART6,			/* APB2, critical. */
+	CLKGATE_ADC1,			/* APB2. */
+	CLKGATE_ADC2,			/* APB2. */
+	CLKGATE_ADC3,			/* APB2. */
+	CLKGATE_SYSCFG,			/* APB2. */
+	CLKGATE_COUNT
+} ClkGate_t;
+
+/* One driver's hold on a clock. Acquiring a held one, or releasing one not
+ * held, does nothing, so a driver can call them from every path that needs
+ * the clock on or off without counting. */
+typedef struct
+{
+	uint8_t ucClock;				/* ClkGate_t */
+	volatile uint8_t ucHeld;
+	TaskHandle_t xOwner;			/* Task of the last acquire, NULL from an ISR. */
+} ClkGateUser_t;
+
+/* Macros --------------------------------------------------------------------*/
+#define CLKGATE_USER(eClock) { (uint8_t)(eClock), 0U, NULL }
+
+/* Function Prototypes -------------------------------------------------------*/
+void clkgate_user_init(ClkGateUser_t *pxUser, ClkGate_t eClock);
+void clkgate_acquire(ClkGateUser_t *pxUser);
+void clkgate_release(ClkGateUser_t *pxUser);
+uint32_t clkgate_get_users(ClkGate_t eClock);
+BaseType_t clkgate_stop_allowed(void);
+void clkgate_hold_callback(const ClkGateUser_t *pxUser, BaseType_t xHeld);
+
+#endif /* CLKGATE_H */
@@ -0,0 +1,187 @@
+/*******************************************************************************
+ *
+ * @file	coro.h
+ * @brief	Interface of the stackless coroutine executor.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	A coroutine is a function that is called again each time it may
+ * 			continue. The CORO_*() macros save the point it stopped at, in
+ * 			the style of protothreads, so it resumes right after the wait:
+ *
+ * 				void vBlinkCoro(Coro_t *pxCoro)
+ * 				{
+ * 					CORO_BEGIN(pxCoro);
+ *
+ * 					while (1)
+ * 					{
+ * 						HAL_GPIO_TogglePin(LD2_GPIO_Port, LD2_Pin);
+ * 						CORO_DELAY(pxCoro, pdMS_TO_TICKS(500));
+ * 					}
+ *
+ * 					CORO_END(pxCoro);
+ * 				}
+ *
+ * 			Local variables do not survive a wait: keep state in the
+ * 			structure passed as pvArg (coro_get_arg()). The wait macros
+ * 			record __LINE__, so use at most one per line, never inside a
+ * 			switch statement, and never in a function the coroutine calls.
+ *
+ ******************************************************************************/
+
+#ifndef CORO_H
+#define CORO_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef CORO_NOTIFY_INDEX
+#define CORO_NOTIFY_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+#endif
+
+/* How often the executor re-evaluates conditions nobody signals with
+ * coro_wake(), in ticks. 0 waits for coro_wake() or a timeout only. */
+#ifndef CORO_POLL_TICKS
+#define CORO_POLL_TICKS pdMS_TO_TICKS(10)
+#endif
+
+/**
+ * @brief Starts the body of a coroutine. Must come first.
+ */
+#define CORO_BEGIN(pxCoro)		switch ((pxCoro)->ulResume) { case 0U:
+
+/**
+ * @brief Ends the body of a coroutine. Reaching it ends the coroutine.
+ */
+#define CORO_END(pxCoro)		} coro_end_(pxCoro); return
+
+/**
+ * @brief Lets the other coroutines run, then continues.
+ */
+#define CORO_YIELD(pxCoro)													\
+	do																		\
+	{																		\
+		(pxCoro)->ulResume = __LINE__;										\
+		return;																\
+		case __LINE__:;														\
+	} while (0)
+
+/**
+ * @brief Waits for xTicks ticks (vTaskDelay()).
+ */
+#define CORO_DELAY(pxCoro, xTicks)											\
+	do																		\
+	{																		\
+		coro_delay_(pxCoro, (xTicks));										\
+		(pxCoro)->ulResume = __LINE__;										\
+		return;																\
+		case __LINE__:;														\
+	} while (0)
+
+/**
+ * @brief Waits until *pxPreviousWakeTime + xTimeIncrement and updates
+ * *pxPreviousWakeTime (vTaskDelayUntil()). pxPreviousWakeTime must survive
+ * the wait.
+ */
+#define CORO_DELAY_UNTIL(pxCoro, pxPreviousWakeTime, xTimeIncrement)		\
+	do																		\
+	{																		\
+		coro_delay_(pxCoro, coro_ticks_until_(pxPreviousWakeTime, (xTimeIncrement))); \
+		(pxCoro)->ulResume = __LINE__;										\
+		return;																\
+		case __LINE__:;														\
+	} while (0)
+
+/**
+ * @brief Waits until xCondition is true or xTimeout ticks have passed,
+ * whichever comes first. xCondition is evaluated at once, then each time the
+ * executor wakes: after coro_wake(), a timeout, or every CORO_POLL_TICKS.
+ * CORO_TIMED_OUT() tells which happened.
+ */
+#define CORO_AWAIT_UNTIL(pxCoro, xCondition, xTimeout)						\
+	do																		\
+	{																		\
+		coro_await_(pxCoro, (xTimeout));										\
+		(pxCoro)->ulResume = __LINE__;										\
+		case __LINE__:														\
+		if (coro_check_((pxCoro), (xCondition) ? pdTRUE : pdFALSE) == pdFALSE) \
+		{																	\
+			return;															\
+		}																	\
+	} while (0)
+
+/**
+ * @brief pdTRUE if the last CORO_AWAIT_*() ended on its timeout.
+ */
+#define CORO_TIMED_OUT(pxCoro)	((BaseType_t)(pxCoro)->ucTimedOut)
+
+/**
+ * @brief Waits for coro_notify() and takes the notified bits into *pulBits
+ * (0 on timeout).
+ */
+#define CORO_AWAIT_NOTIFY(pxCoro, pulBits, xTimeout)						\
+	CORO_AWAIT_UNTIL(pxCoro, (*(pulBits) = coro_notify_take_(pxCoro)) != 0U, (xTimeout))
+
+/**
+ * @brief Waits for an item and receives it into pvBuffer (xQueueReceive()).
+ * *pxResult is pdPASS, or errQUEUE_EMPTY on timeout.
+ */
+#define CORO_AWAIT_QUEUE_RECEIVE(pxCoro, xQueue, pvBuffer, pxResult, xTimeout) \
+	CORO_AWAIT_UNTIL(pxCoro, (*(pxResult) = xQueueReceive((xQueue), (pvBuffer), 0)) == pdPASS, (xTimeout))
+
+/**
+ * @brief Waits for data and reads up to xBufferLength bytes
+ * (xStreamBufferReceive()). *pxReceived is the byte count, 0 on timeout.
+ */
+#define CORO_AWAIT_STREAM_RECEIVE(pxCoro, xStream, pvBuffer, xBufferLength, pxReceived, xTimeout) \
+	CORO_AWAIT_UNTIL(pxCoro, (*(pxReceived) = xStreamBufferReceive((xStream), (pvBuffer), (xBufferLength), 0)) > 0U, (xTimeout))
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct Coro Coro_t;
+typedef struct CoroExecutor CoroExecutor_t;
+typedef void (*CoroFunction_t)(Coro_t *pxCoro);
+
+struct Coro
+{
+	Coro_t *pxNext;
+	CoroExecutor_t *pxExecutor;
+	CoroFunction_t pxFunction;
+	void *pvArg;
+	uint32_t ulResume;				/* Line to resume at, 0 to start. */
+	TickType_t xWaitStart;
+	TickType_t xWaitTicks;			/* portMAX_DELAY waits forever. */
+	uint8_t ucState;				/* CORO_STATE_*, see coro.c. */
+	uint8_t ucTimedOut;
+	volatile uint32_t ulNotifyBits;	/* Set by coro_notify(). */
+};
+
+struct CoroExecutor
+{
+	Coro_t *pxHead;
+	TaskHandle_t xTask;				/* Task running coro_executor_run(). */
+};
+
+/* Function Prototypes -------------------------------------------------------*/
+void coro_executor_init(CoroExecutor_t *pxExecutor);
+void coro_spawn(CoroExecutor_t *pxExecutor, Coro_t *pxCoro, CoroFunction_t pxFunction, void *pvArg);
+BaseType_t coro_executor_start(CoroExecutor_t *pxExecutor, const char *pcName, uint16_t usStackWords, UBaseType_t uxPriority);
+void coro_executor_run(CoroExecutor_t *pxExecutor);
+void *coro_get_arg(const Coro_t *pxCoro);
+void coro_wake(CoroExecutor_t *pxExecutor);
+void coro_wake_from_isr(CoroExecutor_t *pxExecutor, BaseType_t *pxHigherPriorityTaskWoken);
+void coro_notify(Coro_t *pxCoro, uint32_t ulBits);
+void coro_notify_from_isr(Coro_t *pxCoro, uint32_t ulBits, BaseType_t *pxHigherPriorityTaskWoken);
+
+/* Used by the macros only. */
+void coro_end_(Coro_t *pxCoro);
+void coro_delay_(Coro_t *pxCoro, TickType_t xTicks);
+void coro_await_(Coro_t *pxCoro, TickType_t xTicks);
+TickType_t coro_ticks_until_(TickType_t *pxPreviousWakeTime, TickType_t xTimeIncrement);
+BaseType_t coro_check_(Coro_t *pxCoro, BaseType_t xConditionMet);
+uint32_t coro_notify_take_(Coro_t *pxCoro);
+
+#endif /* CORO_H */
@@ -0,0 +1,47 @@
+/*******************************************************************************
+ *
+ * @file	cpuload.h
+ * @brief	Interface of the CPU load measured on the idle task.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef CPULOAD_H
+#define CPULOAD_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef CPULOAD_SAMPLE_MS
+#define CPULOAD_SAMPLE_MS 100U			/* Shortest window, sampled from the tick hook. */
+#endif
+
+#define CPULOAD_FULL 10000U				/* 100.00 %: loads are in units of 0.01 %. */
+#define CPULOAD_STR_LEN 8U				/* "100.00%" and the NUL. */
+
+#ifndef CPULOAD_REPORTER_STACK_WORDS
+#define CPULOAD_REPORTER_STACK_WORDS 256U	/* printf() needs the headroom. */
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint16_t usLoad100ms;				/* Over the last CPULOAD_SAMPLE_MS. */
+	uint16_t usLoad1s;					/* Moving averages of the samples, */
+	uint16_t usLoad10s;					/* 1 s and 10 s time constants. */
+} CpuLoad_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+void cpuload_get(CpuLoad_t *pxLoad);
+const char *cpuload_format(uint16_t usLoad, char *pcBuffer);
+BaseType_t cpuload_start_reporter(uint32_t ulPeriodMs, UBaseType_t uxPriority);
+
+/* Hooked in FreeRTOSConfig.h and main.c. */
+void cpuload_task_switched_in(int xIdle);
+void cpuload_tick(void);
+
+#endif /* CPULOAD_H */
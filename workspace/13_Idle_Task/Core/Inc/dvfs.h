@@ -0,0 +1,53 @@
+/*******************************************************************************
+ *
+ * @file	dvfs.h
+ * @brief	Interface of the load-driven clock profile governor.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef DVFS_H
+#define DVFS_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "clock.h"
+#include "cpuload.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef DVFS_PERIOD_MS
+#define DVFS_PERIOD_MS CPULOAD_SAMPLE_MS	/* One decision per load window. */
+#endif
+
+#ifndef DVFS_UP_LOAD
+#define DVFS_UP_LOAD 8500U				/* 85.00 % over one window: one profile up. */
+#endif
+
+#ifndef DVFS_DOWN_LOAD
+#define DVFS_DOWN_LOAD 7000U			/* 1 s load the profile below would see, under which it is taken. */
+#endif
+
+#ifndef DVFS_DOWN_HOLD_MS
+#define DVFS_DOWN_HOLD_MS 2000U			/* Below DVFS_DOWN_LOAD for this long first. */
+#endif
+
+#ifndef DVFS_STACK_WORDS
+#define DVFS_STACK_WORDS 256U			/* printf() of the report needs the headroom. */
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulSwitches;				/* Profile changes made. */
+	uint32_t ulFailures;				/* Switches that fell back (no HSE). */
+	uint32_t ulTicks[CLOCK_PROFILE_COUNT];	/* Time spent in each profile. */
+} DvfsStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+BaseType_t dvfs_start(UBaseType_t uxPriority, uint32_t ulReportMs);
+int32_t dvfs_set_limits(ClockProfile_t eMin, ClockProfile_t eMax);
+void dvfs_get_stats(DvfsStats_t *pxStats);
+
+#endif /* DVFS_H */
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ *
+ * @file	energy.h
+ * @brief	Interface of the per-task energy accounting.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef ENERGY_H
+#define ENERGY_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clock.h"
+#include "clkgate.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef ENERGY_MAX_TASKS
+#define ENERGY_MAX_TASKS 12U			/* At least the tasks there are, idle included. */
+#endif
+
+#ifndef ENERGY_PERIOD_MS
+#define ENERGY_PERIOD_MS 1000U			/* Between two accountings. */
+#endif
+
+#ifndef ENERGY_STACK_WORDS
+#define ENERGY_STACK_WORDS 384U			/* printf() of the report needs the headroom. */
+#endif
+
+/* 1 to add one telemetry counter per task, its energy in uJ (telemetry.h). */
+#ifndef ENERGY_TELEMETRY
+#define ENERGY_TELEMETRY 0
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+
+/* Supply current of a board, with the figures measured on it (e.g. with
+ * lowpower_current_benchmark()) or taken from the datasheet. */
+typedef struct
+{
+	uint32_t ulSupplyMv;						/* VDD. */
+	uint32_t ulRunUa[CLOCK_PROFILE_COUNT];		/* Running, every gated clock off. */
+	uint32_t ulSleepUa[CLOCK_PROFILE_COUNT];	/* SLEEP mode, the same clocks off. */
+	uint32_t ulStopUa;							/* STOP mode, low-power regulator. */
+	uint16_t usClockNaPerMhz[CLKGATE_COUNT];	/* Added by a held clock, per MHz of HCLK. */
+} EnergyModel_t;
+
+/* Energy charged to one task since energy_start(). */
+typedef struct
+{
+	const char *pcName;			/* "system" for the clocks held outside tasks. */
+	TaskHandle_t xHandle;		/* NULL for the system entry. */
+	BaseType_t xDeleted;		/* pdTRUE once the task is gone. */
+	uint64_t ullCpuUj;			/* Running; sleeping as well for the idle task. */
+	uint64_t ullClockUj;		/* Peripheral clocks it held. */
+} EnergyTask_t;
+
+typedef struct
+{
+	uint32_t ulElapsedMs;		/* Accounted since energy_start(). */
+	uint32_t ulSleepMs;			/* Of it, in SLEEP mode. */
+	uint32_t ulStopMs;			/* And in STOP mode. */
+	uint64_t ullTotalUj;		/* Every entry. */
+	uint64_t ullSleepUj;		/* Idle task in SLEEP mode, clocks not included. */
+	uint64_t ullStopUj;			/* The same in STOP mode. */
+	uint32_t ulAverageUa;		/* Supply current over ulElapsedMs. */
+	uint32_t ulUntracked;		/* Task run times not charged: over ENERGY_MAX_TASKS. */
+} EnergySummary_t;
+
+/* Variables -----------------------------------------------------------------*/
+extern const EnergyModel_t xEnergyModelNucleoF446RE;
+
+/* Function Prototypes -------------------------------------------------------*/
+#if (configGENERATE_RUN_TIME_STATS == 1) && (configUSE_TRACE_FACILITY == 1)
+BaseType_t energy_start(const EnergyModel_t *pxBoard, UBaseType_t uxPriority, uint32_t ulReportMs);
+void energy_profile_changed(ClockProfile_t eNew);
+UBaseType_t energy_get(EnergyTask_t *pxTasks, UBaseType_t uxSize, EnergySummary_t *pxSummary);
+void energy_print(void);
+#endif
+
+#endif /* ENERGY_H */
@@ -0,0 +1,85 @@
+/*******************************************************************************
+ *
+ * @file	flashlog.h
+ * @brief	Interface of the log store in internal flash, programmed and
+ * 			erased from the idle task.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef FLASHLOG_H
+#define FLASHLOG_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef FLASHLOG_FIRST_SECTOR
+#define FLASHLOG_FIRST_SECTOR 6U		/* 5 to 7: the 128 KB sectors. */
+#endif
+
+#ifndef FLASHLOG_SECTORS
+#define FLASHLOG_SECTORS 2U				/* Sectors of the ring, erased in turn. */
+#endif
+
+#ifndef FLASHLOG_BUFFER_WORDS
+#define FLASHLOG_BUFFER_WORDS 256U		/* RAM for records not yet programmed. */
+#endif
+
+#ifndef FLASHLOG_MAX_RECORD
+#define FLASHLOG_MAX_RECORD 64U			/* Bytes of one record. */
+#endif
+
+#ifndef FLASHLOG_BATCH_WORDS
+#define FLASHLOG_BATCH_WORDS 8U			/* Words programmed per idle job step. */
+#endif
+
+#ifndef FLASHLOG_ERASE_AHEAD
+#define FLASHLOG_ERASE_AHEAD (16U * 1024U)	/* Bytes left when the next sector is erased. */
+#endif
+
+#ifndef FLASHLOG_ERASE_MS
+#define FLASHLOG_ERASE_MS 2000U			/* Longest 128 KB sector erase, x32. */
+#endif
+
+#ifndef FLASHLOG_REALTIME_PRIORITY
+#define FLASHLOG_REALTIME_PRIORITY 1U	/* Lowest priority an erase must not delay. */
+#endif
+
+#ifndef FLASHLOG_BUDGET_CYCLES
+#define FLASHLOG_BUDGET_CYCLES (configCPU_CLOCK_HZ / 5000U)	/* 200 us per slice. */
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+/* Position of a reader, from flashlog_rewind(). Readers are independent of
+ * each other and of the writer. */
+typedef struct
+{
+	uint32_t ulSequence;				/* Of the sector being read. */
+	uint32_t ulOffset;					/* Of the next record in it. */
+} FlashLogCursor_t;
+
+typedef struct
+{
+	uint32_t ulRecords;					/* Accepted by flashlog_write(). */
+	uint32_t ulDropped;					/* Refused: the RAM buffer was full. */
+	uint32_t ulProgrammedWords;
+	uint32_t ulErases;
+	uint32_t ulErasesDeferred;			/* A real-time task was due. */
+	uint32_t ulMaxEraseMs;
+	uint32_t ulErrors;					/* Failed programs and erases. */
+	uint32_t ulBadRecords;				/* Skipped by readers, torn or corrupt. */
+} FlashLogStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+void flashlog_init(void);
+int32_t flashlog_write(const void *pvRecord, uint32_t ulLen);
+void flashlog_set_realtime_priority(UBaseType_t uxPriority);
+BaseType_t flashlog_erase_pending(void);
+void flashlog_rewind(FlashLogCursor_t *pxCursor);
+int32_t flashlog_read(FlashLogCursor_t *pxCursor, void *pvRecord, uint32_t ulMax);
+void flashlog_get_stats(FlashLogStats_t *pxStats);
+
+#endif /* FLASHLOG_H */
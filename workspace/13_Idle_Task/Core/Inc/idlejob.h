@@ -0,0 +1,54 @@
+/*******************************************************************************
+ *
+ * @file	idlejob.h
+ * @brief	Interface of the background jobs run from the idle hook.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef IDLEJOB_H
+#define IDLEJOB_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct IdleJob IdleJob_t;
+
+/* One step of a job, a few hundred cycles at most: the budget is checked
+ * between steps only. Returns pdTRUE while the job has more to do, pdFALSE
+ * once it is done until the next kick. Must not block. */
+typedef BaseType_t (*IdleJobFunction_t)(void *pvArg);
+
+typedef struct
+{
+	uint32_t ulSlices;				/* Calls from idlejob_run(). */
+	uint32_t ulSteps;
+	uint32_t ulOverBudget;			/* Slices cut short by the budget. */
+	uint32_t ulMaxStepCycles;		/* Longest single step. */
+} IdleJobStats_t;
+
+struct IdleJob
+{
+	IdleJob_t *pxNext;
+	const char *pcName;
+	IdleJobFunction_t pxFunction;
+	void *pvArg;
+	uint32_t ulBudgetCycles;		/* Per slice, in core clock cycles. */
+	volatile uint32_t ulPending;	/* Set by idlejob_kick(). */
+	IdleJobStats_t xStats;
+};
+
+/* Function Prototypes -------------------------------------------------------*/
+void idlejob_register(IdleJob_t *pxJob, const char *pcName, IdleJobFunction_t pxFunction,
+		void *pvArg, uint32_t ulBudgetCycles);
+void idlejob_kick(IdleJob_t *pxJob);
+void idlejob_set_budget(IdleJob_t *pxJob, uint32_t ulBudgetCycles);
+void idlejob_run(void);
+BaseType_t idlejob_pending(void);
+void idlejob_pre_sleep(TickType_t *pxExpectedIdleTime);
+void idlejob_get_stats(const IdleJob_t *pxJob, IdleJobStats_t *pxStats);
+
+#endif /* IDLEJOB_H */
@@ -0,0 +1,55 @@
+/*******************************************************************************
+ *
+ * @file	lowpower.h
+ * @brief	Interface of the tickless idle (STOP mode + RTC wakeup) support.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef LOWPOWER_H
+#define LOWPOWER_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macros --------------------------------------------------------------------*/
+
+/* Idle periods shorter than this (in ticks) are spent in SLEEP mode with the
+ * SysTick running, since the STOP mode entry/exit cost would not pay off. */
+#ifndef LOWPOWER_MIN_STOP_TICKS
+#define LOWPOWER_MIN_STOP_TICKS 3U
+#endif
+
+/* Time from the RTC wakeup event to the tick count being corrected: STOP mode
+ * exit with the low-power regulator and flash power-down, plus the PLL relock.
+ * The wakeup timer is programmed this much early. */
+#ifndef LOWPOWER_WAKEUP_LATENCY_US
+#define LOWPOWER_WAKEUP_LATENCY_US 300U
+#endif
+
+/* Set to 1 to have main() measure each power mode before starting the
+ * scheduler (see lowpower_current_benchmark()). */
+#ifndef LOWPOWER_RUN_CURRENT_BENCHMARK
+#define LOWPOWER_RUN_CURRENT_BENCHMARK 0
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulStopEntries;		/* Times STOP mode was entered. */
+	uint32_t ulSleepEntries;	/* Idle periods spent in SLEEP mode. */
+	uint32_t ulStopVetoes;		/* Of those, long enough for STOP but a clock was held. */
+	uint32_t ulAborts;			/* Entries abandoned by a pending event. */
+	uint32_t ulEarlyWakeups;	/* STOP exits before the RTC wakeup. */
+	uint32_t ulTicksSuppressed;	/* Ticks stepped with vTaskStepTick(). */
+	uint64_t ullSleepTime;		/* Run-time counter units spent in SLEEP mode. */
+	uint64_t ullStopTime;		/* And in STOP mode, as added by runstats_advance(). */
+} LowPowerStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t lowpower_init(void);
+void lowpower_get_stats(LowPowerStats_t *pxStats);
+void lowpower_current_benchmark(uint32_t ulSecondsPerMode);
+
+#endif /* LOWPOWER_H */
@@ -0,0 +1,78 @@
+/*******************************************************************************
+ *
+ * @file	perfstore.h
+ * @brief	Interface of the persistent performance counters kept in backup
+ * 			SRAM.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef PERFSTORE_H
+#define PERFSTORE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef PERFSTORE_MAX_COUNTERS
+#define PERFSTORE_MAX_COUNTERS 8U		/* Counters of the application. */
+#endif
+
+#ifndef PERFSTORE_HISTORY
+#define PERFSTORE_HISTORY 8U			/* Previous boots kept, newest first. */
+#endif
+
+#ifndef PERFSTORE_COMMITTER_STACK_WORDS
+#define PERFSTORE_COMMITTER_STACK_WORDS 192U
+#endif
+
+/* How a counter keeps the worst value it is given. */
+#define PERFSTORE_KIND_MAX 0U			/* Peaks: latency, load, depth. */
+#define PERFSTORE_KIND_MIN 1U			/* Low-water marks: free heap, stack. */
+
+/* Causes of a reset, from the RCC_CSR flags. A watchdog or software reset
+ * also drives the NRST pin, so PERFSTORE_RESET_PIN comes with them. */
+#define PERFSTORE_RESET_BOR			(1U << 0)	/* Brown-out. */
+#define PERFSTORE_RESET_PIN			(1U << 1)	/* NRST pin. */
+#define PERFSTORE_RESET_POR			(1U << 2)	/* Power-on or power-down. */
+#define PERFSTORE_RESET_SOFTWARE	(1U << 3)	/* NVIC_SystemReset(). */
+#define PERFSTORE_RESET_IWDG		(1U << 4)	/* Independent watchdog. */
+#define PERFSTORE_RESET_WWDG		(1U << 5)	/* Window watchdog. */
+#define PERFSTORE_RESET_LOW_POWER	(1U << 6)	/* Illegal Stop or Standby entry. */
+
+/* Data types ----------------------------------------------------------------*/
+/* One counter of the table given to perfstore_init(). The names and kinds, in
+ * order, make the layout signature: any change to the table discards what was
+ * stored with the previous one. */
+typedef struct
+{
+	const char *pcName;
+	uint8_t ucKind;						/* PERFSTORE_KIND_MAX or _MIN. */
+} PerfStoreCounter_t;
+
+/* The counters of one boot. */
+typedef struct
+{
+	uint32_t ulResetCause;				/* PERFSTORE_RESET_ flags that ended it. */
+	uint32_t ulUptimeS;					/* At its last commit. */
+	uint32_t ulValues[PERFSTORE_MAX_COUNTERS];
+} PerfStoreBoot_t;
+
+/* Called by the committer task before each commit, to update the counters
+ * that are sampled rather than updated where they happen. */
+typedef void (*PerfStoreSample_t)(void);
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t perfstore_init(const PerfStoreCounter_t *pxCounters, uint32_t ulCount);
+void perfstore_update(uint32_t ulCounter, uint32_t ulValue);
+int32_t perfstore_commit(void);
+uint32_t perfstore_get_boots(void);
+uint32_t perfstore_get_lifetime(uint32_t ulCounter);
+int32_t perfstore_get_boot(uint32_t ulBootsAgo, PerfStoreBoot_t *pxBoot);
+void perfstore_report(void);
+BaseType_t perfstore_start_committer(uint32_t ulPeriodMs, UBaseType_t uxPriority,
+		PerfStoreSample_t pxSample);
+
+#endif /* PERFSTORE_H */
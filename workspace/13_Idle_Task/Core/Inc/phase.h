@@ -0,0 +1,59 @@
+/*******************************************************************************
+ *
+ * @file	phase.h
+ * @brief	Interface of the release phase planner.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef PHASE_H
+#define PHASE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef PHASE_MAX_RELEASES
+#define PHASE_MAX_RELEASES 15U			/* Releases per tick counted apart; more go in the last count. */
+#endif
+
+#ifndef PHASE_MAX_ANALYSIS_TICKS
+#define PHASE_MAX_ANALYSIS_TICKS 60000UL	/* Longer hyperperiods are analysed over this many ticks. */
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+
+/* A periodic task, or coroutine, whose first release the planner places. */
+typedef struct PhaseTask
+{
+	const char *pcName;
+	TickType_t xPeriod;				/* Ticks between two releases. */
+	uint32_t ulCost;				/* Work of a release, in any unit (e.g. us); at least 1. */
+	TickType_t xOffset;				/* First release, from phase_base(); set by phase_plan(). */
+	struct PhaseTask *pxNext;
+} PhaseTask_t;
+
+/* Releases per tick over the hyperperiod of the registered tasks. */
+typedef struct
+{
+	uint32_t ulTicks;				/* Analysed: the hyperperiod, at most PHASE_MAX_ANALYSIS_TICKS. */
+	uint32_t ulPeakReleases;		/* Most releases on one tick. */
+	uint32_t ulPeakCost;			/* Most cost on one tick. */
+	uint32_t ulAlignedReleases;		/* The same with every offset 0. */
+	uint32_t ulAlignedCost;
+	uint32_t ulTicksWith[PHASE_MAX_RELEASES + 1U];	/* Ticks with n releases. */
+} PhaseLoad_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+void phase_register(PhaseTask_t *pxTask, const char *pcName, TickType_t xPeriod, uint32_t ulCost);
+void phase_plan(void);
+TickType_t phase_base(void);
+TickType_t phase_offset(const PhaseTask_t *pxTask);
+void phase_delay_first(const PhaseTask_t *pxTask, TickType_t *pxLastWake);
+void phase_analyse(PhaseLoad_t *pxLoad);
+void phase_print(void);
+
+#endif /* PHASE_H */
@@ -0,0 +1,35 @@
+/*******************************************************************************
+ *
+ * @file	runstats.h
+ * @brief	Interface of the DWT cycle counter run-time stats backend.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef RUNSTATS_H
+#define RUNSTATS_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef RUNSTATS_REPORTER_STACK_WORDS
+#define RUNSTATS_REPORTER_STACK_WORDS 384U	/* printf() needs the headroom. */
+#endif
+
+/* 1 to add the interrupts timed with irq_profile_start() (irq.c) to the
+ * table printed by runstats_print(). */
+#ifndef RUNSTATS_IRQ_PROFILE
+#define RUNSTATS_IRQ_PROFILE 0
+#endif
+
+/* Function Prototypes -------------------------------------------------------*/
+void runstats_timer_init(void);
+uint64_t runstats_get_counter(void);
+void runstats_advance(uint64_t ullCycles);
+void runstats_print(void);
+BaseType_t runstats_start_reporter(uint32_t ulPeriodMs, UBaseType_t uxPriority);
+
+#endif /* RUNSTATS_H */
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *
+ * @file	telemetry.h
+ * @brief	Interface of the binary telemetry stream of kernel and system
+ * 			metrics.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "queue.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define TELEMETRY_VERSION 1U			/* First byte of every frame. */
+
+/* Outputs. The one not selected is not linked in. */
+#define TELEMETRY_BACKEND_UART 0		/* uart_write() to TELEMETRY_UART_PORT. */
+#define TELEMETRY_BACKEND_ITM 1			/* ITM_write_buffer() to TELEMETRY_ITM_PORT. */
+
+#ifndef TELEMETRY_BACKEND
+#define TELEMETRY_BACKEND TELEMETRY_BACKEND_UART
+#endif
+
+#ifndef TELEMETRY_UART_PORT
+#define TELEMETRY_UART_PORT UART_PORT_2	/* Opened by the application. */
+#endif
+
+#ifndef TELEMETRY_ITM_PORT
+#define TELEMETRY_ITM_PORT ITM_PORT_TELEMETRY
+#endif
+
+#ifndef TELEMETRY_MAX_TASKS
+#define TELEMETRY_MAX_TASKS 16U			/* More tasks than this are not reported. */
+#endif
+
+#ifndef TELEMETRY_MAX_QUEUES
+#define TELEMETRY_MAX_QUEUES 8U			/* telemetry_add_queue() */
+#endif
+
+#ifndef TELEMETRY_MAX_COUNTERS
+#define TELEMETRY_MAX_COUNTERS 8U		/* telemetry_add_counter() */
+#endif
+
+#ifndef TELEMETRY_KEY_INTERVAL
+#define TELEMETRY_KEY_INTERVAL 16U		/* Samples per absolute (key) frame. */
+#endif
+
+#ifndef TELEMETRY_SCHEMA_INTERVAL
+#define TELEMETRY_SCHEMA_INTERVAL 256U	/* Samples per repeat of the schema. */
+#endif
+
+#ifndef TELEMETRY_STACK_WORDS
+#define TELEMETRY_STACK_WORDS 256U		/* Of the sampling task. */
+#endif
+
+/* Frame types, the second byte of every frame. */
+#define TELEMETRY_FRAME_SCHEMA 0U		/* Names and kinds of the channels. */
+#define TELEMETRY_FRAME_KEY 1U			/* Absolute values. */
+#define TELEMETRY_FRAME_DELTA 2U		/* Differences from the previous sample. */
+
+/* Channel kinds, in the schema. */
+#define TELEMETRY_KIND_RUNTIME 0U		/* Run-time counter of all tasks, low 32 bits. */
+#define TELEMETRY_KIND_TASK_RUNTIME 1U	/* Of one task, low 32 bits. */
+#define TELEMETRY_KIND_TASK_STACK 2U	/* Stack high-water mark, in words. */
+#define TELEMETRY_KIND_HEAP_FREE 3U		/* Bytes. */
+#define TELEMETRY_KIND_HEAP_MIN 4U		/* Least ever free, in bytes. */
+#define TELEMETRY_KIND_QUEUE_DEPTH 5U	/* Items waiting. */
+#define TELEMETRY_KIND_COUNTER 6U		/* telemetry_add_counter() */
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulSamples;					/* Key and delta frames sent. */
+	uint32_t ulSchemas;					/* Schema frames sent. */
+	uint32_t ulBytes;					/* Encoded, delimiters included. */
+	uint32_t ulDropped;					/* Frames the output did not take whole. */
+	uint32_t ulTaskOverflows;			/* Samples without tasks: over TELEMETRY_MAX_TASKS. */
+} TelemetryStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t telemetry_add_queue(QueueHandle_t xQueue, const char *pcName);
+int32_t telemetry_add_counter(const char *pcName, const volatile uint32_t *pulCounter);
+BaseType_t telemetry_start(uint32_t ulRateHz, UBaseType_t uxPriority);
+int32_t telemetry_set_rate(uint32_t ulRateHz);
+void telemetry_get_stats(TelemetryStats_t *pxStats);
+
+#endif /* TELEMETRY_H */
@@ -0,0 +1,389 @@
+/*******************************************************************************
+ *
+ * @file	coro.c
+ * @brief	Stackless coroutine executor running in one FreeRTOS task.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Every coroutine spawned on an executor runs in the executor's
+ * 			task, one at a time, from where it last stopped to its next wait.
+ * 			A coroutine costs sizeof(Coro_t) bytes instead of a TCB and a
+ * 			stack; the executor task needs only the stack of its deepest
+ * 			coroutine call.
+ *
+ * 			The executor sleeps on its task notification at
+ * 			CORO_NOTIFY_INDEX until the nearest delay or timeout expires.
+ * 			coro_notify() sets bits for one coroutine and wakes it. The kernel
+ * 			does not know about coroutines waiting in
+ * 			CORO_AWAIT_QUEUE_RECEIVE() or CORO_AWAIT_STREAM_RECEIVE(), so the
+ * 			sender should call coro_wake() after a send; without that the
+ * 			executor sees the data within CORO_POLL_TICKS.
+ *
+ * 			A coroutine that never waits starves the others: there is no
+ * 			preemption between coroutines of one executor.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "coro.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define CORO_STATE_READY	0U	/* Runs on the next pass. */
+#define CORO_STATE_DELAYED	1U	/* Runs once xWaitTicks have passed. */
+#define CORO_STATE_WAITING	2U	/* Runs on every wakeup to check its condition. */
+#define CORO_STATE_DONE		3U	/* Reached CORO_END(), unlinked on the next pass. */
+
+/* Private function prototypes -----------------------------------------------*/
+static TickType_t coro_ticks_left(const Coro_t *pxCoro, TickType_t xNow);
+static void coro_executor_task(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Initializes an executor with no coroutines.
+ * @param pxExecutor Executor to initialize.
+ * @retval None
+ */
+void coro_executor_init(CoroExecutor_t *pxExecutor)
+{
+	pxExecutor->pxHead = NULL;
+	pxExecutor->xTask = NULL;
+}
+
+/**
+ * @brief Adds a coroutine to an executor, to start on its next pass.
+ * @param pxExecutor Executor to run the coroutine.
+ * @param pxCoro Storage of the coroutine. Must stay valid until it ends.
+ * @param pxFunction Body of the coroutine.
+ * @param pvArg State of the coroutine, returned by coro_get_arg().
+ * @retval None
+ * @note Either before the executor starts, or from one of its coroutines.
+ */
+void coro_spawn(CoroExecutor_t *pxExecutor, Coro_t *pxCoro, CoroFunction_t pxFunction, void *pvArg)
+{
+	Coro_t **ppxLink = &pxExecutor->pxHead;
+
+	configASSERT(pxFunction != NULL);
+
+	pxCoro->pxNext = NULL;
+	pxCoro->pxExecutor = pxExecutor;
+	pxCoro->pxFunction = pxFunction;
+	pxCoro->pvArg = pvArg;
+	pxCoro->ulResume = 0;
+	pxCoro->xWaitStart = 0;
+	pxCoro->xWaitTicks = 0;
+	pxCoro->ucState = CORO_STATE_READY;
+	pxCoro->ucTimedOut = 0;
+	pxCoro->ulNotifyBits = 0;
+
+	/* Appended, so a coroutine spawned during a pass runs in the same pass. */
+	while (*ppxLink != NULL)
+	{
+		ppxLink = &(*ppxLink)->pxNext;
+	}
+
+	*ppxLink = pxCoro;
+}
+
+/**
+ * @brief Creates a task that runs the executor.
+ * @param pxExecutor Executor to run, with its coroutines spawned.
+ * @param pcName Task name.
+ * @param usStackWords Task stack depth in words.
+ * @param uxPriority Task priority.
+ * @retval pdPASS if the task was created, errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY
+ * otherwise.
+ */
+BaseType_t coro_executor_start(CoroExecutor_t *pxExecutor, const char *pcName, uint16_t usStackWords, UBaseType_t uxPriority)
+{
+	return xTaskCreate(coro_executor_task,
+					   pcName,
+					   usStackWords,
+					   pxExecutor,
+					   uxPriority,
+					   &pxExecutor->xTask);
+}
+
+/**
+ * @brief Runs the coroutines of an executor in the calling task. Never returns.
+ * @param pxExecutor Executor to run.
+ * @retval None
+ */
+void coro_executor_run(CoroExecutor_t *pxExecutor)
+{
+	Coro_t **ppxLink;
+	Coro_t *pxCoro;
+	TickType_t xSleep;
+	TickType_t xLeft;
+	BaseType_t xPolling;
+
+	pxExecutor->xTask = xTaskGetCurrentTaskHandle();
+
+	while (1)
+	{
+		xSleep = portMAX_DELAY;
+		xPolling = pdFALSE;
+		ppxLink = &pxExecutor->pxHead;
+
+		while ((pxCoro = *ppxLink) != NULL)
+		{
+			if ((pxCoro->ucState != CORO_STATE_DELAYED) ||
+				(coro_ticks_left(pxCoro, xTaskGetTickCount()) == 0U))
+			{
+				pxCoro->ucState = CORO_STATE_READY;
+				pxCoro->pxFunction(pxCoro);
+			}
+
+			if (pxCoro->ucState == CORO_STATE_DONE)
+			{
+				*ppxLink = pxCoro->pxNext;
+				continue;
+			}
+
+			if (pxCoro->ucState == CORO_STATE_READY)
+			{
+				/* Yielded: pass again without sleeping. */
+				xLeft = 0;
+			}
+			else
+			{
+				xLeft = coro_ticks_left(pxCoro, xTaskGetTickCount());
+				xPolling |= (pxCoro->ucState == CORO_STATE_WAITING) ? pdTRUE : pdFALSE;
+			}
+
+			if (xLeft < xSleep)
+			{
+				xSleep = xLeft;
+			}
+
+			ppxLink = &pxCoro->pxNext;
+		}
+
+		if ((xPolling != pdFALSE) && (CORO_POLL_TICKS > 0U) && (xSleep > CORO_POLL_TICKS))
+		{
+			xSleep = CORO_POLL_TICKS;
+		}
+
+		if (xSleep > 0U)
+		{
+			(void)ulTaskNotifyTakeIndexed(CORO_NOTIFY_INDEX, pdTRUE, xSleep);
+		}
+	}
+}
+
+/**
+ * @brief Returns the state passed to coro_spawn().
+ * @param pxCoro Coroutine.
+ * @retval pvArg of the coroutine.
+ */
+void *coro_get_arg(const Coro_t *pxCoro)
+{
+	return pxCoro->pvArg;
+}
+
+/**
+ * @brief Makes the executor check its waiting coroutines (task side), e.g.
+ * after sending to a queue one of them waits on.
+ * @param pxExecutor Executor.
+ * @retval None
+ */
+void coro_wake(CoroExecutor_t *pxExecutor)
+{
+	if (pxExecutor->xTask != NULL)
+	{
+		(void)xTaskNotifyGiveIndexed(pxExecutor->xTask, CORO_NOTIFY_INDEX);
+	}
+}
+
+/**
+ * @brief Makes the executor check its waiting coroutines (ISR side).
+ * @param pxExecutor Executor.
+ * @param pxHigherPriorityTaskWoken Set if the executor must run on exit.
+ * @retval None
+ * @note Only from ISRs at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+void coro_wake_from_isr(CoroExecutor_t *pxExecutor, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	if (pxExecutor->xTask != NULL)
+	{
+		vTaskNotifyGiveIndexedFromISR(pxExecutor->xTask, CORO_NOTIFY_INDEX, pxHigherPriorityTaskWoken);
+	}
+}
+
+/**
+ * @brief Sets notification bits of a coroutine and wakes it from
+ * CORO_AWAIT_NOTIFY() (task side).
+ * @param pxCoro Coroutine to notify.
+ * @param ulBits Bits to set, not 0.
+ * @retval None
+ */
+void coro_notify(Coro_t *pxCoro, uint32_t ulBits)
+{
+	taskENTER_CRITICAL();
+	pxCoro->ulNotifyBits |= ulBits;
+	taskEXIT_CRITICAL();
+
+	coro_wake(pxCoro->pxExecutor);
+}
+
+/**
+ * @brief Sets notification bits of a coroutine and wakes it from
+ * CORO_AWAIT_NOTIFY() (ISR side).
+ * @param pxCoro Coroutine to notify.
+ * @param ulBits Bits to set, not 0.
+ * @param pxHigherPriorityTaskWoken Set if the executor must run on exit.
+ * @retval None
+ * @note Only from ISRs at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+void coro_notify_from_isr(Coro_t *pxCoro, uint32_t ulBits, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	pxCoro->ulNotifyBits |= ulBits;
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	coro_wake_from_isr(pxCoro->pxExecutor, pxHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Ends the coroutine (CORO_END()).
+ * @param pxCoro Coroutine.
+ * @retval None
+ */
+void coro_end_(Coro_t *pxCoro)
+{
+	pxCoro->ucState = CORO_STATE_DONE;
+}
+
+/**
+ * @brief Suspends the coroutine for xTicks ticks (CORO_DELAY()).
+ * @param pxCoro Coroutine.
+ * @param xTicks Ticks to wait.
+ * @retval None
+ */
+void coro_delay_(Coro_t *pxCoro, TickType_t xTicks)
+{
+	pxCoro->xWaitStart = xTaskGetTickCount();
+	pxCoro->xWaitTicks = xTicks;
+	pxCoro->ucState = CORO_STATE_DELAYED;
+}
+
+/**
+ * @brief Starts waiting for a condition for up to xTicks ticks
+ * (CORO_AWAIT_UNTIL()).
+ * @param pxCoro Coroutine.
+ * @param xTicks Timeout, portMAX_DELAY for none.
+ * @retval None
+ */
+void coro_await_(Coro_t *pxCoro, TickType_t xTicks)
+{
+	pxCoro->xWaitStart = xTaskGetTickCount();
+	pxCoro->xWaitTicks = xTicks;
+	pxCoro->ucState = CORO_STATE_WAITING;
+	pxCoro->ucTimedOut = 0;
+}
+
+/**
+ * @brief Returns the ticks to wait until *pxPreviousWakeTime + xTimeIncrement
+ * and advances *pxPreviousWakeTime (CORO_DELAY_UNTIL()).
+ * @param pxPreviousWakeTime Last wake time.
+ * @param xTimeIncrement Period.
+ * @retval Ticks to wait, 0 if the wake time has already passed.
+ * @note Same wrap handling as vTaskDelayUntil().
+ */
+TickType_t coro_ticks_until_(TickType_t *pxPreviousWakeTime, TickType_t xTimeIncrement)
+{
+	const TickType_t xNow = xTaskGetTickCount();
+	const TickType_t xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
+	BaseType_t xShouldDelay;
+
+	if (xNow < *pxPreviousWakeTime)
+	{
+		/* The tick count wrapped since the last wake: only wait if the wake
+		 * time wrapped too and is still ahead. */
+		xShouldDelay = ((xTimeToWake < *pxPreviousWakeTime) && (xTimeToWake > xNow)) ? pdTRUE : pdFALSE;
+	}
+	else
+	{
+		xShouldDelay = ((xTimeToWake < *pxPreviousWakeTime) || (xTimeToWake > xNow)) ? pdTRUE : pdFALSE;
+	}
+
+	*pxPreviousWakeTime = xTimeToWake;
+
+	return (xShouldDelay != pdFALSE) ? (TickType_t)(xTimeToWake - xNow) : 0U;
+}
+
+/**
+ * @brief Decides whether CORO_AWAIT_UNTIL() is over.
+ * @param pxCoro Coroutine.
+ * @param xConditionMet Result of the awaited condition.
+ * @retval pdTRUE to continue past the wait, pdFALSE to keep waiting.
+ */
+BaseType_t coro_check_(Coro_t *pxCoro, BaseType_t xConditionMet)
+{
+	if (xConditionMet != pdFALSE)
+	{
+		pxCoro->ucTimedOut = 0;
+	}
+	else if (coro_ticks_left(pxCoro, xTaskGetTickCount()) == 0U)
+	{
+		pxCoro->ucTimedOut = 1;
+	}
+	else
+	{
+		pxCoro->ucState = CORO_STATE_WAITING;
+		return pdFALSE;
+	}
+
+	pxCoro->ucState = CORO_STATE_READY;
+	return pdTRUE;
+}
+
+/**
+ * @brief Takes and clears the notification bits (CORO_AWAIT_NOTIFY()).
+ * @param pxCoro Coroutine.
+ * @retval Bits set since the last take.
+ */
+uint32_t coro_notify_take_(Coro_t *pxCoro)
+{
+	uint32_t ulBits;
+
+	taskENTER_CRITICAL();
+	ulBits = pxCoro->ulNotifyBits;
+	pxCoro->ulNotifyBits = 0;
+	taskEXIT_CRITICAL();
+
+	return ulBits;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Returns the ticks left of the current delay or timeout.
+ * @param pxCoro Delayed or waiting coroutine.
+ * @param xNow Current tick count.
+ * @retval Ticks left, 0 if expired, portMAX_DELAY if it never expires.
+ */
+static TickType_t coro_ticks_left(const Coro_t *pxCoro, TickType_t xNow)
+{
+	/* Unsigned subtraction keeps the elapsed time right across a wrap. */
+	const TickType_t xElapsed = xNow - pxCoro->xWaitStart;
+
+	if ((pxCoro->ucState == CORO_STATE_WAITING) && (pxCoro->xWaitTicks == portMAX_DELAY))
+	{
+		return portMAX_DELAY;
+	}
+
+	return (xElapsed >= pxCoro->xWaitTicks) ? 0U : (TickType_t)(pxCoro->xWaitTicks - xElapsed);
+}
+
+/**
+ * @brief Task running an executor.
+ * @param pvParameters Executor to run.
+ * @retval None
+ */
+static void coro_executor_task(void *pvParameters)
+{
+	coro_executor_run((CoroExecutor_t *)pvParameters);
+}
@@ -0,0 +1,278 @@
+/*******************************************************************************
+ *
+ * @file	dvfs.c
+ * @brief	Governor switching the clock profile to follow the CPU load.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	A task wakes up every DVFS_PERIOD_MS, reads the load (see
+ * 			cpuload.h) and moves one profile at a time between the limits
+ * 			set by dvfs_set_limits():
+ *
+ * 			- Up as soon as one window is loaded DVFS_UP_LOAD or more, so a
+ * 			  burst gets the faster clock within one or two windows.
+ * 			- Down only once the 1 s load, scaled to the clock of the profile
+ * 			  below, has stayed under DVFS_DOWN_LOAD for DVFS_DOWN_HOLD_MS.
+ * 			  The load is predicted there rather than measured here, and
+ * 			  the prediction has to leave headroom under DVFS_UP_LOAD, so
+ * 			  the governor does not step down into a profile that it would
+ * 			  leave again at the next window.
+ *
+ * 			clock_set_profile() does the switch: SystemCoreClock (and so
+ * 			configCPU_CLOCK_HZ), the HAL time base, the SysTick reload and
+ * 			the USART dividers follow the new clock. Task delays are in
+ * 			ticks and keep their length. Anything counted in core clock
+ * 			cycles does not: cycle budgets are to be recomputed in
+ * 			clock_profile_changed_callback(), and cycle-based run-time stats
+ * 			mix frequencies across a switch.
+ *
+ * 			A switch that fails (the HSE profiles need the ST-LINK MCO) is
+ * 			not retried: the profile reached becomes the ceiling until the
+ * 			next dvfs_set_limits(), as each attempt holds the scheduler for
+ * 			the HSE start-up timeout.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "dvfs.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define DVFS_PERIOD_TICKS		pdMS_TO_TICKS(DVFS_PERIOD_MS)
+#define DVFS_DOWN_HOLD_PERIODS	(DVFS_DOWN_HOLD_MS / DVFS_PERIOD_MS)
+
+#if (DVFS_DOWN_LOAD >= DVFS_UP_LOAD)
+#error DVFS_DOWN_LOAD must be below DVFS_UP_LOAD, or the governor oscillates
+#endif
+
+/* Variables -----------------------------------------------------------------*/
+/* Written by dvfs_set_limits() from any task, in a critical section. */
+static ClockProfile_t eLimitMin = CLOCK_PROFILE_LOW_POWER;
+static ClockProfile_t eLimitMax = CLOCK_PROFILE_MAX_PERFORMANCE;
+static ClockProfile_t eCeiling = CLOCK_PROFILE_MAX_PERFORMANCE;	/* eLimitMax, or below after a failure. */
+static DvfsStats_t xStats;
+
+/* Private function prototypes -----------------------------------------------*/
+static void dvfs_task(void *pvParameters);
+static ClockProfile_t dvfs_decide(ClockProfile_t eCurrent, const CpuLoad_t *pxLoad,
+		uint32_t *pulLowPeriods);
+static void dvfs_report(void);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Creates the governor task.
+ * @param uxPriority Priority of the governor, above the tasks whose load it
+ * follows so that it is not starved by them.
+ * @param ulReportMs Period of the printed report in milliseconds, 0 for none.
+ * @retval pdPASS if the task was created.
+ */
+BaseType_t dvfs_start(UBaseType_t uxPriority, uint32_t ulReportMs)
+{
+	return xTaskCreate(dvfs_task,
+					   "Dvfs",
+					   DVFS_STACK_WORDS,
+					   (void *)ulReportMs,
+					   uxPriority,
+					   NULL);
+}
+
+/**
+ * @brief Sets the profiles the governor may use.
+ * @param eMin Slowest profile, e.g. the fastest one meeting a deadline.
+ * @param eMax Fastest profile, e.g. the slowest one when the power budget is.
+ * The same as eMin fixes the profile.
+ * @retval 0 if successful, -1 otherwise.
+ * @note Applied at the next period. Clears the ceiling left by a failed switch.
+ */
+int32_t dvfs_set_limits(ClockProfile_t eMin, ClockProfile_t eMax)
+{
+	if ((eMin > eMax) || (eMax >= CLOCK_PROFILE_COUNT))
+	{
+		return -1;
+	}
+
+	taskENTER_CRITICAL();
+	eLimitMin = eMin;
+	eLimitMax = eMax;
+	eCeiling = eMax;
+	taskEXIT_CRITICAL();
+
+	return 0;
+}
+
+/**
+ * @brief Reads the governor's counters.
+ * @param pxStats Where the counters are written.
+ * @retval None
+ * @note The time in each profile is accounted once per period.
+ */
+void dvfs_get_stats(DvfsStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = xStats;
+	taskEXIT_CRITICAL();
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Follows the load every DVFS_PERIOD_MS, and prints the report.
+ * @param pvParameters Report period in milliseconds, 0 for none.
+ * @retval None
+ */
+static void dvfs_task(void *pvParameters)
+{
+	const TickType_t xReportTicks = pdMS_TO_TICKS((uint32_t)pvParameters);
+	TickType_t xLastWakeTicks = xTaskGetTickCount();
+	TickType_t xLastAccount = xLastWakeTicks;
+	TickType_t xLastReport = xLastWakeTicks;
+	ClockProfile_t eCurrent;
+	ClockProfile_t eTarget;
+	CpuLoad_t xLoad;
+	uint32_t ulLowPeriods = 0U;
+
+	while (1)
+	{
+		vTaskDelayUntil(&xLastWakeTicks, DVFS_PERIOD_TICKS);
+
+		eCurrent = clock_get_profile();
+		cpuload_get(&xLoad);
+
+		taskENTER_CRITICAL();
+		xStats.ulTicks[eCurrent] += xLastWakeTicks - xLastAccount;
+		taskEXIT_CRITICAL();
+		xLastAccount = xLastWakeTicks;
+
+		eTarget = dvfs_decide(eCurrent, &xLoad, &ulLowPeriods);
+
+		if (eTarget != eCurrent)
+		{
+			if (clock_set_profile(eTarget) != 0)
+			{
+				taskENTER_CRITICAL();
+				eCeiling = clock_get_profile();
+				xStats.ulFailures++;
+				taskEXIT_CRITICAL();
+			}
+
+			if (clock_get_profile() != eCurrent)
+			{
+				taskENTER_CRITICAL();
+				xStats.ulSwitches++;
+				taskEXIT_CRITICAL();
+			}
+
+			/* The next decision to step down starts from a fresh hold. */
+			ulLowPeriods = 0U;
+		}
+
+		if ((xReportTicks != 0U) && ((TickType_t)(xLastWakeTicks - xLastReport) >= xReportTicks))
+		{
+			xLastReport = xLastWakeTicks;
+			dvfs_report();
+		}
+	}
+}
+
+/**
+ * @brief Picks the profile for the next period.
+ * @param eCurrent Profile in effect.
+ * @param pxLoad Load measured in eCurrent.
+ * @param pulLowPeriods Periods the profile below has been predicted to stay
+ * under DVFS_DOWN_LOAD, updated.
+ * @retval The profile to switch to, eCurrent to stay.
+ */
+static ClockProfile_t dvfs_decide(ClockProfile_t eCurrent, const CpuLoad_t *pxLoad,
+		uint32_t *pulLowPeriods)
+{
+	ClockProfile_t eMin;
+	ClockProfile_t eMax;
+	uint32_t ulPredicted;
+
+	taskENTER_CRITICAL();
+	eMin = eLimitMin;
+	eMax = (eCeiling < eLimitMax) ? eCeiling : eLimitMax;
+	taskEXIT_CRITICAL();
+
+	if (eMax < eMin)
+	{
+		/* The ceiling of a failure wins: eMin cannot be reached. */
+		eMin = eMax;
+	}
+
+	/* Limits changed by the application. */
+	if (eCurrent < eMin)
+	{
+		return eMin;
+	}
+
+	if (eCurrent > eMax)
+	{
+		return eMax;
+	}
+
+	if ((pxLoad->usLoad100ms >= DVFS_UP_LOAD) && (eCurrent < eMax))
+	{
+		return (ClockProfile_t)(eCurrent + 1);
+	}
+
+	if (eCurrent == eMin)
+	{
+		*pulLowPeriods = 0U;
+		return eCurrent;
+	}
+
+	/* The same work in fewer cycles per second. */
+	ulPredicted = (uint32_t)(((uint64_t)pxLoad->usLoad1s * clock_get_profile_hz(eCurrent))
+			/ clock_get_profile_hz((ClockProfile_t)(eCurrent - 1)));
+
+	if (ulPredicted >= DVFS_DOWN_LOAD)
+	{
+		*pulLowPeriods = 0U;
+		return eCurrent;
+	}
+
+	if (++(*pulLowPeriods) < DVFS_DOWN_HOLD_PERIODS)
+	{
+		return eCurrent;
+	}
+
+	return (ClockProfile_t)(eCurrent - 1);
+}
+
+/**
+ * @brief Prints the profile in effect, the switches and the share of time
+ * spent in each profile.
+ * @param None
+ * @retval None
+ */
+static void dvfs_report(void)
+{
+	DvfsStats_t xNow;
+	uint64_t ullTotal = 0U;
+	char cShare[CPULOAD_STR_LEN];
+	uint32_t x;
+
+	dvfs_get_stats(&xNow);
+
+	for (x = 0; x < CLOCK_PROFILE_COUNT; x++)
+	{
+		ullTotal += xNow.ulTicks[x];
+	}
+
+	printf("DVFS: %lu MHz, %lu switches, %lu failed, time at",
+			clock_get_profile_hz(clock_get_profile()) / 1000000U,
+			xNow.ulSwitches, xNow.ulFailures);
+
+	for (x = 0; x < CLOCK_PROFILE_COUNT; x++)
+	{
+		printf(" %lu MHz %s", clock_get_profile_hz((ClockProfile_t)x) / 1000000U,
+				cpuload_format((ullTotal == 0U) ? 0U :
+						(uint16_t)(((uint64_t)xNow.ulTicks[x] * CPULOAD_FULL) / ullTotal),
+						cShare));
+	}
+
+	printf("\r\n");
+}
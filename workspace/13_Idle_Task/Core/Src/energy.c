@@ -0,0 +1,667 @@
+/*******************************************************************************
+ *
+ * @file	energy.c
+ * @brief	Energy charged to each task, estimated from a current model.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	There is no current sensor: the energy is estimated from what the
+ * 			kernel and the drivers already know, and a model of the board
+ * 			(EnergyModel_t) giving the supply current in each state.
+ *
+ * 			- CPU: every ENERGY_PERIOD_MS, and at every clock profile
+ * 			  change, the run time of each task since the last accounting
+ * 			  (run-time stats, runstats.c) is charged at the run current of
+ * 			  the profile in force over it.
+ * 			- Sleep: the idle task's run time includes the time the core
+ * 			  slept. What lowpower.c measured in SLEEP mode is charged at
+ * 			  the sleep current of the profile instead, and what it measured
+ * 			  in STOP mode at the stop current.
+ * 			- Clocks: a peripheral clock held through clkgate.h draws its
+ * 			  current, in proportion to HCLK, whichever task runs. It is
+ * 			  charged to the tasks holding it, shared equally, from the
+ * 			  moment each hold is taken to the moment it is let go
+ * 			  (clkgate_hold_callback()). Holds taken from an ISR go to the
+ * 			  system entry.
+ *
+ * 			Current is integrated over time in run-time counter units, the
+ * 			core clock cycles: at f MHz, a current of I uA for n cycles is
+ * 			I * n / f uA us, times the supply voltage. Clock currents are
+ * 			per MHz, so they need no profile at all. The energy is kept in
+ * 			nJ, 64 bits, and reported in uJ.
+ *
+ * 			The run time counted after a profile change and before the
+ * 			callback is charged at the old profile's current; the same
+ * 			goes for clocks held in STOP mode, where the non-critical ones
+ * 			(GPIO ports) stand still. Both are small next to the model's
+ * 			own error, which is set by how well its figures were measured.
+ *
+ * 			With ENERGY_TELEMETRY 1 the energy of each task, in uJ, is also
+ * 			a telemetry counter named "uJ <task>", so the host decoder
+ * 			plots the breakdown over time.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clock.h"
+#include "clkgate.h"
+#include "lowpower.h"
+#include "energy.h"
+#if (ENERGY_TELEMETRY == 1)
+#include "telemetry.h"
+#endif
+
+#if (configGENERATE_RUN_TIME_STATS == 1) && (configUSE_TRACE_FACILITY == 1)
+
+#if (INCLUDE_xTaskGetIdleTaskHandle != 1)
+#error energy.c tells the idle task apart: set INCLUDE_xTaskGetIdleTaskHandle to 1
+#endif
+
+/* Macros --------------------------------------------------------------------*/
+#define ENERGY_SYSTEM		ENERGY_MAX_TASKS		/* Entry of the holds from ISRs. */
+#define ENERGY_ENTRIES		(ENERGY_MAX_TASKS + 1U)
+#define ENERGY_LABEL_LEN	configMAX_TASK_NAME_LEN	/* Telemetry cuts longer names. */
+#define ENERGY_LABEL_PREFIX	"uJ "
+
+#define ENERGY_FREE			0U
+#define ENERGY_LIVE			1U
+#define ENERGY_DELETED		2U
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	TaskHandle_t xHandle;
+	uint8_t ucState;
+	char cName[configMAX_TASK_NAME_LEN];
+	configRUN_TIME_COUNTER_TYPE xLastRunTime;
+	uint64_t ullClockCharge;			/* nA us of held clocks, not yet converted. */
+	uint64_t ullCpuNj;
+	uint64_t ullClockNj;
+#if (ENERGY_TELEMETRY == 1)
+	char cLabel[ENERGY_LABEL_LEN];
+	uint8_t ucPublished;
+	volatile uint32_t ulPublishedUj;	/* Read by the telemetry task. */
+#endif
+} EnergyEntry_t;
+
+/* Variables -----------------------------------------------------------------*/
+/* Typical figures of the STM32F446 datasheet at 3.3 V and 25 C, running from
+ * flash with the ART accelerator on, for the profiles of clock.c. Peripheral
+ * clocks are per MHz of HCLK at the bus dividers of those profiles. The
+ * clocks not listed are counted as drawing nothing. Replace them with the
+ * readings of lowpower_current_benchmark() on the IDD jumper. */
+const EnergyModel_t xEnergyModelNucleoF446RE =
+{
+	.ulSupplyMv = 3300U,
+	.ulRunUa = { 16000U, 34000U, 37500U },
+	.ulSleepUa = { 4300U, 8800U, 9500U },
+	.ulStopUa = 280U,
+	.usClockNaPerMhz =
+	{
+		[CLKGATE_GPIOA] = 2400U,
+		[CLKGATE_GPIOB] = 2400U,
+		[CLKGATE_GPIOC] = 2400U,
+		[CLKGATE_GPIOD] = 2400U,
+		[CLKGATE_GPIOE] = 2400U,
+		[CLKGATE_GPIOF] = 2400U,
+		[CLKGATE_GPIOG] = 2400U,
+		[CLKGATE_GPIOH] = 2400U,
+		[CLKGATE_CRC] = 400U,
+		[CLKGATE_DMA1] = 3400U,
+		[CLKGATE_DMA2] = 3400U,
+		[CLKGATE_TIM2] = 3000U,
+		[CLKGATE_TIM3] = 2200U,
+		[CLKGATE_TIM4] = 2200U,
+		[CLKGATE_TIM6] = 600U,
+		[CLKGATE_TIM7] = 600U,
+		[CLKGATE_USART2] = 1000U,
+		[CLKGATE_USART3] = 1000U,
+		[CLKGATE_UART4] = 1000U,
+		[CLKGATE_UART5] = 1000U,
+		[CLKGATE_TIM1] = 6000U,
+		[CLKGATE_TIM8] = 6000U,
+		[CLKGATE_USART1] = 1500U,
+		[CLKGATE_USART6] = 1500U,
+		[CLKGATE_ADC1] = 2000U,
+		[CLKGATE_ADC2] = 2000U,
+		[CLKGATE_ADC3] = 2000U,
+		[CLKGATE_SYSCFG] = 400U,
+	},
+};
+
+static const EnergyModel_t *volatile pxModel = NULL;	/* Set once by energy_start(). */
+static ClockProfile_t eProfile;							/* Over the time not yet accounted. */
+
+/* Entries and holds, written in critical sections (also by ISRs). */
+static EnergyEntry_t xEntries[ENERGY_ENTRIES];
+static uint8_t ucHolds[CLKGATE_COUNT][ENERGY_ENTRIES];
+static uint8_t ucClockHolds[CLKGATE_COUNT];
+static configRUN_TIME_COUNTER_TYPE xClockSince[CLKGATE_COUNT];
+
+/* Written with the scheduler suspended. */
+static TaskStatus_t xTasks[ENERGY_MAX_TASKS];
+static BaseType_t xBaselined = pdFALSE;
+static configRUN_TIME_COUNTER_TYPE xLastTime = 0;
+static uint64_t ullLastSleepTime = 0;
+static uint64_t ullLastStopTime = 0;
+static uint64_t ullElapsedUs = 0;
+static uint64_t ullSleepUs = 0;
+static uint64_t ullStopUs = 0;
+static uint64_t ullSleepNj = 0;
+static uint64_t ullStopNj = 0;
+static uint32_t ulUntracked = 0;
+
+/* Private function prototypes -----------------------------------------------*/
+static void energy_task(void *pvParameters);
+static void energy_account(void);
+static UBaseType_t energy_entry_of(TaskHandle_t xHandle);
+static void energy_settle_clock(uint32_t ulClock, configRUN_TIME_COUNTER_TYPE xNow);
+static uint64_t energy_nj(uint64_t ullCycles, uint32_t ulUa, uint32_t ulMhz);
+#if (ENERGY_TELEMETRY == 1)
+static void energy_publish(void);
+#endif
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Starts the accounting, and creates its task.
+ * @param pxBoard Current model of the board, kept by reference.
+ * @param uxPriority Priority of the accounting task, below the real-time tasks.
+ * @param ulReportMs Period of the printed report in milliseconds, 0 for none.
+ * @retval pdPASS if the task was created.
+ * @note Call before vTaskStartScheduler(), after the clock profile is set, so
+ * every clock hold and every tick of run time is seen.
+ */
+BaseType_t energy_start(const EnergyModel_t *pxBoard, UBaseType_t uxPriority, uint32_t ulReportMs)
+{
+	if ((pxBoard == NULL) || (pxModel != NULL))
+	{
+		return pdFAIL;
+	}
+
+	eProfile = clock_get_profile();
+	strcpy(xEntries[ENERGY_SYSTEM].cName, "system");
+	xEntries[ENERGY_SYSTEM].ucState = ENERGY_LIVE;
+	pxModel = pxBoard;
+
+	return xTaskCreate(energy_task,
+					   "Energy",
+					   ENERGY_STACK_WORDS,
+					   (void *)ulReportMs,
+					   uxPriority,
+					   NULL);
+}
+
+/**
+ * @brief Accounts the time run at the previous profile, before the new one
+ * applies.
+ * @param eNew The new profile.
+ * @retval None
+ * @note Call from clock_profile_changed_callback().
+ */
+void energy_profile_changed(ClockProfile_t eNew)
+{
+	if ((pxModel != NULL) && (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED))
+	{
+		vTaskSuspendAll();
+		energy_account();
+		eProfile = eNew;
+		(void)xTaskResumeAll();
+	}
+	else
+	{
+		eProfile = eNew;
+	}
+}
+
+/**
+ * @brief Copies the energy charged so far.
+ * @param pxTasks Array of uxSize entries, filled with the tasks ever seen and
+ * then the system entry.
+ * @param uxSize Size of the array.
+ * @param pxSummary Totals, or NULL.
+ * @retval Number of entries written.
+ * @note As of the last accounting, at most ENERGY_PERIOD_MS old.
+ */
+UBaseType_t energy_get(EnergyTask_t *pxTasks, UBaseType_t uxSize, EnergySummary_t *pxSummary)
+{
+	UBaseType_t uxCount = 0;
+	uint64_t ullTotalNj = 0;
+	UBaseType_t x;
+
+	vTaskSuspendAll();
+
+	for (x = 0; x < ENERGY_ENTRIES; x++)
+	{
+		const EnergyEntry_t *pxEntry = &xEntries[x];
+
+		if (pxEntry->ucState == ENERGY_FREE)
+		{
+			continue;
+		}
+
+		ullTotalNj += pxEntry->ullCpuNj + pxEntry->ullClockNj;
+
+		if (uxCount < uxSize)
+		{
+			pxTasks[uxCount].pcName = pxEntry->cName;
+			pxTasks[uxCount].xHandle = (x == ENERGY_SYSTEM) ? NULL : pxEntry->xHandle;
+			pxTasks[uxCount].xDeleted = (pxEntry->ucState == ENERGY_DELETED) ? pdTRUE : pdFALSE;
+			pxTasks[uxCount].ullCpuUj = pxEntry->ullCpuNj / 1000U;
+			pxTasks[uxCount].ullClockUj = pxEntry->ullClockNj / 1000U;
+			uxCount++;
+		}
+	}
+
+	if (pxSummary != NULL)
+	{
+		pxSummary->ulElapsedMs = (uint32_t)(ullElapsedUs / 1000U);
+		pxSummary->ulSleepMs = (uint32_t)(ullSleepUs / 1000U);
+		pxSummary->ulStopMs = (uint32_t)(ullStopUs / 1000U);
+		pxSummary->ullTotalUj = ullTotalNj / 1000U;
+		pxSummary->ullSleepUj = ullSleepNj / 1000U;
+		pxSummary->ullStopUj = ullStopNj / 1000U;
+		/* nJ per ms is uW, and uW per mV is mA. */
+		pxSummary->ulAverageUa = ((ullElapsedUs < 1000U) || (pxModel == NULL)) ? 0U :
+				(uint32_t)(((ullTotalNj / (ullElapsedUs / 1000U)) * 1000U) / pxModel->ulSupplyMv);
+		pxSummary->ulUntracked = ulUntracked;
+	}
+
+	(void)xTaskResumeAll();
+
+	return uxCount;
+}
+
+/**
+ * @brief Prints the energy of each task, in mJ, and its share of the total.
+ * @param None
+ * @retval None
+ */
+void energy_print(void)
+{
+	EnergyTask_t xReport[ENERGY_ENTRIES];
+	EnergySummary_t xSummary;
+	UBaseType_t uxCount;
+	UBaseType_t x;
+	uint64_t ullUj;
+	uint32_t ulShare;
+
+	uxCount = energy_get(xReport, ENERGY_ENTRIES, &xSummary);
+
+	printf("Energy: %lu.%03lu mJ over %lu ms, %lu uA average, sleep %lu ms, stop %lu ms\r\n",
+			(uint32_t)(xSummary.ullTotalUj / 1000U), (uint32_t)(xSummary.ullTotalUj % 1000U),
+			xSummary.ulElapsedMs, xSummary.ulAverageUa, xSummary.ulSleepMs, xSummary.ulStopMs);
+	printf("%-*s %12s %12s %8s\r\n", configMAX_TASK_NAME_LEN, "Task", "CPU mJ", "Clocks mJ",
+			"Share");
+
+	for (x = 0; x < uxCount; x++)
+	{
+		ullUj = xReport[x].ullCpuUj + xReport[x].ullClockUj;
+		ulShare = (xSummary.ullTotalUj == 0U) ? 0U :
+				(uint32_t)((ullUj * 10000U) / xSummary.ullTotalUj);
+
+		printf("%-*s %8lu.%03lu %8lu.%03lu %4lu.%02lu%%%s\r\n", configMAX_TASK_NAME_LEN,
+				xReport[x].pcName,
+				(uint32_t)(xReport[x].ullCpuUj / 1000U), (uint32_t)(xReport[x].ullCpuUj % 1000U),
+				(uint32_t)(xReport[x].ullClockUj / 1000U), (uint32_t)(xReport[x].ullClockUj % 1000U),
+				ulShare / 100U, ulShare % 100U,
+				(xReport[x].xDeleted != pdFALSE) ? " (deleted)" : "");
+	}
+
+	if (xSummary.ulUntracked != 0U)
+	{
+		printf("%lu accountings missed tasks: raise ENERGY_MAX_TASKS.\r\n", xSummary.ulUntracked);
+	}
+}
+
+/**
+ * @brief Follows the holds of the peripheral clocks (clkgate.c).
+ * @param pxUser The hold, with the task that took it.
+ * @param xHeld pdTRUE when taken, pdFALSE when let go.
+ * @retval None
+ * @note Runs in the critical section of clkgate_acquire() or
+ * clkgate_release(), from a task or an ISR.
+ */
+void clkgate_hold_callback(const ClkGateUser_t *pxUser, BaseType_t xHeld)
+{
+	const uint32_t ulClock = pxUser->ucClock;
+	UBaseType_t uxEntry;
+
+	if (pxModel == NULL)
+	{
+		return;
+	}
+
+	/* The holders so far are charged up to now, before the share changes. */
+	energy_settle_clock(ulClock, portGET_RUN_TIME_COUNTER_VALUE());
+
+	if (xHeld != pdFALSE)
+	{
+		uxEntry = energy_entry_of(pxUser->xOwner);
+		ucHolds[ulClock][uxEntry]++;
+		ucClockHolds[ulClock]++;
+		return;
+	}
+
+	/* Let go by its owner, alive or not, or by the entry it fell back to. */
+	for (uxEntry = 0; uxEntry < ENERGY_ENTRIES; uxEntry++)
+	{
+		if ((ucHolds[ulClock][uxEntry] != 0U) && (xEntries[uxEntry].xHandle == pxUser->xOwner))
+		{
+			break;
+		}
+	}
+
+	if ((uxEntry == ENERGY_ENTRIES) && (ucHolds[ulClock][ENERGY_SYSTEM] != 0U))
+	{
+		uxEntry = ENERGY_SYSTEM;
+	}
+
+	/* Not found: taken before energy_start(). */
+	if (uxEntry < ENERGY_ENTRIES)
+	{
+		ucHolds[ulClock][uxEntry]--;
+		ucClockHolds[ulClock]--;
+	}
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Accounts every ENERGY_PERIOD_MS, and prints the report.
+ * @param pvParameters Report period in milliseconds, 0 for none.
+ * @retval None
+ */
+static void energy_task(void *pvParameters)
+{
+	const TickType_t xReportTicks = pdMS_TO_TICKS((uint32_t)pvParameters);
+	TickType_t xLastWakeTicks = xTaskGetTickCount();
+	TickType_t xLastReport = xLastWakeTicks;
+
+	/* The run time of the tasks so far is not charged. */
+	vTaskSuspendAll();
+	energy_account();
+	(void)xTaskResumeAll();
+
+	while (1)
+	{
+		vTaskDelayUntil(&xLastWakeTicks, pdMS_TO_TICKS(ENERGY_PERIOD_MS));
+
+		vTaskSuspendAll();
+		energy_account();
+		(void)xTaskResumeAll();
+
+#if (ENERGY_TELEMETRY == 1)
+		energy_publish();
+#endif
+
+		if ((xReportTicks != 0U) && ((xLastWakeTicks - xLastReport) >= xReportTicks))
+		{
+			xLastReport = xLastWakeTicks;
+			energy_print();
+		}
+	}
+}
+
+/**
+ * @brief Charges the time since the last accounting, at the current eProfile.
+ * @param None
+ * @retval None
+ * @note With the scheduler suspended. The first call only sets the baselines.
+ */
+static void energy_account(void)
+{
+	const EnergyModel_t *pxBoard = pxModel;
+	const uint32_t ulMhz = clock_get_profile_hz(eProfile) / 1000000U;
+	const TaskHandle_t xIdle = xTaskGetIdleTaskHandle();
+	configRUN_TIME_COUNTER_TYPE xNow = 0;
+	configRUN_TIME_COUNTER_TYPE xRun;
+	LowPowerStats_t xLowPower;
+	EnergyEntry_t *pxEntry;
+	UBaseType_t uxTasks;
+	UBaseType_t uxEntry;
+	UBaseType_t x;
+	uint64_t ullSleep;
+	uint64_t ullStop;
+	uint64_t ullCharge;
+	uint8_t ucFound[ENERGY_ENTRIES] = { 0 };
+
+	uxTasks = uxTaskGetSystemState(xTasks, ENERGY_MAX_TASKS, &xNow);
+	lowpower_get_stats(&xLowPower);
+
+	if (uxTasks == 0U)
+	{
+		/* More tasks than xTasks holds: their run time waits for the next. */
+		ulUntracked++;
+		return;
+	}
+
+	ullSleep = xLowPower.ullSleepTime - ullLastSleepTime;
+	ullStop = xLowPower.ullStopTime - ullLastStopTime;
+	ullLastSleepTime = xLowPower.ullSleepTime;
+	ullLastStopTime = xLowPower.ullStopTime;
+
+	if ((xBaselined != pdFALSE) && (ulMhz != 0U))
+	{
+		ullElapsedUs += (xNow - xLastTime) / ulMhz;
+	}
+
+	xLastTime = xNow;
+
+	for (x = 0; x < uxTasks; x++)
+	{
+		taskENTER_CRITICAL();
+		uxEntry = energy_entry_of(xTasks[x].xHandle);
+		taskEXIT_CRITICAL();
+
+		pxEntry = &xEntries[uxEntry];
+		ucFound[uxEntry] = 1U;
+
+		if (uxEntry == ENERGY_SYSTEM)
+		{
+			/* No entry left, the deleted tasks keep theirs. */
+			ulUntracked++;
+			continue;
+		}
+
+		if (pxEntry->cName[0] == '\0')
+		{
+			strncpy(pxEntry->cName, xTasks[x].pcTaskName, configMAX_TASK_NAME_LEN - 1U);
+		}
+
+		/* A handle reused by a new task starts again from its run time. */
+		xRun = (xTasks[x].ulRunTimeCounter >= pxEntry->xLastRunTime) ?
+				(xTasks[x].ulRunTimeCounter - pxEntry->xLastRunTime) : xTasks[x].ulRunTimeCounter;
+		pxEntry->xLastRunTime = xTasks[x].ulRunTimeCounter;
+
+		/* The run time before the first accounting is not charged. Tasks
+		 * created afterwards are charged from their start. */
+		if ((xBaselined == pdFALSE) || (ulMhz == 0U))
+		{
+			continue;
+		}
+
+		if (xTasks[x].xHandle == xIdle)
+		{
+			/* The core slept inside the idle task's run time. */
+			if (ullSleep > xRun)
+			{
+				ullSleep = xRun;
+			}
+
+			if (ullStop > (xRun - ullSleep))
+			{
+				ullStop = xRun - ullSleep;
+			}
+
+			ullSleepUs += ullSleep / ulMhz;
+			ullStopUs += ullStop / ulMhz;
+			ullSleepNj += energy_nj(ullSleep, pxBoard->ulSleepUa[eProfile], ulMhz);
+			ullStopNj += energy_nj(ullStop, pxBoard->ulStopUa, ulMhz);
+
+			pxEntry->ullCpuNj += energy_nj(ullSleep, pxBoard->ulSleepUa[eProfile], ulMhz)
+					+ energy_nj(ullStop, pxBoard->ulStopUa, ulMhz);
+			xRun -= ullSleep + ullStop;
+		}
+
+		pxEntry->ullCpuNj += energy_nj(xRun, pxBoard->ulRunUa[eProfile], ulMhz);
+	}
+
+	/* Clocks: charge every held one up to now, then convert the charges. */
+	taskENTER_CRITICAL();
+
+	for (x = 0; x < CLKGATE_COUNT; x++)
+	{
+		if (ucClockHolds[x] != 0U)
+		{
+			energy_settle_clock(x, xNow);
+		}
+	}
+
+	for (x = 0; x < ENERGY_ENTRIES; x++)
+	{
+		pxEntry = &xEntries[x];
+		ullCharge = pxEntry->ullClockCharge;
+		pxEntry->ullClockCharge = 0U;
+
+		/* nA us times mV is fJ. */
+		pxEntry->ullClockNj += (ullCharge * pxBoard->ulSupplyMv) / 1000000000U;
+
+		if ((pxEntry->ucState == ENERGY_LIVE) && (ucFound[x] == 0U) && (x != ENERGY_SYSTEM))
+		{
+			/* Deleted. Its handle is kept to let go of the clocks it held. */
+			pxEntry->ucState = ENERGY_DELETED;
+		}
+	}
+
+	taskEXIT_CRITICAL();
+
+	xBaselined = pdTRUE;
+}
+
+/**
+ * @brief Finds the entry of a task, taking a free one for a new task.
+ * @param xHandle Task, NULL for an ISR.
+ * @retval Index of the entry, ENERGY_SYSTEM for an ISR or without a free one.
+ * @note In a critical section.
+ */
+static UBaseType_t energy_entry_of(TaskHandle_t xHandle)
+{
+	UBaseType_t uxFree = ENERGY_SYSTEM;
+	UBaseType_t x;
+
+	if (xHandle == NULL)
+	{
+		return ENERGY_SYSTEM;
+	}
+
+	for (x = 0; x < ENERGY_MAX_TASKS; x++)
+	{
+		if ((xEntries[x].ucState == ENERGY_LIVE) && (xEntries[x].xHandle == xHandle))
+		{
+			return x;
+		}
+
+		if ((xEntries[x].ucState == ENERGY_FREE) && (uxFree == ENERGY_SYSTEM))
+		{
+			uxFree = x;
+		}
+	}
+
+	if (uxFree != ENERGY_SYSTEM)
+	{
+		/* Named and baselined by the next accounting. */
+		xEntries[uxFree].xHandle = xHandle;
+		xEntries[uxFree].ucState = ENERGY_LIVE;
+	}
+
+	return uxFree;
+}
+
+/**
+ * @brief Charges the holders of a clock up to a time.
+ * @param ulClock ClkGate_t.
+ * @param xNow Run-time counter value.
+ * @retval None
+ * @note In a critical section.
+ */
+static void energy_settle_clock(uint32_t ulClock, configRUN_TIME_COUNTER_TYPE xNow)
+{
+	uint64_t ullShare;
+	UBaseType_t x;
+
+	if (xNow <= xClockSince[ulClock])
+	{
+		/* Already settled later, by an ISR. */
+		return;
+	}
+
+	if (ucClockHolds[ulClock] != 0U)
+	{
+		/* Per MHz times cycles: nA us, at any profile. */
+		ullShare = ((uint64_t)pxModel->usClockNaPerMhz[ulClock] * (xNow - xClockSince[ulClock]))
+				/ ucClockHolds[ulClock];
+
+		for (x = 0; x < ENERGY_ENTRIES; x++)
+		{
+			if (ucHolds[ulClock][x] != 0U)
+			{
+				xEntries[x].ullClockCharge += ullShare * ucHolds[ulClock][x];
+			}
+		}
+	}
+
+	xClockSince[ulClock] = xNow;
+}
+
+/**
+ * @brief Converts a time at a current into energy.
+ * @param ullCycles Run-time counter units.
+ * @param ulUa Current in uA.
+ * @param ulMhz Core clock the cycles were counted at.
+ * @retval Energy in nJ.
+ */
+static uint64_t energy_nj(uint64_t ullCycles, uint32_t ulUa, uint32_t ulMhz)
+{
+	/* uA us times mV is fJ. */
+	return (((ullCycles * ulUa) / ulMhz) * pxModel->ulSupplyMv) / 1000000U;
+}
+
+#if (ENERGY_TELEMETRY == 1)
+/**
+ * @brief Updates the telemetry counters, adding those of new tasks.
+ * @param None
+ * @retval None
+ * @note Entries past TELEMETRY_MAX_COUNTERS are not streamed.
+ */
+static void energy_publish(void)
+{
+	EnergyEntry_t *pxEntry;
+	UBaseType_t x;
+
+	for (x = 0; x < ENERGY_ENTRIES; x++)
+	{
+		pxEntry = &xEntries[x];
+
+		if ((pxEntry->ucState == ENERGY_FREE) || (pxEntry->cName[0] == '\0'))
+		{
+			continue;
+		}
+
+		pxEntry->ulPublishedUj = (uint32_t)((pxEntry->ullCpuNj + pxEntry->ullClockNj) / 1000U);
+
+		if (pxEntry->ucPublished == 0U)
+		{
+			(void)snprintf(pxEntry->cLabel, ENERGY_LABEL_LEN, "%s%s", ENERGY_LABEL_PREFIX,
+					pxEntry->cName);
+			pxEntry->ucPublished = 1U;
+			(void)telemetry_add_counter(pxEntry->cLabel, &pxEntry->ulPublishedUj);
+		}
+	}
+}
+#endif
+
+#endif /* (configGENERATE_RUN_TIME_STATS == 1) && (configUSE_TRACE_FACILITY == 1) */
@@ -0,0 +1,801 @@
+/*******************************************************************************
+ *
+ * @file	flashlog.c
+ * @brief	Log store in internal flash, programmed and erased from the idle
+ * 			task.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	The STM32F446 has a single flash bank: while a word is programmed
+ * 			(16 us, 100 us at worst) or a sector erased (1 s, 2 s at worst for
+ * 			128 KB), every instruction fetch from flash stalls, and so does
+ * 			every interrupt whose vector or handler is in flash.
+ *
+ * 			So flashlog_write() only copies the record into a RAM buffer,
+ * 			from a task or an interrupt. Two idle jobs (see idlejob.h) do the
+ * 			flash work, in time no task wants:
+ *
+ * 			- The program job writes FLASHLOG_BATCH_WORDS words per step, a
+ * 			  stall of one batch at most before a task that becomes ready
+ * 			  runs.
+ * 			- The erase job erases the next sector of the ring when the
+ * 			  current one has less than FLASHLOG_ERASE_AHEAD bytes left, but
+ * 			  only when xTaskGetTicksToNextWake() reports that no task of
+ * 			  the real-time priority (flashlog_set_realtime_priority()) or
+ * 			  above is due within FLASHLOG_ERASE_MS. Until such a gap
+ * 			  comes, records wait in RAM, and are dropped once it is full.
+ * 			  The tick interrupts the erase merged are caught up after it.
+ *
+ * 			A real-time task blocked without a timeout, woken by an
+ * 			interrupt, cannot be foreseen: keep such code out of the flash
+ * 			(KERNEL_RAM_FUNCTION), or raise the priority above it.
+ *
+ * 			The sectors of the ring are used and erased in turn, so they
+ * 			wear evenly. Each starts with a magic and a sequence number, one
+ * 			more than the previous sector's, which orders the ring at boot.
+ * 			Each record is a header word (magic and length), the data padded
+ * 			to words, then a CRC (crc.c) of both. The header is programmed
+ * 			first, so a reset in the middle of a record leaves a header with
+ * 			a bad CRC, which readers step over.
+ *
+ * 			The linker script leaves the sectors of the ring out of the
+ * 			code region.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "crc.h"
+#include "idlejob.h"
+#include "flashlog.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define FLASHLOG_SECTOR_BYTES	(128U * 1024U)
+#define FLASHLOG_BASE			(FLASH_BASE + (FLASHLOG_SECTOR_BYTES * (FLASHLOG_FIRST_SECTOR - 4U)))
+#define FLASHLOG_SECTOR_MAGIC	0x474F4C46U		/* "FLOG" */
+#define FLASHLOG_RECORD_MAGIC	0x4C52U			/* In the top half of the record header. */
+#define FLASHLOG_HEADER_BYTES	8U				/* Sector magic, then sequence. */
+#define FLASHLOG_ERASED			0xFFFFFFFFU
+#define FLASHLOG_NONE			0xFFFFFFFFU
+#define FLASHLOG_BUFFER_MASK	(FLASHLOG_BUFFER_WORDS - 1U)
+
+/* Header, data and CRC. */
+#define FLASHLOG_RECORD_WORDS(ulLen)	(2U + (((ulLen) + 3U) / 4U))
+
+#if (FLASHLOG_FIRST_SECTOR < 5U) || ((FLASHLOG_FIRST_SECTOR + FLASHLOG_SECTORS) > 8U)
+#error The sectors of the flash log must be among sectors 5 to 7, of 128 KB
+#endif
+
+#if (FLASHLOG_SECTORS < 2U)
+#error The flash log needs two sectors: one is erased while the other holds the log
+#endif
+
+#if ((FLASHLOG_BUFFER_WORDS & FLASHLOG_BUFFER_MASK) != 0U)
+#error FLASHLOG_BUFFER_WORDS must be a power of two
+#endif
+
+#if (FLASHLOG_BUFFER_WORDS < FLASHLOG_RECORD_WORDS(FLASHLOG_MAX_RECORD))
+#error FLASHLOG_BUFFER_WORDS must hold a record of FLASHLOG_MAX_RECORD bytes
+#endif
+
+#if (FLASHLOG_MAX_RECORD > 0xFFFFU)
+#error FLASHLOG_MAX_RECORD must fit the 16-bit length of the record header
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef enum
+{
+	FLASHLOG_BLANK,						/* Erased, ready to be opened. */
+	FLASHLOG_USED,						/* Magic and sequence programmed. */
+	FLASHLOG_DIRTY						/* Anything else: to be erased. */
+} FlashLogState_t;
+
+/* Variables -----------------------------------------------------------------*/
+static uint32_t ulFlashLogBuffer[FLASHLOG_BUFFER_WORDS];
+static volatile uint32_t ulFlashLogIn = 0;		/* Words written, free running. */
+static volatile uint32_t ulFlashLogOut = 0;		/* Words programmed, up to a whole record. */
+static uint32_t ulFlashLogRecordWords = 0;		/* Of the record being programmed, 0 if none. */
+static uint32_t ulFlashLogRecordDone = 0;		/* Of its words, programmed. */
+static uint32_t ulFlashLogHead = 0;				/* Sector being written. */
+static uint32_t ulFlashLogSequence = 0;			/* Its sequence, 0 if no sector was opened. */
+static uint32_t ulFlashLogOffset = 0;			/* End of its last whole record. */
+static FlashLogState_t xFlashLogState[FLASHLOG_SECTORS];
+static volatile UBaseType_t uxFlashLogRealtimePriority = FLASHLOG_REALTIME_PRIORITY;
+static IdleJob_t xFlashLogProgramJob;
+static IdleJob_t xFlashLogEraseJob;
+static FlashLogStats_t xFlashLogStats;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t flashlog_address(uint32_t ulSector, uint32_t ulOffset);
+static uint32_t flashlog_word(uint32_t ulSector, uint32_t ulOffset);
+static uint32_t flashlog_sequence(uint32_t ulSector);
+static uint32_t flashlog_find(uint32_t ulSequence);
+static int32_t flashlog_header_valid(uint32_t ulHeader);
+static uint32_t flashlog_scan_end(uint32_t ulSector);
+static BaseType_t flashlog_erase_due(void);
+static void flashlog_flush_data_cache(void);
+static BaseType_t flashlog_open_next(void);
+static BaseType_t flashlog_program_step(void *pvArg);
+static BaseType_t flashlog_erase_step(void *pvArg);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Finds where the log ends and registers the idle jobs.
+ * @param None
+ * @retval None
+ * @note Call once, before the scheduler starts. Sectors neither erased nor
+ * written by this module are erased as the ring comes round to them.
+ */
+void flashlog_init(void)
+{
+	uint32_t ulSector;
+	uint32_t ulSequence;
+	uint32_t ulOffset;
+
+	ulFlashLogSequence = 0U;
+
+	for (ulSector = 0; ulSector < FLASHLOG_SECTORS; ulSector++)
+	{
+		ulSequence = flashlog_sequence(ulSector);
+
+		if (ulSequence != 0U)
+		{
+			xFlashLogState[ulSector] = FLASHLOG_USED;
+
+			if ((ulFlashLogSequence == 0U) || ((int32_t)(ulSequence - ulFlashLogSequence) > 0))
+			{
+				ulFlashLogSequence = ulSequence;
+				ulFlashLogHead = ulSector;
+			}
+		}
+		else
+		{
+			xFlashLogState[ulSector] = FLASHLOG_BLANK;
+
+			for (ulOffset = 0; ulOffset < FLASHLOG_SECTOR_BYTES; ulOffset += 4U)
+			{
+				if (flashlog_word(ulSector, ulOffset) != FLASHLOG_ERASED)
+				{
+					xFlashLogState[ulSector] = FLASHLOG_DIRTY;
+					break;
+				}
+			}
+		}
+	}
+
+	if (ulFlashLogSequence != 0U)
+	{
+		/* Go on after the last record, torn or not. */
+		ulFlashLogOffset = flashlog_scan_end(ulFlashLogHead);
+	}
+	else
+	{
+		/* As if the last sector were full, so that the first record opens
+		 * the first sector. */
+		ulFlashLogHead = FLASHLOG_SECTORS - 1U;
+		ulFlashLogOffset = FLASHLOG_SECTOR_BYTES;
+	}
+
+	idlejob_register(&xFlashLogProgramJob, "FlashLog", flashlog_program_step, NULL,
+			FLASHLOG_BUDGET_CYCLES);
+	idlejob_register(&xFlashLogEraseJob, "FlashErase", flashlog_erase_step, NULL,
+			FLASHLOG_BUDGET_CYCLES);
+
+	if (flashlog_erase_due() != pdFALSE)
+	{
+		idlejob_kick(&xFlashLogEraseJob);
+	}
+}
+
+/**
+ * @brief Adds a record to the log.
+ * @param pvRecord Bytes of the record.
+ * @param ulLen Number of bytes, 1 to FLASHLOG_MAX_RECORD.
+ * @retval 0 if buffered, to be programmed when the CPU is idle, -1 if the
+ * length is out of range or the buffer is full.
+ * @note From tasks and from interrupts at or below
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY alike. Interrupts are masked while the
+ * record is copied.
+ */
+int32_t flashlog_write(const void *pvRecord, uint32_t ulLen)
+{
+	const uint8_t *pucRecord = (const uint8_t *)pvRecord;
+	const uint32_t ulPad = 0U;
+	CrcContext_t xCtx;
+	UBaseType_t uxSavedInterruptStatus;
+	uint32_t ulHeader;
+	uint32_t ulWords;
+	uint32_t ulCrc;
+	uint32_t ulIn;
+	uint32_t ulWord;
+	uint32_t ulBytes;
+	uint32_t i;
+
+	if ((ulLen == 0U) || (ulLen > FLASHLOG_MAX_RECORD))
+	{
+		return -1;
+	}
+
+	ulHeader = ((uint32_t)FLASHLOG_RECORD_MAGIC << 16) | ulLen;
+	ulWords = FLASHLOG_RECORD_WORDS(ulLen);
+
+	/* The padding is covered too, as it is programmed. */
+	crc_begin(&xCtx);
+	crc_update(&xCtx, &ulHeader, sizeof(ulHeader));
+	crc_update(&xCtx, pvRecord, ulLen);
+	crc_update(&xCtx, &ulPad, (4U - (ulLen & 3U)) & 3U);
+	ulCrc = crc_final(&xCtx);
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	ulIn = ulFlashLogIn;
+
+	if ((FLASHLOG_BUFFER_WORDS - (ulIn - ulFlashLogOut)) < ulWords)
+	{
+		xFlashLogStats.ulDropped++;
+		taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+		return -1;
+	}
+
+	ulFlashLogBuffer[ulIn++ & FLASHLOG_BUFFER_MASK] = ulHeader;
+
+	for (i = 0; i < ulLen; i += 4U)
+	{
+		ulWord = 0U;
+		ulBytes = ((ulLen - i) < 4U) ? (ulLen - i) : 4U;
+		memcpy(&ulWord, &pucRecord[i], ulBytes);
+		ulFlashLogBuffer[ulIn++ & FLASHLOG_BUFFER_MASK] = ulWord;
+	}
+
+	ulFlashLogBuffer[ulIn++ & FLASHLOG_BUFFER_MASK] = ulCrc;
+	ulFlashLogIn = ulIn;
+	xFlashLogStats.ulRecords++;
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	idlejob_kick(&xFlashLogProgramJob);
+
+	/* Retried with each record while no gap has come. */
+	if (flashlog_erase_due() != pdFALSE)
+	{
+		idlejob_kick(&xFlashLogEraseJob);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Sets the priority from which tasks are real-time: an erase only
+ * starts when none of them is due before it ends.
+ * @param uxPriority Lowest real-time priority. Above configMAX_PRIORITIES - 1,
+ * no task is real-time and an erase starts on the first idle slice.
+ * @retval None
+ * @note Can be changed at any time, for example raised while a control loop
+ * is stopped so that the pending erase runs then.
+ */
+void flashlog_set_realtime_priority(UBaseType_t uxPriority)
+{
+	uxFlashLogRealtimePriority = uxPriority;
+
+	if (flashlog_erase_due() != pdFALSE)
+	{
+		idlejob_kick(&xFlashLogEraseJob);
+	}
+}
+
+/**
+ * @brief Tells whether the ring waits for an erase.
+ * @param None
+ * @retval pdTRUE if the next sector must be erased before the current one
+ * fills up, pdFALSE otherwise.
+ */
+BaseType_t flashlog_erase_pending(void)
+{
+	return flashlog_erase_due();
+}
+
+/**
+ * @brief Points a reader at the oldest record kept.
+ * @param pxCursor Reader.
+ * @retval None
+ */
+void flashlog_rewind(FlashLogCursor_t *pxCursor)
+{
+	UBaseType_t uxSavedInterruptStatus;
+	uint32_t ulOldest;
+	uint32_t ulSequence;
+	uint32_t ulSector;
+
+	/* With nothing kept, the first sector to be opened. */
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	ulOldest = ulFlashLogSequence + 1U;
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	for (ulSector = 0; ulSector < FLASHLOG_SECTORS; ulSector++)
+	{
+		ulSequence = flashlog_sequence(ulSector);
+
+		if ((ulSequence != 0U) && ((int32_t)(ulSequence - ulOldest) < 0))
+		{
+			ulOldest = ulSequence;
+		}
+	}
+
+	pxCursor->ulSequence = ulOldest;
+	pxCursor->ulOffset = FLASHLOG_HEADER_BYTES;
+}
+
+/**
+ * @brief Reads the next record, oldest first.
+ * @param pxCursor Reader, from flashlog_rewind().
+ * @param pvRecord Where the record is copied.
+ * @param ulMax Size of pvRecord. A longer record is cut.
+ * @retval Length of the record, 0 if there is no record yet past the cursor.
+ * @note From a task, or before the scheduler starts. Records that were erased while the reader was behind
+ * are skipped, and so are torn or corrupt ones (ulBadRecords). The flash
+ * programmed since the last call is read on the next one.
+ */
+int32_t flashlog_read(FlashLogCursor_t *pxCursor, void *pvRecord, uint32_t ulMax)
+{
+	UBaseType_t uxSavedInterruptStatus;
+	uint32_t ulSector;
+	uint32_t ulSequence;
+	uint32_t ulLimit;
+	uint32_t ulHeader;
+	uint32_t ulLen;
+	uint32_t ulWords;
+	uint32_t ulCrc;
+	BaseType_t xHead;
+
+	for (;;)
+	{
+		ulSector = flashlog_find(pxCursor->ulSequence);
+
+		if (ulSector == FLASHLOG_NONE)
+		{
+			/* Erased under the reader: go on with the oldest sector left
+			 * after it, if any. */
+			ulSequence = pxCursor->ulSequence;
+			flashlog_rewind(pxCursor);
+
+			if ((int32_t)(pxCursor->ulSequence - ulSequence) <= 0)
+			{
+				pxCursor->ulSequence = ulSequence;
+
+				return 0;
+			}
+
+			continue;
+		}
+
+		/* Only the whole records of the sector being written. */
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		xHead = (pxCursor->ulSequence == ulFlashLogSequence) ? pdTRUE : pdFALSE;
+		ulLimit = (xHead != pdFALSE) ? ulFlashLogOffset : FLASHLOG_SECTOR_BYTES;
+		taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+		ulHeader = (pxCursor->ulOffset + 4U <= ulLimit) ? flashlog_word(ulSector, pxCursor->ulOffset)
+				: FLASHLOG_ERASED;
+		ulLen = ulHeader & 0xFFFFU;
+		ulWords = FLASHLOG_RECORD_WORDS(ulLen);
+
+		if ((flashlog_header_valid(ulHeader) == 0)
+				|| ((pxCursor->ulOffset + (4U * ulWords)) > ulLimit))
+		{
+			if (xHead != pdFALSE)
+			{
+				return 0;
+			}
+
+			/* The end of a full sector. */
+			pxCursor->ulSequence++;
+			pxCursor->ulOffset = FLASHLOG_HEADER_BYTES;
+			continue;
+		}
+
+		ulCrc = crc_compute((const void *)flashlog_address(ulSector, pxCursor->ulOffset),
+				4U * (ulWords - 1U));
+
+		if (ulCrc != flashlog_word(ulSector, pxCursor->ulOffset + (4U * (ulWords - 1U))))
+		{
+			pxCursor->ulOffset += 4U * ulWords;
+			uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+			xFlashLogStats.ulBadRecords++;
+			taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+			continue;
+		}
+
+		memcpy(pvRecord, (const void *)flashlog_address(ulSector, pxCursor->ulOffset + 4U),
+				(ulLen < ulMax) ? ulLen : ulMax);
+
+		/* The sector may have been erased while it was copied. */
+		if (flashlog_sequence(ulSector) != pxCursor->ulSequence)
+		{
+			continue;
+		}
+
+		pxCursor->ulOffset += 4U * ulWords;
+
+		return (int32_t)ulLen;
+	}
+}
+
+/**
+ * @brief Reads the statistics of the log.
+ * @param pxStats Where the statistics are written.
+ * @retval None
+ */
+void flashlog_get_stats(FlashLogStats_t *pxStats)
+{
+	UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	*pxStats = xFlashLogStats;
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Computes the address of a word of the ring.
+ * @param ulSector Sector of the ring, from 0.
+ * @param ulOffset Byte offset in the sector.
+ * @retval The address.
+ */
+static uint32_t flashlog_address(uint32_t ulSector, uint32_t ulOffset)
+{
+	return FLASHLOG_BASE + (ulSector * FLASHLOG_SECTOR_BYTES) + ulOffset;
+}
+
+/**
+ * @brief Reads a word of the ring.
+ * @param ulSector Sector of the ring, from 0.
+ * @param ulOffset Byte offset in the sector, a multiple of 4.
+ * @retval The word.
+ */
+static uint32_t flashlog_word(uint32_t ulSector, uint32_t ulOffset)
+{
+	return *(const volatile uint32_t *)flashlog_address(ulSector, ulOffset);
+}
+
+/**
+ * @brief Reads the sequence number of a sector.
+ * @param ulSector Sector of the ring, from 0.
+ * @retval The sequence, 0 if the sector was not opened.
+ */
+static uint32_t flashlog_sequence(uint32_t ulSector)
+{
+	uint32_t ulSequence = flashlog_word(ulSector, 4U);
+
+	if ((flashlog_word(ulSector, 0U) != FLASHLOG_SECTOR_MAGIC) || (ulSequence == FLASHLOG_ERASED))
+	{
+		return 0U;
+	}
+
+	return ulSequence;
+}
+
+/**
+ * @brief Finds the sector of a sequence number.
+ * @param ulSequence Sequence, not 0.
+ * @retval Sector of the ring, FLASHLOG_NONE if no sector has it.
+ */
+static uint32_t flashlog_find(uint32_t ulSequence)
+{
+	uint32_t ulSector;
+
+	for (ulSector = 0; ulSector < FLASHLOG_SECTORS; ulSector++)
+	{
+		if (flashlog_sequence(ulSector) == ulSequence)
+		{
+			return ulSector;
+		}
+	}
+
+	return FLASHLOG_NONE;
+}
+
+/**
+ * @brief Checks a record header.
+ * @param ulHeader Header word.
+ * @retval 1 if it has the magic and a length in range, 0 otherwise.
+ */
+static int32_t flashlog_header_valid(uint32_t ulHeader)
+{
+	uint32_t ulLen = ulHeader & 0xFFFFU;
+
+	return (((ulHeader >> 16) == FLASHLOG_RECORD_MAGIC) && (ulLen != 0U)
+			&& (ulLen <= FLASHLOG_MAX_RECORD)) ? 1 : 0;
+}
+
+/**
+ * @brief Finds the end of the records of a sector.
+ * @param ulSector Sector of the ring, opened.
+ * @retval Offset of the first erased word after the records, or the sector
+ * size if a header is corrupt: nothing more is written there.
+ */
+static uint32_t flashlog_scan_end(uint32_t ulSector)
+{
+	uint32_t ulOffset = FLASHLOG_HEADER_BYTES;
+	uint32_t ulHeader;
+
+	while (ulOffset < FLASHLOG_SECTOR_BYTES)
+	{
+		ulHeader = flashlog_word(ulSector, ulOffset);
+
+		if (ulHeader == FLASHLOG_ERASED)
+		{
+			return ulOffset;
+		}
+
+		if ((flashlog_header_valid(ulHeader) == 0)
+				|| ((ulOffset + (4U * FLASHLOG_RECORD_WORDS(ulHeader & 0xFFFFU))) > FLASHLOG_SECTOR_BYTES))
+		{
+			break;
+		}
+
+		ulOffset += 4U * FLASHLOG_RECORD_WORDS(ulHeader & 0xFFFFU);
+	}
+
+	return FLASHLOG_SECTOR_BYTES;
+}
+
+/**
+ * @brief Tells whether the next sector needs an erase by now.
+ * @param None
+ * @retval pdTRUE if it is not erased and the current sector has less than
+ * FLASHLOG_ERASE_AHEAD bytes left, pdFALSE otherwise.
+ */
+static BaseType_t flashlog_erase_due(void)
+{
+	uint32_t ulNext = (ulFlashLogHead + 1U) % FLASHLOG_SECTORS;
+
+	return ((xFlashLogState[ulNext] != FLASHLOG_BLANK)
+			&& ((FLASHLOG_SECTOR_BYTES - ulFlashLogOffset) < FLASHLOG_ERASE_AHEAD)) ? pdTRUE : pdFALSE;
+}
+
+/**
+ * @brief Drops the lines of the flash data cache.
+ * @param None
+ * @retval None
+ * @note Programming does not update the cache: a line read before, erased
+ * words included, would be returned as it was. HAL_FLASHEx_Erase() flushes
+ * the caches itself.
+ */
+static void flashlog_flush_data_cache(void)
+{
+	if (READ_BIT(FLASH->ACR, FLASH_ACR_DCEN) != 0U)
+	{
+		__HAL_FLASH_DATA_CACHE_DISABLE();
+		__HAL_FLASH_DATA_CACHE_RESET();
+		__HAL_FLASH_DATA_CACHE_ENABLE();
+	}
+}
+
+/**
+ * @brief Moves the writer to the next sector, programming its header.
+ * @param None
+ * @retval pdTRUE if it was opened, pdFALSE if it waits for an erase.
+ * @note The sequence is programmed before the magic: a sector torn between
+ * the two is neither erased nor opened, and is erased again.
+ */
+static BaseType_t flashlog_open_next(void)
+{
+	uint32_t ulNext = (ulFlashLogHead + 1U) % FLASHLOG_SECTORS;
+	HAL_StatusTypeDef xStatus;
+
+	if (xFlashLogState[ulNext] != FLASHLOG_BLANK)
+	{
+		idlejob_kick(&xFlashLogEraseJob);
+
+		return pdFALSE;
+	}
+
+	HAL_FLASH_Unlock();
+	xStatus = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, flashlog_address(ulNext, 4U),
+			ulFlashLogSequence + 1U);
+
+	if (xStatus == HAL_OK)
+	{
+		xStatus = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, flashlog_address(ulNext, 0U),
+				FLASHLOG_SECTOR_MAGIC);
+	}
+
+	HAL_FLASH_Lock();
+	flashlog_flush_data_cache();
+
+	if (xStatus != HAL_OK)
+	{
+		xFlashLogState[ulNext] = FLASHLOG_DIRTY;
+		taskENTER_CRITICAL();
+		xFlashLogStats.ulErrors++;
+		taskEXIT_CRITICAL();
+		idlejob_kick(&xFlashLogEraseJob);
+
+		return pdFALSE;
+	}
+
+	xFlashLogState[ulNext] = FLASHLOG_USED;
+
+	/* Readers look at the three together. */
+	taskENTER_CRITICAL();
+	ulFlashLogHead = ulNext;
+	ulFlashLogSequence++;
+	ulFlashLogOffset = FLASHLOG_HEADER_BYTES;
+	taskEXIT_CRITICAL();
+
+	return pdTRUE;
+}
+
+/**
+ * @brief Programs the next FLASHLOG_BATCH_WORDS words of the buffer.
+ * @param pvArg Unused.
+ * @retval pdTRUE while there is more to program, pdFALSE once the buffer is
+ * empty or the ring waits for an erase.
+ */
+static BaseType_t flashlog_program_step(void *pvArg)
+{
+	HAL_StatusTypeDef xStatus = HAL_OK;
+	uint32_t ulOut = ulFlashLogOut;
+	uint32_t ulAddress;
+	uint32_t ulWords;
+	uint32_t i;
+
+	(void)pvArg;
+
+	if (ulFlashLogRecordWords == 0U)
+	{
+		if (ulOut == ulFlashLogIn)
+		{
+			return pdFALSE;
+		}
+
+		ulWords = FLASHLOG_RECORD_WORDS(ulFlashLogBuffer[ulOut & FLASHLOG_BUFFER_MASK] & 0xFFFFU);
+
+		if ((ulFlashLogOffset + (4U * ulWords)) > FLASHLOG_SECTOR_BYTES)
+		{
+			return flashlog_open_next();
+		}
+
+		ulFlashLogRecordWords = ulWords;
+		ulFlashLogRecordDone = 0U;
+	}
+
+	ulWords = ulFlashLogRecordWords - ulFlashLogRecordDone;
+
+	if (ulWords > FLASHLOG_BATCH_WORDS)
+	{
+		ulWords = FLASHLOG_BATCH_WORDS;
+	}
+
+	ulAddress = flashlog_address(ulFlashLogHead, ulFlashLogOffset + (4U * ulFlashLogRecordDone));
+
+	HAL_FLASH_Unlock();
+
+	for (i = 0; (i < ulWords) && (xStatus == HAL_OK); i++)
+	{
+		xStatus = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, ulAddress + (4U * i),
+				ulFlashLogBuffer[(ulOut + ulFlashLogRecordDone + i) & FLASHLOG_BUFFER_MASK]);
+	}
+
+	HAL_FLASH_Lock();
+	flashlog_flush_data_cache();
+
+	taskENTER_CRITICAL();
+
+	if (xStatus != HAL_OK)
+	{
+		/* Close the sector, the torn record ends it, and program the record
+		 * again in the next one. */
+		ulFlashLogOffset = FLASHLOG_SECTOR_BYTES;
+		ulFlashLogRecordWords = 0U;
+		xFlashLogStats.ulErrors++;
+		taskEXIT_CRITICAL();
+
+		return pdTRUE;
+	}
+
+	xFlashLogStats.ulProgrammedWords += ulWords;
+	ulFlashLogRecordDone += ulWords;
+
+	if (ulFlashLogRecordDone == ulFlashLogRecordWords)
+	{
+		/* Hand the words back to flashlog_write(), and the record to the
+		 * readers. */
+		ulFlashLogOffset += 4U * ulFlashLogRecordWords;
+		ulFlashLogOut = ulOut + ulFlashLogRecordWords;
+		ulFlashLogRecordWords = 0U;
+	}
+
+	taskEXIT_CRITICAL();
+
+	if (flashlog_erase_due() != pdFALSE)
+	{
+		idlejob_kick(&xFlashLogEraseJob);
+	}
+
+	return pdTRUE;
+}
+
+/**
+ * @brief Erases the next sector of the ring, if no real-time task is due
+ * before the erase would end.
+ * @param pvArg Unused.
+ * @retval pdFALSE: one step, kicked again by the next record if deferred.
+ * @note The whole step is a single stall of up to FLASHLOG_ERASE_MS.
+ */
+static BaseType_t flashlog_erase_step(void *pvArg)
+{
+	FLASH_EraseInitTypeDef xErase;
+	HAL_StatusTypeDef xStatus;
+	uint32_t ulNext = (ulFlashLogHead + 1U) % FLASHLOG_SECTORS;
+	uint32_t ulSectorError;
+	uint32_t ulStart;
+	uint32_t ulCycles;
+	uint32_t ulMs;
+	TickType_t xTicks;
+
+	(void)pvArg;
+
+	if (flashlog_erase_due() == pdFALSE)
+	{
+		return pdFALSE;
+	}
+
+	if (xTaskGetTicksToNextWake(uxFlashLogRealtimePriority) <= pdMS_TO_TICKS(FLASHLOG_ERASE_MS))
+	{
+		taskENTER_CRITICAL();
+		xFlashLogStats.ulErasesDeferred++;
+		taskEXIT_CRITICAL();
+
+		return pdFALSE;
+	}
+
+	xErase.TypeErase = FLASH_TYPEERASE_SECTORS;
+	xErase.Sector = FLASHLOG_FIRST_SECTOR + ulNext;
+	xErase.NbSectors = 1U;
+	xErase.VoltageRange = FLASH_VOLTAGE_RANGE_3;	/* x32 parallelism, at 3.3 V. */
+
+	ulStart = DWT->CYCCNT;
+	HAL_FLASH_Unlock();
+	xStatus = HAL_FLASHEx_Erase(&xErase, &ulSectorError);
+	HAL_FLASH_Lock();
+	ulCycles = DWT->CYCCNT - ulStart;
+
+	/* The tick interrupts of the stall were merged, and one of them is
+	 * taken once it ends. */
+	xTicks = (TickType_t)(ulCycles / (SystemCoreClock / configTICK_RATE_HZ));
+
+	if (xTicks > 1U)
+	{
+		(void)xTaskCatchUpTicks(xTicks - 1U);
+	}
+
+	ulMs = ulCycles / (SystemCoreClock / 1000U);
+
+	taskENTER_CRITICAL();
+
+	if (xStatus == HAL_OK)
+	{
+		xFlashLogState[ulNext] = FLASHLOG_BLANK;
+		xFlashLogStats.ulErases++;
+	}
+	else
+	{
+		xFlashLogStats.ulErrors++;
+	}
+
+	if (ulMs > xFlashLogStats.ulMaxEraseMs)
+	{
+		xFlashLogStats.ulMaxEraseMs = ulMs;
+	}
+
+	taskEXIT_CRITICAL();
+
+	/* Records may wait for the sector. */
+	idlejob_kick(&xFlashLogProgramJob);
+
+	return pdFALSE;
+}
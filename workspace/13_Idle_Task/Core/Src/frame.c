@@ -0,0 +1,393 @@
+/*******************************************************************************
+ *
+ * @file	frame.c
+ * @brief	Implementation of the COBS and SLIP framing with a CRC-32 trailer.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	A frame is the payload followed by its CRC (crc_compute(), LSB
+ * 			first), encoded as one of:
+ * 			- COBS: the body holds no 0x00, at most 1 byte in 254 of overhead,
+ * 			  and a 0x00 ends it.
+ * 			- SLIP: 0xC0 and 0xDB are escaped, up to 2 bytes each, and a 0xC0
+ * 			  starts and ends it.
+ *
+ * 			The receiver only collects or unescapes bytes as they arrive.
+ * 			The CRC is checked once per frame by the CRC unit, a word at a
+ * 			time, instead of a table lookup per byte on the RX path.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "crc.h"
+#include "frame.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define COBS_MAX_CODE 0xFFU				/* 254 data bytes, no implied zero. */
+
+/* Private function prototypes -----------------------------------------------*/
+static int32_t frame_cobs_encode(const uint8_t *pucPayload, uint32_t ulLen,
+		const uint8_t *pucCrc, uint8_t *pucOut, uint32_t ulSize);
+static int32_t frame_slip_encode(const uint8_t *pucPayload, uint32_t ulLen,
+		const uint8_t *pucCrc, uint8_t *pucOut, uint32_t ulSize);
+static int32_t frame_cobs_decode(uint8_t *pucBuf, uint32_t ulLen);
+static int32_t frame_rx_end(FrameRx_t *pxRx, int32_t lLen);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Encodes a payload and its CRC into a complete frame.
+ * @param xMode FRAME_COBS or FRAME_SLIP.
+ * @param pucPayload Payload bytes.
+ * @param ulLen Payload length.
+ * @param pucOut Frame output, delimiters included.
+ * @param ulSize Size of pucOut; FRAME_COBS_MAX_ENCODED() or
+ * FRAME_SLIP_MAX_ENCODED() of ulLen is always enough.
+ * @retval Frame length, or -1 if it does not fit.
+ */
+int32_t frame_encode(FrameMode_t xMode, const uint8_t *pucPayload, uint32_t ulLen,
+		uint8_t *pucOut, uint32_t ulSize)
+{
+	uint32_t ulCrc;
+	uint8_t ucCrc[FRAME_CRC_LEN];
+
+	if ((pucOut == NULL) || ((pucPayload == NULL) && (ulLen > 0U)))
+	{
+		return -1;
+	}
+
+	ulCrc = crc_compute(pucPayload, ulLen);
+	ucCrc[0] = (uint8_t)ulCrc;
+	ucCrc[1] = (uint8_t)(ulCrc >> 8);
+	ucCrc[2] = (uint8_t)(ulCrc >> 16);
+	ucCrc[3] = (uint8_t)(ulCrc >> 24);
+
+	if (xMode == FRAME_COBS)
+	{
+		return frame_cobs_encode(pucPayload, ulLen, ucCrc, pucOut, ulSize);
+	}
+
+	return frame_slip_encode(pucPayload, ulLen, ucCrc, pucOut, ulSize);
+}
+
+/**
+ * @brief Initializes a frame receiver.
+ * @param pxRx Receiver.
+ * @param xMode FRAME_COBS or FRAME_SLIP.
+ * @param pucBuf Buffer for one frame, CRC included (COBS: encoded frame).
+ * @param usSize Size of pucBuf.
+ * @retval 0 if successful, -1 otherwise.
+ */
+int32_t frame_rx_init(FrameRx_t *pxRx, FrameMode_t xMode, uint8_t *pucBuf, uint16_t usSize)
+{
+	if ((pxRx == NULL) || (pucBuf == NULL) || (usSize <= FRAME_CRC_LEN)
+			|| ((xMode != FRAME_COBS) && (xMode != FRAME_SLIP)))
+	{
+		return -1;
+	}
+
+	pxRx->pucBuf = pucBuf;
+	pxRx->usSize = usSize;
+	pxRx->usLen = 0;
+	pxRx->ucMode = (uint8_t)xMode;
+	pxRx->ucEscape = 0;
+	pxRx->ucDiscard = 0;
+	pxRx->xStats.ulFrames = 0;
+	pxRx->xStats.ulCrcErrors = 0;
+	pxRx->xStats.ulFramingErrors = 0;
+	pxRx->xStats.ulOverflows = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Adds a received byte to a frame receiver.
+ * @param pxRx Receiver.
+ * @param ucByte Received byte.
+ * @retval Payload length, the payload being at pxRx->pucBuf, if the byte ended
+ * a frame with a valid CRC; FRAME_RX_ERROR if it ended a frame that was
+ * dropped (see pxRx->xStats); FRAME_RX_MORE otherwise.
+ * @note The payload stays valid until the next call.
+ */
+int32_t frame_rx_put(FrameRx_t *pxRx, uint8_t ucByte)
+{
+	if (pxRx->ucMode == FRAME_COBS)
+	{
+		if (ucByte == FRAME_COBS_DELIMITER)
+		{
+			return frame_rx_end(pxRx, frame_cobs_decode(pxRx->pucBuf, pxRx->usLen));
+		}
+	}
+	else
+	{
+		if (ucByte == FRAME_SLIP_END)
+		{
+			if (pxRx->ucEscape != 0U)
+			{
+				pxRx->ucDiscard = 1;
+				pxRx->xStats.ulFramingErrors++;
+			}
+
+			return frame_rx_end(pxRx, pxRx->usLen);
+		}
+
+		if (pxRx->ucDiscard != 0U)
+		{
+			return FRAME_RX_MORE;
+		}
+
+		if (pxRx->ucEscape != 0U)
+		{
+			pxRx->ucEscape = 0;
+
+			if (ucByte == FRAME_SLIP_ESC_END)
+			{
+				ucByte = FRAME_SLIP_END;
+			}
+			else if (ucByte == FRAME_SLIP_ESC_ESC)
+			{
+				ucByte = FRAME_SLIP_ESC;
+			}
+			else
+			{
+				pxRx->ucDiscard = 1;
+				pxRx->xStats.ulFramingErrors++;
+				return FRAME_RX_MORE;
+			}
+		}
+		else if (ucByte == FRAME_SLIP_ESC)
+		{
+			pxRx->ucEscape = 1;
+			return FRAME_RX_MORE;
+		}
+	}
+
+	if (pxRx->ucDiscard != 0U)
+	{
+		return FRAME_RX_MORE;
+	}
+
+	if (pxRx->usLen >= pxRx->usSize)
+	{
+		pxRx->ucDiscard = 1;
+		pxRx->xStats.ulOverflows++;
+		return FRAME_RX_MORE;
+	}
+
+	pxRx->pucBuf[pxRx->usLen++] = ucByte;
+
+	return FRAME_RX_MORE;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Encodes a payload and its CRC with COBS.
+ * @param pucPayload Payload bytes.
+ * @param ulLen Payload length.
+ * @param pucCrc CRC bytes, FRAME_CRC_LEN of them.
+ * @param pucOut Frame output.
+ * @param ulSize Size of pucOut.
+ * @retval Frame length, or -1 if it does not fit.
+ */
+static int32_t frame_cobs_encode(const uint8_t *pucPayload, uint32_t ulLen,
+		const uint8_t *pucCrc, uint8_t *pucOut, uint32_t ulSize)
+{
+	uint32_t ulCodePos = 0;
+	uint32_t ulOut = 1;
+	uint8_t ucCode = 1;
+	uint8_t ucByte;
+	uint32_t x;
+
+	if (ulSize < 2U)
+	{
+		return -1;
+	}
+
+	for (x = 0; x < (ulLen + FRAME_CRC_LEN); x++)
+	{
+		ucByte = (x < ulLen) ? pucPayload[x] : pucCrc[x - ulLen];
+
+		if (ulOut >= ulSize)
+		{
+			return -1;
+		}
+
+		if (ucByte == 0U)
+		{
+			/* The code byte stands for the data bytes and this zero. */
+			pucOut[ulCodePos] = ucCode;
+			ulCodePos = ulOut++;
+			ucCode = 1;
+		}
+		else
+		{
+			pucOut[ulOut++] = ucByte;
+			ucCode++;
+
+			if (ucCode == COBS_MAX_CODE)
+			{
+				pucOut[ulCodePos] = ucCode;
+
+				if (ulOut >= ulSize)
+				{
+					return -1;
+				}
+
+				ulCodePos = ulOut++;
+				ucCode = 1;
+			}
+		}
+	}
+
+	if (ulOut >= ulSize)
+	{
+		return -1;
+	}
+
+	pucOut[ulCodePos] = ucCode;
+	pucOut[ulOut++] = FRAME_COBS_DELIMITER;
+
+	return (int32_t)ulOut;
+}
+
+/**
+ * @brief Encodes a payload and its CRC with SLIP.
+ * @param pucPayload Payload bytes.
+ * @param ulLen Payload length.
+ * @param pucCrc CRC bytes, FRAME_CRC_LEN of them.
+ * @param pucOut Frame output.
+ * @param ulSize Size of pucOut.
+ * @retval Frame length, or -1 if it does not fit.
+ * @note The leading END flushes any line noise at the receiver.
+ */
+static int32_t frame_slip_encode(const uint8_t *pucPayload, uint32_t ulLen,
+		const uint8_t *pucCrc, uint8_t *pucOut, uint32_t ulSize)
+{
+	uint32_t ulOut = 0;
+	uint8_t ucByte;
+	uint32_t x;
+
+	if (ulSize < 2U)
+	{
+		return -1;
+	}
+
+	pucOut[ulOut++] = FRAME_SLIP_END;
+
+	for (x = 0; x < (ulLen + FRAME_CRC_LEN); x++)
+	{
+		ucByte = (x < ulLen) ? pucPayload[x] : pucCrc[x - ulLen];
+
+		if ((ucByte == FRAME_SLIP_END) || (ucByte == FRAME_SLIP_ESC))
+		{
+			if ((ulOut + 2U) >= ulSize)
+			{
+				return -1;
+			}
+
+			pucOut[ulOut++] = FRAME_SLIP_ESC;
+			pucOut[ulOut++] = (ucByte == FRAME_SLIP_END) ? FRAME_SLIP_ESC_END : FRAME_SLIP_ESC_ESC;
+		}
+		else
+		{
+			if ((ulOut + 1U) >= ulSize)
+			{
+				return -1;
+			}
+
+			pucOut[ulOut++] = ucByte;
+		}
+	}
+
+	pucOut[ulOut++] = FRAME_SLIP_END;
+
+	return (int32_t)ulOut;
+}
+
+/**
+ * @brief Decodes a COBS frame body in place.
+ * @param pucBuf Encoded bytes, without the delimiter; decoded bytes on return.
+ * @param ulLen Number of encoded bytes.
+ * @retval Decoded length, or -1 if the encoding is invalid.
+ * @note The output never overtakes the input, so no second buffer is needed.
+ */
+static int32_t frame_cobs_decode(uint8_t *pucBuf, uint32_t ulLen)
+{
+	uint32_t ulIn = 0;
+	uint32_t ulOut = 0;
+	uint8_t ucCode;
+	uint8_t x;
+
+	while (ulIn < ulLen)
+	{
+		ucCode = pucBuf[ulIn++];
+
+		if ((ucCode == 0U) || ((ulIn + ucCode - 1U) > ulLen))
+		{
+			return -1;
+		}
+
+		for (x = 1; x < ucCode; x++)
+		{
+			pucBuf[ulOut++] = pucBuf[ulIn++];
+		}
+
+		if ((ucCode < COBS_MAX_CODE) && (ulIn < ulLen))
+		{
+			pucBuf[ulOut++] = 0;
+		}
+	}
+
+	return (int32_t)ulOut;
+}
+
+/**
+ * @brief Ends the frame being received and checks its CRC.
+ * @param pxRx Receiver.
+ * @param lLen Decoded frame length, CRC included, or -1 if it is invalid.
+ * @retval As frame_rx_put().
+ */
+static int32_t frame_rx_end(FrameRx_t *pxRx, int32_t lLen)
+{
+	uint8_t ucDiscard = pxRx->ucDiscard;
+	uint16_t usReceived = pxRx->usLen;
+	const uint8_t *pucCrc;
+	uint32_t ulCrc;
+
+	pxRx->usLen = 0;
+	pxRx->ucEscape = 0;
+	pxRx->ucDiscard = 0;
+
+	if (ucDiscard != 0U)
+	{
+		return FRAME_RX_ERROR;
+	}
+
+	/* Back-to-back delimiters carry no frame. */
+	if (usReceived == 0U)
+	{
+		return FRAME_RX_MORE;
+	}
+
+	if (lLen < (int32_t)FRAME_CRC_LEN)
+	{
+		pxRx->xStats.ulFramingErrors++;
+		return FRAME_RX_ERROR;
+	}
+
+	lLen -= (int32_t)FRAME_CRC_LEN;
+	pucCrc = &pxRx->pucBuf[lLen];
+	ulCrc = (uint32_t)pucCrc[0] | ((uint32_t)pucCrc[1] << 8)
+			| ((uint32_t)pucCrc[2] << 16) | ((uint32_t)pucCrc[3] << 24);
+
+	if (crc_compute(pxRx->pucBuf, (uint32_t)lLen) != ulCrc)
+	{
+		pxRx->xStats.ulCrcErrors++;
+		return FRAME_RX_ERROR;
+	}
+
+	pxRx->xStats.ulFrames++;
+
+	return lLen;
+}
@@ -0,0 +1,251 @@
+/*******************************************************************************
+ *
+ * @file	idlejob.c
+ * @brief	Background jobs run in budgeted slices from the idle hook.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Housekeeping such as log commits, statistics aggregation or
+ * 			checksum scrubbing runs from vApplicationIdleHook(), calling
+ * 			idlejob_run(), so it only ever gets the time no task wants:
+ *
+ * 			- A task of higher priority that becomes ready preempts the idle
+ * 			  task at once, in the middle of a step if need be.
+ * 			- Each call runs one slice of one pending job, round robin, and
+ * 			  returns once the job's cycle budget is spent. The idle task then
+ * 			  yields to the tasks of idle priority (configIDLE_SHOULD_YIELD)
+ * 			  and checks whether it can sleep.
+ *
+ * 			A job runs after idlejob_kick() until its step function returns
+ * 			pdFALSE. The budget is measured on the DWT cycle counter (see
+ * 			runstats.c), as elapsed cycles: time taken by preempting tasks and
+ * 			interrupts counts against it, so the slice ends early rather than
+ * 			late.
+ *
+ * 			Tickless idle: while a job is pending, idlejob_pre_sleep()
+ * 			(configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING()) keeps the idle
+ * 			task from sleeping, and vPortSuppressTicksAndSleep() checks
+ * 			idlejob_pending() again with interrupts disabled, for a kick from
+ * 			an interrupt just before the sleep. With no job pending the idle
+ * 			hook returns at once and the sleep is as long as before.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "idlejob.h"
+
+/* Variables -----------------------------------------------------------------*/
+static IdleJob_t *pxJobs = NULL;
+static IdleJob_t *pxLastRun = NULL;	/* Round robin starts after this job. */
+
+/* Private function prototypes -----------------------------------------------*/
+static IdleJob_t *idlejob_next_pending(void);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Adds a job, not pending until the first idlejob_kick().
+ * @param pxJob Storage of the job. Must stay valid for good.
+ * @param pcName Name of the job, for debugging.
+ * @param pxFunction Step function, called with pvArg.
+ * @param pvArg Argument of the step function.
+ * @param ulBudgetCycles Core clock cycles one slice may take. At least one
+ * step runs per slice, however long.
+ * @retval None
+ */
+void idlejob_register(IdleJob_t *pxJob, const char *pcName, IdleJobFunction_t pxFunction,
+		void *pvArg, uint32_t ulBudgetCycles)
+{
+	configASSERT(pxFunction != NULL);
+
+	pxJob->pcName = pcName;
+	pxJob->pxFunction = pxFunction;
+	pxJob->pvArg = pvArg;
+	pxJob->ulBudgetCycles = ulBudgetCycles;
+	pxJob->ulPending = 0U;
+	pxJob->xStats.ulSlices = 0U;
+	pxJob->xStats.ulSteps = 0U;
+	pxJob->xStats.ulOverBudget = 0U;
+	pxJob->xStats.ulMaxStepCycles = 0U;
+
+	/* The idle task may be walking the list; a pointer store is atomic. */
+	taskENTER_CRITICAL();
+	pxJob->pxNext = pxJobs;
+	pxJobs = pxJob;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Marks a job as having work, to run the next time the CPU is idle.
+ * @param pxJob Job.
+ * @retval None
+ * @note From tasks and from interrupts at or below
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY alike: it only sets a flag. An
+ * interrupt that kicks a job while the idle task sleeps has already woken it.
+ */
+void idlejob_kick(IdleJob_t *pxJob)
+{
+	pxJob->ulPending = 1U;
+}
+
+/**
+ * @brief Runs one slice of the next pending job. Call from
+ * vApplicationIdleHook().
+ * @param None
+ * @retval None
+ */
+void idlejob_run(void)
+{
+	IdleJob_t *pxJob;
+	BaseType_t xMore;
+	uint32_t ulStart;
+	uint32_t ulStepStart;
+	uint32_t ulStepCycles;
+	uint32_t ulMaxStepCycles = 0U;
+	uint32_t ulSteps = 0U;
+
+	pxJob = idlejob_next_pending();
+
+	if (pxJob == NULL)
+	{
+		return;
+	}
+
+	pxLastRun = pxJob;
+
+	/* Cleared first: a kick during the slice leaves it pending again. */
+	pxJob->ulPending = 0U;
+	ulStart = DWT->CYCCNT;
+
+	do
+	{
+		ulStepStart = DWT->CYCCNT;
+		xMore = pxJob->pxFunction(pxJob->pvArg);
+		ulStepCycles = DWT->CYCCNT - ulStepStart;
+		ulSteps++;
+
+		if (ulStepCycles > ulMaxStepCycles)
+		{
+			ulMaxStepCycles = ulStepCycles;
+		}
+	} while ((xMore != pdFALSE) && ((DWT->CYCCNT - ulStart) < pxJob->ulBudgetCycles));
+
+	if (xMore != pdFALSE)
+	{
+		pxJob->ulPending = 1U;
+	}
+
+	/* idlejob_get_stats() may read them from another task. */
+	taskENTER_CRITICAL();
+	pxJob->xStats.ulSlices++;
+	pxJob->xStats.ulSteps += ulSteps;
+
+	if (xMore != pdFALSE)
+	{
+		pxJob->xStats.ulOverBudget++;
+	}
+
+	if (ulMaxStepCycles > pxJob->xStats.ulMaxStepCycles)
+	{
+		pxJob->xStats.ulMaxStepCycles = ulMaxStepCycles;
+	}
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Changes the cycle budget of a job's slices.
+ * @param pxJob Registered job.
+ * @param ulBudgetCycles Core clock cycles one slice may take.
+ * @retval None
+ * @note For a budget meant as a time, call it again after a clock profile
+ * switch. Takes effect from the next slice.
+ */
+void idlejob_set_budget(IdleJob_t *pxJob, uint32_t ulBudgetCycles)
+{
+	/* A word store, read by the idle task after each step. */
+	pxJob->ulBudgetCycles = ulBudgetCycles;
+}
+
+/**
+ * @brief Tells whether any job has work left.
+ * @param None
+ * @retval pdTRUE if a job is pending, pdFALSE otherwise.
+ */
+BaseType_t idlejob_pending(void)
+{
+	const IdleJob_t *pxJob;
+
+	for (pxJob = pxJobs; pxJob != NULL; pxJob = pxJob->pxNext)
+	{
+		if (pxJob->ulPending != 0U)
+		{
+			return pdTRUE;
+		}
+	}
+
+	return pdFALSE;
+}
+
+/**
+ * @brief Skips the tickless sleep while a job is pending
+ * (configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING()).
+ * @param pxExpectedIdleTime Idle time the kernel is about to sleep for, set
+ * to 0 to stay awake.
+ * @retval None
+ */
+void idlejob_pre_sleep(TickType_t *pxExpectedIdleTime)
+{
+	if (idlejob_pending() != pdFALSE)
+	{
+		*pxExpectedIdleTime = 0U;
+	}
+}
+
+/**
+ * @brief Reads the statistics of a job.
+ * @param pxJob Job.
+ * @param pxStats Where the statistics are written.
+ * @retval None
+ */
+void idlejob_get_stats(const IdleJob_t *pxJob, IdleJobStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = pxJob->xStats;
+	taskEXIT_CRITICAL();
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Finds the first pending job after the one run last, wrapping around.
+ * @param None
+ * @retval The job, or NULL if none is pending.
+ */
+static IdleJob_t *idlejob_next_pending(void)
+{
+	IdleJob_t *pxJob;
+	IdleJob_t *pxStart;
+
+	if (pxJobs == NULL)
+	{
+		return NULL;
+	}
+
+	pxStart = ((pxLastRun != NULL) && (pxLastRun->pxNext != NULL)) ? pxLastRun->pxNext : pxJobs;
+	pxJob = pxStart;
+
+	do
+	{
+		if (pxJob->ulPending != 0U)
+		{
+			return pxJob;
+		}
+
+		pxJob = (pxJob->pxNext != NULL) ? pxJob->pxNext : pxJobs;
+	} while (pxJob != pxStart);
+
+	return NULL;
+}
@@ -0,0 +1,235 @@
+/*******************************************************************************
+ *
+ * @file	itm.c
+ * @brief	ITM/SWO output driver: printf() and diagnostics on stimulus ports.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	The ST-LINK of the NUCLEO reads SWO (PB3, in its reset alternate
+ * 			function), so diagnostics leave the chip without touching
+ * 			USART2, at up to 2 Mbit/s against 115200 baud.
+ *
+ * 			A write goes out as one packet: a header byte and 1, 2 or 4
+ * 			data bytes. Text is written a word at a time, 5 bytes on the
+ * 			wire for 4 characters instead of 8.
+ *
+ * 			The stimulus FIFO holds about one packet. ITM_BLOCKING 1 polls
+ * 			it for up to ITM_BLOCK_SPINS before each packet, so a write
+ * 			takes as long as it takes on the wire. ITM_BLOCKING 0 drops the
+ * 			rest of a write as soon as the FIFO is full: the caller never
+ * 			waits, but only sparse output gets through. Dropped bytes are
+ * 			counted per port either way.
+ *
+ * 			A write to a port that is not enabled (no debugger capture, or
+ * 			no ITM_SWO_Init()) is discarded at the cost of two reads.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "itm.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define ITM_LOCK_KEY		0xC5ACCE55UL	/* Unlocks the ITM registers. */
+#define ITM_TRACE_BUS_ID	1UL
+#define TPI_PROTOCOL_NRZ	2UL				/* Asynchronous SWO (UART framing). */
+
+#if (ITM_PORT_COUNT > 32U)
+#error ITM_PORT_COUNT must not exceed 32
+#endif
+
+/* Variables -----------------------------------------------------------------*/
+static volatile uint32_t ulItmDropped[ITM_PORT_COUNT];
+
+/* Private function prototypes -----------------------------------------------*/
+static int32_t ITM_port_enabled(uint32_t ulPort);
+static int32_t ITM_wait(uint32_t ulPort);
+static void ITM_count_drop(uint32_t ulPort, uint32_t ulBytes);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Configures the TPIU for asynchronous SWO and enables the ITM and its
+ * stimulus ports.
+ * @param ulBaud SWO bit rate; SystemCoreClock must be a multiple of it.
+ * @retval 0 if successful, -1 otherwise.
+ * @note The debugger must capture SWO at the same rate (STM32CubeIDE: Serial
+ * Wire Viewer, core clock = SystemCoreClock, SWO clock = ulBaud). Without this
+ * call, a debugger that enables SWV configures the same registers itself.
+ */
+int32_t ITM_SWO_Init(uint32_t ulBaud)
+{
+	uint32_t ulPrescaler;
+
+	if ((ulBaud == 0U) || ((SystemCoreClock % ulBaud) != 0U))
+	{
+		return -1;
+	}
+
+	ulPrescaler = (SystemCoreClock / ulBaud) - 1U;
+
+	if (ulPrescaler > TPI_ACPR_PRESCALER_Msk)
+	{
+		return -1;
+	}
+
+	/* Trace clock and the TRACESWO pin, asynchronous mode. */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DBGMCU->CR = (DBGMCU->CR & ~DBGMCU_CR_TRACE_MODE) | DBGMCU_CR_TRACE_IOEN;
+
+	TPI->SPPR = TPI_PROTOCOL_NRZ;
+	TPI->ACPR = ulPrescaler;
+	TPI->FFCR = TPI_FFCR_TrigIn_Msk;		/* Formatter off: SWO carries ITM only. */
+
+	ITM->LAR = ITM_LOCK_KEY;
+	ITM->TCR = ITM_TCR_ITMENA_Msk | ITM_TCR_SYNCENA_Msk | ITM_TCR_SWOENA_Msk
+			| (ITM_TRACE_BUS_ID << ITM_TCR_TraceBusID_Pos);
+	ITM->TPR = 0;							/* Unprivileged writes allowed. */
+	ITM->TER |= (1UL << ITM_PORT_COUNT) - 1U;
+
+	return 0;
+}
+
+/**
+ * @brief Writes a buffer to a stimulus port.
+ * @param ulPort Stimulus port, below ITM_PORT_COUNT.
+ * @param ptr Bytes to send.
+ * @param len Number of bytes.
+ * @retval len: bytes that could not be sent are dropped and counted.
+ * @note Tasks and ISRs of any priority. Writers on the same port may interleave
+ * their packets; give each source its own port to keep them apart.
+ */
+int ITM_write_buffer(uint32_t ulPort, const char *ptr, int len)
+{
+	uint32_t ulWord;
+	int i = 0;
+
+	if ((ulPort >= ITM_PORT_COUNT) || (ITM_port_enabled(ulPort) == 0))
+	{
+		return len;
+	}
+
+	while (i < len)
+	{
+		if (ITM_wait(ulPort) != 0)
+		{
+			ITM_count_drop(ulPort, (uint32_t)(len - i));
+			break;
+		}
+
+		if ((len - i) >= 4)
+		{
+			memcpy(&ulWord, &ptr[i], sizeof(ulWord));
+			ITM->PORT[ulPort].u32 = ulWord;
+			i += 4;
+		}
+		else
+		{
+			ITM->PORT[ulPort].u8 = (uint8_t)ptr[i];
+			i++;
+		}
+	}
+
+	return len;
+}
+
+/**
+ * @brief Writes one 32-bit sample to a stimulus port without waiting.
+ * @param ulPort Stimulus port, below ITM_PORT_COUNT.
+ * @param ulWord Sample.
+ * @retval 0 if sent, -1 if the port is disabled or its FIFO is full.
+ * @note Never waits, whatever ITM_BLOCKING: a late sample is worth less than
+ * the time spent waiting. Tasks and ISRs of any priority.
+ */
+int32_t ITM_write_word(uint32_t ulPort, uint32_t ulWord)
+{
+	if ((ulPort >= ITM_PORT_COUNT) || (ITM_port_enabled(ulPort) == 0))
+	{
+		return -1;
+	}
+
+	if (ITM->PORT[ulPort].u32 == 0UL)
+	{
+		ITM_count_drop(ulPort, sizeof(ulWord));
+		return -1;
+	}
+
+	ITM->PORT[ulPort].u32 = ulWord;
+
+	return 0;
+}
+
+/**
+ * @brief Returns the number of bytes dropped on a port because its FIFO was
+ * full.
+ * @param ulPort Stimulus port.
+ * @retval Dropped bytes since start-up.
+ */
+uint32_t ITM_get_dropped(uint32_t ulPort)
+{
+	return (ulPort < ITM_PORT_COUNT) ? ulItmDropped[ulPort] : 0U;
+}
+
+/**
+ * @brief Buffer-level output hook called by _write() in syscalls.c when a
+ * stream is routed to the ITM.
+ * @param ptr Bytes to send.
+ * @param len Number of bytes.
+ * @retval Number of bytes consumed.
+ */
+int __io_putbuf_itm(char *ptr, int len)
+{
+	return ITM_write_buffer(ITM_PORT_TEXT, ptr, len);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Checks that the ITM and a stimulus port are enabled.
+ * @param ulPort Stimulus port.
+ * @retval 1 if enabled, 0 otherwise.
+ */
+static int32_t ITM_port_enabled(uint32_t ulPort)
+{
+	return ((ITM->TCR & ITM_TCR_ITMENA_Msk) != 0U) && ((ITM->TER & (1UL << ulPort)) != 0U);
+}
+
+/**
+ * @brief Waits for room in the stimulus FIFO of a port.
+ * @param ulPort Stimulus port.
+ * @retval 0 if there is room, -1 if the write must be dropped.
+ */
+static int32_t ITM_wait(uint32_t ulPort)
+{
+#if (ITM_BLOCKING == 1U)
+	uint32_t ulSpins;
+
+	for (ulSpins = 0; ulSpins < ITM_BLOCK_SPINS; ulSpins++)
+	{
+		if (ITM->PORT[ulPort].u32 != 0UL)
+		{
+			return 0;
+		}
+	}
+
+	return -1;
+#else
+	return (ITM->PORT[ulPort].u32 != 0UL) ? 0 : -1;
+#endif
+}
+
+/**
+ * @brief Adds to the dropped byte count of a port, from any context.
+ * @param ulPort Stimulus port.
+ * @param ulBytes Bytes dropped.
+ * @retval None
+ */
+static void ITM_count_drop(uint32_t ulPort, uint32_t ulBytes)
+{
+	uint32_t ulDropped;
+
+	do
+	{
+		ulDropped = __LDREXW(&ulItmDropped[ulPort]);
+	} while (__STREXW(ulDropped + ulBytes, &ulItmDropped[ulPort]) != 0U);
+}
@@ -0,0 +1,534 @@
+/*******************************************************************************
+ *
+ * @file	lowpower.c
+ * @brief	Tickless idle for the STM32F446: STOP mode timed by the RTC wakeup
+ * 			timer.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	'configUSE_TICKLESS_IDLE' must be set to 2 in 'FreeRTOSConfig.h' so
+ * 			that this file, not port.c, provides vPortSuppressTicksAndSleep().
+ *
+ * 			The SysTick stops with the core clock in STOP mode, so the sleep is
+ * 			timed by the RTC wakeup timer (LSE / 4 = 8192 Hz, up to 8 s per
+ * 			sleep) and measured afterwards from the RTC sub-second counter
+ * 			(LSE / 8 = 4096 Hz). The measured time, not the programmed one,
+ * 			is what vTaskStepTick() is given, so an early wakeup by any other
+ * 			EXTI source keeps the tick count right.
+ *
+ * 			Peripherals clocked from the PLL (e.g. USART2) stop too. A task
+ * 			that must not lose UART input should stay ready, or sleep via a
+ * 			wakeup-capable source. A driver holding a DMA, timer or USART
+ * 			clock (see clkgate.h) keeps idle periods in SLEEP mode instead.
+ *
+ * 			The time spent in either mode is kept with the counters, in
+ * 			run-time counter units, for the energy estimate (energy.c).
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clock.h"
+#include "lowpower.h"
+#include "runstats.h"
+#include "idlejob.h"
+#include "clkgate.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define LOWPOWER_LSE_HZ			32768U
+#define LOWPOWER_RTC_PREDIV_A	7U		/* 32768 / (7 + 1) = 4096 Hz */
+#define LOWPOWER_RTC_PREDIV_S	4095U	/* 4096 / (4095 + 1) = 1 Hz */
+#define LOWPOWER_SUBSEC_HZ		(LOWPOWER_LSE_HZ / (LOWPOWER_RTC_PREDIV_A + 1U))
+#define LOWPOWER_DAY_UNITS		(86400U * LOWPOWER_SUBSEC_HZ)
+
+#define LOWPOWER_WUT_HZ			(LOWPOWER_LSE_HZ / 4U)	/* WUCKSEL = RTC/4 */
+#define LOWPOWER_WUT_WUCKSEL	2U
+#define LOWPOWER_WUT_MAX_COUNTS	65536U
+#define LOWPOWER_WUT_LATENCY_COUNTS \
+	((LOWPOWER_WAKEUP_LATENCY_US * LOWPOWER_WUT_HZ + 999999U) / 1000000U)
+
+/* Longest idle period one STOP entry can cover. */
+#define LOWPOWER_MAX_STOP_TICKS \
+	((TickType_t)(((uint64_t)LOWPOWER_WUT_MAX_COUNTS * configTICK_RATE_HZ) / LOWPOWER_WUT_HZ))
+
+#define LOWPOWER_LSE_TIMEOUT	5000000U	/* Busy-wait iterations (~2 s). */
+#define LOWPOWER_EXTI_RTC_WKUP	(1U << 22)	/* EXTI line 22: RTC wakeup */
+
+/* Variables -----------------------------------------------------------------*/
+static volatile uint8_t ucLowPowerReady = 0;
+static LowPowerStats_t xStats;
+
+/* Private function prototypes -----------------------------------------------*/
+static void lowpower_rtc_unlock(void);
+static void lowpower_rtc_lock(void);
+static uint32_t lowpower_rtc_now(void);
+static void lowpower_wakeup_start(uint32_t ulCounts);
+static void lowpower_wakeup_stop(void);
+static void lowpower_enter_stop(void);
+static void lowpower_restore_clock(void);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Starts the LSE and configures the RTC and its wakeup timer.
+ * @param None
+ * @retval 0 on success, -1 if the LSE did not start. STOP mode is not used
+ * until this returns 0; idle periods are then spent in SLEEP mode instead.
+ * @note Must be called before vTaskStartScheduler().
+ */
+int32_t lowpower_init(void)
+{
+	uint32_t ulTimeout = LOWPOWER_LSE_TIMEOUT;
+
+	/* Enable clock for PWR and allow writes to the backup domain. */
+	RCC->APB1ENR |= RCC_APB1ENR_PWREN;
+	PWR->CR |= PWR_CR_DBP;
+
+	/* The RTC clock source can only be changed by a backup domain reset. Skip
+	 * it when the RTC already runs from the LSE, e.g. after a warm reset. */
+	if ((RCC->BDCR & RCC_BDCR_RTCSEL) != RCC_BDCR_RTCSEL_0)
+	{
+		RCC->BDCR |= RCC_BDCR_BDRST;
+		RCC->BDCR &= ~RCC_BDCR_BDRST;
+	}
+
+	/* Start the LSE (32.768 kHz crystal X2 on the NUCLEO-F446RE). */
+	RCC->BDCR |= RCC_BDCR_LSEON;
+
+	while (!(RCC->BDCR & RCC_BDCR_LSERDY))
+	{
+		if (--ulTimeout == 0U)
+		{
+			return -1;
+		}
+	}
+
+	/* Clock the RTC from the LSE and enable it. */
+	RCC->BDCR |= (RCC_BDCR_RTCSEL_0 | RCC_BDCR_RTCEN);
+
+	lowpower_rtc_unlock();
+
+	/* The prescalers can only be written in initialization mode. */
+	RTC->ISR |= RTC_ISR_INIT;
+
+	while (!(RTC->ISR & RTC_ISR_INITF))
+	{
+		/* Wait for initialization mode. */
+	}
+
+	RTC->PRER = LOWPOWER_RTC_PREDIV_S;
+	RTC->PRER |= (LOWPOWER_RTC_PREDIV_A << RTC_PRER_PREDIV_A_Pos);
+	RTC->ISR &= ~RTC_ISR_INIT;
+
+	/* Read the calendar directly. The shadow registers are stale after STOP
+	 * mode until they resynchronize, which would cost 2 RTCCLK cycles. */
+	RTC->CR |= RTC_CR_BYPSHAD;
+
+	/* The wakeup clock can only be selected while the timer is off. */
+	RTC->CR &= ~(RTC_CR_WUTE | RTC_CR_WUTIE);
+
+	while (!(RTC->ISR & RTC_ISR_WUTWF))
+	{
+		/* Wait until the wakeup timer can be written. */
+	}
+
+	RTC->CR &= ~RTC_CR_WUCKSEL;
+	RTC->CR |= (LOWPOWER_WUT_WUCKSEL << RTC_CR_WUCKSEL_Pos);
+
+	lowpower_rtc_lock();
+
+	/* The RTC wakeup event reaches the core through EXTI line 22. */
+	EXTI->IMR |= LOWPOWER_EXTI_RTC_WKUP;
+	EXTI->RTSR |= LOWPOWER_EXTI_RTC_WKUP;
+
+	NVIC_SetPriority(RTC_WKUP_IRQn, 6);
+	NVIC_EnableIRQ(RTC_WKUP_IRQn);
+
+	ucLowPowerReady = 1;
+
+	return 0;
+}
+
+/**
+ * @brief Copies the tickless idle counters.
+ * @param pxStats Destination of the counters.
+ * @retval None
+ */
+void lowpower_get_stats(LowPowerStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = xStats;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Holds the MCU in RUN, SLEEP and STOP mode in turn so the supply
+ * current of each can be read on the IDD jumper (JP6).
+ * @param ulSecondsPerMode How long each mode is held.
+ * @retval None
+ * @note Call after lowpower_init() and before vTaskStartScheduler(). The mode
+ * about to be entered is printed first. In SLEEP mode the core is woken once
+ * per millisecond, as by SysTick under the scheduler: by the HAL timebase
+ * (TIM1), or by SysTick itself when the HAL timebase follows the RTOS tick.
+ */
+void lowpower_current_benchmark(uint32_t ulSecondsPerMode)
+{
+	uint32_t ulStart;
+	uint32_t ulCounts;
+	const uint32_t ulUnits = ulSecondsPerMode * LOWPOWER_SUBSEC_HZ;
+
+	if (!ucLowPowerReady)
+	{
+		printf("[lowpower] RTC not running, benchmark skipped.\r\n");
+		return;
+	}
+
+	printf("[lowpower] RUN for %lu s.\r\n", ulSecondsPerMode);
+	HAL_Delay(10);	/* Let the UART drain. */
+	ulStart = lowpower_rtc_now();
+
+	while (((lowpower_rtc_now() + LOWPOWER_DAY_UNITS - ulStart) % LOWPOWER_DAY_UNITS) < ulUnits)
+	{
+		/* Busy loop. */
+	}
+
+	printf("[lowpower] SLEEP for %lu s.\r\n", ulSecondsPerMode);
+	HAL_Delay(10);
+	ulStart = lowpower_rtc_now();
+
+#if (configUSE_HAL_TIMEBASE_RTOS_TICK == 1)
+	/* No TIM1 interrupt to end the WFI; SysTick_Handler() ignores the tick
+	 * until the scheduler starts, which then reprograms SysTick. */
+	SysTick_Config(SystemCoreClock / configTICK_RATE_HZ);
+#endif
+
+	while (((lowpower_rtc_now() + LOWPOWER_DAY_UNITS - ulStart) % LOWPOWER_DAY_UNITS) < ulUnits)
+	{
+		__WFI();
+	}
+
+#if (configUSE_HAL_TIMEBASE_RTOS_TICK == 1)
+	SysTick->CTRL = 0U;
+#endif
+
+	printf("[lowpower] STOP for %lu s.\r\n", ulSecondsPerMode);
+	HAL_Delay(10);
+	ulCounts = ulSecondsPerMode * LOWPOWER_WUT_HZ;
+
+	/* Keep the HAL timebase from ending STOP mode early. */
+	HAL_SuspendTick();
+	__disable_irq();
+	NVIC_ClearPendingIRQ(TIM1_UP_TIM10_IRQn);
+
+	while (ulCounts > 0U)
+	{
+		uint32_t ulChunk = (ulCounts > LOWPOWER_WUT_MAX_COUNTS) ? LOWPOWER_WUT_MAX_COUNTS : ulCounts;
+
+		lowpower_wakeup_start(ulChunk);
+
+		do
+		{
+			lowpower_enter_stop();
+		} while (!(RTC->ISR & RTC_ISR_WUTF));
+
+		lowpower_wakeup_stop();
+		ulCounts -= ulChunk;
+	}
+
+	lowpower_restore_clock();
+	__enable_irq();
+	HAL_ResumeTick();
+
+	printf("[lowpower] Benchmark done.\r\n");
+}
+
+/**
+ * @brief Suppresses the tick for an idle period (called by the idle task).
+ * @param xExpectedIdleTime Ticks until the next task unblocks.
+ * @retval None
+ */
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime)
+{
+	TickType_t xModifiableIdleTime;
+	TickType_t xCompleteTicks;
+	uint32_t ulTickCounts;
+	uint32_t ulSpentCounts;
+	uint32_t ulWakeupCounts;
+	uint32_t ulStart;
+	uint32_t ulElapsed;
+	uint64_t ullSleptCounts;
+	uint64_t ullTotalCounts;
+#if (configGENERATE_RUN_TIME_STATS == 1)
+	configRUN_TIME_COUNTER_TYPE xSleepStart;
+#endif
+
+	/* Enter a critical section but don't use taskENTER_CRITICAL(), as that
+	 * would mask the interrupts that have to end the sleep. */
+	__disable_irq();
+	__DSB();
+	__ISB();
+
+	/* A context switch is pending, a task is waiting for the scheduler to be
+	 * resumed, or an interrupt kicked an idle job since the idle hook ran, so
+	 * do not sleep. */
+	if ((eTaskConfirmSleepModeStatus() == eAbortSleep) || (idlejob_pending() != pdFALSE))
+	{
+		xStats.ulAborts++;
+		__enable_irq();
+		return;
+	}
+
+	/* Short idle periods, and those a peripheral in use would not survive:
+	 * plain SLEEP mode, the SysTick keeps running and the next tick interrupt
+	 * ends the sleep. */
+	if (!ucLowPowerReady || (xExpectedIdleTime < LOWPOWER_MIN_STOP_TICKS)
+			|| (clkgate_stop_allowed() == pdFALSE))
+	{
+		if (ucLowPowerReady && (xExpectedIdleTime >= LOWPOWER_MIN_STOP_TICKS))
+		{
+			xStats.ulStopVetoes++;
+		}
+
+		xStats.ulSleepEntries++;
+#if (configGENERATE_RUN_TIME_STATS == 1)
+		/* Read before the interrupt that ends the sleep is taken, so its
+		 * handler is not counted as sleep. */
+		xSleepStart = runstats_get_counter();
+#endif
+		__DSB();
+		__WFI();
+		__ISB();
+#if (configGENERATE_RUN_TIME_STATS == 1)
+		xStats.ullSleepTime += runstats_get_counter() - xSleepStart;
+#endif
+		__enable_irq();
+		return;
+	}
+
+	if (xExpectedIdleTime > LOWPOWER_MAX_STOP_TICKS)
+	{
+		xExpectedIdleTime = LOWPOWER_MAX_STOP_TICKS;
+	}
+
+	/* Stop the SysTick and note how far into the current tick period it was. */
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+	ulTickCounts = SysTick->LOAD + 1U;
+	ulSpentCounts = ulTickCounts - SysTick->VAL;
+
+	/* Sleep to the start of the tick the next task unblocks on, early by the
+	 * wakeup latency. */
+	ulWakeupCounts = (uint32_t)(((uint64_t)(xExpectedIdleTime * ulTickCounts - ulSpentCounts)
+			* LOWPOWER_WUT_HZ) / configCPU_CLOCK_HZ);
+
+	if (ulWakeupCounts > LOWPOWER_WUT_LATENCY_COUNTS)
+	{
+		ulWakeupCounts -= LOWPOWER_WUT_LATENCY_COUNTS;
+	}
+
+	if (ulWakeupCounts > LOWPOWER_WUT_MAX_COUNTS)
+	{
+		ulWakeupCounts = LOWPOWER_WUT_MAX_COUNTS;
+	}
+
+	ulStart = lowpower_rtc_now();
+	lowpower_wakeup_start(ulWakeupCounts);
+
+	/* configPRE_SLEEP_PROCESSING() can set its parameter to 0 to indicate that
+	 * it slept on its own, as in port.c. */
+	xModifiableIdleTime = xExpectedIdleTime;
+	configPRE_SLEEP_PROCESSING(xModifiableIdleTime);
+
+	if (xModifiableIdleTime > 0)
+	{
+		lowpower_enter_stop();
+	}
+
+	lowpower_restore_clock();
+	configPOST_SLEEP_PROCESSING(xExpectedIdleTime);
+
+	if (!(RTC->ISR & RTC_ISR_WUTF))
+	{
+		xStats.ulEarlyWakeups++;
+	}
+
+	lowpower_wakeup_stop();
+	xStats.ulStopEntries++;
+
+	/* Convert the measured sleep into SysTick counts and add the part of the
+	 * tick period that had already passed. */
+	ulElapsed = (lowpower_rtc_now() + LOWPOWER_DAY_UNITS - ulStart) % LOWPOWER_DAY_UNITS;
+	ullSleptCounts = ((uint64_t)ulElapsed * configCPU_CLOCK_HZ) / LOWPOWER_SUBSEC_HZ;
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+	/* The cycle counter stood still with the core clock. */
+	runstats_advance(ullSleptCounts);
+	xStats.ullStopTime += ullSleptCounts;
+#endif
+	ullTotalCounts = ullSleptCounts + ulSpentCounts;
+	xCompleteTicks = (TickType_t)(ullTotalCounts / ulTickCounts);
+
+	if (xCompleteTicks >= xExpectedIdleTime)
+	{
+		/* The tick that unblocks a task is due now. Step to just before it and
+		 * let the SysTick handler process it as soon as interrupts are back. */
+		xCompleteTicks = xExpectedIdleTime - 1U;
+		SysTick->LOAD = ulTickCounts - 1U;
+		SCB->ICSR = SCB_ICSR_PENDSTSET_Msk;
+	}
+	else
+	{
+		/* Run the rest of the current tick period, then full periods again. */
+		SysTick->LOAD = ulTickCounts - (uint32_t)(ullTotalCounts % ulTickCounts) - 1U;
+	}
+
+	SysTick->VAL = 0U;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+	SysTick->LOAD = ulTickCounts - 1U;
+
+	vTaskStepTick(xCompleteTicks);
+	xStats.ulTicksSuppressed += xCompleteTicks;
+
+	/* Exit with interrupts enabled. The RTC wakeup interrupt, if pending,
+	 * only acknowledges the flags. */
+	__enable_irq();
+}
+
+/**
+ * @brief Acknowledges the RTC wakeup; its only job is to end STOP mode.
+ * @param None
+ * @retval None
+ */
+void RTC_WKUP_IRQHandler(void)
+{
+	/* RTC_ISR[13:8] is not write protected, so no unlock is needed. */
+	RTC->ISR = (~(RTC_ISR_WUTF | RTC_ISR_INIT) & 0x0000FFFFU) | (RTC->ISR & RTC_ISR_INIT);
+	EXTI->PR = LOWPOWER_EXTI_RTC_WKUP;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Disables the RTC register write protection.
+ * @param None
+ * @retval None
+ */
+static void lowpower_rtc_unlock(void)
+{
+	RTC->WPR = 0xCAU;
+	RTC->WPR = 0x53U;
+}
+
+/**
+ * @brief Re-enables the RTC register write protection.
+ * @param None
+ * @retval None
+ */
+static void lowpower_rtc_lock(void)
+{
+	RTC->WPR = 0xFFU;
+}
+
+/**
+ * @brief Reads the RTC time of day.
+ * @param None
+ * @retval Time of day in 1/4096 s units.
+ */
+static uint32_t lowpower_rtc_now(void)
+{
+	uint32_t ulSsr;
+	uint32_t ulTr;
+	uint32_t ulSeconds;
+
+	/* With BYPSHAD set the two registers are not latched together, so re-read
+	 * if a sub-second tick happened in between. */
+	do
+	{
+		ulSsr = RTC->SSR;
+		ulTr = RTC->TR;
+	} while (ulSsr != RTC->SSR);
+
+	/* TR holds BCD hours, minutes and seconds (24-hour format). */
+	ulSeconds = ((((ulTr >> 20) & 0x3U) * 10U + ((ulTr >> 16) & 0xFU)) * 3600U)
+			+ ((((ulTr >> 12) & 0x7U) * 10U + ((ulTr >> 8) & 0xFU)) * 60U)
+			+ (((ulTr >> 4) & 0x7U) * 10U + (ulTr & 0xFU));
+
+	/* SSR counts down from PREDIV_S within each second. */
+	return (ulSeconds * LOWPOWER_SUBSEC_HZ) + (LOWPOWER_RTC_PREDIV_S - (ulSsr & 0xFFFFU));
+}
+
+/**
+ * @brief Arms the RTC wakeup timer.
+ * @param ulCounts Wakeup timer periods (1/8192 s) until the wakeup, 1..65536.
+ * @retval None
+ */
+static void lowpower_wakeup_start(uint32_t ulCounts)
+{
+	lowpower_rtc_unlock();
+
+	RTC->CR &= ~(RTC_CR_WUTE | RTC_CR_WUTIE);
+
+	while (!(RTC->ISR & RTC_ISR_WUTWF))
+	{
+		/* Wait until the wakeup timer can be written. */
+	}
+
+	RTC->WUTR = ulCounts - 1U;
+
+	/* Clear a stale wakeup so STOP mode is not left straight away. */
+	RTC->ISR = (~(RTC_ISR_WUTF | RTC_ISR_INIT) & 0x0000FFFFU) | (RTC->ISR & RTC_ISR_INIT);
+	EXTI->PR = LOWPOWER_EXTI_RTC_WKUP;
+
+	RTC->CR |= (RTC_CR_WUTE | RTC_CR_WUTIE);
+
+	lowpower_rtc_lock();
+}
+
+/**
+ * @brief Disarms the RTC wakeup timer and drops any pending wakeup.
+ * @param None
+ * @retval None
+ */
+static void lowpower_wakeup_stop(void)
+{
+	lowpower_rtc_unlock();
+	RTC->CR &= ~(RTC_CR_WUTE | RTC_CR_WUTIE);
+	lowpower_rtc_lock();
+
+	RTC->ISR = (~(RTC_ISR_WUTF | RTC_ISR_INIT) & 0x0000FFFFU) | (RTC->ISR & RTC_ISR_INIT);
+	EXTI->PR = LOWPOWER_EXTI_RTC_WKUP;
+	NVIC_ClearPendingIRQ(RTC_WKUP_IRQn);
+}
+
+/**
+ * @brief Enters STOP mode with the low-power regulator and flash powered down.
+ * @param None
+ * @retval None
+ * @note Returns straight away if an interrupt is already pending.
+ */
+static void lowpower_enter_stop(void)
+{
+	/* STOP, not STANDBY. */
+	PWR->CR &= ~PWR_CR_PDDS;
+	PWR->CR |= (PWR_CR_LPDS | PWR_CR_FPDS | PWR_CR_CWUF);
+
+	SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+	__DSB();
+	__WFI();
+	__ISB();
+	SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+}
+
+/**
+ * @brief Switches the system clock back to the PLL after STOP mode.
+ * @param None
+ * @retval None
+ * @note STOP mode exit leaves the HSI as system clock. clock_resume_from_stop()
+ * brings back whatever the current clock profile needs (HSE, PLL, over-drive)
+ * without the full HAL sequence.
+ */
+static void lowpower_restore_clock(void)
+{
+	clock_resume_from_stop();
+}
@@ -11,25 +11,148 @@
  * 			'configUSE_IDLE_HOOK' must be enabled in the 'FreeRTOSConfig.h' file
  * 			for the idle hook function to work.
  *
+ * 			The three LED controllers are coroutines sharing one executor
+ * 			task (see coro.h) instead of three tasks with their own stacks.
+ *
+ * 			The coroutines of equal periods, the three 250 ms LED
+ * 			controllers and the two 1 s ones, would all be released on the
+ * 			same ticks. With RELEASE_PHASES set, their first releases are
+ * 			staggered (see phase.h), so the executor wakes for one or two of
+ * 			them at a time, and the releases per tick are printed at
+ * 			start-up.
+ *
+ * 			The idle hook also scrubs the flash checksum once a second, in
+ * 			slices of IDLE_SCRUB_BUDGET_CYCLES (see idlejob.h).
+ *
+ * 			The CPU load, from the time the idle task runs, is printed every
+ * 			second (see cpuload.h).
+ *
+ * 			The worst CPU load, free heap and idle job step of each boot are
+ * 			kept in backup SRAM (see perfstore.h), and those of the previous
+ * 			boots are printed at start-up, with the cause of each reset.
+ *
+ * 			A sample of the idle count and free heap is logged to flash every
+ * 			second (see flashlog.h). The flash is programmed and erased from
+ * 			the idle task, and the samples kept are counted at start-up.
+ *
+ * 			The clock profile follows the CPU load, between 84 and 180 MHz
+ * 			(see dvfs.h). The time spent in each profile is printed every
+ * 			5 s.
+ *
+ * 			The energy of each task is estimated from its run time, the
+ * 			clock profile, the time slept and the clocks it holds (see
+ * 			energy.h), printed every 10 s and sent as telemetry counters
+ * 			on ITM stimulus port 3 ('Tools/telemetry_decode.py swo.bin
+ * 			--itm 3').
+ *
  ******************************************************************************/
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
+#include "coro.h"
+#include "lowpower.h"
+#include "runstats.h"
+#include "idlejob.h"
+#include "cpuload.h"
+#include "crc.h"
+#include "perfstore.h"
+#include "flashlog.h"
+#include "dvfs.h"
+#include "energy.h"
+#if (ENERGY_TELEMETRY == 1)
+#include "itm.h"
+#include "telemetry.h"
+#include "phase.h"
+#endif
+
+/* Macros --------------------------------------------------------------------*/
+#define IDLE_JOBS 1	/* 0: the idle hook only counts, 1: it also runs background jobs */
+#define IDLE_SCRUB_START ((const uint32_t *)FLASH_BASE)
+#define IDLE_SCRUB_WORDS (64U * 1024U / 4U)				/* The first 64 KB. */
+#define IDLE_SCRUB_STEP_WORDS 64U						/* Checksummed per step. */
+#define IDLE_SCRUB_BUDGET_CYCLES (configCPU_CLOCK_HZ / 10000U)	/* 100 us per slice. */
+#define IDLE_SCRUB_PERIOD_MS 1000U
+#define CPU_LOAD 1	/* 0: watch uIdleTaskProfiler grow, 1: print the measured CPU load */
+#define CPU_LOAD_PERIOD_MS 1000U
+#define PERF_STORE 1	/* 0: nothing kept across resets, 1: keep the worst counters in backup SRAM */
+#define PERF_STORE_COMMIT_MS 1000U
+#define FLASH_LOG 1	/* 0: no log, 1: log a sample every FLASH_LOG_PERIOD_MS to flash */
+#define FLASH_LOG_PERIOD_MS 1000U
+#define FLASH_LOG_REALTIME_PRIORITY 3U	/* Above every task here: the LEDs and reports may be late by an erase. */
+#define DVFS_GOVERNOR 1	/* 0: stay at CLOCK_PROFILE_DEFAULT, 1: follow the CPU load */
+#define DVFS_MIN_PROFILE CLOCK_PROFILE_LOW_POWER
+#define DVFS_MAX_PROFILE CLOCK_PROFILE_MAX_PERFORMANCE
+#define DVFS_REPORT_MS 5000U
+#define ENERGY 1	/* 0: no estimate, 1: charge each task its energy (energy.c) */
+#define ENERGY_REPORT_MS 10000U
+#define TELEMETRY_RATE_HZ 1U	/* The energy counters change every ENERGY_PERIOD_MS. */
+#define RELEASE_PHASES 1	/* 0: coroutines of equal periods wake on the same tick, 1: staggered first releases */
+
+#if (FLASH_LOG == 1) && (IDLE_JOBS == 0)
+#error FLASH_LOG programs the flash from the idle jobs: set IDLE_JOBS to 1
+#endif
+
+#if (DVFS_GOVERNOR == 1) && (CPU_LOAD == 0)
+#error DVFS_GOVERNOR follows the measured load: set CPU_LOAD to 1
+#endif
+
+#if (ENERGY_TELEMETRY == 1) && (ENERGY == 0)
+#error ENERGY_TELEMETRY streams the estimate: set ENERGY to 1
+#endif
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 static void MX_USART2_UART_Init(void);
 int __io_putchar(int ch);
-void vBlueLedControllerTask(void *pvParameters);
-void vRedLedControllerTask(void *pvParameters);
-void vGreenLedControllerTask(void *pvParameters);
+void vLedControllerCoro(Coro_t *pxCoro);
+#if (IDLE_JOBS == 1)
+void vScrubKickCoro(Coro_t *pxCoro);
+static BaseType_t prvScrubStep(void *pvArg);
+#endif
+#if (PERF_STORE == 1)
+static void prvPerfSample(void);
+#endif
+#if (FLASH_LOG == 1)
+void vFlashLogCoro(Coro_t *pxCoro);
+static void prvFlashLogReport(void);
+#endif
 
 /* Data types ----------------------------------------------------------------*/
 typedef uint32_t TaskProfiler;
 
+/* A LED controller coroutine, kept across its waits. */
+typedef struct
+{
+	TaskProfiler *puProfiler;
+	PhaseTask_t xPhase;
+	TickType_t xLastWake;
+} LedController_t;
+
+#if (PERF_STORE == 1)
+/* Counters of the persistent store, in the order of xPerfCounters. */
+enum
+{
+	PERF_CPU_PEAK,			/* 1 s average, in units of 0.01 %. */
+	PERF_HEAP_MIN_FREE,		/* Bytes. */
+	PERF_IDLE_STEP_MAX,		/* Cycles of the longest idle job step. */
+	PERF_COUNTERS
+};
+#endif
+
+#if (FLASH_LOG == 1)
+/* A record of the flash log. */
+typedef struct
+{
+	uint32_t ulUptimeMs;
+	uint32_t ulIdleCount;				/* uIdleTaskProfiler. */
+	uint32_t ulFreeHeap;				/* Bytes. */
+} FlashLogSample_t;
+#endif
+
 /* Variables -----------------------------------------------------------------*/
 TaskProfiler uRedTaskProfiler;
 TaskProfiler uBlueTaskProfiler;
@@ -37,6 +160,37 @@ TaskProfiler uGreenTaskProfiler;
 TaskProfiler uIdleTaskProfiler;
 UART_HandleTypeDef huart2;
 const TickType_t TICKS_250_MS = pdMS_TO_TICKS(250);
+static CoroExecutor_t xLedExecutor;
+static Coro_t xGreenLedCoro;
+static Coro_t xRedLedCoro;
+static Coro_t xBlueLedCoro;
+static LedController_t xGreenLed = { &uGreenTaskProfiler };
+static LedController_t xRedLed = { &uRedTaskProfiler };
+static LedController_t xBlueLed = { &uBlueTaskProfiler };
+#if (IDLE_JOBS == 1)
+static Coro_t xScrubKickCoro;
+static PhaseTask_t xScrubKickPhase;
+static TickType_t xScrubKickLastWake;
+static IdleJob_t xScrubJob;
+static uint32_t ulScrubOffset;		/* Next word to checksum. */
+static uint32_t ulScrubSum;
+static uint32_t ulScrubReference;	/* Checksum of the first pass. */
+uint32_t ulScrubPasses;
+uint32_t ulScrubErrors;				/* Passes that did not match the first. */
+#endif
+#if (PERF_STORE == 1)
+static const PerfStoreCounter_t xPerfCounters[PERF_COUNTERS] =
+{
+	{ "cpu_peak", PERFSTORE_KIND_MAX },
+	{ "heap_min_free", PERFSTORE_KIND_MIN },
+	{ "idle_step_max", PERFSTORE_KIND_MAX }
+};
+#endif
+#if (FLASH_LOG == 1)
+static Coro_t xFlashLogCoro;
+static PhaseTask_t xFlashLogPhase;
+static TickType_t xFlashLogLastWake;
+#endif
 
 /**
  * @brief The application entry point.
@@ -53,27 +207,100 @@ int main(void)
 	MX_GPIO_Init();
 	MX_USART2_UART_Init();
 
-	/* Create tasks */
-	xTaskCreate(vGreenLedControllerTask,
-				"Green Led Controller",
-				100,
-				NULL,
-				1,
-				NULL);
-
-	xTaskCreate(vRedLedControllerTask,
-				"Red Led Controller",
-				100,
-				NULL,
-				1,
-				NULL);
-
-	xTaskCreate(vBlueLedControllerTask,
-				"Blue Led Controller",
-				100,
-				NULL,
-				1,
-				NULL);
+#if (ENERGY == 1)
+	/* Before the first clock hold, that of crc_init(). */
+	if (energy_start(&xEnergyModelNucleoF446RE, 2, ENERGY_REPORT_MS) != pdPASS)
+	{
+		Error_Handler();
+	}
+#endif
+
+#if (PERF_STORE == 1) || (FLASH_LOG == 1) || (ENERGY_TELEMETRY == 1)
+	crc_init();
+#endif
+
+#if (PERF_STORE == 1)
+	/* The worst counters of the previous boots, and what ended each. */
+	(void)perfstore_init(xPerfCounters, PERF_COUNTERS);
+	perfstore_report();
+#endif
+
+#if (FLASH_LOG == 1)
+	/* Picks up after the last sample of the previous boots. */
+	flashlog_init();
+	flashlog_set_realtime_priority(FLASH_LOG_REALTIME_PRIORITY);
+	prvFlashLogReport();
+#endif
+
+	/* Tickless idle: STOP mode timed by the RTC. On failure (no LSE) idle
+	 * periods fall back to SLEEP mode. */
+	lowpower_init();
+
+#if LOWPOWER_RUN_CURRENT_BENCHMARK
+	lowpower_current_benchmark(10);
+#endif
+
+	/* The periodic coroutines, each release about as cheap as the others. */
+	phase_register(&xGreenLed.xPhase, "Green", TICKS_250_MS, 1);
+	phase_register(&xRedLed.xPhase, "Red", TICKS_250_MS, 1);
+	phase_register(&xBlueLed.xPhase, "Blue", TICKS_250_MS, 1);
+#if (IDLE_JOBS == 1)
+	phase_register(&xScrubKickPhase, "ScrubKick", pdMS_TO_TICKS(IDLE_SCRUB_PERIOD_MS), 1);
+#endif
+#if (FLASH_LOG == 1)
+	phase_register(&xFlashLogPhase, "FlashLog", pdMS_TO_TICKS(FLASH_LOG_PERIOD_MS), 1);
+#endif
+
+#if (RELEASE_PHASES == 1)
+	phase_plan();
+#endif
+	/* Without a plan every offset is 0. */
+	phase_print();
+
+	/* Create the LED controllers, all run by one task */
+	coro_executor_init(&xLedExecutor);
+	coro_spawn(&xLedExecutor, &xGreenLedCoro, vLedControllerCoro, &xGreenLed);
+	coro_spawn(&xLedExecutor, &xRedLedCoro, vLedControllerCoro, &xRedLed);
+	coro_spawn(&xLedExecutor, &xBlueLedCoro, vLedControllerCoro, &xBlueLed);
+
+#if (IDLE_JOBS == 1)
+	/* Flash scrubbing, only in time no task wants. */
+	idlejob_register(&xScrubJob, "Scrub", prvScrubStep, NULL, IDLE_SCRUB_BUDGET_CYCLES);
+	coro_spawn(&xLedExecutor, &xScrubKickCoro, vScrubKickCoro, &xScrubJob);
+#endif
+
+#if (FLASH_LOG == 1)
+	coro_spawn(&xLedExecutor, &xFlashLogCoro, vFlashLogCoro, NULL);
+#endif
+
+	coro_executor_start(&xLedExecutor, "Led Controllers", 128, 1);
+
+	/* Print each task's share of the CPU every 5 s. Time spent in STOP mode is
+	 * charged to the idle task. */
+	runstats_start_reporter(5000, 2);
+
+#if (CPU_LOAD == 1)
+	cpuload_start_reporter(CPU_LOAD_PERIOD_MS, 2);
+#endif
+
+#if (PERF_STORE == 1)
+	/* A reset loses at most the last PERF_STORE_COMMIT_MS of counters. */
+	perfstore_start_committer(PERF_STORE_COMMIT_MS, 2, prvPerfSample);
+#endif
+
+#if (DVFS_GOVERNOR == 1)
+	/* Above the LED controllers, whose load it follows. */
+	(void)dvfs_set_limits(DVFS_MIN_PROFILE, DVFS_MAX_PROFILE);
+	dvfs_start(2, DVFS_REPORT_MS);
+#endif
+
+#if (ENERGY_TELEMETRY == 1)
+	/* The SWO prescaler is set again at each profile change. */
+	if ((ITM_SWO_Init(ITM_SWO_BAUD) != 0) || (telemetry_start(TELEMETRY_RATE_HZ, 2) != pdPASS))
+	{
+		Error_Handler();
+	}
+#endif
 
 	vTaskStartScheduler();
 
@@ -87,55 +314,231 @@ int main(void)
 }
 
 /**
- * @brief A task handler to increment its profiler at 250ms period.
+ * @brief A coroutine to increment its profiler at 250ms period.
+ * @param pxCoro Coroutine, with its LedController_t as its argument.
  * @retval None
  */
-void vGreenLedControllerTask(void *pvParameters)
+void vLedControllerCoro(Coro_t *pxCoro)
 {
+	LedController_t *pxLed = coro_get_arg(pxCoro);
+
+	CORO_BEGIN(pxCoro);
+
+	pxLed->xLastWake = phase_base();
+	CORO_DELAY_UNTIL(pxCoro, &pxLed->xLastWake, phase_offset(&pxLed->xPhase));
+
 	while (1)
 	{
-		uGreenTaskProfiler++;
-		vTaskDelay(TICKS_250_MS);
+		(*pxLed->puProfiler)++;
+		CORO_DELAY_UNTIL(pxCoro, &pxLed->xLastWake, pxLed->xPhase.xPeriod);
 	}
+
+	CORO_END(pxCoro);
+}
+
+/**
+ * @brief An idle hook function to increment the idle task's profiler.
+ * @retval None
+ * @note This function is called automatically by the Idle task once per
+ * iteration of the Idle task loop. 'configUSE_IDLE_HOOK()' must be enabled in
+ * 'FreeRTOSConfig.h' file for this function to be called.
+ */
+void vApplicationIdleHook(void)
+{
+	uIdleTaskProfiler++;
+
+#if (IDLE_JOBS == 1)
+	idlejob_run();
+#endif
 }
 
+#if (CPU_LOAD == 1)
 /**
- * @brief A task handler to increment its profiler at 250ms period.
- * @retval Nonee
+ * @brief A tick hook function to sample the CPU load.
+ * @retval None
+ * @note Called from the tick interrupt. 'configUSE_TICK_HOOK' must be enabled
+ * in 'FreeRTOSConfig.h' file for this function to be called.
  */
-void vRedLedControllerTask(void *pvParameters)
+void vApplicationTickHook(void)
 {
+	cpuload_tick();
+}
+#endif
+
+#if (IDLE_JOBS == 1)
+/**
+ * @brief A coroutine to start a scrubbing pass every IDLE_SCRUB_PERIOD_MS.
+ * @param pxCoro Coroutine, with the scrubbing job as its argument.
+ * @retval None
+ */
+void vScrubKickCoro(Coro_t *pxCoro)
+{
+	CORO_BEGIN(pxCoro);
+
+	xScrubKickLastWake = phase_base();
+	CORO_DELAY_UNTIL(pxCoro, &xScrubKickLastWake, phase_offset(&xScrubKickPhase));
+
 	while (1)
 	{
-		uRedTaskProfiler++;
-		vTaskDelay(TICKS_250_MS);
+		idlejob_kick(coro_get_arg(pxCoro));
+		CORO_DELAY_UNTIL(pxCoro, &xScrubKickLastWake, xScrubKickPhase.xPeriod);
 	}
+
+	CORO_END(pxCoro);
 }
 
 /**
- * @brief A task handler to increment its profiler at 250ms period.
+ * @brief Checksums the next IDLE_SCRUB_STEP_WORDS words of flash.
+ * @param pvArg Unused.
+ * @retval pdTRUE until the end of the pass, then pdFALSE.
+ */
+static BaseType_t prvScrubStep(void *pvArg)
+{
+	uint32_t ulEnd = ulScrubOffset + IDLE_SCRUB_STEP_WORDS;
+
+	(void)pvArg;
+
+	for (; ulScrubOffset < ulEnd; ulScrubOffset++)
+	{
+		/* Rotate so that swapped words change the sum. */
+		ulScrubSum = ((ulScrubSum << 1) | (ulScrubSum >> 31)) + IDLE_SCRUB_START[ulScrubOffset];
+	}
+
+	if (ulScrubOffset < IDLE_SCRUB_WORDS)
+	{
+		return pdTRUE;
+	}
+
+	if (ulScrubPasses == 0U)
+	{
+		ulScrubReference = ulScrubSum;
+	}
+	else if (ulScrubSum != ulScrubReference)
+	{
+		ulScrubErrors++;
+	}
+
+	ulScrubPasses++;
+	ulScrubOffset = 0U;
+	ulScrubSum = 0U;
+
+	return pdFALSE;
+}
+#endif
+
+#if ((DVFS_GOVERNOR == 1) && (IDLE_JOBS == 1)) || (ENERGY == 1)
+/**
+ * @brief Keeps the scrubbing slices at 100 us in the new clock profile, and
+ * the energy charged at the right one.
+ * @param eProfile The new profile.
  * @retval None
+ * @note Called by clock_set_profile() from the governor task.
  */
-void vBlueLedControllerTask(void *pvParameters)
+void clock_profile_changed_callback(ClockProfile_t eProfile)
 {
+	(void)eProfile;
+
+#if (ENERGY == 1)
+	energy_profile_changed(eProfile);
+#endif
+
+#if (ENERGY_TELEMETRY == 1)
+	(void)ITM_SWO_Init(ITM_SWO_BAUD);
+#endif
+
+#if (DVFS_GOVERNOR == 1) && (IDLE_JOBS == 1)
+	idlejob_set_budget(&xScrubJob, IDLE_SCRUB_BUDGET_CYCLES);
+#endif
+}
+#endif
+
+#if (PERF_STORE == 1)
+/**
+ * @brief Samples the counters of the persistent store, before each commit.
+ * @retval None
+ */
+static void prvPerfSample(void)
+{
+#if (CPU_LOAD == 1)
+	CpuLoad_t xLoad;
+#endif
+#if (IDLE_JOBS == 1)
+	IdleJobStats_t xStats;
+#endif
+
+#if (CPU_LOAD == 1)
+	cpuload_get(&xLoad);
+	perfstore_update(PERF_CPU_PEAK, xLoad.usLoad1s);
+#endif
+
+	perfstore_update(PERF_HEAP_MIN_FREE, (uint32_t)xPortGetMinimumEverFreeHeapSize());
+
+#if (IDLE_JOBS == 1)
+	idlejob_get_stats(&xScrubJob, &xStats);
+	perfstore_update(PERF_IDLE_STEP_MAX, xStats.ulMaxStepCycles);
+#endif
+}
+#endif
+
+#if (FLASH_LOG == 1)
+/**
+ * @brief A coroutine to log a sample every FLASH_LOG_PERIOD_MS.
+ * @param pxCoro Coroutine.
+ * @retval None
+ * @note flashlog_write() only copies the sample: the flash is programmed
+ * from the idle task.
+ */
+void vFlashLogCoro(Coro_t *pxCoro)
+{
+	FlashLogSample_t xSample;
+
+	CORO_BEGIN(pxCoro);
+
+	xFlashLogLastWake = phase_base();
+	CORO_DELAY_UNTIL(pxCoro, &xFlashLogLastWake, phase_offset(&xFlashLogPhase));
+
 	while (1)
 	{
-		uBlueTaskProfiler++;
-		vTaskDelay(TICKS_250_MS);
+		xSample.ulUptimeMs = (uint32_t)xTaskGetTickCount() * portTICK_PERIOD_MS;
+		xSample.ulIdleCount = uIdleTaskProfiler;
+		xSample.ulFreeHeap = (uint32_t)xPortGetFreeHeapSize();
+		(void)flashlog_write(&xSample, sizeof(xSample));
+		CORO_DELAY_UNTIL(pxCoro, &xFlashLogLastWake, xFlashLogPhase.xPeriod);
 	}
+
+	CORO_END(pxCoro);
 }
 
 /**
- * @brief An idle hook function to increment the idle task's profiler.
+ * @brief Prints how many samples the flash log keeps, and the newest.
  * @retval None
- * @note This function is called automatically by the Idle task once per
- * iteration of the Idle task loop. 'configUSE_IDLE_HOOK()' must be enabled in
- * 'FreeRTOSConfig.h' file for this function to be called.
  */
-void vApplicationIdleHook(void)
+static void prvFlashLogReport(void)
 {
-	uIdleTaskProfiler++;
+	FlashLogCursor_t xCursor;
+	FlashLogSample_t xSample;
+	FlashLogSample_t xLast = { 0 };
+	uint32_t ulCount = 0;
+
+	flashlog_rewind(&xCursor);
+
+	while (flashlog_read(&xCursor, &xSample, sizeof(xSample)) == (int32_t)sizeof(xSample))
+	{
+		xLast = xSample;
+		ulCount++;
+	}
+
+	printf("flashlog: %lu samples kept", ulCount);
+
+	if (ulCount > 0U)
+	{
+		printf(", the last at %lu ms of its boot, %lu bytes of heap free", xLast.ulUptimeMs,
+				xLast.ulFreeHeap);
+	}
+
+	printf("\r\n");
 }
+#endif
 
 /**
  * @brief Retargets the C library printf function to UART.
@@ -156,44 +559,9 @@ int __io_putchar(int ch)
  */
 void SystemClock_Config(void)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
-
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-	{
-		Error_Handler();
-	}
-
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
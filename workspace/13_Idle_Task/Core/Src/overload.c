@@ -0,0 +1,330 @@
+/*******************************************************************************
+ *
+ * @file	overload.c
+ * @brief	Overload manager: sheds registered work, least needed first, while
+ * 			the CPU or a queue is saturated, and restores it once they are not.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	Without it, a saturated CPU degrades everything at once: every
+ * 			task below the busiest runs late, logs and telemetry pile up in
+ * 			their buffers, and the work that matters waits behind the work
+ * 			that does not.
+ *
+ * 			The application registers actions in the order they may be given
+ * 			up, e.g. debug logs, then the telemetry rate, then sensor sample
+ * 			rates, then idle jobs. Each action has a hook that sheds the work
+ * 			and one that restores it; both run in the manager task and
+ * 			should only set a flag or a rate that their task reads.
+ *
+ * 			Every OVERLOAD_PERIOD_MS the manager takes the pressure: the CPU
+ * 			load of the last window (cpuload.c), or the fill of the fullest
+ * 			watched queue, whichever is higher, in 0.01 %.
+ *
+ * 			- OVERLOAD_SHED_SAMPLES looks in a row at or above
+ * 			  OVERLOAD_SHED_ABOVE shed the next action, and so on while
+ * 			  the pressure stays there.
+ * 			- OVERLOAD_RESTORE_SAMPLES looks in a row (the hold) at or below
+ * 			  OVERLOAD_RESTORE_BELOW restore the last action shed.
+ * 			- In between, nothing changes.
+ *
+ * 			Restoring is slower than shedding, and the two thresholds are
+ * 			apart, so that an action does not come and go with each window.
+ * 			Work that overloads the CPU whenever it is restored would still
+ * 			flap once per hold: an action shed again within a hold of being
+ * 			restored doubles the hold, up to OVERLOAD_RESTORE_SAMPLES_MAX,
+ * 			and a restore that lasts a whole hold sets it back.
+ *
+ * 			The manager must run above the work it sheds, or it would starve
+ * 			with it: give it a priority above every task with an action, and
+ * 			below the tasks whose latency matters.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "overload.h"
+#include "task.h"
+
+/* Variables -----------------------------------------------------------------*/
+static OverloadAction_t *pxActions = NULL;		/* Shed in this order. */
+static QueueHandle_t xQueues[OVERLOAD_MAX_QUEUES];
+static uint32_t ulQueueCount = 0;
+static OverloadStats_t xStats;					/* Written by the manager task only. */
+
+/* Private function prototypes -----------------------------------------------*/
+static void overload_task(void *pvParameters);
+static uint16_t overload_pressure(void);
+static OverloadAction_t *overload_action(uint32_t ulIndex);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Adds an action, shed after those registered before it.
+ * @param pxAction Storage of the action. Must stay valid for good.
+ * @param pcName Name, for overload_print().
+ * @param pxShed Gives the work up.
+ * @param pxRestore Takes it back.
+ * @param pvContext Passed to both.
+ * @retval None
+ * @note Before overload_start().
+ */
+void overload_register(OverloadAction_t *pxAction, const char *pcName, OverloadHook_t pxShed,
+		OverloadHook_t pxRestore, void *pvContext)
+{
+	OverloadAction_t **ppxLink = &pxActions;
+
+	configASSERT((pxShed != NULL) && (pxRestore != NULL));
+
+	pxAction->pcName = pcName;
+	pxAction->pxShed = pxShed;
+	pxAction->pxRestore = pxRestore;
+	pxAction->pvContext = pvContext;
+	pxAction->ulSheds = 0U;
+	pxAction->pxNext = NULL;
+
+	while (*ppxLink != NULL)
+	{
+		ppxLink = &(*ppxLink)->pxNext;
+	}
+
+	*ppxLink = pxAction;
+}
+
+/**
+ * @brief Counts the fill of a queue as pressure.
+ * @param xQueue Queue, e.g. the input of a task that falls behind under load.
+ * @retval 0 if successful, -1 if OVERLOAD_MAX_QUEUES are watched already.
+ * @note Before overload_start().
+ */
+int32_t overload_watch_queue(QueueHandle_t xQueue)
+{
+	if ((xQueue == NULL) || (ulQueueCount >= OVERLOAD_MAX_QUEUES))
+	{
+		return -1;
+	}
+
+	xQueues[ulQueueCount++] = xQueue;
+
+	return 0;
+}
+
+/**
+ * @brief Creates the manager task.
+ * @param uxPriority Above every task with an action.
+ * @retval pdPASS if the task was created.
+ */
+BaseType_t overload_start(UBaseType_t uxPriority)
+{
+	xStats.ulRestoreHold = OVERLOAD_RESTORE_SAMPLES;
+
+	return xTaskCreate(overload_task,
+					   "Overload",
+					   OVERLOAD_STACK_WORDS,
+					   NULL,
+					   uxPriority,
+					   NULL);
+}
+
+/**
+ * @brief Copies the manager statistics.
+ * @param pxStats Where to copy them.
+ * @retval None
+ */
+void overload_get_stats(OverloadStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = xStats;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Prints the pressure and the state of each action with printf().
+ * @param None
+ * @retval None
+ */
+void overload_print(void)
+{
+	OverloadStats_t xNow;
+	const OverloadAction_t *pxAction;
+	char cPressure[CPULOAD_STR_LEN];
+	char cPeak[CPULOAD_STR_LEN];
+	uint32_t ulIndex = 0;
+
+	overload_get_stats(&xNow);
+
+	printf("Overload: pressure %s (peak %s), %lu shed, %lu sheds, %lu restores, hold %lu\r\n",
+			cpuload_format(xNow.usPressure, cPressure), cpuload_format(xNow.usPeak, cPeak),
+			xNow.ulLevel, xNow.ulSheds, xNow.ulRestores, xNow.ulRestoreHold);
+
+	for (pxAction = pxActions; pxAction != NULL; pxAction = pxAction->pxNext)
+	{
+		printf("  %-16s %-4s %8lu\r\n", pxAction->pcName,
+				(ulIndex < xNow.ulLevel) ? "shed" : "on", pxAction->ulSheds);
+		ulIndex++;
+	}
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Sheds and restores the actions as the pressure says.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void overload_task(void *pvParameters)
+{
+	const TickType_t xPeriodTicks = pdMS_TO_TICKS(OVERLOAD_PERIOD_MS);
+	TickType_t xLastWakeTicks = xTaskGetTickCount();
+	OverloadAction_t *pxAction;
+	uint16_t usPressure;
+	uint32_t ulAbove = 0;
+	uint32_t ulBelow = 0;
+	uint32_t ulSinceRestore = 0;
+	BaseType_t xRestoreOnTrial = pdFALSE;
+
+	(void)pvParameters;
+
+	while (1)
+	{
+		vTaskDelayUntil(&xLastWakeTicks, xPeriodTicks);
+		usPressure = overload_pressure();
+
+		if (ulSinceRestore < UINT32_MAX)
+		{
+			ulSinceRestore++;
+		}
+
+		if (usPressure >= OVERLOAD_SHED_ABOVE)
+		{
+			ulAbove++;
+			ulBelow = 0;
+		}
+		else if (usPressure <= OVERLOAD_RESTORE_BELOW)
+		{
+			ulBelow++;
+			ulAbove = 0;
+		}
+		else
+		{
+			ulAbove = 0;
+			ulBelow = 0;
+		}
+
+		/* A restore that held for a whole hold was not the cause. */
+		if ((xRestoreOnTrial != pdFALSE) && (ulSinceRestore >= xStats.ulRestoreHold))
+		{
+			xRestoreOnTrial = pdFALSE;
+			xStats.ulRestoreHold = OVERLOAD_RESTORE_SAMPLES;
+		}
+
+		if ((ulAbove >= OVERLOAD_SHED_SAMPLES) && ((pxAction = overload_action(xStats.ulLevel)) != NULL))
+		{
+			ulAbove = 0;
+			pxAction->pxShed(pxAction->pvContext);
+			pxAction->ulSheds++;
+
+			taskENTER_CRITICAL();
+			xStats.ulLevel++;
+			xStats.ulSheds++;
+			taskEXIT_CRITICAL();
+
+			/* Shed again soon after a restore: wait longer next time. */
+			if (xRestoreOnTrial != pdFALSE)
+			{
+				xRestoreOnTrial = pdFALSE;
+
+				if (xStats.ulRestoreHold < (OVERLOAD_RESTORE_SAMPLES_MAX / 2U))
+				{
+					xStats.ulRestoreHold *= 2U;
+				}
+				else
+				{
+					xStats.ulRestoreHold = OVERLOAD_RESTORE_SAMPLES_MAX;
+				}
+			}
+		}
+		else if ((ulBelow >= xStats.ulRestoreHold) && (xStats.ulLevel > 0U))
+		{
+			ulBelow = 0;
+			pxAction = overload_action(xStats.ulLevel - 1U);
+			pxAction->pxRestore(pxAction->pvContext);
+			ulSinceRestore = 0;
+			xRestoreOnTrial = pdTRUE;
+
+			taskENTER_CRITICAL();
+			xStats.ulLevel--;
+			xStats.ulRestores++;
+			taskEXIT_CRITICAL();
+		}
+
+		taskENTER_CRITICAL();
+		xStats.usPressure = usPressure;
+
+		if (usPressure > xStats.usPeak)
+		{
+			xStats.usPeak = usPressure;
+		}
+
+		if (usPressure >= OVERLOAD_SHED_ABOVE)
+		{
+			xStats.ulOverloaded++;
+		}
+
+		taskEXIT_CRITICAL();
+	}
+}
+
+/**
+ * @brief Takes the pressure now.
+ * @param None
+ * @retval The CPU load of the last window or the fill of the fullest watched
+ * queue, whichever is higher, in 0.01 %.
+ */
+static uint16_t overload_pressure(void)
+{
+	CpuLoad_t xLoad;
+	UBaseType_t uxWaiting;
+	UBaseType_t uxSpaces;
+	uint32_t ulFill;
+	uint32_t ulPressure;
+	uint32_t i;
+
+	cpuload_get(&xLoad);
+	ulPressure = xLoad.usLoad100ms;
+
+	for (i = 0; i < ulQueueCount; i++)
+	{
+		uxWaiting = uxQueueMessagesWaiting(xQueues[i]);
+		uxSpaces = uxQueueSpacesAvailable(xQueues[i]);
+
+		if ((uxWaiting + uxSpaces) > 0U)
+		{
+			ulFill = ((uint32_t)uxWaiting * CPULOAD_FULL) / (uint32_t)(uxWaiting + uxSpaces);
+
+			if (ulFill > ulPressure)
+			{
+				ulPressure = ulFill;
+			}
+		}
+	}
+
+	return (uint16_t)ulPressure;
+}
+
+/**
+ * @brief Returns an action by its place in the shedding order.
+ * @param ulIndex Place, from 0.
+ * @retval The action, or NULL past the last one.
+ */
+static OverloadAction_t *overload_action(uint32_t ulIndex)
+{
+	OverloadAction_t *pxAction = pxActions;
+
+	while ((pxAction != NULL) && (ulIndex > 0U))
+	{
+		pxAction = pxAction->pxNext;
+		ulIndex--;
+	}
+
+	return pxAction;
+}
@@ -0,0 +1,355 @@
+/*******************************************************************************
+ *
+ * @file	phase.c
+ * @brief	Release phase planner: staggers the first releases of periodic
+ * 			tasks so that they do not all wake on the same tick.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	Tasks that start together and wait for equal periods, or for
+ * 			multiples of one another, are released on the same ticks for
+ * 			good. Those ticks then carry every wakeup at once: a longer tick
+ * 			interrupt, more ready list work, and the last task released
+ * 			starts the latest. Moving each task's first release by a few
+ * 			ticks spreads the releases over the hyperperiod, the least common
+ * 			multiple of the periods, without changing any period.
+ *
+ * 			Each task, or coroutine, is registered with its period and the
+ * 			cost of a release, then phase_plan() gives it an offset from
+ * 			phase_base(), before the scheduler starts. The task waits for
+ * 			its first release with phase_delay_first() and keeps the phase
+ * 			with vTaskDelayUntil():
+ *
+ * 				phase_delay_first(&xPhase, &xLastWake);
+ *
+ * 				while (1)
+ * 				{
+ * 					... one release of work ...
+ * 					vTaskDelayUntil(&xLastWake, xPhase.xPeriod);
+ * 				}
+ *
+ * 			The tasks are placed one after another, the shortest period
+ * 			first, the costliest first among equal periods. Two tasks are
+ * 			released on a common tick exactly when their offsets are equal
+ * 			modulo the greatest common divisor of their periods. Each task
+ * 			takes the offset of least cost released on common ticks with the
+ * 			tasks already placed, and of those the one furthest from their
+ * 			releases. The offsets tried are those up to the least common
+ * 			multiple of these divisors, a divisor of the period, so the plan
+ * 			takes up to a period times the number of tasks squared steps.
+ *
+ * 			phase_analyse() counts the releases on each tick of the
+ * 			hyperperiod, with the planned offsets and with every offset 0,
+ * 			and phase_print() shows the result.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "phase.h"
+
+/* Variables -----------------------------------------------------------------*/
+static PhaseTask_t *pxTasks = NULL;		/* Shortest period first. */
+static TickType_t xBase;				/* Tick count when phase_plan() ran. */
+
+/* Private function prototypes -----------------------------------------------*/
+static TickType_t phase_gcd(TickType_t xA, TickType_t xB);
+static uint32_t phase_hyperperiod(void);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Adds a periodic task to the next plan.
+ * @param pxTask Storage of the task's phase. Must stay valid for good.
+ * @param pcName Name, for phase_print().
+ * @param xPeriod Ticks between two releases.
+ * @param ulCost Work of a release, in any unit common to all the tasks
+ * (e.g. us), 1 if all cost the same.
+ * @retval None
+ * @note Before phase_plan(), from one task or before the scheduler starts.
+ */
+void phase_register(PhaseTask_t *pxTask, const char *pcName, TickType_t xPeriod, uint32_t ulCost)
+{
+	PhaseTask_t **ppxLink = &pxTasks;
+
+	configASSERT(xPeriod > 0U);
+
+	pxTask->pcName = pcName;
+	pxTask->xPeriod = xPeriod;
+	pxTask->ulCost = (ulCost > 0U) ? ulCost : 1U;
+	pxTask->xOffset = 0U;
+
+	/* The order tasks are placed in. */
+	while ((*ppxLink != NULL) && (((*ppxLink)->xPeriod < xPeriod)
+			|| (((*ppxLink)->xPeriod == xPeriod) && ((*ppxLink)->ulCost >= pxTask->ulCost))))
+	{
+		ppxLink = &(*ppxLink)->pxNext;
+	}
+
+	pxTask->pxNext = *ppxLink;
+	*ppxLink = pxTask;
+}
+
+/**
+ * @brief Gives every registered task the offset of its first release.
+ * @param None
+ * @retval None
+ * @note Before the tasks wait for their first release, typically before
+ * vTaskStartScheduler(). The offsets count from the tick count now
+ * (phase_base()).
+ */
+void phase_plan(void)
+{
+	PhaseTask_t *pxTask;
+	const PhaseTask_t *pxPlaced;
+	TickType_t xSpan;
+	TickType_t xGcd;
+	TickType_t xCandidate;
+	TickType_t xApart;
+	TickType_t xDistance;
+	TickType_t xBestDistance;
+	uint32_t ulCost;
+	uint32_t ulBestCost;
+
+	xBase = xTaskGetTickCount();
+
+	for (pxTask = pxTasks; pxTask != NULL; pxTask = pxTask->pxNext)
+	{
+		/* Collisions with a placed task depend on the offset modulo the gcd
+		 * of the two periods. */
+		xSpan = 1U;
+
+		for (pxPlaced = pxTasks; pxPlaced != pxTask; pxPlaced = pxPlaced->pxNext)
+		{
+			xGcd = phase_gcd(pxTask->xPeriod, pxPlaced->xPeriod);
+			xSpan = (xSpan / phase_gcd(xSpan, xGcd)) * xGcd;
+		}
+
+		ulBestCost = UINT32_MAX;
+		xBestDistance = 0U;
+
+		for (xCandidate = 0U; xCandidate < xSpan; xCandidate++)
+		{
+			ulCost = 0U;
+			xDistance = pxTask->xPeriod;
+
+			for (pxPlaced = pxTasks; pxPlaced != pxTask; pxPlaced = pxPlaced->pxNext)
+			{
+				xGcd = phase_gcd(pxTask->xPeriod, pxPlaced->xPeriod);
+				xApart = (xCandidate + xGcd - (pxPlaced->xOffset % xGcd)) % xGcd;
+
+				if (xApart == 0U)
+				{
+					ulCost += pxPlaced->ulCost;
+				}
+				else
+				{
+					/* The closest the two ever come, either way round. */
+					if (xApart > (xGcd - xApart))
+					{
+						xApart = xGcd - xApart;
+					}
+
+					if (xApart < xDistance)
+					{
+						xDistance = xApart;
+					}
+				}
+			}
+
+			if ((ulCost < ulBestCost) || ((ulCost == ulBestCost) && (xDistance > xBestDistance)))
+			{
+				ulBestCost = ulCost;
+				xBestDistance = xDistance;
+				pxTask->xOffset = xCandidate;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Returns the tick the offsets count from.
+ * @param None
+ * @retval The tick count when phase_plan() ran.
+ */
+TickType_t phase_base(void)
+{
+	return xBase;
+}
+
+/**
+ * @brief Returns the offset of a task's first release.
+ * @param pxTask Registered task.
+ * @retval Ticks from phase_base(), less than its period.
+ */
+TickType_t phase_offset(const PhaseTask_t *pxTask)
+{
+	return pxTask->xOffset;
+}
+
+/**
+ * @brief Blocks until a task's first release.
+ * @param pxTask Registered task, planned.
+ * @param pxLastWake Receives the tick of the release, for the
+ * vTaskDelayUntil() calls that follow.
+ * @retval None
+ * @note Called by the task itself. A task that starts after its first
+ * release returns at once; its next releases are still in phase.
+ */
+void phase_delay_first(const PhaseTask_t *pxTask, TickType_t *pxLastWake)
+{
+	*pxLastWake = xBase;
+
+	if (pxTask->xOffset > 0U)
+	{
+		vTaskDelayUntil(pxLastWake, pxTask->xOffset);
+	}
+}
+
+/**
+ * @brief Counts the releases on each tick of the hyperperiod.
+ * @param pxLoad Receives the counts.
+ * @retval None
+ * @note Takes the length of the hyperperiod times the number of tasks
+ * steps.
+ */
+void phase_analyse(PhaseLoad_t *pxLoad)
+{
+	const PhaseTask_t *pxTask;
+	uint32_t ulTick;
+	uint32_t ulPosition;
+	uint32_t ulReleases;
+	uint32_t ulCost;
+	uint32_t ulAlignedReleases;
+	uint32_t ulAlignedCost;
+
+	memset(pxLoad, 0, sizeof(*pxLoad));
+	pxLoad->ulTicks = phase_hyperperiod();
+
+	for (ulTick = 0U; ulTick < pxLoad->ulTicks; ulTick++)
+	{
+		ulReleases = 0U;
+		ulCost = 0U;
+		ulAlignedReleases = 0U;
+		ulAlignedCost = 0U;
+
+		for (pxTask = pxTasks; pxTask != NULL; pxTask = pxTask->pxNext)
+		{
+			ulPosition = ulTick % pxTask->xPeriod;
+
+			if (ulPosition == pxTask->xOffset)
+			{
+				ulReleases++;
+				ulCost += pxTask->ulCost;
+			}
+
+			if (ulPosition == 0U)
+			{
+				ulAlignedReleases++;
+				ulAlignedCost += pxTask->ulCost;
+			}
+		}
+
+		pxLoad->ulTicksWith[(ulReleases < PHASE_MAX_RELEASES) ? ulReleases : PHASE_MAX_RELEASES]++;
+
+		if (ulReleases > pxLoad->ulPeakReleases)
+		{
+			pxLoad->ulPeakReleases = ulReleases;
+		}
+
+		if (ulCost > pxLoad->ulPeakCost)
+		{
+			pxLoad->ulPeakCost = ulCost;
+		}
+
+		if (ulAlignedReleases > pxLoad->ulAlignedReleases)
+		{
+			pxLoad->ulAlignedReleases = ulAlignedReleases;
+		}
+
+		if (ulAlignedCost > pxLoad->ulAlignedCost)
+		{
+			pxLoad->ulAlignedCost = ulAlignedCost;
+		}
+	}
+}
+
+/**
+ * @brief Prints the offsets and the releases per tick with printf().
+ * @param None
+ * @retval None
+ */
+void phase_print(void)
+{
+	static PhaseLoad_t xLoad;		/* Too large for most task stacks. */
+	const PhaseTask_t *pxTask;
+	uint32_t ulReleases;
+
+	phase_analyse(&xLoad);
+
+	printf("Phases: hyperperiod %lu ticks analysed\r\n", xLoad.ulTicks);
+	printf("  %-*s %8s %8s %8s\r\n", configMAX_TASK_NAME_LEN, "Task", "Period", "Offset", "Cost");
+
+	for (pxTask = pxTasks; pxTask != NULL; pxTask = pxTask->pxNext)
+	{
+		printf("  %-*.*s %8lu %8lu %8lu\r\n", configMAX_TASK_NAME_LEN, configMAX_TASK_NAME_LEN,
+				pxTask->pcName, (uint32_t)pxTask->xPeriod, (uint32_t)pxTask->xOffset,
+				pxTask->ulCost);
+	}
+
+	printf("  Peak per tick: %lu releases, cost %lu (%lu, cost %lu all in phase)\r\n",
+			xLoad.ulPeakReleases, xLoad.ulPeakCost, xLoad.ulAlignedReleases,
+			xLoad.ulAlignedCost);
+	printf("  Releases     Ticks\r\n");
+
+	for (ulReleases = 0U; ulReleases <= PHASE_MAX_RELEASES; ulReleases++)
+	{
+		if (xLoad.ulTicksWith[ulReleases] != 0U)
+		{
+			printf("  %8lu%s %8lu\r\n", ulReleases,
+					(ulReleases == PHASE_MAX_RELEASES) ? "+" : " ", xLoad.ulTicksWith[ulReleases]);
+		}
+	}
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Returns the greatest common divisor of two periods.
+ * @param xA First period, not 0.
+ * @param xB Second period, not 0.
+ * @retval The greatest common divisor.
+ */
+static TickType_t phase_gcd(TickType_t xA, TickType_t xB)
+{
+	TickType_t xRemainder;
+
+	while (xB != 0U)
+	{
+		xRemainder = xA % xB;
+		xA = xB;
+		xB = xRemainder;
+	}
+
+	return xA;
+}
+
+/**
+ * @brief Returns the number of ticks to analyse.
+ * @param None
+ * @retval The least common multiple of the periods, at most
+ * PHASE_MAX_ANALYSIS_TICKS.
+ */
+static uint32_t phase_hyperperiod(void)
+{
+	const PhaseTask_t *pxTask;
+	uint64_t ullTicks = 1U;
+
+	for (pxTask = pxTasks; (pxTask != NULL) && (ullTicks <= PHASE_MAX_ANALYSIS_TICKS); pxTask = pxTask->pxNext)
+	{
+		ullTicks = (ullTicks / phase_gcd((TickType_t)ullTicks, pxTask->xPeriod)) * pxTask->xPeriod;
+	}
+
+	return (ullTicks > PHASE_MAX_ANALYSIS_TICKS) ? PHASE_MAX_ANALYSIS_TICKS : (uint32_t)ullTicks;
+}
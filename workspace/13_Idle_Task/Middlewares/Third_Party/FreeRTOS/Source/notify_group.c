@@ -0,0 +1,200 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "notify_group.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+to include notification group functionality. */
+#if( configUSE_NOTIFY_GROUPS == 1 )
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to use notification groups
+#endif
+
+/*
+ * The position of xTask among the members of xGroup, or uxMembers if it is
+ * not one.  Called in a critical section.
+ */
+static UBaseType_t prvFindMember( NotifyGroupHandle_t xGroup, TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+NotifyGroupHandle_t xNotifyGroupCreateStatic( UBaseType_t uxIndex, TaskHandle_t *pxMembers, UBaseType_t uxMaxMembers, StaticNotifyGroup_t *pxNotifyGroupBuffer )
+{
+	configASSERT( pxNotifyGroupBuffer );
+	configASSERT( pxMembers );
+	configASSERT( uxMaxMembers > ( UBaseType_t ) 0 );
+	configASSERT( uxIndex < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+	pxNotifyGroupBuffer->pxMembers = pxMembers;
+	pxNotifyGroupBuffer->uxMaxMembers = uxMaxMembers;
+	pxNotifyGroupBuffer->uxMembers = ( UBaseType_t ) 0;
+	pxNotifyGroupBuffer->uxIndex = uxIndex;
+
+	return pxNotifyGroupBuffer;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xNotifyGroupSubscribe( NotifyGroupHandle_t xGroup, TaskHandle_t xTask )
+{
+BaseType_t xReturn = pdPASS;
+
+	configASSERT( xGroup );
+
+	if( xTask == NULL )
+	{
+		xTask = xTaskGetCurrentTaskHandle();
+	}
+
+	taskENTER_CRITICAL();
+	{
+		if( prvFindMember( xGroup, xTask ) < xGroup->uxMembers )
+		{
+			/* Already a member: it is still notified once. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+		else if( xGroup->uxMembers < xGroup->uxMaxMembers )
+		{
+			xGroup->pxMembers[ xGroup->uxMembers ] = xTask;
+			( xGroup->uxMembers )++;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xNotifyGroupUnsubscribe( NotifyGroupHandle_t xGroup, TaskHandle_t xTask )
+{
+UBaseType_t uxMember;
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( xGroup );
+
+	if( xTask == NULL )
+	{
+		xTask = xTaskGetCurrentTaskHandle();
+	}
+
+	taskENTER_CRITICAL();
+	{
+		uxMember = prvFindMember( xGroup, xTask );
+
+		if( uxMember < xGroup->uxMembers )
+		{
+			/* The order of the members does not matter: the last one takes
+			the freed place. */
+			( xGroup->uxMembers )--;
+			xGroup->pxMembers[ uxMember ] = xGroup->pxMembers[ xGroup->uxMembers ];
+			xReturn = pdPASS;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskNotifyGroup( NotifyGroupHandle_t xGroup, uint32_t ulValue, eNotifyAction eAction )
+{
+BaseType_t xReturn;
+
+	configASSERT( xGroup );
+
+	/* Critical sections nest: the members cannot change between the read of
+	their count and the last notification. */
+	taskENTER_CRITICAL();
+	{
+		xReturn = xTaskGenericNotifyGroup( xGroup->pxMembers, xGroup->uxMembers, xGroup->uxIndex, ulValue, eAction );
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskNotifyGroupFromISR( NotifyGroupHandle_t xGroup, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken )
+{
+BaseType_t xReturn;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( xGroup );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		xReturn = xTaskGenericNotifyGroupFromISR( xGroup->pxMembers, xGroup->uxMembers, xGroup->uxIndex, ulValue, eAction, pxHigherPriorityTaskWoken );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxNotifyGroupGetMemberCount( NotifyGroupHandle_t xGroup )
+{
+	configASSERT( xGroup );
+
+	return xGroup->uxMembers;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindMember( NotifyGroupHandle_t xGroup, TaskHandle_t xTask )
+{
+UBaseType_t uxMember;
+
+	for( uxMember = 0; uxMember < xGroup->uxMembers; uxMember++ )
+	{
+		if( xGroup->pxMembers[ uxMember ] == xTask )
+		{
+			break;
+		}
+	}
+
+	return uxMember;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_NOTIFY_GROUPS == 1 */
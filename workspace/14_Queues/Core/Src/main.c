@@ -5,6 +5,15 @@
  * @author	Kyungjae Lee
  * @date	Jun 14, 2025
  * @note	'queue.h' must be included to use queues.
+ *
+ * 			The queue and the tasks are defined with 'static_alloc.h', so
+ * 			their memory is fixed at link time and the project builds
+ * 			without a kernel heap (configSUPPORT_DYNAMIC_ALLOCATION 0).
+ *
+ * 			staticDEFINE_QUEUE() registers the queue under its handle name,
+ * 			and QueueMetricsTask prints its counters (configUSE_QUEUE_METRICS)
+ * 			every QUEUE_METRICS_MS: the full drops of the sender show how
+ * 			often it outruns the receiver.
  * @todo	Look into the timing between the send and receive functions and
  * 			understand how they interact. Also, investigate why using the
  * 			'__io_putchar()' function as is (i.e., to use printf()) causes the
@@ -15,8 +24,13 @@
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
 #include "queue.h"
+#include "static_alloc.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define QUEUE_METRICS_MS	5000U	/* Queue counters print period. */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
@@ -26,15 +40,17 @@ int Uart2_Putchar(int ch);
 int __io_putchar(int ch);
 void SendToQueueTask(void *pvParameters);
 void ReceiveFromQueueTask(void *pvParameters);
+void QueueMetricsTask(void *pvParameters);
 
 /* Data types ----------------------------------------------------------------*/
 typedef uint32_t TaskProfiler;
 
 /* Variables -----------------------------------------------------------------*/
 UART_HandleTypeDef huart2;
-TaskHandle_t xSendToQueueTaskHandle;
-TaskHandle_t xReceiveFromQueueTaskHandle;
-QueueHandle_t xYearQueue;
+staticDEFINE_QUEUE(xYearQueue, 5, sizeof(int32_t));
+staticDEFINE_TASK(xSendToQueueTaskHandle, SendToQueueTask, "SendToQueueTask", 100, NULL, 1);
+staticDEFINE_TASK(xReceiveFromQueueTaskHandle, ReceiveFromQueueTask, "ReceiveFromQueueTask", 100, NULL, 1);
+staticDEFINE_TASK(xQueueMetricsTaskHandle, QueueMetricsTask, "QueueMetricsTask", 256, NULL, 2);
 TaskProfiler xSendToQueueTaskProfiler;
 TaskProfiler xReceiveFromQueueTaskProfiler;
 
@@ -53,32 +69,13 @@ int main(void)
 	MX_GPIO_Init();
 	MX_USART2_UART_Init();
 
-	/* Create queue */
-	xYearQueue = xQueueCreate(5, sizeof(int32_t));
-	if (NULL == xYearQueue)
-	{
-		printf("Error: Queue could not be created.\r\n");
-		while (1)
-		{
-			/* Hang here to prevent using a null queue. */
-		}
-	}
+	/* Create queue. Its storage is static, so this cannot fail. */
+	staticCREATE(xYearQueue);
 
 	/* Create tasks */
-	xTaskCreate(SendToQueueTask,
-				"SendToQueueTask",
-				100,
-				NULL,
-				1,
-				&xSendToQueueTaskHandle);
-
-	xTaskCreate(ReceiveFromQueueTask,
-				"ReceiveFromQueueTask",
-				100,
-				NULL,
-				1,
-				&xReceiveFromQueueTaskHandle);
-
+	staticCREATE(xSendToQueueTaskHandle);
+	staticCREATE(xReceiveFromQueueTaskHandle);
+	staticCREATE(xQueueMetricsTaskHandle);
 
 	vTaskStartScheduler();
 
@@ -152,6 +149,40 @@ void ReceiveFromQueueTask(void *pvParameters)
 	}
 }
 
+/**
+ * @brief Prints the counters of each queue in the queue registry every
+ * QUEUE_METRICS_MS.
+ * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
+ * task function signature.
+ * @return None.
+ * @note Blocks and timeouts are shown as send/receive.
+ */
+void QueueMetricsTask(void *pvParameters)
+{
+	static QueueRegistryMetrics_t xMetrics[configQUEUE_REGISTRY_SIZE];	/* Off the task stack. */
+	TickType_t xLastWakeTicks = xTaskGetTickCount();
+	UBaseType_t uxCount;
+	UBaseType_t ux;
+
+	while (1)
+	{
+		vTaskDelayUntil(&xLastWakeTicks, pdMS_TO_TICKS(QUEUE_METRICS_MS));
+		uxCount = uxQueueGetRegistryMetrics(xMetrics, configQUEUE_REGISTRY_SIZE);
+
+		for (ux = 0; ux < uxCount; ux++)
+		{
+			printf("%s: sent %lu, received %lu, peak %lu/%lu, full drops %lu\r\n",
+					xMetrics[ux].pcQueueName, xMetrics[ux].xMetrics.ulSends,
+					xMetrics[ux].xMetrics.ulReceives, xMetrics[ux].xMetrics.ulHighWaterMark,
+					(uint32_t)xMetrics[ux].uxLength, xMetrics[ux].xMetrics.ulFullDrops);
+			printf("%s: blocked %lu/%lu, timeouts %lu/%lu, ticks blocked %lu\r\n",
+					xMetrics[ux].pcQueueName, xMetrics[ux].xMetrics.ulSendsBlocked,
+					xMetrics[ux].xMetrics.ulReceivesBlocked, xMetrics[ux].xMetrics.ulSendTimeouts,
+					xMetrics[ux].xMetrics.ulReceiveTimeouts, xMetrics[ux].xMetrics.ulTicksBlocked);
+		}
+	}
+}
+
 int Uart2_Putchar(int ch)
 {
 	while (!(USART2->SR & 0x0080))
@@ -187,44 +218,9 @@ int __io_putchar(int ch)
  */
 void SystemClock_Config(void)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
-
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-	{
-		Error_Handler();
-	}
-
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
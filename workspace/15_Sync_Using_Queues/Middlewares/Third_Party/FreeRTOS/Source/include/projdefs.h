@@ -61,6 +61,8 @@ definition here is not suitable for your application. */
 
 #if( configUSE_16_BIT_TICKS == 1 )
 	#define pdINTEGRITY_CHECK_VALUE 0x5a5a
+#elif( configUSE_64_BIT_TICKS == 1 )
+	#define pdINTEGRITY_CHECK_VALUE 0x5a5a5a5a5a5a5a5aULL
 #else
 	#define pdINTEGRITY_CHECK_VALUE 0x5a5a5a5aUL
 #endif
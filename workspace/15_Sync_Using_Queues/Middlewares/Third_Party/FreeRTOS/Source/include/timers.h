@@ -87,6 +87,18 @@ typedef void (*TimerCallbackFunction_t)( TimerHandle_t xTimer );
  */
 typedef void (*PendedFunction_t)( void *, uint32_t );
 
+/*
+ * The statistics of a timer service task, see vTimerGetDaemonStats().  Times
+ * are in the unit of portGET_RUN_TIME_COUNTER_VALUE() when
+ * configGENERATE_RUN_TIME_STATS is 1, otherwise in ticks.
+ */
+typedef struct xTIMER_DAEMON_STATS
+{
+	uint32_t ulCallbacks;							/* Timer callbacks and pended functions run. */
+	configRUN_TIME_COUNTER_TYPE xTotalCallbackTime;
+	configRUN_TIME_COUNTER_TYPE xMaxCallbackTime;	/* The longest single callback. */
+} TimerDaemonStats_t;
+
 /**
  * TimerHandle_t xTimerCreate( 	const char * const pcTimerName,
  * 								TickType_t xTimerPeriodInTicks,
@@ -1262,6 +1274,40 @@ void vTimerSetReloadMode( TimerHandle_t xTimer, const UBaseType_t uxAutoReload )
 */
 UBaseType_t uxTimerGetReloadMode( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+ * void vTimerSetSlack( TimerHandle_t xTimer, const TickType_t xSlack );
+ *
+ * Allows the callback of a timer to run up to xSlack ticks after the timer
+ * expires.  The timer service task then sleeps until the earliest expiry time
+ * plus slack among its timers, instead of waking for each expiry, and runs
+ * every timer that has expired by then in one go.  Fewer wakeups also mean
+ * longer idle periods when configUSE_TICKLESS_IDLE is used.
+ *
+ * Auto-reload timers keep their period: the next expiry time is still counted
+ * from the one before, not from when the callback ran.  Timers are created
+ * with no slack.  configUSE_TIMER_SLACK must be set to 1 for this function to
+ * be available.
+ *
+ * A new slack is taken into account the next time the timer service task
+ * blocks, so set it before starting the timer.
+ *
+ * @param xTimer The handle of the timer being updated.
+ *
+ * @param xSlack The delay the callback can tolerate, in ticks.
+ */
+void vTimerSetSlack( TimerHandle_t xTimer, const TickType_t xSlack ) PRIVILEGED_FUNCTION;
+
+/**
+ * TickType_t xTimerGetSlack( TimerHandle_t xTimer );
+ *
+ * Queries the slack of a timer, see vTimerSetSlack().
+ *
+ * @param xTimer The handle of the timer being queried.
+ *
+ * @return The slack of the timer in ticks.
+ */
+TickType_t xTimerGetSlack( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
 /**
  * TickType_t xTimerGetPeriod( TimerHandle_t xTimer );
  *
@@ -1288,6 +1334,61 @@ TickType_t xTimerGetPeriod( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 */
 TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+ * void vTimerSetDaemon( TimerHandle_t xTimer, UBaseType_t uxDaemon );
+ *
+ * Selects the timer service task that runs the timer, so that the callbacks of
+ * timers that must not be delayed can run on a daemon of higher priority than
+ * the others.  configTIMER_DAEMONS sets the number of daemons and
+ * configTIMER_DAEMON_PRIORITIES their priorities.  Timers are created on
+ * daemon 0.
+ *
+ * The timer must be dormant: call vTimerSetDaemon() after creating the timer,
+ * or after a call to xTimerStop() has been processed, and before starting it.
+ *
+ * @param xTimer The handle of the timer being updated.
+ *
+ * @param uxDaemon The daemon, less than configTIMER_DAEMONS.
+ */
+void vTimerSetDaemon( TimerHandle_t xTimer, UBaseType_t uxDaemon ) PRIVILEGED_FUNCTION;
+
+/**
+ * UBaseType_t uxTimerGetDaemon( TimerHandle_t xTimer );
+ *
+ * Queries the timer service task that runs a timer.
+ *
+ * @param xTimer The handle of the timer being queried.
+ *
+ * @return The daemon set by vTimerSetDaemon(), or 0.
+ */
+UBaseType_t uxTimerGetDaemon( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * TaskHandle_t xTimerGetDaemonTaskHandle( UBaseType_t uxDaemon );
+ *
+ * Simply returns the handle of timer service task uxDaemon.  It is not valid
+ * to call xTimerGetDaemonTaskHandle() before the scheduler has been started.
+ * xTimerGetTimerDaemonTaskHandle() is the same as
+ * xTimerGetDaemonTaskHandle( 0 ).
+ */
+TaskHandle_t xTimerGetDaemonTaskHandle( UBaseType_t uxDaemon ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTimerGetDaemonStats( UBaseType_t uxDaemon, TimerDaemonStats_t *pxStats );
+ *
+ * Reads the number of callbacks timer service task uxDaemon has run, timer
+ * callbacks and pended functions alike, with their total and longest
+ * execution time.  The callbacks are timed with
+ * portGET_RUN_TIME_COUNTER_VALUE() when configGENERATE_RUN_TIME_STATS is 1,
+ * otherwise with the tick count.  configUSE_TIMER_DAEMON_STATS must be set to
+ * 1 for this function to be available.
+ *
+ * @param uxDaemon The daemon, less than configTIMER_DAEMONS.
+ *
+ * @param pxStats Where the statistics are written.
+ */
+void vTimerGetDaemonStats( UBaseType_t uxDaemon, TimerDaemonStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
@@ -0,0 +1,329 @@
+/*******************************************************************************
+ *
+ * @file	wire.h
+ * @brief	Packed little-endian message layouts, generated from a schema, read
+ * 			in place.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	A struct copied raw into a queue or onto a link carries its
+ * 			padding, and its layout depends on the compiler and the target.
+ * 			Here a message is a byte string: a 3-byte header (type, version,
+ * 			length), then its fields, packed, least significant byte first.
+ * 			The schema is an X-macro list of fields, each with the version
+ * 			that added it:
+ *
+ * 				#define SENSOR_READING_FIELDS(X, M) \
+ * 					X(M, ucSensor,   u8,  1) \
+ * 					X(M, ucValue,    u8,  1) \
+ * 					X(M, usSequence, u16, 2)
+ * 				WIRE_MESSAGE(SensorReading, 1, 2, SENSOR_READING_FIELDS)
+ *
+ * 			WIRE_MESSAGE() generates, for message type 1 at version 2:
+ *
+ * 				SensorReading_MAX_SIZE		header and every field, 7 bytes
+ * 				SensorReading_MIN_SIZE		header and the version 1 fields
+ * 				SensorReading_init(buf)		header, fields zeroed
+ * 				SensorReading_check(buf, len)
+ * 				SensorReading_get_ucValue(buf)
+ * 				SensorReading_set_ucValue(buf, value)
+ * 				SensorReading_has_usSequence(buf)
+ *
+ * 			There is no decode step: once SensorReading_check() accepts a
+ * 			received buffer, the getters read the fields straight out of it.
+ * 			A message is built the same way, in the buffer that is sent, so
+ * 			it is marshalled once whatever carries it: a queue or keyed queue
+ * 			of SensorReading_MAX_SIZE items, a pubsub.h topic, or an
+ * 			rqueue.h proxy, which WIRE_STATIC_ASSERT() can check at compile
+ * 			time:
+ *
+ * 				WIRE_STATIC_ASSERT(SensorReading_MAX_SIZE <= RQUEUE_MAX_ITEM,
+ * 						"reading larger than a remote queue item");
+ *
+ * 			Versions only append fields. Fields of version 1 are required
+ * 			and come first; later ones are optional. A receiver finds a
+ * 			field present when the length in the header covers it, so an
+ * 			older sender's message reads its newer fields as 0 (check with
+ * 			_has_), and a newer sender's extra fields are ignored.
+ *
+ * 			Field types are u8, i8, u16, i16, u32, i32 and f32. The getters
+ * 			and setters are byte loads and stores, which the compiler merges
+ * 			into single unaligned accesses on the Cortex-M4, so the fields
+ * 			need no alignment. Setters are for messages built by _init():
+ * 			a received message may be shorter than the layout.
+ *
+ ******************************************************************************/
+
+#ifndef WIRE_H
+#define WIRE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Macros --------------------------------------------------------------------*/
+#define WIRE_HEADER_SIZE 3U
+#define WIRE_OFFSET_TYPE 0U
+#define WIRE_OFFSET_VERSION 1U
+#define WIRE_OFFSET_LENGTH 2U				/* Header included. */
+#define WIRE_MAX_MESSAGE 255U
+
+#define WIRE_MAX(a, b) (((a) > (b)) ? (a) : (b))	/* To size a buffer for several messages. */
+
+#ifdef __cplusplus
+#define WIRE_STATIC_ASSERT(expr, msg) static_assert(expr, msg)
+#else
+#define WIRE_STATIC_ASSERT(expr, msg) _Static_assert(expr, msg)
+#endif
+
+/* Bytes and C type of each field type. */
+#define WIRE_SIZE_u8 1U
+#define WIRE_SIZE_i8 1U
+#define WIRE_SIZE_u16 2U
+#define WIRE_SIZE_i16 2U
+#define WIRE_SIZE_u32 4U
+#define WIRE_SIZE_i32 4U
+#define WIRE_SIZE_f32 4U
+
+#define WIRE_CTYPE_u8 uint8_t
+#define WIRE_CTYPE_i8 int8_t
+#define WIRE_CTYPE_u16 uint16_t
+#define WIRE_CTYPE_i16 int16_t
+#define WIRE_CTYPE_u32 uint32_t
+#define WIRE_CTYPE_i32 int32_t
+#define WIRE_CTYPE_f32 float
+
+/* Schema expansions, one per field: X(M, field, type, since). */
+#define WIRE_LAYOUT_(M, f, t, v) uint8_t f[WIRE_SIZE_##t];
+#define WIRE_REQUIRED_(M, f, t, v) + (((v) == 1U) ? WIRE_SIZE_##t : 0U)
+#define WIRE_FIELD_END_(M, f, t, v) (offsetof(M##_Layout_t, f) + WIRE_SIZE_##t)
+
+#define WIRE_ASSERT_(M, f, t, v) \
+	WIRE_STATIC_ASSERT(((v) >= 1U) && ((v) <= M##_VERSION), \
+			#M "." #f ": added after the message version"); \
+	WIRE_STATIC_ASSERT(((v) > 1U) || (WIRE_FIELD_END_(M, f, t, v) <= M##_MIN_SIZE), \
+			#M "." #f ": version 1 fields must come first");
+
+#define WIRE_ACCESSORS_(M, f, t, v) \
+static inline int32_t M##_has_##f(const void *pvMsg) \
+{ \
+	/* Required fields are there once the message is checked. */ \
+	return (((v) == 1U) || wire_covers(pvMsg, WIRE_FIELD_END_(M, f, t, v))) ? 1 : 0; \
+} \
+static inline WIRE_CTYPE_##t M##_get_##f(const void *pvMsg) \
+{ \
+	if (M##_has_##f(pvMsg) == 0) \
+	{ \
+		return (WIRE_CTYPE_##t)0; \
+	} \
+	return wire_load_##t(&((const uint8_t *)pvMsg)[offsetof(M##_Layout_t, f)]); \
+} \
+static inline void M##_set_##f(void *pvMsg, WIRE_CTYPE_##t xValue) \
+{ \
+	wire_store_##t(&((uint8_t *)pvMsg)[offsetof(M##_Layout_t, f)], xValue); \
+}
+
+/**
+ * @brief Generates the layout, sizes and accessors of a message.
+ * @param M Prefix of the generated names.
+ * @param TYPE Message type in the header, 1 to 255, unique per link or topic.
+ * @param VERSION Highest version of its fields.
+ * @param FIELDS Schema: FIELDS(X, M) expands to X(M, field, type, since) for
+ * each field, in wire order.
+ */
+#define WIRE_MESSAGE(M, TYPE, VERSION, FIELDS) \
+typedef struct \
+{ \
+	uint8_t ucHeader[WIRE_HEADER_SIZE]; \
+	FIELDS(WIRE_LAYOUT_, M) \
+} M##_Layout_t; \
+enum \
+{ \
+	M##_TYPE = (TYPE), \
+	M##_VERSION = (VERSION), \
+	M##_MAX_SIZE = sizeof(M##_Layout_t), \
+	M##_MIN_SIZE = WIRE_HEADER_SIZE FIELDS(WIRE_REQUIRED_, M) \
+}; \
+WIRE_STATIC_ASSERT(((TYPE) >= 1U) && ((TYPE) <= 255U) && ((VERSION) >= 1U) && ((VERSION) <= 255U), \
+		#M ": type and version are 1 to 255"); \
+WIRE_STATIC_ASSERT(sizeof(M##_Layout_t) <= WIRE_MAX_MESSAGE, #M ": longer than a message"); \
+FIELDS(WIRE_ASSERT_, M) \
+static inline void M##_init(void *pvMsg) \
+{ \
+	wire_init(pvMsg, (uint8_t)(TYPE), (uint8_t)(VERSION), (uint8_t)M##_MAX_SIZE); \
+} \
+static inline int32_t M##_check(const void *pvMsg, uint32_t ulLen) \
+{ \
+	return wire_check(pvMsg, ulLen, (uint8_t)(TYPE), M##_MIN_SIZE); \
+} \
+FIELDS(WIRE_ACCESSORS_, M)
+
+/* Function definitions ------------------------------------------------------*/
+
+static inline uint8_t wire_load_u8(const uint8_t *pucField)
+{
+	return pucField[0];
+}
+
+static inline uint16_t wire_load_u16(const uint8_t *pucField)
+{
+	return (uint16_t)((uint32_t)pucField[0] | ((uint32_t)pucField[1] << 8));
+}
+
+static inline uint32_t wire_load_u32(const uint8_t *pucField)
+{
+	return (uint32_t)pucField[0] | ((uint32_t)pucField[1] << 8) | ((uint32_t)pucField[2] << 16)
+			| ((uint32_t)pucField[3] << 24);
+}
+
+static inline int8_t wire_load_i8(const uint8_t *pucField)
+{
+	return (int8_t)wire_load_u8(pucField);
+}
+
+static inline int16_t wire_load_i16(const uint8_t *pucField)
+{
+	return (int16_t)wire_load_u16(pucField);
+}
+
+static inline int32_t wire_load_i32(const uint8_t *pucField)
+{
+	return (int32_t)wire_load_u32(pucField);
+}
+
+static inline float wire_load_f32(const uint8_t *pucField)
+{
+	uint32_t ulBits = wire_load_u32(pucField);
+	float fValue;
+
+	memcpy(&fValue, &ulBits, sizeof(fValue));
+
+	return fValue;
+}
+
+static inline void wire_store_u8(uint8_t *pucField, uint8_t ucValue)
+{
+	pucField[0] = ucValue;
+}
+
+static inline void wire_store_u16(uint8_t *pucField, uint16_t usValue)
+{
+	pucField[0] = (uint8_t)usValue;
+	pucField[1] = (uint8_t)(usValue >> 8);
+}
+
+static inline void wire_store_u32(uint8_t *pucField, uint32_t ulValue)
+{
+	pucField[0] = (uint8_t)ulValue;
+	pucField[1] = (uint8_t)(ulValue >> 8);
+	pucField[2] = (uint8_t)(ulValue >> 16);
+	pucField[3] = (uint8_t)(ulValue >> 24);
+}
+
+static inline void wire_store_i8(uint8_t *pucField, int8_t cValue)
+{
+	wire_store_u8(pucField, (uint8_t)cValue);
+}
+
+static inline void wire_store_i16(uint8_t *pucField, int16_t sValue)
+{
+	wire_store_u16(pucField, (uint16_t)sValue);
+}
+
+static inline void wire_store_i32(uint8_t *pucField, int32_t lValue)
+{
+	wire_store_u32(pucField, (uint32_t)lValue);
+}
+
+static inline void wire_store_f32(uint8_t *pucField, float fValue)
+{
+	uint32_t ulBits;
+
+	memcpy(&ulBits, &fValue, sizeof(ulBits));
+	wire_store_u32(pucField, ulBits);
+}
+
+/**
+ * @brief Returns the type of a message, to dispatch on before checking it.
+ * @param pvMsg Message, at least WIRE_HEADER_SIZE bytes.
+ * @retval Type in the header.
+ */
+static inline uint8_t wire_type(const void *pvMsg)
+{
+	return ((const uint8_t *)pvMsg)[WIRE_OFFSET_TYPE];
+}
+
+/**
+ * @brief Returns the schema version of the sender of a message.
+ * @param pvMsg Message, at least WIRE_HEADER_SIZE bytes.
+ * @retval Version in the header.
+ */
+static inline uint8_t wire_version(const void *pvMsg)
+{
+	return ((const uint8_t *)pvMsg)[WIRE_OFFSET_VERSION];
+}
+
+/**
+ * @brief Returns the length of a message.
+ * @param pvMsg Message, at least WIRE_HEADER_SIZE bytes.
+ * @retval Bytes in the message, header included: what to send.
+ */
+static inline uint32_t wire_length(const void *pvMsg)
+{
+	return ((const uint8_t *)pvMsg)[WIRE_OFFSET_LENGTH];
+}
+
+/**
+ * @brief Tells whether a message reaches a given end of field.
+ * @param pvMsg Checked message.
+ * @param ulEnd Offset just past the field.
+ * @retval Nonzero if the field was sent.
+ */
+static inline int32_t wire_covers(const void *pvMsg, uint32_t ulEnd)
+{
+	return (wire_length(pvMsg) >= ulEnd) ? 1 : 0;
+}
+
+/**
+ * @brief Writes the header of a message and zeroes its fields. Called by the
+ * generated _init().
+ * @param pvMsg Buffer of ucLength bytes.
+ * @param ucType Message type.
+ * @param ucVersion Schema version of the sender.
+ * @param ucLength Bytes in the message, header included.
+ * @retval None
+ */
+static inline void wire_init(void *pvMsg, uint8_t ucType, uint8_t ucVersion, uint8_t ucLength)
+{
+	uint8_t *pucMsg = (uint8_t *)pvMsg;
+
+	memset(&pucMsg[WIRE_HEADER_SIZE], 0, (size_t)ucLength - WIRE_HEADER_SIZE);
+	pucMsg[WIRE_OFFSET_TYPE] = ucType;
+	pucMsg[WIRE_OFFSET_VERSION] = ucVersion;
+	pucMsg[WIRE_OFFSET_LENGTH] = ucLength;
+}
+
+/**
+ * @brief Checks a received buffer before its fields are read in place.
+ * Called by the generated _check().
+ * @param pvMsg Received bytes.
+ * @param ulLen Bytes received.
+ * @param ucType Expected message type.
+ * @param ulMinSize Header and required fields.
+ * @retval 0 if the message is of that type, holds its required fields and
+ * fits the bytes received, -1 otherwise.
+ */
+static inline int32_t wire_check(const void *pvMsg, uint32_t ulLen, uint8_t ucType,
+		uint32_t ulMinSize)
+{
+	if ((pvMsg == NULL) || (ulLen < WIRE_HEADER_SIZE) || (wire_type(pvMsg) != ucType)
+			|| (wire_version(pvMsg) == 0U) || (wire_length(pvMsg) < ulMinSize)
+			|| (wire_length(pvMsg) > ulLen))
+	{
+		return -1;
+	}
+
+	return 0;
+}
+
+#endif /* WIRE_H */
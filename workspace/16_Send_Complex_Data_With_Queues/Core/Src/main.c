@@ -5,6 +5,23 @@
  * 			application.
  * @author	Kyungjae Lee
  * @date	Jun 21, 2025
+ * @note	With SENSOR_QUEUE_KEYED set to 1, the readings go through a
+ * 			keyed queue (keyed_queue.h, 'configUSE_KEYED_QUEUES') keyed by
+ * 			xSensor instead of a length-3 queue. A reading overwrites the
+ * 			pending one of its sensor, so the senders never block and the
+ * 			receiver always prints the newest value of each sensor.
+ *
+ * 			The sends and the prints are timed as perfhist.h regions, whose
+ * 			histograms a reporter task prints every PERF_REPORT_MS; the
+ * 			count of each print region is how often its sensor's data was
+ * 			received.
+ *
+ * 			With SENSOR_WIRE_FORMAT set to 1, the items are wire.h messages
+ * 			instead of raw DataType_t structs: 7 packed bytes with a
+ * 			header, in place of 8 with 3 of padding. Each sender builds its
+ * 			message once and only updates the sequence number (a version 2
+ * 			field) before each send; the receiver reads the fields in place
+ * 			from the received bytes.
  * @todo	This application contains a bug. Check for possible stack overflow,
  * 			data corruption, or race conditions.
  *
@@ -13,8 +30,23 @@
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
 #include "queue.h"
+#include "keyed_queue.h"
+#include "perfhist.h"
+#include "wire.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define SENSOR_QUEUE_KEYED	1	/* 0: queue of length 3, 1: keyed queue */
+#define SENSOR_WIRE_FORMAT	1	/* 0: raw DataType_t items, 1: wire.h messages */
+#define SENSOR_COUNT		2U
+
+/* perfhist.h regions. */
+#define PERF_SEND			0U	/* Queue send, both sensors. */
+#define PERF_HUMIDITY		1U	/* Print of a humidity reading. */
+#define PERF_PRESSURE		2U	/* Print of a pressure reading. */
+#define PERF_REPORT_MS		5000U
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
@@ -39,6 +71,19 @@ typedef struct
 	SensorType_t xSensor;
 } DataType_t;
 
+/** Wire format of a reading: X(M, field, type, version that added it). */
+#define SENSOR_READING_FIELDS(X, M) \
+	X(M, ucSensor,   u8,  1) \
+	X(M, ucValue,    u8,  1) \
+	X(M, usSequence, u16, 2)
+WIRE_MESSAGE(SensorReading, 1, 2, SENSOR_READING_FIELDS)
+
+#if (SENSOR_WIRE_FORMAT == 1)
+#define SENSOR_ITEM_SIZE	SensorReading_MAX_SIZE
+#else
+#define SENSOR_ITEM_SIZE	sizeof(DataType_t)
+#endif
+
 /* Variables -----------------------------------------------------------------*/
 UART_HandleTypeDef huart2;
 static const DataType_t xData[2] =
@@ -50,9 +95,13 @@ static const DataType_t xData[2] =
 TaskHandle_t xSendHumidityDataToQueueTaskHandle;
 TaskHandle_t xSendPressureDataToQueueTaskHandle;
 TaskHandle_t xReceiveDataFromQueueTaskHandle;
+#if (SENSOR_QUEUE_KEYED == 1)
+static uint8_t ucSensorDataStorage[keyedqueueSTORAGE_SIZE(SENSOR_COUNT, SENSOR_ITEM_SIZE)];
+static StaticKeyedQueue_t xSensorDataQueueBuffer;
+KeyedQueueHandle_t xSensorDataQueue;
+#else
 QueueHandle_t xSensorDataQueue;
-uint32_t ulSendHumidityDataToQueueTaskProfiler;
-uint32_t ulSendPressureDataToQueueTaskProfiler;
+#endif
 
 /**
  * @brief The application entry point.
@@ -69,8 +118,18 @@ int main(void)
 	MX_GPIO_Init();
 	MX_USART2_UART_Init();
 
+	perfhist_init();
+	perfhist_name(PERF_SEND, "send");
+	perfhist_name(PERF_HUMIDITY, "humidity");
+	perfhist_name(PERF_PRESSURE, "pressure");
+
 	/* Create queue */
-	xSensorDataQueue = xQueueCreate(3, sizeof(DataType_t));
+#if (SENSOR_QUEUE_KEYED == 1)
+	xSensorDataQueue = xKeyedQueueCreateStatic(SENSOR_COUNT, SENSOR_ITEM_SIZE,
+			ucSensorDataStorage, &xSensorDataQueueBuffer);
+#else
+	xSensorDataQueue = xQueueCreate(3, SENSOR_ITEM_SIZE);
+#endif
 	if (NULL == xSensorDataQueue)
 	{
 		printf("Error: Queue could not be created.\r\n");
@@ -102,6 +161,8 @@ int main(void)
 				2,
 				&xSendPressureDataToQueueTaskHandle);
 
+	(void)perfhist_start_reporter(PERF_REPORT_MS, 1);
+
 	/* Start scheduler. */
 	vTaskStartScheduler();
 
@@ -124,9 +185,43 @@ int main(void)
  * parameter, and periodically attempts to send it to a shared queue. If the
  * queue is full, the task waits for up to 200ms for space to become available.
  * The task then performs a non-blocking delay to simulate periodic behavior.
+ * With SENSOR_QUEUE_KEYED, the send never blocks: it replaces the pending
+ * reading of the same sensor, if there is one. With SENSOR_WIRE_FORMAT, the
+ * item is a message built once, whose sequence number is set before each
+ * send.
  */
 void SendDataToQueueTask(void *pvParameters)
 {
+	const DataType_t *pxData = (const DataType_t *)pvParameters;
+#if (SENSOR_WIRE_FORMAT == 1)
+	uint8_t ucMessage[SensorReading_MAX_SIZE];
+	uint16_t usSequence = 0U;
+	const void *pvItem = ucMessage;
+
+	SensorReading_init(ucMessage);
+	SensorReading_set_ucSensor(ucMessage, (uint8_t)pxData->xSensor);
+	SensorReading_set_ucValue(ucMessage, pxData->ucValue);
+#else
+	const void *pvItem = pxData;
+#endif
+
+#if (SENSOR_QUEUE_KEYED == 1)
+	while (1)
+	{
+#if (SENSOR_WIRE_FORMAT == 1)
+		SensorReading_set_usSequence(ucMessage, usSequence++);
+#endif
+		PERF_BEGIN(PERF_SEND);
+		(void)xKeyedQueueSend(xSensorDataQueue, (UBaseType_t)pxData->xSensor, pvItem);
+		PERF_END(PERF_SEND);
+
+		/* Introduce a non-blocking delay. */
+		for (volatile int i = 0; i < 500000; i++)
+		{
+			/* Do nothing. */
+		}
+	}
+#else
 	BaseType_t xQueueStatus;
 
 	/* Enter the Blocked state for 200ms for space to become available in the
@@ -135,7 +230,12 @@ void SendDataToQueueTask(void *pvParameters)
 
 	while (1)
 	{
-		xQueueStatus = xQueueSend(xSensorDataQueue, pvParameters, xWaitTicks);
+#if (SENSOR_WIRE_FORMAT == 1)
+		SensorReading_set_usSequence(ucMessage, usSequence++);
+#endif
+		PERF_BEGIN(PERF_SEND);
+		xQueueStatus = xQueueSend(xSensorDataQueue, pvItem, xWaitTicks);
+		PERF_END(PERF_SEND);
 		if (pdPASS != xQueueStatus)
 		{
 			/* Do nothing. */
@@ -147,6 +247,7 @@ void SendDataToQueueTask(void *pvParameters)
 			/* Do nothing. */
 		}
 	}
+#endif
 }
 
 /**
@@ -156,30 +257,60 @@ void SendDataToQueueTask(void *pvParameters)
  * @return None.
  * @note This task continuously attempts to receive 'DataType_t' items from the
  * shared queue. Upon successful reception, it checks the sensor type and prints
- * the corresponding value over UART. It also increments profiler counters for
- * each sensor type to track how often data is received.
+ * the corresponding value over UART. Each print is timed in its sensor's
+ * perfhist.h region, whose count tracks how often data is received. With
+ * SENSOR_WIRE_FORMAT, the fields are read in place from the received message
+ * once its header is checked.
  */
 void ReceiveDataFromQueueTask(void *pvParameters)
 {
+#if (SENSOR_WIRE_FORMAT == 1)
+	uint8_t ucReceivedData[SensorReading_MAX_SIZE];
+	void *pvReceivedData = ucReceivedData;
+#else
 	DataType_t xReceivedData;
+	void *pvReceivedData = &xReceivedData;
+#endif
+	SensorType_t xSensor;
+	uint8_t ucValue;
 	BaseType_t xQueueStatus;
 
 	while (1)
 	{
 		/* Until there's a data available in the queue, this function will block
 		 * indefinitely. */
-		xQueueStatus = xQueueReceive(xSensorDataQueue, &xReceivedData, portMAX_DELAY);
+#if (SENSOR_QUEUE_KEYED == 1)
+		xQueueStatus = xKeyedQueueReceive(xSensorDataQueue, NULL, pvReceivedData, portMAX_DELAY);
+#else
+		xQueueStatus = xQueueReceive(xSensorDataQueue, pvReceivedData, portMAX_DELAY);
+#endif
+#if (SENSOR_WIRE_FORMAT == 1)
+		if ((pdPASS == xQueueStatus) && (SensorReading_check(ucReceivedData, sizeof(ucReceivedData)) != 0))
+		{
+			/* Not a reading: drop it. */
+			xQueueStatus = pdFAIL;
+		}
+#endif
 		if (pdPASS == xQueueStatus)
 		{
-			if (HUMIDITY_SENSOR == xReceivedData.xSensor)
+#if (SENSOR_WIRE_FORMAT == 1)
+			xSensor = (SensorType_t)SensorReading_get_ucSensor(ucReceivedData);
+			ucValue = SensorReading_get_ucValue(ucReceivedData);
+#else
+			xSensor = xReceivedData.xSensor;
+			ucValue = xReceivedData.ucValue;
+#endif
+			if (HUMIDITY_SENSOR == xSensor)
 			{
-				printf("Humidity sensor value: %d\r\n", xReceivedData.ucValue);
-				ulSendHumidityDataToQueueTaskProfiler++;
+				PERF_BEGIN(PERF_HUMIDITY);
+				printf("Humidity sensor value: %d\r\n", ucValue);
+				PERF_END(PERF_HUMIDITY);
 			}
 			else
 			{
-				printf("Pressure sensor value: %d\r\n", xReceivedData.ucValue);
-				ulSendPressureDataToQueueTaskProfiler++;
+				PERF_BEGIN(PERF_PRESSURE);
+				printf("Pressure sensor value: %d\r\n", ucValue);
+				PERF_END(PERF_PRESSURE);
 			}
 		}
 		else
@@ -224,44 +355,9 @@ int __io_putchar(int ch)
  */
 void SystemClock_Config(void)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
-
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-	{
-		Error_Handler();
-	}
-
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
@@ -0,0 +1,383 @@
+/*******************************************************************************
+ *
+ * @file	perfhist.c
+ * @brief	Latency histograms of code regions, timed on the DWT cycle
+ * 			counter.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	PERF_BEGIN(id) reads CYCCNT into a local, PERF_END(id) hands the
+ * 			cycles since to perfhist_record(), which counts them in the
+ * 			region's histogram with its count, minimum, maximum and total.
+ * 			The cost of the two reads, measured by perfhist_init(), is taken
+ * 			off each sample.
+ *
+ * 			The histograms are log-linear, as HdrHistogram's: each power of
+ * 			two of cycles is split into 2^PERFHIST_SUB_BITS buckets, so the
+ * 			bucket width grows with the value and the relative error stays
+ * 			the same from tens of cycles to milliseconds, in a fixed array
+ * 			of 32-bit counts. Below 2^(PERFHIST_SUB_BITS + 1) cycles every
+ * 			value has its own bucket.
+ *
+ * 			perfhist_record() masks every interrupt (PRIMASK) for the few
+ * 			cycles of the update, so regions may be timed from tasks and
+ * 			from interrupts of any priority, those above
+ * 			configMAX_SYSCALL_INTERRUPT_PRIORITY included. A region
+ * 			interrupted is timed with the interrupt in it: the histogram
+ * 			shows latency, not cycles spent.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "perfhist.h"
+
+#if (PERFHIST_ENABLE == 1)
+
+/* Macros --------------------------------------------------------------------*/
+#define PERFHIST_SUB_BUCKETS	(1UL << PERFHIST_SUB_BITS)
+
+#if (PERFHIST_SUB_BITS < 1U) || (PERFHIST_RANGE_BITS > 31U) || (PERFHIST_RANGE_BITS <= PERFHIST_SUB_BITS)
+#error PERFHIST_SUB_BITS must be at least 1 and PERFHIST_RANGE_BITS above it, at most 31
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulCount;
+	uint32_t ulMin;
+	uint32_t ulMax;
+	uint64_t ullTotal;
+	uint32_t ulBuckets[PERFHIST_BUCKETS];
+} PerfhistRegion_t;
+
+/* Variables -----------------------------------------------------------------*/
+static PerfhistRegion_t xRegions[PERFHIST_REGIONS];
+static const char *pcNames[PERFHIST_REGIONS];
+static uint32_t ulOverhead = 0;
+
+/* Copy of a region, taken with interrupts masked, for the readers; one
+ * reader at a time. */
+static PerfhistRegion_t xSnapshot;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t perfhist_bucket(uint32_t ulCycles);
+static uint32_t perfhist_bucket_top(uint32_t ulBucket);
+static void perfhist_take_snapshot(uint32_t ulId);
+static uint32_t perfhist_rank(uint32_t ulPerMille);
+static void perfhist_reporter_task(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Starts the cycle counter, measures the cost of a PERF_BEGIN() /
+ * PERF_END() pair and clears the histograms.
+ * @param None
+ * @retval None
+ * @note Call before the first region is timed.
+ */
+void perfhist_init(void)
+{
+	volatile uint32_t ulBegin;
+
+	/* Enable the trace and debug blocks, DWT included. */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	ulBegin = DWT->CYCCNT;
+	ulOverhead = DWT->CYCCNT - ulBegin;
+
+	perfhist_reset();
+}
+
+/**
+ * @brief Names a region for perfhist_dump().
+ * @param ulId Region.
+ * @param pcName Name; kept, not copied.
+ * @retval None
+ */
+void perfhist_name(uint32_t ulId, const char *pcName)
+{
+	if (ulId < PERFHIST_REGIONS)
+	{
+		pcNames[ulId] = pcName;
+	}
+}
+
+/**
+ * @brief Counts a sample of a region (PERF_END()).
+ * @param ulId Region.
+ * @param ulCycles Cycles it took, the measurement's own included.
+ * @retval None
+ * @note Task or interrupt context, any priority.
+ */
+void perfhist_record(uint32_t ulId, uint32_t ulCycles)
+{
+	PerfhistRegion_t *pxRegion;
+	uint32_t ulPrimask;
+
+	if (ulId >= PERFHIST_REGIONS)
+	{
+		return;
+	}
+
+	pxRegion = &xRegions[ulId];
+	ulCycles = (ulCycles > ulOverhead) ? (ulCycles - ulOverhead) : 0U;
+
+	ulPrimask = __get_PRIMASK();
+	__disable_irq();
+
+	pxRegion->ulBuckets[perfhist_bucket(ulCycles)]++;
+	pxRegion->ullTotal += ulCycles;
+	pxRegion->ulMin = (ulCycles < pxRegion->ulMin) ? ulCycles : pxRegion->ulMin;
+	pxRegion->ulMax = (ulCycles > pxRegion->ulMax) ? ulCycles : pxRegion->ulMax;
+	pxRegion->ulCount++;
+
+	__set_PRIMASK(ulPrimask);
+}
+
+/**
+ * @brief Summarizes a region.
+ * @param ulId Region.
+ * @param pxStats Receives the summary, all 0 if nothing was counted.
+ * @retval 0 on success, -1 if ulId is out of range.
+ * @note Task context, one reader at a time.
+ */
+int32_t perfhist_get(uint32_t ulId, PerfhistStats_t *pxStats)
+{
+	if (ulId >= PERFHIST_REGIONS)
+	{
+		return -1;
+	}
+
+	perfhist_take_snapshot(ulId);
+	memset(pxStats, 0, sizeof(*pxStats));
+
+	if (xSnapshot.ulCount == 0U)
+	{
+		return 0;
+	}
+
+	pxStats->ulCount = xSnapshot.ulCount;
+	pxStats->ulMin = xSnapshot.ulMin;
+	pxStats->ulMax = xSnapshot.ulMax;
+	pxStats->ulMean = (uint32_t)(xSnapshot.ullTotal / xSnapshot.ulCount);
+	pxStats->ulP50 = perfhist_rank(500U);
+	pxStats->ulP90 = perfhist_rank(900U);
+	pxStats->ulP99 = perfhist_rank(990U);
+	pxStats->ulP999 = perfhist_rank(999U);
+
+	return 0;
+}
+
+/**
+ * @brief Reads one percentile of a region.
+ * @param ulId Region.
+ * @param ulPerMille Percentile in tenths of a percent, 0 to 1000.
+ * @retval Cycles, 0 if nothing was counted.
+ * @note Task context, one reader at a time.
+ */
+uint32_t perfhist_percentile(uint32_t ulId, uint32_t ulPerMille)
+{
+	if (ulId >= PERFHIST_REGIONS)
+	{
+		return 0U;
+	}
+
+	perfhist_take_snapshot(ulId);
+
+	return (xSnapshot.ulCount == 0U) ? 0U : perfhist_rank(ulPerMille);
+}
+
+/**
+ * @brief Clears every histogram. The names are kept.
+ * @param None
+ * @retval None
+ */
+void perfhist_reset(void)
+{
+	uint32_t ulPrimask;
+	uint32_t i;
+
+	for (i = 0; i < PERFHIST_REGIONS; i++)
+	{
+		ulPrimask = __get_PRIMASK();
+		__disable_irq();
+
+		memset(&xRegions[i], 0, sizeof(xRegions[i]));
+		xRegions[i].ulMin = UINT32_MAX;
+
+		__set_PRIMASK(ulPrimask);
+	}
+}
+
+/**
+ * @brief Prints the summary of every region counted with printf(), in cycles.
+ * @param None
+ * @retval None
+ * @note Task context.
+ */
+void perfhist_dump(void)
+{
+	PerfhistStats_t xStats;
+	uint32_t i;
+
+	printf("perfhist: begin hz=%lu overhead=%lu\r\n", (unsigned long)SystemCoreClock,
+			(unsigned long)ulOverhead);
+
+	for (i = 0; i < PERFHIST_REGIONS; i++)
+	{
+		(void)perfhist_get(i, &xStats);
+
+		if (xStats.ulCount == 0U)
+		{
+			continue;
+		}
+
+		if (pcNames[i] != NULL)
+		{
+			printf("perfhist: %s", pcNames[i]);
+		}
+		else
+		{
+			printf("perfhist: r%lu", (unsigned long)i);
+		}
+
+		printf(" n=%lu min=%lu mean=%lu p50=%lu p90=%lu p99=%lu p999=%lu max=%lu\r\n",
+				(unsigned long)xStats.ulCount, (unsigned long)xStats.ulMin,
+				(unsigned long)xStats.ulMean, (unsigned long)xStats.ulP50,
+				(unsigned long)xStats.ulP90, (unsigned long)xStats.ulP99,
+				(unsigned long)xStats.ulP999, (unsigned long)xStats.ulMax);
+	}
+
+	printf("perfhist: end\r\n");
+}
+
+/**
+ * @brief Creates a task that dumps and clears the histograms periodically.
+ * @param ulPeriodMs Period in milliseconds.
+ * @param ulPriority Task priority, low: printf() is slow.
+ * @retval 0 on success, -1 if the task could not be created.
+ */
+int32_t perfhist_start_reporter(uint32_t ulPeriodMs, uint32_t ulPriority)
+{
+	return (xTaskCreate(perfhist_reporter_task, "perfhist", PERFHIST_REPORTER_STACK_WORDS,
+			(void *)ulPeriodMs, (UBaseType_t)ulPriority, NULL) == pdPASS) ? 0 : -1;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Finds the bucket of a sample.
+ * @param ulCycles Sample.
+ * @retval Bucket index, 0 to PERFHIST_BUCKETS - 1.
+ * @note The power of two above the sub-buckets sets the shift; the bits under
+ * the leading one then pick the sub-bucket. Values under
+ * 2^(PERFHIST_SUB_BITS + 1) index themselves.
+ */
+static uint32_t perfhist_bucket(uint32_t ulCycles)
+{
+	uint32_t ulShift;
+
+	if (ulCycles >= (1UL << PERFHIST_RANGE_BITS))
+	{
+		return PERFHIST_BUCKETS - 1U;
+	}
+
+	ulShift = 31U - (uint32_t)__CLZ(ulCycles | PERFHIST_SUB_BUCKETS) - PERFHIST_SUB_BITS;
+
+	return (ulShift << PERFHIST_SUB_BITS) + (ulCycles >> ulShift);
+}
+
+/**
+ * @brief Finds the largest value a bucket holds.
+ * @param ulBucket Bucket index.
+ * @retval Cycles.
+ */
+static uint32_t perfhist_bucket_top(uint32_t ulBucket)
+{
+	uint32_t ulShift;
+	uint32_t ulMantissa;
+
+	if (ulBucket < (2U * PERFHIST_SUB_BUCKETS))
+	{
+		return ulBucket;
+	}
+
+	ulShift = (ulBucket >> PERFHIST_SUB_BITS) - 1U;
+	ulMantissa = ulBucket - (ulShift << PERFHIST_SUB_BITS);
+
+	return ((ulMantissa + 1U) << ulShift) - 1U;
+}
+
+/**
+ * @brief Copies a region into xSnapshot, with interrupts masked so that its
+ * counts agree with each other.
+ * @param ulId Region.
+ * @retval None
+ */
+static void perfhist_take_snapshot(uint32_t ulId)
+{
+	const uint32_t ulPrimask = __get_PRIMASK();
+
+	__disable_irq();
+	memcpy(&xSnapshot, &xRegions[ulId], sizeof(xSnapshot));
+	__set_PRIMASK(ulPrimask);
+}
+
+/**
+ * @brief Finds a percentile in xSnapshot.
+ * @param ulPerMille Percentile in tenths of a percent, 0 to 1000.
+ * @retval Top of the bucket the sample of that rank is in, kept within the
+ * minimum and the maximum.
+ * @note xSnapshot.ulCount must not be 0.
+ */
+static uint32_t perfhist_rank(uint32_t ulPerMille)
+{
+	/* Rank of the sample, from 1, rounded up. */
+	uint32_t ulRank = (uint32_t)((((uint64_t)xSnapshot.ulCount * ulPerMille) + 999U) / 1000U);
+	uint32_t ulSeen = 0;
+	uint32_t ulTop = xSnapshot.ulMax;
+	uint32_t i;
+
+	ulRank = (ulRank == 0U) ? 1U : ulRank;
+
+	for (i = 0; i < PERFHIST_BUCKETS; i++)
+	{
+		ulSeen += xSnapshot.ulBuckets[i];
+
+		if (ulSeen >= ulRank)
+		{
+			/* The last bucket also holds everything above the range. */
+			ulTop = (i < (PERFHIST_BUCKETS - 1U)) ? perfhist_bucket_top(i) : xSnapshot.ulMax;
+			break;
+		}
+	}
+
+	ulTop = (ulTop > xSnapshot.ulMax) ? xSnapshot.ulMax : ulTop;
+
+	return (ulTop < xSnapshot.ulMin) ? xSnapshot.ulMin : ulTop;
+}
+
+/**
+ * @brief Dumps and clears the histograms every period.
+ * @param pvParameters Period in milliseconds.
+ * @retval None
+ */
+static void perfhist_reporter_task(void *pvParameters)
+{
+	const TickType_t xPeriodTicks = pdMS_TO_TICKS((uint32_t)pvParameters);
+	TickType_t xLastWakeTicks = xTaskGetTickCount();
+
+	while (1)
+	{
+		vTaskDelayUntil(&xLastWakeTicks, xPeriodTicks);
+		perfhist_dump();
+		perfhist_reset();
+	}
+}
+
+#endif /* (PERFHIST_ENABLE == 1) */
@@ -84,12 +84,17 @@ typedef struct EventGroupDef_t * EventGroupHandle_t;
 /*
  * The type that holds event bits always matches TickType_t - therefore the
  * number of bits it holds is set by configUSE_16_BIT_TICKS (16 bits if set to 1,
- * 32 bits if set to 0.
+ * 32 bits if set to 0.  With configUSE_64_BIT_TICKS it stays 32 bits, as the
+ * control bits are in the top byte of 32.
  *
  * \defgroup EventBits_t EventBits_t
  * \ingroup EventGroup
  */
-typedef TickType_t EventBits_t;
+#if( configUSE_64_BIT_TICKS == 1 )
+	typedef uint32_t EventBits_t;
+#else
+	typedef TickType_t EventBits_t;
+#endif
 
 /**
  * event_groups.h
@@ -401,10 +406,14 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup, const EventBit
 		}
   }
    </pre>
+ * If configUSE_EVENT_GROUPS_DIRECT_FROM_ISR is set to 1 in FreeRTOSConfig.h
+ * the bits are cleared directly, without the timer task, and pdPASS is always
+ * returned.
+ *
  * \defgroup xEventGroupClearBitsFromISR xEventGroupClearBitsFromISR
  * \ingroup EventGroup
  */
-#if( configUSE_TRACE_FACILITY == 1 )
+#if( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUPS_DIRECT_FROM_ISR == 1 ) )
 	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear ) PRIVILEGED_FUNCTION;
 #else
 	#define xEventGroupClearBitsFromISR( xEventGroup, uxBitsToClear ) xTimerPendFunctionCallFromISR( vEventGroupClearBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToClear, NULL )
@@ -553,10 +562,17 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
 		}
   }
    </pre>
+ * If configUSE_EVENT_GROUPS_DIRECT_FROM_ISR is set to 1 in FreeRTOSConfig.h
+ * the bits are set and the waiting tasks unblocked from within the interrupt,
+ * so the only task switch is to the unblocked task.  Interrupts are masked
+ * up to configMAX_SYSCALL_INTERRUPT_PRIORITY while the tasks waiting on the
+ * event group are examined, so the time taken grows with the number of
+ * waiting tasks.  pdPASS is always returned.
+ *
  * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
  * \ingroup EventGroup
  */
-#if( configUSE_TRACE_FACILITY == 1 )
+#if( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUPS_DIRECT_FROM_ISR == 1 ) )
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 #else
 	#define xEventGroupSetBitsFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken ) xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken )
@@ -738,6 +754,32 @@ EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup ) PRIVILEG
  */
 void vEventGroupDelete( EventGroupHandle_t xEventGroup ) PRIVILEGED_FUNCTION;
 
+/**
+ * event_groups.h
+ *<pre>
+	void vEventGroupAddToRegistry( EventGroupHandle_t xEventGroup, const char *pcName );
+	void vEventGroupUnregister( EventGroupHandle_t xEventGroup );
+	const char *pcEventGroupGetName( EventGroupHandle_t xEventGroup );
+	EventGroupHandle_t xEventGroupFindByName( const char *pcName );
+ </pre>
+ *
+ * Gives an event group a name in the object registry, removes it, reads the
+ * name of an event group (NULL if it is not registered) and finds an event
+ * group by its name (NULL if there is none).  Adding a registered event group
+ * renames it, and vEventGroupDelete() removes it.  The name is only pointed
+ * to, so it must be persistent.  Not to be called from interrupts.
+ * configUSE_OBJECT_REGISTRY must be set to 1.
+ *
+ * \defgroup vEventGroupAddToRegistry vEventGroupAddToRegistry
+ * \ingroup EventGroup
+ */
+#if( configUSE_OBJECT_REGISTRY == 1 )
+	void vEventGroupAddToRegistry( EventGroupHandle_t xEventGroup, const char *pcName ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	void vEventGroupUnregister( EventGroupHandle_t xEventGroup ) PRIVILEGED_FUNCTION;
+	const char *pcEventGroupGetName( EventGroupHandle_t xEventGroup ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	EventGroupHandle_t xEventGroupFindByName( const char *pcName ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+#endif
+
 /* For internal use only. */
 void vEventGroupSetBitsCallback( void *pvEventGroup, const uint32_t ulBitsToSet ) PRIVILEGED_FUNCTION;
 void vEventGroupClearBitsCallback( void *pvEventGroup, const uint32_t ulBitsToClear ) PRIVILEGED_FUNCTION;
@@ -13,13 +13,29 @@
  * 			To use QueueSet, 'configUSE_QUEUE_SETS' must be enabled in the
  * 			'FreeRTOSConfig.h' file. If it doesn't exist, create one yourself.
  *
+ * 			With RECEIVE_WITH_WAIT_ANY set to 1, the receiver waits on a
+ * 			wait-any object (wait_any.h, 'configUSE_WAIT_ANY') instead. It
+ * 			needs no set queue and returns a bitmask of every ready queue,
+ * 			so both messages are printed when they arrive together.
+ *
+ * 			The queues are added to the queue registry, and
+ * 			vQueueMetricsTask prints their counters (configUSE_QUEUE_METRICS)
+ * 			every QUEUE_METRICS_MS. With one-item queues, the full drops
+ * 			show the messages lost while the receiver was busy.
+ *
  ******************************************************************************/
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
 #include "queue.h"
+#include "wait_any.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define RECEIVE_WITH_WAIT_ANY	1	/* 0: queue set, 1: wait-any object */
+#define QUEUE_METRICS_MS		5000U	/* Queue counters print period. */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
@@ -30,12 +46,17 @@ int __io_putchar(int ch);
 void vSendDataToQueueTask1(void *pvParameters);
 void vSendDataToQueueTask2(void *pvParameters);
 void vReceiveDataFromQueueTask(void *pvParameters);
+void vQueueMetricsTask(void *pvParameters);
 
 /* Variables -----------------------------------------------------------------*/
 UART_HandleTypeDef huart2;
 static QueueHandle_t xQueue1 = NULL;
 static QueueHandle_t xQueue2 = NULL;
+#if (RECEIVE_WITH_WAIT_ANY == 1)
+static StaticWaitAny_t xWaitAnyBuffer;
+#else
 static QueueSetHandle_t xQueueSet = NULL;
+#endif
 
 /**
  * @brief The application entry point.
@@ -66,7 +87,7 @@ int main(void)
 	}
 
 	xQueue2 = xQueueCreate(1, sizeof(char *));
-	if (NULL == xQueue1)
+	if (NULL == xQueue2)
 	{
 		printf("Error: Queue2 could not be created.\r\n");
 		while (1)
@@ -75,12 +96,19 @@ int main(void)
 		}
 	}
 
+	/* Register the queues, so their counters are printed by name. */
+	vQueueAddToRegistry(xQueue1, "xQueue1");
+	vQueueAddToRegistry(xQueue2, "xQueue2");
+
+#if (RECEIVE_WITH_WAIT_ANY == 0)
 	/* Create a queue set to hold two queues each of which holds one element. */
 	xQueueSet = xQueueCreateSet(1 * 2);
 
 	/* Add the two queues to the queue set. */
 	xQueueAddToSet(xQueue1,  xQueueSet);
 	xQueueAddToSet(xQueue2,  xQueueSet);
+	vQueueAddToRegistry(xQueueSet, "xQueueSet");
+#endif
 
 	/* Create two sender tasks with the same priority of 1. */
 	xTaskCreate(vSendDataToQueueTask1,
@@ -105,6 +133,14 @@ int main(void)
 				2,
 				NULL);
 
+	/* Create the queue counters reporter, below the receiver. */
+	xTaskCreate(vQueueMetricsTask,
+				"vQueueMetricsTask",
+				256,
+				NULL,
+				1,
+				NULL);
+
 	/* Start scheduler. */
 	vTaskStartScheduler();
 
@@ -170,6 +206,41 @@ void vSendDataToQueueTask2(void *pvParameters)
  * the corresponding value over UART. It also increments profiler counters for
  * each sensor type to track how often data is received.
  */
+#if (RECEIVE_WITH_WAIT_ANY == 1)
+void vReceiveDataFromQueueTask(void *pvParameters)
+{
+	WaitAnyHandle_t xWaitAny;
+	UBaseType_t uxQueue1Bit;
+	UBaseType_t uxQueue2Bit;
+	UBaseType_t uxReady;
+	char *pcReceivedString;
+
+	/* Notification index 0 is left to the task notification API; the
+	 * wait-any object sleeps on index 1. Messages sent before the queues are
+	 * added are not lost: readiness is read from the queues themselves. */
+	xWaitAny = xWaitAnyCreateStatic(xTaskGetCurrentTaskHandle(), 1, &xWaitAnyBuffer);
+	uxQueue1Bit = uxWaitAnyAddQueue(xWaitAny, xQueue1);
+	uxQueue2Bit = uxWaitAnyAddQueue(xWaitAny, xQueue2);
+
+	while (1)
+	{
+		/* Block until at least one of the queues holds a message. */
+		uxReady = uxWaitAnyWait(xWaitAny, uxQueue1Bit | uxQueue2Bit, portMAX_DELAY);
+
+		/* Every ready queue is reported, so none of them waits for another
+		 * round. */
+		if (((uxReady & uxQueue1Bit) != 0U) && (xQueueReceive(xQueue1, &pcReceivedString, 0) == pdPASS))
+		{
+			printf("%s", pcReceivedString);
+		}
+
+		if (((uxReady & uxQueue2Bit) != 0U) && (xQueueReceive(xQueue2, &pcReceivedString, 0) == pdPASS))
+		{
+			printf("%s", pcReceivedString);
+		}
+	}
+}
+#else
 void vReceiveDataFromQueueTask(void *pvParameters)
 {
 	QueueHandle_t xQueue;
@@ -188,6 +259,41 @@ void vReceiveDataFromQueueTask(void *pvParameters)
 		printf("%s", pcReceivedString);
 	}
 }
+#endif
+
+/**
+ * @brief Prints the counters of each queue in the queue registry every
+ * QUEUE_METRICS_MS.
+ * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
+ * task function signature.
+ * @return None.
+ * @note Blocks and timeouts are shown as send/receive.
+ */
+void vQueueMetricsTask(void *pvParameters)
+{
+	static QueueRegistryMetrics_t xMetrics[configQUEUE_REGISTRY_SIZE];	/* Off the task stack. */
+	TickType_t xLastWakeTicks = xTaskGetTickCount();
+	UBaseType_t uxCount;
+	UBaseType_t ux;
+
+	while (1)
+	{
+		vTaskDelayUntil(&xLastWakeTicks, pdMS_TO_TICKS(QUEUE_METRICS_MS));
+		uxCount = uxQueueGetRegistryMetrics(xMetrics, configQUEUE_REGISTRY_SIZE);
+
+		for (ux = 0; ux < uxCount; ux++)
+		{
+			printf("%s: sent %lu, received %lu, peak %lu/%lu, full drops %lu\r\n",
+					xMetrics[ux].pcQueueName, xMetrics[ux].xMetrics.ulSends,
+					xMetrics[ux].xMetrics.ulReceives, xMetrics[ux].xMetrics.ulHighWaterMark,
+					(uint32_t)xMetrics[ux].uxLength, xMetrics[ux].xMetrics.ulFullDrops);
+			printf("%s: blocked %lu/%lu, timeouts %lu/%lu, ticks blocked %lu\r\n",
+					xMetrics[ux].pcQueueName, xMetrics[ux].xMetrics.ulSendsBlocked,
+					xMetrics[ux].xMetrics.ulReceivesBlocked, xMetrics[ux].xMetrics.ulSendTimeouts,
+					xMetrics[ux].xMetrics.ulReceiveTimeouts, xMetrics[ux].xMetrics.ulTicksBlocked);
+		}
+	}
+}
 
 int Uart2_Putchar(int ch)
 {
@@ -224,44 +330,9 @@ int __io_putchar(int ch)
  */
 void SystemClock_Config(void)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
-
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-	{
-		Error_Handler();
-	}
-
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
@@ -0,0 +1,236 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "arena.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+#if( configUSE_TASK_ARENAS == 1 )
+
+/* Sizes are rounded up to this, so every object starts aligned. */
+#define arenaALIGN_UP( x )	( ( ( x ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* The arena header takes the start of the block xArenaCreate() allocates,
+rounded up so that the storage after it is aligned like the heap's blocks. */
+#define arenaHEADER_SIZE	arenaALIGN_UP( sizeof( StaticArena_t ) )
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	ArenaHandle_t xArenaCreate( size_t xSizeBytes )
+	{
+	StaticArena_t *pxArena = NULL;
+
+		/* Refuse sizes that would wrap around once the header is added. */
+		if( xSizeBytes <= ( ( ( size_t ) -1 ) - ( arenaHEADER_SIZE + ( size_t ) portBYTE_ALIGNMENT ) ) )
+		{
+			xSizeBytes = arenaALIGN_UP( xSizeBytes );
+			pxArena = ( StaticArena_t * ) pvPortMalloc( arenaHEADER_SIZE + xSizeBytes ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+
+			if( pxArena != NULL )
+			{
+				( void ) xArenaCreateStatic( xSizeBytes, ( ( uint8_t * ) pxArena ) + arenaHEADER_SIZE, pxArena );
+				pxArena->ucStaticallyAllocated = pdFALSE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxArena;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+ArenaHandle_t xArenaCreateStatic( size_t xSizeBytes, uint8_t *pucArenaStorage, StaticArena_t *pxArenaBuffer )
+{
+size_t uxAddress, uxEnd;
+
+	configASSERT( pxArenaBuffer );
+	configASSERT( pucArenaStorage );
+
+	/* Use the aligned part of the storage only, so that every size handed
+	out, rounded up, keeps the pointer aligned. */
+	uxAddress = arenaALIGN_UP( ( size_t ) pucArenaStorage );
+	uxEnd = ( ( ( size_t ) pucArenaStorage ) + xSizeBytes ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+	if( uxAddress > uxEnd )
+	{
+		uxAddress = uxEnd;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxArenaBuffer->pucStart = ( uint8_t * ) uxAddress;
+	pxArenaBuffer->pucNext = pxArenaBuffer->pucStart;
+	pxArenaBuffer->pucEnd = ( uint8_t * ) uxEnd;
+	pxArenaBuffer->xHighWaterMark = 0;
+	pxArenaBuffer->ucStaticallyAllocated = pdTRUE;
+
+	return pxArenaBuffer;
+}
+/*-----------------------------------------------------------*/
+
+void vArenaDelete( ArenaHandle_t xArena )
+{
+	configASSERT( xArena );
+
+	#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	{
+		if( xArena->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( xArena );
+			return;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	/* The application owns the memory of a static arena: leave it empty, so
+	nothing still pointing into it is mistaken for a live object. */
+	vArenaReset( xArena );
+}
+/*-----------------------------------------------------------*/
+
+void *pvArenaAlloc( ArenaHandle_t xArena, size_t xWantedSize )
+{
+void *pvReturn = NULL;
+size_t xUsed;
+
+	configASSERT( xArena );
+
+	/* Compared with the bytes left before rounding up, so a huge request
+	cannot wrap around.  The bytes left are a multiple of portBYTE_ALIGNMENT,
+	so the rounded up size still fits. */
+	if( ( xWantedSize > 0 ) && ( xWantedSize <= ( size_t ) ( xArena->pucEnd - xArena->pucNext ) ) )
+	{
+		pvReturn = ( void * ) xArena->pucNext;
+		xArena->pucNext += arenaALIGN_UP( xWantedSize );
+
+		xUsed = ( size_t ) ( xArena->pucNext - xArena->pucStart );
+
+		if( xUsed > xArena->xHighWaterMark )
+		{
+			xArena->xHighWaterMark = xUsed;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xArenaGetMark( ArenaHandle_t xArena )
+{
+	configASSERT( xArena );
+
+	return ( size_t ) ( xArena->pucNext - xArena->pucStart );
+}
+/*-----------------------------------------------------------*/
+
+void vArenaRewind( ArenaHandle_t xArena, size_t xMark )
+{
+	configASSERT( xArena );
+
+	/* A mark from before a reset, or an outer rewind, is past the pointer. */
+	configASSERT( xMark <= xArenaGetMark( xArena ) );
+
+	if( xMark <= xArenaGetMark( xArena ) )
+	{
+		xArena->pucNext = xArena->pucStart + xMark;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vArenaReset( ArenaHandle_t xArena )
+{
+	configASSERT( xArena );
+
+	xArena->pucNext = xArena->pucStart;
+}
+/*-----------------------------------------------------------*/
+
+size_t xArenaGetFreeSize( ArenaHandle_t xArena )
+{
+	configASSERT( xArena );
+
+	return ( size_t ) ( xArena->pucEnd - xArena->pucNext );
+}
+/*-----------------------------------------------------------*/
+
+size_t xArenaGetHighWaterMark( ArenaHandle_t xArena )
+{
+	configASSERT( xArena );
+
+	return xArena->xHighWaterMark;
+}
+/*-----------------------------------------------------------*/
+
+void *pvTaskArenaAlloc( size_t xWantedSize )
+{
+ArenaHandle_t xArena = xTaskGetArena( NULL );
+
+	return ( xArena != NULL ) ? pvArenaAlloc( xArena, xWantedSize ) : NULL;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TASK_ARENAS */
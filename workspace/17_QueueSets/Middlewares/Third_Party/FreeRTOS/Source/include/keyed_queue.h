@@ -0,0 +1,251 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A keyed queue holds at most one pending item per key, and a send with the
+ * key of a pending item overwrites that item in place.  It suits producers of
+ * state, such as sensor readings, whose consumer only needs the newest value
+ * of each: a slow consumer no longer finds a backlog of stale readings, and
+ * producers never block or lose the latest value to a full queue.
+ *
+ * - Keys are small integers, 0 to uxKeys - 1, which index the item slots
+ *   directly, so a send and a receive are O(1) whatever the number of keys.
+ *   Map sparse identifiers to dense keys first.
+ *
+ * - Pending keys are received in the order they first became pending.  An
+ *   overwrite keeps the place of the item it replaces.
+ *
+ * - The queue can therefore never hold more than uxKeys items, and a send
+ *   never fails.
+ *
+ * - Items are copied in and out in a critical section, as by queue.c, so they
+ *   should be kept small.  Receivers block on a counting semaphore of the
+ *   pending keys, in priority order.
+ *
+ * Sends may be made from interrupts with xKeyedQueueSendFromISR().
+ */
+
+#ifndef KEYED_QUEUE_H
+#define KEYED_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include keyed_queue.h"
+#endif
+
+#include "semphr.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * The largest number of keys of a keyed queue.  Each key takes one byte of
+ * link storage; the two values above are markers.
+ */
+#define keyedqueueMAX_KEYS	( ( UBaseType_t ) 254U )
+
+/**
+ * The size in bytes of the storage to pass to xKeyedQueueCreateStatic(): one
+ * item slot and one link byte per key.
+ */
+#define keyedqueueSTORAGE_SIZE( uxKeys, uxItemSize )	( ( size_t ) ( uxKeys ) * ( ( size_t ) ( uxItemSize ) + 1U ) )
+
+/**
+ * The storage of a keyed queue, declared by the application and passed to
+ * xKeyedQueueCreateStatic().  Its members must not be accessed directly.
+ */
+typedef struct KeyedQueueDef_t
+{
+	uint8_t *pucLinks;				/* Per key: next pending key, or a marker. */
+	uint8_t *pucItems;				/* Per key: the newest item. */
+	UBaseType_t uxKeys;
+	UBaseType_t uxItemSize;
+	uint8_t ucHead;					/* Oldest pending key. */
+	uint8_t ucTail;					/* Newest pending key. */
+	volatile UBaseType_t uxWaiting;
+	volatile UBaseType_t uxConflated;
+	SemaphoreHandle_t xPending;		/* Counts the pending keys. */
+	StaticSemaphore_t xPendingBuffer;
+} StaticKeyedQueue_t;
+
+/**
+ * Type by which keyed queues are referenced.
+ */
+typedef StaticKeyedQueue_t * KeyedQueueHandle_t;
+
+/**
+ * keyed_queue.h
+ *
+<pre>
+KeyedQueueHandle_t xKeyedQueueCreateStatic( UBaseType_t uxKeys,
+                                            UBaseType_t uxItemSize,
+                                            uint8_t *pucStorage,
+                                            StaticKeyedQueue_t *pxKeyedQueueBuffer );
+</pre>
+ *
+ * Creates an empty keyed queue in pxKeyedQueueBuffer.
+ *
+ * @param uxKeys The number of keys, 1 to keyedqueueMAX_KEYS.
+ *
+ * @param uxItemSize The size in bytes of an item.
+ *
+ * @param pucStorage keyedqueueSTORAGE_SIZE( uxKeys, uxItemSize ) bytes.
+ *
+ * @param pxKeyedQueueBuffer The storage of the queue itself.
+ *
+ * @return A handle to the queue.
+ *
+ * Example usage:
+<pre>
+#define SENSOR_COUNT 2
+
+static uint8_t ucSensorStorage[ keyedqueueSTORAGE_SIZE( SENSOR_COUNT, sizeof( Reading_t ) ) ];
+static StaticKeyedQueue_t xSensorQueueBuffer;
+KeyedQueueHandle_t xSensorQueue;
+
+void vSetup( void )
+{
+	xSensorQueue = xKeyedQueueCreateStatic( SENSOR_COUNT, sizeof( Reading_t ), ucSensorStorage, &xSensorQueueBuffer );
+}
+
+void vProducer( const Reading_t *pxReading )
+{
+	( void ) xKeyedQueueSend( xSensorQueue, pxReading->uxSensor, pxReading );
+}
+
+void vConsumer( void )
+{
+UBaseType_t uxSensor;
+Reading_t xReading;
+
+	if( xKeyedQueueReceive( xSensorQueue, &uxSensor, &xReading, portMAX_DELAY ) == pdTRUE )
+	{
+		vProcess( uxSensor, &xReading );
+	}
+}
+</pre>
+ * \defgroup xKeyedQueueCreateStatic xKeyedQueueCreateStatic
+ * \ingroup KeyedQueues
+ */
+KeyedQueueHandle_t xKeyedQueueCreateStatic( UBaseType_t uxKeys, UBaseType_t uxItemSize, uint8_t *pucStorage, StaticKeyedQueue_t *pxKeyedQueueBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * keyed_queue.h
+ *
+<pre>
+BaseType_t xKeyedQueueSend( KeyedQueueHandle_t xKeyedQueue, UBaseType_t uxKey, const void *pvItem );
+</pre>
+ *
+ * Stores pvItem as the newest item of uxKey, and makes the key pending if it
+ * was not.  Never blocks.
+ *
+ * @return pdTRUE if the key became pending, pdFALSE if the item overwrote the
+ * pending item of the key.
+ *
+ * \defgroup xKeyedQueueSend xKeyedQueueSend
+ * \ingroup KeyedQueues
+ */
+BaseType_t xKeyedQueueSend( KeyedQueueHandle_t xKeyedQueue, UBaseType_t uxKey, const void *pvItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * keyed_queue.h
+ *
+<pre>
+BaseType_t xKeyedQueueSendFromISR( KeyedQueueHandle_t xKeyedQueue,
+                                   UBaseType_t uxKey,
+                                   const void *pvItem,
+                                   BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xKeyedQueueSend() that can be called from an interrupt.
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if the send unblocked a task of
+ * a higher priority than the interrupted one.
+ *
+ * \defgroup xKeyedQueueSendFromISR xKeyedQueueSendFromISR
+ * \ingroup KeyedQueues
+ */
+BaseType_t xKeyedQueueSendFromISR( KeyedQueueHandle_t xKeyedQueue, UBaseType_t uxKey, const void *pvItem, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * keyed_queue.h
+ *
+<pre>
+BaseType_t xKeyedQueueReceive( KeyedQueueHandle_t xKeyedQueue,
+                               UBaseType_t *puxKey,
+                               void *pvItem,
+                               TickType_t xTicksToWait );
+</pre>
+ *
+ * Removes the oldest pending key and copies out its newest item, blocking
+ * for up to xTicksToWait while no key is pending.
+ *
+ * @param puxKey Receives the key.  May be NULL.
+ *
+ * @param pvItem Receives the item.
+ *
+ * @return pdTRUE if an item was received, pdFALSE if the block time expired
+ * first.
+ *
+ * \defgroup xKeyedQueueReceive xKeyedQueueReceive
+ * \ingroup KeyedQueues
+ */
+BaseType_t xKeyedQueueReceive( KeyedQueueHandle_t xKeyedQueue, UBaseType_t *puxKey, void *pvItem, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * keyed_queue.h
+ *
+<pre>
+UBaseType_t uxKeyedQueueMessagesWaiting( KeyedQueueHandle_t xKeyedQueue );
+</pre>
+ *
+ * @return The number of pending keys.
+ *
+ * \defgroup uxKeyedQueueMessagesWaiting uxKeyedQueueMessagesWaiting
+ * \ingroup KeyedQueues
+ */
+UBaseType_t uxKeyedQueueMessagesWaiting( KeyedQueueHandle_t xKeyedQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * keyed_queue.h
+ *
+<pre>
+UBaseType_t uxKeyedQueueGetConflatedCount( KeyedQueueHandle_t xKeyedQueue );
+</pre>
+ *
+ * @return The number of items overwritten before they were received, since
+ * the queue was created.
+ *
+ * \defgroup uxKeyedQueueGetConflatedCount uxKeyedQueueGetConflatedCount
+ * \ingroup KeyedQueues
+ */
+UBaseType_t uxKeyedQueueGetConflatedCount( KeyedQueueHandle_t xKeyedQueue ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif	/* !defined( KEYED_QUEUE_H ) */
@@ -59,6 +59,13 @@ typedef unsigned long UBaseType_t;
 #if( configUSE_16_BIT_TICKS == 1 )
 	typedef uint16_t TickType_t;
 	#define portMAX_DELAY ( TickType_t ) 0xffff
+#elif( configUSE_64_BIT_TICKS == 1 )
+	typedef uint64_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffffffffffULL
+
+	/* Two loads, so not atomic.  xTaskGetTickCount() reads the high word twice
+	instead of entering a critical section (see tasks.c). */
+	#define portTICK_TYPE_IS_ATOMIC 0
 #else
 	typedef uint32_t TickType_t;
 	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
@@ -76,7 +83,7 @@ typedef unsigned long UBaseType_t;
 /*-----------------------------------------------------------*/
 
 /* Scheduler utilities. */
-#define portYIELD() 															\
+#define portYIELD_PENDSV() 														\
 {																				\
 	/* Set a PendSV to request a context switch. */								\
 	portNVIC_INT_CTRL_REG = portNVIC_PENDSVSET_BIT;								\
@@ -87,9 +94,31 @@ typedef unsigned long UBaseType_t;
 	__asm volatile( "isb" );													\
 }
 
+/* With configUSE_FAST_COOPERATIVE_YIELD set to 1, a task that yields or
+blocks switches to the next task in thread mode, without PendSV: vPortYield()
+saves only what a function call has to preserve, in the layout of
+xPortPendSVHandler(), and returns straight into the next task if that task was
+switched out the same way.  Interrupts still request switches with PendSV.
+Only available with configUSE_PREEMPTION 0, where all switches but those are
+voluntary. */
+#ifndef configUSE_FAST_COOPERATIVE_YIELD
+	#define configUSE_FAST_COOPERATIVE_YIELD 0
+#endif
+
+#if( configUSE_FAST_COOPERATIVE_YIELD == 1 )
+	#if( configUSE_PREEMPTION != 0 )
+		#error configUSE_FAST_COOPERATIVE_YIELD can only be set to 1 when configUSE_PREEMPTION is 0.
+	#endif
+
+	extern void vPortYield( void );
+	#define portYIELD()				vPortYield()
+#else
+	#define portYIELD()				portYIELD_PENDSV()
+#endif
+
 #define portNVIC_INT_CTRL_REG		( * ( ( volatile uint32_t * ) 0xe000ed04 ) )
 #define portNVIC_PENDSVSET_BIT		( 1UL << 28UL )
-#define portEND_SWITCHING_ISR( xSwitchRequired ) if( xSwitchRequired != pdFALSE ) portYIELD()
+#define portEND_SWITCHING_ISR( xSwitchRequired ) if( xSwitchRequired != pdFALSE ) portYIELD_PENDSV()
 #define portYIELD_FROM_ISR( x ) portEND_SWITCHING_ISR( x )
 /*-----------------------------------------------------------*/
 
@@ -103,6 +132,9 @@ extern void vPortExitCritical( void );
 #define portENTER_CRITICAL()					vPortEnterCritical()
 #define portEXIT_CRITICAL()						vPortExitCritical()
 
+/* Call sites of critical sections, for the trace macros. */
+#define portGET_RETURN_ADDRESS()				__builtin_return_address( 0 )
+
 /*-----------------------------------------------------------*/
 
 /* Task function macros as described on the FreeRTOS.org WEB site.  These are
@@ -112,6 +144,62 @@ not necessary for to use this port.  They are defined so the common demo files
 #define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
 /*-----------------------------------------------------------*/
 
+/* FPU context.  xPortPendSVHandler() saves and restores S16-S31 only for a
+task whose EXC_RETURN shows an FPU frame, which the hardware sets once the task
+has executed a floating point instruction.  S0-S15 and the FPSCR are stacked
+lazily by the hardware on exception entry, for tasks and interrupts alike, so
+integer only tasks pay nothing.
+
+With configUSE_TASK_FPU_DECLARATION set to 1, tasks that use the FPU are
+declared by OR'ing portTASK_USES_FPU_BIT into the priority passed to
+xTaskCreate(), and the kernel asserts if any other task acquires an FPU
+context.  portTASK_HAS_FPU_CONTEXT() reads the EXC_RETURN saved by
+xPortPendSVHandler() after R4-R11 at the top of a switched out task's stack. */
+#define portTASK_USES_FPU_BIT						( ( UBaseType_t ) 0x40000000UL )
+#define portTASK_HAS_FPU_CONTEXT( pxTopOfStack )	( ( ( ( ( const uint32_t * ) ( pxTopOfStack ) )[ 8 ] & 0x10UL ) == 0UL ) ? pdTRUE : pdFALSE )
+/*-----------------------------------------------------------*/
+
+/* MPU stack guard (configUSE_MPU_STACK_GUARD).  MPU region 7, the highest
+priority region, is a 32 byte no access region at the lowest aligned address
+of the running task's stack.  Its size and attributes are set once by
+xPortStartScheduler(), so moving it to the stack of the task switched in is a
+single store to RBAR, with the VALID bit selecting the region.  The exception
+return that ends the switch makes the new base take effect; in the thread mode
+switch of vPortYield() the old base may hold for a few instructions, which
+only delays the check. */
+#define portSTACK_GUARD_SIZE			( 32UL )
+#define portSTACK_GUARD_REGION			( 7UL )
+#define portMPU_RBAR_REG				( * ( ( volatile uint32_t * ) 0xe000ed9c ) )
+#define portMPU_RBAR_VALID_BIT			( 1UL << 4UL )
+
+#define portSTACK_GUARD_BASE( pxStack )	( ( ( uint32_t ) ( pxStack ) + ( portSTACK_GUARD_SIZE - 1UL ) ) & ~( portSTACK_GUARD_SIZE - 1UL ) )
+#define portSTACK_GUARD_END( pxStack )	( portSTACK_GUARD_BASE( pxStack ) + portSTACK_GUARD_SIZE )
+#define portSET_STACK_GUARD( pxStack )	portMPU_RBAR_REG = ( portSTACK_GUARD_BASE( pxStack ) | portMPU_RBAR_VALID_BIT | portSTACK_GUARD_REGION )
+
+/* Called from MemManage_Handler(): pdTRUE if the fault is an access to the
+guard, by the running task or by the exception entry stacking its context. */
+BaseType_t xPortIsStackGuardFault( void );
+/*-----------------------------------------------------------*/
+
+/* Run-time tick rate, with configUSE_DYNAMIC_TICK_RATE.  xPortSetTickRate()
+takes a rate that divides configTICK_RATE_HZ and returns pdFAIL otherwise, or
+if the SysTick reload would not fit 24 bits.  The next tick interrupt puts it
+into effect; ulPortGetTickRate() returns the rate in effect. */
+#if( configUSE_DYNAMIC_TICK_RATE == 1 )
+	BaseType_t xPortSetTickRate( uint32_t ulTickRateHz );
+	uint32_t ulPortGetTickRate( void );
+#endif
+/*-----------------------------------------------------------*/
+
+/* Idle sleep, with configUSE_IDLE_SLEEP.  A WFI with interrupts masked, so
+the wake-up can be timed on the SysTick before the interrupt that ended it is
+taken. */
+#if( configUSE_IDLE_SLEEP == 1 )
+	void vPortIdleSleep( void );
+	#define portIDLE_SLEEP() vPortIdleSleep()
+#endif
+/*-----------------------------------------------------------*/
+
 /* Tickless idle/low power functionality. */
 #ifndef portSUPPRESS_TICKS_AND_SLEEP
 	extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
@@ -135,10 +223,9 @@ not necessary for to use this port.  They are defined so the common demo files
 		return ucReturn;
 	}
 
-	/* Check the configuration. */
-	#if( configMAX_PRIORITIES > 32 )
-		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
-	#endif
+	/* The bit map is one 32-bit word.  tasks.c keeps more than 32 priorities,
+	such as the 56 of CMSIS-RTOS2, in two levels of such words. */
+	#define portREADY_BITMAP_BITS 32
 
 	/* Store/clear the ready priorities in a bit map. */
 	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
@@ -162,6 +249,16 @@ not necessary for to use this port.  They are defined so the common demo files
 
 #define portINLINE	__inline
 
+/* Places a kernel function in SRAM (configUSE_KERNEL_RAM_FUNCTIONS).  The
+section is matched by the .RamFunc* pattern of the linker script, so the
+startup code copies it from flash together with .data.  Calls between flash
+and SRAM are out of BL range and go through veneers added by the linker. */
+#define portRAM_FUNCTION __attribute__(( section( ".RamFunc.kernel" ) ))
+
+/* Places zero initialised data in the .noinit section of the linker script,
+which is kept out of .bss so the startup code does not clear it. */
+#define portNOINIT_DATA __attribute__(( section( ".noinit" ) ))
+
 #ifndef portFORCE_INLINE
 	#define portFORCE_INLINE inline __attribute__(( always_inline))
 #endif
@@ -233,7 +330,36 @@ portFORCE_INLINE static void vPortSetBASEPRI( uint32_t ulNewMaskValue )
 }
 /*-----------------------------------------------------------*/
 
+/* Exclusive access, used by the mutex fast path (configUSE_MUTEX_FAST_PATH)
+and by atomic.h (configUSE_ATOMIC_EXCLUSIVE_ACCESS).  Exception entry and
+return clear the local monitor, so a store exclusive fails if the task was
+interrupted or switched out since the matching load. */
+portFORCE_INLINE static uint32_t ulPortLoadExclusive( volatile uint32_t *pulAddress )
+{
+uint32_t ulValue;
+
+	__asm volatile( "ldrex %0, [%1]" : "=r" ( ulValue ) : "r" ( pulAddress ) : "memory" );
+
+	return ulValue;
+}
+/*-----------------------------------------------------------*/
+
+portFORCE_INLINE static uint32_t ulPortStoreExclusive( volatile uint32_t *pulAddress, uint32_t ulValue )
+{
+uint32_t ulFailed;
+
+	__asm volatile( "strex %0, %2, [%1]" : "=&r" ( ulFailed ) : "r" ( pulAddress ), "r" ( ulValue ) : "memory" );
+
+	return ulFailed;
+}
+/*-----------------------------------------------------------*/
+
+#define portLOAD_EXCLUSIVE( pulAddress )				ulPortLoadExclusive( ( pulAddress ) )
+#define portSTORE_EXCLUSIVE( pulAddress, ulValue )		ulPortStoreExclusive( ( pulAddress ), ( ulValue ) )
+#define portCLEAR_EXCLUSIVE()							__asm volatile( "clrex" ::: "memory" )
+
 #define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
+#define portDATA_MEMORY_BARRIER() __asm volatile( "dmb" ::: "memory" )
 
 #ifdef __cplusplus
 }
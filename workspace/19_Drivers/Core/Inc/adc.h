@@ -11,9 +11,69 @@
 #define ADC_H
 
 /* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "xfer.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define ADC_SCAN_MAX_CHANNELS		16U		/* Regular sequence length. */
+#define ADC_INJECTED_MAX_CHANNELS	4U
+#define ADC_SCAN_MAX_OVERSAMPLE_LOG2 8U
+#define ADC_CHANNEL_VREFINT			17U
+#define ADC_CHANNEL_TEMPERATURE		18U
+
+#ifndef ADC_IRQ_PRIORITY
+#define ADC_IRQ_PRIORITY 6U		/* At or below configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+#endif
+
+#ifndef ADC_REQUEST_CHANNEL
+#define ADC_REQUEST_CHANNEL 1U		/* Converted by adc_convert_async(): PA1. */
+#endif
+
+#ifndef ADC_REQUEST_SAMPLE_TIME
+#define ADC_REQUEST_SAMPLE_TIME 3U	/* SMPR code: 56 + 12 ADC clocks, about 3 us. */
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	const uint8_t *pucChannels;	/* Sequence of ucCount channels, 0..18. */
+	uint8_t ucCount;			/* 1..ADC_SCAN_MAX_CHANNELS */
+	uint8_t ucSampleTime;		/* SMPR code 0..7 (3 to 480 ADC clocks), every channel. */
+	uint8_t ucOversampleLog2;	/* 2^n sequences are summed into each result. */
+	uint8_t ucShift;			/* Right shift of the sums; n / 2 for n / 2 extra bits. */
+	uint32_t ulRateHz;			/* Sequences per second (TIM2 update rate). */
+	uint16_t *pusRaw;			/* 2 * (ucCount << ucOversampleLog2) halfwords, for the DMA. */
+	TaskHandle_t xTask;			/* Notified once per result block, or NULL. */
+} AdcScanConfig_t;
 
 /* Function Prototypes -------------------------------------------------------*/
 void adc_init(void);
 uint32_t read_analog_sensor(void);
+void read_analog_sensor_block(uint16_t *pusSamples, uint32_t ulCount);
+int32_t adc_stream_init(uint32_t ulSampleRateHz, uint16_t *pusBuf0, uint16_t *pusBuf1,
+		uint16_t usBlockSize, TaskHandle_t xTask);
+int32_t adc_stream_start(void);
+void adc_stream_stop(void);
+uint16_t *adc_stream_wait(TickType_t xTicksToWait);
+uint32_t adc_stream_get_overruns(void);
+int32_t adc_scan_init(const AdcScanConfig_t *pxConfig);
+int32_t adc_scan_start(void);
+void adc_scan_stop(void);
+uint32_t adc_scan_get_latest(uint16_t *pusValues);
+int32_t adc_scan_wait(uint16_t *pusValues, TickType_t xTicksToWait);
+uint32_t adc_scan_get_overruns(void);
+int32_t adc_interleaved_init(uint32_t ulChannel, uint32_t *pulBuf0, uint32_t *pulBuf1,
+		uint16_t usBlockWords, TaskHandle_t xTask);
+int32_t adc_interleaved_start(void);
+void adc_interleaved_stop(void);
+uint32_t *adc_interleaved_wait(TickType_t xTicksToWait);
+uint32_t adc_interleaved_get_rate(void);
+uint32_t adc_interleaved_get_overruns(void);
+int32_t adc_injected_init(const uint8_t *pucChannels, uint32_t ulCount, uint32_t ulSampleTime);
+int32_t adc_injected_read(uint16_t *pusValues);
+int32_t adc_convert_async(XferReq_t *pxReq);
+uint32_t adc_request_get_gaps(void);
 
 #endif /* ADC_H */
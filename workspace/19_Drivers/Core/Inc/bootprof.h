@@ -0,0 +1,66 @@
+/*******************************************************************************
+ *
+ * @file	bootprof.h
+ * @brief	Interface of the boot profiler.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Included at the end of 'FreeRTOSConfig.h', so that the context
+ * 			switch hook below replaces the empty default of 'FreeRTOS.h'.
+ * 			It cannot be combined with ktrace.h, which takes the same hook.
+ *
+ * 			Only <stdint.h> may be included here: this header is read before
+ * 			any FreeRTOS type is defined.
+ *
+ ******************************************************************************/
+
+#ifndef BOOTPROF_H
+#define BOOTPROF_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef BOOTPROF_MAX_MARKS
+#define BOOTPROF_MAX_MARKS 24U		/* Startup stamps included; 28 bytes each. */
+#endif
+
+#ifndef BOOTPROF_NAME_LEN
+#define BOOTPROF_NAME_LEN 16U		/* Longer names are cut. */
+#endif
+
+#ifndef BOOTPROF_SWITCH_MARKS
+#define BOOTPROF_SWITCH_MARKS 1U	/* Context switches recorded after start-up. */
+#endif
+
+#ifndef BOOTPROF_BUDGET_US
+#define BOOTPROF_BUDGET_US 10000U	/* Reset to the first task; 0 for none. */
+#endif
+
+/* Kernel trace hooks ---------------------------------------------------------*/
+
+/* Only installed when read from 'FreeRTOSConfig.h', ahead of the empty
+ * defaults of 'FreeRTOS.h' (traceSTART() is one of them). The first switch
+ * in is the one vTaskStartScheduler() makes into the first task. */
+#if !defined(traceSTART) && !defined(traceTASK_SWITCHED_IN)
+
+#define traceTASK_SWITCHED_IN()															\
+	do																					\
+	{																					\
+		if (ulBootProfSwitchesLeft != 0U)												\
+		{																				\
+			bootprof_task_switched_in(pxCurrentTCB->pcTaskName);						\
+		}																				\
+	} while (0)
+
+#endif
+
+/* Function Prototypes -------------------------------------------------------*/
+extern volatile uint32_t ulBootProfSwitchesLeft;
+
+void bootprof_init(void);
+void bootprof_mark(const char *pcName);
+void bootprof_task_switched_in(const char *pcTaskName);
+uint32_t bootprof_get_us(void);
+void bootprof_dump(void);
+
+#endif /* BOOTPROF_H */
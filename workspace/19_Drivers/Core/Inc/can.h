@@ -0,0 +1,149 @@
+/*******************************************************************************
+ *
+ * @file	can.h
+ * @brief	Interface of the bxCAN driver.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef CAN_H
+#define CAN_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+/* Macros --------------------------------------------------------------------*/
+/* Controllers compiled in. Each claims its TX, RX0 and RX1 vectors. */
+#ifndef CAN_USE_CAN1
+#define CAN_USE_CAN1 1
+#endif
+
+#ifndef CAN_USE_CAN2
+#define CAN_USE_CAN2 0
+#endif
+
+/* Filter banks 0 to CAN_CAN2_FIRST_BANK - 1 are CAN1's, the others CAN2's.
+ * In each share, the first CAN_FIFO0_BANKS feed FIFO 0 and the rest FIFO 1. */
+#ifndef CAN_CAN2_FIRST_BANK
+#define CAN_CAN2_FIRST_BANK 14U
+#endif
+
+#ifndef CAN_FIFO0_BANKS
+#define CAN_FIFO0_BANKS 7U
+#endif
+
+#ifndef CAN_TX_QUEUE_LEN
+#define CAN_TX_QUEUE_LEN 16U		/* Frames queued per port, the mailboxes included. */
+#endif
+
+#ifndef CAN_IRQ_PRIORITY
+#define CAN_IRQ_PRIORITY 6U			/* At or below configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+#endif
+
+#ifndef CAN_NOTIFY_INDEX
+#define CAN_NOTIFY_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+#endif
+
+#define CAN_FILTER_BANKS	28U
+#define CAN_MAILBOXES		3U
+
+#if (CAN_CAN2_FIRST_BANK == 0U) || (CAN_CAN2_FIRST_BANK >= CAN_FILTER_BANKS)
+#error "CAN_CAN2_FIRST_BANK: each controller needs a bank."
+#endif
+
+/* CanFrame_t flags. */
+#define CAN_FLAG_EXT		0x01U	/* 29-bit identifier. */
+#define CAN_FLAG_RTR		0x02U	/* Remote frame, no data. */
+
+/* Masks of CanSubConfig_t matching a single identifier. */
+#define CAN_MASK_STD		0x7FFU
+#define CAN_MASK_EXT		0x1FFFFFFFU
+
+/* Data types ----------------------------------------------------------------*/
+typedef enum
+{
+	CAN_PORT_1 = 0U,				/* CAN1, PB8 (RX)/PB9 (TX) */
+	CAN_PORT_2,						/* CAN2, PB12 (RX)/PB13 (TX) */
+	CAN_PORTS
+} CanPort_t;
+
+typedef enum
+{
+	CAN_MODE_NORMAL = 0U,
+	CAN_MODE_LOOPBACK,				/* Frames sent are received, none go out. */
+	CAN_MODE_SILENT,				/* Receives only, never acknowledges. */
+	CAN_MODE_SILENT_LOOPBACK		/* Self-test without a bus. */
+} CanMode_t;
+
+typedef struct
+{
+	uint32_t ulBitRate;				/* Must divide PCLK1 into 8 to 25 time quanta. */
+	uint8_t ucMode;					/* CanMode_t */
+} CanConfig_t;
+
+typedef struct
+{
+	uint32_t ulId;					/* 11 or 29 bits. */
+	uint8_t ucFlags;				/* CAN_FLAG_xxx */
+	uint8_t ucDlc;					/* 0 to 8. */
+	uint8_t ucData[8];
+} CanFrame_t;
+
+/* One filter bank: a frame is delivered if the identifier bits set in ulMask
+ * are those of ulId, and it is extended if and only if CAN_FLAG_EXT is set. */
+typedef struct
+{
+	uint32_t ulId;
+	uint32_t ulMask;
+	uint8_t ucFlags;				/* CAN_FLAG_EXT or 0. */
+	uint8_t ucFifo;					/* 0 or 1, each with its own interrupt. */
+	QueueHandle_t xQueue;			/* Queue of CanFrame_t, or NULL for */
+	CanFrame_t *pxRing;				/* a ring read with can_receive(), */
+	uint16_t usRingSize;			/* a power of two. */
+} CanSubConfig_t;
+
+/* Subscriber, owned by the driver from can_subscribe() to can_unsubscribe(). */
+typedef struct
+{
+	QueueHandle_t xQueue;
+	CanFrame_t *pxRing;
+	uint32_t ulRingMask;
+	volatile uint32_t ulHead;		/* Free-running, the RX ISR only. */
+	volatile uint32_t ulTail;		/* Free-running, the reader only. */
+	volatile TaskHandle_t xReader;	/* Blocked in can_receive(). */
+	uint32_t ulFr1;					/* The bank's identifier and mask registers. */
+	uint32_t ulFr2;
+	uint8_t ucPort;
+	uint8_t ucBank;
+	uint32_t ulReceived;
+	uint32_t ulDropped;				/* Queue or ring full. */
+} CanSub_t;
+
+typedef struct
+{
+	uint32_t ulTxFrames;			/* Acknowledged. */
+	uint32_t ulTxPreempted;			/* Taken out of a mailbox by a more urgent frame. */
+	uint32_t ulRxFrames;			/* Delivered. */
+	uint32_t ulRxDropped;			/* Subscriber full, or unsubscribed meanwhile. */
+	uint32_t ulRxMisrouted;			/* Matched by search, not by filter index. */
+	uint32_t ulRxOverruns;			/* Frames lost in a full FIFO. */
+	uint8_t ucTxErrors;				/* Error counters, at the time of the call. */
+	uint8_t ucRxErrors;
+	uint8_t ucBusOff;
+} CanStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t can_open(CanPort_t xPort, const CanConfig_t *pxCfg);
+int32_t can_set_bit_rate(CanPort_t xPort, uint32_t ulBitRate);
+int32_t can_subscribe(CanPort_t xPort, CanSub_t *pxSub, const CanSubConfig_t *pxCfg);
+void can_unsubscribe(CanSub_t *pxSub);
+int32_t can_send(CanPort_t xPort, const CanFrame_t *pxFrame, TickType_t xTicksToWait);
+int32_t can_receive(CanSub_t *pxSub, CanFrame_t *pxFrame, TickType_t xTicksToWait);
+int32_t can_get_stats(CanPort_t xPort, CanStats_t *pxStats);
+
+#endif /* CAN_H */
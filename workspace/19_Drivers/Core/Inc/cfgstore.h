@@ -0,0 +1,71 @@
+/*******************************************************************************
+ *
+ * @file	cfgstore.h
+ * @brief	Interface of the read-copy-update configuration store.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef CFGSTORE_H
+#define CFGSTORE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef CFGSTORE_POLL_TICKS
+#define CFGSTORE_POLL_TICKS 1U			/* Between two checks of a grace period. */
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulPublished;			/* Versions published since cfgstore_init(). */
+	uint32_t ulGraceWaits;			/* Edits that found the spare copy still read. */
+	uint32_t ulGraceTicksMax;		/* Longest of those waits. */
+	uint32_t ulTimeouts;			/* Edits that gave up waiting. */
+} CfgStoreStats_t;
+
+typedef struct
+{
+	void * volatile pvCurrent;		/* The version readers see. */
+	void *pvCopies[2];
+	uint32_t ulSize;
+	uint32_t ulEpoch;				/* Grace period of the last publish. */
+	BaseType_t xGracePending;		/* The other copy may still be read. */
+	SemaphoreHandle_t xWriteLock;	/* One writer at a time. */
+	StaticSemaphore_t xWriteLockBuffer;
+	CfgStoreStats_t xStats;			/* Writers only. */
+} CfgStore_t;
+
+/* Function definitions ------------------------------------------------------*/
+
+/**
+ * @brief Returns the current version (readers).
+ * @param pxStore Store.
+ * @retval The version, to be used until the task next blocks, suspends or
+ * deletes itself, and not written to.
+ * @note One load, no lock: the version stays valid as long as the task has
+ * not left the Ready state since, whatever a writer publishes meanwhile.
+ * Read it again after any blocking call.
+ */
+static inline const void *cfgstore_read(const CfgStore_t *pxStore)
+{
+	return pxStore->pvCurrent;
+}
+
+/* Function Prototypes -------------------------------------------------------*/
+#if (configUSE_QUIESCENT_STATES == 1) && (configSUPPORT_STATIC_ALLOCATION == 1)
+int32_t cfgstore_init(CfgStore_t *pxStore, void *pvCopy0, void *pvCopy1, uint32_t ulSize,
+		const void *pvDefaults);
+void *cfgstore_edit(CfgStore_t *pxStore, TickType_t xTicksToWait);
+void cfgstore_publish(CfgStore_t *pxStore);
+void cfgstore_cancel(CfgStore_t *pxStore);
+void cfgstore_get_stats(CfgStore_t *pxStore, CfgStoreStats_t *pxStats);
+#endif
+
+#endif /* CFGSTORE_H */
@@ -0,0 +1,1058 @@
+/*******************************************************************************
+ *
+ * @file	coro.hpp
+ * @brief	C++20 coroutines on FreeRTOS: a single-task executor, awaitable
+ * 			delays, byte streams and channels.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Header-only, on top of rtos.hpp. A Routine is a coroutine that
+ * 			runs on an Executor, one FreeRTOS task that resumes the
+ * 			routines in turn. A routine suspends at each co_await, so many
+ * 			I/O flows share the executor's stack, each written as straight
+ * 			line code:
+ *
+ * 				n = co_await rx.read(buf, 8, pdMS_TO_TICKS(100));
+ * 				co_await rtos::co::delay(pdMS_TO_TICKS(10));
+ * 				auto item = co_await channel.receive();
+ *
+ * 			Wakeups: an ISR or a task completing a wait puts its waiter on
+ * 			the executor's ready list and notifies the executor task at
+ * 			CO_NOTIFY_INDEX. Timeouts and delays are kept on a list sorted
+ * 			by deadline, and the executor blocks in ulTaskNotifyTake() until
+ * 			the earliest one. No kernel timer is used.
+ *
+ * 			Frames: every routine frame comes from a pool of CO_FRAMES
+ * 			blocks of CO_FRAME_BYTES, never from the heap. A routine whose
+ * 			frame does not fit fails to spawn; FramePool::largest() gives
+ * 			the largest frame requested so far, to size the blocks. The
+ * 			frame holds the locals that live across a co_await: keep large
+ * 			buffers in the objects the routines share instead.
+ *
+ * 			Rules:
+ * 			- Routines run in the executor task only; they must not call
+ * 			  blocking FreeRTOS APIs, which would stall every routine.
+ * 			- A Stream or a Channel has one reader at a time.
+ * 			- put_from_isr() and send_from_isr() are for ISRs at or below
+ * 			  configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ * 			- Delays and timeouts must be below portMAX_DELAY / 2 ticks.
+ *
+ * 			Needs a C++20 compiler (arm-none-eabi-g++ -std=c++20, with
+ * 			-fno-exceptions -fno-rtti) and configSUPPORT_STATIC_ALLOCATION 1.
+ *
+ ******************************************************************************/
+
+#ifndef CORO_HPP
+#define CORO_HPP
+
+/* Includes ------------------------------------------------------------------*/
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include "rtos.hpp"
+
+#if !defined(__cpp_impl_coroutine)
+#error coro.hpp needs C++20 coroutines (-std=c++20)
+#endif
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef CO_FRAMES
+#define CO_FRAMES 8U			/* Routines alive at once, at most 32. */
+#endif
+
+#ifndef CO_FRAME_BYTES
+#define CO_FRAME_BYTES 256U		/* Largest routine frame. */
+#endif
+
+#ifndef CO_NOTIFY_INDEX
+#define CO_NOTIFY_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+#endif
+
+namespace rtos
+{
+namespace co
+{
+
+/* Data types ----------------------------------------------------------------*/
+class ExecutorBase;
+
+/**
+ * @brief A suspended routine, queued on a source, on the timer list or on the
+ * ready list of its executor. It lives in the routine's frame.
+ * @note ucState goes from pending to done once, in a critical section, by
+ * whichever of the source and the timeout gets there first.
+ */
+struct Waiter
+{
+	static constexpr uint8_t PENDING = 0U;
+	static constexpr uint8_t DONE = 1U;
+
+	std::coroutine_handle<> xHandle;
+	ExecutorBase *pxExecutor = nullptr;
+	Waiter *pxNextReady = nullptr;
+	Waiter *pxNextTimer = nullptr;
+	TickType_t xDeadline = 0;
+	bool bTimed = false;					/* On the timer list. */
+	bool bTimedOut = false;
+	volatile uint8_t ucState = PENDING;
+	void (*pxCancel)(Waiter *) = nullptr;	/* Detaches from the source; in a critical section. */
+	void *pvSource = nullptr;
+};
+
+/**
+ * @brief Fixed-block storage for routine frames.
+ * @note Blocks are taken when a routine is created and given back when it
+ * ends, in task context, under a short critical section.
+ */
+class FramePool
+{
+	static_assert((CO_FRAMES > 0U) && (CO_FRAMES <= 32U), "CO_FRAMES must be 1 to 32");
+
+public:
+	static constexpr std::size_t ALIGN = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+	static constexpr std::size_t BLOCK_BYTES = (CO_FRAME_BYTES + ALIGN - 1U) & ~(ALIGN - 1U);
+
+	/**
+	 * @brief Takes a block for a frame of xSize bytes.
+	 * @param xSize Frame size, chosen by the compiler.
+	 * @retval The block, or nullptr if the pool is empty or the frame too big.
+	 */
+	static void *allocate(std::size_t xSize) noexcept
+	{
+		void *pvBlock = nullptr;
+
+		taskENTER_CRITICAL();
+		{
+			if (xSize > xLargest)
+			{
+				xLargest = xSize;
+			}
+
+			if ((xSize <= BLOCK_BYTES) && (ulFree != 0U))
+			{
+				const uint32_t ulIndex = static_cast<uint32_t>(__builtin_ctz(ulFree));
+
+				ulFree = ulFree & ~(1UL << ulIndex);
+				pvBlock = ucBlocks[ulIndex];
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return pvBlock;
+	}
+
+	/**
+	 * @brief Gives a block back.
+	 * @param pvBlock Block from allocate().
+	 * @retval None
+	 */
+	static void release(void *pvBlock) noexcept
+	{
+		const std::size_t xIndex =
+				static_cast<std::size_t>(static_cast<uint8_t *>(pvBlock) - ucBlocks[0]) / BLOCK_BYTES;
+
+		configASSERT(xIndex < CO_FRAMES);
+
+		taskENTER_CRITICAL();
+		{
+			ulFree = ulFree | (1UL << xIndex);
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	/**
+	 * @brief Returns the number of free blocks.
+	 * @param None
+	 * @retval Routines that can still be created.
+	 */
+	static UBaseType_t available() noexcept
+	{
+		return static_cast<UBaseType_t>(__builtin_popcount(ulFree));
+	}
+
+	/**
+	 * @brief Returns the largest frame requested, fitting or not.
+	 * @param None
+	 * @retval Bytes; CO_FRAME_BYTES must be at least this.
+	 */
+	static std::size_t largest() noexcept
+	{
+		return xLargest;
+	}
+
+private:
+	alignas(ALIGN) static inline uint8_t ucBlocks[CO_FRAMES][BLOCK_BYTES];
+	static inline volatile uint32_t ulFree =
+			(CO_FRAMES == 32U) ? 0xFFFFFFFFUL : ((1UL << CO_FRAMES) - 1UL);
+	static inline std::size_t xLargest = 0;
+};
+
+/**
+ * @brief A coroutine run by an Executor: 'rtos::co::Routine xFlow(...)'.
+ * @note Created suspended; Executor::spawn() starts it. Its frame is freed
+ * when it returns. A Routine that could not get a frame is empty, and
+ * spawn() refuses it.
+ */
+class Routine
+{
+public:
+	struct promise_type
+	{
+		Waiter xStart;
+
+		static void *operator new(std::size_t xSize) noexcept
+		{
+			return FramePool::allocate(xSize);
+		}
+
+		static void operator delete(void *pvFrame) noexcept
+		{
+			FramePool::release(pvFrame);
+		}
+
+		static Routine get_return_object_on_allocation_failure() noexcept
+		{
+			return Routine();
+		}
+
+		Routine get_return_object() noexcept
+		{
+			return Routine(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+
+		std::suspend_always initial_suspend() noexcept
+		{
+			return {};
+		}
+
+		std::suspend_never final_suspend() noexcept
+		{
+			return {};
+		}
+
+		void return_void() noexcept
+		{
+		}
+
+		void unhandled_exception() noexcept
+		{
+			configASSERT(0);
+		}
+	};
+
+	using Handle = std::coroutine_handle<promise_type>;
+
+	Routine() = default;
+
+	Routine(Routine &&xOther) noexcept : xHandle(xOther.xHandle)
+	{
+		xOther.xHandle = nullptr;
+	}
+
+	Routine(const Routine &) = delete;
+	Routine &operator=(const Routine &) = delete;
+	Routine &operator=(Routine &&) = delete;
+
+	/* A routine never spawned is destroyed with its handle. */
+	~Routine()
+	{
+		if (xHandle)
+		{
+			xHandle.destroy();
+		}
+	}
+
+	/**
+	 * @brief Tells whether the routine got a frame.
+	 * @param None
+	 * @retval true if it can be spawned.
+	 */
+	explicit operator bool() const noexcept
+	{
+		return static_cast<bool>(xHandle);
+	}
+
+private:
+	friend class ExecutorBase;
+
+	explicit Routine(Handle xHandle) : xHandle(xHandle)
+	{
+	}
+
+	Handle xHandle;
+};
+
+/**
+ * @brief The part of an Executor that does not depend on its stack size.
+ */
+class ExecutorBase
+{
+public:
+	ExecutorBase(const ExecutorBase &) = delete;
+	ExecutorBase &operator=(const ExecutorBase &) = delete;
+
+	/**
+	 * @brief Hands a routine to the executor, which starts it.
+	 * @param xRoutine Routine, empty afterwards.
+	 * @retval true if queued, false if the routine is empty.
+	 * @note Call from a task or a routine, before or after start().
+	 */
+	bool spawn(Routine &&xRoutine) noexcept
+	{
+		Routine::Handle xHandle = xRoutine.xHandle;
+
+		if (!xHandle)
+		{
+			return false;
+		}
+
+		xRoutine.xHandle = nullptr;
+
+		Waiter &xStart = xHandle.promise().xStart;
+		xStart.xHandle = xHandle;
+		xStart.pxExecutor = this;
+		xStart.ucState = Waiter::DONE;
+		post(&xStart);
+
+		return true;
+	}
+
+	/**
+	 * @brief Queues a completed waiter to be resumed (task context).
+	 * @param pxWaiter Waiter already marked done.
+	 * @retval None
+	 */
+	void post(Waiter *pxWaiter) noexcept
+	{
+		taskENTER_CRITICAL();
+		{
+			prvPushReady(pxWaiter);
+		}
+		taskEXIT_CRITICAL();
+
+		if (xExecutorTask != nullptr)
+		{
+			(void)xTaskNotifyGiveIndexed(xExecutorTask, CO_NOTIFY_INDEX);
+		}
+	}
+
+	/**
+	 * @brief Queues a completed waiter to be resumed (ISR context).
+	 * @param pxWaiter Waiter already marked done.
+	 * @param pxHigherPriorityTaskWoken Set to pdTRUE if the executor task
+	 * should run before the interrupted one.
+	 * @retval None
+	 */
+	void post_from_isr(Waiter *pxWaiter, BaseType_t *pxHigherPriorityTaskWoken) noexcept
+	{
+		const UBaseType_t uxSaved = taskENTER_CRITICAL_FROM_ISR();
+		{
+			prvPushReady(pxWaiter);
+		}
+		taskEXIT_CRITICAL_FROM_ISR(uxSaved);
+
+		if (xExecutorTask != nullptr)
+		{
+			vTaskNotifyGiveIndexedFromISR(xExecutorTask, CO_NOTIFY_INDEX, pxHigherPriorityTaskWoken);
+		}
+	}
+
+	/**
+	 * @brief Arms the timeout of a waiter (executor task only).
+	 * @param pxWaiter Waiter about to suspend.
+	 * @param xTicksToWait Ticks from now; portMAX_DELAY for none.
+	 * @retval None
+	 */
+	void add_timer(Waiter *pxWaiter, TickType_t xTicksToWait) noexcept
+	{
+		if (xTicksToWait == portMAX_DELAY)
+		{
+			return;
+		}
+
+		const TickType_t xNow = xTaskGetTickCount();
+		Waiter **ppxLink = &pxTimers;
+
+		pxWaiter->xDeadline = xNow + xTicksToWait;
+		pxWaiter->bTimed = true;
+
+		/* Sorted by the time left, which does not wrap around. */
+		while ((*ppxLink != nullptr)
+				&& (static_cast<TickType_t>((*ppxLink)->xDeadline - xNow) <= xTicksToWait))
+		{
+			ppxLink = &(*ppxLink)->pxNextTimer;
+		}
+
+		pxWaiter->pxNextTimer = *ppxLink;
+		*ppxLink = pxWaiter;
+	}
+
+	/**
+	 * @brief Returns the executor task.
+	 * @param None
+	 * @retval The task handle, NULL before start().
+	 */
+	TaskHandle_t handle() const noexcept
+	{
+		return xExecutorTask;
+	}
+
+protected:
+	ExecutorBase() = default;
+
+	/* Body of the executor task. */
+	static void prvRun(void *pvParameters)
+	{
+		static_cast<ExecutorBase *>(pvParameters)->prvLoop();
+	}
+
+	TaskHandle_t xExecutorTask = nullptr;
+
+private:
+	static constexpr TickType_t HALF_RANGE = (portMAX_DELAY >> 1) + 1U;
+
+	void prvLoop()
+	{
+		for (;;)
+		{
+			Waiter *pxWaiter;
+
+			while ((pxWaiter = prvPopReady()) != nullptr)
+			{
+				prvRemoveTimer(pxWaiter);
+				pxWaiter->xHandle.resume();
+			}
+
+			const TickType_t xNow = xTaskGetTickCount();
+			bool bExpired = false;
+
+			/* A deadline at or before now is less than half the range behind. */
+			while ((pxTimers != nullptr)
+					&& (static_cast<TickType_t>(xNow - pxTimers->xDeadline) < HALF_RANGE))
+			{
+				pxWaiter = pxTimers;
+				pxTimers = pxWaiter->pxNextTimer;
+				pxWaiter->bTimed = false;
+				prvExpire(pxWaiter);
+				bExpired = true;
+			}
+
+			/* Expired waiters may have made others ready. */
+			if (bExpired)
+			{
+				continue;
+			}
+
+			const TickType_t xWait = (pxTimers != nullptr)
+					? static_cast<TickType_t>(pxTimers->xDeadline - xNow) : portMAX_DELAY;
+
+			(void)ulTaskNotifyTakeIndexed(CO_NOTIFY_INDEX, pdTRUE, xWait);
+		}
+	}
+
+	/* Resumes a timed-out waiter, unless its source completed it first, in
+	 * which case it is already on the ready list. */
+	void prvExpire(Waiter *pxWaiter)
+	{
+		bool bResume = false;
+
+		taskENTER_CRITICAL();
+		{
+			if (pxWaiter->ucState == Waiter::PENDING)
+			{
+				pxWaiter->ucState = Waiter::DONE;
+				pxWaiter->bTimedOut = true;
+
+				if (pxWaiter->pxCancel != nullptr)
+				{
+					pxWaiter->pxCancel(pxWaiter);
+				}
+
+				bResume = true;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if (bResume)
+		{
+			pxWaiter->xHandle.resume();
+		}
+	}
+
+	void prvRemoveTimer(Waiter *pxWaiter)
+	{
+		if (!pxWaiter->bTimed)
+		{
+			return;
+		}
+
+		Waiter **ppxLink = &pxTimers;
+
+		while (*ppxLink != pxWaiter)
+		{
+			ppxLink = &(*ppxLink)->pxNextTimer;
+		}
+
+		*ppxLink = pxWaiter->pxNextTimer;
+		pxWaiter->bTimed = false;
+	}
+
+	/* In a critical section. */
+	void prvPushReady(Waiter *pxWaiter)
+	{
+		pxWaiter->pxNextReady = nullptr;
+
+		if (pxReadyTail == nullptr)
+		{
+			pxReadyHead = pxWaiter;
+		}
+		else
+		{
+			pxReadyTail->pxNextReady = pxWaiter;
+		}
+
+		pxReadyTail = pxWaiter;
+	}
+
+	Waiter *prvPopReady()
+	{
+		Waiter *pxWaiter;
+
+		taskENTER_CRITICAL();
+		{
+			pxWaiter = pxReadyHead;
+
+			if (pxWaiter != nullptr)
+			{
+				pxReadyHead = pxWaiter->pxNextReady;
+
+				if (pxReadyHead == nullptr)
+				{
+					pxReadyTail = nullptr;
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return pxWaiter;
+	}
+
+	Waiter *pxReadyHead = nullptr;			/* Shared with ISRs and tasks. */
+	Waiter *pxReadyTail = nullptr;
+	Waiter *pxTimers = nullptr;				/* Executor task only. */
+};
+
+/**
+ * @brief An executor task with a stack of StackWords words.
+ */
+template <configSTACK_DEPTH_TYPE StackWords>
+class Executor : public ExecutorBase
+{
+public:
+	Executor() = default;
+
+	/**
+	 * @brief Creates the executor task.
+	 * @param pcName Name, for debugging.
+	 * @param uxPriority Priority, shared by all its routines.
+	 * @retval true if created, false if already started.
+	 */
+	bool start(const char *pcName, UBaseType_t uxPriority) noexcept
+	{
+		if (!xTask.start(prvRun, pcName, uxPriority, static_cast<ExecutorBase *>(this)))
+		{
+			return false;
+		}
+
+		xExecutorTask = xTask.handle();
+
+		/* Routines spawned before start() are already on the ready list. */
+		(void)xTaskNotifyGiveIndexed(xExecutorTask, CO_NOTIFY_INDEX);
+
+		return true;
+	}
+
+private:
+	Task<StackWords> xTask;
+};
+
+/**
+ * @brief Common part of the awaiters: finds the executor of the routine.
+ */
+class AwaiterBase
+{
+protected:
+	void prvPrepare(Routine::Handle xHandle) noexcept
+	{
+		xWaiter.xHandle = xHandle;
+		xWaiter.pxExecutor = xHandle.promise().xStart.pxExecutor;
+		xWaiter.ucState = Waiter::PENDING;
+		xWaiter.bTimedOut = false;
+	}
+
+	Waiter xWaiter;
+};
+
+/**
+ * @brief Awaiter of delay().
+ */
+class DelayAwaiter : public AwaiterBase
+{
+public:
+	explicit DelayAwaiter(TickType_t xTicks) noexcept : xTicks(xTicks)
+	{
+	}
+
+	bool await_ready() const noexcept
+	{
+		return xTicks == 0U;
+	}
+
+	void await_suspend(Routine::Handle xHandle) noexcept
+	{
+		prvPrepare(xHandle);
+		xWaiter.pxExecutor->add_timer(&xWaiter, xTicks);
+	}
+
+	void await_resume() const noexcept
+	{
+	}
+
+private:
+	TickType_t xTicks;
+};
+
+/**
+ * @brief Suspends the routine for xTicks ticks: 'co_await delay(ticks)'.
+ * @param xTicks Ticks, below portMAX_DELAY / 2; 0 does not suspend.
+ * @retval The awaiter.
+ */
+inline DelayAwaiter delay(TickType_t xTicks) noexcept
+{
+	return DelayAwaiter(xTicks);
+}
+
+/**
+ * @brief A byte stream from an ISR (or a task) to one routine.
+ * @note The UART RX interrupt of a driver calls put_from_isr() with each
+ * byte; the routine reads whole messages with 'co_await read(buf, n, t)'.
+ * Bytes put while the ring is full are dropped.
+ */
+template <uint32_t Size>
+class Stream
+{
+	static_assert((Size != 0U) && ((Size & (Size - 1U)) == 0U), "Size must be a power of two");
+
+public:
+	Stream() = default;
+
+	Stream(const Stream &) = delete;
+	Stream &operator=(const Stream &) = delete;
+
+	class ReadAwaiter : public AwaiterBase
+	{
+	public:
+		ReadAwaiter(Stream &xStream, uint8_t *pucData, uint32_t ulLen, TickType_t xTicksToWait) noexcept
+			: xStream(xStream), pucData(pucData), ulLen(ulLen), xTicksToWait(xTicksToWait)
+		{
+		}
+
+		bool await_ready() const noexcept
+		{
+			return (ulLen == 0U) || (xStream.count() >= ulLen);
+		}
+
+		bool await_suspend(Routine::Handle xHandle) noexcept
+		{
+			prvPrepare(xHandle);
+			xWaiter.pxCancel = prvCancel;
+			xWaiter.pvSource = &xStream;
+
+			taskENTER_CRITICAL();
+			{
+				if ((xStream.ulHead - xStream.ulTail) >= ulLen)
+				{
+					taskEXIT_CRITICAL();
+					return false;
+				}
+
+				configASSERT(xStream.pxReader == nullptr);
+				xStream.pxReader = &xWaiter;
+				xStream.ulWanted = ulLen;
+			}
+			taskEXIT_CRITICAL();
+
+			xWaiter.pxExecutor->add_timer(&xWaiter, xTicksToWait);
+
+			return true;
+		}
+
+		/* ulLen bytes, or those that came before the timeout. */
+		uint32_t await_resume() noexcept
+		{
+			return xStream.prvRead(pucData, ulLen);
+		}
+
+	private:
+		static void prvCancel(Waiter *pxWaiter)
+		{
+			static_cast<Stream *>(pxWaiter->pvSource)->pxReader = nullptr;
+		}
+
+		Stream &xStream;
+		uint8_t *pucData;
+		uint32_t ulLen;
+		TickType_t xTicksToWait;
+	};
+
+	/**
+	 * @brief Waits for ulLen bytes and reads them.
+	 * @param pucData Receives the bytes; must outlive the co_await.
+	 * @param ulLen Bytes, at most Size.
+	 * @param xTicksToWait Ticks to wait for all of them.
+	 * @retval Awaiter; co_await gives the number of bytes read, ulLen unless
+	 * the wait timed out.
+	 */
+	ReadAwaiter read(uint8_t *pucData, uint32_t ulLen, TickType_t xTicksToWait = portMAX_DELAY) noexcept
+	{
+		configASSERT(ulLen <= Size);
+		return ReadAwaiter(*this, pucData, ulLen, xTicksToWait);
+	}
+
+	/**
+	 * @brief Appends bytes (ISR context).
+	 * @param pucData Bytes.
+	 * @param ulLen Number of bytes.
+	 * @param pxHigherPriorityTaskWoken Set to pdTRUE if the executor task
+	 * should run before the interrupted one.
+	 * @retval Bytes stored; the rest did not fit.
+	 */
+	uint32_t put_from_isr(const uint8_t *pucData, uint32_t ulLen,
+			BaseType_t *pxHigherPriorityTaskWoken) noexcept
+	{
+		Waiter *pxWaiter;
+		uint32_t ulStored;
+
+		const UBaseType_t uxSaved = taskENTER_CRITICAL_FROM_ISR();
+		{
+			ulStored = prvPut(pucData, ulLen);
+			pxWaiter = prvTakeReader();
+		}
+		taskEXIT_CRITICAL_FROM_ISR(uxSaved);
+
+		if (pxWaiter != nullptr)
+		{
+			pxWaiter->pxExecutor->post_from_isr(pxWaiter, pxHigherPriorityTaskWoken);
+		}
+
+		return ulStored;
+	}
+
+	/**
+	 * @brief Appends bytes (task or routine context).
+	 * @param pucData Bytes.
+	 * @param ulLen Number of bytes.
+	 * @retval Bytes stored; the rest did not fit.
+	 */
+	uint32_t put(const uint8_t *pucData, uint32_t ulLen) noexcept
+	{
+		Waiter *pxWaiter;
+		uint32_t ulStored;
+
+		taskENTER_CRITICAL();
+		{
+			ulStored = prvPut(pucData, ulLen);
+			pxWaiter = prvTakeReader();
+		}
+		taskEXIT_CRITICAL();
+
+		if (pxWaiter != nullptr)
+		{
+			pxWaiter->pxExecutor->post(pxWaiter);
+		}
+
+		return ulStored;
+	}
+
+	/**
+	 * @brief Returns the number of bytes waiting.
+	 * @param None
+	 * @retval Bytes the reader can take.
+	 */
+	uint32_t count() const noexcept
+	{
+		return ulHead - ulTail;
+	}
+
+private:
+	/* In a critical section. */
+	uint32_t prvPut(const uint8_t *pucData, uint32_t ulLen)
+	{
+		uint32_t ulFree = Size - (ulHead - ulTail);
+		uint32_t i;
+
+		if (ulLen > ulFree)
+		{
+			ulLen = ulFree;
+		}
+
+		for (i = 0; i < ulLen; i++)
+		{
+			ucBuffer[(ulHead + i) & (Size - 1U)] = pucData[i];
+		}
+
+		ulHead = ulHead + ulLen;
+
+		return ulLen;
+	}
+
+	/* In a critical section: the reader, if it now has its bytes. */
+	Waiter *prvTakeReader()
+	{
+		Waiter *pxWaiter = pxReader;
+
+		if ((pxWaiter == nullptr) || ((ulHead - ulTail) < ulWanted))
+		{
+			return nullptr;
+		}
+
+		pxReader = nullptr;
+		pxWaiter->ucState = Waiter::DONE;
+
+		return pxWaiter;
+	}
+
+	uint32_t prvRead(uint8_t *pucData, uint32_t ulLen)
+	{
+		uint32_t i;
+
+		taskENTER_CRITICAL();
+		{
+			const uint32_t ulCount = ulHead - ulTail;
+
+			if (ulLen > ulCount)
+			{
+				ulLen = ulCount;
+			}
+
+			for (i = 0; i < ulLen; i++)
+			{
+				pucData[i] = ucBuffer[(ulTail + i) & (Size - 1U)];
+			}
+
+			ulTail = ulTail + ulLen;
+		}
+		taskEXIT_CRITICAL();
+
+		return ulLen;
+	}
+
+	uint8_t ucBuffer[Size];
+	volatile uint32_t ulHead = 0;			/* Free-running. */
+	volatile uint32_t ulTail = 0;
+	Waiter *pxReader = nullptr;
+	uint32_t ulWanted = 0;
+};
+
+/**
+ * @brief A queue of up to N items of type T from ISRs and tasks to one
+ * routine: 'auto item = co_await channel.receive(timeout)'.
+ * @note Senders never block: a send to a full channel fails.
+ */
+template <typename T, uint32_t N>
+class Channel
+{
+	static_assert(N > 0U, "a channel holds at least one item");
+	static_assert(std::is_trivially_copyable<T>::value, "items are copied like queue items");
+
+public:
+	Channel() = default;
+
+	Channel(const Channel &) = delete;
+	Channel &operator=(const Channel &) = delete;
+
+	class ReceiveAwaiter : public AwaiterBase
+	{
+	public:
+		ReceiveAwaiter(Channel &xChannel, TickType_t xTicksToWait) noexcept
+			: xChannel(xChannel), xTicksToWait(xTicksToWait)
+		{
+		}
+
+		bool await_ready() const noexcept
+		{
+			return xChannel.uxCount != 0U;
+		}
+
+		bool await_suspend(Routine::Handle xHandle) noexcept
+		{
+			prvPrepare(xHandle);
+			xWaiter.pxCancel = prvCancel;
+			xWaiter.pvSource = &xChannel;
+
+			taskENTER_CRITICAL();
+			{
+				if (xChannel.uxCount != 0U)
+				{
+					taskEXIT_CRITICAL();
+					return false;
+				}
+
+				configASSERT(xChannel.pxReceiver == nullptr);
+				xChannel.pxReceiver = &xWaiter;
+			}
+			taskEXIT_CRITICAL();
+
+			xWaiter.pxExecutor->add_timer(&xWaiter, xTicksToWait);
+
+			return true;
+		}
+
+		/* The item, or nothing if the wait timed out. */
+		std::optional<T> await_resume() noexcept
+		{
+			return xChannel.prvTake();
+		}
+
+	private:
+		static void prvCancel(Waiter *pxWaiter)
+		{
+			static_cast<Channel *>(pxWaiter->pvSource)->pxReceiver = nullptr;
+		}
+
+		Channel &xChannel;
+		TickType_t xTicksToWait;
+	};
+
+	/**
+	 * @brief Waits for an item.
+	 * @param xTicksToWait Ticks to wait.
+	 * @retval Awaiter; co_await gives the item, or std::nullopt on timeout.
+	 */
+	ReceiveAwaiter receive(TickType_t xTicksToWait = portMAX_DELAY) noexcept
+	{
+		return ReceiveAwaiter(*this, xTicksToWait);
+	}
+
+	/**
+	 * @brief Sends an item (task or routine context).
+	 * @param xItem Item, copied into the channel.
+	 * @retval true if sent, false if the channel is full.
+	 */
+	bool send(const T &xItem) noexcept
+	{
+		Waiter *pxWaiter;
+		bool bSent;
+
+		taskENTER_CRITICAL();
+		{
+			bSent = prvPut(xItem);
+			pxWaiter = prvTakeReceiver();
+		}
+		taskEXIT_CRITICAL();
+
+		if (pxWaiter != nullptr)
+		{
+			pxWaiter->pxExecutor->post(pxWaiter);
+		}
+
+		return bSent;
+	}
+
+	/**
+	 * @brief Sends an item (ISR context).
+	 * @param xItem Item, copied into the channel.
+	 * @param pxHigherPriorityTaskWoken Set to pdTRUE if the executor task
+	 * should run before the interrupted one.
+	 * @retval true if sent, false if the channel is full.
+	 */
+	bool send_from_isr(const T &xItem, BaseType_t *pxHigherPriorityTaskWoken) noexcept
+	{
+		Waiter *pxWaiter;
+		bool bSent;
+
+		const UBaseType_t uxSaved = taskENTER_CRITICAL_FROM_ISR();
+		{
+			bSent = prvPut(xItem);
+			pxWaiter = prvTakeReceiver();
+		}
+		taskEXIT_CRITICAL_FROM_ISR(uxSaved);
+
+		if (pxWaiter != nullptr)
+		{
+			pxWaiter->pxExecutor->post_from_isr(pxWaiter, pxHigherPriorityTaskWoken);
+		}
+
+		return bSent;
+	}
+
+	/**
+	 * @brief Returns the number of items waiting.
+	 * @param None
+	 * @retval Items the receiver can take.
+	 */
+	uint32_t waiting() const noexcept
+	{
+		return uxCount;
+	}
+
+private:
+	/* In a critical section. */
+	bool prvPut(const T &xItem)
+	{
+		if (uxCount == N)
+		{
+			return false;
+		}
+
+		xItems[(uxFirst + uxCount) % N] = xItem;
+		uxCount = uxCount + 1U;
+
+		return true;
+	}
+
+	/* In a critical section. */
+	Waiter *prvTakeReceiver()
+	{
+		Waiter *pxWaiter = pxReceiver;
+
+		if ((pxWaiter == nullptr) || (uxCount == 0U))
+		{
+			return nullptr;
+		}
+
+		pxReceiver = nullptr;
+		pxWaiter->ucState = Waiter::DONE;
+
+		return pxWaiter;
+	}
+
+	std::optional<T> prvTake()
+	{
+		std::optional<T> xItem;
+
+		taskENTER_CRITICAL();
+		{
+			if (uxCount != 0U)
+			{
+				xItem = xItems[uxFirst];
+				uxFirst = (uxFirst + 1U) % N;
+				uxCount = uxCount - 1U;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xItem;
+	}
+
+	T xItems[N];
+	uint32_t uxFirst = 0;
+	volatile uint32_t uxCount = 0;
+	Waiter *pxReceiver = nullptr;
+};
+
+} /* namespace co */
+} /* namespace rtos */
+
+#endif /* CORO_HPP */
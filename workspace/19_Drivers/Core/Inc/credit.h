@@ -0,0 +1,142 @@
+/*******************************************************************************
+ *
+ * @file	credit.h
+ * @brief	Credit-based flow control between one producer and one consumer.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	The consumer lends the producer a window of credits, one per item
+ * 			it can take without falling behind (e.g. its queue slots). The
+ * 			producer spends a credit per item it sends and checks what is
+ * 			left with two loads, no kernel call, before it even produces
+ * 			the item. With no credit left it can skip the item or slow down
+ * 			instead of blocking on, or dropping at, a full queue.
+ *
+ * 			The consumer returns the credits of the items it has finished
+ * 			with in batches: credit_consumed() counts them and
+ * 			credit_grant() hands them back once a batch has built up, so a
+ * 			fast producer is not woken up, nor its cache line touched, per
+ * 			item.
+ *
+ * 			'ulGranted' only ever grows and is written by the consumer only;
+ * 			'ulUsed' likewise by the producer only. The credit left is their
+ * 			difference, which wraps correctly, so neither side takes a lock.
+ *
+ ******************************************************************************/
+
+#ifndef CREDIT_H
+#define CREDIT_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	volatile uint32_t ulGranted;		/* Credits ever granted, the window included. */
+	volatile uint32_t ulUsed;			/* Credits ever spent. */
+	uint32_t ulWindow;					/* Items in flight at most. */
+	uint32_t ulConsumed;				/* Consumer only: not yet granted back. */
+} Credit_t;
+
+/* Function definitions ------------------------------------------------------*/
+
+/**
+ * @brief Initializes a credit link with the whole window available.
+ * @param pxCredit Credit link to initialize.
+ * @param ulWindow Items the consumer can hold for the producer, at least 1.
+ * @retval 0 if successful, -1 otherwise.
+ */
+static inline int32_t credit_init(Credit_t *pxCredit, uint32_t ulWindow)
+{
+	if ((pxCredit == NULL) || (ulWindow == 0U))
+	{
+		return -1;
+	}
+
+	pxCredit->ulGranted = ulWindow;
+	pxCredit->ulUsed = 0;
+	pxCredit->ulWindow = ulWindow;
+	pxCredit->ulConsumed = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Returns the credits the producer has left (producer side).
+ * @param pxCredit Credit link.
+ * @retval Items the producer may send now, up to the window.
+ */
+static inline uint32_t credit_available(const Credit_t *pxCredit)
+{
+	return pxCredit->ulGranted - pxCredit->ulUsed;
+}
+
+/**
+ * @brief Spends credits for items about to be sent (producer side).
+ * @param pxCredit Credit link.
+ * @param ulCount Number of items.
+ * @retval 0 if the credits were spent, -1 if fewer are left.
+ */
+static inline int32_t credit_take(Credit_t *pxCredit, uint32_t ulCount)
+{
+	if (credit_available(pxCredit) < ulCount)
+	{
+		return -1;
+	}
+
+	pxCredit->ulUsed += ulCount;
+
+	return 0;
+}
+
+/**
+ * @brief Gives back credits taken for items that were not sent after all
+ * (producer side).
+ * @param pxCredit Credit link.
+ * @param ulCount Number of items, at most those taken.
+ * @retval None
+ */
+static inline void credit_refund(Credit_t *pxCredit, uint32_t ulCount)
+{
+	pxCredit->ulUsed -= ulCount;
+}
+
+/**
+ * @brief Counts items the consumer has finished with (consumer side).
+ * @param pxCredit Credit link.
+ * @param ulCount Number of items.
+ * @retval None
+ * @note Their credits go back to the producer at the next credit_grant().
+ */
+static inline void credit_consumed(Credit_t *pxCredit, uint32_t ulCount)
+{
+	pxCredit->ulConsumed += ulCount;
+}
+
+/**
+ * @brief Grants the consumed items back to the producer once there are at
+ * least ulBatch of them (consumer side).
+ * @param pxCredit Credit link.
+ * @param ulBatch Smallest grant. 1 grants whatever has been consumed, e.g.
+ * when the consumer goes idle; a batch above the window only grants then.
+ * @retval Credits granted, 0 if the batch was not reached.
+ */
+static inline uint32_t credit_grant(Credit_t *pxCredit, uint32_t ulBatch)
+{
+	const uint32_t ulConsumed = pxCredit->ulConsumed;
+
+	if ((ulConsumed == 0U) || (ulConsumed < ulBatch))
+	{
+		return 0;
+	}
+
+	/* The items must be done with before the producer may reuse their room. */
+	__DMB();
+	pxCredit->ulGranted += ulConsumed;
+	pxCredit->ulConsumed = 0;
+
+	return ulConsumed;
+}
+
+#endif /* CREDIT_H */
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ *
+ * @file	csprof.h
+ * @brief	Interface of the critical section profiler.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Included at the end of 'FreeRTOSConfig.h', so that the trace hooks
+ * 			below replace the empty defaults of 'FreeRTOS.h'.
+ *
+ * 			Only <stdint.h> may be included here: this header is read before
+ * 			any FreeRTOS type is defined.
+ *
+ ******************************************************************************/
+
+#ifndef CSPROF_H
+#define CSPROF_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef CSPROF_SLOTS
+#define CSPROF_SLOTS 64U			/* Call sites per table, a power of two; 16 bytes each. */
+#endif
+
+#ifndef CSPROF_PROBES
+#define CSPROF_PROBES 8U			/* Slots tried before a section is lost. */
+#endif
+
+#ifndef CSPROF_REPORTER_STACK_WORDS
+#define CSPROF_REPORTER_STACK_WORDS 384U	/* printf() needs the headroom. */
+#endif
+
+/* Kernel hooks, only installed when read from 'FreeRTOSConfig.h', ahead of
+ * the empty defaults of 'FreeRTOS.h' (traceSTART() is one of them). */
+#ifndef traceSTART
+#define traceENTER_CRITICAL_SECTION(pvCaller)	csprof_critical_enter(pvCaller)
+#define traceEXIT_CRITICAL_SECTION()			csprof_critical_exit()
+#define traceSCHEDULER_SUSPENDED(pvCaller)		csprof_scheduler_suspended(pvCaller)
+#define traceSCHEDULER_RESUMED()				csprof_scheduler_resumed()
+#endif /* traceSTART */
+
+/* Function Prototypes -------------------------------------------------------*/
+void csprof_start(void);
+void csprof_stop(void);
+void csprof_reset(void);
+void csprof_dump(void);
+int32_t csprof_start_reporter(uint32_t ulPeriodMs, uint32_t ulPriority);
+
+/* Hooked in FreeRTOSConfig.h. */
+void csprof_critical_enter(void *pvCaller);
+void csprof_critical_exit(void);
+void csprof_scheduler_suspended(void *pvCaller);
+void csprof_scheduler_resumed(void);
+
+#endif /* CSPROF_H */
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ * @file	dma.h
+ * @brief	Interface of the DMA stream manager.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef DMA_H
+#define DMA_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "xfer.h"
+
+/* Macros --------------------------------------------------------------------*/
+/* Bit of a stream in DMA_FIXED_STREAMS: DMA1 in bits 0 to 7, DMA2 above. */
+#define DMA_STREAM_BIT(ulDma, ulStream) (1U << ((((ulDma) - 1U) * 8U) + (ulStream)))
+
+#define DMA_PL_LOW			0U
+#define DMA_PL_MEDIUM		1U
+#define DMA_PL_HIGH			2U
+#define DMA_PL_VERY_HIGH	3U
+
+#define DMA_MAX_ITEMS			0xFFFFU		/* Per descriptor (NDTR). */
+
+#ifndef DMA_IRQ_PRIORITY
+#define DMA_IRQ_PRIORITY 6U			/* At or below configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+#endif
+
+/* Bytes per second each controller is trusted to move for the streams it
+ * serves, against which dma_alloc() checks their declared bandwidth. About a
+ * fifth of what one controller moves at 180 MHz, leaving room for the CPU on
+ * the bus matrix. */
+#ifndef DMA_BANDWIDTH_BUDGET
+#define DMA_BANDWIDTH_BUDGET 36000000U
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+/* Peripheral requests the manager can serve, from the F446 request tables. */
+typedef enum
+{
+	DMA_REQ_MEM_TO_MEM = 0,			/* DMA2 only. */
+	DMA_REQ_SPI1_RX,
+	DMA_REQ_SPI1_TX,
+	DMA_REQ_SPI2_RX,
+	DMA_REQ_SPI2_TX,
+	DMA_REQ_SPI3_RX,
+	DMA_REQ_SPI3_TX,
+	DMA_REQ_I2C1_RX,
+	DMA_REQ_I2C1_TX,
+	DMA_REQ_I2C2_RX,
+	DMA_REQ_I2C2_TX,
+	DMA_REQ_I2C3_RX,
+	DMA_REQ_I2C3_TX,
+	DMA_REQ_SDIO,					/* Words, flow controlled by the SDIO. */
+	DMA_REQ_TIM2_CH1,				/* Capture or compare, CCR1. */
+	DMA_REQ_TIM2_CH2,
+	DMA_REQ_TIM2_CH3,
+	DMA_REQ_TIM2_CH4,
+	DMA_REQ_TIM1_UP,				/* Update event, for TIM1 DMA bursts. */
+	DMA_REQ_COUNT
+} DmaRequest_t;
+
+typedef enum
+{
+	DMA_DIR_P2M = 0,				/* Peripheral to memory. */
+	DMA_DIR_M2P,					/* Memory to peripheral. */
+	DMA_DIR_M2M						/* Memory to memory, from the peripheral side. */
+} DmaDir_t;
+
+typedef struct
+{
+	DmaRequest_t xRequest;
+	DmaDir_t xDir;
+	uint8_t ucPriority;				/* DMA_PRIORITY_... */
+	uint8_t ucItemSize;				/* 1, 2 or 4 bytes, on both sides. */
+	uint8_t ucPeriphInc;			/* Increment the peripheral address. */
+	uint8_t ucMemInc;				/* Increment the memory address. */
+	volatile void *pvPeriph;		/* Default peripheral address, e.g. &SPI1->DR. */
+	uint32_t ulBandwidth;			/* Bytes per second at most, 0 if unknown. */
+} DmaConfig_t;
+
+/* One transfer of a chain. xReq must stay first. */
+typedef struct
+{
+	XferReq_t xReq;					/* pvData: memory side, ulLen: items. */
+	volatile void *pvPeriph;		/* NULL for the stream's, the source for memory to memory. */
+} DmaDesc_t;
+
+typedef struct
+{
+	uint32_t ulBytes;				/* Moved by completed descriptors. */
+	uint32_t ulDescs;				/* Descriptors completed. */
+	uint32_t ulChained;				/* Started from the TC interrupt of the one before. */
+	uint32_t ulErrors;				/* Transfer or direct mode errors. */
+} DmaStats_t;
+
+typedef struct DmaStream DmaStream_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t dma_alloc(const DmaConfig_t *pxCfg, DmaStream_t **ppxStream);
+void dma_free(DmaStream_t *pxStream);
+void dma_desc_init(DmaDesc_t *pxDesc, volatile void *pvPeriph, void *pvMem, uint32_t ulItems);
+int32_t dma_submit(DmaStream_t *pxStream, DmaDesc_t *pxDesc);
+void dma_abort(DmaStream_t *pxStream);
+int32_t dma_start_ring(DmaStream_t *pxStream, void *pvMem, uint32_t ulItems);
+uint32_t dma_get_remaining(const DmaStream_t *pxStream);
+void dma_get_stats(const DmaStream_t *pxStream, DmaStats_t *pxStats);
+uint32_t dma_get_bandwidth(uint32_t ulDma);
+
+#endif /* DMA_H */
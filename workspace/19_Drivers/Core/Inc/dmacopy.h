@@ -0,0 +1,42 @@
+/*******************************************************************************
+ *
+ * @file	dmacopy.h
+ * @brief	Interface of the DMA memory copy service.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef DMACOPY_H
+#define DMACOPY_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+#include "dma.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef DMACOPY_MIN_BYTES
+#define DMACOPY_MIN_BYTES 1024U		/* Shorter copies are done by the CPU. */
+#endif
+
+#ifndef DMACOPY_PRIORITY
+#define DMACOPY_PRIORITY DMA_PL_LOW	/* Below the peripherals' streams. */
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulDmaBytes;			/* Copied by the DMA. */
+	uint32_t ulCpuBytes;			/* Of copies of DMACOPY_MIN_BYTES or more, by the CPU. */
+	uint32_t ulDmaCopies;
+} DmaCopyStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t dmacopy_init(void);
+void *dmacopy(void *pvDest, const void *pvSrc, size_t xLen);
+int32_t dmacopy_prepare(DmaDesc_t *pxDesc, void *pvDest, const void *pvSrc, size_t xLen);
+int32_t dmacopy_submit(DmaDesc_t *pxDesc);
+void dmacopy_get_stats(DmaCopyStats_t *pxStats);
+
+#endif /* DMACOPY_H */
@@ -0,0 +1,35 @@
+/*******************************************************************************
+ *
+ * @file	fat.h
+ * @brief	Interface of the FAT32 file writer.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef FAT_H
+#define FAT_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Data types ----------------------------------------------------------------*/
+/* A file in the root directory, its clusters contiguous. */
+typedef struct
+{
+	uint32_t ulFirstCluster;
+	uint32_t ulClusters;			/* Allocated. */
+	uint32_t ulLba;					/* First sector. */
+	uint32_t ulDirLba;				/* Sector of its directory entry. */
+	uint32_t ulDirOffset;			/* Byte offset of the entry in that sector. */
+	uint32_t ulSize;				/* Bytes, as recorded in the entry. */
+} FatFile_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t fat_mount(void);
+int32_t fat_create_contiguous(FatFile_t *pxFile, const char *pcName, uint32_t ulBytes);
+int32_t fat_set_size(FatFile_t *pxFile, uint32_t ulSize);
+int32_t fat_truncate(FatFile_t *pxFile, uint32_t ulSize);
+uint32_t fat_get_cluster_bytes(void);
+
+#endif /* FAT_H */
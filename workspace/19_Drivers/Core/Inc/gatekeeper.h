@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ * @file	gatekeeper.h
+ * @brief	Interface of the reusable gatekeeper task.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef GATEKEEPER_H
+#define GATEKEEPER_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "credit.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef GATEKEEPER_QUEUE_LENGTH
+#define GATEKEEPER_QUEUE_LENGTH 8U		/* Requests waiting for the gatekeeper. */
+#endif
+
+#ifndef GATEKEEPER_REQUEST_BYTES
+#define GATEKEEPER_REQUEST_BYTES 64U	/* Longer writes are split. */
+#endif
+
+#ifndef GATEKEEPER_BATCH
+#define GATEKEEPER_BATCH 8U				/* Requests drained per wakeup. */
+#endif
+
+#ifndef GATEKEEPER_STAGING_BYTES
+#define GATEKEEPER_STAGING_BYTES 256U	/* Largest merged transaction. */
+#endif
+
+#ifndef GATEKEEPER_PRODUCERS
+#define GATEKEEPER_PRODUCERS 4U			/* Producers with a credit window. */
+#endif
+
+#ifndef GATEKEEPER_CREDIT_BATCH
+#define GATEKEEPER_CREDIT_BATCH 2U		/* Smallest grant while requests wait. */
+#endif
+
+#ifndef GATEKEEPER_STACK_WORDS
+#define GATEKEEPER_STACK_WORDS 256U		/* Includes the write function. */
+#endif
+
+/* Address of a request to a stream peripheral (UART): every such request
+ * continues the previous one. */
+#define GATEKEEPER_ADDRESS_STREAM 0xFFFFFFFFUL
+
+/* Data types ----------------------------------------------------------------*/
+
+/* Performs one transaction with the resource. Returns 0 if successful. The
+ * data is only valid until it returns. */
+typedef int32_t (*GatekeeperWrite_t)(void *pvContext, uint32_t ulAddress,
+		const uint8_t *pucData, uint32_t ulLength);
+
+typedef struct
+{
+	uint32_t ulAddress;
+	uint32_t ulPostCycles;		/* CYCCNT when posted. */
+	Credit_t *pxCredit;			/* Credit spent on it, NULL if none. */
+	uint16_t usLength;
+	uint8_t ucData[GATEKEEPER_REQUEST_BYTES];
+} GatekeeperRequest_t;
+
+typedef struct
+{
+	uint32_t ulRequests;		/* Requests served. */
+	uint32_t ulTransactions;	/* Calls to the write function. */
+	uint32_t ulErrors;			/* Transactions that failed. */
+	uint32_t ulDropped;			/* Posts refused because the queue was full. */
+	uint32_t ulDepth;			/* Requests waiting now. */
+	uint32_t ulPeakDepth;		/* Most requests waiting at once. */
+	uint32_t ulPeakBatch;		/* Most requests drained in one wakeup. */
+	uint32_t ulMinCycles;		/* Post to end of its transaction. */
+	uint32_t ulMaxCycles;
+	uint64_t ullTotalCycles;
+} GatekeeperStats_t;
+
+typedef struct
+{
+	QueueHandle_t xQueue;
+	StaticQueue_t xQueueBuffer;
+	uint8_t ucQueueStorage[GATEKEEPER_QUEUE_LENGTH * sizeof(GatekeeperRequest_t)];
+	GatekeeperWrite_t pxWrite;
+	void *pvContext;
+	GatekeeperRequest_t xBatch[GATEKEEPER_BATCH];		/* Gatekeeper only. */
+	uint8_t ucStaging[GATEKEEPER_STAGING_BYTES];		/* Gatekeeper only. */
+	volatile uint32_t ulDropped;
+	GatekeeperStats_t xStats;
+	Credit_t *pxCredits[GATEKEEPER_PRODUCERS];
+	uint32_t ulProducers;
+	uint32_t ulWindows;			/* Queue slots lent to producers. */
+	TaskHandle_t xTask;
+	StaticTask_t xTaskTcb;
+	StackType_t xTaskStack[GATEKEEPER_STACK_WORDS];
+} Gatekeeper_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t gatekeeper_start(Gatekeeper_t *pxGatekeeper, const char *pcName,
+		GatekeeperWrite_t pxWrite, void *pvContext, UBaseType_t uxPriority);
+int32_t gatekeeper_write(Gatekeeper_t *pxGatekeeper, uint32_t ulAddress,
+		const void *pvData, uint32_t ulLength, TickType_t xTicksToWait);
+int32_t gatekeeper_add_producer(Gatekeeper_t *pxGatekeeper, Credit_t *pxCredit,
+		uint32_t ulWindow);
+int32_t gatekeeper_write_credit(Gatekeeper_t *pxGatekeeper, Credit_t *pxCredit,
+		uint32_t ulAddress, const void *pvData, uint32_t ulLength);
+int32_t gatekeeper_write_from_isr(Gatekeeper_t *pxGatekeeper, uint32_t ulAddress,
+		const void *pvData, uint32_t ulLength, BaseType_t *pxHigherPriorityTaskWoken);
+int32_t gatekeeper_get_stats(Gatekeeper_t *pxGatekeeper, GatekeeperStats_t *pxStats);
+
+#endif /* GATEKEEPER_H */
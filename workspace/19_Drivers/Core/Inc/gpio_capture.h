@@ -0,0 +1,39 @@
+/*******************************************************************************
+ *
+ * @file	gpio_capture.h
+ * @brief	Interface of the timer-triggered GPIO input capture.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef GPIO_CAPTURE_H
+#define GPIO_CAPTURE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef GPIO_CAPTURE_MAX_RATE_HZ
+#define GPIO_CAPTURE_MAX_RATE_HZ 4000000U	/* Above this DMA2 may miss requests. */
+#endif
+
+#ifndef GPIO_CAPTURE_IRQ_PRIORITY
+#define GPIO_CAPTURE_IRQ_PRIORITY 6U		/* At or below configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+#endif
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t gpio_capture_init(GPIO_TypeDef *pxPort, uint32_t ulSampleRateHz, uint16_t *pusBuf0,
+		uint16_t *pusBuf1, uint16_t usBlockSize, TaskHandle_t xTask);
+int32_t gpio_capture_start(void);
+void gpio_capture_stop(void);
+uint16_t *gpio_capture_wait(TickType_t xTicksToWait);
+uint32_t gpio_capture_get_rate(void);
+uint32_t gpio_capture_get_overruns(void);
+uint32_t gpio_capture_count_edges(const uint16_t *pusBlock, uint32_t ulCount, uint16_t usMask,
+		uint16_t *pusPrevious);
+
+#endif /* GPIO_CAPTURE_H */
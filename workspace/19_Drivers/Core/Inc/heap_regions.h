@@ -0,0 +1,23 @@
+/*******************************************************************************
+ *
+ * @file	heap_regions.h
+ * @brief	Interface of the SRAM1/SRAM2 heap region table.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef HEAP_REGIONS_H
+#define HEAP_REGIONS_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+
+/* Macros --------------------------------------------------------------------*/
+
+/* Regions for pvPortMallocRegion(), in address order. */
+#define HEAP_REGION_SRAM1	0	/* 112 KB, shared with .data, .bss and the MSP stack. */
+#define HEAP_REGION_SRAM2	1	/* 16 KB, its own bus matrix port: DMA buffers. */
+#define HEAP_REGION_COUNT	2
+
+#endif /* HEAP_REGIONS_H */
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *
+ * @file	i2c.h
+ * @brief	Interface of the I2C master driver.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef I2C_H
+#define I2C_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clkgate.h"
+#include "xfer.h"
+#include "dma.h"
+#include "hrtimer.h"
+
+/* Macros --------------------------------------------------------------------*/
+/* Buses compiled in. Each claims its event and error vectors. */
+#ifndef I2C_USE_I2C1
+#define I2C_USE_I2C1 1
+#endif
+
+#ifndef I2C_USE_I2C2
+#define I2C_USE_I2C2 0
+#endif
+
+#ifndef I2C_USE_I2C3
+#define I2C_USE_I2C3 0
+#endif
+
+#ifndef I2C_IRQ_PRIORITY
+#define I2C_IRQ_PRIORITY 6U			/* At or below configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+#endif
+
+#ifndef I2C_DMA_PRIORITY
+#define I2C_DMA_PRIORITY DMA_PL_MEDIUM
+#endif
+
+/* A transaction taking longer than this plus twice its bit time recovers the
+ * bus and fails. */
+#ifndef I2C_TIMEOUT_US
+#define I2C_TIMEOUT_US 2000U
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef enum
+{
+	I2C_BUS_1 = 0U,					/* I2C1, PB6 (SCL)/PB7 (SDA) */
+	I2C_BUS_2,						/* I2C2, PB10/PC12 */
+	I2C_BUS_3,						/* I2C3, PA8/PC9 */
+	I2C_BUSES
+} I2cBus_t;
+
+/* One transaction: a write, a read, or a write then a read after a repeated
+ * START, e.g. a register address then a burst of registers. xReq is the
+ * caller's: pvData receives ulLen bytes, and it completes with ulLen, or
+ * XFER_ERROR on a NACK, bus error or timeout. */
+typedef struct
+{
+	XferReq_t xReq;
+	const uint8_t *pucTx;
+	uint16_t usTxLen;				/* 0 for a read only. */
+	uint8_t ucBus;					/* I2cBus_t */
+	uint8_t ucAddr;					/* 7-bit address. */
+	DmaDesc_t xDesc;				/* The driver's. */
+} I2cXfer_t;
+
+typedef struct
+{
+	uint32_t ulXfers;				/* Completed. */
+	uint32_t ulBytes;				/* Written and read. */
+	uint32_t ulNacks;				/* Address or data not acknowledged. */
+	uint32_t ulBusErrors;			/* Misplaced START or STOP, lost arbitration. */
+	uint32_t ulTimeouts;
+	uint32_t ulRecoveries;			/* SCL clocked until SDA was released. */
+} I2cStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t i2c_open(I2cBus_t xBus, uint32_t ulSpeedHz);
+void i2c_xfer_init(I2cXfer_t *pxXfer, I2cBus_t xBus, uint8_t ucAddr, const void *pvTx,
+		uint16_t usTxLen, void *pvRx, uint32_t ulRxLen);
+int32_t i2c_submit(I2cXfer_t *pxXfer);
+int32_t i2c_submit_batch(I2cXfer_t *pxXfers, uint32_t ulCount);
+int32_t i2c_transfer(I2cBus_t xBus, uint8_t ucAddr, const void *pvTx, uint16_t usTxLen,
+		void *pvRx, uint32_t ulRxLen);
+int32_t i2c_get_stats(I2cBus_t xBus, I2cStats_t *pxStats);
+
+#endif /* I2C_H */
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ *
+ * @file	icap.h
+ * @brief	Interface of the timer input capture (frequency and duty cycle).
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef ICAP_H
+#define ICAP_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+/* Macros --------------------------------------------------------------------*/
+/* Edges of each kind kept between two icap_read() calls: a power of two. At
+ * 10 kHz, 256 edges last 25.6 ms. */
+#ifndef ICAP_RING_EDGES
+#define ICAP_RING_EDGES 256U
+#endif
+
+/* Input filter (ICxF): 3 takes 8 timer clocks of a level, rejecting glitches
+ * under 90 ns at 90 MHz and delaying both edges alike. 0 to 15. */
+#ifndef ICAP_FILTER
+#define ICAP_FILTER 3U
+#endif
+
+/* Highest edge rate expected, for the DMA bandwidth budget. */
+#ifndef ICAP_MAX_EDGE_HZ
+#define ICAP_MAX_EDGE_HZ 100000U
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef enum
+{
+	ICAP_INPUT_TI1 = 0,				/* PA0: TIM2 CH1 rising, CH2 falling. */
+	ICAP_INPUT_TI3,					/* PB10: TIM2 CH3 rising, CH4 falling. */
+	ICAP_INPUTS
+} IcapInput_t;
+
+/* The periods completed since the last icap_read(). */
+typedef struct
+{
+	uint32_t ulPeriods;				/* Rising edge to rising edge. */
+	uint32_t ulFrequencyMilliHz;	/* Over all of them, 0 if none. */
+	uint32_t ulDutyPpm;				/* High time, over the periods with a falling edge. */
+	uint32_t ulMinPeriodNs;
+	uint32_t ulMaxPeriodNs;
+	uint32_t ulLastEdge;			/* Timer count of the last rising edge. */
+	uint32_t ulOverruns;			/* Reads that found edges overwritten. */
+} IcapResult_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t icap_open(IcapInput_t eInput);
+void icap_close(IcapInput_t eInput);
+int32_t icap_read(IcapInput_t eInput, IcapResult_t *pxResult);
+uint32_t icap_get_clock_hz(void);
+
+#endif /* ICAP_H */
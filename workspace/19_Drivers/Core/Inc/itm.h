@@ -0,0 +1,43 @@
+/*******************************************************************************
+ *
+ * @file	itm.h
+ * @brief	Interface of the ITM/SWO output driver.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef ITM_H
+#define ITM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macros --------------------------------------------------------------------*/
+
+/* Stimulus ports. Each is a separate channel in the SWO viewer. */
+#define ITM_PORT_TEXT		0U	/* printf() (syscalls.c) */
+#define ITM_PORT_TRACE		1U	/* Binary trace records (ktrace.c, KTRACE_ITM_PORT). */
+#define ITM_PORT_METRICS	2U	/* 32-bit samples, e.g. for the SWV data plot. */
+#define ITM_PORT_TELEMETRY	3U	/* Telemetry frames (telemetry.c, TELEMETRY_ITM_PORT). */
+#define ITM_PORT_COUNT		4U	/* Ports enabled by ITM_SWO_Init(). */
+
+#ifndef ITM_SWO_BAUD
+#define ITM_SWO_BAUD 2000000U	/* Must match the debugger's SWO clock. */
+#endif
+
+#ifndef ITM_BLOCKING
+#define ITM_BLOCKING 1U			/* 0 to drop as soon as the FIFO is full. */
+#endif
+
+#ifndef ITM_BLOCK_SPINS
+#define ITM_BLOCK_SPINS 100000U	/* Polls per packet before a blocking write drops. */
+#endif
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t ITM_SWO_Init(uint32_t ulBaud);
+int ITM_write_buffer(uint32_t ulPort, const char *ptr, int len);
+int32_t ITM_write_word(uint32_t ulPort, uint32_t ulWord);
+uint32_t ITM_get_dropped(uint32_t ulPort);
+
+#endif /* ITM_H */
@@ -0,0 +1,159 @@
+/*******************************************************************************
+ *
+ * @file	ktrace.h
+ * @brief	Interface of the kernel trace recorder.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Included at the end of 'FreeRTOSConfig.h', so that the trace hooks
+ * 			below replace the empty defaults of 'FreeRTOS.h'. The hooks
+ * 			expand inside tasks.c and queue.c, where the TCB and queue
+ * 			fields they read are visible; they need
+ * 			configUSE_TRACE_FACILITY set to 1.
+ *
+ * 			Only <stdint.h> may be included here: this header is read before
+ * 			any FreeRTOS type is defined.
+ *
+ ******************************************************************************/
+
+#ifndef KTRACE_H
+#define KTRACE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macros --------------------------------------------------------------------*/
+#define KTRACE_MODE_STREAM		0U	/* Drain continuously, drop when full. */
+#define KTRACE_MODE_SNAPSHOT	1U	/* Overwrite the oldest, dump on stop. */
+
+#define KTRACE_EXPORT_UART		0U	/* USART2 TX DMA (uart.c). */
+#define KTRACE_EXPORT_ITM		1U	/* ITM stimulus port, out through SWO. */
+
+#ifndef KTRACE_MODE
+#define KTRACE_MODE KTRACE_MODE_STREAM
+#endif
+
+#ifndef KTRACE_EXPORT
+#define KTRACE_EXPORT KTRACE_EXPORT_UART
+#endif
+
+#ifndef KTRACE_RING_EVENTS
+#define KTRACE_RING_EVENTS 512U		/* Event ring, a power of two; 8 bytes each. */
+#endif
+
+#ifndef KTRACE_MAX_TASKS
+#define KTRACE_MAX_TASKS 16U		/* Task numbers that get a name on the host. */
+#endif
+
+#ifndef KTRACE_TICKS
+#define KTRACE_TICKS 0U				/* 1 to record every tick interrupt. */
+#endif
+
+#ifndef KTRACE_DRAIN_PERIOD_MS
+#define KTRACE_DRAIN_PERIOD_MS 10U	/* How often the drain task runs. */
+#endif
+
+#ifndef KTRACE_FLUSH_EVENTS
+#define KTRACE_FLUSH_EVENTS 12U		/* Events sent per drain; fits 115200 baud. */
+#endif
+
+#ifndef KTRACE_SYNC_PERIOD_MS
+#define KTRACE_SYNC_PERIOD_MS 1000U	/* Sync record and task names, for joining. */
+#endif
+
+#ifndef KTRACE_DRAIN_PRIORITY
+#define KTRACE_DRAIN_PRIORITY (configMAX_PRIORITIES - 1)	/* Above busy tasks. */
+#endif
+
+#ifndef KTRACE_ITM_PORT
+#define KTRACE_ITM_PORT 1U			/* Port 0 is usually printf(). */
+#endif
+
+/* Event IDs (bits 7:0 of the second word of a record, see ktrace.c). */
+#define KTRACE_EV_SYNC					0x01U
+#define KTRACE_EV_DROPPED				0x02U
+#define KTRACE_EV_TASK_NAME				0x03U
+#define KTRACE_EV_TASK_CREATE			0x10U
+#define KTRACE_EV_TASK_DELETE			0x11U
+#define KTRACE_EV_TASK_SWITCHED_IN		0x12U
+#define KTRACE_EV_TASK_READY			0x13U
+#define KTRACE_EV_TASK_DELAY			0x14U
+#define KTRACE_EV_TASK_DELAY_UNTIL		0x15U
+#define KTRACE_EV_TASK_NOTIFY			0x16U
+#define KTRACE_EV_TASK_NOTIFY_WAIT		0x17U
+#define KTRACE_EV_TICK					0x18U
+#define KTRACE_EV_QUEUE_CREATE			0x20U	/* + queueQUEUE_TYPE_*. */
+#define KTRACE_EV_QUEUE_SEND			0x28U
+#define KTRACE_EV_QUEUE_SEND_FAILED		0x29U
+#define KTRACE_EV_QUEUE_RECEIVE			0x2AU
+#define KTRACE_EV_QUEUE_RECEIVE_FAILED	0x2BU
+#define KTRACE_EV_QUEUE_BLOCK_SEND		0x2CU
+#define KTRACE_EV_QUEUE_BLOCK_RECEIVE	0x2DU
+#define KTRACE_EV_ISR_ENTER				0x30U
+#define KTRACE_EV_ISR_EXIT				0x31U
+#define KTRACE_EV_MARK					0x40U
+
+/* Kernel trace hooks ---------------------------------------------------------*/
+
+/* Only installed when read from 'FreeRTOSConfig.h', ahead of the empty
+ * defaults of 'FreeRTOS.h' (traceSTART() is one of them). */
+#ifndef traceSTART
+
+#define traceTASK_CREATE( pxNewTCB )													\
+	ktrace_task_create( ( uint32_t ) ( pxNewTCB )->uxTCBNumber,						\
+			( uint32_t ) ( pxNewTCB )->uxPriority, ( pxNewTCB )->pcTaskName )
+#define traceTASK_DELETE( pxTaskToDelete )												\
+	ktrace_event( KTRACE_EV_TASK_DELETE, ( uint32_t ) ( pxTaskToDelete )->uxTCBNumber )
+#define traceTASK_SWITCHED_IN()															\
+	ktrace_task_switched_in( ( uint32_t ) pxCurrentTCB->uxTCBNumber,					\
+			( uint32_t ) pxCurrentTCB->uxPriority )
+#define traceMOVED_TASK_TO_READY_STATE( pxTCB )											\
+	ktrace_event( KTRACE_EV_TASK_READY, ( uint32_t ) ( pxTCB )->uxTCBNumber )
+#define traceTASK_DELAY()																\
+	ktrace_event( KTRACE_EV_TASK_DELAY, ( uint32_t ) xTicksToDelay )
+#define traceTASK_DELAY_UNTIL( xTimeToWake )											\
+	ktrace_event( KTRACE_EV_TASK_DELAY_UNTIL, ( uint32_t ) ( xTimeToWake ) )
+#define traceTASK_NOTIFY()																\
+	ktrace_event( KTRACE_EV_TASK_NOTIFY, ( uint32_t ) pxTCB->uxTCBNumber )
+#define traceTASK_NOTIFY_FROM_ISR()		traceTASK_NOTIFY()
+#define traceTASK_NOTIFY_GIVE_FROM_ISR()	traceTASK_NOTIFY()
+#define traceTASK_NOTIFY_TAKE_BLOCK()	ktrace_event( KTRACE_EV_TASK_NOTIFY_WAIT, 0U )
+#define traceTASK_NOTIFY_WAIT_BLOCK()	ktrace_event( KTRACE_EV_TASK_NOTIFY_WAIT, 0U )
+
+#if (KTRACE_TICKS == 1U)
+#define traceTASK_INCREMENT_TICK( xTickCount )											\
+	ktrace_event( KTRACE_EV_TICK, ( uint32_t ) ( xTickCount ) )
+#endif
+
+#define traceQUEUE_CREATE( pxNewQueue )													\
+	ktrace_object( KTRACE_EV_QUEUE_CREATE + ( uint32_t ) ( pxNewQueue )->ucQueueType,	\
+			( pxNewQueue ) )
+#define traceQUEUE_SEND( pxQueue )					ktrace_object( KTRACE_EV_QUEUE_SEND, ( pxQueue ) )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )			ktrace_object( KTRACE_EV_QUEUE_SEND, ( pxQueue ) )
+#define traceQUEUE_SEND_FAILED( pxQueue )			ktrace_object( KTRACE_EV_QUEUE_SEND_FAILED, ( pxQueue ) )
+#define traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue )	ktrace_object( KTRACE_EV_QUEUE_SEND_FAILED, ( pxQueue ) )
+#define traceQUEUE_RECEIVE( pxQueue )				ktrace_object( KTRACE_EV_QUEUE_RECEIVE, ( pxQueue ) )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )		ktrace_object( KTRACE_EV_QUEUE_RECEIVE, ( pxQueue ) )
+#define traceQUEUE_RECEIVE_FAILED( pxQueue )		ktrace_object( KTRACE_EV_QUEUE_RECEIVE_FAILED, ( pxQueue ) )
+#define traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue )	ktrace_object( KTRACE_EV_QUEUE_RECEIVE_FAILED, ( pxQueue ) )
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )		ktrace_object( KTRACE_EV_QUEUE_BLOCK_SEND, ( pxQueue ) )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )	ktrace_object( KTRACE_EV_QUEUE_BLOCK_RECEIVE, ( pxQueue ) )
+
+#endif /* traceSTART */
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t ktrace_init(void);
+void ktrace_start(void);
+void ktrace_stop(void);
+uint32_t ktrace_flush(void);
+uint32_t ktrace_get_dropped(void);
+void ktrace_isr_enter(void);
+void ktrace_isr_exit(void);
+void ktrace_mark(uint32_t ulId);
+
+/* Called by the trace hooks. */
+void ktrace_event(uint32_t ulEvent, uint32_t ulArg);
+void ktrace_object(uint32_t ulEvent, const void *pvObject);
+void ktrace_task_create(uint32_t ulTask, uint32_t ulPriority, const char *pcName);
+void ktrace_task_switched_in(uint32_t ulTask, uint32_t ulPriority);
+
+#endif /* KTRACE_H */
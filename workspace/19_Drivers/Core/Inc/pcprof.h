@@ -0,0 +1,54 @@
+/*******************************************************************************
+ *
+ * @file	pcprof.h
+ * @brief	Interface of the statistical PC-sampling profiler.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef PCPROF_H
+#define PCPROF_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define PCPROF_MIN_HZ	1000U
+#define PCPROF_MAX_HZ	20000U
+
+#ifndef PCPROF_SLOTS
+#define PCPROF_SLOTS 512U			/* Histogram entries, a power of two; 12 bytes each. */
+#endif
+
+#ifndef PCPROF_PROBES
+#define PCPROF_PROBES 16U			/* Slots tried before a sample is lost. */
+#endif
+
+#ifndef PCPROF_MAX_TASKS
+#define PCPROF_MAX_TASKS 16U		/* Tasks named in a dump. */
+#endif
+
+#ifndef PCPROF_IRQ_PRIORITY
+#define PCPROF_IRQ_PRIORITY 0U		/* Above configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+#endif
+
+#ifndef PCPROF_REPORTER_STACK_WORDS
+#define PCPROF_REPORTER_STACK_WORDS 384U	/* printf() needs the headroom. */
+#endif
+
+/* Context of a sample that is not a task. */
+#define PCPROF_CTX_MAIN		0UL			/* Thread mode on MSP: before the scheduler. */
+#define PCPROF_CTX_EXC		0x80000000UL	/* + exception number (16 + IRQn). */
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t pcprof_start(uint32_t ulRateHz);
+void pcprof_stop(void);
+void pcprof_reset(void);
+void pcprof_dump(void);
+uint32_t pcprof_get_samples(void);
+uint32_t pcprof_get_lost(void);
+BaseType_t pcprof_start_reporter(uint32_t ulPeriodMs, UBaseType_t uxPriority);
+
+#endif /* PCPROF_H */
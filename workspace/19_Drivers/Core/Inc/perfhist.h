@@ -0,0 +1,91 @@
+/*******************************************************************************
+ *
+ * @file	perfhist.h
+ * @brief	Interface of the code region latency histograms.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	A region is timed by a PERF_BEGIN(id) / PERF_END(id) pair in the
+ * 			same block; id is a constant from 0 to PERFHIST_REGIONS - 1,
+ * 			numbered by the application, named by a macro or a literal (it
+ * 			is pasted into the name of a local). With PERFHIST_ENABLE 0 the
+ * 			pair expands to nothing and the histograms are not built.
+ *
+ ******************************************************************************/
+
+#ifndef PERFHIST_H
+#define PERFHIST_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "stm32f4xx.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef PERFHIST_ENABLE
+#define PERFHIST_ENABLE 1
+#endif
+
+#ifndef PERFHIST_REGIONS
+#define PERFHIST_REGIONS 8U			/* Regions, one histogram each. */
+#endif
+
+/* Bucket resolution: 2^PERFHIST_SUB_BITS buckets per power of two, so a
+ * percentile is within 1 / 2^PERFHIST_SUB_BITS of the true value (12.5 %). */
+#ifndef PERFHIST_SUB_BITS
+#define PERFHIST_SUB_BITS 3U
+#endif
+
+/* Range: regions up to 2^PERFHIST_RANGE_BITS cycles (5.8 ms at 180 MHz) are
+ * bucketed; longer ones land in the last bucket, their maximum still exact. */
+#ifndef PERFHIST_RANGE_BITS
+#define PERFHIST_RANGE_BITS 20U
+#endif
+
+/* 144 buckets, 576 bytes per region, with the defaults. */
+#define PERFHIST_BUCKETS		((PERFHIST_RANGE_BITS + 1U - PERFHIST_SUB_BITS) << PERFHIST_SUB_BITS)
+
+#ifndef PERFHIST_REPORTER_STACK_WORDS
+#define PERFHIST_REPORTER_STACK_WORDS 384U	/* printf() needs the headroom. */
+#endif
+
+#if (PERFHIST_ENABLE == 1)
+#define PERF_BEGIN(id)			const uint32_t ulPerfBegin_##id = DWT->CYCCNT
+#define PERF_END(id)			perfhist_record((id), DWT->CYCCNT - ulPerfBegin_##id)
+#else
+/* Compiled out, with the calls that set the histograms up and report them. */
+#define PERF_BEGIN(id)
+#define PERF_END(id)
+#define perfhist_init()
+#define perfhist_name(ulId, pcName)
+#define perfhist_reset()
+#define perfhist_dump()
+#define perfhist_start_reporter(ulPeriodMs, ulPriority)	(0)
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+/* Summary of one region, in cycles. The percentiles are bucket upper bounds,
+ * capped to the maximum. */
+typedef struct
+{
+	uint32_t ulCount;
+	uint32_t ulMin;
+	uint32_t ulMax;
+	uint32_t ulMean;
+	uint32_t ulP50;
+	uint32_t ulP90;
+	uint32_t ulP99;
+	uint32_t ulP999;
+} PerfhistStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+#if (PERFHIST_ENABLE == 1)
+void perfhist_init(void);
+void perfhist_name(uint32_t ulId, const char *pcName);
+void perfhist_record(uint32_t ulId, uint32_t ulCycles);
+int32_t perfhist_get(uint32_t ulId, PerfhistStats_t *pxStats);
+uint32_t perfhist_percentile(uint32_t ulId, uint32_t ulPerMille);
+void perfhist_reset(void);
+void perfhist_dump(void);
+int32_t perfhist_start_reporter(uint32_t ulPeriodMs, uint32_t ulPriority);
+#endif
+
+#endif /* PERFHIST_H */
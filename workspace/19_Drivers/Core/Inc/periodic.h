@@ -0,0 +1,73 @@
+/*******************************************************************************
+ *
+ * @file	periodic.h
+ * @brief	Interface of the periodic task helper.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef PERIODIC_H
+#define PERIODIC_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef PERIODIC_HIST_BUCKETS
+#define PERIODIC_HIST_BUCKETS 16U	/* Powers of two of us; the last is open. */
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef enum
+{
+	PERIODIC_OVERRUN_CATCH_UP,	/* Run the missed releases back to back. */
+	PERIODIC_OVERRUN_SKIP,		/* Drop them and keep the phase. */
+	PERIODIC_OVERRUN_NOTIFY		/* As SKIP, and notify on each deadline miss. */
+} PeriodicPolicy_t;
+
+typedef struct
+{
+	uint32_t ulCycles;			/* Completed cycles. */
+	uint32_t ulDeadlineMisses;	/* Cycles completed after their deadline. */
+	uint32_t ulSkipped;			/* Releases dropped by the SKIP policy. */
+	uint32_t ulJitterMaxUs;		/* Release, from its tick. */
+	uint32_t ulResponseMaxUs;	/* Completion, from the release tick. */
+	uint16_t usJitter[PERIODIC_HIST_BUCKETS];
+	uint16_t usResponse[PERIODIC_HIST_BUCKETS];
+} PeriodicStats_t;
+
+typedef struct
+{
+	uint32_t ulWcetUs;			/* Worst-case execution time of a cycle. */
+	uint32_t ulPeriodUs;
+	uint32_t ulDeadlineUs;		/* From the release; at most the period. */
+} PeriodicSpec_t;
+
+typedef struct
+{
+	TickType_t xPeriod;
+	TickType_t xDeadline;
+	uint32_t ulDeadlineUs;
+	PeriodicPolicy_t ePolicy;
+	TaskHandle_t xNotifyTask;	/* PERIODIC_OVERRUN_NOTIFY only. */
+	uint32_t ulNotifyBits;
+	TickType_t xLastWake;		/* Tick of the current release. */
+	uint8_t ucStarted;
+	PeriodicStats_t xStats;
+} Periodic_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+void periodic_init(Periodic_t *pxPeriodic, TickType_t xPeriod, TickType_t xDeadline,
+		PeriodicPolicy_t ePolicy);
+void periodic_set_notify(Periodic_t *pxPeriodic, TaskHandle_t xTask, uint32_t ulNotifyBits);
+void periodic_wait(Periodic_t *pxPeriodic);
+void periodic_get_stats(const Periodic_t *pxPeriodic, PeriodicStats_t *pxStats);
+void periodic_reset_stats(Periodic_t *pxPeriodic);
+void periodic_print(const Periodic_t *pxPeriodic, const char *pcName);
+BaseType_t periodic_edf_schedulable(const PeriodicSpec_t *pxSpecs, uint32_t ulCount,
+		uint32_t *pulDensityPpm);
+
+#endif /* PERIODIC_H */
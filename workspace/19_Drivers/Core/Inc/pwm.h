@@ -0,0 +1,53 @@
+/*******************************************************************************
+ *
+ * @file	pwm.h
+ * @brief	Interface of the hardware PWM pattern player (LEDs, actuators).
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef PWM_H
+#define PWM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+/* Macros --------------------------------------------------------------------*/
+/* Duty cycle steps: a level of PWM_LEVELS is always on, 0 always off. */
+#define PWM_LEVELS				1000U
+
+/* TIM1 channels driven, from CH1: PA8, PA9, PA10 and PA11. CH4 shares PA11
+ * with the USB OTG FS D- line (usb_cdc.c). 1 to 4. */
+#ifndef PWM_CHANNELS
+#define PWM_CHANNELS 3U
+#endif
+
+/* PWM frequency: above what the eye sees flicker and above the audible range
+ * for motors and buzzers. The timer clock must divide into
+ * PWM_FREQUENCY_HZ * PWM_LEVELS for it to be exact. */
+#ifndef PWM_FREQUENCY_HZ
+#define PWM_FREQUENCY_HZ 20000U
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+/* A sequence of frames, each PWM_CHANNELS levels (0 to PWM_LEVELS) in channel
+ * order, one frame per step. The frames stay in place while playing. */
+typedef struct
+{
+	const uint16_t *pusFrames;
+	uint32_t ulFrames;				/* 1 to DMA_MAX_ITEMS / PWM_CHANNELS. */
+	uint8_t ucLoop;					/* Start again after the last frame, else hold it. */
+} PwmPattern_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t pwm_open(uint32_t ulStepHz);
+void pwm_close(void);
+int32_t pwm_play(const PwmPattern_t *pxPattern);
+int32_t pwm_set(const uint16_t *pusLevels);
+uint32_t pwm_is_playing(void);
+void pwm_fill_ramp(uint16_t *pusFrames, uint32_t ulFrames, uint32_t ulChannel,
+		uint16_t usFrom, uint16_t usTo);
+
+#endif /* PWM_H */
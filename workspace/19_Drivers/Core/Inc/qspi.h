@@ -0,0 +1,53 @@
+/*******************************************************************************
+ *
+ * @file	qspi.h
+ * @brief	Interface of the Quad-SPI NOR flash driver.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef QSPI_H
+#define QSPI_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macros --------------------------------------------------------------------*/
+/* Where the flash appears once qspi_map() has run. */
+#define QSPI_XIP_BASE			0x90000000UL
+
+/* Places a constant in the external flash (the linker's .qspi_rodata section,
+ * the QSPI region). Read it by pointer once qspi_map() has run:
+ *   static const int16_t sTable[65536] QSPI_RODATA = { ... }; */
+#define QSPI_RODATA				__attribute__((section(".qspi_rodata")))
+
+#define QSPI_PAGE_BYTES			256U	/* Programmed at once. */
+#define QSPI_SECTOR_BYTES		4096U	/* Erased at once. */
+
+/* Size of the flash: a power of two, as the QSPI region of the linker script. */
+#ifndef QSPI_FLASH_BYTES
+#define QSPI_FLASH_BYTES (16U * 1024U * 1024U)
+#endif
+
+/* QUADSPI clock = HCLK / (QSPI_PRESCALER + 1): 90 MHz at 180 MHz. Up to the
+ * flash's fast read frequency (104 MHz for a W25Q128JV). */
+#ifndef QSPI_PRESCALER
+#define QSPI_PRESCALER 1U
+#endif
+
+/* Memory-mapped mode releases the chip select after this many idle clocks,
+ * so the flash can go to standby; the next read then sends the command and
+ * address again. */
+#ifndef QSPI_IDLE_RELEASE_CLOCKS
+#define QSPI_IDLE_RELEASE_CLOCKS 256U
+#endif
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t qspi_open(void);
+uint32_t qspi_get_id(void);
+int32_t qspi_map(void);
+int32_t qspi_erase(uint32_t ulAddr, uint32_t ulLen);
+int32_t qspi_program(uint32_t ulAddr, const void *pvData, uint32_t ulLen);
+
+#endif /* QSPI_H */
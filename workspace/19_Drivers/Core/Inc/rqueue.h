@@ -0,0 +1,134 @@
+/*******************************************************************************
+ *
+ * @file	rqueue.h
+ * @brief	Interface of the remote queues carried between boards over UART
+ * 			links.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef RQUEUE_H
+#define RQUEUE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "credit.h"
+#include "frame.h"
+#include "uart.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef RQUEUE_CHANNELS
+#define RQUEUE_CHANNELS 8U				/* Channels per link, each one way. */
+#endif
+
+#ifndef RQUEUE_MAX_ITEM
+#define RQUEUE_MAX_ITEM 64U				/* Largest item, in bytes. */
+#endif
+
+#ifndef RQUEUE_BATCH_BYTES
+#define RQUEUE_BATCH_BYTES 256U			/* Largest frame payload. */
+#endif
+
+#ifndef RQUEUE_BATCH_TICKS
+#define RQUEUE_BATCH_TICKS pdMS_TO_TICKS(2)	/* Longest wait for a batch to fill. */
+#endif
+
+#ifndef RQUEUE_REFRESH_TICKS
+#define RQUEUE_REFRESH_TICKS pdMS_TO_TICKS(100)	/* Credits sent again, in case one was lost. */
+#endif
+
+#ifndef RQUEUE_STACK_WORDS
+#define RQUEUE_STACK_WORDS 256U
+#endif
+
+/* Record overhead in a data frame: channel, length and sequence number. */
+#define RQUEUE_RECORD_HEADER 4U
+
+#if (RQUEUE_CHANNELS > 24U)
+#error "RQUEUE_CHANNELS: one event bit per channel, 24 at most."
+#endif
+
+#if ((RQUEUE_MAX_ITEM + RQUEUE_RECORD_HEADER + 1U) > RQUEUE_BATCH_BYTES) || (RQUEUE_MAX_ITEM > 255U)
+#error "RQUEUE_MAX_ITEM: an item must fit a record and a frame."
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct RqLink RqLink_t;
+
+/* Sending end of a channel, on the board that sends. */
+typedef struct
+{
+	RqLink_t *pxLink;
+	uint8_t ucChannel;
+	uint8_t ucItemSize;
+	uint16_t usSeq;						/* Of the next item. */
+	Credit_t xCredit;					/* Granted by the peer's endpoint. */
+	uint32_t ulSent;
+} RqProxy_t;
+
+/* Receiving end of a channel: replays its items into a local queue. */
+typedef struct
+{
+	QueueHandle_t xQueue;
+	uint8_t ucItemSize;
+	uint16_t usExpected;				/* Sequence number of the next item. */
+	Credit_t xCredit;					/* Window: the queue length. */
+	uint32_t ulArrived;					/* Items queued, lost or dropped. */
+	uint32_t ulCounted;					/* Of those, counted as consumed. */
+	uint32_t ulLost;					/* In frames that never arrived. */
+	uint32_t ulDropped;					/* Queue full: the peer ignored its credit. */
+	uint8_t ucAnnounce;					/* Send the credit even without a new grant. */
+} RqEndpoint_t;
+
+typedef struct
+{
+	uint32_t ulFramesSent;
+	uint32_t ulFramesReceived;
+	uint32_t ulItemsSent;
+	uint32_t ulItemsReceived;
+	uint32_t ulGrantsSent;
+	uint32_t ulResets;					/* The peer restarted. */
+	uint32_t ulBadFrames;				/* Unknown type or channel, or truncated. */
+} RqStats_t;
+
+struct RqLink
+{
+	UartPort_t xPort;
+	SemaphoreHandle_t xTxLock;			/* The batch and the TX path. */
+	StaticSemaphore_t xTxLockBuffer;
+	EventGroupHandle_t xCredits;		/* Bit n: channel n got credits. */
+	StaticEventGroup_t xCreditsBuffer;
+	RqProxy_t *pxProxies[RQUEUE_CHANNELS];
+	RqEndpoint_t *pxEndpoints[RQUEUE_CHANNELS];
+	uint8_t ucBatch[RQUEUE_BATCH_BYTES];
+	uint16_t usBatchLen;
+	TickType_t xBatchStart;
+	uint8_t ucTxFrame[FRAME_COBS_MAX_ENCODED(RQUEUE_BATCH_BYTES)];
+	uint8_t ucRxPayload[RQUEUE_BATCH_BYTES];	/* Agent only. */
+	uint8_t ucRxBytes[64];						/* Agent only. */
+	FrameRx_t xRx;
+	RqStats_t xStats;
+	TaskHandle_t xTask;
+	StaticTask_t xTaskTcb;
+	StackType_t xTaskStack[RQUEUE_STACK_WORDS];
+};
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t rqueue_start(RqLink_t *pxLink, const char *pcName, UartPort_t xPort,
+		UBaseType_t uxPriority);
+int32_t rqueue_proxy_init(RqLink_t *pxLink, RqProxy_t *pxProxy, uint8_t ucChannel,
+		uint8_t ucItemSize);
+int32_t rqueue_endpoint_init(RqLink_t *pxLink, RqEndpoint_t *pxEndpoint, uint8_t ucChannel,
+		QueueHandle_t xQueue, uint8_t ucItemSize);
+BaseType_t rqueue_send(RqProxy_t *pxProxy, const void *pvItem, TickType_t xTicksToWait);
+UBaseType_t rqueue_spaces_available(const RqProxy_t *pxProxy);
+void rqueue_flush(RqLink_t *pxLink);
+void rqueue_get_stats(RqLink_t *pxLink, RqStats_t *pxStats);
+
+#endif /* RQUEUE_H */
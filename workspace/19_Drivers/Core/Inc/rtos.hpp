@@ -0,0 +1,365 @@
+/*******************************************************************************
+ *
+ * @file	rtos.hpp
+ * @brief	Typed C++17 wrappers with static storage over queue.h, semphr.h
+ * 			and task.h.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Header-only. Each object holds its kernel storage, so it lives
+ * 			wherever it is declared (a global or a static, normally) and
+ * 			nothing comes from the heap. Every member function is a
+ * 			forwarding call to the C API, inlined, so the code is what the
+ * 			same calls written in C compile to.
+ *
+ * 			Queue<T, N> only takes and returns a T: the item size given at
+ * 			creation always matches, and receiving into the wrong struct no
+ * 			longer compiles. T must be trivially copyable, as the kernel
+ * 			copies items with memcpy().
+ *
+ * 			LockGuard takes a Mutex in its constructor and gives it back in
+ * 			its destructor, on every path out of the scope.
+ *
+ * 			Objects are created in their constructors, so global ones are
+ * 			ready before main(): the kernel allows creating queues, mutexes
+ * 			and tasks before the scheduler starts. Tasks are only created by
+ * 			Task::start(), to keep the creation order explicit.
+ *
+ * 			The objects cannot be copied or moved: the kernel keeps
+ * 			pointers to their storage. Nor can they be deleted; declare them
+ * 			for the lifetime of the application.
+ *
+ * 			Needs configSUPPORT_STATIC_ALLOCATION 1, and a C++17 compiler
+ * 			(arm-none-eabi-g++ -std=c++17, with -fno-exceptions -fno-rtti).
+ * 			The STM32CubeIDE projects are C projects: convert one to C++
+ * 			(File > New > Convert to a C/C++ Project) to use this file.
+ *
+ ******************************************************************************/
+
+#ifndef RTOS_HPP
+#define RTOS_HPP
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "semphr.h"
+#include "task.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION != 1)
+#error rtos.hpp needs configSUPPORT_STATIC_ALLOCATION 1
+#endif
+
+namespace rtos
+{
+
+/* Data types ----------------------------------------------------------------*/
+
+/**
+ * @brief A queue of up to N items of type T, with static storage.
+ */
+template <typename T, UBaseType_t N>
+class Queue
+{
+	static_assert(N > 0U, "a queue holds at least one item");
+	static_assert(std::is_trivially_copyable<T>::value, "the kernel copies items with memcpy()");
+
+public:
+	Queue() : xHandle(xQueueCreateStatic(N, sizeof(T), ucStorage, &xQueueBuffer))
+	{
+	}
+
+	Queue(const Queue &) = delete;
+	Queue &operator=(const Queue &) = delete;
+
+	/**
+	 * @brief Sends an item to the back of the queue.
+	 * @param xItem Item, copied into the queue.
+	 * @param xTicksToWait Ticks to wait for room.
+	 * @retval true if sent, false if the queue stayed full.
+	 */
+	bool send(const T &xItem, TickType_t xTicksToWait = portMAX_DELAY)
+	{
+		return xQueueSend(xHandle, &xItem, xTicksToWait) == pdPASS;
+	}
+
+	/**
+	 * @brief Sends an item to the front of the queue.
+	 * @param xItem Item, copied into the queue.
+	 * @param xTicksToWait Ticks to wait for room.
+	 * @retval true if sent, false if the queue stayed full.
+	 */
+	bool sendToFront(const T &xItem, TickType_t xTicksToWait = portMAX_DELAY)
+	{
+		return xQueueSendToFront(xHandle, &xItem, xTicksToWait) == pdPASS;
+	}
+
+	/**
+	 * @brief Sends an item from an ISR.
+	 * @param xItem Item, copied into the queue.
+	 * @param pxHigherPriorityTaskWoken Set to pdTRUE if a task of a higher
+	 * priority than the interrupted one was woken.
+	 * @retval true if sent, false if the queue was full.
+	 */
+	bool sendFromISR(const T &xItem, BaseType_t *pxHigherPriorityTaskWoken)
+	{
+		return xQueueSendFromISR(xHandle, &xItem, pxHigherPriorityTaskWoken) == pdPASS;
+	}
+
+	/**
+	 * @brief Replaces the only item of a queue of length 1.
+	 * @param xItem Item, copied into the queue.
+	 * @retval None
+	 */
+	void overwrite(const T &xItem)
+	{
+		static_assert(N == 1U, "only a queue of length 1 can be overwritten");
+		(void)xQueueOverwrite(xHandle, &xItem);
+	}
+
+	/**
+	 * @brief Receives the item at the front of the queue.
+	 * @param xItem Receives the item.
+	 * @param xTicksToWait Ticks to wait for an item.
+	 * @retval true if received, false if the queue stayed empty.
+	 */
+	bool receive(T &xItem, TickType_t xTicksToWait = portMAX_DELAY)
+	{
+		return xQueueReceive(xHandle, &xItem, xTicksToWait) == pdPASS;
+	}
+
+	/**
+	 * @brief Receives an item from an ISR.
+	 * @param xItem Receives the item.
+	 * @param pxHigherPriorityTaskWoken Set to pdTRUE if a task of a higher
+	 * priority than the interrupted one was woken.
+	 * @retval true if received, false if the queue was empty.
+	 */
+	bool receiveFromISR(T &xItem, BaseType_t *pxHigherPriorityTaskWoken)
+	{
+		return xQueueReceiveFromISR(xHandle, &xItem, pxHigherPriorityTaskWoken) == pdPASS;
+	}
+
+	/**
+	 * @brief Copies the item at the front of the queue, leaving it there.
+	 * @param xItem Receives the item.
+	 * @param xTicksToWait Ticks to wait for an item.
+	 * @retval true if copied, false if the queue stayed empty.
+	 */
+	bool peek(T &xItem, TickType_t xTicksToWait = portMAX_DELAY)
+	{
+		return xQueuePeek(xHandle, &xItem, xTicksToWait) == pdPASS;
+	}
+
+	/**
+	 * @brief Returns the number of items in the queue.
+	 * @param None
+	 * @retval Items waiting.
+	 */
+	UBaseType_t waiting() const
+	{
+		return uxQueueMessagesWaiting(xHandle);
+	}
+
+	/**
+	 * @brief Returns the room left in the queue.
+	 * @param None
+	 * @retval Items that can still be sent.
+	 */
+	UBaseType_t spaces() const
+	{
+		return uxQueueSpacesAvailable(xHandle);
+	}
+
+	/**
+	 * @brief Returns the number of items the queue holds when full.
+	 * @param None
+	 * @retval N.
+	 */
+	static constexpr UBaseType_t capacity()
+	{
+		return N;
+	}
+
+	/**
+	 * @brief Returns the handle, for the C API (queue sets, the registry).
+	 * @param None
+	 * @retval The queue handle.
+	 */
+	QueueHandle_t handle() const
+	{
+		return xHandle;
+	}
+
+private:
+	StaticQueue_t xQueueBuffer;
+	alignas(T) uint8_t ucStorage[N * sizeof(T)];
+	QueueHandle_t xHandle;
+};
+
+/**
+ * @brief A mutex with priority inheritance, with static storage.
+ * @note Take and give from tasks only, the same task doing both.
+ */
+class Mutex
+{
+public:
+	Mutex() : xHandle(xSemaphoreCreateMutexStatic(&xMutexBuffer))
+	{
+	}
+
+	Mutex(const Mutex &) = delete;
+	Mutex &operator=(const Mutex &) = delete;
+
+	/**
+	 * @brief Takes the mutex.
+	 * @param xTicksToWait Ticks to wait for it.
+	 * @retval true if taken, false if the block time expired.
+	 */
+	bool lock(TickType_t xTicksToWait = portMAX_DELAY)
+	{
+		return xSemaphoreTake(xHandle, xTicksToWait) == pdPASS;
+	}
+
+	/**
+	 * @brief Gives the mutex back.
+	 * @param None
+	 * @retval None
+	 */
+	void unlock()
+	{
+		(void)xSemaphoreGive(xHandle);
+	}
+
+	/**
+	 * @brief Returns the task holding the mutex.
+	 * @param None
+	 * @retval The holder, or NULL if it is free.
+	 */
+	TaskHandle_t holder() const
+	{
+		return xSemaphoreGetMutexHolder(xHandle);
+	}
+
+	/**
+	 * @brief Returns the handle, for the C API.
+	 * @param None
+	 * @retval The semaphore handle.
+	 */
+	SemaphoreHandle_t handle() const
+	{
+		return xHandle;
+	}
+
+private:
+	StaticSemaphore_t xMutexBuffer;
+	SemaphoreHandle_t xHandle;
+};
+
+/**
+ * @brief Holds a mutex for the lifetime of a scope.
+ * @note 'LockGuard xLock(xMutex);' waits for the mutex as long as it takes.
+ * With a timeout, check locked() before touching what the mutex guards.
+ */
+template <typename M>
+class LockGuard
+{
+public:
+	explicit LockGuard(M &xMutex, TickType_t xTicksToWait = portMAX_DELAY)
+		: xMutex(xMutex), bLocked(xMutex.lock(xTicksToWait))
+	{
+	}
+
+	~LockGuard()
+	{
+		if (bLocked)
+		{
+			xMutex.unlock();
+		}
+	}
+
+	LockGuard(const LockGuard &) = delete;
+	LockGuard &operator=(const LockGuard &) = delete;
+
+	/**
+	 * @brief Tells whether the mutex was taken.
+	 * @param None
+	 * @retval true if it is held until the end of the scope.
+	 */
+	bool locked() const
+	{
+		return bLocked;
+	}
+
+private:
+	M &xMutex;
+	const bool bLocked;
+};
+
+/**
+ * @brief A task with a stack of StackWords words, with static storage.
+ */
+template <configSTACK_DEPTH_TYPE StackWords>
+class Task
+{
+	static_assert(StackWords >= configMINIMAL_STACK_SIZE, "stack below configMINIMAL_STACK_SIZE");
+
+public:
+	Task() = default;
+
+	Task(const Task &) = delete;
+	Task &operator=(const Task &) = delete;
+
+	/**
+	 * @brief Creates the task.
+	 * @param pxTaskCode Task function, which must not return.
+	 * @param pcName Name, for debugging.
+	 * @param uxPriority Priority.
+	 * @param pvParameters Passed to pxTaskCode.
+	 * @retval true if created, false if already started.
+	 * @note Call once, before or after vTaskStartScheduler().
+	 */
+	bool start(TaskFunction_t pxTaskCode, const char *pcName, UBaseType_t uxPriority,
+			void *pvParameters = nullptr)
+	{
+		if (xHandle != nullptr)
+		{
+			return false;
+		}
+
+		xHandle = xTaskCreateStatic(pxTaskCode, pcName, StackWords, pvParameters, uxPriority,
+				uxStack, &xTaskBuffer);
+
+		return xHandle != nullptr;
+	}
+
+	/**
+	 * @brief Returns the handle, for the C API (notifications, priorities).
+	 * @param None
+	 * @retval The task handle, NULL before start().
+	 */
+	TaskHandle_t handle() const
+	{
+		return xHandle;
+	}
+
+	/**
+	 * @brief Returns the stack depth.
+	 * @param None
+	 * @retval StackWords.
+	 */
+	static constexpr configSTACK_DEPTH_TYPE stackWords()
+	{
+		return StackWords;
+	}
+
+private:
+	StaticTask_t xTaskBuffer;
+	StackType_t uxStack[StackWords];
+	TaskHandle_t xHandle = nullptr;
+};
+
+} /* namespace rtos */
+
+#endif /* RTOS_HPP */
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *
+ * @file	rtt.h
+ * @brief	Interface of the debugger-polled memory channels (RTT).
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef RTT_H
+#define RTT_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef RTT_MAX_UP_BUFFERS
+#define RTT_MAX_UP_BUFFERS 2U			/* Target to host channels; 0 is the terminal. */
+#endif
+
+#ifndef RTT_MAX_DOWN_BUFFERS
+#define RTT_MAX_DOWN_BUFFERS 2U			/* Host to target channels; 0 is the terminal. */
+#endif
+
+#ifndef RTT_TERMINAL_UP_SIZE
+#define RTT_TERMINAL_UP_SIZE 1024U		/* printf() output waiting for the probe. */
+#endif
+
+#ifndef RTT_TERMINAL_DOWN_SIZE
+#define RTT_TERMINAL_DOWN_SIZE 32U		/* Typed input waiting for the target. */
+#endif
+
+#ifndef RTT_TERMINAL_MODE
+#define RTT_TERMINAL_MODE RTT_MODE_NO_BLOCK_TRIM
+#endif
+
+#ifndef RTT_BLOCK_TICKS
+#define RTT_BLOCK_TICKS 100U			/* Longest wait of RTT_MODE_BLOCK_IF_FULL, then drop. */
+#endif
+
+#ifndef RTT_POLL_TICKS
+#define RTT_POLL_TICKS 1U				/* Between two looks at a ring the probe fills or drains. */
+#endif
+
+/* Up buffer modes, the values of the SEGGER flags. */
+#define RTT_MODE_NO_BLOCK_SKIP	0U		/* Drop a write that does not fit whole. */
+#define RTT_MODE_NO_BLOCK_TRIM	1U		/* Write what fits, drop the rest. */
+#define RTT_MODE_BLOCK_IF_FULL	2U		/* Wait for the probe, up to RTT_BLOCK_TICKS. */
+#define RTT_MODE_MASK			3U
+
+/* Data types ----------------------------------------------------------------*/
+
+/* A ring, as the probe expects it: the writer owns WrOff, the reader RdOff. */
+typedef struct
+{
+	const char *sName;
+	char *pBuffer;
+	uint32_t SizeOfBuffer;
+	volatile uint32_t WrOff;
+	volatile uint32_t RdOff;
+	uint32_t Flags;
+} RttBuffer_t;
+
+/* The control block the probe finds by its ID, or by the symbol _SEGGER_RTT. */
+typedef struct
+{
+	char acID[16];
+	int32_t MaxNumUpBuffers;
+	int32_t MaxNumDownBuffers;
+	RttBuffer_t aUp[RTT_MAX_UP_BUFFERS];
+	RttBuffer_t aDown[RTT_MAX_DOWN_BUFFERS];
+} RttControlBlock_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+void rtt_init(void);
+int32_t rtt_config_up(uint32_t ulChannel, const char *pcName, char *pcBuffer, uint32_t ulSize,
+		uint32_t ulMode);
+int32_t rtt_config_down(uint32_t ulChannel, const char *pcName, char *pcBuffer, uint32_t ulSize);
+int rtt_write(uint32_t ulChannel, const void *pvData, int len);
+int rtt_read(uint32_t ulChannel, void *pvData, int len);
+int rtt_read_wait(uint32_t ulChannel, void *pvData, int len, TickType_t xTicksToWait);
+uint32_t rtt_has_data(uint32_t ulChannel);
+uint32_t rtt_get_dropped(uint32_t ulChannel);
+
+#endif /* RTT_H */
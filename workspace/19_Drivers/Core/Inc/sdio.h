@@ -0,0 +1,53 @@
+/*******************************************************************************
+ *
+ * @file	sdio.h
+ * @brief	Interface of the SD card driver.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef SDIO_H
+#define SDIO_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "dma.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define SDIO_BLOCK_BYTES		512U
+
+/* Blocks per sdio_read() or sdio_write(): one DMA descriptor of words. */
+#define SDIO_MAX_BLOCKS			(DMA_MAX_ITEMS / (SDIO_BLOCK_BYTES / 4U))
+
+#ifndef SDIO_IRQ_PRIORITY
+#define SDIO_IRQ_PRIORITY 6U		/* At or below configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+#endif
+
+#ifndef SDIO_DMA_PRIORITY
+#define SDIO_DMA_PRIORITY DMA_PL_HIGH
+#endif
+
+/* Longest a transfer, or the card's programming before the next one, may take. */
+#ifndef SDIO_TIMEOUT_MS
+#define SDIO_TIMEOUT_MS 500U
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulBlocksRead;
+	uint32_t ulBlocksWritten;
+	uint32_t ulErrors;				/* CRC, FIFO or command errors. */
+	uint32_t ulTimeouts;
+} SdioStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t sdio_open(void);
+int32_t sdio_read(uint32_t ulBlock, void *pvData, uint32_t ulCount);
+int32_t sdio_write(uint32_t ulBlock, const void *pvData, uint32_t ulCount);
+uint32_t sdio_get_blocks(void);
+void sdio_get_stats(SdioStats_t *pxStats);
+
+#endif /* SDIO_H */
@@ -0,0 +1,58 @@
+/*******************************************************************************
+ *
+ * @file	sdlog.h
+ * @brief	Interface of the SD card data logger.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef SDLOG_H
+#define SDLOG_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+/* Macros --------------------------------------------------------------------*/
+/* Bytes handed to the card at once: a multiple of 512, at most 32 KB (one
+ * DMA descriptor). Two such buffers are reserved. Larger blocks amortize the
+ * card's per-write overhead. */
+#ifndef SDLOG_BLOCK_BYTES
+#define SDLOG_BLOCK_BYTES 16384U
+#endif
+
+/* Space reserved for each log file: the most one session can record. */
+#ifndef SDLOG_PREALLOC_BYTES
+#define SDLOG_PREALLOC_BYTES (64U * 1024U * 1024U)
+#endif
+
+/* The directory entry gets the size every this many blocks, so that a power
+ * cut loses at most that much. */
+#ifndef SDLOG_SYNC_BLOCKS
+#define SDLOG_SYNC_BLOCKS 64U
+#endif
+
+#ifndef SDLOG_STACK_WORDS
+#define SDLOG_STACK_WORDS 256U
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulFile;				/* Number of the file being written, LOGnnnnn.BIN. */
+	uint32_t ulBytes;				/* Written to the card. */
+	uint32_t ulBlocks;
+	uint32_t ulOverruns;			/* Blocks lost: the card fell behind. */
+	uint32_t ulDropped;				/* Bytes given while stopped or with the file full. */
+	uint32_t ulErrors;				/* Failed writes. */
+	uint32_t ulMaxWriteMs;			/* Longest write of a block. */
+} SdLogStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t sdlog_start(UBaseType_t uxPriority);
+uint32_t sdlog_write(const void *pvData, uint32_t ulLen);
+int32_t sdlog_stop(void);
+void sdlog_get_stats(SdLogStats_t *pxStats);
+
+#endif /* SDLOG_H */
@@ -0,0 +1,55 @@
+/*******************************************************************************
+ *
+ * @file	sencomp.h
+ * @brief	Interface of the sensor block compression.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef SENCOMP_H
+#define SENCOMP_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef SENCOMP_MAX_SAMPLES
+#define SENCOMP_MAX_SAMPLES 256U		/* Per block, all channels. */
+#endif
+
+#ifndef SENCOMP_MAX_CHANNELS
+#define SENCOMP_MAX_CHANNELS 8U			/* Interleaved in the block. */
+#endif
+
+#ifndef SENCOMP_HASH_BITS
+#define SENCOMP_HASH_BITS 9U			/* LZ match table, 2 bytes an entry. */
+#endif
+
+#define SENCOMP_HEADER_BYTES 4U			/* Mode, channels, samples (LSB first). */
+#define SENCOMP_VARINT_MAX 3U			/* Bytes of the largest 16-bit delta. */
+
+/* Largest block sencomp_encode() writes, in either mode. */
+#define SENCOMP_MAX_ENCODED(samples) (SENCOMP_HEADER_BYTES + (SENCOMP_VARINT_MAX * (samples)))
+
+/* Data types ----------------------------------------------------------------*/
+typedef enum
+{
+	SENCOMP_DELTA = 0U,					/* Zig-zag varint of the deltas. */
+	SENCOMP_DELTA_LZ = 1U				/* The same, then LZ4 block format. */
+} SenCompMode_t;
+
+/* Working memory of the encoder, one per task that encodes. */
+typedef struct
+{
+	uint16_t usHash[1U << SENCOMP_HASH_BITS];	/* Position + 1 of the last 4 bytes seen. */
+	uint8_t ucDelta[SENCOMP_VARINT_MAX * SENCOMP_MAX_SAMPLES];
+} SenComp_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t sencomp_encode(SenComp_t *pxComp, SenCompMode_t xMode, const uint16_t *pusSamples,
+		uint32_t ulSamples, uint32_t ulChannels, uint8_t *pucOut, uint32_t ulSize);
+int32_t sencomp_decode(const uint8_t *pucIn, uint32_t ulLen, uint16_t *pusSamples,
+		uint32_t ulMaxSamples, uint8_t *pucScratch, uint32_t ulScratchSize);
+
+#endif /* SENCOMP_H */
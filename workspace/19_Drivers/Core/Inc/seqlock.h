@@ -0,0 +1,250 @@
+/*******************************************************************************
+ *
+ * @file	seqlock.h
+ * @brief	Lock-free "latest value" channel built on a sequence lock.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	The channel holds one value of a fixed size. seqlock_write()
+ * 			overwrites it and never blocks; seqlock_read() returns the
+ * 			newest complete value, so a slow reader skips stale values
+ * 			instead of working through a backlog. Neither side enters a
+ * 			critical section or causes a context switch.
+ *
+ * 			'ulSequence' is odd while a write is in progress and advances by
+ * 			two per write. A reader copies the value between two reads of
+ * 			the sequence and retries if they differ or were odd, so it never
+ * 			returns a torn value. A writer claims the odd state with one
+ * 			LDREX/STREX pair; a second writer finding it odd (e.g. an ISR
+ * 			that interrupted a task mid-write) returns -1 rather than spin.
+ *
+ * 			A reader that preempts the writer cannot let the write finish,
+ * 			so seqlock_read() gives up after SEQLOCK_READ_RETRIES torn reads.
+ * 			An ISR reading a channel written by a task should expect that.
+ *
+ * 			Optional wakeup: one task blocks in seqlock_wait() and the writer
+ * 			calls seqlock_wake() or seqlock_wake_from_isr() after a write. The
+ * 			wakeup uses the reader's last notification (SEQLOCK_NOTIFY_INDEX),
+ * 			as spsc_ring.h does, so a task waiting on both must give one of
+ * 			them another index.
+ *
+ ******************************************************************************/
+
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef SEQLOCK_NOTIFY_INDEX
+#define SEQLOCK_NOTIFY_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+#endif
+
+#ifndef SEQLOCK_READ_RETRIES
+#define SEQLOCK_READ_RETRIES 16U	/* Torn reads before seqlock_read() fails. */
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	volatile uint32_t ulSequence;		/* Odd while a write is in progress. */
+	void *pvData;						/* ulSize bytes. */
+	uint32_t ulSize;
+	TaskHandle_t xReader;				/* Set by seqlock_wait(). */
+	volatile uint32_t ulReaderWaiting;	/* Reader about to block. */
+} Seqlock_t;
+
+/* Function definitions ------------------------------------------------------*/
+
+/**
+ * @brief Initializes a channel that holds no value yet.
+ * @param pxLock Channel to initialize.
+ * @param pvData Storage of ulSize bytes for the value.
+ * @param ulSize Size of the value in bytes.
+ * @retval 0 if successful, -1 otherwise.
+ */
+static inline int32_t seqlock_init(Seqlock_t *pxLock, void *pvData, uint32_t ulSize)
+{
+	if ((pxLock == NULL) || (pvData == NULL) || (ulSize == 0U))
+	{
+		return -1;
+	}
+
+	pxLock->ulSequence = 0;
+	pxLock->pvData = pvData;
+	pxLock->ulSize = ulSize;
+	pxLock->xReader = NULL;
+	pxLock->ulReaderWaiting = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Returns the sequence of the last complete write.
+ * @param pxLock Channel.
+ * @retval Sequence number, 0 if nothing has been written yet.
+ */
+static inline uint32_t seqlock_sequence(const Seqlock_t *pxLock)
+{
+	return pxLock->ulSequence & ~1UL;
+}
+
+/**
+ * @brief Publishes a new value (writer side). Tasks and ISRs of any priority.
+ * @param pxLock Channel.
+ * @param pvValue The new value, pxLock->ulSize bytes.
+ * @retval 0 if successful, -1 if another write was in progress.
+ */
+static inline int32_t seqlock_write(Seqlock_t *pxLock, const void *pvValue)
+{
+	uint32_t ulSequence;
+
+	/* Claim the odd state; an exception between the two clears the
+	 * exclusive monitor and makes the store fail. */
+	do
+	{
+		ulSequence = __LDREXW(&pxLock->ulSequence);
+
+		if ((ulSequence & 1U) != 0U)
+		{
+			__CLREX();
+			return -1;
+		}
+	} while (__STREXW(ulSequence + 1U, &pxLock->ulSequence) != 0U);
+
+	/* Readers must see the odd sequence before any byte changes. */
+	__DMB();
+	memcpy(pxLock->pvData, pvValue, pxLock->ulSize);
+
+	/* And every byte before the even sequence that publishes them. */
+	__DMB();
+	pxLock->ulSequence = ulSequence + 2U;
+
+	return 0;
+}
+
+/**
+ * @brief Copies the newest value (reader side).
+ * @param pxLock Channel.
+ * @param pvValue Receives the value, pxLock->ulSize bytes.
+ * @param pulSequence Receives the sequence of the value, may be NULL.
+ * @retval 0 if successful, -1 if every attempt overlapped a write.
+ */
+static inline int32_t seqlock_read(const Seqlock_t *pxLock, void *pvValue, uint32_t *pulSequence)
+{
+	uint32_t ulBefore;
+	uint32_t i;
+
+	for (i = 0; i < SEQLOCK_READ_RETRIES; i++)
+	{
+		ulBefore = pxLock->ulSequence;
+
+		if ((ulBefore & 1U) != 0U)
+		{
+			continue;
+		}
+
+		/* Copy only after seeing the sequence, and check it again only
+		 * after the copy. */
+		__DMB();
+		memcpy(pvValue, pxLock->pvData, pxLock->ulSize);
+		__DMB();
+
+		if (pxLock->ulSequence == ulBefore)
+		{
+			if (pulSequence != NULL)
+			{
+				*pulSequence = ulBefore;
+			}
+
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Blocks the calling task until a write newer than ulSequence
+ * completes (reader side).
+ * @param pxLock Channel.
+ * @param ulSequence Sequence of the value the caller already has.
+ * @param xTicksToWait Maximum time to wait.
+ * @retval Sequence of the last complete write, ulSequence on timeout.
+ * @note Uses the calling task's notification count at SEQLOCK_NOTIFY_INDEX.
+ * The waiting flag is set before the sequence is checked again, so a write in
+ * between is never missed.
+ */
+static inline uint32_t seqlock_wait(Seqlock_t *pxLock, uint32_t ulSequence, TickType_t xTicksToWait)
+{
+	TimeOut_t xTimeOut;
+	uint32_t ulNow;
+
+	vTaskSetTimeOutState(&xTimeOut);
+	pxLock->xReader = xTaskGetCurrentTaskHandle();
+
+	while ((ulNow = seqlock_sequence(pxLock)) == ulSequence)
+	{
+		pxLock->ulReaderWaiting = 1;
+		__DMB();
+
+		if ((ulNow = seqlock_sequence(pxLock)) != ulSequence)
+		{
+			break;
+		}
+
+		if (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE)
+		{
+			break;
+		}
+
+		(void)ulTaskNotifyTakeIndexed(SEQLOCK_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+	}
+
+	pxLock->ulReaderWaiting = 0;
+
+	return ulNow;
+}
+
+/**
+ * @brief Wakes the reader if it is blocked in seqlock_wait() (writer task
+ * side).
+ * @param pxLock Channel.
+ * @retval None
+ */
+static inline void seqlock_wake(Seqlock_t *pxLock)
+{
+	/* The new sequence must be visible before the flag is read. */
+	__DMB();
+
+	if (pxLock->ulReaderWaiting != 0U)
+	{
+		pxLock->ulReaderWaiting = 0;
+		(void)xTaskNotifyGiveIndexed(pxLock->xReader, SEQLOCK_NOTIFY_INDEX);
+	}
+}
+
+/**
+ * @brief Wakes the reader if it is blocked in seqlock_wait() (writer ISR
+ * side).
+ * @param pxLock Channel.
+ * @param pxHigherPriorityTaskWoken Set if the reader must run on exit.
+ * @retval None
+ * @note Only from ISRs at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+static inline void seqlock_wake_from_isr(Seqlock_t *pxLock, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	__DMB();
+
+	if (pxLock->ulReaderWaiting != 0U)
+	{
+		pxLock->ulReaderWaiting = 0;
+		vTaskNotifyGiveIndexedFromISR(pxLock->xReader, SEQLOCK_NOTIFY_INDEX, pxHigherPriorityTaskWoken);
+	}
+}
+
+#endif /* SEQLOCK_H */
@@ -0,0 +1,116 @@
+/*******************************************************************************
+ *
+ * @file	spi.h
+ * @brief	Interface of the SPI master driver.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef SPI_H
+#define SPI_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clkgate.h"
+#include "xfer.h"
+#include "dma.h"
+#include "hrtimer.h"
+#include "pingpong.h"
+
+/* Macros --------------------------------------------------------------------*/
+/* Buses compiled in. SPI2 shares PB13 with CAN2 TX and SPI3 shares PC10 to
+ * PC12 with USART3 and UART5. */
+#ifndef SPI_USE_SPI1
+#define SPI_USE_SPI1 1
+#endif
+
+#ifndef SPI_USE_SPI2
+#define SPI_USE_SPI2 0
+#endif
+
+#ifndef SPI_USE_SPI3
+#define SPI_USE_SPI3 0
+#endif
+
+#ifndef SPI_DMA_PRIORITY
+#define SPI_DMA_PRIORITY DMA_PL_HIGH
+#endif
+
+/* SpiDevice_t modes: clock polarity and phase. */
+#define SPI_MODE_0			0U		/* Idle low, sample on the rising edge. */
+#define SPI_MODE_1			1U		/* Idle low, sample on the falling edge. */
+#define SPI_MODE_2			2U		/* Idle high, sample on the falling edge. */
+#define SPI_MODE_3			3U		/* Idle high, sample on the rising edge. */
+
+/* Data types ----------------------------------------------------------------*/
+typedef enum
+{
+	SPI_BUS_1 = 0U,					/* SPI1, PA5 (SCK)/PA6 (MISO)/PA7 (MOSI) */
+	SPI_BUS_2,						/* SPI2, PB13/PB14/PB15 */
+	SPI_BUS_3,						/* SPI3, PC10/PC11/PC12 */
+	SPI_BUSES
+} SpiBus_t;
+
+/* A chip on a bus, selected by its own pin, active low. */
+typedef struct
+{
+	uint8_t ucBus;					/* SpiBus_t */
+	uint8_t ucCsPin;
+	uint16_t usCr1;					/* Baud rate divider, CPOL and CPHA. */
+	GPIO_TypeDef *pxCsPort;
+	ClkGateUser_t xCsClock;
+} SpiDevice_t;
+
+/* One full-duplex transaction with chip select held low throughout. xReq is
+ * the caller's: pvData receives ulLen bytes, and it completes with ulLen or
+ * XFER_ERROR. The DMA descriptors are the driver's. */
+typedef struct
+{
+	XferReq_t xReq;
+	SpiDevice_t *pxDevice;
+	const void *pvTx;				/* ulLen bytes to send, NULL to send pvData. */
+	DmaDesc_t xRxDesc;
+	DmaDesc_t xTxDesc;
+} SpiXfer_t;
+
+/* A transaction repeated by an hrtimer, its replies gathered into the blocks
+ * of a ping-pong buffer. */
+typedef struct
+{
+	SpiXfer_t xXfer;
+	HrTimer_t xTimer;
+	PingPong_t *pxPingPong;			/* Blocks of ulSamples replies. */
+	uint8_t *pucBlock;				/* Being filled. */
+	uint32_t ulSamples;
+	uint32_t ulIndex;				/* Of the next reply in the block. */
+	volatile uint8_t ucBusy;		/* Submitted, not yet stored. */
+	volatile uint32_t ulMissed;		/* Periods skipped, the bus still busy. */
+	volatile uint32_t ulErrors;		/* Transactions failed. */
+} SpiPeriodic_t;
+
+typedef struct
+{
+	uint32_t ulXfers;				/* Completed. */
+	uint32_t ulBytes;
+	uint32_t ulErrors;				/* DMA errors. */
+	uint32_t ulQueued;				/* Submitted behind another one. */
+} SpiStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t spi_open(SpiBus_t xBus);
+int32_t spi_device_init(SpiDevice_t *pxDevice, SpiBus_t xBus, GPIO_TypeDef *pxCsPort,
+		uint8_t ucCsPin, uint32_t ulMaxHz, uint8_t ucMode);
+void spi_xfer_init(SpiXfer_t *pxXfer, SpiDevice_t *pxDevice, const void *pvTx, void *pvRx,
+		uint32_t ulLen);
+int32_t spi_submit(SpiXfer_t *pxXfer);
+int32_t spi_transfer(SpiDevice_t *pxDevice, const void *pvTx, void *pvRx, uint32_t ulLen);
+int32_t spi_periodic_start(SpiPeriodic_t *pxPeriodic, SpiDevice_t *pxDevice, const void *pvCmd,
+		uint32_t ulLen, uint32_t ulPeriodUs, PingPong_t *pxPingPong, uint32_t ulSamples);
+void spi_periodic_stop(SpiPeriodic_t *pxPeriodic);
+int32_t spi_get_stats(SpiBus_t xBus, SpiStats_t *pxStats);
+
+#endif /* SPI_H */
@@ -0,0 +1,27 @@
+/*******************************************************************************
+ *
+ * @file	timestamp.h
+ * @brief	Interface of the 64-bit microsecond time source.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef TIMESTAMP_H
+#define TIMESTAMP_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef TIMESTAMP_IRQ_PRIORITY
+#define TIMESTAMP_IRQ_PRIORITY 5U	/* Highest priority allowed to use FreeRTOS. */
+#endif
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t timestamp_init(void);
+uint64_t timestamp_now_us(void);
+uint32_t timestamp_now32(void);
+void timestamp_compare_callback(void);
+
+#endif /* TIMESTAMP_H */
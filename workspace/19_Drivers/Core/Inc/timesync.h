@@ -0,0 +1,117 @@
+/*******************************************************************************
+ *
+ * @file	timesync.h
+ * @brief	Interface of the clock synchronization over serial links.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef TIMESYNC_H
+#define TIMESYNC_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "uart.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef TIMESYNC_MAX_LINKS
+#define TIMESYNC_MAX_LINKS 2U			/* One TIM3 channel each, at most 4. */
+#endif
+
+#ifndef TIMESYNC_PERIOD_MS
+#define TIMESYNC_PERIOD_MS 1000U		/* Between the exchanges of a slave link. */
+#endif
+
+#ifndef TIMESYNC_TIMEOUT_MS
+#define TIMESYNC_TIMEOUT_MS 100U		/* For the master's response. */
+#endif
+
+#ifndef TIMESYNC_TX_LEAD_US
+#define TIMESYNC_TX_LEAD_US 200U		/* From stamping a frame to sending it. */
+#endif
+
+#ifndef TIMESYNC_STEP_US
+#define TIMESYNC_STEP_US 1000U			/* Larger errors step the clock. */
+#endif
+
+#ifndef TIMESYNC_MAX_SLEW_PPB
+#define TIMESYNC_MAX_SLEW_PPB 500000	/* 500 ppm, the most the clock is slewed. */
+#endif
+
+#ifndef TIMESYNC_DRIFT_GAIN
+#define TIMESYNC_DRIFT_GAIN 4			/* Share of a rate error taken per sample. */
+#endif
+
+#ifndef TIMESYNC_DELAY_WINDOW
+#define TIMESYNC_DELAY_WINDOW 8U		/* Samples the minimum delay is taken over. */
+#endif
+
+#ifndef TIMESYNC_DELAY_MARGIN_US
+#define TIMESYNC_DELAY_MARGIN_US 20U	/* Above the minimum, a sample is dropped. */
+#endif
+
+#ifndef TIMESYNC_LOCK_US
+#define TIMESYNC_LOCK_US 20U			/* Locked while the errors stay within it, */
+#endif
+
+#ifndef TIMESYNC_LOCK_SAMPLES
+#define TIMESYNC_LOCK_SAMPLES 4U		/* for this many samples in a row. */
+#endif
+
+#ifndef TIMESYNC_IRQ_PRIORITY
+#define TIMESYNC_IRQ_PRIORITY 5U		/* TIM3 capture. */
+#endif
+
+#ifndef TIMESYNC_STACK_WORDS
+#define TIMESYNC_STACK_WORDS 256U
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef enum
+{
+	TIMESYNC_MASTER = 0U,				/* Answers with this node's synchronized time. */
+	TIMESYNC_SLAVE						/* Follows the node at the other end. */
+} TimeSyncRole_t;
+
+typedef enum
+{
+	TIMESYNC_CAPTURE_PA6 = 0U,			/* TIM3 CH1, D12 */
+	TIMESYNC_CAPTURE_PA7,				/* TIM3 CH2, D11 */
+	TIMESYNC_CAPTURE_PB0,				/* TIM3 CH3, A3 */
+	TIMESYNC_CAPTURE_PB1,				/* TIM3 CH4 */
+	TIMESYNC_CAPTURES
+} TimeSyncCapture_t;
+
+/* The port is opened by timesync_start() and must be enabled in uart.h. Its
+ * RX pin is wired to the capture pin as well. */
+typedef struct
+{
+	UartPort_t xPort;
+	uint32_t ulBaudRate;
+	TimeSyncCapture_t xCapture;
+	TimeSyncRole_t xRole;
+} TimeSyncLink_t;
+
+typedef struct
+{
+	uint32_t ulExchanges;				/* Requests sent by the slave link. */
+	uint32_t ulAccepted;				/* Samples the servo took. */
+	uint32_t ulRejected;				/* Samples with a delay above the minimum. */
+	uint32_t ulTimeouts;
+	uint32_t ulSteps;					/* Times the clock was set, not slewed. */
+	uint32_t ulResponses;				/* Requests answered by the master links. */
+	int32_t lOffsetUs;					/* Last measured offset, master - this node. */
+	uint32_t ulDelayUs;					/* Last one-way delay. */
+	int32_t lDriftPpb;					/* Estimated rate of the master - this node. */
+	uint32_t ulLocked;					/* 1 once the errors stay within TIMESYNC_LOCK_US. */
+} TimeSyncStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+BaseType_t timesync_start(const TimeSyncLink_t *pxLinks, uint32_t ulLinks, UBaseType_t uxPriority);
+uint64_t timesync_now_us(void);
+uint64_t timesync_to_synced_us(uint64_t ullLocalUs);
+int32_t timesync_get_stats(TimeSyncStats_t *pxStats);
+
+#endif /* TIMESYNC_H */
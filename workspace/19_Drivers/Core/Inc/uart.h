@@ -11,9 +11,132 @@
 #define UART_H
 
 /* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "xfer.h"
+
+/* Macros --------------------------------------------------------------------*/
+/* Ports compiled in. Each claims its USART and DMA interrupt vectors (see the
+ * table in uart.c), so only enable the ones in use: USART6 RX shares DMA2
+ * Stream1 with gpio_capture.c. */
+#ifndef UART_USE_USART1
+#define UART_USE_USART1 0
+#endif
+
+#ifndef UART_USE_USART2
+#define UART_USE_USART2 1		/* ST-LINK virtual COM port, the console. */
+#endif
+
+#ifndef UART_USE_USART3
+#define UART_USE_USART3 0
+#endif
+
+#ifndef UART_USE_UART4
+#define UART_USE_UART4 0
+#endif
+
+#ifndef UART_USE_UART5
+#define UART_USE_UART5 0
+#endif
+
+#ifndef UART_USE_USART6
+#define UART_USE_USART6 0
+#endif
+
+#ifndef UART_TX_RING_SIZE
+#define UART_TX_RING_SIZE 512	/* Bytes buffered ahead of the USART2 TX DMA. */
+#endif
+
+#ifndef UART_TX_LANES
+#define UART_TX_LANES 2U		/* TX priority lanes per port, lane 0 the lowest. */
+#endif
+
+#ifndef UART_TX_LANE_CHUNK
+#define UART_TX_LANE_CHUNK 64U	/* Longest TX DMA chunk once a lane above 0 is attached. */
+#endif
+
+#ifndef UART_TX_URGENT_RING_SIZE
+#define UART_TX_URGENT_RING_SIZE 128	/* USART2 urgent lane; 0 for none. */
+#endif
+
+#ifndef UART_RX_RING_SIZE
+#define UART_RX_RING_SIZE 0		/* USART2 RX ring for uart_read(); 0 for none. */
+#endif
+
+#define UART_LANE_BULK 0U						/* The ring of UartConfig_t. */
+#define UART_LANE_URGENT (UART_TX_LANES - 1U)	/* The highest lane. */
+
+#ifndef UART_DEFAULT_BAUD_RATE
+#define UART_DEFAULT_BAUD_RATE 115200U	/* For USART2_UART_TX_Init() and _RX_Init(). */
+#endif
+
+#ifndef UART_BAUD_TOLERANCE_PPM
+#define UART_BAUD_TOLERANCE_PPM 20000U	/* 2 %, half the receiver tolerance. */
+#endif
+
+#ifndef UART_IRQ_PRIORITY
+#define UART_IRQ_PRIORITY 6U		/* At or below configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+#endif
+
+#ifndef UART_NOTIFY_INDEX
+#define UART_NOTIFY_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef enum
+{
+	UART_PORT_1 = 0U,				/* USART1, PA9/PA10 */
+	UART_PORT_2,					/* USART2, PA2/PA3 */
+	UART_PORT_3,					/* USART3, PC10/PC11 */
+	UART_PORT_4,					/* UART4, PA0/PA1 */
+	UART_PORT_5,					/* UART5, PC12/PD2 */
+	UART_PORT_6,					/* USART6, PC6/PC7 */
+	UART_PORTS
+} UartPort_t;
+
+/* 8 data bits, no parity, 1 stop bit. The buffers belong to the port until it
+ * is opened again. */
+typedef struct
+{
+	uint32_t ulBaudRate;			/* Up to the APB clock / 8. */
+	uint8_t *pucTxBuf;				/* TX ring drained by DMA; NULL for polled writes. */
+	uint16_t usTxSize;
+	uint8_t *pucRxBuf;				/* RX ring filled by circular DMA; NULL to */
+	uint16_t usRxSize;				/* leave the receiver to the application. */
+} UartConfig_t;
+
+typedef struct
+{
+	uint32_t ulTxBytes;				/* Sent. */
+	uint32_t ulTxDropped[UART_TX_LANES];	/* Bytes a write gave up on, per lane. */
+	uint32_t ulRxBytes;				/* Returned by uart_read(). */
+	uint32_t ulRxOverruns;			/* Times the reader fell a whole RX ring behind. */
+	uint32_t ulRxErrors;			/* Overrun, framing or noise errors. */
+} UartStats_t;
 
 /* Function Prototypes -------------------------------------------------------*/
+int32_t uart_open(UartPort_t xPort, const UartConfig_t *pxCfg);
+int32_t uart_write(UartPort_t xPort, const void *pvData, uint32_t ulLen, TickType_t xTicksToWait);
+int32_t uart_write_lane(UartPort_t xPort, uint32_t ulLane, const void *pvData, uint32_t ulLen,
+		TickType_t xTicksToWait);
+int32_t uart_attach_tx_lane(UartPort_t xPort, uint32_t ulLane, uint8_t *pucBuf, uint16_t usSize);
+int32_t uart_read(UartPort_t xPort, void *pvData, uint32_t ulLen, TickType_t xTicksToWait);
+int32_t uart_write_async(UartPort_t xPort, XferReq_t *pxReq);
+int32_t uart_read_async(UartPort_t xPort, XferReq_t *pxReq);
+void uart_flush(UartPort_t xPort);
+int32_t uart_set_baud_rate(UartPort_t xPort, uint32_t ulBaudRate);
+uint32_t uart_get_baud_rate(UartPort_t xPort);
+int32_t uart_get_stats(UartPort_t xPort, UartStats_t *pxStats);
+
+/* USART2 console, on UART_PORT_2. */
+int32_t USART2_UART_Open(uint32_t ulBaudRate);
+int32_t USART2_set_baud_rate(uint32_t ulBaudRate);
+uint32_t USART2_get_baud_rate(void);
 void USART2_UART_TX_Init(void);
 void USART2_UART_RX_Init(void);
+int USART2_write_buffer(const char *ptr, int len);
+int USART2_write_urgent(const char *ptr, int len);
+void USART2_flush(void);
 
 #endif /* UART_H */
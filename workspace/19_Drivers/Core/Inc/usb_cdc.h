@@ -0,0 +1,63 @@
+/*******************************************************************************
+ *
+ * @file	usb_cdc.h
+ * @brief	Interface of the USB CDC-ACM output channel.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef USB_CDC_H
+#define USB_CDC_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+/* Macros --------------------------------------------------------------------*/
+/* Bytes written and not yet sent. Up to 65472 (1023 packets a transfer). */
+#ifndef USB_CDC_TX_BUFFER_BYTES
+#define USB_CDC_TX_BUFFER_BYTES 4096U
+#endif
+
+/* Packets the bulk IN FIFO holds: with two, the core sends one while the CPU
+ * writes the next. Up to 10 fit in the 1.25 KB of FIFO RAM. */
+#ifndef USB_CDC_IN_PACKETS
+#define USB_CDC_IN_PACKETS 2U
+#endif
+
+#ifndef USB_CDC_IRQ_PRIORITY
+#define USB_CDC_IRQ_PRIORITY 6U		/* At or below configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+#endif
+
+/* ST's Virtual COM Port IDs: the host needs no driver of its own. */
+#ifndef USB_CDC_VID
+#define USB_CDC_VID 0x0483U
+#endif
+
+#ifndef USB_CDC_PID
+#define USB_CDC_PID 0x5740U
+#endif
+
+#ifndef USB_CDC_PRODUCT
+#define USB_CDC_PRODUCT "FreeRTOS CDC"
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulBytes;				/* Sent to the host. */
+	uint32_t ulTransfers;			/* Bulk IN transfers completed. */
+	uint32_t ulDropped;				/* Written with no host, or with the buffer full. */
+	uint32_t ulRxDiscarded;			/* Sent by the host, not read. */
+	uint32_t ulResets;				/* Bus resets: (re)connections. */
+	uint32_t ulSuspends;			/* Bus suspends: disconnections, host sleep. */
+} UsbCdcStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t usb_cdc_open(void);
+uint32_t usb_cdc_write(const void *pvData, uint32_t ulLen);
+uint32_t usb_cdc_is_connected(void);
+void usb_cdc_get_stats(UsbCdcStats_t *pxStats);
+
+#endif /* USB_CDC_H */
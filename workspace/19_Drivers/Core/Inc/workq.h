@@ -0,0 +1,54 @@
+/*******************************************************************************
+ *
+ * @file	workq.h
+ * @brief	Interface of the deferred interrupt work queue.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef WORKQ_H
+#define WORKQ_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef WORKQ_LANES
+#define WORKQ_LANES 2U				/* Worker tasks, one per lane. */
+#endif
+
+#ifndef WORKQ_RING_SIZE
+#define WORKQ_RING_SIZE 16U			/* Work items per lane, a power of two. */
+#endif
+
+#ifndef WORKQ_STACK_WORDS
+#define WORKQ_STACK_WORDS 256U		/* Shared by every work function of a lane. */
+#endif
+
+#ifndef WORKQ_NOTIFY_INDEX
+#define WORKQ_NOTIFY_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef void (*WorkqFunction_t)(void *pvArg);
+
+typedef struct
+{
+	uint32_t ulDone;			/* Work items run. */
+	uint32_t ulDropped;			/* Posts refused because the ring was full. */
+	uint32_t ulPeakDepth;		/* Most items waiting at once. */
+	uint32_t ulMinCycles;		/* Post to start of the work function. */
+	uint32_t ulMaxCycles;
+	uint64_t ullTotalCycles;
+} WorkqStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t workq_start_lane(uint32_t ulLane, UBaseType_t uxPriority);
+int32_t workq_post(uint32_t ulLane, WorkqFunction_t pxFunction, void *pvArg);
+int32_t workq_post_from_isr(uint32_t ulLane, WorkqFunction_t pxFunction, void *pvArg,
+		BaseType_t *pxHigherPriorityTaskWoken);
+int32_t workq_get_stats(uint32_t ulLane, WorkqStats_t *pxStats);
+
+#endif /* WORKQ_H */
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ *
+ * @file	xfer.h
+ * @brief	Interface of the asynchronous transfer requests shared by the
+ * 			DMA drivers.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef XFER_H
+#define XFER_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define XFER_PENDING		(-2)	/* lResult while the driver owns the request. */
+#define XFER_ERROR			(-1)	/* lResult of a failed transfer. */
+
+#ifndef XFER_NOTIFY_INDEX
+#define XFER_NOTIFY_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct XferReq XferReq_t;
+
+/* Runs in the driver's ISR, or in the submitting task when the request
+ * completes at once. */
+typedef void (*XferCallback_t)(XferReq_t *pxReq, BaseType_t *pxHigherPriorityTaskWoken);
+
+typedef enum
+{
+	XFER_SIGNAL_NONE = 0U,			/* Poll xfer_done(). */
+	XFER_SIGNAL_CALLBACK,
+	XFER_SIGNAL_TASK,				/* Notification XFER_NOTIFY_INDEX, see xfer_wait(). */
+	XFER_SIGNAL_EVENT				/* Bits set in an event group. */
+} XferSignal_t;
+
+/* One transfer. It belongs to the driver from submission to completion and
+ * must not be touched, or go out of scope, meanwhile. */
+struct XferReq
+{
+	XferReq_t *pxNext;				/* Driver queue. */
+	void *pvData;
+	uint32_t ulLen;					/* Bytes for the UART, samples for the ADC. */
+	volatile int32_t lResult;		/* XFER_PENDING, then the amount done or XFER_ERROR. */
+	XferSignal_t xSignal;
+	XferCallback_t pxCallback;
+	void *pvContext;				/* For the callback. */
+	TaskHandle_t xTask;
+	EventGroupHandle_t xEvents;
+	EventBits_t uxBits;
+};
+
+/* Requests waiting on a driver, oldest first. */
+typedef struct
+{
+	XferReq_t *pxHead;
+	XferReq_t *pxTail;
+} XferQueue_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+void xfer_init(XferReq_t *pxReq, void *pvData, uint32_t ulLen);
+void xfer_on_callback(XferReq_t *pxReq, XferCallback_t pxCallback, void *pvContext);
+void xfer_on_task(XferReq_t *pxReq, TaskHandle_t xTask);
+void xfer_on_event(XferReq_t *pxReq, EventGroupHandle_t xEvents, EventBits_t uxBits);
+int32_t xfer_wait(XferReq_t *pxReq, TickType_t xTicksToWait);
+
+/* Driver side. */
+int32_t xfer_queue_push(XferQueue_t *pxQueue, XferReq_t *pxReq);
+XferReq_t *xfer_queue_pop(XferQueue_t *pxQueue);
+void xfer_complete(XferReq_t *pxReq, int32_t lResult);
+void xfer_complete_from_isr(XferReq_t *pxReq, int32_t lResult,
+		BaseType_t *pxHigherPriorityTaskWoken);
+
+/* Function definitions ------------------------------------------------------*/
+
+/**
+ * @brief Tells whether a request has completed.
+ * @param pxReq Request.
+ * @retval 1 if the driver has given it back, 0 otherwise.
+ */
+static inline int32_t xfer_done(const XferReq_t *pxReq)
+{
+	return (pxReq->lResult != XFER_PENDING) ? 1 : 0;
+}
+
+#endif /* XFER_H */
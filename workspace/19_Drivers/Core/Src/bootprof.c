@@ -0,0 +1,244 @@
+/*******************************************************************************
+ *
+ * @file	bootprof.c
+ * @brief	Boot profiler: DWT-timestamped markers from reset to the first
+ * 			task, kept in .noinit for a dump after boot.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Reset_Handler starts CYCCNT at 0 and stamps the end of
+ * 			SystemInit(), of the .data copy, of the .bss clear and of the
+ * 			constructors (g_ulBootStamps). bootprof_init(), the first call
+ * 			in main(), turns those into the first marks. main() then calls
+ * 			bootprof_mark() after each phase, and the context switch hook
+ * 			(bootprof.h) adds the switch into the first task.
+ *
+ * 			Each mark keeps the cycle count and SystemCoreClock at that
+ * 			moment. An interval is converted with the clock at its start,
+ * 			so the one containing SystemClock_Config() is counted at the
+ * 			reset clock throughout and slightly overestimated.
+ *
+ * 			The profile is in .noinit, so the startup code does not clear
+ * 			it: a debugger can read xBootProfile whatever the application
+ * 			does next, and it survives until bootprof_init() in the next
+ * 			boot. CYCCNT wraps after 2^32 cycles, 23 s at 180 MHz.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "bootprof.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define BOOTPROF_MAGIC			0xB0070F11UL
+#define BOOTPROF_STARTUP_STAMPS	4U
+
+#if (BOOTPROF_MAX_MARKS < (BOOTPROF_STARTUP_STAMPS + 2U))
+#error BOOTPROF_MAX_MARKS must leave room for the startup stamps and main()
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulCycles;				/* CYCCNT, from reset. */
+	uint32_t ulHz;					/* SystemCoreClock at the mark. */
+	uint8_t ucSwitch;				/* 1 if cName is a task switched in. */
+	char cName[BOOTPROF_NAME_LEN];	/* Terminated. */
+} BootProfMark_t;
+
+typedef struct
+{
+	uint32_t ulMagic;				/* BOOTPROF_MAGIC once initialized. */
+	uint32_t ulBoots;				/* Boots profiled since power-on. */
+	uint32_t ulCount;
+	uint32_t ulDropped;				/* Marks that did not fit. */
+	BootProfMark_t xMarks[BOOTPROF_MAX_MARKS];
+} BootProfile_t;
+
+/* Variables -----------------------------------------------------------------*/
+extern const uint32_t g_ulBootStamps[BOOTPROF_STARTUP_STAMPS];	/* Startup code. */
+
+static const char * const pcBootStampNames[BOOTPROF_STARTUP_STAMPS] =
+{
+	"SystemInit", ".data", ".bss", "constructors"
+};
+
+static BootProfile_t xBootProfile __attribute__((section(".noinit")));
+
+/* Read by the context switch hook; cleared in .bss until bootprof_init(). */
+volatile uint32_t ulBootProfSwitchesLeft = 0;
+
+/* Private function prototypes -----------------------------------------------*/
+static void bootprof_add(const char *pcName, uint32_t ulCycles, uint32_t ulHz,
+		uint8_t ucSwitch);
+static uint32_t bootprof_elapsed_us(uint32_t ulCount, uint32_t *pulLastUs);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Starts the profile of this boot with the startup stamps and a "main"
+ * mark.
+ * @param None
+ * @retval None
+ * @note Call first in main(), before HAL_Init().
+ */
+void bootprof_init(void)
+{
+	uint32_t i;
+
+	xBootProfile.ulBoots = (xBootProfile.ulMagic == BOOTPROF_MAGIC) ? (xBootProfile.ulBoots + 1U) : 1U;
+	xBootProfile.ulMagic = BOOTPROF_MAGIC;
+	xBootProfile.ulCount = 0;
+	xBootProfile.ulDropped = 0;
+
+	/* SystemInit() keeps the reset clock. */
+	for (i = 0; i < BOOTPROF_STARTUP_STAMPS; i++)
+	{
+		bootprof_add(pcBootStampNames[i], g_ulBootStamps[i], HSI_VALUE, 0);
+	}
+
+	bootprof_mark("main");
+
+	ulBootProfSwitchesLeft = BOOTPROF_SWITCH_MARKS;
+}
+
+/**
+ * @brief Records the end of a boot phase.
+ * @param pcName Name of the phase; copied, cut at BOOTPROF_NAME_LEN - 1.
+ * @retval None
+ * @note Any context. Marks beyond BOOTPROF_MAX_MARKS are counted as dropped.
+ */
+void bootprof_mark(const char *pcName)
+{
+	bootprof_add(pcName, DWT->CYCCNT, SystemCoreClock, 0);
+}
+
+/**
+ * @brief Records a task being switched in, for the first BOOTPROF_SWITCH_MARKS
+ * switches after bootprof_init().
+ * @param pcTaskName Name of the task.
+ * @retval None
+ * @note Called from the context switch hook (bootprof.h), only while
+ * ulBootProfSwitchesLeft is not 0.
+ */
+void bootprof_task_switched_in(const char *pcTaskName)
+{
+	ulBootProfSwitchesLeft--;
+	bootprof_add(pcTaskName, DWT->CYCCNT, SystemCoreClock, 1);
+}
+
+/**
+ * @brief Returns the time from reset to the last mark.
+ * @param None
+ * @retval Microseconds.
+ */
+uint32_t bootprof_get_us(void)
+{
+	return bootprof_elapsed_us(xBootProfile.ulCount, NULL);
+}
+
+/**
+ * @brief Prints the profile of this boot with printf().
+ * @param None
+ * @retval None
+ * @note From a task, once the marks of interest have been recorded. Each line
+ * gives the time from reset, the length of the phase and its name; switches
+ * into tasks are prefixed with "task".
+ */
+void bootprof_dump(void)
+{
+	uint32_t ulCount = xBootProfile.ulCount;
+	uint32_t ulUs;
+	uint32_t ulLastUs;
+	uint32_t i;
+
+	printf("bootprof: boot %lu, %lu marks, %lu dropped\r\n",
+			xBootProfile.ulBoots, ulCount, xBootProfile.ulDropped);
+
+	for (i = 0; i < ulCount; i++)
+	{
+		ulUs = bootprof_elapsed_us(i + 1U, &ulLastUs);
+		printf("bootprof: %8lu us  +%7lu us  %s%s\r\n", ulUs, ulUs - ulLastUs,
+				(xBootProfile.xMarks[i].ucSwitch != 0U) ? "task " : "",
+				xBootProfile.xMarks[i].cName);
+	}
+
+	ulUs = bootprof_elapsed_us(ulCount, NULL);
+
+#if (BOOTPROF_BUDGET_US > 0U)
+	printf("bootprof: total %lu us, budget %lu us: %s\r\n", ulUs,
+			(unsigned long)BOOTPROF_BUDGET_US, (ulUs <= BOOTPROF_BUDGET_US) ? "ok" : "OVER");
+#else
+	printf("bootprof: total %lu us\r\n", ulUs);
+#endif
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Appends a mark with interrupts masked, so tasks, ISRs and the context
+ * switch hook can all record.
+ * @param pcName Name; copied.
+ * @param ulCycles CYCCNT at the mark.
+ * @param ulHz Core clock at the mark.
+ * @param ucSwitch 1 for a task switched in.
+ * @retval None
+ * @note PRIMASK rather than a kernel critical section, which would leave
+ * interrupts masked when called before the scheduler starts.
+ */
+static void bootprof_add(const char *pcName, uint32_t ulCycles, uint32_t ulHz,
+		uint8_t ucSwitch)
+{
+	const uint32_t ulPrimask = __get_PRIMASK();
+	BootProfMark_t *pxMark;
+
+	__disable_irq();
+
+	if (xBootProfile.ulCount < BOOTPROF_MAX_MARKS)
+	{
+		pxMark = &xBootProfile.xMarks[xBootProfile.ulCount++];
+		pxMark->ulCycles = ulCycles;
+		pxMark->ulHz = ulHz;
+		pxMark->ucSwitch = ucSwitch;
+		strncpy(pxMark->cName, pcName, sizeof(pxMark->cName) - 1U);
+		pxMark->cName[sizeof(pxMark->cName) - 1U] = '\0';
+	}
+	else
+	{
+		xBootProfile.ulDropped++;
+	}
+
+	__set_PRIMASK(ulPrimask);
+}
+
+/**
+ * @brief Converts the first ulCount marks to the time from reset to the last
+ * of them, each interval at the clock in effect at its start.
+ * @param ulCount Marks to add up.
+ * @param pulLastUs If not NULL, receives the time to the mark before.
+ * @retval Microseconds.
+ */
+static uint32_t bootprof_elapsed_us(uint32_t ulCount, uint32_t *pulLastUs)
+{
+	uint64_t ullUs = 0;
+	uint64_t ullLastUs = 0;
+	uint32_t ulCycles = 0;
+	uint32_t ulHz = HSI_VALUE;
+	uint32_t i;
+
+	for (i = 0; (i < ulCount) && (i < BOOTPROF_MAX_MARKS); i++)
+	{
+		ullLastUs = ullUs;
+		ullUs += ((uint64_t)(xBootProfile.xMarks[i].ulCycles - ulCycles) * 1000000U) / ulHz;
+		ulCycles = xBootProfile.xMarks[i].ulCycles;
+		ulHz = xBootProfile.xMarks[i].ulHz;
+	}
+
+	if (pulLastUs != NULL)
+	{
+		*pulLastUs = (uint32_t)ullLastUs;
+	}
+
+	return (uint32_t)ullUs;
+}
@@ -0,0 +1,954 @@
+/*******************************************************************************
+ *
+ * @file	can.c
+ * @brief	Implementation of the bxCAN driver.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	One driver for CAN1 and CAN2, table driven like uart.c.
+ *
+ * 			RX: every subscriber owns one filter bank, in 32-bit mask mode,
+ * 			so the hardware drops the frames no subscriber wants and the CPU
+ * 			never sees them. A frame that passes lands in the FIFO of its
+ * 			bank with the bank's filter match index (FMI). The FIFO's ISR
+ * 			looks the subscriber up by that index and copies the frame into
+ * 			its queue, or its lock-free ring, and releases the FIFO slot:
+ * 			no search and no task in between. The banks of each controller
+ * 			are split between the two FIFOs once and for all, so the index
+ * 			of a bank never changes while frames wait. Each FIFO has its own
+ * 			interrupt, so latency-critical subscribers can have FIFO 1 to
+ * 			themselves.
+ *
+ * 			The reference manual counts the indexes of CAN2 from its first
+ * 			bank. The ISR checks the frame against the subscriber's filter
+ * 			anyway and searches the port's banks if they disagree
+ * 			(ulRxMisrouted), so a stale or miscounted index costs time, not
+ * 			frames.
+ *
+ * 			TX: the mailboxes go out by identifier (TXFP = 0), as bus
+ * 			arbitration would order them. Frames waiting for a mailbox are
+ * 			kept sorted the same way, and when all three hold less urgent
+ * 			frames than the first one waiting, the least urgent is aborted
+ * 			and queued again. Frames with the same identifier never share
+ * 			the mailboxes, which would send them by mailbox number instead
+ * 			of in order. A counting semaphore of CAN_TX_QUEUE_LEN slots, one
+ * 			per frame until it is acknowledged, blocks senders.
+ *
+ * 			The bit timing is computed from PCLK1 with the sample point at
+ * 			87.5 %. After a clock profile switch, call can_set_bit_rate()
+ * 			from clock_profile_changed_callback().
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "clkgate.h"
+#include "can.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define CAN_INIT_TIMEOUT		100000U	/* Busy-wait iterations for (INAK), > 11 bits. */
+#define CAN_TQ_MAX				25U
+#define CAN_TQ_MIN				8U
+#define CAN_TSR_MAILBOX_STRIDE	8U		/* RQCP, TXOK, ALST, TERR, ABRQ of a mailbox. */
+#define CAN_RIR_IDE				(1U << 2)
+#define CAN_RIR_RTR				(1U << 1)
+#define GPIO_PORT_STRIDE		0x400U
+#define PIN_MODE_AF				2U
+#define PIN_SPEED_FAST			2U
+#define PIN_PULL_UP				1U
+#define PIN_AF_CAN				9U
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	CAN_TypeDef *pxCan;
+	uint8_t ucClock;				/* ClkGate_t of the controller. */
+	uint8_t ucFirstBank;
+	uint8_t ucBanks;
+	GPIO_TypeDef *pxPort;			/* RX and TX pins. */
+	uint8_t ucRxPin;
+	uint8_t ucTxPin;
+	IRQn_Type xTxIrq;
+	IRQn_Type xRx0Irq;
+	IRQn_Type xRx1Irq;
+	uint8_t ucEnabled;				/* CAN_USE_xxx */
+} CanHw_t;
+
+typedef struct
+{
+	uint8_t ucOpen;
+	uint32_t ulBitRate;
+
+	SemaphoreHandle_t xTxSlots;
+	StaticSemaphore_t xTxSlotsBuffer;
+	/* Waiting frames, most urgent last; equal keys oldest last. */
+	CanFrame_t xTxPending[CAN_TX_QUEUE_LEN];
+	uint32_t ulTxKey[CAN_TX_QUEUE_LEN];
+	uint8_t ucTxCount;
+	CanFrame_t xMailbox[CAN_MAILBOXES];	/* Copies, to queue an aborted one again. */
+	uint32_t ulMailboxKey[CAN_MAILBOXES];
+	uint8_t ucMailboxBusy;			/* Bit n: mailbox n holds a frame. */
+	uint8_t ucMailboxAborting;
+
+	CanStats_t xStats;
+} CanState_t;
+
+typedef struct
+{
+	ClkGateUser_t xCan;
+	ClkGateUser_t xCan1;			/* The filters, for CAN2. */
+	ClkGateUser_t xPins;
+} CanClocks_t;
+
+/* Variables -----------------------------------------------------------------*/
+static const CanHw_t xCanHw[CAN_PORTS] =
+{
+	{ CAN1, CLKGATE_CAN1, 0U, CAN_CAN2_FIRST_BANK, GPIOB, 8, 9,
+			CAN1_TX_IRQn, CAN1_RX0_IRQn, CAN1_RX1_IRQn, CAN_USE_CAN1 },
+	{ CAN2, CLKGATE_CAN2, CAN_CAN2_FIRST_BANK, CAN_FILTER_BANKS - CAN_CAN2_FIRST_BANK,
+			GPIOB, 12, 13, CAN2_TX_IRQn, CAN2_RX0_IRQn, CAN2_RX1_IRQn, CAN_USE_CAN2 }
+};
+
+static CanState_t xCanState[CAN_PORTS];
+static CanClocks_t xCanClocks[CAN_PORTS];
+
+/* Subscriber of each bank, read by the RX ISRs. */
+static CanSub_t *volatile pxBankSub[CAN_FILTER_BANKS];
+
+/* Private function prototypes -----------------------------------------------*/
+static int32_t can_compute_btr(uint32_t ulPclk, uint32_t ulBitRate, uint32_t *pulBtr);
+static int32_t can_enter_init(CAN_TypeDef *pxCan);
+static int32_t can_leave_init(CAN_TypeDef *pxCan);
+static void can_filters_init(void);
+static void can_pin_init(GPIO_TypeDef *pxPort, uint8_t ucPin, uint8_t ucPullUp);
+static uint32_t can_key(const CanFrame_t *pxFrame);
+static void can_tx_insert(CanState_t *pxState, const CanFrame_t *pxFrame, uint32_t ulKey,
+		BaseType_t xRequeue);
+static void can_tx_kick(CanPort_t xPort);
+static CanSub_t *can_rx_route(CanPort_t xPort, uint32_t ulFifo, uint32_t ulFmi, uint32_t ulRir);
+static void can_tx_irq(CanPort_t xPort);
+static void can_rx_irq(CanPort_t xPort, uint32_t ulFifo);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Opens a controller.
+ * @param xPort Port, compiled in with its CAN_USE_xxx.
+ * @param pxCfg Bit rate and mode.
+ * @retval 0 if successful, -1 if the port is not compiled in or already open,
+ * the bit rate does not divide PCLK1, or the controller does not synchronize
+ * with the bus (11 recessive bits on RX).
+ * @note Frames are only received once subscribed to. Bus-off is recovered
+ * from automatically. Call from a task or before the scheduler starts.
+ */
+int32_t can_open(CanPort_t xPort, const CanConfig_t *pxCfg)
+{
+	const CanHw_t *pxHw;
+	CanState_t *pxState;
+	CanClocks_t *pxClocks;
+	uint32_t ulBtr;
+
+	if ((xPort >= CAN_PORTS) || (pxCfg == NULL) || (xCanHw[xPort].ucEnabled == 0U)
+			|| (xCanState[xPort].ucOpen != 0U)
+			|| (can_compute_btr(HAL_RCC_GetPCLK1Freq(), pxCfg->ulBitRate, &ulBtr) != 0))
+	{
+		return -1;
+	}
+
+	pxHw = &xCanHw[xPort];
+	pxState = &xCanState[xPort];
+	pxClocks = &xCanClocks[xPort];
+
+	if (pxClocks->xCan.ucHeld == 0U)
+	{
+		clkgate_user_init(&pxClocks->xCan, (ClkGate_t)pxHw->ucClock);
+		clkgate_user_init(&pxClocks->xCan1, CLKGATE_CAN1);
+		clkgate_user_init(&pxClocks->xPins, (ClkGate_t)(CLKGATE_GPIOA
+				+ (((uint32_t)pxHw->pxPort - GPIOA_BASE) / GPIO_PORT_STRIDE)));
+	}
+
+	clkgate_acquire(&pxClocks->xCan1);
+	clkgate_acquire(&pxClocks->xCan);
+	clkgate_acquire(&pxClocks->xPins);
+
+	can_pin_init(pxHw->pxPort, pxHw->ucRxPin, 1);
+	can_pin_init(pxHw->pxPort, pxHw->ucTxPin, 0);
+	can_filters_init();
+
+	if (can_enter_init(pxHw->pxCan) != 0)
+	{
+		return -1;
+	}
+
+	memset(pxState, 0, sizeof(*pxState));
+	pxState->ulBitRate = pxCfg->ulBitRate;
+	pxState->xTxSlots = xSemaphoreCreateCountingStatic(CAN_TX_QUEUE_LEN, CAN_TX_QUEUE_LEN,
+			&pxState->xTxSlotsBuffer);
+
+	/* Automatic bus-off recovery and retransmission; mailboxes by identifier;
+	 * a full FIFO keeps its frames. */
+	pxHw->pxCan->MCR = CAN_MCR_INRQ | CAN_MCR_ABOM | CAN_MCR_RFLM | CAN_MCR_DBF;
+	pxHw->pxCan->BTR = ulBtr
+			| (((pxCfg->ucMode & CAN_MODE_LOOPBACK) != 0U) ? CAN_BTR_LBKM : 0U)
+			| (((pxCfg->ucMode & CAN_MODE_SILENT) != 0U) ? CAN_BTR_SILM : 0U);
+	pxHw->pxCan->IER = CAN_IER_TMEIE | CAN_IER_FMPIE0 | CAN_IER_FOVIE0 | CAN_IER_FMPIE1
+			| CAN_IER_FOVIE1;
+
+	NVIC_SetPriority(pxHw->xTxIrq, CAN_IRQ_PRIORITY);
+	NVIC_SetPriority(pxHw->xRx0Irq, CAN_IRQ_PRIORITY);
+	NVIC_SetPriority(pxHw->xRx1Irq, CAN_IRQ_PRIORITY);
+	NVIC_EnableIRQ(pxHw->xTxIrq);
+	NVIC_EnableIRQ(pxHw->xRx0Irq);
+	NVIC_EnableIRQ(pxHw->xRx1Irq);
+
+	pxState->ucOpen = 1;
+
+	return can_leave_init(pxHw->pxCan);
+}
+
+/**
+ * @brief Changes the bit rate of an open controller.
+ * @param xPort Open port.
+ * @param ulBitRate New bit rate, or the current one to follow a PCLK1 change.
+ * @retval 0 if successful, -1 if the port is not open, the bit rate does not
+ * divide PCLK1, or the controller does not synchronize with the bus.
+ * @note Frames in the mailboxes are sent at the new rate. Call from a task,
+ * e.g. from clock_profile_changed_callback().
+ */
+int32_t can_set_bit_rate(CanPort_t xPort, uint32_t ulBitRate)
+{
+	CAN_TypeDef *pxCan;
+	uint32_t ulBtr;
+
+	if ((xPort >= CAN_PORTS) || (xCanState[xPort].ucOpen == 0U)
+			|| (can_compute_btr(HAL_RCC_GetPCLK1Freq(), ulBitRate, &ulBtr) != 0))
+	{
+		return -1;
+	}
+
+	pxCan = xCanHw[xPort].pxCan;
+
+	if (can_enter_init(pxCan) != 0)
+	{
+		return -1;
+	}
+
+	pxCan->BTR = (pxCan->BTR & (CAN_BTR_LBKM | CAN_BTR_SILM)) | ulBtr;
+	xCanState[xPort].ulBitRate = ulBitRate;
+
+	return can_leave_init(pxCan);
+}
+
+/**
+ * @brief Programs a filter bank for a subscriber.
+ * @param xPort Open port.
+ * @param pxSub Subscriber, not subscribed.
+ * @param pxCfg Filter, FIFO and destination.
+ * @retval 0 if successful, -1 if the port is not open, the configuration is
+ * invalid, or the FIFO has no free bank left.
+ * @note Frames matching several subscribers go to the first bank's. Call from
+ * a task.
+ */
+int32_t can_subscribe(CanPort_t xPort, CanSub_t *pxSub, const CanSubConfig_t *pxCfg)
+{
+	const CanHw_t *pxHw;
+	const uint32_t ulIdBits = ((pxCfg->ucFlags & CAN_FLAG_EXT) != 0U) ? 29U : 11U;
+	uint32_t ulFirst;
+	uint32_t ulLast;
+	uint32_t ulBank;
+
+	if ((xPort >= CAN_PORTS) || (xCanState[xPort].ucOpen == 0U) || (pxCfg->ucFifo > 1U)
+			|| ((pxCfg->ulId >> ulIdBits) != 0U) || ((pxCfg->ulMask >> ulIdBits) != 0U)
+			|| ((pxCfg->xQueue == NULL) && ((pxCfg->pxRing == NULL) || (pxCfg->usRingSize == 0U)
+					|| ((pxCfg->usRingSize & (pxCfg->usRingSize - 1U)) != 0U))))
+	{
+		return -1;
+	}
+
+	pxHw = &xCanHw[xPort];
+	ulFirst = pxHw->ucFirstBank + ((pxCfg->ucFifo == 0U) ? 0U : CAN_FIFO0_BANKS);
+	ulLast = (pxCfg->ucFifo == 0U) ? (pxHw->ucFirstBank + CAN_FIFO0_BANKS)
+			: (pxHw->ucFirstBank + pxHw->ucBanks);
+
+	if (ulLast > (uint32_t)(pxHw->ucFirstBank + pxHw->ucBanks))
+	{
+		ulLast = pxHw->ucFirstBank + pxHw->ucBanks;
+	}
+
+	memset(pxSub, 0, sizeof(*pxSub));
+	pxSub->xQueue = pxCfg->xQueue;
+	pxSub->pxRing = pxCfg->pxRing;
+	pxSub->ulRingMask = (pxCfg->xQueue == NULL) ? (pxCfg->usRingSize - 1U) : 0U;
+	pxSub->ucPort = (uint8_t)xPort;
+
+	/* The layout of the receive identifier register, the IDE bit compared. */
+	if ((pxCfg->ucFlags & CAN_FLAG_EXT) != 0U)
+	{
+		pxSub->ulFr1 = (pxCfg->ulId << 3) | CAN_RIR_IDE;
+		pxSub->ulFr2 = (pxCfg->ulMask << 3) | CAN_RIR_IDE;
+	}
+	else
+	{
+		pxSub->ulFr1 = pxCfg->ulId << 21;
+		pxSub->ulFr2 = (pxCfg->ulMask << 21) | CAN_RIR_IDE;
+	}
+
+	taskENTER_CRITICAL();
+
+	for (ulBank = ulFirst; ulBank < ulLast; ulBank++)
+	{
+		if (pxBankSub[ulBank] == NULL)
+		{
+			break;
+		}
+	}
+
+	if (ulBank < ulLast)
+	{
+		pxSub->ucBank = (uint8_t)ulBank;
+		pxBankSub[ulBank] = pxSub;
+
+		/* An inactive bank can be written without stopping reception. */
+		CAN1->FA1R &= ~(1U << ulBank);
+		CAN1->sFilterRegister[ulBank].FR1 = pxSub->ulFr1;
+		CAN1->sFilterRegister[ulBank].FR2 = pxSub->ulFr2;
+		CAN1->FA1R |= (1U << ulBank);
+	}
+
+	taskEXIT_CRITICAL();
+
+	return (ulBank < ulLast) ? 0 : -1;
+}
+
+/**
+ * @brief Frees a subscriber's filter bank.
+ * @param pxSub Subscriber.
+ * @retval None
+ * @note Frames of the bank still in the FIFO are dropped. Call from a task.
+ */
+void can_unsubscribe(CanSub_t *pxSub)
+{
+	taskENTER_CRITICAL();
+
+	if (pxBankSub[pxSub->ucBank] == pxSub)
+	{
+		CAN1->FA1R &= ~(1U << pxSub->ucBank);
+		pxBankSub[pxSub->ucBank] = NULL;
+	}
+
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Queues a frame for transmission.
+ * @param xPort Open port.
+ * @param pxFrame Frame. Copied before the call returns.
+ * @param xTicksToWait How long a task waits for one of the CAN_TX_QUEUE_LEN
+ * slots.
+ * @retval 0 if queued, -1 if the port is not open, the frame is invalid or no
+ * slot came free.
+ * @note Frames leave most urgent (lowest identifier) first, and in order for
+ * one identifier. May be called from an ISR, without waiting.
+ */
+int32_t can_send(CanPort_t xPort, const CanFrame_t *pxFrame, TickType_t xTicksToWait)
+{
+	CanState_t *pxState;
+	UBaseType_t uxSavedInterruptStatus;
+	BaseType_t xTaken;
+
+	if ((xPort >= CAN_PORTS) || (xCanState[xPort].ucOpen == 0U) || (pxFrame->ucDlc > 8U)
+			|| ((pxFrame->ulId >> (((pxFrame->ucFlags & CAN_FLAG_EXT) != 0U) ? 29U : 11U)) != 0U))
+	{
+		return -1;
+	}
+
+	pxState = &xCanState[xPort];
+
+	if (xPortIsInsideInterrupt() != pdFALSE)
+	{
+		xTaken = xSemaphoreTakeFromISR(pxState->xTxSlots, NULL);
+	}
+	else
+	{
+		xTaken = xSemaphoreTake(pxState->xTxSlots, xTicksToWait);
+	}
+
+	if (xTaken != pdTRUE)
+	{
+		return -1;
+	}
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	can_tx_insert(pxState, pxFrame, can_key(pxFrame), pdFALSE);
+	can_tx_kick(xPort);
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	return 0;
+}
+
+/**
+ * @brief Reads a frame from a subscriber's ring.
+ * @param pxSub Subscriber with a ring; a task reads it, one at a time.
+ * @param pxFrame Receives the frame.
+ * @param xTicksToWait How long to wait for one.
+ * @retval 1 if a frame was read, 0 on timeout, -1 if the subscriber delivers
+ * to a queue.
+ */
+int32_t can_receive(CanSub_t *pxSub, CanFrame_t *pxFrame, TickType_t xTicksToWait)
+{
+	TimeOut_t xTimeOut;
+	uint32_t ulTail;
+
+	if (pxSub->xQueue != NULL)
+	{
+		return -1;
+	}
+
+	vTaskSetTimeOutState(&xTimeOut);
+
+	for (;;)
+	{
+		ulTail = pxSub->ulTail;
+
+		if (pxSub->ulHead != ulTail)
+		{
+			/* The ISR published the frame before the index. */
+			__DMB();
+			*pxFrame = pxSub->pxRing[ulTail & pxSub->ulRingMask];
+			__DMB();
+			pxSub->ulTail = ulTail + 1U;
+			pxSub->xReader = NULL;
+			return 1;
+		}
+
+		if ((xTicksToWait == 0U) || (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE))
+		{
+			pxSub->xReader = NULL;
+			return 0;
+		}
+
+		/* Announce, then check again, so a frame in between is not missed. */
+		if (pxSub->xReader == NULL)
+		{
+			pxSub->xReader = xTaskGetCurrentTaskHandle();
+			__DMB();
+			continue;
+		}
+
+		(void)ulTaskNotifyTakeIndexed(CAN_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+	}
+}
+
+/**
+ * @brief Reads the counters of a port.
+ * @param xPort Open port.
+ * @param pxStats Receives the counters, with the current error counters.
+ * @retval 0 if successful, -1 if the port is not open.
+ */
+int32_t can_get_stats(CanPort_t xPort, CanStats_t *pxStats)
+{
+	uint32_t ulEsr;
+
+	if ((xPort >= CAN_PORTS) || (xCanState[xPort].ucOpen == 0U))
+	{
+		return -1;
+	}
+
+	ulEsr = xCanHw[xPort].pxCan->ESR;
+
+	taskENTER_CRITICAL();
+	*pxStats = xCanState[xPort].xStats;
+	taskEXIT_CRITICAL();
+
+	pxStats->ucTxErrors = (uint8_t)((ulEsr & CAN_ESR_TEC) >> CAN_ESR_TEC_Pos);
+	pxStats->ucRxErrors = (uint8_t)((ulEsr & CAN_ESR_REC) >> CAN_ESR_REC_Pos);
+	pxStats->ucBusOff = ((ulEsr & CAN_ESR_BOFF) != 0U) ? 1U : 0U;
+
+	return 0;
+}
+
+/* Interrupt handlers, one line each: the port table does the rest. */
+#if (CAN_USE_CAN1 == 1)
+void CAN1_TX_IRQHandler(void) { can_tx_irq(CAN_PORT_1); }
+void CAN1_RX0_IRQHandler(void) { can_rx_irq(CAN_PORT_1, 0U); }
+void CAN1_RX1_IRQHandler(void) { can_rx_irq(CAN_PORT_1, 1U); }
+#endif
+
+#if (CAN_USE_CAN2 == 1)
+void CAN2_TX_IRQHandler(void) { can_tx_irq(CAN_PORT_2); }
+void CAN2_RX0_IRQHandler(void) { can_rx_irq(CAN_PORT_2, 0U); }
+void CAN2_RX1_IRQHandler(void) { can_rx_irq(CAN_PORT_2, 1U); }
+#endif
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Computes the bit timing register for a bit rate.
+ * @param ulPclk CAN clock (PCLK1).
+ * @param ulBitRate Bit rate.
+ * @param pulBtr Receives SJW, TS2, TS1 and BRP.
+ * @retval 0 if successful, -1 if no prescaler gives the rate exactly.
+ * @note Prefers the most time quanta per bit, for the finest resynchronization.
+ */
+static int32_t can_compute_btr(uint32_t ulPclk, uint32_t ulBitRate, uint32_t *pulBtr)
+{
+	uint32_t ulTq;
+	uint32_t ulBrp;
+	uint32_t ulTs1;
+	uint32_t ulTs2;
+	uint32_t ulSjw;
+
+	if ((ulBitRate == 0U) || (ulBitRate > (ulPclk / CAN_TQ_MIN)))
+	{
+		return -1;
+	}
+
+	for (ulTq = CAN_TQ_MAX; ulTq >= CAN_TQ_MIN; ulTq--)
+	{
+		if ((ulPclk % (ulBitRate * ulTq)) != 0U)
+		{
+			continue;
+		}
+
+		ulBrp = ulPclk / (ulBitRate * ulTq);
+
+		/* Sample point: SYNC_SEG + TS1 = 7/8 of the bit, rounded. */
+		ulTs1 = (((ulTq * 7U) + 4U) / 8U) - 1U;
+		ulTs2 = ulTq - 1U - ulTs1;
+
+		if ((ulBrp > 1024U) || (ulTs1 > 16U) || (ulTs2 == 0U) || (ulTs2 > 8U))
+		{
+			continue;
+		}
+
+		ulSjw = (ulTs2 < 4U) ? ulTs2 : 4U;
+		*pulBtr = ((ulSjw - 1U) << CAN_BTR_SJW_Pos) | ((ulTs2 - 1U) << CAN_BTR_TS2_Pos)
+				| ((ulTs1 - 1U) << CAN_BTR_TS1_Pos) | (ulBrp - 1U);
+
+		return 0;
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Puts a controller in initialization mode, out of sleep.
+ * @param pxCan Controller.
+ * @retval 0 if successful, -1 on timeout.
+ */
+static int32_t can_enter_init(CAN_TypeDef *pxCan)
+{
+	uint32_t ulTimeout = CAN_INIT_TIMEOUT;
+
+	pxCan->MCR = (pxCan->MCR & ~CAN_MCR_SLEEP) | CAN_MCR_INRQ;
+
+	while (((pxCan->MSR & CAN_MSR_INAK) == 0U) || ((pxCan->MSR & CAN_MSR_SLAK) != 0U))
+	{
+		if (--ulTimeout == 0U)
+		{
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Takes a controller back to normal mode.
+ * @param pxCan Controller.
+ * @retval 0 if successful, -1 if it did not see 11 recessive bits in time.
+ */
+static int32_t can_leave_init(CAN_TypeDef *pxCan)
+{
+	uint32_t ulTimeout = CAN_INIT_TIMEOUT;
+
+	pxCan->MCR &= ~CAN_MCR_INRQ;
+
+	while ((pxCan->MSR & CAN_MSR_INAK) != 0U)
+	{
+		if (--ulTimeout == 0U)
+		{
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Lays the filter banks out once, all inactive.
+ * @param None
+ * @retval None
+ * @note All banks are 32-bit masks, so each has one filter index, and each
+ * controller's share is split between the FIFOs by CAN_FIFO0_BANKS. Later
+ * opens leave the banks of an open controller alone.
+ */
+static void can_filters_init(void)
+{
+	static uint8_t ucDone = 0;
+	uint32_t ulFifo1 = 0;
+	uint32_t x;
+
+	if (ucDone != 0U)
+	{
+		return;
+	}
+
+	for (x = 0; x < CAN_FILTER_BANKS; x++)
+	{
+		if ((x >= CAN_FIFO0_BANKS) && ((x < CAN_CAN2_FIRST_BANK)
+				|| (x >= (CAN_CAN2_FIRST_BANK + CAN_FIFO0_BANKS))))
+		{
+			ulFifo1 |= 1U << x;
+		}
+	}
+
+	CAN1->FMR = (CAN_CAN2_FIRST_BANK << CAN_FMR_CAN2SB_Pos) | CAN_FMR_FINIT;
+	CAN1->FA1R = 0;
+	CAN1->FM1R = 0;
+	CAN1->FS1R = (1U << CAN_FILTER_BANKS) - 1U;
+	CAN1->FFA1R = ulFifo1;
+	CAN1->FMR &= ~CAN_FMR_FINIT;
+
+	ucDone = 1;
+}
+
+/**
+ * @brief Configures a pin for CAN.
+ * @param pxPort GPIO port (clock enabled).
+ * @param ucPin Pin number, 0 to 15.
+ * @param ucPullUp 1 to pull the pin up (RX, recessive without a transceiver).
+ * @retval None
+ */
+static void can_pin_init(GPIO_TypeDef *pxPort, uint8_t ucPin, uint8_t ucPullUp)
+{
+	uint32_t ulShift2 = 2U * ucPin;
+	uint32_t ulShift4 = 4U * (ucPin & 7U);
+
+	pxPort->AFR[ucPin >> 3] = (pxPort->AFR[ucPin >> 3] & ~(0xFU << ulShift4))
+			| (PIN_AF_CAN << ulShift4);
+	pxPort->OTYPER &= ~(1U << ucPin);
+	pxPort->OSPEEDR = (pxPort->OSPEEDR & ~(3U << ulShift2)) | (PIN_SPEED_FAST << ulShift2);
+	pxPort->PUPDR = (pxPort->PUPDR & ~(3U << ulShift2))
+			| ((ucPullUp ? PIN_PULL_UP : 0U) << ulShift2);
+	pxPort->MODER = (pxPort->MODER & ~(3U << ulShift2)) | (PIN_MODE_AF << ulShift2);
+}
+
+/**
+ * @brief Computes the arbitration key of a frame.
+ * @param pxFrame Frame.
+ * @retval Key, lower for the frame that wins arbitration: the base identifier,
+ * SRR or RTR, IDE, the identifier extension and RTR, as on the bus.
+ */
+static uint32_t can_key(const CanFrame_t *pxFrame)
+{
+	const uint32_t ulRtr = ((pxFrame->ucFlags & CAN_FLAG_RTR) != 0U) ? 1U : 0U;
+
+	if ((pxFrame->ucFlags & CAN_FLAG_EXT) != 0U)
+	{
+		return ((pxFrame->ulId >> 18) << 21) | (1U << 20) | (1U << 19)
+				| ((pxFrame->ulId & 0x3FFFFU) << 1) | ulRtr;
+	}
+
+	return (pxFrame->ulId << 21) | (ulRtr << 20);
+}
+
+/**
+ * @brief Adds a frame to the waiting ones.
+ * @param pxState Port, in a critical section.
+ * @param pxFrame Frame, whose slot is taken.
+ * @param ulKey Its arbitration key.
+ * @param xRequeue pdTRUE for an aborted frame, which goes before the frames of
+ * its identifier queued after it.
+ * @retval None
+ * @note The most urgent frames are at the end, where sending pops them, so an
+ * urgent frame moves only the few more urgent ones.
+ */
+static void can_tx_insert(CanState_t *pxState, const CanFrame_t *pxFrame, uint32_t ulKey,
+		BaseType_t xRequeue)
+{
+	uint32_t x = pxState->ucTxCount;
+
+	while ((x > 0U) && ((pxState->ulTxKey[x - 1U] < ulKey)
+			|| ((pxState->ulTxKey[x - 1U] == ulKey) && (xRequeue == pdFALSE))))
+	{
+		pxState->xTxPending[x] = pxState->xTxPending[x - 1U];
+		pxState->ulTxKey[x] = pxState->ulTxKey[x - 1U];
+		x--;
+	}
+
+	pxState->xTxPending[x] = *pxFrame;
+	pxState->ulTxKey[x] = ulKey;
+	pxState->ucTxCount++;
+}
+
+/**
+ * @brief Moves waiting frames into free mailboxes, or makes room.
+ * @param xPort Port, in a critical section.
+ * @retval None
+ */
+static void can_tx_kick(CanPort_t xPort)
+{
+	CAN_TypeDef *pxCan = xCanHw[xPort].pxCan;
+	CanState_t *pxState = &xCanState[xPort];
+	const CanFrame_t *pxFrame;
+	CAN_TxMailBox_TypeDef *pxMailbox;
+	uint32_t ulKey;
+	uint32_t ulVictim;
+	uint32_t ulData[2];
+	uint32_t x;
+
+	while (pxState->ucTxCount > 0U)
+	{
+		ulKey = pxState->ulTxKey[pxState->ucTxCount - 1U];
+		ulVictim = CAN_MAILBOXES;
+
+		for (x = 0; x < CAN_MAILBOXES; x++)
+		{
+			if ((pxState->ucMailboxBusy & (1U << x)) == 0U)
+			{
+				continue;
+			}
+
+			/* Same identifier: mailbox order would not be queue order. */
+			if (pxState->ulMailboxKey[x] == ulKey)
+			{
+				return;
+			}
+
+			if (((pxState->ucMailboxAborting & (1U << x)) == 0U)
+					&& ((ulVictim == CAN_MAILBOXES)
+							|| (pxState->ulMailboxKey[x] > pxState->ulMailboxKey[ulVictim])))
+			{
+				ulVictim = x;
+			}
+		}
+
+		if (pxState->ucMailboxBusy == ((1U << CAN_MAILBOXES) - 1U))
+		{
+			/* Full: abort the least urgent if it loses to the frame waiting.
+			 * One sent meanwhile completes normally. */
+			if ((ulVictim < CAN_MAILBOXES) && (pxState->ulMailboxKey[ulVictim] > ulKey))
+			{
+				pxState->ucMailboxAborting |= (uint8_t)(1U << ulVictim);
+				pxCan->TSR = CAN_TSR_ABRQ0 << (ulVictim * CAN_TSR_MAILBOX_STRIDE);
+			}
+
+			return;
+		}
+
+		x = 0;
+
+		while ((pxState->ucMailboxBusy & (1U << x)) != 0U)
+		{
+			x++;
+		}
+
+		pxState->ucTxCount--;
+		pxFrame = &pxState->xTxPending[pxState->ucTxCount];
+		pxState->xMailbox[x] = *pxFrame;
+		pxState->ulMailboxKey[x] = ulKey;
+		pxState->ucMailboxBusy |= (uint8_t)(1U << x);
+
+		memcpy(ulData, pxFrame->ucData, sizeof(ulData));
+		pxMailbox = &pxCan->sTxMailBox[x];
+		pxMailbox->TIR = (((pxFrame->ucFlags & CAN_FLAG_EXT) != 0U)
+				? ((pxFrame->ulId << 3) | CAN_RIR_IDE) : (pxFrame->ulId << 21))
+				| (((pxFrame->ucFlags & CAN_FLAG_RTR) != 0U) ? CAN_RIR_RTR : 0U);
+		pxMailbox->TDTR = pxFrame->ucDlc;
+		pxMailbox->TDLR = ulData[0];
+		pxMailbox->TDHR = ulData[1];
+		pxMailbox->TIR |= CAN_TI0R_TXRQ;
+	}
+}
+
+/**
+ * @brief Finds the subscriber of a received frame.
+ * @param xPort Port.
+ * @param ulFifo FIFO it came through.
+ * @param ulFmi Its filter match index.
+ * @param ulRir Its identifier register.
+ * @retval Subscriber, or NULL if none wants it any more.
+ */
+static CanSub_t *can_rx_route(CanPort_t xPort, uint32_t ulFifo, uint32_t ulFmi, uint32_t ulRir)
+{
+	const CanHw_t *pxHw = &xCanHw[xPort];
+	const uint32_t ulFirst = pxHw->ucFirstBank + ((ulFifo == 0U) ? 0U : CAN_FIFO0_BANKS);
+	CanSub_t *pxSub;
+	uint32_t x;
+
+	ulRir &= ~CAN_TI0R_TXRQ;
+
+	if ((ulFirst + ulFmi) < (uint32_t)(pxHw->ucFirstBank + pxHw->ucBanks))
+	{
+		pxSub = pxBankSub[ulFirst + ulFmi];
+
+		if ((pxSub != NULL) && (((ulRir ^ pxSub->ulFr1) & pxSub->ulFr2) == 0U))
+		{
+			return pxSub;
+		}
+	}
+
+	for (x = pxHw->ucFirstBank; x < (uint32_t)(pxHw->ucFirstBank + pxHw->ucBanks); x++)
+	{
+		pxSub = pxBankSub[x];
+
+		if ((pxSub != NULL) && (((ulRir ^ pxSub->ulFr1) & pxSub->ulFr2) == 0U))
+		{
+			xCanState[xPort].xStats.ulRxMisrouted++;
+			return pxSub;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Handles the TX interrupt of a port: mailboxes emptied.
+ * @param xPort Port.
+ * @retval None
+ */
+static void can_tx_irq(CanPort_t xPort)
+{
+	CAN_TypeDef *pxCan = xCanHw[xPort].pxCan;
+	CanState_t *pxState = &xCanState[xPort];
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	UBaseType_t uxSavedInterruptStatus;
+	uint32_t ulTsr;
+	uint32_t ulShift;
+	uint32_t x;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+	ulTsr = pxCan->TSR;
+
+	for (x = 0; x < CAN_MAILBOXES; x++)
+	{
+		ulShift = x * CAN_TSR_MAILBOX_STRIDE;
+
+		if ((ulTsr & (CAN_TSR_RQCP0 << ulShift)) == 0U)
+		{
+			continue;
+		}
+
+		/* Clears RQCP, TXOK, ALST and TERR. */
+		pxCan->TSR = CAN_TSR_RQCP0 << ulShift;
+		pxState->ucMailboxBusy &= (uint8_t)~(1U << x);
+
+		if ((ulTsr & (CAN_TSR_TXOK0 << ulShift)) != 0U)
+		{
+			pxState->xStats.ulTxFrames++;
+			(void)xSemaphoreGiveFromISR(pxState->xTxSlots, &xHigherPriorityTaskWoken);
+		}
+		else
+		{
+			/* Aborted: it keeps its slot and waits again. */
+			can_tx_insert(pxState, &pxState->xMailbox[x], pxState->ulMailboxKey[x], pdTRUE);
+			pxState->xStats.ulTxPreempted++;
+		}
+
+		pxState->ucMailboxAborting &= (uint8_t)~(1U << x);
+	}
+
+	can_tx_kick(xPort);
+
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Handles an RX interrupt of a port: drains the FIFO to subscribers.
+ * @param xPort Port.
+ * @param ulFifo 0 or 1.
+ * @retval None
+ */
+static void can_rx_irq(CanPort_t xPort, uint32_t ulFifo)
+{
+	CAN_TypeDef *pxCan = xCanHw[xPort].pxCan;
+	CanState_t *pxState = &xCanState[xPort];
+	volatile uint32_t *pulRfr = (ulFifo == 0U) ? &pxCan->RF0R : &pxCan->RF1R;
+	CAN_FIFOMailBox_TypeDef *pxFifo = &pxCan->sFIFOMailBox[ulFifo];
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	CanFrame_t xFrame;
+	CanSub_t *pxSub;
+	TaskHandle_t xReader;
+	uint32_t ulRir;
+	uint32_t ulRdtr;
+	uint32_t ulData[2];
+	uint32_t ulHead;
+
+	while ((*pulRfr & CAN_RF0R_FMP0) != 0U)
+	{
+		ulRir = pxFifo->RIR;
+		ulRdtr = pxFifo->RDTR;
+		ulData[0] = pxFifo->RDLR;
+		ulData[1] = pxFifo->RDHR;
+		*pulRfr = CAN_RF0R_RFOM0;
+
+		xFrame.ulId = ((ulRir & CAN_RIR_IDE) != 0U) ? (ulRir >> 3) : (ulRir >> 21);
+		xFrame.ucFlags = (((ulRir & CAN_RIR_IDE) != 0U) ? CAN_FLAG_EXT : 0U)
+				| (((ulRir & CAN_RIR_RTR) != 0U) ? CAN_FLAG_RTR : 0U);
+		xFrame.ucDlc = (uint8_t)(ulRdtr & CAN_RDT0R_DLC);
+		memcpy(xFrame.ucData, ulData, sizeof(ulData));
+
+		pxSub = can_rx_route(xPort, ulFifo,
+				(ulRdtr & CAN_RDT0R_FMI) >> CAN_RDT0R_FMI_Pos, ulRir);
+
+		if (pxSub == NULL)
+		{
+			pxState->xStats.ulRxDropped++;
+		}
+		else if (pxSub->xQueue != NULL)
+		{
+			if (xQueueSendFromISR(pxSub->xQueue, &xFrame, &xHigherPriorityTaskWoken) == pdPASS)
+			{
+				pxSub->ulReceived++;
+				pxState->xStats.ulRxFrames++;
+			}
+			else
+			{
+				pxSub->ulDropped++;
+				pxState->xStats.ulRxDropped++;
+			}
+		}
+		else
+		{
+			ulHead = pxSub->ulHead;
+
+			if ((ulHead - pxSub->ulTail) > pxSub->ulRingMask)
+			{
+				pxSub->ulDropped++;
+				pxState->xStats.ulRxDropped++;
+				continue;
+			}
+
+			pxSub->pxRing[ulHead & pxSub->ulRingMask] = xFrame;
+			/* The frame must be visible before the index that publishes it. */
+			__DMB();
+			pxSub->ulHead = ulHead + 1U;
+			pxSub->ulReceived++;
+			pxState->xStats.ulRxFrames++;
+
+			xReader = pxSub->xReader;
+
+			if (xReader != NULL)
+			{
+				vTaskNotifyGiveIndexedFromISR(xReader, CAN_NOTIFY_INDEX, &xHigherPriorityTaskWoken);
+			}
+		}
+	}
+
+	if ((*pulRfr & CAN_RF0R_FOVR0) != 0U)
+	{
+		pxState->xStats.ulRxOverruns++;
+		*pulRfr = CAN_RF0R_FOVR0 | CAN_RF0R_FULL0;
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
@@ -0,0 +1,192 @@
+/*******************************************************************************
+ *
+ * @file	cfgstore.c
+ * @brief	Read-copy-update store for configuration tables that many tasks
+ * 			read every cycle and a writer changes now and then.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	Readers load one pointer (cfgstore_read()) and use the version
+ * 			it points to: no lock, no retry, whatever the size of the
+ * 			table. A mutex would make every read pay, and a seqlock would
+ * 			have readers copy, and possibly copy again, a whole table.
+ *
+ * 			The store keeps two copies. A writer edits the one readers do
+ * 			not see (cfgstore_edit(), which starts from the current
+ * 			version), then cfgstore_publish() swaps the pointer. Readers
+ * 			that loaded the old pointer may still be using the old copy, so
+ * 			it is only handed to the next writer after a grace period: until
+ * 			every task has left the Ready state at least once, or was
+ * 			blocked or suspended all along (configUSE_QUIESCENT_STATES,
+ * 			counted by vTaskSwitchContext()). A task preempted in the middle
+ * 			of a read is still ready, so it holds the grace period open
+ * 			until it blocks.
+ *
+ * 			Readers therefore must not keep a version across a blocking
+ * 			call, and a task that never blocks, other than the idle task,
+ * 			keeps a second edit waiting: cfgstore_edit() then times out.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "cfgstore.h"
+
+#if (configUSE_QUIESCENT_STATES == 1) && (configSUPPORT_STATIC_ALLOCATION == 1)
+
+/* Private function prototypes -----------------------------------------------*/
+static void *cfgstore_spare(const CfgStore_t *pxStore);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Initializes a store with both copies set to the defaults.
+ * @param pxStore Store to initialize.
+ * @param pvCopy0 First copy.
+ * @param pvCopy1 Second copy, of the same size.
+ * @param ulSize Size of a copy in bytes.
+ * @param pvDefaults First version, copied into both.
+ * @retval 0 if successful, -1 otherwise.
+ * @note Before any task reads the store.
+ */
+int32_t cfgstore_init(CfgStore_t *pxStore, void *pvCopy0, void *pvCopy1, uint32_t ulSize,
+		const void *pvDefaults)
+{
+	if ((pxStore == NULL) || (pvCopy0 == NULL) || (pvCopy1 == NULL) || (ulSize == 0U)
+			|| (pvDefaults == NULL))
+	{
+		return -1;
+	}
+
+	(void)memcpy(pvCopy0, pvDefaults, ulSize);
+	(void)memcpy(pvCopy1, pvDefaults, ulSize);
+	pxStore->pvCopies[0] = pvCopy0;
+	pxStore->pvCopies[1] = pvCopy1;
+	pxStore->pvCurrent = pvCopy0;
+	pxStore->ulSize = ulSize;
+	pxStore->ulEpoch = 0;
+	pxStore->xGracePending = pdFALSE;
+	(void)memset(&pxStore->xStats, 0, sizeof(pxStore->xStats));
+	pxStore->xWriteLock = xSemaphoreCreateMutexStatic(&pxStore->xWriteLockBuffer);
+
+	return 0;
+}
+
+/**
+ * @brief Starts a new version (writers).
+ * @param pxStore Store.
+ * @param xTicksToWait How long to wait for another writer, then for the
+ * readers of the copy to be edited to be done with it.
+ * @retval The copy to edit, holding the current version, or NULL on timeout.
+ * @note Must be followed by cfgstore_publish() or cfgstore_cancel(). The
+ * caller may keep using what it read before; it is not waited for.
+ */
+void *cfgstore_edit(CfgStore_t *pxStore, TickType_t xTicksToWait)
+{
+	TimeOut_t xTimeOut;
+	TickType_t xStart;
+	uint32_t ulWaited;
+	void *pvSpare;
+
+	vTaskSetTimeOutState(&xTimeOut);
+
+	if (xSemaphoreTake(pxStore->xWriteLock, xTicksToWait) != pdTRUE)
+	{
+		return NULL;
+	}
+
+	if (pxStore->xGracePending != pdFALSE)
+	{
+		xStart = xTaskGetTickCount();
+
+		while (xTaskGracePeriodElapsed(pxStore->ulEpoch) == pdFALSE)
+		{
+			if (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE)
+			{
+				pxStore->xStats.ulTimeouts++;
+				(void)xSemaphoreGive(pxStore->xWriteLock);
+				return NULL;
+			}
+
+			vTaskDelay(CFGSTORE_POLL_TICKS);
+		}
+
+		ulWaited = (uint32_t)(xTaskGetTickCount() - xStart);
+
+		if (ulWaited > 0U)
+		{
+			pxStore->xStats.ulGraceWaits++;
+
+			if (ulWaited > pxStore->xStats.ulGraceTicksMax)
+			{
+				pxStore->xStats.ulGraceTicksMax = ulWaited;
+			}
+		}
+
+		pxStore->xGracePending = pdFALSE;
+	}
+
+	pvSpare = cfgstore_spare(pxStore);
+	(void)memcpy(pvSpare, (const void *)pxStore->pvCurrent, pxStore->ulSize);
+
+	return pvSpare;
+}
+
+/**
+ * @brief Makes the edited copy the current version (writers).
+ * @param pxStore Store, with an edit started by cfgstore_edit().
+ * @retval None
+ * @note Readers see the new version from their next cfgstore_read(). The
+ * old one is left alone until the grace period that starts here is over.
+ */
+void cfgstore_publish(CfgStore_t *pxStore)
+{
+	/* The edits must be visible before the pointer to them. */
+	__DMB();
+	pxStore->pvCurrent = cfgstore_spare(pxStore);
+
+	/* Started after the swap: a task that leaves the Ready state from now on
+	 * can only read the new version next. */
+	pxStore->ulEpoch = ulTaskGracePeriodStart();
+	pxStore->xGracePending = pdTRUE;
+	pxStore->xStats.ulPublished++;
+
+	(void)xSemaphoreGive(pxStore->xWriteLock);
+}
+
+/**
+ * @brief Drops an edit started by cfgstore_edit() (writers).
+ * @param pxStore Store.
+ * @retval None
+ */
+void cfgstore_cancel(CfgStore_t *pxStore)
+{
+	(void)xSemaphoreGive(pxStore->xWriteLock);
+}
+
+/**
+ * @brief Copies the writer statistics.
+ * @param pxStore Store.
+ * @param pxStats Where to copy them.
+ * @retval None
+ */
+void cfgstore_get_stats(CfgStore_t *pxStore, CfgStoreStats_t *pxStats)
+{
+	(void)xSemaphoreTake(pxStore->xWriteLock, portMAX_DELAY);
+	*pxStats = pxStore->xStats;
+	(void)xSemaphoreGive(pxStore->xWriteLock);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Returns the copy readers do not see.
+ * @param pxStore Store.
+ * @retval The other copy.
+ */
+static void *cfgstore_spare(const CfgStore_t *pxStore)
+{
+	return (pxStore->pvCurrent == pxStore->pvCopies[0]) ? pxStore->pvCopies[1] : pxStore->pvCopies[0];
+}
+
+#endif /* (configUSE_QUIESCENT_STATES == 1) && (configSUPPORT_STATIC_ALLOCATION == 1) */
@@ -0,0 +1,367 @@
+/*******************************************************************************
+ *
+ * @file	clkgate.c
+ * @brief	Peripheral clock gates with reference counts.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Every enabled peripheral clock draws run-mode current, clocked or
+ * 			not. Instead of setting RCC->xxxENR bits once and for good, a
+ * 			driver holds a clock through a ClkGateUser_t while it needs it:
+ * 			the first clkgate_acquire() of a clock enables it, and the last
+ * 			clkgate_release() gates it off again. The registers of a gated
+ * 			peripheral keep their values, so a driver can configure it once
+ * 			and only hold its clock while it runs.
+ *
+ * 			A clock found already enabled when first acquired was enabled
+ * 			by code outside this file (e.g. MX_GPIO_Init()) and is never
+ * 			gated off here: that code did not say when it is done with it.
+ *
+ * 			DMA controllers, timers, the serial controllers, the USB and
+ * 			the SDIO are critical: their clocks stop in STOP mode, and so
+ * 			does their work. While any is held, clkgate_stop_allowed()
+ * 			tells the tickless idle code to use SLEEP mode instead. GPIO
+ * 			ports, SYSCFG and the EXTI work without a clock in STOP mode,
+ * 			and so do not hold it off; nor does the QUADSPI, only accessed
+ * 			while the CPU runs.
+ *
+ * 			The RCC also gates clocks in SLEEP mode, through the LPENR
+ * 			registers, which enable every clock at reset. GPIO ports, the
+ * 			CRC, the QUADSPI and SYSCFG have nothing to do while the CPU
+ * 			sleeps, so their sleep clocks are turned off at the first
+ * 			acquire. The flash interface and SRAM1/SRAM2 are only kept
+ * 			clocked in SLEEP mode while a DMA controller is held, as only a
+ * 			DMA stream can access them then. The other clocks, and those not
+ * 			in this file, keep the reset setting. A wake-up brings every
+ * 			clock back before the first instruction runs.
+ *
+ * 			Each hold records the task that took it, NULL for an ISR, and
+ * 			clkgate_hold_callback() is told of every hold taken or let go,
+ * 			so the clock current can be charged to tasks (energy.c).
+ *
+ * 			Acquire and release from tasks or from ISRs at or below
+ * 			configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bitband.h"
+#include "clkgate.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define CLKGATE_AHB1	0U
+#define CLKGATE_APB1	1U
+#define CLKGATE_APB2	2U
+#define CLKGATE_AHB2	3U
+#define CLKGATE_AHB3	4U
+
+/* Kept clocked in SLEEP mode while a DMA controller is held. */
+#define CLKGATE_DMA_SLEEP_CLOCKS	(RCC_AHB1LPENR_FLITFLPEN | RCC_AHB1LPENR_SRAM1LPEN \
+		| RCC_AHB1LPENR_SRAM2LPEN)
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint8_t ucBus;				/* CLKGATE_AHB1 to CLKGATE_AHB3, CLKGATE_APB1 or CLKGATE_APB2. */
+	uint8_t ucBit;				/* In the bus's ENR register. */
+	uint8_t ucCritical;			/* Stalls in STOP mode. */
+	uint8_t ucSleep;			/* Keeps its clock in SLEEP mode. */
+} ClkGateDef_t;
+
+/* Variables -----------------------------------------------------------------*/
+static const ClkGateDef_t xClocks[CLKGATE_COUNT] =
+{
+	[CLKGATE_GPIOA] = { CLKGATE_AHB1, RCC_AHB1ENR_GPIOAEN_Pos, 0U, 0U },
+	[CLKGATE_GPIOB] = { CLKGATE_AHB1, RCC_AHB1ENR_GPIOBEN_Pos, 0U, 0U },
+	[CLKGATE_GPIOC] = { CLKGATE_AHB1, RCC_AHB1ENR_GPIOCEN_Pos, 0U, 0U },
+	[CLKGATE_GPIOD] = { CLKGATE_AHB1, RCC_AHB1ENR_GPIODEN_Pos, 0U, 0U },
+	[CLKGATE_GPIOE] = { CLKGATE_AHB1, RCC_AHB1ENR_GPIOEEN_Pos, 0U, 0U },
+	[CLKGATE_GPIOF] = { CLKGATE_AHB1, RCC_AHB1ENR_GPIOFEN_Pos, 0U, 0U },
+	[CLKGATE_GPIOG] = { CLKGATE_AHB1, RCC_AHB1ENR_GPIOGEN_Pos, 0U, 0U },
+	[CLKGATE_GPIOH] = { CLKGATE_AHB1, RCC_AHB1ENR_GPIOHEN_Pos, 0U, 0U },
+	[CLKGATE_CRC] = { CLKGATE_AHB1, RCC_AHB1ENR_CRCEN_Pos, 0U, 0U },
+	[CLKGATE_OTGFS] = { CLKGATE_AHB2, RCC_AHB2ENR_OTGFSEN_Pos, 1U, 1U },
+	[CLKGATE_QSPI] = { CLKGATE_AHB3, RCC_AHB3ENR_QSPIEN_Pos, 0U, 0U },
+	[CLKGATE_DMA1] = { CLKGATE_AHB1, RCC_AHB1ENR_DMA1EN_Pos, 1U, 1U },
+	[CLKGATE_DMA2] = { CLKGATE_AHB1, RCC_AHB1ENR_DMA2EN_Pos, 1U, 1U },
+	[CLKGATE_TIM2] = { CLKGATE_APB1, RCC_APB1ENR_TIM2EN_Pos, 1U, 1U },
+	[CLKGATE_TIM3] = { CLKGATE_APB1, RCC_APB1ENR_TIM3EN_Pos, 1U, 1U },
+	[CLKGATE_TIM4] = { CLKGATE_APB1, RCC_APB1ENR_TIM4EN_Pos, 1U, 1U },
+	[CLKGATE_TIM6] = { CLKGATE_APB1, RCC_APB1ENR_TIM6EN_Pos, 1U, 1U },
+	[CLKGATE_TIM7] = { CLKGATE_APB1, RCC_APB1ENR_TIM7EN_Pos, 1U, 1U },
+	[CLKGATE_USART2] = { CLKGATE_APB1, RCC_APB1ENR_USART2EN_Pos, 1U, 1U },
+	[CLKGATE_USART3] = { CLKGATE_APB1, RCC_APB1ENR_USART3EN_Pos, 1U, 1U },
+	[CLKGATE_UART4] = { CLKGATE_APB1, RCC_APB1ENR_UART4EN_Pos, 1U, 1U },
+	[CLKGATE_UART5] = { CLKGATE_APB1, RCC_APB1ENR_UART5EN_Pos, 1U, 1U },
+	[CLKGATE_CAN1] = { CLKGATE_APB1, RCC_APB1ENR_CAN1EN_Pos, 1U, 1U },
+	[CLKGATE_CAN2] = { CLKGATE_APB1, RCC_APB1ENR_CAN2EN_Pos, 1U, 1U },
+	[CLKGATE_SPI2] = { CLKGATE_APB1, RCC_APB1ENR_SPI2EN_Pos, 1U, 1U },
+	[CLKGATE_SPI3] = { CLKGATE_APB1, RCC_APB1ENR_SPI3EN_Pos, 1U, 1U },
+	[CLKGATE_I2C1] = { CLKGATE_APB1, RCC_APB1ENR_I2C1EN_Pos, 1U, 1U },
+	[CLKGATE_I2C2] = { CLKGATE_APB1, RCC_APB1ENR_I2C2EN_Pos, 1U, 1U },
+	[CLKGATE_I2C3] = { CLKGATE_APB1, RCC_APB1ENR_I2C3EN_Pos, 1U, 1U },
+	[CLKGATE_TIM1] = { CLKGATE_APB2, RCC_APB2ENR_TIM1EN_Pos, 1U, 1U },
+	[CLKGATE_TIM8] = { CLKGATE_APB2, RCC_APB2ENR_TIM8EN_Pos, 1U, 1U },
+	[CLKGATE_USART1] = { CLKGATE_APB2, RCC_APB2ENR_USART1EN_Pos, 1U, 1U },
+	[CLKGATE_USART6] = { CLKGATE_APB2, RCC_APB2ENR_USART6EN_Pos, 1U, 1U },
+	[CLKGATE_SPI1] = { CLKGATE_APB2, RCC_APB2ENR_SPI1EN_Pos, 1U, 1U },
+	[CLKGATE_SDIO] = { CLKGATE_APB2, RCC_APB2ENR_SDIOEN_Pos, 1U, 1U },
+	[CLKGATE_ADC1] = { CLKGATE_APB2, RCC_APB2ENR_ADC1EN_Pos, 0U, 1U },
+	[CLKGATE_ADC2] = { CLKGATE_APB2, RCC_APB2ENR_ADC2EN_Pos, 0U, 1U },
+	[CLKGATE_ADC3] = { CLKGATE_APB2, RCC_APB2ENR_ADC3EN_Pos, 0U, 1U },
+	[CLKGATE_SYSCFG] = { CLKGATE_APB2, RCC_APB2ENR_SYSCFGEN_Pos, 0U, 0U },
+};
+
+/* Written in critical sections. */
+static uint8_t ucUsers[CLKGATE_COUNT];
+static uint8_t ucForeign[CLKGATE_COUNT];	/* Enabled before the first acquire. */
+static volatile uint32_t ulCriticalHeld = 0;
+static uint32_t ulDmaHeld = 0;				/* Held DMA controllers. */
+static uint8_t ucSleepGated = 0;			/* The LPENR bits have been set up. */
+
+/* Private function prototypes -----------------------------------------------*/
+static volatile uint32_t *clkgate_enr(uint32_t ulBus);
+static volatile uint32_t *clkgate_lpenr(uint32_t ulBus);
+static void clkgate_sleep_init(void);
+static TaskHandle_t clkgate_current_task(void);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Initializes a hold on a clock chosen at run time, e.g. a GPIO port.
+ * @param pxUser Hold to initialize, not held.
+ * @param eClock Clock it is on.
+ * @retval None
+ * @note Holds on a fixed clock can be initialized with CLKGATE_USER() instead.
+ */
+void clkgate_user_init(ClkGateUser_t *pxUser, ClkGate_t eClock)
+{
+	configASSERT(eClock < CLKGATE_COUNT);
+
+	pxUser->ucClock = (uint8_t)eClock;
+	pxUser->ucHeld = 0U;
+	pxUser->xOwner = NULL;
+}
+
+/**
+ * @brief Holds a clock on, enabling it if it is its first user.
+ * @param pxUser Hold of the calling driver.
+ * @retval None
+ * @note The peripheral can be accessed as soon as this returns.
+ */
+void clkgate_acquire(ClkGateUser_t *pxUser)
+{
+	const ClkGateDef_t *pxDef = &xClocks[pxUser->ucClock];
+	volatile uint32_t *pulEnr = clkgate_enr(pxDef->ucBus);
+	UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+	if (ucSleepGated == 0U)
+	{
+		clkgate_sleep_init();
+	}
+
+	if (pxUser->ucHeld == 0U)
+	{
+		pxUser->ucHeld = 1U;
+		pxUser->xOwner = clkgate_current_task();
+		clkgate_hold_callback(pxUser, pdTRUE);
+
+		if (ucUsers[pxUser->ucClock]++ == 0U)
+		{
+			if ((*pulEnr & (1U << pxDef->ucBit)) != 0U)
+			{
+				ucForeign[pxUser->ucClock] = 1U;
+			}
+
+			/* The bit alone: the ENR registers are also written outside this
+			 * file, without our critical section. */
+			bitband_periph_set(pulEnr, pxDef->ucBit);
+			/* Two AHB cycles before the peripheral may be accessed. */
+			(void)*pulEnr;
+		}
+
+		if (pxDef->ucCritical != 0U)
+		{
+			ulCriticalHeld++;
+		}
+
+		if (((pxUser->ucClock == CLKGATE_DMA1) || (pxUser->ucClock == CLKGATE_DMA2))
+				&& (ulDmaHeld++ == 0U))
+		{
+			RCC->AHB1LPENR |= CLKGATE_DMA_SLEEP_CLOCKS;
+		}
+	}
+
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+/**
+ * @brief Lets a clock go, gating it off if it was its last user.
+ * @param pxUser Hold of the calling driver.
+ * @retval None
+ * @note The peripheral must be idle: a DMA stream or timer left running
+ * freezes, and carries on when the clock comes back.
+ */
+void clkgate_release(ClkGateUser_t *pxUser)
+{
+	const ClkGateDef_t *pxDef = &xClocks[pxUser->ucClock];
+	UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+	if (pxUser->ucHeld != 0U)
+	{
+		pxUser->ucHeld = 0U;
+		clkgate_hold_callback(pxUser, pdFALSE);
+
+		if ((--ucUsers[pxUser->ucClock] == 0U) && (ucForeign[pxUser->ucClock] == 0U))
+		{
+			bitband_periph_clear(clkgate_enr(pxDef->ucBus), pxDef->ucBit);
+		}
+
+		if (pxDef->ucCritical != 0U)
+		{
+			ulCriticalHeld--;
+		}
+
+		if (((pxUser->ucClock == CLKGATE_DMA1) || (pxUser->ucClock == CLKGATE_DMA2))
+				&& (--ulDmaHeld == 0U))
+		{
+			RCC->AHB1LPENR &= ~CLKGATE_DMA_SLEEP_CLOCKS;
+		}
+	}
+
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+/**
+ * @brief Returns how many drivers hold a clock.
+ * @param eClock Clock.
+ * @retval Number of holds, 0 if the clock is gated off (or only enabled
+ * outside this file).
+ */
+uint32_t clkgate_get_users(ClkGate_t eClock)
+{
+	return (eClock < CLKGATE_COUNT) ? ucUsers[eClock] : 0U;
+}
+
+/**
+ * @brief Tells whether STOP mode would stall a peripheral in use.
+ * @param None
+ * @retval pdTRUE if no critical clock is held, pdFALSE otherwise.
+ * @note Called by the tickless idle code with interrupts disabled.
+ */
+BaseType_t clkgate_stop_allowed(void)
+{
+	return (ulCriticalHeld == 0U) ? pdTRUE : pdFALSE;
+}
+
+/**
+ * @brief Called when a hold is taken or let go, in the critical section of
+ * clkgate_acquire() or clkgate_release().
+ * @param pxUser The hold, with the task that took it.
+ * @param xHeld pdTRUE when taken, pdFALSE when let go.
+ * @retval None
+ * @note Weak; override it to follow who keeps which clock on (energy.c). It
+ * may run in an ISR, and must be short.
+ */
+__weak void clkgate_hold_callback(const ClkGateUser_t *pxUser, BaseType_t xHeld)
+{
+	(void)pxUser;
+	(void)xHeld;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Returns the clock enable register of a bus.
+ * @param ulBus CLKGATE_AHB1, CLKGATE_AHB2, CLKGATE_APB1 or CLKGATE_APB2.
+ * @retval The register.
+ */
+static volatile uint32_t *clkgate_enr(uint32_t ulBus)
+{
+	if (ulBus == CLKGATE_AHB1)
+	{
+		return &RCC->AHB1ENR;
+	}
+
+	if (ulBus == CLKGATE_AHB2)
+	{
+		return &RCC->AHB2ENR;
+	}
+
+	if (ulBus == CLKGATE_AHB3)
+	{
+		return &RCC->AHB3ENR;
+	}
+
+	return (ulBus == CLKGATE_APB1) ? &RCC->APB1ENR : &RCC->APB2ENR;
+}
+
+/**
+ * @brief Returns the SLEEP mode clock enable register of a bus.
+ * @param ulBus CLKGATE_AHB1, CLKGATE_AHB2, CLKGATE_APB1 or CLKGATE_APB2.
+ * @retval The register.
+ */
+static volatile uint32_t *clkgate_lpenr(uint32_t ulBus)
+{
+	if (ulBus == CLKGATE_AHB1)
+	{
+		return &RCC->AHB1LPENR;
+	}
+
+	if (ulBus == CLKGATE_AHB2)
+	{
+		return &RCC->AHB2LPENR;
+	}
+
+	if (ulBus == CLKGATE_AHB3)
+	{
+		return &RCC->AHB3LPENR;
+	}
+
+	return (ulBus == CLKGATE_APB1) ? &RCC->APB1LPENR : &RCC->APB2LPENR;
+}
+
+/**
+ * @brief Turns off the SLEEP mode clocks with nothing to do while the CPU
+ * sleeps.
+ * @param None
+ * @retval None
+ * @note Called once, in the critical section of the first acquire.
+ */
+static void clkgate_sleep_init(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < CLKGATE_COUNT; i++)
+	{
+		if (xClocks[i].ucSleep == 0U)
+		{
+			bitband_periph_clear(clkgate_lpenr(xClocks[i].ucBus), xClocks[i].ucBit);
+		}
+	}
+
+	RCC->AHB1LPENR &= ~CLKGATE_DMA_SLEEP_CLOCKS;
+	ucSleepGated = 1U;
+}
+
+/**
+ * @brief Returns the task a hold is taken for.
+ * @param None
+ * @retval The running task, or NULL in an ISR or before the scheduler starts.
+ */
+static TaskHandle_t clkgate_current_task(void)
+{
+	if ((xPortIsInsideInterrupt() != pdFALSE)
+			|| (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED))
+	{
+		return NULL;
+	}
+
+	return xTaskGetCurrentTaskHandle();
+}
@@ -0,0 +1,356 @@
+/*******************************************************************************
+ *
+ * @file	csprof.c
+ * @brief	Critical section profiler: how long each call site masks
+ * 			interrupts or suspends the scheduler.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Hooked in from the 'USER CODE BEGIN Defines' section of
+ * 			'FreeRTOSConfig.h' (see csprof.h):
+ *
+ * 				traceENTER_CRITICAL_SECTION()	outermost vPortEnterCritical()
+ * 				traceEXIT_CRITICAL_SECTION()	outermost vPortExitCritical()
+ * 				traceSCHEDULER_SUSPENDED()		outermost vTaskSuspendAll()
+ * 				traceSCHEDULER_RESUMED()		outermost xTaskResumeAll()
+ *
+ * 			Each section is timed on the DWT cycle counter, from the hook
+ * 			that opens it to the one that closes it, and charged to the
+ * 			return address of the call that opened it: the caller of
+ * 			taskENTER_CRITICAL() or vTaskSuspendAll(). A kernel function that
+ * 			enters a critical section for an API call shows up as itself,
+ * 			e.g. xQueueGenericSend, not as the task that called it. Per call
+ * 			site, a hash table keeps the count, the longest and the total
+ * 			time; Tools/csprof_report.py maps the addresses to functions.
+ *
+ * 			The time is elapsed time: an interrupt above
+ * 			configMAX_SYSCALL_INTERRUPT_PRIORITY that runs during a section
+ * 			is counted in it, as it delays the masked ones just as much.
+ * 			Only the task level critical sections are seen. The masking done
+ * 			from interrupts (portSET_INTERRUPT_MASK_FROM_ISR(), the tick and
+ * 			the context switch) and the critical sections entered before the
+ * 			scheduler starts are not.
+ *
+ * 			The critical section table is only written with interrupts
+ * 			masked, by the exit hook; the scheduler table by the resume
+ * 			hook, which runs in a critical section too.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "csprof.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define CSPROF_HASH_MUL			2654435761UL	/* Knuth's multiplicative hash. */
+
+#if ((CSPROF_SLOTS & (CSPROF_SLOTS - 1U)) != 0U)
+#error CSPROF_SLOTS must be a power of two
+#endif
+
+#if (CSPROF_SLOTS > 256U)
+#error CSPROF_SLOTS must be at most 256
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulCaller;			/* Thumb bit cleared; 0: free slot. */
+	uint32_t ulCount;
+	uint32_t ulMaxCycles;
+	uint32_t ulTotalCycles;		/* Saturates at 23 s of it at 180 MHz. */
+} CsprofSite_t;
+
+typedef struct
+{
+	CsprofSite_t xSites[CSPROF_SLOTS];
+	uint32_t ulLost;			/* Sections whose probe sequence was full. */
+	uint32_t ulStart;			/* CYCCNT when the open section began. */
+	uint32_t ulCaller;			/* Its call site, 0 if not timed. */
+} CsprofTable_t;
+
+/* Variables -----------------------------------------------------------------*/
+static CsprofTable_t xCritical;
+static CsprofTable_t xScheduler;
+static volatile uint32_t ulEnabled = 0;
+
+/* Copy of a table for csprof_dump(), ranked there. */
+static CsprofSite_t xSnapshot[CSPROF_SLOTS];
+static uint8_t ucRank[CSPROF_SLOTS];
+
+/* Private function prototypes -----------------------------------------------*/
+static void csprof_open(CsprofTable_t *pxTable, void *pvCaller);
+static void csprof_close(CsprofTable_t *pxTable);
+static void csprof_clear(CsprofTable_t *pxTable);
+static void csprof_print_table(const char *pcName, CsprofTable_t *pxTable);
+static void csprof_reporter_task(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Starts timing the sections, from the next one opened. The tables
+ * are kept; call csprof_reset() to start afresh.
+ * @param None
+ * @retval None
+ */
+void csprof_start(void)
+{
+	/* Enable the trace and debug blocks, DWT included. */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	ulEnabled = 1U;
+}
+
+/**
+ * @brief Stops timing the sections. The tables are kept.
+ * @param None
+ * @retval None
+ */
+void csprof_stop(void)
+{
+	ulEnabled = 0U;
+}
+
+/**
+ * @brief Clears both tables.
+ * @param None
+ * @retval None
+ * @note Task context only. Masks interrupts without a critical section, which
+ * would time itself.
+ */
+void csprof_reset(void)
+{
+	const UBaseType_t uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+	csprof_clear(&xCritical);
+	csprof_clear(&xScheduler);
+
+	portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+}
+
+/**
+ * @brief Prints both tables with printf(), call sites ranked by their
+ * longest section, one "csprof:" line per call site.
+ * @param None
+ * @retval None
+ * @note Task context only. Lines from other tasks may come in between; the
+ * host script only reads the "csprof:" ones.
+ */
+void csprof_dump(void)
+{
+	printf("csprof: begin hz=%lu\r\n", (unsigned long)SystemCoreClock);
+	csprof_print_table("crit", &xCritical);
+	csprof_print_table("sched", &xScheduler);
+	printf("csprof: end\r\n");
+}
+
+/**
+ * @brief Creates a task that dumps and clears the tables periodically, so
+ * each dump covers one period.
+ * @param ulPeriodMs Period between two dumps.
+ * @param ulPriority Task priority.
+ * @retval pdPASS if the task was created, errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY
+ * otherwise.
+ */
+int32_t csprof_start_reporter(uint32_t ulPeriodMs, uint32_t ulPriority)
+{
+	return xTaskCreate(csprof_reporter_task, "csprof", CSPROF_REPORTER_STACK_WORDS,
+			(void *)ulPeriodMs, (UBaseType_t)ulPriority, NULL);
+}
+
+/**
+ * @brief Opens a critical section (traceENTER_CRITICAL_SECTION).
+ * @param pvCaller Return address of the vPortEnterCritical() call.
+ * @retval None
+ * @note Called by the port with interrupts masked.
+ */
+void csprof_critical_enter(void *pvCaller)
+{
+	csprof_open(&xCritical, pvCaller);
+}
+
+/**
+ * @brief Closes a critical section (traceEXIT_CRITICAL_SECTION).
+ * @param None
+ * @retval None
+ * @note Called by the port with interrupts masked.
+ */
+void csprof_critical_exit(void)
+{
+	csprof_close(&xCritical);
+}
+
+/**
+ * @brief Opens a scheduler suspension (traceSCHEDULER_SUSPENDED).
+ * @param pvCaller Return address of the vTaskSuspendAll() call.
+ * @retval None
+ * @note Called by the kernel with the scheduler suspended: no other task can
+ * get here until the suspension is closed, and interrupts never do.
+ */
+void csprof_scheduler_suspended(void *pvCaller)
+{
+	csprof_open(&xScheduler, pvCaller);
+}
+
+/**
+ * @brief Closes a scheduler suspension (traceSCHEDULER_RESUMED).
+ * @param None
+ * @retval None
+ * @note Called by the kernel within a critical section.
+ */
+void csprof_scheduler_resumed(void)
+{
+	csprof_close(&xScheduler);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Timestamps the section opened now.
+ * @param pxTable Table to charge when the section closes.
+ * @param pvCaller Call site that opened it.
+ * @retval None
+ */
+static void csprof_open(CsprofTable_t *pxTable, void *pvCaller)
+{
+	pxTable->ulCaller = (ulEnabled != 0U) ? ((uint32_t)pvCaller & ~1UL) : 0U;
+	pxTable->ulStart = DWT->CYCCNT;
+}
+
+/**
+ * @brief Charges the section closed now to its call site.
+ * @param pxTable Table of the section.
+ * @retval None
+ * @note The time is taken first: the table update is not in it.
+ */
+static void csprof_close(CsprofTable_t *pxTable)
+{
+	const uint32_t ulCycles = DWT->CYCCNT - pxTable->ulStart;
+	const uint32_t ulCaller = pxTable->ulCaller;
+	uint32_t ulIndex;
+	uint32_t i;
+
+	if ((ulCaller == 0U) || (ulEnabled == 0U))
+	{
+		return;
+	}
+
+	pxTable->ulCaller = 0U;
+
+	ulIndex = ((ulCaller >> 1) * CSPROF_HASH_MUL) >> 16;
+
+	for (i = 0; i < CSPROF_PROBES; i++)
+	{
+		CsprofSite_t *pxSite = &pxTable->xSites[(ulIndex + i) & (CSPROF_SLOTS - 1U)];
+
+		if (pxSite->ulCaller == 0U)
+		{
+			pxSite->ulCaller = ulCaller;
+		}
+		else if (pxSite->ulCaller != ulCaller)
+		{
+			continue;
+		}
+
+		pxSite->ulCount++;
+		pxSite->ulTotalCycles = (pxSite->ulTotalCycles > (UINT32_MAX - ulCycles)) ?
+				UINT32_MAX : (pxSite->ulTotalCycles + ulCycles);
+
+		if (ulCycles > pxSite->ulMaxCycles)
+		{
+			pxSite->ulMaxCycles = ulCycles;
+		}
+
+		return;
+	}
+
+	pxTable->ulLost++;
+}
+
+/**
+ * @brief Empties a table.
+ * @param pxTable Table.
+ * @retval None
+ * @note Called with interrupts masked. A section open meanwhile is still
+ * charged when it closes.
+ */
+static void csprof_clear(CsprofTable_t *pxTable)
+{
+	(void)memset(pxTable->xSites, 0, sizeof(pxTable->xSites));
+	pxTable->ulLost = 0U;
+}
+
+/**
+ * @brief Prints a table, longest section first.
+ * @param pcName Name of the table in the lines.
+ * @param pxTable Table.
+ * @retval None
+ * @note The table is copied with interrupts masked, then sorted and printed
+ * from the copy.
+ */
+static void csprof_print_table(const char *pcName, CsprofTable_t *pxTable)
+{
+	UBaseType_t uxSavedInterruptStatus;
+	uint32_t ulLost;
+	uint32_t ulUsed = 0U;
+	uint32_t i;
+	uint32_t j;
+	uint8_t ucSlot;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	(void)memcpy(xSnapshot, pxTable->xSites, sizeof(xSnapshot));
+	ulLost = pxTable->ulLost;
+	portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+
+	/* Insertion sort of the used slots, by longest section. */
+	for (i = 0; i < CSPROF_SLOTS; i++)
+	{
+		if (xSnapshot[i].ulCaller == 0U)
+		{
+			continue;
+		}
+
+		for (j = ulUsed; (j > 0U) && (xSnapshot[ucRank[j - 1U]].ulMaxCycles < xSnapshot[i].ulMaxCycles); j--)
+		{
+			ucRank[j] = ucRank[j - 1U];
+		}
+
+		ucRank[j] = (uint8_t)i;
+		ulUsed++;
+	}
+
+	printf("csprof: %s sites=%lu lost=%lu\r\n", pcName, (unsigned long)ulUsed,
+			(unsigned long)ulLost);
+
+	for (i = 0; i < ulUsed; i++)
+	{
+		ucSlot = ucRank[i];
+		printf("csprof: %s %08lx %lu %lu %lu\r\n", pcName,
+				(unsigned long)xSnapshot[ucSlot].ulCaller,
+				(unsigned long)xSnapshot[ucSlot].ulCount,
+				(unsigned long)xSnapshot[ucSlot].ulMaxCycles,
+				(unsigned long)xSnapshot[ucSlot].ulTotalCycles);
+	}
+}
+
+/**
+ * @brief Dumps and clears the tables every period.
+ * @param pvParameters Period in milliseconds.
+ * @retval None
+ */
+static void csprof_reporter_task(void *pvParameters)
+{
+	const TickType_t xPeriodTicks = pdMS_TO_TICKS((uint32_t)pvParameters);
+	TickType_t xLastWakeTicks = xTaskGetTickCount();
+
+	while (1)
+	{
+		vTaskDelayUntil(&xLastWakeTicks, xPeriodTicks);
+		csprof_dump();
+		csprof_reset();
+	}
+}
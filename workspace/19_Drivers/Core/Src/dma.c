@@ -0,0 +1,647 @@
+/*******************************************************************************
+ *
+ * @file	dma.c
+ * @brief	DMA stream manager.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	Each peripheral request of the F446 reaches one or two fixed
+ * 			(controller, stream, channel) routes. A driver asks dma_alloc()
+ * 			for a request and gets the first route in xDmaRoutes whose
+ * 			stream is free, so drivers sharing a controller settle their
+ * 			conflicts here rather than in their own tables. The stream keeps
+ * 			the configuration it was allocated with (direction, item size,
+ * 			increments, priority); only the addresses and the count change
+ * 			from one transfer to the next.
+ *
+ * 			Transfers are DmaDesc_t descriptors, xfer.h requests with a
+ * 			peripheral side address. They are chained on the stream in the
+ * 			order they are submitted: the TC interrupt of one loads and
+ * 			starts the next, then signals the finished one, so queued
+ * 			descriptors follow each other without a task in between.
+ * 			dma_start_ring() instead keeps a stream going round one buffer
+ * 			in circular mode, for captures that never end.
+ *
+ * 			Priorities: the hardware serves the stream with the highest
+ * 			PL first, and the lower stream number at equal PL. The bus
+ * 			bandwidth each stream declares is added up per controller and
+ * 			an allocation that would exceed DMA_BANDWIDTH_BUDGET fails.
+ * 			What the streams actually move is counted by dma_get_stats().
+ *
+ * 			Streams whose interrupt handlers are defined by other drivers
+ * 			are listed in DMA_FIXED_STREAMS and never allocated; this file
+ * 			defines the handlers of the others.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clkgate.h"
+#include "crc.h"
+#include "uart.h"
+#include "xfer.h"
+#include "dma.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define DMA_SxCR_EN_OFS			0U
+#define DMA_SxCR_TEIE_OFS		2U
+#define DMA_SxCR_TCIE_OFS		4U
+#define DMA_SxCR_PFCTRL_OFS		5U
+#define DMA_SxCR_DIR_OFS		6U
+#define DMA_SxCR_CIRC_OFS		8U
+#define DMA_SxCR_PINC_OFS		9U
+#define DMA_SxCR_MINC_OFS		10U
+#define DMA_SxCR_PSIZE_OFS		11U
+#define DMA_SxCR_MSIZE_OFS		13U
+#define DMA_SxCR_PL_OFS			16U
+#define DMA_SxCR_PBURST_OFS		21U
+#define DMA_SxCR_MBURST_OFS		23U
+#define DMA_SxCR_CHSEL_OFS		25U
+#define DMA_SxFCR_DMDIS_OFS		2U
+#define DMA_SxFCR_FTH_OFS		0U
+#define DMA_FLAG_TEIF			(1U << 3)	/* Flags shifted down to bit 0. */
+#define DMA_FLAG_TCIF			(1U << 5)
+#define DMA_FLAGS_MASK			0x3DU		/* FEIF, DMEIF, TEIF, HTIF, TCIF of a stream. */
+#define DMA_STREAMS				16U			/* DMA1 streams 0 to 7, then DMA2's. */
+
+/* Streams taken by drivers that program them directly. */
+#ifndef DMA_FIXED_STREAMS
+#define DMA_FIXED_STREAMS (DMA_STREAM_BIT(2U, 0U)		/* adc.c */ \
+		| DMA_STREAM_BIT(2U, 1U)						/* gpio_capture.c */ \
+		| ((CRC_USE_DMA == 1) ? DMA_STREAM_BIT(2U, 2U) : 0U) \
+		| ((UART_USE_USART1 == 1) ? (DMA_STREAM_BIT(2U, 7U) | DMA_STREAM_BIT(2U, 5U)) : 0U) \
+		| ((UART_USE_USART2 == 1) ? (DMA_STREAM_BIT(1U, 6U) | DMA_STREAM_BIT(1U, 5U)) : 0U) \
+		| ((UART_USE_USART3 == 1) ? (DMA_STREAM_BIT(1U, 3U) | DMA_STREAM_BIT(1U, 1U)) : 0U) \
+		| ((UART_USE_UART4 == 1) ? (DMA_STREAM_BIT(1U, 4U) | DMA_STREAM_BIT(1U, 2U)) : 0U) \
+		| ((UART_USE_UART5 == 1) ? (DMA_STREAM_BIT(1U, 7U) | DMA_STREAM_BIT(1U, 0U)) : 0U) \
+		| ((UART_USE_USART6 == 1) ? (DMA_STREAM_BIT(2U, 6U) | DMA_STREAM_BIT(2U, 1U)) : 0U))
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint8_t ucRequest;				/* DmaRequest_t */
+	uint8_t ucDma;					/* 1 or 2 */
+	uint8_t ucStream;
+	uint8_t ucChannel;
+} DmaRoute_t;
+
+struct DmaStream
+{
+	DMA_TypeDef *pxDma;
+	DMA_Stream_TypeDef *pxRegs;
+	uint8_t ucIndex;				/* Bit in DMA_FIXED_STREAMS. */
+	uint8_t ucInUse;
+	uint8_t ucItemSize;
+	uint32_t ulCr;					/* CR of every transfer, without EN. */
+	uint32_t ulFcr;
+	volatile void *pvPeriph;		/* Default peripheral address. */
+	uint32_t ulBandwidth;
+	XferQueue_t xQueue;				/* Head: the descriptor in flight. */
+	DmaDesc_t xRing;				/* The head while dma_start_ring() runs. */
+	ClkGateUser_t xClock;			/* Held while descriptors are queued. */
+	DmaStats_t xStats;
+};
+
+/* Variables -----------------------------------------------------------------*/
+/* Routes of each request, in order of preference. Memory to memory avoids
+ * the DMA2 streams the SPI routes and the fixed drivers use. */
+static const DmaRoute_t xDmaRoutes[] =
+{
+	{ DMA_REQ_MEM_TO_MEM,	2, 4, 0 },
+	{ DMA_REQ_MEM_TO_MEM,	2, 6, 0 },
+	{ DMA_REQ_MEM_TO_MEM,	2, 7, 0 },
+	{ DMA_REQ_MEM_TO_MEM,	2, 1, 0 },
+	{ DMA_REQ_MEM_TO_MEM,	2, 2, 0 },
+	{ DMA_REQ_MEM_TO_MEM,	2, 0, 0 },
+	{ DMA_REQ_MEM_TO_MEM,	2, 3, 0 },
+	{ DMA_REQ_MEM_TO_MEM,	2, 5, 0 },
+	{ DMA_REQ_SPI1_RX,		2, 2, 3 },
+	{ DMA_REQ_SPI1_RX,		2, 0, 3 },
+	{ DMA_REQ_SPI1_TX,		2, 3, 3 },
+	{ DMA_REQ_SPI1_TX,		2, 5, 3 },
+	{ DMA_REQ_SPI2_RX,		1, 3, 0 },
+	{ DMA_REQ_SPI2_TX,		1, 4, 0 },
+	{ DMA_REQ_SPI3_RX,		1, 0, 0 },
+	{ DMA_REQ_SPI3_RX,		1, 2, 0 },
+	{ DMA_REQ_SPI3_TX,		1, 5, 0 },
+	{ DMA_REQ_SPI3_TX,		1, 7, 0 },
+	{ DMA_REQ_I2C1_RX,		1, 0, 1 },
+	{ DMA_REQ_I2C1_RX,		1, 5, 1 },
+	{ DMA_REQ_I2C1_TX,		1, 6, 1 },
+	{ DMA_REQ_I2C1_TX,		1, 7, 1 },
+	{ DMA_REQ_I2C2_RX,		1, 2, 7 },
+	{ DMA_REQ_I2C2_RX,		1, 3, 7 },
+	{ DMA_REQ_I2C2_TX,		1, 7, 7 },
+	{ DMA_REQ_I2C3_RX,		1, 2, 3 },
+	{ DMA_REQ_I2C3_TX,		1, 4, 3 },
+	{ DMA_REQ_SDIO,			2, 3, 4 },
+	{ DMA_REQ_SDIO,			2, 6, 4 },
+	{ DMA_REQ_TIM2_CH1,		1, 5, 3 },
+	{ DMA_REQ_TIM2_CH2,		1, 6, 3 },
+	{ DMA_REQ_TIM2_CH3,		1, 1, 3 },
+	{ DMA_REQ_TIM2_CH4,		1, 7, 3 },
+	{ DMA_REQ_TIM2_CH4,		1, 6, 3 },
+	{ DMA_REQ_TIM1_UP,		2, 5, 6 }
+};
+
+static const IRQn_Type xDmaIrqs[DMA_STREAMS] =
+{
+	DMA1_Stream0_IRQn, DMA1_Stream1_IRQn, DMA1_Stream2_IRQn, DMA1_Stream3_IRQn,
+	DMA1_Stream4_IRQn, DMA1_Stream5_IRQn, DMA1_Stream6_IRQn, DMA1_Stream7_IRQn,
+	DMA2_Stream0_IRQn, DMA2_Stream1_IRQn, DMA2_Stream2_IRQn, DMA2_Stream3_IRQn,
+	DMA2_Stream4_IRQn, DMA2_Stream5_IRQn, DMA2_Stream6_IRQn, DMA2_Stream7_IRQn
+};
+
+static DmaStream_t xDmaStreams[DMA_STREAMS];
+static uint32_t ulDmaBandwidth[2] = { 0, 0 };	/* Declared, per controller. */
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t dma_flags(const DmaStream_t *pxStream);
+static void dma_clear(const DmaStream_t *pxStream);
+static void dma_disable(const DmaStream_t *pxStream);
+static void dma_load(DmaStream_t *pxStream, const DmaDesc_t *pxDesc);
+static void dma_irq(uint32_t ulIndex);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Allocates a stream for a peripheral request.
+ * @param pxCfg Request and configuration of the stream's transfers.
+ * @param ppxStream Receives the stream.
+ * @retval 0 on success, -1 if the configuration is invalid, every route of the
+ * request is taken or its controller has no bandwidth left.
+ * @note Call from a task. The stream interrupt is enabled at DMA_IRQ_PRIORITY.
+ */
+int32_t dma_alloc(const DmaConfig_t *pxCfg, DmaStream_t **ppxStream)
+{
+	DmaStream_t *pxStream = NULL;
+	const DmaRoute_t *pxRoute = NULL;
+	uint32_t ulIndex;
+	uint32_t x;
+
+	if ((pxCfg == NULL) || (ppxStream == NULL) || (pxCfg->xRequest >= DMA_REQ_COUNT)
+			|| (pxCfg->ucPriority > DMA_PL_VERY_HIGH)
+			|| ((pxCfg->ucItemSize != 1U) && (pxCfg->ucItemSize != 2U) && (pxCfg->ucItemSize != 4U))
+			|| ((pxCfg->xDir == DMA_DIR_M2M) != (pxCfg->xRequest == DMA_REQ_MEM_TO_MEM)))
+	{
+		return -1;
+	}
+
+	taskENTER_CRITICAL();
+
+	for (x = 0; x < (sizeof(xDmaRoutes) / sizeof(xDmaRoutes[0])); x++)
+	{
+		if (xDmaRoutes[x].ucRequest != (uint8_t)pxCfg->xRequest)
+		{
+			continue;
+		}
+
+		ulIndex = ((xDmaRoutes[x].ucDma - 1U) * 8U) + xDmaRoutes[x].ucStream;
+
+		if (((DMA_FIXED_STREAMS & (1U << ulIndex)) == 0U) && (xDmaStreams[ulIndex].ucInUse == 0U)
+				&& (ulDmaBandwidth[xDmaRoutes[x].ucDma - 1U] + pxCfg->ulBandwidth
+						<= DMA_BANDWIDTH_BUDGET))
+		{
+			pxRoute = &xDmaRoutes[x];
+			pxStream = &xDmaStreams[ulIndex];
+			pxStream->ucInUse = 1;
+			ulDmaBandwidth[pxRoute->ucDma - 1U] += pxCfg->ulBandwidth;
+			break;
+		}
+	}
+
+	taskEXIT_CRITICAL();
+
+	if (pxStream == NULL)
+	{
+		return -1;
+	}
+
+	pxStream->pxDma = (pxRoute->ucDma == 1U) ? DMA1 : DMA2;
+	/* Streams follow the controller's interrupt registers, 0x18 bytes apart. */
+	pxStream->pxRegs = (DMA_Stream_TypeDef *)((uint32_t)pxStream->pxDma + 0x10U
+			+ (0x18U * pxRoute->ucStream));
+	pxStream->ucIndex = (uint8_t)(((pxRoute->ucDma - 1U) * 8U) + pxRoute->ucStream);
+	pxStream->ucItemSize = pxCfg->ucItemSize;
+	pxStream->pvPeriph = pxCfg->pvPeriph;
+	pxStream->ulBandwidth = pxCfg->ulBandwidth;
+	pxStream->xQueue.pxHead = NULL;
+	pxStream->xQueue.pxTail = NULL;
+	memset(&pxStream->xStats, 0, sizeof(pxStream->xStats));
+	clkgate_user_init(&pxStream->xClock, (pxRoute->ucDma == 1U) ? CLKGATE_DMA1 : CLKGATE_DMA2);
+
+	/* The size codes 0, 1 and 2 are the item size halved. */
+	pxStream->ulCr = ((uint32_t)pxRoute->ucChannel << DMA_SxCR_CHSEL_OFS)
+			| ((uint32_t)pxCfg->ucPriority << DMA_SxCR_PL_OFS)
+			| ((uint32_t)(pxCfg->ucItemSize >> 1) << DMA_SxCR_MSIZE_OFS)
+			| ((uint32_t)(pxCfg->ucItemSize >> 1) << DMA_SxCR_PSIZE_OFS)
+			| ((pxCfg->ucMemInc ? 1U : 0U) << DMA_SxCR_MINC_OFS)
+			| ((pxCfg->ucPeriphInc ? 1U : 0U) << DMA_SxCR_PINC_OFS)
+			| ((uint32_t)pxCfg->xDir << DMA_SxCR_DIR_OFS)
+			| (1U << DMA_SxCR_TCIE_OFS)
+			| (1U << DMA_SxCR_TEIE_OFS);
+
+	/* Memory to memory needs the FIFO; the peripherals are served directly. */
+	pxStream->ulFcr = (pxCfg->xDir == DMA_DIR_M2M)
+			? ((1U << DMA_SxFCR_DMDIS_OFS) | (3U << DMA_SxFCR_FTH_OFS)) : 0U;
+
+	/* The SDIO ends the transfer itself and wants bursts of 4 words, through
+	 * a full FIFO: the memory side must be 16-byte aligned. */
+	if (pxCfg->xRequest == DMA_REQ_SDIO)
+	{
+		pxStream->ulCr |= (1U << DMA_SxCR_PFCTRL_OFS) | (1U << DMA_SxCR_PBURST_OFS)
+				| (1U << DMA_SxCR_MBURST_OFS);
+		pxStream->ulFcr = (1U << DMA_SxFCR_DMDIS_OFS) | (3U << DMA_SxFCR_FTH_OFS);
+	}
+
+	clkgate_acquire(&pxStream->xClock);
+	dma_disable(pxStream);
+	dma_clear(pxStream);
+	clkgate_release(&pxStream->xClock);
+
+	NVIC_SetPriority(xDmaIrqs[pxStream->ucIndex], DMA_IRQ_PRIORITY);
+	NVIC_EnableIRQ(xDmaIrqs[pxStream->ucIndex]);
+
+	*ppxStream = pxStream;
+
+	return 0;
+}
+
+/**
+ * @brief Gives a stream back.
+ * @param pxStream Stream from dma_alloc().
+ * @retval None
+ * @note Descriptors still queued complete with XFER_ERROR.
+ */
+void dma_free(DmaStream_t *pxStream)
+{
+	dma_abort(pxStream);
+	NVIC_DisableIRQ(xDmaIrqs[pxStream->ucIndex]);
+
+	taskENTER_CRITICAL();
+	ulDmaBandwidth[(pxStream->pxDma == DMA1) ? 0U : 1U] -= pxStream->ulBandwidth;
+	pxStream->ucInUse = 0;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Prepares a descriptor with no completion signal.
+ * @param pxDesc Descriptor, not queued on a stream.
+ * @param pvPeriph Peripheral side address, NULL for the stream's. The source
+ * of a memory to memory transfer.
+ * @param pvMem Memory side address.
+ * @param ulItems Number of items, 1 to DMA_MAX_ITEMS.
+ * @retval None
+ * @note The xfer_on_...() calls on &pxDesc->xReq choose how it signals.
+ */
+void dma_desc_init(DmaDesc_t *pxDesc, volatile void *pvPeriph, void *pvMem, uint32_t ulItems)
+{
+	xfer_init(&pxDesc->xReq, pvMem, ulItems);
+	pxDesc->pvPeriph = pvPeriph;
+}
+
+/**
+ * @brief Queues a descriptor on a stream.
+ * @param pxStream Stream from dma_alloc().
+ * @param pxDesc Descriptor. It completes with lResult = ulLen items, or
+ * XFER_ERROR after a transfer error.
+ * @retval 0 if queued, -1 if the descriptor is empty, too long or has no
+ * peripheral side address.
+ * @note Starts at once on an idle stream, otherwise from the TC interrupt of
+ * the descriptor before it. May be called from an ISR, e.g. the completion
+ * callback of another descriptor.
+ */
+int32_t dma_submit(DmaStream_t *pxStream, DmaDesc_t *pxDesc)
+{
+	UBaseType_t uxSavedInterruptStatus;
+
+	if ((pxDesc == NULL) || (pxDesc->xReq.ulLen == 0U) || (pxDesc->xReq.ulLen > DMA_MAX_ITEMS)
+			|| ((pxDesc->pvPeriph == NULL) && (pxStream->pvPeriph == NULL)))
+	{
+		return -1;
+	}
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+	if (xfer_queue_push(&pxStream->xQueue, &pxDesc->xReq))
+	{
+		/* DMA1 or DMA2 would freeze in STOP mode: the hold keeps the idle task
+		 * in SLEEP mode until the chain is done. */
+		clkgate_acquire(&pxStream->xClock);
+		dma_load(pxStream, pxDesc);
+	}
+
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	return 0;
+}
+
+/**
+ * @brief Stops a stream and fails what it has queued.
+ * @param pxStream Stream from dma_alloc().
+ * @retval None
+ * @note The descriptor in flight and the ones after it complete with
+ * XFER_ERROR, in order. May be called from an ISR, e.g. a driver's error
+ * interrupt.
+ */
+void dma_abort(DmaStream_t *pxStream)
+{
+	const BaseType_t xFromIsr = xPortIsInsideInterrupt();
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	UBaseType_t uxSavedInterruptStatus;
+	XferReq_t *pxReq;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+	if (pxStream->xQueue.pxHead != NULL)
+	{
+		dma_disable(pxStream);
+		dma_clear(pxStream);
+		clkgate_release(&pxStream->xClock);
+	}
+
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	for (;;)
+	{
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		pxReq = (pxStream->xQueue.pxHead != NULL) ? xfer_queue_pop(&pxStream->xQueue) : NULL;
+		taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+		if (pxReq == NULL)
+		{
+			break;
+		}
+
+		if (xFromIsr != pdFALSE)
+		{
+			xfer_complete_from_isr(pxReq, XFER_ERROR, &xHigherPriorityTaskWoken);
+		}
+		else
+		{
+			xfer_complete(pxReq, XFER_ERROR);
+		}
+	}
+
+	if (xFromIsr != pdFALSE)
+	{
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+	}
+}
+
+/**
+ * @brief Starts an idle stream moving items round a ring buffer, for good.
+ * @param pxStream Stream from dma_alloc(), with a default peripheral address.
+ * @param pvMem Ring of ulItems items.
+ * @param ulItems Number of items, 1 to DMA_MAX_ITEMS.
+ * @retval 0 if started, -1 if the stream is busy or the ring is invalid.
+ * @note Circular mode, with no interrupt but the error one: the CPU is not
+ * involved until dma_abort() stops it. The next item goes to (ulItems -
+ * dma_get_remaining()). Nothing may be submitted on the stream meanwhile.
+ */
+int32_t dma_start_ring(DmaStream_t *pxStream, void *pvMem, uint32_t ulItems)
+{
+	DMA_Stream_TypeDef *pxRegs = pxStream->pxRegs;
+	UBaseType_t uxSavedInterruptStatus;
+
+	if ((pvMem == NULL) || (ulItems == 0U) || (ulItems > DMA_MAX_ITEMS)
+			|| (pxStream->pvPeriph == NULL))
+	{
+		return -1;
+	}
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+	if (pxStream->xQueue.pxHead != NULL)
+	{
+		taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+		return -1;
+	}
+
+	/* Queued, so that dma_abort() and a transfer error end it as usual. */
+	dma_desc_init(&pxStream->xRing, NULL, pvMem, ulItems);
+	(void)xfer_queue_push(&pxStream->xQueue, &pxStream->xRing.xReq);
+	clkgate_acquire(&pxStream->xClock);
+
+	dma_clear(pxStream);
+	pxRegs->PAR = (uint32_t)pxStream->pvPeriph;
+	pxRegs->M0AR = (uint32_t)pvMem;
+	pxRegs->NDTR = ulItems;
+	pxRegs->FCR = pxStream->ulFcr;
+	pxRegs->CR = (pxStream->ulCr & ~(1U << DMA_SxCR_TCIE_OFS)) | (1U << DMA_SxCR_CIRC_OFS);
+	pxRegs->CR |= (1U << DMA_SxCR_EN_OFS);
+
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	return 0;
+}
+
+/**
+ * @brief Returns what is left of the descriptor in flight.
+ * @param pxStream Stream from dma_alloc().
+ * @retval Items not transferred yet, 0 if the stream is idle.
+ */
+uint32_t dma_get_remaining(const DmaStream_t *pxStream)
+{
+	return (pxStream->xQueue.pxHead != NULL) ? pxStream->pxRegs->NDTR : 0U;
+}
+
+/**
+ * @brief Returns the transfer counters of a stream.
+ * @param pxStream Stream from dma_alloc().
+ * @param pxStats Receives the counters, since the allocation.
+ * @retval None
+ * @note Sampling ulBytes twice gives the bandwidth the stream really uses.
+ */
+void dma_get_stats(const DmaStream_t *pxStream, DmaStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = pxStream->xStats;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Returns the bandwidth declared by the streams of a controller.
+ * @param ulDma 1 or 2.
+ * @retval Bytes per second, out of DMA_BANDWIDTH_BUDGET.
+ */
+uint32_t dma_get_bandwidth(uint32_t ulDma)
+{
+	return ((ulDma == 1U) || (ulDma == 2U)) ? ulDmaBandwidth[ulDma - 1U] : 0U;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Returns the interrupt flags of a stream, shifted down to bit 0.
+ * @param pxStream Stream.
+ * @retval FEIF (bit 0), DMEIF (2), TEIF (3), HTIF (4) and TCIF (5).
+ */
+static uint32_t dma_flags(const DmaStream_t *pxStream)
+{
+	static const uint8_t ucShift[4] = { 0, 6, 16, 22 };
+	uint32_t ulStream = pxStream->ucIndex & 7U;
+	uint32_t ulIsr = (ulStream < 4U) ? pxStream->pxDma->LISR : pxStream->pxDma->HISR;
+
+	return (ulIsr >> ucShift[ulStream & 3U]) & DMA_FLAGS_MASK;
+}
+
+/**
+ * @brief Clears the interrupt flags of a stream.
+ * @param pxStream Stream.
+ * @retval None
+ */
+static void dma_clear(const DmaStream_t *pxStream)
+{
+	static const uint8_t ucShift[4] = { 0, 6, 16, 22 };
+	uint32_t ulStream = pxStream->ucIndex & 7U;
+
+	if (ulStream < 4U)
+	{
+		pxStream->pxDma->LIFCR = DMA_FLAGS_MASK << ucShift[ulStream];
+	}
+	else
+	{
+		pxStream->pxDma->HIFCR = DMA_FLAGS_MASK << ucShift[ulStream - 4U];
+	}
+}
+
+/**
+ * @brief Disables a stream and waits until it is really off.
+ * @param pxStream Stream.
+ * @retval None
+ */
+static void dma_disable(const DmaStream_t *pxStream)
+{
+	pxStream->pxRegs->CR &= ~(1U << DMA_SxCR_EN_OFS);
+	while (pxStream->pxRegs->CR & (1U << DMA_SxCR_EN_OFS)){}
+}
+
+/**
+ * @brief Programs and starts the transfer of a descriptor.
+ * @param pxStream Stream, disabled.
+ * @param pxDesc Descriptor.
+ * @retval None
+ * @note Called with the stream's interrupt masked or from it.
+ */
+static void dma_load(DmaStream_t *pxStream, const DmaDesc_t *pxDesc)
+{
+	DMA_Stream_TypeDef *pxRegs = pxStream->pxRegs;
+
+	dma_clear(pxStream);
+	pxRegs->PAR = (uint32_t)((pxDesc->pvPeriph != NULL) ? pxDesc->pvPeriph : pxStream->pvPeriph);
+	pxRegs->M0AR = (uint32_t)pxDesc->xReq.pvData;
+	pxRegs->NDTR = pxDesc->xReq.ulLen;
+	pxRegs->FCR = pxStream->ulFcr;
+	pxRegs->CR = pxStream->ulCr;
+	pxRegs->CR = pxStream->ulCr | (1U << DMA_SxCR_EN_OFS);
+}
+
+/**
+ * @brief Interrupt of an allocated stream: a descriptor has ended.
+ * @param ulIndex Stream, DMA1 Stream0 being 0 and DMA2 Stream7 15.
+ * @retval None
+ * @note The next descriptor is started before the finished one is signalled,
+ * so the time the signal takes does not delay it.
+ */
+static void dma_irq(uint32_t ulIndex)
+{
+	DmaStream_t *pxStream = &xDmaStreams[ulIndex];
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	XferReq_t *pxDone;
+	uint32_t ulFlags;
+	int32_t lResult;
+
+	ulFlags = dma_flags(pxStream);
+	dma_clear(pxStream);
+
+	if (((ulFlags & (DMA_FLAG_TCIF | DMA_FLAG_TEIF)) == 0U) || (pxStream->xQueue.pxHead == NULL))
+	{
+		return;
+	}
+
+	pxDone = xfer_queue_pop(&pxStream->xQueue);
+
+	if (ulFlags & DMA_FLAG_TEIF)
+	{
+		/* The hardware has disabled the stream. */
+		pxStream->xStats.ulErrors++;
+		lResult = XFER_ERROR;
+	}
+	else
+	{
+		pxStream->xStats.ulBytes += pxDone->ulLen * pxStream->ucItemSize;
+		pxStream->xStats.ulDescs++;
+		lResult = (int32_t)pxDone->ulLen;
+	}
+
+	dma_disable(pxStream);
+
+	if (pxStream->xQueue.pxHead != NULL)
+	{
+		dma_load(pxStream, (const DmaDesc_t *)pxStream->xQueue.pxHead);
+		pxStream->xStats.ulChained++;
+	}
+	else
+	{
+		clkgate_release(&pxStream->xClock);
+	}
+
+	xfer_complete_from_isr(pxDone, lResult, &xHigherPriorityTaskWoken);
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/* Interrupt handlers of the streams not in DMA_FIXED_STREAMS. */
+#if ((DMA_FIXED_STREAMS) & DMA_STREAM_BIT(1U, 0U)) == 0U
+void DMA1_Stream0_IRQHandler(void) { dma_irq(0U); }
+#endif
+#if ((DMA_FIXED_STREAMS) & DMA_STREAM_BIT(1U, 1U)) == 0U
+void DMA1_Stream1_IRQHandler(void) { dma_irq(1U); }
+#endif
+#if ((DMA_FIXED_STREAMS) & DMA_STREAM_BIT(1U, 2U)) == 0U
+void DMA1_Stream2_IRQHandler(void) { dma_irq(2U); }
+#endif
+#if ((DMA_FIXED_STREAMS) & DMA_STREAM_BIT(1U, 3U)) == 0U
+void DMA1_Stream3_IRQHandler(void) { dma_irq(3U); }
+#endif
+#if ((DMA_FIXED_STREAMS) & DMA_STREAM_BIT(1U, 4U)) == 0U
+void DMA1_Stream4_IRQHandler(void) { dma_irq(4U); }
+#endif
+#if ((DMA_FIXED_STREAMS) & DMA_STREAM_BIT(1U, 5U)) == 0U
+void DMA1_Stream5_IRQHandler(void) { dma_irq(5U); }
+#endif
+#if ((DMA_FIXED_STREAMS) & DMA_STREAM_BIT(1U, 6U)) == 0U
+void DMA1_Stream6_IRQHandler(void) { dma_irq(6U); }
+#endif
+#if ((DMA_FIXED_STREAMS) & DMA_STREAM_BIT(1U, 7U)) == 0U
+void DMA1_Stream7_IRQHandler(void) { dma_irq(7U); }
+#endif
+#if ((DMA_FIXED_STREAMS) & DMA_STREAM_BIT(2U, 0U)) == 0U
+void DMA2_Stream0_IRQHandler(void) { dma_irq(8U); }
+#endif
+#if ((DMA_FIXED_STREAMS) & DMA_STREAM_BIT(2U, 1U)) == 0U
+void DMA2_Stream1_IRQHandler(void) { dma_irq(9U); }
+#endif
+#if ((DMA_FIXED_STREAMS) & DMA_STREAM_BIT(2U, 2U)) == 0U
+void DMA2_Stream2_IRQHandler(void) { dma_irq(10U); }
+#endif
+#if ((DMA_FIXED_STREAMS) & DMA_STREAM_BIT(2U, 3U)) == 0U
+void DMA2_Stream3_IRQHandler(void) { dma_irq(11U); }
+#endif
+#if ((DMA_FIXED_STREAMS) & DMA_STREAM_BIT(2U, 4U)) == 0U
+void DMA2_Stream4_IRQHandler(void) { dma_irq(12U); }
+#endif
+#if ((DMA_FIXED_STREAMS) & DMA_STREAM_BIT(2U, 5U)) == 0U
+void DMA2_Stream5_IRQHandler(void) { dma_irq(13U); }
+#endif
+#if ((DMA_FIXED_STREAMS) & DMA_STREAM_BIT(2U, 6U)) == 0U
+void DMA2_Stream6_IRQHandler(void) { dma_irq(14U); }
+#endif
+#if ((DMA_FIXED_STREAMS) & DMA_STREAM_BIT(2U, 7U)) == 0U
+void DMA2_Stream7_IRQHandler(void) { dma_irq(15U); }
+#endif
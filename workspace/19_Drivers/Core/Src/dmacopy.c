@@ -0,0 +1,226 @@
+/*******************************************************************************
+ *
+ * @file	dmacopy.c
+ * @brief	Memory copies offloaded to DMA2.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	dmacopy() is memcpy() for large blocks: a task copying at least
+ * 			DMACOPY_MIN_BYTES hands the words to a memory-to-memory stream
+ * 			of dma.c and blocks on a notification until they are there, so
+ * 			other tasks run meanwhile. Below the threshold the DMA set-up,
+ * 			interrupt and two context switches cost more than the copy.
+ *
+ * 			The DMA moves whole words, so the source and the destination
+ * 			must share their alignment. The CPU copies the bytes before the
+ * 			first aligned word and after the last one. Copies that cannot
+ * 			block are done by the CPU: from an ISR, in a critical section,
+ * 			with interrupts or the scheduler off, or before dmacopy_init().
+ *
+ * 			With configSTREAM_BUFFER_COPY pointing here (FreeRTOSConfig.h),
+ * 			stream and message buffers use it for their own copies. Queues
+ * 			copy items inside a critical section, so they stay on the CPU.
+ *
+ * 			dmacopy_prepare() and dmacopy_submit() queue a copy instead,
+ * 			signalled like any xfer.h request, for a task with other work
+ * 			to do meanwhile.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "xfer.h"
+#include "dma.h"
+#include "dmacopy.h"
+
+/* Variables -----------------------------------------------------------------*/
+static DmaStream_t *pxCopyStream = NULL;
+static DmaCopyStats_t xCopyStats = { 0, 0, 0 };
+
+/* Private function prototypes -----------------------------------------------*/
+static BaseType_t dmacopy_can_block(void);
+static void dmacopy_count(uint32_t ulDmaBytes, uint32_t ulCpuBytes);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Allocates the memory-to-memory stream.
+ * @param None
+ * @retval 0 on success, -1 if dma_alloc() found no DMA2 stream.
+ * @note Call from a task or before the scheduler starts. Until then, and if it
+ * fails, every copy is done by the CPU.
+ */
+int32_t dmacopy_init(void)
+{
+	static const DmaConfig_t xConfig =
+	{ DMA_REQ_MEM_TO_MEM, DMA_DIR_M2M, DMACOPY_PRIORITY, 4U, 1U, 1U, NULL, 0U };
+
+	if (pxCopyStream != NULL)
+	{
+		return 0;
+	}
+
+	return dma_alloc(&xConfig, &pxCopyStream);
+}
+
+/**
+ * @brief Copies bytes, with the DMA when it pays.
+ * @param pvDest Destination, in SRAM.
+ * @param pvSrc Source, in SRAM or flash. The areas must not overlap.
+ * @param xLen Number of bytes.
+ * @retval pvDest, like memcpy().
+ * @note May be called from anywhere; it only blocks (the calling task) when it
+ * can. Copies sharing the stream are served in turn.
+ */
+void *dmacopy(void *pvDest, const void *pvSrc, size_t xLen)
+{
+	uint8_t *pucDest = (uint8_t *)pvDest;
+	const uint8_t *pucSrc = (const uint8_t *)pvSrc;
+	DmaDesc_t xDesc;
+	uint32_t ulHead;
+	uint32_t ulWords;
+	uint32_t ulChunk;
+	uint32_t ulDma = 0;
+
+	if (xLen < DMACOPY_MIN_BYTES)
+	{
+		return memcpy(pvDest, pvSrc, xLen);
+	}
+
+	if ((((uint32_t)pucDest ^ (uint32_t)pucSrc) & 3U) || (dmacopy_can_block() == pdFALSE))
+	{
+		dmacopy_count(0U, xLen);
+		return memcpy(pvDest, pvSrc, xLen);
+	}
+
+	ulHead = (4U - ((uint32_t)pucDest & 3U)) & 3U;
+	(void)memcpy(pucDest, pucSrc, ulHead);
+	pucDest += ulHead;
+	pucSrc += ulHead;
+	xLen -= ulHead;
+
+	for (ulWords = xLen / 4U; ulWords > 0U; ulWords -= ulChunk)
+	{
+		ulChunk = (ulWords < DMA_MAX_ITEMS) ? ulWords : DMA_MAX_ITEMS;
+
+		/* The peripheral port reads, the memory port writes. */
+		dma_desc_init(&xDesc, (volatile void *)pucSrc, pucDest, ulChunk);
+		xfer_on_task(&xDesc.xReq, NULL);
+
+		if ((dma_submit(pxCopyStream, &xDesc) != 0)
+				|| (xfer_wait(&xDesc.xReq, portMAX_DELAY) != (int32_t)ulChunk))
+		{
+			(void)memcpy(pucDest, pucSrc, 4U * ulChunk);
+		}
+		else
+		{
+			ulDma += 4U * ulChunk;
+		}
+
+		pucDest += 4U * ulChunk;
+		pucSrc += 4U * ulChunk;
+		xLen -= 4U * ulChunk;
+	}
+
+	(void)memcpy(pucDest, pucSrc, xLen);
+	dmacopy_count(ulDma, ulHead + xLen);
+
+	return pvDest;
+}
+
+/**
+ * @brief Prepares a descriptor for a copy queued with dmacopy_submit().
+ * @param pxDesc Descriptor, not queued.
+ * @param pvDest Destination, in SRAM, word aligned.
+ * @param pvSrc Source, in SRAM or flash, word aligned.
+ * @param xLen Number of bytes, a multiple of 4 up to 4 * DMA_MAX_ITEMS.
+ * @retval 0 if prepared, with no completion signal yet, -1 if the copy does not
+ * suit the DMA or dmacopy_init() has not succeeded: use memcpy().
+ * @note Choose the signal with xfer_on_...(&pxDesc->xReq, ...). The request
+ * completes with lResult = xLen / 4 words, or XFER_ERROR.
+ */
+int32_t dmacopy_prepare(DmaDesc_t *pxDesc, void *pvDest, const void *pvSrc, size_t xLen)
+{
+	if ((pxCopyStream == NULL) || (xLen == 0U) || (xLen > (4U * DMA_MAX_ITEMS))
+			|| ((((uint32_t)pvDest | (uint32_t)pvSrc | xLen) & 3U) != 0U))
+	{
+		return -1;
+	}
+
+	dma_desc_init(pxDesc, (volatile void *)pvSrc, pvDest, xLen / 4U);
+
+	return 0;
+}
+
+/**
+ * @brief Queues a copy prepared with dmacopy_prepare().
+ * @param pxDesc Descriptor.
+ * @retval 0 if queued, -1 otherwise.
+ * @note Neither area may be touched until the request completes. May be called
+ * from an ISR.
+ */
+int32_t dmacopy_submit(DmaDesc_t *pxDesc)
+{
+	if (dma_submit(pxCopyStream, pxDesc) != 0)
+	{
+		return -1;
+	}
+
+	dmacopy_count(4U * pxDesc->xReq.ulLen, 0U);
+
+	return 0;
+}
+
+/**
+ * @brief Returns the copy counters.
+ * @param pxStats Receives the counters.
+ * @retval None
+ */
+void dmacopy_get_stats(DmaCopyStats_t *pxStats)
+{
+	UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	*pxStats = xCopyStats;
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Tells whether the caller may block on a DMA copy.
+ * @param None
+ * @retval pdTRUE for a task, with the scheduler running and interrupts enabled,
+ * once the stream is allocated.
+ */
+static BaseType_t dmacopy_can_block(void)
+{
+	if ((pxCopyStream == NULL) || (__get_IPSR() != 0U) || (__get_PRIMASK() != 0U)
+			|| (__get_BASEPRI() != 0U)
+			|| (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING))
+	{
+		return pdFALSE;
+	}
+
+	return pdTRUE;
+}
+
+/**
+ * @brief Adds to the copy counters.
+ * @param ulDmaBytes Bytes copied by the DMA.
+ * @param ulCpuBytes Bytes of a large copy copied by the CPU.
+ * @retval None
+ */
+static void dmacopy_count(uint32_t ulDmaBytes, uint32_t ulCpuBytes)
+{
+	UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	xCopyStats.ulDmaBytes += ulDmaBytes;
+	xCopyStats.ulCpuBytes += ulCpuBytes;
+	xCopyStats.ulDmaCopies += (ulDmaBytes != 0U) ? 1U : 0U;
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
@@ -0,0 +1,663 @@
+/*******************************************************************************
+ *
+ * @file	fat.c
+ * @brief	Implementation of the FAT32 file writer.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	Just enough FAT32 for a logger on the SD card (sdio.c): creating
+ * 			a file in the root directory with all of its clusters allocated
+ * 			up front and contiguous, so that data goes straight to
+ * 			consecutive sectors with no FAT traffic while logging, then
+ * 			recording its size and giving the unused tail back. No
+ * 			reading, no subdirectories, no long names.
+ *
+ * 			The volume is the first FAT32 partition of an MBR card, or the
+ * 			whole card if it has no partition table, as formatted by a PC
+ * 			or SD Formatter. The root directory is not grown: creation
+ * 			fails once its clusters are full.
+ *
+ * 			One sector buffer serves everything; the FAT sector in it is
+ * 			written to every FAT copy before another sector is loaded.
+ * 			Not thread-safe: one task uses it.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "sdio.h"
+#include "fat.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define FAT_SECTOR_BYTES		512U
+#define FAT_ENTRIES_PER_SECTOR	(FAT_SECTOR_BYTES / 4U)
+#define FAT_DIR_ENTRY_BYTES		32U
+#define FAT_EOC					0x0FFFFFFFU
+#define FAT_ENTRY_MASK			0x0FFFFFFFU
+#define FAT_NO_SECTOR			0xFFFFFFFFU
+#define FAT_ATTR_ARCHIVE		0x20U
+#define FAT_ATTR_VOLUME_ID		0x08U
+#define FAT_NAME_FREE			0xE5U
+#define FAT_NAME_END			0x00U
+#define FAT_FSINFO_SIGNATURE	0x41615252U
+#define FAT_FSINFO_FREE			488U
+#define FAT_FSINFO_NEXT			492U
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint8_t ucMounted;
+	uint8_t ucDirty;				/* The buffered FAT sector is changed. */
+	uint32_t ulFats;
+	uint32_t ulFatLba;
+	uint32_t ulFatSectors;			/* Per copy. */
+	uint32_t ulDataLba;
+	uint32_t ulSectorsPerCluster;
+	uint32_t ulClusters;			/* Data clusters: 2 to ulClusters + 1. */
+	uint32_t ulRootCluster;
+	uint32_t ulFsInfoLba;
+	uint32_t ulNextFree;			/* Where to look for free clusters first. */
+	uint32_t ulLoaded;				/* Sector in the buffer, or FAT_NO_SECTOR. */
+} FatVolume_t;
+
+/* Variables -----------------------------------------------------------------*/
+static FatVolume_t xVol;
+static uint32_t ulSector[FAT_SECTOR_BYTES / 4U] __attribute__((aligned(16)));
+static uint8_t *const pucSector = (uint8_t *)ulSector;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t fat_get16(const uint8_t *pucData);
+static uint32_t fat_get32(const uint8_t *pucData);
+static void fat_put16(uint8_t *pucData, uint32_t ulValue);
+static void fat_put32(uint8_t *pucData, uint32_t ulValue);
+static int32_t fat_flush(void);
+static int32_t fat_load(uint32_t ulLba);
+static int32_t fat_store(void);
+static int32_t fat_entry_get(uint32_t ulCluster, uint32_t *pulValue);
+static int32_t fat_entry_set(uint32_t ulCluster, uint32_t ulValue);
+static uint32_t fat_cluster_lba(uint32_t ulCluster);
+static int32_t fat_to_short_name(const char *pcName, uint8_t *pucShort);
+static int32_t fat_find_dir_slot(const uint8_t *pucShort, FatFile_t *pxFile);
+static int32_t fat_find_free_run(uint32_t ulCount, uint32_t *pulFirst);
+static int32_t fat_update_fsinfo(void);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Finds the FAT32 volume on the card.
+ * @param None
+ * @retval 0 if successful, -1 if no FAT32 volume of 512-byte sectors is found.
+ * @note The card must be open (sdio_open()).
+ */
+int32_t fat_mount(void)
+{
+	uint32_t ulPartLba = 0;
+	uint32_t ulType;
+	uint32_t ulReserved;
+	uint32_t ulTotal;
+
+	xVol.ucMounted = 0;
+	xVol.ucDirty = 0;
+	xVol.ulLoaded = FAT_NO_SECTOR;
+
+	if ((fat_load(0U) != 0) || (fat_get16(&pucSector[510]) != 0xAA55U))
+	{
+		return -1;
+	}
+
+	/* An MBR whose first partition is FAT32 (CHS or LBA), or a bare volume. */
+	ulType = pucSector[0x1C2];
+
+	if ((ulType == 0x0BU) || (ulType == 0x0CU))
+	{
+		ulPartLba = fat_get32(&pucSector[0x1C6]);
+
+		if ((fat_load(ulPartLba) != 0) || (fat_get16(&pucSector[510]) != 0xAA55U))
+		{
+			return -1;
+		}
+	}
+
+	xVol.ulSectorsPerCluster = pucSector[0x0D];
+	ulReserved = fat_get16(&pucSector[0x0E]);
+	xVol.ulFats = pucSector[0x10];
+	ulTotal = fat_get32(&pucSector[0x20]);
+	xVol.ulFatSectors = fat_get32(&pucSector[0x24]);
+	xVol.ulRootCluster = fat_get32(&pucSector[0x2C]);
+
+	/* FAT12 and FAT16 have a 16-bit FAT size, and no root cluster. */
+	if ((fat_get16(&pucSector[0x0B]) != FAT_SECTOR_BYTES) || (fat_get16(&pucSector[0x16]) != 0U)
+			|| (xVol.ulSectorsPerCluster == 0U)
+			|| ((xVol.ulSectorsPerCluster & (xVol.ulSectorsPerCluster - 1U)) != 0U)
+			|| (xVol.ulFats == 0U) || (xVol.ulFatSectors == 0U) || (xVol.ulRootCluster < 2U))
+	{
+		return -1;
+	}
+
+	xVol.ulFatLba = ulPartLba + ulReserved;
+	xVol.ulDataLba = xVol.ulFatLba + (xVol.ulFats * xVol.ulFatSectors);
+	xVol.ulClusters = (ulTotal - (xVol.ulDataLba - ulPartLba)) / xVol.ulSectorsPerCluster;
+	xVol.ulFsInfoLba = ulPartLba + fat_get16(&pucSector[0x30]);
+	xVol.ulNextFree = 2U;
+
+	if ((fat_load(xVol.ulFsInfoLba) == 0) && (fat_get32(&pucSector[0]) == FAT_FSINFO_SIGNATURE))
+	{
+		const uint32_t ulHint = fat_get32(&pucSector[FAT_FSINFO_NEXT]);
+
+		if ((ulHint >= 2U) && (ulHint < (xVol.ulClusters + 2U)))
+		{
+			xVol.ulNextFree = ulHint;
+		}
+	}
+	else
+	{
+		xVol.ulFsInfoLba = 0;
+	}
+
+	xVol.ucMounted = 1;
+
+	return 0;
+}
+
+/**
+ * @brief Creates a file in the root directory with contiguous clusters.
+ * @param pxFile Receives the file.
+ * @param pcName 8.3 name, e.g. "LOG00001.BIN", upper case.
+ * @param ulBytes Space to allocate, rounded up to whole clusters.
+ * @retval 0 if successful, -1 if the name exists or is invalid, the root
+ * directory is full, no free run is long enough, or the card fails.
+ * @note The file is created empty: its size grows with fat_set_size().
+ */
+int32_t fat_create_contiguous(FatFile_t *pxFile, const char *pcName, uint32_t ulBytes)
+{
+	const uint32_t ulClusterBytes = fat_get_cluster_bytes();
+	uint8_t ucShort[11];
+	uint32_t ulFirst;
+	uint32_t ulCount;
+	uint32_t ulCluster;
+	uint8_t *pucEntry;
+
+	if ((xVol.ucMounted == 0U) || (ulBytes == 0U) || (fat_to_short_name(pcName, ucShort) != 0))
+	{
+		return -1;
+	}
+
+	ulCount = (ulBytes + ulClusterBytes - 1U) / ulClusterBytes;
+
+	if ((fat_find_dir_slot(ucShort, pxFile) != 0) || (fat_find_free_run(ulCount, &ulFirst) != 0))
+	{
+		return -1;
+	}
+
+	/* The chain first: a crash before the entry only loses clusters. */
+	for (ulCluster = ulFirst; ulCluster < (ulFirst + ulCount); ulCluster++)
+	{
+		if (fat_entry_set(ulCluster, (ulCluster == (ulFirst + ulCount - 1U)) ? FAT_EOC
+				: (ulCluster + 1U)) != 0)
+		{
+			return -1;
+		}
+	}
+
+	if ((fat_flush() != 0) || (fat_load(pxFile->ulDirLba) != 0))
+	{
+		return -1;
+	}
+
+	pucEntry = &pucSector[pxFile->ulDirOffset];
+	(void)memset(pucEntry, 0, FAT_DIR_ENTRY_BYTES);
+	(void)memcpy(pucEntry, ucShort, sizeof(ucShort));
+	pucEntry[11] = FAT_ATTR_ARCHIVE;
+	fat_put16(&pucEntry[20], ulFirst >> 16);
+	fat_put16(&pucEntry[26], ulFirst & 0xFFFFU);
+
+	if (fat_store() != 0)
+	{
+		return -1;
+	}
+
+	pxFile->ulFirstCluster = ulFirst;
+	pxFile->ulClusters = ulCount;
+	pxFile->ulLba = fat_cluster_lba(ulFirst);
+	pxFile->ulSize = 0;
+
+	xVol.ulNextFree = ulFirst + ulCount;
+
+	if (xVol.ulNextFree >= (xVol.ulClusters + 2U))
+	{
+		xVol.ulNextFree = 2U;
+	}
+
+	return fat_update_fsinfo();
+}
+
+/**
+ * @brief Records the size of a file in its directory entry.
+ * @param pxFile File.
+ * @param ulSize Bytes, within the allocated clusters.
+ * @retval 0 if successful, -1 otherwise.
+ */
+int32_t fat_set_size(FatFile_t *pxFile, uint32_t ulSize)
+{
+	uint8_t *pucEntry;
+
+	if ((xVol.ucMounted == 0U)
+			|| (ulSize > (pxFile->ulClusters * fat_get_cluster_bytes()))
+			|| (fat_flush() != 0) || (fat_load(pxFile->ulDirLba) != 0))
+	{
+		return -1;
+	}
+
+	pucEntry = &pucSector[pxFile->ulDirOffset];
+	fat_put16(&pucEntry[20], pxFile->ulFirstCluster >> 16);
+	fat_put16(&pucEntry[26], pxFile->ulFirstCluster & 0xFFFFU);
+	fat_put32(&pucEntry[28], ulSize);
+
+	if (fat_store() != 0)
+	{
+		return -1;
+	}
+
+	pxFile->ulSize = ulSize;
+
+	return 0;
+}
+
+/**
+ * @brief Sets the size of a file and frees the clusters past it.
+ * @param pxFile File.
+ * @param ulSize Bytes, within the allocated clusters.
+ * @retval 0 if successful, -1 otherwise.
+ */
+int32_t fat_truncate(FatFile_t *pxFile, uint32_t ulSize)
+{
+	const uint32_t ulClusterBytes = fat_get_cluster_bytes();
+	const uint32_t ulKeep = (ulSize + ulClusterBytes - 1U) / ulClusterBytes;
+	uint32_t ulCluster;
+
+	if ((xVol.ucMounted == 0U) || (ulKeep > pxFile->ulClusters))
+	{
+		return -1;
+	}
+
+	for (ulCluster = pxFile->ulFirstCluster + ulKeep;
+			ulCluster < (pxFile->ulFirstCluster + pxFile->ulClusters); ulCluster++)
+	{
+		if (fat_entry_set(ulCluster, 0U) != 0)
+		{
+			return -1;
+		}
+	}
+
+	if ((ulKeep != 0U) && (ulKeep < pxFile->ulClusters)
+			&& (fat_entry_set(pxFile->ulFirstCluster + ulKeep - 1U, FAT_EOC) != 0))
+	{
+		return -1;
+	}
+
+	/* Freed clusters are the next to reuse. */
+	if (ulKeep < pxFile->ulClusters)
+	{
+		xVol.ulNextFree = pxFile->ulFirstCluster + ulKeep;
+	}
+
+	/* An empty file has no clusters. */
+	pxFile->ulClusters = ulKeep;
+
+	if (ulKeep == 0U)
+	{
+		pxFile->ulFirstCluster = 0;
+	}
+
+	if ((fat_set_size(pxFile, ulSize) != 0) || (fat_update_fsinfo() != 0))
+	{
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Returns the size of a cluster.
+ * @param None
+ * @retval Bytes, 0 if no volume is mounted.
+ */
+uint32_t fat_get_cluster_bytes(void)
+{
+	return (xVol.ucMounted != 0U) ? (xVol.ulSectorsPerCluster * FAT_SECTOR_BYTES) : 0U;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Reads a little-endian 16-bit field.
+ * @param pucData Field.
+ * @retval Value.
+ */
+static uint32_t fat_get16(const uint8_t *pucData)
+{
+	return (uint32_t)pucData[0] | ((uint32_t)pucData[1] << 8);
+}
+
+/**
+ * @brief Reads a little-endian 32-bit field.
+ * @param pucData Field.
+ * @retval Value.
+ */
+static uint32_t fat_get32(const uint8_t *pucData)
+{
+	return fat_get16(pucData) | (fat_get16(&pucData[2]) << 16);
+}
+
+/**
+ * @brief Writes a little-endian 16-bit field.
+ * @param pucData Field.
+ * @param ulValue Value.
+ * @retval None
+ */
+static void fat_put16(uint8_t *pucData, uint32_t ulValue)
+{
+	pucData[0] = (uint8_t)ulValue;
+	pucData[1] = (uint8_t)(ulValue >> 8);
+}
+
+/**
+ * @brief Writes a little-endian 32-bit field.
+ * @param pucData Field.
+ * @param ulValue Value.
+ * @retval None
+ */
+static void fat_put32(uint8_t *pucData, uint32_t ulValue)
+{
+	fat_put16(pucData, ulValue);
+	fat_put16(&pucData[2], ulValue >> 16);
+}
+
+/**
+ * @brief Writes the buffered FAT sector, if changed, to every FAT copy.
+ * @param None
+ * @retval 0 if successful, -1 otherwise.
+ */
+static int32_t fat_flush(void)
+{
+	uint32_t ulCopy;
+
+	if (xVol.ucDirty == 0U)
+	{
+		return 0;
+	}
+
+	for (ulCopy = 0; ulCopy < xVol.ulFats; ulCopy++)
+	{
+		if (sdio_write(xVol.ulLoaded + (ulCopy * xVol.ulFatSectors), ulSector, 1U) != 0)
+		{
+			return -1;
+		}
+	}
+
+	xVol.ucDirty = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Brings a sector into the buffer.
+ * @param ulLba Sector.
+ * @retval 0 if successful, -1 otherwise.
+ */
+static int32_t fat_load(uint32_t ulLba)
+{
+	if (ulLba == xVol.ulLoaded)
+	{
+		return 0;
+	}
+
+	if (fat_flush() != 0)
+	{
+		return -1;
+	}
+
+	if (sdio_read(ulLba, ulSector, 1U) != 0)
+	{
+		xVol.ulLoaded = FAT_NO_SECTOR;
+		return -1;
+	}
+
+	xVol.ulLoaded = ulLba;
+
+	return 0;
+}
+
+/**
+ * @brief Writes the buffered (non-FAT) sector back.
+ * @param None
+ * @retval 0 if successful, -1 otherwise.
+ */
+static int32_t fat_store(void)
+{
+	return sdio_write(xVol.ulLoaded, ulSector, 1U);
+}
+
+/**
+ * @brief Reads the FAT entry of a cluster.
+ * @param ulCluster Cluster.
+ * @param pulValue Receives the entry, 0 if free.
+ * @retval 0 if successful, -1 otherwise.
+ */
+static int32_t fat_entry_get(uint32_t ulCluster, uint32_t *pulValue)
+{
+	if (fat_load(xVol.ulFatLba + (ulCluster / FAT_ENTRIES_PER_SECTOR)) != 0)
+	{
+		return -1;
+	}
+
+	*pulValue = fat_get32(&pucSector[(ulCluster % FAT_ENTRIES_PER_SECTOR) * 4U]) & FAT_ENTRY_MASK;
+
+	return 0;
+}
+
+/**
+ * @brief Changes the FAT entry of a cluster in the buffer.
+ * @param ulCluster Cluster.
+ * @param ulValue Next cluster, FAT_EOC or 0.
+ * @retval 0 if successful, -1 otherwise.
+ * @note The upper four bits are reserved and kept.
+ */
+static int32_t fat_entry_set(uint32_t ulCluster, uint32_t ulValue)
+{
+	uint8_t *pucEntry;
+
+	if (fat_load(xVol.ulFatLba + (ulCluster / FAT_ENTRIES_PER_SECTOR)) != 0)
+	{
+		return -1;
+	}
+
+	pucEntry = &pucSector[(ulCluster % FAT_ENTRIES_PER_SECTOR) * 4U];
+	fat_put32(pucEntry, (fat_get32(pucEntry) & ~FAT_ENTRY_MASK) | ulValue);
+	xVol.ucDirty = 1;
+
+	return 0;
+}
+
+/**
+ * @brief Returns the first sector of a cluster.
+ * @param ulCluster Cluster, 2 or more.
+ * @retval Sector.
+ */
+static uint32_t fat_cluster_lba(uint32_t ulCluster)
+{
+	return xVol.ulDataLba + ((ulCluster - 2U) * xVol.ulSectorsPerCluster);
+}
+
+/**
+ * @brief Converts "NAME.EXT" to the 11 space-padded characters of an entry.
+ * @param pcName Name.
+ * @param pucShort Receives the entry name.
+ * @retval 0 if successful, -1 if the name does not fit 8.3.
+ */
+static int32_t fat_to_short_name(const char *pcName, uint8_t *pucShort)
+{
+	uint32_t ulPos = 0;
+
+	(void)memset(pucShort, ' ', 11U);
+
+	while ((*pcName != '\0') && (*pcName != '.'))
+	{
+		if (ulPos == 8U)
+		{
+			return -1;
+		}
+
+		pucShort[ulPos++] = (uint8_t)*pcName++;
+	}
+
+	if (ulPos == 0U)
+	{
+		return -1;
+	}
+
+	if (*pcName == '.')
+	{
+		pcName++;
+
+		for (ulPos = 8U; *pcName != '\0'; ulPos++)
+		{
+			if (ulPos == 11U)
+			{
+				return -1;
+			}
+
+			pucShort[ulPos] = (uint8_t)*pcName++;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Finds a free root directory entry, making sure the name is unused.
+ * @param pucShort Entry name.
+ * @param pxFile Receives the entry's sector and offset.
+ * @retval 0 if found, -1 if the name exists, the directory is full or the
+ * card fails.
+ */
+static int32_t fat_find_dir_slot(const uint8_t *pucShort, FatFile_t *pxFile)
+{
+	uint32_t ulCluster = xVol.ulRootCluster;
+	uint32_t ulFound = 0;
+	uint32_t ulSectorIndex;
+	uint32_t ulOffset;
+	uint32_t ulLba;
+
+	while ((ulCluster >= 2U) && (ulCluster < (xVol.ulClusters + 2U)))
+	{
+		for (ulSectorIndex = 0; ulSectorIndex < xVol.ulSectorsPerCluster; ulSectorIndex++)
+		{
+			ulLba = fat_cluster_lba(ulCluster) + ulSectorIndex;
+
+			if (fat_load(ulLba) != 0)
+			{
+				return -1;
+			}
+
+			for (ulOffset = 0; ulOffset < FAT_SECTOR_BYTES; ulOffset += FAT_DIR_ENTRY_BYTES)
+			{
+				const uint8_t *pucEntry = &pucSector[ulOffset];
+
+				if ((pucEntry[0] == FAT_NAME_END) || (pucEntry[0] == FAT_NAME_FREE))
+				{
+					if (ulFound == 0U)
+					{
+						ulFound = 1;
+						pxFile->ulDirLba = ulLba;
+						pxFile->ulDirOffset = ulOffset;
+					}
+
+					/* Nothing follows the end marker. */
+					if (pucEntry[0] == FAT_NAME_END)
+					{
+						return 0;
+					}
+				}
+				else if (((pucEntry[11] & FAT_ATTR_VOLUME_ID) == 0U)
+						&& (memcmp(pucEntry, pucShort, 11U) == 0))
+				{
+					return -1;
+				}
+			}
+		}
+
+		if (fat_entry_get(ulCluster, &ulCluster) != 0)
+		{
+			return -1;
+		}
+	}
+
+	return (ulFound != 0U) ? 0 : -1;
+}
+
+/**
+ * @brief Finds consecutive free clusters, from the free hint on, wrapping once.
+ * @param ulCount Clusters.
+ * @param pulFirst Receives the first.
+ * @retval 0 if found, -1 otherwise.
+ */
+static int32_t fat_find_free_run(uint32_t ulCount, uint32_t *pulFirst)
+{
+	const uint32_t ulEnd = xVol.ulClusters + 2U;
+	uint32_t ulCluster = xVol.ulNextFree;
+	uint32_t ulChecked;
+	uint32_t ulRun = 0;
+	uint32_t ulValue;
+
+	for (ulChecked = 0; ulChecked < xVol.ulClusters; ulChecked++)
+	{
+		/* A run does not wrap around the end of the volume. */
+		if (ulCluster == ulEnd)
+		{
+			ulCluster = 2U;
+			ulRun = 0;
+		}
+
+		if (fat_entry_get(ulCluster, &ulValue) != 0)
+		{
+			return -1;
+		}
+
+		ulRun = (ulValue == 0U) ? (ulRun + 1U) : 0U;
+
+		if (ulRun == ulCount)
+		{
+			*pulFirst = ulCluster + 1U - ulCount;
+			return 0;
+		}
+
+		ulCluster++;
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Updates FSInfo: the free count becomes unknown, the hint moves on.
+ * @param None
+ * @retval 0 if successful (or the volume has no FSInfo), -1 otherwise.
+ * @note The host recounts free clusters; keeping the count right would
+ * need a full FAT scan here.
+ */
+static int32_t fat_update_fsinfo(void)
+{
+	if (xVol.ulFsInfoLba == 0U)
+	{
+		return fat_flush();
+	}
+
+	if (fat_load(xVol.ulFsInfoLba) != 0)
+	{
+		return -1;
+	}
+
+	fat_put32(&pucSector[FAT_FSINFO_FREE], 0xFFFFFFFFU);
+	fat_put32(&pucSector[FAT_FSINFO_NEXT], xVol.ulNextFree);
+
+	return fat_store();
+}
@@ -0,0 +1,570 @@
+/*******************************************************************************
+ *
+ * @file	gatekeeper.c
+ * @brief	Reusable gatekeeper task: the only task that touches a shared
+ * 			resource (UART, SPI flash, display), serving write requests that
+ * 			other tasks and ISRs post to its queue.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	The resource is reached through one write function, given to
+ * 			gatekeeper_start(), that performs one transaction. Each wakeup
+ * 			drains up to GATEKEEPER_BATCH requests at once (one critical
+ * 			section with configUSE_QUEUE_BATCH) and merges adjacent ones in
+ * 			a staging buffer, so a burst of small writes costs one
+ * 			transaction, and one peripheral setup, instead of one each:
+ *
+ * 				- requests to GATEKEEPER_ADDRESS_STREAM all merge, in order;
+ * 				- a request to an address merges with the run before it if it
+ * 				  starts where that run ends.
+ *
+ * 			A run ends when the next request does not merge, when it would
+ * 			overflow GATEKEEPER_STAGING_BYTES, or at the end of the batch.
+ * 			Requests are never reordered.
+ *
+ * 			Writes longer than GATEKEEPER_REQUEST_BYTES are split into
+ * 			several requests, which writes of other tasks may come between;
+ * 			shorter writes are atomic. ISRs can only post writes that fit in
+ * 			one request.
+ *
+ * 			Producers that must not block nor lose writes to a full queue
+ * 			can borrow queue slots instead: gatekeeper_add_producer() lends
+ * 			one a credit window (see credit.h), and gatekeeper_write_credit()
+ * 			posts only what the producer has credit for, failing without a
+ * 			kernel call otherwise, so the producer finds out before it even
+ * 			formats the data and can slow down. The gatekeeper grants the
+ * 			credits of the requests it has written back in batches of
+ * 			GATEKEEPER_CREDIT_BATCH, or all of them when the queue runs dry,
+ * 			so credits flow back at the rate the resource really drains.
+ *
+ * 			Service time, from the post to the end of the transaction that
+ * 			carried the request, is measured with the DWT cycle counter.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "gatekeeper.h"
+
+/* Macros --------------------------------------------------------------------*/
+#if (GATEKEEPER_REQUEST_BYTES > GATEKEEPER_STAGING_BYTES)
+#error GATEKEEPER_REQUEST_BYTES cannot exceed GATEKEEPER_STAGING_BYTES
+#endif
+
+#if (GATEKEEPER_REQUEST_BYTES > 0xFFFFU)
+#error GATEKEEPER_REQUEST_BYTES must fit in a uint16_t
+#endif
+
+/* Private function prototypes -----------------------------------------------*/
+static UBaseType_t gatekeeper_receive_batch(Gatekeeper_t *pxGatekeeper);
+static uint32_t gatekeeper_merges(uint32_t ulRunAddress, uint32_t ulRunLength,
+		const GatekeeperRequest_t *pxRequest);
+static void gatekeeper_flush(Gatekeeper_t *pxGatekeeper, uint32_t ulRunAddress,
+		uint32_t ulRunLength, UBaseType_t uxFirst, UBaseType_t uxEnd);
+static void gatekeeper_count_drop(Gatekeeper_t *pxGatekeeper);
+static void gatekeeper_grant(Gatekeeper_t *pxGatekeeper);
+static void gatekeeper_task(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Initializes a gatekeeper and creates its task.
+ * @param pxGatekeeper Gatekeeper to start. Its queue, buffers, stack and TCB
+ * are all inside it.
+ * @param pcName Name of the gatekeeper task.
+ * @param pxWrite Function that performs one transaction with the resource.
+ * @param pvContext First argument of pxWrite.
+ * @param uxPriority Priority of the gatekeeper task.
+ * @retval 0 if successful, -1 otherwise.
+ * @note Call before posting to the gatekeeper, from a task or before the
+ * scheduler starts.
+ */
+int32_t gatekeeper_start(Gatekeeper_t *pxGatekeeper, const char *pcName,
+		GatekeeperWrite_t pxWrite, void *pvContext, UBaseType_t uxPriority)
+{
+	if ((pxGatekeeper == NULL) || (pxWrite == NULL))
+	{
+		return -1;
+	}
+
+	/* Service time is measured in core clock cycles. */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	pxGatekeeper->pxWrite = pxWrite;
+	pxGatekeeper->pvContext = pvContext;
+	pxGatekeeper->ulDropped = 0;
+	memset(&pxGatekeeper->xStats, 0, sizeof(pxGatekeeper->xStats));
+	pxGatekeeper->xStats.ulMinCycles = UINT32_MAX;
+	pxGatekeeper->ulProducers = 0;
+	pxGatekeeper->ulWindows = 0;
+
+	pxGatekeeper->xQueue = xQueueCreateStatic(GATEKEEPER_QUEUE_LENGTH,
+											  sizeof(GatekeeperRequest_t),
+											  pxGatekeeper->ucQueueStorage,
+											  &pxGatekeeper->xQueueBuffer);
+
+	if (pxGatekeeper->xQueue == NULL)
+	{
+		return -1;
+	}
+
+	/* Listed under the task name, e.g. for uxQueueGetRegistryMetrics(). */
+	vQueueAddToRegistry(pxGatekeeper->xQueue, pcName);
+
+	pxGatekeeper->xTask = xTaskCreateStatic(gatekeeper_task,
+											pcName,
+											GATEKEEPER_STACK_WORDS,
+											pxGatekeeper,
+											uxPriority,
+											pxGatekeeper->xTaskStack,
+											&pxGatekeeper->xTaskTcb);
+
+	return (pxGatekeeper->xTask != NULL) ? 0 : -1;
+}
+
+/**
+ * @brief Posts a write from a task.
+ * @param pxGatekeeper Gatekeeper started with gatekeeper_start().
+ * @param ulAddress Address in the resource of the first byte, or
+ * GATEKEEPER_ADDRESS_STREAM.
+ * @param pvData Bytes to write. Copied before the call returns.
+ * @param ulLength Number of bytes.
+ * @param xTicksToWait Longest time to wait for room in the queue, for the
+ * whole write.
+ * @retval 0 if successful, -1 if the queue stayed full. Part of a write that
+ * was split may have been posted.
+ */
+int32_t gatekeeper_write(Gatekeeper_t *pxGatekeeper, uint32_t ulAddress,
+		const void *pvData, uint32_t ulLength, TickType_t xTicksToWait)
+{
+	const uint8_t *pucData = pvData;
+	GatekeeperRequest_t xRequest;
+	TimeOut_t xTimeOut;
+	uint32_t ulChunk;
+
+	if ((pxGatekeeper == NULL) || ((pvData == NULL) && (ulLength != 0U)))
+	{
+		return -1;
+	}
+
+	vTaskSetTimeOutState(&xTimeOut);
+
+	while (ulLength > 0U)
+	{
+		ulChunk = (ulLength < GATEKEEPER_REQUEST_BYTES) ? ulLength : GATEKEEPER_REQUEST_BYTES;
+
+		xRequest.ulAddress = ulAddress;
+		xRequest.pxCredit = NULL;
+		xRequest.usLength = (uint16_t)ulChunk;
+		memcpy(xRequest.ucData, pucData, ulChunk);
+		xRequest.ulPostCycles = DWT->CYCCNT;
+
+		if (xQueueSendToBack(pxGatekeeper->xQueue, &xRequest, xTicksToWait) != pdPASS)
+		{
+			gatekeeper_count_drop(pxGatekeeper);
+			return -1;
+		}
+
+		if (ulAddress != GATEKEEPER_ADDRESS_STREAM)
+		{
+			ulAddress += ulChunk;
+		}
+
+		pucData += ulChunk;
+		ulLength -= ulChunk;
+
+		/* The next chunk gets whatever is left of the block time. */
+		if ((ulLength > 0U) && (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE))
+		{
+			xTicksToWait = 0;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Lends a producer a window of queue slots.
+ * @param pxGatekeeper Gatekeeper started with gatekeeper_start().
+ * @param pxCredit Credit link of the producer, initialized here.
+ * @param ulWindow Requests the producer may have waiting at once, at least 1.
+ * @retval 0 if successful, -1 if the windows lent would exceed
+ * GATEKEEPER_QUEUE_LENGTH or GATEKEEPER_PRODUCERS producers have one already.
+ * @note Call before the producer's first gatekeeper_write_credit(). The
+ * windows add up to at most the queue length, so credited posts find room as
+ * long as writers without credit leave the slots alone.
+ */
+int32_t gatekeeper_add_producer(Gatekeeper_t *pxGatekeeper, Credit_t *pxCredit,
+		uint32_t ulWindow)
+{
+	int32_t lResult = -1;
+
+	if ((pxGatekeeper == NULL) || (credit_init(pxCredit, ulWindow) != 0))
+	{
+		return -1;
+	}
+
+	/* The gatekeeper walks the producers after each wakeup. */
+	taskENTER_CRITICAL();
+	if ((pxGatekeeper->ulProducers < GATEKEEPER_PRODUCERS)
+			&& ((pxGatekeeper->ulWindows + ulWindow) <= GATEKEEPER_QUEUE_LENGTH))
+	{
+		pxGatekeeper->pxCredits[pxGatekeeper->ulProducers] = pxCredit;
+		pxGatekeeper->ulProducers++;
+		pxGatekeeper->ulWindows += ulWindow;
+		lResult = 0;
+	}
+	taskEXIT_CRITICAL();
+
+	return lResult;
+}
+
+/**
+ * @brief Posts a write from a task, spending one credit per request, without
+ * ever blocking.
+ * @param pxGatekeeper Gatekeeper started with gatekeeper_start().
+ * @param pxCredit Credit link given to gatekeeper_add_producer(). Only one
+ * task may write with it.
+ * @param ulAddress Address in the resource of the first byte, or
+ * GATEKEEPER_ADDRESS_STREAM.
+ * @param pvData Bytes to write. Copied before the call returns.
+ * @param ulLength Number of bytes. Each GATEKEEPER_REQUEST_BYTES, or part of
+ * it, takes one credit.
+ * @retval 0 if successful, -1 if the credit left was too little, in which case
+ * nothing was posted and no kernel call made, or if the queue was full anyway,
+ * which is counted as a drop.
+ * @note Check credit_available() first to skip producing the data altogether.
+ */
+int32_t gatekeeper_write_credit(Gatekeeper_t *pxGatekeeper, Credit_t *pxCredit,
+		uint32_t ulAddress, const void *pvData, uint32_t ulLength)
+{
+	const uint8_t *pucData = pvData;
+	GatekeeperRequest_t xRequest;
+	uint32_t ulRequests;
+	uint32_t ulChunk;
+
+	if ((pxGatekeeper == NULL) || (pxCredit == NULL) || ((pvData == NULL) && (ulLength != 0U)))
+	{
+		return -1;
+	}
+
+	ulRequests = (ulLength + GATEKEEPER_REQUEST_BYTES - 1U) / GATEKEEPER_REQUEST_BYTES;
+
+	if (credit_take(pxCredit, ulRequests) != 0)
+	{
+		return -1;
+	}
+
+	while (ulLength > 0U)
+	{
+		ulChunk = (ulLength < GATEKEEPER_REQUEST_BYTES) ? ulLength : GATEKEEPER_REQUEST_BYTES;
+
+		xRequest.ulAddress = ulAddress;
+		xRequest.pxCredit = pxCredit;
+		xRequest.usLength = (uint16_t)ulChunk;
+		memcpy(xRequest.ucData, pucData, ulChunk);
+		xRequest.ulPostCycles = DWT->CYCCNT;
+
+		/* Only writers without credit can have taken the slot. */
+		if (xQueueSendToBack(pxGatekeeper->xQueue, &xRequest, 0) != pdPASS)
+		{
+			credit_refund(pxCredit, ulRequests);
+			gatekeeper_count_drop(pxGatekeeper);
+			return -1;
+		}
+
+		if (ulAddress != GATEKEEPER_ADDRESS_STREAM)
+		{
+			ulAddress += ulChunk;
+		}
+
+		pucData += ulChunk;
+		ulLength -= ulChunk;
+		ulRequests--;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Posts a write from an ISR.
+ * @param pxGatekeeper Gatekeeper started with gatekeeper_start().
+ * @param ulAddress Address in the resource of the first byte, or
+ * GATEKEEPER_ADDRESS_STREAM.
+ * @param pvData Bytes to write. Copied before the call returns.
+ * @param ulLength Number of bytes, at most GATEKEEPER_REQUEST_BYTES.
+ * @param pxHigherPriorityTaskWoken Set if the gatekeeper must run on exit.
+ * @retval 0 if successful, -1 if the write is too long or the queue was full.
+ * @note Only from ISRs at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+int32_t gatekeeper_write_from_isr(Gatekeeper_t *pxGatekeeper, uint32_t ulAddress,
+		const void *pvData, uint32_t ulLength, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	GatekeeperRequest_t xRequest;
+
+	if ((pxGatekeeper == NULL) || (pvData == NULL) || (ulLength == 0U)
+			|| (ulLength > GATEKEEPER_REQUEST_BYTES))
+	{
+		return -1;
+	}
+
+	xRequest.ulAddress = ulAddress;
+	xRequest.pxCredit = NULL;
+	xRequest.usLength = (uint16_t)ulLength;
+	memcpy(xRequest.ucData, pvData, ulLength);
+	xRequest.ulPostCycles = DWT->CYCCNT;
+
+	if (xQueueSendToBackFromISR(pxGatekeeper->xQueue, &xRequest, pxHigherPriorityTaskWoken) != pdPASS)
+	{
+		gatekeeper_count_drop(pxGatekeeper);
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Copies the statistics of a gatekeeper.
+ * @param pxGatekeeper Gatekeeper.
+ * @param pxStats Receives the statistics. ulMinCycles is UINT32_MAX until
+ * the first transaction has completed.
+ * @retval 0 if successful, -1 otherwise.
+ * @note From tasks only.
+ */
+int32_t gatekeeper_get_stats(Gatekeeper_t *pxGatekeeper, GatekeeperStats_t *pxStats)
+{
+	if ((pxGatekeeper == NULL) || (pxStats == NULL))
+	{
+		return -1;
+	}
+
+	taskENTER_CRITICAL();
+	*pxStats = pxGatekeeper->xStats;
+	pxStats->ulDropped = pxGatekeeper->ulDropped;
+	taskEXIT_CRITICAL();
+
+	pxStats->ulDepth = (uint32_t)uxQueueMessagesWaiting(pxGatekeeper->xQueue);
+
+	return 0;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Blocks until at least one request is waiting, then takes up to
+ * GATEKEEPER_BATCH of them.
+ * @param pxGatekeeper Gatekeeper.
+ * @retval Number of requests in pxGatekeeper->xBatch.
+ */
+static UBaseType_t gatekeeper_receive_batch(Gatekeeper_t *pxGatekeeper)
+{
+#if (configUSE_QUEUE_BATCH == 1)
+	return (UBaseType_t)xQueueReceiveMultiple(pxGatekeeper->xQueue, pxGatekeeper->xBatch,
+			GATEKEEPER_BATCH, portMAX_DELAY);
+#else
+	UBaseType_t uxCount = 0;
+
+	if (xQueueReceive(pxGatekeeper->xQueue, &pxGatekeeper->xBatch[0], portMAX_DELAY) == pdPASS)
+	{
+		uxCount = 1;
+
+		while ((uxCount < GATEKEEPER_BATCH)
+				&& (xQueueReceive(pxGatekeeper->xQueue, &pxGatekeeper->xBatch[uxCount], 0) == pdPASS))
+		{
+			uxCount++;
+		}
+	}
+
+	return uxCount;
+#endif
+}
+
+/**
+ * @brief Checks whether a request can be appended to the current run.
+ * @param ulRunAddress Address of the run.
+ * @param ulRunLength Bytes in the run, 0 if there is none.
+ * @param pxRequest Next request.
+ * @retval 1 if it can, 0 otherwise.
+ */
+static uint32_t gatekeeper_merges(uint32_t ulRunAddress, uint32_t ulRunLength,
+		const GatekeeperRequest_t *pxRequest)
+{
+	if ((ulRunLength == 0U) || ((ulRunLength + pxRequest->usLength) > GATEKEEPER_STAGING_BYTES))
+	{
+		return 0;
+	}
+
+	if (ulRunAddress == GATEKEEPER_ADDRESS_STREAM)
+	{
+		return (pxRequest->ulAddress == GATEKEEPER_ADDRESS_STREAM) ? 1U : 0U;
+	}
+
+	return ((pxRequest->ulAddress != GATEKEEPER_ADDRESS_STREAM)
+			&& (pxRequest->ulAddress == (ulRunAddress + ulRunLength))) ? 1U : 0U;
+}
+
+/**
+ * @brief Writes the staged run in one transaction and accounts for the
+ * requests it carried.
+ * @param pxGatekeeper Gatekeeper.
+ * @param ulRunAddress Address of the run.
+ * @param ulRunLength Bytes staged.
+ * @param uxFirst Index in the batch of the first request of the run.
+ * @param uxEnd Index just past its last request.
+ * @retval None
+ */
+static void gatekeeper_flush(Gatekeeper_t *pxGatekeeper, uint32_t ulRunAddress,
+		uint32_t ulRunLength, UBaseType_t uxFirst, UBaseType_t uxEnd)
+{
+	int32_t lResult;
+	uint32_t ulDone;
+	uint32_t ulCycles;
+	UBaseType_t i;
+
+	lResult = pxGatekeeper->pxWrite(pxGatekeeper->pvContext, ulRunAddress,
+			pxGatekeeper->ucStaging, ulRunLength);
+	ulDone = DWT->CYCCNT;
+
+	/* A reader preempting the gatekeeper must not see half an update. */
+	taskENTER_CRITICAL();
+	pxGatekeeper->xStats.ulTransactions++;
+
+	if (lResult != 0)
+	{
+		pxGatekeeper->xStats.ulErrors++;
+	}
+
+	for (i = uxFirst; i < uxEnd; i++)
+	{
+		ulCycles = ulDone - pxGatekeeper->xBatch[i].ulPostCycles;
+
+		pxGatekeeper->xStats.ulRequests++;
+		pxGatekeeper->xStats.ullTotalCycles += ulCycles;
+
+		if (ulCycles < pxGatekeeper->xStats.ulMinCycles)
+		{
+			pxGatekeeper->xStats.ulMinCycles = ulCycles;
+		}
+
+		if (ulCycles > pxGatekeeper->xStats.ulMaxCycles)
+		{
+			pxGatekeeper->xStats.ulMaxCycles = ulCycles;
+		}
+
+		if (pxGatekeeper->xBatch[i].pxCredit != NULL)
+		{
+			credit_consumed(pxGatekeeper->xBatch[i].pxCredit, 1);
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Counts a refused post.
+ * @param pxGatekeeper Gatekeeper.
+ * @retval None
+ */
+static void gatekeeper_count_drop(Gatekeeper_t *pxGatekeeper)
+{
+	uint32_t ulDropped;
+
+	/* Tasks and ISRs both count here. */
+	do
+	{
+		ulDropped = __LDREXW(&pxGatekeeper->ulDropped);
+	} while (__STREXW(ulDropped + 1U, &pxGatekeeper->ulDropped) != 0U);
+}
+
+/**
+ * @brief Grants the producers the credits of the requests written so far.
+ * @param pxGatekeeper Gatekeeper.
+ * @retval None
+ * @note Small grants wait while requests do, so that a producer keeping the
+ * queue busy gets its credits back a batch at a time; once the queue is empty
+ * the gatekeeper is about to sleep and grants whatever is left.
+ */
+static void gatekeeper_grant(Gatekeeper_t *pxGatekeeper)
+{
+	const uint32_t ulBatch = (uxQueueMessagesWaiting(pxGatekeeper->xQueue) == 0U)
+			? 1U : GATEKEEPER_CREDIT_BATCH;
+	uint32_t i;
+
+	for (i = 0; i < pxGatekeeper->ulProducers; i++)
+	{
+		(void)credit_grant(pxGatekeeper->pxCredits[i], ulBatch);
+	}
+}
+
+/**
+ * @brief Drains the request queue in batches, merging adjacent requests into
+ * single transactions.
+ * @param pvParameters The gatekeeper.
+ * @retval None
+ */
+static void gatekeeper_task(void *pvParameters)
+{
+	Gatekeeper_t *pxGatekeeper = pvParameters;
+	const GatekeeperRequest_t *pxRequest;
+	UBaseType_t uxCount;
+	UBaseType_t uxFirst;
+	UBaseType_t i;
+	uint32_t ulRunAddress = 0;
+	uint32_t ulRunLength;
+	uint32_t ulDepth;
+
+	while (1)
+	{
+		uxCount = gatekeeper_receive_batch(pxGatekeeper);
+
+		if (uxCount == 0U)
+		{
+			continue;
+		}
+
+		/* Requests waiting when the gatekeeper woke, including the batch. */
+		ulDepth = (uint32_t)uxCount + (uint32_t)uxQueueMessagesWaiting(pxGatekeeper->xQueue);
+
+		taskENTER_CRITICAL();
+		if (ulDepth > pxGatekeeper->xStats.ulPeakDepth)
+		{
+			pxGatekeeper->xStats.ulPeakDepth = ulDepth;
+		}
+
+		if (uxCount > pxGatekeeper->xStats.ulPeakBatch)
+		{
+			pxGatekeeper->xStats.ulPeakBatch = uxCount;
+		}
+		taskEXIT_CRITICAL();
+
+		ulRunLength = 0;
+		uxFirst = 0;
+
+		for (i = 0; i < uxCount; i++)
+		{
+			pxRequest = &pxGatekeeper->xBatch[i];
+
+			if (gatekeeper_merges(ulRunAddress, ulRunLength, pxRequest) == 0U)
+			{
+				if (ulRunLength > 0U)
+				{
+					gatekeeper_flush(pxGatekeeper, ulRunAddress, ulRunLength, uxFirst, i);
+				}
+
+				ulRunAddress = pxRequest->ulAddress;
+				ulRunLength = 0;
+				uxFirst = i;
+			}
+
+			memcpy(&pxGatekeeper->ucStaging[ulRunLength], pxRequest->ucData, pxRequest->usLength);
+			ulRunLength += pxRequest->usLength;
+		}
+
+		if (ulRunLength > 0U)
+		{
+			gatekeeper_flush(pxGatekeeper, ulRunAddress, ulRunLength, uxFirst, uxCount);
+		}
+
+		gatekeeper_grant(pxGatekeeper);
+	}
+}
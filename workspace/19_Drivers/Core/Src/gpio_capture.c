@@ -0,0 +1,335 @@
+/*******************************************************************************
+ *
+ * @file	gpio_capture.c
+ * @brief	Implementation of the timer-triggered GPIO input capture.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Samples all 16 inputs of one port at a fixed rate, like a logic
+ * 			analyser: each TIM8 update event requests a DMA2 Stream1
+ * 			(channel 7 is TIM8_UP) transfer of GPIOx->IDR into a pair of
+ * 			buffers in double buffer mode. The consumer task is notified
+ * 			when one fills while the DMA carries on in the other, so the
+ * 			CPU runs once per block instead of once per sample.
+ *
+ * 			Only DMA2 can read GPIO: its peripheral port reaches AHB1,
+ * 			DMA1's only reaches APB1. For the same reason the buffers
+ * 			are best placed in SRAM2, away from the CPU's accesses to
+ * 			SRAM1.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clkgate.h"
+#include "gpio_capture.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define GPIO_PORT_STRIDE		0x400U
+#define TIM_CR1_CEN_OFS			0U
+#define TIM_DIER_UDE_OFS		8U
+#define DMA_SxCR_EN_OFS			0U
+#define DMA_SxCR_TEIE_OFS		2U
+#define DMA_SxCR_TCIE_OFS		4U
+#define DMA_SxCR_CIRC_OFS		8U
+#define DMA_SxCR_MINC_OFS		10U
+#define DMA_SxCR_PSIZE_OFS		11U
+#define DMA_SxCR_MSIZE_OFS		13U
+#define DMA_SxCR_PL_OFS			16U
+#define DMA_SxCR_DBM_OFS		18U
+#define DMA_SxCR_CT_OFS			19U
+#define DMA_SxCR_CHSEL_OFS		25U
+#define DMA_LISR_TEIF1_OFS		9U
+#define DMA_LISR_TCIF1_OFS		11U
+#define DMA_LIFCR_STREAM1_MASK	0xF40U	/* FEIF1, DMEIF1, TEIF1, HTIF1, TCIF1 */
+
+/* Notification values posted to the consumer task. */
+#define GPIO_CAPTURE_NOTIFY_BUF0	1U
+#define GPIO_CAPTURE_NOTIFY_BUF1	2U
+
+/* Variables -----------------------------------------------------------------*/
+static GPIO_TypeDef *pxCapturePort = NULL;
+static uint16_t *pusCaptureBuf[2] = { NULL, NULL };
+static uint16_t usCaptureBlockSize = 0;
+static uint32_t ulCaptureRequestedHz = 0;
+static uint32_t ulCaptureRateHz = 0;
+static TaskHandle_t xCaptureTask = NULL;
+static volatile uint32_t ulCaptureOverruns = 0;
+static ClkGateUser_t xPortClock;
+static ClkGateUser_t xDmaClock = CLKGATE_USER(CLKGATE_DMA2);
+static ClkGateUser_t xTimerClock = CLKGATE_USER(CLKGATE_TIM8);	/* Held while sampling. */
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t gpio_capture_timer_clock(void);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Configures timer-triggered sampling of a port into a pair of buffers.
+ * @param pxPort Port to sample (GPIOA to GPIOH). The pins keep their mode, so
+ * configure the ones of interest as inputs.
+ * @param ulSampleRateHz Samples per second, up to GPIO_CAPTURE_MAX_RATE_HZ.
+ * @param pusBuf0 First buffer of usBlockSize samples.
+ * @param pusBuf1 Second buffer of usBlockSize samples.
+ * @param usBlockSize Samples per buffer.
+ * @param xTask Task notified each time a buffer fills, normally the caller of
+ * gpio_capture_wait(). Its notification value is used by the driver.
+ * @retval 0 if successful, -1 otherwise.
+ * @note Call gpio_capture_start() to begin sampling.
+ */
+int32_t gpio_capture_init(GPIO_TypeDef *pxPort, uint32_t ulSampleRateHz, uint16_t *pusBuf0,
+		uint16_t *pusBuf1, uint16_t usBlockSize, TaskHandle_t xTask)
+{
+	if ((pxPort == NULL) || (ulSampleRateHz == 0U) || (ulSampleRateHz > GPIO_CAPTURE_MAX_RATE_HZ)
+			|| (pusBuf0 == NULL) || (pusBuf1 == NULL) || (usBlockSize == 0U) || (xTask == NULL))
+	{
+		return -1;
+	}
+
+	gpio_capture_stop();
+
+	pxCapturePort = pxPort;
+	pusCaptureBuf[0] = pusBuf0;
+	pusCaptureBuf[1] = pusBuf1;
+	usCaptureBlockSize = usBlockSize;
+	ulCaptureRequestedHz = ulSampleRateHz;
+	ulCaptureRateHz = 0;
+	xCaptureTask = xTask;
+	ulCaptureOverruns = 0;
+
+	/* Hold the port's clock; DMA2 and TIM8 only to configure them. */
+	clkgate_release(&xPortClock);
+	clkgate_user_init(&xPortClock,
+			(ClkGate_t)(CLKGATE_GPIOA + (((uint32_t)pxPort - GPIOA_BASE) / GPIO_PORT_STRIDE)));
+	clkgate_acquire(&xPortClock);
+	clkgate_acquire(&xDmaClock);
+	clkgate_acquire(&xTimerClock);
+
+	/* Free-running up-counter; only its update event is used. */
+	TIM8->CR1 = 0;
+	TIM8->CR2 = 0;
+	TIM8->PSC = 0;
+
+	NVIC_SetPriority(DMA2_Stream1_IRQn, GPIO_CAPTURE_IRQ_PRIORITY);
+	NVIC_EnableIRQ(DMA2_Stream1_IRQn);
+
+	/* Gated until gpio_capture_start(); the registers keep their values. */
+	clkgate_release(&xTimerClock);
+	clkgate_release(&xDmaClock);
+
+	return 0;
+}
+
+/**
+ * @brief Starts (or restarts) sampling from the first buffer.
+ * @param None
+ * @retval 0 if successful, -1 if gpio_capture_init() was not called or the
+ * sample rate is out of reach.
+ * @note The timer period is computed from the current bus clock, so call this
+ * again after changing the clock profile.
+ */
+int32_t gpio_capture_start(void)
+{
+	uint32_t ulClock;
+	uint32_t ulPeriod;
+
+	if (xCaptureTask == NULL)
+	{
+		return -1;
+	}
+
+	ulClock = gpio_capture_timer_clock();
+	ulPeriod = (ulClock + (ulCaptureRequestedHz / 2U)) / ulCaptureRequestedHz;
+
+	if ((ulPeriod < 2U) || (ulPeriod > 0x10000U))
+	{
+		return -1;
+	}
+
+	gpio_capture_stop();
+	clkgate_acquire(&xDmaClock);
+	clkgate_acquire(&xTimerClock);
+
+	DMA2_Stream1->PAR = (uint32_t)&pxCapturePort->IDR;
+	DMA2_Stream1->M0AR = (uint32_t)pusCaptureBuf[0];
+	DMA2_Stream1->M1AR = (uint32_t)pusCaptureBuf[1];
+	DMA2_Stream1->NDTR = usCaptureBlockSize;
+	DMA2_Stream1->CR = (7U << DMA_SxCR_CHSEL_OFS)		/* Channel 7. */
+			| (1U << DMA_SxCR_DBM_OFS)					/* Double buffer. */
+			| (3U << DMA_SxCR_PL_OFS)					/* Very high: a late sample is a wrong one. */
+			| (1U << DMA_SxCR_MSIZE_OFS)				/* 16-bit memory. */
+			| (1U << DMA_SxCR_PSIZE_OFS)				/* 16-bit peripheral. */
+			| (1U << DMA_SxCR_MINC_OFS)					/* Increment memory. */
+			| (1U << DMA_SxCR_CIRC_OFS)					/* Required by DBM. */
+			| (1U << DMA_SxCR_TCIE_OFS)					/* Buffer full. */
+			| (1U << DMA_SxCR_TEIE_OFS);				/* Transfer error. */
+	DMA2_Stream1->FCR = 0;	/* Direct mode. */
+	DMA2_Stream1->CR |= (1U << DMA_SxCR_EN_OFS);
+
+	ulCaptureRateHz = ulClock / ulPeriod;
+
+	/* A request per update event, from a clean count. */
+	TIM8->ARR = ulPeriod - 1U;
+	TIM8->CNT = 0;
+	TIM8->SR = 0;
+	TIM8->DIER |= (1U << TIM_DIER_UDE_OFS);
+	TIM8->CR1 |= (1U << TIM_CR1_CEN_OFS);
+
+	return 0;
+}
+
+/**
+ * @brief Stops the sampling timer and the DMA stream, and gates their clocks
+ * off.
+ * @param None
+ * @retval None
+ */
+void gpio_capture_stop(void)
+{
+	if (xTimerClock.ucHeld == 0U)
+	{
+		return;
+	}
+
+	TIM8->CR1 &= ~(1U << TIM_CR1_CEN_OFS);
+	TIM8->DIER &= ~(1U << TIM_DIER_UDE_OFS);
+
+	/* Disable the stream and wait until it is really off. */
+	DMA2_Stream1->CR &= ~(1U << DMA_SxCR_EN_OFS);
+	while (DMA2_Stream1->CR & (1U << DMA_SxCR_EN_OFS)){}
+
+	DMA2->LIFCR = DMA_LIFCR_STREAM1_MASK;
+
+	clkgate_release(&xTimerClock);
+	clkgate_release(&xDmaClock);
+}
+
+/**
+ * @brief Blocks until a buffer is full.
+ * @param xTicksToWait Maximum time to wait.
+ * @retval The full buffer (usBlockSize samples of the port's IDR), or NULL on
+ * timeout. It stays valid until the DMA comes back to it, one block period
+ * later.
+ */
+uint16_t *gpio_capture_wait(TickType_t xTicksToWait)
+{
+	uint32_t ulValue;
+
+	if (xTaskNotifyWait(0, GPIO_CAPTURE_NOTIFY_BUF0 | GPIO_CAPTURE_NOTIFY_BUF1,
+			&ulValue, xTicksToWait) != pdTRUE)
+	{
+		return NULL;
+	}
+
+	return (ulValue & GPIO_CAPTURE_NOTIFY_BUF1) ? pusCaptureBuf[1] : pusCaptureBuf[0];
+}
+
+/**
+ * @brief Returns the sample rate actually in use.
+ * @param None
+ * @retval The timer clock divided by the rounded period, or 0 before
+ * gpio_capture_start().
+ */
+uint32_t gpio_capture_get_rate(void)
+{
+	return ulCaptureRateHz;
+}
+
+/**
+ * @brief Returns the number of blocks the consumer did not pick up in time.
+ * @param None
+ * @retval Missed blocks (and DMA transfer errors) since gpio_capture_init().
+ */
+uint32_t gpio_capture_get_overruns(void)
+{
+	return ulCaptureOverruns;
+}
+
+/**
+ * @brief Counts the transitions of some pins over a block of samples.
+ * @param pusBlock Samples, as returned by gpio_capture_wait().
+ * @param ulCount Number of samples.
+ * @param usMask Pins to watch (bit n is pin n).
+ * @param pusPrevious In: the sample before the block. Out: its last sample,
+ * for the next call.
+ * @retval Rising and falling edges, summed over the pins of usMask.
+ */
+uint32_t gpio_capture_count_edges(const uint16_t *pusBlock, uint32_t ulCount, uint16_t usMask,
+		uint16_t *pusPrevious)
+{
+	uint32_t ulPrevious = *pusPrevious;
+	uint32_t ulEdges = 0;
+	uint32_t ulChanged;
+	uint32_t i;
+
+	for (i = 0; i < ulCount; i++)
+	{
+		ulChanged = (pusBlock[i] ^ ulPrevious) & usMask;
+		ulPrevious = pusBlock[i];
+
+		if (ulChanged != 0U)
+		{
+			ulEdges += (uint32_t)__builtin_popcount(ulChanged);
+		}
+	}
+
+	*pusPrevious = (uint16_t)ulPrevious;
+
+	return ulEdges;
+}
+
+/**
+ * @brief DMA2 Stream1 IRQ handler (TIM8 update, GPIO capture buffer full).
+ * @note CT already points at the buffer the DMA moved on to, so the full one
+ * is the other. A block the consumer has not yet taken is counted as an
+ * overrun rather than overwriting its notification.
+ * @param None
+ * @retval None
+ */
+void DMA2_Stream1_IRQHandler(void)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	const uint32_t ulStatus = DMA2->LISR;
+	uint32_t ulFull;
+
+	DMA2->LIFCR = DMA_LIFCR_STREAM1_MASK;
+
+	if (ulStatus & (1U << DMA_LISR_TEIF1_OFS))
+	{
+		ulCaptureOverruns++;
+	}
+
+	if (ulStatus & (1U << DMA_LISR_TCIF1_OFS))
+	{
+		ulFull = (DMA2_Stream1->CR & (1U << DMA_SxCR_CT_OFS)) ?
+				GPIO_CAPTURE_NOTIFY_BUF0 : GPIO_CAPTURE_NOTIFY_BUF1;
+
+		if (xTaskNotifyFromISR(xCaptureTask, ulFull, eSetValueWithoutOverwrite,
+				&xHigherPriorityTaskWoken) != pdPASS)
+		{
+			ulCaptureOverruns++;
+		}
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Returns the TIM8 kernel clock.
+ * @param None
+ * @retval PCLK2, doubled when APB2 is divided.
+ */
+static uint32_t gpio_capture_timer_clock(void)
+{
+	uint32_t ulClock = HAL_RCC_GetPCLK2Freq();
+
+	if ((RCC->CFGR & RCC_CFGR_PPRE2) != RCC_CFGR_PPRE2_DIV1)
+	{
+		ulClock *= 2U;
+	}
+
+	return ulClock;
+}
@@ -0,0 +1,804 @@
+/*******************************************************************************
+ *
+ * @file	i2c.c
+ * @brief	Implementation of the I2C master driver.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	One driver for I2C1 to I2C3, table driven like uart.c, without
+ * 			the HAL I2C module. Nothing blocks: a transaction (I2cXfer_t,
+ * 			an xfer.h request) is a chain of interrupts, and its data phases
+ * 			are DMA descriptors on the bus's two streams from dma.c.
+ * 			- Event interrupt: START sent (SB), then the address (ADDR), then
+ * 			  the last byte written (BTF), which leads to a repeated START
+ * 			  for the read phase or to STOP.
+ * 			- RX DMA completion: the read phase is over (LAST makes the DMA
+ * 			  NACK the final byte), STOP follows.
+ * 			- Error interrupt: NACK, bus error or lost arbitration.
+ * 			A single-byte read is left to the RXNE interrupt, as the
+ * 			peripheral requires.
+ *
+ * 			Transactions queue per bus and each one starts from the
+ * 			interrupt that ends the one before, so a batch of register
+ * 			reads on several slow devices needs no task until its last one
+ * 			completes: i2c_submit_batch() queues them under one critical
+ * 			section, and only the last needs a completion signal.
+ *
+ * 			Bus recovery: a slave reset in the middle of a byte may hold
+ * 			SDA low for good, and the peripheral then sees a busy bus. A
+ * 			bus found busy before a START, a bus error or lost arbitration,
+ * 			and a transaction outliving its hrtimer watchdog all lead to
+ * 			the same recovery: SCL is clocked as a GPIO until SDA is
+ * 			released (9 clocks at most), a STOP is driven, and the
+ * 			peripheral is reset and set up again. It busy-waits about
+ * 			100 us at 100 kHz, in the event interrupt.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clkgate.h"
+#include "xfer.h"
+#include "dma.h"
+#include "hrtimer.h"
+#include "i2c.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define I2C_PHASE_WRITE			0U
+#define I2C_PHASE_READ			1U
+#define I2C_STOP_TIMEOUT		1000U	/* Busy-wait iterations for a STOP to go out. */
+#define I2C_RECOVERY_CLOCKS		9U
+#define I2C_SR1_ERRORS			(I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_AF | I2C_SR1_OVR \
+		| I2C_SR1_TIMEOUT)
+#define GPIO_PORT_STRIDE		0x400U
+#define PIN_MODE_OUTPUT			1U
+#define PIN_MODE_AF				2U
+#define PIN_SPEED_FAST			2U
+#define PIN_PULL_UP				1U
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	I2C_TypeDef *pxI2c;
+	uint8_t ucClock;				/* ClkGate_t of the I2C. */
+	uint8_t ucAf;
+	GPIO_TypeDef *pxSclPort;
+	uint8_t ucSclPin;
+	GPIO_TypeDef *pxSdaPort;
+	uint8_t ucSdaPin;
+	IRQn_Type xEvIrq;
+	IRQn_Type xErIrq;
+	uint8_t ucRxRequest;			/* DmaRequest_t */
+	uint8_t ucTxRequest;
+	uint8_t ucEnabled;				/* I2C_USE_xxx */
+} I2cHw_t;
+
+typedef struct
+{
+	uint8_t ucOpen;
+	uint8_t ucPhase;				/* Of the transaction at the head. */
+	uint8_t ucAborting;				/* Failing it: ignore its descriptors. */
+	volatile uint8_t ucTimedOut;	/* Set by the watchdog. */
+	volatile uint8_t ucStuck;		/* Busy bus found by i2c_start(). */
+	uint32_t ulSpeedHz;
+	DmaStream_t *pxRxStream;
+	DmaStream_t *pxTxStream;
+	XferQueue_t xQueue;				/* Head: the transaction on the bus. */
+	HrTimer_t xWatchdog;
+	I2cStats_t xStats;
+	ClkGateUser_t xI2cClock;
+	ClkGateUser_t xSclClock;
+	ClkGateUser_t xSdaClock;
+} I2cState_t;
+
+/* Variables -----------------------------------------------------------------*/
+static const I2cHw_t xI2cHw[I2C_BUSES] =
+{
+	{ I2C1, CLKGATE_I2C1, 4, GPIOB, 6, GPIOB, 7, I2C1_EV_IRQn, I2C1_ER_IRQn,
+			DMA_REQ_I2C1_RX, DMA_REQ_I2C1_TX, I2C_USE_I2C1 },
+	{ I2C2, CLKGATE_I2C2, 4, GPIOB, 10, GPIOC, 12, I2C2_EV_IRQn, I2C2_ER_IRQn,
+			DMA_REQ_I2C2_RX, DMA_REQ_I2C2_TX, I2C_USE_I2C2 },
+	{ I2C3, CLKGATE_I2C3, 4, GPIOA, 8, GPIOC, 9, I2C3_EV_IRQn, I2C3_ER_IRQn,
+			DMA_REQ_I2C3_RX, DMA_REQ_I2C3_TX, I2C_USE_I2C3 }
+};
+
+static I2cState_t xI2cState[I2C_BUSES];
+
+/* Private function prototypes -----------------------------------------------*/
+static ClkGate_t i2c_port_clock(const GPIO_TypeDef *pxPort);
+static void i2c_pin_mode(GPIO_TypeDef *pxPort, uint8_t ucPin, uint8_t ucMode, uint8_t ucAf);
+static int32_t i2c_configure(I2cBus_t xBus);
+static void i2c_spin_us(uint32_t ulUs);
+static void i2c_recover(I2cBus_t xBus);
+static void i2c_start(I2cBus_t xBus);
+static void i2c_finish(I2cBus_t xBus, int32_t lResult, BaseType_t *pxHigherPriorityTaskWoken);
+static void i2c_fail(I2cBus_t xBus, BaseType_t xRecover, BaseType_t *pxHigherPriorityTaskWoken);
+static void i2c_rx_done(XferReq_t *pxReq, BaseType_t *pxHigherPriorityTaskWoken);
+static void i2c_watchdog(HrTimer_t *pxTimer, void *pvArg);
+static void i2c_ev_irq(I2cBus_t xBus);
+static void i2c_er_irq(I2cBus_t xBus);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Opens a bus as master and allocates its DMA streams.
+ * @param xBus Bus, compiled in with its I2C_USE_xxx.
+ * @param ulSpeedHz SCL frequency, up to 400000.
+ * @retval 0 if successful, -1 if the bus is not compiled in or already open,
+ * the speed or PCLK1 is out of range, or dma_alloc() found no stream for it.
+ * @note hrtimer_init() must have been called. Call from a task or before the
+ * scheduler starts.
+ */
+int32_t i2c_open(I2cBus_t xBus, uint32_t ulSpeedHz)
+{
+	const I2cHw_t *pxHw;
+	I2cState_t *pxState;
+	DmaConfig_t xCfg;
+
+	if ((xBus >= I2C_BUSES) || (xI2cHw[xBus].ucEnabled == 0U) || (xI2cState[xBus].ucOpen != 0U)
+			|| (ulSpeedHz == 0U) || (ulSpeedHz > 400000U))
+	{
+		return -1;
+	}
+
+	pxHw = &xI2cHw[xBus];
+	pxState = &xI2cState[xBus];
+
+	xCfg.xRequest = (DmaRequest_t)pxHw->ucTxRequest;
+	xCfg.xDir = DMA_DIR_M2P;
+	xCfg.ucPriority = I2C_DMA_PRIORITY;
+	xCfg.ucItemSize = 1U;
+	xCfg.ucPeriphInc = 0U;
+	xCfg.ucMemInc = 1U;
+	xCfg.pvPeriph = &pxHw->pxI2c->DR;
+	xCfg.ulBandwidth = ulSpeedHz / 9U;
+
+	if (dma_alloc(&xCfg, &pxState->pxTxStream) != 0)
+	{
+		return -1;
+	}
+
+	xCfg.xRequest = (DmaRequest_t)pxHw->ucRxRequest;
+	xCfg.xDir = DMA_DIR_P2M;
+
+	if (dma_alloc(&xCfg, &pxState->pxRxStream) != 0)
+	{
+		dma_free(pxState->pxTxStream);
+		return -1;
+	}
+
+	clkgate_user_init(&pxState->xI2cClock, (ClkGate_t)pxHw->ucClock);
+	clkgate_user_init(&pxState->xSclClock, i2c_port_clock(pxHw->pxSclPort));
+	clkgate_user_init(&pxState->xSdaClock, i2c_port_clock(pxHw->pxSdaPort));
+	clkgate_acquire(&pxState->xI2cClock);
+	clkgate_acquire(&pxState->xSclClock);
+	clkgate_acquire(&pxState->xSdaClock);
+
+	pxState->ulSpeedHz = ulSpeedHz;
+	pxState->xQueue.pxHead = NULL;
+	pxState->xQueue.pxTail = NULL;
+	memset(&pxState->xStats, 0, sizeof(pxState->xStats));
+	hrtimer_setup(&pxState->xWatchdog, i2c_watchdog, (void *)(uint32_t)xBus);
+
+	/* Open drain, pulled up: the internal pull-ups only help short buses. */
+	i2c_pin_mode(pxHw->pxSclPort, pxHw->ucSclPin, PIN_MODE_AF, pxHw->ucAf);
+	i2c_pin_mode(pxHw->pxSdaPort, pxHw->ucSdaPin, PIN_MODE_AF, pxHw->ucAf);
+
+	if (i2c_configure(xBus) != 0)
+	{
+		clkgate_release(&pxState->xI2cClock);
+		clkgate_release(&pxState->xSclClock);
+		clkgate_release(&pxState->xSdaClock);
+		dma_free(pxState->pxRxStream);
+		dma_free(pxState->pxTxStream);
+		return -1;
+	}
+
+	NVIC_SetPriority(pxHw->xEvIrq, I2C_IRQ_PRIORITY);
+	NVIC_SetPriority(pxHw->xErIrq, I2C_IRQ_PRIORITY);
+	NVIC_EnableIRQ(pxHw->xEvIrq);
+	NVIC_EnableIRQ(pxHw->xErIrq);
+
+	pxState->ucOpen = 1;
+
+	return 0;
+}
+
+/**
+ * @brief Prepares a transaction, with no completion signal.
+ * @param pxXfer Transaction, not submitted.
+ * @param xBus Bus.
+ * @param ucAddr 7-bit address of the device.
+ * @param pvTx usTxLen bytes written first, e.g. a register address.
+ * @param usTxLen Bytes to write, 0 for a read only.
+ * @param pvRx Receives ulRxLen bytes, read after a repeated START.
+ * @param ulRxLen Bytes to read, 0 for a write only, up to DMA_MAX_ITEMS.
+ * @retval None
+ * @note Choose the signal with xfer_on_...(&pxXfer->xReq, ...). With neither
+ * bytes to write nor to read, the address alone is sent: a probe.
+ */
+void i2c_xfer_init(I2cXfer_t *pxXfer, I2cBus_t xBus, uint8_t ucAddr, const void *pvTx,
+		uint16_t usTxLen, void *pvRx, uint32_t ulRxLen)
+{
+	xfer_init(&pxXfer->xReq, pvRx, ulRxLen);
+	pxXfer->pucTx = (const uint8_t *)pvTx;
+	pxXfer->usTxLen = usTxLen;
+	pxXfer->ucBus = (uint8_t)xBus;
+	pxXfer->ucAddr = ucAddr;
+}
+
+/**
+ * @brief Queues a transaction on its bus.
+ * @param pxXfer Transaction from i2c_xfer_init().
+ * @retval 0 if queued, -1 if it is invalid or its bus is not open.
+ * @note The buffers belong to the driver until it completes. May be called
+ * from an ISR, e.g. a completion callback.
+ */
+int32_t i2c_submit(I2cXfer_t *pxXfer)
+{
+	return i2c_submit_batch(pxXfer, 1U);
+}
+
+/**
+ * @brief Queues transactions to run back to back.
+ * @param pxXfers Transactions from i2c_xfer_init(), on the same bus.
+ * @param ulCount Number of transactions.
+ * @retval 0 if queued, -1 if one is invalid or the bus is not open; none is
+ * queued then.
+ * @note No other transaction comes between them. Each completes on its own,
+ * so only the last usually needs a signal. May be called from an ISR.
+ */
+int32_t i2c_submit_batch(I2cXfer_t *pxXfers, uint32_t ulCount)
+{
+	I2cState_t *pxState;
+	UBaseType_t uxSavedInterruptStatus;
+	BaseType_t xIdle = pdFALSE;
+	uint32_t x;
+
+	if ((pxXfers == NULL) || (ulCount == 0U) || (pxXfers[0].ucBus >= I2C_BUSES)
+			|| (xI2cState[pxXfers[0].ucBus].ucOpen == 0U))
+	{
+		return -1;
+	}
+
+	for (x = 0; x < ulCount; x++)
+	{
+		if ((pxXfers[x].ucBus != pxXfers[0].ucBus) || (pxXfers[x].ucAddr > 0x7FU)
+				|| (pxXfers[x].xReq.ulLen > DMA_MAX_ITEMS)
+				|| ((pxXfers[x].usTxLen != 0U) && (pxXfers[x].pucTx == NULL)))
+		{
+			return -1;
+		}
+	}
+
+	pxState = &xI2cState[pxXfers[0].ucBus];
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+	for (x = 0; x < ulCount; x++)
+	{
+		if (xfer_queue_push(&pxState->xQueue, &pxXfers[x].xReq))
+		{
+			xIdle = pdTRUE;
+		}
+	}
+
+	if (xIdle != pdFALSE)
+	{
+		i2c_start((I2cBus_t)pxXfers[0].ucBus);
+	}
+
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	return 0;
+}
+
+/**
+ * @brief Runs a transaction and waits for it.
+ * @param xBus Open bus.
+ * @param ucAddr 7-bit address of the device.
+ * @param pvTx usTxLen bytes written first.
+ * @param usTxLen Bytes to write, 0 for a read only.
+ * @param pvRx Receives ulRxLen bytes.
+ * @param ulRxLen Bytes to read, 0 for a write only.
+ * @retval ulRxLen if successful, -1 otherwise.
+ * @note Call from a task. It blocks on notification XFER_NOTIFY_INDEX, and the
+ * CPU runs other tasks meanwhile.
+ */
+int32_t i2c_transfer(I2cBus_t xBus, uint8_t ucAddr, const void *pvTx, uint16_t usTxLen,
+		void *pvRx, uint32_t ulRxLen)
+{
+	I2cXfer_t xXfer;
+
+	i2c_xfer_init(&xXfer, xBus, ucAddr, pvTx, usTxLen, pvRx, ulRxLen);
+	xfer_on_task(&xXfer.xReq, NULL);
+
+	if (i2c_submit(&xXfer) != 0)
+	{
+		return -1;
+	}
+
+	return xfer_wait(&xXfer.xReq, portMAX_DELAY);
+}
+
+/**
+ * @brief Reads the counters of a bus.
+ * @param xBus Open bus.
+ * @param pxStats Receives the counters.
+ * @retval 0 if successful, -1 if the bus is not open.
+ */
+int32_t i2c_get_stats(I2cBus_t xBus, I2cStats_t *pxStats)
+{
+	UBaseType_t uxSavedInterruptStatus;
+
+	if ((xBus >= I2C_BUSES) || (xI2cState[xBus].ucOpen == 0U))
+	{
+		return -1;
+	}
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	*pxStats = xI2cState[xBus].xStats;
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	return 0;
+}
+
+/* Interrupt handlers, one line each: the bus table does the rest. */
+#if (I2C_USE_I2C1 == 1)
+void I2C1_EV_IRQHandler(void) { i2c_ev_irq(I2C_BUS_1); }
+void I2C1_ER_IRQHandler(void) { i2c_er_irq(I2C_BUS_1); }
+#endif
+
+#if (I2C_USE_I2C2 == 1)
+void I2C2_EV_IRQHandler(void) { i2c_ev_irq(I2C_BUS_2); }
+void I2C2_ER_IRQHandler(void) { i2c_er_irq(I2C_BUS_2); }
+#endif
+
+#if (I2C_USE_I2C3 == 1)
+void I2C3_EV_IRQHandler(void) { i2c_ev_irq(I2C_BUS_3); }
+void I2C3_ER_IRQHandler(void) { i2c_er_irq(I2C_BUS_3); }
+#endif
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Returns the clock gate of a GPIO port.
+ * @param pxPort GPIO port.
+ * @retval CLKGATE_GPIOA to CLKGATE_GPIOH.
+ */
+static ClkGate_t i2c_port_clock(const GPIO_TypeDef *pxPort)
+{
+	return (ClkGate_t)(CLKGATE_GPIOA + (((uint32_t)pxPort - GPIOA_BASE) / GPIO_PORT_STRIDE));
+}
+
+/**
+ * @brief Configures a bus pin, open drain with a pull-up.
+ * @param pxPort GPIO port (clock enabled).
+ * @param ucPin Pin number, 0 to 15.
+ * @param ucMode PIN_MODE_AF, or PIN_MODE_OUTPUT for the recovery.
+ * @param ucAf Alternate function, for PIN_MODE_AF.
+ * @retval None
+ */
+static void i2c_pin_mode(GPIO_TypeDef *pxPort, uint8_t ucPin, uint8_t ucMode, uint8_t ucAf)
+{
+	uint32_t ulShift2 = 2U * ucPin;
+	uint32_t ulShift4 = 4U * (ucPin & 7U);
+
+	pxPort->BSRR = 1U << ucPin;
+	pxPort->AFR[ucPin >> 3] = (pxPort->AFR[ucPin >> 3] & ~(0xFU << ulShift4))
+			| ((uint32_t)ucAf << ulShift4);
+	pxPort->OTYPER |= (1U << ucPin);
+	pxPort->OSPEEDR = (pxPort->OSPEEDR & ~(3U << ulShift2)) | (PIN_SPEED_FAST << ulShift2);
+	pxPort->PUPDR = (pxPort->PUPDR & ~(3U << ulShift2)) | (PIN_PULL_UP << ulShift2);
+	pxPort->MODER = (pxPort->MODER & ~(3U << ulShift2)) | ((uint32_t)ucMode << ulShift2);
+}
+
+/**
+ * @brief Resets the peripheral and sets its timing for PCLK1.
+ * @param xBus Bus.
+ * @retval 0 if successful, -1 if PCLK1 is out of the 2 to 50 MHz range.
+ * @note Standard mode up to 100 kHz, fast mode with a 2:1 duty cycle above.
+ */
+static int32_t i2c_configure(I2cBus_t xBus)
+{
+	I2C_TypeDef *pxI2c = xI2cHw[xBus].pxI2c;
+	const uint32_t ulPclk = HAL_RCC_GetPCLK1Freq();
+	const uint32_t ulMhz = ulPclk / 1000000U;
+	const uint32_t ulSpeed = xI2cState[xBus].ulSpeedHz;
+	uint32_t ulCcr;
+	uint32_t ulTrise;
+
+	if ((ulMhz < 2U) || (ulMhz > 50U))
+	{
+		return -1;
+	}
+
+	if (ulSpeed <= 100000U)
+	{
+		/* Rounded up: never faster than asked. Rise time 1000 ns. */
+		ulCcr = (ulPclk + (2U * ulSpeed) - 1U) / (2U * ulSpeed);
+		ulCcr = (ulCcr < 4U) ? 4U : ulCcr;
+		ulTrise = ulMhz + 1U;
+	}
+	else
+	{
+		/* Rise time 300 ns. */
+		ulCcr = (ulPclk + (3U * ulSpeed) - 1U) / (3U * ulSpeed);
+		ulCcr = ((ulCcr < 1U) ? 1U : ulCcr) | I2C_CCR_FS;
+		ulTrise = ((ulMhz * 300U) / 1000U) + 1U;
+	}
+
+	pxI2c->CR1 = I2C_CR1_SWRST;
+	pxI2c->CR1 = 0;
+	pxI2c->CR2 = ulMhz;
+	pxI2c->CCR = ulCcr;
+	pxI2c->TRISE = ulTrise;
+	pxI2c->CR1 = I2C_CR1_PE;
+
+	return 0;
+}
+
+/**
+ * @brief Busy-waits on the hrtimer.c clock.
+ * @param ulUs Microseconds.
+ * @retval None
+ */
+static void i2c_spin_us(uint32_t ulUs)
+{
+	const uint32_t ulStart = hrtimer_now();
+
+	while ((hrtimer_now() - ulStart) < ulUs)
+	{
+	}
+}
+
+/**
+ * @brief Frees a bus held by a slave and resets the peripheral.
+ * @param xBus Bus.
+ * @retval None
+ * @note A slave stuck in a read drives SDA until it has clocked its byte out:
+ * up to 9 SCL pulses release it, then a STOP resets every slave.
+ */
+static void i2c_recover(I2cBus_t xBus)
+{
+	const I2cHw_t *pxHw = &xI2cHw[xBus];
+	const uint32_t ulHalfUs = (500000U / xI2cState[xBus].ulSpeedHz) + 1U;
+	uint32_t x;
+
+	pxHw->pxI2c->CR1 = 0;
+
+	i2c_pin_mode(pxHw->pxSclPort, pxHw->ucSclPin, PIN_MODE_OUTPUT, 0U);
+	i2c_pin_mode(pxHw->pxSdaPort, pxHw->ucSdaPin, PIN_MODE_OUTPUT, 0U);
+
+	for (x = 0; (x < I2C_RECOVERY_CLOCKS) && ((pxHw->pxSdaPort->IDR & (1U << pxHw->ucSdaPin)) == 0U);
+			x++)
+	{
+		pxHw->pxSclPort->BSRR = 1U << (pxHw->ucSclPin + 16U);
+		i2c_spin_us(ulHalfUs);
+		pxHw->pxSclPort->BSRR = 1U << pxHw->ucSclPin;
+		i2c_spin_us(ulHalfUs);
+	}
+
+	/* STOP: SDA rises while SCL is high. */
+	pxHw->pxSdaPort->BSRR = 1U << (pxHw->ucSdaPin + 16U);
+	i2c_spin_us(ulHalfUs);
+	pxHw->pxSdaPort->BSRR = 1U << pxHw->ucSdaPin;
+	i2c_spin_us(ulHalfUs);
+
+	i2c_pin_mode(pxHw->pxSclPort, pxHw->ucSclPin, PIN_MODE_AF, pxHw->ucAf);
+	i2c_pin_mode(pxHw->pxSdaPort, pxHw->ucSdaPin, PIN_MODE_AF, pxHw->ucAf);
+
+	(void)i2c_configure(xBus);
+	xI2cState[xBus].xStats.ulRecoveries++;
+}
+
+/**
+ * @brief Starts the transaction at the head of a bus's queue.
+ * @param xBus Bus, in a critical section.
+ * @retval None
+ */
+static void i2c_start(I2cBus_t xBus)
+{
+	const I2cHw_t *pxHw = &xI2cHw[xBus];
+	I2cState_t *pxState = &xI2cState[xBus];
+	const I2cXfer_t *pxXfer = (const I2cXfer_t *)pxState->xQueue.pxHead;
+	I2C_TypeDef *pxI2c = pxHw->pxI2c;
+	uint32_t ulBits;
+	uint32_t ulTimeout = I2C_STOP_TIMEOUT;
+
+	pxState->ucPhase = ((pxXfer->usTxLen != 0U) || (pxXfer->xReq.ulLen == 0U))
+			? I2C_PHASE_WRITE : I2C_PHASE_READ;
+	pxState->ucAborting = 0;
+	pxState->ucTimedOut = 0;
+
+	/* Address, data and ACK bits, twice over for a slow or stretching slave. */
+	ulBits = 9U * (2U + pxXfer->usTxLen + pxXfer->xReq.ulLen);
+	(void)hrtimer_start(&pxState->xWatchdog,
+			I2C_TIMEOUT_US + (uint32_t)(((uint64_t)ulBits * 2000000U) / pxState->ulSpeedHz), 0U);
+
+	/* The STOP of the transaction before must be out first. */
+	while (((pxI2c->CR1 & I2C_CR1_STOP) != 0U) && (--ulTimeout != 0U))
+	{
+	}
+
+	pxI2c->CR2 |= I2C_CR2_ITEVTEN | I2C_CR2_ITERREN;
+
+	if ((pxI2c->SR2 & I2C_SR2_BUSY) != 0U)
+	{
+		/* Held by a slave: recovered in the event interrupt, which
+		 * starts the transaction after. */
+		pxState->ucStuck = 1;
+		NVIC_SetPendingIRQ(pxHw->xEvIrq);
+		return;
+	}
+
+	pxI2c->CR1 |= I2C_CR1_START;
+}
+
+/**
+ * @brief Ends the transaction at the head of a bus's queue.
+ * @param xBus Bus.
+ * @param lResult Its result.
+ * @param pxHigherPriorityTaskWoken Set if a task woken must run on exit.
+ * @retval None
+ * @note Starts the next one before signalling this one.
+ */
+static void i2c_finish(I2cBus_t xBus, int32_t lResult, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	I2cState_t *pxState = &xI2cState[xBus];
+	I2C_TypeDef *pxI2c = xI2cHw[xBus].pxI2c;
+	UBaseType_t uxSavedInterruptStatus;
+	I2cXfer_t *pxXfer;
+
+	hrtimer_stop(&pxState->xWatchdog);
+	pxI2c->CR2 &= ~(I2C_CR2_ITEVTEN | I2C_CR2_ITBUFEN | I2C_CR2_DMAEN | I2C_CR2_LAST);
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+	pxXfer = (I2cXfer_t *)xfer_queue_pop(&pxState->xQueue);
+
+	if (lResult != XFER_ERROR)
+	{
+		pxState->xStats.ulXfers++;
+		pxState->xStats.ulBytes += pxXfer->usTxLen + pxXfer->xReq.ulLen;
+	}
+
+	if (pxState->xQueue.pxHead != NULL)
+	{
+		i2c_start(xBus);
+	}
+
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	xfer_complete_from_isr(&pxXfer->xReq, lResult, pxHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Fails the transaction at the head of a bus's queue.
+ * @param xBus Bus.
+ * @param xRecover pdTRUE to recover the bus, pdFALSE to just send a STOP.
+ * @param pxHigherPriorityTaskWoken Set if a task woken must run on exit.
+ * @retval None
+ */
+static void i2c_fail(I2cBus_t xBus, BaseType_t xRecover, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	I2cState_t *pxState = &xI2cState[xBus];
+	I2C_TypeDef *pxI2c = xI2cHw[xBus].pxI2c;
+
+	pxI2c->CR2 &= ~(I2C_CR2_DMAEN | I2C_CR2_LAST);
+
+	/* Its descriptors complete with XFER_ERROR, and are ignored. */
+	pxState->ucAborting = 1;
+	dma_abort(pxState->pxTxStream);
+	dma_abort(pxState->pxRxStream);
+
+	if (xRecover != pdFALSE)
+	{
+		i2c_recover(xBus);
+	}
+	else
+	{
+		pxI2c->CR1 |= I2C_CR1_STOP;
+	}
+
+	i2c_finish(xBus, XFER_ERROR, pxHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Ends the read phase: its RX descriptor has completed.
+ * @param pxReq RX descriptor's request.
+ * @param pxHigherPriorityTaskWoken Set if a task woken must run on exit.
+ * @retval None
+ * @note Runs in the RX stream's interrupt. The DMA has NACKed the last byte.
+ */
+static void i2c_rx_done(XferReq_t *pxReq, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	const I2cBus_t xBus = (I2cBus_t)((I2cXfer_t *)pxReq->pvContext)->ucBus;
+	I2C_TypeDef *pxI2c = xI2cHw[xBus].pxI2c;
+
+	if (xI2cState[xBus].ucAborting != 0U)
+	{
+		return;
+	}
+
+	if (pxReq->lResult == XFER_ERROR)
+	{
+		i2c_fail(xBus, pdTRUE, pxHigherPriorityTaskWoken);
+		return;
+	}
+
+	pxI2c->CR1 |= I2C_CR1_STOP;
+	i2c_finish(xBus, (int32_t)pxReq->ulLen, pxHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Hrtimer callback: a transaction has taken too long.
+ * @param pxTimer Watchdog.
+ * @param pvArg Bus.
+ * @retval None
+ * @note Runs in the TIM5 interrupt, above the bus's: the event interrupt is
+ * pended to fail the transaction in its own context.
+ */
+static void i2c_watchdog(HrTimer_t *pxTimer, void *pvArg)
+{
+	const I2cBus_t xBus = (I2cBus_t)(uint32_t)pvArg;
+
+	(void)pxTimer;
+
+	xI2cState[xBus].ucTimedOut = 1;
+	NVIC_SetPendingIRQ(xI2cHw[xBus].xEvIrq);
+}
+
+/**
+ * @brief Event interrupt of a bus: moves the transaction to its next step.
+ * @param xBus Bus.
+ * @retval None
+ */
+static void i2c_ev_irq(I2cBus_t xBus)
+{
+	I2cState_t *pxState = &xI2cState[xBus];
+	I2C_TypeDef *pxI2c = xI2cHw[xBus].pxI2c;
+	I2cXfer_t *pxXfer = (I2cXfer_t *)pxState->xQueue.pxHead;
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	uint32_t ulSr1;
+
+	if (pxXfer == NULL)
+	{
+		pxI2c->CR2 &= ~(I2C_CR2_ITEVTEN | I2C_CR2_ITBUFEN);
+		return;
+	}
+
+	if (pxState->ucTimedOut != 0U)
+	{
+		pxState->xStats.ulTimeouts++;
+		i2c_fail(xBus, pdTRUE, &xHigherPriorityTaskWoken);
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+		return;
+	}
+
+	if (pxState->ucStuck != 0U)
+	{
+		pxState->ucStuck = 0;
+		i2c_recover(xBus);
+		pxI2c->CR2 |= I2C_CR2_ITEVTEN | I2C_CR2_ITERREN;
+		pxI2c->CR1 |= I2C_CR1_START;
+		return;
+	}
+
+	ulSr1 = pxI2c->SR1;
+
+	if ((ulSr1 & I2C_SR1_SB) != 0U)
+	{
+		/* Reading SR1 then writing DR clears SB. */
+		pxI2c->DR = ((uint32_t)pxXfer->ucAddr << 1)
+				| ((pxState->ucPhase == I2C_PHASE_READ) ? 1U : 0U);
+	}
+	else if ((ulSr1 & I2C_SR1_ADDR) != 0U)
+	{
+		if (pxState->ucPhase == I2C_PHASE_WRITE)
+		{
+			if (pxXfer->usTxLen != 0U)
+			{
+				dma_desc_init(&pxXfer->xDesc, NULL, (void *)pxXfer->pucTx, pxXfer->usTxLen);
+				(void)dma_submit(pxState->pxTxStream, &pxXfer->xDesc);
+				pxI2c->CR2 |= I2C_CR2_DMAEN;
+				(void)pxI2c->SR2;
+			}
+			else
+			{
+				/* A probe, or a write of nothing: no BTF will come. */
+				(void)pxI2c->SR2;
+
+				if (pxXfer->xReq.ulLen == 0U)
+				{
+					pxI2c->CR1 |= I2C_CR1_STOP;
+					i2c_finish(xBus, 0, &xHigherPriorityTaskWoken);
+				}
+				else
+				{
+					pxState->ucPhase = I2C_PHASE_READ;
+					pxI2c->CR1 |= I2C_CR1_START;
+				}
+			}
+		}
+		else if (pxXfer->xReq.ulLen == 1U)
+		{
+			/* NACK and STOP must be set around the ADDR clear. */
+			pxI2c->CR1 &= ~I2C_CR1_ACK;
+			(void)pxI2c->SR2;
+			pxI2c->CR1 |= I2C_CR1_STOP;
+			pxI2c->CR2 |= I2C_CR2_ITBUFEN;
+		}
+		else
+		{
+			dma_desc_init(&pxXfer->xDesc, NULL, pxXfer->xReq.pvData, pxXfer->xReq.ulLen);
+			xfer_on_callback(&pxXfer->xDesc.xReq, i2c_rx_done, pxXfer);
+			(void)dma_submit(pxState->pxRxStream, &pxXfer->xDesc);
+			pxI2c->CR1 |= I2C_CR1_ACK;
+			pxI2c->CR2 |= I2C_CR2_DMAEN | I2C_CR2_LAST;
+			(void)pxI2c->SR2;
+		}
+	}
+	else if (((ulSr1 & I2C_SR1_BTF) != 0U) && (pxState->ucPhase == I2C_PHASE_WRITE))
+	{
+		/* The DMA has written the last byte and it is acknowledged. */
+		pxI2c->CR2 &= ~I2C_CR2_DMAEN;
+
+		if (pxXfer->xReq.ulLen != 0U)
+		{
+			pxState->ucPhase = I2C_PHASE_READ;
+			pxI2c->CR1 |= I2C_CR1_START;
+		}
+		else
+		{
+			pxI2c->CR1 |= I2C_CR1_STOP;
+			i2c_finish(xBus, 0, &xHigherPriorityTaskWoken);
+		}
+	}
+	else if (((ulSr1 & I2C_SR1_RXNE) != 0U) && (pxState->ucPhase == I2C_PHASE_READ))
+	{
+		*(uint8_t *)pxXfer->xReq.pvData = (uint8_t)pxI2c->DR;
+		i2c_finish(xBus, 1, &xHigherPriorityTaskWoken);
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Error interrupt of a bus: fails the transaction.
+ * @param xBus Bus.
+ * @retval None
+ */
+static void i2c_er_irq(I2cBus_t xBus)
+{
+	I2cState_t *pxState = &xI2cState[xBus];
+	I2C_TypeDef *pxI2c = xI2cHw[xBus].pxI2c;
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	uint32_t ulSr1;
+
+	ulSr1 = pxI2c->SR1;
+
+	/* The error flags clear by writing 0; the others ignore it. */
+	pxI2c->SR1 = ~(ulSr1 & I2C_SR1_ERRORS) & 0xFFFFU;
+
+	if (pxState->xQueue.pxHead == NULL)
+	{
+		return;
+	}
+
+	if ((ulSr1 & I2C_SR1_AF) != 0U)
+	{
+		pxState->xStats.ulNacks++;
+		i2c_fail(xBus, pdFALSE, &xHigherPriorityTaskWoken);
+	}
+	else if ((ulSr1 & (I2C_SR1_BERR | I2C_SR1_ARLO)) != 0U)
+	{
+		pxState->xStats.ulBusErrors++;
+		i2c_fail(xBus, pdTRUE, &xHigherPriorityTaskWoken);
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
@@ -0,0 +1,432 @@
+/*******************************************************************************
+ *
+ * @file	icap.c
+ * @brief	Implementation of the timer input capture (frequency and duty cycle).
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	Measures the frequency and duty cycle of flow meters, tachometers
+ * 			and other pulse outputs without polling them and without an
+ * 			interrupt per edge. TIM2 free-runs at the timer clock (90 MHz at
+ * 			180 MHz, an 11 ns resolution) over its full 32 bits. For each
+ * 			input, one channel captures its rising edges and the next one
+ * 			(mapped on the same pin) its falling edges. Each capture is
+ * 			copied by DMA, circular (dma_start_ring()), into a ring of
+ * 			timestamps.
+ *
+ * 			icap_read() works a block at a time: it takes the edges stored
+ * 			since the last call and sums their periods and high times. A
+ * 			reader calling it every tick, or every second, pays the same
+ * 			per edge, a few cycles, and nothing between calls.
+ *
+ * 			Periods are differences of 32-bit counts, so they are right
+ * 			across the counter's wrap (every 47 s), up to 23 s long. A ring
+ * 			that wraps between two reads has lost edges: the read finds the
+ * 			last edge it took overwritten, counts an overrun and starts
+ * 			again from the next edges.
+ *
+ * 			TIM5, the other 32-bit timer, is the time base of timestamp.c
+ * 			and hrtimer.c. TIM2 is also the trigger of adc.c's streaming, so
+ * 			the two cannot run together: icap_open() fails while the ADC
+ * 			holds TIM2. The TI1 input uses DMA1 streams 5 and 6, which the
+ * 			USART2 console takes by default (uart.h); TI3 uses streams 1 and
+ * 			7 (or 6).
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clkgate.h"
+#include "dma.h"
+#include "icap.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define ICAP_RING_MASK			(ICAP_RING_EDGES - 1U)
+#define ICAP_AF_TIM2			1U
+#define TIM_CR1_CEN_OFS			0U
+#define TIM_EGR_UG_OFS			0U
+
+/* Per pair of channels: CH1 and CH2, or CH3 and CH4 (shift by 8 in CCER,
+ * by 2 in DIER, the other CCMR register). */
+#define TIM_CCMR_CCAS_TI_DIRECT		(1U << 0)	/* First channel: its own pin. */
+#define TIM_CCMR_ICAF_OFS			4U
+#define TIM_CCMR_CCBS_TI_INDIRECT	(2U << 8)	/* Second channel: the first one's pin. */
+#define TIM_CCER_PAIR_MASK			0xFFU
+#define TIM_CCER_CCAE				(1U << 0)	/* First channel enabled, rising. */
+#define TIM_CCER_CCBE				(1U << 4)
+#define TIM_CCER_CCBP				(1U << 5)	/* Second channel falling. */
+#define TIM_DIER_CCADE_OFS			9U
+#define TIM_DIER_CCBDE_OFS			10U
+
+#if (ICAP_RING_EDGES & ICAP_RING_MASK) != 0U
+#error "ICAP_RING_EDGES must be a power of two"
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	GPIO_TypeDef *pxPort;
+	ClkGate_t ePortClock;
+	uint8_t ucPin;
+	uint8_t ucPair;					/* 0: CH1 and CH2, 1: CH3 and CH4. */
+	DmaRequest_t xRiseRequest;
+	DmaRequest_t xFallRequest;
+} IcapInputDef_t;
+
+typedef struct
+{
+	uint8_t ucOpen;
+	uint8_t ucHaveRise;				/* ulLastRise is an edge taken. */
+	uint8_t ucHaveFall;
+	DmaStream_t *pxRise;
+	DmaStream_t *pxFall;
+	uint32_t ulRiseRead;			/* Next edge to take. */
+	uint32_t ulFallRead;
+	uint32_t ulLastRise;
+	uint32_t ulLastFall;
+	uint32_t ulOverruns;
+	ClkGateUser_t xPortClock;
+} IcapState_t;
+
+/* Variables -----------------------------------------------------------------*/
+static const IcapInputDef_t xInputs[ICAP_INPUTS] =
+{
+	[ICAP_INPUT_TI1] = { GPIOA, CLKGATE_GPIOA, 0U, 0U, DMA_REQ_TIM2_CH1, DMA_REQ_TIM2_CH2 },
+	[ICAP_INPUT_TI3] = { GPIOB, CLKGATE_GPIOB, 10U, 1U, DMA_REQ_TIM2_CH3, DMA_REQ_TIM2_CH4 },
+};
+
+static IcapState_t xIcap[ICAP_INPUTS];
+static uint32_t ulRises[ICAP_INPUTS][ICAP_RING_EDGES];
+static uint32_t ulFalls[ICAP_INPUTS][ICAP_RING_EDGES];
+static uint32_t ulTimerUsers = 0;
+static ClkGateUser_t xTimerClock = CLKGATE_USER(CLKGATE_TIM2);
+
+/* Private function prototypes -----------------------------------------------*/
+static int32_t icap_alloc(DmaRequest_t xRequest, volatile uint32_t *pulCcr, DmaStream_t **ppxStream);
+static uint32_t icap_ring_index(const DmaStream_t *pxStream);
+static uint64_t icap_ns(uint64_t ullTicks, uint32_t ulClock);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Starts capturing the edges of an input.
+ * @param eInput Input; its pin is switched to TIM2.
+ * @retval 0 if successful, -1 if already open, TIM2 is used by the ADC or a
+ * DMA stream is taken.
+ * @note Call from a task. The pin gets no pull resistor: an open-collector
+ * sensor needs one on the board.
+ */
+int32_t icap_open(IcapInput_t eInput)
+{
+	const IcapInputDef_t *pxDef;
+	IcapState_t *pxState;
+	volatile uint32_t *pulCcmr;
+	volatile uint32_t *pulCcr;
+	uint32_t ulShift2;
+	uint32_t ulShift4;
+
+	if ((eInput >= ICAP_INPUTS) || (xIcap[eInput].ucOpen != 0U))
+	{
+		return -1;
+	}
+
+	pxDef = &xInputs[eInput];
+	pxState = &xIcap[eInput];
+
+	if (ulTimerUsers == 0U)
+	{
+		if (clkgate_get_users(CLKGATE_TIM2) != 0U)
+		{
+			return -1;
+		}
+
+		clkgate_acquire(&xTimerClock);
+
+		/* Free-running over 32 bits at the timer clock. */
+		TIM2->CR1 = 0;
+		TIM2->CR2 = 0;
+		TIM2->SMCR = 0;
+		TIM2->DIER = 0;
+		TIM2->CCER = 0;
+		TIM2->PSC = 0;
+		TIM2->ARR = 0xFFFFFFFFU;
+		TIM2->EGR = (1U << TIM_EGR_UG_OFS);
+		TIM2->CR1 = (1U << TIM_CR1_CEN_OFS);
+	}
+
+	/* CCR1 to CCR4 follow each other, the pair's first at 2 * ucPair. */
+	pulCcr = &TIM2->CCR1 + (2U * pxDef->ucPair);
+
+	if (icap_alloc(pxDef->xRiseRequest, pulCcr, &pxState->pxRise) != 0)
+	{
+		if (ulTimerUsers == 0U)
+		{
+			TIM2->CR1 = 0;
+			clkgate_release(&xTimerClock);
+		}
+
+		return -1;
+	}
+
+	if (icap_alloc(pxDef->xFallRequest, pulCcr + 1, &pxState->pxFall) != 0)
+	{
+		dma_free(pxState->pxRise);
+
+		if (ulTimerUsers == 0U)
+		{
+			TIM2->CR1 = 0;
+			clkgate_release(&xTimerClock);
+		}
+
+		return -1;
+	}
+
+	ulTimerUsers++;
+
+	clkgate_user_init(&pxState->xPortClock, pxDef->ePortClock);
+	clkgate_acquire(&pxState->xPortClock);
+
+	ulShift2 = 2U * pxDef->ucPin;
+	ulShift4 = 4U * (pxDef->ucPin & 7U);
+	pxDef->pxPort->AFR[pxDef->ucPin >> 3] = (pxDef->pxPort->AFR[pxDef->ucPin >> 3]
+			& ~(0xFU << ulShift4)) | (ICAP_AF_TIM2 << ulShift4);
+	pxDef->pxPort->PUPDR &= ~(3U << ulShift2);
+	pxDef->pxPort->MODER = (pxDef->pxPort->MODER & ~(3U << ulShift2)) | (2U << ulShift2);
+
+	pxState->ucHaveRise = 0;
+	pxState->ucHaveFall = 0;
+	pxState->ulRiseRead = 0;
+	pxState->ulFallRead = 0;
+	pxState->ulOverruns = 0;
+
+	(void)dma_start_ring(pxState->pxRise, ulRises[eInput], ICAP_RING_EDGES);
+	(void)dma_start_ring(pxState->pxFall, ulFalls[eInput], ICAP_RING_EDGES);
+
+	/* Both channels on the first one's pin, filtered there. */
+	pulCcmr = (pxDef->ucPair == 0U) ? &TIM2->CCMR1 : &TIM2->CCMR2;
+	*pulCcmr = TIM_CCMR_CCAS_TI_DIRECT | ((ICAP_FILTER & 0xFU) << TIM_CCMR_ICAF_OFS)
+			| TIM_CCMR_CCBS_TI_INDIRECT;
+
+	TIM2->DIER |= (1U << (TIM_DIER_CCADE_OFS + (2U * pxDef->ucPair)))
+			| (1U << (TIM_DIER_CCBDE_OFS + (2U * pxDef->ucPair)));
+	TIM2->CCER |= (TIM_CCER_CCAE | TIM_CCER_CCBE | TIM_CCER_CCBP) << (8U * pxDef->ucPair);
+
+	pxState->ucOpen = 1;
+
+	return 0;
+}
+
+/**
+ * @brief Stops capturing an input.
+ * @param eInput Input.
+ * @retval None
+ * @note The pin stays in its alternate function mode.
+ */
+void icap_close(IcapInput_t eInput)
+{
+	const IcapInputDef_t *pxDef;
+	IcapState_t *pxState;
+
+	if ((eInput >= ICAP_INPUTS) || (xIcap[eInput].ucOpen == 0U))
+	{
+		return;
+	}
+
+	pxDef = &xInputs[eInput];
+	pxState = &xIcap[eInput];
+
+	TIM2->CCER &= ~(TIM_CCER_PAIR_MASK << (8U * pxDef->ucPair));
+	TIM2->DIER &= ~((1U << (TIM_DIER_CCADE_OFS + (2U * pxDef->ucPair)))
+			| (1U << (TIM_DIER_CCBDE_OFS + (2U * pxDef->ucPair))));
+
+	dma_free(pxState->pxRise);
+	dma_free(pxState->pxFall);
+	clkgate_release(&pxState->xPortClock);
+	pxState->ucOpen = 0;
+
+	if (--ulTimerUsers == 0U)
+	{
+		TIM2->CR1 = 0;
+		clkgate_release(&xTimerClock);
+	}
+}
+
+/**
+ * @brief Measures the periods completed since the last call.
+ * @param eInput Input.
+ * @param pxResult Receives the measurement.
+ * @retval 0 if successful, -1 if the input is not open.
+ * @note One reader per input. A signal that stopped gives no period: the
+ * reader decides after how long that means zero.
+ */
+int32_t icap_read(IcapInput_t eInput, IcapResult_t *pxResult)
+{
+	const uint32_t ulClock = icap_get_clock_hz();
+	IcapState_t *pxState;
+	uint64_t ullPeriodSum = 0;
+	uint64_t ullHighSum = 0;
+	uint64_t ullHighPeriodSum = 0;
+	uint32_t ulMin = 0xFFFFFFFFU;
+	uint32_t ulMax = 0;
+	uint32_t ulCount = 0;
+	uint32_t ulRiseWrite;
+	uint32_t ulFallWrite;
+	uint32_t ulRise;
+	uint32_t ulFall;
+	uint32_t ulPeriod;
+	uint8_t ucHigh;
+
+	if ((eInput >= ICAP_INPUTS) || (xIcap[eInput].ucOpen == 0U) || (pxResult == NULL))
+	{
+		return -1;
+	}
+
+	pxState = &xIcap[eInput];
+
+	/* Rises first: every fall before the last rise is then in the falls'. */
+	ulRiseWrite = icap_ring_index(pxState->pxRise);
+	ulFallWrite = icap_ring_index(pxState->pxFall);
+
+	/* The last edge taken, overwritten: the ring went round. */
+	if (((pxState->ucHaveRise != 0U)
+			&& (ulRises[eInput][(pxState->ulRiseRead - 1U) & ICAP_RING_MASK] != pxState->ulLastRise))
+			|| ((pxState->ucHaveFall != 0U)
+			&& (ulFalls[eInput][(pxState->ulFallRead - 1U) & ICAP_RING_MASK] != pxState->ulLastFall)))
+	{
+		pxState->ulOverruns++;
+		pxState->ucHaveRise = 0;
+		pxState->ucHaveFall = 0;
+		pxState->ulRiseRead = ulRiseWrite;
+		pxState->ulFallRead = ulFallWrite;
+	}
+
+	while (pxState->ulRiseRead != ulRiseWrite)
+	{
+		ulRise = ulRises[eInput][pxState->ulRiseRead];
+		pxState->ulRiseRead = (pxState->ulRiseRead + 1U) & ICAP_RING_MASK;
+
+		if (pxState->ucHaveRise != 0U)
+		{
+			ulPeriod = ulRise - pxState->ulLastRise;
+			ucHigh = 0;
+
+			/* The fall of this period, skipping any before it. */
+			while (pxState->ulFallRead != ulFallWrite)
+			{
+				ulFall = ulFalls[eInput][pxState->ulFallRead];
+
+				if ((int32_t)(ulFall - ulRise) >= 0)
+				{
+					break;
+				}
+
+				pxState->ulFallRead = (pxState->ulFallRead + 1U) & ICAP_RING_MASK;
+				pxState->ulLastFall = ulFall;
+				pxState->ucHaveFall = 1;
+
+				/* The first one only: a glitch filtered in adds another. */
+				if (((int32_t)(ulFall - pxState->ulLastRise) > 0) && (ucHigh == 0U))
+				{
+					ullHighSum += ulFall - pxState->ulLastRise;
+					ullHighPeriodSum += ulPeriod;
+					ucHigh = 1;
+				}
+			}
+
+			ullPeriodSum += ulPeriod;
+			ulMin = (ulPeriod < ulMin) ? ulPeriod : ulMin;
+			ulMax = (ulPeriod > ulMax) ? ulPeriod : ulMax;
+			ulCount++;
+		}
+
+		pxState->ulLastRise = ulRise;
+		pxState->ucHaveRise = 1;
+	}
+
+	pxResult->ulPeriods = ulCount;
+	pxResult->ulLastEdge = pxState->ulLastRise;
+	pxResult->ulOverruns = pxState->ulOverruns;
+
+	if (ulCount == 0U)
+	{
+		pxResult->ulFrequencyMilliHz = 0;
+		pxResult->ulDutyPpm = 0;
+		pxResult->ulMinPeriodNs = 0;
+		pxResult->ulMaxPeriodNs = 0;
+		return 0;
+	}
+
+	pxResult->ulFrequencyMilliHz = (uint32_t)(((uint64_t)ulCount * ulClock * 1000U) / ullPeriodSum);
+	pxResult->ulDutyPpm = (ullHighPeriodSum != 0U)
+			? (uint32_t)((ullHighSum * 1000000U) / ullHighPeriodSum) : 0U;
+	pxResult->ulMinPeriodNs = (uint32_t)icap_ns(ulMin, ulClock);
+	pxResult->ulMaxPeriodNs = (uint32_t)icap_ns(ulMax, ulClock);
+
+	return 0;
+}
+
+/**
+ * @brief Returns the rate TIM2 counts at, to convert edge counts to time.
+ * @param None
+ * @retval Hz: PCLK1, doubled when APB1 is divided.
+ */
+uint32_t icap_get_clock_hz(void)
+{
+	uint32_t ulClock = HAL_RCC_GetPCLK1Freq();
+
+	if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+	{
+		ulClock *= 2U;
+	}
+
+	return ulClock;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Allocates the DMA stream of a capture channel.
+ * @param xRequest TIM2 channel request.
+ * @param pulCcr Its capture register.
+ * @param ppxStream Receives the stream.
+ * @retval 0 if successful, -1 otherwise.
+ */
+static int32_t icap_alloc(DmaRequest_t xRequest, volatile uint32_t *pulCcr, DmaStream_t **ppxStream)
+{
+	DmaConfig_t xCfg;
+
+	xCfg.xRequest = xRequest;
+	xCfg.xDir = DMA_DIR_P2M;
+	xCfg.ucPriority = DMA_PL_HIGH;
+	xCfg.ucItemSize = 4U;
+	xCfg.ucPeriphInc = 0U;
+	xCfg.ucMemInc = 1U;
+	xCfg.pvPeriph = pulCcr;
+	xCfg.ulBandwidth = ICAP_MAX_EDGE_HZ * 4U;
+
+	return dma_alloc(&xCfg, ppxStream);
+}
+
+/**
+ * @brief Returns where the DMA writes the next edge of a ring.
+ * @param pxStream Stream of the ring.
+ * @retval Ring index.
+ */
+static uint32_t icap_ring_index(const DmaStream_t *pxStream)
+{
+	/* NDTR reloads to ICAP_RING_EDGES after the last item. */
+	return (ICAP_RING_EDGES - dma_get_remaining(pxStream)) & ICAP_RING_MASK;
+}
+
+/**
+ * @brief Converts timer counts to nanoseconds.
+ * @param ullTicks Counts.
+ * @param ulClock Timer clock, Hz.
+ * @retval Nanoseconds.
+ */
+static uint64_t icap_ns(uint64_t ullTicks, uint32_t ulClock)
+{
+	return (ullTicks * 1000000000U) / ulClock;
+}
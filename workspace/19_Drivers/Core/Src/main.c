@@ -4,16 +4,27 @@
  * @brief	Drivers necessary for the FreeRTOS projects.
  * @author	Kyungjae Lee
  * @date	Aug 23, 2025
+ * @note	The Arduino analog inputs A0-A5 are scanned in one DMA transfer
+ * 			per sequence and oversampled 16 times into 14-bit values, and
+ * 			VREFINT is read on the injected group, which pre-empts the scan.
+ * 			The vector table is copied to SRAM at boot (irq.c).
  *
  ******************************************************************************/
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
 #include "uart.h"
 #include "exti.h"
 #include "adc.h"
+#include "irq.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define SCAN_CHANNELS			6U
+#define SCAN_OVERSAMPLE_LOG2	4U		/* 16 sequences per result. */
+#define SCAN_RATE_HZ			16000U	/* One result block every 1 ms. */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
@@ -26,6 +37,18 @@ typedef uint32_t TaskProfiler;
 /* Variables -----------------------------------------------------------------*/
 uint8_t button_state;
 uint32_t sensor_value;
+uint16_t analog_values[SCAN_CHANNELS];	/* 14 bits. */
+uint16_t vrefint_value;
+
+/* A0-A5: PA0, PA1, PA4, PB0, PC1, PC0. */
+static const uint8_t ucScanChannels[SCAN_CHANNELS] = { 0, 1, 4, 8, 11, 10 };
+static const uint8_t ucInjectedChannels[] = { ADC_CHANNEL_VREFINT };
+static uint16_t usScanRaw[2U * (SCAN_CHANNELS << SCAN_OVERSAMPLE_LOG2)];
+
+/* 56 ADC clocks per sample; 16 sums shifted by 2 give 12 + 2 bits. */
+static const AdcScanConfig_t xScanConfig =
+{ ucScanChannels, SCAN_CHANNELS, 3U, SCAN_OVERSAMPLE_LOG2, SCAN_OVERSAMPLE_LOG2 / 2U,
+		SCAN_RATE_HZ, usScanRaw, NULL };
 
 /**
  * @brief The application entry point.
@@ -33,6 +56,9 @@ uint32_t sensor_value;
  */
 int main(void)
 {
+	/* Vectors from SRAM, before HAL_Init() enables the timebase interrupt. */
+	(void)irq_init();
+
 	HAL_Init();
 
 	/* Configure the system clock */
@@ -43,14 +69,22 @@ int main(void)
 	USART2_UART_TX_Init();
 
 	gpio_init();
-	adc_init();
-	//gpio_pc13_interrupt_init();
+
+	if ((adc_scan_init(&xScanConfig) != 0) || (adc_scan_start() != 0)
+			|| (adc_injected_init(ucInjectedChannels, 1U, 7U) != 0))	/* VREFINT needs 10 us. */
+	{
+		Error_Handler();
+	}
 
 	/* Infinite loop */
 	while (1)
 	{
 		button_state = read_digital_sensor();
-		sensor_value = read_analog_sensor();
+
+		(void)adc_scan_get_latest(analog_values);
+		sensor_value = analog_values[1];	/* PA1 */
+
+		(void)adc_injected_read(&vrefint_value);
 	}
 }
 
@@ -60,44 +94,9 @@ int main(void)
  */
 void SystemClock_Config(void)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
-
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-	{
-		Error_Handler();
-	}
-
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
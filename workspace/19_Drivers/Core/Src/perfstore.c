@@ -0,0 +1,599 @@
+/*******************************************************************************
+ *
+ * @file	perfstore.c
+ * @brief	Persistent performance counters: the worst values of each boot,
+ * 			kept in backup SRAM across resets.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	The application names its counters in a table given to
+ * 			perfstore_init(), each keeping the highest (a peak) or the lowest
+ * 			(a low-water mark) value given to perfstore_update(). Updates go
+ * 			to a copy in RAM, with interrupts masked only when the value is a
+ * 			new worst. perfstore_commit() writes the copy to backup SRAM,
+ * 			periodically from the committer task.
+ *
+ * 			The 4 KB of backup SRAM hold two slots of the same layout. A
+ * 			commit writes the older slot, the CRC word last, so a reset in
+ * 			the middle of it leaves the other slot as it was. The newest
+ * 			slot with a valid CRC wins at boot. Each slot starts with a
+ * 			magic, a sequence number and a layout signature, a CRC of the
+ * 			format version and of the counter table, so a firmware with
+ * 			other counters starts afresh instead of misreading them.
+ *
+ * 			At boot, the counters of the boot that just ended are moved to
+ * 			a history of PERFSTORE_HISTORY boots, with the cause of the reset
+ * 			read from RCC_CSR and how long the boot lasted. The lifetime
+ * 			values keep the worst of all boots since the store was
+ * 			formatted: by the first boot, a loss of power with no VBAT, or a
+ * 			new counter table.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "crc.h"
+#include "perfstore.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define RCC_APB1ENR_PWREN_OFS		28U
+#define RCC_AHB1ENR_BKPSRAMEN_OFS	18U
+#define RCC_CSR_RMVF_OFS			24U
+#define RCC_CSR_FLAGS_OFS			25U		/* BORRSTF, then PIN, POR, SFT, IWDG, WWDG, LPWR. */
+#define RCC_CSR_FLAGS_MASK			0x7FU
+#define PWR_CR_DBP_OFS				8U
+#define PWR_CSR_BRE_OFS				9U
+#define PWR_CSR_BRR_OFS				3U
+
+#define PERFSTORE_MAGIC				0x50455246UL	/* "PERF" */
+#define PERFSTORE_FORMAT			1U		/* Bumped when PerfStoreSlot_t changes. */
+#define PERFSTORE_BKPSRAM_BYTES		4096U
+#define PERFSTORE_BRR_TIMEOUT		100000U	/* Polls of the backup regulator. */
+#define PERFSTORE_SLOTS				((PerfStoreSlot_t *)BKPSRAM_BASE)
+
+/* PerfStoreSlot_t, in words. */
+#define PERFSTORE_BOOT_WORDS		(2U + PERFSTORE_MAX_COUNTERS)
+#define PERFSTORE_SLOT_WORDS		(7U + PERFSTORE_BOOT_WORDS + PERFSTORE_MAX_COUNTERS \
+										+ (PERFSTORE_HISTORY * PERFSTORE_BOOT_WORDS) + 1U)
+
+#if ((2U * 4U * PERFSTORE_SLOT_WORDS) > PERFSTORE_BKPSRAM_BYTES)
+#error PERFSTORE_MAX_COUNTERS and PERFSTORE_HISTORY make two slots larger than the backup SRAM
+#endif
+
+#if (PERFSTORE_HISTORY == 0U)
+#error PERFSTORE_HISTORY must keep at least one previous boot
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulMagic;					/* PERFSTORE_MAGIC. */
+	uint32_t ulLayout;					/* Signature of the format and counter table. */
+	uint32_t ulSequence;				/* Commits since formatted; the newest slot wins. */
+	uint32_t ulBoots;					/* Boots since formatted, this one included. */
+	uint32_t ulResetCause;				/* PERFSTORE_RESET_ flags that started this boot. */
+	uint32_t ulHistoryCount;			/* Valid entries of xHistory. */
+	uint32_t ulHistoryHead;				/* Index of the newest entry. */
+	PerfStoreBoot_t xBoot;				/* This boot so far. */
+	uint32_t ulLifetime[PERFSTORE_MAX_COUNTERS];
+	PerfStoreBoot_t xHistory[PERFSTORE_HISTORY];
+	uint32_t ulCrc;						/* Of all the words above; written last. */
+} PerfStoreSlot_t;
+
+/* Variables -----------------------------------------------------------------*/
+static const char * const pcPerfStoreCauseNames[] =
+{
+	"bor", "pin", "por", "software", "iwdg", "wwdg", "low-power"
+};
+
+static const PerfStoreCounter_t *pxPerfStoreCounters = NULL;
+static uint32_t ulPerfStoreCount = 0;		/* 0 until perfstore_init(). */
+static uint32_t ulPerfStoreNextSlot = 0;	/* The older slot, written next. */
+static uint32_t ulPerfStoreFormatted = 0;	/* 1: nothing valid, 2: new layout. */
+static PerfStoreSlot_t xPerfStore;			/* The counters, updated at run time. */
+static PerfStoreSlot_t xPerfStoreImage;		/* What a commit writes. */
+static TickType_t xPerfStoreCommitTicks = 0;
+static PerfStoreSample_t pxPerfStoreSample = NULL;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t perfstore_layout(const PerfStoreCounter_t *pxCounters, uint32_t ulCount);
+static int32_t perfstore_slot_valid(const PerfStoreSlot_t *pxSlot, uint32_t ulLayout);
+static uint32_t perfstore_initial(uint32_t ulCounter);
+static int32_t perfstore_is_worse(uint32_t ulCounter, uint32_t ulValue, uint32_t ulCurrent);
+static const char *perfstore_format_cause(uint32_t ulCause, char *pcBuffer, size_t xSize);
+static const char *perfstore_format_value(uint32_t ulCounter, uint32_t ulValue, char *pcBuffer,
+		size_t xSize);
+static void perfstore_committer_task(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Opens the store in backup SRAM, moves the counters of the boot that
+ * just ended to the history and starts the counters of this boot.
+ * @param pxCounters Table of ulCount counters; must stay valid, names included.
+ * @param ulCount Number of counters, 1 to PERFSTORE_MAX_COUNTERS.
+ * @retval 0 if the stored counters were restored, 1 if the store was started
+ * afresh (first boot, lost power, or another counter table), -1 if ulCount is
+ * out of range.
+ * @note Call once before vTaskStartScheduler(), after crc_init(). Clears the
+ * RCC_CSR reset flags. Enables the backup regulator, so the counters survive
+ * on VBAT too.
+ */
+int32_t perfstore_init(const PerfStoreCounter_t *pxCounters, uint32_t ulCount)
+{
+	const PerfStoreSlot_t *pxSlots = PERFSTORE_SLOTS;
+	uint32_t ulTimeout = PERFSTORE_BRR_TIMEOUT;
+	uint32_t ulLayout;
+	uint32_t ulCause;
+	int32_t lValid0;
+	int32_t lValid1;
+	int32_t lNewest = -1;
+	uint32_t i;
+
+	if ((pxCounters == NULL) || (ulCount == 0U) || (ulCount > PERFSTORE_MAX_COUNTERS))
+	{
+		return -1;
+	}
+
+	configASSERT(sizeof(PerfStoreSlot_t) == (4U * PERFSTORE_SLOT_WORDS));
+
+	/* The backup SRAM is written through the backup domain, which needs the
+	 * PWR clock and its write protection off, and has a clock of its own. */
+	RCC->APB1ENR |= (1U << RCC_APB1ENR_PWREN_OFS);
+	(void)RCC->APB1ENR;
+	PWR->CR |= (1U << PWR_CR_DBP_OFS);
+	RCC->AHB1ENR |= (1U << RCC_AHB1ENR_BKPSRAMEN_OFS);
+	(void)RCC->AHB1ENR;
+
+	/* With the backup regulator, it is also kept on VBAT while VDD is off. */
+	PWR->CSR |= (1U << PWR_CSR_BRE_OFS);
+
+	while (((PWR->CSR & (1U << PWR_CSR_BRR_OFS)) == 0U) && (--ulTimeout > 0U))
+	{
+		/* Wait for the backup regulator. */
+	}
+
+	ulCause = (RCC->CSR >> RCC_CSR_FLAGS_OFS) & RCC_CSR_FLAGS_MASK;
+	RCC->CSR |= (1U << RCC_CSR_RMVF_OFS);
+
+	ulLayout = perfstore_layout(pxCounters, ulCount);
+	lValid0 = perfstore_slot_valid(&pxSlots[0], ulLayout);
+	lValid1 = perfstore_slot_valid(&pxSlots[1], ulLayout);
+
+	if ((lValid0 == 0) && ((lValid1 != 0)
+			|| ((int32_t)(pxSlots[0].ulSequence - pxSlots[1].ulSequence) > 0)))
+	{
+		lNewest = 0;
+	}
+	else if (lValid1 == 0)
+	{
+		lNewest = 1;
+	}
+
+	if (lNewest >= 0)
+	{
+		xPerfStore = pxSlots[lNewest];
+		ulPerfStoreNextSlot = (uint32_t)lNewest ^ 1U;
+		ulPerfStoreFormatted = 0;
+
+		/* The boot that just ended goes to the history, with what ended it. */
+		xPerfStore.ulHistoryHead = (xPerfStore.ulHistoryHead + 1U) % PERFSTORE_HISTORY;
+		xPerfStore.xHistory[xPerfStore.ulHistoryHead] = xPerfStore.xBoot;
+		xPerfStore.xHistory[xPerfStore.ulHistoryHead].ulResetCause = ulCause;
+
+		if (xPerfStore.ulHistoryCount < PERFSTORE_HISTORY)
+		{
+			xPerfStore.ulHistoryCount++;
+		}
+	}
+	else
+	{
+		/* The magic without this layout: written by another firmware. */
+		ulPerfStoreFormatted = ((pxSlots[0].ulMagic == PERFSTORE_MAGIC)
+				|| (pxSlots[1].ulMagic == PERFSTORE_MAGIC)) ? 2U : 1U;
+
+		memset(&xPerfStore, 0, sizeof(xPerfStore));
+		xPerfStore.ulMagic = PERFSTORE_MAGIC;
+		xPerfStore.ulLayout = ulLayout;
+		ulPerfStoreNextSlot = 0;
+	}
+
+	pxPerfStoreCounters = pxCounters;
+	ulPerfStoreCount = ulCount;
+
+	if (ulPerfStoreFormatted != 0U)
+	{
+		for (i = 0; i < ulCount; i++)
+		{
+			xPerfStore.ulLifetime[i] = perfstore_initial(i);
+		}
+	}
+
+	xPerfStore.ulBoots++;
+	xPerfStore.ulResetCause = ulCause;
+	xPerfStore.xBoot.ulResetCause = 0;
+	xPerfStore.xBoot.ulUptimeS = 0;
+
+	for (i = 0; i < PERFSTORE_MAX_COUNTERS; i++)
+	{
+		xPerfStore.xBoot.ulValues[i] = (i < ulCount) ? perfstore_initial(i) : 0U;
+	}
+
+	/* Written now, so a reset before the first periodic commit does not file
+	 * the previous boot twice. */
+	(void)perfstore_commit();
+
+	return (ulPerfStoreFormatted == 0U) ? 0 : 1;
+}
+
+/**
+ * @brief Gives a counter a new value, kept if it is worse than the worst of
+ * this boot.
+ * @param ulCounter Index in the table given to perfstore_init().
+ * @param ulValue The value.
+ * @retval None
+ * @note Any task, or an ISR at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ * A value no worse than the current one costs a compare; a new worst masks
+ * interrupts for a few stores. Ignored before perfstore_init().
+ */
+void perfstore_update(uint32_t ulCounter, uint32_t ulValue)
+{
+	UBaseType_t uxSavedInterruptStatus;
+
+	if ((ulCounter >= ulPerfStoreCount)
+			|| (perfstore_is_worse(ulCounter, ulValue, xPerfStore.xBoot.ulValues[ulCounter]) == 0))
+	{
+		return;
+	}
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+	/* Checked again, another update may have come in between. */
+	if (perfstore_is_worse(ulCounter, ulValue, xPerfStore.xBoot.ulValues[ulCounter]) != 0)
+	{
+		xPerfStore.xBoot.ulValues[ulCounter] = ulValue;
+	}
+
+	if (perfstore_is_worse(ulCounter, ulValue, xPerfStore.ulLifetime[ulCounter]) != 0)
+	{
+		xPerfStore.ulLifetime[ulCounter] = ulValue;
+	}
+
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+/**
+ * @brief Writes the counters to the older slot of the backup SRAM.
+ * @param None
+ * @retval 0, or -1 before perfstore_init().
+ * @note From one task at a time (the committer task, when started). About
+ * 500 bytes are copied with interrupts masked, then checksummed and written
+ * with interrupts enabled.
+ */
+int32_t perfstore_commit(void)
+{
+	PerfStoreSlot_t *pxSlot;
+	UBaseType_t uxSavedInterruptStatus;
+	const uint32_t *pulFrom = (const uint32_t *)&xPerfStoreImage;
+	volatile uint32_t *pulTo;
+	uint32_t i;
+
+	if (ulPerfStoreCount == 0U)
+	{
+		return -1;
+	}
+
+	/* Not taskENTER_CRITICAL(): perfstore_init() commits before the scheduler
+	 * starts, when leaving a critical section does not unmask interrupts. */
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	xPerfStore.xBoot.ulUptimeS = (uint32_t)(xTaskGetTickCount() / configTICK_RATE_HZ);
+	xPerfStore.ulSequence++;
+	xPerfStoreImage = xPerfStore;
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	xPerfStoreImage.ulCrc = crc_compute(&xPerfStoreImage, offsetof(PerfStoreSlot_t, ulCrc));
+
+	/* The CRC goes last: until it is written, the slot is invalid and the
+	 * other one is the newest. */
+	pxSlot = &PERFSTORE_SLOTS[ulPerfStoreNextSlot];
+	pulTo = (volatile uint32_t *)pxSlot;
+
+	for (i = 0; i < (PERFSTORE_SLOT_WORDS - 1U); i++)
+	{
+		pulTo[i] = pulFrom[i];
+	}
+
+	__DSB();
+	pulTo[PERFSTORE_SLOT_WORDS - 1U] = xPerfStoreImage.ulCrc;
+	__DSB();
+
+	ulPerfStoreNextSlot ^= 1U;
+
+	return 0;
+}
+
+/**
+ * @brief Returns the number of boots since the store was formatted.
+ * @param None
+ * @retval Boots, this one included.
+ */
+uint32_t perfstore_get_boots(void)
+{
+	return xPerfStore.ulBoots;
+}
+
+/**
+ * @brief Returns the worst value of a counter since the store was formatted.
+ * @param ulCounter Index in the table given to perfstore_init().
+ * @retval The value, or 0 for an unknown counter.
+ */
+uint32_t perfstore_get_lifetime(uint32_t ulCounter)
+{
+	return (ulCounter < ulPerfStoreCount) ? xPerfStore.ulLifetime[ulCounter] : 0U;
+}
+
+/**
+ * @brief Reads the counters of this boot or of a previous one.
+ * @param ulBootsAgo 0 for this boot, 1 for the previous one, and so on up to
+ * PERFSTORE_HISTORY.
+ * @param pxBoot Filled with the counters. The reset cause of this boot is 0.
+ * @retval 0, or -1 if that boot is not in the history.
+ */
+int32_t perfstore_get_boot(uint32_t ulBootsAgo, PerfStoreBoot_t *pxBoot)
+{
+	UBaseType_t uxSavedInterruptStatus;
+
+	if ((ulPerfStoreCount == 0U) || (ulBootsAgo > xPerfStore.ulHistoryCount))
+	{
+		return -1;
+	}
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+	if (ulBootsAgo == 0U)
+	{
+		*pxBoot = xPerfStore.xBoot;
+	}
+	else
+	{
+		*pxBoot = xPerfStore.xHistory[(xPerfStore.ulHistoryHead + PERFSTORE_HISTORY
+				- (ulBootsAgo - 1U)) % PERFSTORE_HISTORY];
+	}
+
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	return 0;
+}
+
+/**
+ * @brief Prints the store with printf(): the previous boots, how each ended,
+ * then each counter over the lifetime of the store, this boot and the
+ * previous boots, newest first.
+ * @param None
+ * @retval None
+ * @note Usually right after perfstore_init(), so that this boot's column is
+ * still empty and the previous boot is the one of interest. Lines start with
+ * "perfstore:".
+ */
+void perfstore_report(void)
+{
+	PerfStoreBoot_t xBoot;
+	char cCause[48];
+	char cValue[12];
+	uint32_t ulBoots = 0;
+	uint32_t i;
+	uint32_t j;
+
+	if (ulPerfStoreCount == 0U)
+	{
+		return;
+	}
+
+	printf("perfstore: boot %lu, reset by %s, %lu previous boot(s)%s\r\n",
+			xPerfStore.ulBoots,
+			perfstore_format_cause(xPerfStore.ulResetCause, cCause, sizeof(cCause)),
+			xPerfStore.ulHistoryCount,
+			(ulPerfStoreFormatted == 1U) ? ", formatted" :
+			(ulPerfStoreFormatted == 2U) ? ", formatted for a new layout" : "");
+
+	while (perfstore_get_boot(ulBoots + 1U, &xBoot) == 0)
+	{
+		ulBoots++;
+		printf("perfstore: boot -%lu: %lu s, ended by %s\r\n", ulBoots, xBoot.ulUptimeS,
+				perfstore_format_cause(xBoot.ulResetCause, cCause, sizeof(cCause)));
+	}
+
+	for (i = 0; i < ulPerfStoreCount; i++)
+	{
+		printf("perfstore: %-16s %s lifetime %10s",
+				pxPerfStoreCounters[i].pcName,
+				(pxPerfStoreCounters[i].ucKind == PERFSTORE_KIND_MIN) ? "min" : "max",
+				perfstore_format_value(i, xPerfStore.ulLifetime[i], cValue, sizeof(cValue)));
+		printf("  now %10s  previous",
+				perfstore_format_value(i, xPerfStore.xBoot.ulValues[i], cValue, sizeof(cValue)));
+
+		for (j = 1; perfstore_get_boot(j, &xBoot) == 0; j++)
+		{
+			printf(" %s", perfstore_format_value(i, xBoot.ulValues[i], cValue, sizeof(cValue)));
+		}
+
+		printf("\r\n");
+	}
+}
+
+/**
+ * @brief Creates a task that samples and commits the counters periodically.
+ * @param ulPeriodMs Commit period in milliseconds.
+ * @param uxPriority Priority of the committer task.
+ * @param pxSample Called before each commit, or NULL.
+ * @retval pdPASS if the task was created.
+ * @note A reset loses what was updated since the last commit, so the period
+ * bounds how much of a boot the store misses.
+ */
+BaseType_t perfstore_start_committer(uint32_t ulPeriodMs, UBaseType_t uxPriority,
+		PerfStoreSample_t pxSample)
+{
+	xPerfStoreCommitTicks = pdMS_TO_TICKS(ulPeriodMs);
+	pxPerfStoreSample = pxSample;
+
+	return xTaskCreate(perfstore_committer_task,
+					   "PerfStore",
+					   PERFSTORE_COMMITTER_STACK_WORDS,
+					   NULL,
+					   uxPriority,
+					   NULL);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Computes the layout signature.
+ * @param pxCounters Counter table.
+ * @param ulCount Number of counters.
+ * @retval CRC of the format, the sizes, and the name and kind of each counter.
+ */
+static uint32_t perfstore_layout(const PerfStoreCounter_t *pxCounters, uint32_t ulCount)
+{
+	const uint32_t ulHeader[4] = { PERFSTORE_FORMAT, PERFSTORE_MAX_COUNTERS, PERFSTORE_HISTORY, ulCount };
+	CrcContext_t xCtx;
+	uint32_t i;
+
+	crc_begin(&xCtx);
+	crc_update(&xCtx, ulHeader, sizeof(ulHeader));
+
+	for (i = 0; i < ulCount; i++)
+	{
+		/* The terminator separates the names. */
+		crc_update(&xCtx, pxCounters[i].pcName, (uint32_t)strlen(pxCounters[i].pcName) + 1U);
+		crc_update(&xCtx, &pxCounters[i].ucKind, 1U);
+	}
+
+	return crc_final(&xCtx);
+}
+
+/**
+ * @brief Checks a slot of the backup SRAM.
+ * @param pxSlot The slot.
+ * @param ulLayout Expected layout signature.
+ * @retval 0 if it holds counters of this layout, -1 if not.
+ */
+static int32_t perfstore_slot_valid(const PerfStoreSlot_t *pxSlot, uint32_t ulLayout)
+{
+	if ((pxSlot->ulMagic != PERFSTORE_MAGIC) || (pxSlot->ulLayout != ulLayout)
+			|| (pxSlot->ulHistoryCount > PERFSTORE_HISTORY)
+			|| (pxSlot->ulHistoryHead >= PERFSTORE_HISTORY))
+	{
+		return -1;
+	}
+
+	return (crc_compute(pxSlot, offsetof(PerfStoreSlot_t, ulCrc)) == pxSlot->ulCrc) ? 0 : -1;
+}
+
+/**
+ * @brief Returns the value a counter starts a boot with.
+ * @param ulCounter Index in the counter table.
+ * @retval 0 for a peak, the largest value for a low-water mark.
+ */
+static uint32_t perfstore_initial(uint32_t ulCounter)
+{
+	return (pxPerfStoreCounters[ulCounter].ucKind == PERFSTORE_KIND_MIN) ? UINT32_MAX : 0U;
+}
+
+/**
+ * @brief Tells whether a value is worse than the one a counter holds.
+ * @param ulCounter Index in the counter table.
+ * @param ulValue New value.
+ * @param ulCurrent Value held.
+ * @retval 1 if worse, 0 if not.
+ */
+static int32_t perfstore_is_worse(uint32_t ulCounter, uint32_t ulValue, uint32_t ulCurrent)
+{
+	if (pxPerfStoreCounters[ulCounter].ucKind == PERFSTORE_KIND_MIN)
+	{
+		return (ulValue < ulCurrent) ? 1 : 0;
+	}
+
+	return (ulValue > ulCurrent) ? 1 : 0;
+}
+
+/**
+ * @brief Formats PERFSTORE_RESET_ flags, e.g. "iwdg+pin".
+ * @param ulCause Flags.
+ * @param pcBuffer Output.
+ * @param xSize Size of pcBuffer.
+ * @retval pcBuffer.
+ */
+static const char *perfstore_format_cause(uint32_t ulCause, char *pcBuffer, size_t xSize)
+{
+	size_t xLen = 0;
+	uint32_t i;
+
+	pcBuffer[0] = '\0';
+
+	for (i = 0; i < (sizeof(pcPerfStoreCauseNames) / sizeof(pcPerfStoreCauseNames[0])); i++)
+	{
+		if (((ulCause & (1UL << i)) != 0U) && (xLen < xSize))
+		{
+			xLen += (size_t)snprintf(&pcBuffer[xLen], xSize - xLen, "%s%s",
+					(xLen > 0U) ? "+" : "", pcPerfStoreCauseNames[i]);
+		}
+	}
+
+	if (xLen == 0U)
+	{
+		(void)snprintf(pcBuffer, xSize, "unknown");
+	}
+
+	return pcBuffer;
+}
+
+/**
+ * @brief Formats the value of a counter, or "-" if it was never updated.
+ * @param ulCounter Index in the counter table.
+ * @param ulValue Value.
+ * @param pcBuffer Output, 11 characters at least.
+ * @param xSize Size of pcBuffer.
+ * @retval pcBuffer.
+ */
+static const char *perfstore_format_value(uint32_t ulCounter, uint32_t ulValue, char *pcBuffer,
+		size_t xSize)
+{
+	if (ulValue == perfstore_initial(ulCounter))
+	{
+		(void)snprintf(pcBuffer, xSize, "-");
+	}
+	else
+	{
+		(void)snprintf(pcBuffer, xSize, "%lu", ulValue);
+	}
+
+	return pcBuffer;
+}
+
+/**
+ * @brief Samples and commits the counters every period.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void perfstore_committer_task(void *pvParameters)
+{
+	TickType_t xLastWakeTicks = xTaskGetTickCount();
+
+	(void)pvParameters;
+
+	while (1)
+	{
+		vTaskDelayUntil(&xLastWakeTicks, xPerfStoreCommitTicks);
+
+		if (pxPerfStoreSample != NULL)
+		{
+			pxPerfStoreSample();
+		}
+
+		(void)perfstore_commit();
+	}
+}
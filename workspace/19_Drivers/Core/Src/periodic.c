@@ -0,0 +1,346 @@
+/*******************************************************************************
+ *
+ * @file	periodic.c
+ * @brief	Periodic task helper: vTaskDelayUntil() with a deadline, an overrun
+ * 			policy and release jitter and response time histograms.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	A periodic task calls periodic_wait() at the top of its loop. The
+ * 			call ends the previous cycle, applies the overrun policy and
+ * 			blocks until the next release:
+ *
+ * 				periodic_init(&xLoop, pdMS_TO_TICKS(1), pdMS_TO_TICKS(1),
+ * 						PERIODIC_OVERRUN_SKIP);
+ *
+ * 				while (1)
+ * 				{
+ * 					periodic_wait(&xLoop);
+ * 					... one cycle of work ...
+ * 				}
+ *
+ * 			Times are microseconds from the tick a release is due at, read
+ * 			from the tick count and the SysTick down-counter, so no timer is
+ * 			needed. Jitter is the time from that tick to the task running
+ * 			(tick interrupt, higher priority tasks, context switch). Response
+ * 			time is the time from that tick to the next periodic_wait(), and
+ * 			a cycle misses its deadline when it is longer than the deadline.
+ *
+ * 			The histograms have a bucket per power of two of microseconds
+ * 			(0-1, 2-3, 4-7, ...), with saturating 16-bit counts.
+ *
+ * 			With configUSE_EDF_SCHEDULING 1, periodic_wait() also sets the
+ * 			task's deadline for its next release, so tasks at
+ * 			configEDF_PRIORITY are scheduled earliest deadline first without
+ * 			further calls. periodic_edf_schedulable() checks a task set
+ * 			beforehand.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "periodic.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define PERIODIC_US_PER_TICK	(1000000UL / configTICK_RATE_HZ)
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t periodic_us_since(TickType_t xTick);
+static void periodic_record(uint16_t *pusHist, uint32_t *pulMaxUs, uint32_t ulUs);
+static void periodic_print_bucket(uint32_t ulBucket, uint16_t usJitter, uint16_t usResponse);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Initializes a periodic task's timing.
+ * @param pxPeriodic Timing to initialize.
+ * @param xPeriod Release period, in ticks.
+ * @param xDeadline Deadline from each release, in ticks; at most xPeriod.
+ * @param ePolicy What to do when a cycle runs past the next release.
+ * @retval None
+ * @note The first periodic_wait() releases the task one period later.
+ */
+void periodic_init(Periodic_t *pxPeriodic, TickType_t xPeriod, TickType_t xDeadline,
+		PeriodicPolicy_t ePolicy)
+{
+	configASSERT(xPeriod > 0U);
+
+	memset(pxPeriodic, 0, sizeof(*pxPeriodic));
+	pxPeriodic->xPeriod = xPeriod;
+	pxPeriodic->xDeadline = (xDeadline > xPeriod) ? xPeriod : xDeadline;
+	pxPeriodic->ulDeadlineUs = pxPeriodic->xDeadline * PERIODIC_US_PER_TICK;
+	pxPeriodic->ePolicy = ePolicy;
+}
+
+/**
+ * @brief Sets the task notified on each deadline miss under
+ * PERIODIC_OVERRUN_NOTIFY.
+ * @param pxPeriodic Timing.
+ * @param xTask Task to notify, e.g. a supervisor.
+ * @param ulNotifyBits Bits set in its notification value.
+ * @retval None
+ */
+void periodic_set_notify(Periodic_t *pxPeriodic, TaskHandle_t xTask, uint32_t ulNotifyBits)
+{
+	pxPeriodic->xNotifyTask = xTask;
+	pxPeriodic->ulNotifyBits = ulNotifyBits;
+}
+
+/**
+ * @brief Ends the current cycle and blocks until the next release.
+ * @param pxPeriodic Timing set up with periodic_init().
+ * @retval None
+ * @note Called by the periodic task only. When the cycle ran past one or more
+ * releases, PERIODIC_OVERRUN_CATCH_UP returns at once for each of them, as
+ * vTaskDelayUntil() does; the other policies drop those more than a tick late
+ * and count them as skipped.
+ */
+void periodic_wait(Periodic_t *pxPeriodic)
+{
+	uint32_t ulResponseUs;
+	uint32_t ulJitterUs;
+	TickType_t xElapsed;
+	TickType_t xMissed;
+
+	if (pxPeriodic->ucStarted == 0U)
+	{
+		pxPeriodic->xLastWake = xTaskGetTickCount();
+		pxPeriodic->ucStarted = 1U;
+	}
+	else
+	{
+		ulResponseUs = periodic_us_since(pxPeriodic->xLastWake);
+
+		taskENTER_CRITICAL();
+		{
+			periodic_record(pxPeriodic->xStats.usResponse, &pxPeriodic->xStats.ulResponseMaxUs,
+					ulResponseUs);
+			pxPeriodic->xStats.ulCycles++;
+
+			if (ulResponseUs > pxPeriodic->ulDeadlineUs)
+			{
+				pxPeriodic->xStats.ulDeadlineMisses++;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if ((ulResponseUs > pxPeriodic->ulDeadlineUs)
+				&& (pxPeriodic->ePolicy == PERIODIC_OVERRUN_NOTIFY)
+				&& (pxPeriodic->xNotifyTask != NULL))
+		{
+			(void)xTaskNotify(pxPeriodic->xNotifyTask, pxPeriodic->ulNotifyBits, eSetBits);
+		}
+
+		xElapsed = xTaskGetTickCount() - pxPeriodic->xLastWake;
+
+		if ((pxPeriodic->ePolicy != PERIODIC_OVERRUN_CATCH_UP) && (xElapsed > pxPeriodic->xPeriod))
+		{
+			/* Drop the releases more than a tick in the past; one due now
+			 * still runs. */
+			xMissed = (xElapsed - 1U) / pxPeriodic->xPeriod;
+			pxPeriodic->xLastWake += xMissed * pxPeriodic->xPeriod;
+
+			taskENTER_CRITICAL();
+			pxPeriodic->xStats.ulSkipped += xMissed;
+			taskEXIT_CRITICAL();
+		}
+	}
+
+#if (configUSE_EDF_SCHEDULING == 1)
+	/* Ordered by it from the moment the next release makes the task ready. */
+	vTaskSetDeadline(NULL, pxPeriodic->xLastWake + pxPeriodic->xPeriod + pxPeriodic->xDeadline);
+#endif
+
+	vTaskDelayUntil(&pxPeriodic->xLastWake, pxPeriodic->xPeriod);
+
+	ulJitterUs = periodic_us_since(pxPeriodic->xLastWake);
+
+	taskENTER_CRITICAL();
+	periodic_record(pxPeriodic->xStats.usJitter, &pxPeriodic->xStats.ulJitterMaxUs, ulJitterUs);
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Copies the statistics of a periodic task.
+ * @param pxPeriodic Timing.
+ * @param pxStats Receives the statistics.
+ * @retval None
+ * @note From any task; the copy is consistent.
+ */
+void periodic_get_stats(const Periodic_t *pxPeriodic, PeriodicStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = pxPeriodic->xStats;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Clears the statistics of a periodic task, e.g. after start-up.
+ * @param pxPeriodic Timing.
+ * @retval None
+ */
+void periodic_reset_stats(Periodic_t *pxPeriodic)
+{
+	taskENTER_CRITICAL();
+	memset(&pxPeriodic->xStats, 0, sizeof(pxPeriodic->xStats));
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Prints the statistics and the non-empty histogram buckets of a
+ * periodic task with printf().
+ * @param pxPeriodic Timing.
+ * @param pcName Name printed in the heading.
+ * @retval None
+ */
+void periodic_print(const Periodic_t *pxPeriodic, const char *pcName)
+{
+	PeriodicStats_t xStats;
+	uint32_t i;
+
+	periodic_get_stats(pxPeriodic, &xStats);
+
+	printf("%s: %lu cycles, %lu deadline misses, %lu skipped\r\n", pcName,
+			xStats.ulCycles, xStats.ulDeadlineMisses, xStats.ulSkipped);
+	printf("  max jitter %lu us, max response %lu us (deadline %lu us)\r\n",
+			xStats.ulJitterMaxUs, xStats.ulResponseMaxUs, pxPeriodic->ulDeadlineUs);
+	printf("  us              Jitter  Response\r\n");
+
+	for (i = 0; i < PERIODIC_HIST_BUCKETS; i++)
+	{
+		if ((xStats.usJitter[i] != 0U) || (xStats.usResponse[i] != 0U))
+		{
+			periodic_print_bucket(i, xStats.usJitter[i], xStats.usResponse[i]);
+		}
+	}
+}
+
+/**
+ * @brief Checks that earliest deadline first scheduling meets every deadline
+ * of a set of periodic tasks.
+ * @param pxSpecs The tasks of the EDF band. Work of higher priorities, which
+ * preempts them all, must be added as a task of its own.
+ * @param ulCount Number of tasks.
+ * @param pulDensityPpm If not NULL, receives the density of the set, the sum
+ * of WCET / min(deadline, period), in parts per million.
+ * @retval pdTRUE if the density is at most 1, pdFALSE otherwise.
+ * @note Exact when every deadline equals its period (utilization test), and
+ * sufficient for shorter deadlines. Rate monotonic priorities only guarantee
+ * a utilization of about 69 % for large sets.
+ */
+BaseType_t periodic_edf_schedulable(const PeriodicSpec_t *pxSpecs, uint32_t ulCount,
+		uint32_t *pulDensityPpm)
+{
+	uint64_t ullDensityPpm = 0;
+	uint32_t ulWindowUs;
+	uint32_t i;
+
+	for (i = 0; i < ulCount; i++)
+	{
+		ulWindowUs = pxSpecs[i].ulDeadlineUs;
+
+		if ((ulWindowUs == 0U) || (ulWindowUs > pxSpecs[i].ulPeriodUs))
+		{
+			ulWindowUs = pxSpecs[i].ulPeriodUs;
+		}
+
+		if (ulWindowUs == 0U)
+		{
+			return pdFALSE;
+		}
+
+		/* Rounded up, so the test never errs on the optimistic side. */
+		ullDensityPpm += (((uint64_t)pxSpecs[i].ulWcetUs * 1000000U) + ulWindowUs - 1U) / ulWindowUs;
+	}
+
+	if (pulDensityPpm != NULL)
+	{
+		*pulDensityPpm = (ullDensityPpm > UINT32_MAX) ? UINT32_MAX : (uint32_t)ullDensityPpm;
+	}
+
+	return (ullDensityPpm <= 1000000U) ? pdTRUE : pdFALSE;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Returns the time since the start of a tick.
+ * @param xTick Tick count, not in the future.
+ * @retval Microseconds.
+ * @note The tick count and SysTick are read in a critical section, which
+ * holds off the tick interrupt. If SysTick has reloaded but its interrupt is
+ * still pending, the tick count is one behind: SysTick is read again and the
+ * tick counted.
+ */
+static uint32_t periodic_us_since(TickType_t xTick)
+{
+	uint32_t ulLoad;
+	uint32_t ulValue;
+	TickType_t xNow;
+
+	taskENTER_CRITICAL();
+	{
+		ulLoad = SysTick->LOAD;
+		ulValue = SysTick->VAL;
+		xNow = xTaskGetTickCount();
+
+		if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0U)
+		{
+			ulValue = SysTick->VAL;
+			xNow++;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return ((xNow - xTick) * PERIODIC_US_PER_TICK)
+			+ (uint32_t)(((uint64_t)(ulLoad - ulValue) * 1000000U) / SystemCoreClock);
+}
+
+/**
+ * @brief Adds a sample to a histogram and its maximum.
+ * @param pusHist Histogram of PERIODIC_HIST_BUCKETS buckets.
+ * @param pulMaxUs Maximum so far.
+ * @param ulUs Sample.
+ * @retval None
+ */
+static void periodic_record(uint16_t *pusHist, uint32_t *pulMaxUs, uint32_t ulUs)
+{
+	uint32_t ulBucket = (ulUs < 2U) ? 0U : (31U - (uint32_t)__CLZ(ulUs));
+
+	if (ulBucket >= PERIODIC_HIST_BUCKETS)
+	{
+		ulBucket = PERIODIC_HIST_BUCKETS - 1U;
+	}
+
+	if (pusHist[ulBucket] != UINT16_MAX)
+	{
+		pusHist[ulBucket]++;
+	}
+
+	if (ulUs > *pulMaxUs)
+	{
+		*pulMaxUs = ulUs;
+	}
+}
+
+/**
+ * @brief Prints one histogram row.
+ * @param ulBucket Bucket index.
+ * @param usJitter Jitter count.
+ * @param usResponse Response time count.
+ * @retval None
+ */
+static void periodic_print_bucket(uint32_t ulBucket, uint16_t usJitter, uint16_t usResponse)
+{
+	const uint32_t ulLow = (ulBucket == 0U) ? 0U : (1UL << ulBucket);
+
+	if (ulBucket == (PERIODIC_HIST_BUCKETS - 1U))
+	{
+		printf("  >= %-10lu  %8u  %8u\r\n", ulLow, usJitter, usResponse);
+	}
+	else
+	{
+		printf("  %5lu-%-7lu  %8u  %8u\r\n", ulLow, (2UL << ulBucket) - 1U, usJitter, usResponse);
+	}
+}
@@ -0,0 +1,359 @@
+/*******************************************************************************
+ *
+ * @file	pwm.c
+ * @brief	Implementation of the hardware PWM pattern player (LEDs, actuators).
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	Dims LEDs and drives actuators with the timer instead of a task
+ * 			toggling a pin in a loop: once a pattern is posted, no code runs
+ * 			until the next one. TIM1 generates PWM_FREQUENCY_HZ PWM on
+ * 			PWM_CHANNELS channels, counting to PWM_LEVELS so a level is a
+ * 			duty cycle in steps of 0.1 %, whatever the clock.
+ *
+ * 			A pattern is a table of frames, one level per channel. The
+ * 			repetition counter raises an update event every few PWM
+ * 			periods, the step rate given to pwm_open(); each update asks
+ * 			for a DMA burst (DCR, DMAR) that writes the next frame into
+ * 			CCR1 onwards. The compare registers are preloaded, so a frame
+ * 			takes effect on the following update and never mid-period.
+ * 			Looping patterns go round in circular mode (dma_start_ring());
+ * 			the others are one descriptor and the last frame holds.
+ *
+ * 			The repetition counter is 8 bits: the step rate is
+ * 			PWM_FREQUENCY_HZ / 256 (78 Hz) to PWM_FREQUENCY_HZ. TIM1 is
+ * 			free since the HAL time base follows the RTOS tick
+ * 			(stm32f4xx_hal_timebase_tim.c). Its update request is on DMA2
+ * 			stream 5, which the USART1 console takes when enabled (uart.h).
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "clkgate.h"
+#include "dma.h"
+#include "pwm.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define PWM_AF_TIM1				1U
+#define PWM_FIRST_PIN			8U			/* PA8: CH1. */
+#define TIM_CR1_CEN_OFS			0U
+#define TIM_CR1_ARPE_OFS		7U
+#define TIM_EGR_UG_OFS			0U
+#define TIM_DIER_UDE_OFS		8U
+#define TIM_CCMR_OCPE_OFS		3U			/* Per channel, shift by 8 for the second. */
+#define TIM_CCMR_OCM_OFS		4U
+#define TIM_CCMR_OCM_PWM1		6U
+#define TIM_CCER_CCE_OFS		0U			/* Per channel, shift by 4. */
+#define TIM_BDTR_MOE_OFS		15U
+#define TIM_DCR_DBA_CCR1		13U			/* CCR1 offset 0x34, in words. */
+#define TIM_DCR_DBL_OFS			8U
+
+#if (PWM_CHANNELS < 1U) || (PWM_CHANNELS > 4U)
+#error "PWM_CHANNELS must be 1 to 4"
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint8_t ucOpen;
+	uint32_t ulStepHz;
+	DmaStream_t *pxStream;
+	DmaDesc_t xDesc;				/* The one-shot pattern playing. */
+	SemaphoreHandle_t xLock;
+	StaticSemaphore_t xLockBuffer;
+	ClkGateUser_t xTimerClock;
+	ClkGateUser_t xPortClock;
+} PwmState_t;
+
+/* Variables -----------------------------------------------------------------*/
+static PwmState_t xPwm;
+
+/* Private function prototypes -----------------------------------------------*/
+static void pwm_stop(void);
+static uint32_t pwm_get_clock_hz(void);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Starts the PWM outputs, all off.
+ * @param ulStepHz Frame rate of the patterns, PWM_FREQUENCY_HZ / 256 to
+ * PWM_FREQUENCY_HZ; rounded to a divisor of PWM_FREQUENCY_HZ.
+ * @retval 0 if successful, -1 if already open, the rate is out of range, TIM1
+ * is in use or its DMA stream is taken.
+ * @note Call from a task.
+ */
+int32_t pwm_open(uint32_t ulStepHz)
+{
+	DmaConfig_t xCfg;
+	uint32_t ulRepeat;
+	uint32_t ulPin;
+	uint32_t ulShift2;
+	uint32_t ulShift4;
+
+	if ((xPwm.ucOpen != 0U) || (ulStepHz == 0U) || (ulStepHz > PWM_FREQUENCY_HZ))
+	{
+		return -1;
+	}
+
+	ulRepeat = PWM_FREQUENCY_HZ / ulStepHz;
+
+	if ((ulRepeat > 256U) || (clkgate_get_users(CLKGATE_TIM1) != 0U))
+	{
+		return -1;
+	}
+
+	/* Each update writes one frame: PWM_CHANNELS halfwords. */
+	xCfg.xRequest = DMA_REQ_TIM1_UP;
+	xCfg.xDir = DMA_DIR_M2P;
+	xCfg.ucPriority = DMA_PL_MEDIUM;
+	xCfg.ucItemSize = 2U;
+	xCfg.ucPeriphInc = 0U;
+	xCfg.ucMemInc = 1U;
+	xCfg.pvPeriph = &TIM1->DMAR;
+	xCfg.ulBandwidth = ulStepHz * PWM_CHANNELS * 2U;
+
+	if (dma_alloc(&xCfg, &xPwm.pxStream) != 0)
+	{
+		return -1;
+	}
+
+	clkgate_user_init(&xPwm.xTimerClock, CLKGATE_TIM1);
+	clkgate_user_init(&xPwm.xPortClock, CLKGATE_GPIOA);
+	clkgate_acquire(&xPwm.xTimerClock);
+	clkgate_acquire(&xPwm.xPortClock);
+
+	TIM1->CR1 = 0;
+	TIM1->CR2 = 0;
+	TIM1->SMCR = 0;
+	TIM1->DIER = 0;
+	TIM1->CCER = 0;
+	TIM1->PSC = (pwm_get_clock_hz() / (PWM_FREQUENCY_HZ * PWM_LEVELS)) - 1U;
+	TIM1->ARR = PWM_LEVELS - 1U;
+	TIM1->RCR = ulRepeat - 1U;
+	TIM1->CCR1 = 0;
+	TIM1->CCR2 = 0;
+	TIM1->CCR3 = 0;
+	TIM1->CCR4 = 0;
+
+	/* PWM mode 1, preloaded, on each channel; CCMR1 holds CH1 and CH2. */
+	TIM1->CCMR1 = 0;
+	TIM1->CCMR2 = 0;
+
+	for (ulPin = 0; ulPin < PWM_CHANNELS; ulPin++)
+	{
+		volatile uint32_t *pulCcmr = (ulPin < 2U) ? &TIM1->CCMR1 : &TIM1->CCMR2;
+
+		*pulCcmr |= ((TIM_CCMR_OCM_PWM1 << TIM_CCMR_OCM_OFS) | (1U << TIM_CCMR_OCPE_OFS))
+				<< (8U * (ulPin & 1U));
+		TIM1->CCER |= (1U << (TIM_CCER_CCE_OFS + (4U * ulPin)));
+	}
+
+	/* Bursts of PWM_CHANNELS writes, from CCR1. */
+	TIM1->DCR = TIM_DCR_DBA_CCR1 | ((PWM_CHANNELS - 1U) << TIM_DCR_DBL_OFS);
+
+	TIM1->EGR = (1U << TIM_EGR_UG_OFS);
+	TIM1->BDTR = (1U << TIM_BDTR_MOE_OFS);
+	TIM1->CR1 = (1U << TIM_CR1_ARPE_OFS) | (1U << TIM_CR1_CEN_OFS);
+
+	for (ulPin = PWM_FIRST_PIN; ulPin < (PWM_FIRST_PIN + PWM_CHANNELS); ulPin++)
+	{
+		ulShift2 = 2U * ulPin;
+		ulShift4 = 4U * (ulPin & 7U);
+		GPIOA->AFR[1] = (GPIOA->AFR[1] & ~(0xFU << ulShift4)) | (PWM_AF_TIM1 << ulShift4);
+		GPIOA->OTYPER &= ~(1U << ulPin);
+		GPIOA->PUPDR &= ~(3U << ulShift2);
+		GPIOA->MODER = (GPIOA->MODER & ~(3U << ulShift2)) | (2U << ulShift2);
+	}
+
+	if (xPwm.xLock == NULL)
+	{
+		xPwm.xLock = xSemaphoreCreateMutexStatic(&xPwm.xLockBuffer);
+	}
+
+	xPwm.ulStepHz = PWM_FREQUENCY_HZ / ulRepeat;
+	xPwm.ucOpen = 1;
+
+	return 0;
+}
+
+/**
+ * @brief Stops the PWM outputs.
+ * @retval None
+ * @note The pins are left as outputs driving low, so the LEDs stay off.
+ */
+void pwm_close(void)
+{
+	uint32_t ulPin;
+
+	if (xPwm.ucOpen == 0U)
+	{
+		return;
+	}
+
+	(void)xSemaphoreTake(xPwm.xLock, portMAX_DELAY);
+
+	pwm_stop();
+
+	for (ulPin = PWM_FIRST_PIN; ulPin < (PWM_FIRST_PIN + PWM_CHANNELS); ulPin++)
+	{
+		GPIOA->BSRR = (1U << (ulPin + 16U));
+		GPIOA->MODER = (GPIOA->MODER & ~(3U << (2U * ulPin))) | (1U << (2U * ulPin));
+	}
+
+	TIM1->BDTR = 0;
+	TIM1->CR1 = 0;
+	dma_free(xPwm.pxStream);
+	clkgate_release(&xPwm.xTimerClock);
+	clkgate_release(&xPwm.xPortClock);
+	xPwm.ucOpen = 0;
+
+	(void)xSemaphoreGive(xPwm.xLock);
+}
+
+/**
+ * @brief Replaces what plays with a pattern.
+ * @param pxPattern Pattern; its frames must stay in place until the next
+ * pwm_play(), pwm_set() or pwm_close().
+ * @retval 0 if successful, -1 if not open or the pattern is empty or too long.
+ * @note Call from a task. Returns at once: the first frame takes effect
+ * within two steps.
+ */
+int32_t pwm_play(const PwmPattern_t *pxPattern)
+{
+	int32_t lResult;
+
+	if ((xPwm.ucOpen == 0U) || (pxPattern == NULL) || (pxPattern->pusFrames == NULL)
+			|| (pxPattern->ulFrames == 0U)
+			|| (pxPattern->ulFrames > (DMA_MAX_ITEMS / PWM_CHANNELS)))
+	{
+		return -1;
+	}
+
+	(void)xSemaphoreTake(xPwm.xLock, portMAX_DELAY);
+
+	pwm_stop();
+
+	if (pxPattern->ucLoop != 0U)
+	{
+		lResult = dma_start_ring(xPwm.pxStream, (void *)pxPattern->pusFrames,
+				pxPattern->ulFrames * PWM_CHANNELS);
+	}
+	else
+	{
+		dma_desc_init(&xPwm.xDesc, NULL, (void *)pxPattern->pusFrames,
+				pxPattern->ulFrames * PWM_CHANNELS);
+		lResult = dma_submit(xPwm.pxStream, &xPwm.xDesc);
+	}
+
+	if (lResult == 0)
+	{
+		TIM1->DIER |= (1U << TIM_DIER_UDE_OFS);
+	}
+
+	(void)xSemaphoreGive(xPwm.xLock);
+
+	return lResult;
+}
+
+/**
+ * @brief Stops any pattern and sets fixed levels.
+ * @param pusLevels PWM_CHANNELS levels, 0 to PWM_LEVELS.
+ * @retval 0 if successful, -1 if not open.
+ * @note Call from a task. The levels take effect at the next step.
+ */
+int32_t pwm_set(const uint16_t *pusLevels)
+{
+	volatile uint32_t *pulCcr = &TIM1->CCR1;
+	uint32_t i;
+
+	if ((xPwm.ucOpen == 0U) || (pusLevels == NULL))
+	{
+		return -1;
+	}
+
+	(void)xSemaphoreTake(xPwm.xLock, portMAX_DELAY);
+
+	pwm_stop();
+
+	for (i = 0; i < PWM_CHANNELS; i++)
+	{
+		pulCcr[i] = (pusLevels[i] < PWM_LEVELS) ? pusLevels[i] : PWM_LEVELS;
+	}
+
+	(void)xSemaphoreGive(xPwm.xLock);
+
+	return 0;
+}
+
+/**
+ * @brief Tells whether a pattern is still playing.
+ * @retval 1 for a looping pattern, or a one-shot one before its last frame,
+ * 0 otherwise.
+ */
+uint32_t pwm_is_playing(void)
+{
+	return ((xPwm.ucOpen != 0U) && (dma_get_remaining(xPwm.pxStream) != 0U)) ? 1U : 0U;
+}
+
+/**
+ * @brief Fills one channel of a frame table with a linear ramp.
+ * @param pusFrames Frame table, PWM_CHANNELS levels per frame.
+ * @param ulFrames Frames of the ramp.
+ * @param ulChannel Channel, 0 to PWM_CHANNELS - 1.
+ * @param usFrom Level of the first frame.
+ * @param usTo Level of the last frame.
+ * @retval None
+ * @note For fades: a ramp up then down, looped, is a breathing LED.
+ */
+void pwm_fill_ramp(uint16_t *pusFrames, uint32_t ulFrames, uint32_t ulChannel,
+		uint16_t usFrom, uint16_t usTo)
+{
+	int32_t lSpan = (int32_t)usTo - (int32_t)usFrom;
+	uint32_t i;
+
+	if ((pusFrames == NULL) || (ulChannel >= PWM_CHANNELS))
+	{
+		return;
+	}
+
+	for (i = 0; i < ulFrames; i++)
+	{
+		pusFrames[(i * PWM_CHANNELS) + ulChannel] = (ulFrames > 1U)
+				? (uint16_t)((int32_t)usFrom + ((lSpan * (int32_t)i) / (int32_t)(ulFrames - 1U)))
+				: usTo;
+	}
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Stops the pattern playing, the levels holding.
+ * @retval None
+ */
+static void pwm_stop(void)
+{
+	TIM1->DIER &= ~(1U << TIM_DIER_UDE_OFS);
+	dma_abort(xPwm.pxStream);
+
+	/* Writing DCR again restarts a burst cut short at CCR1. */
+	TIM1->DCR = TIM_DCR_DBA_CCR1 | ((PWM_CHANNELS - 1U) << TIM_DCR_DBL_OFS);
+}
+
+/**
+ * @brief Returns the clock of TIM1.
+ * @retval Hz: twice PCLK2 when APB2 is divided.
+ */
+static uint32_t pwm_get_clock_hz(void)
+{
+	uint32_t ulClock = HAL_RCC_GetPCLK2Freq();
+
+	if ((RCC->CFGR & RCC_CFGR_PPRE2) != RCC_CFGR_PPRE2_DIV1)
+	{
+		ulClock *= 2U;
+	}
+
+	return ulClock;
+}
@@ -0,0 +1,538 @@
+/*******************************************************************************
+ *
+ * @file	qspi.c
+ * @brief	Implementation of the Quad-SPI NOR flash driver.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	An external NOR flash on the QUADSPI (bank 1), register level,
+ * 			for constant data too large for the internal 512 KB: lookup
+ * 			tables, calibration data, models. qspi_map() puts the flash in
+ * 			memory-mapped mode at QSPI_XIP_BASE, where the CPU and the DMA
+ * 			read it by pointer with no copy into SRAM; the linker places
+ * 			QSPI_RODATA constants there.
+ *
+ * 			Reads use Fast Read Quad I/O (EBh): command on one line, then
+ * 			address and data on four, 6 dummy clocks; about 40 MB/s
+ * 			sequential at 90 MHz. The QUADSPI prefetches sequential data,
+ * 			but each read elsewhere costs about 20 clocks of command and
+ * 			address, and neither the ART accelerator nor a cache helps:
+ * 			keep what is read in tight loops in internal flash or SRAM.
+ *
+ * 			Commands are those of the W25Q family (Winbond) and its
+ * 			compatibles: quad enable in status register 2, 4 KB sectors,
+ * 			24-bit addresses (16 MB).
+ *
+ * 			Pins (AF9, NCS AF10): PB2 CLK, PB6 NCS, PC9 IO0, PC10 IO1,
+ * 			PC8 IO2, PA1 IO3. PC8 to PC10 are shared with the SDIO.
+ *
+ * 			qspi_erase() and qspi_program() leave memory-mapped mode while
+ * 			they run: nothing may read the flash by pointer meanwhile, or it
+ * 			faults. Use them at boot or for updates, from one task.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clkgate.h"
+#include "qspi.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define QSPI_CMD_WRITE_ENABLE		0x06U
+#define QSPI_CMD_READ_SR1			0x05U
+#define QSPI_CMD_READ_SR2			0x35U
+#define QSPI_CMD_WRITE_SR2			0x31U
+#define QSPI_CMD_READ_ID			0x9FU
+#define QSPI_CMD_QUAD_READ			0xEBU
+#define QSPI_CMD_QUAD_PROGRAM		0x32U
+#define QSPI_CMD_SECTOR_ERASE		0x20U
+#define QSPI_CMD_RESET_ENABLE		0x66U
+#define QSPI_CMD_RESET				0x99U
+
+#define QSPI_SR1_BUSY				(1U << 0)
+#define QSPI_SR2_QE					(1U << 1)
+
+/* CCR fields. */
+#define QSPI_FMODE_WRITE			(0U << QUADSPI_CCR_FMODE_Pos)
+#define QSPI_FMODE_READ				(1U << QUADSPI_CCR_FMODE_Pos)
+#define QSPI_FMODE_POLL				(2U << QUADSPI_CCR_FMODE_Pos)
+#define QSPI_FMODE_MAPPED			(3U << QUADSPI_CCR_FMODE_Pos)
+#define QSPI_IMODE_1				(1U << QUADSPI_CCR_IMODE_Pos)
+#define QSPI_ADMODE_1				(1U << QUADSPI_CCR_ADMODE_Pos)
+#define QSPI_ADMODE_4				(3U << QUADSPI_CCR_ADMODE_Pos)
+#define QSPI_ADSIZE_24				(2U << QUADSPI_CCR_ADSIZE_Pos)
+#define QSPI_ABMODE_4				(3U << QUADSPI_CCR_ABMODE_Pos)
+#define QSPI_DMODE_1				(1U << QUADSPI_CCR_DMODE_Pos)
+#define QSPI_DMODE_4				(3U << QUADSPI_CCR_DMODE_Pos)
+
+/* Mode byte of EBh, sent as an alternate byte: not Fxh continuous read. */
+#define QSPI_QUAD_READ_MODE			0xFFU
+#define QSPI_QUAD_READ_DUMMY		4U		/* After the 2 mode clocks. */
+
+#define QSPI_CS_HIGH_CLOCKS			5U		/* 55 ns at 90 MHz; 50 ns for writes. */
+#define QSPI_SPIN_TIMEOUT			1000000U
+#define QSPI_PROGRAM_TIMEOUT_MS		5U		/* 3 ms max per page. */
+#define QSPI_ERASE_TIMEOUT_MS		500U	/* 400 ms max per sector. */
+#define QSPI_SR_WRITE_TIMEOUT_MS	20U		/* 15 ms max. */
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	GPIO_TypeDef *pxPort;
+	ClkGate_t eClock;
+	uint8_t ucPin;
+	uint8_t ucAf;
+} QspiPin_t;
+
+typedef struct
+{
+	uint8_t ucOpen;
+	uint8_t ucMapped;
+	uint32_t ulId;
+	ClkGateUser_t xClock;
+} QspiState_t;
+
+/* Variables -----------------------------------------------------------------*/
+static const QspiPin_t xPins[] =
+{
+	{ GPIOB, CLKGATE_GPIOB, 2U, 9U },	/* CLK */
+	{ GPIOB, CLKGATE_GPIOB, 6U, 10U },	/* NCS */
+	{ GPIOC, CLKGATE_GPIOC, 9U, 9U },	/* IO0 */
+	{ GPIOC, CLKGATE_GPIOC, 10U, 9U },	/* IO1 */
+	{ GPIOC, CLKGATE_GPIOC, 8U, 9U },	/* IO2 */
+	{ GPIOA, CLKGATE_GPIOA, 1U, 9U },	/* IO3 */
+};
+
+static ClkGateUser_t xPinClocks[sizeof(xPins) / sizeof(xPins[0])];
+static QspiState_t xQspi;
+
+/* Private function prototypes -----------------------------------------------*/
+static void qspi_pin_init(const QspiPin_t *pxPin);
+static int32_t qspi_idle(void);
+static void qspi_unmap(void);
+static int32_t qspi_command(uint32_t ulCcr, uint32_t ulAddr, uint8_t *pucData, uint32_t ulLen);
+static int32_t qspi_write_enable(void);
+static int32_t qspi_wait_ready(uint32_t ulTimeoutMs);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Sets the QUADSPI up, resets the flash and enables its quad mode.
+ * @param None
+ * @retval 0 if successful, -1 if already open or no flash answers.
+ * @note Call from a task or before the scheduler starts. The first call on a
+ * new flash writes its status register (non-volatile, up to 15 ms).
+ */
+int32_t qspi_open(void)
+{
+	uint32_t ulPin;
+	uint8_t ucData[3];
+
+	if (xQspi.ucOpen != 0U)
+	{
+		return -1;
+	}
+
+	clkgate_user_init(&xQspi.xClock, CLKGATE_QSPI);
+	clkgate_acquire(&xQspi.xClock);
+
+	for (ulPin = 0; ulPin < (sizeof(xPins) / sizeof(xPins[0])); ulPin++)
+	{
+		clkgate_user_init(&xPinClocks[ulPin], xPins[ulPin].eClock);
+		clkgate_acquire(&xPinClocks[ulPin]);
+		qspi_pin_init(&xPins[ulPin]);
+	}
+
+	QUADSPI->CR = 0;
+	QUADSPI->DCR = ((31U - __CLZ(QSPI_FLASH_BYTES) - 1U) << QUADSPI_DCR_FSIZE_Pos)
+			| ((QSPI_CS_HIGH_CLOCKS - 1U) << QUADSPI_DCR_CSHT_Pos);
+	QUADSPI->LPTR = QSPI_IDLE_RELEASE_CLOCKS;
+
+	/* Sample half a clock late: the flash's output delay at high clocks. */
+	QUADSPI->CR = (QSPI_PRESCALER << QUADSPI_CR_PRESCALER_Pos) | QUADSPI_CR_SSHIFT
+			| QUADSPI_CR_EN;
+
+	/* A reset first: the flash may be left mid-command by a CPU reset. */
+	if ((qspi_command(QSPI_CMD_RESET_ENABLE | QSPI_IMODE_1, 0U, NULL, 0U) != 0)
+			|| (qspi_command(QSPI_CMD_RESET | QSPI_IMODE_1, 0U, NULL, 0U) != 0))
+	{
+		QUADSPI->CR = 0;
+		clkgate_release(&xQspi.xClock);
+		return -1;
+	}
+
+	HAL_Delay(1U);		/* tRST: 30 us. */
+
+	if (qspi_command(QSPI_CMD_READ_ID | QSPI_IMODE_1 | QSPI_DMODE_1 | QSPI_FMODE_READ, 0U,
+			ucData, sizeof(ucData)) != 0)
+	{
+		QUADSPI->CR = 0;
+		clkgate_release(&xQspi.xClock);
+		return -1;
+	}
+
+	xQspi.ulId = ((uint32_t)ucData[0] << 16) | ((uint32_t)ucData[1] << 8) | ucData[2];
+
+	/* Lines that float high or low: nothing there. */
+	if ((xQspi.ulId == 0U) || (xQspi.ulId == 0xFFFFFFU)
+			|| (qspi_command(QSPI_CMD_READ_SR2 | QSPI_IMODE_1 | QSPI_DMODE_1 | QSPI_FMODE_READ, 0U,
+					ucData, 1U) != 0))
+	{
+		QUADSPI->CR = 0;
+		clkgate_release(&xQspi.xClock);
+		return -1;
+	}
+
+	/* IO2 and IO3 are /WP and /HOLD until quad mode is enabled. */
+	if ((ucData[0] & QSPI_SR2_QE) == 0U)
+	{
+		ucData[0] |= QSPI_SR2_QE;
+
+		if ((qspi_write_enable() != 0)
+				|| (qspi_command(QSPI_CMD_WRITE_SR2 | QSPI_IMODE_1 | QSPI_DMODE_1, 0U, ucData, 1U) != 0)
+				|| (qspi_wait_ready(QSPI_SR_WRITE_TIMEOUT_MS) != 0))
+		{
+			QUADSPI->CR = 0;
+			clkgate_release(&xQspi.xClock);
+			return -1;
+		}
+	}
+
+	xQspi.ucOpen = 1;
+
+	return 0;
+}
+
+/**
+ * @brief Returns the JEDEC ID of the flash.
+ * @param None
+ * @retval Manufacturer, type and capacity bytes (EF4018h for a W25Q128), 0
+ * if not open.
+ */
+uint32_t qspi_get_id(void)
+{
+	return (xQspi.ucOpen != 0U) ? xQspi.ulId : 0U;
+}
+
+/**
+ * @brief Maps the flash at QSPI_XIP_BASE for reads by pointer.
+ * @param None
+ * @retval 0 if successful, -1 if not open.
+ * @note Stays mapped, across erases and programs, until reset.
+ */
+int32_t qspi_map(void)
+{
+	if (xQspi.ucOpen == 0U)
+	{
+		return -1;
+	}
+
+	if (xQspi.ucMapped == 0U)
+	{
+		if (qspi_idle() != 0)
+		{
+			return -1;
+		}
+
+		/* Release the chip select when idle, see QSPI_IDLE_RELEASE_CLOCKS. */
+		QUADSPI->CR |= QUADSPI_CR_TCEN;
+		QUADSPI->ABR = QSPI_QUAD_READ_MODE;
+		QUADSPI->CCR = QSPI_CMD_QUAD_READ | QSPI_IMODE_1 | QSPI_ADMODE_4 | QSPI_ADSIZE_24
+				| QSPI_ABMODE_4 | (QSPI_QUAD_READ_DUMMY << QUADSPI_CCR_DCYC_Pos) | QSPI_DMODE_4
+				| QSPI_FMODE_MAPPED;
+		xQspi.ucMapped = 1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Erases the 4 KB sectors that hold a range.
+ * @param ulAddr Start, from the start of the flash, sector aligned.
+ * @param ulLen Bytes, rounded up to whole sectors.
+ * @retval 0 if successful, -1 if out of range or the flash fails.
+ * @note Sleeps while each sector erases (45 ms typical). See the note at the
+ * top about memory-mapped reads.
+ */
+int32_t qspi_erase(uint32_t ulAddr, uint32_t ulLen)
+{
+	const uint8_t ucWasMapped = xQspi.ucMapped;
+	int32_t lResult = 0;
+	uint32_t ulEnd;
+
+	if ((xQspi.ucOpen == 0U) || ((ulAddr % QSPI_SECTOR_BYTES) != 0U)
+			|| (ulAddr >= QSPI_FLASH_BYTES) || (ulLen > (QSPI_FLASH_BYTES - ulAddr)))
+	{
+		return -1;
+	}
+
+	qspi_unmap();
+
+	for (ulEnd = ulAddr + ulLen; (lResult == 0) && (ulAddr < ulEnd); ulAddr += QSPI_SECTOR_BYTES)
+	{
+		if ((qspi_write_enable() != 0)
+				|| (qspi_command(QSPI_CMD_SECTOR_ERASE | QSPI_IMODE_1 | QSPI_ADMODE_1 | QSPI_ADSIZE_24,
+						ulAddr, NULL, 0U) != 0)
+				|| (qspi_wait_ready(QSPI_ERASE_TIMEOUT_MS) != 0))
+		{
+			lResult = -1;
+		}
+	}
+
+	if (ucWasMapped != 0U)
+	{
+		(void)qspi_map();
+	}
+
+	return lResult;
+}
+
+/**
+ * @brief Programs erased flash.
+ * @param ulAddr Start, from the start of the flash.
+ * @param pvData Bytes.
+ * @param ulLen Number of bytes.
+ * @retval 0 if successful, -1 if out of range or the flash fails.
+ * @note Writes up to a page at a time, data on four lines (0.7 ms per page
+ * typical). See the note at the top about memory-mapped reads.
+ */
+int32_t qspi_program(uint32_t ulAddr, const void *pvData, uint32_t ulLen)
+{
+	const uint8_t ucWasMapped = xQspi.ucMapped;
+	const uint8_t *pucData = (const uint8_t *)pvData;
+	int32_t lResult = 0;
+	uint32_t ulChunk;
+
+	if ((xQspi.ucOpen == 0U) || (pvData == NULL) || (ulAddr >= QSPI_FLASH_BYTES)
+			|| (ulLen > (QSPI_FLASH_BYTES - ulAddr)))
+	{
+		return -1;
+	}
+
+	qspi_unmap();
+
+	while ((lResult == 0) && (ulLen != 0U))
+	{
+		/* A page program wraps within its page. */
+		ulChunk = QSPI_PAGE_BYTES - (ulAddr % QSPI_PAGE_BYTES);
+
+		if (ulChunk > ulLen)
+		{
+			ulChunk = ulLen;
+		}
+
+		if ((qspi_write_enable() != 0)
+				|| (qspi_command(QSPI_CMD_QUAD_PROGRAM | QSPI_IMODE_1 | QSPI_ADMODE_1 | QSPI_ADSIZE_24
+						| QSPI_DMODE_4, ulAddr, (uint8_t *)pucData, ulChunk) != 0)
+				|| (qspi_wait_ready(QSPI_PROGRAM_TIMEOUT_MS) != 0))
+		{
+			lResult = -1;
+		}
+
+		ulAddr += ulChunk;
+		pucData += ulChunk;
+		ulLen -= ulChunk;
+	}
+
+	if (ucWasMapped != 0U)
+	{
+		(void)qspi_map();
+	}
+
+	return lResult;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Configures a QUADSPI pin.
+ * @param pxPin Pin (clock enabled).
+ * @retval None
+ */
+static void qspi_pin_init(const QspiPin_t *pxPin)
+{
+	GPIO_TypeDef *pxPort = pxPin->pxPort;
+	const uint32_t ulPin = pxPin->ucPin;
+	const uint32_t ulShift2 = 2U * ulPin;
+	const uint32_t ulShift4 = 4U * (ulPin & 7U);
+
+	pxPort->AFR[ulPin >> 3] = (pxPort->AFR[ulPin >> 3] & ~(0xFU << ulShift4))
+			| ((uint32_t)pxPin->ucAf << ulShift4);
+	pxPort->OTYPER &= ~(1U << ulPin);
+	pxPort->OSPEEDR |= (3U << ulShift2);
+	pxPort->PUPDR &= ~(3U << ulShift2);
+	pxPort->MODER = (pxPort->MODER & ~(3U << ulShift2)) | (2U << ulShift2);
+}
+
+/**
+ * @brief Waits until the QUADSPI has finished its last command.
+ * @param None
+ * @retval 0 if idle, -1 on timeout.
+ */
+static int32_t qspi_idle(void)
+{
+	uint32_t ulTimeout = QSPI_SPIN_TIMEOUT;
+
+	while ((QUADSPI->SR & QUADSPI_SR_BUSY) != 0U)
+	{
+		if (--ulTimeout == 0U)
+		{
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Leaves memory-mapped mode, for an indirect command.
+ * @param None
+ * @retval None
+ * @note Aborting also ends the prefetch, which otherwise keeps the QUADSPI
+ * busy until the chip select is released.
+ */
+static void qspi_unmap(void)
+{
+	if (xQspi.ucMapped != 0U)
+	{
+		QUADSPI->CR |= QUADSPI_CR_ABORT;
+
+		while ((QUADSPI->CR & QUADSPI_CR_ABORT) != 0U)
+		{
+		}
+
+		QUADSPI->CR &= ~QUADSPI_CR_TCEN;
+		(void)qspi_idle();
+		xQspi.ucMapped = 0;
+	}
+}
+
+/**
+ * @brief Runs an indirect command, polling the FIFO.
+ * @param ulCcr Instruction, line modes and QSPI_FMODE_READ or _WRITE.
+ * @param ulAddr Address, if ulCcr has an address phase.
+ * @param pucData Data to send or receive, if ulCcr has a data phase.
+ * @param ulLen Data bytes.
+ * @retval 0 if successful, -1 on timeout.
+ * @note The command starts with the last register its phases need: CCR,
+ * then AR if there is an address, then DR if data is sent.
+ */
+static int32_t qspi_command(uint32_t ulCcr, uint32_t ulAddr, uint8_t *pucData, uint32_t ulLen)
+{
+	uint32_t ulTimeout;
+	uint32_t ulIndex;
+
+	if (qspi_idle() != 0)
+	{
+		return -1;
+	}
+
+	QUADSPI->FCR = QUADSPI_FCR_CTCF | QUADSPI_FCR_CTEF;
+
+	if (ulLen != 0U)
+	{
+		QUADSPI->DLR = ulLen - 1U;
+	}
+
+	QUADSPI->CCR = ulCcr;
+
+	if ((ulCcr & QUADSPI_CCR_ADMODE_Msk) != 0U)
+	{
+		QUADSPI->AR = ulAddr;
+	}
+
+	for (ulIndex = 0; ulIndex < ulLen; ulIndex++)
+	{
+		/* A byte of room, or of data (the threshold is 1 byte). */
+		for (ulTimeout = QSPI_SPIN_TIMEOUT; (QUADSPI->SR & QUADSPI_SR_FTF) == 0U; ulTimeout--)
+		{
+			if (ulTimeout == 0U)
+			{
+				QUADSPI->CR |= QUADSPI_CR_ABORT;
+				return -1;
+			}
+		}
+
+		if ((ulCcr & QUADSPI_CCR_FMODE_Msk) == QSPI_FMODE_READ)
+		{
+			pucData[ulIndex] = *(volatile uint8_t *)&QUADSPI->DR;
+		}
+		else
+		{
+			*(volatile uint8_t *)&QUADSPI->DR = pucData[ulIndex];
+		}
+	}
+
+	for (ulTimeout = QSPI_SPIN_TIMEOUT; (QUADSPI->SR & QUADSPI_SR_TCF) == 0U; ulTimeout--)
+	{
+		if (ulTimeout == 0U)
+		{
+			QUADSPI->CR |= QUADSPI_CR_ABORT;
+			return -1;
+		}
+	}
+
+	QUADSPI->FCR = QUADSPI_FCR_CTCF;
+
+	return 0;
+}
+
+/**
+ * @brief Sends Write Enable, needed before each program, erase or register
+ * write.
+ * @param None
+ * @retval 0 if successful, -1 otherwise.
+ */
+static int32_t qspi_write_enable(void)
+{
+	return qspi_command(QSPI_CMD_WRITE_ENABLE | QSPI_IMODE_1, 0U, NULL, 0U);
+}
+
+/**
+ * @brief Waits until the flash has finished programming or erasing.
+ * @param ulTimeoutMs Longest the operation may take.
+ * @retval 0 if ready, -1 on timeout.
+ * @note The QUADSPI polls the status register itself (auto-polling) until
+ * BUSY clears; the CPU sleeps a tick at a time meanwhile, or spins before
+ * the scheduler starts and for programs, which take under a tick.
+ */
+static int32_t qspi_wait_ready(uint32_t ulTimeoutMs)
+{
+	const uint32_t ulSleep = ((ulTimeoutMs > QSPI_PROGRAM_TIMEOUT_MS)
+			&& (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)) ? 1U : 0U;
+	const uint32_t ulStart = HAL_GetTick();
+
+	if (qspi_idle() != 0)
+	{
+		return -1;
+	}
+
+	QUADSPI->FCR = QUADSPI_FCR_CSMF;
+	QUADSPI->PSMKR = QSPI_SR1_BUSY;
+	QUADSPI->PSMAR = 0U;
+	QUADSPI->PIR = 16U;
+	QUADSPI->DLR = 0U;
+	QUADSPI->CR = (QUADSPI->CR & ~QUADSPI_CR_PMM) | QUADSPI_CR_APMS;
+	QUADSPI->CCR = QSPI_CMD_READ_SR1 | QSPI_IMODE_1 | QSPI_DMODE_1 | QSPI_FMODE_POLL;
+
+	while ((QUADSPI->SR & QUADSPI_SR_SMF) == 0U)
+	{
+		if ((HAL_GetTick() - ulStart) > ulTimeoutMs)
+		{
+			QUADSPI->CR |= QUADSPI_CR_ABORT;
+			return -1;
+		}
+
+		if (ulSleep != 0U)
+		{
+			vTaskDelay(1);
+		}
+	}
+
+	QUADSPI->FCR = QUADSPI_FCR_CSMF;
+
+	/* APMS ends the command on the match. */
+	return qspi_idle();
+}
@@ -0,0 +1,616 @@
+/*******************************************************************************
+ *
+ * @file	rqueue.c
+ * @brief	Remote queues carried between boards over UART links.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	A link joins two boards over one uart.c port, opened with TX and
+ * 			RX buffers by the application. It carries up to RQUEUE_CHANNELS
+ * 			channels each way. On the sending board a channel is an
+ * 			RqProxy_t, written with rqueue_send() like a queue; on the other
+ * 			board an RqEndpoint_t replays its items into an ordinary local
+ * 			queue, read with xQueueReceive().
+ *
+ * 			Items are batched: rqueue_send() appends a record (channel,
+ * 			length, sequence number, item) to the link's batch, and the batch
+ * 			goes out as one COBS frame with a CRC (frame.c) when the next
+ * 			record does not fit or RQUEUE_BATCH_TICKS after its first one.
+ * 			A burst of small items thus costs one frame, one CRC and one
+ * 			uart_write() instead of one each.
+ *
+ * 			Flow control is per channel, with credit.h credits: an endpoint
+ * 			lends its proxy one credit per free slot of its queue and grants
+ * 			them back in batches as the queue is read. Grants carry the total
+ * 			granted so far, so a lost grant is made good by the next one, and
+ * 			every endpoint's total is sent again each RQUEUE_REFRESH_TICKS.
+ * 			Items of frames that never arrive show as gaps in the sequence
+ * 			numbers; they are counted lost and their credits returned.
+ *
+ * 			Each board's agent task sends a RESET frame when it starts. Its
+ * 			peer then restarts the numbering of its proxies, drops their
+ * 			pending batch and grants its endpoints' free slots again.
+ *
+ * 			Frame payloads, integers least significant byte first:
+ * 			  DATA   'D' { channel, length, seq (2), item } ...
+ * 			  CREDIT 'C' { channel, granted (4) } ...
+ * 			  RESET  'R'
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "credit.h"
+#include "frame.h"
+#include "uart.h"
+#include "rqueue.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define RQUEUE_FRAME_DATA		'D'
+#define RQUEUE_FRAME_CREDIT		'C'
+#define RQUEUE_FRAME_RESET		'R'
+#define RQUEUE_CREDIT_RECORD	5U		/* Channel, granted. */
+
+/* Private function prototypes -----------------------------------------------*/
+static void rqueue_send_batch(RqLink_t *pxLink);
+static void rqueue_send_frame(RqLink_t *pxLink, const uint8_t *pucPayload, uint32_t ulLen);
+static void rqueue_grant(RqLink_t *pxLink, BaseType_t xRefresh);
+static void rqueue_receive(RqLink_t *pxLink, const uint8_t *pucPayload, uint32_t ulLen);
+static void rqueue_receive_data(RqLink_t *pxLink, const uint8_t *pucRecords, uint32_t ulLen);
+static void rqueue_receive_credit(RqLink_t *pxLink, const uint8_t *pucRecords, uint32_t ulLen);
+static void rqueue_peer_reset(RqLink_t *pxLink);
+static void rqueue_task(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Initializes a link and creates its agent task.
+ * @param pxLink Link to start. Its buffers, stack and TCB are all inside it.
+ * @param pcName Name of the agent task.
+ * @param xPort Port to the peer, opened with TX and RX buffers. The agent is
+ * its only reader.
+ * @param uxPriority Priority of the agent task.
+ * @retval 0 if successful, -1 otherwise.
+ * @note Call from a task or before the scheduler starts, then add the
+ * proxies and endpoints.
+ */
+int32_t rqueue_start(RqLink_t *pxLink, const char *pcName, UartPort_t xPort,
+		UBaseType_t uxPriority)
+{
+	if ((pxLink == NULL) || (xPort >= UART_PORTS))
+	{
+		return -1;
+	}
+
+	memset(pxLink->pxProxies, 0, sizeof(pxLink->pxProxies));
+	memset(pxLink->pxEndpoints, 0, sizeof(pxLink->pxEndpoints));
+	memset(&pxLink->xStats, 0, sizeof(pxLink->xStats));
+	pxLink->xPort = xPort;
+	pxLink->usBatchLen = 0;
+
+	(void)frame_rx_init(&pxLink->xRx, FRAME_COBS, pxLink->ucRxPayload, RQUEUE_BATCH_BYTES);
+
+	pxLink->xTxLock = xSemaphoreCreateMutexStatic(&pxLink->xTxLockBuffer);
+	pxLink->xCredits = xEventGroupCreateStatic(&pxLink->xCreditsBuffer);
+
+	pxLink->xTask = xTaskCreateStatic(rqueue_task,
+									  pcName,
+									  RQUEUE_STACK_WORDS,
+									  pxLink,
+									  uxPriority,
+									  pxLink->xTaskStack,
+									  &pxLink->xTaskTcb);
+
+	return (pxLink->xTask != NULL) ? 0 : -1;
+}
+
+/**
+ * @brief Adds the sending end of a channel.
+ * @param pxLink Link started with rqueue_start().
+ * @param pxProxy Proxy to initialize.
+ * @param ucChannel Channel, below RQUEUE_CHANNELS, whose endpoint is on the
+ * peer.
+ * @param ucItemSize Item size, 1 to RQUEUE_MAX_ITEM, the same as the
+ * endpoint's.
+ * @retval 0 if successful, -1 otherwise.
+ * @note rqueue_send() waits for the endpoint's first grant.
+ */
+int32_t rqueue_proxy_init(RqLink_t *pxLink, RqProxy_t *pxProxy, uint8_t ucChannel,
+		uint8_t ucItemSize)
+{
+	if ((pxLink == NULL) || (pxProxy == NULL) || (ucChannel >= RQUEUE_CHANNELS)
+			|| (ucItemSize == 0U) || (ucItemSize > RQUEUE_MAX_ITEM)
+			|| (pxLink->pxProxies[ucChannel] != NULL))
+	{
+		return -1;
+	}
+
+	pxProxy->pxLink = pxLink;
+	pxProxy->ucChannel = ucChannel;
+	pxProxy->ucItemSize = ucItemSize;
+	pxProxy->usSeq = 0;
+	pxProxy->ulSent = 0;
+
+	/* No credit until the endpoint grants its window. */
+	memset(&pxProxy->xCredit, 0, sizeof(pxProxy->xCredit));
+
+	xSemaphoreTake(pxLink->xTxLock, portMAX_DELAY);
+	pxLink->pxProxies[ucChannel] = pxProxy;
+	xSemaphoreGive(pxLink->xTxLock);
+
+	return 0;
+}
+
+/**
+ * @brief Adds the receiving end of a channel.
+ * @param pxLink Link started with rqueue_start().
+ * @param pxEndpoint Endpoint to initialize.
+ * @param ucChannel Channel, below RQUEUE_CHANNELS, whose proxy is on the peer.
+ * @param xQueue Local queue of ucItemSize items, empty. Only read it, the
+ * agent is its only writer.
+ * @param ucItemSize Item size, 1 to RQUEUE_MAX_ITEM.
+ * @retval 0 if successful, -1 otherwise.
+ * @note The whole queue is the proxy's window.
+ */
+int32_t rqueue_endpoint_init(RqLink_t *pxLink, RqEndpoint_t *pxEndpoint, uint8_t ucChannel,
+		QueueHandle_t xQueue, uint8_t ucItemSize)
+{
+	if ((pxLink == NULL) || (pxEndpoint == NULL) || (xQueue == NULL)
+			|| (ucChannel >= RQUEUE_CHANNELS) || (ucItemSize == 0U)
+			|| (ucItemSize > RQUEUE_MAX_ITEM) || (pxLink->pxEndpoints[ucChannel] != NULL)
+			|| (credit_init(&pxEndpoint->xCredit, uxQueueSpacesAvailable(xQueue)) != 0))
+	{
+		return -1;
+	}
+
+	pxEndpoint->xQueue = xQueue;
+	pxEndpoint->ucItemSize = ucItemSize;
+	pxEndpoint->usExpected = 0;
+	pxEndpoint->ulArrived = 0;
+	pxEndpoint->ulCounted = 0;
+	pxEndpoint->ulLost = 0;
+	pxEndpoint->ulDropped = 0;
+	pxEndpoint->ucAnnounce = 1;
+
+	/* The agent picks it up from here. */
+	taskENTER_CRITICAL();
+	pxLink->pxEndpoints[ucChannel] = pxEndpoint;
+	taskEXIT_CRITICAL();
+
+	return 0;
+}
+
+/**
+ * @brief Sends an item to the peer's endpoint.
+ * @param pxProxy Proxy from rqueue_proxy_init().
+ * @param pvItem Item of the proxy's size. Copied before the call returns.
+ * @param xTicksToWait Longest time to wait for a credit.
+ * @retval pdPASS if the item is batched, errQUEUE_FULL if no credit came.
+ * @note Like xQueueSend(): the item will find room in the remote queue. It
+ * leaves within RQUEUE_BATCH_TICKS, or at once with rqueue_flush(). Call from
+ * a task.
+ */
+BaseType_t rqueue_send(RqProxy_t *pxProxy, const void *pvItem, TickType_t xTicksToWait)
+{
+	RqLink_t *pxLink = pxProxy->pxLink;
+	const EventBits_t uxBit = (EventBits_t)1U << pxProxy->ucChannel;
+	uint8_t *pucRecord;
+	TimeOut_t xTimeOut;
+
+	vTaskSetTimeOutState(&xTimeOut);
+
+	for (;;)
+	{
+		if (xSemaphoreTake(pxLink->xTxLock, xTicksToWait) != pdTRUE)
+		{
+			return errQUEUE_FULL;
+		}
+
+		if (credit_take(&pxProxy->xCredit, 1U) == 0)
+		{
+			break;
+		}
+
+		xSemaphoreGive(pxLink->xTxLock);
+
+		/* The bit stays set if credits came in since, and the agent sets it
+		 * again for every grant. */
+		if (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE)
+		{
+			return errQUEUE_FULL;
+		}
+
+		(void)xEventGroupWaitBits(pxLink->xCredits, uxBit, pdTRUE, pdFALSE, xTicksToWait);
+	}
+
+	if ((pxLink->usBatchLen + RQUEUE_RECORD_HEADER + pxProxy->ucItemSize) > RQUEUE_BATCH_BYTES)
+	{
+		rqueue_send_batch(pxLink);
+	}
+
+	if (pxLink->usBatchLen == 0U)
+	{
+		pxLink->ucBatch[0] = RQUEUE_FRAME_DATA;
+		pxLink->usBatchLen = 1;
+		pxLink->xBatchStart = xTaskGetTickCount();
+	}
+
+	pucRecord = &pxLink->ucBatch[pxLink->usBatchLen];
+	pucRecord[0] = pxProxy->ucChannel;
+	pucRecord[1] = pxProxy->ucItemSize;
+	pucRecord[2] = (uint8_t)pxProxy->usSeq;
+	pucRecord[3] = (uint8_t)(pxProxy->usSeq >> 8);
+	memcpy(&pucRecord[RQUEUE_RECORD_HEADER], pvItem, pxProxy->ucItemSize);
+
+	pxLink->usBatchLen += RQUEUE_RECORD_HEADER + pxProxy->ucItemSize;
+	pxProxy->usSeq++;
+	pxProxy->ulSent++;
+	pxLink->xStats.ulItemsSent++;
+
+	xSemaphoreGive(pxLink->xTxLock);
+
+	return pdPASS;
+}
+
+/**
+ * @brief Returns how many items can be sent without waiting.
+ * @param pxProxy Proxy from rqueue_proxy_init().
+ * @retval Credits left, i.e. free slots the remote queue had for them.
+ */
+UBaseType_t rqueue_spaces_available(const RqProxy_t *pxProxy)
+{
+	return (UBaseType_t)credit_available(&pxProxy->xCredit);
+}
+
+/**
+ * @brief Sends the items batched so far without waiting for more.
+ * @param pxLink Link started with rqueue_start().
+ * @retval None
+ */
+void rqueue_flush(RqLink_t *pxLink)
+{
+	xSemaphoreTake(pxLink->xTxLock, portMAX_DELAY);
+	rqueue_send_batch(pxLink);
+	xSemaphoreGive(pxLink->xTxLock);
+}
+
+/**
+ * @brief Reads the counters of a link since it was started.
+ * @param pxLink Link started with rqueue_start().
+ * @param pxStats Filled with the counters.
+ * @retval None
+ */
+void rqueue_get_stats(RqLink_t *pxLink, RqStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = pxLink->xStats;
+	taskEXIT_CRITICAL();
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Sends the batch as one frame, if it holds a record.
+ * @param pxLink Link, TX lock held.
+ * @retval None
+ */
+static void rqueue_send_batch(RqLink_t *pxLink)
+{
+	if (pxLink->usBatchLen > 1U)
+	{
+		rqueue_send_frame(pxLink, pxLink->ucBatch, pxLink->usBatchLen);
+	}
+
+	pxLink->usBatchLen = 0;
+}
+
+/**
+ * @brief Encodes a payload and queues the frame on the port.
+ * @param pxLink Link, TX lock held.
+ * @param pucPayload Payload.
+ * @param ulLen Payload length, at most RQUEUE_BATCH_BYTES.
+ * @retval None
+ * @note Blocks while the TX ring is full: the peer reads at the line rate.
+ */
+static void rqueue_send_frame(RqLink_t *pxLink, const uint8_t *pucPayload, uint32_t ulLen)
+{
+	int32_t lFrameLen;
+
+	lFrameLen = frame_encode(FRAME_COBS, pucPayload, ulLen, pxLink->ucTxFrame,
+			sizeof(pxLink->ucTxFrame));
+
+	if ((lFrameLen > 0)
+			&& (uart_write(pxLink->xPort, pxLink->ucTxFrame, (uint32_t)lFrameLen, portMAX_DELAY)
+					== lFrameLen))
+	{
+		pxLink->xStats.ulFramesSent++;
+	}
+}
+
+/**
+ * @brief Grants the endpoints' consumed items back to the peer.
+ * @param pxLink Link.
+ * @param xRefresh pdTRUE to send every endpoint's total, granted or not.
+ * @retval None
+ * @note Agent only. Credits go back a quarter of the window at a time while
+ * items wait in the queue, and all at once when it is empty.
+ */
+static void rqueue_grant(RqLink_t *pxLink, BaseType_t xRefresh)
+{
+	uint8_t ucPayload[1U + (RQUEUE_CHANNELS * RQUEUE_CREDIT_RECORD)];
+	uint32_t ulLen = 1;
+	RqEndpoint_t *pxEndpoint;
+	UBaseType_t uxWaiting;
+	uint32_t ulDone;
+	uint32_t ulBatch;
+	uint32_t x;
+
+	ucPayload[0] = RQUEUE_FRAME_CREDIT;
+
+	for (x = 0; x < RQUEUE_CHANNELS; x++)
+	{
+		pxEndpoint = pxLink->pxEndpoints[x];
+
+		if (pxEndpoint == NULL)
+		{
+			continue;
+		}
+
+		/* Whatever arrived and is no longer in the queue has been consumed. */
+		uxWaiting = uxQueueMessagesWaiting(pxEndpoint->xQueue);
+		ulDone = pxEndpoint->ulArrived - (uint32_t)uxWaiting;
+		credit_consumed(&pxEndpoint->xCredit, ulDone - pxEndpoint->ulCounted);
+		pxEndpoint->ulCounted = ulDone;
+
+		ulBatch = (uxWaiting == 0U) ? 1U : ((pxEndpoint->xCredit.ulWindow + 3U) / 4U);
+
+		if ((credit_grant(&pxEndpoint->xCredit, ulBatch) != 0U) || (pxEndpoint->ucAnnounce != 0U)
+				|| (xRefresh != pdFALSE))
+		{
+			pxEndpoint->ucAnnounce = 0;
+			ucPayload[ulLen] = (uint8_t)x;
+			ucPayload[ulLen + 1U] = (uint8_t)pxEndpoint->xCredit.ulGranted;
+			ucPayload[ulLen + 2U] = (uint8_t)(pxEndpoint->xCredit.ulGranted >> 8);
+			ucPayload[ulLen + 3U] = (uint8_t)(pxEndpoint->xCredit.ulGranted >> 16);
+			ucPayload[ulLen + 4U] = (uint8_t)(pxEndpoint->xCredit.ulGranted >> 24);
+			ulLen += RQUEUE_CREDIT_RECORD;
+		}
+	}
+
+	if (ulLen > 1U)
+	{
+		xSemaphoreTake(pxLink->xTxLock, portMAX_DELAY);
+		rqueue_send_frame(pxLink, ucPayload, ulLen);
+		pxLink->xStats.ulGrantsSent++;
+		xSemaphoreGive(pxLink->xTxLock);
+	}
+}
+
+/**
+ * @brief Handles a frame from the peer.
+ * @param pxLink Link.
+ * @param pucPayload Payload, CRC checked.
+ * @param ulLen Payload length.
+ * @retval None
+ */
+static void rqueue_receive(RqLink_t *pxLink, const uint8_t *pucPayload, uint32_t ulLen)
+{
+	pxLink->xStats.ulFramesReceived++;
+
+	switch (pucPayload[0])
+	{
+	case RQUEUE_FRAME_DATA:
+		rqueue_receive_data(pxLink, &pucPayload[1], ulLen - 1U);
+		break;
+
+	case RQUEUE_FRAME_CREDIT:
+		rqueue_receive_credit(pxLink, &pucPayload[1], ulLen - 1U);
+		break;
+
+	case RQUEUE_FRAME_RESET:
+		rqueue_peer_reset(pxLink);
+		break;
+
+	default:
+		pxLink->xStats.ulBadFrames++;
+		break;
+	}
+}
+
+/**
+ * @brief Replays the records of a data frame into the endpoints' queues.
+ * @param pxLink Link.
+ * @param pucRecords Records.
+ * @param ulLen Length of the records.
+ * @retval None
+ * @note A malformed record drops it and the rest of the frame; their items
+ * show up as lost with the next sequence number.
+ */
+static void rqueue_receive_data(RqLink_t *pxLink, const uint8_t *pucRecords, uint32_t ulLen)
+{
+	RqEndpoint_t *pxEndpoint;
+	uint16_t usSeq;
+	uint16_t usGap;
+
+	while (ulLen > 0U)
+	{
+		if ((ulLen < RQUEUE_RECORD_HEADER) || (pucRecords[0] >= RQUEUE_CHANNELS)
+				|| ((pxEndpoint = pxLink->pxEndpoints[pucRecords[0]]) == NULL)
+				|| (pucRecords[1] != pxEndpoint->ucItemSize)
+				|| (ulLen < (RQUEUE_RECORD_HEADER + pxEndpoint->ucItemSize)))
+		{
+			pxLink->xStats.ulBadFrames++;
+			return;
+		}
+
+		usSeq = (uint16_t)(pucRecords[2] | ((uint16_t)pucRecords[3] << 8));
+		usGap = (uint16_t)(usSeq - pxEndpoint->usExpected);
+
+		/* Behind: a duplicate, skipped. Ahead: the items in between are lost,
+		 * and so are their credits unless they are counted as consumed. */
+		if (usGap < 0x8000U)
+		{
+			pxEndpoint->ulLost += usGap;
+			pxEndpoint->ulArrived += usGap;
+			pxEndpoint->usExpected = usSeq + 1U;
+
+			if (xQueueSend(pxEndpoint->xQueue, &pucRecords[RQUEUE_RECORD_HEADER], 0) != pdPASS)
+			{
+				pxEndpoint->ulDropped++;
+			}
+
+			pxEndpoint->ulArrived++;
+			pxLink->xStats.ulItemsReceived++;
+		}
+
+		pucRecords += RQUEUE_RECORD_HEADER + pxEndpoint->ucItemSize;
+		ulLen -= RQUEUE_RECORD_HEADER + pxEndpoint->ucItemSize;
+	}
+}
+
+/**
+ * @brief Applies the grants of a credit frame to the proxies.
+ * @param pxLink Link.
+ * @param pucRecords Records.
+ * @param ulLen Length of the records.
+ * @retval None
+ */
+static void rqueue_receive_credit(RqLink_t *pxLink, const uint8_t *pucRecords, uint32_t ulLen)
+{
+	RqProxy_t *pxProxy;
+	uint32_t ulGranted;
+
+	for (; ulLen >= RQUEUE_CREDIT_RECORD; ulLen -= RQUEUE_CREDIT_RECORD)
+	{
+		pxProxy = (pucRecords[0] < RQUEUE_CHANNELS) ? pxLink->pxProxies[pucRecords[0]] : NULL;
+		ulGranted = (uint32_t)pucRecords[1] | ((uint32_t)pucRecords[2] << 8)
+				| ((uint32_t)pucRecords[3] << 16) | ((uint32_t)pucRecords[4] << 24);
+
+		/* Totals: an older one, repeated or overtaken, changes nothing. */
+		if ((pxProxy != NULL) && ((int32_t)(ulGranted - pxProxy->xCredit.ulGranted) > 0))
+		{
+			pxProxy->xCredit.ulGranted = ulGranted;
+			(void)xEventGroupSetBits(pxLink->xCredits, (EventBits_t)1U << pucRecords[0]);
+		}
+
+		pucRecords += RQUEUE_CREDIT_RECORD;
+	}
+
+	if (ulLen != 0U)
+	{
+		pxLink->xStats.ulBadFrames++;
+	}
+}
+
+/**
+ * @brief Starts the channels over after the peer has restarted.
+ * @param pxLink Link.
+ * @retval None
+ * @note The proxies wait for new grants. The endpoints lend their free slots
+ * again; the items still queued give theirs back once read.
+ */
+static void rqueue_peer_reset(RqLink_t *pxLink)
+{
+	RqEndpoint_t *pxEndpoint;
+	RqProxy_t *pxProxy;
+	UBaseType_t uxWaiting;
+	uint32_t x;
+
+	pxLink->xStats.ulResets++;
+
+	xSemaphoreTake(pxLink->xTxLock, portMAX_DELAY);
+
+	pxLink->usBatchLen = 0;
+
+	for (x = 0; x < RQUEUE_CHANNELS; x++)
+	{
+		pxProxy = pxLink->pxProxies[x];
+
+		if (pxProxy != NULL)
+		{
+			pxProxy->usSeq = 0;
+			memset(&pxProxy->xCredit, 0, sizeof(pxProxy->xCredit));
+		}
+	}
+
+	xSemaphoreGive(pxLink->xTxLock);
+
+	for (x = 0; x < RQUEUE_CHANNELS; x++)
+	{
+		pxEndpoint = pxLink->pxEndpoints[x];
+
+		if (pxEndpoint != NULL)
+		{
+			uxWaiting = uxQueueMessagesWaiting(pxEndpoint->xQueue);
+			(void)credit_init(&pxEndpoint->xCredit, pxEndpoint->xCredit.ulWindow);
+			pxEndpoint->xCredit.ulGranted -= (uint32_t)uxWaiting;
+			pxEndpoint->ulCounted = pxEndpoint->ulArrived - (uint32_t)uxWaiting;
+			pxEndpoint->usExpected = 0;
+			pxEndpoint->ucAnnounce = 1;
+		}
+	}
+}
+
+/**
+ * @brief Agent task of a link.
+ * @param pvParameters The link.
+ * @retval None
+ * @note Reads the port, replays the frames, sends batches that waited
+ * RQUEUE_BATCH_TICKS and grants credits.
+ */
+static void rqueue_task(void *pvParameters)
+{
+	static const uint8_t ucReset[1] = { RQUEUE_FRAME_RESET };
+	RqLink_t *pxLink = (RqLink_t *)pvParameters;
+	TickType_t xLastRefresh;
+	BaseType_t xRefresh;
+	int32_t lRead;
+	int32_t lFrame;
+	int32_t x;
+
+	xSemaphoreTake(pxLink->xTxLock, portMAX_DELAY);
+	rqueue_send_frame(pxLink, ucReset, sizeof(ucReset));
+	xSemaphoreGive(pxLink->xTxLock);
+
+	xLastRefresh = xTaskGetTickCount();
+
+	for (;;)
+	{
+		lRead = uart_read(pxLink->xPort, pxLink->ucRxBytes, sizeof(pxLink->ucRxBytes),
+				RQUEUE_BATCH_TICKS);
+
+		for (x = 0; x < lRead; x++)
+		{
+			lFrame = frame_rx_put(&pxLink->xRx, pxLink->ucRxBytes[x]);
+
+			if (lFrame > 0)
+			{
+				rqueue_receive(pxLink, pxLink->ucRxPayload, (uint32_t)lFrame);
+			}
+		}
+
+		xSemaphoreTake(pxLink->xTxLock, portMAX_DELAY);
+
+		if ((pxLink->usBatchLen != 0U)
+				&& ((xTaskGetTickCount() - pxLink->xBatchStart) >= RQUEUE_BATCH_TICKS))
+		{
+			rqueue_send_batch(pxLink);
+		}
+
+		xSemaphoreGive(pxLink->xTxLock);
+
+		xRefresh = ((xTaskGetTickCount() - xLastRefresh) >= RQUEUE_REFRESH_TICKS) ? pdTRUE : pdFALSE;
+
+		if (xRefresh != pdFALSE)
+		{
+			xLastRefresh = xTaskGetTickCount();
+		}
+
+		rqueue_grant(pxLink, xRefresh);
+	}
+}
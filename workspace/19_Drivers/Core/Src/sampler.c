@@ -0,0 +1,245 @@
+/*******************************************************************************
+ *
+ * @file	sampler.c
+ * @brief	Shared sampling scheduler: one timer-driven task reads every
+ * 			sensor that is due in a single wakeup.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	A task per sensor, each sleeping on vTaskDelay() between reads,
+ * 			costs a stack per sensor and a wakeup and context switch per
+ * 			read, at tick-rounded times that drift apart. Here the sensors
+ * 			register a read function, a period and a sink before the
+ * 			scheduler starts:
+ *
+ * 				sampler_register(1000, read_digital, print_digital, NULL);
+ * 				sampler_register(4000, read_analog, print_analog, NULL);
+ * 				sampler_start(2);
+ *
+ * 			Each period is rounded down to SAMPLER_BASE_US times a power of
+ * 			two, so the periods are harmonic: every read of a slow sensor
+ * 			falls on a wakeup of the fastest one, and the task is woken at
+ * 			the shortest period only, by a periodic hrtimer (TIM5). In each
+ * 			wakeup it first runs the reads that are due, back to back, then
+ * 			passes the values to the sinks, so readings of the same wakeup
+ * 			are taken within microseconds of each other.
+ *
+ * 			Time is counted in base periods since the start. A sensor reads
+ * 			when the count reaches a multiple of its period; a wakeup that
+ * 			comes late reads it once and counts the reads it missed, rather
+ * 			than running them back to back.
+ *
+ * 			Reads and sinks run in the sampler task, at its priority: they
+ * 			must not block for long, or they delay the other sensors.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "hrtimer.h"
+#include "sampler.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define SAMPLER_NOTIFY_BIT		(1UL << 0)
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	SamplerRead_t pxRead;
+	SamplerSink_t pxSink;
+	void *pvArg;
+	uint32_t ulShift;					/* Period is SAMPLER_BASE_US << ulShift. */
+	uint32_t ulNextTick;				/* Base period of the next read. */
+	uint32_t ulValue;					/* Read in this wakeup, for the sink. */
+	uint32_t ulDue;						/* Read in this wakeup. */
+	volatile uint32_t ulReads;
+	volatile uint32_t ulMissed;
+	volatile uint32_t ulLast;
+} SamplerSensor_t;
+
+/* Variables -----------------------------------------------------------------*/
+static SamplerSensor_t xSensors[SAMPLER_MAX_SENSORS];
+static uint32_t ulSensorCount = 0;
+static uint32_t ulMinShift = SAMPLER_MAX_SHIFT;
+static TaskHandle_t xSamplerTask = NULL;
+static volatile uint32_t ulWakeups = 0;
+
+/* Private function prototypes -----------------------------------------------*/
+static void sampler_task(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Adds a sensor to the schedule.
+ * @param ulPeriodUs Time between reads. Rounded down to SAMPLER_BASE_US
+ * times a power of two, between SAMPLER_BASE_US and SAMPLER_BASE_US <<
+ * SAMPLER_MAX_SHIFT.
+ * @param pxRead Reads the sensor.
+ * @param pxSink Takes the reading, NULL to only keep the last one.
+ * @param pvArg Argument passed to pxRead and pxSink.
+ * @retval The sensor number for sampler_get_stats(), or -1 if the table is
+ * full, pxRead is NULL or the sampler has started.
+ */
+int32_t sampler_register(uint32_t ulPeriodUs, SamplerRead_t pxRead, SamplerSink_t pxSink,
+		void *pvArg)
+{
+	SamplerSensor_t *pxSensor;
+	uint32_t ulShift = 0U;
+
+	if ((pxRead == NULL) || (ulSensorCount >= SAMPLER_MAX_SENSORS) || (xSamplerTask != NULL))
+	{
+		return -1;
+	}
+
+	while ((ulShift < SAMPLER_MAX_SHIFT) && ((SAMPLER_BASE_US << (ulShift + 1U)) <= ulPeriodUs))
+	{
+		ulShift++;
+	}
+
+	pxSensor = &xSensors[ulSensorCount];
+	pxSensor->pxRead = pxRead;
+	pxSensor->pxSink = pxSink;
+	pxSensor->pvArg = pvArg;
+	pxSensor->ulShift = ulShift;
+
+	if (ulShift < ulMinShift)
+	{
+		ulMinShift = ulShift;
+	}
+
+	return (int32_t)ulSensorCount++;
+}
+
+/**
+ * @brief Starts the microsecond timer and creates the sampler task.
+ * @param uxPriority Priority of the sampler. At least that of the tasks that
+ * use the readings, as the reads are what is timed.
+ * @retval pdPASS if the task was created.
+ * @note Every sensor is read in the first wakeup, one shortest period after
+ * the task starts.
+ */
+BaseType_t sampler_start(UBaseType_t uxPriority)
+{
+	if ((ulSensorCount == 0U) || (xSamplerTask != NULL) || (hrtimer_init() != 0))
+	{
+		return pdFAIL;
+	}
+
+	return xTaskCreate(sampler_task,
+					   "Sampler",
+					   SAMPLER_STACK_WORDS,
+					   NULL,
+					   uxPriority,
+					   &xSamplerTask);
+}
+
+/**
+ * @brief Copies the counters of a sensor.
+ * @param ulSensor Number returned by sampler_register().
+ * @param pxStats Where to copy them.
+ * @retval 0 on success, -1 on a bad argument.
+ */
+int32_t sampler_get_stats(uint32_t ulSensor, SamplerStats_t *pxStats)
+{
+	if ((pxStats == NULL) || (ulSensor >= ulSensorCount))
+	{
+		return -1;
+	}
+
+	pxStats->ulPeriodUs = SAMPLER_BASE_US << xSensors[ulSensor].ulShift;
+	pxStats->ulReads = xSensors[ulSensor].ulReads;
+	pxStats->ulMissed = xSensors[ulSensor].ulMissed;
+	pxStats->ulLast = xSensors[ulSensor].ulLast;
+
+	return 0;
+}
+
+/**
+ * @brief Returns how many times the sampler task has woken.
+ * @param None
+ * @retval Wakeups since the start. Compare with the reads of the sensors to
+ * see how many reads each wakeup shared.
+ */
+uint32_t sampler_get_wakeups(void)
+{
+	return ulWakeups;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Wakes every shortest period, reads the sensors that are due, then
+ * passes the readings to their sinks.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void sampler_task(void *pvParameters)
+{
+	HrTimer_t xTimer;
+	SamplerSensor_t *pxSensor;
+	uint32_t ulWakeUs = SAMPLER_BASE_US << ulMinShift;
+	uint32_t ulTickTime;
+	uint32_t ulTick = 0U;
+	uint32_t ulElapsed;
+	uint32_t ulNow;
+	uint32_t i;
+
+	(void)pvParameters;
+
+	/* All due in the first wakeup, then on multiples of their periods. */
+	for (i = 0U; i < ulSensorCount; i++)
+	{
+		xSensors[i].ulNextTick = 1UL << ulMinShift;
+	}
+
+	hrtimer_setup_notify(&xTimer, xTaskGetCurrentTaskHandle(), SAMPLER_NOTIFY_BIT);
+	ulTickTime = hrtimer_now();
+
+	if (hrtimer_start_at(&xTimer, ulTickTime + ulWakeUs, ulWakeUs) != 0)
+	{
+		vTaskDelete(NULL);
+	}
+
+	while (1)
+	{
+		(void)xTaskNotifyWait(0U, SAMPLER_NOTIFY_BIT, NULL, portMAX_DELAY);
+
+		/* Count whole base periods, wrap-safe: the microsecond count wraps
+		 * every 71 minutes, which is not a multiple of the base period. */
+		ulNow = hrtimer_now();
+		ulElapsed = (ulNow - ulTickTime) / SAMPLER_BASE_US;
+		ulTick += ulElapsed;
+		ulTickTime += ulElapsed * SAMPLER_BASE_US;
+		ulWakeups++;
+
+		for (i = 0U; i < ulSensorCount; i++)
+		{
+			pxSensor = &xSensors[i];
+			pxSensor->ulDue = ((int32_t)(ulTick - pxSensor->ulNextTick) >= 0) ? 1U : 0U;
+
+			if (pxSensor->ulDue != 0U)
+			{
+				pxSensor->ulValue = pxSensor->pxRead(pxSensor->pvArg);
+			}
+		}
+
+		for (i = 0U; i < ulSensorCount; i++)
+		{
+			pxSensor = &xSensors[i];
+
+			if (pxSensor->ulDue == 0U)
+			{
+				continue;
+			}
+
+			pxSensor->ulMissed += (ulTick - pxSensor->ulNextTick) >> pxSensor->ulShift;
+			pxSensor->ulNextTick = ((ulTick >> pxSensor->ulShift) + 1U) << pxSensor->ulShift;
+			pxSensor->ulLast = pxSensor->ulValue;
+			pxSensor->ulReads++;
+
+			if (pxSensor->pxSink != NULL)
+			{
+				pxSensor->pxSink(pxSensor->ulValue, ulNow, pxSensor->pvArg);
+			}
+		}
+	}
+}
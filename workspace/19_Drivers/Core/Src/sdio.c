@@ -0,0 +1,640 @@
+/*******************************************************************************
+ *
+ * @file	sdio.c
+ * @brief	Implementation of the SD card driver.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	An SD, SDHC or SDXC card on the SDIO, 4-bit bus, register level
+ * 			without the HAL SD module. Pins: PC8 to PC11 (D0 to D3), PC12
+ * 			(CK) and PD2 (CMD), AF12; PC9 and PC10 to PC12 are shared with
+ * 			I2C3, SPI3, USART3 and UART5.
+ *
+ * 			The card is identified at 400 kHz, then clocked at 24 MHz
+ * 			(CK48 / 2), 12 MB/s on the bus. Blocks move by DMA on DMA2
+ * 			stream 3 or 6 (dma.c), flow controlled by the SDIO, in bursts of
+ * 			four words: buffers must be 16-byte aligned. A transfer ends
+ * 			when both the SDIO (DATAEND, or an error) and the DMA have
+ * 			finished; the calling task sleeps meanwhile.
+ *
+ * 			Writes of several blocks are multiple-block writes announced
+ * 			with ACMD23, so the card can erase ahead, and the card programs
+ * 			after the last one while the CPU goes on: its busy time is
+ * 			waited for (CMD13) at the start of the next transfer only.
+ *
+ * 			Hardware flow control is left off (errata: SDIOCLK glitches);
+ * 			the DMA keeps ahead of the bus by far.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "clkgate.h"
+#include "clock.h"
+#include "xfer.h"
+#include "dma.h"
+#include "sdio.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define SDIO_CLKDIV_INIT		118U	/* 48 MHz / (118 + 2) = 400 kHz */
+#define SDIO_CLKDIV_DATA		0U		/* 48 MHz / 2 = 24 MHz */
+#define SDIO_DATA_TIMEOUT		(24000000U / 1000U * SDIO_TIMEOUT_MS)	/* In bus clocks. */
+#define SDIO_CMD_TIMEOUT		1000000U	/* Busy-wait iterations for a response. */
+#define SDIO_ACMD41_TRIES		1000U	/* 1 ms apart. */
+#define SDIO_ICR_ALL			0x00C007FFU
+#define SDIO_ICR_CMD			(SDIO_ICR_CCRCFAILC | SDIO_ICR_CTIMEOUTC | SDIO_ICR_CMDRENDC \
+		| SDIO_ICR_CMDSENTC)
+#define SDIO_DATA_ERRORS		(SDIO_STA_DCRCFAIL | SDIO_STA_DTIMEOUT | SDIO_STA_TXUNDERR \
+		| SDIO_STA_RXOVERR)
+#define SDIO_DBLOCKSIZE_512		9U		/* 2^9 bytes. */
+
+/* Response kinds. */
+#define SDIO_RESP_NONE			0U
+#define SDIO_RESP_R1			1U		/* Short, card status checked. */
+#define SDIO_RESP_SHORT			2U		/* Short, not checked (R6, R7, stop). */
+#define SDIO_RESP_R3			3U		/* Short without a valid CRC. */
+#define SDIO_RESP_R2			4U		/* Long. */
+
+#define SD_R1_ERRORS			0xFDF98008U
+#define SD_R1_READY_FOR_DATA	(1U << 8)
+#define SD_R1_STATE(r1)			(((r1) >> 9) & 0xFU)
+#define SD_STATE_TRAN			4U
+#define SD_OCR_BUSY				(1U << 31)	/* Set when powered up. */
+#define SD_OCR_CCS				(1U << 30)	/* Block addressed (SDHC, SDXC). */
+#define SD_OCR_VOLTAGES			0x00100000U	/* 3.2 to 3.3 V. */
+
+#define SDIO_AF					12U
+#define PIN_PULL_UP				1U
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint8_t ucOpen;
+	uint8_t ucHighCapacity;
+	uint32_t ulRca;					/* Shifted into the argument's upper half. */
+	uint32_t ulBlocks;
+	DmaStream_t *pxRxStream;
+	DmaStream_t *pxTxStream;
+	DmaStream_t *pxActive;			/* Stream of the transfer in flight. */
+	DmaDesc_t xDesc;
+	XferReq_t xOp;					/* The transfer, signalled to its task. */
+	volatile uint8_t ucParts;		/* SDIO and DMA sides still running. */
+	volatile uint8_t ucFailed;
+	SemaphoreHandle_t xLock;
+	StaticSemaphore_t xLockBuffer;
+	SdioStats_t xStats;
+	ClkGateUser_t xSdioClock;
+	ClkGateUser_t xPortC;
+	ClkGateUser_t xPortD;
+} SdioState_t;
+
+/* Variables -----------------------------------------------------------------*/
+static SdioState_t xSd;
+
+/* Private function prototypes -----------------------------------------------*/
+static void sdio_pin_init(GPIO_TypeDef *pxPort, uint32_t ulPin, uint32_t ulPull);
+static int32_t sdio_cmd(uint32_t ulIndex, uint32_t ulArg, uint32_t ulResp);
+static int32_t sdio_acmd(uint32_t ulIndex, uint32_t ulArg, uint32_t ulResp);
+static int32_t sdio_card_init(void);
+static int32_t sdio_wait_ready(void);
+static int32_t sdio_transfer(uint32_t ulBlock, void *pvData, uint32_t ulCount, uint32_t ulWrite);
+static void sdio_part_done(BaseType_t *pxHigherPriorityTaskWoken);
+static void sdio_dma_done(XferReq_t *pxReq, BaseType_t *pxHigherPriorityTaskWoken);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Powers the card up, identifies it and sets the 4-bit bus.
+ * @param None
+ * @retval 0 if successful, -1 if already open, no DMA stream or 48 MHz clock
+ * is available, or no card answers.
+ * @note Call from a task: identification takes up to a second.
+ */
+int32_t sdio_open(void)
+{
+	DmaConfig_t xCfg;
+	uint32_t ulPin;
+
+	if (xSd.ucOpen != 0U)
+	{
+		return -1;
+	}
+
+	xCfg.xRequest = DMA_REQ_SDIO;
+	xCfg.xDir = DMA_DIR_M2P;
+	xCfg.ucPriority = SDIO_DMA_PRIORITY;
+	xCfg.ucItemSize = 4U;
+	xCfg.ucPeriphInc = 0U;
+	xCfg.ucMemInc = 1U;
+	xCfg.pvPeriph = &SDIO->FIFO;
+	xCfg.ulBandwidth = 12000000U;
+
+	if (dma_alloc(&xCfg, &xSd.pxTxStream) != 0)
+	{
+		return -1;
+	}
+
+	/* Reads and writes never overlap: the bus time is the write stream's. */
+	xCfg.xDir = DMA_DIR_P2M;
+	xCfg.ulBandwidth = 0U;
+
+	if ((dma_alloc(&xCfg, &xSd.pxRxStream) != 0) || (clock_ck48_enable() != 0))
+	{
+		dma_free(xSd.pxTxStream);
+		return -1;
+	}
+
+	/* SDIOCLK from CK48, not SYSCLK. */
+	RCC->DCKCFGR2 &= ~RCC_DCKCFGR2_SDIOSEL;
+
+	clkgate_user_init(&xSd.xSdioClock, CLKGATE_SDIO);
+	clkgate_user_init(&xSd.xPortC, CLKGATE_GPIOC);
+	clkgate_user_init(&xSd.xPortD, CLKGATE_GPIOD);
+	clkgate_acquire(&xSd.xSdioClock);
+	clkgate_acquire(&xSd.xPortC);
+	clkgate_acquire(&xSd.xPortD);
+
+	for (ulPin = 8U; ulPin <= 11U; ulPin++)
+	{
+		sdio_pin_init(GPIOC, ulPin, PIN_PULL_UP);
+	}
+
+	sdio_pin_init(GPIOC, 12U, 0U);
+	sdio_pin_init(GPIOD, 2U, PIN_PULL_UP);
+
+	xSd.xLock = xSemaphoreCreateMutexStatic(&xSd.xLockBuffer);
+
+	NVIC_SetPriority(SDIO_IRQn, SDIO_IRQ_PRIORITY);
+	NVIC_EnableIRQ(SDIO_IRQn);
+
+	if (sdio_card_init() != 0)
+	{
+		SDIO->POWER = 0;
+		NVIC_DisableIRQ(SDIO_IRQn);
+		clkgate_release(&xSd.xSdioClock);
+		dma_free(xSd.pxRxStream);
+		dma_free(xSd.pxTxStream);
+		return -1;
+	}
+
+	xSd.ucOpen = 1;
+
+	return 0;
+}
+
+/**
+ * @brief Reads blocks.
+ * @param ulBlock First block.
+ * @param pvData Receives ulCount blocks, 16-byte aligned.
+ * @param ulCount Blocks, 1 to SDIO_MAX_BLOCKS.
+ * @retval 0 if successful, -1 otherwise.
+ * @note Call from a task; it sleeps until the data is in.
+ */
+int32_t sdio_read(uint32_t ulBlock, void *pvData, uint32_t ulCount)
+{
+	return sdio_transfer(ulBlock, pvData, ulCount, 0U);
+}
+
+/**
+ * @brief Writes blocks.
+ * @param ulBlock First block.
+ * @param pvData ulCount blocks, 16-byte aligned.
+ * @param ulCount Blocks, 1 to SDIO_MAX_BLOCKS.
+ * @retval 0 if successful, -1 otherwise.
+ * @note Call from a task; it sleeps until the data is out. The card then
+ * programs it on its own.
+ */
+int32_t sdio_write(uint32_t ulBlock, const void *pvData, uint32_t ulCount)
+{
+	return sdio_transfer(ulBlock, (void *)pvData, ulCount, 1U);
+}
+
+/**
+ * @brief Returns the capacity of the card.
+ * @param None
+ * @retval Blocks of SDIO_BLOCK_BYTES, 0 if no card is open.
+ */
+uint32_t sdio_get_blocks(void)
+{
+	return (xSd.ucOpen != 0U) ? xSd.ulBlocks : 0U;
+}
+
+/**
+ * @brief Reads the counters.
+ * @param pxStats Receives the counters.
+ * @retval None
+ */
+void sdio_get_stats(SdioStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = xSd.xStats;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief SDIO interrupt: the data phase has ended or failed.
+ * @param None
+ * @retval None
+ */
+void SDIO_IRQHandler(void)
+{
+	const uint32_t ulSta = SDIO->STA & SDIO->MASK;
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	if ((ulSta & SDIO_DATA_ERRORS) != 0U)
+	{
+		SDIO->MASK = 0;
+		SDIO->DCTRL = 0;
+		SDIO->ICR = SDIO_ICR_ALL;
+		xSd.ucFailed = 1;
+		xSd.xStats.ulErrors++;
+		sdio_part_done(&xHigherPriorityTaskWoken);
+
+		/* Its descriptor completes with XFER_ERROR: the DMA side. */
+		dma_abort(xSd.pxActive);
+	}
+	else if ((ulSta & SDIO_STA_DATAEND) != 0U)
+	{
+		SDIO->MASK = 0;
+		SDIO->ICR = SDIO_ICR_ALL;
+		sdio_part_done(&xHigherPriorityTaskWoken);
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Configures an SDIO pin.
+ * @param pxPort GPIO port (clock enabled).
+ * @param ulPin Pin number.
+ * @param ulPull PIN_PULL_UP for CMD and data, 0 for CK.
+ * @retval None
+ */
+static void sdio_pin_init(GPIO_TypeDef *pxPort, uint32_t ulPin, uint32_t ulPull)
+{
+	const uint32_t ulShift2 = 2U * ulPin;
+	const uint32_t ulShift4 = 4U * (ulPin & 7U);
+
+	pxPort->AFR[ulPin >> 3] = (pxPort->AFR[ulPin >> 3] & ~(0xFU << ulShift4))
+			| (SDIO_AF << ulShift4);
+	pxPort->OTYPER &= ~(1U << ulPin);
+	pxPort->OSPEEDR |= (3U << ulShift2);
+	pxPort->PUPDR = (pxPort->PUPDR & ~(3U << ulShift2)) | (ulPull << ulShift2);
+	pxPort->MODER = (pxPort->MODER & ~(3U << ulShift2)) | (2U << ulShift2);
+}
+
+/**
+ * @brief Sends a command and waits for its response.
+ * @param ulIndex Command index.
+ * @param ulArg Argument.
+ * @param ulResp SDIO_RESP_ kind.
+ * @retval 0 if answered (and, for R1, without error bits), -1 otherwise.
+ * @note Busy-waits: a command and its response take under 400 us at 400 kHz.
+ */
+static int32_t sdio_cmd(uint32_t ulIndex, uint32_t ulArg, uint32_t ulResp)
+{
+	uint32_t ulWait;
+	uint32_t ulTimeout = SDIO_CMD_TIMEOUT;
+	uint32_t ulSta;
+
+	switch (ulResp)
+	{
+	case SDIO_RESP_NONE:
+		ulWait = 0U;
+		break;
+
+	case SDIO_RESP_R2:
+		ulWait = SDIO_CMD_WAITRESP_0 | SDIO_CMD_WAITRESP_1;
+		break;
+
+	default:
+		ulWait = SDIO_CMD_WAITRESP_0;
+		break;
+	}
+
+	SDIO->ICR = SDIO_ICR_CMD;
+	SDIO->ARG = ulArg;
+	SDIO->CMD = ulIndex | ulWait | SDIO_CMD_CPSMEN;
+
+	do
+	{
+		ulSta = SDIO->STA & (SDIO_STA_CCRCFAIL | SDIO_STA_CTIMEOUT | SDIO_STA_CMDREND
+				| SDIO_STA_CMDSENT);
+
+		if (--ulTimeout == 0U)
+		{
+			return -1;
+		}
+	} while (ulSta == 0U);
+
+	SDIO->ICR = SDIO_ICR_CMD;
+
+	if (ulResp == SDIO_RESP_NONE)
+	{
+		return 0;
+	}
+
+	if ((ulSta & SDIO_STA_CTIMEOUT) != 0U)
+	{
+		return -1;
+	}
+
+	/* R3 carries no CRC: its check always fails. */
+	if (((ulSta & SDIO_STA_CCRCFAIL) != 0U) && (ulResp != SDIO_RESP_R3))
+	{
+		return -1;
+	}
+
+	if ((ulResp == SDIO_RESP_R1) && ((SDIO->RESP1 & SD_R1_ERRORS) != 0U))
+	{
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Sends an application command (CMD55 first).
+ * @param ulIndex Command index.
+ * @param ulArg Argument.
+ * @param ulResp SDIO_RESP_ kind.
+ * @retval 0 if answered, -1 otherwise.
+ */
+static int32_t sdio_acmd(uint32_t ulIndex, uint32_t ulArg, uint32_t ulResp)
+{
+	if (sdio_cmd(55U, xSd.ulRca, SDIO_RESP_R1) != 0)
+	{
+		return -1;
+	}
+
+	return sdio_cmd(ulIndex, ulArg, ulResp);
+}
+
+/**
+ * @brief Identifies the card, selects it and switches to the fast 4-bit bus.
+ * @param None
+ * @retval 0 if successful, -1 otherwise.
+ */
+static int32_t sdio_card_init(void)
+{
+	uint32_t ulOcrArg = SD_OCR_VOLTAGES;
+	uint32_t ulTries;
+	uint32_t ulCSize;
+
+	SDIO->CLKCR = SDIO_CLKDIV_INIT;
+	SDIO->POWER = SDIO_POWER_PWRCTRL;
+	SDIO->CLKCR |= SDIO_CLKCR_CLKEN;
+
+	/* 74 clocks and the power ramp. */
+	vTaskDelay(pdMS_TO_TICKS(2U));
+
+	xSd.ulRca = 0;
+	(void)sdio_cmd(0U, 0U, SDIO_RESP_NONE);
+
+	/* CMD8 answered: a version 2 card, which may be high capacity. */
+	if ((sdio_cmd(8U, 0x1AAU, SDIO_RESP_SHORT) == 0) && ((SDIO->RESP1 & 0xFFFU) == 0x1AAU))
+	{
+		ulOcrArg |= SD_OCR_CCS;
+	}
+
+	for (ulTries = 0; ulTries < SDIO_ACMD41_TRIES; ulTries++)
+	{
+		if ((sdio_acmd(41U, ulOcrArg, SDIO_RESP_R3) == 0) && ((SDIO->RESP1 & SD_OCR_BUSY) != 0U))
+		{
+			break;
+		}
+
+		vTaskDelay(pdMS_TO_TICKS(1U));
+	}
+
+	if (ulTries == SDIO_ACMD41_TRIES)
+	{
+		return -1;
+	}
+
+	xSd.ucHighCapacity = ((SDIO->RESP1 & SD_OCR_CCS) != 0U) ? 1U : 0U;
+
+	if ((sdio_cmd(2U, 0U, SDIO_RESP_R2) != 0) || (sdio_cmd(3U, 0U, SDIO_RESP_SHORT) != 0))
+	{
+		return -1;
+	}
+
+	xSd.ulRca = SDIO->RESP1 & 0xFFFF0000U;
+
+	/* CSD: RESP1 holds bits 127 to 96, RESP4 bits 31 to 0. */
+	if (sdio_cmd(9U, xSd.ulRca, SDIO_RESP_R2) != 0)
+	{
+		return -1;
+	}
+
+	if ((SDIO->RESP1 >> 30) == 1U)
+	{
+		/* CSD 2.0: (C_SIZE + 1) * 512 KB. */
+		ulCSize = ((SDIO->RESP2 & 0x3FU) << 16) | (SDIO->RESP3 >> 16);
+		xSd.ulBlocks = (ulCSize + 1U) * 1024U;
+	}
+	else
+	{
+		/* CSD 1.0: (C_SIZE + 1) * 2^(C_SIZE_MULT + 2) * 2^READ_BL_LEN bytes. */
+		ulCSize = ((SDIO->RESP2 & 0x3FFU) << 2) | (SDIO->RESP3 >> 30);
+		xSd.ulBlocks = ((ulCSize + 1U) << (((SDIO->RESP3 >> 15) & 7U) + 2U))
+				<< (((SDIO->RESP2 >> 16) & 0xFU) - 9U);
+	}
+
+	if ((sdio_cmd(7U, xSd.ulRca, SDIO_RESP_R1) != 0)
+			|| (sdio_cmd(16U, SDIO_BLOCK_BYTES, SDIO_RESP_R1) != 0)
+			|| (sdio_acmd(6U, 2U, SDIO_RESP_R1) != 0))
+	{
+		return -1;
+	}
+
+	SDIO->CLKCR = SDIO_CLKDIV_DATA | SDIO_CLKCR_WIDBUS_0 | SDIO_CLKCR_CLKEN;
+
+	return 0;
+}
+
+/**
+ * @brief Waits until the card is ready for data, e.g. done programming.
+ * @param None
+ * @retval 0 if ready, -1 after SDIO_TIMEOUT_MS.
+ * @note Asks straight away, then once a tick: writes of 16 KB take a few ms.
+ */
+static int32_t sdio_wait_ready(void)
+{
+	const TickType_t xStart = xTaskGetTickCount();
+	uint32_t ulStatus;
+
+	for (;;)
+	{
+		if (sdio_cmd(13U, xSd.ulRca, SDIO_RESP_R1) == 0)
+		{
+			ulStatus = SDIO->RESP1;
+
+			if (((ulStatus & SD_R1_READY_FOR_DATA) != 0U) && (SD_R1_STATE(ulStatus) == SD_STATE_TRAN))
+			{
+				return 0;
+			}
+		}
+
+		if ((xTaskGetTickCount() - xStart) >= pdMS_TO_TICKS(SDIO_TIMEOUT_MS))
+		{
+			return -1;
+		}
+
+		vTaskDelay(1);
+	}
+}
+
+/**
+ * @brief Moves blocks between the card and memory.
+ * @param ulBlock First block.
+ * @param pvData Buffer, 16-byte aligned.
+ * @param ulCount Blocks.
+ * @param ulWrite 1 to write, 0 to read.
+ * @retval 0 if successful, -1 otherwise.
+ */
+static int32_t sdio_transfer(uint32_t ulBlock, void *pvData, uint32_t ulCount, uint32_t ulWrite)
+{
+	const uint32_t ulAddr = (xSd.ucHighCapacity != 0U) ? ulBlock : (ulBlock * SDIO_BLOCK_BYTES);
+	const uint32_t ulMulti = (ulCount > 1U) ? 1U : 0U;
+	int32_t lResult = -1;
+
+	if ((xSd.ucOpen == 0U) || (pvData == NULL) || (((uint32_t)pvData & 15U) != 0U)
+			|| (ulCount == 0U) || (ulCount > SDIO_MAX_BLOCKS)
+			|| ((ulBlock + ulCount) > xSd.ulBlocks))
+	{
+		return -1;
+	}
+
+	(void)xSemaphoreTake(xSd.xLock, portMAX_DELAY);
+
+	if (sdio_wait_ready() != 0)
+	{
+		xSd.xStats.ulTimeouts++;
+		(void)xSemaphoreGive(xSd.xLock);
+		return -1;
+	}
+
+	/* Let the card erase ahead of a multiple-block write. */
+	if ((ulWrite != 0U) && (ulMulti != 0U) && (sdio_acmd(23U, ulCount, SDIO_RESP_R1) != 0))
+	{
+		xSd.xStats.ulErrors++;
+		(void)xSemaphoreGive(xSd.xLock);
+		return -1;
+	}
+
+	xfer_init(&xSd.xOp, pvData, ulCount * SDIO_BLOCK_BYTES);
+	xfer_on_task(&xSd.xOp, NULL);
+	xSd.ucParts = 2;
+	xSd.ucFailed = 0;
+	xSd.pxActive = (ulWrite != 0U) ? xSd.pxTxStream : xSd.pxRxStream;
+
+	dma_desc_init(&xSd.xDesc, NULL, pvData, ulCount * (SDIO_BLOCK_BYTES / 4U));
+	xfer_on_callback(&xSd.xDesc.xReq, sdio_dma_done, NULL);
+	(void)dma_submit(xSd.pxActive, &xSd.xDesc);
+
+	SDIO->DTIMER = SDIO_DATA_TIMEOUT;
+	SDIO->DLEN = ulCount * SDIO_BLOCK_BYTES;
+	SDIO->ICR = SDIO_ICR_ALL;
+	SDIO->MASK = SDIO_MASK_DCRCFAILIE | SDIO_MASK_DTIMEOUTIE | SDIO_MASK_TXUNDERRIE
+			| SDIO_MASK_RXOVERRIE | SDIO_MASK_DATAENDIE;
+
+	if (ulWrite == 0U)
+	{
+		/* A read: the data path waits for the card's first block. */
+		SDIO->DCTRL = (SDIO_DBLOCKSIZE_512 << SDIO_DCTRL_DBLOCKSIZE_Pos) | SDIO_DCTRL_DMAEN
+				| SDIO_DCTRL_DTDIR | SDIO_DCTRL_DTEN;
+		lResult = sdio_cmd((ulMulti != 0U) ? 18U : 17U, ulAddr, SDIO_RESP_R1);
+	}
+	else
+	{
+		lResult = sdio_cmd((ulMulti != 0U) ? 25U : 24U, ulAddr, SDIO_RESP_R1);
+
+		if (lResult == 0)
+		{
+			SDIO->DCTRL = (SDIO_DBLOCKSIZE_512 << SDIO_DCTRL_DBLOCKSIZE_Pos) | SDIO_DCTRL_DMAEN
+					| SDIO_DCTRL_DTEN;
+		}
+	}
+
+	if ((lResult == 0) && (xfer_wait(&xSd.xOp, pdMS_TO_TICKS(SDIO_TIMEOUT_MS)) == XFER_PENDING))
+	{
+		xSd.xStats.ulTimeouts++;
+		lResult = -1;
+	}
+	else if ((lResult != 0) || (xSd.xOp.lResult == XFER_ERROR))
+	{
+		xSd.xStats.ulErrors += (lResult != 0) ? 1U : 0U;
+		lResult = -1;
+	}
+
+	if (lResult != 0)
+	{
+		/* Give the transfer up: neither side signals it any more. */
+		NVIC_DisableIRQ(SDIO_IRQn);
+		SDIO->MASK = 0;
+		SDIO->DCTRL = 0;
+		SDIO->ICR = SDIO_ICR_ALL;
+		xSd.xDesc.xReq.xSignal = XFER_SIGNAL_NONE;
+		NVIC_EnableIRQ(SDIO_IRQn);
+		dma_abort(xSd.pxActive);
+	}
+
+	if ((ulMulti != 0U) || (lResult != 0))
+	{
+		(void)sdio_cmd(12U, 0U, SDIO_RESP_SHORT);
+	}
+
+	if (lResult == 0)
+	{
+		if (ulWrite != 0U)
+		{
+			xSd.xStats.ulBlocksWritten += ulCount;
+		}
+		else
+		{
+			xSd.xStats.ulBlocksRead += ulCount;
+		}
+	}
+
+	(void)xSemaphoreGive(xSd.xLock);
+
+	return lResult;
+}
+
+/**
+ * @brief Counts one side of the transfer done, and signals it after both.
+ * @param pxHigherPriorityTaskWoken Set if a task woken must run on exit.
+ * @retval None
+ * @note Called from the SDIO and DMA interrupts, at the same priority.
+ */
+static void sdio_part_done(BaseType_t *pxHigherPriorityTaskWoken)
+{
+	if ((xSd.ucParts != 0U) && (--xSd.ucParts == 0U))
+	{
+		xfer_complete_from_isr(&xSd.xOp, (xSd.ucFailed != 0U) ? XFER_ERROR : (int32_t)xSd.xOp.ulLen,
+				pxHigherPriorityTaskWoken);
+	}
+}
+
+/**
+ * @brief Descriptor callback: the DMA side is done.
+ * @param pxReq Descriptor's request.
+ * @param pxHigherPriorityTaskWoken Set if a task woken must run on exit.
+ * @retval None
+ * @note On a read, the DMA empties the SDIO FIFO after DATAEND.
+ */
+static void sdio_dma_done(XferReq_t *pxReq, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	if (pxReq->lResult == XFER_ERROR)
+	{
+		xSd.ucFailed = 1;
+	}
+
+	sdio_part_done(pxHigherPriorityTaskWoken);
+}
@@ -0,0 +1,354 @@
+/*******************************************************************************
+ *
+ * @file	sdlog.c
+ * @brief	Implementation of the SD card data logger.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	Streams bytes from one producer task into LOGnnnnn.BIN files on
+ * 			the SD card. The producer copies into one of two blocks
+ * 			(pingpong.h) and hands it over when full; a writer task sends
+ * 			it to the card in one multiple-block DMA write (sdio.c) while
+ * 			the producer fills the other. The producer never waits for the
+ * 			card: if the writer still holds a block when the next one is
+ * 			full, a block is lost and counted as an overrun.
+ *
+ * 			Each file is created with SDLOG_PREALLOC_BYTES of contiguous
+ * 			clusters (fat.c), so blocks go to consecutive sectors with no
+ * 			FAT update in between; only the directory entry is rewritten,
+ * 			every SDLOG_SYNC_BLOCKS blocks. sdlog_stop() writes the partial
+ * 			block and gives the unused clusters back.
+ *
+ * 			The worst write time of a card (erase, wear levelling) reaches
+ * 			hundreds of milliseconds; a block must take longer than that to
+ * 			fill for no overrun to happen.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pingpong.h"
+#include "sdio.h"
+#include "fat.h"
+#include "sdlog.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define SDLOG_SECTORS_PER_BLOCK	(SDLOG_BLOCK_BYTES / SDIO_BLOCK_BYTES)
+#define SDLOG_MAX_FILES			99999U
+#define SDLOG_NAME_TRIES		1000U	/* Names tried by one sdlog_start(). */
+
+#if ((SDLOG_BLOCK_BYTES % SDIO_BLOCK_BYTES) != 0U) || (SDLOG_SECTORS_PER_BLOCK > SDIO_MAX_BLOCKS)
+#error "SDLOG_BLOCK_BYTES must be a multiple of 512, at most 32 KB"
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint8_t ucMounted;
+	volatile uint8_t ucRunning;
+	TaskHandle_t xWriter;
+	PingPong_t xBlocks;
+	FatFile_t xFile;
+	uint32_t ulCapacity;			/* Blocks the file holds. */
+	uint32_t ulNextFile;
+	uint32_t ulFill;				/* Bytes in the fill block (producer). */
+	uint32_t ulPublished;			/* Blocks handed over (producer). */
+	uint32_t ulWritten;				/* Blocks in the file (writer). */
+	uint32_t ulOverrunBase;
+	SdLogStats_t xStats;
+} SdLog_t;
+
+/* Variables -----------------------------------------------------------------*/
+static SdLog_t xLog;
+static uint32_t ulBlock0[SDLOG_BLOCK_BYTES / 4U] __attribute__((aligned(16)));
+static uint32_t ulBlock1[SDLOG_BLOCK_BYTES / 4U] __attribute__((aligned(16)));
+
+/* Private function prototypes -----------------------------------------------*/
+static int32_t sdlog_create_file(void);
+static int32_t sdlog_write_block(const void *pvBlock, uint32_t ulSectors);
+static void sdlog_writer_task(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Opens the card if needed and starts a new log file.
+ * @param uxPriority Priority of the writer task, created on the first call;
+ * above the producer's keeps the card busy.
+ * @retval 0 if successful, -1 if already running, or no card, FAT32 volume,
+ * free name or free space is found.
+ * @note Call from a task.
+ */
+int32_t sdlog_start(UBaseType_t uxPriority)
+{
+	if (xLog.ucRunning != 0U)
+	{
+		return -1;
+	}
+
+	if (xLog.ucMounted == 0U)
+	{
+		if (((sdio_get_blocks() == 0U) && (sdio_open() != 0)) || (fat_mount() != 0))
+		{
+			return -1;
+		}
+
+		(void)pingpong_init(&xLog.xBlocks, ulBlock0, ulBlock1);
+		xLog.ulNextFile = 1;
+		xLog.ucMounted = 1;
+	}
+
+	if (sdlog_create_file() != 0)
+	{
+		return -1;
+	}
+
+	if ((xLog.xWriter == NULL) && (xTaskCreate(sdlog_writer_task, "sdlog", SDLOG_STACK_WORDS,
+			NULL, uxPriority, &xLog.xWriter) != pdPASS))
+	{
+		xLog.xWriter = NULL;
+		(void)fat_truncate(&xLog.xFile, 0U);
+		return -1;
+	}
+
+	taskENTER_CRITICAL();
+	(void)memset(&xLog.xStats, 0, sizeof(xLog.xStats));
+	xLog.xStats.ulFile = xLog.ulNextFile - 1U;
+	taskEXIT_CRITICAL();
+
+	xLog.ulCapacity = (xLog.xFile.ulClusters * fat_get_cluster_bytes()) / SDLOG_BLOCK_BYTES;
+	xLog.ulFill = 0;
+	xLog.ulPublished = 0;
+	xLog.ulWritten = 0;
+	xLog.ulOverrunBase = pingpong_get_overruns(&xLog.xBlocks);
+	xLog.ucRunning = 1;
+
+	return 0;
+}
+
+/**
+ * @brief Adds bytes to the log.
+ * @param pvData Bytes.
+ * @param ulLen Number of bytes.
+ * @retval Bytes taken; the rest are dropped (not running, or the file full).
+ * @note One producer task. Never waits for the card.
+ */
+uint32_t sdlog_write(const void *pvData, uint32_t ulLen)
+{
+	const uint8_t *pucData = (const uint8_t *)pvData;
+	uint32_t ulTaken = 0;
+	uint32_t ulChunk;
+
+	while ((ulTaken < ulLen) && (xLog.ucRunning != 0U) && (xLog.ulPublished < xLog.ulCapacity))
+	{
+		ulChunk = SDLOG_BLOCK_BYTES - xLog.ulFill;
+
+		if (ulChunk > (ulLen - ulTaken))
+		{
+			ulChunk = ulLen - ulTaken;
+		}
+
+		(void)memcpy((uint8_t *)pingpong_fill_buffer(&xLog.xBlocks) + xLog.ulFill,
+				&pucData[ulTaken], ulChunk);
+		xLog.ulFill += ulChunk;
+		ulTaken += ulChunk;
+
+		if (xLog.ulFill == SDLOG_BLOCK_BYTES)
+		{
+			(void)pingpong_swap(&xLog.xBlocks);
+			xLog.ulFill = 0;
+			xLog.ulPublished++;
+		}
+	}
+
+	if (ulTaken < ulLen)
+	{
+		taskENTER_CRITICAL();
+		xLog.xStats.ulDropped += ulLen - ulTaken;
+		taskEXIT_CRITICAL();
+	}
+
+	return ulTaken;
+}
+
+/**
+ * @brief Writes what is left, closes the file and gives its unused space back.
+ * @param None
+ * @retval 0 if successful, -1 if not running or the card fails.
+ * @note Call from the producer task. Waits for the block in flight.
+ */
+int32_t sdlog_stop(void)
+{
+	uint8_t *pucFill;
+	uint32_t ulSize;
+	int32_t lResult = 0;
+
+	if (xLog.ucRunning == 0U)
+	{
+		return -1;
+	}
+
+	xLog.ucRunning = 0;
+
+	/* The writer owns the card and the file until both blocks are free. */
+	while ((xLog.xBlocks.ulState & (PINGPONG_READY | PINGPONG_BUSY)) != 0U)
+	{
+		vTaskDelay(1);
+	}
+
+	ulSize = xLog.ulWritten * SDLOG_BLOCK_BYTES;
+
+	if ((xLog.ulFill != 0U) && (xLog.ulWritten < xLog.ulCapacity))
+	{
+		/* Whole sectors; the padding lies past the end of the file. */
+		const uint32_t ulSectors = (xLog.ulFill + SDIO_BLOCK_BYTES - 1U) / SDIO_BLOCK_BYTES;
+
+		pucFill = (uint8_t *)pingpong_fill_buffer(&xLog.xBlocks);
+		(void)memset(&pucFill[xLog.ulFill], 0, (ulSectors * SDIO_BLOCK_BYTES) - xLog.ulFill);
+
+		if (sdlog_write_block(pucFill, ulSectors) == 0)
+		{
+			ulSize += xLog.ulFill;
+
+			taskENTER_CRITICAL();
+			xLog.xStats.ulBytes += xLog.ulFill;
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			lResult = -1;
+		}
+	}
+
+	xLog.ulFill = 0;
+
+	if (fat_truncate(&xLog.xFile, ulSize) != 0)
+	{
+		lResult = -1;
+	}
+
+	return lResult;
+}
+
+/**
+ * @brief Reads the counters of the current or last file.
+ * @param pxStats Receives the counters.
+ * @retval None
+ */
+void sdlog_get_stats(SdLogStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = xLog.xStats;
+	pxStats->ulOverruns = pingpong_get_overruns(&xLog.xBlocks) - xLog.ulOverrunBase;
+	taskEXIT_CRITICAL();
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Creates the first free LOGnnnnn.BIN from the last number used on.
+ * @param None
+ * @retval 0 if successful, -1 otherwise.
+ * @note A name that exists fails as the card being full does; only
+ * SDLOG_NAME_TRIES names are tried.
+ */
+static int32_t sdlog_create_file(void)
+{
+	char cName[13];
+	uint32_t ulTry;
+
+	for (ulTry = 0; ulTry < SDLOG_NAME_TRIES; ulTry++)
+	{
+		if (xLog.ulNextFile > SDLOG_MAX_FILES)
+		{
+			return -1;
+		}
+
+		(void)snprintf(cName, sizeof(cName), "LOG%05lu.BIN", (unsigned long)xLog.ulNextFile);
+		xLog.ulNextFile++;
+
+		if (fat_create_contiguous(&xLog.xFile, cName, SDLOG_PREALLOC_BYTES) == 0)
+		{
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Writes sectors after the last block of the file and times it.
+ * @param pvBlock Data, 16-byte aligned.
+ * @param ulSectors Sectors.
+ * @retval 0 if successful, -1 otherwise.
+ */
+static int32_t sdlog_write_block(const void *pvBlock, uint32_t ulSectors)
+{
+	const TickType_t xStart = xTaskGetTickCount();
+	const int32_t lResult = sdio_write(xLog.xFile.ulLba + (xLog.ulWritten * SDLOG_SECTORS_PER_BLOCK),
+			pvBlock, ulSectors);
+	const uint32_t ulMs = (uint32_t)(xTaskGetTickCount() - xStart) * portTICK_PERIOD_MS;
+
+	taskENTER_CRITICAL();
+
+	if (ulMs > xLog.xStats.ulMaxWriteMs)
+	{
+		xLog.xStats.ulMaxWriteMs = ulMs;
+	}
+
+	if (lResult != 0)
+	{
+		xLog.xStats.ulErrors++;
+	}
+
+	taskEXIT_CRITICAL();
+
+	return lResult;
+}
+
+/**
+ * @brief Writes each block handed over to the file.
+ * @param pvParameters Not used.
+ * @retval None
+ * @note A block that fails is lost; the next one takes its place, so the
+ * file has no gap.
+ */
+static void sdlog_writer_task(void *pvParameters)
+{
+	const void *pvBlock;
+
+	(void)pvParameters;
+
+	for (;;)
+	{
+		pvBlock = pingpong_wait(&xLog.xBlocks, portMAX_DELAY);
+
+		if (pvBlock == NULL)
+		{
+			continue;
+		}
+
+		if ((xLog.ulWritten < xLog.ulCapacity)
+				&& (sdlog_write_block(pvBlock, SDLOG_SECTORS_PER_BLOCK) == 0))
+		{
+			xLog.ulWritten++;
+
+			taskENTER_CRITICAL();
+			xLog.xStats.ulBlocks++;
+			xLog.xStats.ulBytes += SDLOG_BLOCK_BYTES;
+			taskEXIT_CRITICAL();
+
+			/* Before the release: sdlog_stop() then finds the file idle. */
+			if (((xLog.ulWritten % SDLOG_SYNC_BLOCKS) == 0U)
+					&& (fat_set_size(&xLog.xFile, xLog.ulWritten * SDLOG_BLOCK_BYTES) != 0))
+			{
+				taskENTER_CRITICAL();
+				xLog.xStats.ulErrors++;
+				taskEXIT_CRITICAL();
+			}
+		}
+
+		pingpong_release(&xLog.xBlocks);
+	}
+}
@@ -0,0 +1,579 @@
+/*******************************************************************************
+ *
+ * @file	spi.c
+ * @brief	Implementation of the SPI master driver.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	One driver for SPI1 to SPI3, table driven like uart.c. Each open
+ * 			bus owns an RX and a TX stream from dma.c, so a transaction is
+ * 			two descriptors and the CPU touches no byte of it.
+ *
+ * 			Transactions (SpiXfer_t, xfer.h requests) queue per bus, in the
+ * 			order they are submitted, whichever device they are for. The
+ * 			one at the head owns the bus: the driver loads its device's
+ * 			clock divider and mode, pulls its chip select low and starts the
+ * 			RX stream, then the TX stream, which clocks the bytes out. The
+ * 			RX completion ends it: chip select goes high once the last byte
+ * 			is off the wire, the next transaction starts, and only then is
+ * 			the finished one signalled. Devices of different speeds and
+ * 			modes share a bus without a task in between, and nothing runs
+ * 			per byte.
+ *
+ * 			TX always runs ahead of RX, so a transaction may send a buffer
+ * 			and receive into it (pvTx NULL), e.g. a register address and
+ * 			dummy bytes replaced by the reply.
+ *
+ * 			Periodic reads: an hrtimer.c timer submits the same command each
+ * 			period, from the TIM5 interrupt, and the replies land one after
+ * 			the other in the fill buffer of a pingpong.h double buffer. When
+ * 			a block is full it is swapped to the consumer task, which wakes
+ * 			once per block and no task polls the sensor. A period whose
+ * 			previous read has not completed is skipped and counted.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clkgate.h"
+#include "xfer.h"
+#include "dma.h"
+#include "hrtimer.h"
+#include "pingpong.h"
+#include "spi.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define SPI_BSY_TIMEOUT			1000U	/* Busy-wait iterations, > 1 byte at the slowest clock. */
+#define GPIO_PORT_STRIDE		0x400U
+#define PIN_MODE_OUTPUT			1U
+#define PIN_MODE_AF				2U
+#define PIN_SPEED_HIGH			3U
+#define PIN_PULL_UP				1U
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	SPI_TypeDef *pxSpi;
+	uint8_t ucClock;				/* ClkGate_t of the SPI. */
+	uint8_t ucOnApb2;
+	uint8_t ucAf;
+	GPIO_TypeDef *pxPort;			/* SCK, MISO and MOSI. */
+	uint8_t ucSckPin;
+	uint8_t ucMisoPin;
+	uint8_t ucMosiPin;
+	uint8_t ucRxRequest;			/* DmaRequest_t */
+	uint8_t ucTxRequest;
+	uint8_t ucEnabled;				/* SPI_USE_xxx */
+} SpiHw_t;
+
+typedef struct
+{
+	uint8_t ucOpen;
+	DmaStream_t *pxRxStream;
+	DmaStream_t *pxTxStream;
+	XferQueue_t xQueue;				/* Head: the transaction on the bus. */
+	SpiStats_t xStats;
+	ClkGateUser_t xSpiClock;
+	ClkGateUser_t xPinClock;
+} SpiState_t;
+
+/* Variables -----------------------------------------------------------------*/
+static const SpiHw_t xSpiHw[SPI_BUSES] =
+{
+	{ SPI1, CLKGATE_SPI1, 1, 5, GPIOA, 5, 6, 7, DMA_REQ_SPI1_RX, DMA_REQ_SPI1_TX, SPI_USE_SPI1 },
+	{ SPI2, CLKGATE_SPI2, 0, 5, GPIOB, 13, 14, 15, DMA_REQ_SPI2_RX, DMA_REQ_SPI2_TX, SPI_USE_SPI2 },
+	{ SPI3, CLKGATE_SPI3, 0, 6, GPIOC, 10, 11, 12, DMA_REQ_SPI3_RX, DMA_REQ_SPI3_TX, SPI_USE_SPI3 }
+};
+
+static SpiState_t xSpiState[SPI_BUSES];
+
+/* Private function prototypes -----------------------------------------------*/
+static ClkGate_t spi_port_clock(const GPIO_TypeDef *pxPort);
+static void spi_pin_init(GPIO_TypeDef *pxPort, uint8_t ucPin, uint8_t ucMode, uint8_t ucAf,
+		uint8_t ucPullUp);
+static uint32_t spi_pclk(const SpiHw_t *pxHw);
+static void spi_start(SpiXfer_t *pxXfer);
+static void spi_rx_done(XferReq_t *pxReq, BaseType_t *pxHigherPriorityTaskWoken);
+static void spi_periodic_tick(HrTimer_t *pxTimer, void *pvArg);
+static void spi_periodic_done(XferReq_t *pxReq, BaseType_t *pxHigherPriorityTaskWoken);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Opens a bus as master and allocates its DMA streams.
+ * @param xBus Bus, compiled in with its SPI_USE_xxx.
+ * @retval 0 if successful, -1 if the bus is not compiled in or already open,
+ * or dma_alloc() found no stream for it.
+ * @note Call from a task or before the scheduler starts.
+ */
+int32_t spi_open(SpiBus_t xBus)
+{
+	const SpiHw_t *pxHw;
+	SpiState_t *pxState;
+	DmaConfig_t xRxCfg;
+	DmaConfig_t xTxCfg;
+
+	if ((xBus >= SPI_BUSES) || (xSpiHw[xBus].ucEnabled == 0U) || (xSpiState[xBus].ucOpen != 0U))
+	{
+		return -1;
+	}
+
+	pxHw = &xSpiHw[xBus];
+	pxState = &xSpiState[xBus];
+
+	/* At most a byte per 16 PCLK cycles (divider 2). RX a level above TX,
+	 * so a byte is read before the next one arrives. */
+	xTxCfg.xRequest = (DmaRequest_t)pxHw->ucTxRequest;
+	xTxCfg.xDir = DMA_DIR_M2P;
+	xTxCfg.ucPriority = SPI_DMA_PRIORITY;
+	xTxCfg.ucItemSize = 1U;
+	xTxCfg.ucPeriphInc = 0U;
+	xTxCfg.ucMemInc = 1U;
+	xTxCfg.pvPeriph = &pxHw->pxSpi->DR;
+	xTxCfg.ulBandwidth = spi_pclk(pxHw) / 16U;
+
+	xRxCfg = xTxCfg;
+	xRxCfg.xRequest = (DmaRequest_t)pxHw->ucRxRequest;
+	xRxCfg.xDir = DMA_DIR_P2M;
+	xRxCfg.ucPriority = (SPI_DMA_PRIORITY < DMA_PL_VERY_HIGH) ? (SPI_DMA_PRIORITY + 1U)
+			: DMA_PL_VERY_HIGH;
+
+	if (dma_alloc(&xRxCfg, &pxState->pxRxStream) != 0)
+	{
+		return -1;
+	}
+
+	if (dma_alloc(&xTxCfg, &pxState->pxTxStream) != 0)
+	{
+		dma_free(pxState->pxRxStream);
+		return -1;
+	}
+
+	clkgate_user_init(&pxState->xSpiClock, (ClkGate_t)pxHw->ucClock);
+	clkgate_user_init(&pxState->xPinClock, spi_port_clock(pxHw->pxPort));
+	clkgate_acquire(&pxState->xSpiClock);
+	clkgate_acquire(&pxState->xPinClock);
+
+	spi_pin_init(pxHw->pxPort, pxHw->ucSckPin, PIN_MODE_AF, pxHw->ucAf, 0);
+	spi_pin_init(pxHw->pxPort, pxHw->ucMisoPin, PIN_MODE_AF, pxHw->ucAf, 1);
+	spi_pin_init(pxHw->pxPort, pxHw->ucMosiPin, PIN_MODE_AF, pxHw->ucAf, 0);
+
+	/* Master, 8 bits, software slave select; the rest per device. */
+	pxHw->pxSpi->CR1 = SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI;
+	pxHw->pxSpi->CR2 = SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN;
+
+	pxState->xQueue.pxHead = NULL;
+	pxState->xQueue.pxTail = NULL;
+	memset(&pxState->xStats, 0, sizeof(pxState->xStats));
+	pxState->ucOpen = 1;
+
+	return 0;
+}
+
+/**
+ * @brief Describes a device and drives its chip select high.
+ * @param pxDevice Device to initialize.
+ * @param xBus Open bus it is on.
+ * @param pxCsPort Port of its chip select pin.
+ * @param ucCsPin Chip select pin, 0 to 15.
+ * @param ulMaxHz Fastest clock it takes; the bus runs at the fastest PCLK
+ * division at or below it.
+ * @param ucMode SPI_MODE_0 to SPI_MODE_3.
+ * @retval 0 if successful, -1 if the bus is not open, the mode is invalid or
+ * PCLK / 256 is still too fast.
+ * @note Call from a task.
+ */
+int32_t spi_device_init(SpiDevice_t *pxDevice, SpiBus_t xBus, GPIO_TypeDef *pxCsPort,
+		uint8_t ucCsPin, uint32_t ulMaxHz, uint8_t ucMode)
+{
+	uint32_t ulPclk;
+	uint32_t ulBr = 0;
+
+	if ((xBus >= SPI_BUSES) || (xSpiState[xBus].ucOpen == 0U) || (pxCsPort == NULL)
+			|| (ucCsPin > 15U) || (ucMode > SPI_MODE_3))
+	{
+		return -1;
+	}
+
+	ulPclk = spi_pclk(&xSpiHw[xBus]);
+
+	/* Divider 2 << BR. */
+	while ((ulPclk / (2U << ulBr)) > ulMaxHz)
+	{
+		if (++ulBr > 7U)
+		{
+			return -1;
+		}
+	}
+
+	pxDevice->ucBus = (uint8_t)xBus;
+	pxDevice->ucCsPin = ucCsPin;
+	pxDevice->usCr1 = (uint16_t)((ulBr << SPI_CR1_BR_Pos)
+			| (((ucMode & 2U) != 0U) ? SPI_CR1_CPOL : 0U)
+			| (((ucMode & 1U) != 0U) ? SPI_CR1_CPHA : 0U));
+	pxDevice->pxCsPort = pxCsPort;
+
+	clkgate_user_init(&pxDevice->xCsClock, spi_port_clock(pxCsPort));
+	clkgate_acquire(&pxDevice->xCsClock);
+
+	pxCsPort->BSRR = 1U << ucCsPin;
+	spi_pin_init(pxCsPort, ucCsPin, PIN_MODE_OUTPUT, 0U, 0U);
+
+	return 0;
+}
+
+/**
+ * @brief Prepares a transaction, with no completion signal.
+ * @param pxXfer Transaction, not submitted.
+ * @param pxDevice Device.
+ * @param pvTx ulLen bytes to send, or NULL to send pvRx and receive over it.
+ * @param pvRx Receives ulLen bytes.
+ * @param ulLen Number of bytes, 1 to DMA_MAX_ITEMS.
+ * @retval None
+ * @note Choose the signal with xfer_on_...(&pxXfer->xReq, ...).
+ */
+void spi_xfer_init(SpiXfer_t *pxXfer, SpiDevice_t *pxDevice, const void *pvTx, void *pvRx,
+		uint32_t ulLen)
+{
+	xfer_init(&pxXfer->xReq, pvRx, ulLen);
+	pxXfer->pxDevice = pxDevice;
+	pxXfer->pvTx = pvTx;
+}
+
+/**
+ * @brief Queues a transaction on its device's bus.
+ * @param pxXfer Transaction from spi_xfer_init().
+ * @retval 0 if queued, -1 if it is empty, too long or its bus is not open.
+ * @note Starts at once on an idle bus, otherwise when the transactions before
+ * it are done. The buffers belong to the driver until it completes. May be
+ * called from an ISR, e.g. a completion callback.
+ */
+int32_t spi_submit(SpiXfer_t *pxXfer)
+{
+	SpiState_t *pxState;
+	UBaseType_t uxSavedInterruptStatus;
+
+	if ((pxXfer->pxDevice == NULL) || (pxXfer->pxDevice->ucBus >= SPI_BUSES)
+			|| (pxXfer->xReq.ulLen == 0U) || (pxXfer->xReq.ulLen > DMA_MAX_ITEMS))
+	{
+		return -1;
+	}
+
+	pxState = &xSpiState[pxXfer->pxDevice->ucBus];
+
+	if (pxState->ucOpen == 0U)
+	{
+		return -1;
+	}
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+	if (xfer_queue_push(&pxState->xQueue, &pxXfer->xReq))
+	{
+		spi_start(pxXfer);
+	}
+	else
+	{
+		pxState->xStats.ulQueued++;
+	}
+
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	return 0;
+}
+
+/**
+ * @brief Runs a transaction and waits for it.
+ * @param pxDevice Device.
+ * @param pvTx ulLen bytes to send, or NULL to send pvRx and receive over it.
+ * @param pvRx Receives ulLen bytes.
+ * @param ulLen Number of bytes, 1 to DMA_MAX_ITEMS.
+ * @retval ulLen if successful, -1 otherwise.
+ * @note Call from a task. It blocks on notification XFER_NOTIFY_INDEX.
+ */
+int32_t spi_transfer(SpiDevice_t *pxDevice, const void *pvTx, void *pvRx, uint32_t ulLen)
+{
+	SpiXfer_t xXfer;
+
+	spi_xfer_init(&xXfer, pxDevice, pvTx, pvRx, ulLen);
+	xfer_on_task(&xXfer.xReq, NULL);
+
+	if (spi_submit(&xXfer) != 0)
+	{
+		return -1;
+	}
+
+	return xfer_wait(&xXfer.xReq, portMAX_DELAY);
+}
+
+/**
+ * @brief Starts reading a device periodically into a double buffer.
+ * @param pxPeriodic Periodic read, not started.
+ * @param pxDevice Device.
+ * @param pvCmd ulLen bytes sent each period, e.g. a burst read command.
+ * @param ulLen Length of a transaction; the first reply bytes are those
+ * received during the command.
+ * @param ulPeriodUs Period, in microseconds.
+ * @param pxPingPong Double buffer whose buffers hold ulSamples * ulLen bytes.
+ * Its consumer gets the blocks with pingpong_wait().
+ * @param ulSamples Replies per block.
+ * @retval 0 if started, -1 otherwise.
+ * @note hrtimer_init() must have been called. Call from a task.
+ */
+int32_t spi_periodic_start(SpiPeriodic_t *pxPeriodic, SpiDevice_t *pxDevice, const void *pvCmd,
+		uint32_t ulLen, uint32_t ulPeriodUs, PingPong_t *pxPingPong, uint32_t ulSamples)
+{
+	if ((pxPeriodic == NULL) || (pxDevice == NULL) || (pvCmd == NULL) || (ulLen == 0U)
+			|| (ulLen > DMA_MAX_ITEMS) || (ulPeriodUs == 0U) || (pxPingPong == NULL)
+			|| (ulSamples == 0U))
+	{
+		return -1;
+	}
+
+	pxPeriodic->pxPingPong = pxPingPong;
+	pxPeriodic->pucBlock = (uint8_t *)pingpong_fill_buffer(pxPingPong);
+	pxPeriodic->ulSamples = ulSamples;
+	pxPeriodic->ulIndex = 0;
+	pxPeriodic->ucBusy = 0;
+	pxPeriodic->ulMissed = 0;
+	pxPeriodic->ulErrors = 0;
+
+	spi_xfer_init(&pxPeriodic->xXfer, pxDevice, pvCmd, pxPeriodic->pucBlock, ulLen);
+	xfer_on_callback(&pxPeriodic->xXfer.xReq, spi_periodic_done, pxPeriodic);
+
+	hrtimer_setup(&pxPeriodic->xTimer, spi_periodic_tick, pxPeriodic);
+
+	return hrtimer_start(&pxPeriodic->xTimer, ulPeriodUs, ulPeriodUs);
+}
+
+/**
+ * @brief Stops a periodic read.
+ * @param pxPeriodic Periodic read.
+ * @retval None
+ * @note Returns once its last transaction is done. The block being filled is
+ * not handed over. Call from a task.
+ */
+void spi_periodic_stop(SpiPeriodic_t *pxPeriodic)
+{
+	hrtimer_stop(&pxPeriodic->xTimer);
+
+	while (pxPeriodic->ucBusy != 0U)
+	{
+		vTaskDelay(1);
+	}
+}
+
+/**
+ * @brief Reads the counters of a bus.
+ * @param xBus Open bus.
+ * @param pxStats Receives the counters.
+ * @retval 0 if successful, -1 if the bus is not open.
+ */
+int32_t spi_get_stats(SpiBus_t xBus, SpiStats_t *pxStats)
+{
+	UBaseType_t uxSavedInterruptStatus;
+
+	if ((xBus >= SPI_BUSES) || (xSpiState[xBus].ucOpen == 0U))
+	{
+		return -1;
+	}
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	*pxStats = xSpiState[xBus].xStats;
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	return 0;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Returns the clock gate of a GPIO port.
+ * @param pxPort GPIO port.
+ * @retval CLKGATE_GPIOA to CLKGATE_GPIOH.
+ */
+static ClkGate_t spi_port_clock(const GPIO_TypeDef *pxPort)
+{
+	return (ClkGate_t)(CLKGATE_GPIOA + (((uint32_t)pxPort - GPIOA_BASE) / GPIO_PORT_STRIDE));
+}
+
+/**
+ * @brief Configures a pin for the bus or a chip select.
+ * @param pxPort GPIO port (clock enabled).
+ * @param ucPin Pin number, 0 to 15.
+ * @param ucMode PIN_MODE_AF or PIN_MODE_OUTPUT.
+ * @param ucAf Alternate function, for PIN_MODE_AF.
+ * @param ucPullUp 1 to pull the pin up (MISO, while no device drives it).
+ * @retval None
+ */
+static void spi_pin_init(GPIO_TypeDef *pxPort, uint8_t ucPin, uint8_t ucMode, uint8_t ucAf,
+		uint8_t ucPullUp)
+{
+	uint32_t ulShift2 = 2U * ucPin;
+	uint32_t ulShift4 = 4U * (ucPin & 7U);
+
+	pxPort->AFR[ucPin >> 3] = (pxPort->AFR[ucPin >> 3] & ~(0xFU << ulShift4))
+			| ((uint32_t)ucAf << ulShift4);
+	pxPort->OTYPER &= ~(1U << ucPin);
+	pxPort->OSPEEDR = (pxPort->OSPEEDR & ~(3U << ulShift2)) | (PIN_SPEED_HIGH << ulShift2);
+	pxPort->PUPDR = (pxPort->PUPDR & ~(3U << ulShift2))
+			| ((ucPullUp ? PIN_PULL_UP : 0U) << ulShift2);
+	pxPort->MODER = (pxPort->MODER & ~(3U << ulShift2)) | ((uint32_t)ucMode << ulShift2);
+}
+
+/**
+ * @brief Returns the clock of a bus.
+ * @param pxHw Bus.
+ * @retval PCLK2 for SPI1, PCLK1 for the others.
+ */
+static uint32_t spi_pclk(const SpiHw_t *pxHw)
+{
+	return pxHw->ucOnApb2 ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+}
+
+/**
+ * @brief Puts a transaction on the bus.
+ * @param pxXfer Transaction at the head of its bus's queue, in a critical
+ * section.
+ * @retval None
+ */
+static void spi_start(SpiXfer_t *pxXfer)
+{
+	const SpiDevice_t *pxDevice = pxXfer->pxDevice;
+	const SpiHw_t *pxHw = &xSpiHw[pxDevice->ucBus];
+	SpiState_t *pxState = &xSpiState[pxDevice->ucBus];
+	SPI_TypeDef *pxSpi = pxHw->pxSpi;
+	const uint32_t ulCr1 = SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI | pxDevice->usCr1;
+
+	/* The divider and mode can only change with the SPI disabled. */
+	if ((pxSpi->CR1 & ~SPI_CR1_SPE) != ulCr1)
+	{
+		pxSpi->CR1 = ulCr1;
+	}
+
+	pxSpi->CR1 = ulCr1 | SPI_CR1_SPE;
+
+	/* Drop a byte left over from a failed transaction, and its overrun. */
+	(void)pxSpi->DR;
+	(void)pxSpi->SR;
+
+	pxDevice->pxCsPort->BSRR = 1U << (pxDevice->ucCsPin + 16U);
+
+	dma_desc_init(&pxXfer->xRxDesc, NULL, pxXfer->xReq.pvData, pxXfer->xReq.ulLen);
+	xfer_on_callback(&pxXfer->xRxDesc.xReq, spi_rx_done, pxXfer);
+	dma_desc_init(&pxXfer->xTxDesc, NULL,
+			(void *)((pxXfer->pvTx != NULL) ? pxXfer->pvTx : pxXfer->xReq.pvData),
+			pxXfer->xReq.ulLen);
+
+	/* RX first: the TX stream starts the clock. */
+	(void)dma_submit(pxState->pxRxStream, &pxXfer->xRxDesc);
+	(void)dma_submit(pxState->pxTxStream, &pxXfer->xTxDesc);
+}
+
+/**
+ * @brief Ends the transaction on a bus: its RX descriptor has completed.
+ * @param pxReq RX descriptor's request.
+ * @param pxHigherPriorityTaskWoken Set if a task woken must run on exit.
+ * @retval None
+ * @note Runs in the RX stream's interrupt.
+ */
+static void spi_rx_done(XferReq_t *pxReq, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	SpiXfer_t *pxXfer = (SpiXfer_t *)pxReq->pvContext;
+	const SpiDevice_t *pxDevice = pxXfer->pxDevice;
+	SpiState_t *pxState = &xSpiState[pxDevice->ucBus];
+	SPI_TypeDef *pxSpi = xSpiHw[pxDevice->ucBus].pxSpi;
+	UBaseType_t uxSavedInterruptStatus;
+	uint32_t ulTimeout = SPI_BSY_TIMEOUT;
+	const int32_t lResult = (pxReq->lResult == XFER_ERROR) ? XFER_ERROR
+			: (int32_t)pxXfer->xReq.ulLen;
+
+	/* The last byte is in; the clock stops a moment later. */
+	while (((pxSpi->SR & SPI_SR_BSY) != 0U) && (--ulTimeout != 0U))
+	{
+	}
+
+	pxDevice->pxCsPort->BSRR = 1U << pxDevice->ucCsPin;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+	(void)xfer_queue_pop(&pxState->xQueue);
+
+	if (lResult == XFER_ERROR)
+	{
+		pxState->xStats.ulErrors++;
+	}
+	else
+	{
+		pxState->xStats.ulXfers++;
+		pxState->xStats.ulBytes += (uint32_t)lResult;
+	}
+
+	if (pxState->xQueue.pxHead != NULL)
+	{
+		spi_start((SpiXfer_t *)pxState->xQueue.pxHead);
+	}
+
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	xfer_complete_from_isr(&pxXfer->xReq, lResult, pxHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Hrtimer callback of a periodic read: submits this period's read.
+ * @param pxTimer Timer.
+ * @param pvArg The periodic read.
+ * @retval None
+ * @note Runs in the TIM5 interrupt, which preempts the DMA ones, so ucBusy
+ * rather than the request's result says whether the last one is stored.
+ */
+static void spi_periodic_tick(HrTimer_t *pxTimer, void *pvArg)
+{
+	SpiPeriodic_t *pxPeriodic = (SpiPeriodic_t *)pvArg;
+	const uint32_t ulLen = pxPeriodic->xXfer.xReq.ulLen;
+
+	(void)pxTimer;
+
+	if (pxPeriodic->ucBusy != 0U)
+	{
+		pxPeriodic->ulMissed++;
+		return;
+	}
+
+	pxPeriodic->ucBusy = 1;
+	pxPeriodic->xXfer.xReq.pvData = &pxPeriodic->pucBlock[pxPeriodic->ulIndex * ulLen];
+
+	if (spi_submit(&pxPeriodic->xXfer) != 0)
+	{
+		pxPeriodic->ulErrors++;
+		pxPeriodic->ucBusy = 0;
+	}
+}
+
+/**
+ * @brief Completion of a periodic read: hands full blocks to the consumer.
+ * @param pxReq The periodic read's request.
+ * @param pxHigherPriorityTaskWoken Set if the consumer must run on exit.
+ * @retval None
+ * @note A failed read is retried in the same slot next period.
+ */
+static void spi_periodic_done(XferReq_t *pxReq, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	SpiPeriodic_t *pxPeriodic = (SpiPeriodic_t *)pxReq->pvContext;
+
+	if (pxReq->lResult == XFER_ERROR)
+	{
+		pxPeriodic->ulErrors++;
+	}
+	else if (++pxPeriodic->ulIndex == pxPeriodic->ulSamples)
+	{
+		pxPeriodic->pucBlock = (uint8_t *)pingpong_swap_from_isr(pxPeriodic->pxPingPong,
+				pxHigherPriorityTaskWoken);
+		pxPeriodic->ulIndex = 0;
+	}
+
+	pxPeriodic->ucBusy = 0;
+}
@@ -0,0 +1,780 @@
+/*******************************************************************************
+ *
+ * @file	timesync.c
+ * @brief	Clock synchronization between boards over serial links.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	A two-way exchange as in PTP, over SLIP frames (frame.c) on a
+ * 			UART. Every TIMESYNC_PERIOD_MS the slave end of a link sends a
+ * 			request at t1 and the master end receives it at t2; the master
+ * 			answers at t3 with t2 and t3 in the frame, and the slave receives
+ * 			the answer at t4. With the same delay both ways:
+ *
+ * 				offset = ((t2 - t1) + (t3 - t4)) / 2
+ * 				delay  = ((t4 - t1) - (t3 - t2)) / 2
+ *
+ * 			Receive times come from the hardware: each link's RX pin is also
+ * 			wired to a TIM3 input (TIM5's own inputs are the console pins),
+ * 			which captures the falling edge of the first start bit. TIM3
+ * 			free-runs over 16 bits at the timer clock, so the capture
+ * 			interrupt turns its count into timestamp_now_us() time, at
+ * 			interrupt latency plus a few instructions no matter how late the
+ * 			task reads the frame. A capture is armed only while its line is
+ * 			idle, so it always takes the first edge of a frame.
+ *
+ * 			Send times are scheduled instead: the frame is stamped with a
+ * 			time TIMESYNC_TX_LEAD_US ahead, encoded, and handed to the TX DMA
+ * 			when the clock reaches it, with interrupts masked for the last
+ * 			few microseconds. The constant latency from there to the start
+ * 			bit adds to both directions, so it leaves the offset alone.
+ *
+ * 			Samples whose delay is more than TIMESYNC_DELAY_MARGIN_US above
+ * 			the smallest of the last TIMESYNC_DELAY_WINDOW are dropped: they
+ * 			were held up somewhere and the delay was not symmetric.
+ *
+ * 			The synchronized clock is the local one plus an offset that
+ * 			changes at a rate: offset(t) = offset0 + (t - t0) * rate / 10^9.
+ * 			Each sample's error against that model slews the rate so the
+ * 			error is gone by the next sample, and a share of it, over the
+ * 			time since the last sample, is added to the drift estimate the
+ * 			rate comes back to. So the clock stays continuous and monotonic;
+ * 			only errors above TIMESYNC_STEP_US (the first sample, a new
+ * 			master) set it directly. The model is published as a latch, as
+ * 			in timestamp.c, so timesync_now_us() is lock-free.
+ *
+ * 			A node has at most one slave link and any number of master
+ * 			links, which answer in its synchronized time: the middle of
+ * 			three boards follows the first and leads the third.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clkgate.h"
+#include "frame.h"
+#include "timestamp.h"
+#include "timesync.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define TIMESYNC_MSG_REQ		1U		/* type, sequence */
+#define TIMESYNC_MSG_RESP		2U		/* type, sequence, t2, t3 */
+#define TIMESYNC_REQ_LEN		3U
+#define TIMESYNC_RESP_LEN		19U
+#define TIMESYNC_RESP_T2_OFS	3U
+#define TIMESYNC_RESP_T3_OFS	11U
+#define TIMESYNC_FRAME_BYTES	FRAME_SLIP_MAX_ENCODED(TIMESYNC_RESP_LEN)
+#define TIMESYNC_RING_BYTES		64U
+#define TIMESYNC_SPIN_US		20U		/* Spent with interrupts masked before a send. */
+#define TIMESYNC_AF_TIM3		2U
+#define TIMESYNC_NO_DELAY		0xFFFFFFFFU
+
+#define TIM_CR1_CEN_OFS			0U
+#define TIM_EGR_UG_OFS			0U
+#define TIM_DIER_CC1IE_OFS		1U
+#define TIM_SR_CC1IF_OFS		1U
+#define TIM_CCMR_CCS_TI_DIRECT	1U		/* Per channel, shifted by 8 in its CCMR. */
+#define TIM_CCER_CCE			(1U << 0)	/* Per channel, shifted by 4. */
+#define TIM_CCER_CCP			(1U << 1)	/* Falling edge. */
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	GPIO_TypeDef *pxPort;
+	ClkGate_t ePortClock;
+	uint8_t ucPin;
+} TimeSyncPinDef_t;
+
+typedef struct
+{
+	TimeSyncLink_t xLink;
+	FrameRx_t xRx;
+	volatile uint64_t ullStart;		/* Local time of the frame start captured. */
+	volatile uint32_t ulStartValid;
+	uint64_t ullT1;					/* Slave: local time the request was sent. */
+	TickType_t xSentTick;
+	TickType_t xNextTick;			/* Slave: next request. */
+	uint16_t usSequence;
+	uint8_t ucWaiting;				/* Slave: a response is due. */
+	ClkGateUser_t xPinClock;
+	uint8_t ucRxFrame[TIMESYNC_RESP_LEN + FRAME_CRC_LEN];
+	uint8_t ucRxRing[TIMESYNC_RING_BYTES];
+	uint8_t ucTxRing[TIMESYNC_RING_BYTES];
+} TimeSyncPort_t;
+
+typedef struct
+{
+	uint64_t ullT0;					/* Local time the offset is given at. */
+	int64_t llOffset;				/* Synchronized - local at ullT0. */
+	int32_t lRatePpb;				/* Change of the offset per second of local time. */
+} TimeSyncModel_t;
+
+/* Variables -----------------------------------------------------------------*/
+static const TimeSyncPinDef_t xPins[TIMESYNC_CAPTURES] =
+{
+	[TIMESYNC_CAPTURE_PA6] = { GPIOA, CLKGATE_GPIOA, 6U },
+	[TIMESYNC_CAPTURE_PA7] = { GPIOA, CLKGATE_GPIOA, 7U },
+	[TIMESYNC_CAPTURE_PB0] = { GPIOB, CLKGATE_GPIOB, 0U },
+	[TIMESYNC_CAPTURE_PB1] = { GPIOB, CLKGATE_GPIOB, 1U },
+};
+
+static TimeSyncPort_t xPorts[TIMESYNC_MAX_LINKS];
+static TimeSyncPort_t *pxByCapture[TIMESYNC_CAPTURES];
+static uint32_t ulLinkCount = 0;
+static uint32_t ulTicksPerUs = 1;
+static ClkGateUser_t xTimerClock = CLKGATE_USER(CLKGATE_TIM3);
+
+static volatile uint32_t ulModelSequence = 0;
+static volatile TimeSyncModel_t xModel[2];
+
+/* Servo state, owned by the task. */
+static TimeSyncStats_t xStats;
+static int32_t lDriftPpb = 0;
+static uint64_t ullLastSample = 0;
+static uint32_t ulHaveSample = 0;
+static uint32_t ulLockCount = 0;
+static uint32_t ulDelays[TIMESYNC_DELAY_WINDOW];
+static uint32_t ulDelayNext = 0;
+
+/* Private function prototypes -----------------------------------------------*/
+static void timesync_task(void *pvParameters);
+static void timesync_poll(TimeSyncPort_t *pxPort);
+static void timesync_receive(TimeSyncPort_t *pxPort, const uint8_t *pucMsg, int32_t lLen);
+static void timesync_send(TimeSyncPort_t *pxPort, uint8_t *pucMsg, uint32_t ulLen, uint32_t ulStampOfs);
+static void timesync_servo(uint64_t ullT1, uint64_t ullT2, uint64_t ullT3, uint64_t ullT4);
+static void timesync_arm(TimeSyncPort_t *pxPort);
+static void timesync_read_model(TimeSyncModel_t *pxModel);
+static void timesync_publish(uint64_t ullT0, int64_t llOffset, int32_t lRatePpb);
+static int64_t timesync_model_offset(const TimeSyncModel_t *pxModel, uint64_t ullLocalUs);
+static int32_t timesync_clamp(int64_t llPpb);
+static void timesync_put64(uint8_t *pucBuf, uint64_t ullValue);
+static uint64_t timesync_get64(const uint8_t *pucBuf);
+static uint32_t timesync_timer_clock(void);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Opens the links and starts the task that synchronizes over them.
+ * @param pxLinks Links, each on its own port and capture input. Copied.
+ * @param ulLinks Number of links, up to TIMESYNC_MAX_LINKS.
+ * @param uxPriority Priority of the task. Above the busy tasks: it polls the
+ * links every tick and spins for up to TIMESYNC_TX_LEAD_US per frame sent.
+ * @retval pdPASS if successful, pdFAIL if a link is invalid, two links share
+ * a capture input, more than one is a slave, TIM3 is taken or a port or the
+ * task cannot be set up.
+ * @note Call once, from a task or before the scheduler starts. A node without
+ * a slave link is the reference: its synchronized time is its local time.
+ */
+BaseType_t timesync_start(const TimeSyncLink_t *pxLinks, uint32_t ulLinks, UBaseType_t uxPriority)
+{
+	const uint32_t ulClock = timesync_timer_clock();
+	const TimeSyncPinDef_t *pxPin;
+	TimeSyncPort_t *pxPort;
+	UartConfig_t xConfig;
+	volatile uint32_t *pulCcmr;
+	uint32_t ulSlaves = 0;
+	uint32_t ulChannel;
+	uint32_t ulShift2;
+	uint32_t ulShift4;
+	uint32_t i;
+
+	if ((pxLinks == NULL) || (ulLinks == 0U) || (ulLinks > TIMESYNC_MAX_LINKS)
+			|| (ulLinkCount != 0U) || ((ulClock % 1000000U) != 0U)
+			|| (clkgate_get_users(CLKGATE_TIM3) != 0U))
+	{
+		return pdFAIL;
+	}
+
+	for (i = 0; i < ulLinks; i++)
+	{
+		if ((pxLinks[i].xCapture >= TIMESYNC_CAPTURES) || (pxByCapture[pxLinks[i].xCapture] != NULL))
+		{
+			memset(pxByCapture, 0, sizeof(pxByCapture));
+			return pdFAIL;
+		}
+
+		pxByCapture[pxLinks[i].xCapture] = &xPorts[i];
+		ulSlaves += (pxLinks[i].xRole == TIMESYNC_SLAVE) ? 1U : 0U;
+	}
+
+	if ((ulSlaves > 1U) || (timestamp_init() != 0))
+	{
+		memset(pxByCapture, 0, sizeof(pxByCapture));
+		return pdFAIL;
+	}
+
+	for (i = 0; i < ulLinks; i++)
+	{
+		pxPort = &xPorts[i];
+		pxPort->xLink = pxLinks[i];
+
+		xConfig.ulBaudRate = pxLinks[i].ulBaudRate;
+		xConfig.pucTxBuf = pxPort->ucTxRing;
+		xConfig.usTxSize = TIMESYNC_RING_BYTES;
+		xConfig.pucRxBuf = pxPort->ucRxRing;
+		xConfig.usRxSize = TIMESYNC_RING_BYTES;
+
+		if ((uart_open(pxLinks[i].xPort, &xConfig) != 0)
+				|| (frame_rx_init(&pxPort->xRx, FRAME_SLIP, pxPort->ucRxFrame,
+						sizeof(pxPort->ucRxFrame)) != 0))
+		{
+			memset(pxByCapture, 0, sizeof(pxByCapture));
+			return pdFAIL;
+		}
+	}
+
+	/* Free-running over 16 bits at the timer clock: 11 ns per count and a
+	 * 728 us wrap at 180 MHz, far above the capture interrupt's latency. */
+	clkgate_acquire(&xTimerClock);
+	ulTicksPerUs = ulClock / 1000000U;
+	TIM3->CR1 = 0;
+	TIM3->CR2 = 0;
+	TIM3->SMCR = 0;
+	TIM3->DIER = 0;
+	TIM3->CCER = 0;
+	TIM3->PSC = 0;
+	TIM3->ARR = 0xFFFFU;
+	TIM3->EGR = (1U << TIM_EGR_UG_OFS);
+	TIM3->SR = 0;
+	TIM3->CR1 = (1U << TIM_CR1_CEN_OFS);
+
+	for (i = 0; i < ulLinks; i++)
+	{
+		pxPort = &xPorts[i];
+		pxPin = &xPins[pxLinks[i].xCapture];
+		ulChannel = (uint32_t)pxLinks[i].xCapture;
+
+		/* The pin only listens: the UART's own RX pin drives the line. */
+		clkgate_user_init(&pxPort->xPinClock, pxPin->ePortClock);
+		clkgate_acquire(&pxPort->xPinClock);
+		ulShift2 = 2U * pxPin->ucPin;
+		ulShift4 = 4U * (pxPin->ucPin & 7U);
+		pxPin->pxPort->AFR[pxPin->ucPin >> 3] = (pxPin->pxPort->AFR[pxPin->ucPin >> 3]
+				& ~(0xFU << ulShift4)) | (TIMESYNC_AF_TIM3 << ulShift4);
+		pxPin->pxPort->PUPDR &= ~(3U << ulShift2);
+		pxPin->pxPort->MODER = (pxPin->pxPort->MODER & ~(3U << ulShift2)) | (2U << ulShift2);
+
+		/* Unfiltered: a filter would delay the edge. */
+		pulCcmr = (ulChannel < 2U) ? &TIM3->CCMR1 : &TIM3->CCMR2;
+		*pulCcmr = (*pulCcmr & ~(0xFFU << (8U * (ulChannel & 1U))))
+				| (TIM_CCMR_CCS_TI_DIRECT << (8U * (ulChannel & 1U)));
+		TIM3->CCER |= (TIM_CCER_CCE | TIM_CCER_CCP) << (4U * ulChannel);
+
+		pxPort->ucWaiting = 0;
+		pxPort->usSequence = 0;
+		pxPort->xNextTick = 0;
+		timesync_arm(pxPort);
+	}
+
+	memset(&xStats, 0, sizeof(xStats));
+	memset(ulDelays, 0xFF, sizeof(ulDelays));
+	timesync_publish(0, 0, 0);
+	ulLinkCount = ulLinks;
+
+	NVIC_SetPriority(TIM3_IRQn, TIMESYNC_IRQ_PRIORITY);
+	NVIC_EnableIRQ(TIM3_IRQn);
+
+	return xTaskCreate(timesync_task,
+					   "TimeSync",
+					   TIMESYNC_STACK_WORDS,
+					   NULL,
+					   uxPriority,
+					   NULL);
+}
+
+/**
+ * @brief Returns the synchronized time.
+ * @param None
+ * @retval Microseconds on the clock of the reference node.
+ * @note Lock-free: callable from tasks and from ISRs of any priority. Moves
+ * back only when the clock is stepped (TIMESYNC_STEP_US).
+ */
+uint64_t timesync_now_us(void)
+{
+	return timesync_to_synced_us(timestamp_now_us());
+}
+
+/**
+ * @brief Converts a local timestamp_now_us() time to the synchronized time.
+ * @param ullLocalUs Local time, e.g. a capture or an event logged earlier.
+ * @retval Synchronized microseconds, by the current model.
+ */
+uint64_t timesync_to_synced_us(uint64_t ullLocalUs)
+{
+	TimeSyncModel_t xNow;
+
+	timesync_read_model(&xNow);
+
+	return ullLocalUs + (uint64_t)timesync_model_offset(&xNow, ullLocalUs);
+}
+
+/**
+ * @brief Copies the synchronization statistics.
+ * @param pxStats Receives the statistics.
+ * @retval 0 if successful, -1 otherwise.
+ */
+int32_t timesync_get_stats(TimeSyncStats_t *pxStats)
+{
+	if (pxStats == NULL)
+	{
+		return -1;
+	}
+
+	taskENTER_CRITICAL();
+	*pxStats = xStats;
+	taskEXIT_CRITICAL();
+
+	return 0;
+}
+
+/**
+ * @brief TIM3 IRQ handler: turns the frame-start captures into local time.
+ * @param None
+ * @retval None
+ */
+void TIM3_IRQHandler(void)
+{
+	const uint32_t ulStatus = TIM3->SR & TIM3->DIER;
+	const uint64_t ullNow = timestamp_now_us();
+	const uint16_t usCount = (uint16_t)TIM3->CNT;
+	TimeSyncPort_t *pxPort;
+	uint16_t usAge;
+	uint32_t ulChannel;
+
+	for (ulChannel = 0; ulChannel < TIMESYNC_CAPTURES; ulChannel++)
+	{
+		if ((ulStatus & (1U << (TIM_SR_CC1IF_OFS + ulChannel))) == 0U)
+		{
+			continue;
+		}
+
+		/* One capture per arming: the rest of the frame is not wanted. */
+		TIM3->DIER &= ~(1U << (TIM_DIER_CC1IE_OFS + ulChannel));
+		TIM3->SR = ~(1U << (TIM_SR_CC1IF_OFS + ulChannel));
+
+		usAge = (uint16_t)(usCount - (uint16_t)(&TIM3->CCR1)[ulChannel]);
+		pxPort = pxByCapture[ulChannel];
+
+		if (pxPort != NULL)
+		{
+			pxPort->ullStart = ullNow - ((usAge + (ulTicksPerUs / 2U)) / ulTicksPerUs);
+			pxPort->ulStartValid = 1;
+		}
+	}
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Polls the links every tick.
+ * @param pvParameters Not used.
+ * @retval None
+ */
+static void timesync_task(void *pvParameters)
+{
+	uint32_t i;
+
+	(void)pvParameters;
+
+	for (;;)
+	{
+		for (i = 0; i < ulLinkCount; i++)
+		{
+			timesync_poll(&xPorts[i]);
+		}
+
+		vTaskDelay(1);
+	}
+}
+
+/**
+ * @brief Takes the frames a link received, and sends its next request.
+ * @param pxPort Link.
+ * @retval None
+ */
+static void timesync_poll(TimeSyncPort_t *pxPort)
+{
+	const TickType_t xNow = xTaskGetTickCount();
+	uint8_t ucBytes[TIMESYNC_RING_BYTES];
+	uint8_t ucMsg[TIMESYNC_REQ_LEN];
+	int32_t lRead;
+	int32_t lLen;
+	int32_t i;
+
+	lRead = uart_read(pxPort->xLink.xPort, ucBytes, sizeof(ucBytes), 0);
+
+	for (i = 0; i < lRead; i++)
+	{
+		lLen = frame_rx_put(&pxPort->xRx, ucBytes[i]);
+
+		if (lLen >= 0)
+		{
+			timesync_receive(pxPort, pxPort->ucRxFrame, lLen);
+		}
+		else if (lLen == FRAME_RX_ERROR)
+		{
+			timesync_arm(pxPort);
+		}
+	}
+
+	if (pxPort->xLink.xRole != TIMESYNC_SLAVE)
+	{
+		return;
+	}
+
+	if (pxPort->ucWaiting && ((xNow - pxPort->xSentTick) >= pdMS_TO_TICKS(TIMESYNC_TIMEOUT_MS)))
+	{
+		pxPort->ucWaiting = 0;
+		xStats.ulTimeouts++;
+	}
+
+	if ((pxPort->ucWaiting == 0U) && ((TickType_t)(xNow - pxPort->xNextTick) < portMAX_DELAY / 2U))
+	{
+		pxPort->usSequence++;
+		ucMsg[0] = TIMESYNC_MSG_REQ;
+		ucMsg[1] = (uint8_t)pxPort->usSequence;
+		ucMsg[2] = (uint8_t)(pxPort->usSequence >> 8);
+
+		/* The answer's start bit must be the next edge captured. */
+		timesync_arm(pxPort);
+		timesync_send(pxPort, ucMsg, sizeof(ucMsg), 0);
+
+		pxPort->ucWaiting = 1;
+		pxPort->xSentTick = xNow;
+		pxPort->xNextTick = xNow + pdMS_TO_TICKS(TIMESYNC_PERIOD_MS);
+		xStats.ulExchanges++;
+	}
+}
+
+/**
+ * @brief Handles a frame: a master answers a request, a slave takes a
+ * response as a sample.
+ * @param pxPort Link.
+ * @param pucMsg Payload.
+ * @param lLen Payload length.
+ * @retval None
+ */
+static void timesync_receive(TimeSyncPort_t *pxPort, const uint8_t *pucMsg, int32_t lLen)
+{
+	uint8_t ucResp[TIMESYNC_RESP_LEN];
+	uint64_t ullStart;
+	uint32_t ulValid;
+
+	ulValid = pxPort->ulStartValid;
+	ullStart = pxPort->ullStart;
+	timesync_arm(pxPort);
+
+	if (ulValid == 0U)
+	{
+		return;
+	}
+
+	if ((pxPort->xLink.xRole == TIMESYNC_MASTER) && (lLen == (int32_t)TIMESYNC_REQ_LEN)
+			&& (pucMsg[0] == TIMESYNC_MSG_REQ))
+	{
+		ucResp[0] = TIMESYNC_MSG_RESP;
+		ucResp[1] = pucMsg[1];
+		ucResp[2] = pucMsg[2];
+		timesync_put64(&ucResp[TIMESYNC_RESP_T2_OFS], timesync_to_synced_us(ullStart));
+		timesync_send(pxPort, ucResp, sizeof(ucResp), TIMESYNC_RESP_T3_OFS);
+		xStats.ulResponses++;
+	}
+	else if ((pxPort->xLink.xRole == TIMESYNC_SLAVE) && (lLen == (int32_t)TIMESYNC_RESP_LEN)
+			&& (pucMsg[0] == TIMESYNC_MSG_RESP) && pxPort->ucWaiting
+			&& (pucMsg[1] == (uint8_t)pxPort->usSequence)
+			&& (pucMsg[2] == (uint8_t)(pxPort->usSequence >> 8))
+			&& (ullStart > pxPort->ullT1))	/* Not an edge from before the request. */
+	{
+		pxPort->ucWaiting = 0;
+		timesync_servo(pxPort->ullT1, timesync_get64(&pucMsg[TIMESYNC_RESP_T2_OFS]),
+				timesync_get64(&pucMsg[TIMESYNC_RESP_T3_OFS]), ullStart);
+	}
+}
+
+/**
+ * @brief Sends a frame at a time chosen in advance, stamped with that time.
+ * @param pxPort Link.
+ * @param pucMsg Payload.
+ * @param ulLen Payload length.
+ * @param ulStampOfs Where the synchronized send time goes in pucMsg, 0 for
+ * nowhere. The local send time is kept as t1 either way.
+ * @retval None
+ */
+static void timesync_send(TimeSyncPort_t *pxPort, uint8_t *pucMsg, uint32_t ulLen, uint32_t ulStampOfs)
+{
+	uint8_t ucFrame[TIMESYNC_FRAME_BYTES];
+	uint64_t ullAt;
+	int32_t lFrameLen;
+	uint32_t ulSent = 0;
+
+	/* The frame must go straight to the shift register, not queue. */
+	uart_flush(pxPort->xLink.xPort);
+
+	while (ulSent == 0U)
+	{
+		ullAt = timestamp_now_us() + TIMESYNC_TX_LEAD_US;
+
+		if (ulStampOfs != 0U)
+		{
+			timesync_put64(&pucMsg[ulStampOfs], timesync_to_synced_us(ullAt));
+		}
+
+		lFrameLen = frame_encode(FRAME_SLIP, pucMsg, ulLen, ucFrame, sizeof(ucFrame));
+
+		if (lFrameLen <= 0)
+		{
+			return;
+		}
+
+		while ((timestamp_now_us() + TIMESYNC_SPIN_US) < ullAt)
+		{
+		}
+
+		/* Preempted past the time: stamp the frame again. */
+		taskENTER_CRITICAL();
+		if (timestamp_now_us() <= ullAt)
+		{
+			while (timestamp_now_us() < ullAt)
+			{
+			}
+
+			(void)uart_write(pxPort->xLink.xPort, ucFrame, (uint32_t)lFrameLen, 0);
+			ulSent = 1;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	pxPort->ullT1 = ullAt;
+}
+
+/**
+ * @brief Takes one exchange: filters it on its delay and steers the clock.
+ * @param ullT1 Local time the request was sent.
+ * @param ullT2 Master time it was received.
+ * @param ullT3 Master time the response was sent.
+ * @param ullT4 Local time it was received.
+ * @retval None
+ */
+static void timesync_servo(uint64_t ullT1, uint64_t ullT2, uint64_t ullT3, uint64_t ullT4)
+{
+	const int64_t llOffset = (((int64_t)(ullT2 - ullT1)) + ((int64_t)(ullT3 - ullT4))) / 2;
+	const int64_t llDelay = (((int64_t)(ullT4 - ullT1)) - ((int64_t)(ullT3 - ullT2))) / 2;
+	const uint64_t ullMid = ullT1 + ((ullT4 - ullT1) / 2U);
+	TimeSyncModel_t xNow;
+	uint64_t ullNow;
+	uint32_t ulMinDelay = TIMESYNC_NO_DELAY;
+	int64_t llError;
+	int64_t llSpan;
+	uint32_t i;
+
+	xStats.lOffsetUs = (int32_t)llOffset;
+
+	if ((llDelay < 0) || (llDelay > (int64_t)(TIMESYNC_TIMEOUT_MS * 1000U)))
+	{
+		xStats.ulRejected++;
+		return;
+	}
+
+	xStats.ulDelayUs = (uint32_t)llDelay;
+	ulDelays[ulDelayNext] = (uint32_t)llDelay;
+	ulDelayNext = (ulDelayNext + 1U) % TIMESYNC_DELAY_WINDOW;
+
+	for (i = 0; i < TIMESYNC_DELAY_WINDOW; i++)
+	{
+		ulMinDelay = (ulDelays[i] < ulMinDelay) ? ulDelays[i] : ulMinDelay;
+	}
+
+	if ((uint32_t)llDelay > (ulMinDelay + TIMESYNC_DELAY_MARGIN_US))
+	{
+		xStats.ulRejected++;
+		return;
+	}
+
+	xStats.ulAccepted++;
+	timesync_read_model(&xNow);
+	llError = llOffset - timesync_model_offset(&xNow, ullMid);
+	ullNow = timestamp_now_us();
+
+	if ((ulHaveSample == 0U) || (llError > (int64_t)TIMESYNC_STEP_US)
+			|| (llError < -(int64_t)TIMESYNC_STEP_US))
+	{
+		timesync_publish(ullNow, llOffset, lDriftPpb);
+		xStats.ulSteps++;
+		ulHaveSample = 1;
+		ulLockCount = 0;
+	}
+	else
+	{
+		/* What is left of the last correction is the rate still wrong. */
+		llSpan = (int64_t)(ullMid - ullLastSample);
+
+		if (llSpan > 0)
+		{
+			lDriftPpb = timesync_clamp(lDriftPpb
+					+ ((llError * 1000000000LL) / llSpan / TIMESYNC_DRIFT_GAIN));
+		}
+
+		/* Continuous at the switch, and the error gone by the next sample. */
+		timesync_publish(ullNow, timesync_model_offset(&xNow, ullNow),
+				timesync_clamp(lDriftPpb + ((llError * 1000000LL) / (int64_t)TIMESYNC_PERIOD_MS)));
+
+		if ((llError <= (int64_t)TIMESYNC_LOCK_US) && (llError >= -(int64_t)TIMESYNC_LOCK_US))
+		{
+			ulLockCount++;
+		}
+		else
+		{
+			ulLockCount = 0;
+		}
+	}
+
+	ullLastSample = ullMid;
+	xStats.lDriftPpb = lDriftPpb;
+	xStats.ulLocked = (ulLockCount >= TIMESYNC_LOCK_SAMPLES) ? 1U : 0U;
+}
+
+/**
+ * @brief Arms a link's capture for the next frame start.
+ * @param pxPort Link, whose line should be idle.
+ * @retval None
+ */
+static void timesync_arm(TimeSyncPort_t *pxPort)
+{
+	const uint32_t ulChannel = (uint32_t)pxPort->xLink.xCapture;
+
+	taskENTER_CRITICAL();
+	pxPort->ulStartValid = 0;
+	TIM3->SR = ~(1U << (TIM_SR_CC1IF_OFS + ulChannel));
+	TIM3->DIER |= (1U << (TIM_DIER_CC1IE_OFS + ulChannel));
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Copies the current clock model.
+ * @param pxModel Receives the model.
+ * @retval None
+ */
+static void timesync_read_model(TimeSyncModel_t *pxModel)
+{
+	uint32_t ulSeq;
+
+	do
+	{
+		ulSeq = ulModelSequence;
+		__DMB();
+		pxModel->ullT0 = xModel[ulSeq & 1U].ullT0;
+		pxModel->llOffset = xModel[ulSeq & 1U].llOffset;
+		pxModel->lRatePpb = xModel[ulSeq & 1U].lRatePpb;
+		__DMB();
+	} while (ulSeq != ulModelSequence);
+}
+
+/**
+ * @brief Publishes a new clock model.
+ * @param ullT0 Local time the offset is given at.
+ * @param llOffset Synchronized - local time at ullT0.
+ * @param lRatePpb Change of the offset per second from then on.
+ * @retval None
+ * @note One writer: timesync_start(), then the task. Readers use copy 1 while
+ * copy 0 is written, then copy 0 while copy 1 is written.
+ */
+static void timesync_publish(uint64_t ullT0, int64_t llOffset, int32_t lRatePpb)
+{
+	ulModelSequence++;
+	__DMB();
+	xModel[0].ullT0 = ullT0;
+	xModel[0].llOffset = llOffset;
+	xModel[0].lRatePpb = lRatePpb;
+	__DMB();
+	ulModelSequence++;
+	__DMB();
+	xModel[1].ullT0 = ullT0;
+	xModel[1].llOffset = llOffset;
+	xModel[1].lRatePpb = lRatePpb;
+	__DMB();
+}
+
+/**
+ * @brief Evaluates a model's offset at a local time.
+ * @param pxModel Model.
+ * @param ullLocalUs Local time, before or after the model's start.
+ * @retval Synchronized - local microseconds.
+ */
+static int64_t timesync_model_offset(const TimeSyncModel_t *pxModel, uint64_t ullLocalUs)
+{
+	return pxModel->llOffset
+			+ (((int64_t)(ullLocalUs - pxModel->ullT0) * pxModel->lRatePpb) / 1000000000LL);
+}
+
+/**
+ * @brief Limits a rate to what the clock may be slewed by.
+ * @param llPpb Rate.
+ * @retval Rate within +/- TIMESYNC_MAX_SLEW_PPB.
+ */
+static int32_t timesync_clamp(int64_t llPpb)
+{
+	if (llPpb > TIMESYNC_MAX_SLEW_PPB)
+	{
+		return TIMESYNC_MAX_SLEW_PPB;
+	}
+
+	if (llPpb < -TIMESYNC_MAX_SLEW_PPB)
+	{
+		return -TIMESYNC_MAX_SLEW_PPB;
+	}
+
+	return (int32_t)llPpb;
+}
+
+/**
+ * @brief Stores a 64-bit value, LSB first.
+ * @param pucBuf Destination, 8 bytes.
+ * @param ullValue Value.
+ * @retval None
+ */
+static void timesync_put64(uint8_t *pucBuf, uint64_t ullValue)
+{
+	uint32_t i;
+
+	for (i = 0; i < 8U; i++)
+	{
+		pucBuf[i] = (uint8_t)(ullValue >> (8U * i));
+	}
+}
+
+/**
+ * @brief Loads a 64-bit value, LSB first.
+ * @param pucBuf Source, 8 bytes.
+ * @retval Value.
+ */
+static uint64_t timesync_get64(const uint8_t *pucBuf)
+{
+	uint64_t ullValue = 0;
+	uint32_t i;
+
+	for (i = 0; i < 8U; i++)
+	{
+		ullValue |= (uint64_t)pucBuf[i] << (8U * i);
+	}
+
+	return ullValue;
+}
+
+/**
+ * @brief Returns the TIM3 kernel clock.
+ * @param None
+ * @retval PCLK1, doubled when APB1 is divided.
+ */
+static uint32_t timesync_timer_clock(void)
+{
+	uint32_t ulClock = HAL_RCC_GetPCLK1Freq();
+
+	if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+	{
+		ulClock *= 2U;
+	}
+
+	return ulClock;
+}
@@ -0,0 +1,1084 @@
+/*******************************************************************************
+ *
+ * @file	usb_cdc.c
+ * @brief	Implementation of the USB CDC-ACM output channel.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	A virtual COM port on USB OTG FS (PA11 DM, PA12 DP, the user USB
+ * 			connector of the Nucleo), register level, without the HAL PCD
+ * 			module or the ST USB device library. Logs and telemetry leave at
+ * 			full speed, 12 Mbit/s on the wire and about 1 MB/s of bulk data,
+ * 			where the ST-LINK VCOM on USART2 tops out at 11.5 kB/s.
+ *
+ * 			usb_cdc_write() copies into a stream buffer and returns: it never
+ * 			blocks and may be called from an ISR. The OTG interrupt drains the
+ * 			stream buffer in bulk IN transfers of everything written so far,
+ * 			straight into the endpoint's FIFO, which holds USB_CDC_IN_PACKETS
+ * 			packets: the core sends one while the CPU writes the next. A
+ * 			transfer ending on a packet boundary is followed by a zero-length
+ * 			packet once nothing more is written, so the host's read returns.
+ *
+ * 			No host, or a suspended one: written bytes are dropped and
+ * 			counted, so a producer carries on unaware; and a host that does
+ * 			not read fills the buffer, after which the excess is dropped. The
+ * 			board is bus powered by the ST-LINK and VBUS is not sensed (PA9
+ * 			stays free): a cable pulled shows up as a suspend, a cable
+ * 			plugged in as a reset.
+ *
+ * 			Enumeration answers the standard requests and the ACM ones a
+ * 			terminal sends (line coding, DTR/RTS), which are accepted and
+ * 			ignored: the line is not a UART. Bytes from the host are
+ * 			discarded. The 48 MHz clock comes from PLLSAI (clock.c).
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "clkgate.h"
+#include "clock.h"
+#include "usb_cdc.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define USB_DEVICE				((USB_OTG_DeviceTypeDef *)(USB_OTG_FS_PERIPH_BASE + USB_OTG_DEVICE_BASE))
+#define USB_INEP(ep)			((USB_OTG_INEndpointTypeDef *)(USB_OTG_FS_PERIPH_BASE \
+		+ USB_OTG_IN_ENDPOINT_BASE + ((ep) * USB_OTG_EP_REG_SIZE)))
+#define USB_OUTEP(ep)			((USB_OTG_OUTEndpointTypeDef *)(USB_OTG_FS_PERIPH_BASE \
+		+ USB_OTG_OUT_ENDPOINT_BASE + ((ep) * USB_OTG_EP_REG_SIZE)))
+#define USB_FIFO(ep)			(*(volatile uint32_t *)(USB_OTG_FS_PERIPH_BASE + USB_OTG_FIFO_BASE \
+		+ ((ep) * USB_OTG_FIFO_SIZE)))
+#define USB_PCGCCTL				(*(volatile uint32_t *)(USB_OTG_FS_PERIPH_BASE + USB_OTG_PCGCCTL_BASE))
+
+#define USB_EP_DATA				1U		/* Bulk IN 0x81 and bulk OUT 0x01. */
+#define USB_EP_NOTIFY			2U		/* Interrupt IN 0x82, never sent on. */
+#define USB_MPS					64U		/* EP0 and bulk packets. */
+#define USB_NOTIFY_MPS			8U
+#define USB_EPTYP_BULK			2U
+#define USB_EPTYP_INTERRUPT		3U
+
+/* FIFO RAM in words (1.25 KB): the shared RX FIFO, then one TX FIFO per IN
+ * endpoint. */
+#define USB_RX_FIFO_WORDS		128U
+#define USB_EP0_FIFO_WORDS		(USB_MPS / 4U)
+#define USB_DATA_FIFO_WORDS		(USB_CDC_IN_PACKETS * (USB_MPS / 4U))
+#define USB_NOTIFY_FIFO_WORDS	16U
+
+#define USB_PKTSTS_OUT_DATA		2U
+#define USB_PKTSTS_SETUP_DATA	6U
+
+#define USB_TRDT_32MHZ			6U		/* USB turnaround time, HCLK of 32 MHz and above. */
+#define USB_MODE_DELAY_MS		50U		/* Forced device mode takes 25 ms. */
+#define USB_RESET_TIMEOUT		200000U	/* Busy-wait iterations for a core or FIFO reset. */
+
+#define USB_PA11_DM				11U
+#define USB_PA12_DP				12U
+#define USB_AF_OTG_FS			10U
+
+/* Standard and CDC requests. */
+#define USB_REQ_TYPE_MASK		0x60U
+#define USB_REQ_TYPE_STANDARD	0x00U
+#define USB_REQ_TYPE_CLASS		0x20U
+#define USB_REQ_GET_STATUS		0x00U
+#define USB_REQ_CLEAR_FEATURE	0x01U
+#define USB_REQ_SET_FEATURE		0x03U
+#define USB_REQ_SET_ADDRESS		0x05U
+#define USB_REQ_GET_DESCRIPTOR	0x06U
+#define USB_REQ_GET_CONFIG		0x08U
+#define USB_REQ_SET_CONFIG		0x09U
+#define USB_REQ_GET_INTERFACE	0x0AU
+#define USB_REQ_SET_INTERFACE	0x0BU
+#define CDC_SET_LINE_CODING		0x20U
+#define CDC_GET_LINE_CODING		0x21U
+#define CDC_SET_CONTROL_LINE	0x22U
+#define CDC_SEND_BREAK			0x23U
+
+#define USB_DESC_DEVICE			1U
+#define USB_DESC_CONFIG			2U
+#define USB_DESC_STRING			3U
+#define USB_STRING_CHARS		32U
+#define USB_UID_WORDS			3U
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint8_t bmRequestType;
+	uint8_t bRequest;
+	uint16_t wValue;
+	uint16_t wIndex;
+	uint16_t wLength;
+} UsbSetup_t;
+
+typedef struct
+{
+	uint8_t ucOpen;
+	volatile uint8_t ucConfigured;
+	volatile uint8_t ucSuspended;
+	volatile uint8_t ucInBusy;		/* A bulk IN transfer is running. */
+	uint8_t ucInZlp;				/* The last one ended on a packet boundary. */
+	uint8_t ucEp0Zlp;				/* The EP0 data stage needs a zero-length packet. */
+	uint8_t ucLineCodingOut;		/* SET_LINE_CODING data stage expected. */
+	uint32_t ulInLen;				/* Bytes of the bulk IN transfer. */
+	uint32_t ulInRemaining;			/* Not yet in its FIFO. */
+	const uint8_t *pucEp0;			/* EP0 data stage, not yet sent. */
+	uint32_t ulEp0Remaining;
+	uint32_t aulSetup[2];			/* Last SETUP packet. */
+	uint32_t aulEp0Buf[(2U + (2U * USB_STRING_CHARS)) / 4U + 1U];
+	uint8_t aucLineCoding[7];		/* dwDTERate, bCharFormat, bParityType, bDataBits. */
+	UsbCdcStats_t xStats;
+	StreamBufferHandle_t xTx;
+	StaticStreamBuffer_t xTxStatic;
+	ClkGateUser_t xUsbClock;
+	ClkGateUser_t xPinClock;
+} UsbCdcState_t;
+
+/* Variables -----------------------------------------------------------------*/
+static const uint8_t ucDeviceDesc[18] =
+{
+	18U, USB_DESC_DEVICE,
+	0x00U, 0x02U,					/* USB 2.0 */
+	0x02U, 0x00U, 0x00U,			/* Communications device class. */
+	USB_MPS,
+	(uint8_t)USB_CDC_VID, (uint8_t)(USB_CDC_VID >> 8),
+	(uint8_t)USB_CDC_PID, (uint8_t)(USB_CDC_PID >> 8),
+	0x00U, 0x01U,					/* bcdDevice 1.00 */
+	1U, 2U, 3U,						/* Manufacturer, product and serial strings. */
+	1U								/* One configuration. */
+};
+
+static const uint8_t ucConfigDesc[67] =
+{
+	9U, USB_DESC_CONFIG, 67U, 0U, 2U, 1U, 0U, 0x80U, 50U,	/* Bus powered, 100 mA. */
+
+	/* Interface 0: communications, abstract control model. */
+	9U, 4U, 0U, 0U, 1U, 0x02U, 0x02U, 0x01U, 0U,
+	5U, 0x24U, 0x00U, 0x10U, 0x01U,							/* Header, CDC 1.10. */
+	5U, 0x24U, 0x01U, 0x00U, 1U,								/* Call management. */
+	4U, 0x24U, 0x02U, 0x02U,									/* ACM: line coding, line state. */
+	5U, 0x24U, 0x06U, 0U, 1U,									/* Union: 0 controls 1. */
+	7U, 5U, 0x80U | USB_EP_NOTIFY, USB_EPTYP_INTERRUPT, USB_NOTIFY_MPS, 0U, 16U,
+
+	/* Interface 1: data. */
+	9U, 4U, 1U, 0U, 2U, 0x0AU, 0x00U, 0x00U, 0U,
+	7U, 5U, USB_EP_DATA, USB_EPTYP_BULK, USB_MPS, 0U, 0U,
+	7U, 5U, 0x80U | USB_EP_DATA, USB_EPTYP_BULK, USB_MPS, 0U, 0U
+};
+
+static const uint8_t ucLangIdDesc[4] = { 4U, USB_DESC_STRING, 0x09U, 0x04U };	/* en-US */
+
+static UsbCdcState_t xUsb =
+{
+	.aucLineCoding = { 0x00U, 0xC2U, 0x01U, 0x00U, 0U, 0U, 8U }	/* 115200 8N1 */
+};
+
+static uint8_t ucTxStorage[USB_CDC_TX_BUFFER_BYTES + 1U];
+
+/* Private function prototypes -----------------------------------------------*/
+static int32_t usb_core_init(void);
+static int32_t usb_wait_clear(volatile uint32_t *pulReg, uint32_t ulMask);
+static void usb_flush_fifos(void);
+static void usb_fifo_write(uint32_t ulEp, const void *pvData, uint32_t ulLen);
+static void usb_fifo_read(void *pvData, uint32_t ulLen, uint32_t ulMax);
+static void usb_bus_reset(void);
+static void usb_rx_pop(void);
+static void usb_setup(void);
+static void usb_get_descriptor(const UsbSetup_t *pxSetup);
+static const void *usb_string(uint8_t ucIndex);
+static void usb_configure(uint8_t ucConfig);
+static void usb_ep0_send(const void *pvData, uint32_t ulLen, uint16_t usRequested);
+static void usb_ep0_in_next(void);
+static void usb_ep0_out_arm(void);
+static void usb_ep0_stall(void);
+static void usb_data_out_arm(void);
+static void usb_in_kick(BaseType_t *pxHigherPriorityTaskWoken);
+static void usb_in_fill(BaseType_t *pxHigherPriorityTaskWoken);
+static uint32_t usb_online(void);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Starts the device: the host enumerates it once the cable is in.
+ * @param None
+ * @retval 0 if successful, -1 if already open, PLLSAI did not lock or the
+ * core did not come out of reset.
+ * @note Call from a task: forcing device mode takes 50 ms.
+ */
+int32_t usb_cdc_open(void)
+{
+	GPIO_TypeDef *pxPort = GPIOA;
+	uint32_t ulPin;
+
+	if (xUsb.ucOpen != 0U)
+	{
+		return -1;
+	}
+
+	xUsb.xTx = xStreamBufferCreateStatic(sizeof(ucTxStorage), 1U, ucTxStorage, &xUsb.xTxStatic);
+
+	if (clock_ck48_enable() != 0)
+	{
+		return -1;
+	}
+
+	clkgate_user_init(&xUsb.xPinClock, CLKGATE_GPIOA);
+	clkgate_user_init(&xUsb.xUsbClock, CLKGATE_OTGFS);
+	clkgate_acquire(&xUsb.xPinClock);
+	clkgate_acquire(&xUsb.xUsbClock);
+
+	/* DM and DP: alternate function, push-pull, very high speed, no pull. */
+	for (ulPin = USB_PA11_DM; ulPin <= USB_PA12_DP; ulPin++)
+	{
+		pxPort->AFR[1] = (pxPort->AFR[1] & ~(0xFU << (4U * (ulPin - 8U))))
+				| (USB_AF_OTG_FS << (4U * (ulPin - 8U)));
+		pxPort->OTYPER &= ~(1U << ulPin);
+		pxPort->OSPEEDR |= (3U << (2U * ulPin));
+		pxPort->PUPDR &= ~(3U << (2U * ulPin));
+		pxPort->MODER = (pxPort->MODER & ~(3U << (2U * ulPin))) | (2U << (2U * ulPin));
+	}
+
+	if (usb_core_init() != 0)
+	{
+		clkgate_release(&xUsb.xUsbClock);
+		clkgate_release(&xUsb.xPinClock);
+		return -1;
+	}
+
+	xUsb.ucOpen = 1;
+
+	NVIC_SetPriority(OTG_FS_IRQn, USB_CDC_IRQ_PRIORITY);
+	NVIC_EnableIRQ(OTG_FS_IRQn);
+
+	/* Pull DP up: the host sees the device. */
+	USB_DEVICE->DCTL &= ~USB_OTG_DCTL_SDIS;
+
+	return 0;
+}
+
+/**
+ * @brief Queues bytes for the host, without blocking.
+ * @param pvData Bytes to send.
+ * @param ulLen Number of bytes.
+ * @retval Bytes queued, ulLen unless the buffer is full. 0 with no host: the
+ * bytes are dropped.
+ * @note May be called from tasks and ISRs at or below
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY. The copy runs with interrupts masked,
+ * so keep writes to a line or a record at a time.
+ */
+uint32_t usb_cdc_write(const void *pvData, uint32_t ulLen)
+{
+	UBaseType_t uxSavedInterruptStatus;
+	uint32_t ulQueued = 0;
+
+	if ((xUsb.ucOpen == 0U) || (ulLen == 0U))
+	{
+		return 0;
+	}
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+	if (usb_online() != 0U)
+	{
+		/* The critical section makes concurrent writers one. */
+		ulQueued = (uint32_t)xStreamBufferSendFromISR(xUsb.xTx, pvData, ulLen, NULL);
+	}
+
+	xUsb.xStats.ulDropped += ulLen - ulQueued;
+
+	/* Idle: the interrupt starts the transfer. */
+	if ((ulQueued != 0U) && (xUsb.ucInBusy == 0U))
+	{
+		NVIC_SetPendingIRQ(OTG_FS_IRQn);
+	}
+
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	return ulQueued;
+}
+
+/**
+ * @brief Tells whether a host has configured the device and is awake.
+ * @param None
+ * @retval 1 if written bytes are sent, 0 if they are dropped.
+ */
+uint32_t usb_cdc_is_connected(void)
+{
+	return (xUsb.ucOpen != 0U) ? usb_online() : 0U;
+}
+
+/**
+ * @brief Reads the counters.
+ * @param pxStats Receives the counters.
+ * @retval None
+ */
+void usb_cdc_get_stats(UsbCdcStats_t *pxStats)
+{
+	UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	*pxStats = xUsb.xStats;
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+/**
+ * @brief USB OTG FS interrupt: bus events, control requests and bulk data.
+ * @param None
+ * @retval None
+ */
+void OTG_FS_IRQHandler(void)
+{
+	const uint32_t ulStatus = USB_OTG_FS->GINTSTS & USB_OTG_FS->GINTMSK;
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	uint32_t ulDaint;
+	uint32_t ulInt;
+	uint32_t ulEp;
+
+	if ((ulStatus & USB_OTG_GINTSTS_USBRST) != 0U)
+	{
+		USB_OTG_FS->GINTSTS = USB_OTG_GINTSTS_USBRST;
+		usb_bus_reset();
+	}
+
+	if ((ulStatus & USB_OTG_GINTSTS_ENUMDNE) != 0U)
+	{
+		USB_OTG_FS->GINTSTS = USB_OTG_GINTSTS_ENUMDNE;
+		/* Full speed: EP0 packets of 64 bytes (MPSIZ 0). */
+		USB_INEP(0U)->DIEPCTL &= ~USB_OTG_DIEPCTL_MPSIZ;
+		USB_DEVICE->DCTL |= USB_OTG_DCTL_CGINAK;
+	}
+
+	while ((USB_OTG_FS->GINTSTS & USB_OTG_GINTSTS_RXFLVL) != 0U)
+	{
+		usb_rx_pop();
+	}
+
+	if ((ulStatus & USB_OTG_GINTSTS_OEPINT) != 0U)
+	{
+		ulDaint = (USB_DEVICE->DAINT & USB_DEVICE->DAINTMSK) >> 16;
+
+		for (ulEp = 0; ulDaint != 0U; ulEp++, ulDaint >>= 1)
+		{
+			if ((ulDaint & 1U) == 0U)
+			{
+				continue;
+			}
+
+			ulInt = USB_OUTEP(ulEp)->DOEPINT;
+			USB_OUTEP(ulEp)->DOEPINT = ulInt;
+
+			if (ulEp == USB_EP_DATA)
+			{
+				usb_data_out_arm();
+			}
+			else
+			{
+				if (((ulInt & USB_OTG_DOEPINT_XFRC) != 0U) && (xUsb.ucLineCodingOut != 0U))
+				{
+					/* Data stage in: the status stage follows. */
+					xUsb.ucLineCodingOut = 0;
+					memcpy(xUsb.aucLineCoding, xUsb.aulEp0Buf, sizeof(xUsb.aucLineCoding));
+					usb_ep0_send(NULL, 0U, 0U);
+				}
+
+				if ((ulInt & USB_OTG_DOEPINT_STUP) != 0U)
+				{
+					usb_setup();
+				}
+			}
+		}
+	}
+
+	if ((ulStatus & USB_OTG_GINTSTS_IEPINT) != 0U)
+	{
+		ulDaint = USB_DEVICE->DAINT & USB_DEVICE->DAINTMSK & 0xFFFFU;
+
+		for (ulEp = 0; ulDaint != 0U; ulEp++, ulDaint >>= 1)
+		{
+			if ((ulDaint & 1U) == 0U)
+			{
+				continue;
+			}
+
+			ulInt = USB_INEP(ulEp)->DIEPINT;
+			USB_INEP(ulEp)->DIEPINT = ulInt & ~USB_OTG_DIEPINT_TXFE;
+
+			if (ulEp == 0U)
+			{
+				if ((ulInt & USB_OTG_DIEPINT_XFRC) != 0U)
+				{
+					if ((xUsb.ulEp0Remaining != 0U) || (xUsb.ucEp0Zlp != 0U))
+					{
+						xUsb.ucEp0Zlp = (xUsb.ulEp0Remaining != 0U) ? xUsb.ucEp0Zlp : 0U;
+						usb_ep0_in_next();
+					}
+					else
+					{
+						/* Data or status stage done: the host's status, or
+						 * its next request's data. */
+						usb_ep0_out_arm();
+					}
+				}
+			}
+			else if (ulEp == USB_EP_DATA)
+			{
+				if (((ulInt & USB_OTG_DIEPINT_TXFE) != 0U)
+						&& ((USB_DEVICE->DIEPEMPMSK & (1U << USB_EP_DATA)) != 0U))
+				{
+					usb_in_fill(&xHigherPriorityTaskWoken);
+				}
+
+				if ((ulInt & USB_OTG_DIEPINT_XFRC) != 0U)
+				{
+					xUsb.xStats.ulBytes += xUsb.ulInLen;
+					xUsb.xStats.ulTransfers++;
+					xUsb.ucInBusy = 0;
+				}
+			}
+		}
+	}
+
+	if ((ulStatus & USB_OTG_GINTSTS_USBSUSP) != 0U)
+	{
+		USB_OTG_FS->GINTSTS = USB_OTG_GINTSTS_USBSUSP;
+
+		if (xUsb.ucConfigured != 0U)
+		{
+			xUsb.ucSuspended = 1;
+			xUsb.xStats.ulSuspends++;
+		}
+	}
+
+	if ((ulStatus & USB_OTG_GINTSTS_WKUINT) != 0U)
+	{
+		USB_OTG_FS->GINTSTS = USB_OTG_GINTSTS_WKUINT;
+		xUsb.ucSuspended = 0;
+	}
+
+	usb_in_kick(&xHigherPriorityTaskWoken);
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Resets the core and sets it up as a full-speed device, disconnected.
+ * @param None
+ * @retval 0 if successful, -1 if the core did not come out of reset.
+ */
+static int32_t usb_core_init(void)
+{
+	USB_OTG_GlobalTypeDef *pxOtg = USB_OTG_FS;
+	uint32_t ulTimeout = USB_RESET_TIMEOUT;
+
+	while ((pxOtg->GRSTCTL & USB_OTG_GRSTCTL_AHBIDL) == 0U)
+	{
+		if (--ulTimeout == 0U)
+		{
+			return -1;
+		}
+	}
+
+	pxOtg->GRSTCTL |= USB_OTG_GRSTCTL_CSRST;
+
+	if (usb_wait_clear(&pxOtg->GRSTCTL, USB_OTG_GRSTCTL_CSRST) != 0)
+	{
+		return -1;
+	}
+
+	/* Embedded PHY on, VBUS not sensed: the B session is always valid. */
+	pxOtg->GCCFG = USB_OTG_GCCFG_PWRDWN;
+	pxOtg->GOTGCTL |= USB_OTG_GOTGCTL_BVALOEN | USB_OTG_GOTGCTL_BVALOVAL;
+
+	pxOtg->GUSBCFG = (pxOtg->GUSBCFG & ~(USB_OTG_GUSBCFG_FHMOD | USB_OTG_GUSBCFG_TRDT))
+			| USB_OTG_GUSBCFG_FDMOD | USB_OTG_GUSBCFG_PHYSEL
+			| (USB_TRDT_32MHZ << USB_OTG_GUSBCFG_TRDT_Pos);
+	vTaskDelay(pdMS_TO_TICKS(USB_MODE_DELAY_MS));
+
+	USB_PCGCCTL = 0;
+	USB_DEVICE->DCTL |= USB_OTG_DCTL_SDIS;
+	USB_DEVICE->DCFG |= USB_OTG_DCFG_DSPD;		/* Full speed, embedded PHY. */
+
+	pxOtg->GRXFSIZ = USB_RX_FIFO_WORDS;
+	pxOtg->DIEPTXF0_HNPTXFSIZ = (USB_EP0_FIFO_WORDS << 16) | USB_RX_FIFO_WORDS;
+	pxOtg->DIEPTXF[USB_EP_DATA - 1U] = (USB_DATA_FIFO_WORDS << 16)
+			| (USB_RX_FIFO_WORDS + USB_EP0_FIFO_WORDS);
+	pxOtg->DIEPTXF[USB_EP_NOTIFY - 1U] = (USB_NOTIFY_FIFO_WORDS << 16)
+			| (USB_RX_FIFO_WORDS + USB_EP0_FIFO_WORDS + USB_DATA_FIFO_WORDS);
+	usb_flush_fifos();
+
+	USB_DEVICE->DIEPMSK = 0;
+	USB_DEVICE->DOEPMSK = 0;
+	USB_DEVICE->DAINTMSK = 0;
+	USB_DEVICE->DIEPEMPMSK = 0;
+
+	pxOtg->GINTSTS = 0xBFFFFFFFU;
+	pxOtg->GINTMSK = USB_OTG_GINTMSK_USBRST | USB_OTG_GINTMSK_ENUMDNEM | USB_OTG_GINTMSK_RXFLVLM
+			| USB_OTG_GINTMSK_IEPINT | USB_OTG_GINTMSK_OEPINT | USB_OTG_GINTMSK_USBSUSPM
+			| USB_OTG_GINTMSK_WUIM;
+	pxOtg->GAHBCFG |= USB_OTG_GAHBCFG_GINT;
+
+	return 0;
+}
+
+/**
+ * @brief Busy-waits for bits of a core register to clear.
+ * @param pulReg Register.
+ * @param ulMask Bits.
+ * @retval 0 if they cleared, -1 on timeout.
+ */
+static int32_t usb_wait_clear(volatile uint32_t *pulReg, uint32_t ulMask)
+{
+	uint32_t ulTimeout = USB_RESET_TIMEOUT;
+
+	while ((*pulReg & ulMask) != 0U)
+	{
+		if (--ulTimeout == 0U)
+		{
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Flushes every TX FIFO and the RX FIFO.
+ * @param None
+ * @retval None
+ */
+static void usb_flush_fifos(void)
+{
+	USB_OTG_FS->GRSTCTL = USB_OTG_GRSTCTL_TXFFLSH | (0x10U << USB_OTG_GRSTCTL_TXFNUM_Pos);
+	(void)usb_wait_clear(&USB_OTG_FS->GRSTCTL, USB_OTG_GRSTCTL_TXFFLSH);
+	USB_OTG_FS->GRSTCTL = USB_OTG_GRSTCTL_RXFFLSH;
+	(void)usb_wait_clear(&USB_OTG_FS->GRSTCTL, USB_OTG_GRSTCTL_RXFFLSH);
+}
+
+/**
+ * @brief Writes a packet into an IN endpoint's FIFO.
+ * @param ulEp Endpoint, with room for the packet.
+ * @param pvData Packet, word aligned.
+ * @param ulLen Bytes.
+ * @retval None
+ */
+static void usb_fifo_write(uint32_t ulEp, const void *pvData, uint32_t ulLen)
+{
+	const uint32_t *pulData = (const uint32_t *)pvData;
+	uint32_t x;
+
+	for (x = 0; x < ((ulLen + 3U) / 4U); x++)
+	{
+		USB_FIFO(ulEp) = pulData[x];
+	}
+}
+
+/**
+ * @brief Pops a packet from the RX FIFO.
+ * @param pvData Receives up to ulMax bytes, word aligned; NULL to discard.
+ * @param ulLen Bytes of the packet: all are popped.
+ * @param ulMax Room in pvData.
+ * @retval None
+ */
+static void usb_fifo_read(void *pvData, uint32_t ulLen, uint32_t ulMax)
+{
+	uint32_t *pulData = (uint32_t *)pvData;
+	uint32_t ulWord;
+	uint32_t x;
+
+	for (x = 0; x < ((ulLen + 3U) / 4U); x++)
+	{
+		ulWord = USB_FIFO(0U);
+
+		if ((pulData != NULL) && (((x + 1U) * 4U) <= ulMax))
+		{
+			pulData[x] = ulWord;
+		}
+	}
+}
+
+/**
+ * @brief Bus reset: back to the default address with only EP0.
+ * @param None
+ * @retval None
+ * @note A transfer cut short loses the packets already in the FIFO; the
+ * bytes still in the stream buffer go to the next host.
+ */
+static void usb_bus_reset(void)
+{
+	uint32_t ulEp;
+
+	USB_DEVICE->DCTL &= ~USB_OTG_DCTL_RWUSIG;
+	usb_flush_fifos();
+
+	for (ulEp = 0; ulEp <= USB_EP_NOTIFY; ulEp++)
+	{
+		USB_INEP(ulEp)->DIEPINT = 0xFFFFU;
+		USB_OUTEP(ulEp)->DOEPINT = 0xFFFFU;
+
+		if (ulEp != 0U)
+		{
+			USB_INEP(ulEp)->DIEPCTL = USB_OTG_DIEPCTL_SNAK;
+			USB_OUTEP(ulEp)->DOEPCTL = USB_OTG_DOEPCTL_SNAK;
+		}
+	}
+
+	USB_DEVICE->DAINTMSK = 1U | (1U << 16);
+	USB_DEVICE->DIEPMSK = USB_OTG_DIEPMSK_XFRCM;
+	USB_DEVICE->DOEPMSK = USB_OTG_DOEPMSK_STUPM | USB_OTG_DOEPMSK_XFRCM;
+	USB_DEVICE->DIEPEMPMSK = 0;
+	USB_DEVICE->DCFG &= ~USB_OTG_DCFG_DAD;
+
+	xUsb.ucConfigured = 0;
+	xUsb.ucSuspended = 0;
+	xUsb.ucInBusy = 0;
+	xUsb.ucInZlp = 0;
+	xUsb.ucEp0Zlp = 0;
+	xUsb.ucLineCodingOut = 0;
+	xUsb.ulEp0Remaining = 0;
+	xUsb.xStats.ulResets++;
+
+	usb_ep0_out_arm();
+}
+
+/**
+ * @brief Pops one entry of the RX FIFO: a SETUP packet or OUT data.
+ * @param None
+ * @retval None
+ */
+static void usb_rx_pop(void)
+{
+	const uint32_t ulStatus = USB_OTG_FS->GRXSTSP;
+	const uint32_t ulEp = ulStatus & USB_OTG_GRXSTSP_EPNUM;
+	const uint32_t ulLen = (ulStatus & USB_OTG_GRXSTSP_BCNT) >> USB_OTG_GRXSTSP_BCNT_Pos;
+	const uint32_t ulPktSts = (ulStatus & USB_OTG_GRXSTSP_PKTSTS) >> USB_OTG_GRXSTSP_PKTSTS_Pos;
+
+	if (ulPktSts == USB_PKTSTS_SETUP_DATA)
+	{
+		usb_fifo_read(xUsb.aulSetup, ulLen, sizeof(xUsb.aulSetup));
+	}
+	else if (ulPktSts == USB_PKTSTS_OUT_DATA)
+	{
+		if (ulEp == 0U)
+		{
+			usb_fifo_read(xUsb.aulEp0Buf, ulLen, sizeof(xUsb.aulEp0Buf));
+		}
+		else
+		{
+			usb_fifo_read(NULL, ulLen, 0U);
+			xUsb.xStats.ulRxDiscarded += ulLen;
+		}
+	}
+}
+
+/**
+ * @brief Answers the SETUP packet just received on EP0.
+ * @param None
+ * @retval None
+ */
+static void usb_setup(void)
+{
+	UsbSetup_t xSetup;
+	uint8_t *pucBuf = (uint8_t *)xUsb.aulEp0Buf;
+
+	memcpy(&xSetup, xUsb.aulSetup, sizeof(xSetup));
+
+	xUsb.ulEp0Remaining = 0;
+	xUsb.ucEp0Zlp = 0;
+	xUsb.ucLineCodingOut = 0;
+
+	if ((xSetup.bmRequestType & USB_REQ_TYPE_MASK) == USB_REQ_TYPE_STANDARD)
+	{
+		switch (xSetup.bRequest)
+		{
+		case USB_REQ_GET_STATUS:
+			pucBuf[0] = 0;
+			pucBuf[1] = 0;
+			usb_ep0_send(pucBuf, 2U, xSetup.wLength);
+			break;
+
+		case USB_REQ_CLEAR_FEATURE:
+		case USB_REQ_SET_FEATURE:
+		case USB_REQ_SET_INTERFACE:
+			usb_ep0_send(NULL, 0U, 0U);
+			break;
+
+		case USB_REQ_SET_ADDRESS:
+			/* Taken at once: the core answers the status stage at address 0. */
+			USB_DEVICE->DCFG = (USB_DEVICE->DCFG & ~USB_OTG_DCFG_DAD)
+					| (((uint32_t)xSetup.wValue & 0x7FU) << USB_OTG_DCFG_DAD_Pos);
+			usb_ep0_send(NULL, 0U, 0U);
+			break;
+
+		case USB_REQ_GET_DESCRIPTOR:
+			usb_get_descriptor(&xSetup);
+			break;
+
+		case USB_REQ_GET_CONFIG:
+			pucBuf[0] = xUsb.ucConfigured;
+			usb_ep0_send(pucBuf, 1U, xSetup.wLength);
+			break;
+
+		case USB_REQ_SET_CONFIG:
+			if ((xSetup.wValue & 0xFFU) > 1U)
+			{
+				usb_ep0_stall();
+				break;
+			}
+
+			usb_configure((uint8_t)xSetup.wValue);
+			usb_ep0_send(NULL, 0U, 0U);
+			break;
+
+		case USB_REQ_GET_INTERFACE:
+			pucBuf[0] = 0;
+			usb_ep0_send(pucBuf, 1U, xSetup.wLength);
+			break;
+
+		default:
+			usb_ep0_stall();
+			break;
+		}
+	}
+	else if ((xSetup.bmRequestType & USB_REQ_TYPE_MASK) == USB_REQ_TYPE_CLASS)
+	{
+		switch (xSetup.bRequest)
+		{
+		case CDC_SET_LINE_CODING:
+			xUsb.ucLineCodingOut = 1;
+			usb_ep0_out_arm();
+			break;
+
+		case CDC_GET_LINE_CODING:
+			usb_ep0_send(xUsb.aucLineCoding, sizeof(xUsb.aucLineCoding), xSetup.wLength);
+			break;
+
+		case CDC_SET_CONTROL_LINE:
+		case CDC_SEND_BREAK:
+			usb_ep0_send(NULL, 0U, 0U);
+			break;
+
+		default:
+			usb_ep0_stall();
+			break;
+		}
+	}
+	else
+	{
+		usb_ep0_stall();
+	}
+}
+
+/**
+ * @brief Answers GET_DESCRIPTOR.
+ * @param pxSetup The request.
+ * @retval None
+ * @note A full-speed-only device stalls the device qualifier request.
+ */
+static void usb_get_descriptor(const UsbSetup_t *pxSetup)
+{
+	const uint8_t *pucDesc = NULL;
+
+	switch (pxSetup->wValue >> 8)
+	{
+	case USB_DESC_DEVICE:
+		pucDesc = ucDeviceDesc;
+		usb_ep0_send(pucDesc, sizeof(ucDeviceDesc), pxSetup->wLength);
+		return;
+
+	case USB_DESC_CONFIG:
+		pucDesc = ucConfigDesc;
+		usb_ep0_send(pucDesc, sizeof(ucConfigDesc), pxSetup->wLength);
+		return;
+
+	case USB_DESC_STRING:
+		pucDesc = (const uint8_t *)usb_string((uint8_t)pxSetup->wValue);
+		break;
+
+	default:
+		break;
+	}
+
+	if (pucDesc == NULL)
+	{
+		usb_ep0_stall();
+		return;
+	}
+
+	usb_ep0_send(pucDesc, pucDesc[0], pxSetup->wLength);
+}
+
+/**
+ * @brief Builds a string descriptor.
+ * @param ucIndex 0 (languages), 1 (manufacturer), 2 (product) or 3 (serial).
+ * @retval The descriptor, NULL for an unknown index.
+ * @note The serial number is the chip's 96-bit unique ID in hex, so two boards
+ * keep their COM port names.
+ */
+static const void *usb_string(uint8_t ucIndex)
+{
+	static const char cHex[] = "0123456789ABCDEF";
+	uint8_t *pucBuf = (uint8_t *)xUsb.aulEp0Buf;
+	const char *pcText = NULL;
+	uint32_t ulChars = 0;
+	uint32_t ulUid;
+	uint32_t x;
+
+	switch (ucIndex)
+	{
+	case 0U:
+		return ucLangIdDesc;
+
+	case 1U:
+		pcText = "STMicroelectronics";
+		break;
+
+	case 2U:
+		pcText = USB_CDC_PRODUCT;
+		break;
+
+	case 3U:
+		for (x = 0; x < (USB_UID_WORDS * 8U); x++)
+		{
+			ulUid = ((const volatile uint32_t *)UID_BASE)[x / 8U];
+			pucBuf[2U + (2U * x)] = (uint8_t)cHex[(ulUid >> (28U - (4U * (x % 8U)))) & 0xFU];
+			pucBuf[3U + (2U * x)] = 0;
+		}
+
+		ulChars = USB_UID_WORDS * 8U;
+		break;
+
+	default:
+		return NULL;
+	}
+
+	for (x = 0; (pcText != NULL) && (pcText[x] != '\0') && (x < USB_STRING_CHARS); x++)
+	{
+		pucBuf[2U + (2U * x)] = (uint8_t)pcText[x];
+		pucBuf[3U + (2U * x)] = 0;
+		ulChars = x + 1U;
+	}
+
+	pucBuf[0] = (uint8_t)(2U + (2U * ulChars));
+	pucBuf[1] = USB_DESC_STRING;
+
+	return pucBuf;
+}
+
+/**
+ * @brief Applies SET_CONFIGURATION.
+ * @param ucConfig 1 to activate the CDC endpoints, 0 to deactivate them.
+ * @retval None
+ */
+static void usb_configure(uint8_t ucConfig)
+{
+	USB_OTG_FS->GRSTCTL = USB_OTG_GRSTCTL_TXFFLSH | (USB_EP_DATA << USB_OTG_GRSTCTL_TXFNUM_Pos);
+	(void)usb_wait_clear(&USB_OTG_FS->GRSTCTL, USB_OTG_GRSTCTL_TXFFLSH);
+
+	xUsb.ucInBusy = 0;
+	xUsb.ucInZlp = 0;
+	USB_DEVICE->DIEPEMPMSK = 0;
+
+	if (ucConfig == 0U)
+	{
+		xUsb.ucConfigured = 0;
+		USB_INEP(USB_EP_DATA)->DIEPCTL = USB_OTG_DIEPCTL_SNAK;
+		USB_INEP(USB_EP_NOTIFY)->DIEPCTL = USB_OTG_DIEPCTL_SNAK;
+		USB_OUTEP(USB_EP_DATA)->DOEPCTL = USB_OTG_DOEPCTL_SNAK;
+		USB_DEVICE->DAINTMSK = 1U | (1U << 16);
+		return;
+	}
+
+	USB_INEP(USB_EP_DATA)->DIEPCTL = (USB_MPS << USB_OTG_DIEPCTL_MPSIZ_Pos)
+			| (USB_EPTYP_BULK << USB_OTG_DIEPCTL_EPTYP_Pos)
+			| (USB_EP_DATA << USB_OTG_DIEPCTL_TXFNUM_Pos)
+			| USB_OTG_DIEPCTL_SD0PID_SEVNFRM | USB_OTG_DIEPCTL_USBAEP | USB_OTG_DIEPCTL_SNAK;
+	USB_INEP(USB_EP_NOTIFY)->DIEPCTL = (USB_NOTIFY_MPS << USB_OTG_DIEPCTL_MPSIZ_Pos)
+			| (USB_EPTYP_INTERRUPT << USB_OTG_DIEPCTL_EPTYP_Pos)
+			| (USB_EP_NOTIFY << USB_OTG_DIEPCTL_TXFNUM_Pos)
+			| USB_OTG_DIEPCTL_SD0PID_SEVNFRM | USB_OTG_DIEPCTL_USBAEP | USB_OTG_DIEPCTL_SNAK;
+	USB_OUTEP(USB_EP_DATA)->DOEPCTL = (USB_MPS << USB_OTG_DOEPCTL_MPSIZ_Pos)
+			| (USB_EPTYP_BULK << USB_OTG_DOEPCTL_EPTYP_Pos)
+			| USB_OTG_DOEPCTL_SD0PID_SEVNFRM | USB_OTG_DOEPCTL_USBAEP;
+
+	USB_DEVICE->DAINTMSK = 1U | (1U << USB_EP_DATA) | (1U << 16) | (1U << (16U + USB_EP_DATA));
+
+	usb_data_out_arm();
+	xUsb.ucConfigured = 1;
+}
+
+/**
+ * @brief Starts the data stage of a control IN request.
+ * @param pvData Data, word aligned; NULL for a status stage.
+ * @param ulLen Bytes.
+ * @param usRequested wLength of the request: the data is cut to it.
+ * @retval None
+ */
+static void usb_ep0_send(const void *pvData, uint32_t ulLen, uint16_t usRequested)
+{
+	if ((pvData != NULL) && (ulLen > usRequested))
+	{
+		ulLen = usRequested;
+	}
+
+	xUsb.pucEp0 = (const uint8_t *)pvData;
+	xUsb.ulEp0Remaining = ulLen;
+
+	/* Shorter than asked and a whole number of packets: a zero-length
+	 * packet tells the host there is no more. */
+	xUsb.ucEp0Zlp = ((ulLen != 0U) && (ulLen < usRequested) && ((ulLen % USB_MPS) == 0U)) ? 1U : 0U;
+
+	usb_ep0_in_next();
+}
+
+/**
+ * @brief Sends the next EP0 IN packet, up to 64 bytes.
+ * @param None
+ * @retval None
+ * @note The EP0 FIFO holds one packet and is empty here: the previous one has
+ * completed.
+ */
+static void usb_ep0_in_next(void)
+{
+	const uint32_t ulLen = (xUsb.ulEp0Remaining < USB_MPS) ? xUsb.ulEp0Remaining : USB_MPS;
+	uint32_t aulPacket[USB_MPS / 4U];
+
+	USB_INEP(0U)->DIEPTSIZ = (1U << USB_OTG_DIEPTSIZ_PKTCNT_Pos) | ulLen;
+	USB_INEP(0U)->DIEPCTL |= USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK;
+
+	if (ulLen != 0U)
+	{
+		/* The descriptors are byte arrays. */
+		memcpy(aulPacket, xUsb.pucEp0, ulLen);
+		usb_fifo_write(0U, aulPacket, ulLen);
+		xUsb.pucEp0 += ulLen;
+		xUsb.ulEp0Remaining -= ulLen;
+	}
+}
+
+/**
+ * @brief Lets EP0 receive one OUT packet: a status stage or request data.
+ * @param None
+ * @retval None
+ */
+static void usb_ep0_out_arm(void)
+{
+	USB_OUTEP(0U)->DOEPTSIZ = (3U << USB_OTG_DOEPTSIZ_STUPCNT_Pos)
+			| (1U << USB_OTG_DOEPTSIZ_PKTCNT_Pos) | USB_MPS;
+	USB_OUTEP(0U)->DOEPCTL |= USB_OTG_DOEPCTL_EPENA | USB_OTG_DOEPCTL_CNAK;
+}
+
+/**
+ * @brief Refuses a request. The core clears the stall at the next SETUP.
+ * @param None
+ * @retval None
+ */
+static void usb_ep0_stall(void)
+{
+	USB_INEP(0U)->DIEPCTL |= USB_OTG_DIEPCTL_STALL;
+	USB_OUTEP(0U)->DOEPCTL |= USB_OTG_DOEPCTL_STALL;
+	usb_ep0_out_arm();
+}
+
+/**
+ * @brief Lets the bulk OUT endpoint take one more packet, to be discarded.
+ * @param None
+ * @retval None
+ */
+static void usb_data_out_arm(void)
+{
+	USB_OUTEP(USB_EP_DATA)->DOEPTSIZ = (1U << USB_OTG_DOEPTSIZ_PKTCNT_Pos) | USB_MPS;
+	USB_OUTEP(USB_EP_DATA)->DOEPCTL |= USB_OTG_DOEPCTL_EPENA | USB_OTG_DOEPCTL_CNAK;
+}
+
+/**
+ * @brief Starts a bulk IN transfer of everything written, if idle.
+ * @param pxHigherPriorityTaskWoken Set if a task woken must run on exit.
+ * @retval None
+ * @note The transfer length is fixed here and its packets are taken from the
+ * stream buffer as the FIFO empties: the interrupt is its only reader.
+ */
+static void usb_in_kick(BaseType_t *pxHigherPriorityTaskWoken)
+{
+	USB_OTG_INEndpointTypeDef *pxEp = USB_INEP(USB_EP_DATA);
+	uint32_t ulLen;
+
+	if ((usb_online() == 0U) || (xUsb.ucInBusy != 0U))
+	{
+		return;
+	}
+
+	ulLen = (uint32_t)xStreamBufferBytesAvailable(xUsb.xTx);
+
+	if (ulLen == 0U)
+	{
+		if (xUsb.ucInZlp != 0U)
+		{
+			xUsb.ucInZlp = 0;
+			xUsb.ulInLen = 0;
+			xUsb.ucInBusy = 1;
+			pxEp->DIEPTSIZ = 1U << USB_OTG_DIEPTSIZ_PKTCNT_Pos;
+			pxEp->DIEPCTL |= USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK;
+		}
+
+		return;
+	}
+
+	xUsb.ulInLen = ulLen;
+	xUsb.ulInRemaining = ulLen;
+	xUsb.ucInZlp = ((ulLen % USB_MPS) == 0U) ? 1U : 0U;
+	xUsb.ucInBusy = 1;
+
+	pxEp->DIEPTSIZ = (((ulLen + USB_MPS - 1U) / USB_MPS) << USB_OTG_DIEPTSIZ_PKTCNT_Pos) | ulLen;
+	pxEp->DIEPCTL |= USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK;
+
+	usb_in_fill(pxHigherPriorityTaskWoken);
+
+	if (xUsb.ulInRemaining != 0U)
+	{
+		USB_DEVICE->DIEPEMPMSK |= 1U << USB_EP_DATA;
+	}
+}
+
+/**
+ * @brief Moves packets of the bulk IN transfer into its FIFO while they fit.
+ * @param pxHigherPriorityTaskWoken Set if a task woken must run on exit.
+ * @retval None
+ */
+static void usb_in_fill(BaseType_t *pxHigherPriorityTaskWoken)
+{
+	USB_OTG_INEndpointTypeDef *pxEp = USB_INEP(USB_EP_DATA);
+	uint32_t aulPacket[USB_MPS / 4U];
+	uint32_t ulLen;
+
+	while (xUsb.ulInRemaining != 0U)
+	{
+		ulLen = (xUsb.ulInRemaining < USB_MPS) ? xUsb.ulInRemaining : USB_MPS;
+
+		if ((pxEp->DTXFSTS & USB_OTG_DTXFSTS_INEPTFSAV) < ((ulLen + 3U) / 4U))
+		{
+			break;
+		}
+
+		(void)xStreamBufferReceiveFromISR(xUsb.xTx, aulPacket, ulLen, pxHigherPriorityTaskWoken);
+		usb_fifo_write(USB_EP_DATA, aulPacket, ulLen);
+		xUsb.ulInRemaining -= ulLen;
+	}
+
+	if (xUsb.ulInRemaining == 0U)
+	{
+		USB_DEVICE->DIEPEMPMSK &= ~(1U << USB_EP_DATA);
+	}
+}
+
+/**
+ * @brief Tells whether a configured host is awake.
+ * @param None
+ * @retval 1 if so, 0 otherwise.
+ */
+static uint32_t usb_online(void)
+{
+	return ((xUsb.ucConfigured != 0U) && (xUsb.ucSuspended == 0U)) ? 1U : 0U;
+}
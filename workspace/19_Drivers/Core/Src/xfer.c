@@ -0,0 +1,272 @@
+/*******************************************************************************
+ *
+ * @file	xfer.c
+ * @brief	Asynchronous transfer requests shared by the DMA drivers.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	A request describes one transfer and how its completion is
+ * 			signalled: a callback, a task notification or event group bits.
+ * 			A driver queues the requests it is given and, from the interrupt
+ * 			that ends one, starts the next before signalling the first, so
+ * 			requests queued back-to-back keep the peripheral busy without
+ * 			waiting for the task that submitted them.
+ *
+ * 			The submitter fills a request with xfer_init() and one of the
+ * 			xfer_on_...() calls, then hands it to a driver, e.g.
+ * 			uart_write_async() or adc_convert_async(). From then until it
+ * 			completes the request belongs to the driver. lResult reads
+ * 			XFER_PENDING meanwhile, then the amount transferred, or
+ * 			XFER_ERROR.
+ *
+ * 			Event bits are set from the driver's ISR with
+ * 			xEventGroupSetBitsFromISR(), i.e. by the timer service task, so
+ * 			they need configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+#include "xfer.h"
+
+/* Macros --------------------------------------------------------------------*/
+#if (configUSE_TIMERS == 1) && (INCLUDE_xTimerPendFunctionCall == 1)
+#define XFER_EVENTS_FROM_ISR 1
+#else
+#define XFER_EVENTS_FROM_ISR 0
+#endif
+
+/* Private function prototypes -----------------------------------------------*/
+static void xfer_signal(XferReq_t *pxReq, int32_t lResult, BaseType_t xFromIsr,
+		BaseType_t *pxHigherPriorityTaskWoken);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Prepares a request with no completion signal.
+ * @param pxReq Request, not queued on a driver.
+ * @param pvData Buffer to send from or receive into.
+ * @param ulLen Length, in the units of the driver it is submitted to.
+ * @retval None
+ * @note Completion is then seen by polling xfer_done().
+ */
+void xfer_init(XferReq_t *pxReq, void *pvData, uint32_t ulLen)
+{
+	pxReq->pxNext = NULL;
+	pxReq->pvData = pvData;
+	pxReq->ulLen = ulLen;
+	pxReq->lResult = 0;
+	pxReq->xSignal = XFER_SIGNAL_NONE;
+	pxReq->pxCallback = NULL;
+	pxReq->pvContext = NULL;
+	pxReq->xTask = NULL;
+	pxReq->xEvents = NULL;
+	pxReq->uxBits = 0;
+}
+
+/**
+ * @brief Signals completion with a callback.
+ * @param pxReq Request.
+ * @param pxCallback Called once the request is complete, normally from the
+ * driver's ISR. It may submit the request again.
+ * @param pvContext Left in pxReq->pvContext for the callback.
+ * @retval None
+ */
+void xfer_on_callback(XferReq_t *pxReq, XferCallback_t pxCallback, void *pvContext)
+{
+	pxReq->xSignal = XFER_SIGNAL_CALLBACK;
+	pxReq->pxCallback = pxCallback;
+	pxReq->pvContext = pvContext;
+}
+
+/**
+ * @brief Signals completion with a task notification.
+ * @param pxReq Request.
+ * @param xTask Task notified at XFER_NOTIFY_INDEX, NULL for the caller.
+ * @retval None
+ * @note The task waits with xfer_wait(). The notification only counts, so one
+ * task can wait for several requests in turn.
+ */
+void xfer_on_task(XferReq_t *pxReq, TaskHandle_t xTask)
+{
+	pxReq->xSignal = XFER_SIGNAL_TASK;
+	pxReq->xTask = (xTask != NULL) ? xTask : xTaskGetCurrentTaskHandle();
+}
+
+/**
+ * @brief Signals completion by setting event group bits.
+ * @param pxReq Request.
+ * @param xEvents Event group.
+ * @param uxBits Bits to set.
+ * @retval None
+ */
+void xfer_on_event(XferReq_t *pxReq, EventGroupHandle_t xEvents, EventBits_t uxBits)
+{
+	configASSERT(XFER_EVENTS_FROM_ISR == 1);
+
+	pxReq->xSignal = XFER_SIGNAL_EVENT;
+	pxReq->xEvents = xEvents;
+	pxReq->uxBits = uxBits;
+}
+
+/**
+ * @brief Waits for a request signalled to the calling task.
+ * @param pxReq Request prepared with xfer_on_task() for this task.
+ * @param xTicksToWait Maximum time to wait.
+ * @retval The result of the request, or XFER_PENDING on timeout (it then
+ * still belongs to the driver).
+ */
+int32_t xfer_wait(XferReq_t *pxReq, TickType_t xTicksToWait)
+{
+	TimeOut_t xTimeOut;
+
+	vTaskSetTimeOutState(&xTimeOut);
+
+	/* A notification left by an earlier request only costs one more pass. */
+	while (pxReq->lResult == XFER_PENDING)
+	{
+		if (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE)
+		{
+			return XFER_PENDING;
+		}
+
+		(void)ulTaskNotifyTakeIndexed(XFER_NOTIFY_INDEX, pdFALSE, xTicksToWait);
+	}
+
+	return pxReq->lResult;
+}
+
+/**
+ * @brief Appends a request to a driver queue and marks it pending.
+ * @param pxQueue Queue.
+ * @param pxReq Request.
+ * @retval 1 if the queue was empty, so the driver must start it, 0 otherwise.
+ * @note Called by the driver with its interrupts masked.
+ */
+int32_t xfer_queue_push(XferQueue_t *pxQueue, XferReq_t *pxReq)
+{
+	pxReq->pxNext = NULL;
+	pxReq->lResult = XFER_PENDING;
+
+	if (pxQueue->pxTail == NULL)
+	{
+		pxQueue->pxHead = pxReq;
+		pxQueue->pxTail = pxReq;
+
+		return 1;
+	}
+
+	pxQueue->pxTail->pxNext = pxReq;
+	pxQueue->pxTail = pxReq;
+
+	return 0;
+}
+
+/**
+ * @brief Removes the oldest request of a driver queue.
+ * @param pxQueue Queue, not empty.
+ * @retval The request removed.
+ * @note Called by the driver with its interrupts masked or from its ISR. The
+ * next request, if any, is then pxQueue->pxHead.
+ */
+XferReq_t *xfer_queue_pop(XferQueue_t *pxQueue)
+{
+	XferReq_t *pxReq = pxQueue->pxHead;
+
+	pxQueue->pxHead = pxReq->pxNext;
+
+	if (pxQueue->pxHead == NULL)
+	{
+		pxQueue->pxTail = NULL;
+	}
+
+	pxReq->pxNext = NULL;
+
+	return pxReq;
+}
+
+/**
+ * @brief Completes a request from a task.
+ * @param pxReq Request, removed from its driver queue.
+ * @param lResult Amount transferred, or XFER_ERROR.
+ * @retval None
+ */
+void xfer_complete(XferReq_t *pxReq, int32_t lResult)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	xfer_signal(pxReq, lResult, pdFALSE, &xHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Completes a request from the driver's ISR.
+ * @param pxReq Request, removed from its driver queue.
+ * @param lResult Amount transferred, or XFER_ERROR.
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the signalled task should
+ * run before the interrupted one.
+ * @retval None
+ */
+void xfer_complete_from_isr(XferReq_t *pxReq, int32_t lResult,
+		BaseType_t *pxHigherPriorityTaskWoken)
+{
+	xfer_signal(pxReq, lResult, pdTRUE, pxHigherPriorityTaskWoken);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Publishes the result of a request and signals it.
+ * @param pxReq Request.
+ * @param lResult Result.
+ * @param xFromIsr pdTRUE in an ISR.
+ * @param pxHigherPriorityTaskWoken Updated by the FromISR calls.
+ * @retval None
+ * @note The signal is read before the result is written: once lResult is no
+ * longer XFER_PENDING the submitter may reuse the request.
+ */
+static void xfer_signal(XferReq_t *pxReq, int32_t lResult, BaseType_t xFromIsr,
+		BaseType_t *pxHigherPriorityTaskWoken)
+{
+	const XferSignal_t xSignal = pxReq->xSignal;
+	TaskHandle_t xTask = pxReq->xTask;
+	EventGroupHandle_t xEvents = pxReq->xEvents;
+	EventBits_t uxBits = pxReq->uxBits;
+
+	pxReq->lResult = lResult;
+
+	switch (xSignal)
+	{
+	case XFER_SIGNAL_CALLBACK:
+		pxReq->pxCallback(pxReq, pxHigherPriorityTaskWoken);
+		break;
+
+	case XFER_SIGNAL_TASK:
+		if (xFromIsr)
+		{
+			vTaskNotifyGiveIndexedFromISR(xTask, XFER_NOTIFY_INDEX, pxHigherPriorityTaskWoken);
+		}
+		else
+		{
+			(void)xTaskNotifyGiveIndexed(xTask, XFER_NOTIFY_INDEX);
+		}
+		break;
+
+	case XFER_SIGNAL_EVENT:
+		if (xFromIsr)
+		{
+#if (XFER_EVENTS_FROM_ISR == 1)
+			(void)xEventGroupSetBitsFromISR(xEvents, uxBits, pxHigherPriorityTaskWoken);
+#endif
+		}
+		else
+		{
+			(void)xEventGroupSetBits(xEvents, uxBits);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+"""Ranks the critical sections printed by csprof.c, worst first.
+
+Each call site is looked up in the symbol table of the firmware ELF and
+shown as function+offset. Dumps are merged: the longest section is the
+longest of all dumps, counts and totals are summed.
+
+Usage:
+    csprof_report.py Debug/app.elf /dev/ttyACM0 --dumps 3
+    csprof_report.py Debug/app.elf console.log
+    csprof_report.py Debug/app.elf console.log --top 10 --sort total
+
+A serial port is opened with pyserial when it is installed; otherwise set it
+up beforehand (e.g. 'stty -F /dev/ttyACM0 115200 raw') and pass its path.
+Lines without the "csprof:" prefix are ignored.
+"""
+
+import argparse
+import bisect
+import collections
+import struct
+import sys
+
+PREFIX = "csprof:"
+TABLES = (("crit", "Interrupts masked (taskENTER_CRITICAL)"),
+          ("sched", "Scheduler suspended (vTaskSuspendAll)"))
+
+SHT_SYMTAB = 2
+STT_FUNC = 2
+
+
+def read_functions(path):
+    """Returns the sorted (address, size, name) functions of an ELF32 file."""
+    with open(path, "rb") as elf:
+        data = elf.read()
+    if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+        raise SystemExit("%s: not a little-endian ELF32 file" % path)
+
+    e_shoff, = struct.unpack_from("<I", data, 0x20)
+    e_shentsize, e_shnum = struct.unpack_from("<HH", data, 0x2E)
+    sections = [struct.unpack_from("<IIIIIIIIII", data, e_shoff + i * e_shentsize)
+                for i in range(e_shnum)]
+
+    functions = []
+    for section in sections:
+        if section[1] != SHT_SYMTAB:
+            continue
+        offset, size, link, entsize = section[4], section[5], section[6], section[9]
+        strtab = sections[link][4]
+        for pos in range(offset, offset + size, entsize):
+            st_name, st_value, st_size, st_info = struct.unpack_from("<IIIB", data, pos)
+            if (st_info & 0xF) != STT_FUNC or st_value == 0:
+                continue
+            end = data.index(b"\0", strtab + st_name)
+            name = data[strtab + st_name:end].decode(errors="replace")
+            functions.append((st_value & ~1, st_size, name))    # Thumb bit.
+    functions.sort()
+    return functions
+
+
+def open_input(path, baudrate):
+    if path == "-":
+        return sys.stdin
+    try:
+        import serial
+        if path.startswith(("/dev/", "COM")):
+            port = serial.Serial(path, baudrate)
+            return (line.decode(errors="replace") for line in port)
+    except ImportError:
+        pass
+    return open(path, errors="replace")
+
+
+class Site:
+    def __init__(self):
+        self.count = 0
+        self.max = 0
+        self.total = 0
+
+
+class Profile:
+    def __init__(self, functions):
+        self.functions = functions
+        self.addresses = [function[0] for function in functions]
+        self.sites = {table: collections.defaultdict(Site) for table, _ in TABLES}
+        self.lost = collections.Counter()
+        self.hz = 0
+        self.dumps = 0
+
+    def location(self, address):
+        i = bisect.bisect_right(self.addresses, address) - 1
+        if i >= 0:
+            start, size, name = self.functions[i]
+            if address < start + max(size, 2):
+                return "%s+0x%x" % (name, address - start)
+        return "0x%08x" % address
+
+    def line(self, line):
+        """Parses one console line; returns True at the end of a dump."""
+        start = line.find(PREFIX)
+        if start < 0:
+            return False
+        fields = line[start + len(PREFIX):].split()
+        if not fields:
+            return False
+        if fields[0] == "begin":
+            values = dict(field.split("=", 1) for field in fields[1:] if "=" in field)
+            self.hz = int(values.get("hz", self.hz))
+        elif fields[0] in self.sites and len(fields) >= 2 and "=" in fields[1]:
+            values = dict(field.split("=", 1) for field in fields[1:] if "=" in field)
+            self.lost[fields[0]] += int(values.get("lost", 0))
+        elif fields[0] in self.sites and len(fields) == 5:
+            site = self.sites[fields[0]][int(fields[1], 16)]
+            count, longest, total = (int(field) for field in fields[2:])
+            site.count += count
+            site.max = max(site.max, longest)
+            site.total += total
+        elif fields[0] == "end":
+            self.dumps += 1
+            return True
+        return False
+
+    def us(self, cycles):
+        return 1e6 * cycles / self.hz if self.hz else 0.0
+
+    def report(self, top, sort):
+        print("%d dump(s), core clock %d Hz" % (self.dumps, self.hz))
+        for table, title in TABLES:
+            sites = self.sites[table]
+            print("\n%s: %d call site(s), %d lost" % (title, len(sites), self.lost[table]))
+            if not sites:
+                continue
+            ranked = sorted(sites.items(), key=lambda item: getattr(item[1], sort),
+                            reverse=True)
+            print("%10s %10s %10s %12s  %s" % ("max us", "mean us", "count", "total us",
+                                               "call site"))
+            for address, site in ranked[:top]:
+                print("%10.2f %10.2f %10d %12.1f  %s" % (
+                    self.us(site.max), self.us(site.total / site.count) if site.count else 0.0,
+                    site.count, self.us(site.total), self.location(address)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf", help="firmware ELF with its symbol table")
+    parser.add_argument("input", help="serial port, console log, or - for stdin")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--dumps", type=int, default=0,
+                        help="stop after this many dumps (default: end of input)")
+    parser.add_argument("--top", type=int, default=20,
+                        help="call sites listed per table")
+    parser.add_argument("--sort", choices=("max", "total", "count"), default="max",
+                        help="rank by the longest section (default), the total or the count")
+    options = parser.parse_args()
+
+    profile = Profile(read_functions(options.elf))
+    try:
+        for line in open_input(options.input, options.baudrate):
+            if profile.line(line) and options.dumps and profile.dumps >= options.dumps:
+                break
+    except KeyboardInterrupt:
+        pass
+    profile.report(options.top, options.sort)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,182 @@
+#!/usr/bin/env python3
+"""Maps the histogram printed by pcprof.c to functions and tasks.
+
+Each sampled PC is looked up in the symbol table of the firmware ELF and
+the samples are totalled per function, overall and per task or handler.
+Dumps are summed, so a longer capture gives a finer profile.
+
+Usage:
+    pcprof_report.py Debug/app.elf /dev/ttyACM0 --dumps 3
+    pcprof_report.py Debug/app.elf console.log
+    pcprof_report.py Debug/app.elf console.log --top 10 --per-task
+
+A serial port is opened with pyserial when it is installed; otherwise set it
+up beforehand (e.g. 'stty -F /dev/ttyACM0 115200 raw') and pass its path.
+Lines without the "pcprof:" prefix are ignored.
+"""
+
+import argparse
+import bisect
+import collections
+import struct
+import sys
+
+PREFIX = "pcprof:"
+CTX_MAIN = 0
+CTX_EXC = 0x80000000
+
+SHT_SYMTAB = 2
+STT_FUNC = 2
+
+EXCEPTIONS = {2: "NMI", 3: "HardFault", 4: "MemManage", 5: "BusFault",
+              6: "UsageFault", 11: "SVCall", 12: "DebugMon", 14: "PendSV",
+              15: "SysTick"}
+
+
+def read_functions(path):
+    """Returns the sorted (address, size, name) functions of an ELF32 file."""
+    with open(path, "rb") as elf:
+        data = elf.read()
+    if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+        raise SystemExit("%s: not a little-endian ELF32 file" % path)
+
+    e_shoff, = struct.unpack_from("<I", data, 0x20)
+    e_shentsize, e_shnum = struct.unpack_from("<HH", data, 0x2E)
+    sections = [struct.unpack_from("<IIIIIIIIII", data, e_shoff + i * e_shentsize)
+                for i in range(e_shnum)]
+
+    functions = []
+    for section in sections:
+        if section[1] != SHT_SYMTAB:
+            continue
+        offset, size, link, entsize = section[4], section[5], section[6], section[9]
+        strtab = sections[link][4]
+        for pos in range(offset, offset + size, entsize):
+            st_name, st_value, st_size, st_info = struct.unpack_from("<IIIB", data, pos)
+            if (st_info & 0xF) != STT_FUNC or st_value == 0:
+                continue
+            end = data.index(b"\0", strtab + st_name)
+            name = data[strtab + st_name:end].decode(errors="replace")
+            functions.append((st_value & ~1, st_size, name))    # Thumb bit.
+    functions.sort()
+    return functions
+
+
+def open_input(path, baudrate):
+    if path == "-":
+        return sys.stdin
+    try:
+        import serial
+        if path.startswith(("/dev/", "COM")):
+            port = serial.Serial(path, baudrate)
+            return (line.decode(errors="replace") for line in port)
+    except ImportError:
+        pass
+    return open(path, errors="replace")
+
+
+class Profile:
+    def __init__(self, functions):
+        self.functions = functions
+        self.addresses = [function[0] for function in functions]
+        self.names = {}
+        self.counts = collections.Counter()    # (function, context) -> samples
+        self.samples = 0
+        self.lost = 0
+        self.dumps = 0
+
+    def function(self, pc):
+        i = bisect.bisect_right(self.addresses, pc) - 1
+        if i >= 0:
+            address, size, name = self.functions[i]
+            if pc < address + max(size, 2):
+                return name
+        return "0x%08x" % pc
+
+    def context(self, ctx):
+        if ctx == CTX_MAIN:
+            return "main"
+        if ctx & CTX_EXC:
+            number = ctx & ~CTX_EXC
+            return EXCEPTIONS.get(number, "IRQ%d" % (number - 16))
+        return self.names.get(ctx, "task 0x%08x" % ctx)
+
+    def line(self, line):
+        """Parses one console line; returns True at the end of a dump."""
+        start = line.find(PREFIX)
+        if start < 0:
+            return False
+        fields = line[start + len(PREFIX):].split()
+        if not fields:
+            return False
+        if fields[0] == "begin":
+            values = dict(field.split("=", 1) for field in fields[1:] if "=" in field)
+            self.samples += int(values.get("samples", 0))
+            self.lost += int(values.get("lost", 0))
+        elif fields[0] == "task" and len(fields) >= 3:
+            self.names[int(fields[1], 16)] = " ".join(fields[2:])
+        elif fields[0] == "pc" and len(fields) == 4:
+            pc, ctx, count = int(fields[1], 16), int(fields[2], 16), int(fields[3])
+            self.counts[(self.function(pc), ctx)] += count
+        elif fields[0] == "end":
+            self.dumps += 1
+            return True
+        return False
+
+    def report(self, top, per_task):
+        total = sum(self.counts.values())
+        print("%d dump(s), %d samples, %d lost" % (self.dumps, self.samples, self.lost))
+        if total == 0:
+            return
+
+        by_function = collections.Counter()
+        by_context = collections.Counter()
+        for (function, ctx), count in self.counts.items():
+            by_function[function] += count
+            by_context[self.context(ctx)] += count
+
+        print("\n%8s %6s  %s" % ("samples", "%", "function"))
+        for function, count in by_function.most_common(top):
+            print("%8d %6.2f  %s" % (count, 100.0 * count / total, function))
+
+        print("\n%8s %6s  %s" % ("samples", "%", "task / handler"))
+        for context, count in by_context.most_common():
+            print("%8d %6.2f  %s" % (count, 100.0 * count / total, context))
+
+        if not per_task:
+            return
+        for context, context_total in by_context.most_common():
+            print("\n%s (%d samples)" % (context, context_total))
+            rows = collections.Counter()
+            for (function, ctx), count in self.counts.items():
+                if self.context(ctx) == context:
+                    rows[function] += count
+            for function, count in rows.most_common(top):
+                print("%8d %6.2f  %s" % (count, 100.0 * count / context_total, function))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf", help="firmware ELF with its symbol table")
+    parser.add_argument("input", help="serial port, console log, or - for stdin")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--dumps", type=int, default=0,
+                        help="stop after this many dumps (default: end of input)")
+    parser.add_argument("--top", type=int, default=20,
+                        help="functions listed per table")
+    parser.add_argument("--per-task", action="store_true",
+                        help="also list the functions of each task and handler")
+    options = parser.parse_args()
+
+    profile = Profile(read_functions(options.elf))
+    try:
+        for line in open_input(options.input, options.baudrate):
+            if profile.line(line) and options.dumps and profile.dumps >= options.dumps:
+                break
+    except KeyboardInterrupt:
+        pass
+    profile.report(options.top, options.per_task)
+
+
+if __name__ == "__main__":
+    main()
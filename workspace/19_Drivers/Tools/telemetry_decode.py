@@ -0,0 +1,390 @@
+#!/usr/bin/env python3
+"""Decodes the binary telemetry stream written by telemetry.c.
+
+Each frame is COBS-encoded with a CRC-32 trailer (frame.c). Schema frames
+name the channels; key frames carry absolute values, delta frames the
+differences from the previous sample. The decoder waits for a schema and a
+key frame, drops delta frames after a lost frame until the next key frame,
+and derives the CPU share of each task from consecutive samples.
+
+Usage:
+    telemetry_decode.py /dev/ttyACM0
+    telemetry_decode.py /dev/ttyACM0 --interval 0 --csv samples.csv
+    telemetry_decode.py swo.bin --itm 3
+
+It can also be imported: feed bytes to Decoder.feed() and read the Sample
+objects it yields.
+
+A serial port is opened with pyserial when it is installed; otherwise set it
+up beforehand (e.g. 'stty -F /dev/ttyACM0 115200 raw') and pass its path.
+With --itm, the input is a raw SWO capture and the frames are taken from
+that ITM stimulus port.
+"""
+
+import argparse
+import csv
+import struct
+import sys
+import time
+
+VERSION = 1
+HEADER = struct.Struct("<BBBBHI")
+POLYNOMIAL = 0x04C11DB7
+
+FRAME_SCHEMA, FRAME_KEY, FRAME_DELTA = 0, 1, 2
+
+KIND_RUNTIME = 0
+KIND_TASK_RUNTIME = 1
+KIND_TASK_STACK = 2
+KIND_HEAP_FREE = 3
+KIND_HEAP_MIN = 4
+KIND_QUEUE_DEPTH = 5
+KIND_COUNTER = 6
+
+KIND_NAMES = {
+    KIND_RUNTIME: "runtime",
+    KIND_TASK_RUNTIME: "cpu",
+    KIND_TASK_STACK: "stack",
+    KIND_HEAP_FREE: "heap_free",
+    KIND_HEAP_MIN: "heap_min",
+    KIND_QUEUE_DEPTH: "queue",
+    KIND_COUNTER: "counter",
+}
+
+
+def crc_shift(crc, bits):
+    for _ in range(bits):
+        crc = ((crc << 1) ^ POLYNOMIAL) if crc & 0x80000000 else (crc << 1)
+        crc &= 0xFFFFFFFF
+    return crc
+
+
+def crc32_stm32(data):
+    """CRC of the STM32 CRC unit over data, as crc.c computes it."""
+    crc = 0xFFFFFFFF
+    whole = len(data) - len(data) % 4
+    for (word,) in struct.iter_unpack("<I", data[:whole]):
+        crc = crc_shift(crc ^ word, 32)
+    for byte in data[whole:]:
+        crc = crc_shift(crc ^ (byte << 24), 8)
+    return crc
+
+
+def cobs_decode(data):
+    """Returns the decoded body of one COBS frame, or None if malformed."""
+    out = bytearray()
+    index = 0
+    while index < len(data):
+        code = data[index]
+        if code == 0 or index + code > len(data):
+            return None
+        out += data[index + 1:index + code]
+        index += code
+        if code < 0xFF and index < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def read_varint(data, offset):
+    value, shift = 0, 0
+    while True:
+        if offset >= len(data) or shift > 28:
+            raise ValueError("truncated varint")
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value & 0xFFFFFFFF, offset
+        shift += 7
+
+
+def itm_payload(stream, port):
+    """Yields the bytes written to one ITM stimulus port in a SWO capture."""
+    while True:
+        header = stream.read(1)
+        if not header:
+            return
+        header = header[0]
+        size = (0, 1, 2, 4)[header & 3]
+        if size:
+            # Source packet: software (bit 2 clear) or hardware.
+            payload = stream.read(size)
+            if not (header & 4) and (header >> 3) == port:
+                yield payload
+        elif header & 0x80 and header & 0x0F == 0:
+            # Local timestamp with continuation bytes.
+            while True:
+                byte = stream.read(1)
+                if not byte or not byte[0] & 0x80:
+                    break
+        # Sync (0x00 ... 0x80) and overflow (0x70) packets carry no data.
+
+
+class Channel:
+    def __init__(self, kind, param, name):
+        self.kind = kind
+        self.param = param
+        self.name = name
+
+    @property
+    def label(self):
+        if self.kind in (KIND_TASK_RUNTIME, KIND_TASK_STACK):
+            return f"{self.name}.{KIND_NAMES[self.kind]}"
+        if self.kind in (KIND_QUEUE_DEPTH, KIND_COUNTER):
+            return self.name
+        return KIND_NAMES.get(self.kind, f"kind{self.kind}")
+
+
+class Schema:
+    def __init__(self, number, count, tick_hz, runtime_hz):
+        self.number = number
+        self.channels = [None] * count
+        self.tick_hz = tick_hz
+        self.runtime_hz = runtime_hz
+
+    @property
+    def complete(self):
+        return all(channel is not None for channel in self.channels)
+
+
+class Sample:
+    """One decoded sample. 'values' holds one integer per schema channel."""
+
+    def __init__(self, sequence, ticks, schema, values, previous):
+        self.sequence = sequence
+        self.ticks = ticks
+        self.schema = schema
+        self.values = values
+        self.previous = previous    # Sample before it, same schema, or None.
+
+    @property
+    def seconds(self):
+        return self.ticks / self.schema.tick_hz if self.schema.tick_hz else 0.0
+
+    def by_kind(self, kind):
+        return [(channel, value) for channel, value in zip(self.schema.channels, self.values)
+                if channel.kind == kind]
+
+    def value(self, kind):
+        found = self.by_kind(kind)
+        return found[0][1] if found else None
+
+    def cpu_shares(self):
+        """Percent of the run time of each task since the previous sample."""
+        if self.previous is None:
+            return {}
+        total = self.value(KIND_RUNTIME)
+        before = self.previous.value(KIND_RUNTIME)
+        if total is None or before is None:
+            return {}
+        elapsed = (total - before) & 0xFFFFFFFF
+        shares = {}
+        for index, (channel, value) in enumerate(zip(self.schema.channels, self.values)):
+            if channel.kind == KIND_TASK_RUNTIME:
+                used = (value - self.previous.values[index]) & 0xFFFFFFFF
+                shares[channel.name] = 100.0 * used / elapsed if elapsed else 0.0
+        return shares
+
+    def rates(self):
+        """Increments per second of each counter since the previous sample."""
+        if self.previous is None:
+            return {}
+        dt = self.seconds - self.previous.seconds
+        rates = {}
+        for index, (channel, value) in enumerate(zip(self.schema.channels, self.values)):
+            if channel.kind == KIND_COUNTER and dt > 0:
+                rates[channel.name] = ((value - self.previous.values[index]) & 0xFFFFFFFF) / dt
+        return rates
+
+
+class Decoder:
+    """Turns the byte stream into Sample objects."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.schemas = {}
+        self.last = None            # Last sample applied.
+        self.last_sequence = None
+        self.frames = 0
+        self.bad_frames = 0         # CRC, COBS or format errors.
+        self.lost_frames = 0        # Gaps in the sequence numbers.
+        self.skipped = 0            # Samples that could not be decoded.
+
+    def feed(self, data):
+        for byte in data:
+            if byte != 0:
+                self.buffer.append(byte)
+                continue
+            frame, self.buffer = bytes(self.buffer), bytearray()
+            if frame:
+                sample = self.frame(frame)
+                if sample is not None:
+                    yield sample
+
+    def frame(self, encoded):
+        body = cobs_decode(encoded)
+        if body is None or len(body) < HEADER.size + 4:
+            self.bad_frames += 1
+            return None
+        payload, (crc,) = body[:-4], struct.unpack("<I", body[-4:])
+        if crc32_stm32(payload) != crc:
+            self.bad_frames += 1
+            return None
+
+        version, kind, schema, count, sequence, ticks = HEADER.unpack_from(payload)
+        if version != VERSION:
+            self.bad_frames += 1
+            return None
+        self.frames += 1
+
+        follows = (self.last_sequence is not None
+                   and sequence == (self.last_sequence + 1) & 0xFFFF)
+        if self.last_sequence is not None and not follows:
+            self.lost_frames += (sequence - self.last_sequence - 1) & 0xFFFF
+        self.last_sequence = sequence
+
+        try:
+            if kind == FRAME_SCHEMA:
+                self.schema(payload, schema, count)
+                return None
+            return self.sample(payload, kind, schema, count, sequence, ticks, follows)
+        except ValueError:
+            self.bad_frames += 1
+            self.last = None
+            return None
+
+    def schema(self, payload, number, count):
+        tick_hz, runtime_hz, first = struct.unpack_from("<IIB", payload, HEADER.size)
+        current = self.schemas.get(number)
+        if current is None or len(current.channels) != count:
+            current = self.schemas[number] = Schema(number, count, tick_hz, runtime_hz)
+        offset = HEADER.size + 9
+        index = first
+        while offset < len(payload):
+            kind = payload[offset]
+            param, offset = read_varint(payload, offset + 1)
+            length = payload[offset]
+            name = payload[offset + 1:offset + 1 + length].decode("utf-8", errors="replace")
+            offset += 1 + length
+            if index >= count:
+                raise ValueError("too many channels")
+            current.channels[index] = Channel(kind, param, name)
+            index += 1
+
+    def sample(self, payload, kind, number, count, sequence, ticks, follows):
+        schema = self.schemas.get(number)
+        if schema is None or not schema.complete or len(schema.channels) != count:
+            self.skipped += 1
+            self.last = None
+            return None
+
+        previous = self.last if (self.last is not None and self.last.schema is schema) else None
+        if kind == FRAME_DELTA and (previous is None or not follows):
+            self.skipped += 1
+            self.last = None
+            return None
+
+        values = []
+        offset = HEADER.size
+        for index in range(count):
+            word, offset = read_varint(payload, offset)
+            if kind == FRAME_KEY:
+                values.append(word)
+            else:
+                diff = (word >> 1) ^ -(word & 1)
+                values.append((previous.values[index] + diff) & 0xFFFFFFFF)
+
+        self.last = Sample(sequence, ticks, schema, values, previous)
+        return self.last
+
+
+def open_input(path, baudrate):
+    if path == "-":
+        return sys.stdin.buffer
+    try:
+        import serial
+        if path.startswith(("/dev/", "COM")):
+            return serial.Serial(path, baudrate, timeout=0.1)
+    except ImportError:
+        pass
+    return open(path, "rb")
+
+
+def chunks(stream, port):
+    if port is None:
+        while True:
+            data = stream.read(256)
+            if not data:
+                if hasattr(stream, "in_waiting"):
+                    continue    # Serial read timeout: keep waiting.
+                return
+            yield data
+    else:
+        yield from itm_payload(stream, port)
+
+
+def report(sample):
+    shares = sample.cpu_shares()
+    lines = [f"t={sample.seconds:10.3f}s  seq={sample.sequence:5d}  "
+             f"heap free={sample.value(KIND_HEAP_FREE)} min={sample.value(KIND_HEAP_MIN)}"]
+    for channel, value in sample.by_kind(KIND_TASK_STACK):
+        share = shares.get(channel.name)
+        cpu = f"{share:6.2f}%" if share is not None else "      -"
+        lines.append(f"  {channel.name:<16} cpu {cpu}  stack free {value:5d} words")
+    for channel, value in sample.by_kind(KIND_QUEUE_DEPTH):
+        lines.append(f"  queue {channel.name:<10} {value:5d} / {channel.param}")
+    rates = sample.rates()
+    for channel, value in sample.by_kind(KIND_COUNTER):
+        rate = rates.get(channel.name)
+        per_second = f"  {rate:10.1f}/s" if rate is not None else ""
+        lines.append(f"  counter {channel.name:<8} {value:10d}{per_second}")
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="serial port, capture file, or - for stdin")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--itm", type=int, metavar="PORT",
+                        help="input is a raw SWO capture; use this stimulus port")
+    parser.add_argument("--interval", type=float, default=1.0,
+                        help="seconds of target time between printed samples (0: all)")
+    parser.add_argument("--csv", metavar="FILE", help="also write every sample to FILE")
+    parser.add_argument("--seconds", type=float, default=0,
+                        help="stop after this long (serial capture)")
+    options = parser.parse_args()
+
+    decoder = Decoder()
+    writer, csv_file, csv_schema = None, None, None
+    if options.csv:
+        csv_file = open(options.csv, "w", newline="")
+        writer = csv.writer(csv_file)
+    printed = None
+    deadline = time.monotonic() + options.seconds if options.seconds else None
+
+    try:
+        for data in chunks(open_input(options.input, options.baudrate), options.itm):
+            for sample in decoder.feed(data):
+                if writer is not None:
+                    if sample.schema is not csv_schema:
+                        csv_schema = sample.schema
+                        writer.writerow(["seconds", "sequence"]
+                                        + [channel.label for channel in csv_schema.channels])
+                    writer.writerow([f"{sample.seconds:.3f}", sample.sequence] + sample.values)
+                if printed is None or sample.seconds - printed >= options.interval \
+                        or sample.seconds < printed:
+                    printed = sample.seconds
+                    print(report(sample), flush=True)
+            if deadline is not None and time.monotonic() >= deadline:
+                break
+    except KeyboardInterrupt:
+        pass
+
+    if csv_file is not None:
+        csv_file.close()
+    sys.stderr.write(f"{decoder.frames} frames, {decoder.bad_frames} bad, "
+                     f"{decoder.lost_frames} lost, {decoder.skipped} samples skipped\n")
+
+
+if __name__ == "__main__":
+    main()
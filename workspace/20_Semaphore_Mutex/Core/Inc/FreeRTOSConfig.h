@@ -125,6 +125,7 @@ to exclude the API function. */
  * by the application thus the correct define need to be enabled below
  */
 #define USE_FreeRTOS_HEAP_4
+/* #define USE_FreeRTOS_HEAP_TLSF */	/* Instead of HEAP_4: heap_tlsf.c, O(1) malloc and free */
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -168,6 +169,28 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Port optimised task selection: the CM4F port finds the highest ready
+priority with CLZ on a ready-priority bitmap instead of walking the ready
+lists.  The 56 CMSIS-RTOS2 priorities take a two-level bitmap, so selection is
+two CLZs whatever the priorities in use (see README, Task Selection). */
+#undef configUSE_PORT_OPTIMISED_TASK_SELECTION
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
+/* The serial mutex is mostly uncontended: take and give it without a critical
+section, falling back to the kernel path only when a task has to block. */
+#define configUSE_MUTEX_FAST_PATH                1
+/* xSemaphoreCreateMutexWithCeiling(): the holder of the serial mutex runs at
+the priority of its highest user, instead of inheriting priorities (see
+README, Priority Ceiling Mutexes). */
+#define configUSE_MUTEX_PRIORITY_CEILING         1
+/* Boot profiler (bootprof.c): marks from reset to the switch into the first
+task, printed once by the digital sensor task (see README, Boot Profile).
+Remove this include to build without it. */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  #include "bootprof.h"
+#endif
+/* The idle task sleeps the CPU until the next interrupt instead of spinning
+between ticks (see README, Idle Sleep). */
+#define configUSE_IDLE_SLEEP                     1
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,64 @@
+/*******************************************************************************
+ *
+ * @file	logring.h
+ * @brief	Interface of the per-task lock-free log rings.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef LOGRING_H
+#define LOGRING_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdarg.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef LOGRING_RINGS
+#define LOGRING_RINGS 4U				/* Tasks that can log. */
+#endif
+
+#ifndef LOGRING_RING_BYTES
+#define LOGRING_RING_BYTES 512U			/* Per task, a power of two. */
+#endif
+
+#ifndef LOGRING_LINE_BYTES
+#define LOGRING_LINE_BYTES 96U			/* Longest line, with its NUL. */
+#endif
+
+#ifndef LOGRING_PERIOD_MS
+#define LOGRING_PERIOD_MS 10U			/* How often the logger drains the rings. */
+#endif
+
+#ifndef LOGRING_REPORT_MS
+#define LOGRING_REPORT_MS 1000U			/* How often the drops are reported. */
+#endif
+
+#ifndef LOGRING_STACK_WORDS
+#define LOGRING_STACK_WORDS 384U		/* printf() needs the headroom. */
+#endif
+
+/* Checks the arguments against the format, as for printf(). */
+#define LOGRING_CHECK(fmt_arg, va_arg)	__attribute__((format(printf, fmt_arg, va_arg)))
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	TaskHandle_t xOwner;				/* NULL while the ring is free. */
+	uint32_t ulWritten;					/* Lines put in the ring. */
+	uint32_t ulDropped;					/* Lines that did not fit. */
+	uint32_t ulPeakBytes;				/* Most bytes waiting at once. */
+} LogRingStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+BaseType_t logring_start(UBaseType_t uxPriority);
+int32_t logring_printf(const char *pcFormat, ...) LOGRING_CHECK(1, 2);
+int32_t logring_vprintf(const char *pcFormat, va_list xArgs);
+int32_t logring_get_stats(uint32_t ulRing, LogRingStats_t *pxStats);
+uint32_t logring_get_unowned(void);
+void logring_output(const char *pcLine, uint32_t ulLength);
+
+#endif /* LOGRING_H */
@@ -0,0 +1,58 @@
+/*******************************************************************************
+ *
+ * @file	sampler.h
+ * @brief	Interface of the shared sensor sampling scheduler.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef SAMPLER_MAX_SENSORS
+#define SAMPLER_MAX_SENSORS 8U			/* Sensors that can be registered. */
+#endif
+
+#ifndef SAMPLER_BASE_US
+#define SAMPLER_BASE_US 1000U			/* Periods are this times a power of two. */
+#endif
+
+#ifndef SAMPLER_MAX_SHIFT
+#define SAMPLER_MAX_SHIFT 12U			/* Longest period, SAMPLER_BASE_US << it. */
+#endif
+
+#ifndef SAMPLER_STACK_WORDS
+#define SAMPLER_STACK_WORDS 384U		/* The sinks run on it. */
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+/* Reads the sensor, in the sampler task. */
+typedef uint32_t (*SamplerRead_t)(void *pvArg);
+
+/* Takes a reading, in the sampler task, right after every read of the same
+ * wakeup. ulTimeUs is the hrtimer_now() time of the wakeup. */
+typedef void (*SamplerSink_t)(uint32_t ulValue, uint32_t ulTimeUs, void *pvArg);
+
+typedef struct
+{
+	uint32_t ulPeriodUs;				/* After rounding to the harmonic grid. */
+	uint32_t ulReads;
+	uint32_t ulMissed;					/* Due reads skipped by a late wakeup. */
+	uint32_t ulLast;					/* Last value read. */
+} SamplerStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t sampler_register(uint32_t ulPeriodUs, SamplerRead_t pxRead, SamplerSink_t pxSink,
+		void *pvArg);
+BaseType_t sampler_start(UBaseType_t uxPriority);
+int32_t sampler_get_stats(uint32_t ulSensor, SamplerStats_t *pxStats);
+uint32_t sampler_get_wakeups(void);
+
+#endif /* SAMPLER_H */
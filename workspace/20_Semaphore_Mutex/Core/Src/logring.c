@@ -0,0 +1,401 @@
+/*******************************************************************************
+ *
+ * @file	logring.c
+ * @brief	Per-task lock-free log rings, merged in time order by a logger
+ * 			task.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	Tasks that print behind a shared mutex wait for each other, and
+ * 			one that gives up on a timeout loses its line. Here each task
+ * 			formats its line into a ring of its own and returns:
+ *
+ * 				logring_start(1);
+ * 				...
+ * 				logring_printf("Analog sensor value: %lu\r\n", ulValue);
+ *
+ * 			A task claims one of the LOGRING_RINGS rings the first time it
+ * 			logs, in a short critical section. From then on it is the only
+ * 			writer of its ring (spsc_ring.h) and the logger task the only
+ * 			reader, so a line costs the formatting, a copy and a barrier,
+ * 			with no lock and no kernel call. A line that does not fit is dropped and
+ * 			counted; the task never blocks.
+ *
+ * 			Each line carries the TIM5 microsecond count (timestamp.c) it
+ * 			was logged at. Every LOGRING_PERIOD_MS, the logger drains the
+ * 			rings oldest line first across all of them and passes each line
+ * 			to logring_output(). Every LOGRING_REPORT_MS, it also prints how
+ * 			many lines each task has dropped since the last report. It is
+ * 			the only task that prints, so the lines never mix. A line still
+ * 			being written when the logger runs comes out in the next round,
+ * 			after any newer line of another task.
+ *
+ * 			Tasks only: an ISR has no ring of its own, and its lines are
+ * 			refused. Rings are not given back when a task is deleted.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "stm32f4xx_hal.h"
+#include "logring.h"
+#include "spsc_ring.h"
+#include "timestamp.h"
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulTime;					/* timestamp_now32(), in microseconds. */
+	uint32_t ulLength;					/* Bytes of text that follow. */
+} LogHeader_t;
+
+/* One line in the ring: the header, then ulLength bytes of text, without the
+ * NUL. */
+typedef struct
+{
+	LogHeader_t xHeader;
+	char cText[LOGRING_LINE_BYTES];
+} LogRecord_t;
+
+typedef struct
+{
+	TaskHandle_t volatile xOwner;		/* Set once, in a critical section. */
+	SpscRing_t xRing;
+	volatile uint32_t ulWritten;		/* Owner only. */
+	volatile uint32_t ulDropped;		/* Owner only. */
+	uint32_t ulPeakBytes;				/* Owner only. */
+	uint32_t ulDropsReported;			/* Logger only. */
+	uint8_t ucData[LOGRING_RING_BYTES];
+} LogRing_t;
+
+_Static_assert((LOGRING_RING_BYTES & (LOGRING_RING_BYTES - 1U)) == 0U,
+		"LOGRING_RING_BYTES must be a power of two");
+_Static_assert(LOGRING_RING_BYTES >= sizeof(LogRecord_t), "LOGRING_RING_BYTES too small for a line");
+
+/* Variables -----------------------------------------------------------------*/
+static LogRing_t xRings[LOGRING_RINGS];
+static uint32_t ulUnowned;				/* Lines refused: no ring free, or an ISR. */
+static uint32_t ulUnownedReported;
+
+/* Private function prototypes -----------------------------------------------*/
+static LogRing_t *logring_own(void);
+static BaseType_t logring_drain_one(char *pcLine);
+static void logring_report_drops(void);
+static void logring_task(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Starts the microsecond time source and creates the logger task.
+ * @param uxPriority Priority of the logger. Below the tasks that log, so it
+ * only runs when they have nothing to do.
+ * @retval pdPASS if the task was created.
+ */
+BaseType_t logring_start(UBaseType_t uxPriority)
+{
+	if (timestamp_init() != 0)
+	{
+		return pdFAIL;
+	}
+
+	return xTaskCreate(logring_task,
+					   "LogRing",
+					   LOGRING_STACK_WORDS,
+					   NULL,
+					   uxPriority,
+					   NULL);
+}
+
+/**
+ * @brief Formats a line into the ring of the calling task.
+ * @param pcFormat printf() format.
+ * @retval Characters put in the ring, or -1 if the line was dropped.
+ */
+int32_t logring_printf(const char *pcFormat, ...)
+{
+	va_list xArgs;
+	int32_t lResult;
+
+	va_start(xArgs, pcFormat);
+	lResult = logring_vprintf(pcFormat, xArgs);
+	va_end(xArgs);
+
+	return lResult;
+}
+
+/**
+ * @brief Formats a line into the ring of the calling task.
+ * @param pcFormat printf() format.
+ * @param xArgs Its arguments.
+ * @retval Characters put in the ring, or -1 if the line was dropped.
+ * @note Lines are cut at LOGRING_LINE_BYTES - 1 characters. Never blocks.
+ * Formats on the stack: LOGRING_LINE_BYTES on top of what vsnprintf() takes.
+ */
+int32_t logring_vprintf(const char *pcFormat, va_list xArgs)
+{
+	LogRing_t *pxRing;
+	LogRecord_t xRecord;
+	uint32_t ulBytes;
+	int iLength;
+
+	xRecord.xHeader.ulTime = timestamp_now32();
+	pxRing = logring_own();
+
+	if (pxRing == NULL)
+	{
+		return -1;
+	}
+
+	iLength = vsnprintf(xRecord.cText, sizeof(xRecord.cText), pcFormat, xArgs);
+
+	if (iLength < 0)
+	{
+		return -1;
+	}
+
+	if (iLength >= (int)sizeof(xRecord.cText))
+	{
+		iLength = (int)sizeof(xRecord.cText) - 1;
+	}
+
+	xRecord.xHeader.ulLength = (uint32_t)iLength;
+	ulBytes = sizeof(xRecord.xHeader) + xRecord.xHeader.ulLength;
+
+	if (spsc_ring_write(&pxRing->xRing, (const uint8_t *)&xRecord, ulBytes) != 0)
+	{
+		pxRing->ulDropped++;
+		return -1;
+	}
+
+	pxRing->ulWritten++;
+	ulBytes = spsc_ring_count(&pxRing->xRing);
+
+	if (ulBytes > pxRing->ulPeakBytes)
+	{
+		pxRing->ulPeakBytes = ulBytes;
+	}
+
+	return iLength;
+}
+
+/**
+ * @brief Copies the counters of a ring.
+ * @param ulRing 0 to LOGRING_RINGS - 1, in the order the tasks first logged.
+ * @param pxStats Where to copy them.
+ * @retval 0 on success, -1 on a bad argument.
+ */
+int32_t logring_get_stats(uint32_t ulRing, LogRingStats_t *pxStats)
+{
+	if ((pxStats == NULL) || (ulRing >= LOGRING_RINGS))
+	{
+		return -1;
+	}
+
+	pxStats->xOwner = xRings[ulRing].xOwner;
+	pxStats->ulWritten = xRings[ulRing].ulWritten;
+	pxStats->ulDropped = xRings[ulRing].ulDropped;
+	pxStats->ulPeakBytes = xRings[ulRing].ulPeakBytes;
+
+	return 0;
+}
+
+/**
+ * @brief Returns the lines refused because no ring was free or they came
+ * from an ISR.
+ * @param None
+ * @retval Lines refused since boot.
+ */
+uint32_t logring_get_unowned(void)
+{
+	return ulUnowned;
+}
+
+/**
+ * @brief Writes one merged line out. Called by the logger task only.
+ * @param pcLine The line, NUL-terminated.
+ * @param ulLength Its length.
+ * @retval None
+ * @note Weak: printf() by default. Override it to send the lines elsewhere,
+ * or to share the output with code that prints directly.
+ */
+__weak void logring_output(const char *pcLine, uint32_t ulLength)
+{
+	printf("%.*s", (int)ulLength, pcLine);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Returns the ring of the calling task, claiming a free one on its
+ * first line.
+ * @param None
+ * @retval The ring, or NULL if none is free or if called from an ISR.
+ */
+static LogRing_t *logring_own(void)
+{
+	TaskHandle_t xTask;
+	LogRing_t *pxRing = NULL;
+	UBaseType_t uxSavedInterruptStatus;
+	uint32_t i;
+
+	if (__get_IPSR() != 0U)
+	{
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		ulUnowned++;
+		taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+		return NULL;
+	}
+
+	xTask = xTaskGetCurrentTaskHandle();
+
+	for (i = 0U; i < LOGRING_RINGS; i++)
+	{
+		if (xRings[i].xOwner == xTask)
+		{
+			return &xRings[i];
+		}
+	}
+
+	taskENTER_CRITICAL();
+
+	for (i = 0U; (i < LOGRING_RINGS) && (pxRing == NULL); i++)
+	{
+		if (xRings[i].xOwner == NULL)
+		{
+			(void)spsc_ring_init(&xRings[i].xRing, xRings[i].ucData, LOGRING_RING_BYTES);
+			xRings[i].xOwner = xTask;
+			pxRing = &xRings[i];
+		}
+	}
+
+	if (pxRing == NULL)
+	{
+		ulUnowned++;
+	}
+
+	taskEXIT_CRITICAL();
+
+	return pxRing;
+}
+
+/**
+ * @brief Takes the oldest line of all the rings and writes it out.
+ * @param pcLine Buffer of LOGRING_LINE_BYTES for the line.
+ * @retval pdTRUE if a line was written, pdFALSE if the rings are empty.
+ * @note The times are compared as signed differences, so the order survives
+ * the 32-bit microsecond count wrapping every 71 minutes.
+ */
+static BaseType_t logring_drain_one(char *pcLine)
+{
+	LogRing_t *pxOldest = NULL;
+	LogHeader_t xOldest = { 0 };
+	LogHeader_t xHeader;
+	uint32_t i;
+
+	for (i = 0U; i < LOGRING_RINGS; i++)
+	{
+		/* A header is only there with its text: both went in at once. */
+		if ((xRings[i].xOwner == NULL)
+				|| (spsc_ring_peek(&xRings[i].xRing, (uint8_t *)&xHeader, sizeof(xHeader))
+						!= sizeof(xHeader)))
+		{
+			continue;
+		}
+
+		if ((pxOldest == NULL) || ((int32_t)(xHeader.ulTime - xOldest.ulTime) < 0))
+		{
+			pxOldest = &xRings[i];
+			xOldest = xHeader;
+		}
+	}
+
+	if (pxOldest == NULL)
+	{
+		return pdFALSE;
+	}
+
+	/* The owner may reuse the space once the line is out of it. */
+	(void)spsc_ring_read(&pxOldest->xRing, (uint8_t *)&xHeader, sizeof(xHeader));
+	(void)spsc_ring_read(&pxOldest->xRing, (uint8_t *)pcLine, xOldest.ulLength);
+	pcLine[xOldest.ulLength] = '\0';
+
+	logring_output(pcLine, xOldest.ulLength);
+
+	return pdTRUE;
+}
+
+/**
+ * @brief Writes out how many lines each task dropped since the last report.
+ * @param None
+ * @retval None
+ */
+static void logring_report_drops(void)
+{
+	char cLine[LOGRING_LINE_BYTES];
+	uint32_t ulDropped;
+	uint32_t i;
+	int iLength;
+
+	for (i = 0U; i < LOGRING_RINGS; i++)
+	{
+		ulDropped = xRings[i].ulDropped;
+
+		if ((xRings[i].xOwner == NULL) || (ulDropped == xRings[i].ulDropsReported))
+		{
+			continue;
+		}
+
+		iLength = snprintf(cLine, sizeof(cLine), "logring: %s dropped %lu lines (%lu in all)\r\n",
+				pcTaskGetName(xRings[i].xOwner), ulDropped - xRings[i].ulDropsReported, ulDropped);
+		xRings[i].ulDropsReported = ulDropped;
+
+		if (iLength > 0)
+		{
+			logring_output(cLine, ((uint32_t)iLength < sizeof(cLine)) ? (uint32_t)iLength :
+					(uint32_t)sizeof(cLine) - 1U);
+		}
+	}
+
+	ulDropped = ulUnowned;
+
+	if (ulDropped != ulUnownedReported)
+	{
+		iLength = snprintf(cLine, sizeof(cLine), "logring: %lu lines without a ring\r\n",
+				ulDropped - ulUnownedReported);
+		ulUnownedReported = ulDropped;
+
+		if (iLength > 0)
+		{
+			logring_output(cLine, (uint32_t)iLength);
+		}
+	}
+}
+
+/**
+ * @brief Drains the rings every LOGRING_PERIOD_MS and reports the drops every
+ * LOGRING_REPORT_MS.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void logring_task(void *pvParameters)
+{
+	const TickType_t xPeriodTicks = pdMS_TO_TICKS(LOGRING_PERIOD_MS);
+	const TickType_t xReportTicks = pdMS_TO_TICKS(LOGRING_REPORT_MS);
+	TickType_t xLastReportTicks = xTaskGetTickCount();
+	char cLine[LOGRING_LINE_BYTES];
+
+	while (1)
+	{
+		while (logring_drain_one(cLine) != pdFALSE)
+		{
+		}
+
+		if ((xTaskGetTickCount() - xLastReportTicks) >= xReportTicks)
+		{
+			xLastReportTicks += xReportTicks;
+			logring_report_drops();
+		}
+
+		vTaskDelay(xPeriodTicks);
+	}
+}
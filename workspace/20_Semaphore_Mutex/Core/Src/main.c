@@ -9,15 +9,53 @@
  * @note	'semphr.h' must be included inside the 'cmsis_os.h' to use
  * 			semaphores.
  *
+ * 			main() marks each boot phase with bootprof_mark(), and the
+ * 			digital sensor task prints the boot profile once under the
+ * 			serial mutex.
+ *
+ * 			With MUTEX_CEILING set, the serial mutex uses the priority
+ * 			ceiling protocol: the analog sensor task runs at the priority of
+ * 			the digital sensor task while it prints.
+ *
+ * 			With LOG_RINGS set, the sensor tasks no longer take the mutex:
+ * 			each logs into a ring of its own (logring.h) and the logger task
+ * 			prints the lines in time order. Only the logger and the boot
+ * 			profile still share the mutex, so a sensor task never waits, and
+ * 			a line that does not fit is counted instead of lost on a timeout.
+ *
+ * 			With SENSOR_SAMPLER set, the two sensor tasks are replaced by
+ * 			the sampler task (sampler.h): it wakes on TIM5 every
+ * 			DIGITAL_PERIOD_US, reads the digital sensor each time and the
+ * 			analog sensor every ANALOG_PERIOD_US in the same wakeup, then
+ * 			logs both readings.
+ *
  ******************************************************************************/
 
 /* Includes ------------------------------------------------------------------*/
+#include <stdarg.h>
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
 #include "uart.h"
 #include "exti.h"
 #include "adc.h"
+#include "bootprof.h"
+#include "logring.h"
+#include "sampler.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define MUTEX_CEILING 1		/* 0: priority inheritance, 1: priority ceiling */
+#define LOG_RINGS 1			/* 0: print under the mutex, 1: log into per-task rings */
+#define SENSOR_SAMPLER 1	/* 0: a polling task per sensor, 1: one shared sampler task */
+
+#define DIGITAL_PERIOD_US	1000U	/* Rounded down to SAMPLER_BASE_US << n. */
+#define ANALOG_PERIOD_US	4000U
+
+#define DIGITAL_TASK_PRIORITY	2
+#define ANALOG_TASK_PRIORITY	1
+#define LOGGER_TASK_PRIORITY	1
+#define SAMPLER_TASK_PRIORITY	DIGITAL_TASK_PRIORITY
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
@@ -25,6 +63,14 @@ static void MX_GPIO_Init(void);
 int __io_putchar(int ch);
 void vReadDigitalSensorTask(void *pvParameters);
 void vReadAnalogSensorTask(void *pvParameters);
+static void vSensorPrintf(const char *pcFormat, ...);
+static void vPrintBootProfile(void);
+#if (SENSOR_SAMPLER == 1)
+static uint32_t ulReadDigital(void *pvArg);
+static uint32_t ulReadAnalog(void *pvArg);
+static void vDigitalSink(uint32_t ulValue, uint32_t ulTimeUs, void *pvArg);
+static void vAnalogSink(uint32_t ulValue, uint32_t ulTimeUs, void *pvArg);
+#endif
 
 /* Data types ----------------------------------------------------------------*/
 typedef uint32_t TaskProfiler;
@@ -40,33 +86,69 @@ SemaphoreHandle_t xSerialSemaphore;
  */
 int main(void)
 {
+	bootprof_init();
+
 	HAL_Init();
+	bootprof_mark("HAL_Init");
 
 	/* Configure the system clock */
 	SystemClock_Config();
+	bootprof_mark("clock");
 
 	/* Initialize all configured peripherals */
 	MX_GPIO_Init();
+	bootprof_mark("GPIO");
 	USART2_UART_TX_Init();
+	bootprof_mark("USART2");
 
 	printf("System Initializing...\n\r");
+	bootprof_mark("banner");
 
+#if (MUTEX_CEILING == 1)
+	/* The ceiling is the highest priority of the tasks that print. */
+	xSerialSemaphore = xSemaphoreCreateMutexWithCeiling(DIGITAL_TASK_PRIORITY);
+#else
 	xSerialSemaphore = xSemaphoreCreateMutex();
+#endif
+	bootprof_mark("mutex");
+
+#if (LOG_RINGS == 1)
+	if (logring_start(LOGGER_TASK_PRIORITY) != pdPASS)
+	{
+		Error_Handler();
+	}
+	bootprof_mark("logger");
+#endif
+
+#if (SENSOR_SAMPLER == 1)
+	gpio_init();
+	adc_init();
 
+	if ((sampler_register(DIGITAL_PERIOD_US, ulReadDigital, vDigitalSink, NULL) < 0)
+			|| (sampler_register(ANALOG_PERIOD_US, ulReadAnalog, vAnalogSink, NULL) < 0)
+			|| (sampler_start(SAMPLER_TASK_PRIORITY) != pdPASS))
+	{
+		Error_Handler();
+	}
+	bootprof_mark("sampler");
+#else
 	/* Create tasks. */
 	xTaskCreate(vReadDigitalSensorTask,
 				"vReadDigitalSensorTask",
-				128,
+				256,
 				NULL,
-				2,
+				DIGITAL_TASK_PRIORITY,
 				NULL);
+	bootprof_mark("digital task");
 
 	xTaskCreate(vReadAnalogSensorTask,
 				"vReadAnalogSensorTask",
-				128,
+				256,
 				NULL,
-				1,
+				ANALOG_TASK_PRIORITY,
 				NULL);
+	bootprof_mark("analog task");
+#endif
 
 	vTaskStartScheduler();
 
@@ -91,16 +173,9 @@ void vReadDigitalSensorTask(void *pvParameters)
 	{
 		digital_snsr_state = read_digital_sensor();
 
-		/* Attempt to obtain or "Take" the Serial Semaphore.
-		 * If the semaphore is not available, wait 5 ticks of the scheduler to
-		 * see if it becomes available. */
-		if (xSemaphoreTake(xSerialSemaphore, (TickType_t)5) == pdTRUE)
-		{
-			printf("Digital sensor state: %d\r\n", digital_snsr_state);
+		vPrintBootProfile();
 
-			/* Now free or "Give" the Serial Semaphore. */
-			xSemaphoreGive(xSerialSemaphore);
-		}
+		vSensorPrintf("Digital sensor state: %d\r\n", digital_snsr_state);
 
 		vTaskDelay(1);
 	}
@@ -120,65 +195,154 @@ void vReadAnalogSensorTask(void *pvParameters)
 	{
 		analog_snsr_value = read_analog_sensor();
 
-		/* Attempt to obtain or "Take" the Serial Semaphore.
-		 * If the semaphore is not available, wait 5 ticks of the scheduler to
-		 * see if it becomes available. */
-		if (xSemaphoreTake(xSerialSemaphore, (TickType_t)5) == pdTRUE)
-		{
-			printf("Analog sensor value: %ld\r\n", analog_snsr_value);
-
-			/* Now free or "Give" the Serial Semaphore. */
-			xSemaphoreGive(xSerialSemaphore);
-		}
+		vSensorPrintf("Analog sensor value: %ld\r\n", analog_snsr_value);
 
 		vTaskDelay(1);
 	}
 }
 
+#if (SENSOR_SAMPLER == 1)
 /**
- * @brief System Clock Configuration
+ * @brief Reads the digital sensor, in the sampler task.
+ * @param pvArg Unused.
+ * @retval The sensor state.
+ */
+static uint32_t ulReadDigital(void *pvArg)
+{
+	(void)pvArg;
+
+	return read_digital_sensor();
+}
+
+/**
+ * @brief Reads the analog sensor, in the sampler task.
+ * @param pvArg Unused.
+ * @retval The conversion result.
+ */
+static uint32_t ulReadAnalog(void *pvArg)
+{
+	(void)pvArg;
+
+	return read_analog_sensor();
+}
+
+/**
+ * @brief Publishes and logs a digital reading, in the sampler task.
+ * @param ulValue The sensor state.
+ * @param ulTimeUs Time of the wakeup it was read in.
+ * @param pvArg Unused.
  * @retval None
  */
-void SystemClock_Config(void)
+static void vDigitalSink(uint32_t ulValue, uint32_t ulTimeUs, void *pvArg)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
+	(void)ulTimeUs;
+	(void)pvArg;
+
+	digital_snsr_state = (uint8_t)ulValue;
+
+	vPrintBootProfile();
+
+	vSensorPrintf("Digital sensor state: %d\r\n", digital_snsr_state);
+}
 
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+/**
+ * @brief Publishes and logs an analog reading, in the sampler task.
+ * @param ulValue The conversion result.
+ * @param ulTimeUs Time of the wakeup it was read in.
+ * @param pvArg Unused.
+ * @retval None
+ */
+static void vAnalogSink(uint32_t ulValue, uint32_t ulTimeUs, void *pvArg)
+{
+	(void)ulTimeUs;
+	(void)pvArg;
+
+	analog_snsr_value = ulValue;
+
+	vSensorPrintf("Analog sensor value: %ld\r\n", analog_snsr_value);
+}
+#endif
+
+/**
+ * @brief Prints the boot profile the first time the serial mutex is free.
+ * @param None
+ * @retval None
+ * @note Called by the task that reads the digital sensor. The profile is
+ * printed directly, so it always takes the mutex.
+ */
+static void vPrintBootProfile(void)
+{
+	static BaseType_t xBootProfilePrinted = pdFALSE;
+
+	if ((xBootProfilePrinted == pdFALSE)
+			&& (xSemaphoreTake(xSerialSemaphore, (TickType_t)5) == pdTRUE))
 	{
-		Error_Handler();
+		bootprof_dump();
+		xBootProfilePrinted = pdTRUE;
+		xSemaphoreGive(xSerialSemaphore);
 	}
+}
 
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+/**
+ * @brief Prints a sensor line, into the ring of the calling task or under the
+ * serial mutex.
+ * @param pcFormat printf() format.
+ * @retval None
+ */
+static void vSensorPrintf(const char *pcFormat, ...)
+{
+	va_list xArgs;
+
+	va_start(xArgs, pcFormat);
+
+#if (LOG_RINGS == 1)
+	/* Never blocks; a line that does not fit is counted by the logger. */
+	(void)logring_vprintf(pcFormat, xArgs);
+#else
+	/* Attempt to obtain or "Take" the Serial Semaphore.
+	 * If the semaphore is not available, wait 5 ticks of the scheduler to
+	 * see if it becomes available. */
+	if (xSemaphoreTake(xSerialSemaphore, (TickType_t)5) == pdTRUE)
+	{
+		vprintf(pcFormat, xArgs);
+
+		/* Now free or "Give" the Serial Semaphore. */
+		xSemaphoreGive(xSerialSemaphore);
+	}
+#endif
+
+	va_end(xArgs);
+}
 
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+#if (LOG_RINGS == 1)
+/**
+ * @brief Prints a merged log line under the serial mutex.
+ * @param pcLine The line, NUL-terminated.
+ * @param ulLength Its length.
+ * @retval None
+ * @note Overrides the weak one in logring.c, as the boot profile is still
+ * printed directly. The logger is the lowest priority task here, so it can
+ * wait for the mutex.
+ */
+void logring_output(const char *pcLine, uint32_t ulLength)
+{
+	if (xSemaphoreTake(xSerialSemaphore, portMAX_DELAY) == pdTRUE)
+	{
+		printf("%.*s", (int)ulLength, pcLine);
+		xSemaphoreGive(xSerialSemaphore);
+	}
+}
+#endif
+
+/**
+ * @brief System Clock Configuration
+ * @retval None
+ */
+void SystemClock_Config(void)
+{
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
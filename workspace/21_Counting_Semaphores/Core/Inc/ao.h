@@ -0,0 +1,104 @@
+/*******************************************************************************
+ *
+ * @file	ao.h
+ * @brief	Interface of the run-to-completion active objects.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	An active object is an event handler with its own event queue.
+ * 			It owns no task: all the active objects of one priority share
+ * 			one dispatcher task, and so one stack. The dispatcher calls the
+ * 			handler once per event, and the handler returns when done:
+ *
+ * 				static void vBlinkHandler(Ao_t *pxAo, AoEvent_t xEvent)
+ * 				{
+ * 					if (xEvent.usSignal == SIG_BLINK)
+ * 					{
+ * 						HAL_GPIO_TogglePin(LD2_GPIO_Port, LD2_Pin);
+ * 					}
+ * 				}
+ *
+ * 				ao_init(&xBlinkAo, vBlinkHandler, xBlinkQueue, 2U);
+ * 				ao_start(&xBlinkAo, 1U);
+ * 				ao_time_event_init(&xBlinkTimer, &xBlinkAo, SIG_BLINK);
+ * 				ao_time_event_arm(&xBlinkTimer, 500U, 500U);
+ *
+ * 			Active objects of a higher priority preempt those of a lower one.
+ * 			Within one priority they never preempt each other, so state they
+ * 			share needs no lock. A handler may block, but that holds up every
+ * 			active object of its priority.
+ *
+ ******************************************************************************/
+
+#ifndef AO_H
+#define AO_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef AO_MAX_LEVELS
+#define AO_MAX_LEVELS 4U				/* Distinct priorities in use. */
+#endif
+
+#ifndef AO_STACK_WORDS
+#define AO_STACK_WORDS 256U				/* Per priority, shared by its objects. */
+#endif
+
+#define AO_SIG_INIT 0U					/* First event of every active object. */
+#define AO_SIG_USER 1U					/* First signal free for the application. */
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint16_t usSignal;
+	uint16_t usParam;
+} AoEvent_t;
+
+typedef struct Ao Ao_t;
+typedef struct AoLevel AoLevel_t;
+
+/* Handles one event and returns. */
+typedef void (*AoHandler_t)(Ao_t *pxAo, AoEvent_t xEvent);
+
+/* 20 bytes, and 4 per event of queue storage, instead of a TCB and a stack. */
+struct Ao
+{
+	Ao_t *pxNext;						/* Next one of the same priority. */
+	AoLevel_t *pxLevel;
+	AoHandler_t pxHandler;
+	AoEvent_t *pxQueue;
+	uint8_t ucLength;
+	uint8_t ucHead;
+	uint8_t ucCount;
+	uint8_t ucMaxCount;					/* Deepest the queue has been. */
+};
+
+typedef struct AoTimeEvent AoTimeEvent_t;
+
+struct AoTimeEvent
+{
+	AoTimeEvent_t *pxNext;
+	Ao_t *pxAo;
+	TickType_t xCountdown;				/* 0 while disarmed. */
+	TickType_t xInterval;				/* 0 for a one-shot event. */
+	uint16_t usSignal;
+	uint16_t usLost;					/* Posts that found the queue full. */
+};
+
+/* Function Prototypes -------------------------------------------------------*/
+void ao_init(Ao_t *pxAo, AoHandler_t pxHandler, AoEvent_t *pxQueue, uint8_t ucLength);
+BaseType_t ao_start(Ao_t *pxAo, UBaseType_t uxPriority);
+BaseType_t ao_post(Ao_t *pxAo, uint16_t usSignal, uint16_t usParam);
+BaseType_t ao_post_from_isr(Ao_t *pxAo, uint16_t usSignal, uint16_t usParam,
+		BaseType_t *pxHigherPriorityTaskWoken);
+
+void ao_time_event_init(AoTimeEvent_t *pxTimeEvent, Ao_t *pxAo, uint16_t usSignal);
+void ao_time_event_arm(AoTimeEvent_t *pxTimeEvent, TickType_t xTicks, TickType_t xInterval);
+void ao_time_event_disarm(AoTimeEvent_t *pxTimeEvent);
+
+/* Hooked in main.c: vApplicationTickHook() calls ao_tick(). */
+void ao_tick(void);
+
+#endif /* AO_H */
@@ -0,0 +1,274 @@
+/*******************************************************************************
+ *
+ * @file	pingpong.h
+ * @brief	Lock-free double buffer handed over a whole block at a time.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	The producer fills one buffer while the consumer works on the
+ * 			other. pingpong_swap() publishes the filled buffer and returns
+ * 			the one to fill next, so a block producer (a DMA handler, a
+ * 			sensor task that samples into an array) pays one
+ * 			synchronisation per block instead of one per sample. Nothing is
+ * 			copied and neither side enters a critical section.
+ *
+ * 			'ulState' holds the index of the buffer being filled and the
+ * 			state of the other one: free, ready (swapped in, not yet taken)
+ * 			or busy (held by the consumer). Both sides change it with one
+ * 			LDREX/STREX pair. A swap that finds the other buffer ready
+ * 			still flips, so the consumer gets the newest block and the
+ * 			older one is overwritten. A swap that finds it busy cannot
+ * 			flip, so the block just filled is refilled. Both count as an
+ * 			overrun.
+ *
+ * 			The consumer holds one buffer at a time: pingpong_take() or
+ * 			pingpong_wait(), then pingpong_release() once it is done with
+ * 			it. The wakeup uses the consumer's last notification
+ * 			(PINGPONG_NOTIFY_INDEX), as spsc_ring.h does, so
+ * 			pingpong_swap_from_isr() is reserved for producers at or below
+ * 			configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ *
+ ******************************************************************************/
+
+#ifndef PINGPONG_H
+#define PINGPONG_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef PINGPONG_NOTIFY_INDEX
+#define PINGPONG_NOTIFY_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+#endif
+
+#define PINGPONG_FILL	(1U << 0)	/* Index of the buffer being filled. */
+#define PINGPONG_READY	(1U << 1)	/* The other one is a block not yet taken. */
+#define PINGPONG_BUSY	(1U << 2)	/* The other one is held by the consumer. */
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	volatile uint32_t ulState;			/* PINGPONG_ flags. */
+	void *pvBuffers[2];
+	volatile uint32_t ulOverruns;		/* Producer only. */
+	TaskHandle_t xConsumer;				/* Set by pingpong_wait(). */
+	volatile uint32_t ulConsumerWaiting;	/* Consumer about to block. */
+} PingPong_t;
+
+/* Function definitions ------------------------------------------------------*/
+
+/**
+ * @brief Initializes a double buffer; the producer starts on pvBuffer0.
+ * @param pxPingPong Double buffer to initialize.
+ * @param pvBuffer0 First buffer.
+ * @param pvBuffer1 Second buffer, of the same size.
+ * @retval 0 if successful, -1 otherwise.
+ */
+static inline int32_t pingpong_init(PingPong_t *pxPingPong, void *pvBuffer0, void *pvBuffer1)
+{
+	if ((pxPingPong == NULL) || (pvBuffer0 == NULL) || (pvBuffer1 == NULL))
+	{
+		return -1;
+	}
+
+	pxPingPong->ulState = 0;
+	pxPingPong->pvBuffers[0] = pvBuffer0;
+	pxPingPong->pvBuffers[1] = pvBuffer1;
+	pxPingPong->ulOverruns = 0;
+	pxPingPong->xConsumer = NULL;
+	pxPingPong->ulConsumerWaiting = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Returns the buffer the producer fills (producer side).
+ * @param pxPingPong Double buffer.
+ * @retval The buffer, the one returned by the last swap.
+ */
+static inline void *pingpong_fill_buffer(const PingPong_t *pxPingPong)
+{
+	return pxPingPong->pvBuffers[pxPingPong->ulState & PINGPONG_FILL];
+}
+
+/**
+ * @brief Returns the number of blocks the consumer did not take in time.
+ * @param pxPingPong Double buffer.
+ * @retval Blocks overwritten or refilled since pingpong_init().
+ */
+static inline uint32_t pingpong_get_overruns(const PingPong_t *pxPingPong)
+{
+	return pxPingPong->ulOverruns;
+}
+
+/**
+ * @brief Publishes the filled buffer without waking the consumer (producer
+ * side). Tasks and ISRs of any priority.
+ * @param pxPingPong Double buffer.
+ * @retval The buffer to fill next.
+ */
+static inline void *pingpong_flip(PingPong_t *pxPingPong)
+{
+	uint32_t ulState;
+	uint32_t ulNext;
+
+	/* The block must be visible before the state that publishes it. */
+	__DMB();
+
+	do
+	{
+		ulState = __LDREXW(&pxPingPong->ulState);
+
+		if ((ulState & PINGPONG_BUSY) != 0U)
+		{
+			/* The consumer holds the other buffer; refill this one. */
+			__CLREX();
+			pxPingPong->ulOverruns++;
+			return pxPingPong->pvBuffers[ulState & PINGPONG_FILL];
+		}
+
+		ulNext = (ulState ^ PINGPONG_FILL) | PINGPONG_READY;
+	} while (__STREXW(ulNext, &pxPingPong->ulState) != 0U);
+
+	if ((ulState & PINGPONG_READY) != 0U)
+	{
+		/* The block before was never taken and is refilled next. */
+		pxPingPong->ulOverruns++;
+	}
+
+	return pxPingPong->pvBuffers[ulNext & PINGPONG_FILL];
+}
+
+/**
+ * @brief Publishes the filled buffer and wakes the consumer if it is blocked
+ * in pingpong_wait() (producer task side).
+ * @param pxPingPong Double buffer.
+ * @retval The buffer to fill next.
+ */
+static inline void *pingpong_swap(PingPong_t *pxPingPong)
+{
+	void *pvNext = pingpong_flip(pxPingPong);
+
+	/* The new state must be visible before the flag is read. */
+	__DMB();
+
+	if (pxPingPong->ulConsumerWaiting != 0U)
+	{
+		pxPingPong->ulConsumerWaiting = 0;
+		(void)xTaskNotifyGiveIndexed(pxPingPong->xConsumer, PINGPONG_NOTIFY_INDEX);
+	}
+
+	return pvNext;
+}
+
+/**
+ * @brief Publishes the filled buffer and wakes the consumer if it is blocked
+ * in pingpong_wait() (producer ISR side).
+ * @param pxPingPong Double buffer.
+ * @param pxHigherPriorityTaskWoken Set if the consumer must run on exit.
+ * @retval The buffer to fill next.
+ * @note Only from ISRs at or below configMAX_SYSCALL_INTERRUPT_PRIORITY;
+ * higher ones call pingpong_flip() and leave the consumer to poll.
+ */
+static inline void *pingpong_swap_from_isr(PingPong_t *pxPingPong, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	void *pvNext = pingpong_flip(pxPingPong);
+
+	__DMB();
+
+	if (pxPingPong->ulConsumerWaiting != 0U)
+	{
+		pxPingPong->ulConsumerWaiting = 0;
+		vTaskNotifyGiveIndexedFromISR(pxPingPong->xConsumer, PINGPONG_NOTIFY_INDEX,
+				pxHigherPriorityTaskWoken);
+	}
+
+	return pvNext;
+}
+
+/**
+ * @brief Takes the published block if there is one (consumer side).
+ * @param pxPingPong Double buffer.
+ * @retval The block, or NULL if none was swapped in since the last take. It is
+ * the consumer's until pingpong_release().
+ */
+static inline void *pingpong_take(PingPong_t *pxPingPong)
+{
+	uint32_t ulState;
+
+	do
+	{
+		ulState = __LDREXW(&pxPingPong->ulState);
+
+		if ((ulState & PINGPONG_READY) == 0U)
+		{
+			__CLREX();
+			return NULL;
+		}
+	} while (__STREXW((ulState & ~PINGPONG_READY) | PINGPONG_BUSY, &pxPingPong->ulState) != 0U);
+
+	/* Read the block only after taking it. */
+	__DMB();
+
+	return pxPingPong->pvBuffers[(ulState & PINGPONG_FILL) ^ 1U];
+}
+
+/**
+ * @brief Hands the taken block back to the producer (consumer side).
+ * @param pxPingPong Double buffer.
+ * @retval None
+ * @note The producer does not change the state while the consumer holds a
+ * block, so a plain store is enough.
+ */
+static inline void pingpong_release(PingPong_t *pxPingPong)
+{
+	/* The block must be read before it is handed back. */
+	__DMB();
+	pxPingPong->ulState &= ~PINGPONG_BUSY;
+}
+
+/**
+ * @brief Blocks the calling task until a block is published, and takes it
+ * (consumer side).
+ * @param pxPingPong Double buffer.
+ * @param xTicksToWait Maximum time to wait.
+ * @retval The block, or NULL on timeout. It is the consumer's until
+ * pingpong_release().
+ * @note Uses the calling task's notification count at PINGPONG_NOTIFY_INDEX.
+ * The waiting flag is set before the state is checked again, so a swap in
+ * between is never missed.
+ */
+static inline void *pingpong_wait(PingPong_t *pxPingPong, TickType_t xTicksToWait)
+{
+	TimeOut_t xTimeOut;
+	void *pvBlock;
+
+	vTaskSetTimeOutState(&xTimeOut);
+	pxPingPong->xConsumer = xTaskGetCurrentTaskHandle();
+
+	while ((pvBlock = pingpong_take(pxPingPong)) == NULL)
+	{
+		pxPingPong->ulConsumerWaiting = 1;
+		__DMB();
+
+		if ((pvBlock = pingpong_take(pxPingPong)) != NULL)
+		{
+			break;
+		}
+
+		if (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE)
+		{
+			break;
+		}
+
+		(void)ulTaskNotifyTakeIndexed(PINGPONG_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+	}
+
+	pxPingPong->ulConsumerWaiting = 0;
+
+	return pvBlock;
+}
+
+#endif /* PINGPONG_H */
@@ -0,0 +1,367 @@
+/*******************************************************************************
+ *
+ * @file	ao.c
+ * @brief	Run-to-completion active objects dispatched on shared stacks.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Hooked in from main.c: vApplicationTickHook() calls ao_tick().
+ *
+ * 			ao_start() creates one dispatcher task per priority in use, the
+ * 			first time an active object of that priority starts. Posting an
+ * 			event puts it in the object's queue and gives the dispatcher's
+ * 			task notification. The dispatcher then serves the objects of its
+ * 			priority one event at a time, in the order they were started,
+ * 			until every queue is empty, and blocks again.
+ *
+ * 			Time events replace vTaskDelay(): the tick hook counts them down
+ * 			and posts their signal when they expire, so a waiting object is
+ * 			one queue slot waiting for an event rather than a blocked task.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "ao.h"
+
+/* Data types ----------------------------------------------------------------*/
+struct AoLevel
+{
+	TaskHandle_t xTask;					/* Dispatcher, NULL while unused. */
+	Ao_t *pxHead;
+	UBaseType_t uxPriority;
+	char cName[8];						/* Kept: a lean TCB does not copy it. */
+};
+
+/* Variables -----------------------------------------------------------------*/
+static AoLevel_t xLevels[AO_MAX_LEVELS];
+static AoTimeEvent_t *pxTimeEvents = NULL;	/* Walked by the tick hook. */
+
+/* Private function prototypes -----------------------------------------------*/
+static AoLevel_t *ao_get_level(UBaseType_t uxPriority);
+static BaseType_t ao_put(Ao_t *pxAo, AoEvent_t xEvent);
+static BaseType_t ao_get(Ao_t *pxAo, AoEvent_t *pxEvent);
+static void ao_dispatcher_task(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Sets up an active object, not dispatched until ao_start().
+ * @param pxAo Storage of the active object. Must stay valid for good.
+ * @param pxHandler Event handler.
+ * @param pxQueue Storage for the events waiting to be handled.
+ * @param ucLength Number of events pxQueue holds, at least 1.
+ * @retval None
+ */
+void ao_init(Ao_t *pxAo, AoHandler_t pxHandler, AoEvent_t *pxQueue, uint8_t ucLength)
+{
+	configASSERT((pxHandler != NULL) && (pxQueue != NULL) && (ucLength > 0U));
+
+	pxAo->pxNext = NULL;
+	pxAo->pxLevel = NULL;
+	pxAo->pxHandler = pxHandler;
+	pxAo->pxQueue = pxQueue;
+	pxAo->ucLength = ucLength;
+	pxAo->ucHead = 0U;
+	pxAo->ucCount = 0U;
+	pxAo->ucMaxCount = 0U;
+}
+
+/**
+ * @brief Starts dispatching an active object, beginning with AO_SIG_INIT.
+ * @param pxAo Active object.
+ * @param uxPriority Priority of the task that dispatches it.
+ * @retval pdPASS, or pdFAIL if AO_MAX_LEVELS priorities are in use already or
+ * the dispatcher could not be created.
+ * @note Call from main() or from one task at a time.
+ */
+BaseType_t ao_start(Ao_t *pxAo, UBaseType_t uxPriority)
+{
+	AoLevel_t *pxLevel = ao_get_level(uxPriority);
+	Ao_t **ppxLast;
+
+	if (pxLevel == NULL)
+	{
+		return pdFAIL;
+	}
+
+	pxAo->pxLevel = pxLevel;
+
+	/* AO_SIG_INIT goes ahead of any event posted before the start. */
+	taskENTER_CRITICAL();
+	pxAo->ucHead = (uint8_t)((pxAo->ucHead + pxAo->ucLength - 1U) % pxAo->ucLength);
+	pxAo->pxQueue[pxAo->ucHead].usSignal = AO_SIG_INIT;
+	pxAo->pxQueue[pxAo->ucHead].usParam = 0U;
+
+	if (pxAo->ucCount < pxAo->ucLength)
+	{
+		pxAo->ucCount++;
+	}
+
+	for (ppxLast = &pxLevel->pxHead; *ppxLast != NULL; ppxLast = &(*ppxLast)->pxNext)
+	{
+		/* Walk to the end: objects are served in the order they started. */
+	}
+
+	*ppxLast = pxAo;
+	taskEXIT_CRITICAL();
+
+	xTaskNotifyGive(pxLevel->xTask);
+
+	return pdPASS;
+}
+
+/**
+ * @brief Posts an event to an active object, from a task.
+ * @param pxAo Active object.
+ * @param usSignal Event signal, AO_SIG_USER or above.
+ * @param usParam Event parameter.
+ * @retval pdPASS, or pdFAIL if the queue is full.
+ */
+BaseType_t ao_post(Ao_t *pxAo, uint16_t usSignal, uint16_t usParam)
+{
+	const AoEvent_t xEvent = { usSignal, usParam };
+	BaseType_t xReturn;
+
+	taskENTER_CRITICAL();
+	xReturn = ao_put(pxAo, xEvent);
+	taskEXIT_CRITICAL();
+
+	if ((xReturn != pdFAIL) && (pxAo->pxLevel != NULL))
+	{
+		xTaskNotifyGive(pxAo->pxLevel->xTask);
+	}
+
+	return xReturn;
+}
+
+/**
+ * @brief Posts an event to an active object, from an interrupt.
+ * @param pxAo Active object.
+ * @param usSignal Event signal, AO_SIG_USER or above.
+ * @param usParam Event parameter.
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a context switch is due,
+ * or NULL to have the kernel switch at the end of the interrupt.
+ * @retval pdPASS, or pdFAIL if the queue is full.
+ */
+BaseType_t ao_post_from_isr(Ao_t *pxAo, uint16_t usSignal, uint16_t usParam,
+		BaseType_t *pxHigherPriorityTaskWoken)
+{
+	const AoEvent_t xEvent = { usSignal, usParam };
+	UBaseType_t uxSavedInterruptStatus;
+	BaseType_t xReturn;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	xReturn = ao_put(pxAo, xEvent);
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	if ((xReturn != pdFAIL) && (pxAo->pxLevel != NULL))
+	{
+		vTaskNotifyGiveFromISR(pxAo->pxLevel->xTask, pxHigherPriorityTaskWoken);
+	}
+
+	return xReturn;
+}
+
+/**
+ * @brief Sets up a time event, disarmed.
+ * @param pxTimeEvent Storage of the time event. Must stay valid for good.
+ * @param pxAo Active object the signal is posted to.
+ * @param usSignal Signal posted on expiry.
+ * @retval None
+ */
+void ao_time_event_init(AoTimeEvent_t *pxTimeEvent, Ao_t *pxAo, uint16_t usSignal)
+{
+	pxTimeEvent->pxAo = pxAo;
+	pxTimeEvent->xCountdown = 0U;
+	pxTimeEvent->xInterval = 0U;
+	pxTimeEvent->usSignal = usSignal;
+	pxTimeEvent->usLost = 0U;
+
+	taskENTER_CRITICAL();
+	pxTimeEvent->pxNext = pxTimeEvents;
+	pxTimeEvents = pxTimeEvent;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Arms a time event.
+ * @param pxTimeEvent Time event.
+ * @param xTicks Ticks to the first expiry, at least 1.
+ * @param xInterval Ticks between later expiries, or 0 for a one-shot event.
+ * @retval None
+ */
+void ao_time_event_arm(AoTimeEvent_t *pxTimeEvent, TickType_t xTicks, TickType_t xInterval)
+{
+	configASSERT(xTicks > 0U);
+
+	taskENTER_CRITICAL();
+	pxTimeEvent->xCountdown = xTicks;
+	pxTimeEvent->xInterval = xInterval;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Disarms a time event. An expiry already posted is still handled.
+ * @param pxTimeEvent Time event.
+ * @retval None
+ */
+void ao_time_event_disarm(AoTimeEvent_t *pxTimeEvent)
+{
+	taskENTER_CRITICAL();
+	pxTimeEvent->xCountdown = 0U;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Counts the armed time events down (vApplicationTickHook).
+ * @param None
+ * @retval None
+ */
+void ao_tick(void)
+{
+	AoTimeEvent_t *pxTimeEvent;
+
+	for (pxTimeEvent = pxTimeEvents; pxTimeEvent != NULL; pxTimeEvent = pxTimeEvent->pxNext)
+	{
+		if ((pxTimeEvent->xCountdown == 0U) || (--pxTimeEvent->xCountdown != 0U))
+		{
+			continue;
+		}
+
+		pxTimeEvent->xCountdown = pxTimeEvent->xInterval;
+
+		/* The tick interrupt switches context on its way out if need be. */
+		if (ao_post_from_isr(pxTimeEvent->pxAo, pxTimeEvent->usSignal, 0U, NULL) == pdFAIL)
+		{
+			pxTimeEvent->usLost++;
+		}
+	}
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Finds the level of a priority, creating its dispatcher if need be.
+ * @param uxPriority Priority.
+ * @retval The level, or NULL if none is left or the dispatcher could not be
+ * created.
+ */
+static AoLevel_t *ao_get_level(UBaseType_t uxPriority)
+{
+	AoLevel_t *pxFree = NULL;
+	uint32_t i;
+
+	for (i = 0U; i < AO_MAX_LEVELS; i++)
+	{
+		if (xLevels[i].xTask == NULL)
+		{
+			if (pxFree == NULL)
+			{
+				pxFree = &xLevels[i];
+			}
+		}
+		else if (xLevels[i].uxPriority == uxPriority)
+		{
+			return &xLevels[i];
+		}
+	}
+
+	if (pxFree == NULL)
+	{
+		return NULL;
+	}
+
+	pxFree->pxHead = NULL;
+	pxFree->uxPriority = uxPriority;
+	(void)snprintf(pxFree->cName, sizeof(pxFree->cName), "AO %u", (unsigned)uxPriority);
+
+	if (xTaskCreate(ao_dispatcher_task, pxFree->cName, AO_STACK_WORDS, pxFree, uxPriority,
+			&pxFree->xTask) != pdPASS)
+	{
+		pxFree->xTask = NULL;
+		return NULL;
+	}
+
+	return pxFree;
+}
+
+/**
+ * @brief Queues an event. Called in a critical section.
+ * @param pxAo Active object.
+ * @param xEvent Event.
+ * @retval pdPASS, or pdFAIL if the queue is full.
+ */
+static BaseType_t ao_put(Ao_t *pxAo, AoEvent_t xEvent)
+{
+	if (pxAo->ucCount >= pxAo->ucLength)
+	{
+		return pdFAIL;
+	}
+
+	pxAo->pxQueue[(pxAo->ucHead + pxAo->ucCount) % pxAo->ucLength] = xEvent;
+	pxAo->ucCount++;
+
+	if (pxAo->ucCount > pxAo->ucMaxCount)
+	{
+		pxAo->ucMaxCount = pxAo->ucCount;
+	}
+
+	return pdPASS;
+}
+
+/**
+ * @brief Takes the oldest event of an active object.
+ * @param pxAo Active object.
+ * @param pxEvent Where the event is written.
+ * @retval pdTRUE if there was one, pdFALSE otherwise.
+ */
+static BaseType_t ao_get(Ao_t *pxAo, AoEvent_t *pxEvent)
+{
+	BaseType_t xReturn = pdFALSE;
+
+	taskENTER_CRITICAL();
+
+	if (pxAo->ucCount > 0U)
+	{
+		*pxEvent = pxAo->pxQueue[pxAo->ucHead];
+		pxAo->ucHead = (uint8_t)((pxAo->ucHead + 1U) % pxAo->ucLength);
+		pxAo->ucCount--;
+		xReturn = pdTRUE;
+	}
+
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+
+/**
+ * @brief Runs the handlers of one priority to completion, one event at a time.
+ * @param pvParameters Level served.
+ * @retval None
+ */
+static void ao_dispatcher_task(void *pvParameters)
+{
+	const AoLevel_t *pxLevel = (const AoLevel_t *)pvParameters;
+	Ao_t *pxAo;
+	AoEvent_t xEvent;
+	BaseType_t xDispatched;
+
+	while (1)
+	{
+		(void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+		do
+		{
+			xDispatched = pdFALSE;
+
+			for (pxAo = pxLevel->pxHead; pxAo != NULL; pxAo = pxAo->pxNext)
+			{
+				if (ao_get(pxAo, &xEvent) != pdFALSE)
+				{
+					pxAo->pxHandler(pxAo, xEvent);
+					xDispatched = pdTRUE;
+				}
+			}
+		} while (xDispatched != pdFALSE);
+	}
+}
@@ -8,32 +8,141 @@
  * @date	Mar 28, 2026
  * @note	'semphr.h' must be included inside the 'cmsis_os.h' to use
  * 			semaphores.
+ * 			With ACTIVE_OBJECTS set, the sensors are active objects (ao.h)
+ * 			driven by time events instead of tasks looping on vTaskDelay().
+ * 			With ANALOG_BLOCKS set, the analog samples go into a ping-pong
+ * 			double buffer (pingpong.h) and vAnalogBlockTask prints one
+ * 			summary per block, so the hand-over costs one swap per
+ * 			ANALOG_BLOCK_SIZE samples instead of a print per sample.
+ * 			With ANALOG_COMPRESS set as well, every sample of the block is
+ * 			sent instead of the summary: delta and zig-zag varint coded
+ * 			(sencomp.h), in base64 lines of the same log, at about 1.4
+ * 			bytes per sample instead of 27 for the line of text.
+ * 			With ANALOG_WATCH set, the analog sensor is no longer read every
+ * 			tick: the ADC samples it round a DMA ring (adc_ring_init()) and
+ * 			its analog watchdog (adc_watch_init()) wakes vAnalogWatchTask
+ * 			only when the value leaves or comes back into the window, so
+ * 			the task runs for none of the samples in between. ANALOG_BLOCKS
+ * 			needs every sample and is ignored then.
+ * 			With LOG_RINGS set, the sensors no longer take the semaphore:
+ * 			each task logs into a ring of its own (logring.h) and the logger
+ * 			task prints the lines in time order, so a sensor never waits,
+ * 			and a line that does not fit is counted instead of lost on a
+ * 			timeout.
  *
  ******************************************************************************/
 
 /* Includes ------------------------------------------------------------------*/
+#include <stdarg.h>
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
 #include "uart.h"
 #include "exti.h"
 #include "adc.h"
+#include "ao.h"
+#include "pingpong.h"
+#include "logring.h"
+#include "sencomp.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define ACTIVE_OBJECTS 1	/* 0: one task per sensor, 1: active objects */
+#define ANALOG_BLOCKS 1		/* 0: print every analog sample, 1: one summary per block */
+#define ANALOG_COMPRESS 1	/* 0: the block summary, 1: the whole block, compressed */
+#define ANALOG_COMPRESS_MODE SENCOMP_DELTA	/* SENCOMP_DELTA_LZ for repetitive signals */
+
+#define ANALOG_WATCH 1		/* 0: read the analog sensor every tick, 1: wake on a change of zone only */
+
+#define LOG_RINGS 1			/* 0: print under the semaphore, 1: log into per-task rings */
+#define LOGGER_TASK_PRIORITY 1
+
+/* The watchdog replaces the periodic sampling, and with it the blocks. */
+#if (ANALOG_WATCH == 1)
+#undef ANALOG_BLOCKS
+#define ANALOG_BLOCKS 0
+#endif
+
+#define ANALOG_BLOCK_SIZE 100U	/* Samples per block, one block every 100 ms. */
+#define ANALOG_LINE_BYTES 45U	/* Compressed bytes per line, 60 in base64. */
+
+#define ANALOG_WATCH_RATE_HZ	1000U	/* Conversions per second, as often as before. */
+#define ANALOG_WATCH_RING		16U		/* Samples kept by the DMA. */
+#define ANALOG_WATCH_LOW		1000U	/* Window of normal readings. */
+#define ANALOG_WATCH_HIGH		3000U
+#define ANALOG_WATCH_HYSTERESIS	100U	/* Margin to clear before coming back inside. */
+
+#define SENSOR_QUEUE_LENGTH 2U
+#define SENSOR_PERIOD_TICKS 1U
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 int __io_putchar(int ch);
+#if (ACTIVE_OBJECTS == 1)
+static void vDigitalSensorHandler(Ao_t *pxAo, AoEvent_t xEvent);
+#if (ANALOG_WATCH == 0)
+static void vAnalogSensorHandler(Ao_t *pxAo, AoEvent_t xEvent);
+#endif
+#else
 void vReadDigitalSensorTask(void *pvParameters);
+#if (ANALOG_WATCH == 0)
 void vReadAnalogSensorTask(void *pvParameters);
+#endif
+#endif
+#if (ANALOG_WATCH == 1)
+void vAnalogWatchTask(void *pvParameters);
+#endif
+static void vSensorPrintf(const char *pcFormat, ...);
+#if (ANALOG_BLOCKS == 1)
+static void vAnalogSamplePut(uint32_t ulValue);
+void vAnalogBlockTask(void *pvParameters);
+#if (ANALOG_COMPRESS == 1)
+static void vBase64Encode(const uint8_t *pucIn, uint32_t ulLen, char *pcOut);
+#endif
+#endif
 
 /* Data types ----------------------------------------------------------------*/
 typedef uint32_t TaskProfiler;
 
+#if (ACTIVE_OBJECTS == 1)
+enum
+{
+	SIG_SAMPLE = AO_SIG_USER			/* Time to read the sensor. */
+};
+#endif
+
 /* Variables -----------------------------------------------------------------*/
 uint8_t digital_snsr_state;
 uint32_t analog_snsr_value;
 SemaphoreHandle_t xSerialSemaphore;
 
+#if (ACTIVE_OBJECTS == 1)
+static Ao_t xDigitalSensorAo;
+static AoEvent_t xDigitalSensorQueue[SENSOR_QUEUE_LENGTH];
+static AoTimeEvent_t xDigitalSensorTimer;
+#if (ANALOG_WATCH == 0)
+static Ao_t xAnalogSensorAo;
+static AoEvent_t xAnalogSensorQueue[SENSOR_QUEUE_LENGTH];
+static AoTimeEvent_t xAnalogSensorTimer;
+#endif
+#endif
+
+#if (ANALOG_WATCH == 1)
+static uint16_t usAnalogRing[ANALOG_WATCH_RING];
+#endif
+
+#if (ANALOG_BLOCKS == 1)
+static uint16_t usAnalogBlocks[2][ANALOG_BLOCK_SIZE];
+static PingPong_t xAnalogPingPong;
+static uint16_t *pusAnalogFill;			/* Buffer of the analog sensor. */
+static uint32_t ulAnalogFillCount;
+#if (ANALOG_COMPRESS == 1)
+static SenComp_t xAnalogComp;
+static uint8_t ucAnalogPacked[SENCOMP_MAX_ENCODED(ANALOG_BLOCK_SIZE)];
+#endif
+#endif
+
 /**
  * @brief The application entry point.
  * @retval int
@@ -53,20 +162,71 @@ int main(void)
 
 	xSerialSemaphore = xSemaphoreCreateCounting(1, 0); /* Total, initial */
 
+#if (LOG_RINGS == 1)
+	if (logring_start(LOGGER_TASK_PRIORITY) != pdPASS)
+	{
+		Error_Handler();
+	}
+#endif
+
+#if (ANALOG_BLOCKS == 1)
+	/* The analog sensor fills one block while this task prints the other. */
+	if ((pingpong_init(&xAnalogPingPong, usAnalogBlocks[0], usAnalogBlocks[1]) != 0)
+			|| (xTaskCreate(vAnalogBlockTask, "vAnalogBlockTask", 256, NULL, 1, NULL) != pdPASS))
+	{
+		Error_Handler();
+	}
+
+	pusAnalogFill = pingpong_fill_buffer(&xAnalogPingPong);
+#endif
+
+#if (ACTIVE_OBJECTS == 1)
+	/* One dispatcher per priority; the sensors keep priorities 2 and 1. */
+	ao_init(&xDigitalSensorAo, vDigitalSensorHandler, xDigitalSensorQueue, SENSOR_QUEUE_LENGTH);
+
+	if (ao_start(&xDigitalSensorAo, 2) != pdPASS)
+	{
+		Error_Handler();
+	}
+
+	ao_time_event_init(&xDigitalSensorTimer, &xDigitalSensorAo, SIG_SAMPLE);
+	ao_time_event_arm(&xDigitalSensorTimer, SENSOR_PERIOD_TICKS, SENSOR_PERIOD_TICKS);
+#if (ANALOG_WATCH == 0)
+	ao_init(&xAnalogSensorAo, vAnalogSensorHandler, xAnalogSensorQueue, SENSOR_QUEUE_LENGTH);
+
+	if (ao_start(&xAnalogSensorAo, 1) != pdPASS)
+	{
+		Error_Handler();
+	}
+
+	ao_time_event_init(&xAnalogSensorTimer, &xAnalogSensorAo, SIG_SAMPLE);
+	ao_time_event_arm(&xAnalogSensorTimer, SENSOR_PERIOD_TICKS, SENSOR_PERIOD_TICKS);
+#endif
+#else
 	/* Create tasks. */
 	xTaskCreate(vReadDigitalSensorTask,
 				"vReadDigitalSensorTask",
-				128,
+				256,
 				NULL,
 				2,
 				NULL);
 
+#if (ANALOG_WATCH == 0)
 	xTaskCreate(vReadAnalogSensorTask,
 				"vReadAnalogSensorTask",
-				128,
+				256,
 				NULL,
 				1,
 				NULL);
+#endif
+#endif
+
+#if (ANALOG_WATCH == 1)
+	if (xTaskCreate(vAnalogWatchTask, "vAnalogWatchTask", 256, NULL, 1, NULL) != pdPASS)
+	{
+		Error_Handler();
+	}
+#endif
 
 	/* Note: Since we set the initial count to 0, we need to give a semaphore
 	 * first to make it available to a task. If you didn't want this approach,
@@ -82,6 +242,77 @@ int main(void)
 	}
 }
 
+/**
+ * @brief Counts down the active object time events.
+ * @param None
+ * @retval None
+ */
+void vApplicationTickHook(void)
+{
+#if (ACTIVE_OBJECTS == 1)
+	ao_tick();
+#endif
+}
+
+#if (ACTIVE_OBJECTS == 1)
+/**
+ * @brief Reads and prints the digital sensor on each SIG_SAMPLE.
+ * @param pxAo Digital sensor active object.
+ * @param xEvent Event to handle.
+ * @retval None
+ */
+static void vDigitalSensorHandler(Ao_t *pxAo, AoEvent_t xEvent)
+{
+	switch (xEvent.usSignal)
+	{
+	case AO_SIG_INIT:
+		gpio_init();
+		break;
+
+	case SIG_SAMPLE:
+		digital_snsr_state = read_digital_sensor();
+
+		/* The analog sensor runs at another priority, so the UART is still
+		 * shared. */
+		vSensorPrintf("Digital sensor state: %d\r\n", digital_snsr_state);
+		break;
+
+	default:
+		break;
+	}
+}
+
+#if (ANALOG_WATCH == 0)
+/**
+ * @brief Reads and prints the analog sensor on each SIG_SAMPLE.
+ * @param pxAo Analog sensor active object.
+ * @param xEvent Event to handle.
+ * @retval None
+ */
+static void vAnalogSensorHandler(Ao_t *pxAo, AoEvent_t xEvent)
+{
+	switch (xEvent.usSignal)
+	{
+	case AO_SIG_INIT:
+		adc_init();
+		break;
+
+	case SIG_SAMPLE:
+		analog_snsr_value = read_analog_sensor();
+
+#if (ANALOG_BLOCKS == 1)
+		vAnalogSamplePut(analog_snsr_value);
+#else
+		vSensorPrintf("Analog sensor value: %ld\r\n", analog_snsr_value);
+#endif
+		break;
+
+	default:
+		break;
+	}
+}
+#endif
+#else
 /**
  * @brief Reads digital sensor data.
  * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
@@ -96,21 +327,13 @@ void vReadDigitalSensorTask(void *pvParameters)
 	{
 		digital_snsr_state = read_digital_sensor();
 
-		/* Attempt to obtain or "Take" the Serial Semaphore.
-		 * If the semaphore is not available, wait 5 ticks of the scheduler to
-		 * see if it becomes available. */
-		if (xSemaphoreTake(xSerialSemaphore, (TickType_t)5) == pdTRUE)
-		{
-			printf("Digital sensor state: %d\r\n", digital_snsr_state);
-
-			/* Now free or "Give" the Serial Semaphore. */
-			xSemaphoreGive(xSerialSemaphore);
-		}
+		vSensorPrintf("Digital sensor state: %d\r\n", digital_snsr_state);
 
 		vTaskDelay(1);
 	}
 }
 
+#if (ANALOG_WATCH == 0)
 /**
  * @brief Reads analog sensor data.
  * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
@@ -125,65 +348,235 @@ void vReadAnalogSensorTask(void *pvParameters)
 	{
 		analog_snsr_value = read_analog_sensor();
 
-		/* Attempt to obtain or "Take" the Serial Semaphore.
-		 * If the semaphore is not available, wait 5 ticks of the scheduler to
-		 * see if it becomes available. */
-		if (xSemaphoreTake(xSerialSemaphore, (TickType_t)5) == pdTRUE)
+#if (ANALOG_BLOCKS == 1)
+		vAnalogSamplePut(analog_snsr_value);
+#else
+		vSensorPrintf("Analog sensor value: %ld\r\n", analog_snsr_value);
+#endif
+
+		vTaskDelay(1);
+	}
+}
+#endif
+#endif
+
+#if (ANALOG_WATCH == 1)
+/**
+ * @brief Prints the analog sensor each time it leaves or comes back into the
+ * window of normal readings.
+ * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
+ * task function signature.
+ * @return None.
+ * @note The sensor is sampled at ANALOG_WATCH_RATE_HZ by the ADC and the DMA
+ * alone; this task is only woken by the analog watchdog interrupt.
+ */
+void vAnalogWatchTask(void *pvParameters)
+{
+	static const char * const pcZones[] = { "inside", "above", "below" };
+	const AdcWatchConfig_t xConfig =
+	{
+		.ucChannel = 1U,							/* PA1 */
+		.usLow = ANALOG_WATCH_LOW,
+		.usHigh = ANALOG_WATCH_HIGH,
+		.usHysteresis = ANALOG_WATCH_HYSTERESIS,
+		.xTask = xTaskGetCurrentTaskHandle()
+	};
+	uint16_t usValue;
+	int32_t lZone;
+
+	if ((adc_watch_init(&xConfig) != 0)
+			|| (adc_ring_init(ANALOG_WATCH_RATE_HZ, usAnalogRing, ANALOG_WATCH_RING) != 0)
+			|| (adc_ring_start() != 0))
+	{
+		Error_Handler();
+	}
+
+	while (1)
+	{
+		lZone = adc_watch_wait(&usValue, portMAX_DELAY);
+
+		if (lZone < 0)
 		{
-			printf("Analog sensor value: %ld\r\n", analog_snsr_value);
+			continue;
+		}
+
+		analog_snsr_value = usValue;
+
+		vSensorPrintf("Analog sensor %s the window: %lu (changes %lu)\r\n",
+				pcZones[lZone], analog_snsr_value, adc_watch_get_events());
+	}
+}
+#endif
+
+#if (ANALOG_BLOCKS == 1)
+/**
+ * @brief Appends an analog sample to the block being filled, and swaps the
+ * block in once it is full.
+ * @param ulValue Sample to append.
+ * @retval None
+ */
+static void vAnalogSamplePut(uint32_t ulValue)
+{
+	pusAnalogFill[ulAnalogFillCount++] = (uint16_t)ulValue;
 
-			/* Now free or "Give" the Serial Semaphore. */
-			xSemaphoreGive(xSerialSemaphore);
+	if (ulAnalogFillCount == ANALOG_BLOCK_SIZE)
+	{
+		pusAnalogFill = pingpong_swap(&xAnalogPingPong);
+		ulAnalogFillCount = 0;
+	}
+}
+
+#if (ANALOG_COMPRESS == 1)
+/**
+ * @brief Sends each block of analog samples compressed, as lines of
+ * "Analog block <block>+<offset>: <base64>".
+ * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
+ * task function signature.
+ * @return None.
+ * @note The receiver joins the lines of a block by their offsets and hands the
+ * bytes to sencomp_decode(). A block with a line missing is lost alone, as each
+ * block decodes on its own.
+ */
+void vAnalogBlockTask(void *pvParameters)
+{
+	const uint16_t *pusBlock;
+	char cLine[((ANALOG_LINE_BYTES + 2U) / 3U) * 4U + 1U];
+	uint32_t ulBlock = 0;
+	uint32_t ulOffset;
+	uint32_t ulChunk;
+	int32_t lPacked;
+
+	while (1)
+	{
+		pusBlock = pingpong_wait(&xAnalogPingPong, portMAX_DELAY);
+
+		lPacked = sencomp_encode(&xAnalogComp, ANALOG_COMPRESS_MODE, pusBlock, ANALOG_BLOCK_SIZE,
+				1U, ucAnalogPacked, sizeof(ucAnalogPacked));
+
+		/* The packed copy is all that is needed from the block. */
+		pingpong_release(&xAnalogPingPong);
+
+		for (ulOffset = 0; (lPacked > 0) && (ulOffset < (uint32_t)lPacked); ulOffset += ulChunk)
+		{
+			ulChunk = (uint32_t)lPacked - ulOffset;
+			ulChunk = (ulChunk < ANALOG_LINE_BYTES) ? ulChunk : ANALOG_LINE_BYTES;
+			vBase64Encode(&ucAnalogPacked[ulOffset], ulChunk, cLine);
+			vSensorPrintf("Analog block %lu+%lu: %s\r\n", ulBlock, ulOffset, cLine);
 		}
 
-		vTaskDelay(1);
+		ulBlock++;
 	}
 }
 
 /**
- * @brief System Clock Configuration
+ * @brief Encodes bytes in base64, with padding.
+ * @param pucIn Bytes.
+ * @param ulLen Number of bytes.
+ * @param pcOut Output, 4 characters per 3 bytes or part of them, and a NUL.
  * @retval None
  */
-void SystemClock_Config(void)
+static void vBase64Encode(const uint8_t *pucIn, uint32_t ulLen, char *pcOut)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
+	static const char cDigits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	uint32_t ulBits;
+	uint32_t i;
 
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+	for (i = 0; i < ulLen; i += 3U)
 	{
-		Error_Handler();
+		ulBits = (uint32_t)pucIn[i] << 16;
+		ulBits |= ((i + 1U) < ulLen) ? ((uint32_t)pucIn[i + 1U] << 8) : 0U;
+		ulBits |= ((i + 2U) < ulLen) ? pucIn[i + 2U] : 0U;
+
+		*pcOut++ = cDigits[(ulBits >> 18) & 0x3FU];
+		*pcOut++ = cDigits[(ulBits >> 12) & 0x3FU];
+		*pcOut++ = ((i + 1U) < ulLen) ? cDigits[(ulBits >> 6) & 0x3FU] : '=';
+		*pcOut++ = ((i + 2U) < ulLen) ? cDigits[ulBits & 0x3FU] : '=';
+	}
+
+	*pcOut = '\0';
+}
+#else
+/**
+ * @brief Prints the minimum, maximum and mean of each block of analog samples.
+ * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
+ * task function signature.
+ * @return None.
+ */
+void vAnalogBlockTask(void *pvParameters)
+{
+	const uint16_t *pusBlock;
+	uint32_t ulMin;
+	uint32_t ulMax;
+	uint32_t ulSum;
+	uint32_t i;
+
+	while (1)
+	{
+		/* One wakeup per block; the sensor fills the other one meanwhile. */
+		pusBlock = pingpong_wait(&xAnalogPingPong, portMAX_DELAY);
+
+		ulMin = UINT32_MAX;
+		ulMax = 0;
+		ulSum = 0;
+
+		for (i = 0; i < ANALOG_BLOCK_SIZE; i++)
+		{
+			ulMin = (pusBlock[i] < ulMin) ? pusBlock[i] : ulMin;
+			ulMax = (pusBlock[i] > ulMax) ? pusBlock[i] : ulMax;
+			ulSum += pusBlock[i];
+		}
+
+		/* The summary is all that is needed from the block. */
+		pingpong_release(&xAnalogPingPong);
+
+		vSensorPrintf("Analog sensor block: min %lu, max %lu, mean %lu, overruns %lu\r\n",
+				ulMin, ulMax, ulSum / ANALOG_BLOCK_SIZE,
+				pingpong_get_overruns(&xAnalogPingPong));
 	}
+}
+#endif /* ANALOG_COMPRESS */
+#endif
 
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+/**
+ * @brief Prints a sensor line, into the ring of the calling task or under the
+ * serial semaphore.
+ * @param pcFormat printf() format.
+ * @retval None
+ */
+static void vSensorPrintf(const char *pcFormat, ...)
+{
+	va_list xArgs;
+
+	va_start(xArgs, pcFormat);
+
+#if (LOG_RINGS == 1)
+	/* Never blocks; a line that does not fit is counted by the logger. */
+	(void)logring_vprintf(pcFormat, xArgs);
+#else
+	/* Attempt to obtain or "Take" the Serial Semaphore.
+	 * If the semaphore is not available, wait 5 ticks of the scheduler to
+	 * see if it becomes available. */
+	if (xSemaphoreTake(xSerialSemaphore, (TickType_t)5) == pdTRUE)
+	{
+		vprintf(pcFormat, xArgs);
 
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+		/* Now free or "Give" the Serial Semaphore. */
+		xSemaphoreGive(xSerialSemaphore);
+	}
+#endif
+
+	va_end(xArgs);
+}
+
+/**
+ * @brief System Clock Configuration
+ * @retval None
+ */
+void SystemClock_Config(void)
+{
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
@@ -0,0 +1,477 @@
+/*******************************************************************************
+ *
+ * @file	sencomp.c
+ * @brief	Lossless compression of blocks of sensor samples.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	Sensor samples change little from one to the next, so a block is
+ * 			sent as the differences instead of the values:
+ * 			- Each sample minus the previous one of its channel (the first
+ * 			  against 0, so every block decodes on its own).
+ * 			- Zig-zag mapped, 0, -1, 1, -2, ... to 0, 1, 2, 3, ..., so small
+ * 			  differences of either sign are small numbers.
+ * 			- As varints, 7 bits a byte, LSB first, the top bit set on every
+ * 			  byte but the last: a difference within +/-63 takes one byte, a
+ * 			  12-bit sample two bytes at most.
+ *
+ * 			SENCOMP_DELTA_LZ then packs the varints in the LZ4 block format,
+ * 			for signals that repeat (a stuck sensor, a periodic waveform).
+ * 			The matcher is greedy, one hash table lookup per position, so the
+ * 			encoder needs no memory but SenComp_t: under 2 KB with the
+ * 			defaults. A block LZ does not shrink is sent as SENCOMP_DELTA.
+ *
+ * 			An encoded block is the 4-byte header, then the varints or the
+ * 			LZ4 block. It never exceeds SENCOMP_MAX_ENCODED() of the samples.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "sencomp.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define SENCOMP_LZ_MIN_MATCH	4U		/* LZ4: shorter matches are literals, */
+#define SENCOMP_LZ_LAST_LITERALS 5U		/* the last 5 bytes are literals */
+#define SENCOMP_LZ_MATCH_LIMIT	12U		/* and no match starts in the last 12. */
+#define SENCOMP_LZ_RUN_MASK		0x0FU	/* 15 in a token nibble: more length follows. */
+
+#define SENCOMP_ZIGZAG(lDelta)	(((uint32_t)(lDelta) << 1) ^ (uint32_t)((lDelta) >> 31))
+
+#if (SENCOMP_MAX_SAMPLES > 0xFFFFU) || ((SENCOMP_VARINT_MAX * SENCOMP_MAX_SAMPLES) > 0xFFFFU)
+#error "SENCOMP_MAX_SAMPLES is too large for the header and the match table"
+#endif
+
+/* Private function prototypes -----------------------------------------------*/
+static int32_t sencomp_lz_encode(SenComp_t *pxComp, const uint8_t *pucIn, uint32_t ulLen,
+		uint8_t *pucOut, uint32_t ulSize);
+static int32_t sencomp_lz_decode(const uint8_t *pucIn, uint32_t ulLen, uint8_t *pucOut,
+		uint32_t ulSize);
+static uint8_t *sencomp_lz_length(uint8_t *pucOut, uint32_t ulLength);
+static uint32_t sencomp_read32(const uint8_t *pucIn);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Compresses a block of samples.
+ * @param pxComp Working memory of the caller.
+ * @param xMode SENCOMP_DELTA or SENCOMP_DELTA_LZ.
+ * @param pusSamples Samples, channels interleaved.
+ * @param ulSamples Number of samples, all channels, up to SENCOMP_MAX_SAMPLES.
+ * @param ulChannels Channels in the block, 1 to SENCOMP_MAX_CHANNELS.
+ * @param pucOut Output.
+ * @param ulSize Size of pucOut; SENCOMP_MAX_ENCODED(ulSamples) is always
+ * enough.
+ * @retval Encoded length, or -1 if an argument is invalid or the block does
+ * not fit.
+ */
+int32_t sencomp_encode(SenComp_t *pxComp, SenCompMode_t xMode, const uint16_t *pusSamples,
+		uint32_t ulSamples, uint32_t ulChannels, uint8_t *pucOut, uint32_t ulSize)
+{
+	uint16_t usPrev[SENCOMP_MAX_CHANNELS] = { 0 };
+	uint8_t *pucDelta;
+	uint32_t ulDeltaLen = 0;
+	uint32_t ulDeltaSize;
+	uint32_t ulChannel = 0;
+	uint32_t ulValue;
+	int32_t lLzLen;
+	uint32_t i;
+
+	if ((pxComp == NULL) || (pusSamples == NULL) || (pucOut == NULL)
+			|| (ulSamples > SENCOMP_MAX_SAMPLES) || (ulChannels == 0U)
+			|| (ulChannels > SENCOMP_MAX_CHANNELS) || (ulSize < SENCOMP_HEADER_BYTES))
+	{
+		return -1;
+	}
+
+	/* The varints go straight to the output unless LZ is to pack them. */
+	if (xMode == SENCOMP_DELTA_LZ)
+	{
+		pucDelta = pxComp->ucDelta;
+		ulDeltaSize = sizeof(pxComp->ucDelta);
+	}
+	else
+	{
+		pucDelta = &pucOut[SENCOMP_HEADER_BYTES];
+		ulDeltaSize = ulSize - SENCOMP_HEADER_BYTES;
+	}
+
+	for (i = 0; i < ulSamples; i++)
+	{
+		ulValue = SENCOMP_ZIGZAG((int32_t)pusSamples[i] - (int32_t)usPrev[ulChannel]);
+		usPrev[ulChannel] = pusSamples[i];
+		ulChannel = (ulChannel + 1U == ulChannels) ? 0U : (ulChannel + 1U);
+
+		do
+		{
+			if (ulDeltaLen == ulDeltaSize)
+			{
+				return -1;
+			}
+
+			pucDelta[ulDeltaLen++] = (uint8_t)((ulValue & 0x7FU) | ((ulValue > 0x7FU) ? 0x80U : 0U));
+			ulValue >>= 7;
+		} while (ulValue != 0U);
+	}
+
+	pucOut[0] = (uint8_t)SENCOMP_DELTA;
+	pucOut[1] = (uint8_t)ulChannels;
+	pucOut[2] = (uint8_t)ulSamples;
+	pucOut[3] = (uint8_t)(ulSamples >> 8);
+
+	if (xMode != SENCOMP_DELTA_LZ)
+	{
+		return (int32_t)(SENCOMP_HEADER_BYTES + ulDeltaLen);
+	}
+
+	/* Only if it is smaller than the varints; they go as they are otherwise. */
+	lLzLen = -1;
+
+	if (ulDeltaLen > 0U)
+	{
+		lLzLen = sencomp_lz_encode(pxComp, pucDelta, ulDeltaLen, &pucOut[SENCOMP_HEADER_BYTES],
+				((ulDeltaLen - 1U) < (ulSize - SENCOMP_HEADER_BYTES))
+				? (ulDeltaLen - 1U) : (ulSize - SENCOMP_HEADER_BYTES));
+	}
+
+	if (lLzLen >= 0)
+	{
+		pucOut[0] = (uint8_t)SENCOMP_DELTA_LZ;
+		return (int32_t)SENCOMP_HEADER_BYTES + lLzLen;
+	}
+
+	if (ulDeltaLen > (ulSize - SENCOMP_HEADER_BYTES))
+	{
+		return -1;
+	}
+
+	memcpy(&pucOut[SENCOMP_HEADER_BYTES], pucDelta, ulDeltaLen);
+
+	return (int32_t)(SENCOMP_HEADER_BYTES + ulDeltaLen);
+}
+
+/**
+ * @brief Restores the samples of a block encoded by sencomp_encode().
+ * @param pucIn Encoded block.
+ * @param ulLen Its length.
+ * @param pusSamples Output, channels interleaved as they were.
+ * @param ulMaxSamples Size of pusSamples.
+ * @param pucScratch Room for the varints of an LZ block, NULL if only
+ * SENCOMP_DELTA blocks are expected.
+ * @param ulScratchSize Size of pucScratch; SENCOMP_VARINT_MAX per sample is
+ * always enough.
+ * @retval Number of samples, or -1 if the block is corrupt or does not fit.
+ */
+int32_t sencomp_decode(const uint8_t *pucIn, uint32_t ulLen, uint16_t *pusSamples,
+		uint32_t ulMaxSamples, uint8_t *pucScratch, uint32_t ulScratchSize)
+{
+	uint16_t usPrev[SENCOMP_MAX_CHANNELS] = { 0 };
+	const uint8_t *pucDelta;
+	uint32_t ulDeltaLen;
+	uint32_t ulChannels;
+	uint32_t ulSamples;
+	uint32_t ulChannel = 0;
+	uint32_t ulValue;
+	uint32_t ulShift;
+	uint32_t ulPos = 0;
+	int32_t lLen;
+	uint32_t i;
+
+	if ((pucIn == NULL) || (pusSamples == NULL) || (ulLen < SENCOMP_HEADER_BYTES))
+	{
+		return -1;
+	}
+
+	ulChannels = pucIn[1];
+	ulSamples = pucIn[2] | ((uint32_t)pucIn[3] << 8);
+
+	if ((ulChannels == 0U) || (ulChannels > SENCOMP_MAX_CHANNELS) || (ulSamples > ulMaxSamples))
+	{
+		return -1;
+	}
+
+	if (pucIn[0] == (uint8_t)SENCOMP_DELTA_LZ)
+	{
+		if (pucScratch == NULL)
+		{
+			return -1;
+		}
+
+		lLen = sencomp_lz_decode(&pucIn[SENCOMP_HEADER_BYTES], ulLen - SENCOMP_HEADER_BYTES,
+				pucScratch, ulScratchSize);
+
+		if (lLen < 0)
+		{
+			return -1;
+		}
+
+		pucDelta = pucScratch;
+		ulDeltaLen = (uint32_t)lLen;
+	}
+	else if (pucIn[0] == (uint8_t)SENCOMP_DELTA)
+	{
+		pucDelta = &pucIn[SENCOMP_HEADER_BYTES];
+		ulDeltaLen = ulLen - SENCOMP_HEADER_BYTES;
+	}
+	else
+	{
+		return -1;
+	}
+
+	for (i = 0; i < ulSamples; i++)
+	{
+		ulValue = 0;
+		ulShift = 0;
+
+		do
+		{
+			if ((ulPos == ulDeltaLen) || (ulShift > (7U * (SENCOMP_VARINT_MAX - 1U))))
+			{
+				return -1;
+			}
+
+			ulValue |= (uint32_t)(pucDelta[ulPos] & 0x7FU) << ulShift;
+			ulShift += 7U;
+		} while ((pucDelta[ulPos++] & 0x80U) != 0U);
+
+		/* Undo the zig-zag; the sum wraps back into 16 bits. */
+		usPrev[ulChannel] = (uint16_t)(usPrev[ulChannel] + (uint32_t)((ulValue >> 1) ^ (0U - (ulValue & 1U))));
+		pusSamples[i] = usPrev[ulChannel];
+		ulChannel = (ulChannel + 1U == ulChannels) ? 0U : (ulChannel + 1U);
+	}
+
+	return (ulPos == ulDeltaLen) ? (int32_t)ulSamples : -1;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Packs bytes as an LZ4 block: sequences of a token, literals, and a
+ * match given as a 16-bit offset back and a length.
+ * @param pxComp Working memory; its table is cleared here.
+ * @param pucIn Bytes to pack.
+ * @param ulLen Number of bytes.
+ * @param pucOut Output.
+ * @param ulSize Size of pucOut.
+ * @retval Packed length, or -1 if it does not fit in ulSize.
+ */
+static int32_t sencomp_lz_encode(SenComp_t *pxComp, const uint8_t *pucIn, uint32_t ulLen,
+		uint8_t *pucOut, uint32_t ulSize)
+{
+	const uint8_t *const pucEnd = pucOut + ulSize;
+	uint8_t *pucOp = pucOut;
+	uint8_t *pucToken;
+	uint32_t ulAnchor = 0;
+	uint32_t ulPos = 0;
+	uint32_t ulRef;
+	uint32_t ulMatch;
+	uint32_t ulHash;
+	uint32_t ulLiterals;
+
+	memset(pxComp->usHash, 0, sizeof(pxComp->usHash));
+
+	while ((ulPos + SENCOMP_LZ_MATCH_LIMIT) < ulLen)
+	{
+		/* Knuth's multiplicative hash of the next 4 bytes. */
+		ulHash = (sencomp_read32(&pucIn[ulPos]) * 2654435761U) >> (32U - SENCOMP_HASH_BITS);
+		ulRef = pxComp->usHash[ulHash];
+		pxComp->usHash[ulHash] = (uint16_t)(ulPos + 1U);
+
+		if ((ulRef == 0U) || (sencomp_read32(&pucIn[ulRef - 1U]) != sencomp_read32(&pucIn[ulPos])))
+		{
+			ulPos++;
+			continue;
+		}
+
+		ulRef--;
+		ulMatch = SENCOMP_LZ_MIN_MATCH;
+
+		while (((ulPos + ulMatch) < (ulLen - SENCOMP_LZ_LAST_LITERALS))
+				&& (pucIn[ulRef + ulMatch] == pucIn[ulPos + ulMatch]))
+		{
+			ulMatch++;
+		}
+
+		/* Token, literals, offset: the length bytes are at most 1 per 255. */
+		ulLiterals = ulPos - ulAnchor;
+
+		if ((pucOp + 1U + (ulLiterals / 255U) + 1U + ulLiterals + 2U
+				+ ((ulMatch - SENCOMP_LZ_MIN_MATCH) / 255U) + 1U) > pucEnd)
+		{
+			return -1;
+		}
+
+		pucToken = pucOp++;
+		*pucToken = (uint8_t)(((ulLiterals < SENCOMP_LZ_RUN_MASK) ? ulLiterals : SENCOMP_LZ_RUN_MASK) << 4);
+
+		if (ulLiterals >= SENCOMP_LZ_RUN_MASK)
+		{
+			pucOp = sencomp_lz_length(pucOp, ulLiterals - SENCOMP_LZ_RUN_MASK);
+		}
+
+		memcpy(pucOp, &pucIn[ulAnchor], ulLiterals);
+		pucOp += ulLiterals;
+		*pucOp++ = (uint8_t)(ulPos - ulRef);
+		*pucOp++ = (uint8_t)((ulPos - ulRef) >> 8);
+
+		if ((ulMatch - SENCOMP_LZ_MIN_MATCH) >= SENCOMP_LZ_RUN_MASK)
+		{
+			*pucToken |= SENCOMP_LZ_RUN_MASK;
+			pucOp = sencomp_lz_length(pucOp, ulMatch - SENCOMP_LZ_MIN_MATCH - SENCOMP_LZ_RUN_MASK);
+		}
+		else
+		{
+			*pucToken |= (uint8_t)(ulMatch - SENCOMP_LZ_MIN_MATCH);
+		}
+
+		ulPos += ulMatch;
+		ulAnchor = ulPos;
+	}
+
+	/* The last sequence is literals only. */
+	ulLiterals = ulLen - ulAnchor;
+
+	if ((pucOp + 1U + (ulLiterals / 255U) + 1U + ulLiterals) > pucEnd)
+	{
+		return -1;
+	}
+
+	pucToken = pucOp++;
+	*pucToken = (uint8_t)(((ulLiterals < SENCOMP_LZ_RUN_MASK) ? ulLiterals : SENCOMP_LZ_RUN_MASK) << 4);
+
+	if (ulLiterals >= SENCOMP_LZ_RUN_MASK)
+	{
+		pucOp = sencomp_lz_length(pucOp, ulLiterals - SENCOMP_LZ_RUN_MASK);
+	}
+
+	memcpy(pucOp, &pucIn[ulAnchor], ulLiterals);
+	pucOp += ulLiterals;
+
+	return (int32_t)(pucOp - pucOut);
+}
+
+/**
+ * @brief Unpacks an LZ4 block.
+ * @param pucIn Block.
+ * @param ulLen Its length.
+ * @param pucOut Output.
+ * @param ulSize Size of pucOut.
+ * @retval Unpacked length, or -1 if the block is corrupt or does not fit.
+ */
+static int32_t sencomp_lz_decode(const uint8_t *pucIn, uint32_t ulLen, uint8_t *pucOut,
+		uint32_t ulSize)
+{
+	uint32_t ulIp = 0;
+	uint32_t ulOp = 0;
+	uint32_t ulToken;
+	uint32_t ulLength;
+	uint32_t ulOffset;
+	uint8_t ucByte;
+
+	while (ulIp < ulLen)
+	{
+		ulToken = pucIn[ulIp++];
+		ulLength = ulToken >> 4;
+
+		if (ulLength == SENCOMP_LZ_RUN_MASK)
+		{
+			do
+			{
+				if (ulIp == ulLen)
+				{
+					return -1;
+				}
+
+				ucByte = pucIn[ulIp++];
+				ulLength += ucByte;
+			} while (ucByte == 0xFFU);
+		}
+
+		if ((ulLength > (ulLen - ulIp)) || (ulLength > (ulSize - ulOp)))
+		{
+			return -1;
+		}
+
+		memcpy(&pucOut[ulOp], &pucIn[ulIp], ulLength);
+		ulIp += ulLength;
+		ulOp += ulLength;
+
+		/* The last sequence ends after its literals. */
+		if (ulIp == ulLen)
+		{
+			break;
+		}
+
+		if ((ulLen - ulIp) < 2U)
+		{
+			return -1;
+		}
+
+		ulOffset = pucIn[ulIp] | ((uint32_t)pucIn[ulIp + 1U] << 8);
+		ulIp += 2U;
+		ulLength = ulToken & SENCOMP_LZ_RUN_MASK;
+
+		if (ulLength == SENCOMP_LZ_RUN_MASK)
+		{
+			do
+			{
+				if (ulIp == ulLen)
+				{
+					return -1;
+				}
+
+				ucByte = pucIn[ulIp++];
+				ulLength += ucByte;
+			} while (ucByte == 0xFFU);
+		}
+
+		ulLength += SENCOMP_LZ_MIN_MATCH;
+
+		if ((ulOffset == 0U) || (ulOffset > ulOp) || (ulLength > (ulSize - ulOp)))
+		{
+			return -1;
+		}
+
+		/* Byte by byte: a match may overlap what it copies. */
+		while (ulLength-- > 0U)
+		{
+			pucOut[ulOp] = pucOut[ulOp - ulOffset];
+			ulOp++;
+		}
+	}
+
+	return (int32_t)ulOp;
+}
+
+/**
+ * @brief Writes the rest of a length in LZ4 form: 255s, then the remainder.
+ * @param pucOut Where it goes; the caller has checked the room.
+ * @param ulLength Length beyond the 15 in the token.
+ * @retval Position after it.
+ */
+static uint8_t *sencomp_lz_length(uint8_t *pucOut, uint32_t ulLength)
+{
+	while (ulLength >= 255U)
+	{
+		*pucOut++ = 255U;
+		ulLength -= 255U;
+	}
+
+	*pucOut++ = (uint8_t)ulLength;
+
+	return pucOut;
+}
+
+/**
+ * @brief Reads 4 bytes, unaligned.
+ * @param pucIn First byte.
+ * @retval The bytes as one word, LSB first.
+ */
+static uint32_t sencomp_read32(const uint8_t *pucIn)
+{
+	uint32_t ulWord;
+
+	memcpy(&ulWord, pucIn, sizeof(ulWord));
+
+	return ulWord;
+}
@@ -31,6 +31,7 @@
 #include "semphr.h"                     // ARM.FreeRTOS::RTOS:Core
 
 #include "freertos_mpool.h"             // osMemoryPool definitions
+#include "freertos_mqueue.h"            // osMessageQueue definitions
 #include "freertos_os2.h"               // Configuration check and setup
 
 /*---------------------------------------------------------------------------*/
@@ -465,7 +466,8 @@ osThreadId_t osThreadNew (osThreadFunc_t func, void *argument, const osThreadAtt
         prio = (UBaseType_t)attr->priority;
       }
 
-      if ((prio < osPriorityIdle) || (prio > osPriorityISR) || ((attr->attr_bits & osThreadJoinable) == osThreadJoinable)) {
+      /* Priorities above configMAX_PRIORITIES - 1 do not exist in this kernel */
+      if ((prio < osPriorityIdle) || (prio > osPriorityISR) || (prio >= (UBaseType_t)configMAX_PRIORITIES) || ((attr->attr_bits & osThreadJoinable) == osThreadJoinable)) {
         return (NULL);
       }
 
@@ -572,7 +574,7 @@ osStatus_t osThreadSetPriority (osThreadId_t thread_id, osPriority_t priority) {
   if (IS_IRQ()) {
     stat = osErrorISR;
   }
-  else if ((hTask == NULL) || (priority < osPriorityIdle) || (priority > osPriorityISR)) {
+  else if ((hTask == NULL) || (priority < osPriorityIdle) || (priority > osPriorityISR) || ((UBaseType_t)priority >= (UBaseType_t)configMAX_PRIORITIES)) {
     stat = osErrorParameter;
   }
   else {
@@ -698,11 +700,34 @@ uint32_t osThreadGetCount (void) {
 #if (configUSE_OS2_THREAD_ENUMERATE == 1)
 uint32_t osThreadEnumerate (osThreadId_t *thread_array, uint32_t array_items) {
   uint32_t i, count;
+#if (configUSE_TASK_SNAPSHOTS == 1)
+  TaskSnapshot_t snapshot;
+  TaskStatus_t task[4];
+  uint32_t n;
+#else
   TaskStatus_t *task;
+#endif
 
   if (IS_IRQ() || (thread_array == NULL) || (array_items == 0U)) {
     count = 0U;
   } else {
+#if (configUSE_TASK_SNAPSHOTS == 1)
+    /* A few threads at a time, so switching goes on. Started again if a
+       thread is created or deleted meanwhile. */
+    do {
+      vTaskSnapshotStart (&snapshot);
+      count = 0U;
+
+      do {
+        n = array_items - count;
+        n = uxTaskSnapshotNext (&snapshot, task, (n < 4U) ? n : 4U, pdFALSE);
+
+        for (i = 0U; i < n; i++) {
+          thread_array[count++] = (osThreadId_t)task[i].xHandle;
+        }
+      } while ((n != 0U) && (count < array_items));
+    } while (xTaskSnapshotChanged (&snapshot) != pdFALSE);
+#else
     vTaskSuspendAll();
 
     count = uxTaskGetNumberOfTasks();
@@ -719,6 +744,7 @@ uint32_t osThreadEnumerate (osThreadId_t *thread_array, uint32_t array_items) {
     (void)xTaskResumeAll();
 
     vPortFree (task);
+#endif
   }
 
   return (count);
@@ -727,9 +753,20 @@ uint32_t osThreadEnumerate (osThreadId_t *thread_array, uint32_t array_items) {
 
 #if (configUSE_OS2_THREAD_FLAGS == 1)
 uint32_t osThreadFlagsSet (osThreadId_t thread_id, uint32_t flags) {
+  uint32_t rflags;
+
+  if (IS_IRQ()) {
+    rflags = osThreadFlagsSetFromISR (thread_id, flags);
+  } else {
+    rflags = osThreadFlagsSetFromTask (thread_id, flags);
+  }
+
+  return (rflags);
+}
+
+uint32_t osThreadFlagsSetFromTask (osThreadId_t thread_id, uint32_t flags) {
   TaskHandle_t hTask = (TaskHandle_t)thread_id;
   uint32_t rflags;
-  BaseType_t yield;
 
   if ((hTask == NULL) || ((flags & THREAD_FLAGS_INVALID_BITS) != 0U)) {
     rflags = (uint32_t)osErrorParameter;
@@ -737,18 +774,29 @@ uint32_t osThreadFlagsSet (osThreadId_t thread_id, uint32_t flags) {
   else {
     rflags = (uint32_t)osError;
 
-    if (IS_IRQ()) {
-      yield = pdFALSE;
+    (void)xTaskNotify (hTask, flags, eSetBits);
+    (void)xTaskNotifyAndQuery (hTask, 0, eNoAction, &rflags);
+  }
+  /* Return flags after setting */
+  return (rflags);
+}
 
-      (void)xTaskNotifyFromISR (hTask, flags, eSetBits, &yield);
-      (void)xTaskNotifyAndQueryFromISR (hTask, 0, eNoAction, &rflags, NULL);
+uint32_t osThreadFlagsSetFromISR (osThreadId_t thread_id, uint32_t flags) {
+  TaskHandle_t hTask = (TaskHandle_t)thread_id;
+  uint32_t rflags;
+  BaseType_t yield;
 
-      portYIELD_FROM_ISR (yield);
-    }
-    else {
-      (void)xTaskNotify (hTask, flags, eSetBits);
-      (void)xTaskNotifyAndQuery (hTask, 0, eNoAction, &rflags);
-    }
+  if ((hTask == NULL) || ((flags & THREAD_FLAGS_INVALID_BITS) != 0U)) {
+    rflags = (uint32_t)osErrorParameter;
+  }
+  else {
+    rflags = (uint32_t)osError;
+    yield = pdFALSE;
+
+    (void)xTaskNotifyFromISR (hTask, flags, eSetBits, &yield);
+    (void)xTaskNotifyAndQueryFromISR (hTask, 0, eNoAction, &rflags, NULL);
+
+    portYIELD_FROM_ISR (yield);
   }
   /* Return flags after setting */
   return (rflags);
@@ -1142,12 +1190,44 @@ osEventFlagsId_t osEventFlagsNew (const osEventFlagsAttr_t *attr) {
         #endif
       }
     }
+
+    #if (configUSE_OBJECT_REGISTRY == 1)
+    if ((hEventGroup != NULL) && (attr != NULL)) {
+      vEventGroupAddToRegistry (hEventGroup, attr->name);
+    }
+    #endif
   }
 
   return ((osEventFlagsId_t)hEventGroup);
 }
 
 uint32_t osEventFlagsSet (osEventFlagsId_t ef_id, uint32_t flags) {
+  uint32_t rflags;
+
+  if (IS_IRQ()) {
+    rflags = osEventFlagsSetFromISR (ef_id, flags);
+  } else {
+    rflags = osEventFlagsSetFromTask (ef_id, flags);
+  }
+
+  return (rflags);
+}
+
+uint32_t osEventFlagsSetFromTask (osEventFlagsId_t ef_id, uint32_t flags) {
+  EventGroupHandle_t hEventGroup = (EventGroupHandle_t)ef_id;
+  uint32_t rflags;
+
+  if ((hEventGroup == NULL) || ((flags & EVENT_FLAGS_INVALID_BITS) != 0U)) {
+    rflags = (uint32_t)osErrorParameter;
+  }
+  else {
+    rflags = xEventGroupSetBits (hEventGroup, (EventBits_t)flags);
+  }
+
+  return (rflags);
+}
+
+uint32_t osEventFlagsSetFromISR (osEventFlagsId_t ef_id, uint32_t flags) {
   EventGroupHandle_t hEventGroup = (EventGroupHandle_t)ef_id;
   uint32_t rflags;
   BaseType_t yield;
@@ -1155,7 +1235,7 @@ uint32_t osEventFlagsSet (osEventFlagsId_t ef_id, uint32_t flags) {
   if ((hEventGroup == NULL) || ((flags & EVENT_FLAGS_INVALID_BITS) != 0U)) {
     rflags = (uint32_t)osErrorParameter;
   }
-  else if (IS_IRQ()) {
+  else {
   #if (configUSE_OS2_EVENTFLAGS_FROM_ISR == 0)
     (void)yield;
     /* Enable timers and xTimerPendFunctionCall function to support osEventFlagsSet from ISR */
@@ -1171,9 +1251,6 @@ uint32_t osEventFlagsSet (osEventFlagsId_t ef_id, uint32_t flags) {
     }
   #endif
   }
-  else {
-    rflags = xEventGroupSetBits (hEventGroup, (EventBits_t)flags);
-  }
 
   return (rflags);
 }
@@ -1384,6 +1461,18 @@ osMutexId_t osMutexNew (const osMutexAttr_t *attr) {
 }
 
 osStatus_t osMutexAcquire (osMutexId_t mutex_id, uint32_t timeout) {
+  osStatus_t stat;
+
+  if (IS_IRQ()) {
+    stat = osErrorISR;
+  } else {
+    stat = osMutexAcquireFromTask (mutex_id, timeout);
+  }
+
+  return (stat);
+}
+
+osStatus_t osMutexAcquireFromTask (osMutexId_t mutex_id, uint32_t timeout) {
   SemaphoreHandle_t hMutex;
   osStatus_t stat;
   uint32_t rmtx;
@@ -1394,10 +1483,7 @@ osStatus_t osMutexAcquire (osMutexId_t mutex_id, uint32_t timeout) {
 
   stat = osOK;
 
-  if (IS_IRQ()) {
-    stat = osErrorISR;
-  }
-  else if (hMutex == NULL) {
+  if (hMutex == NULL) {
     stat = osErrorParameter;
   }
   else {
@@ -1427,6 +1513,18 @@ osStatus_t osMutexAcquire (osMutexId_t mutex_id, uint32_t timeout) {
 }
 
 osStatus_t osMutexRelease (osMutexId_t mutex_id) {
+  osStatus_t stat;
+
+  if (IS_IRQ()) {
+    stat = osErrorISR;
+  } else {
+    stat = osMutexReleaseFromTask (mutex_id);
+  }
+
+  return (stat);
+}
+
+osStatus_t osMutexReleaseFromTask (osMutexId_t mutex_id) {
   SemaphoreHandle_t hMutex;
   osStatus_t stat;
   uint32_t rmtx;
@@ -1437,10 +1535,7 @@ osStatus_t osMutexRelease (osMutexId_t mutex_id) {
 
   stat = osOK;
 
-  if (IS_IRQ()) {
-    stat = osErrorISR;
-  }
-  else if (hMutex == NULL) {
+  if (hMutex == NULL) {
     stat = osErrorParameter;
   }
   else {
@@ -1582,29 +1677,30 @@ osSemaphoreId_t osSemaphoreNew (uint32_t max_count, uint32_t initial_count, cons
 }
 
 osStatus_t osSemaphoreAcquire (osSemaphoreId_t semaphore_id, uint32_t timeout) {
+  osStatus_t stat;
+
+  if (IS_IRQ()) {
+    if (timeout != 0U) {
+      stat = osErrorParameter;
+    } else {
+      stat = osSemaphoreAcquireFromISR (semaphore_id);
+    }
+  } else {
+    stat = osSemaphoreAcquireFromTask (semaphore_id, timeout);
+  }
+
+  return (stat);
+}
+
+osStatus_t osSemaphoreAcquireFromTask (osSemaphoreId_t semaphore_id, uint32_t timeout) {
   SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)semaphore_id;
   osStatus_t stat;
-  BaseType_t yield;
 
   stat = osOK;
 
   if (hSemaphore == NULL) {
     stat = osErrorParameter;
   }
-  else if (IS_IRQ()) {
-    if (timeout != 0U) {
-      stat = osErrorParameter;
-    }
-    else {
-      yield = pdFALSE;
-
-      if (xSemaphoreTakeFromISR (hSemaphore, &yield) != pdPASS) {
-        stat = osErrorResource;
-      } else {
-        portYIELD_FROM_ISR (yield);
-      }
-    }
-  }
   else {
     if (xSemaphoreTake (hSemaphore, (TickType_t)timeout) != pdPASS) {
       if (timeout != 0U) {
@@ -1618,7 +1714,7 @@ osStatus_t osSemaphoreAcquire (osSemaphoreId_t semaphore_id, uint32_t timeout) {
   return (stat);
 }
 
-osStatus_t osSemaphoreRelease (osSemaphoreId_t semaphore_id) {
+osStatus_t osSemaphoreAcquireFromISR (osSemaphoreId_t semaphore_id) {
   SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)semaphore_id;
   osStatus_t stat;
   BaseType_t yield;
@@ -1628,15 +1724,40 @@ osStatus_t osSemaphoreRelease (osSemaphoreId_t semaphore_id) {
   if (hSemaphore == NULL) {
     stat = osErrorParameter;
   }
-  else if (IS_IRQ()) {
+  else {
     yield = pdFALSE;
 
-    if (xSemaphoreGiveFromISR (hSemaphore, &yield) != pdTRUE) {
+    if (xSemaphoreTakeFromISR (hSemaphore, &yield) != pdPASS) {
       stat = osErrorResource;
     } else {
       portYIELD_FROM_ISR (yield);
     }
   }
+
+  return (stat);
+}
+
+osStatus_t osSemaphoreRelease (osSemaphoreId_t semaphore_id) {
+  osStatus_t stat;
+
+  if (IS_IRQ()) {
+    stat = osSemaphoreReleaseFromISR (semaphore_id);
+  } else {
+    stat = osSemaphoreReleaseFromTask (semaphore_id);
+  }
+
+  return (stat);
+}
+
+osStatus_t osSemaphoreReleaseFromTask (osSemaphoreId_t semaphore_id) {
+  SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)semaphore_id;
+  osStatus_t stat;
+
+  stat = osOK;
+
+  if (hSemaphore == NULL) {
+    stat = osErrorParameter;
+  }
   else {
     if (xSemaphoreGive (hSemaphore) != pdPASS) {
       stat = osErrorResource;
@@ -1646,6 +1767,29 @@ osStatus_t osSemaphoreRelease (osSemaphoreId_t semaphore_id) {
   return (stat);
 }
 
+osStatus_t osSemaphoreReleaseFromISR (osSemaphoreId_t semaphore_id) {
+  SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)semaphore_id;
+  osStatus_t stat;
+  BaseType_t yield;
+
+  stat = osOK;
+
+  if (hSemaphore == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    yield = pdFALSE;
+
+    if (xSemaphoreGiveFromISR (hSemaphore, &yield) != pdTRUE) {
+      stat = osErrorResource;
+    } else {
+      portYIELD_FROM_ISR (yield);
+    }
+  }
+
+  return (stat);
+}
+
 uint32_t osSemaphoreGetCount (osSemaphoreId_t semaphore_id) {
   SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)semaphore_id;
   uint32_t count;
@@ -1689,6 +1833,7 @@ osStatus_t osSemaphoreDelete (osSemaphoreId_t semaphore_id) {
 }
 
 /*---------------------------------------------------------------------------*/
+#if (configUSE_OS2_MESSAGE_PRIORITY == 0)
 
 osMessageQueueId_t osMessageQueueNew (uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr) {
   QueueHandle_t hQueue;
@@ -1748,39 +1893,54 @@ osMessageQueueId_t osMessageQueueNew (uint32_t msg_count, uint32_t msg_size, con
 }
 
 osStatus_t osMessageQueuePut (osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout) {
-  QueueHandle_t hQueue = (QueueHandle_t)mq_id;
   osStatus_t stat;
-  BaseType_t yield;
 
-  (void)msg_prio; /* Message priority is ignored */
+  if (IS_IRQ()) {
+    if (timeout != 0U) {
+      stat = osErrorParameter;
+    } else {
+      stat = osMessageQueuePutFromISR (mq_id, msg_ptr, msg_prio);
+    }
+  } else {
+    stat = osMessageQueuePutFromTask (mq_id, msg_ptr, msg_prio, timeout);
+  }
 
-  stat = osOK;
+  return (stat);
+}
+
+osStatus_t osMessageQueueGet (osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout) {
+  osStatus_t stat;
 
   if (IS_IRQ()) {
-    if ((hQueue == NULL) || (msg_ptr == NULL) || (timeout != 0U)) {
+    if (timeout != 0U) {
       stat = osErrorParameter;
+    } else {
+      stat = osMessageQueueGetFromISR (mq_id, msg_ptr, msg_prio);
     }
-    else {
-      yield = pdFALSE;
+  } else {
+    stat = osMessageQueueGetFromTask (mq_id, msg_ptr, msg_prio, timeout);
+  }
 
-      if (xQueueSendToBackFromISR (hQueue, msg_ptr, &yield) != pdTRUE) {
-        stat = osErrorResource;
-      } else {
-        portYIELD_FROM_ISR (yield);
-      }
-    }
+  return (stat);
+}
+
+osStatus_t osMessageQueuePutFromTask (osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout) {
+  QueueHandle_t hQueue = (QueueHandle_t)mq_id;
+  osStatus_t stat;
+
+  (void)msg_prio; /* Message priority is ignored */
+
+  stat = osOK;
+
+  if ((hQueue == NULL) || (msg_ptr == NULL)) {
+    stat = osErrorParameter;
   }
   else {
-    if ((hQueue == NULL) || (msg_ptr == NULL)) {
-      stat = osErrorParameter;
-    }
-    else {
-      if (xQueueSendToBack (hQueue, msg_ptr, (TickType_t)timeout) != pdPASS) {
-        if (timeout != 0U) {
-          stat = osErrorTimeout;
-        } else {
-          stat = osErrorResource;
-        }
+    if (xQueueSendToBack (hQueue, msg_ptr, (TickType_t)timeout) != pdPASS) {
+      if (timeout != 0U) {
+        stat = osErrorTimeout;
+      } else {
+        stat = osErrorResource;
       }
     }
   }
@@ -1788,7 +1948,7 @@ osStatus_t osMessageQueuePut (osMessageQueueId_t mq_id, const void *msg_ptr, uin
   return (stat);
 }
 
-osStatus_t osMessageQueueGet (osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout) {
+osStatus_t osMessageQueuePutFromISR (osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio) {
   QueueHandle_t hQueue = (QueueHandle_t)mq_id;
   osStatus_t stat;
   BaseType_t yield;
@@ -1797,51 +1957,84 @@ osStatus_t osMessageQueueGet (osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *
 
   stat = osOK;
 
-  if (IS_IRQ()) {
-    if ((hQueue == NULL) || (msg_ptr == NULL) || (timeout != 0U)) {
-      stat = osErrorParameter;
-    }
-    else {
-      yield = pdFALSE;
-
-      if (xQueueReceiveFromISR (hQueue, msg_ptr, &yield) != pdPASS) {
-        stat = osErrorResource;
-      } else {
-        portYIELD_FROM_ISR (yield);
-      }
-    }
+  if ((hQueue == NULL) || (msg_ptr == NULL)) {
+    stat = osErrorParameter;
   }
   else {
-    if ((hQueue == NULL) || (msg_ptr == NULL)) {
-      stat = osErrorParameter;
-    }
-    else {
-      if (xQueueReceive (hQueue, msg_ptr, (TickType_t)timeout) != pdPASS) {
-        if (timeout != 0U) {
-          stat = osErrorTimeout;
-        } else {
-          stat = osErrorResource;
-        }
-      }
+    yield = pdFALSE;
+
+    if (xQueueSendToBackFromISR (hQueue, msg_ptr, &yield) != pdTRUE) {
+      stat = osErrorResource;
+    } else {
+      portYIELD_FROM_ISR (yield);
     }
   }
 
   return (stat);
 }
 
-uint32_t osMessageQueueGetCapacity (osMessageQueueId_t mq_id) {
-  StaticQueue_t *mq = (StaticQueue_t *)mq_id;
-  uint32_t capacity;
+osStatus_t osMessageQueueGetFromTask (osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout) {
+  QueueHandle_t hQueue = (QueueHandle_t)mq_id;
+  osStatus_t stat;
 
-  if (mq == NULL) {
-    capacity = 0U;
-  } else {
-    /* capacity = pxQueue->uxLength */
-    capacity = mq->uxDummy4[1];
-  }
+  (void)msg_prio; /* Message priority is ignored */
 
-  return (capacity);
-}
+  stat = osOK;
+
+  if ((hQueue == NULL) || (msg_ptr == NULL)) {
+    stat = osErrorParameter;
+  }
+  else {
+    if (xQueueReceive (hQueue, msg_ptr, (TickType_t)timeout) != pdPASS) {
+      if (timeout != 0U) {
+        stat = osErrorTimeout;
+      } else {
+        stat = osErrorResource;
+      }
+    }
+  }
+
+  return (stat);
+}
+
+osStatus_t osMessageQueueGetFromISR (osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio) {
+  QueueHandle_t hQueue = (QueueHandle_t)mq_id;
+  osStatus_t stat;
+  BaseType_t yield;
+
+  (void)msg_prio; /* Message priority is ignored */
+
+  stat = osOK;
+
+  if ((hQueue == NULL) || (msg_ptr == NULL)) {
+    stat = osErrorParameter;
+  }
+  else {
+    yield = pdFALSE;
+
+    if (xQueueReceiveFromISR (hQueue, msg_ptr, &yield) != pdPASS) {
+      stat = osErrorResource;
+    } else {
+      portYIELD_FROM_ISR (yield);
+    }
+  }
+
+  return (stat);
+}
+
+uint32_t osMessageQueueGetCapacity (osMessageQueueId_t mq_id) {
+  StaticQueue_t *mq = (StaticQueue_t *)mq_id;
+  uint32_t capacity;
+
+  if (mq == NULL) {
+    capacity = 0U;
+  } else {
+    /* capacity = pxQueue->uxLength */
+    capacity = mq->uxDummy4[1];
+  }
+
+  return (capacity);
+}
 
 uint32_t osMessageQueueGetMsgSize (osMessageQueueId_t mq_id) {
   StaticQueue_t *mq = (StaticQueue_t *)mq_id;
@@ -1941,24 +2134,577 @@ osStatus_t osMessageQueueDelete (osMessageQueueId_t mq_id) {
   return (stat);
 }
 
+#else /* (configUSE_OS2_MESSAGE_PRIORITY == 1) */
+
+/*
+  Priority message queue. Messages live in slots of one array; each priority bucket
+  is a FIFO list of slots and free slots form another list. A 32-bit bitmap marks the
+  non-empty buckets, so the highest priority message is found with one CLZ. Two
+  counting semaphores, for queued messages and free slots, do the blocking. The
+  message itself is copied outside the critical sections.
+*/
+
+/* Message queue functions */
+static uint32_t MQueueBucket  (uint8_t msg_prio);
+static uint16_t MQueueAlloc   (MsgQueue_t *mq);
+static void     MQueueLink    (MsgQueue_t *mq, uint16_t slot, uint8_t msg_prio);
+static uint16_t MQueueUnlink  (MsgQueue_t *mq);
+static void     MQueueFree    (MsgQueue_t *mq, uint16_t slot);
+static uint8_t *MQueueSlot    (MsgQueue_t *mq, uint16_t slot);
+
+osMessageQueueId_t osMessageQueueNew (uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr) {
+  MsgQueue_t *mq;
+  int32_t mem_cb, mem_mq;
+  uint32_t sz;
+  uint32_t i;
+  #if (configQUEUE_REGISTRY_SIZE > 0)
+  const char *name;
+  #endif
+
+  mq = NULL;
+
+  if (!IS_IRQ() && (msg_count > 0U) && (msg_count < MQUEUE_NIL) && (msg_size > 0U)) {
+    sz = MQUEUE_ARR_SIZE (msg_count, msg_size);
+
+    mem_cb = -1;
+    mem_mq = -1;
+
+    if (attr != NULL) {
+      if ((attr->cb_mem != NULL) && (attr->cb_size >= sizeof(MsgQueue_t))) {
+        /* Static control block is provided */
+        mem_cb = 1;
+      }
+      else if ((attr->cb_mem == NULL) && (attr->cb_size == 0U)) {
+        /* Allocate control block memory on heap */
+        mem_cb = 0;
+      }
+
+      if ((attr->mq_mem == NULL) && (attr->mq_size == 0U)) {
+        /* Allocate message array on heap */
+        mem_mq = 0;
+      }
+      else {
+        /* Static message array must be 4-byte aligned and big enough */
+        if ((attr->mq_mem != NULL) && (((uint32_t)attr->mq_mem & 3U) == 0U) && (attr->mq_size >= sz)) {
+          mem_mq = 1;
+        }
+      }
+    }
+    else {
+      /* Attributes not provided, allocate memory on heap */
+      mem_cb = 0;
+      mem_mq = 0;
+    }
+
+    if ((mem_cb != -1) && (mem_mq != -1)) {
+      if (mem_cb == 0) {
+        mq = pvPortMalloc (sizeof(MsgQueue_t));
+      } else {
+        mq = attr->cb_mem;
+      }
+    }
+
+    if (mq != NULL) {
+      mq->msg_sem = NULL;
+      mq->spc_sem = NULL;
+      mq->mem_arr = NULL;
+
+      #if (configSUPPORT_STATIC_ALLOCATION == 1)
+        mq->msg_sem = xSemaphoreCreateCountingStatic (msg_count, 0U, &mq->msg_sem_mem);
+        mq->spc_sem = xSemaphoreCreateCountingStatic (msg_count, msg_count, &mq->spc_sem_mem);
+      #elif (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+        mq->msg_sem = xSemaphoreCreateCounting (msg_count, 0U);
+        mq->spc_sem = xSemaphoreCreateCounting (msg_count, msg_count);
+      #endif
+
+      if ((mq->msg_sem != NULL) && (mq->spc_sem != NULL)) {
+        if (mem_mq == 0) {
+          mq->mem_arr = pvPortMalloc (sz);
+        } else {
+          mq->mem_arr = attr->mq_mem;
+        }
+      }
+    }
+
+    if ((mq != NULL) && (mq->mem_arr != NULL)) {
+      /* Message queue can be created */
+      mq->msg_sz  = msg_size;
+      mq->msg_cnt = msg_count;
+      mq->slot_sz = MQUEUE_ARR_SIZE (1U, msg_size);
+      mq->bitmap  = 0U;
+
+      /* Chain every slot into the free list */
+      for (i = 0U; i < msg_count; i++) {
+        ((MsgQueueSlot_t *)MQueueSlot (mq, (uint16_t)i))->next = (uint16_t)(i + 1U);
+      }
+      ((MsgQueueSlot_t *)MQueueSlot (mq, (uint16_t)(msg_count - 1U)))->next = MQUEUE_NIL;
+      mq->free = 0U;
+
+      for (i = 0U; i < MQUEUE_LEVELS; i++) {
+        mq->head[i] = MQUEUE_NIL;
+        mq->tail[i] = MQUEUE_NIL;
+      }
+
+      /* Set heap allocated memory flags */
+      mq->status = MQUEUE_STATUS;
+
+      if (mem_cb == 0) {
+        /* Control block on heap */
+        mq->status |= 1U;
+      }
+      if (mem_mq == 0) {
+        /* Message array on heap */
+        mq->status |= 2U;
+      }
+
+      #if (configQUEUE_REGISTRY_SIZE > 0)
+      if (attr != NULL) {
+        name = attr->name;
+      } else {
+        name = NULL;
+      }
+      vQueueAddToRegistry (mq->msg_sem, name);
+      #endif
+    }
+    else {
+      /* Message queue cannot be created, release allocated resources */
+      if (mq != NULL) {
+        if (mq->msg_sem != NULL) {
+          vSemaphoreDelete (mq->msg_sem);
+        }
+        if (mq->spc_sem != NULL) {
+          vSemaphoreDelete (mq->spc_sem);
+        }
+        if (mem_cb == 0) {
+          /* Free control block memory */
+          vPortFree (mq);
+        }
+      }
+      mq = NULL;
+    }
+  }
+
+  return ((osMessageQueueId_t)mq);
+}
+
+osStatus_t osMessageQueuePut (osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout) {
+  osStatus_t stat;
+
+  if (IS_IRQ()) {
+    if (timeout != 0U) {
+      stat = osErrorParameter;
+    } else {
+      stat = osMessageQueuePutFromISR (mq_id, msg_ptr, msg_prio);
+    }
+  } else {
+    stat = osMessageQueuePutFromTask (mq_id, msg_ptr, msg_prio, timeout);
+  }
+
+  return (stat);
+}
+
+osStatus_t osMessageQueueGet (osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout) {
+  osStatus_t stat;
+
+  if (IS_IRQ()) {
+    if (timeout != 0U) {
+      stat = osErrorParameter;
+    } else {
+      stat = osMessageQueueGetFromISR (mq_id, msg_ptr, msg_prio);
+    }
+  } else {
+    stat = osMessageQueueGetFromTask (mq_id, msg_ptr, msg_prio, timeout);
+  }
+
+  return (stat);
+}
+
+osStatus_t osMessageQueuePutFromTask (osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout) {
+  MsgQueue_t *mq = (MsgQueue_t *)mq_id;
+  osStatus_t stat;
+  uint16_t slot;
+
+  stat = osOK;
+
+  if ((mq == NULL) || (msg_ptr == NULL) || ((mq->status & MQUEUE_STATUS) != MQUEUE_STATUS)) {
+    stat = osErrorParameter;
+  }
+  else if (xSemaphoreTake (mq->spc_sem, (TickType_t)timeout) != pdPASS) {
+    if (timeout != 0U) {
+      stat = osErrorTimeout;
+    } else {
+      stat = osErrorResource;
+    }
+  }
+  else {
+    /* A free slot is reserved for this message */
+    taskENTER_CRITICAL();
+    slot = MQueueAlloc (mq);
+    taskEXIT_CRITICAL();
+
+    memcpy (&MQueueSlot (mq, slot)[sizeof(MsgQueueSlot_t)], msg_ptr, mq->msg_sz);
+
+    taskENTER_CRITICAL();
+    MQueueLink (mq, slot, msg_prio);
+    taskEXIT_CRITICAL();
+
+    (void)xSemaphoreGive (mq->msg_sem);
+  }
+
+  return (stat);
+}
+
+osStatus_t osMessageQueuePutFromISR (osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio) {
+  MsgQueue_t *mq = (MsgQueue_t *)mq_id;
+  osStatus_t stat;
+  BaseType_t yield;
+  uint32_t isrm;
+  uint16_t slot;
+
+  stat = osOK;
+  yield = pdFALSE;
+
+  if ((mq == NULL) || (msg_ptr == NULL) || ((mq->status & MQUEUE_STATUS) != MQUEUE_STATUS)) {
+    stat = osErrorParameter;
+  }
+  else if (xSemaphoreTakeFromISR (mq->spc_sem, &yield) != pdPASS) {
+    stat = osErrorResource;
+  }
+  else {
+    /* A free slot is reserved for this message */
+    isrm = taskENTER_CRITICAL_FROM_ISR();
+    slot = MQueueAlloc (mq);
+    taskEXIT_CRITICAL_FROM_ISR(isrm);
+
+    memcpy (&MQueueSlot (mq, slot)[sizeof(MsgQueueSlot_t)], msg_ptr, mq->msg_sz);
+
+    isrm = taskENTER_CRITICAL_FROM_ISR();
+    MQueueLink (mq, slot, msg_prio);
+    taskEXIT_CRITICAL_FROM_ISR(isrm);
+
+    (void)xSemaphoreGiveFromISR (mq->msg_sem, &yield);
+    portYIELD_FROM_ISR (yield);
+  }
+
+  return (stat);
+}
+
+osStatus_t osMessageQueueGetFromTask (osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout) {
+  MsgQueue_t *mq = (MsgQueue_t *)mq_id;
+  osStatus_t stat;
+  uint16_t slot;
+  uint8_t *p;
+
+  stat = osOK;
+
+  if ((mq == NULL) || (msg_ptr == NULL) || ((mq->status & MQUEUE_STATUS) != MQUEUE_STATUS)) {
+    stat = osErrorParameter;
+  }
+  else if (xSemaphoreTake (mq->msg_sem, (TickType_t)timeout) != pdPASS) {
+    if (timeout != 0U) {
+      stat = osErrorTimeout;
+    } else {
+      stat = osErrorResource;
+    }
+  }
+  else {
+    /* A queued message is reserved for this call */
+    taskENTER_CRITICAL();
+    slot = MQueueUnlink (mq);
+    taskEXIT_CRITICAL();
+
+    p = MQueueSlot (mq, slot);
+    memcpy (msg_ptr, &p[sizeof(MsgQueueSlot_t)], mq->msg_sz);
+    if (msg_prio != NULL) {
+      *msg_prio = ((MsgQueueSlot_t *)p)->prio;
+    }
+
+    taskENTER_CRITICAL();
+    MQueueFree (mq, slot);
+    taskEXIT_CRITICAL();
+
+    (void)xSemaphoreGive (mq->spc_sem);
+  }
+
+  return (stat);
+}
+
+osStatus_t osMessageQueueGetFromISR (osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio) {
+  MsgQueue_t *mq = (MsgQueue_t *)mq_id;
+  osStatus_t stat;
+  BaseType_t yield;
+  uint32_t isrm;
+  uint16_t slot;
+  uint8_t *p;
+
+  stat = osOK;
+  yield = pdFALSE;
+
+  if ((mq == NULL) || (msg_ptr == NULL) || ((mq->status & MQUEUE_STATUS) != MQUEUE_STATUS)) {
+    stat = osErrorParameter;
+  }
+  else if (xSemaphoreTakeFromISR (mq->msg_sem, &yield) != pdPASS) {
+    stat = osErrorResource;
+  }
+  else {
+    /* A queued message is reserved for this call */
+    isrm = taskENTER_CRITICAL_FROM_ISR();
+    slot = MQueueUnlink (mq);
+    taskEXIT_CRITICAL_FROM_ISR(isrm);
+
+    p = MQueueSlot (mq, slot);
+    memcpy (msg_ptr, &p[sizeof(MsgQueueSlot_t)], mq->msg_sz);
+    if (msg_prio != NULL) {
+      *msg_prio = ((MsgQueueSlot_t *)p)->prio;
+    }
+
+    isrm = taskENTER_CRITICAL_FROM_ISR();
+    MQueueFree (mq, slot);
+    taskEXIT_CRITICAL_FROM_ISR(isrm);
+
+    (void)xSemaphoreGiveFromISR (mq->spc_sem, &yield);
+    portYIELD_FROM_ISR (yield);
+  }
+
+  return (stat);
+}
+
+uint32_t osMessageQueueGetCapacity (osMessageQueueId_t mq_id) {
+  MsgQueue_t *mq = (MsgQueue_t *)mq_id;
+  uint32_t capacity;
+
+  if (mq == NULL) {
+    capacity = 0U;
+  } else {
+    capacity = mq->msg_cnt;
+  }
+
+  return (capacity);
+}
+
+uint32_t osMessageQueueGetMsgSize (osMessageQueueId_t mq_id) {
+  MsgQueue_t *mq = (MsgQueue_t *)mq_id;
+  uint32_t size;
+
+  if (mq == NULL) {
+    size = 0U;
+  } else {
+    size = mq->msg_sz;
+  }
+
+  return (size);
+}
+
+uint32_t osMessageQueueGetCount (osMessageQueueId_t mq_id) {
+  MsgQueue_t *mq = (MsgQueue_t *)mq_id;
+  UBaseType_t count;
+
+  if (mq == NULL) {
+    count = 0U;
+  }
+  else if (IS_IRQ()) {
+    count = uxQueueMessagesWaitingFromISR (mq->msg_sem);
+  }
+  else {
+    count = uxQueueMessagesWaiting (mq->msg_sem);
+  }
+
+  return ((uint32_t)count);
+}
+
+uint32_t osMessageQueueGetSpace (osMessageQueueId_t mq_id) {
+  MsgQueue_t *mq = (MsgQueue_t *)mq_id;
+  UBaseType_t space;
+
+  if (mq == NULL) {
+    space = 0U;
+  }
+  else if (IS_IRQ()) {
+    space = uxQueueMessagesWaitingFromISR (mq->spc_sem);
+  }
+  else {
+    space = uxQueueMessagesWaiting (mq->spc_sem);
+  }
+
+  return ((uint32_t)space);
+}
+
+osStatus_t osMessageQueueReset (osMessageQueueId_t mq_id) {
+  MsgQueue_t *mq = (MsgQueue_t *)mq_id;
+  osStatus_t stat;
+  uint16_t slot;
+
+  if (IS_IRQ()) {
+    stat = osErrorISR;
+  }
+  else if (mq == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    stat = osOK;
+
+    /* Discard the messages one by one, so blocked senders are released */
+    while (xSemaphoreTake (mq->msg_sem, 0U) == pdPASS) {
+      taskENTER_CRITICAL();
+      slot = MQueueUnlink (mq);
+      MQueueFree (mq, slot);
+      taskEXIT_CRITICAL();
+
+      (void)xSemaphoreGive (mq->spc_sem);
+    }
+  }
+
+  return (stat);
+}
+
+osStatus_t osMessageQueueDelete (osMessageQueueId_t mq_id) {
+  MsgQueue_t *mq = (MsgQueue_t *)mq_id;
+  osStatus_t stat;
+
+#ifndef USE_FreeRTOS_HEAP_1
+  if (IS_IRQ()) {
+    stat = osErrorISR;
+  }
+  else if (mq == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    #if (configQUEUE_REGISTRY_SIZE > 0)
+    vQueueUnregisterQueue (mq->msg_sem);
+    #endif
+
+    stat = osOK;
+
+    /* Invalidate control block status */
+    mq->status = mq->status & 3U;
+
+    vSemaphoreDelete (mq->msg_sem);
+    vSemaphoreDelete (mq->spc_sem);
+
+    if ((mq->status & 2U) != 0U) {
+      /* Message array on heap */
+      vPortFree (mq->mem_arr);
+    }
+    if ((mq->status & 1U) != 0U) {
+      /* Control block on heap */
+      vPortFree (mq);
+    }
+  }
+#else
+  stat = osError;
+#endif
+
+  return (stat);
+}
+
+/*
+  Map a message priority (0..255) onto its bucket.
+*/
+static uint32_t MQueueBucket (uint8_t msg_prio) {
+  return (((uint32_t)msg_prio * MQUEUE_LEVELS) >> 8);
+}
+
+/*
+  Take a slot off the free list. The caller holds a space semaphore token, so the
+  list is not empty. Must be called from a critical section.
+*/
+static uint16_t MQueueAlloc (MsgQueue_t *mq) {
+  uint16_t slot;
+
+  slot = mq->free;
+  configASSERT (slot != MQUEUE_NIL);
+  mq->free = ((MsgQueueSlot_t *)MQueueSlot (mq, slot))->next;
+
+  return (slot);
+}
+
+/*
+  Append a filled slot to the list of its bucket. Must be called from a critical
+  section.
+*/
+static void MQueueLink (MsgQueue_t *mq, uint16_t slot, uint8_t msg_prio) {
+  MsgQueueSlot_t *s = (MsgQueueSlot_t *)MQueueSlot (mq, slot);
+  uint32_t b = MQueueBucket (msg_prio);
+
+  s->next = MQUEUE_NIL;
+  s->prio = msg_prio;
+
+  if (mq->tail[b] == MQUEUE_NIL) {
+    mq->head[b] = slot;
+    mq->bitmap |= (1UL << b);
+  } else {
+    ((MsgQueueSlot_t *)MQueueSlot (mq, mq->tail[b]))->next = slot;
+  }
+  mq->tail[b] = slot;
+}
+
+/*
+  Remove the oldest message of the highest non-empty bucket. The caller holds a
+  message semaphore token, so there is one. Must be called from a critical section.
+*/
+static uint16_t MQueueUnlink (MsgQueue_t *mq) {
+  uint32_t b;
+  uint16_t slot;
+
+  configASSERT (mq->bitmap != 0U);
+  b = 31U - __CLZ (mq->bitmap);
+
+  slot = mq->head[b];
+  mq->head[b] = ((MsgQueueSlot_t *)MQueueSlot (mq, slot))->next;
+
+  if (mq->head[b] == MQUEUE_NIL) {
+    mq->tail[b] = MQUEUE_NIL;
+    mq->bitmap &= ~(1UL << b);
+  }
+
+  return (slot);
+}
+
+/*
+  Return a slot to the free list. Must be called from a critical section.
+*/
+static void MQueueFree (MsgQueue_t *mq, uint16_t slot) {
+  ((MsgQueueSlot_t *)MQueueSlot (mq, slot))->next = mq->free;
+  mq->free = slot;
+}
+
+/*
+  Address of a slot.
+*/
+static uint8_t *MQueueSlot (MsgQueue_t *mq, uint16_t slot) {
+  return (&mq->mem_arr[(uint32_t)slot * mq->slot_sz]);
+}
+
+#endif /* (configUSE_OS2_MESSAGE_PRIORITY == 1) */
+
 /*---------------------------------------------------------------------------*/
 #ifdef FREERTOS_MPOOL_H_
 
+/*
+  Memory pools keep their free blocks on a lock-free list. The head is one word, a
+  block index and a tag bumped on every update, changed with LDREX/STREX, so an
+  allocation or a free is a few loads and stores, never masks interrupts and is safe
+  from any interrupt priority. A block popped and pushed back between the load and
+  the store changes the tag, so the store cannot succeed on a stale next index (ABA).
+  The semaphore is only used to wake tasks blocked on an empty pool.
+*/
+
 /* Static memory pool functions */
-static void  FreeBlock   (MemPool_t *mp, void *block);
-static void *AllocBlock  (MemPool_t *mp);
-static void *CreateBlock (MemPool_t *mp);
+static void    *AllocBlock (MemPool_t *mp);
+static void     FreeBlock  (MemPool_t *mp, void *block);
+static void     AtomicAdd  (volatile uint32_t *p, uint32_t n);
 
 osMemoryPoolId_t osMemoryPoolNew (uint32_t block_count, uint32_t block_size, const osMemoryPoolAttr_t *attr) {
   MemPool_t *mp;
   const char *name;
   int32_t mem_cb, mem_mp;
   uint32_t sz;
+  uint32_t i;
 
   if (IS_IRQ()) {
     mp = NULL;
   }
-  else if ((block_count == 0U) || (block_size == 0U)) {
+  else if ((block_count == 0U) || (block_count >= MPOOL_NIL) || (block_size == 0U)) {
     mp = NULL;
   }
   else {
@@ -2013,13 +2759,15 @@ osMemoryPoolId_t osMemoryPoolNew (uint32_t block_count, uint32_t block_size, con
     }
 
     if (mp != NULL) {
-      /* Create a semaphore (max count == initial count == block_count) */
+      mp->mem_arr = NULL;
+
+      /* Create a semaphore (max count == block_count, initial count == 0) */
       #if (configSUPPORT_STATIC_ALLOCATION == 1)
-        mp->sem = xSemaphoreCreateCountingStatic (block_count, block_count, &mp->mem_sem);
+        mp->sem = xSemaphoreCreateCountingStatic (block_count, 0U, &mp->mem_sem);
       #elif (configSUPPORT_DYNAMIC_ALLOCATION == 1)
-        mp->sem = xSemaphoreCreateCounting (block_count, block_count);
+        mp->sem = xSemaphoreCreateCounting (block_count, 0U);
       #else
-        mp->sem == NULL;
+        mp->sem = NULL;
       #endif
 
       if (mp->sem != NULL) {
@@ -2034,12 +2782,20 @@ osMemoryPoolId_t osMemoryPoolNew (uint32_t block_count, uint32_t block_size, con
 
     if ((mp != NULL) && (mp->mem_arr != NULL)) {
       /* Memory pool can be created */
-      mp->head    = NULL;
       mp->mem_sz  = sz;
       mp->name    = name;
       mp->bl_sz   = block_size;
       mp->bl_cnt  = block_count;
-      mp->n       = 0U;
+      mp->bl_step = MEMPOOL_ARR_SIZE (1U, block_size);
+      mp->used    = 0U;
+      mp->waiters = 0U;
+
+      /* Chain every block into the free list, tag 0 */
+      for (i = 0U; i < block_count; i++) {
+        ((MemPoolBlock_t *)(mp->mem_arr + (mp->bl_step * i)))->next = i + 1U;
+      }
+      ((MemPoolBlock_t *)(mp->mem_arr + (mp->bl_step * (block_count - 1U))))->next = MPOOL_NIL;
+      mp->head = 0U;
 
       /* Set heap allocated memory flags */
       mp->status = MPOOL_STATUS;
@@ -2055,6 +2811,9 @@ osMemoryPoolId_t osMemoryPoolNew (uint32_t block_count, uint32_t block_size, con
     }
     else {
       /* Memory pool cannot be created, release allocated resources */
+      if ((mp != NULL) && (mp->sem != NULL)) {
+        vSemaphoreDelete (mp->sem);
+      }
       if ((mem_cb == 0) && (mp != NULL)) {
         /* Free control block memory */
         vPortFree (mp);
@@ -2086,7 +2845,8 @@ const char *osMemoryPoolGetName (osMemoryPoolId_t mp_id) {
 void *osMemoryPoolAlloc (osMemoryPoolId_t mp_id, uint32_t timeout) {
   MemPool_t *mp;
   void *block;
-  uint32_t isrm;
+  TimeOut_t xTimeOut;
+  TickType_t xTicks;
 
   if (mp_id == NULL) {
     /* Invalid input parameters */
@@ -2097,42 +2857,39 @@ void *osMemoryPoolAlloc (osMemoryPoolId_t mp_id, uint32_t timeout) {
 
     mp = (MemPool_t *)mp_id;
 
-    if ((mp->status & MPOOL_STATUS) == MPOOL_STATUS) {
-      if (IS_IRQ()) {
-        if (timeout == 0U) {
-          if (xSemaphoreTakeFromISR (mp->sem, NULL) == pdTRUE) {
-            if ((mp->status & MPOOL_STATUS) == MPOOL_STATUS) {
-              isrm  = taskENTER_CRITICAL_FROM_ISR();
+    if (IS_IRQ() && (timeout != 0U)) {
+      /* ISRs cannot wait */
+      block = NULL;
+    }
+    else if ((mp->status & MPOOL_STATUS) == MPOOL_STATUS) {
+      /* Get a block from the free-list, from task or ISR at any priority */
+      block = AllocBlock (mp);
 
-              /* Get a block from the free-list */
-              block = AllocBlock(mp);
+      if ((block == NULL) && (timeout != 0U)) {
+        /* Pool is empty, block until a block is freed */
+        vTaskSetTimeOutState (&xTimeOut);
+        xTicks = (TickType_t)timeout;
 
-              if (block == NULL) {
-                /* List of free blocks is empty, 'create' new block */
-                block = CreateBlock(mp);
-              }
+        /* Announce the waiter before looking again, so a free in between gives
+           the semaphore */
+        AtomicAdd (&mp->waiters, 1U);
 
-              taskEXIT_CRITICAL_FROM_ISR(isrm);
-            }
-          }
-        }
-      }
-      else {
-        if (xSemaphoreTake (mp->sem, (TickType_t)timeout) == pdTRUE) {
-          if ((mp->status & MPOOL_STATUS) == MPOOL_STATUS) {
-            taskENTER_CRITICAL();
+        while ((block == NULL) && ((mp->status & MPOOL_STATUS) == MPOOL_STATUS)) {
+          block = AllocBlock (mp);
 
-            /* Get a block from the free-list */
-            block = AllocBlock(mp);
-
-            if (block == NULL) {
-              /* List of free blocks is empty, 'create' new block */
-              block = CreateBlock(mp);
+          if (block == NULL) {
+            if (xSemaphoreTake (mp->sem, xTicks) != pdTRUE) {
+              break;
+            }
+            if (xTaskCheckForTimeOut (&xTimeOut, &xTicks) != pdFALSE) {
+              /* Last chance for the block that woke us */
+              block = AllocBlock (mp);
+              break;
             }
-
-            taskEXIT_CRITICAL();
           }
         }
+
+        AtomicAdd (&mp->waiters, (uint32_t)-1);
       }
     }
   }
@@ -2143,7 +2900,6 @@ void *osMemoryPoolAlloc (osMemoryPoolId_t mp_id, uint32_t timeout) {
 osStatus_t osMemoryPoolFree (osMemoryPoolId_t mp_id, void *block) {
   MemPool_t *mp;
   osStatus_t stat;
-  uint32_t isrm;
   BaseType_t yield;
 
   if ((mp_id == NULL) || (block == NULL)) {
@@ -2157,43 +2913,32 @@ osStatus_t osMemoryPoolFree (osMemoryPoolId_t mp_id, void *block) {
       /* Invalid object status */
       stat = osErrorResource;
     }
-    else if ((block < (void *)&mp->mem_arr[0]) || (block > (void*)&mp->mem_arr[mp->mem_sz-1])) {
-      /* Block pointer outside of memory array area */
+    else if ((block < (void *)&mp->mem_arr[0]) || (block > (void*)&mp->mem_arr[mp->mem_sz-1]) ||
+             ((((uint8_t *)block - mp->mem_arr) % mp->bl_step) != 0U)) {
+      /* Block pointer outside of memory array area, or not at a block start */
       stat = osErrorParameter;
     }
+    else if (mp->used == 0U) {
+      /* Every block is already free */
+      stat = osErrorResource;
+    }
     else {
       stat = osOK;
 
-      if (IS_IRQ()) {
-        if (uxSemaphoreGetCountFromISR (mp->sem) == mp->bl_cnt) {
-          stat = osErrorResource;
-        }
-        else {
-          isrm = taskENTER_CRITICAL_FROM_ISR();
-
-          /* Add block to the list of free blocks */
-          FreeBlock(mp, block);
-
-          taskEXIT_CRITICAL_FROM_ISR(isrm);
+      /* Add block to the list of free blocks */
+      FreeBlock (mp, block);
 
+      /* Wake a blocked task. Only then is a FreeRTOS call made, so ISRs above
+         configMAX_SYSCALL_INTERRUPT_PRIORITY can free into pools that tasks do not
+         wait on. */
+      if (mp->waiters != 0U) {
+        if (IS_IRQ()) {
           yield = pdFALSE;
-          xSemaphoreGiveFromISR (mp->sem, &yield);
+          (void)xSemaphoreGiveFromISR (mp->sem, &yield);
           portYIELD_FROM_ISR (yield);
         }
-      }
-      else {
-        if (uxSemaphoreGetCount (mp->sem) == mp->bl_cnt) {
-          stat = osErrorResource;
-        }
         else {
-          taskENTER_CRITICAL();
-
-          /* Add block to the list of free blocks */
-          FreeBlock(mp, block);
-
-          taskEXIT_CRITICAL();
-
-          xSemaphoreGive (mp->sem);
+          (void)xSemaphoreGive (mp->sem);
         }
       }
     }
@@ -2266,13 +3011,7 @@ uint32_t osMemoryPoolGetCount (osMemoryPoolId_t mp_id) {
       n = 0U;
     }
     else {
-      if (IS_IRQ()) {
-        n = uxSemaphoreGetCountFromISR (mp->sem);
-      } else {
-        n = uxSemaphoreGetCount        (mp->sem);
-      }
-
-      n = mp->bl_cnt - n;
+      n = mp->used;
     }
   }
 
@@ -2296,11 +3035,7 @@ uint32_t osMemoryPoolGetSpace (osMemoryPoolId_t mp_id) {
       n = 0U;
     }
     else {
-      if (IS_IRQ()) {
-        n = uxSemaphoreGetCountFromISR (mp->sem);
-      } else {
-        n = uxSemaphoreGetCount        (mp->sem);
-      }
+      n = mp->bl_cnt - mp->used;
     }
   }
 
@@ -2330,7 +3065,7 @@ osStatus_t osMemoryPoolDelete (osMemoryPoolId_t mp_id) {
     /* Wake-up tasks waiting for pool semaphore */
     while (xSemaphoreGive (mp->sem) == pdTRUE);
 
-    mp->head    = NULL;
+    mp->head    = MPOOL_NIL;
     mp->bl_sz   = 0U;
     mp->bl_cnt  = 0U;
 
@@ -2351,52 +3086,127 @@ osStatus_t osMemoryPoolDelete (osMemoryPoolId_t mp_id) {
   return (stat);
 }
 
+#if ((__ARM_ARCH_7M__ == 1U) || (__ARM_ARCH_7EM__ == 1U) || (__ARM_ARCH_8M_MAIN__ == 1U))
+
 /*
-  Create new block given according to the current block index.
+  Allocate a block by popping the head of the list of free blocks. An exception
+  between LDREX and STREX clears the exclusive monitor and makes the store fail.
 */
-static void *CreateBlock (MemPool_t *mp) {
-  MemPoolBlock_t *p = NULL;
+static void *AllocBlock (MemPool_t *mp) {
+  uint32_t head, idx;
+  MemPoolBlock_t *p;
 
-  if (mp->n < mp->bl_cnt) {
-    /* Unallocated blocks exist, set pointer to new block */
-    p = (void *)(mp->mem_arr + (mp->bl_sz * mp->n));
+  do {
+    head = __LDREXW (&mp->head);
+    idx  = head & MPOOL_NIL;
 
-    /* Increment block index */
-    mp->n += 1U;
-  }
+    if (idx == MPOOL_NIL) {
+      /* List of free blocks is empty */
+      __CLREX();
+      return (NULL);
+    }
+
+    p = (MemPoolBlock_t *)(mp->mem_arr + (mp->bl_step * idx));
+  } while (__STREXW (((head + 0x10000U) & ~MPOOL_NIL) | p->next, &mp->head) != 0U);
+
+  AtomicAdd (&mp->used, 1U);
 
   return (p);
 }
 
 /*
-  Allocate a block by reading the list of free blocks.
+  Free block by pushing it onto the list of free blocks.
+*/
+static void FreeBlock (MemPool_t *mp, void *block) {
+  MemPoolBlock_t *p = block;
+  uint32_t head, idx;
+
+  idx = (uint32_t)((uint8_t *)block - mp->mem_arr) / mp->bl_step;
+
+  AtomicAdd (&mp->used, (uint32_t)-1);
+
+  do {
+    head = __LDREXW (&mp->head);
+
+    /* Store current head into block memory space */
+    p->next = head & MPOOL_NIL;
+
+    /* The link must be visible before the block is */
+    __DMB();
+  } while (__STREXW (((head + 0x10000U) & ~MPOOL_NIL) | idx, &mp->head) != 0U);
+}
+
+/*
+  Add n to a counter shared with ISRs of any priority.
+*/
+static void AtomicAdd (volatile uint32_t *p, uint32_t n) {
+  uint32_t v;
+
+  do {
+    v = __LDREXW (p);
+  } while (__STREXW (v + n, p) != 0U);
+}
+
+#else
+
+/*
+  No exclusive access instructions: the list is updated with interrupts disabled,
+  which is still safe from any interrupt priority.
 */
 static void *AllocBlock (MemPool_t *mp) {
   MemPoolBlock_t *p = NULL;
+  uint32_t primask;
+  uint32_t idx;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
 
-  if (mp->head != NULL) {
+  idx = mp->head & MPOOL_NIL;
+
+  if (idx != MPOOL_NIL) {
     /* List of free block exists, get head block */
-    p = mp->head;
+    p = (MemPoolBlock_t *)(mp->mem_arr + (mp->bl_step * idx));
 
     /* Head block is now next on the list */
-    mp->head = p->next;
+    mp->head = ((mp->head + 0x10000U) & ~MPOOL_NIL) | p->next;
+    mp->used += 1U;
   }
 
+  __set_PRIMASK (primask);
+
   return (p);
 }
 
-/*
-  Free block by putting it to the list of free blocks.
-*/
 static void FreeBlock (MemPool_t *mp, void *block) {
   MemPoolBlock_t *p = block;
+  uint32_t primask;
+  uint32_t idx;
+
+  idx = (uint32_t)((uint8_t *)block - mp->mem_arr) / mp->bl_step;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
 
   /* Store current head into block memory space */
-  p->next = mp->head;
+  p->next = mp->head & MPOOL_NIL;
 
   /* Store current block as new head */
-  mp->head = p;
+  mp->head = ((mp->head + 0x10000U) & ~MPOOL_NIL) | idx;
+  mp->used -= 1U;
+
+  __set_PRIMASK (primask);
 }
+
+static void AtomicAdd (volatile uint32_t *p, uint32_t n) {
+  uint32_t primask;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  *p += n;
+  __set_PRIMASK (primask);
+}
+
+#endif
 #endif /* FREERTOS_MPOOL_H_ */
 /*---------------------------------------------------------------------------*/
 
@@ -138,6 +138,42 @@ typedef struct xHeapStats
 	size_t xNumberOfSuccessfulFrees;		/* The number of calls to vPortFree() that has successfully freed a block of memory. */
 } HeapStats_t;
 
+/* Used to pass information about each heap_4.c slab class out of
+uxPortGetSlabStats() when configUSE_HEAP_SLABS is 1. */
+typedef struct xSlabStats
+{
+	size_t xObjectSizeInBytes;			/* The exact request size served by the class. */
+	size_t xNumberOfSlabs;				/* The number of slabs taken from the heap for the class.  They are never given back. */
+	size_t xNumberOfObjects;			/* The number of objects in those slabs, free or in use. */
+	size_t xObjectsInUse;				/* The number of objects currently allocated. */
+	size_t xMaximumEverObjectsInUse;	/* The most objects there have been allocated at once since the system booted. */
+} SlabStats_t;
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	/* One entry of HeapInstrumentation_t.xCallers[]. */
+	typedef struct xHeapCallerStats
+	{
+		void *pvCaller;							/* Return address of the pvPortMalloc() call.  NULL in the last entry, which collects the callers that did not fit. */
+		size_t xOutstandingBytes;				/* Bytes, headers and padding included, allocated from here and not yet freed. */
+		size_t xOutstandingBlocks;				/* Blocks allocated from here and not yet freed. */
+		size_t xMaximumEverOutstandingBytes;	/* The most xOutstandingBytes has been since the system booted. */
+	} HeapCallerStats_t;
+
+	/* Used to pass the heap_4.c instrumentation out of
+	vPortGetHeapInstrumentation(). */
+	typedef struct xHeapInstrumentation
+	{
+		size_t xAllocationsBySize[ configHEAP_HISTOGRAM_BUCKETS ];	/* Successful pvPortMalloc() calls by requested size.  Bucket n counts sizes of up to 16 << n bytes, the last bucket everything larger. */
+		size_t xOutstandingBySize[ configHEAP_HISTOGRAM_BUCKETS ];	/* Of those, the blocks not yet freed. */
+		HeapCallerStats_t xCallers[ configHEAP_INSTRUMENTATION_CALLERS ];
+		size_t xOutstandingBytes;				/* Bytes allocated and not yet freed, headers and padding included. */
+		size_t xMaximumEverOutstandingBytes;	/* The most xOutstandingBytes has been since the system booted.  configTOTAL_HEAP_SIZE needs to be at least this, plus room for fragmentation. */
+		size_t xFailedAllocations;				/* The number of calls to pvPortMalloc() that returned NULL. */
+	} HeapInstrumentation_t;
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
 /*
  * Used to define multiple heap regions for use by heap_5.c.  This function
  * must be called before any calls to pvPortMalloc() - not creating a task,
@@ -151,12 +187,53 @@ typedef struct xHeapStats
  */
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
+/*
+ * Only provided by heap_4.c, and only when configUSE_HEAP_REGIONS is 1.  The
+ * heap is then made of up to configHEAP_MAX_REGIONS regions, given to
+ * vPortDefineHeapRegions() before the first allocation or, failing that,
+ * returned by vApplicationGetHeapRegions() when the first allocation is made.
+ * Regions are numbered from 0 in array order.
+ *
+ * pvPortMalloc() takes the first fit in any region, lowest address first.
+ * pvPortMallocRegion() only allocates from region xRegion, for memory that
+ * must be in a given bank, such as DMA buffers.  Both are freed with
+ * vPortFree().  xPortGetFreeHeapSizeRegion() returns the free bytes of one
+ * region.
+ */
+#if( configUSE_HEAP_REGIONS == 1 )
+	void vApplicationGetHeapRegions( const HeapRegion_t **ppxHeapRegions );
+	void *pvPortMallocRegion( size_t xWantedSize, BaseType_t xRegion ) PRIVILEGED_FUNCTION;
+	size_t xPortGetFreeHeapSizeRegion( BaseType_t xRegion ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Returns a HeapStats_t structure filled with information about the current
  * heap state.
  */
 void vPortGetHeapStats( HeapStats_t *pxHeapStats );
 
+/*
+ * Fills up to uxArraySize SlabStats_t structures, one per slab class, and
+ * returns the number filled.  Only provided by heap_4.c, and only when
+ * configUSE_HEAP_SLABS is 1.  Free objects held by a class are
+ * xNumberOfObjects - xObjectsInUse; fragmentation of the heap itself is
+ * reported by vPortGetHeapStats().
+ */
+UBaseType_t uxPortGetSlabStats( SlabStats_t *pxSlabStats, UBaseType_t uxArraySize );
+
+/*
+ * Only provided by heap_4.c, and only when configUSE_HEAP_INSTRUMENTATION is 1.
+ * vPortGetHeapInstrumentation() takes a consistent copy of the allocation size
+ * histogram and the per caller totals.  vPortHeapReport() writes them as text,
+ * together with the vPortGetHeapStats() and slab figures, to pcWriteBuffer.
+ * The report is truncated to xBufferLength - 1 characters; 1024 bytes is
+ * enough for the default number of callers.
+ */
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	void vPortGetHeapInstrumentation( HeapInstrumentation_t *pxHeapInstrumentation );
+	void vPortHeapReport( char *pcWriteBuffer, size_t xBufferLength );
+#endif
+
 /*
  * Map to the memory management routines required for the port.
  */
@@ -166,6 +243,26 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Only provided by heap_4.c.  Returns the number of bytes the caller may use
+ * in a block returned by pvPortMalloc(), which can be more than it asked for,
+ * or 0 if pv is NULL.  realloc() needs it when newlib's allocator is routed to
+ * the FreeRTOS heap (configUSE_NEWLIB_MALLOC_HEAP).
+ */
+size_t xPortGetAllocationSize( void *pv ) PRIVILEGED_FUNCTION;
+
+/*
+ * pvPortRealloc() resizes a block returned by pvPortMalloc() as realloc()
+ * does, and pvPortCalloc() allocates xNum * xSize zeroed bytes, or returns NULL
+ * if the product overflows.  heap_4.c shrinks a block in place, and grows it in
+ * place when the block just above it is free and large enough, so only copies
+ * as a last resort.  When its heap is a static array, which the C startup
+ * code clears, pvPortCalloc() only clears the part of the block that has been
+ * written since boot.
+ */
+void *pvPortRealloc( void *pv, size_t xWantedSize ) PRIVILEGED_FUNCTION;
+void *pvPortCalloc( size_t xNum, size_t xSize ) PRIVILEGED_FUNCTION;
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
@@ -52,7 +52,7 @@
 		/* Is the currently saved stack pointer within the stack limit? */								\
 		if( pxCurrentTCB->pxTopOfStack <= pxCurrentTCB->pxStack )										\
 		{																								\
-			vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, pxCurrentTCB->pcTaskName );	\
+			vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, ( char * ) pxCurrentTCB->pcTaskName );	\
 		}																								\
 	}
 
@@ -68,7 +68,7 @@
 		/* Is the currently saved stack pointer within the stack limit? */								\
 		if( pxCurrentTCB->pxTopOfStack >= pxCurrentTCB->pxEndOfStack )									\
 		{																								\
-			vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, pxCurrentTCB->pcTaskName );	\
+			vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, ( char * ) pxCurrentTCB->pcTaskName );	\
 		}																								\
 	}
 
@@ -87,7 +87,7 @@
 			( pulStack[ 2 ] != ulCheckValue ) ||														\
 			( pulStack[ 3 ] != ulCheckValue ) )															\
 		{																								\
-			vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, pxCurrentTCB->pcTaskName );	\
+			vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, ( char * ) pxCurrentTCB->pcTaskName );	\
 		}																								\
 	}
 
@@ -111,7 +111,7 @@
 		/* Has the extremity of the task stack ever been written over? */																\
 		if( memcmp( ( void * ) pcEndOfStack, ( void * ) ucExpectedStackBytes, sizeof( ucExpectedStackBytes ) ) != 0 )					\
 		{																																\
-			vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, pxCurrentTCB->pcTaskName );									\
+			vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, ( char * ) pxCurrentTCB->pcTaskName );									\
 		}																																\
 	}
 
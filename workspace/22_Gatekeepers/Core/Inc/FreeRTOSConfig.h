@@ -125,6 +125,7 @@ to exclude the API function. */
  * by the application thus the correct define need to be enabled below
  */
 #define USE_FreeRTOS_HEAP_4
+/* #define USE_FreeRTOS_HEAP_TLSF */	/* Instead of HEAP_4: heap_tlsf.c, O(1) malloc and free */
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -168,6 +169,39 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Port optimised task selection: the CM4F port finds the highest ready
+priority with CLZ on a ready-priority bitmap instead of walking the ready
+lists.  The 56 CMSIS-RTOS2 priorities take a two-level bitmap, so selection is
+two CLZs whatever the priorities in use (see README, Task Selection). */
+#undef configUSE_PORT_OPTIMISED_TASK_SELECTION
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
+/* The UART gatekeeper drains its queue in batches (gatekeeper.c). */
+#define configUSE_QUEUE_BATCH                    1
+/* The analog pipeline passes its buffers between stages by reference
+(pipeline.c). */
+#define configUSE_QUEUE_REFERENCES               1
+/* The heap takes the SRAM1 and SRAM2 left free by the linker (heap_regions.c)
+instead of configTOTAL_HEAP_SIZE, and the ADC buffers come from SRAM2. */
+#define configUSE_HEAP_REGIONS                   1
+/* Tasks format with fmt.c and never call newlib's stdio, so they need no
+struct _reent of their own. */
+#undef configUSE_NEWLIB_REENTRANT
+#define configUSE_NEWLIB_REENTRANT               0
+/* Each queue counts its traffic; the print task reports the queues of the
+registry (vPrintQueueMetrics() in main.c). */
+#define configUSE_QUEUE_METRICS                  1
+/* Registered objects are hashed by name instead of held in an array of
+configQUEUE_REGISTRY_SIZE entries, which is then only the number of queues
+vPrintQueueMetrics() reports. */
+#define configUSE_OBJECT_REGISTRY                1
+/* The idle task sleeps the CPU until the next interrupt instead of spinning
+between ticks (see README, Idle Sleep). */
+#define configUSE_IDLE_SLEEP                     1
+/* Tasks record when they last left the Ready state, so the settings table
+(cfgstore.c) can tell when an old version is no longer read. */
+#define configUSE_QUIESCENT_STATES               1
+/* USART2 receives the console commands of vConfigTask (uart.c). */
+#define UART_RX_RING_SIZE                        64
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -11,9 +11,85 @@
 #define ADC_H
 
 /* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define ADC_SCAN_MAX_CHANNELS		16U		/* Regular sequence length. */
+#define ADC_INJECTED_MAX_CHANNELS	4U
+#define ADC_SCAN_MAX_OVERSAMPLE_LOG2 8U
+#define ADC_CHANNEL_VREFINT			17U
+#define ADC_CHANNEL_TEMPERATURE		18U
+#define ADC_WATCH_MAX				0xFFFU	/* 12-bit full scale. */
+
+#ifndef ADC_IRQ_PRIORITY
+#define ADC_IRQ_PRIORITY 6U		/* At or below configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	const uint8_t *pucChannels;	/* Sequence of ucCount channels, 0..18. */
+	uint8_t ucCount;			/* 1..ADC_SCAN_MAX_CHANNELS */
+	uint8_t ucSampleTime;		/* SMPR code 0..7 (3 to 480 ADC clocks), every channel. */
+	uint8_t ucOversampleLog2;	/* 2^n sequences are summed into each result. */
+	uint8_t ucShift;			/* Right shift of the sums; n / 2 for n / 2 extra bits. */
+	uint32_t ulRateHz;			/* Sequences per second (TIM2 update rate). */
+	uint16_t *pusRaw;			/* 2 * (ucCount << ucOversampleLog2) halfwords, for the DMA. */
+	TaskHandle_t xTask;			/* Notified once per result block, or NULL. */
+} AdcScanConfig_t;
+
+/* Where the watched channel is, with respect to the window. */
+typedef enum
+{
+	ADC_WATCH_INSIDE = 0,		/* usLow <= value <= usHigh */
+	ADC_WATCH_ABOVE,			/* Crossed usHigh; back inside below usHigh - usHysteresis. */
+	ADC_WATCH_BELOW				/* Crossed usLow; back inside above usLow + usHysteresis. */
+} AdcWatchZone_t;
+
+typedef struct
+{
+	uint8_t ucChannel;			/* Regular channel watched, 0..18. */
+	uint16_t usLow;				/* Window, 0..ADC_WATCH_MAX; usLow = 0 or */
+	uint16_t usHigh;			/* usHigh = ADC_WATCH_MAX watches one side only. */
+	uint16_t usHysteresis;		/* Margin to clear before coming back inside. */
+	TaskHandle_t xTask;			/* Notified on each change of zone, or NULL. */
+} AdcWatchConfig_t;
 
 /* Function Prototypes -------------------------------------------------------*/
 void adc_init(void);
 uint32_t read_analog_sensor(void);
+void read_analog_sensor_block(uint16_t *pusSamples, uint32_t ulCount);
+int32_t adc_stream_init(uint32_t ulSampleRateHz, uint16_t *pusBuf0, uint16_t *pusBuf1,
+		uint16_t usBlockSize, TaskHandle_t xTask);
+int32_t adc_stream_start(void);
+void adc_stream_stop(void);
+uint16_t *adc_stream_wait(TickType_t xTicksToWait);
+uint32_t adc_stream_get_overruns(void);
+int32_t adc_scan_init(const AdcScanConfig_t *pxConfig);
+int32_t adc_scan_start(void);
+void adc_scan_stop(void);
+uint32_t adc_scan_get_latest(uint16_t *pusValues);
+int32_t adc_scan_wait(uint16_t *pusValues, TickType_t xTicksToWait);
+uint32_t adc_scan_get_overruns(void);
+int32_t adc_interleaved_init(uint32_t ulChannel, uint32_t *pulBuf0, uint32_t *pulBuf1,
+		uint16_t usBlockWords, TaskHandle_t xTask);
+int32_t adc_interleaved_start(void);
+void adc_interleaved_stop(void);
+uint32_t *adc_interleaved_wait(TickType_t xTicksToWait);
+uint32_t adc_interleaved_get_rate(void);
+uint32_t adc_interleaved_get_overruns(void);
+int32_t adc_injected_init(const uint8_t *pucChannels, uint32_t ulCount, uint32_t ulSampleTime);
+int32_t adc_injected_read(uint16_t *pusValues);
+int32_t adc_ring_init(uint32_t ulSampleRateHz, uint16_t *pusRing, uint16_t usLength);
+int32_t adc_ring_start(void);
+void adc_ring_stop(void);
+uint16_t adc_ring_get_latest(void);
+int32_t adc_watch_init(const AdcWatchConfig_t *pxConfig);
+void adc_watch_stop(void);
+int32_t adc_watch_wait(uint16_t *pusValue, TickType_t xTicksToWait);
+AdcWatchZone_t adc_watch_get_zone(void);
+uint32_t adc_watch_get_events(void);
 
 #endif /* ADC_H */
@@ -0,0 +1,65 @@
+/*******************************************************************************
+ *
+ * @file	filter.h
+ * @brief	Interface of the block filters for 12-bit sensor samples.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef FILTER_H
+#define FILTER_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Data types ----------------------------------------------------------------*/
+
+/* FIR filter. The state holds the last (usTaps - 1) input samples followed by
+ * room for one block: (usTaps - 1 + usBlockSize) samples. */
+typedef struct
+{
+	const int16_t *psCoeffs;	/* Q15, usTaps of them. */
+	int16_t *psState;
+	uint16_t usTaps;			/* Even. */
+	uint16_t usBlockSize;		/* Largest block filter_fir_q15() is given. */
+} FirQ15_t;
+
+/* Second order IIR section (direct form I):
+ * y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+ * The coefficients are Q15 scaled down by 2^ucPostShift, so that |a1| up to 2
+ * fits. */
+typedef struct
+{
+	uint32_t ulB0B1;			/* b0 | b1 << 16 */
+	uint32_t ulB2NegA1;			/* b2 | -a1 << 16 */
+	uint32_t ulNegA2;			/* -a2 */
+	uint32_t ulX0X1;			/* x[n-1] | x[n-2] << 16 */
+	uint32_t ulY1Y2;			/* y[n-1] | y[n-2] << 16 */
+	uint8_t ucPostShift;
+} BiquadQ15_t;
+
+/* Moving average over a power of two number of samples. The history holds
+ * (1 << ucLog2Length) samples. */
+typedef struct
+{
+	int16_t *psHistory;
+	int32_t lSum;
+	uint16_t usIndex;
+	uint8_t ucLog2Length;
+} MovingAverageQ15_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+void filter_adc_to_q15(const uint16_t *pusIn, int16_t *psOut, uint32_t ulCount);
+uint32_t filter_q15_to_adc(int16_t sSample);
+int32_t filter_fir_init(FirQ15_t *pxFir, const int16_t *psCoeffs, uint16_t usTaps,
+		int16_t *psState, uint16_t usBlockSize);
+void filter_fir_q15(FirQ15_t *pxFir, const int16_t *psIn, int16_t *psOut, uint32_t ulCount);
+void filter_biquad_init(BiquadQ15_t *pxBiquad, const int16_t psCoeffs[5], uint8_t ucPostShift);
+void filter_biquad_q15(BiquadQ15_t *pxBiquad, const int16_t *psIn, int16_t *psOut, uint32_t ulCount);
+int32_t filter_moving_average_init(MovingAverageQ15_t *pxAverage, int16_t *psHistory,
+		uint8_t ucLog2Length);
+void filter_moving_average_q15(MovingAverageQ15_t *pxAverage, const int16_t *psIn,
+		int16_t *psOut, uint32_t ulCount);
+
+#endif /* FILTER_H */
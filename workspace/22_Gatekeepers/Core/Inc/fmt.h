@@ -0,0 +1,38 @@
+/*******************************************************************************
+ *
+ * @file	fmt.h
+ * @brief	Interface of the lightweight reentrant formatter.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef FMT_H
+#define FMT_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef FMT_PRINTF_CHUNK
+#define FMT_PRINTF_CHUNK 64U		/* Stack buffer of fmt_printf(), in bytes. */
+#endif
+
+#ifndef FMT_PRINTF_FILE
+#define FMT_PRINTF_FILE 1			/* _write() file of fmt_printf(): stdout. */
+#endif
+
+#define FMT_FLOAT_MAX_PRECISION	9U	/* Most digits after the point for %f. */
+
+/* Checks the arguments against the format, as for printf(). */
+#define FMT_CHECK(fmt_arg, va_arg)	__attribute__((format(printf, fmt_arg, va_arg)))
+
+/* Function Prototypes -------------------------------------------------------*/
+int fmt_snprintf(char *pcBuffer, size_t xSize, const char *pcFormat, ...) FMT_CHECK(3, 4);
+int fmt_vsnprintf(char *pcBuffer, size_t xSize, const char *pcFormat, va_list xArgs);
+int fmt_printf(const char *pcFormat, ...) FMT_CHECK(1, 2);
+int fmt_vprintf(const char *pcFormat, va_list xArgs);
+
+#endif /* FMT_H */
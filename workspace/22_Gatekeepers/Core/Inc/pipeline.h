@@ -0,0 +1,117 @@
+/*******************************************************************************
+ *
+ * @file	pipeline.h
+ * @brief	Interface of the zero-copy multi-stage processing pipeline.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "cmsis_os2.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef PIPELINE_MAX_STAGES
+#define PIPELINE_MAX_STAGES 4U
+#endif
+
+#ifndef PIPELINE_MAX_BATCH
+#define PIPELINE_MAX_BATCH 8U			/* Largest batch of a stage. */
+#endif
+
+#ifndef PIPELINE_STACK_WORDS
+#define PIPELINE_STACK_WORDS 256U		/* Each stage task, with its process function. */
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulSequence;		/* Submission order, from 0. */
+	uint32_t ulLength;			/* Bytes of ucData in use, kept up to date by the stages. */
+	uint32_t ulSubmitCycles;	/* CYCCNT at pipeline_submit(). */
+	uint32_t ulHandoffCycles;	/* CYCCNT when handed to its current stage. */
+	uint8_t ucData[];			/* ulBufferBytes, word aligned. */
+} PipelineBuffer_t;
+
+/* Processes a batch of buffers in place, oldest first. When it returns, they
+ * all move on to the next stage, or back to the pool after the last one, so
+ * it must keep no reference to them. */
+typedef void (*PipelineProcess_t)(void *pvContext, PipelineBuffer_t * const *ppxBuffers,
+		uint32_t ulCount);
+
+typedef struct
+{
+	const char *pcName;			/* Name of the stage task and its queue. */
+	PipelineProcess_t pxProcess;
+	void *pvContext;			/* First argument of pxProcess. */
+	UBaseType_t uxPriority;		/* Priority of the stage task. */
+	uint32_t ulBatch;			/* Most buffers per call, 1..PIPELINE_MAX_BATCH. */
+	TickType_t xBatchTicks;		/* Longest wait for a full batch after its first buffer. */
+} PipelineStageConfig_t;
+
+typedef struct
+{
+	uint32_t ulBuffers;			/* Buffers processed. */
+	uint32_t ulBatches;			/* Calls of the process function. */
+	uint32_t ulDepth;			/* Buffers queued for the stage now. */
+	uint32_t ulPeakDepth;		/* Most buffers queued at once. */
+	uint32_t ulMinWaitCycles;	/* Handed over to the start of its batch. */
+	uint32_t ulMaxWaitCycles;
+	uint64_t ullTotalWaitCycles;
+	uint32_t ulMaxBatchCycles;	/* Longest call of the process function. */
+	uint64_t ullTotalBatchCycles;
+} PipelineStageStats_t;
+
+typedef struct
+{
+	uint32_t ulSubmitted;		/* Buffers submitted. */
+	uint32_t ulCompleted;		/* Buffers through the last stage. */
+	uint32_t ulAllocFailures;	/* pipeline_alloc() calls that got no buffer. */
+	uint32_t ulInUse;			/* Buffers out of the pool now. */
+	uint32_t ulMinLatencyCycles;	/* Submit to the end of the last stage. */
+	uint32_t ulMaxLatencyCycles;
+	uint64_t ullTotalLatencyCycles;
+} PipelineStats_t;
+
+typedef struct
+{
+	PipelineStageConfig_t xConfig;
+	QueueHandle_t xQueue;		/* References to the buffers waiting for the stage. */
+	QueueHandle_t xNext;		/* Queue of the next stage, NULL for the last one. */
+	void *pvPipeline;			/* Pipeline_t of the stage. */
+	TaskHandle_t xTask;
+	PipelineStageStats_t xStats;
+} PipelineStage_t;
+
+typedef struct
+{
+	osMemoryPoolId_t xPool;
+	uint32_t ulBuffers;
+	uint32_t ulBufferBytes;
+	PipelineStage_t xStages[PIPELINE_MAX_STAGES];
+	uint32_t ulStages;
+	uint32_t ulSequence;		/* Producer only. */
+	volatile uint32_t ulAllocFailures;
+	PipelineStats_t xStats;
+	BaseType_t xStarted;
+} Pipeline_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t pipeline_init(Pipeline_t *pxPipeline, uint32_t ulBuffers, uint32_t ulBufferBytes);
+int32_t pipeline_add_stage(Pipeline_t *pxPipeline, const PipelineStageConfig_t *pxConfig);
+int32_t pipeline_start(Pipeline_t *pxPipeline);
+PipelineBuffer_t *pipeline_alloc(Pipeline_t *pxPipeline, TickType_t xTicksToWait);
+int32_t pipeline_submit(Pipeline_t *pxPipeline, PipelineBuffer_t **ppxBuffer);
+void pipeline_free(Pipeline_t *pxPipeline, PipelineBuffer_t *pxBuffer);
+int32_t pipeline_get_stage_stats(Pipeline_t *pxPipeline, uint32_t ulStage,
+		PipelineStageStats_t *pxStats);
+int32_t pipeline_get_stats(Pipeline_t *pxPipeline, PipelineStats_t *pxStats);
+
+#endif /* PIPELINE_H */
@@ -0,0 +1,325 @@
+/*******************************************************************************
+ *
+ * @file	pubsub.h
+ * @brief	Lock-free publish/subscribe topic: one ring of messages shared by
+ * 			every subscriber.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	A message is copied into the ring once, however many tasks
+ * 			subscribe, instead of once per subscriber queue. Each subscriber
+ * 			keeps its own read cursor, so a slow one never holds back the
+ * 			publisher or the others: once the ring has wrapped past its
+ * 			cursor, it skips to the oldest message still there and the
+ * 			messages it lost are counted and returned with the next one.
+ *
+ * 			'ulHead' is the sequence of the next message to publish and
+ * 			'ulReserved' runs one ahead of it while that message is being
+ * 			copied in. A subscriber copies a message out, then checks that
+ * 			the slot was not reserved again meanwhile; if it was, it skips
+ * 			ahead as for any overrun. Neither side enters a critical section.
+ *
+ * 			There is a single publisher, a task or an ISR of any priority.
+ * 			Publishers that may preempt each other must serialize, e.g. by
+ * 			publishing from one task.
+ *
+ * 			Subscribers block in pubsub_wait() on their last notification
+ * 			(PUBSUB_NOTIFY_INDEX), as spsc_ring.h does. pubsub_publish()
+ * 			loads one flag per subscriber and notifies only those that are
+ * 			blocked, so a publish costs one copy plus one wakeup per waiting
+ * 			subscriber. Subscribers are never removed.
+ *
+ ******************************************************************************/
+
+#ifndef PUBSUB_H
+#define PUBSUB_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef PUBSUB_NOTIFY_INDEX
+#define PUBSUB_NOTIFY_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct PubSubSubscriber
+{
+	uint32_t ulCursor;					/* Sequence of the next message to take. */
+	uint32_t ulOverruns;				/* Messages overwritten before they were taken. */
+	TaskHandle_t xTask;					/* Set by pubsub_wait(). */
+	volatile uint32_t ulWaiting;		/* Subscriber about to block. */
+	struct PubSubSubscriber * volatile pxNext;
+} PubSubSubscriber_t;
+
+typedef struct
+{
+	volatile uint32_t ulHead;			/* Sequence of the next message. */
+	volatile uint32_t ulReserved;		/* ulHead + 1 while it is copied in. */
+	uint8_t *pucSlots;					/* ulDepth messages of ulSize bytes. */
+	uint32_t ulSize;
+	uint32_t ulDepth;					/* A power of two, at least 2. */
+	PubSubSubscriber_t * volatile pxSubscribers;
+} PubSubTopic_t;
+
+/* Function definitions ------------------------------------------------------*/
+
+/**
+ * @brief Initializes a topic with no messages and no subscribers.
+ * @param pxTopic Topic to initialize.
+ * @param pvSlots Storage of ulDepth * ulSize bytes for the ring.
+ * @param ulSize Size of a message in bytes.
+ * @param ulDepth Messages the ring holds, a power of two, at least 2.
+ * @retval 0 if successful, -1 otherwise.
+ */
+static inline int32_t pubsub_init(PubSubTopic_t *pxTopic, void *pvSlots, uint32_t ulSize, uint32_t ulDepth)
+{
+	if ((pxTopic == NULL) || (pvSlots == NULL) || (ulSize == 0U) || (ulDepth < 2U)
+			|| ((ulDepth & (ulDepth - 1U)) != 0U))
+	{
+		return -1;
+	}
+
+	pxTopic->ulHead = 0;
+	pxTopic->ulReserved = 0;
+	pxTopic->pucSlots = (uint8_t *)pvSlots;
+	pxTopic->ulSize = ulSize;
+	pxTopic->ulDepth = ulDepth;
+	pxTopic->pxSubscribers = NULL;
+
+	return 0;
+}
+
+/**
+ * @brief Adds a subscriber, which takes the messages published from now on.
+ * @param pxTopic Topic.
+ * @param pxSubscriber Subscriber to add, owned by one task.
+ * @retval 0 if successful, -1 otherwise.
+ * @note Tasks only. The publisher may walk the list meanwhile: it sees the
+ * subscriber either fully linked or not at all.
+ */
+static inline int32_t pubsub_subscribe(PubSubTopic_t *pxTopic, PubSubSubscriber_t *pxSubscriber)
+{
+	if ((pxTopic == NULL) || (pxSubscriber == NULL))
+	{
+		return -1;
+	}
+
+	pxSubscriber->ulCursor = pxTopic->ulHead;
+	pxSubscriber->ulOverruns = 0;
+	pxSubscriber->xTask = NULL;
+	pxSubscriber->ulWaiting = 0;
+
+	/* Against other subscribing tasks; the publisher never writes the list. */
+	taskENTER_CRITICAL();
+	pxSubscriber->pxNext = pxTopic->pxSubscribers;
+	__DMB();
+	pxTopic->pxSubscribers = pxSubscriber;
+	taskEXIT_CRITICAL();
+
+	return 0;
+}
+
+/**
+ * @brief Returns the messages a subscriber lost to overruns.
+ * @param pxSubscriber Subscriber.
+ * @retval Messages skipped since pubsub_subscribe().
+ */
+static inline uint32_t pubsub_get_overruns(const PubSubSubscriber_t *pxSubscriber)
+{
+	return pxSubscriber->ulOverruns;
+}
+
+/**
+ * @brief Copies a message into the ring without waking the subscribers
+ * (publisher side). Tasks and ISRs of any priority.
+ * @param pxTopic Topic.
+ * @param pvMessage The message, pxTopic->ulSize bytes.
+ * @retval None
+ * @note Never blocks: the oldest message is overwritten.
+ */
+static inline void pubsub_write(PubSubTopic_t *pxTopic, const void *pvMessage)
+{
+	const uint32_t ulHead = pxTopic->ulHead;
+
+	/* Subscribers copying the message this slot held must see it go before
+	 * any byte changes. */
+	pxTopic->ulReserved = ulHead + 1U;
+	__DMB();
+	memcpy(&pxTopic->pucSlots[(ulHead & (pxTopic->ulDepth - 1U)) * pxTopic->ulSize], pvMessage,
+			pxTopic->ulSize);
+
+	/* And every byte before the sequence that publishes them. */
+	__DMB();
+	pxTopic->ulHead = ulHead + 1U;
+}
+
+/**
+ * @brief Publishes a message and wakes the subscribers blocked in
+ * pubsub_wait() (publisher task side).
+ * @param pxTopic Topic.
+ * @param pvMessage The message, pxTopic->ulSize bytes.
+ * @retval None
+ */
+static inline void pubsub_publish(PubSubTopic_t *pxTopic, const void *pvMessage)
+{
+	PubSubSubscriber_t *pxSubscriber;
+
+	pubsub_write(pxTopic, pvMessage);
+
+	/* The new head must be visible before the flags are read. */
+	__DMB();
+
+	for (pxSubscriber = pxTopic->pxSubscribers; pxSubscriber != NULL; pxSubscriber = pxSubscriber->pxNext)
+	{
+		if (pxSubscriber->ulWaiting != 0U)
+		{
+			pxSubscriber->ulWaiting = 0;
+			(void)xTaskNotifyGiveIndexed(pxSubscriber->xTask, PUBSUB_NOTIFY_INDEX);
+		}
+	}
+}
+
+/**
+ * @brief Publishes a message and wakes the subscribers blocked in
+ * pubsub_wait() (publisher ISR side).
+ * @param pxTopic Topic.
+ * @param pvMessage The message, pxTopic->ulSize bytes.
+ * @param pxHigherPriorityTaskWoken Set if a subscriber must run on exit.
+ * @retval None
+ * @note Only from ISRs at or below configMAX_SYSCALL_INTERRUPT_PRIORITY;
+ * higher ones call pubsub_write() and leave the subscribers to poll.
+ */
+static inline void pubsub_publish_from_isr(PubSubTopic_t *pxTopic, const void *pvMessage,
+		BaseType_t *pxHigherPriorityTaskWoken)
+{
+	PubSubSubscriber_t *pxSubscriber;
+
+	pubsub_write(pxTopic, pvMessage);
+
+	__DMB();
+
+	for (pxSubscriber = pxTopic->pxSubscribers; pxSubscriber != NULL; pxSubscriber = pxSubscriber->pxNext)
+	{
+		if (pxSubscriber->ulWaiting != 0U)
+		{
+			pxSubscriber->ulWaiting = 0;
+			vTaskNotifyGiveIndexedFromISR(pxSubscriber->xTask, PUBSUB_NOTIFY_INDEX,
+					pxHigherPriorityTaskWoken);
+		}
+	}
+}
+
+/**
+ * @brief Takes the subscriber's next message if there is one (subscriber
+ * side).
+ * @param pxTopic Topic.
+ * @param pxSubscriber Subscriber, used by one task only.
+ * @param pvMessage Receives the message, pxTopic->ulSize bytes.
+ * @param pulLost Receives the messages skipped just before this one, may be
+ * NULL. They are also added to the subscriber's overruns.
+ * @retval 0 if a message was taken, -1 if the subscriber has taken them all.
+ */
+static inline int32_t pubsub_take(PubSubTopic_t *pxTopic, PubSubSubscriber_t *pxSubscriber,
+		void *pvMessage, uint32_t *pulLost)
+{
+	const uint32_t ulDepth = pxTopic->ulDepth;
+	uint32_t ulCursor = pxSubscriber->ulCursor;
+	uint32_t ulLost = 0;
+	uint32_t ulReserved;
+
+	while (1)
+	{
+		if (pxTopic->ulHead == ulCursor)
+		{
+			pxSubscriber->ulCursor = ulCursor;
+			pxSubscriber->ulOverruns += ulLost;
+			return -1;
+		}
+
+		/* Read the slot only after seeing the head that covers it. */
+		__DMB();
+		ulReserved = pxTopic->ulReserved;
+
+		if ((ulReserved - ulCursor) > ulDepth)
+		{
+			/* Overwritten, or being overwritten: skip to the oldest message
+			 * the publisher is not touching. With a depth of at least 2 it is
+			 * already published. */
+			ulLost += (ulReserved - ulDepth) - ulCursor;
+			ulCursor = ulReserved - ulDepth;
+		}
+
+		memcpy(pvMessage, &pxTopic->pucSlots[(ulCursor & (ulDepth - 1U)) * pxTopic->ulSize],
+				pxTopic->ulSize);
+
+		/* Check the reservation again only after the copy. An overwrite
+		 * started meanwhile has moved it on, so the loop skips ahead. */
+		__DMB();
+
+		if ((pxTopic->ulReserved - ulCursor) <= ulDepth)
+		{
+			break;
+		}
+	}
+
+	pxSubscriber->ulCursor = ulCursor + 1U;
+	pxSubscriber->ulOverruns += ulLost;
+
+	if (pulLost != NULL)
+	{
+		*pulLost = ulLost;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Blocks the calling task until the subscriber has a message, and takes
+ * it (subscriber side).
+ * @param pxTopic Topic.
+ * @param pxSubscriber Subscriber, used by the calling task only.
+ * @param pvMessage Receives the message, pxTopic->ulSize bytes.
+ * @param pulLost As for pubsub_take(), may be NULL.
+ * @param xTicksToWait Maximum time to wait.
+ * @retval 0 if a message was taken, -1 on timeout.
+ * @note Uses the calling task's notification count at PUBSUB_NOTIFY_INDEX.
+ * The waiting flag is set before the ring is checked again, so a publish in
+ * between is never missed.
+ */
+static inline int32_t pubsub_wait(PubSubTopic_t *pxTopic, PubSubSubscriber_t *pxSubscriber,
+		void *pvMessage, uint32_t *pulLost, TickType_t xTicksToWait)
+{
+	TimeOut_t xTimeOut;
+	int32_t lResult;
+
+	vTaskSetTimeOutState(&xTimeOut);
+	pxSubscriber->xTask = xTaskGetCurrentTaskHandle();
+
+	while ((lResult = pubsub_take(pxTopic, pxSubscriber, pvMessage, pulLost)) != 0)
+	{
+		pxSubscriber->ulWaiting = 1;
+		__DMB();
+
+		if ((lResult = pubsub_take(pxTopic, pxSubscriber, pvMessage, pulLost)) == 0)
+		{
+			break;
+		}
+
+		if (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE)
+		{
+			break;
+		}
+
+		(void)ulTaskNotifyTakeIndexed(PUBSUB_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+	}
+
+	pxSubscriber->ulWaiting = 0;
+
+	return lResult;
+}
+
+#endif /* PUBSUB_H */
@@ -0,0 +1,72 @@
+/*******************************************************************************
+ *
+ * @file	qadvisor.h
+ * @brief	Interface of the queue sizing advisor.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef QADVISOR_H
+#define QADVISOR_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "queue.h"
+
+/* Macros --------------------------------------------------------------------*/
+/* Queues evaluated at most: the registry's. */
+#ifndef QADVISOR_MAX_QUEUES
+#define QADVISOR_MAX_QUEUES configQUEUE_REGISTRY_SIZE
+#endif
+
+/* Spare slots kept above the high-water mark, as a percentage of it... */
+#ifndef QADVISOR_SPARE_PERCENT
+#define QADVISOR_SPARE_PERCENT 25U
+#endif
+
+/* ...and at least this many. */
+#ifndef QADVISOR_MIN_SPARE
+#define QADVISOR_MIN_SPARE 1U
+#endif
+
+/* A queue that stalled or lost items is advised this many times longer: how
+ * much longer it needs cannot be seen while it is full. */
+#ifndef QADVISOR_GROW_FACTOR
+#define QADVISOR_GROW_FACTOR 2U
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef enum
+{
+	QADVISOR_IDLE = 0,				/* Nothing sent: the soak did not exercise it. */
+	QADVISOR_KEEP,					/* The length fits the high-water mark. */
+	QADVISOR_SHRINK,				/* Slots never used. */
+	QADVISOR_GROW					/* Senders blocked or items were lost. */
+} QadvisorVerdict_t;
+
+/* Advice on one queue of the registry. */
+typedef struct
+{
+	const char *pcName;
+	QueueHandle_t xHandle;
+	UBaseType_t uxLength;
+	UBaseType_t uxItemSize;
+	uint32_t ulHighWater;			/* Most items held at once. */
+	uint32_t ulStalls;				/* Sends that blocked on a full queue. */
+	uint32_t ulLosses;				/* Sends that timed out or were dropped. */
+	UBaseType_t uxAdvisedLength;
+	int32_t lRamDelta;				/* Bytes of storage the advice saves (< 0) or costs. */
+	QadvisorVerdict_t eVerdict;
+} QadvisorAdvice_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+#if (configUSE_QUEUE_METRICS == 1) && (configQUEUE_REGISTRY_SIZE > 0)
+void qadvisor_start(void);
+UBaseType_t qadvisor_evaluate(QadvisorAdvice_t *pxAdvice, UBaseType_t uxSize,
+		int32_t *plRamDelta);
+const char *qadvisor_verdict_name(QadvisorVerdict_t eVerdict);
+#endif
+
+#endif /* QADVISOR_H */
@@ -0,0 +1,46 @@
+/*******************************************************************************
+ *
+ * @file	spectrum.h
+ * @brief	Interface of the spectral analysis of sensor frames on the FPU.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macros --------------------------------------------------------------------*/
+#define SPECTRUM_SIZE 512U				/* Real samples per frame, 2 * 4^n. The
+										 * sine table in spectrum.c is for it. */
+#define SPECTRUM_BINS (SPECTRUM_SIZE / 2U)	/* 0 (DC) to SPECTRUM_BINS - 1. */
+
+#ifndef SPECTRUM_PEAKS
+#define SPECTRUM_PEAKS 3U				/* Strongest peaks in a feature vector. */
+#endif
+
+#ifndef SPECTRUM_BANDS
+#define SPECTRUM_BANDS 8U				/* Equal-width bands, dividing SPECTRUM_BINS. */
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+/* Features of one frame, in the units of the samples (e.g. ADC counts). */
+typedef struct
+{
+	float fRms;							/* Of the frame from bin 2 up, without DC. */
+	float fPeakHz[SPECTRUM_PEAKS];		/* Strongest first, 0 if none. */
+	float fPeakAmplitude[SPECTRUM_PEAKS];	/* Of a sine at that frequency. */
+	float fBandRms[SPECTRUM_BANDS];		/* From DC to half the sample rate. */
+} SpectrumFeatures_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+void spectrum_window(float *pfFrame);
+void spectrum_rfft(float *pfFrame);
+void spectrum_features(const float *pfSpectrum, uint32_t ulSampleRateHz,
+		SpectrumFeatures_t *pxFeatures);
+void spectrum_analyze(float *pfFrame, uint32_t ulSampleRateHz, SpectrumFeatures_t *pxFeatures);
+
+#endif /* SPECTRUM_H */
@@ -0,0 +1,312 @@
+/*******************************************************************************
+ *
+ * @file	filter.c
+ * @brief	Block filters for 12-bit sensor samples, on the Cortex-M4 dual
+ * 			16-bit (SIMD) instructions.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Samples are Q15: filter_adc_to_q15() maps the ADC range 0..4095
+ * 			onto -32768..32752.
+ *
+ * 			The multiply-accumulate loops load two samples and two
+ * 			coefficients per 32-bit word and use SMLALD, which does both
+ * 			multiplies and adds them to a 64-bit accumulator in a single
+ * 			cycle. Unaligned word loads (memcpy() of 4 bytes) are allowed on
+ * 			the Cortex-M4, so odd sample offsets cost nothing extra.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "filter.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define FILTER_ADC_MID_SCALE		2048
+#define FILTER_ADC_MID_SCALE_X2		0x08000800U	/* Mid-scale in both halves. */
+#define FILTER_ADC_TO_Q15_SHIFT		4U
+#define FILTER_MAX_LOG2_LENGTH		15U
+
+/* Private function prototypes -----------------------------------------------*/
+static int16_t filter_saturate_q15(int64_t llValue);
+static uint32_t filter_read_q15x2(const int16_t *psPair);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Converts raw 12-bit ADC samples to Q15, two samples per iteration.
+ * @param pusIn Raw samples (0..4095).
+ * @param psOut Q15 samples. May be the same buffer as pusIn.
+ * @param ulCount Number of samples.
+ * @retval None
+ * @note SSUB16 removes the mid-scale offset from both halves at once. Each half
+ * is then in -2048..2047, so one shift scales both by 16: the bits the lower
+ * half pushes into the upper one are only its sign extension and are masked.
+ */
+void filter_adc_to_q15(const uint16_t *pusIn, int16_t *psOut, uint32_t ulCount)
+{
+	uint32_t ulPair;
+	uint32_t x;
+
+	for (x = 0; (x + 1U) < ulCount; x += 2U)
+	{
+		memcpy(&ulPair, &pusIn[x], sizeof(ulPair));
+		ulPair = __SSUB16(ulPair, FILTER_ADC_MID_SCALE_X2);
+		ulPair = (ulPair << FILTER_ADC_TO_Q15_SHIFT) & 0xFFF0FFF0U;
+		memcpy(&psOut[x], &ulPair, sizeof(ulPair));
+	}
+
+	if (x < ulCount)
+	{
+		psOut[x] = (int16_t)(((int32_t)pusIn[x] - FILTER_ADC_MID_SCALE) << FILTER_ADC_TO_Q15_SHIFT);
+	}
+}
+
+/**
+ * @brief Converts a Q15 sample back to the 12-bit ADC scale.
+ * @param sSample Q15 sample.
+ * @retval 0..4095
+ */
+uint32_t filter_q15_to_adc(int16_t sSample)
+{
+	return (uint32_t)((sSample >> FILTER_ADC_TO_Q15_SHIFT) + FILTER_ADC_MID_SCALE);
+}
+
+/**
+ * @brief Initializes an FIR filter and clears its history.
+ * @param pxFir Filter to initialize.
+ * @param psCoeffs usTaps Q15 coefficients in time-reversed order, i.e. the one
+ * applied to the oldest sample first (as CMSIS-DSP arm_fir_q15()).
+ * @param usTaps Number of taps, even (pad with a zero coefficient).
+ * @param psState Buffer of (usTaps - 1 + usBlockSize) samples.
+ * @param usBlockSize Largest number of samples per filter_fir_q15() pass.
+ * @retval 0 if successful, -1 otherwise.
+ */
+int32_t filter_fir_init(FirQ15_t *pxFir, const int16_t *psCoeffs, uint16_t usTaps,
+		int16_t *psState, uint16_t usBlockSize)
+{
+	if ((pxFir == NULL) || (psCoeffs == NULL) || (psState == NULL)
+			|| (usTaps < 2U) || ((usTaps & 1U) != 0U) || (usBlockSize == 0U))
+	{
+		return -1;
+	}
+
+	pxFir->psCoeffs = psCoeffs;
+	pxFir->psState = psState;
+	pxFir->usTaps = usTaps;
+	pxFir->usBlockSize = usBlockSize;
+
+	memset(psState, 0, ((size_t)usTaps - 1U + usBlockSize) * sizeof(int16_t));
+
+	return 0;
+}
+
+/**
+ * @brief Filters a block of samples.
+ * @param pxFir Initialized filter.
+ * @param psIn Q15 input samples.
+ * @param psOut Q15 output samples. May be the same buffer as psIn.
+ * @param ulCount Number of samples, any length (processed in chunks of
+ * usBlockSize).
+ * @retval None
+ * @note The inner loop runs usTaps / 2 times per output sample, each time one
+ * SMLALD on a pair of samples and a pair of coefficients.
+ */
+void filter_fir_q15(FirQ15_t *pxFir, const int16_t *psIn, int16_t *psOut, uint32_t ulCount)
+{
+	const uint32_t ulHistory = (uint32_t)pxFir->usTaps - 1U;
+	int16_t *psState = pxFir->psState;
+	const int16_t *psWindow;
+	uint64_t ullAcc;
+	uint32_t ulChunk;
+	uint32_t n;
+	uint32_t k;
+
+	while (ulCount > 0U)
+	{
+		ulChunk = (ulCount < pxFir->usBlockSize) ? ulCount : pxFir->usBlockSize;
+
+		/* New samples go after the history, so every output sample's window is
+		 * contiguous: psState[n] (oldest) .. psState[n + usTaps - 1] (newest). */
+		memcpy(&psState[ulHistory], psIn, ulChunk * sizeof(int16_t));
+
+		for (n = 0; n < ulChunk; n++)
+		{
+			psWindow = &psState[n];
+			ullAcc = 0;
+
+			for (k = 0; k < pxFir->usTaps; k += 2U)
+			{
+				ullAcc = __SMLALD(filter_read_q15x2(&psWindow[k]),
+						filter_read_q15x2(&pxFir->psCoeffs[k]), ullAcc);
+			}
+
+			/* Q30 accumulator back to Q15. */
+			psOut[n] = filter_saturate_q15((int64_t)ullAcc >> 15);
+		}
+
+		/* Keep the last (usTaps - 1) inputs for the next block. */
+		memmove(psState, &psState[ulChunk], ulHistory * sizeof(int16_t));
+
+		psIn += ulChunk;
+		psOut += ulChunk;
+		ulCount -= ulChunk;
+	}
+}
+
+/**
+ * @brief Initializes a biquad section and clears its history.
+ * @param pxBiquad Section to initialize.
+ * @param psCoeffs { b0, b1, b2, a1, a2 }, Q15 scaled down by 2^ucPostShift.
+ * @param ucPostShift 1 when |a1| or any other coefficient is up to 2 (the
+ * usual case for low-pass sections), 0 otherwise.
+ * @retval None
+ */
+void filter_biquad_init(BiquadQ15_t *pxBiquad, const int16_t psCoeffs[5], uint8_t ucPostShift)
+{
+	/* Negated so the whole recursion is a sum of products. */
+	const int16_t sNegA1 = filter_saturate_q15(-(int64_t)psCoeffs[3]);
+	const int16_t sNegA2 = filter_saturate_q15(-(int64_t)psCoeffs[4]);
+
+	pxBiquad->ulB0B1 = __PKHBT((uint32_t)(uint16_t)psCoeffs[0], (uint32_t)(uint16_t)psCoeffs[1], 16);
+	pxBiquad->ulB2NegA1 = __PKHBT((uint32_t)(uint16_t)psCoeffs[2], (uint32_t)(uint16_t)sNegA1, 16);
+	pxBiquad->ulNegA2 = (uint32_t)(uint16_t)sNegA2;
+	pxBiquad->ulX0X1 = 0;
+	pxBiquad->ulY1Y2 = 0;
+	pxBiquad->ucPostShift = ucPostShift;
+}
+
+/**
+ * @brief Filters a block of samples through a biquad section.
+ * @param pxBiquad Initialized section.
+ * @param psIn Q15 input samples.
+ * @param psOut Q15 output samples. May be the same buffer as psIn.
+ * @param ulCount Number of samples.
+ * @retval None
+ * @note The state is kept packed in the operand order SMLALD needs, so each
+ * output sample takes three dual multiply-accumulates and no unpacking.
+ */
+void filter_biquad_q15(BiquadQ15_t *pxBiquad, const int16_t *psIn, int16_t *psOut, uint32_t ulCount)
+{
+	uint32_t ulX0X1 = pxBiquad->ulX0X1;
+	uint32_t ulY1Y2 = pxBiquad->ulY1Y2;
+	uint32_t ulXnX1;
+	uint64_t ullAcc;
+	int16_t sY;
+	uint32_t n;
+
+	for (n = 0; n < ulCount; n++)
+	{
+		/* x[n] | x[n-1] << 16 */
+		ulXnX1 = __PKHBT((uint32_t)(uint16_t)psIn[n], ulX0X1, 16);
+
+		/* b0 x[n] + b1 x[n-1] */
+		ullAcc = __SMLALD(ulXnX1, pxBiquad->ulB0B1, 0);
+		/* + b2 x[n-2] - a1 y[n-1] */
+		ullAcc = __SMLALD((ulX0X1 >> 16) | (ulY1Y2 << 16), pxBiquad->ulB2NegA1, ullAcc);
+		/* - a2 y[n-2] */
+		ullAcc = __SMLALD(ulY1Y2 >> 16, pxBiquad->ulNegA2, ullAcc);
+
+		sY = filter_saturate_q15((int64_t)ullAcc >> (15U - pxBiquad->ucPostShift));
+		psOut[n] = sY;
+
+		ulX0X1 = ulXnX1;
+		ulY1Y2 = (uint32_t)(uint16_t)sY | (ulY1Y2 << 16);
+	}
+
+	pxBiquad->ulX0X1 = ulX0X1;
+	pxBiquad->ulY1Y2 = ulY1Y2;
+}
+
+/**
+ * @brief Initializes a moving average and clears its history.
+ * @param pxAverage Moving average to initialize.
+ * @param psHistory Buffer of (1 << ucLog2Length) samples.
+ * @param ucLog2Length Window length as a power of two (at most 15).
+ * @retval 0 if successful, -1 otherwise.
+ */
+int32_t filter_moving_average_init(MovingAverageQ15_t *pxAverage, int16_t *psHistory,
+		uint8_t ucLog2Length)
+{
+	if ((pxAverage == NULL) || (psHistory == NULL) || (ucLog2Length > FILTER_MAX_LOG2_LENGTH))
+	{
+		return -1;
+	}
+
+	pxAverage->psHistory = psHistory;
+	pxAverage->lSum = 0;
+	pxAverage->usIndex = 0;
+	pxAverage->ucLog2Length = ucLog2Length;
+
+	memset(psHistory, 0, ((size_t)1U << ucLog2Length) * sizeof(int16_t));
+
+	return 0;
+}
+
+/**
+ * @brief Filters a block of samples through the moving average.
+ * @param pxAverage Initialized moving average.
+ * @param psIn Q15 input samples.
+ * @param psOut Q15 output samples. May be the same buffer as psIn.
+ * @param ulCount Number of samples.
+ * @retval None
+ * @note A running sum: one add and one subtract per sample whatever the window
+ * length, cheaper than the equivalent FIR even with SIMD.
+ */
+void filter_moving_average_q15(MovingAverageQ15_t *pxAverage, const int16_t *psIn,
+		int16_t *psOut, uint32_t ulCount)
+{
+	const uint16_t usMask = (uint16_t)((1U << pxAverage->ucLog2Length) - 1U);
+	int32_t lSum = pxAverage->lSum;
+	uint16_t usIndex = pxAverage->usIndex;
+	uint32_t n;
+
+	for (n = 0; n < ulCount; n++)
+	{
+		lSum += (int32_t)psIn[n] - pxAverage->psHistory[usIndex];
+		pxAverage->psHistory[usIndex] = psIn[n];
+		usIndex = (usIndex + 1U) & usMask;
+
+		psOut[n] = (int16_t)(lSum >> pxAverage->ucLog2Length);
+	}
+
+	pxAverage->lSum = lSum;
+	pxAverage->usIndex = usIndex;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Saturates to the Q15 range.
+ * @param llValue Value in Q15 units.
+ * @retval -32768..32767
+ */
+static int16_t filter_saturate_q15(int64_t llValue)
+{
+	if (llValue > INT16_MAX)
+	{
+		return INT16_MAX;
+	}
+
+	if (llValue < INT16_MIN)
+	{
+		return INT16_MIN;
+	}
+
+	return (int16_t)llValue;
+}
+
+/**
+ * @brief Loads two consecutive Q15 values as one word for the SIMD
+ * instructions (the first one in the lower half).
+ * @param psPair Address of the first value, halfword aligned.
+ * @retval The packed pair.
+ */
+static uint32_t filter_read_q15x2(const int16_t *psPair)
+{
+	uint32_t ulPair;
+
+	memcpy(&ulPair, psPair, sizeof(ulPair));
+
+	return ulPair;
+}
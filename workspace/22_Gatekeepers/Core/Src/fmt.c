@@ -0,0 +1,705 @@
+/*******************************************************************************
+ *
+ * @file	fmt.c
+ * @brief	Lightweight reentrant formatter: a printf() subset that needs
+ * 			neither the heap nor newlib's per-task reentrancy structure.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Supported conversions: %d %i %u %x %X %o %c %s %p %% and %f,
+ * 			with the flags '-' '0' '+' ' ' '#', a width, a precision (%s, %f
+ * 			and the integers) and the length modifiers h, hh, l, ll, z.
+ * 			'*' takes the width or the precision from the arguments. An
+ * 			unsupported conversion is copied to the output unchanged.
+ *
+ * 			%f is printed in fixed point, with up to FMT_FLOAT_MAX_PRECISION
+ * 			digits after the point (6 by default), rounded half away from
+ * 			zero: "%.0f" of 2.5 gives "3", where newlib gives "2".
+ * 			Values too large for 64 bits print as "ovf".
+ *
+ * 			All state is on the caller's stack, so any number of tasks can
+ * 			format at once, and so can ISRs with fmt_snprintf(). Nothing
+ * 			touches newlib's FILE structures, so a firmware that only
+ * 			formats with this module can build with
+ * 			configUSE_NEWLIB_REENTRANT 0.
+ *
+ * 			fmt_printf() goes straight to _write() (syscalls.c), so to the
+ * 			console sink of stdout, FMT_PRINTF_CHUNK bytes at a time. Output
+ * 			of tasks printing at once may interleave at chunk boundaries.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include "fmt.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define FMT_FLAG_LEFT		(1U << 0)	/* '-' */
+#define FMT_FLAG_ZERO		(1U << 1)	/* '0' */
+#define FMT_FLAG_PLUS		(1U << 2)	/* '+' */
+#define FMT_FLAG_SPACE		(1U << 3)	/* ' ' */
+#define FMT_FLAG_ALT		(1U << 4)	/* '#' */
+
+#define FMT_DEFAULT_FLOAT_PRECISION	6U
+#define FMT_MAX_DIGITS		22U			/* A 64-bit value in octal. */
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	char *pcBuffer;			/* Caller's buffer, or the chunk of fmt_vprintf(). */
+	size_t xSize;			/* Characters pcBuffer can hold, terminator excluded. */
+	size_t xPos;			/* Characters in pcBuffer. */
+	size_t xCount;			/* Characters produced, stored or not. */
+	bool bFlush;			/* Passes a full buffer to _write() instead of truncating. */
+} FmtOutput_t;
+
+typedef struct
+{
+	uint32_t ulFlags;
+	uint32_t ulWidth;
+	int32_t lPrecision;		/* -1 when not given. */
+} FmtSpec_t;
+
+/* Variables -----------------------------------------------------------------*/
+static const char cFmtDigitsLower[] = "0123456789abcdef";
+static const char cFmtDigitsUpper[] = "0123456789ABCDEF";
+
+static const uint32_t ulFmtPow10[FMT_FLOAT_MAX_PRECISION + 1U] =
+{
+	1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL,
+	100000000UL, 1000000000UL
+};
+
+/* Private function prototypes -----------------------------------------------*/
+extern int _write(int file, char *ptr, int len);
+static void fmt_put(FmtOutput_t *pxOut, char c);
+static void fmt_put_repeat(FmtOutput_t *pxOut, char c, uint32_t ulCount);
+static void fmt_put_field(FmtOutput_t *pxOut, const FmtSpec_t *pxSpec,
+		const char *pcPrefix, const char *pcDigits, uint32_t ulDigits,
+		uint32_t ulZeros);
+static uint32_t fmt_utoa(char *pcEnd, uint64_t ullValue, uint32_t ulBase,
+		const char *pcDigits);
+static void fmt_integer(FmtOutput_t *pxOut, const FmtSpec_t *pxSpec,
+		uint64_t ullValue, bool bNegative, char cConversion);
+static void fmt_float(FmtOutput_t *pxOut, const FmtSpec_t *pxSpec, double dValue);
+static void fmt_string(FmtOutput_t *pxOut, const FmtSpec_t *pxSpec, const char *pcString);
+static void fmt_format(FmtOutput_t *pxOut, const char *pcFormat, va_list xArgs);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Formats into a buffer, as snprintf().
+ * @param pcBuffer Destination, always terminated if xSize is not 0.
+ * @param xSize Size of pcBuffer, terminator included.
+ * @param pcFormat Format; see the file note for what is supported.
+ * @retval Length of the whole output, even if it was truncated.
+ * @note Tasks and ISRs of any priority.
+ */
+int fmt_snprintf(char *pcBuffer, size_t xSize, const char *pcFormat, ...)
+{
+	va_list xArgs;
+	int iLength;
+
+	va_start(xArgs, pcFormat);
+	iLength = fmt_vsnprintf(pcBuffer, xSize, pcFormat, xArgs);
+	va_end(xArgs);
+
+	return iLength;
+}
+
+/**
+ * @brief Formats into a buffer, as vsnprintf().
+ * @param pcBuffer Destination, always terminated if xSize is not 0.
+ * @param xSize Size of pcBuffer, terminator included.
+ * @param pcFormat Format; see the file note for what is supported.
+ * @param xArgs Arguments.
+ * @retval Length of the whole output, even if it was truncated.
+ * @note Tasks and ISRs of any priority.
+ */
+int fmt_vsnprintf(char *pcBuffer, size_t xSize, const char *pcFormat, va_list xArgs)
+{
+	FmtOutput_t xOut = { pcBuffer, (xSize > 0U) ? (xSize - 1U) : 0U, 0, 0, false };
+
+	fmt_format(&xOut, pcFormat, xArgs);
+
+	if (xSize > 0U)
+	{
+		pcBuffer[xOut.xPos] = '\0';
+	}
+
+	return (int)xOut.xCount;
+}
+
+/**
+ * @brief Formats to stdout through _write(), as printf().
+ * @param pcFormat Format; see the file note for what is supported.
+ * @retval Number of characters written.
+ * @note Tasks only, like any console output that may block.
+ */
+int fmt_printf(const char *pcFormat, ...)
+{
+	va_list xArgs;
+	int iLength;
+
+	va_start(xArgs, pcFormat);
+	iLength = fmt_vprintf(pcFormat, xArgs);
+	va_end(xArgs);
+
+	return iLength;
+}
+
+/**
+ * @brief Formats to stdout through _write(), as vprintf().
+ * @param pcFormat Format; see the file note for what is supported.
+ * @param xArgs Arguments.
+ * @retval Number of characters written.
+ */
+int fmt_vprintf(const char *pcFormat, va_list xArgs)
+{
+	char cChunk[FMT_PRINTF_CHUNK];
+	FmtOutput_t xOut = { cChunk, sizeof(cChunk), 0, 0, true };
+
+	fmt_format(&xOut, pcFormat, xArgs);
+
+	if (xOut.xPos > 0U)
+	{
+		(void)_write(FMT_PRINTF_FILE, cChunk, (int)xOut.xPos);
+	}
+
+	return (int)xOut.xCount;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Appends one character, flushing or truncating when the buffer is full.
+ * @param pxOut Output.
+ * @param c Character.
+ * @retval None
+ */
+static void fmt_put(FmtOutput_t *pxOut, char c)
+{
+	if ((pxOut->xPos == pxOut->xSize) && pxOut->bFlush)
+	{
+		(void)_write(FMT_PRINTF_FILE, pxOut->pcBuffer, (int)pxOut->xPos);
+		pxOut->xPos = 0;
+	}
+
+	if (pxOut->xPos < pxOut->xSize)
+	{
+		pxOut->pcBuffer[pxOut->xPos++] = c;
+	}
+
+	pxOut->xCount++;
+}
+
+/**
+ * @brief Appends a character several times.
+ * @param pxOut Output.
+ * @param c Character.
+ * @param ulCount Number of times.
+ * @retval None
+ */
+static void fmt_put_repeat(FmtOutput_t *pxOut, char c, uint32_t ulCount)
+{
+	while (ulCount-- > 0U)
+	{
+		fmt_put(pxOut, c);
+	}
+}
+
+/**
+ * @brief Appends a converted field, padded to the width of the conversion.
+ * @param pxOut Output.
+ * @param pxSpec Flags and width of the conversion.
+ * @param pcPrefix Sign or "0x", put before any zero padding.
+ * @param pcDigits Body of the field.
+ * @param ulDigits Length of pcDigits.
+ * @param ulZeros Zeros required between the prefix and the body.
+ * @retval None
+ */
+static void fmt_put_field(FmtOutput_t *pxOut, const FmtSpec_t *pxSpec,
+		const char *pcPrefix, const char *pcDigits, uint32_t ulDigits,
+		uint32_t ulZeros)
+{
+	uint32_t ulPrefix = 0;
+	uint32_t ulPad = 0;
+	uint32_t i;
+
+	while (pcPrefix[ulPrefix] != '\0')
+	{
+		ulPrefix++;
+	}
+
+	if (pxSpec->ulWidth > (ulPrefix + ulZeros + ulDigits))
+	{
+		ulPad = pxSpec->ulWidth - (ulPrefix + ulZeros + ulDigits);
+	}
+
+	/* '0' pads after the prefix, as part of the number. */
+	if ((pxSpec->ulFlags & (FMT_FLAG_LEFT | FMT_FLAG_ZERO)) == FMT_FLAG_ZERO)
+	{
+		ulZeros += ulPad;
+		ulPad = 0;
+	}
+
+	if ((pxSpec->ulFlags & FMT_FLAG_LEFT) == 0U)
+	{
+		fmt_put_repeat(pxOut, ' ', ulPad);
+	}
+
+	for (i = 0; i < ulPrefix; i++)
+	{
+		fmt_put(pxOut, pcPrefix[i]);
+	}
+
+	fmt_put_repeat(pxOut, '0', ulZeros);
+
+	for (i = 0; i < ulDigits; i++)
+	{
+		fmt_put(pxOut, pcDigits[i]);
+	}
+
+	if ((pxSpec->ulFlags & FMT_FLAG_LEFT) != 0U)
+	{
+		fmt_put_repeat(pxOut, ' ', ulPad);
+	}
+}
+
+/**
+ * @brief Converts an unsigned value to digits, written backwards from pcEnd.
+ * @param pcEnd One past the last digit.
+ * @param ullValue Value.
+ * @param ulBase 8, 10 or 16.
+ * @param pcDigits Digit characters.
+ * @retval Number of digits, at least one.
+ * @note Values that fit in 32 bits use 32-bit division, which the core does in
+ * hardware; only the rest go through the 64-bit library division.
+ */
+static uint32_t fmt_utoa(char *pcEnd, uint64_t ullValue, uint32_t ulBase,
+		const char *pcDigits)
+{
+	uint32_t ulValue;
+	uint32_t ulCount = 0;
+
+	while (ullValue > UINT32_MAX)
+	{
+		*--pcEnd = pcDigits[ullValue % ulBase];
+		ullValue /= ulBase;
+		ulCount++;
+	}
+
+	ulValue = (uint32_t)ullValue;
+
+	do
+	{
+		*--pcEnd = pcDigits[ulValue % ulBase];
+		ulValue /= ulBase;
+		ulCount++;
+	} while (ulValue != 0U);
+
+	return ulCount;
+}
+
+/**
+ * @brief Appends an integer conversion.
+ * @param pxOut Output.
+ * @param pxSpec Flags, width and precision.
+ * @param ullValue Magnitude.
+ * @param bNegative true to print a minus sign.
+ * @param cConversion 'd', 'u', 'x', 'X', 'o' or 'p'.
+ * @retval None
+ */
+static void fmt_integer(FmtOutput_t *pxOut, const FmtSpec_t *pxSpec,
+		uint64_t ullValue, bool bNegative, char cConversion)
+{
+	char cDigits[FMT_MAX_DIGITS];
+	const char *pcPrefix = "";
+	uint32_t ulBase = 10;
+	uint32_t ulDigits;
+	uint32_t ulZeros = 0;
+	FmtSpec_t xSpec = *pxSpec;
+
+	if ((cConversion == 'x') || (cConversion == 'X') || (cConversion == 'p'))
+	{
+		ulBase = 16;
+	}
+	else if (cConversion == 'o')
+	{
+		ulBase = 8;
+	}
+
+	if (bNegative)
+	{
+		pcPrefix = "-";
+	}
+	else if (cConversion == 'd')
+	{
+		if ((xSpec.ulFlags & FMT_FLAG_PLUS) != 0U)
+		{
+			pcPrefix = "+";
+		}
+		else if ((xSpec.ulFlags & FMT_FLAG_SPACE) != 0U)
+		{
+			pcPrefix = " ";
+		}
+	}
+	else if ((cConversion == 'p')
+			|| ((cConversion == 'x') && ((xSpec.ulFlags & FMT_FLAG_ALT) != 0U) && (ullValue != 0U)))
+	{
+		pcPrefix = "0x";
+	}
+	else if ((cConversion == 'X') && ((xSpec.ulFlags & FMT_FLAG_ALT) != 0U) && (ullValue != 0U))
+	{
+		pcPrefix = "0X";
+	}
+
+	ulDigits = fmt_utoa(&cDigits[sizeof(cDigits)], ullValue, ulBase,
+			(cConversion == 'X') ? cFmtDigitsUpper : cFmtDigitsLower);
+
+	if (xSpec.lPrecision >= 0)
+	{
+		/* A precision gives the minimum number of digits and disables '0';
+		 * "%.0d" prints nothing for 0. */
+		xSpec.ulFlags &= ~FMT_FLAG_ZERO;
+
+		if ((xSpec.lPrecision == 0) && (ullValue == 0U))
+		{
+			ulDigits = 0;
+		}
+		else if ((uint32_t)xSpec.lPrecision > ulDigits)
+		{
+			ulZeros = (uint32_t)xSpec.lPrecision - ulDigits;
+		}
+	}
+
+	/* "%#o" starts with a 0 whatever the value. */
+	if ((cConversion == 'o') && ((xSpec.ulFlags & FMT_FLAG_ALT) != 0U) && (ulZeros == 0U)
+			&& ((ulDigits == 0U) || (ullValue != 0U)))
+	{
+		ulZeros = 1;
+	}
+
+	fmt_put_field(pxOut, &xSpec, pcPrefix, &cDigits[sizeof(cDigits) - ulDigits],
+			ulDigits, ulZeros);
+}
+
+/**
+ * @brief Appends a %f conversion in fixed point.
+ * @param pxOut Output.
+ * @param pxSpec Flags, width and precision (digits after the point).
+ * @param dValue Value.
+ * @retval None
+ * @note The integer part is converted with 64-bit arithmetic and the fraction
+ * as one scaled 32-bit integer, so only two double operations are needed.
+ */
+static void fmt_float(FmtOutput_t *pxOut, const FmtSpec_t *pxSpec, double dValue)
+{
+	char cDigits[FMT_MAX_DIGITS + 1U + FMT_FLOAT_MAX_PRECISION];
+	char *pcEnd = &cDigits[sizeof(cDigits)];
+	const char *pcPrefix = "";
+	uint32_t ulPrecision = FMT_DEFAULT_FLOAT_PRECISION;
+	uint32_t ulDigits = 0;
+	uint32_t ulFraction;
+	uint64_t ullInteger;
+	double dFraction;
+	FmtSpec_t xSpec = *pxSpec;
+
+	if (xSpec.lPrecision >= 0)
+	{
+		ulPrecision = ((uint32_t)xSpec.lPrecision < FMT_FLOAT_MAX_PRECISION)
+				? (uint32_t)xSpec.lPrecision : FMT_FLOAT_MAX_PRECISION;
+	}
+
+	if ((dValue < 0.0) || ((dValue == 0.0) && ((1.0 / dValue) < 0.0)))
+	{
+		pcPrefix = "-";
+		dValue = -dValue;
+	}
+	else if ((xSpec.ulFlags & FMT_FLAG_PLUS) != 0U)
+	{
+		pcPrefix = "+";
+	}
+	else if ((xSpec.ulFlags & FMT_FLAG_SPACE) != 0U)
+	{
+		pcPrefix = " ";
+	}
+
+	/* NaN, infinity and anything past 64 bits: no zero padding. */
+	if ((dValue != dValue) || (dValue >= 18446744073709551616.0))
+	{
+		xSpec.ulFlags &= ~FMT_FLAG_ZERO;
+		fmt_put_field(pxOut, &xSpec, (dValue != dValue) ? "" : pcPrefix,
+				(dValue != dValue) ? "nan" : ((dValue - dValue) != 0.0) ? "inf" : "ovf",
+				3, 0);
+		return;
+	}
+
+	ullInteger = (uint64_t)dValue;
+	dFraction = ((dValue - (double)ullInteger) * (double)ulFmtPow10[ulPrecision]) + 0.5;
+	ulFraction = (uint32_t)dFraction;
+
+	/* Rounding can carry into the integer part: 0.9996 -> "1.000". */
+	if (ulFraction >= ulFmtPow10[ulPrecision])
+	{
+		ulFraction -= ulFmtPow10[ulPrecision];
+		ullInteger++;
+	}
+
+	if (ulPrecision > 0U)
+	{
+		while (ulDigits < ulPrecision)
+		{
+			*--pcEnd = cFmtDigitsLower[ulFraction % 10U];
+			ulFraction /= 10U;
+			ulDigits++;
+		}
+
+		*--pcEnd = '.';
+		ulDigits++;
+	}
+
+	ulDigits += fmt_utoa(pcEnd, ullInteger, 10, cFmtDigitsLower);
+
+	fmt_put_field(pxOut, &xSpec, pcPrefix, &cDigits[sizeof(cDigits) - ulDigits],
+			ulDigits, 0);
+}
+
+/**
+ * @brief Appends a %s conversion.
+ * @param pxOut Output.
+ * @param pxSpec Flags, width and precision (most characters printed).
+ * @param pcString String; NULL prints "(null)".
+ * @retval None
+ */
+static void fmt_string(FmtOutput_t *pxOut, const FmtSpec_t *pxSpec, const char *pcString)
+{
+	uint32_t ulLength = 0;
+	FmtSpec_t xSpec = *pxSpec;
+
+	if (pcString == NULL)
+	{
+		pcString = "(null)";
+	}
+
+	/* Only as far as the precision, which need not be terminated. */
+	while (((xSpec.lPrecision < 0) || (ulLength < (uint32_t)xSpec.lPrecision))
+			&& (pcString[ulLength] != '\0'))
+	{
+		ulLength++;
+	}
+
+	xSpec.ulFlags &= ~FMT_FLAG_ZERO;
+	fmt_put_field(pxOut, &xSpec, "", pcString, ulLength, 0);
+}
+
+/**
+ * @brief Walks the format and appends each literal and conversion.
+ * @param pxOut Output.
+ * @param pcFormat Format.
+ * @param xArgs Arguments.
+ * @retval None
+ */
+static void fmt_format(FmtOutput_t *pxOut, const char *pcFormat, va_list xArgs)
+{
+	const char *pcStart;
+	FmtSpec_t xSpec;
+	uint32_t ulLength;		/* Length modifier: 'h', 'H' (hh), 'l', 'L' (ll) or 0. */
+	int64_t llValue;
+	uint64_t ullValue;
+	char cChar;
+	int iArg;
+
+	while (*pcFormat != '\0')
+	{
+		if (*pcFormat != '%')
+		{
+			fmt_put(pxOut, *pcFormat++);
+			continue;
+		}
+
+		pcStart = pcFormat++;
+		xSpec.ulFlags = 0;
+		xSpec.ulWidth = 0;
+		xSpec.lPrecision = -1;
+		ulLength = 0;
+
+		/* Flags. */
+		for (;; pcFormat++)
+		{
+			if (*pcFormat == '-')
+			{
+				xSpec.ulFlags |= FMT_FLAG_LEFT;
+			}
+			else if (*pcFormat == '0')
+			{
+				xSpec.ulFlags |= FMT_FLAG_ZERO;
+			}
+			else if (*pcFormat == '+')
+			{
+				xSpec.ulFlags |= FMT_FLAG_PLUS;
+			}
+			else if (*pcFormat == ' ')
+			{
+				xSpec.ulFlags |= FMT_FLAG_SPACE;
+			}
+			else if (*pcFormat == '#')
+			{
+				xSpec.ulFlags |= FMT_FLAG_ALT;
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		/* Width. */
+		if (*pcFormat == '*')
+		{
+			iArg = va_arg(xArgs, int);
+
+			if (iArg < 0)
+			{
+				xSpec.ulFlags |= FMT_FLAG_LEFT;
+				iArg = -iArg;
+			}
+
+			xSpec.ulWidth = (uint32_t)iArg;
+			pcFormat++;
+		}
+		else
+		{
+			while ((*pcFormat >= '0') && (*pcFormat <= '9'))
+			{
+				xSpec.ulWidth = (xSpec.ulWidth * 10U) + (uint32_t)(*pcFormat++ - '0');
+			}
+		}
+
+		/* Precision. */
+		if (*pcFormat == '.')
+		{
+			pcFormat++;
+			xSpec.lPrecision = 0;
+
+			if (*pcFormat == '*')
+			{
+				iArg = va_arg(xArgs, int);
+				xSpec.lPrecision = (iArg < 0) ? -1 : iArg;
+				pcFormat++;
+			}
+			else
+			{
+				while ((*pcFormat >= '0') && (*pcFormat <= '9'))
+				{
+					xSpec.lPrecision = (xSpec.lPrecision * 10) + (*pcFormat++ - '0');
+				}
+			}
+		}
+
+		/* Length modifier. */
+		if ((*pcFormat == 'h') || (*pcFormat == 'l'))
+		{
+			ulLength = (uint32_t)*pcFormat++;
+
+			if ((uint32_t)*pcFormat == ulLength)
+			{
+				ulLength = (ulLength == 'h') ? 'H' : 'L';
+				pcFormat++;
+			}
+		}
+		else if (*pcFormat == 'z')
+		{
+			ulLength = (sizeof(size_t) == sizeof(long)) ? 'l' : 0U;
+			pcFormat++;
+		}
+
+		cChar = *pcFormat;
+
+		switch (cChar)
+		{
+		case 'd':
+		case 'i':
+			if (ulLength == 'L')
+			{
+				llValue = va_arg(xArgs, long long);
+			}
+			else if (ulLength == 'l')
+			{
+				llValue = va_arg(xArgs, long);
+			}
+			else
+			{
+				llValue = va_arg(xArgs, int);
+				llValue = (ulLength == 'H') ? (signed char)llValue
+						: (ulLength == 'h') ? (short)llValue : llValue;
+			}
+
+			/* Negated in unsigned arithmetic, so INT64_MIN works too. */
+			fmt_integer(pxOut, &xSpec,
+					(llValue < 0) ? (0U - (uint64_t)llValue) : (uint64_t)llValue,
+					llValue < 0, 'd');
+			break;
+
+		case 'u':
+		case 'x':
+		case 'X':
+		case 'o':
+			if (ulLength == 'L')
+			{
+				ullValue = va_arg(xArgs, unsigned long long);
+			}
+			else if (ulLength == 'l')
+			{
+				ullValue = va_arg(xArgs, unsigned long);
+			}
+			else
+			{
+				ullValue = va_arg(xArgs, unsigned int);
+				ullValue = (ulLength == 'H') ? (unsigned char)ullValue
+						: (ulLength == 'h') ? (unsigned short)ullValue : ullValue;
+			}
+
+			fmt_integer(pxOut, &xSpec, ullValue, false, cChar);
+			break;
+
+		case 'p':
+			fmt_integer(pxOut, &xSpec, (uintptr_t)va_arg(xArgs, void *), false, 'p');
+			break;
+
+		case 'c':
+			cChar = (char)va_arg(xArgs, int);
+			xSpec.ulFlags &= ~FMT_FLAG_ZERO;
+			fmt_put_field(pxOut, &xSpec, "", &cChar, 1, 0);
+			break;
+
+		case 's':
+			fmt_string(pxOut, &xSpec, va_arg(xArgs, const char *));
+			break;
+
+		case 'f':
+		case 'F':
+			fmt_float(pxOut, &xSpec, va_arg(xArgs, double));
+			break;
+
+		case '%':
+			fmt_put(pxOut, '%');
+			break;
+
+		default:
+			/* Not supported, or the format ended: copy it as it is. */
+			while (pcStart < pcFormat)
+			{
+				fmt_put(pxOut, *pcStart++);
+			}
+
+			if (cChar == '\0')
+			{
+				return;
+			}
+
+			fmt_put(pxOut, cChar);
+			break;
+		}
+
+		pcFormat++;
+	}
+}
@@ -0,0 +1,65 @@
+/*******************************************************************************
+ *
+ * @file	heap_regions.c
+ * @brief	FreeRTOS heap regions made of the SRAM that the linker leaves free.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Enabled with 'configUSE_HEAP_REGIONS 1' in 'FreeRTOSConfig.h'.
+ * 			heap_4.c then calls vApplicationGetHeapRegions() on the first
+ * 			allocation, instead of using a fixed configTOTAL_HEAP_SIZE array.
+ *
+ * 			The linker script defines the bounds (see the 'Heap regions'
+ * 			comment in 'STM32F446RETX_FLASH.ld'):
+ *
+ * 				SRAM1	_sheap_sram1 .. _eheap_sram1, from the end of the
+ * 						newlib heap to the bottom of the MSP stack
+ * 				SRAM2	_sheap_sram2 .. _eheap_sram2, after the DMA buffers
+ * 						placed there statically
+ *
+ * 			so the heap grows and shrinks with .data and .bss, and no RAM is
+ * 			left idle. On the F446, SRAM1 and SRAM2 sit on separate ports of
+ * 			the bus matrix. A DMA stream working on SRAM2 does not hold up the
+ * 			CPU's stack and data accesses to SRAM1, so DMA buffers are taken
+ * 			from SRAM2 with pvPortMallocRegion(..., HEAP_REGION_SRAM2).
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+#include "heap_regions.h"
+
+#if (configUSE_HEAP_REGIONS == 1)
+
+/* Variables -----------------------------------------------------------------*/
+
+/* Linker script symbols. */
+extern uint8_t _sheap_sram1[];
+extern uint8_t _eheap_sram1[];
+extern uint8_t _sheap_sram2[];
+extern uint8_t _eheap_sram2[];
+
+/* Terminated by a region of size 0. */
+static HeapRegion_t xHeapRegions[HEAP_REGION_COUNT + 1];
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Returns the heap regions (heap_4.c, configUSE_HEAP_REGIONS).
+ * @param ppxHeapRegions Receives the region array, in address order.
+ * @retval None
+ * @note Called once, on the first allocation. An empty SRAM2 region ends the
+ * array early; SRAM2 allocations then fail.
+ */
+void vApplicationGetHeapRegions(const HeapRegion_t **ppxHeapRegions)
+{
+	xHeapRegions[HEAP_REGION_SRAM1].pucStartAddress = _sheap_sram1;
+	xHeapRegions[HEAP_REGION_SRAM1].xSizeInBytes = (size_t)(_eheap_sram1 - _sheap_sram1);
+	xHeapRegions[HEAP_REGION_SRAM2].pucStartAddress = _sheap_sram2;
+	xHeapRegions[HEAP_REGION_SRAM2].xSizeInBytes = (size_t)(_eheap_sram2 - _sheap_sram2);
+	xHeapRegions[HEAP_REGION_COUNT].pucStartAddress = NULL;
+	xHeapRegions[HEAP_REGION_COUNT].xSizeInBytes = 0;
+
+	*ppxHeapRegions = xHeapRegions;
+}
+
+#endif /* configUSE_HEAP_REGIONS */
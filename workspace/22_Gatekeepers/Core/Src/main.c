@@ -12,31 +12,278 @@
  * 			Needed to increase the delay time of the tasks from 1 to 10 to
  * 			resolve the 'analog sensor data not getting printed' issue.
  *
+ * 			The latest readings are shared through a reader-writer lock:
+ * 			the sensor tasks write them, the print task reads both as one
+ * 			snapshot, and readers never serialize each other.
+ *
+ * 			The filtered analog value is published through a seqlock
+ * 			channel instead of the print queue, so the print task always
+ * 			prints the newest block and the analog task never stalls or
+ * 			drops on a full queue.
+ *
+ * 			With ANALOG_TOPIC set, it is published on a pub/sub topic
+ * 			(pubsub.h) instead, with two subscribers: the print task and
+ * 			vAnalogAlarmTask, which checks every reading against a
+ * 			threshold. Each reading is copied into the topic once, and each
+ * 			subscriber is told how many readings it missed.
+ * 			With ANALOG_ALARM_WATCHDOG set as well, vAnalogAlarmTask does not
+ * 			subscribe: the ADC analog watchdog (adc_watch_init()) compares
+ * 			every sample of the stream in hardware, and its interrupt wakes
+ * 			the task only when the alarm is raised or cleared, instead of
+ * 			for every reading.
+ * 			The alarm lines skip the gatekeeper: they go straight to the
+ * 			urgent lane of the console (USART2_write_urgent()), which the
+ * 			UART DMA serves at its next chunk boundary, ahead of the sensor
+ * 			and statistics lines queued on the bulk lane. Each starts with
+ * 			a line break, since it may land inside a bulk line.
+ *
+ * 			The UART gatekeeper is the reusable one in 'gatekeeper.c': the
+ * 			tasks format their lines and post them, and the gatekeeper
+ * 			drains them in batches, merging each batch into one DMA
+ * 			transfer. The print task reports its statistics every
+ * 			PRINT_STATS_MS, followed by the counters of each queue in the
+ * 			queue registry (configUSE_QUEUE_METRICS) and the length the
+ * 			queue sizing advisor (qadvisor.c) recommends for it, from the
+ * 			run so far.
+ *
+ * 			With PRINT_CREDITS set, the sensor lines are posted with
+ * 			credit-based flow control (credit.h) instead of waiting for room
+ * 			in the gatekeeper queue: each sensor task is lent a few queue
+ * 			slots and checks its credit, without a kernel call, before
+ * 			formatting a line. With no credit left the digital task prints
+ * 			half as often, and twice as often again once the gatekeeper has
+ * 			granted all of its credit back, so its print rate follows what
+ * 			the UART drains; the print task skips the analog line. Neither
+ * 			blocks on the UART any more.
+ *
+ * 			The FreeRTOS heap spans all the free SRAM1 and SRAM2
+ * 			(heap_regions.c). The UART and ADC DMA buffers are in SRAM2,
+ * 			away from the CPU's accesses to SRAM1.
+ *
+ * 			Lines are formatted with 'fmt.c' instead of newlib, so the
+ * 			tasks need no newlib reentrancy structure
+ * 			(configUSE_NEWLIB_REENTRANT 0).
+ *
+ * 			The digital sensor is sampled by 'gpio_capture.c' instead of a
+ * 			polling loop: TIM8 triggers a DMA2 copy of GPIOC->IDR at
+ * 			DIGITAL_SAMPLE_RATE_HZ, and the task counts the button edges
+ * 			once per block.
+ *
+ * 			With ANALOG_PIPELINE set, the analog task only acquires: each
+ * 			block goes into a buffer of a zero-copy pipeline (pipeline.h),
+ * 			and stage tasks filter it, extract its features and log it in
+ * 			turn, passing the buffer on by reference. The logger stage
+ * 			publishes the readings as the analog task did, and prints the
+ * 			features once a second; the print task reports the depth and
+ * 			latency of each stage with the other statistics.
+ *
+ * 			With SPECTRUM set, the analog task also collects the raw
+ * 			samples into frames of SPECTRUM_SIZE, handed over through a
+ * 			ping-pong double buffer (pingpong.h). vSpectrumTask computes the
+ * 			spectrum of each frame on the FPU ('spectrum.c') and prints its
+ * 			feature vector every SPECTRUM_PRINT_FRAMES frames: a few numbers
+ * 			instead of the 32 KB/s of raw samples, which the 115200 baud
+ * 			link could not carry.
+ *
+ * 			With CONFIG_STORE set, the alarm thresholds and the statistics
+ * 			period are a table in a read-copy-update store (cfgstore.h)
+ * 			instead of constants. The print and alarm tasks read the
+ * 			current version with one pointer load on every pass;
+ * 			vConfigTask reads commands from the console (USART2 RX) and
+ * 			publishes a new version, which each task picks up on its next
+ * 			pass:
+ * 				alarm_high <counts>, alarm_low <counts>, stats_ms <ms>, show
+ *
+ * 			With CONFIG_INPUT_RTT set, the commands come from the RTT
+ * 			terminal (rtt.h) instead, typed in the debugger's RTT console:
+ * 			the probe writes them to a ring in SRAM and USART2 RX is left
+ * 			alone.
+ *
  ******************************************************************************/
 
 /* Includes ------------------------------------------------------------------*/
-#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
+#include "rwlock.h"
+#include "seqlock.h"
+#include "pubsub.h"
 #include "uart.h"
 #include "exti.h"
 #include "adc.h"
+#include "gpio_capture.h"
+#include "filter.h"
+#include "gatekeeper.h"
+#include "heap_regions.h"
+#include "fmt.h"
+#include "pingpong.h"
+#include "spectrum.h"
+#include "qadvisor.h"
+#include "pipeline.h"
+#include "cfgstore.h"
+#include "rtt.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define ANALOG_SAMPLE_RATE_HZ	16000U
+#define ANALOG_BLOCK_SIZE		160U	/* One block every 10 ms. */
+#define ANALOG_FIR_TAPS			16U
+#define PRINT_STATS_MS			5000U	/* Gatekeeper statistics period. */
+#define DIGITAL_SAMPLE_RATE_HZ	1000000U
+#define DIGITAL_BLOCK_SIZE		1000U	/* One block every 1 ms. */
+#define DIGITAL_PRINT_BLOCKS	10U		/* Print every 10 ms, as before. */
+#define DIGITAL_SENSOR_MASK		(1U << 13)	/* PC13 (B1). */
+#define SPECTRUM				1		/* 0: no spectra, 1: vSpectrumTask analyses the analog stream */
+#define SPECTRUM_PRINT_FRAMES	16U		/* Print one frame in 16, about every 0.5 s. */
+#define SPECTRUM_ADC_MID_SCALE	2048.0f
+#define ANALOG_TOPIC			1		/* 0: latest-value channel, 1: pub/sub topic with an alarm subscriber */
+#define ANALOG_TOPIC_DEPTH		8U		/* Readings kept for slow subscribers, 80 ms. */
+#define ANALOG_ALARM_HIGH		3000U	/* Raise the alarm above this value. */
+#define ANALOG_ALARM_LOW		2900U	/* And clear it below this one. */
+#define ANALOG_ALARM_WATCHDOG	1		/* 0: the alarm task checks every reading, 1: the ADC watchdog wakes it on a change */
+#define PRINT_CREDITS			1		/* 0: sensor lines wait for room in the gatekeeper queue, 1: credit-based flow control */
+#define DIGITAL_CREDIT_WINDOW	2U		/* Gatekeeper queue slots lent to each sensor task. */
+#define ANALOG_CREDIT_WINDOW	2U
+#define DIGITAL_PRINT_BLOCKS_MAX	(DIGITAL_PRINT_BLOCKS * 32U)	/* Slowest digital print rate, 320 ms. */
+#define ANALOG_PIPELINE			1		/* 0: the analog task filters and publishes each block, 1: pipeline stages do */
+#define ANALOG_PIPELINE_BUFFERS	6U		/* Blocks in flight, 60 ms. */
+#define ANALOG_LOG_BATCH		4U		/* Blocks the logger stage takes per wakeup. */
+#define ANALOG_LOG_WAIT_MS		30U		/* Longest wait for a full logger batch. */
+#define ANALOG_LOG_BLOCKS		100U	/* Print the features every second. */
+#define CONFIG_STORE			1		/* 0: fixed thresholds and statistics period, 1: set from the console */
+#define CONFIG_LINE_MAX			32U		/* Longest console command. */
+#define CONFIG_INPUT_RTT		0		/* 0: commands from USART2 RX, 1: from the RTT terminal */
+#define CONFIG_POLL_MS			100U	/* How soon the watchdog alarm task applies new thresholds. */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 int __io_putchar(int ch);
+static int32_t uart_gatekeeper_write(void *pvContext, uint32_t ulAddress,
+		const uint8_t *pucData, uint32_t ulLength);
+static void vGatekeeperPrint(const char *pcFormat, ...) FMT_CHECK(1, 2);
+#if (ANALOG_TOPIC == 1)
+static void vUrgentPrint(const char *pcFormat, ...) FMT_CHECK(1, 2);
+#endif
+static int32_t lGatekeeperPrintCredit(Credit_t *pxCredit, const char *pcFormat, ...) FMT_CHECK(2, 3);
+static int32_t lGatekeeperVPrint(Credit_t *pxCredit, const char *pcFormat, va_list xArgs);
+static void vPrintQueueMetrics(void);
 void vReadDigitalSensorTask(void *pvParameters);
 void vReadAnalogSensorTask(void *pvParameters);
 void vPrintTask(void *pvParameters);
+#if (ANALOG_TOPIC == 1)
+void vAnalogAlarmTask(void *pvParameters);
+#endif
+#if (ANALOG_PIPELINE == 1)
+static void vAnalogFilterStage(void *pvContext, PipelineBuffer_t * const *ppxBuffers, uint32_t ulCount);
+static void vAnalogFeatureStage(void *pvContext, PipelineBuffer_t * const *ppxBuffers, uint32_t ulCount);
+static void vAnalogLogStage(void *pvContext, PipelineBuffer_t * const *ppxBuffers, uint32_t ulCount);
+static void vPrintPipelineStats(void);
+#endif
+#if (SPECTRUM == 1)
+static void vSpectrumFeed(const uint16_t *pusBlock, uint32_t ulCount);
+void vSpectrumTask(void *pvParameters);
+#endif
+#if (CONFIG_STORE == 1)
+void vConfigTask(void *pvParameters);
+static void vConfigCommand(char *pcLine);
+static int32_t lConfigNumber(const char *pcText, uint32_t *pulValue);
+#endif
 
 /* Data types ----------------------------------------------------------------*/
 typedef uint32_t TaskProfiler;
 
+typedef struct
+{
+	uint32_t ulValue;	/* Latest filtered sample. */
+	uint32_t ulBlock;	/* Blocks filtered since start. */
+} AnalogReading_t;
+
+#if (ANALOG_PIPELINE == 1)
+/* Payload of a pipeline buffer: one block on its way through the stages. */
+typedef struct
+{
+	AnalogReading_t xReading;	/* Set by the feature stage. */
+	uint32_t ulMin;				/* Filtered block, in ADC counts. */
+	uint32_t ulMax;
+	uint32_t ulMean;
+	int16_t sSamples[ANALOG_BLOCK_SIZE];	/* Q15, filtered in place. */
+} AnalogBlock_t;
+#endif
+
+/* Run-time settings, read by the print and alarm tasks. */
+typedef struct
+{
+	uint32_t ulAlarmHigh;		/* Raise the alarm above this value. */
+	uint32_t ulAlarmLow;		/* And clear it below this one. */
+	uint32_t ulStatsMs;			/* Gatekeeper statistics period. */
+} SensorConfig_t;
+
 /* Variables -----------------------------------------------------------------*/
 uint8_t digital_snsr_state;
 uint32_t analog_snsr_value;
-QueueHandle_t xPrintQueue;
+RWLockHandle_t xSensorLock;
+static StaticRWLock_t xSensorLockBuffer;
+#if (ANALOG_TOPIC == 1)
+static PubSubTopic_t xAnalogTopic;
+static AnalogReading_t xAnalogTopicSlots[ANALOG_TOPIC_DEPTH];
+static PubSubSubscriber_t xPrintSubscriber;
+#if (ANALOG_ALARM_WATCHDOG == 0)
+static PubSubSubscriber_t xAlarmSubscriber;
+#endif
+#else
+static Seqlock_t xAnalogChannel;
+static AnalogReading_t xAnalogChannelData;
+#endif
+static Gatekeeper_t xUartGatekeeper;
+#if (PRINT_CREDITS == 1)
+static Credit_t xDigitalCredit;
+static Credit_t xAnalogCredit;
+static volatile uint32_t ulDigitalPrintBlocks = DIGITAL_PRINT_BLOCKS;	/* Read by vPrintTask. */
+static volatile uint32_t ulDigitalSkipped = 0;
+#endif
+static QueueRegistryMetrics_t xQueueMetrics[configQUEUE_REGISTRY_SIZE];	/* Too big for the stack of vPrintTask. */
+static QadvisorAdvice_t xQueueAdvice[configQUEUE_REGISTRY_SIZE];
+static const SensorConfig_t xConfigDefaults = { ANALOG_ALARM_HIGH, ANALOG_ALARM_LOW, PRINT_STATS_MS };
+#if (CONFIG_STORE == 1)
+static CfgStore_t xConfigStore;
+static SensorConfig_t xConfigCopies[2];
+/* Valid until the reading task next blocks (cfgstore_read()). */
+#define CONFIG_GET() ((const SensorConfig_t *)cfgstore_read(&xConfigStore))
+#else
+#define CONFIG_GET() (&xConfigDefaults)
+#endif
+
+/* 16-tap Hann-windowed low-pass, cut-off at 1/8 of the sample rate (Q15, the
+ * taps are symmetric so the time-reversed order is the same). */
+static const int16_t sAnalogFirCoeffs[ANALOG_FIR_TAPS] =
+{ 0, -63, -287, -303, 623, 2859, 5746, 7808, 7808, 5746, 2859, 623, -303, -287, -63, 0 };
+static int16_t sAnalogFirState[ANALOG_FIR_TAPS - 1U + ANALOG_BLOCK_SIZE];
+static uint16_t *pusAnalogSamples = NULL;	/* Two blocks, in SRAM2. */
+#if (ANALOG_PIPELINE == 0)
+static int16_t sAnalogFiltered[ANALOG_BLOCK_SIZE];
+#endif
+static FirQ15_t xAnalogFir;
+static uint16_t *pusDigitalSamples = NULL;	/* Two blocks, in SRAM2. */
+
+#if (ANALOG_PIPELINE == 1)
+/* Acquisition (vReadAnalogSensorTask) -> filter -> features -> logger. */
+static Pipeline_t xAnalogPipeline;
+static const PipelineStageConfig_t xAnalogStages[] =
+{
+	{ "vAnalogFilter", vAnalogFilterStage, NULL, 2, 1U, 0 },
+	{ "vAnalogFeature", vAnalogFeatureStage, NULL, 1, 2U, 0 },
+	{ "vAnalogLog", vAnalogLogStage, NULL, 1, ANALOG_LOG_BATCH, pdMS_TO_TICKS(ANALOG_LOG_WAIT_MS) }
+};
+#endif
+
+#if (SPECTRUM == 1)
+static float fSpectrumFrames[2][SPECTRUM_SIZE];
+static PingPong_t xSpectrumPingPong;
+static float *pfSpectrumFill;				/* Frame of the analog task. */
+static uint32_t ulSpectrumFillCount;
+#endif
 
 /**
  * @brief The application entry point.
@@ -44,6 +291,10 @@ QueueHandle_t xPrintQueue;
  */
 int main(void)
 {
+#if (ANALOG_PIPELINE == 1)
+	uint32_t i;
+#endif
+
 	HAL_Init();
 
 	/* Configure the system clock */
@@ -53,12 +304,12 @@ int main(void)
 	MX_GPIO_Init();
 	USART2_UART_TX_Init();
 
-	printf("System Initializing...\n\r");
+	fmt_printf("System Initializing...\n\r");
 
 	/* Create tasks. */
 	xTaskCreate(vReadDigitalSensorTask,
 				"vReadDigitalSensorTask",
-				128,
+				256,
 				NULL,
 				1,
 				NULL);
@@ -70,15 +321,93 @@ int main(void)
 				1,
 				NULL);
 
-	/* Gatekeeper task. */
 	xTaskCreate(vPrintTask,
 				"vPrintTask",
-				128,
+				256,
 				NULL,
 				0,
 				NULL);
 
-	xPrintQueue = xQueueCreate(2, sizeof(int32_t));
+#if (SPECTRUM == 1)
+	/* The analog task fills one frame while this task analyses the other. */
+	if ((pingpong_init(&xSpectrumPingPong, fSpectrumFrames[0], fSpectrumFrames[1]) != 0)
+			|| (xTaskCreate(vSpectrumTask, "vSpectrumTask", 256, NULL, 1, NULL) != pdPASS))
+	{
+		Error_Handler();
+	}
+
+	pfSpectrumFill = pingpong_fill_buffer(&xSpectrumPingPong);
+#endif
+
+	/* Gatekeeper task, the only one that touches the UART. */
+	if (gatekeeper_start(&xUartGatekeeper, "vUartGatekeeper", uart_gatekeeper_write, NULL, 0) != 0)
+	{
+		Error_Handler();
+	}
+
+#if (PRINT_CREDITS == 1)
+	/* 4 of the 8 queue slots; the other lines still wait for room. */
+	if ((gatekeeper_add_producer(&xUartGatekeeper, &xDigitalCredit, DIGITAL_CREDIT_WINDOW) != 0)
+			|| (gatekeeper_add_producer(&xUartGatekeeper, &xAnalogCredit, ANALOG_CREDIT_WINDOW) != 0))
+	{
+		Error_Handler();
+	}
+#endif
+
+	xSensorLock = xRWLockCreateStatic(&xSensorLockBuffer);
+
+#if (ANALOG_PIPELINE == 1)
+	if (pipeline_init(&xAnalogPipeline, ANALOG_PIPELINE_BUFFERS, sizeof(AnalogBlock_t)) != 0)
+	{
+		Error_Handler();
+	}
+
+	for (i = 0; i < (sizeof(xAnalogStages) / sizeof(xAnalogStages[0])); i++)
+	{
+		if (pipeline_add_stage(&xAnalogPipeline, &xAnalogStages[i]) < 0)
+		{
+			Error_Handler();
+		}
+	}
+
+	if (pipeline_start(&xAnalogPipeline) != 0)
+	{
+		Error_Handler();
+	}
+#endif
+
+#if (ANALOG_TOPIC == 1)
+	/* Both subscribers take every reading from the first one on. */
+	if ((pubsub_init(&xAnalogTopic, xAnalogTopicSlots, sizeof(AnalogReading_t), ANALOG_TOPIC_DEPTH) != 0)
+			|| (pubsub_subscribe(&xAnalogTopic, &xPrintSubscriber) != 0)
+#if (ANALOG_ALARM_WATCHDOG == 0)
+			|| (pubsub_subscribe(&xAnalogTopic, &xAlarmSubscriber) != 0)
+#endif
+			|| (xTaskCreate(vAnalogAlarmTask, "vAnalogAlarmTask", 256, NULL, 1, NULL) != pdPASS))
+	{
+		Error_Handler();
+	}
+#else
+	if (seqlock_init(&xAnalogChannel, &xAnalogChannelData, sizeof(xAnalogChannelData)) != 0)
+	{
+		Error_Handler();
+	}
+#endif
+
+#if (CONFIG_STORE == 1)
+#if (CONFIG_INPUT_RTT == 1)
+	/* So that the probe finds the control block as soon as it attaches. */
+	rtt_init();
+#endif
+
+	/* Before the readers run; USART2 has its RX ring (UART_RX_RING_SIZE). */
+	if ((cfgstore_init(&xConfigStore, &xConfigCopies[0], &xConfigCopies[1],
+			sizeof(SensorConfig_t), &xConfigDefaults) != 0)
+			|| (xTaskCreate(vConfigTask, "vConfigTask", 256, NULL, 1, NULL) != pdPASS))
+	{
+		Error_Handler();
+	}
+#endif
 
 	vTaskStartScheduler();
 
@@ -90,104 +419,952 @@ int main(void)
 }
 
 /**
- * @brief Reads digital sensor data and sends it to the print queue.
+ * @brief Receives blocks of GPIOC samples captured at a fixed rate, counts the
+ * digital sensor edges, and prints the state along with a snapshot of both
+ * sensor readings.
  * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
  * task function signature.
  * @return None.
+ * @note With PRINT_CREDITS set, the print period adapts to the credit the
+ * gatekeeper grants back, between DIGITAL_PRINT_BLOCKS and
+ * DIGITAL_PRINT_BLOCKS_MAX blocks.
  */
 void vReadDigitalSensorTask(void *pvParameters)
 {
+	uint16_t *pusBlock;
+	uint16_t usPrevious;
+	uint32_t ulEdges = 0;
+	uint32_t ulBlocks = 0;
+#if (PRINT_CREDITS == 1)
+	uint32_t ulPrintBlocks = DIGITAL_PRINT_BLOCKS;
+	uint32_t ulCredit;
+#else
+	const uint32_t ulPrintBlocks = DIGITAL_PRINT_BLOCKS;
+#endif
+	int32_t lState;
+	uint8_t ucDigital;
+	uint32_t ulAnalog;
+
 	gpio_init();
+	usPrevious = (uint16_t)GPIOC->IDR;
+
+	/* The capture double buffer goes in SRAM2 with the other DMA buffers. */
+	pusDigitalSamples = pvPortMallocRegion(2U * DIGITAL_BLOCK_SIZE * sizeof(uint16_t),
+			HEAP_REGION_SRAM2);
+
+	if ((pusDigitalSamples == NULL)
+			|| (gpio_capture_init(GPIOC, DIGITAL_SAMPLE_RATE_HZ, &pusDigitalSamples[0],
+					&pusDigitalSamples[DIGITAL_BLOCK_SIZE], DIGITAL_BLOCK_SIZE,
+					xTaskGetCurrentTaskHandle()) != 0)
+			|| (gpio_capture_start() != 0))
+	{
+		Error_Handler();
+	}
 
 	while (1)
 	{
-		digital_snsr_state = read_digital_sensor();
-		xQueueSendToBack(xPrintQueue, &digital_snsr_state, 0);
-		vTaskDelay(10);
+		/* Blocked here between blocks; sampling runs without the CPU. */
+		pusBlock = gpio_capture_wait(portMAX_DELAY);
+
+		ulEdges += gpio_capture_count_edges(pusBlock, DIGITAL_BLOCK_SIZE,
+				DIGITAL_SENSOR_MASK, &usPrevious);
+
+		if (++ulBlocks < ulPrintBlocks)
+		{
+			continue;
+		}
+
+		ulBlocks = 0;
+		lState = ((usPrevious & DIGITAL_SENSOR_MASK) != 0U) ? 1 : 0;
+
+		xRWLockTakeWrite(xSensorLock, portMAX_DELAY);
+		digital_snsr_state = (uint8_t)lState;
+		vRWLockGiveWrite(xSensorLock);
+
+#if (PRINT_CREDITS == 1)
+		/* No credit: the UART is behind, so back off before formatting
+		 * anything. All of it back: the UART keeps up, so speed up again. */
+		ulCredit = credit_available(&xDigitalCredit);
+
+		if (ulCredit == 0U)
+		{
+			ulDigitalSkipped++;
+
+			if (ulPrintBlocks < DIGITAL_PRINT_BLOCKS_MAX)
+			{
+				ulPrintBlocks *= 2U;
+				ulDigitalPrintBlocks = ulPrintBlocks;
+			}
+
+			continue;
+		}
+
+		if ((ulCredit == DIGITAL_CREDIT_WINDOW) && (ulPrintBlocks > DIGITAL_PRINT_BLOCKS))
+		{
+			ulPrintBlocks /= 2U;
+			ulDigitalPrintBlocks = ulPrintBlocks;
+		}
+#endif
+
+		/* Both readings come from the same moment. */
+		xRWLockTakeRead(xSensorLock, portMAX_DELAY);
+		ucDigital = digital_snsr_state;
+		ulAnalog = analog_snsr_value;
+		vRWLockGiveRead(xSensorLock);
+
+#if (PRINT_CREDITS == 1)
+		(void)lGatekeeperPrintCredit(&xDigitalCredit,
+				"Sensor value: %ld (digital %u, analog %lu, edges %lu, overruns %lu)\n\r",
+				lState, ucDigital, ulAnalog, ulEdges, gpio_capture_get_overruns());
+#else
+		vGatekeeperPrint("Sensor value: %ld (digital %u, analog %lu, edges %lu, overruns %lu)\n\r",
+				lState, ucDigital, ulAnalog, ulEdges, gpio_capture_get_overruns());
+#endif
 	}
 }
 
 /**
- * @brief Reads analog sensor data and sends it to the print queue.
+ * @brief Receives blocks of analog sensor data sampled at a fixed rate by the
+ * ADC stream, low-pass filters them and publishes the latest filtered value
+ * on the analog channel or topic.
  * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
  * task function signature.
  * @return None.
+ * @note With ANALOG_PIPELINE set, it only submits each block to the pipeline,
+ * whose stages filter and publish it.
  */
 void vReadAnalogSensorTask(void *pvParameters)
 {
-	adc_init();
+	uint16_t *pusBlock;
+#if (ANALOG_PIPELINE == 1)
+	PipelineBuffer_t *pxBuffer;
+#else
+	AnalogReading_t xReading = { 0 };
+#endif
+
+	/* The ADC DMA double buffer goes in SRAM2, so the DMA does not compete
+	 * with the CPU for SRAM1. */
+	pusAnalogSamples = pvPortMallocRegion(2U * ANALOG_BLOCK_SIZE * sizeof(uint16_t),
+			HEAP_REGION_SRAM2);
+
+	if ((pusAnalogSamples == NULL)
+			|| (filter_fir_init(&xAnalogFir, sAnalogFirCoeffs, ANALOG_FIR_TAPS,
+			sAnalogFirState, ANALOG_BLOCK_SIZE) != 0)
+			|| (adc_stream_init(ANALOG_SAMPLE_RATE_HZ, &pusAnalogSamples[0],
+					&pusAnalogSamples[ANALOG_BLOCK_SIZE], ANALOG_BLOCK_SIZE,
+					xTaskGetCurrentTaskHandle()) != 0)
+			|| (adc_stream_start() != 0))
+	{
+		Error_Handler();
+	}
 
 	while (1)
 	{
-		analog_snsr_value = read_analog_sensor();
-		xQueueSendToBack(xPrintQueue, &analog_snsr_value, 0);
-		vTaskDelay(10);
+		/* Blocked here between blocks; conversions run without the CPU. */
+		pusBlock = adc_stream_wait(portMAX_DELAY);
+
+#if (SPECTRUM == 1)
+		/* Unfiltered: the low-pass would hide the upper 3/4 of the spectrum. */
+		vSpectrumFeed(pusBlock, ANALOG_BLOCK_SIZE);
+#endif
+
+#if (ANALOG_PIPELINE == 1)
+		/* The DMA buffer is needed again in one block period, so the samples
+		 * are converted once into a pipeline buffer, which then travels by
+		 * reference. A block finding no buffer free is lost. */
+		pxBuffer = pipeline_alloc(&xAnalogPipeline, 0);
+
+		if (pxBuffer != NULL)
+		{
+			filter_adc_to_q15(pusBlock, ((AnalogBlock_t *)pxBuffer->ucData)->sSamples,
+					ANALOG_BLOCK_SIZE);
+			pxBuffer->ulLength = sizeof(AnalogBlock_t);
+			(void)pipeline_submit(&xAnalogPipeline, &pxBuffer);
+		}
+#else
+		filter_adc_to_q15(pusBlock, sAnalogFiltered, ANALOG_BLOCK_SIZE);
+		filter_fir_q15(&xAnalogFir, sAnalogFiltered, sAnalogFiltered, ANALOG_BLOCK_SIZE);
+
+		xReading.ulValue = filter_q15_to_adc(sAnalogFiltered[ANALOG_BLOCK_SIZE - 1U]);
+		xReading.ulBlock++;
+
+		xRWLockTakeWrite(xSensorLock, portMAX_DELAY);
+		analog_snsr_value = xReading.ulValue;
+		vRWLockGiveWrite(xSensorLock);
+
+#if (ANALOG_TOPIC == 1)
+		/* One copy, and a wakeup for each subscriber that is waiting. */
+		pubsub_publish(&xAnalogTopic, &xReading);
+#else
+		/* This task is the only writer, so the write always succeeds. */
+		(void)seqlock_write(&xAnalogChannel, &xReading);
+		seqlock_wake(&xAnalogChannel);
+#endif
+#endif
+	}
+}
+
+#if (ANALOG_PIPELINE == 1)
+/**
+ * @brief Filter stage: low-pass filters each block in place.
+ * @param pvContext Unused.
+ * @param ppxBuffers Blocks, oldest first.
+ * @param ulCount Number of blocks.
+ * @retval None
+ * @note The FIR keeps its state from block to block, which the pipeline's
+ * ordering preserves.
+ */
+static void vAnalogFilterStage(void *pvContext, PipelineBuffer_t * const *ppxBuffers, uint32_t ulCount)
+{
+	AnalogBlock_t *pxBlock;
+	uint32_t i;
+
+	for (i = 0; i < ulCount; i++)
+	{
+		pxBlock = (AnalogBlock_t *)ppxBuffers[i]->ucData;
+		filter_fir_q15(&xAnalogFir, pxBlock->sSamples, pxBlock->sSamples, ANALOG_BLOCK_SIZE);
+	}
+}
+
+/**
+ * @brief Feature stage: computes the reading, minimum, maximum and mean of each
+ * filtered block.
+ * @param pvContext Unused.
+ * @param ppxBuffers Blocks, oldest first.
+ * @param ulCount Number of blocks.
+ * @retval None
+ */
+static void vAnalogFeatureStage(void *pvContext, PipelineBuffer_t * const *ppxBuffers, uint32_t ulCount)
+{
+	AnalogBlock_t *pxBlock;
+	int32_t lMin;
+	int32_t lMax;
+	int32_t lSum;
+	uint32_t i;
+	uint32_t j;
+
+	for (i = 0; i < ulCount; i++)
+	{
+		pxBlock = (AnalogBlock_t *)ppxBuffers[i]->ucData;
+		lMin = INT16_MAX;
+		lMax = INT16_MIN;
+		lSum = 0;
+
+		for (j = 0; j < ANALOG_BLOCK_SIZE; j++)
+		{
+			lMin = (pxBlock->sSamples[j] < lMin) ? pxBlock->sSamples[j] : lMin;
+			lMax = (pxBlock->sSamples[j] > lMax) ? pxBlock->sSamples[j] : lMax;
+			lSum += pxBlock->sSamples[j];
+		}
+
+		pxBlock->ulMin = filter_q15_to_adc((int16_t)lMin);
+		pxBlock->ulMax = filter_q15_to_adc((int16_t)lMax);
+		pxBlock->ulMean = filter_q15_to_adc((int16_t)(lSum / (int32_t)ANALOG_BLOCK_SIZE));
+		pxBlock->xReading.ulValue = filter_q15_to_adc(pxBlock->sSamples[ANALOG_BLOCK_SIZE - 1U]);
+		pxBlock->xReading.ulBlock = ppxBuffers[i]->ulSequence + 1U;
 	}
 }
 
-int val;
+/**
+ * @brief Logger stage: publishes the reading of each block on the analog
+ * channel or topic, and prints the features of one block in
+ * ANALOG_LOG_BLOCKS.
+ * @param pvContext Unused.
+ * @param ppxBuffers Blocks, oldest first.
+ * @param ulCount Number of blocks.
+ * @retval None
+ */
+static void vAnalogLogStage(void *pvContext, PipelineBuffer_t * const *ppxBuffers, uint32_t ulCount)
+{
+	const AnalogBlock_t *pxBlock;
+	uint32_t i;
+
+	for (i = 0; i < ulCount; i++)
+	{
+		pxBlock = (const AnalogBlock_t *)ppxBuffers[i]->ucData;
+
+#if (ANALOG_TOPIC == 1)
+		pubsub_publish(&xAnalogTopic, &pxBlock->xReading);
+#else
+		/* This stage is the only writer, so the write always succeeds. */
+		(void)seqlock_write(&xAnalogChannel, &pxBlock->xReading);
+		seqlock_wake(&xAnalogChannel);
+#endif
+
+		if ((pxBlock->xReading.ulBlock % ANALOG_LOG_BLOCKS) == 0U)
+		{
+			vGatekeeperPrint("Analog features: block %lu, min %lu, max %lu, mean %lu\n\r",
+					pxBlock->xReading.ulBlock, pxBlock->ulMin, pxBlock->ulMax, pxBlock->ulMean);
+		}
+	}
+
+	/* The newest reading of the batch is the latest value. */
+	pxBlock = (const AnalogBlock_t *)ppxBuffers[ulCount - 1U]->ucData;
+	xRWLockTakeWrite(xSensorLock, portMAX_DELAY);
+	analog_snsr_value = pxBlock->xReading.ulValue;
+	vRWLockGiveWrite(xSensorLock);
+}
+#endif
 
 /**
- * @brief Prints a queued value. (A gatekeeper task that handles printing,
- * allowing sensor tasks to avoid synchronizing access to the UART resource.)
+ * @brief Prints each new analog reading, and the gatekeeper and queue
+ * statistics every PRINT_STATS_MS, or the period set from the console.
  * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
  * task function signature.
  * @return None.
  */
 void vPrintTask(void *pvParameters)
 {
+	TickType_t xStatsTicks;
+	TickType_t xLastStats = xTaskGetTickCount();
+#if (ANALOG_TOPIC == 1)
+	uint32_t ulLost;
+#else
+	uint32_t ulSequence = 0;
+#endif
+#if (PRINT_CREDITS == 1)
+	Credit_t *const pxCredit = &xAnalogCredit;
+#else
+	Credit_t *const pxCredit = NULL;	/* Wait for room in the queue. */
+#endif
+	uint32_t ulSkipped = 0;
+	AnalogReading_t xReading;
+	GatekeeperStats_t xStats;
+
 	while (1)
 	{
-		/* Wait for a message to arrive. */
-		xQueueReceive(xPrintQueue, &val, portMAX_DELAY);
-		printf("Sensor value: %d\n\r", val);
+		xStatsTicks = pdMS_TO_TICKS(CONFIG_GET()->ulStatsMs);
+
+#if (ANALOG_TOPIC == 1)
+		/* Wait for the next analog reading, but not past the next report.
+		 * Readings overwritten meanwhile are counted. */
+		if (pubsub_wait(&xAnalogTopic, &xPrintSubscriber, &xReading, &ulLost, xStatsTicks) == 0)
+		{
+			if (lGatekeeperPrintCredit(pxCredit, "Analog sensor value: %lu (block %lu, lost %lu)\n\r",
+					xReading.ulValue, xReading.ulBlock, ulLost) != 0)
+			{
+				ulSkipped++;
+			}
+		}
+#else
+		/* Wait for a new analog reading, but not past the next report.
+		 * Readings published meanwhile are skipped. */
+		ulSequence = seqlock_wait(&xAnalogChannel, ulSequence, xStatsTicks);
+
+		if ((ulSequence != 0U) && (seqlock_read(&xAnalogChannel, &xReading, &ulSequence) == 0))
+		{
+			if (lGatekeeperPrintCredit(pxCredit, "Analog sensor value: %lu (block %lu)\n\r",
+					xReading.ulValue, xReading.ulBlock) != 0)
+			{
+				ulSkipped++;
+			}
+		}
+#endif
+
+		if (((xTaskGetTickCount() - xLastStats) >= xStatsTicks)
+				&& (gatekeeper_get_stats(&xUartGatekeeper, &xStats) == 0))
+		{
+			/* Not a multiple of the old period once it changes. */
+			xLastStats = xTaskGetTickCount();
+
+			/* Requests per transaction show how much merging saves. */
+			vGatekeeperPrint("Gatekeeper: %lu requests, %lu transfers, peak depth %lu, peak batch %lu, dropped %lu\n\r",
+					xStats.ulRequests, xStats.ulTransactions, xStats.ulPeakDepth,
+					xStats.ulPeakBatch, xStats.ulDropped);
+
+			if (xStats.ulRequests > 0U)
+			{
+				vGatekeeperPrint("Gatekeeper: service %lu/%lu/%lu cycles (min/avg/max)\n\r",
+						xStats.ulMinCycles, (uint32_t)(xStats.ullTotalCycles / xStats.ulRequests),
+						xStats.ulMaxCycles);
+			}
+
+#if (PRINT_CREDITS == 1)
+			vGatekeeperPrint("Credits: digital every %lu ms, skipped %lu; analog skipped %lu\n\r",
+					ulDigitalPrintBlocks * DIGITAL_BLOCK_SIZE * 1000U / DIGITAL_SAMPLE_RATE_HZ,
+					ulDigitalSkipped, ulSkipped);
+#endif
+
+			vPrintQueueMetrics();
+#if (ANALOG_PIPELINE == 1)
+			vPrintPipelineStats();
+#endif
+		}
 	}
 }
 
+#if (ANALOG_TOPIC == 1)
+#if (ANALOG_ALARM_WATCHDOG == 1)
 /**
- * @brief System Clock Configuration
- * @retval None
+ * @brief Prints each change of the alarm state, as the ADC analog watchdog
+ * reports it.
+ * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
+ * task function signature.
+ * @return None.
+ * @note The watchdog sees every raw sample of the stream, 160 per reading, so
+ * even an excursion shorter than a block raises the alarm. The window is
+ * open below, so only ANALOG_ALARM_HIGH is watched, and the alarm clears once
+ * a sample is back below ANALOG_ALARM_LOW; the hysteresis keeps the noise on
+ * the raw samples from toggling it. The task wakes for nothing else, but
+ * for a look at the thresholds every CONFIG_POLL_MS with CONFIG_STORE set:
+ * the watchdog is re-armed when they change, starting inside the window, so
+ * an alarm still raised is reported again.
  */
-void SystemClock_Config(void)
+void vAnalogAlarmTask(void *pvParameters)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
+	const SensorConfig_t *pxSettings = CONFIG_GET();
+	AdcWatchConfig_t xConfig =
+	{
+		.ucChannel = 1U,							/* PA1, the stream's channel. */
+		.usLow = 0U,
+		.usHigh = (uint16_t)pxSettings->ulAlarmHigh,
+		.usHysteresis = (uint16_t)(pxSettings->ulAlarmHigh - pxSettings->ulAlarmLow),
+		.xTask = xTaskGetCurrentTaskHandle()
+	};
+#if (CONFIG_STORE == 1)
+	const TickType_t xWaitTicks = pdMS_TO_TICKS(CONFIG_POLL_MS);
+#else
+	const TickType_t xWaitTicks = portMAX_DELAY;
+#endif
+	uint16_t usValue;
+	int32_t lZone;
 
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+	if (adc_watch_init(&xConfig) != 0)
 	{
 		Error_Handler();
 	}
 
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+	while (1)
+	{
+		lZone = adc_watch_wait(&usValue, xWaitTicks);
+		pxSettings = CONFIG_GET();
+
+		if ((pxSettings->ulAlarmHigh != xConfig.usHigh)
+				|| ((pxSettings->ulAlarmHigh - pxSettings->ulAlarmLow) != xConfig.usHysteresis))
+		{
+			xConfig.usHigh = (uint16_t)pxSettings->ulAlarmHigh;
+			xConfig.usHysteresis = (uint16_t)(pxSettings->ulAlarmHigh - pxSettings->ulAlarmLow);
+
+			if (adc_watch_init(&xConfig) != 0)
+			{
+				Error_Handler();
+			}
+		}
+
+		if (lZone == (int32_t)ADC_WATCH_ABOVE)
+		{
+			vUrgentPrint("\n\rAnalog alarm: raised, sample %u, changes %lu\n\r",
+					usValue, adc_watch_get_events());
+		}
+		else if (lZone == (int32_t)ADC_WATCH_INSIDE)
+		{
+			vUrgentPrint("\n\rAnalog alarm: cleared, sample %u, changes %lu\n\r",
+					usValue, adc_watch_get_events());
+		}
+	}
+}
+#else
+/**
+ * @brief Checks every analog reading against the alarm threshold, and prints
+ * each change of the alarm state.
+ * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
+ * task function signature.
+ * @return None.
+ * @note Unlike the print task, this subscriber needs every reading: a short
+ * excursion may last a single block. The readings it missed, if any, are
+ * printed with the next change.
+ */
+void vAnalogAlarmTask(void *pvParameters)
+{
+	const SensorConfig_t *pxSettings;
+	AnalogReading_t xReading;
+	BaseType_t xAlarm = pdFALSE;
+
+	while (1)
+	{
+		(void)pubsub_wait(&xAnalogTopic, &xAlarmSubscriber, &xReading, NULL, portMAX_DELAY);
+		pxSettings = CONFIG_GET();
+
+		if ((xAlarm == pdFALSE) && (xReading.ulValue > pxSettings->ulAlarmHigh))
+		{
+			xAlarm = pdTRUE;
+			vUrgentPrint("\n\rAnalog alarm: raised at block %lu, value %lu, lost %lu\n\r",
+					xReading.ulBlock, xReading.ulValue, pubsub_get_overruns(&xAlarmSubscriber));
+		}
+		else if ((xAlarm != pdFALSE) && (xReading.ulValue < pxSettings->ulAlarmLow))
+		{
+			xAlarm = pdFALSE;
+			vUrgentPrint("\n\rAnalog alarm: cleared at block %lu, value %lu, lost %lu\n\r",
+					xReading.ulBlock, xReading.ulValue, pubsub_get_overruns(&xAlarmSubscriber));
+		}
+	}
+}
+#endif
+#endif
+
+#if (SPECTRUM == 1)
+/**
+ * @brief Appends raw analog samples to the frame being filled, and swaps each
+ * full frame in for vSpectrumTask.
+ * @param pusBlock Raw samples (0..4095).
+ * @param ulCount Number of samples.
+ * @retval None
+ * @note Blocks and frames need not line up: a block may end one frame and
+ * start the next.
+ */
+static void vSpectrumFeed(const uint16_t *pusBlock, uint32_t ulCount)
+{
+	uint32_t i;
+
+	for (i = 0; i < ulCount; i++)
+	{
+		pfSpectrumFill[ulSpectrumFillCount++] = (float)pusBlock[i] - SPECTRUM_ADC_MID_SCALE;
 
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+		if (ulSpectrumFillCount == SPECTRUM_SIZE)
+		{
+			pfSpectrumFill = pingpong_swap(&xSpectrumPingPong);
+			ulSpectrumFillCount = 0;
+		}
+	}
+}
+
+/**
+ * @brief Computes the spectrum of each frame of analog samples, and prints the
+ * feature vector of one frame in SPECTRUM_PRINT_FRAMES.
+ * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
+ * task function signature.
+ * @return None.
+ * @note The features are computed for every frame, as a detector would, even
+ * though only some are printed.
+ */
+void vSpectrumTask(void *pvParameters)
+{
+	SpectrumFeatures_t xFeatures;
+	char cBands[GATEKEEPER_REQUEST_BYTES];
+	uint32_t ulFrames = 0;
+	uint32_t ulLength;
+	uint32_t i;
+
+	while (1)
+	{
+		/* One wakeup per frame, every SPECTRUM_SIZE samples. */
+		spectrum_analyze(pingpong_wait(&xSpectrumPingPong, portMAX_DELAY),
+				ANALOG_SAMPLE_RATE_HZ, &xFeatures);
+
+		/* The features are all that is needed from the frame. */
+		pingpong_release(&xSpectrumPingPong);
+
+		if ((++ulFrames % SPECTRUM_PRINT_FRAMES) != 0U)
+		{
+			continue;
+		}
+
+		vGatekeeperPrint("Spectrum: frame %lu, rms %.1f, overruns %lu\n\r", ulFrames,
+				xFeatures.fRms, pingpong_get_overruns(&xSpectrumPingPong));
+
+		for (i = 0; i < SPECTRUM_PEAKS; i++)
+		{
+			vGatekeeperPrint("Spectrum: peak %.0f Hz, amplitude %.1f\n\r",
+					xFeatures.fPeakHz[i], xFeatures.fPeakAmplitude[i]);
+		}
+
+		ulLength = 0;
+
+		for (i = 0; (i < SPECTRUM_BANDS) && (ulLength < sizeof(cBands)); i++)
+		{
+			ulLength += (uint32_t)fmt_snprintf(&cBands[ulLength], sizeof(cBands) - ulLength,
+					" %.0f", xFeatures.fBandRms[i]);
+		}
+
+		vGatekeeperPrint("Spectrum: bands%s\n\r", cBands);
+	}
+}
+#endif
+
+#if (CONFIG_STORE == 1)
+/**
+ * @brief Reads console commands from USART2, or the RTT terminal, and applies
+ * each one as a new version of the settings.
+ * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
+ * task function signature.
+ * @return None.
+ * @note Lines end with CR or LF; longer ones than CONFIG_LINE_MAX are dropped.
+ */
+void vConfigTask(void *pvParameters)
+{
+	char cLine[CONFIG_LINE_MAX + 1U];
+	uint32_t ulLength = 0;
+	uint32_t ulOverlong = 0;
+	char cByte;
+
+	while (1)
+	{
+#if (CONFIG_INPUT_RTT == 1)
+		if (rtt_read_wait(0U, &cByte, 1, portMAX_DELAY) != 1)
+#else
+		if (uart_read(UART_PORT_2, &cByte, 1U, portMAX_DELAY) != 1)
+#endif
+		{
+			continue;
+		}
+
+		if ((cByte == '\r') || (cByte == '\n'))
+		{
+			if ((ulLength > 0U) && (ulOverlong == 0U))
+			{
+				cLine[ulLength] = '\0';
+				vConfigCommand(cLine);
+			}
+
+			ulLength = 0;
+			ulOverlong = 0;
+		}
+		else if (ulLength < CONFIG_LINE_MAX)
+		{
+			cLine[ulLength++] = cByte;
+		}
+		else
+		{
+			ulOverlong = 1U;
+		}
+	}
+}
+
+/**
+ * @brief Applies one console command.
+ * @param pcLine Command, without the line ending.
+ * @retval None
+ * @note The new version starts from the current one, so the other settings
+ * are kept. It is checked as a whole before it is published: the alarm
+ * window must fit the 12-bit ADC, low below high, as adc_watch_init() wants.
+ */
+static void vConfigCommand(char *pcLine)
+{
+	static const char *const pcNames[] = { "alarm_high", "alarm_low", "stats_ms" };
+	const SensorConfig_t *pxCurrent;
+	SensorConfig_t *pxNew;
+	CfgStoreStats_t xStats;
+	char *pcValue = pcLine;
+	uint32_t ulValue = 0;
+	uint32_t i;
+
+	while ((*pcValue != '\0') && (*pcValue != ' '))
+	{
+		pcValue++;
+	}
+
+	if (*pcValue == ' ')
+	{
+		*pcValue++ = '\0';
+	}
+
+	if (strcmp(pcLine, "show") == 0)
+	{
+		pxCurrent = CONFIG_GET();
+		cfgstore_get_stats(&xConfigStore, &xStats);
+		vGatekeeperPrint("Config: alarm_high %lu, alarm_low %lu, stats_ms %lu (version %lu, waits %lu, longest %lu ticks)\n\r",
+				pxCurrent->ulAlarmHigh, pxCurrent->ulAlarmLow, pxCurrent->ulStatsMs,
+				xStats.ulPublished, xStats.ulGraceWaits, xStats.ulGraceTicksMax);
+		return;
+	}
+
+	for (i = 0; i < (sizeof(pcNames) / sizeof(pcNames[0])); i++)
+	{
+		if (strcmp(pcLine, pcNames[i]) == 0)
+		{
+			break;
+		}
+	}
+
+	if ((i == (sizeof(pcNames) / sizeof(pcNames[0]))) || (lConfigNumber(pcValue, &ulValue) != 0))
+	{
+		vGatekeeperPrint("Config: alarm_high <counts>, alarm_low <counts>, stats_ms <ms> or show\n\r");
+		return;
+	}
+
+	pxNew = (SensorConfig_t *)cfgstore_edit(&xConfigStore, pdMS_TO_TICKS(1000));
+
+	if (pxNew == NULL)
+	{
+		vGatekeeperPrint("Config: busy, %s not changed\n\r", pcLine);
+		return;
+	}
+
+	if (i == 0U)
+	{
+		pxNew->ulAlarmHigh = ulValue;
+	}
+	else if (i == 1U)
+	{
+		pxNew->ulAlarmLow = ulValue;
+	}
+	else
+	{
+		pxNew->ulStatsMs = ulValue;
+	}
+
+	if ((pxNew->ulAlarmHigh > ADC_WATCH_MAX) || (pxNew->ulAlarmLow >= pxNew->ulAlarmHigh)
+			|| (pxNew->ulStatsMs < 100U))
+	{
+		cfgstore_cancel(&xConfigStore);
+		vGatekeeperPrint("Config: %s %lu out of range\n\r", pcLine, ulValue);
+		return;
+	}
+
+	cfgstore_publish(&xConfigStore);
+	vGatekeeperPrint("Config: %s %lu\n\r", pcLine, ulValue);
+}
+
+/**
+ * @brief Parses a decimal number.
+ * @param pcText Digits only.
+ * @param pulValue Receives the number.
+ * @retval 0 if successful, -1 if empty, not a number or over 9 digits.
+ */
+static int32_t lConfigNumber(const char *pcText, uint32_t *pulValue)
+{
+	uint32_t ulValue = 0;
+	uint32_t ulDigits = 0;
+
+	while ((*pcText >= '0') && (*pcText <= '9') && (ulDigits < 9U))
+	{
+		ulValue = (ulValue * 10U) + (uint32_t)(*pcText++ - '0');
+		ulDigits++;
+	}
+
+	if ((ulDigits == 0U) || (*pcText != '\0'))
+	{
+		return -1;
+	}
+
+	*pulValue = ulValue;
+
+	return 0;
+}
+#endif
+
+/**
+ * @brief Prints the counters of each queue in the queue registry, two lines
+ * per queue.
+ * @param None
+ * @retval None
+ * @note Sends and receives first, with the peak and the length of the
+ * queue; then blocks and timeouts (send/receive), the items dropped on a full
+ * queue, and the ticks spent blocked. Then the advised length of each queue,
+ * with the bytes it saves or costs, and the total.
+ */
+static void vPrintQueueMetrics(void)
+{
+	UBaseType_t uxCount = uxQueueGetRegistryMetrics(xQueueMetrics, configQUEUE_REGISTRY_SIZE);
+	UBaseType_t ux;
+	const QueueRegistryMetrics_t *pxEntry;
+	const QadvisorAdvice_t *pxAdvice;
+	int32_t lRamDelta;
+
+	for (ux = 0; ux < uxCount; ux++)
+	{
+		pxEntry = &xQueueMetrics[ux];
+		vGatekeeperPrint("Queue %s: tx %lu rx %lu peak %lu/%lu\n\r",
+				pxEntry->pcQueueName, pxEntry->xMetrics.ulSends, pxEntry->xMetrics.ulReceives,
+				pxEntry->xMetrics.ulHighWaterMark, (uint32_t)pxEntry->uxLength);
+		vGatekeeperPrint("Queue %s: blk %lu/%lu tmo %lu/%lu drop %lu wait %lu\n\r",
+				pxEntry->pcQueueName, pxEntry->xMetrics.ulSendsBlocked,
+				pxEntry->xMetrics.ulReceivesBlocked, pxEntry->xMetrics.ulSendTimeouts,
+				pxEntry->xMetrics.ulReceiveTimeouts, pxEntry->xMetrics.ulFullDrops,
+				pxEntry->xMetrics.ulTicksBlocked);
+	}
+
+	uxCount = qadvisor_evaluate(xQueueAdvice, configQUEUE_REGISTRY_SIZE, &lRamDelta);
+
+	for (ux = 0; ux < uxCount; ux++)
+	{
+		pxAdvice = &xQueueAdvice[ux];
+		vGatekeeperPrint("Advice %s: %s %lu -> %lu (%ld bytes)\n\r",
+				pxAdvice->pcName, qadvisor_verdict_name(pxAdvice->eVerdict),
+				(uint32_t)pxAdvice->uxLength, (uint32_t)pxAdvice->uxAdvisedLength,
+				pxAdvice->lRamDelta);
+	}
+
+	vGatekeeperPrint("Advice: %ld bytes in all\n\r", lRamDelta);
+}
+
+#if (ANALOG_PIPELINE == 1)
+/**
+ * @brief Prints the statistics of each stage of the analog pipeline, then of
+ * the whole pipeline.
+ * @param None
+ * @retval None
+ * @note Per stage: blocks and batches, queue depth now and at its peak, the
+ * average and longest wait from hand-over to processing, and the average
+ * and longest batch, all in cycles. Then the blocks submitted and completed,
+ * those lost to an empty pool, the buffers in flight, and the average and
+ * longest latency from submission to the end of the logger.
+ */
+static void vPrintPipelineStats(void)
+{
+	PipelineStageStats_t xStage;
+	PipelineStats_t xStats;
+	uint32_t i;
+
+	for (i = 0; pipeline_get_stage_stats(&xAnalogPipeline, i, &xStage) == 0; i++)
+	{
+		if (xStage.ulBatches == 0U)
+		{
+			continue;
+		}
+
+		vGatekeeperPrint("Stage %s: %lu in %lu batches, depth %lu/%lu, wait %lu/%lu, run %lu/%lu cycles\n\r",
+				xAnalogStages[i].pcName, xStage.ulBuffers, xStage.ulBatches, xStage.ulDepth,
+				xStage.ulPeakDepth, (uint32_t)(xStage.ullTotalWaitCycles / xStage.ulBuffers),
+				xStage.ulMaxWaitCycles, (uint32_t)(xStage.ullTotalBatchCycles / xStage.ulBatches),
+				xStage.ulMaxBatchCycles);
+	}
+
+	if ((pipeline_get_stats(&xAnalogPipeline, &xStats) == 0) && (xStats.ulCompleted > 0U))
+	{
+		vGatekeeperPrint("Pipeline: %lu submitted, %lu done, %lu lost, %lu in flight, latency %lu/%lu cycles\n\r",
+				xStats.ulSubmitted, xStats.ulCompleted, xStats.ulAllocFailures, xStats.ulInUse,
+				(uint32_t)(xStats.ullTotalLatencyCycles / xStats.ulCompleted),
+				xStats.ulMaxLatencyCycles);
+	}
+}
+#endif
+
+/**
+ * @brief Formats a line and posts it to the UART gatekeeper, waiting for room
+ * in its queue.
+ * @param pcFormat Format, as for fmt_vsnprintf().
+ * @retval None
+ */
+static void vGatekeeperPrint(const char *pcFormat, ...)
+{
+	va_list xArgs;
+
+	va_start(xArgs, pcFormat);
+	(void)lGatekeeperVPrint(NULL, pcFormat, xArgs);
+	va_end(xArgs);
+}
+
+#if (ANALOG_TOPIC == 1)
+/**
+ * @brief Formats a line and queues it on the urgent lane of the console,
+ * bypassing the gatekeeper.
+ * @param pcFormat Format, as for fmt_vsnprintf().
+ * @retval None
+ */
+static void vUrgentPrint(const char *pcFormat, ...)
+{
+	char cLine[GATEKEEPER_REQUEST_BYTES];
+	va_list xArgs;
+	int iLength;
+
+	va_start(xArgs, pcFormat);
+	iLength = fmt_vsnprintf(cLine, sizeof(cLine), pcFormat, xArgs);
+	va_end(xArgs);
+
+	if (iLength <= 0)
+	{
+		return;
+	}
+
+	if (iLength >= (int)sizeof(cLine))
+	{
+		iLength = (int)sizeof(cLine) - 1;
+	}
+
+	(void)USART2_write_urgent(cLine, iLength);
+}
+#endif
+
+/**
+ * @brief Formats a line and posts it to the UART gatekeeper if the producer
+ * has credit for it.
+ * @param pxCredit Credit link of the calling task, or NULL to wait for room in
+ * the queue instead.
+ * @param pcFormat Format, as for fmt_vsnprintf().
+ * @retval 0 if the line was posted, -1 otherwise.
+ */
+static int32_t lGatekeeperPrintCredit(Credit_t *pxCredit, const char *pcFormat, ...)
+{
+	va_list xArgs;
+	int32_t lResult;
+
+	va_start(xArgs, pcFormat);
+	lResult = lGatekeeperVPrint(pxCredit, pcFormat, xArgs);
+	va_end(xArgs);
+
+	return lResult;
+}
+
+/**
+ * @brief Formats a line and posts it to the UART gatekeeper.
+ * @param pxCredit Credit link of the calling task, or NULL to wait for room in
+ * the queue.
+ * @param pcFormat Format, as for fmt_vsnprintf().
+ * @param xArgs Arguments of the format.
+ * @retval 0 if the line was posted, -1 otherwise.
+ * @note Lines are cut at GATEKEEPER_REQUEST_BYTES - 1 characters, so each is
+ * printed whole and takes one credit.
+ */
+static int32_t lGatekeeperVPrint(Credit_t *pxCredit, const char *pcFormat, va_list xArgs)
+{
+	char cLine[GATEKEEPER_REQUEST_BYTES];
+	int iLength;
+
+	/* Not worth formatting a line that cannot be posted. */
+	if ((pxCredit != NULL) && (credit_available(pxCredit) == 0U))
+	{
+		return -1;
+	}
+
+	iLength = fmt_vsnprintf(cLine, sizeof(cLine), pcFormat, xArgs);
+
+	if (iLength <= 0)
+	{
+		return -1;
+	}
+
+	if (iLength >= (int)sizeof(cLine))
+	{
+		iLength = (int)sizeof(cLine) - 1;
+	}
+
+	if (pxCredit != NULL)
+	{
+		return gatekeeper_write_credit(&xUartGatekeeper, pxCredit, GATEKEEPER_ADDRESS_STREAM,
+				cLine, (uint32_t)iLength);
+	}
+
+	return gatekeeper_write(&xUartGatekeeper, GATEKEEPER_ADDRESS_STREAM, cLine,
+			(uint32_t)iLength, portMAX_DELAY);
+}
+
+/**
+ * @brief Sends one merged batch of lines (gatekeeper write function).
+ * @param pvContext Unused.
+ * @param ulAddress Always GATEKEEPER_ADDRESS_STREAM.
+ * @param pucData Bytes to send.
+ * @param ulLength Number of bytes.
+ * @retval 0
+ * @note One call queues the whole batch for one TX DMA transfer.
+ */
+static int32_t uart_gatekeeper_write(void *pvContext, uint32_t ulAddress,
+		const uint8_t *pucData, uint32_t ulLength)
+{
+	(void)USART2_write_buffer((const char *)pucData, (int)ulLength);
+
+	return 0;
+}
+
+/**
+ * @brief System Clock Configuration
+ * @retval None
+ */
+void SystemClock_Config(void)
+{
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
@@ -0,0 +1,446 @@
+/*******************************************************************************
+ *
+ * @file	pipeline.c
+ * @brief	Zero-copy multi-stage processing pipeline: buffers from one pool
+ * 			move between stage tasks by reference.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	A producer takes a buffer from the pool (an osMemoryPoolNew()
+ * 			pool, lock-free while it is not empty), fills it and submits
+ * 			it. Each stage is a task with its own priority that processes
+ * 			the buffers in place and passes them on through the reference
+ * 			queue (xQueueCreateRef()) of the next stage; the last one
+ * 			returns them to the pool. A hop costs one pointer per buffer,
+ * 			whatever the payload size, and a stage more costs one hop, not
+ * 			one copy.
+ *
+ * 			A stage takes its buffers in batches of up to ulBatch, under one
+ * 			critical section (configUSE_QUEUE_BATCH): after the first
+ * 			buffer it waits at most xBatchTicks for the rest, then calls its
+ * 			process function once for the whole batch and forwards it in one
+ * 			xQueueSendMultiple(). Buffers stay in submission order through
+ * 			every stage.
+ *
+ * 			Each queue holds as many references as the pool has buffers, so
+ * 			a stage never blocks passing its batch on: back-pressure comes
+ * 			from the pool alone, when pipeline_alloc() finds it empty.
+ *
+ * 			Per stage, the queue depth and the time from hand-over to the
+ * 			start of the batch are recorded, and the time spent in the
+ * 			process function; per pipeline, the time from submission to the
+ * 			end of the last stage. Times are DWT cycle counts.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "pipeline.h"
+
+/* Macros --------------------------------------------------------------------*/
+#if (configUSE_QUEUE_REFERENCES != 1) || (configUSE_QUEUE_BATCH != 1)
+#error pipeline.c needs configUSE_QUEUE_REFERENCES and configUSE_QUEUE_BATCH
+#endif
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t pipeline_receive_batch(PipelineStage_t *pxStage, PipelineBuffer_t **ppxBatch);
+static void pipeline_account(PipelineStage_t *pxStage, PipelineBuffer_t * const *ppxBatch,
+		uint32_t ulCount, uint32_t ulDepth, uint32_t ulStart, uint32_t ulDone);
+static void pipeline_retire(Pipeline_t *pxPipeline, PipelineBuffer_t * const *ppxBatch,
+		uint32_t ulCount, uint32_t ulDone);
+static void pipeline_task(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Initializes a pipeline and creates its buffer pool.
+ * @param pxPipeline Pipeline to initialize.
+ * @param ulBuffers Buffers in the pool: the most that can be in flight.
+ * @param ulBufferBytes Payload bytes of each buffer.
+ * @retval 0 if successful, -1 otherwise.
+ * @note Call from a task or before the scheduler starts, then add the
+ * stages in order.
+ */
+int32_t pipeline_init(Pipeline_t *pxPipeline, uint32_t ulBuffers, uint32_t ulBufferBytes)
+{
+	if ((pxPipeline == NULL) || (ulBuffers == 0U) || (ulBufferBytes == 0U))
+	{
+		return -1;
+	}
+
+	/* Latencies are measured in core clock cycles. */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	memset(pxPipeline, 0, sizeof(*pxPipeline));
+	pxPipeline->ulBuffers = ulBuffers;
+	pxPipeline->ulBufferBytes = ulBufferBytes;
+	pxPipeline->xStats.ulMinLatencyCycles = UINT32_MAX;
+
+	pxPipeline->xPool = osMemoryPoolNew(ulBuffers, sizeof(PipelineBuffer_t) + ulBufferBytes, NULL);
+
+	return (pxPipeline->xPool != NULL) ? 0 : -1;
+}
+
+/**
+ * @brief Appends a stage to a pipeline.
+ * @param pxPipeline Pipeline, not started yet.
+ * @param pxConfig Name, process function, priority and batch. Copied, but the
+ * name must stay valid.
+ * @retval Index of the stage if successful, -1 otherwise.
+ */
+int32_t pipeline_add_stage(Pipeline_t *pxPipeline, const PipelineStageConfig_t *pxConfig)
+{
+	PipelineStage_t *pxStage;
+
+	if ((pxPipeline == NULL) || (pxConfig == NULL) || (pxConfig->pxProcess == NULL)
+			|| (pxConfig->ulBatch == 0U) || (pxConfig->ulBatch > PIPELINE_MAX_BATCH)
+			|| (pxPipeline->xPool == NULL) || (pxPipeline->xStarted != pdFALSE)
+			|| (pxPipeline->ulStages == PIPELINE_MAX_STAGES))
+	{
+		return -1;
+	}
+
+	pxStage = &pxPipeline->xStages[pxPipeline->ulStages];
+	pxStage->xConfig = *pxConfig;
+	pxStage->pvPipeline = pxPipeline;
+	pxStage->xStats.ulMinWaitCycles = UINT32_MAX;
+
+	/* Room for every buffer of the pool, so passing a batch on never blocks. */
+	pxStage->xQueue = xQueueCreateRef(pxPipeline->ulBuffers);
+
+	if (pxStage->xQueue == NULL)
+	{
+		return -1;
+	}
+
+	/* Listed under the stage name, e.g. for uxQueueGetRegistryMetrics(). */
+	vQueueAddToRegistry(pxStage->xQueue, pxConfig->pcName);
+
+	if (pxPipeline->ulStages > 0U)
+	{
+		pxPipeline->xStages[pxPipeline->ulStages - 1U].xNext = pxStage->xQueue;
+	}
+
+	return (int32_t)pxPipeline->ulStages++;
+}
+
+/**
+ * @brief Creates the stage tasks.
+ * @param pxPipeline Pipeline with at least one stage.
+ * @retval 0 if successful, -1 otherwise.
+ * @note Buffers can be submitted from then on.
+ */
+int32_t pipeline_start(Pipeline_t *pxPipeline)
+{
+	PipelineStage_t *pxStage;
+	uint32_t i;
+
+	if ((pxPipeline == NULL) || (pxPipeline->ulStages == 0U) || (pxPipeline->xStarted != pdFALSE))
+	{
+		return -1;
+	}
+
+	for (i = 0; i < pxPipeline->ulStages; i++)
+	{
+		pxStage = &pxPipeline->xStages[i];
+
+		if (xTaskCreate(pipeline_task, pxStage->xConfig.pcName, PIPELINE_STACK_WORDS,
+				pxStage, pxStage->xConfig.uxPriority, &pxStage->xTask) != pdPASS)
+		{
+			return -1;
+		}
+	}
+
+	pxPipeline->xStarted = pdTRUE;
+
+	return 0;
+}
+
+/**
+ * @brief Takes a buffer from the pool.
+ * @param pxPipeline Pipeline.
+ * @param xTicksToWait Maximum time to wait for a buffer to come back.
+ * @retval The buffer, with ulLength 0, or NULL if none came back in time.
+ * @note Only from tasks. The caller owns the buffer until it submits or
+ * frees it.
+ */
+PipelineBuffer_t *pipeline_alloc(Pipeline_t *pxPipeline, TickType_t xTicksToWait)
+{
+	PipelineBuffer_t *pxBuffer;
+
+	pxBuffer = osMemoryPoolAlloc(pxPipeline->xPool, (uint32_t)xTicksToWait);
+
+	if (pxBuffer == NULL)
+	{
+		pxPipeline->ulAllocFailures++;
+		return NULL;
+	}
+
+	pxBuffer->ulLength = 0;
+
+	return pxBuffer;
+}
+
+/**
+ * @brief Hands a filled buffer to the first stage.
+ * @param pxPipeline Started pipeline.
+ * @param ppxBuffer Buffer from pipeline_alloc(). Cleared once submitted: the
+ * pipeline owns the buffer from then on.
+ * @retval 0 if successful, -1 if the pipeline is not started.
+ * @note Never blocks. There is a single producer.
+ */
+int32_t pipeline_submit(Pipeline_t *pxPipeline, PipelineBuffer_t **ppxBuffer)
+{
+	PipelineBuffer_t * const pxBuffer = *ppxBuffer;
+
+	if (pxPipeline->xStarted == pdFALSE)
+	{
+		return -1;
+	}
+
+	pxBuffer->ulSequence = pxPipeline->ulSequence++;
+	pxBuffer->ulSubmitCycles = DWT->CYCCNT;
+	pxBuffer->ulHandoffCycles = pxBuffer->ulSubmitCycles;
+
+	/* The queue has room for every buffer, so this cannot fail. */
+	(void)xQueueSendRef(pxPipeline->xStages[0].xQueue, (void **)ppxBuffer, 0);
+
+	taskENTER_CRITICAL();
+	pxPipeline->xStats.ulSubmitted++;
+	taskEXIT_CRITICAL();
+
+	return 0;
+}
+
+/**
+ * @brief Returns a buffer the producer will not submit to the pool.
+ * @param pxPipeline Pipeline.
+ * @param pxBuffer Buffer from pipeline_alloc().
+ * @retval None
+ */
+void pipeline_free(Pipeline_t *pxPipeline, PipelineBuffer_t *pxBuffer)
+{
+	(void)osMemoryPoolFree(pxPipeline->xPool, pxBuffer);
+}
+
+/**
+ * @brief Copies the statistics of a stage.
+ * @param pxPipeline Pipeline.
+ * @param ulStage Index of the stage, in the order added.
+ * @param pxStats Receives the statistics.
+ * @retval 0 if successful, -1 otherwise.
+ */
+int32_t pipeline_get_stage_stats(Pipeline_t *pxPipeline, uint32_t ulStage,
+		PipelineStageStats_t *pxStats)
+{
+	if ((pxPipeline == NULL) || (pxStats == NULL) || (ulStage >= pxPipeline->ulStages))
+	{
+		return -1;
+	}
+
+	taskENTER_CRITICAL();
+	*pxStats = pxPipeline->xStages[ulStage].xStats;
+	taskEXIT_CRITICAL();
+
+	pxStats->ulDepth = (uint32_t)uxQueueMessagesWaiting(pxPipeline->xStages[ulStage].xQueue);
+
+	return 0;
+}
+
+/**
+ * @brief Copies the statistics of the whole pipeline.
+ * @param pxPipeline Pipeline.
+ * @param pxStats Receives the statistics.
+ * @retval 0 if successful, -1 otherwise.
+ */
+int32_t pipeline_get_stats(Pipeline_t *pxPipeline, PipelineStats_t *pxStats)
+{
+	if ((pxPipeline == NULL) || (pxStats == NULL) || (pxPipeline->xPool == NULL))
+	{
+		return -1;
+	}
+
+	taskENTER_CRITICAL();
+	*pxStats = pxPipeline->xStats;
+	taskEXIT_CRITICAL();
+
+	pxStats->ulAllocFailures = pxPipeline->ulAllocFailures;
+	pxStats->ulInUse = osMemoryPoolGetCount(pxPipeline->xPool);
+
+	return 0;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Blocks until a buffer is queued for the stage, then takes up to a
+ * batch, waiting at most xBatchTicks for the rest of it.
+ * @param pxStage Stage.
+ * @param ppxBatch Receives the buffer references, oldest first.
+ * @retval Number of buffers taken, at least 1.
+ */
+static uint32_t pipeline_receive_batch(PipelineStage_t *pxStage, PipelineBuffer_t **ppxBatch)
+{
+	const uint32_t ulBatch = pxStage->xConfig.ulBatch;
+	TickType_t xTicksLeft = pxStage->xConfig.xBatchTicks;
+	TimeOut_t xTimeOut;
+	uint32_t ulCount;
+
+	do
+	{
+		ulCount = (uint32_t)xQueueReceiveMultiple(pxStage->xQueue, ppxBatch, ulBatch, portMAX_DELAY);
+	} while (ulCount == 0U);
+
+	if ((ulCount < ulBatch) && (xTicksLeft > 0U))
+	{
+		vTaskSetTimeOutState(&xTimeOut);
+
+		while ((ulCount < ulBatch) && (xTaskCheckForTimeOut(&xTimeOut, &xTicksLeft) == pdFALSE))
+		{
+			ulCount += (uint32_t)xQueueReceiveMultiple(pxStage->xQueue, &ppxBatch[ulCount],
+					ulBatch - ulCount, xTicksLeft);
+		}
+	}
+
+	return ulCount;
+}
+
+/**
+ * @brief Records a processed batch in the statistics of its stage.
+ * @param pxStage Stage.
+ * @param ppxBatch The batch.
+ * @param ulCount Buffers in the batch.
+ * @param ulDepth Buffers queued for the stage when the batch was taken.
+ * @param ulStart CYCCNT before the process function.
+ * @param ulDone CYCCNT after it.
+ * @retval None
+ */
+static void pipeline_account(PipelineStage_t *pxStage, PipelineBuffer_t * const *ppxBatch,
+		uint32_t ulCount, uint32_t ulDepth, uint32_t ulStart, uint32_t ulDone)
+{
+	PipelineStageStats_t * const pxStats = &pxStage->xStats;
+	const uint32_t ulBatchCycles = ulDone - ulStart;
+	uint32_t ulWait;
+	uint32_t i;
+
+	/* A reader preempting the stage must not see half an update. */
+	taskENTER_CRITICAL();
+	pxStats->ulBatches++;
+	pxStats->ullTotalBatchCycles += ulBatchCycles;
+
+	if (ulBatchCycles > pxStats->ulMaxBatchCycles)
+	{
+		pxStats->ulMaxBatchCycles = ulBatchCycles;
+	}
+
+	if (ulDepth > pxStats->ulPeakDepth)
+	{
+		pxStats->ulPeakDepth = ulDepth;
+	}
+
+	for (i = 0; i < ulCount; i++)
+	{
+		ulWait = ulStart - ppxBatch[i]->ulHandoffCycles;
+
+		pxStats->ulBuffers++;
+		pxStats->ullTotalWaitCycles += ulWait;
+
+		if (ulWait < pxStats->ulMinWaitCycles)
+		{
+			pxStats->ulMinWaitCycles = ulWait;
+		}
+
+		if (ulWait > pxStats->ulMaxWaitCycles)
+		{
+			pxStats->ulMaxWaitCycles = ulWait;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Records the end-to-end latency of the buffers leaving the last stage
+ * and returns them to the pool.
+ * @param pxPipeline Pipeline.
+ * @param ppxBatch The batch.
+ * @param ulCount Buffers in the batch.
+ * @param ulDone CYCCNT at the end of the last stage.
+ * @retval None
+ */
+static void pipeline_retire(Pipeline_t *pxPipeline, PipelineBuffer_t * const *ppxBatch,
+		uint32_t ulCount, uint32_t ulDone)
+{
+	PipelineStats_t * const pxStats = &pxPipeline->xStats;
+	uint32_t ulLatency;
+	uint32_t i;
+
+	taskENTER_CRITICAL();
+	for (i = 0; i < ulCount; i++)
+	{
+		ulLatency = ulDone - ppxBatch[i]->ulSubmitCycles;
+
+		pxStats->ulCompleted++;
+		pxStats->ullTotalLatencyCycles += ulLatency;
+
+		if (ulLatency < pxStats->ulMinLatencyCycles)
+		{
+			pxStats->ulMinLatencyCycles = ulLatency;
+		}
+
+		if (ulLatency > pxStats->ulMaxLatencyCycles)
+		{
+			pxStats->ulMaxLatencyCycles = ulLatency;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	for (i = 0; i < ulCount; i++)
+	{
+		(void)osMemoryPoolFree(pxPipeline->xPool, ppxBatch[i]);
+	}
+}
+
+/**
+ * @brief Stage task: takes a batch, processes it and passes it on.
+ * @param pvParameters The PipelineStage_t.
+ * @retval None
+ */
+static void pipeline_task(void *pvParameters)
+{
+	PipelineStage_t * const pxStage = pvParameters;
+	Pipeline_t * const pxPipeline = pxStage->pvPipeline;
+	PipelineBuffer_t *pxBatch[PIPELINE_MAX_BATCH];
+	uint32_t ulCount;
+	uint32_t ulDepth;
+	uint32_t ulStart;
+	uint32_t ulDone;
+	uint32_t i;
+
+	while (1)
+	{
+		ulCount = pipeline_receive_batch(pxStage, pxBatch);
+		ulDepth = ulCount + (uint32_t)uxQueueMessagesWaiting(pxStage->xQueue);
+
+		ulStart = DWT->CYCCNT;
+		pxStage->xConfig.pxProcess(pxStage->xConfig.pvContext, pxBatch, ulCount);
+		ulDone = DWT->CYCCNT;
+
+		pipeline_account(pxStage, pxBatch, ulCount, ulDepth, ulStart, ulDone);
+
+		if (pxStage->xNext != NULL)
+		{
+			for (i = 0; i < ulCount; i++)
+			{
+				pxBatch[i]->ulHandoffCycles = ulDone;
+			}
+
+			/* The references alone move on; the next queue has room for them. */
+			(void)xQueueSendMultiple(pxStage->xNext, pxBatch, ulCount, portMAX_DELAY);
+		}
+		else
+		{
+			pipeline_retire(pxPipeline, pxBatch, ulCount, ulDone);
+		}
+	}
+}
@@ -0,0 +1,173 @@
+/*******************************************************************************
+ *
+ * @file	qadvisor.c
+ * @brief	Implementation of the queue sizing advisor.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	Recommends a length for each queue of the registry from what a
+ * 			soak test made of it, instead of the guessed lengths the
+ * 			queues are created with. qadvisor_start() clears the queue
+ * 			metrics (configUSE_QUEUE_METRICS) when the soak begins;
+ * 			qadvisor_evaluate(), at any time after, turns their counters
+ * 			into advice:
+ *
+ * 				grow	senders blocked on the full queue or items were
+ * 						lost: QADVISOR_GROW_FACTOR times the length, to
+ * 						soak again, since a full queue hides how much
+ * 						more it needed.
+ * 				shrink	the high-water mark plus QADVISOR_SPARE_PERCENT
+ * 						(QADVISOR_MIN_SPARE at least) is under the length.
+ * 				keep	the length is about the high-water mark and
+ * 						spare.
+ * 				idle	nothing was sent; the soak says nothing of it.
+ *
+ * 			Each advice comes with the RAM it saves or costs: the change
+ * 			of length times the item size. The queue structure itself does
+ * 			not change.
+ *
+ * 			The kernel's timer queue ("TmrQ", configTIMER_QUEUE_LENGTH) is
+ * 			in the registry and is advised like the others. Semaphores and
+ * 			mutexes, of item size 0, are left out. A queue whose senders
+ * 			are meant to block, as back-pressure, is advised to grow all
+ * 			the same: its owner knows better.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "qadvisor.h"
+
+#if (configUSE_QUEUE_METRICS == 1) && (configQUEUE_REGISTRY_SIZE > 0)
+
+/* Variables -----------------------------------------------------------------*/
+/* Off the callers' stacks; one caller at a time. */
+static QueueRegistryMetrics_t xRegistry[QADVISOR_MAX_QUEUES];
+
+/* Private function prototypes -----------------------------------------------*/
+static void qadvisor_advise(const QueueRegistryMetrics_t *pxEntry, QadvisorAdvice_t *pxAdvice);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Starts a soak: clears the metrics of every queue in the registry.
+ * @param None
+ * @retval None
+ * @note The high-water marks restart from the items each queue holds now.
+ */
+void qadvisor_start(void)
+{
+	UBaseType_t uxCount = uxQueueGetRegistryMetrics(xRegistry, QADVISOR_MAX_QUEUES);
+	UBaseType_t ux;
+
+	for (ux = 0; ux < uxCount; ux++)
+	{
+		vQueueResetMetrics(xRegistry[ux].xHandle);
+	}
+}
+
+/**
+ * @brief Advises a length for each queue of the registry.
+ * @param pxAdvice Receives the advice, one entry per queue.
+ * @param uxSize Entries pxAdvice holds.
+ * @param plRamDelta Receives the bytes all the advice saves (< 0) or costs;
+ * may be NULL.
+ * @retval Entries written.
+ * @note Task context. Semaphores and mutexes are skipped.
+ */
+UBaseType_t qadvisor_evaluate(QadvisorAdvice_t *pxAdvice, UBaseType_t uxSize,
+		int32_t *plRamDelta)
+{
+	UBaseType_t uxCount = uxQueueGetRegistryMetrics(xRegistry, QADVISOR_MAX_QUEUES);
+	UBaseType_t uxWritten = 0;
+	UBaseType_t ux;
+	int32_t lTotal = 0;
+
+	for (ux = 0; (ux < uxCount) && (uxWritten < uxSize); ux++)
+	{
+		if (xRegistry[ux].uxItemSize == 0U)
+		{
+			continue;
+		}
+
+		qadvisor_advise(&xRegistry[ux], &pxAdvice[uxWritten]);
+		lTotal += pxAdvice[uxWritten].lRamDelta;
+		uxWritten++;
+	}
+
+	if (plRamDelta != NULL)
+	{
+		*plRamDelta = lTotal;
+	}
+
+	return uxWritten;
+}
+
+/**
+ * @brief Names a verdict, for reports.
+ * @param eVerdict Verdict.
+ * @retval "idle", "keep", "shrink" or "grow".
+ */
+const char *qadvisor_verdict_name(QadvisorVerdict_t eVerdict)
+{
+	static const char * const pcNames[] = { "idle", "keep", "shrink", "grow" };
+
+	return (eVerdict <= QADVISOR_GROW) ? pcNames[eVerdict] : "?";
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Advises a length for one queue.
+ * @param pxEntry Its metrics.
+ * @param pxAdvice Receives the advice.
+ * @retval None
+ */
+static void qadvisor_advise(const QueueRegistryMetrics_t *pxEntry, QadvisorAdvice_t *pxAdvice)
+{
+	const QueueMetrics_t *pxMetrics = &pxEntry->xMetrics;
+	uint32_t ulNeeded;
+	uint32_t ulSpare;
+
+	pxAdvice->pcName = pxEntry->pcQueueName;
+	pxAdvice->xHandle = pxEntry->xHandle;
+	pxAdvice->uxLength = pxEntry->uxLength;
+	pxAdvice->uxItemSize = pxEntry->uxItemSize;
+	pxAdvice->ulHighWater = pxMetrics->ulHighWaterMark;
+	pxAdvice->ulStalls = pxMetrics->ulSendsBlocked;
+	pxAdvice->ulLosses = pxMetrics->ulSendTimeouts + pxMetrics->ulFullDrops;
+	pxAdvice->uxAdvisedLength = pxEntry->uxLength;
+
+	if ((pxAdvice->ulStalls != 0U) || (pxAdvice->ulLosses != 0U))
+	{
+		pxAdvice->eVerdict = QADVISOR_GROW;
+		pxAdvice->uxAdvisedLength = pxEntry->uxLength * QADVISOR_GROW_FACTOR;
+	}
+	else if (pxMetrics->ulSends == 0U)
+	{
+		pxAdvice->eVerdict = QADVISOR_IDLE;
+	}
+	else
+	{
+		/* Rounded up, so a mark of 1 to 4 keeps one spare at 25 %. */
+		ulSpare = ((pxMetrics->ulHighWaterMark * QADVISOR_SPARE_PERCENT) + 99U) / 100U;
+		ulSpare = (ulSpare < QADVISOR_MIN_SPARE) ? QADVISOR_MIN_SPARE : ulSpare;
+		ulNeeded = pxMetrics->ulHighWaterMark + ulSpare;
+
+		if (ulNeeded < pxEntry->uxLength)
+		{
+			pxAdvice->eVerdict = QADVISOR_SHRINK;
+			pxAdvice->uxAdvisedLength = (UBaseType_t)ulNeeded;
+		}
+		else
+		{
+			pxAdvice->eVerdict = QADVISOR_KEEP;
+		}
+	}
+
+	pxAdvice->lRamDelta = ((int32_t)pxAdvice->uxAdvisedLength - (int32_t)pxEntry->uxLength)
+			* (int32_t)pxEntry->uxItemSize;
+}
+
+#endif /* (configUSE_QUEUE_METRICS == 1) && (configQUEUE_REGISTRY_SIZE > 0) */
@@ -0,0 +1,472 @@
+/*******************************************************************************
+ *
+ * @file	rtt.c
+ * @brief	Debugger-polled memory channels: console output and command input
+ * 			through rings in SRAM that the probe reads and writes over SWD.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	The layout is SEGGER's Real-Time Transfer (RTT): a control block
+ * 			with the ID "SEGGER RTT", then one descriptor per channel, each
+ * 			describing a ring. J-Link RTT Viewer, OpenOCD ("rtt setup" and
+ * 			"rtt server"), pyOCD and probe-rs find the block by scanning RAM
+ * 			for the ID, or by the symbol _SEGGER_RTT, and then poll it in the
+ * 			background through the debug port while the core runs.
+ *
+ * 			A write only copies into the ring and moves WrOff: no peripheral,
+ * 			no interrupt, no wait for a wire, so printf() costs about a
+ * 			memcpy(). The probe drains the up rings at its own pace (about a
+ * 			megabyte per second over an ST-LINK), and fills the down rings
+ * 			with what is typed, which the target reads by polling.
+ *
+ * 			Each ring has one writer side and one reader side: the writer
+ * 			only moves WrOff, the reader RdOff, and the data is made visible
+ * 			before the offset that covers it. One slot is kept empty to tell
+ * 			a full ring from an empty one. Target writers of the same up
+ * 			channel are serialized by masking interrupts for the copy, so
+ * 			tasks and ISRs up to configMAX_SYSCALL_INTERRUPT_PRIORITY may
+ * 			write.
+ *
+ * 			Without a probe attached nothing drains the rings. A full up
+ * 			ring drops by default (RTT_MODE_NO_BLOCK_TRIM), and the dropped
+ * 			bytes are counted; RTT_MODE_BLOCK_IF_FULL waits for room for up
+ * 			to RTT_BLOCK_TICKS in a task, then drops too.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "rtt.h"
+#include "task.h"
+
+#if (RTT_MAX_UP_BUFFERS < 1U) || (RTT_MAX_DOWN_BUFFERS < 1U)
+#error RTT needs at least the terminal channel both ways
+#endif
+
+/* Variables -----------------------------------------------------------------*/
+
+/* The name the tools look for, hence not in the style of this repository. */
+RttControlBlock_t _SEGGER_RTT;
+
+static char cTerminalUp[RTT_TERMINAL_UP_SIZE];
+static char cTerminalDown[RTT_TERMINAL_DOWN_SIZE];
+static volatile uint32_t ulRttDropped[RTT_MAX_UP_BUFFERS];
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t rtt_free(const RttBuffer_t *pxRing);
+static uint32_t rtt_used(const RttBuffer_t *pxRing);
+static int32_t rtt_can_wait(void);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Sets up the control block and the terminal channels.
+ * @param None
+ * @retval None
+ * @note Called by the first rtt_ call otherwise. Early, so that the probe
+ * finds the block when it attaches: before the scheduler starts.
+ */
+void rtt_init(void)
+{
+	UBaseType_t uxMask;
+
+	uxMask = taskENTER_CRITICAL_FROM_ISR();
+
+	/* The ID is written last, so it also says the block is ready. */
+	if (_SEGGER_RTT.acID[0] == '\0')
+	{
+		(void)memset(&_SEGGER_RTT, 0, sizeof(_SEGGER_RTT));
+		_SEGGER_RTT.MaxNumUpBuffers = (int32_t)RTT_MAX_UP_BUFFERS;
+		_SEGGER_RTT.MaxNumDownBuffers = (int32_t)RTT_MAX_DOWN_BUFFERS;
+
+		_SEGGER_RTT.aUp[0].sName = "Terminal";
+		_SEGGER_RTT.aUp[0].pBuffer = cTerminalUp;
+		_SEGGER_RTT.aUp[0].SizeOfBuffer = sizeof(cTerminalUp);
+		_SEGGER_RTT.aUp[0].Flags = RTT_TERMINAL_MODE;
+
+		_SEGGER_RTT.aDown[0].sName = "Terminal";
+		_SEGGER_RTT.aDown[0].pBuffer = cTerminalDown;
+		_SEGGER_RTT.aDown[0].SizeOfBuffer = sizeof(cTerminalDown);
+
+		/* The probe must not find the ID before the descriptors, nor a
+		 * complete copy of it anywhere else in RAM: it is put together here
+		 * from two parts, the first one last. */
+		__DMB();
+		(void)memcpy(&_SEGGER_RTT.acID[7], "RTT", 4U);
+		__DMB();
+		(void)memcpy(&_SEGGER_RTT.acID[0], "SEGGER ", 7U);
+		__DMB();
+	}
+
+	taskEXIT_CRITICAL_FROM_ISR(uxMask);
+}
+
+/**
+ * @brief Gives an up (target to host) channel a ring.
+ * @param ulChannel Channel, 1 to RTT_MAX_UP_BUFFERS - 1; 0 is the terminal.
+ * @param pcName Name the host tools show.
+ * @param pcBuffer Ring storage. Must stay valid for good.
+ * @param ulSize Size of the ring, at least 2 bytes; one is kept empty.
+ * @param ulMode RTT_MODE_xxx, when full.
+ * @retval 0 if successful, -1 otherwise.
+ * @note Before the channel is written to. The probe may only pick the channel
+ * up when it next reads the control block, typically when it attaches.
+ */
+int32_t rtt_config_up(uint32_t ulChannel, const char *pcName, char *pcBuffer, uint32_t ulSize,
+		uint32_t ulMode)
+{
+	RttBuffer_t *pxRing;
+
+	if ((ulChannel == 0U) || (ulChannel >= RTT_MAX_UP_BUFFERS) || (pcBuffer == NULL) || (ulSize < 2U)
+			|| ((ulMode & ~RTT_MODE_MASK) != 0U) || ((ulMode & RTT_MODE_MASK) == RTT_MODE_MASK))
+	{
+		return -1;
+	}
+
+	rtt_init();
+	pxRing = &_SEGGER_RTT.aUp[ulChannel];
+
+	pxRing->pBuffer = NULL;
+	__DMB();
+	pxRing->sName = pcName;
+	pxRing->SizeOfBuffer = ulSize;
+	pxRing->WrOff = 0U;
+	pxRing->RdOff = 0U;
+	pxRing->Flags = ulMode;
+	__DMB();
+	pxRing->pBuffer = pcBuffer;
+
+	return 0;
+}
+
+/**
+ * @brief Gives a down (host to target) channel a ring.
+ * @param ulChannel Channel, 1 to RTT_MAX_DOWN_BUFFERS - 1; 0 is the terminal.
+ * @param pcName Name the host tools show.
+ * @param pcBuffer Ring storage. Must stay valid for good.
+ * @param ulSize Size of the ring, at least 2 bytes; one is kept empty.
+ * @retval 0 if successful, -1 otherwise.
+ */
+int32_t rtt_config_down(uint32_t ulChannel, const char *pcName, char *pcBuffer, uint32_t ulSize)
+{
+	RttBuffer_t *pxRing;
+
+	if ((ulChannel == 0U) || (ulChannel >= RTT_MAX_DOWN_BUFFERS) || (pcBuffer == NULL) || (ulSize < 2U))
+	{
+		return -1;
+	}
+
+	rtt_init();
+	pxRing = &_SEGGER_RTT.aDown[ulChannel];
+
+	pxRing->pBuffer = NULL;
+	__DMB();
+	pxRing->sName = pcName;
+	pxRing->SizeOfBuffer = ulSize;
+	pxRing->WrOff = 0U;
+	pxRing->RdOff = 0U;
+	pxRing->Flags = 0U;
+	__DMB();
+	pxRing->pBuffer = pcBuffer;
+
+	return 0;
+}
+
+/**
+ * @brief Copies bytes into an up ring for the probe to collect.
+ * @param ulChannel Up channel.
+ * @param pvData Bytes to send.
+ * @param len Number of bytes.
+ * @retval len: bytes that did not fit are dropped and counted, as the mode of
+ * the channel says.
+ * @note Tasks and ISRs up to configMAX_SYSCALL_INTERRUPT_PRIORITY. Interrupts
+ * are masked for the copy only. In RTT_MODE_BLOCK_IF_FULL, a task writes in
+ * parts as the probe makes room, and other writers of the channel may come in
+ * between; an ISR, or a task before the scheduler starts, drops instead.
+ */
+int rtt_write(uint32_t ulChannel, const void *pvData, int len)
+{
+	const char *pcData = (const char *)pvData;
+	RttBuffer_t *pxRing;
+	UBaseType_t uxMask;
+	uint32_t ulTotal;
+	uint32_t ulDone = 0U;
+	uint32_t ulChunk;
+	uint32_t ulFree;
+	uint32_t ulWrOff;
+	uint32_t ulFirst;
+	TickType_t xWaited = 0U;
+
+	if ((ulChannel >= RTT_MAX_UP_BUFFERS) || (len <= 0))
+	{
+		return len;
+	}
+
+	if (_SEGGER_RTT.acID[0] == '\0')
+	{
+		rtt_init();
+	}
+
+	pxRing = &_SEGGER_RTT.aUp[ulChannel];
+	ulTotal = (uint32_t)len;
+
+	while (1)
+	{
+		uxMask = taskENTER_CRITICAL_FROM_ISR();
+
+		ulFree = (pxRing->pBuffer != NULL) ? rtt_free(pxRing) : 0U;
+		ulChunk = ulTotal - ulDone;
+
+		if (ulChunk > ulFree)
+		{
+			/* Skip mode drops a write whole, not its tail. */
+			ulChunk = ((pxRing->Flags & RTT_MODE_MASK) == RTT_MODE_NO_BLOCK_SKIP) ? 0U : ulFree;
+		}
+
+		if (ulChunk > 0U)
+		{
+			ulWrOff = pxRing->WrOff;
+			ulFirst = pxRing->SizeOfBuffer - ulWrOff;
+
+			if (ulFirst > ulChunk)
+			{
+				ulFirst = ulChunk;
+			}
+
+			(void)memcpy(&pxRing->pBuffer[ulWrOff], &pcData[ulDone], ulFirst);
+			(void)memcpy(pxRing->pBuffer, &pcData[ulDone + ulFirst], ulChunk - ulFirst);
+
+			ulWrOff += ulChunk;
+
+			if (ulWrOff >= pxRing->SizeOfBuffer)
+			{
+				ulWrOff -= pxRing->SizeOfBuffer;
+			}
+
+			/* The bytes before the offset that hands them to the probe. */
+			__DMB();
+			pxRing->WrOff = ulWrOff;
+			ulDone += ulChunk;
+		}
+
+		if ((ulDone < ulTotal) && (((pxRing->Flags & RTT_MODE_MASK) != RTT_MODE_BLOCK_IF_FULL)
+				|| (xWaited >= RTT_BLOCK_TICKS) || (rtt_can_wait() == 0)))
+		{
+			ulRttDropped[ulChannel] += ulTotal - ulDone;
+			ulDone = ulTotal;
+		}
+
+		taskEXIT_CRITICAL_FROM_ISR(uxMask);
+
+		if (ulDone == ulTotal)
+		{
+			break;
+		}
+
+		vTaskDelay(RTT_POLL_TICKS);
+		xWaited += RTT_POLL_TICKS;
+	}
+
+	return len;
+}
+
+/**
+ * @brief Takes what the probe has put in a down ring, without waiting.
+ * @param ulChannel Down channel.
+ * @param pvData Where to copy the bytes.
+ * @param len Most bytes to take.
+ * @retval Number of bytes taken, 0 if none.
+ * @note Tasks and ISRs up to configMAX_SYSCALL_INTERRUPT_PRIORITY; readers of
+ * the same channel each get different bytes.
+ */
+int rtt_read(uint32_t ulChannel, void *pvData, int len)
+{
+	char *pcData = (char *)pvData;
+	RttBuffer_t *pxRing;
+	UBaseType_t uxMask;
+	uint32_t ulChunk;
+	uint32_t ulRdOff;
+	uint32_t ulFirst;
+
+	if ((ulChannel >= RTT_MAX_DOWN_BUFFERS) || (len <= 0))
+	{
+		return 0;
+	}
+
+	if (_SEGGER_RTT.acID[0] == '\0')
+	{
+		rtt_init();
+	}
+
+	pxRing = &_SEGGER_RTT.aDown[ulChannel];
+	uxMask = taskENTER_CRITICAL_FROM_ISR();
+
+	ulChunk = (pxRing->pBuffer != NULL) ? rtt_used(pxRing) : 0U;
+
+	if (ulChunk > (uint32_t)len)
+	{
+		ulChunk = (uint32_t)len;
+	}
+
+	if (ulChunk > 0U)
+	{
+		/* The bytes after the offset that says they are there. */
+		__DMB();
+		ulRdOff = pxRing->RdOff;
+		ulFirst = pxRing->SizeOfBuffer - ulRdOff;
+
+		if (ulFirst > ulChunk)
+		{
+			ulFirst = ulChunk;
+		}
+
+		(void)memcpy(pcData, &pxRing->pBuffer[ulRdOff], ulFirst);
+		(void)memcpy(&pcData[ulFirst], pxRing->pBuffer, ulChunk - ulFirst);
+
+		ulRdOff += ulChunk;
+
+		if (ulRdOff >= pxRing->SizeOfBuffer)
+		{
+			ulRdOff -= pxRing->SizeOfBuffer;
+		}
+
+		/* And all read before the probe may write over them. */
+		__DMB();
+		pxRing->RdOff = ulRdOff;
+	}
+
+	taskEXIT_CRITICAL_FROM_ISR(uxMask);
+
+	return (int)ulChunk;
+}
+
+/**
+ * @brief Takes what the probe has put in a down ring, waiting for at least a
+ * byte.
+ * @param ulChannel Down channel.
+ * @param pvData Where to copy the bytes.
+ * @param len Most bytes to take.
+ * @param xTicksToWait How long to wait for a first byte; portMAX_DELAY for
+ * good.
+ * @retval Number of bytes taken, 0 on timeout.
+ * @note The probe writes without raising an interrupt, so the task looks at
+ * the ring every RTT_POLL_TICKS. Tasks only; before the scheduler starts, it
+ * spins.
+ */
+int rtt_read_wait(uint32_t ulChannel, void *pvData, int len, TickType_t xTicksToWait)
+{
+	TimeOut_t xTimeOut;
+	int iRead;
+
+	vTaskSetTimeOutState(&xTimeOut);
+
+	while ((iRead = rtt_read(ulChannel, pvData, len)) == 0)
+	{
+		if ((ulChannel >= RTT_MAX_DOWN_BUFFERS) || (len <= 0)
+				|| (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE))
+		{
+			break;
+		}
+
+		if (rtt_can_wait() != 0)
+		{
+			vTaskDelay(RTT_POLL_TICKS);
+		}
+	}
+
+	return iRead;
+}
+
+/**
+ * @brief Returns the number of bytes waiting in a down ring.
+ * @param ulChannel Down channel.
+ * @retval Bytes rtt_read() would take now.
+ */
+uint32_t rtt_has_data(uint32_t ulChannel)
+{
+	const RttBuffer_t *pxRing;
+
+	if ((ulChannel >= RTT_MAX_DOWN_BUFFERS) || (_SEGGER_RTT.acID[0] == '\0'))
+	{
+		return 0U;
+	}
+
+	pxRing = &_SEGGER_RTT.aDown[ulChannel];
+
+	return (pxRing->pBuffer != NULL) ? rtt_used(pxRing) : 0U;
+}
+
+/**
+ * @brief Returns the number of bytes dropped on an up channel because its
+ * ring was full.
+ * @param ulChannel Up channel.
+ * @retval Dropped bytes since start-up.
+ */
+uint32_t rtt_get_dropped(uint32_t ulChannel)
+{
+	return (ulChannel < RTT_MAX_UP_BUFFERS) ? ulRttDropped[ulChannel] : 0U;
+}
+
+/**
+ * @brief Buffer-level output hook called by _write() in syscalls.c when a
+ * stream is routed to RTT.
+ * @param ptr Bytes to send.
+ * @param len Number of bytes.
+ * @retval Number of bytes consumed.
+ */
+int __io_putbuf_rtt(char *ptr, int len)
+{
+	return rtt_write(0U, ptr, len);
+}
+
+/**
+ * @brief Buffer-level input hook called by _read() in syscalls.c when stdin
+ * is routed to RTT.
+ * @param ptr Where to copy the bytes.
+ * @param len Most bytes to take.
+ * @retval Number of bytes taken, at least 1: waits for the first one.
+ */
+int __io_getbuf_rtt(char *ptr, int len)
+{
+	return rtt_read_wait(0U, ptr, len, portMAX_DELAY);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Returns the room left in a ring.
+ * @param pxRing Ring.
+ * @retval Bytes the writer may add.
+ */
+static uint32_t rtt_free(const RttBuffer_t *pxRing)
+{
+	uint32_t ulRdOff = pxRing->RdOff;
+	uint32_t ulWrOff = pxRing->WrOff;
+
+	return (ulRdOff > ulWrOff) ? (ulRdOff - ulWrOff - 1U)
+			: (pxRing->SizeOfBuffer - 1U - (ulWrOff - ulRdOff));
+}
+
+/**
+ * @brief Returns the bytes waiting in a ring.
+ * @param pxRing Ring.
+ * @retval Bytes the reader may take.
+ */
+static uint32_t rtt_used(const RttBuffer_t *pxRing)
+{
+	uint32_t ulRdOff = pxRing->RdOff;
+	uint32_t ulWrOff = pxRing->WrOff;
+
+	return (ulWrOff >= ulRdOff) ? (ulWrOff - ulRdOff) : (pxRing->SizeOfBuffer - ulRdOff + ulWrOff);
+}
+
+/**
+ * @brief Checks that the caller may block.
+ * @param None
+ * @retval 1 in a task with the scheduler running, 0 otherwise.
+ */
+static int32_t rtt_can_wait(void)
+{
+	return ((SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk) == 0U)
+			&& (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING);
+}
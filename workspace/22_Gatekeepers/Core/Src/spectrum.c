@@ -0,0 +1,441 @@
+/*******************************************************************************
+ *
+ * @file	spectrum.c
+ * @brief	Spectral analysis of sensor frames on the FPU: Hann window, real
+ * 			FFT and a compact feature vector (RMS, peaks, band levels).
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	A real frame of SPECTRUM_SIZE samples is transformed in place as
+ * 			SPECTRUM_BINS complex samples (even samples real, odd samples
+ * 			imaginary) by a radix-4 decimation in frequency FFT, then split
+ * 			into the spectrum of the real frame. Each radix-4 butterfly needs
+ * 			three complex multiplies where two radix-2 stages need four, and
+ * 			the FPU does each multiply-add in one VFMA.
+ *
+ * 			All twiddles come from one quarter-wave sine table in flash.
+ *
+ * 			The spectrum is packed as CMSIS-DSP arm_rfft_fast_f32() packs
+ * 			it: pfSpectrum[0] is bin 0 (DC), pfSpectrum[1] the real bin at
+ * 			half the sample rate, then the real and imaginary part of bins 1
+ * 			to SPECTRUM_BINS - 1.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "spectrum.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define SPECTRUM_QUARTER		(SPECTRUM_SIZE / 4U)	/* A quarter turn, in table steps. */
+#define SPECTRUM_HANN_RMS_SCALE	(16.0f / (3.0f * (float)SPECTRUM_SIZE * (float)SPECTRUM_SIZE))
+#define SPECTRUM_HANN_AMPLITUDE	(4.0f / (float)SPECTRUM_SIZE)
+#define SPECTRUM_FIRST_AC_BIN	2U		/* The window leaks DC into bin 1. */
+
+#if ((SPECTRUM_BINS % SPECTRUM_BANDS) != 0U)
+#error SPECTRUM_BANDS must divide SPECTRUM_BINS
+#endif
+
+/* Variables -----------------------------------------------------------------*/
+/* sin(2 pi i / SPECTRUM_SIZE), i = 0 .. SPECTRUM_QUARTER. */
+static const float fSpectrumSin[SPECTRUM_QUARTER + 1U] =
+{
+	0.000000000f, 0.012271538f, 0.024541229f, 0.036807223f, 0.049067674f, 0.061320736f,
+	0.073564564f, 0.085797312f, 0.098017140f, 0.110222207f, 0.122410675f, 0.134580709f,
+	0.146730474f, 0.158858143f, 0.170961889f, 0.183039888f, 0.195090322f, 0.207111376f,
+	0.219101240f, 0.231058108f, 0.242980180f, 0.254865660f, 0.266712757f, 0.278519689f,
+	0.290284677f, 0.302005949f, 0.313681740f, 0.325310292f, 0.336889853f, 0.348418680f,
+	0.359895037f, 0.371317194f, 0.382683432f, 0.393992040f, 0.405241314f, 0.416429560f,
+	0.427555093f, 0.438616239f, 0.449611330f, 0.460538711f, 0.471396737f, 0.482183772f,
+	0.492898192f, 0.503538384f, 0.514102744f, 0.524589683f, 0.534997620f, 0.545324988f,
+	0.555570233f, 0.565731811f, 0.575808191f, 0.585797857f, 0.595699304f, 0.605511041f,
+	0.615231591f, 0.624859488f, 0.634393284f, 0.643831543f, 0.653172843f, 0.662415778f,
+	0.671558955f, 0.680600998f, 0.689540545f, 0.698376249f, 0.707106781f, 0.715730825f,
+	0.724247083f, 0.732654272f, 0.740951125f, 0.749136395f, 0.757208847f, 0.765167266f,
+	0.773010453f, 0.780737229f, 0.788346428f, 0.795836905f, 0.803207531f, 0.810457198f,
+	0.817584813f, 0.824589303f, 0.831469612f, 0.838224706f, 0.844853565f, 0.851355193f,
+	0.857728610f, 0.863972856f, 0.870086991f, 0.876070094f, 0.881921264f, 0.887639620f,
+	0.893224301f, 0.898674466f, 0.903989293f, 0.909167983f, 0.914209756f, 0.919113852f,
+	0.923879533f, 0.928506080f, 0.932992799f, 0.937339012f, 0.941544065f, 0.945607325f,
+	0.949528181f, 0.953306040f, 0.956940336f, 0.960430519f, 0.963776066f, 0.966976471f,
+	0.970031253f, 0.972939952f, 0.975702130f, 0.978317371f, 0.980785280f, 0.983105487f,
+	0.985277642f, 0.987301418f, 0.989176510f, 0.990902635f, 0.992479535f, 0.993906970f,
+	0.995184727f, 0.996312612f, 0.997290457f, 0.998118113f, 0.998795456f, 0.999322385f,
+	0.999698819f, 0.999924702f, 1.000000000f
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static float spectrum_sin(uint32_t ulAngle);
+static float spectrum_cos(uint32_t ulAngle);
+static float spectrum_sqrt(float fValue);
+static float spectrum_power(const float *pfSpectrum, uint32_t ulBin);
+static void spectrum_cfft_radix4(float *pfData);
+static void spectrum_digit_reverse(float *pfData);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Applies a periodic Hann window to a frame, in place.
+ * @param pfFrame SPECTRUM_SIZE samples.
+ * @retval None
+ * @note The window removes most of the leakage of a tone that does not fit a
+ * whole number of periods in the frame, at the cost of a main lobe two bins
+ * wide.
+ */
+void spectrum_window(float *pfFrame)
+{
+	uint32_t n;
+
+	for (n = 0; n < SPECTRUM_SIZE; n++)
+	{
+		pfFrame[n] *= 0.5f - (0.5f * spectrum_cos(n));
+	}
+}
+
+/**
+ * @brief Computes the spectrum of a real frame, in place.
+ * @param pfFrame SPECTRUM_SIZE samples in, the packed spectrum out (see the
+ * file notes).
+ * @retval None
+ * @note Bin k of the real frame is E[k] + W^k O[k], where E and O are the
+ * spectra of the even and odd samples. Both come from bins k and
+ * SPECTRUM_BINS - k of the complex FFT, so each pass of the split loop
+ * produces those two bins.
+ */
+void spectrum_rfft(float *pfFrame)
+{
+	float fEvenRe, fEvenIm;
+	float fOddRe, fOddIm;
+	float fProdRe, fProdIm;
+	float fCos, fSin;
+	float *pfLow;
+	float *pfHigh;
+	uint32_t k;
+
+	spectrum_cfft_radix4(pfFrame);
+	spectrum_digit_reverse(pfFrame);
+
+	/* DC and half the sample rate are both real; they share bin 0. */
+	fEvenRe = pfFrame[0];
+	fOddRe = pfFrame[1];
+	pfFrame[0] = fEvenRe + fOddRe;
+	pfFrame[1] = fEvenRe - fOddRe;
+
+	for (k = 1; k <= (SPECTRUM_BINS / 2U); k++)
+	{
+		pfLow = &pfFrame[2U * k];
+		pfHigh = &pfFrame[2U * (SPECTRUM_BINS - k)];
+
+		fEvenRe = 0.5f * (pfLow[0] + pfHigh[0]);
+		fEvenIm = 0.5f * (pfLow[1] - pfHigh[1]);
+		fOddRe = 0.5f * (pfLow[1] + pfHigh[1]);
+		fOddIm = 0.5f * (pfHigh[0] - pfLow[0]);
+
+		/* W^k = cos - i sin */
+		fCos = spectrum_cos(k);
+		fSin = spectrum_sin(k);
+		fProdRe = (fCos * fOddRe) + (fSin * fOddIm);
+		fProdIm = (fCos * fOddIm) - (fSin * fOddRe);
+
+		/* When k is SPECTRUM_BINS / 2 both are the same bin, and both give
+		 * the same value. */
+		pfLow[0] = fEvenRe + fProdRe;
+		pfLow[1] = fEvenIm + fProdIm;
+		pfHigh[0] = fEvenRe - fProdRe;
+		pfHigh[1] = fProdIm - fEvenIm;
+	}
+}
+
+/**
+ * @brief Extracts the feature vector of a spectrum.
+ * @param pfSpectrum Packed spectrum from spectrum_rfft() of a Hann-windowed
+ * frame.
+ * @param ulSampleRateHz Sample rate of the frame.
+ * @param pxFeatures Receives the features.
+ * @retval None
+ * @note The levels are RMS values by Parseval's theorem, corrected for the
+ * window's mean square of 3/8, and leave out the first SPECTRUM_FIRST_AC_BIN
+ * bins, where the window spreads DC. A peak is a bin above both neighbours; its
+ * frequency and amplitude come from the parabola through the three
+ * magnitudes, so a tone between two bins is neither rounded to a bin nor
+ * under-reported by much.
+ */
+void spectrum_features(const float *pfSpectrum, uint32_t ulSampleRateHz,
+		SpectrumFeatures_t *pxFeatures)
+{
+	const uint32_t ulBandBins = SPECTRUM_BINS / SPECTRUM_BANDS;
+	uint32_t ulPeakBin[SPECTRUM_PEAKS] = { 0 };
+	float fPeakPower[SPECTRUM_PEAKS] = { 0.0f };
+	float fTotal = 0.0f;
+	float fBand;
+	float fPower;
+	float fBefore, fPeak, fAfter;
+	float fCurve, fOffset;
+	uint32_t k;
+	uint32_t i;
+	uint32_t j;
+
+	for (i = 0; i < SPECTRUM_BANDS; i++)
+	{
+		fBand = 0.0f;
+
+		/* The levels are of the variations only, without DC. */
+		for (k = ((i == 0U) ? SPECTRUM_FIRST_AC_BIN : (i * ulBandBins)); k < ((i + 1U) * ulBandBins); k++)
+		{
+			fBand += spectrum_power(pfSpectrum, k);
+		}
+
+		pxFeatures->fBandRms[i] = spectrum_sqrt(SPECTRUM_HANN_RMS_SCALE * fBand);
+		fTotal += fBand;
+	}
+
+	pxFeatures->fRms = spectrum_sqrt(SPECTRUM_HANN_RMS_SCALE * fTotal);
+
+	/* Keep the strongest local maxima, strongest first. */
+	for (k = SPECTRUM_FIRST_AC_BIN; k < (SPECTRUM_BINS - 1U); k++)
+	{
+		fPower = spectrum_power(pfSpectrum, k);
+
+		if ((fPower <= fPeakPower[SPECTRUM_PEAKS - 1U])
+				|| (fPower <= spectrum_power(pfSpectrum, k - 1U))
+				|| (fPower < spectrum_power(pfSpectrum, k + 1U)))
+		{
+			continue;
+		}
+
+		for (i = SPECTRUM_PEAKS - 1U; (i > 0U) && (fPower > fPeakPower[i - 1U]); i--)
+		{
+			fPeakPower[i] = fPeakPower[i - 1U];
+			ulPeakBin[i] = ulPeakBin[i - 1U];
+		}
+
+		fPeakPower[i] = fPower;
+		ulPeakBin[i] = k;
+	}
+
+	for (j = 0; j < SPECTRUM_PEAKS; j++)
+	{
+		pxFeatures->fPeakHz[j] = 0.0f;
+		pxFeatures->fPeakAmplitude[j] = 0.0f;
+
+		if (ulPeakBin[j] == 0U)
+		{
+			continue;
+		}
+
+		k = ulPeakBin[j];
+		fBefore = spectrum_sqrt(spectrum_power(pfSpectrum, k - 1U));
+		fPeak = spectrum_sqrt(fPeakPower[j]);
+		fAfter = spectrum_sqrt(spectrum_power(pfSpectrum, k + 1U));
+
+		fCurve = fBefore - (2.0f * fPeak) + fAfter;
+		fOffset = (fCurve < 0.0f) ? ((0.5f * (fBefore - fAfter)) / fCurve) : 0.0f;
+
+		pxFeatures->fPeakHz[j] = ((float)k + fOffset) * (float)ulSampleRateHz
+				/ (float)SPECTRUM_SIZE;
+		pxFeatures->fPeakAmplitude[j] = SPECTRUM_HANN_AMPLITUDE
+				* (fPeak - (0.25f * (fBefore - fAfter) * fOffset));
+	}
+}
+
+/**
+ * @brief Windows a frame, transforms it and extracts its features.
+ * @param pfFrame SPECTRUM_SIZE samples, overwritten by the packed spectrum.
+ * @param ulSampleRateHz Sample rate of the frame.
+ * @param pxFeatures Receives the features.
+ * @retval None
+ */
+void spectrum_analyze(float *pfFrame, uint32_t ulSampleRateHz, SpectrumFeatures_t *pxFeatures)
+{
+	spectrum_window(pfFrame);
+	spectrum_rfft(pfFrame);
+	spectrum_features(pfFrame, ulSampleRateHz, pxFeatures);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Returns sin(2 pi ulAngle / SPECTRUM_SIZE) from the quarter-wave table.
+ * @param ulAngle Angle in table steps, any value.
+ * @retval The sine.
+ */
+static float spectrum_sin(uint32_t ulAngle)
+{
+	const uint32_t ulStep = ulAngle % SPECTRUM_QUARTER;
+	float fValue;
+
+	switch ((ulAngle / SPECTRUM_QUARTER) % 4U)
+	{
+	case 0:
+		fValue = fSpectrumSin[ulStep];
+		break;
+	case 1:
+		fValue = fSpectrumSin[SPECTRUM_QUARTER - ulStep];
+		break;
+	case 2:
+		fValue = -fSpectrumSin[ulStep];
+		break;
+	default:
+		fValue = -fSpectrumSin[SPECTRUM_QUARTER - ulStep];
+		break;
+	}
+
+	return fValue;
+}
+
+/**
+ * @brief Returns cos(2 pi ulAngle / SPECTRUM_SIZE) from the quarter-wave table.
+ * @param ulAngle Angle in table steps, any value.
+ * @retval The cosine.
+ */
+static float spectrum_cos(uint32_t ulAngle)
+{
+	return spectrum_sin(ulAngle + SPECTRUM_QUARTER);
+}
+
+/**
+ * @brief Returns the square root of a sum of squares.
+ * @param fValue Value, not negative.
+ * @retval The square root.
+ * @note VSQRT itself: sqrtf() adds an errno path for negative values and
+ * needs libm.
+ */
+static float spectrum_sqrt(float fValue)
+{
+	float fRoot;
+
+	__ASM ("vsqrt.f32 %0, %1" : "=t" (fRoot) : "t" (fValue));
+
+	return fRoot;
+}
+
+/**
+ * @brief Returns the squared magnitude of a bin of a packed spectrum.
+ * @param pfSpectrum Packed spectrum.
+ * @param ulBin 1 .. SPECTRUM_BINS - 1.
+ * @retval The squared magnitude.
+ */
+static float spectrum_power(const float *pfSpectrum, uint32_t ulBin)
+{
+	const float fRe = pfSpectrum[2U * ulBin];
+	const float fIm = pfSpectrum[(2U * ulBin) + 1U];
+
+	return (fRe * fRe) + (fIm * fIm);
+}
+
+/**
+ * @brief Complex FFT of SPECTRUM_BINS points (a power of 4), in place, radix-4
+ * decimation in frequency.
+ * @param pfData SPECTRUM_BINS interleaved real and imaginary parts.
+ * @retval None
+ * @note The output is in base-4 digit-reversed order. Each stage combines
+ * points a quarter span apart, then applies W^j, W^2j and W^3j to three of
+ * the four outputs. The twiddles depend only on j, so they are looked up once
+ * per j and reused across the span's groups.
+ */
+static void spectrum_cfft_radix4(float *pfData)
+{
+	float fCos1, fSin1, fCos2, fSin2, fCos3, fSin3;
+	float fSum02Re, fSum02Im, fDiff02Re, fDiff02Im;
+	float fSum13Re, fSum13Im, fDiff13Re, fDiff13Im;
+	float fRe, fIm;
+	float *pfA, *pfB, *pfC, *pfD;
+	uint32_t ulSpan;
+	uint32_t ulQuarter;
+	uint32_t ulStep;
+	uint32_t i;
+	uint32_t j;
+
+	for (ulSpan = SPECTRUM_BINS; ulSpan >= 4U; ulSpan /= 4U)
+	{
+		ulQuarter = ulSpan / 4U;
+
+		/* W_span^j is W_SIZE^(j * SIZE / span), in table steps. */
+		ulStep = SPECTRUM_SIZE / ulSpan;
+
+		for (j = 0; j < ulQuarter; j++)
+		{
+			fCos1 = spectrum_cos(j * ulStep);
+			fSin1 = spectrum_sin(j * ulStep);
+			fCos2 = spectrum_cos(2U * j * ulStep);
+			fSin2 = spectrum_sin(2U * j * ulStep);
+			fCos3 = spectrum_cos(3U * j * ulStep);
+			fSin3 = spectrum_sin(3U * j * ulStep);
+
+			for (i = j; i < SPECTRUM_BINS; i += ulSpan)
+			{
+				pfA = &pfData[2U * i];
+				pfB = &pfA[2U * ulQuarter];
+				pfC = &pfB[2U * ulQuarter];
+				pfD = &pfC[2U * ulQuarter];
+
+				fSum02Re = pfA[0] + pfC[0];
+				fSum02Im = pfA[1] + pfC[1];
+				fDiff02Re = pfA[0] - pfC[0];
+				fDiff02Im = pfA[1] - pfC[1];
+				fSum13Re = pfB[0] + pfD[0];
+				fSum13Im = pfB[1] + pfD[1];
+				fDiff13Re = pfB[0] - pfD[0];
+				fDiff13Im = pfB[1] - pfD[1];
+
+				/* Output 0: a + b + c + d, no twiddle. */
+				pfA[0] = fSum02Re + fSum13Re;
+				pfA[1] = fSum02Im + fSum13Im;
+
+				/* Output 1: a - ib - c + id, times W^j = cos - i sin. */
+				fRe = fDiff02Re + fDiff13Im;
+				fIm = fDiff02Im - fDiff13Re;
+				pfB[0] = (fRe * fCos1) + (fIm * fSin1);
+				pfB[1] = (fIm * fCos1) - (fRe * fSin1);
+
+				/* Output 2: a - b + c - d, times W^2j. */
+				fRe = fSum02Re - fSum13Re;
+				fIm = fSum02Im - fSum13Im;
+				pfC[0] = (fRe * fCos2) + (fIm * fSin2);
+				pfC[1] = (fIm * fCos2) - (fRe * fSin2);
+
+				/* Output 3: a + ib - c - id, times W^3j. */
+				fRe = fDiff02Re - fDiff13Im;
+				fIm = fDiff02Im + fDiff13Re;
+				pfD[0] = (fRe * fCos3) + (fIm * fSin3);
+				pfD[1] = (fIm * fCos3) - (fRe * fSin3);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Puts the output of spectrum_cfft_radix4() back in natural order.
+ * @param pfData SPECTRUM_BINS interleaved real and imaginary parts.
+ * @retval None
+ */
+static void spectrum_digit_reverse(float *pfData)
+{
+	float fSwap;
+	uint32_t ulReversed;
+	uint32_t ulDigits;
+	uint32_t ulIndex;
+	uint32_t i;
+
+	for (i = 1; i < SPECTRUM_BINS; i++)
+	{
+		ulReversed = 0;
+		ulIndex = i;
+
+		for (ulDigits = 1; ulDigits < SPECTRUM_BINS; ulDigits *= 4U)
+		{
+			ulReversed = (ulReversed * 4U) + (ulIndex % 4U);
+			ulIndex /= 4U;
+		}
+
+		if (ulReversed > i)
+		{
+			fSwap = pfData[2U * i];
+			pfData[2U * i] = pfData[2U * ulReversed];
+			pfData[2U * ulReversed] = fSwap;
+
+			fSwap = pfData[(2U * i) + 1U];
+			pfData[(2U * i) + 1U] = pfData[(2U * ulReversed) + 1U];
+			pfData[(2U * ulReversed) + 1U] = fSwap;
+		}
+	}
+}
@@ -12,14 +12,23 @@
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
 #include "uart.h"
 #include "exti.h"
 #include "adc.h"
+#include "hrtimer.h"
 
 /* Macros --------------------------------------------------------------------*/
 #define mainONE_SHOT_TIMER_PERIOD		(pdMS_TO_TICKS(4000UL))
 #define mainAUTO_RELOAD_TIMER_PERIOD	(pdMS_TO_TICKS(500UL))
+#define TIMER_SLACK 1	/* 0: every timer wakes the daemon on time, 1: nearby expiries share a wakeup */
+#define mainONE_SHOT_TIMER_SLACK		(pdMS_TO_TICKS(300UL))	/* The message can be late. */
+#define mainAUTO_RELOAD_TIMER_SLACK		(pdMS_TO_TICKS(20UL))
+#define mainPULSE_PERIOD_US				250UL	/* LD2 toggles at 2 kHz. */
+#define mainWAKE_DELAY_US				100UL
+#define mainWAKE_NOTIFY_BIT				(1UL << 0)
+#define mainSHORT_DELAY_US				20UL
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
@@ -27,6 +36,8 @@ static void MX_GPIO_Init(void);
 int __io_putchar(int ch);
 void prvOneShotTimerCallback(TimerHandle_t xTimer);
 void prvAutoReloadTimerCallback(TimerHandle_t xTimer);
+static void prvPulseCallback(HrTimer_t *pxTimer, void *pvArg);
+void vHrTimerWakeTask(void *pvParameters);
 
 /* Data types ----------------------------------------------------------------*/
 typedef uint32_t TaskProfiler;
@@ -34,6 +45,7 @@ typedef uint32_t TaskProfiler;
 /* Variables -----------------------------------------------------------------*/
 TimerHandle_t xAutoReloadTimer, xOneShotTimer;
 BaseType_t xAutoReloadTimerStarted, xOneShotTimerStarted;
+HrTimer_t xPulseTimer, xWakeTimer;
 
 /**
  * @brief The application entry point.
@@ -65,10 +77,39 @@ int main(void)
 			0,
 			prvAutoReloadTimerCallback);
 
+#if (TIMER_SLACK == 1)
+	/* The one-shot callback may run up to 300 ms late, so it waits for the
+	 * auto-reload timer due within that window rather than waking the timer
+	 * service task on its own. */
+	vTimerSetSlack(xOneShotTimer, mainONE_SHOT_TIMER_SLACK);
+	vTimerSetSlack(xAutoReloadTimer, mainAUTO_RELOAD_TIMER_SLACK);
+#endif
+
 	/* Start timers. */
 	xOneShotTimerStarted = xTimerStart(xOneShotTimer, 0);
 	xAutoReloadTimerStarted = xTimerStart(xAutoReloadTimer, 0);
 
+	/* Hardware-backed timers: a periodic pulse on LD2 generated in interrupt
+	 * context, independent of the tick. */
+	if (hrtimer_init() != 0)
+	{
+		Error_Handler();
+	}
+
+	hrtimer_setup(&xPulseTimer, prvPulseCallback, NULL);
+
+	if (hrtimer_start(&xPulseTimer, mainPULSE_PERIOD_US, mainPULSE_PERIOD_US) != 0)
+	{
+		Error_Handler();
+	}
+
+	xTaskCreate(vHrTimerWakeTask,
+				"vHrTimerWakeTask",
+				128,
+				NULL,
+				2,
+				NULL);
+
 	vTaskStartScheduler();
 
 	/* Infinite loop */
@@ -107,49 +148,58 @@ void prvAutoReloadTimerCallback(TimerHandle_t xTimer)
 }
 
 /**
- * @brief System Clock Configuration
- * @retval None
+ * @brief High-resolution pulse callback, in TIM5 interrupt context.
+ * @param pxTimer Timer associated with this callback function.
+ * @param pvArg Unused.
+ * @return None.
  */
-void SystemClock_Config(void)
+static void prvPulseCallback(HrTimer_t *pxTimer, void *pvArg)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
+	GPIOA->ODR ^= LD2_Pin;
+}
 
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+/**
+ * @brief Once a second, sleeps for mainWAKE_DELAY_US on a high-resolution
+ * one-shot timer, then for mainSHORT_DELAY_US with hrtimer_delay_us(), and
+ * prints how late it was woken up each time.
+ * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
+ * task function signature.
+ * @return None.
+ */
+void vHrTimerWakeTask(void *pvParameters)
+{
+	uint32_t ulStart;
+	uint32_t ulLate;
+
+	hrtimer_setup_notify(&xWakeTimer, xTaskGetCurrentTaskHandle(), mainWAKE_NOTIFY_BIT);
+
+	while (1)
 	{
-		Error_Handler();
-	}
+		ulStart = hrtimer_now();
+		(void)hrtimer_start_at(&xWakeTimer, ulStart + mainWAKE_DELAY_US, 0);
+		(void)xTaskNotifyWait(0, mainWAKE_NOTIFY_BIT, NULL, portMAX_DELAY);
+		ulLate = hrtimer_now() - ulStart - mainWAKE_DELAY_US;
+
+		printf("High-resolution one-shot woke the task %lu us late\n\r", ulLate);
 
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+		ulStart = hrtimer_now();
+		(void)hrtimer_delay_us(mainSHORT_DELAY_US);
+		ulLate = hrtimer_now() - ulStart - mainSHORT_DELAY_US;
 
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+		printf("hrtimer_delay_us(%lu) returned %lu us late\n\r", mainSHORT_DELAY_US, ulLate);
+		vTaskDelay(pdMS_TO_TICKS(1000UL));
+	}
+}
+
+/**
+ * @brief System Clock Configuration
+ * @retval None
+ */
+void SystemClock_Config(void)
+{
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
@@ -777,6 +777,56 @@ typedef QueueHandle_t SemaphoreHandle_t;
 	#define xSemaphoreCreateMutexStatic( pxMutexBuffer ) xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * semphr. h
+ * <pre>SemaphoreHandle_t xSemaphoreCreateMutexWithCeiling( UBaseType_t uxCeilingPriority )</pre>
+ * <pre>SemaphoreHandle_t xSemaphoreCreateMutexWithCeilingStatic( UBaseType_t uxCeilingPriority, StaticSemaphore_t *pxMutexBuffer )</pre>
+ *
+ * configUSE_MUTEX_PRIORITY_CEILING must be set to 1 in FreeRTOSConfig.h for
+ * these macros to be available.
+ *
+ * Creates a mutex that uses the immediate priority ceiling protocol instead
+ * of priority inheritance.  A task that takes the mutex is raised to
+ * uxCeilingPriority at once, within the critical section of the take, and is
+ * lowered again when it gives back the last mutex it holds.  With the ceiling
+ * set to the highest priority of the tasks that use the mutex, no task that
+ * uses it can preempt the holder.  A take then only blocks if the holder
+ * itself blocked with the mutex held, or if time slicing ran a task of the
+ * ceiling priority, and no priority is ever inherited.
+ *
+ * Like any mutex, it is taken and given with xSemaphoreTake() and
+ * xSemaphoreGive(), and cannot be used from interrupts or recursively.  A
+ * task whose base priority is above the ceiling must not take it.
+ *
+ * @param uxCeilingPriority Priority of the holder, between 1 and
+ * configMAX_PRIORITIES - 1.
+ *
+ * @param pxMutexBuffer As for xSemaphoreCreateMutexStatic().
+ *
+ * @return A handle to the created mutex, or NULL if it could not be created.
+ *
+ * Example usage:
+ <pre>
+ SemaphoreHandle_t xBusMutex;
+
+ void vSetup( void )
+ {
+    // Used by tasks of priorities 1 to 3.
+    xBusMutex = xSemaphoreCreateMutexWithCeiling( 3 );
+ }
+ </pre>
+ * \defgroup xSemaphoreCreateMutexWithCeiling xSemaphoreCreateMutexWithCeiling
+ * \ingroup Semaphores
+ */
+#if( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+	#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		#define xSemaphoreCreateMutexWithCeiling( uxCeilingPriority ) xQueueCreateCeilingMutex( ( uxCeilingPriority ) )
+	#endif
+	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		#define xSemaphoreCreateMutexWithCeilingStatic( uxCeilingPriority, pxMutexBuffer ) xQueueCreateCeilingMutexStatic( ( uxCeilingPriority ), ( pxMutexBuffer ) )
+	#endif
+#endif /* configUSE_MUTEX_PRIORITY_CEILING */
+
 
 /**
  * semphr. h
@@ -1135,6 +1185,20 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define uxSemaphoreGetCount( xSemaphore ) uxQueueMessagesWaiting( ( QueueHandle_t ) ( xSemaphore ) )
 
+/**
+ * semphr.h
+ * <pre>void vSemaphoreAddToRegistry( SemaphoreHandle_t xSemaphore, const char *pcName );</pre>
+ * <pre>SemaphoreHandle_t xSemaphoreFindByName( const char *pcName );</pre>
+ *
+ * Semaphores and mutexes are registered in the queue registry, under a
+ * persistent name, and found again by that name.  See vQueueAddToRegistry()
+ * and xQueueFindByName().  configQUEUE_REGISTRY_SIZE must be greater than 0.
+ */
+#if( configQUEUE_REGISTRY_SIZE > 0 )
+	#define vSemaphoreAddToRegistry( xSemaphore, pcName ) vQueueAddToRegistry( ( QueueHandle_t ) ( xSemaphore ), ( pcName ) )
+	#define xSemaphoreFindByName( pcName ) ( ( SemaphoreHandle_t ) xQueueFindByName( ( pcName ) ) )
+#endif
+
 #endif /* SEMAPHORE_H */
 
 
@@ -0,0 +1,507 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "wide_event_groups.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+to include wide event group functionality. */
+#if( configUSE_WIDE_EVENT_GROUPS == 1 )
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to use wide event groups
+#endif
+
+#if( configSUPPORT_STATIC_ALLOCATION != 1 )
+	#error configSUPPORT_STATIC_ALLOCATION must be set to 1 to use wide event groups
+#endif
+
+/* The record of a waiting task, on its stack for as long as it waits.  Set
+bits unlink it, and then fill in uxResult, before notifying it. */
+typedef struct WideEventWaiter
+{
+	struct WideEventWaiter *pxNext;
+	struct WideEventWaiter *pxPrevious;
+	TaskHandle_t xTask;
+	WideEventBits_t uxBitsToWaitFor;
+	WideEventBits_t uxResult;
+	BaseType_t xClearOnExit;
+	BaseType_t xWaitForAllBits;
+	volatile BaseType_t xReleased;
+} WideEventWaiter_t;
+
+/*
+ * Reads the bits.  Called with interrupts masked, or the two words could come
+ * from two different updates.
+ */
+static WideEventBits_t prvGetBits( WideEventGroupHandle_t xEventGroup ) PRIVILEGED_FUNCTION;
+
+/*
+ * Clears the bits.  Called with interrupts masked.
+ */
+static void prvClearBitsMasked( WideEventGroupHandle_t xEventGroup, WideEventBits_t uxBitsToClear ) PRIVILEGED_FUNCTION;
+
+/*
+ * Tests the condition of a waiting task against uxBits.
+ */
+static BaseType_t prvTestWaitCondition( WideEventBits_t uxBits, WideEventBits_t uxBitsToWaitFor, BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks every waiting task whose condition the bits meet, then clears the
+ * bits of those that asked for it.  Called with interrupts masked.
+ */
+static void prvReleaseWaiters( WideEventGroupHandle_t xEventGroup, BaseType_t xFromISR, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Links and unlinks a waiting task.  Called with interrupts masked.
+ */
+static void prvLinkWaiter( WideEventGroupHandle_t xEventGroup, WideEventWaiter_t *pxWaiter ) PRIVILEGED_FUNCTION;
+static void prvUnlinkWaiter( WideEventGroupHandle_t xEventGroup, WideEventWaiter_t *pxWaiter ) PRIVILEGED_FUNCTION;
+
+#ifndef portSTORE_EXCLUSIVE
+	/*
+	 * Sets the bits.  Called with interrupts masked.
+	 */
+	static void prvSetBitsMasked( WideEventGroupHandle_t xEventGroup, WideEventBits_t uxBitsToSet ) PRIVILEGED_FUNCTION;
+#else
+	/*
+	 * Sets or clears bits of one word with exclusive accesses, and returns the
+	 * word before the update.  The store fails, and the update starts again,
+	 * if an interrupt or a context switch came in between, since exception
+	 * entry and return clear the local monitor.
+	 */
+	static uint32_t prvOrWordExclusive( volatile uint32_t *pulWord, uint32_t ulBits ) PRIVILEGED_FUNCTION;
+	static uint32_t prvAndWordExclusive( volatile uint32_t *pulWord, uint32_t ulBits ) PRIVILEGED_FUNCTION;
+#endif
+
+/*-----------------------------------------------------------*/
+
+WideEventGroupHandle_t xWideEventGroupCreateStatic( UBaseType_t uxIndex, StaticWideEventGroup_t *pxEventGroupBuffer )
+{
+	configASSERT( pxEventGroupBuffer );
+	configASSERT( uxIndex < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+	pxEventGroupBuffer->ulBits[ 0 ] = 0UL;
+	pxEventGroupBuffer->ulBits[ 1 ] = 0UL;
+	pxEventGroupBuffer->pxWaiters = NULL;
+	pxEventGroupBuffer->uxIndex = uxIndex;
+
+	return pxEventGroupBuffer;
+}
+/*-----------------------------------------------------------*/
+
+WideEventBits_t xWideEventGroupWaitBits( WideEventGroupHandle_t xEventGroup, const WideEventBits_t uxBitsToWaitFor, const BaseType_t xClearOnExit, const BaseType_t xWaitForAllBits, TickType_t xTicksToWait )
+{
+WideEventWaiter_t xWaiter;
+TimeOut_t xTimeOut;
+WideEventBits_t uxReturn;
+BaseType_t xWaiting = pdFALSE;
+
+	configASSERT( xEventGroup );
+	configASSERT( uxBitsToWaitFor != ( WideEventBits_t ) 0 );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	taskENTER_CRITICAL();
+	{
+		uxReturn = prvGetBits( xEventGroup );
+
+		if( prvTestWaitCondition( uxReturn, uxBitsToWaitFor, xWaitForAllBits ) != pdFALSE )
+		{
+			if( xClearOnExit != pdFALSE )
+			{
+				prvClearBitsMasked( xEventGroup, uxBitsToWaitFor );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else if( xTicksToWait == ( TickType_t ) 0 )
+		{
+			/* The condition was not met and no block time was given. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+		else
+		{
+			xWaiter.xTask = xTaskGetCurrentTaskHandle();
+			xWaiter.uxBitsToWaitFor = uxBitsToWaitFor;
+			xWaiter.uxResult = ( WideEventBits_t ) 0;
+			xWaiter.xClearOnExit = xClearOnExit;
+			xWaiter.xWaitForAllBits = xWaitForAllBits;
+			xWaiter.xReleased = pdFALSE;
+			prvLinkWaiter( xEventGroup, &xWaiter );
+			xWaiting = pdTRUE;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xWaiting == pdFALSE )
+	{
+		return uxReturn;
+	}
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTakeIndexed( xEventGroup->uxIndex, pdTRUE, xTicksToWait );
+
+		/* A wake-up is only a release if the setter left its result. */
+		if( xWaiter.xReleased != pdFALSE )
+		{
+			uxReturn = xWaiter.uxResult;
+			break;
+		}
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( xWaiter.xReleased == pdFALSE )
+				{
+					prvUnlinkWaiter( xEventGroup, &xWaiter );
+					uxReturn = prvGetBits( xEventGroup );
+				}
+				else
+				{
+					/* Released as the block time expired.  The setter notified
+					this task before it could run, so the notification is
+					pending: clear it. */
+					( void ) ulTaskNotifyValueClearIndexed( xWaiter.xTask, xEventGroup->uxIndex, ~( ( uint32_t ) 0 ) );
+					( void ) xTaskNotifyStateClearIndexed( xWaiter.xTask, xEventGroup->uxIndex );
+					uxReturn = xWaiter.uxResult;
+				}
+			}
+			taskEXIT_CRITICAL();
+			break;
+		}
+	}
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+WideEventBits_t xWideEventGroupSetBits( WideEventGroupHandle_t xEventGroup, const WideEventBits_t uxBitsToSet )
+{
+WideEventBits_t uxReturn;
+
+	configASSERT( xEventGroup );
+
+	#ifdef portSTORE_EXCLUSIVE
+	{
+		uxReturn = ( WideEventBits_t ) ( prvOrWordExclusive( &( xEventGroup->ulBits[ 0 ] ), ( uint32_t ) uxBitsToSet ) | ( uint32_t ) uxBitsToSet );
+		uxReturn |= ( ( WideEventBits_t ) ( prvOrWordExclusive( &( xEventGroup->ulBits[ 1 ] ), ( uint32_t ) ( uxBitsToSet >> 32 ) ) | ( uint32_t ) ( uxBitsToSet >> 32 ) ) ) << 32;
+
+		/* A task that tests the bits before the update above links itself
+		before it leaves its critical section, so it is seen here. */
+		portMEMORY_BARRIER();
+
+		if( xEventGroup->pxWaiters == NULL )
+		{
+			return uxReturn;
+		}
+	}
+	#endif
+
+	taskENTER_CRITICAL();
+	{
+		#ifndef portSTORE_EXCLUSIVE
+		{
+			prvSetBitsMasked( xEventGroup, uxBitsToSet );
+		}
+		#endif
+
+		uxReturn = prvGetBits( xEventGroup );
+		prvReleaseWaiters( xEventGroup, pdFALSE, NULL );
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+WideEventBits_t xWideEventGroupSetBitsFromISR( WideEventGroupHandle_t xEventGroup, const WideEventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
+{
+WideEventBits_t uxReturn;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( xEventGroup );
+
+	#ifdef portSTORE_EXCLUSIVE
+	{
+		uxReturn = ( WideEventBits_t ) ( prvOrWordExclusive( &( xEventGroup->ulBits[ 0 ] ), ( uint32_t ) uxBitsToSet ) | ( uint32_t ) uxBitsToSet );
+		uxReturn |= ( ( WideEventBits_t ) ( prvOrWordExclusive( &( xEventGroup->ulBits[ 1 ] ), ( uint32_t ) ( uxBitsToSet >> 32 ) ) | ( uint32_t ) ( uxBitsToSet >> 32 ) ) ) << 32;
+
+		portMEMORY_BARRIER();
+
+		if( xEventGroup->pxWaiters == NULL )
+		{
+			return uxReturn;
+		}
+	}
+	#endif
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		#ifndef portSTORE_EXCLUSIVE
+		{
+			prvSetBitsMasked( xEventGroup, uxBitsToSet );
+		}
+		#endif
+
+		uxReturn = prvGetBits( xEventGroup );
+		prvReleaseWaiters( xEventGroup, pdTRUE, pxHigherPriorityTaskWoken );
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+WideEventBits_t xWideEventGroupClearBits( WideEventGroupHandle_t xEventGroup, const WideEventBits_t uxBitsToClear )
+{
+WideEventBits_t uxReturn;
+
+	configASSERT( xEventGroup );
+
+	/* Clearing bits never unblocks a task, so the waiting tasks are not
+	looked at. */
+	#ifdef portSTORE_EXCLUSIVE
+	{
+		uxReturn = ( WideEventBits_t ) prvAndWordExclusive( &( xEventGroup->ulBits[ 0 ] ), ~( uint32_t ) uxBitsToClear );
+		uxReturn |= ( ( WideEventBits_t ) prvAndWordExclusive( &( xEventGroup->ulBits[ 1 ] ), ~( uint32_t ) ( uxBitsToClear >> 32 ) ) ) << 32;
+	}
+	#else
+	{
+	UBaseType_t uxSavedInterruptStatus;
+
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		{
+			uxReturn = prvGetBits( xEventGroup );
+			prvClearBitsMasked( xEventGroup, uxBitsToClear );
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+	}
+	#endif
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+WideEventBits_t xWideEventGroupGetBits( WideEventGroupHandle_t xEventGroup )
+{
+WideEventBits_t uxReturn;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( xEventGroup );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		uxReturn = prvGetBits( xEventGroup );
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static WideEventBits_t prvGetBits( WideEventGroupHandle_t xEventGroup )
+{
+	return ( ( WideEventBits_t ) xEventGroup->ulBits[ 1 ] << 32 ) | ( WideEventBits_t ) xEventGroup->ulBits[ 0 ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvClearBitsMasked( WideEventGroupHandle_t xEventGroup, WideEventBits_t uxBitsToClear )
+{
+	xEventGroup->ulBits[ 0 ] &= ~( uint32_t ) uxBitsToClear;
+	xEventGroup->ulBits[ 1 ] &= ~( uint32_t ) ( uxBitsToClear >> 32 );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestWaitCondition( WideEventBits_t uxBits, WideEventBits_t uxBitsToWaitFor, BaseType_t xWaitForAllBits )
+{
+BaseType_t xWaitConditionMet;
+
+	if( xWaitForAllBits == pdFALSE )
+	{
+		xWaitConditionMet = ( ( uxBits & uxBitsToWaitFor ) != ( WideEventBits_t ) 0 ) ? pdTRUE : pdFALSE;
+	}
+	else
+	{
+		xWaitConditionMet = ( ( uxBits & uxBitsToWaitFor ) == uxBitsToWaitFor ) ? pdTRUE : pdFALSE;
+	}
+
+	return xWaitConditionMet;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReleaseWaiters( WideEventGroupHandle_t xEventGroup, BaseType_t xFromISR, BaseType_t *pxHigherPriorityTaskWoken )
+{
+WideEventWaiter_t *pxWaiter, *pxNext;
+WideEventBits_t uxBits, uxBitsToClear = ( WideEventBits_t ) 0;
+
+	uxBits = prvGetBits( xEventGroup );
+
+	/* Each task is tested against the bits as set, as event_groups.c does:
+	the bits asked to be cleared on exit are only cleared after the walk. */
+	for( pxWaiter = xEventGroup->pxWaiters; pxWaiter != NULL; pxWaiter = pxNext )
+	{
+		pxNext = pxWaiter->pxNext;
+
+		if( prvTestWaitCondition( uxBits, pxWaiter->uxBitsToWaitFor, pxWaiter->xWaitForAllBits ) != pdFALSE )
+		{
+			if( pxWaiter->xClearOnExit != pdFALSE )
+			{
+				uxBitsToClear |= pxWaiter->uxBitsToWaitFor;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			prvUnlinkWaiter( xEventGroup, pxWaiter );
+			pxWaiter->uxResult = uxBits;
+			pxWaiter->xReleased = pdTRUE;
+
+			/* The task may return, and its record go, as soon as it runs,
+			which cannot be before interrupts are unmasked. */
+			if( xFromISR != pdFALSE )
+			{
+				vTaskNotifyGiveIndexedFromISR( pxWaiter->xTask, xEventGroup->uxIndex, pxHigherPriorityTaskWoken );
+			}
+			else
+			{
+				( void ) xTaskNotifyGiveIndexed( pxWaiter->xTask, xEventGroup->uxIndex );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	prvClearBitsMasked( xEventGroup, uxBitsToClear );
+}
+/*-----------------------------------------------------------*/
+
+static void prvLinkWaiter( WideEventGroupHandle_t xEventGroup, WideEventWaiter_t *pxWaiter )
+{
+	pxWaiter->pxPrevious = NULL;
+	pxWaiter->pxNext = xEventGroup->pxWaiters;
+
+	if( pxWaiter->pxNext != NULL )
+	{
+		pxWaiter->pxNext->pxPrevious = pxWaiter;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xEventGroup->pxWaiters = pxWaiter;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUnlinkWaiter( WideEventGroupHandle_t xEventGroup, WideEventWaiter_t *pxWaiter )
+{
+	if( pxWaiter->pxPrevious != NULL )
+	{
+		pxWaiter->pxPrevious->pxNext = pxWaiter->pxNext;
+	}
+	else
+	{
+		xEventGroup->pxWaiters = pxWaiter->pxNext;
+	}
+
+	if( pxWaiter->pxNext != NULL )
+	{
+		pxWaiter->pxNext->pxPrevious = pxWaiter->pxPrevious;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+#ifndef portSTORE_EXCLUSIVE
+
+	static void prvSetBitsMasked( WideEventGroupHandle_t xEventGroup, WideEventBits_t uxBitsToSet )
+	{
+		xEventGroup->ulBits[ 0 ] |= ( uint32_t ) uxBitsToSet;
+		xEventGroup->ulBits[ 1 ] |= ( uint32_t ) ( uxBitsToSet >> 32 );
+	}
+	/*-----------------------------------------------------------*/
+
+#else
+
+	static uint32_t prvOrWordExclusive( volatile uint32_t *pulWord, uint32_t ulBits )
+	{
+	uint32_t ulValue;
+
+		do
+		{
+			ulValue = portLOAD_EXCLUSIVE( pulWord );
+		} while( portSTORE_EXCLUSIVE( pulWord, ulValue | ulBits ) != 0UL );
+
+		return ulValue;
+	}
+	/*-----------------------------------------------------------*/
+
+	static uint32_t prvAndWordExclusive( volatile uint32_t *pulWord, uint32_t ulBits )
+	{
+	uint32_t ulValue;
+
+		do
+		{
+			ulValue = portLOAD_EXCLUSIVE( pulWord );
+		} while( portSTORE_EXCLUSIVE( pulWord, ulValue & ulBits ) != 0UL );
+
+		return ulValue;
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* portSTORE_EXCLUSIVE */
+
+#endif /* configUSE_WIDE_EVENT_GROUPS */
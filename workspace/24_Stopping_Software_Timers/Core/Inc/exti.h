@@ -11,9 +11,84 @@
 #define EXTI_H
 
 /* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define EXTI_LINES 16U				/* One per pin number, of any port. */
+
+#ifndef EXTI_IRQ_PRIORITY
+#define EXTI_IRQ_PRIORITY 6U		/* At or below configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef enum
+{
+	EXTI_EDGE_RISING = 1U,
+	EXTI_EDGE_FALLING = 2U,
+	EXTI_EDGE_BOTH = 3U
+} ExtiEdge_t;
+
+typedef enum
+{
+	EXTI_PULL_NONE = 0U,			/* GPIOx_PUPDR encodings. */
+	EXTI_PULL_UP = 1U,
+	EXTI_PULL_DOWN = 2U
+} ExtiPull_t;
+
+/* How edges are merged into fewer reports; see exti.c. */
+typedef enum
+{
+	EXTI_COALESCE_NONE = 0U,		/* One report per edge (or debounce window). */
+	EXTI_COALESCE_WINDOW = 1U,		/* Every edge counted, one report per window. */
+	EXTI_COALESCE_HOLDOFF = 2U		/* First edge reported, then masked for the holdoff. */
+} ExtiCoalesce_t;
+
+/* Called from the EXTI interrupt, or from the TIM5 one when the end of a
+ * debounce or coalescing window has something to report. ulLevel is the pin
+ * level. */
+typedef void (*ExtiCallback_t)(uint32_t ulLine, uint32_t ulLevel, void *pvArg,
+		BaseType_t *pxHigherPriorityTaskWoken);
+
+typedef struct
+{
+	GPIO_TypeDef *pxPort;
+	uint8_t ucPin;					/* 0..15, which is also the EXTI line. */
+	uint8_t ucEdge;					/* ExtiEdge_t */
+	uint8_t ucPull;					/* ExtiPull_t */
+	uint16_t usDebounceMs;			/* Quiet time after an event; 0 for none. */
+	ExtiCallback_t pxCallback;		/* NULL to notify *pxNotifyTask instead. */
+	void *pvArg;
+	TaskHandle_t *pxNotifyTask;		/* Read at each event, so set it at any time. */
+	uint32_t ulNotifyBits;			/* 0 to give the notification count. */
+	uint8_t ucCoalesce;				/* ExtiCoalesce_t; not with usDebounceMs. */
+	uint32_t ulCoalesceUs;			/* Window or holdoff from the first edge. */
+} ExtiPin_t;
+
+/* Edges reported since the last exti_take_batch(). */
+typedef struct
+{
+	uint32_t ulCount;				/* EXTI_COALESCE_HOLDOFF: at least this many. */
+	uint32_t ulFirstUs;				/* hrtimer_now() at the first edge, */
+	uint32_t ulLastUs;				/* and at the last one. */
+} ExtiBatch_t;
+
+typedef struct
+{
+	uint32_t ulEvents;				/* Callbacks or notifications. */
+	uint32_t ulEdges;				/* Edges in them. */
+	uint32_t ulBounces;				/* Debounce windows that saw further edges. */
+} ExtiStats_t;
 
 /* Function Prototypes -------------------------------------------------------*/
-void gpio_pc13_interrupt_init(void);
+int32_t exti_init(const ExtiPin_t *pxPins, uint32_t ulCount);
+void exti_enable(uint32_t ulLine);
+void exti_disable(uint32_t ulLine);
+uint32_t exti_read(uint32_t ulLine);
+uint32_t exti_take_batch(uint32_t ulLine, ExtiBatch_t *pxBatch);
+int32_t exti_get_stats(uint32_t ulLine, ExtiStats_t *pxStats);
 void gpio_init(void);
 uint8_t read_digital_sensor(void);
 
@@ -12,6 +12,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
 #include "uart.h"
 #include "exti.h"
@@ -20,6 +21,8 @@
 /* Macros --------------------------------------------------------------------*/
 #define mainONE_SHOT_TIMER_PERIOD		(pdMS_TO_TICKS(4000UL))
 #define mainAUTO_RELOAD_TIMER_PERIOD	(pdMS_TO_TICKS(500UL))
+#define TIMER_DAEMONS_SPLIT 1	/* 0: both timers on one timer service task, 1: the one-shot timer on its own */
+#define ONE_SHOT_TIMER_DAEMON 1U	/* configTIMER_TASK_PRIORITY + 1 */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
@@ -27,6 +30,9 @@ static void MX_GPIO_Init(void);
 int __io_putchar(int ch);
 void prvOneShotTimerCallback(TimerHandle_t xTimer);
 void prvAutoReloadTimerCallback(TimerHandle_t xTimer);
+#if (TIMER_DAEMONS_SPLIT == 1)
+static void prvPrintDaemonStats(void);
+#endif
 
 /* Data types ----------------------------------------------------------------*/
 typedef uint32_t TaskProfiler;
@@ -65,6 +71,12 @@ int main(void)
 			0,
 			prvAutoReloadTimerCallback);
 
+#if (TIMER_DAEMONS_SPLIT == 1)
+	/* The one-shot timer fires on time even while the auto-reload timer
+	 * callback is busy printing on the lower priority daemon. */
+	vTimerSetDaemon(xOneShotTimer, ONE_SHOT_TIMER_DAEMON);
+#endif
+
 	/* Start timers. */
 	xOneShotTimerStarted = xTimerStart(xOneShotTimer, 0);
 	xAutoReloadTimerStarted = xTimerStart(xAutoReloadTimer, 0);
@@ -113,53 +125,42 @@ void prvAutoReloadTimerCallback(TimerHandle_t xTimer)
 	{
 		printf("Timer_STOP_COUNT reached %d\n\r", (int)xTimeNow);
 		xTimerStop(xAutoReloadTimer, 0);
+#if (TIMER_DAEMONS_SPLIT == 1)
+		prvPrintDaemonStats();
+#endif
 	}
 }
 
+#if (TIMER_DAEMONS_SPLIT == 1)
 /**
- * @brief System Clock Configuration
- * @retval None
+ * @brief Prints the callback count and times of each timer service task.
+ * @return None.
  */
-void SystemClock_Config(void)
+static void prvPrintDaemonStats(void)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
+	TimerDaemonStats_t xStats;
+	UBaseType_t uxDaemon;
 
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+	for (uxDaemon = 0U; uxDaemon < (UBaseType_t)configTIMER_DAEMONS; uxDaemon++)
 	{
-		Error_Handler();
+		vTimerGetDaemonStats(uxDaemon, &xStats);
+		printf("Daemon %u: %lu callbacks, %lu ticks, longest %lu\n\r",
+				(unsigned)uxDaemon, (unsigned long)xStats.ulCallbacks,
+				(unsigned long)xStats.xTotalCallbackTime,
+				(unsigned long)xStats.xMaxCallbackTime);
 	}
+}
+#endif
 
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+/**
+ * @brief System Clock Configuration
+ * @retval None
+ */
+void SystemClock_Config(void)
+{
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
@@ -0,0 +1,221 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Light channels carry 32-bit messages - command codes, sensor readings,
+ * pointers - to a single task, the owner.  They replace a queue of
+ * uint32_t items for the common case where only one task ever receives:
+ *
+ * - The oldest message waiting is the value of one entry of the owner's task
+ *   notification array (see configTASK_NOTIFICATION_ARRAY_ENTRIES).  A send
+ *   to an empty channel is xTaskNotifyIndexed( ..., eSetValueWithoutOverwrite ),
+ *   and a receive is xTaskNotifyWaitIndexed(), so the send-to-wake path is
+ *   that of a task notification.  Nothing is copied through a queue storage
+ *   area and the channel has no receive event list.
+ *
+ * - The messages sent while the notification is still pending go to a small
+ *   overflow ring, provided by the application, in order.  Each receive moves
+ *   the oldest of them into the notification, so the owner always receives
+ *   them first in, first out.  The ring may have a length of 0, in which case
+ *   the channel holds one message.
+ *
+ * - A task that sends to a full channel blocks, for up to its block time,
+ *   until the owner receives.  Interrupts never block: a send from an ISR to a
+ *   full channel fails.
+ *
+ * ***NOTE***:  Any number of tasks and interrupts may send to a light channel,
+ * but only its owner may receive from it.  A receive by any other task fails
+ * configASSERT().  Use a queue when more than one task needs to receive.
+ *
+ * The notification index belongs to the channel - the owner must not use it
+ * for anything else.  Index 0 (tskDEFAULT_INDEX_TO_NOTIFY) is also used by the
+ * task notification functions that do not take an index, and by stream
+ * buffers.
+ */
+
+#ifndef LIGHT_CHANNEL_H
+#define LIGHT_CHANNEL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include light_channel.h"
+#endif
+
+#include "task.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * The storage of a light channel, declared by the application and passed to
+ * xLightChannelCreateStatic().  Its members must not be accessed directly.
+ */
+typedef struct LightChannelDef_t
+{
+	TaskHandle_t xOwner;
+	UBaseType_t uxIndex;
+	uint32_t *pulRing;						/* uxRingLength messages. */
+	UBaseType_t uxRingLength;
+	UBaseType_t uxRingHead;					/* Oldest message in the ring. */
+	volatile UBaseType_t uxRingCount;
+	List_t xTasksWaitingToSend;				/* In priority order. */
+} StaticLightChannel_t;
+
+/**
+ * Type by which light channels are referenced.
+ */
+typedef StaticLightChannel_t * LightChannelHandle_t;
+
+/**
+ * light_channel.h
+ *
+<pre>
+LightChannelHandle_t xLightChannelCreateStatic( TaskHandle_t xOwner,
+                                                UBaseType_t uxIndex,
+                                                UBaseType_t uxRingLength,
+                                                uint32_t *pulRingStorage,
+                                                StaticLightChannel_t *pxChannelBuffer );
+</pre>
+ *
+ * Creates an empty light channel in pxChannelBuffer.  The owner's notification
+ * at uxIndex is cleared.
+ *
+ * @param xOwner The only task that may receive from the channel.
+ *
+ * @param uxIndex The owner's notification index used by the channel, less
+ * than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
+ * @param uxRingLength The number of messages the overflow ring holds.  The
+ * channel holds one more, in the notification.  May be 0.
+ *
+ * @param pulRingStorage An array of at least uxRingLength words, or NULL if
+ * uxRingLength is 0.
+ *
+ * @param pxChannelBuffer The storage of the channel.
+ *
+ * @return A handle to the channel.
+ *
+ * Example usage:
+<pre>
+StaticLightChannel_t xCommandsBuffer;
+uint32_t ulCommandsRing[ 4 ];
+LightChannelHandle_t xCommands;
+
+void vSetup( TaskHandle_t xMotorTask )
+{
+	// Index 1 of xMotorTask's notifications holds the oldest of up to 5
+	// commands.
+	xCommands = xLightChannelCreateStatic( xMotorTask, 1, 4, ulCommandsRing, &xCommandsBuffer );
+}
+</pre>
+ * \defgroup xLightChannelCreateStatic xLightChannelCreateStatic
+ * \ingroup LightChannels
+ */
+LightChannelHandle_t xLightChannelCreateStatic( TaskHandle_t xOwner, UBaseType_t uxIndex, UBaseType_t uxRingLength, uint32_t *pulRingStorage, StaticLightChannel_t *pxChannelBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * light_channel.h
+ *
+<pre>
+BaseType_t xLightChannelSend( LightChannelHandle_t xChannel, uint32_t ulValue, TickType_t xTicksToWait );
+</pre>
+ *
+ * Sends ulValue to the channel, blocking for up to xTicksToWait while the
+ * channel is full.  If the owner is waiting, it is unblocked.
+ *
+ * @return pdPASS if the message was sent, errQUEUE_FULL if the block time
+ * expired first.
+ *
+ * \defgroup xLightChannelSend xLightChannelSend
+ * \ingroup LightChannels
+ */
+BaseType_t xLightChannelSend( LightChannelHandle_t xChannel, uint32_t ulValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * light_channel.h
+ *
+<pre>
+BaseType_t xLightChannelSendFromISR( LightChannelHandle_t xChannel, uint32_t ulValue, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xLightChannelSend() that can be called from an ISR.  It never
+ * blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending unblocked the
+ * owner and the owner has a priority above the interrupted task, in which case
+ * a context switch should be requested before the ISR exits.
+ *
+ * @return pdPASS if the message was sent, errQUEUE_FULL if the channel was
+ * full.
+ *
+ * \defgroup xLightChannelSendFromISR xLightChannelSendFromISR
+ * \ingroup LightChannels
+ */
+BaseType_t xLightChannelSendFromISR( LightChannelHandle_t xChannel, uint32_t ulValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * light_channel.h
+ *
+<pre>
+BaseType_t xLightChannelReceive( LightChannelHandle_t xChannel, uint32_t *pulValue, TickType_t xTicksToWait );
+</pre>
+ *
+ * Receives the oldest message, blocking for up to xTicksToWait while the
+ * channel is empty.  Must only be called by the owner.  If a task is blocked
+ * sending to the channel, the highest priority one is unblocked.
+ *
+ * @param pulValue Where the message is written.
+ *
+ * @return pdTRUE if a message was received, pdFALSE if the block time expired
+ * first.
+ *
+ * \defgroup xLightChannelReceive xLightChannelReceive
+ * \ingroup LightChannels
+ */
+BaseType_t xLightChannelReceive( LightChannelHandle_t xChannel, uint32_t *pulValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * light_channel.h
+ *
+<pre>
+UBaseType_t uxLightChannelGetRingCount( LightChannelHandle_t xChannel );
+</pre>
+ *
+ * @return The number of messages in the overflow ring, not counting the one
+ * in the notification.  A channel whose ring is often full needs a longer
+ * ring, or a queue.
+ *
+ * \defgroup uxLightChannelGetRingCount uxLightChannelGetRingCount
+ * \ingroup LightChannels
+ */
+UBaseType_t uxLightChannelGetRingCount( LightChannelHandle_t xChannel ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif	/* !defined( LIGHT_CHANNEL_H ) */
@@ -93,7 +93,8 @@ typedef enum
 	eSetBits,					/* Set bits in the task's notification value. */
 	eIncrement,					/* Increment the task's notification value. */
 	eSetValueWithOverwrite,		/* Set the task's notification value to a specific value even if the previous value has not yet been read by the task. */
-	eSetValueWithoutOverwrite	/* Set the task's notification value if the previous value has been read by the task. */
+	eSetValueWithoutOverwrite,	/* Set the task's notification value if the previous value has been read by the task. */
+	eIncrementUpToValue			/* Increment the task's notification value if it is below ulValue. */
 } eNotifyAction;
 
 /*
@@ -142,11 +143,104 @@ typedef struct xTASK_STATUS
 	eTaskState eCurrentState;		/* The state in which the task existed when the structure was populated. */
 	UBaseType_t uxCurrentPriority;	/* The priority at which the task was running (may be inherited) when the structure was populated. */
 	UBaseType_t uxBasePriority;		/* The priority to which the task will return if the task's current priority has been inherited to avoid unbounded priority inversion when obtaining a mutex.  Only valid if configUSE_MUTEXES is defined as 1 in FreeRTOSConfig.h. */
-	uint32_t ulRunTimeCounter;		/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
+	configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;	/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
 	StackType_t *pxStackBase;		/* Points to the lowest address of the task's stack area. */
 	configSTACK_DEPTH_TYPE usStackHighWaterMark;	/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
+	#if ( configUSE_SWITCH_STATS == 1 )
+		uint32_t ulVoluntarySwitches;	/* Switches away from the task that it asked for: it blocked, suspended itself or yielded. */
+		uint32_t ulInvoluntarySwitches;	/* Switches away from the task while it was still ready: preempted, or its time slice ended. */
+	#endif
 } TaskStatus_t;
 
+#if ( configUSE_TICK_STATS == 1 )
+
+	/* The cost of the tick interrupt, see vTaskGetTickStats().  Times are in
+	tick timer counts, which are CPU cycles unless the port clocks the timer
+	otherwise. */
+	typedef struct xTICK_STATS
+	{
+		uint32_t ulTicks;				/* Tick interrupts measured since the statistics were last reset. */
+		uint64_t ullTotalCycles;		/* Time spent in them. */
+		uint32_t ulMaxCycles;			/* The longest one. */
+		uint32_t ulMaxLatencyCycles;	/* The latest one was taken this long after the timer expired. */
+		uint32_t ulMaxUnblocked;		/* The most tasks unblocked by one tick. */
+		uint32_t ulCycleHistogram[ configTICK_STATS_BUCKETS ];		/* [ 0 ] counts ticks of 0 cycles, [ n ] those from 2^(n-1) to 2^n - 1, and the last bucket also the longer ones. */
+		uint32_t ulLatencyHistogram[ configTICK_STATS_BUCKETS ];	/* The same for how late the ticks were taken. */
+		uint32_t ulUnblockedHistogram[ configTICK_STATS_BUCKETS ];	/* [ n ] counts ticks that unblocked n tasks, and the last bucket also those that unblocked more. */
+	} TickStats_t;
+
+#endif /* configUSE_TICK_STATS */
+
+#if ( configUSE_IDLE_SLEEP == 1 )
+
+	/* How the idle task slept, see vTaskGetIdleSleepStats().  Times are in
+	tick timer counts, which are CPU cycles unless the port clocks the timer
+	otherwise. */
+	typedef struct xIDLE_SLEEP_STATS
+	{
+		uint32_t ulSleeps;				/* Times the idle task slept since the statistics were last reset. */
+		uint32_t ulTickWakes;			/* Those ended by the tick interrupt, the only ones that can be timed. */
+		uint64_t ullTotalWakeCycles;	/* From the tick timer expiring to the CPU running again, over those. */
+		uint32_t ulMaxWakeCycles;		/* The longest wake-up. */
+	} IdleSleepStats_t;
+
+#endif /* configUSE_IDLE_SLEEP */
+
+#if ( configUSE_TASK_SNAPSHOTS == 1 )
+
+	/* A walk over every task, see uxTaskSnapshotNext().  The members are only
+	for the kernel to use. */
+	typedef struct xTASK_SNAPSHOT
+	{
+		void *pvNext;					/* The list item of the next task to copy. */
+		UBaseType_t uxGeneration;		/* uxTaskNumber when the snapshot started, changed by every task creation and deletion. */
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+			configRUN_TIME_COUNTER_TYPE ulTotalRunTime;	/* The run time counter when the snapshot started, as uxTaskGetSystemState() returns it. */
+		#endif
+	} TaskSnapshot_t;
+
+#endif /* configUSE_TASK_SNAPSHOTS */
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	/* What is done with a task that uses up its budget, see vTaskSetBudget(). */
+	typedef enum
+	{
+		eTaskBudgetNotify = 0,	/* Only count the overrun and call vApplicationTaskBudgetHook(). */
+		eTaskBudgetDemote,		/* Run at configTASK_BUDGET_BACKGROUND_PRIORITY until the next period. */
+		eTaskBudgetSuspend		/* Do not run until the next period. */
+	} eTaskBudgetAction;
+
+	/* The budget of a task, see vTaskGetBudget().  Run times are in run time
+	stats counts. */
+	typedef struct xTASK_BUDGET_STATUS
+	{
+		configRUN_TIME_COUNTER_TYPE ulBudget;	/* The run time allowed per period, 0 if the task has no budget. */
+		configRUN_TIME_COUNTER_TYPE ulUsed;		/* The run time used in the current period. */
+		TickType_t xPeriod;						/* The period, in ticks. */
+		uint32_t ulOverruns;					/* Periods in which the budget ran out. */
+		BaseType_t xThrottled;					/* pdTRUE while the task is demoted or suspended for an overrun. */
+	} TaskBudgetStatus_t;
+
+#endif /* configUSE_TASK_BUDGETS */
+
+#if ( configUSE_JOB_STATS == 1 )
+
+	/* The jobs of a task since its statistics were last reset, see
+	vTaskGetJobStats().  Times are in run time stats counts, 0 until there is
+	something to measure. */
+	typedef struct xTASK_JOB_STATS
+	{
+		uint32_t ulJobs;							/* Releases. */
+		uint32_t ulJobsDone;						/* Jobs of those releases that have ended. */
+		configRUN_TIME_COUNTER_TYPE ulPeriodMin;	/* Shortest time between two releases. */
+		configRUN_TIME_COUNTER_TYPE ulPeriodMean;	/* From the first release to the last, over ulJobs - 1. */
+		configRUN_TIME_COUNTER_TYPE ulExecMax;		/* Longest run time of a job. */
+		configRUN_TIME_COUNTER_TYPE ulExecMean;		/* Run time of the ended jobs, over ulJobsDone. */
+	} TaskJobStats_t;
+
+#endif /* configUSE_JOB_STATS */
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -162,6 +256,14 @@ typedef enum
  */
 #define tskIDLE_PRIORITY			( ( UBaseType_t ) 0U )
 
+/**
+ * The notification index used by the task notification API functions that do
+ * not take an index, such as xTaskNotifyGive() and ulTaskNotifyTake().
+ *
+ * \ingroup TaskNotifications
+ */
+#define tskDEFAULT_INDEX_TO_NOTIFY	( 0 )
+
 /**
  * task. h
  *
@@ -170,7 +272,11 @@ typedef enum
  * \defgroup taskYIELD taskYIELD
  * \ingroup SchedulerControl
  */
-#define taskYIELD()					portYIELD()
+#if ( configUSE_SWITCH_STATS == 1 )
+	#define taskYIELD()					vTaskYieldVoluntary()
+#else
+	#define taskYIELD()					portYIELD()
+#endif
 
 /**
  * task. h
@@ -1017,6 +1123,254 @@ void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xG
  */
 void vTaskPrioritySet( TaskHandle_t xTask, UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>void vTaskSetDeadline( TaskHandle_t xTask, TickType_t xDeadline );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be set to 1 for this function to be available.
+ *
+ * Set the absolute deadline, in ticks, of a task.  The ready tasks of
+ * configEDF_PRIORITY run in the order of their deadlines, earliest first, and
+ * a task of that priority made ready with an earlier deadline than the running
+ * one preempts it.  Tasks of other priorities are scheduled as usual, and keep
+ * the deadline for when they are raised to configEDF_PRIORITY.
+ *
+ * Deadlines are compared by their difference, so a deadline must be less than
+ * portMAX_DELAY / 2 ticks away from the others.  A periodic task usually sets
+ * the deadline of its next release just before it blocks.
+ *
+ * @param xTask Handle of the task, or NULL for the calling task.
+ *
+ * @param xDeadline The tick count by which the task must have completed.
+ *
+ * \defgroup vTaskSetDeadline vTaskSetDeadline
+ * \ingroup TaskCtrl
+ */
+void vTaskSetDeadline( TaskHandle_t xTask, TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>TickType_t xTaskGetDeadline( TaskHandle_t xTask );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be set to 1 for this function to be available.
+ *
+ * @param xTask Handle of the task, or NULL for the calling task.
+ *
+ * @return The absolute deadline last set with vTaskSetDeadline().
+ *
+ * \defgroup xTaskGetDeadline xTaskGetDeadline
+ * \ingroup TaskCtrl
+ */
+TickType_t xTaskGetDeadline( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskSetTimeSlice( TaskHandle_t xTask, TickType_t xTicks );</pre>
+ *
+ * configUSE_TASK_TIME_SLICE_QUANTA must be set to 1 for this function to be
+ * available.
+ *
+ * Set the round robin quantum of a task: the number of ticks it runs before
+ * the scheduler switches to the next ready task of the same priority.  Tasks
+ * start with configTASK_TIME_SLICE_TICKS.  A long quantum suits a compute
+ * task, which is then switched out less often; a latency sensitive peer keeps
+ * a short one.
+ *
+ * Ticks in which the task is alone at its priority do not use up its quantum.
+ * A task preempted by a higher priority keeps what is left of its quantum, and
+ * one that blocks starts its next turn with a whole quantum.
+ *
+ * @param xTask Handle of the task, or NULL for the calling task.
+ *
+ * @param xTicks The quantum, in ticks; at least 1.  It also restarts the
+ * current one.
+ *
+ * \defgroup vTaskSetTimeSlice vTaskSetTimeSlice
+ * \ingroup TaskCtrl
+ */
+void vTaskSetTimeSlice( TaskHandle_t xTask, TickType_t xTicks ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>TickType_t xTaskGetTimeSlice( TaskHandle_t xTask );</pre>
+ *
+ * configUSE_TASK_TIME_SLICE_QUANTA must be set to 1 for this function to be
+ * available.
+ *
+ * @param xTask Handle of the task, or NULL for the calling task.
+ *
+ * @return The round robin quantum of the task, in ticks.
+ *
+ * \defgroup xTaskGetTimeSlice xTaskGetTimeSlice
+ * \ingroup TaskCtrl
+ */
+TickType_t xTaskGetTimeSlice( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskPreemptionThresholdSet( TaskHandle_t xTask, UBaseType_t uxThreshold );</pre>
+ *
+ * configUSE_PREEMPTION_THRESHOLD must be set to 1 for this function to be
+ * available.
+ *
+ * Set the preemption threshold of a task: once it runs, only a task with a
+ * priority above uxThreshold preempts it.  A task made ready at or below the
+ * threshold waits for it to block, suspend itself or lower the threshold, and
+ * a task above the threshold that preempts it gives the processor back to it
+ * before any of them.  The task is still only chosen to start running by its
+ * priority.
+ *
+ * Tasks that share data and have the same threshold, at least the highest of
+ * their priorities, therefore never run in the middle of one another's
+ * updates, with no mutex, while the tasks above the threshold keep their
+ * response time.  Fewer preemptions also mean fewer context switches.  The
+ * updates must not block, and each one delays the tasks up to the threshold by
+ * its length.
+ *
+ * A task running above its priority is not time sliced, and taskYIELD() only
+ * gives way to tasks above its threshold.
+ *
+ * @param xTask Handle of the task, or NULL for the calling task.
+ *
+ * @param uxThreshold A priority below configMAX_PRIORITIES.  0, or a value not
+ * above the priority of the task, removes the threshold, which is how tasks
+ * start.
+ *
+ * \defgroup vTaskPreemptionThresholdSet vTaskPreemptionThresholdSet
+ * \ingroup TaskCtrl
+ */
+void vTaskPreemptionThresholdSet( TaskHandle_t xTask, UBaseType_t uxThreshold ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>UBaseType_t uxTaskPreemptionThresholdGet( TaskHandle_t xTask );</pre>
+ *
+ * configUSE_PREEMPTION_THRESHOLD must be set to 1 for this function to be
+ * available.
+ *
+ * @param xTask Handle of the task, or NULL for the calling task.
+ *
+ * @return The preemption threshold set with vTaskPreemptionThresholdSet(), 0
+ * if none was.
+ *
+ * \defgroup uxTaskPreemptionThresholdGet uxTaskPreemptionThresholdGet
+ * \ingroup TaskCtrl
+ */
+UBaseType_t uxTaskPreemptionThresholdGet( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskSetBudget( TaskHandle_t xTask, configRUN_TIME_COUNTER_TYPE ulBudget, TickType_t xPeriod, eTaskBudgetAction eAction );</pre>
+ *
+ * configUSE_TASK_BUDGETS must be set to 1 for this function to be available.
+ *
+ * Limit the processor time a task can use in each period, so that a task that
+ * runs away cannot starve those at or below its priority.  The run time stats
+ * clock charges the task when it is switched out, and at every tick while it
+ * runs.  Once it has used up its budget eAction is applied until the period
+ * ends, when the budget is replenished, whatever of it was used:
+ *
+ * eTaskBudgetNotify only counts the overrun.  eTaskBudgetDemote runs the task
+ * at configTASK_BUDGET_BACKGROUND_PRIORITY; a task holding a mutex keeps any
+ * priority it inherited until it gives the mutex back.  eTaskBudgetSuspend
+ * moves the task to the Suspended state, and vTaskResume() can end that early.
+ * Each of them calls vApplicationTaskBudgetHook() with
+ * configUSE_TASK_BUDGET_HOOK.
+ *
+ * An overrun is noticed up to a tick late.  uxTaskPriorityGet() returns the
+ * background priority while the task is demoted, and vTaskPrioritySet() then
+ * sets the priority it gets back.
+ *
+ * @param xTask Handle of the task, or NULL for the calling task.  Not the
+ * idle task.
+ *
+ * @param ulBudget The run time allowed per period, in run time stats counts,
+ * or 0 to remove the budget and give back what an overrun took away.
+ *
+ * @param xPeriod The period, in ticks; at least 1.  The first one starts now.
+ *
+ * @param eAction What to do with the task when it overruns.
+ *
+ * Example usage:
+   <pre>
+   // A task that may spin is allowed 10 ms of CPU in every 50 ms, and runs
+   // at the idle priority once that is used up.  The run time stats clock
+   // counts CPU cycles here.
+   vTaskSetBudget( xSpinner, ( SystemCoreClock / 1000 ) * 10, pdMS_TO_TICKS( 50 ), eTaskBudgetDemote );
+   </pre>
+ *
+ * \defgroup vTaskSetBudget vTaskSetBudget
+ * \ingroup TaskCtrl
+ */
+#if( configUSE_TASK_BUDGETS == 1 )
+	void vTaskSetBudget( TaskHandle_t xTask, configRUN_TIME_COUNTER_TYPE ulBudget, TickType_t xPeriod, eTaskBudgetAction eAction ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>void vTaskGetBudget( TaskHandle_t xTask, TaskBudgetStatus_t *pxStatus );</pre>
+ *
+ * configUSE_TASK_BUDGETS must be set to 1 for this function to be available.
+ *
+ * @param xTask Handle of the task, or NULL for the calling task.
+ *
+ * @param pxStatus Where the budget, its use in the current period and the
+ * overrun count of the task are copied.
+ *
+ * \defgroup vTaskGetBudget vTaskGetBudget
+ * \ingroup TaskCtrl
+ */
+#if( configUSE_TASK_BUDGETS == 1 )
+	void vTaskGetBudget( TaskHandle_t xTask, TaskBudgetStatus_t *pxStatus ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>void vTaskGetJobStats( TaskHandle_t xTask, TaskJobStats_t *pxStats );</pre>
+ *
+ * configUSE_JOB_STATS must be set to 1 for this function to be available.
+ *
+ * A job of a task is released when the task leaves the Blocked or Suspended
+ * state, whatever it waited for: a delay, a queue, a notification.  It ends
+ * when the task is next switched out after blocking or suspending itself, so
+ * a task that blocks once per cycle, as on vTaskDelayUntil(), has one job per
+ * cycle.  A task that also blocks within a cycle, on a mutex for example,
+ * splits it into several shorter jobs, and one that never blocks has none.
+ *
+ * The time between releases gives the period of the task, or the shortest
+ * time between two events for a sporadic one; the run time of the jobs gives
+ * its execution time, preemptions left out.  Together they are what rate and
+ * deadline monotonic priority assignment needs.
+ *
+ * @param xTask Handle of the task, or NULL for the calling task.
+ *
+ * @param pxStats Where the job statistics of the task are copied.
+ *
+ * \defgroup vTaskGetJobStats vTaskGetJobStats
+ * \ingroup TaskCtrl
+ */
+#if( configUSE_JOB_STATS == 1 )
+	void vTaskGetJobStats( TaskHandle_t xTask, TaskJobStats_t *pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * <pre>void vTaskResetJobStats( TaskHandle_t xTask );</pre>
+ *
+ * configUSE_JOB_STATS must be set to 1 for this function to be available.
+ *
+ * Clears the job statistics of a task, to measure from its next release.  A
+ * job in progress is not counted.
+ *
+ * @param xTask Handle of the task, or NULL for the calling task.
+ *
+ * \defgroup vTaskResetJobStats vTaskResetJobStats
+ * \ingroup TaskCtrl
+ */
+#if( configUSE_JOB_STATS == 1 )
+	void vTaskResetJobStats( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * <pre>void vTaskSuspend( TaskHandle_t xTaskToSuspend );</pre>
@@ -1117,6 +1471,49 @@ void vTaskSuspend( TaskHandle_t xTaskToSuspend ) PRIVILEGED_FUNCTION;
  */
 void vTaskResume( TaskHandle_t xTaskToResume ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>void vTaskSwitchGroups( const TaskHandle_t * const pxTasksToSuspend, UBaseType_t uxSuspendCount, const TaskHandle_t * const pxTasksToResume, UBaseType_t uxResumeCount );</pre>
+ *
+ * INCLUDE_vTaskSuspend and INCLUDE_vTaskSwitchGroups must be defined as 1 for
+ * this function to be available.
+ *
+ * Suspends one group of tasks and resumes another as one operation, e.g. to
+ * switch between operating modes.  The tasks change state with the scheduler
+ * suspended, so no other task runs in between and sees the system half in
+ * each mode, and there is a single reschedule at the end.  Interrupts are
+ * only masked while each task changes state.
+ *
+ * A NULL entry in pxTasksToSuspend is the calling task, which stops running
+ * once the switch is done.  A task in both groups ends up resumed.  Tasks in
+ * the resume group that are not suspended are left alone.
+ *
+ * vTaskSuspendGroup() and vTaskResumeGroup() take a single group.
+ *
+ * @param pxTasksToSuspend Handles of the tasks to suspend.
+ *
+ * @param uxSuspendCount Number of handles in pxTasksToSuspend.
+ *
+ * @param pxTasksToResume Handles of the tasks to resume.
+ *
+ * @param uxResumeCount Number of handles in pxTasksToResume.
+ *
+ * Example usage:
+   <pre>
+ TaskHandle_t xNormalTasks[ 3 ], xSafeTasks[ 2 ];
+
+ void vEnterSafeMode( void )
+ {
+	 vTaskSwitchGroups( xNormalTasks, 3, xSafeTasks, 2 );
+ }
+   </pre>
+ * \defgroup vTaskSwitchGroups vTaskSwitchGroups
+ * \ingroup TaskCtrl
+ */
+void vTaskSwitchGroups( const TaskHandle_t * const pxTasksToSuspend, UBaseType_t uxSuspendCount, const TaskHandle_t * const pxTasksToResume, UBaseType_t uxResumeCount ) PRIVILEGED_FUNCTION;
+#define vTaskSuspendGroup( pxTasks, uxCount ) vTaskSwitchGroups( ( pxTasks ), ( uxCount ), NULL, 0 )
+#define vTaskResumeGroup( pxTasks, uxCount ) vTaskSwitchGroups( NULL, 0, ( pxTasks ), ( uxCount ) )
+
 /**
  * task. h
  * <pre>void xTaskResumeFromISR( TaskHandle_t xTaskToResume );</pre>
@@ -1403,7 +1800,7 @@ char *pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION; /*lint !e9
  * <PRE>TaskHandle_t xTaskGetHandle( const char *pcNameToQuery );</PRE>
  *
  * NOTE:  This function takes a relatively long time to complete and should be
- * used sparingly.
+ * used sparingly, unless configUSE_TASK_NAME_INDEX is set to 1.
  *
  * @return The handle of the task that has the human readable name pcNameToQuery.
  * NULL is returned if no matching name is found.  INCLUDE_xTaskGetHandle
@@ -1414,6 +1811,51 @@ char *pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION; /*lint !e9
  */
 TaskHandle_t xTaskGetHandle( const char *pcNameToQuery ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
+/*
+ * The hash of the task name index: FNV-1a over the first
+ * configMAX_TASK_NAME_LEN - 1 characters, those the kernel keeps.  The macro
+ * takes a string literal, and the optimiser folds it to a constant.
+ */
+#define tskNAME_HASH_STEP( ulHash, pcName, x ) \
+	( ( ( ulHash ) ^ ( ( ( ( x ) < ( sizeof( pcName ) - 1U ) ) && ( ( x ) < ( configMAX_TASK_NAME_LEN - 1U ) ) ) ? \
+		( uint32_t ) ( uint8_t ) ( pcName )[ ( ( x ) < sizeof( pcName ) ) ? ( x ) : 0U ] : 0UL ) ) * \
+	  ( ( ( ( x ) < ( sizeof( pcName ) - 1U ) ) && ( ( x ) < ( configMAX_TASK_NAME_LEN - 1U ) ) ) ? 16777619UL : 1UL ) )
+
+#define tskNAME_HASH_4( ulHash, pcName, x ) \
+	tskNAME_HASH_STEP( tskNAME_HASH_STEP( tskNAME_HASH_STEP( tskNAME_HASH_STEP( ulHash, pcName, ( x ) ), \
+		pcName, ( x ) + 1U ), pcName, ( x ) + 2U ), pcName, ( x ) + 3U )
+
+#define tskNAME_HASH_16( ulHash, pcName, x ) \
+	tskNAME_HASH_4( tskNAME_HASH_4( tskNAME_HASH_4( tskNAME_HASH_4( ulHash, pcName, ( x ) ), \
+		pcName, ( x ) + 4U ), pcName, ( x ) + 8U ), pcName, ( x ) + 12U )
+
+#define taskNAME_HASH( pcName ) \
+	( ( uint32_t ) tskNAME_HASH_16( tskNAME_HASH_16( 2166136261UL, pcName, 0U ), pcName, 16U ) )
+
+/**
+ * task. h
+ * <PRE>TaskHandle_t xTaskGetHandleByHash( uint32_t ulNameHash );</PRE>
+ *
+ * configUSE_TASK_NAME_INDEX must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Looks a task up in the task name index by the hash of its name, without
+ * hashing or comparing the name.  Example usage:
+   <pre>
+   xHandle = xTaskGetHandleByHash( taskNAME_HASH( "Red" ) );
+   </pre>
+ *
+ * @param ulNameHash taskNAME_HASH() of the name.
+ *
+ * @return The handle of the first task found with that hash, or NULL.  Two
+ * names may share a hash: use xTaskGetHandle() when names are not known to
+ * hash apart.  Tasks created while the index was full are not found.
+ *
+ * \defgroup xTaskGetHandleByHash xTaskGetHandleByHash
+ * \ingroup TaskUtils
+ */
+TaskHandle_t xTaskGetHandleByHash( uint32_t ulNameHash ) PRIVILEGED_FUNCTION;
+
 /**
  * task.h
  * <PRE>UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask );</PRE>
@@ -1441,6 +1883,25 @@ TaskHandle_t xTaskGetHandle( const char *pcNameToQuery ) PRIVILEGED_FUNCTION; /*
  */
 UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
+/**
+ * task.h
+ * <PRE>UBaseType_t uxTaskGetStackDepth( TaskHandle_t xTask );</PRE>
+ *
+ * INCLUDE_uxTaskGetStackHighWaterMark and, on ports where the stack grows
+ * down, configRECORD_STACK_HIGH_ADDRESS must be set to 1 in FreeRTOSConfig.h
+ * for this function to be available.
+ *
+ * Returns the usable depth of the stack associated with xTask, in words.
+ * Together with uxTaskGetStackHighWaterMark() it gives the most stack the
+ * task has used.
+ *
+ * @param xTask Handle of the task associated with the stack.  Set xTask to
+ * NULL for the stack of the calling task.
+ *
+ * @return The number of words of the stack.
+ */
+UBaseType_t uxTaskGetStackDepth( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
 /**
  * task.h
  * <PRE>configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask );</PRE>
@@ -1584,7 +2045,7 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 	{
 	TaskStatus_t *pxTaskStatusArray;
 	volatile UBaseType_t uxArraySize, x;
-	uint32_t ulTotalRunTime, ulStatsAsPercentage;
+	configRUN_TIME_COUNTER_TYPE ulTotalRunTime, ulStatsAsPercentage;
 
 		// Make sure the write buffer does not contain a string.
 		*pcWriteBuffer = 0x00;
@@ -1638,7 +2099,62 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 	}
 	</pre>
  */
-UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
+UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>void vTaskSnapshotStart( TaskSnapshot_t * const pxSnapshot );
+ * UBaseType_t uxTaskSnapshotNext( TaskSnapshot_t * const pxSnapshot, TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, const BaseType_t xGetFreeStackSpace );
+ * BaseType_t xTaskSnapshotChanged( const TaskSnapshot_t * const pxSnapshot );</PRE>
+ *
+ * configUSE_TASK_SNAPSHOTS must be defined as 1 for these functions to be
+ * available.
+ *
+ * uxTaskGetSystemState() suspends the scheduler while it walks every task
+ * list, for a time that grows with the number of tasks.  A snapshot collects
+ * the same TaskStatus_t structures uxArraySize tasks per call instead, each
+ * call suspending the scheduler only for its own tasks, so the tasks of the
+ * application run between two calls.
+ *
+ * vTaskSnapshotStart() starts a walk, in creation order.  Each call of
+ * uxTaskSnapshotNext() then fills up to uxArraySize structures, as
+ * vTaskGetInfo() does, and returns how many it filled: 0 once every task has
+ * been copied.  xGetFreeStackSpace is passed on to vTaskGetInfo().
+ *
+ * The tasks are copied at different times, so the result is not a snapshot
+ * of a single instant.  If a task is created or deleted during the walk,
+ * uxTaskSnapshotNext() returns 0 from then on, and xTaskSnapshotChanged()
+ * returns pdTRUE: start again for a complete list.  The structures already
+ * filled stay valid.
+ *
+ * Example usage:
+   <pre>
+	TaskSnapshot_t xSnapshot;
+	TaskStatus_t xStatus[ 4 ];
+	UBaseType_t x, uxCount;
+
+	do
+	{
+		vTaskSnapshotStart( &xSnapshot );
+
+		while( ( uxCount = uxTaskSnapshotNext( &xSnapshot, xStatus, 4, pdTRUE ) ) > 0 )
+		{
+			for( x = 0; x < uxCount; x++ )
+			{
+				vRecordTask( &( xStatus[ x ] ) );
+			}
+		}
+	} while( xTaskSnapshotChanged( &xSnapshot ) != pdFALSE );
+   </pre>
+ *
+ * \defgroup uxTaskSnapshotNext uxTaskSnapshotNext
+ * \ingroup TaskUtils
+ */
+#if( configUSE_TASK_SNAPSHOTS == 1 )
+	void vTaskSnapshotStart( TaskSnapshot_t * const pxSnapshot ) PRIVILEGED_FUNCTION;
+	UBaseType_t uxTaskSnapshotNext( TaskSnapshot_t * const pxSnapshot, TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, const BaseType_t xGetFreeStackSpace ) PRIVILEGED_FUNCTION;
+	BaseType_t xTaskSnapshotChanged( const TaskSnapshot_t * const pxSnapshot ) PRIVILEGED_FUNCTION;
+#endif
 
 /**
  * task. h
@@ -1769,7 +2285,150 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
 * \defgroup ulTaskGetIdleRunTimeCounter ulTaskGetIdleRunTimeCounter
 * \ingroup TaskUtils
 */
-uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
+configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
+
+/**
+* task. h
+* <PRE>uint32_t ulTaskGetSwitchCount( void );</PRE>
+*
+* configUSE_SWITCH_STATS must be defined as 1 for this function to be
+* available.
+*
+* Each task counts the context switches away from it, split into voluntary
+* and involuntary ones (see TaskStatus_t).  This returns the total of all
+* tasks, those deleted since included: the switches that changed the running
+* task.  Sampled twice, it gives the switch rate.
+*
+* @return The number of context switches since the scheduler started.  It
+* wraps at 2^32.
+*
+* \defgroup ulTaskGetSwitchCount ulTaskGetSwitchCount
+* \ingroup TaskUtils
+*/
+#if( configUSE_SWITCH_STATS == 1 )
+	uint32_t ulTaskGetSwitchCount( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+* task. h
+* <PRE>uint32_t ulTaskGracePeriodStart( void );</PRE>
+*
+* configUSE_QUIESCENT_STATES must be defined as 1 for this function to be
+* available.
+*
+* Starts a grace period, after a writer has replaced what a shared pointer
+* points to.  A task passes a quiescent point each time it leaves the Ready
+* state: it blocks, suspends or deletes itself.  Readers must not keep a
+* pointer they read across such a call.  Once every task has passed one, or
+* was blocked or suspended all along, none can still use the old version.
+*
+* @return The epoch to give xTaskGracePeriodElapsed().
+*
+* \defgroup ulTaskGracePeriodStart ulTaskGracePeriodStart
+* \ingroup TaskUtils
+*/
+#if( configUSE_QUIESCENT_STATES == 1 )
+	uint32_t ulTaskGracePeriodStart( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+* task. h
+* <PRE>BaseType_t xTaskGracePeriodElapsed( uint32_t ulEpoch );</PRE>
+*
+* configUSE_QUIESCENT_STATES must be defined as 1 for this function to be
+* available.
+*
+* Walks the ready lists with the scheduler suspended.  The calling task and
+* the idle task are not waited for.  A task that never leaves the Ready state,
+* such as one that spins at the idle priority, holds the grace period open.
+*
+* @param ulEpoch As returned by ulTaskGracePeriodStart().
+*
+* @return pdTRUE if every other task has passed a quiescent point since
+* ulEpoch started, pdFALSE if one has not yet.
+*
+* \defgroup xTaskGracePeriodElapsed xTaskGracePeriodElapsed
+* \ingroup TaskUtils
+*/
+#if( configUSE_QUIESCENT_STATES == 1 )
+	BaseType_t xTaskGracePeriodElapsed( uint32_t ulEpoch ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+* task. h
+* <PRE>void vTaskGetTickStats( TickStats_t *pxTickStats );</PRE>
+*
+* configUSE_TICK_STATS must be defined as 1 for this function to be available.
+*
+* Copies the statistics of the tick interrupts measured since the scheduler
+* started, or since vTaskResetTickStats() was last called.  The interrupt runs
+* configTICK_RATE_HZ times a second, so ullTotalCycles over the cycles elapsed
+* in the same time gives the share of the CPU the tick takes, and the
+* histograms show how often it takes much more.  A tick is timed from its
+* first instruction to its last, so the exception entry and exit are not
+* included.  The tick hook is, and so is the time of the interrupts that
+* preempted it.
+*
+* @param pxTickStats Where the statistics are copied.
+*
+* \defgroup vTaskGetTickStats vTaskGetTickStats
+* \ingroup TaskUtils
+*/
+#if( configUSE_TICK_STATS == 1 )
+	void vTaskGetTickStats( TickStats_t *pxTickStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+* task. h
+* <PRE>void vTaskResetTickStats( void );</PRE>
+*
+* configUSE_TICK_STATS must be defined as 1 for this function to be available.
+*
+* Clears the tick statistics, e.g. before the load to be measured starts.
+*
+* \defgroup vTaskResetTickStats vTaskResetTickStats
+* \ingroup TaskUtils
+*/
+#if( configUSE_TICK_STATS == 1 )
+	void vTaskResetTickStats( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+* task. h
+* <PRE>void vTaskGetIdleSleepStats( IdleSleepStats_t *pxIdleSleepStats );</PRE>
+*
+* configUSE_IDLE_SLEEP must be defined as 1 for this function to be available.
+*
+* Copies the statistics of the idle task's sleeps since the scheduler started,
+* or since vTaskResetIdleSleepStats() was last called.  A sleep ended by the
+* tick interrupt is timed from the tick timer expiring to the first instruction
+* after the sleep, so ullTotalWakeCycles over ulTickWakes is the average
+* wake-up latency, including what the clocks gated in sleep add to it.  Sleeps
+* ended by other interrupts are only counted.
+*
+* @param pxIdleSleepStats Where the statistics are copied.
+*
+* \defgroup vTaskGetIdleSleepStats vTaskGetIdleSleepStats
+* \ingroup TaskUtils
+*/
+#if( configUSE_IDLE_SLEEP == 1 )
+	void vTaskGetIdleSleepStats( IdleSleepStats_t *pxIdleSleepStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+* task. h
+* <PRE>void vTaskResetIdleSleepStats( void );</PRE>
+*
+* configUSE_IDLE_SLEEP must be defined as 1 for this function to be available.
+*
+* Clears the idle sleep statistics.
+*
+* \defgroup vTaskResetIdleSleepStats vTaskResetIdleSleepStats
+* \ingroup TaskUtils
+*/
+#if( configUSE_IDLE_SLEEP == 1 )
+	void vTaskResetIdleSleepStats( void ) PRIVILEGED_FUNCTION;
+#endif
 
 /**
  * task. h
@@ -1781,6 +2440,13 @@ uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
  * When configUSE_TASK_NOTIFICATIONS is set to one each task has its own private
  * "notification value", which is a 32-bit unsigned integer (uint32_t).
  *
+ * Each task has an array of configTASK_NOTIFICATION_ARRAY_ENTRIES
+ * notifications, each with its own state and value.  The functions ending in
+ * Indexed, such as xTaskNotifyIndexed(), take the array index to act on as an
+ * extra parameter, uxIndexToNotify.  The functions without an index act on
+ * tskDEFAULT_INDEX_TO_NOTIFY (index 0), so a driver can keep its own index
+ * without disturbing index 0, which application code and stream buffers use.
+ *
  * Events can be sent to a task using an intermediary object.  Examples of such
  * objects are queues, semaphores, mutexes and event groups.  Task notifications
  * are a method of sending an event directly to a task without the need for such
@@ -1840,6 +2506,12 @@ uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
  * updated.  ulValue is not used and xTaskNotify() always returns pdPASS in
  * this case.
  *
+ * eIncrementUpToValue -
+ * If the task's notification value is below ulValue then it is incremented
+ * and xTaskNotify() returns pdPASS.  Otherwise no action is performed and
+ * pdFAIL is returned.  This is how light semaphores (light_semphr.h) cap their
+ * count.
+ *
  *  pulPreviousNotificationValue -
  *  Can be used to pass out the subject task's notification value before any
  *  bits are modified by the notify function.
@@ -1850,9 +2522,11 @@ uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
-#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL )
-#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
+#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+#define xTaskNotifyAndQueryIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
 
 /**
  * task. h
@@ -1926,6 +2600,12 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * updated.  ulValue is not used and xTaskNotify() always returns pdPASS in
  * this case.
  *
+ * eIncrementUpToValue -
+ * If the task's notification value is below ulValue then it is incremented
+ * and xTaskNotify() returns pdPASS.  Otherwise no action is performed and
+ * pdFAIL is returned.  This is how light semaphores (light_semphr.h) cap their
+ * count.
+ *
  * @param pxHigherPriorityTaskWoken  xTaskNotifyFromISR() will set
  * *pxHigherPriorityTaskWoken to pdTRUE if sending the notification caused the
  * task to which the notification was sent to leave the Blocked state, and the
@@ -1941,9 +2621,39 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
-#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
-#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * task. h
+ * <PRE>BaseType_t xTaskGenericNotifyGroup( TaskHandle_t const *pxTasksToNotify, UBaseType_t uxTaskCount, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
+ * <PRE>BaseType_t xTaskGenericNotifyGroupFromISR( TaskHandle_t const *pxTasksToNotify, UBaseType_t uxTaskCount, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * configUSE_NOTIFY_GROUPS must be set to 1 for these functions to be
+ * available.  They are used by notification groups (see notify_group.h) and
+ * are not intended to be called directly.
+ *
+ * Sends the same notification as xTaskNotifyIndexed() to each of uxTaskCount
+ * tasks, in one critical section.  The tasks waiting for it are moved to the
+ * ready list as they are notified, and whether one of them should preempt the
+ * calling task is only decided once all have been: there is at most one
+ * yield, so the notified tasks then run in priority order instead of each one
+ * preempting the notifier in turn.
+ *
+ * @return pdFAIL if the value of one task or more could not be updated, as
+ * with eSetValueWithoutOverwrite or eIncrementUpToValue, otherwise pdPASS.
+ * The other tasks are notified all the same.
+ *
+ * \defgroup xTaskGenericNotifyGroup xTaskGenericNotifyGroup
+ * \ingroup TaskNotifications
+ */
+#if( configUSE_NOTIFY_GROUPS == 1 )
+	BaseType_t xTaskGenericNotifyGroup( TaskHandle_t const *pxTasksToNotify, UBaseType_t uxTaskCount, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction ) PRIVILEGED_FUNCTION;
+	BaseType_t xTaskGenericNotifyGroupFromISR( TaskHandle_t const *pxTasksToNotify, UBaseType_t uxTaskCount, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
 
 /**
  * task. h
@@ -2018,7 +2728,9 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulVal
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyWait( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( tskDEFAULT_INDEX_TO_NOTIFY, ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
+#define xTaskNotifyWaitIndexed( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( ( uxIndexToWaitOn ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
 
 /**
  * task. h
@@ -2064,7 +2776,8 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyGive xTaskNotifyGive
  * \ingroup TaskNotifications
  */
-#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGiveIndexed( xTaskToNotify, uxIndexToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( 0 ), eIncrement, NULL )
 
 /**
  * task. h
@@ -2100,6 +2813,11 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * using the ulTaskNotificationTake() API function rather than the
  * xTaskNotifyWait() API function.
  *
+ * With configUSE_NOTIFY_GIVE_FAST_PATH set to 1, the count is incremented
+ * with exclusive accesses and interrupts are only masked when the task is
+ * blocked waiting for the notification, to unblock it.  Giving to a task that
+ * is running, ready or blocked on something else then costs a few cycles.
+ *
  * See http://www.FreeRTOS.org/RTOS-task-notifications.html for more details.
  *
  * @param xTaskToNotify The handle of the task being notified.  The handle to a
@@ -2119,7 +2837,9 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define vTaskNotifyGiveFromISR( xTaskToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( pxHigherPriorityTaskWoken ) )
+#define vTaskNotifyGiveIndexedFromISR( xTaskToNotify, uxIndexToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
@@ -2188,7 +2908,9 @@ void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPri
  * \defgroup ulTaskNotifyTake ulTaskNotifyTake
  * \ingroup TaskNotifications
  */
-uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define ulTaskNotifyTake( xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( xClearCountOnExit ), ( xTicksToWait ) )
+#define ulTaskNotifyTakeIndexed( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( uxIndexToWaitOn ), ( xClearCountOnExit ), ( xTicksToWait ) )
 
 /**
  * task. h
@@ -2204,7 +2926,9 @@ uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait
  * \defgroup xTaskNotifyStateClear xTaskNotifyStateClear
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
+BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyStateClear( xTask ) xTaskGenericNotifyStateClear( ( xTask ), ( tskDEFAULT_INDEX_TO_NOTIFY ) )
+#define xTaskNotifyStateClearIndexed( xTask, uxIndexToClear ) xTaskGenericNotifyStateClear( ( xTask ), ( uxIndexToClear ) )
 
 /**
 * task. h
@@ -2222,7 +2946,9 @@ BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
 * \defgroup ulTaskNotifyValueClear ulTaskNotifyValueClear
 * \ingroup TaskNotifications
 */
-uint32_t ulTaskNotifyValueClear( TaskHandle_t xTask, uint32_t ulBitsToClear ) PRIVILEGED_FUNCTION;
+uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear, uint32_t ulBitsToClear ) PRIVILEGED_FUNCTION;
+#define ulTaskNotifyValueClear( xTask, ulBitsToClear ) ulTaskGenericNotifyValueClear( ( xTask ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulBitsToClear ) )
+#define ulTaskNotifyValueClearIndexed( xTask, uxIndexToClear, ulBitsToClear ) ulTaskGenericNotifyValueClear( ( xTask ), ( uxIndexToClear ), ( ulBitsToClear ) )
 
 /**
  * task.h
@@ -2416,6 +3142,19 @@ void vTaskPlaceOnEventListRestricted( List_t * const pxEventList, TickType_t xTi
 BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Interrupt safe version of vTaskRemoveFromUnorderedEventList(), for use by
+ * xEventGroupSetBitsFromISR() when configUSE_EVENT_GROUPS_DIRECT_FROM_ISR is 1.
+ * Must be called from a critical section.
+ *
+ * @return pdTRUE if the task being removed has a higher priority than the task
+ * that was running when the interrupt occurred, otherwise pdFALSE.
+ */
+BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
@@ -2426,6 +3165,54 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const Tick
  */
 portDONT_DISCARD void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE taskYIELD() MACRO.
+ *
+ * Marks the next context switch as voluntary, then yields.
+ */
+#if( configUSE_SWITCH_STATS == 1 )
+	void vTaskYieldVoluntary( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE PORTABLE LAYER.
+ *
+ * Called by the tick interrupt after xTaskIncrementTick(), with interrupts
+ * masked, to record how late the tick was taken and how long it ran, in tick
+ * timer counts.
+ */
+#if( configUSE_TICK_STATS == 1 )
+	void vTaskRecordTickStats( uint32_t ulLatencyCycles, uint32_t ulCycles ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE PORTABLE LAYER.
+ *
+ * Called by portIDLE_SLEEP() after each sleep, with interrupts masked.
+ * xTickWake is pdTRUE if the tick interrupt ended it, ulWakeCycles then the
+ * tick timer counts from its expiry to the wake-up.
+ */
+#if( configUSE_IDLE_SLEEP == 1 )
+	void vTaskRecordIdleSleep( BaseType_t xTickWake, uint32_t ulWakeCycles ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE PORTABLE LAYER.
+ *
+ * Called by the tick interrupt in place of xTaskIncrementTick() when each
+ * interrupt stands for xTicks ticks.  Ticks that wake no task are stepped
+ * over, as after tickless idle, so the tick hook and the time slice only see
+ * the interrupts and the ticks that wake a task.  Returns pdTRUE if a context
+ * switch is required.
+ */
+#if( configUSE_DYNAMIC_TICK_RATE == 1 )
+	BaseType_t xTaskIncrementTickBy( TickType_t xTicks ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
  * THE EVENT BITS MODULE.
@@ -2505,6 +3292,18 @@ tasks may have to be removed from the blocked state as the tick count is
 moved. */
 BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp ) PRIVILEGED_FUNCTION;
 
+/*
+ * Only available when INCLUDE_xTaskGetTicksToNextWake is set to 1.
+ * Returns the number of ticks until the first task of priority uxMinPriority
+ * or above that is Blocked with a timeout is due to wake, 0 if one is overdue,
+ * or portMAX_DELAY if there is none.  Tasks blocked without a timeout are not
+ * counted, as nothing tells when they will run.  Lets background work that
+ * stalls the CPU, such as a flash erase, wait for a gap in which no time
+ * critical task is due.  The delayed lists are walked with the scheduler
+ * suspended, so the cost grows with the number of delayed tasks.
+ */
+TickType_t xTaskGetTicksToNextWake( UBaseType_t uxMinPriority ) PRIVILEGED_FUNCTION;
+
 /*
  * Only available when configUSE_TICKLESS_IDLE is set to 1.
  * Provided for use within portSUPPRESS_TICKS_AND_SLEEP() to allow the port
@@ -2527,6 +3326,28 @@ eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Raise the calling task, which has just taken a
+ * priority ceiling mutex, to uxCeilingPriority if it runs below it.  Called
+ * from a critical section.
+ */
+void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Take the mutex whose holder is pointed to by
+ * pxMutexHolder without a critical section.  Returns pdFALSE, without taking
+ * the mutex, if it is held and the kernel path has to be used.
+ */
+BaseType_t xTaskMutexFastTake( TaskHandle_t volatile * const pxMutexHolder ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Give the mutex whose holder is pointed to by
+ * pxMutexHolder without a critical section.  Returns pdFALSE, without giving
+ * the mutex, if a task in pxWaitingTasks has to be woken or a priority has to
+ * be disinherited.
+ */
+BaseType_t xTaskMutexFastGive( TaskHandle_t volatile * const pxMutexHolder, const List_t * const pxWaitingTasks ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critial
  * section.
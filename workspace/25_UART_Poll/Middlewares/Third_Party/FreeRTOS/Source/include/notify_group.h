@@ -0,0 +1,249 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A notification group is a set of tasks that are notified together: each
+ * task subscribes once, and xTaskNotifyGroup() then sends the same
+ * notification to every member.  It replaces one xTaskNotifyGive() per task,
+ * where each task woken may preempt the notifier before the next one is
+ * notified, and xEventGroupSetBits(), which walks the list of the waiting
+ * tasks with the scheduler suspended.
+ *
+ * - All the members are notified in one critical section.  The tasks waiting
+ *   for the notification are readied in the same pass, and the yield is only
+ *   decided at the end, so there is at most one context switch, to the
+ *   highest priority member woken, whatever the number of members.
+ *
+ * - The critical section is as long as the group is large: a notification
+ *   group suits a few to a few tens of tasks, not hundreds.
+ *
+ * - Members wait with ulTaskNotifyTakeIndexed() or xTaskNotifyWaitIndexed()
+ *   on one entry of their task notification array (see
+ *   configTASK_NOTIFICATION_ARRAY_ENTRIES), the same index for all the
+ *   members.  The index belongs to the group - the members must not use it
+ *   for anything else.  Index 0 (tskDEFAULT_INDEX_TO_NOTIFY) is also used by
+ *   the task notification functions that do not take an index, and by stream
+ *   buffers.
+ *
+ * - A task must unsubscribe before it is deleted.  The group only holds the
+ *   task handles.
+ *
+ * configUSE_NOTIFY_GROUPS must be set to 1 in FreeRTOSConfig.h for
+ * notification groups to be available.
+ */
+
+#ifndef NOTIFY_GROUP_H
+#define NOTIFY_GROUP_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include notify_group.h"
+#endif
+
+#include "task.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * The storage of a notification group, declared by the application and
+ * passed to xNotifyGroupCreateStatic().  Its members must not be accessed
+ * directly.
+ */
+typedef struct NotifyGroupDef_t
+{
+	TaskHandle_t *pxMembers;				/* uxMaxMembers handles. */
+	UBaseType_t uxMaxMembers;
+	volatile UBaseType_t uxMembers;
+	UBaseType_t uxIndex;
+} StaticNotifyGroup_t;
+
+/**
+ * Type by which notification groups are referenced.
+ */
+typedef StaticNotifyGroup_t * NotifyGroupHandle_t;
+
+/**
+ * notify_group.h
+ *
+<pre>
+NotifyGroupHandle_t xNotifyGroupCreateStatic( UBaseType_t uxIndex,
+                                              TaskHandle_t *pxMembers,
+                                              UBaseType_t uxMaxMembers,
+                                              StaticNotifyGroup_t *pxNotifyGroupBuffer );
+</pre>
+ *
+ * Creates an empty notification group in pxNotifyGroupBuffer.
+ *
+ * @param uxIndex The notification index the members are notified on.
+ *
+ * @param pxMembers An array of uxMaxMembers task handles, for the members.
+ *
+ * @param uxMaxMembers The number of tasks that can subscribe at a time.
+ *
+ * @param pxNotifyGroupBuffer The storage of the group.
+ *
+ * @return A handle to the group.
+ *
+ * Example usage:
+<pre>
+#define WORKERS 4
+
+static TaskHandle_t xMembers[ WORKERS ];
+static StaticNotifyGroup_t xGroupBuffer;
+NotifyGroupHandle_t xGroup;
+
+void vSetup( void )
+{
+	xGroup = xNotifyGroupCreateStatic( 1, xMembers, WORKERS, &xGroupBuffer );
+}
+
+void vWorker( void *pvParameters )
+{
+	( void ) xNotifyGroupSubscribe( xGroup, NULL );
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTakeIndexed( 1, pdTRUE, portMAX_DELAY );
+		vWork();
+	}
+}
+
+void vProducer( void )
+{
+	vPrepareWork();
+	( void ) xTaskNotifyGroup( xGroup, 0, eIncrement );
+}
+</pre>
+ * \defgroup xNotifyGroupCreateStatic xNotifyGroupCreateStatic
+ * \ingroup NotifyGroups
+ */
+NotifyGroupHandle_t xNotifyGroupCreateStatic( UBaseType_t uxIndex, TaskHandle_t *pxMembers, UBaseType_t uxMaxMembers, StaticNotifyGroup_t *pxNotifyGroupBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * notify_group.h
+ *
+<pre>
+BaseType_t xNotifyGroupSubscribe( NotifyGroupHandle_t xGroup, TaskHandle_t xTask );
+</pre>
+ *
+ * Adds a task to the group.  The notifications sent to the group before are
+ * not delivered to it.
+ *
+ * @param xTask Handle of the task, or NULL for the calling task.
+ *
+ * @return pdPASS if the task is a member, including if it already was,
+ * pdFAIL if the group is full.
+ *
+ * \defgroup xNotifyGroupSubscribe xNotifyGroupSubscribe
+ * \ingroup NotifyGroups
+ */
+BaseType_t xNotifyGroupSubscribe( NotifyGroupHandle_t xGroup, TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * notify_group.h
+ *
+<pre>
+BaseType_t xNotifyGroupUnsubscribe( NotifyGroupHandle_t xGroup, TaskHandle_t xTask );
+</pre>
+ *
+ * Removes a task from the group.  A notification it already received is
+ * left pending.
+ *
+ * @param xTask Handle of the task, or NULL for the calling task.
+ *
+ * @return pdPASS if the task was a member, otherwise pdFAIL.
+ *
+ * \defgroup xNotifyGroupUnsubscribe xNotifyGroupUnsubscribe
+ * \ingroup NotifyGroups
+ */
+BaseType_t xNotifyGroupUnsubscribe( NotifyGroupHandle_t xGroup, TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * notify_group.h
+ *
+<pre>
+BaseType_t xTaskNotifyGroup( NotifyGroupHandle_t xGroup, uint32_t ulValue, eNotifyAction eAction );
+</pre>
+ *
+ * Notifies every member of the group on the index of the group, as
+ * xTaskNotifyIndexed() would each one, then yields once if a member woken has
+ * a priority above the calling task.
+ *
+ * @param ulValue The value used by eAction.
+ *
+ * @param eAction The update of the notification value of each member, as
+ * with xTaskNotifyIndexed(): eIncrement gives each member a notification to
+ * take with ulTaskNotifyTakeIndexed(), eSetBits sets bits to wait for with
+ * xTaskNotifyWaitIndexed().
+ *
+ * @return pdFAIL if the value of one member or more could not be updated,
+ * with eSetValueWithoutOverwrite or eIncrementUpToValue, otherwise pdPASS.
+ * The other members are notified all the same.
+ *
+ * \defgroup xTaskNotifyGroup xTaskNotifyGroup
+ * \ingroup NotifyGroups
+ */
+BaseType_t xTaskNotifyGroup( NotifyGroupHandle_t xGroup, uint32_t ulValue, eNotifyAction eAction ) PRIVILEGED_FUNCTION;
+
+/**
+ * notify_group.h
+ *
+<pre>
+BaseType_t xTaskNotifyGroupFromISR( NotifyGroupHandle_t xGroup, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xTaskNotifyGroup() that can be called from an interrupt.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a member woken has a
+ * priority above the interrupted task, in which case a context switch should
+ * be requested before the interrupt exits, once for the whole group.
+ *
+ * \defgroup xTaskNotifyGroupFromISR xTaskNotifyGroupFromISR
+ * \ingroup NotifyGroups
+ */
+BaseType_t xTaskNotifyGroupFromISR( NotifyGroupHandle_t xGroup, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * notify_group.h
+ *
+<pre>
+UBaseType_t uxNotifyGroupGetMemberCount( NotifyGroupHandle_t xGroup );
+</pre>
+ *
+ * @return The number of tasks subscribed to the group.
+ *
+ * \defgroup uxNotifyGroupGetMemberCount uxNotifyGroupGetMemberCount
+ * \ingroup NotifyGroups
+ */
+UBaseType_t uxNotifyGroupGetMemberCount( NotifyGroupHandle_t xGroup ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif	/* !defined( NOTIFY_GROUP_H ) */
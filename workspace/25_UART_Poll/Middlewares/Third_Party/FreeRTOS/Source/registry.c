@@ -0,0 +1,295 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "registry.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+to include the object registry. */
+#if( configUSE_OBJECT_REGISTRY == 1 )
+
+#if( configQUEUE_REGISTRY_SIZE < 1 )
+	#error configQUEUE_REGISTRY_SIZE must be greater than 0 to use the object registry
+#endif
+
+/* The bucket of a name is the low bits of its hash, and is held in a uint8_t. */
+#if( ( configOBJECT_REGISTRY_BUCKETS < 1 ) || ( configOBJECT_REGISTRY_BUCKETS > 256 ) || ( ( configOBJECT_REGISTRY_BUCKETS & ( configOBJECT_REGISTRY_BUCKETS - 1 ) ) != 0 ) )
+	#error configOBJECT_REGISTRY_BUCKETS must be a power of two, from 1 to 256
+#endif
+
+/*
+ * Returns the bucket of a name, from its 32-bit FNV-1a hash.
+ */
+static uint8_t prvNameBucket( const char *pcName ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/*
+ * Unlinks a registered item.  Called with the scheduler suspended.
+ */
+static void prvUnlinkItem( RegistryItem_t * const pxItem ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/* The head of the item list of each bucket, NULL when empty. */
+PRIVILEGED_DATA static RegistryItem_t *pxRegistryBuckets[ configOBJECT_REGISTRY_BUCKETS ] = { NULL };
+
+PRIVILEGED_DATA static UBaseType_t uxRegisteredObjects = ( UBaseType_t ) 0U;
+
+/*-----------------------------------------------------------*/
+
+void vRegistryInitialiseItem( RegistryItem_t * const pxItem, void * const pvObject, const uint8_t ucType )
+{
+	/* Sanity check that the size of the structure used to declare a variable
+	of type StaticRegistryItem_t equals the size of the real registry item. */
+	configASSERT( sizeof( StaticRegistryItem_t ) == sizeof( RegistryItem_t ) );
+	configASSERT( ucType != registryTYPE_ANY );
+
+	pxItem->pcName = NULL;
+	pxItem->pvObject = pvObject;
+	pxItem->pxNext = NULL;
+	pxItem->ppxPrevious = NULL;
+	pxItem->ucType = ucType;
+	pxItem->ucBucket = ( uint8_t ) 0U;
+}
+/*-----------------------------------------------------------*/
+
+void vRegistryAdd( RegistryItem_t * const pxItem, const char *pcName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+{
+RegistryItem_t **ppxBucket;
+
+	configASSERT( pxItem );
+
+	vTaskSuspendAll();
+	{
+		if( pxItem->ppxPrevious != NULL )
+		{
+			/* Renamed, so it may move to another bucket. */
+			prvUnlinkItem( pxItem );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxItem->pcName = pcName;
+
+		/* As with the queue registry array, a NULL name leaves the object
+		unregistered. */
+		if( pcName != NULL )
+		{
+			pxItem->ucBucket = prvNameBucket( pcName );
+			ppxBucket = &( pxRegistryBuckets[ pxItem->ucBucket ] );
+
+			/* Push to the front of the bucket. */
+			pxItem->pxNext = *ppxBucket;
+			if( pxItem->pxNext != NULL )
+			{
+				pxItem->pxNext->ppxPrevious = &( pxItem->pxNext );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxItem->ppxPrevious = ppxBucket;
+			*ppxBucket = pxItem;
+			uxRegisteredObjects++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vRegistryRemove( RegistryItem_t * const pxItem )
+{
+	configASSERT( pxItem );
+
+	vTaskSuspendAll();
+	{
+		if( pxItem->ppxPrevious != NULL )
+		{
+			prvUnlinkItem( pxItem );
+			pxItem->pcName = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void *pvRegistryFind( const char *pcName, const uint8_t ucType ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+{
+const RegistryItem_t *pxItem;
+void *pvReturn = NULL;
+
+	configASSERT( pcName );
+
+	vTaskSuspendAll();
+	{
+		for( pxItem = pxRegistryBuckets[ prvNameBucket( pcName ) ]; pxItem != NULL; pxItem = pxItem->pxNext )
+		{
+			if( ( ( ucType == registryTYPE_ANY ) || ( pxItem->ucType == ucType ) ) && ( strcmp( pxItem->pcName, pcName ) == 0 ) )
+			{
+				pvReturn = pxItem->pvObject;
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+RegistryItem_t *pxRegistryGetNext( const RegistryItem_t * const pxItem )
+{
+RegistryItem_t *pxNext;
+UBaseType_t uxBucket;
+
+	if( pxItem == NULL )
+	{
+		pxNext = NULL;
+		uxBucket = ( UBaseType_t ) 0U;
+	}
+	else
+	{
+		pxNext = pxItem->pxNext;
+		uxBucket = ( UBaseType_t ) pxItem->ucBucket + ( UBaseType_t ) 1U;
+	}
+
+	/* At the end of a bucket, move on to the next one that is not empty. */
+	while( ( pxNext == NULL ) && ( uxBucket < ( UBaseType_t ) configOBJECT_REGISTRY_BUCKETS ) )
+	{
+		pxNext = pxRegistryBuckets[ uxBucket ];
+		uxBucket++;
+	}
+
+	return pxNext;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxRegistryGetObjects( RegistryObject_t * const pxArray, const UBaseType_t uxArraySize, const uint8_t ucType )
+{
+const RegistryItem_t *pxItem;
+UBaseType_t uxCount = ( UBaseType_t ) 0U;
+
+	configASSERT( !( ( pxArray == NULL ) && ( uxArraySize != ( UBaseType_t ) 0U ) ) );
+
+	vTaskSuspendAll();
+	{
+		for( pxItem = pxRegistryGetNext( NULL ); ( pxItem != NULL ) && ( uxCount < uxArraySize ); pxItem = pxRegistryGetNext( pxItem ) )
+		{
+			if( ( ucType == registryTYPE_ANY ) || ( pxItem->ucType == ucType ) )
+			{
+				pxArray[ uxCount ].pcName = pxItem->pcName;
+				pxArray[ uxCount ].pvObject = pxItem->pvObject;
+				pxArray[ uxCount ].ucType = pxItem->ucType;
+				uxCount++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxRegistryGetCount( void )
+{
+	return uxRegisteredObjects;
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t prvNameBucket( const char *pcName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+{
+uint32_t ulHash = 2166136261UL;
+const uint8_t *pucNext = ( const uint8_t * ) pcName;
+
+	while( *pucNext != ( uint8_t ) 0U )
+	{
+		ulHash ^= ( uint32_t ) *pucNext;
+		ulHash *= 16777619UL;
+		pucNext++;
+	}
+
+	/* The high bits mix in every character, so fold them into the low ones. */
+	ulHash ^= ulHash >> 16;
+
+	return ( uint8_t ) ( ulHash & ( ( uint32_t ) configOBJECT_REGISTRY_BUCKETS - 1UL ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvUnlinkItem( RegistryItem_t * const pxItem )
+{
+	*( pxItem->ppxPrevious ) = pxItem->pxNext;
+
+	if( pxItem->pxNext != NULL )
+	{
+		pxItem->pxNext->ppxPrevious = pxItem->ppxPrevious;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxItem->pxNext = NULL;
+	pxItem->ppxPrevious = NULL;
+	uxRegisteredObjects--;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_OBJECT_REGISTRY == 1 */
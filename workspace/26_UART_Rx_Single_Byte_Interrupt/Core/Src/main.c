@@ -11,13 +11,16 @@
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
 #include "uart.h"
 #include "exti.h"
 #include "adc.h"
+#include "spsc_ring.h"
 
 /* Macros --------------------------------------------------------------------*/
 #define STACK_SIZE 128	/* 128 * 4 = 512 bytes */
+#define RX_RING_SIZE 64	/* Power of two. */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
@@ -29,7 +32,8 @@ void vStartUart2RxInterrupt(void);
 /* Data types ----------------------------------------------------------------*/
 
 /* Variables -----------------------------------------------------------------*/
-static QueueHandle_t xUart2RxBytesQueue = NULL;
+static SpscRing_t xUart2RxRing;
+static uint8_t ucUart2RxRingBuf[RX_RING_SIZE];
 static int iRxInProgress = 0;
 
 /**
@@ -54,7 +58,11 @@ int main(void)
 				tskIDLE_PRIORITY + 3,
 				NULL);
 
-	xUart2RxBytesQueue = xQueueCreate(10, sizeof(char));
+	/* Filled by USART2_IRQHandler, drained by vUartPrintTask. */
+	if (spsc_ring_init(&xUart2RxRing, ucUart2RxRingBuf, RX_RING_SIZE) != 0)
+	{
+		Error_Handler();
+	}
 
 	vTaskStartScheduler();
 
@@ -79,7 +87,12 @@ void vUartPrintTask(void *pvParameters)
 
 	while (1)
 	{
-		xQueueReceive(xUart2RxBytesQueue, &cRxByte, portMAX_DELAY);
+		spsc_ring_wait(&xUart2RxRing, portMAX_DELAY);
+
+		while (spsc_ring_get(&xUart2RxRing, (uint8_t *)&cRxByte) == 0)
+		{
+			/* Consume the byte. */
+		}
 	}
 }
 
@@ -125,7 +138,10 @@ void USART2_IRQHandler(void)
 
 		if (iRxInProgress)
 		{
-			xQueueSendFromISR(xUart2RxBytesQueue, &temp, &xHigherPriorityTaskWoken);
+			/* A plain store and a barrier; the task is only notified when it is
+			 * actually blocked. */
+			(void)spsc_ring_put(&xUart2RxRing, temp);
+			spsc_ring_wake_from_isr(&xUart2RxRing, &xHigherPriorityTaskWoken);
 		}
 	}
 
@@ -138,44 +154,9 @@ void USART2_IRQHandler(void)
  */
 void SystemClock_Config(void)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
-
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-	{
-		Error_Handler();
-	}
-
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ *
+ * @file	crc.h
+ * @brief	Interface of the hardware CRC service.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef CRC_H
+#define CRC_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define CRC_INITIAL_VALUE 0xFFFFFFFFU	/* State after a reset of the unit. */
+#define CRC_POLYNOMIAL 0x04C11DB7U		/* Fixed in hardware. */
+
+#ifndef CRC_USE_DMA
+#define CRC_USE_DMA 1					/* Feed long buffers with DMA2 Stream2. */
+#endif
+
+#ifndef CRC_DMA_MIN_BYTES
+#define CRC_DMA_MIN_BYTES 256U			/* Shorter updates are fed by the CPU. */
+#endif
+
+#ifndef CRC_CHUNK_WORDS
+#define CRC_CHUNK_WORDS 32U				/* Words fed per critical section. */
+#endif
+
+#ifndef CRC_IRQ_PRIORITY
+#define CRC_IRQ_PRIORITY 6U				/* At or below configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+#endif
+
+#ifndef CRC_NOTIFY_INDEX
+#define CRC_NOTIFY_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+/* One per computation in progress, usually on the caller's stack. It holds
+ * the whole state, so any number of tasks can compute CRCs at once. */
+typedef struct
+{
+	uint32_t ulCrc;						/* State after the last whole word. */
+	uint32_t ulPending;					/* Bytes of an incomplete word, LSB first. */
+	uint8_t ucPendingLen;				/* 0..3 */
+} CrcContext_t;
+
+typedef struct
+{
+	uint32_t ulCpuWords;				/* Words written to CRC->DR by the CPU. */
+	uint32_t ulDmaWords;				/* Words written to CRC->DR by the DMA. */
+	uint32_t ulSoftwareWords;			/* Words computed in software, unit busy. */
+	uint32_t ulRestores;				/* Unit reloaded with another context. */
+} CrcStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+void crc_init(void);
+void crc_begin(CrcContext_t *pxCtx);
+void crc_update(CrcContext_t *pxCtx, const void *pvData, uint32_t ulLen);
+uint32_t crc_final(CrcContext_t *pxCtx);
+uint32_t crc_compute(const void *pvData, uint32_t ulLen);
+void crc_get_stats(CrcStats_t *pxStats);
+
+#endif /* CRC_H */
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ *
+ * @file	hrtimer.h
+ * @brief	Interface of the high-resolution timer driver.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef HRTIMER_H
+#define HRTIMER_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef HRTIMER_MAX_TIMERS
+#define HRTIMER_MAX_TIMERS 16U		/* Timers that can be active at once. */
+#endif
+
+/* Deadlines are compared as signed differences of the 32-bit counter, so a
+ * timer can be at most this far in the future (about 35 minutes). */
+#define HRTIMER_MAX_DELAY_US 0x7FFFFFFFUL
+
+#define HRTIMER_INACTIVE 0xFFFFFFFFUL	/* ulHeapIndex of a stopped timer. */
+
+#ifndef HRTIMER_DELAY_SPIN_US
+#define HRTIMER_DELAY_SPIN_US 10U		/* Shorter delays busy-wait instead. */
+#endif
+
+#ifndef HRTIMER_DELAY_NOTIFY_INDEX
+#define HRTIMER_DELAY_NOTIFY_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct HrTimer HrTimer_t;
+
+/* Called from the TIM5 interrupt when the timer expires. */
+typedef void (*HrTimerCallback_t)(HrTimer_t *pxTimer, void *pvArg);
+
+struct HrTimer
+{
+	uint32_t ulDeadline;			/* TIM5 count at which the timer expires. */
+	uint32_t ulPeriodUs;			/* 0 for a one-shot timer. */
+	HrTimerCallback_t pxCallback;	/* NULL to notify xTask instead. */
+	void *pvArg;
+	TaskHandle_t xTask;
+	uint32_t ulNotifyBits;
+	uint32_t ulHeapIndex;			/* HRTIMER_INACTIVE when not started. */
+};
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t hrtimer_init(void);
+void hrtimer_setup(HrTimer_t *pxTimer, HrTimerCallback_t pxCallback, void *pvArg);
+void hrtimer_setup_notify(HrTimer_t *pxTimer, TaskHandle_t xTask, uint32_t ulNotifyBits);
+int32_t hrtimer_start(HrTimer_t *pxTimer, uint32_t ulDelayUs, uint32_t ulPeriodUs);
+int32_t hrtimer_start_at(HrTimer_t *pxTimer, uint32_t ulDeadline, uint32_t ulPeriodUs);
+void hrtimer_stop(HrTimer_t *pxTimer);
+uint32_t hrtimer_is_active(const HrTimer_t *pxTimer);
+uint32_t hrtimer_now(void);
+uint32_t hrtimer_get_overruns(void);
+int32_t hrtimer_delay_us(uint32_t ulDelayUs);
+
+#endif /* HRTIMER_H */
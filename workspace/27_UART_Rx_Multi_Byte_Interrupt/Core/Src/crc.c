@@ -0,0 +1,461 @@
+/*******************************************************************************
+ *
+ * @file	crc.c
+ * @brief	Implementation of the hardware CRC service.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	The CRC unit computes CRC-32 (polynomial 0x04C11DB7, MSB first,
+ * 			no reflection, no final XOR) over each 32-bit word written to
+ * 			CRC->DR, in 4 AHB cycles. Its state is a single register, shared
+ * 			by every task, and the STM32F4 has no register to preload it.
+ * 			Each computation keeps its own state in a CrcContext_t instead,
+ * 			and the unit is reloaded with it when CRC->DR holds another
+ * 			one: after a reset, writing the word that the CRC maps onto the
+ * 			wanted state puts it back, 32 shifts computed by undoing the
+ * 			CRC bit by bit.
+ *
+ * 			So no mutex guards the unit. The CPU feeds it CRC_CHUNK_WORDS
+ * 			words at a time in a critical section, and a long buffer is fed
+ * 			by memory-to-memory DMA while the caller blocks. During a DMA
+ * 			transfer the unit is taken, and other callers compute their
+ * 			words in software, with the same result, rather than wait.
+ *
+ * 			The result covers the whole words of the data as little-endian
+ * 			words, the way the DMA reads them, then the 0 to 3 remaining
+ * 			bytes one by one, MSB first. It does not depend on how the data
+ * 			is split across crc_update() calls.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clkgate.h"
+#include "crc.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define CRC_CR_RESET_OFS		0U
+#define DMA_SxCR_EN_OFS			0U
+#define DMA_SxCR_TEIE_OFS		2U
+#define DMA_SxCR_TCIE_OFS		4U
+#define DMA_SxCR_DIR_OFS		6U
+#define DMA_SxCR_PINC_OFS		9U
+#define DMA_SxCR_PSIZE_OFS		11U
+#define DMA_SxCR_MSIZE_OFS		13U
+#define DMA_SxFCR_DMDIS_OFS		2U
+#define DMA_SxFCR_FTH_OFS		0U
+#define DMA_LISR_TEIF2_OFS		19U
+#define DMA_LISR_TCIF2_OFS		21U
+#define DMA_LIFCR_STREAM2_MASK	0x3D0000U	/* FEIF2, DMEIF2, TEIF2, HTIF2, TCIF2 */
+#define DMA_DIR_MEM_TO_MEM		2U
+#define DMA_SIZE_WORD			2U
+#define DMA_MAX_ITEMS			0xFFFFU
+
+/* Variables -----------------------------------------------------------------*/
+/* CRC of a single 4-bit value in the top nibble, for the software path. */
+static const uint32_t ulCrcNibbleTable[16] =
+{
+	0x00000000U, 0x04C11DB7U, 0x09823B6EU, 0x0D4326D9U,
+	0x130476DCU, 0x17C56B6BU, 0x1A864DB2U, 0x1E475005U,
+	0x2608EDB8U, 0x22C9F00FU, 0x2F8AD6D6U, 0x2B4BCB61U,
+	0x350C9B64U, 0x31CD86D3U, 0x3C8EA00AU, 0x384FBDBDU
+};
+
+static volatile uint8_t ucCrcDmaBusy = 0;	/* The unit is fed by the DMA. */
+static volatile uint8_t ucCrcDmaDone = 0;
+static volatile uint8_t ucCrcDmaError = 0;
+static TaskHandle_t xCrcDmaTask = NULL;
+static CrcStats_t xCrcStats = { 0, 0, 0, 0 };
+static ClkGateUser_t xCrcClock = CLKGATE_USER(CLKGATE_CRC);
+#if (CRC_USE_DMA == 1)
+static ClkGateUser_t xDmaClock = CLKGATE_USER(CLKGATE_DMA2);	/* Held during a transfer. */
+#endif
+
+/* Private function prototypes -----------------------------------------------*/
+static void crc_restore(uint32_t ulState);
+static uint32_t crc_software_words(uint32_t ulState, const uint8_t *pucData, uint32_t ulWords);
+static void crc_feed_words(CrcContext_t *pxCtx, const uint8_t *pucData, uint32_t ulWords);
+#if (CRC_USE_DMA == 1)
+static int32_t crc_feed_dma(CrcContext_t *pxCtx, const uint32_t *pulData, uint32_t ulWords);
+#endif
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Enables the CRC unit and, with CRC_USE_DMA, the DMA2 Stream2 interrupt.
+ * @param None.
+ * @retval None.
+ * @note Call it once, before any task computes a CRC.
+ */
+void crc_init(void)
+{
+	clkgate_acquire(&xCrcClock);
+	CRC->CR = (1U << CRC_CR_RESET_OFS);
+
+#if (CRC_USE_DMA == 1)
+	clkgate_acquire(&xDmaClock);
+	DMA2_Stream2->CR = 0;
+	DMA2->LIFCR = DMA_LIFCR_STREAM2_MASK;
+	clkgate_release(&xDmaClock);
+
+	NVIC_SetPriority(DMA2_Stream2_IRQn, CRC_IRQ_PRIORITY);
+	NVIC_EnableIRQ(DMA2_Stream2_IRQn);
+#endif
+}
+
+/**
+ * @brief Starts a new computation.
+ * @param pxCtx Context of the computation.
+ * @retval None.
+ */
+void crc_begin(CrcContext_t *pxCtx)
+{
+	pxCtx->ulCrc = CRC_INITIAL_VALUE;
+	pxCtx->ulPending = 0;
+	pxCtx->ucPendingLen = 0;
+}
+
+/**
+ * @brief Adds bytes to a computation.
+ * @param pxCtx Context started with crc_begin().
+ * @param pvData Bytes to add, at any alignment.
+ * @param ulLen Number of bytes.
+ * @retval None.
+ * @note With CRC_USE_DMA, a task adding at least CRC_DMA_MIN_BYTES from a word
+ * aligned address blocks until the DMA has fed them. Shorter or unaligned data,
+ * and calls from an ISR (at or below configMAX_SYSCALL_INTERRUPT_PRIORITY), are
+ * fed by the CPU.
+ */
+void crc_update(CrcContext_t *pxCtx, const void *pvData, uint32_t ulLen)
+{
+	const uint8_t *pucData = (const uint8_t *)pvData;
+	uint32_t ulWords;
+
+	/* Complete the pending word first. */
+	while ((pxCtx->ucPendingLen != 0U) && (ulLen > 0U))
+	{
+		pxCtx->ulPending |= (uint32_t)*pucData++ << (8U * pxCtx->ucPendingLen);
+		pxCtx->ucPendingLen++;
+		ulLen--;
+
+		if (pxCtx->ucPendingLen == 4U)
+		{
+			crc_feed_words(pxCtx, (const uint8_t *)&pxCtx->ulPending, 1);
+			pxCtx->ulPending = 0;
+			pxCtx->ucPendingLen = 0;
+		}
+	}
+
+	ulWords = ulLen / 4U;
+
+	if (ulWords > 0U)
+	{
+#if (CRC_USE_DMA == 1)
+		if ((ulLen < CRC_DMA_MIN_BYTES) || (((uint32_t)pucData & 3U) != 0U)
+				|| (__get_IPSR() != 0U)
+				|| (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+				|| (crc_feed_dma(pxCtx, (const uint32_t *)pucData, ulWords) != 0))
+#endif
+		{
+			crc_feed_words(pxCtx, pucData, ulWords);
+		}
+
+		pucData += 4U * ulWords;
+		ulLen -= 4U * ulWords;
+	}
+
+	/* Keep the rest for the next call or crc_final(). */
+	while (ulLen > 0U)
+	{
+		pxCtx->ulPending |= (uint32_t)*pucData++ << (8U * pxCtx->ucPendingLen);
+		pxCtx->ucPendingLen++;
+		ulLen--;
+	}
+}
+
+/**
+ * @brief Ends a computation.
+ * @param pxCtx Context started with crc_begin().
+ * @retval The CRC of all the bytes added.
+ * @note The context can be started again with crc_begin().
+ */
+uint32_t crc_final(CrcContext_t *pxCtx)
+{
+	uint32_t ulCrc = pxCtx->ulCrc;
+	uint32_t x;
+
+	for (x = 0; x < pxCtx->ucPendingLen; x++)
+	{
+		ulCrc ^= ((pxCtx->ulPending >> (8U * x)) & 0xFFU) << 24;
+		ulCrc = (ulCrc << 4) ^ ulCrcNibbleTable[ulCrc >> 28];
+		ulCrc = (ulCrc << 4) ^ ulCrcNibbleTable[ulCrc >> 28];
+	}
+
+	return ulCrc;
+}
+
+/**
+ * @brief Computes the CRC of a buffer in one call.
+ * @param pvData Bytes, at any alignment.
+ * @param ulLen Number of bytes.
+ * @retval The CRC, as crc_begin(), crc_update() and crc_final() would give.
+ */
+uint32_t crc_compute(const void *pvData, uint32_t ulLen)
+{
+	CrcContext_t xCtx;
+
+	crc_begin(&xCtx);
+	crc_update(&xCtx, pvData, ulLen);
+
+	return crc_final(&xCtx);
+}
+
+/**
+ * @brief Reads how the words were computed since crc_init().
+ * @param pxStats Filled with the counters.
+ * @retval None.
+ * @note ulSoftwareWords counts contention with a DMA transfer, and ulRestores
+ * the interleaving of computations on the unit.
+ */
+void crc_get_stats(CrcStats_t *pxStats)
+{
+	UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	*pxStats = xCrcStats;
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Loads a state into the unit.
+ * @param ulState State to load.
+ * @retval None.
+ * @note Called with interrupts masked and the unit not fed by the DMA. A word
+ * W written after a reset leaves the state CRC(CRC_INITIAL_VALUE ^ W), which is
+ * 32 shifts of the polynomial division. Each shift is undone in turn: the LSB
+ * of a shifted value tells whether the polynomial was subtracted.
+ */
+static void crc_restore(uint32_t ulState)
+{
+	uint32_t x;
+
+	CRC->CR = (1U << CRC_CR_RESET_OFS);
+
+	if (ulState == CRC_INITIAL_VALUE)
+	{
+		return;
+	}
+
+	for (x = 0; x < 32U; x++)
+	{
+		if ((ulState & 1U) != 0U)
+		{
+			ulState = ((ulState ^ CRC_POLYNOMIAL) >> 1) | 0x80000000U;
+		}
+		else
+		{
+			ulState >>= 1;
+		}
+	}
+
+	CRC->DR = ulState ^ CRC_INITIAL_VALUE;
+}
+
+/**
+ * @brief Computes whole words in software, as the unit would.
+ * @param ulState State before the words.
+ * @param pucData Words, at any alignment.
+ * @param ulWords Number of words.
+ * @retval State after the words.
+ */
+static uint32_t crc_software_words(uint32_t ulState, const uint8_t *pucData, uint32_t ulWords)
+{
+	uint32_t x;
+
+	while (ulWords-- > 0U)
+	{
+		ulState ^= __UNALIGNED_UINT32_READ(pucData);
+		pucData += 4;
+
+		for (x = 0; x < 8U; x++)
+		{
+			ulState = (ulState << 4) ^ ulCrcNibbleTable[ulState >> 28];
+		}
+	}
+
+	return ulState;
+}
+
+/**
+ * @brief Feeds whole words to the unit from the CPU.
+ * @param pxCtx Context of the computation.
+ * @param pucData Words, at any alignment.
+ * @param ulWords Number of words.
+ * @retval None.
+ * @note Falls back to software while the DMA feeds the unit.
+ */
+static void crc_feed_words(CrcContext_t *pxCtx, const uint8_t *pucData, uint32_t ulWords)
+{
+	UBaseType_t uxSavedInterruptStatus;
+	uint32_t ulChunk;
+	uint32_t x;
+
+	while (ulWords > 0U)
+	{
+		ulChunk = (ulWords < CRC_CHUNK_WORDS) ? ulWords : CRC_CHUNK_WORDS;
+
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+		if (ucCrcDmaBusy == 0U)
+		{
+			/* The unit may still hold this context from its last chunk. */
+			if (CRC->DR != pxCtx->ulCrc)
+			{
+				crc_restore(pxCtx->ulCrc);
+				xCrcStats.ulRestores++;
+			}
+
+			for (x = 0; x < ulChunk; x++)
+			{
+				CRC->DR = __UNALIGNED_UINT32_READ(&pucData[4U * x]);
+			}
+
+			pxCtx->ulCrc = CRC->DR;
+			xCrcStats.ulCpuWords += ulChunk;
+			taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+		}
+		else
+		{
+			xCrcStats.ulSoftwareWords += ulChunk;
+			taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+			pxCtx->ulCrc = crc_software_words(pxCtx->ulCrc, pucData, ulChunk);
+		}
+
+		pucData += 4U * ulChunk;
+		ulWords -= ulChunk;
+	}
+}
+
+#if (CRC_USE_DMA == 1)
+/**
+ * @brief Feeds whole words to the unit with DMA2 Stream2 and waits.
+ * @param pxCtx Context of the computation.
+ * @param pulData Word aligned words, in SRAM or flash.
+ * @param ulWords Number of words.
+ * @retval 0 if the words were fed, -1 if another task holds the DMA.
+ */
+static int32_t crc_feed_dma(CrcContext_t *pxCtx, const uint32_t *pulData, uint32_t ulWords)
+{
+	uint32_t ulState = pxCtx->ulCrc;
+	uint32_t ulTotal = ulWords;
+	uint32_t ulChunk;
+
+	taskENTER_CRITICAL();
+
+	if (ucCrcDmaBusy != 0U)
+	{
+		taskEXIT_CRITICAL();
+		return -1;
+	}
+
+	ucCrcDmaBusy = 1;
+
+	if (CRC->DR != ulState)
+	{
+		crc_restore(ulState);
+		xCrcStats.ulRestores++;
+	}
+
+	taskEXIT_CRITICAL();
+
+	/* DMA2 would freeze in STOP mode: its hold keeps the idle task in SLEEP
+	 * mode until the transfer is done. */
+	clkgate_acquire(&xDmaClock);
+	xCrcDmaTask = xTaskGetCurrentTaskHandle();
+
+	while (ulWords > 0U)
+	{
+		ulChunk = (ulWords < DMA_MAX_ITEMS) ? ulWords : DMA_MAX_ITEMS;
+
+		/* Memory-to-memory: the peripheral port reads the data and the memory
+		 * port writes CRC->DR, which stays fixed. FIFO mode is required. */
+		ucCrcDmaDone = 0;
+		ucCrcDmaError = 0;
+		DMA2->LIFCR = DMA_LIFCR_STREAM2_MASK;
+		DMA2_Stream2->PAR = (uint32_t)pulData;
+		DMA2_Stream2->M0AR = (uint32_t)&CRC->DR;
+		DMA2_Stream2->NDTR = ulChunk;
+		DMA2_Stream2->FCR = (1U << DMA_SxFCR_DMDIS_OFS) | (3U << DMA_SxFCR_FTH_OFS);
+		DMA2_Stream2->CR = (DMA_SIZE_WORD << DMA_SxCR_MSIZE_OFS)
+				| (DMA_SIZE_WORD << DMA_SxCR_PSIZE_OFS)
+				| (1U << DMA_SxCR_PINC_OFS)
+				| (DMA_DIR_MEM_TO_MEM << DMA_SxCR_DIR_OFS)
+				| (1U << DMA_SxCR_TCIE_OFS)
+				| (1U << DMA_SxCR_TEIE_OFS);
+		DMA2_Stream2->CR |= (1U << DMA_SxCR_EN_OFS);
+
+		/* Other users of this notification index may wake the task too. */
+		while (ucCrcDmaDone == 0U)
+		{
+			(void)ulTaskNotifyTakeIndexed(CRC_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+		}
+
+		if (ucCrcDmaError == 0U)
+		{
+			ulState = CRC->DR;
+		}
+		else
+		{
+			/* Redo the chunk in software; the unit's state is unknown. */
+			ulState = crc_software_words(ulState, (const uint8_t *)pulData, ulChunk);
+			crc_restore(ulState);
+		}
+
+		pulData += ulChunk;
+		ulWords -= ulChunk;
+	}
+
+	clkgate_release(&xDmaClock);
+
+	taskENTER_CRITICAL();
+	pxCtx->ulCrc = ulState;
+	xCrcStats.ulDmaWords += ulTotal;
+	ucCrcDmaBusy = 0;
+	taskEXIT_CRITICAL();
+
+	return 0;
+}
+
+/**
+ * @brief DMA2 Stream2 IRQ handler, the end of a CRC transfer.
+ * @param None.
+ * @retval None.
+ */
+void DMA2_Stream2_IRQHandler(void)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	uint32_t ulFlags = DMA2->LISR;
+
+	DMA2->LIFCR = DMA_LIFCR_STREAM2_MASK;
+
+	if ((ulFlags & ((1U << DMA_LISR_TCIF2_OFS) | (1U << DMA_LISR_TEIF2_OFS))) == 0U)
+	{
+		return;
+	}
+
+	if ((ulFlags & (1U << DMA_LISR_TEIF2_OFS)) != 0U)
+	{
+		DMA2_Stream2->CR &= ~(1U << DMA_SxCR_EN_OFS);
+		ucCrcDmaError = 1;
+	}
+
+	ucCrcDmaDone = 1;
+	vTaskNotifyGiveIndexedFromISR(xCrcDmaTask, CRC_NOTIFY_INDEX, &xHigherPriorityTaskWoken);
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+#endif
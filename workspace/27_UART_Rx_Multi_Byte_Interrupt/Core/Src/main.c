@@ -6,36 +6,57 @@
  * @date	Apr 01, 2026
  * @note	'queue.h' must be included inside the 'cmsis_os.h' to use queues.
  *
+ * 			USART2 carries only the received packets, COBS frames with a
+ * 			CRC-32 trailer (see frame.c) checked by the CRC unit; send them
+ * 			with Tools/send_frames.py. The outcome of each packet is
+ * 			printed on ITM port 0 and its length is sampled on port 2; view
+ * 			both in the SWV ITM Data Console (core clock = SystemCoreClock,
+ * 			SWO clock = 2 MHz).
+ *
+ * 			newlib's malloc(), used by printf() for its stream buffers,
+ * 			allocates from the FreeRTOS heap (configUSE_NEWLIB_MALLOC_HEAP).
+ *
  ******************************************************************************/
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
 #include <string.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
 #include "uart.h"
 #include "exti.h"
 #include "adc.h"
+#include "spsc_ring.h"
+#include "itm.h"
+#include "crc.h"
+#include "frame.h"
 
 /* Macros --------------------------------------------------------------------*/
-#define STACK_SIZE 128	/* 128 * 4 = 512 bytes */
-#define EXPECTED_PKT_LEN 5
+#define STACK_SIZE 256	/* 256 * 4 = 1024 bytes, for printf() */
+#define RX_FRAME_MODE FRAME_COBS
+#define RX_FRAME_SIZE 64	/* Largest encoded frame, CRC included. */
+#define RX_CHUNK_SIZE 16	/* Bytes taken from the ring at a time. */
+#define RX_RING_SIZE 64	/* Power of two. */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 int __io_putchar(int ch);
 void vUartPrintTask(void *pvParameters);
-int32_t vStartUart2RxInterrupt(char * buffer, uint_fast16_t len);
+void vStartUart2RxInterrupt(void);
 
 /* Data types ----------------------------------------------------------------*/
 
 /* Variables -----------------------------------------------------------------*/
-static SemaphoreHandle_t xUartRxDoneSemphr = NULL;
-static int iRxInProgress = 0;
-static uint16_t usRxLen = 0;
-static uint16_t usRxItr = 0;
-static char * pcRxBuffer = NULL;
+/* Filled by USART2_IRQHandler, drained by vUartPrintTask. The ISR owns the
+ * head and the task the tail, so nothing else is shared between them. */
+static SpscRing_t xUart2RxRing;
+static uint8_t ucUart2RxRingBuf[RX_RING_SIZE];
+
+/* Decoded by vUartPrintTask as the bytes come out of the ring. */
+static FrameRx_t xUart2RxFrame;
+static uint8_t ucUart2RxFrameBuf[RX_FRAME_SIZE];
 
 /**
  * @brief The application entry point.
@@ -51,6 +72,12 @@ int main(void)
 	/* Initialize all configured peripherals */
 	MX_GPIO_Init();
 
+	/* printf() goes out through SWO (see syscalls.c). */
+	if (ITM_SWO_Init(ITM_SWO_BAUD) != 0)
+	{
+		Error_Handler();
+	}
+
 	/* Create tasks. */
 	xTaskCreate(vUartPrintTask,
 				"vUartPrintTask",
@@ -59,8 +86,17 @@ int main(void)
 				tskIDLE_PRIORITY + 3,
 				NULL);
 
-	/* Create semaphore. */
-	xUartRxDoneSemphr = xSemaphoreCreateBinary();
+	if (spsc_ring_init(&xUart2RxRing, ucUart2RxRingBuf, RX_RING_SIZE) != 0)
+	{
+		Error_Handler();
+	}
+
+	crc_init();
+
+	if (frame_rx_init(&xUart2RxFrame, RX_FRAME_MODE, ucUart2RxFrameBuf, RX_FRAME_SIZE) != 0)
+	{
+		Error_Handler();
+	}
 
 	vTaskStartScheduler();
 
@@ -71,75 +107,72 @@ int main(void)
 	}
 }
 
-char cRxByte;
-char cUartRxData[EXPECTED_PKT_LEN] = {0};
-char cUartRxCode[32] = {0};
-
 /**
- * @brief Prints the received bytes.
+ * @brief Prints the outcome of each received frame.
  * @param None.
  * @return None.
  */
 void vUartPrintTask(void *pvParameters)
 {
-	USART2_UART_RX_Init();
+	uint8_t ucChunk[RX_CHUNK_SIZE];
+	uint32_t ulRead;
+	uint32_t x;
+	int32_t lLen;
 
-	memset(cUartRxData, 0, sizeof(cUartRxData));
+	USART2_UART_RX_Init();
 
-	/* You need to type some characters within the first 10 seconds after
-	 * the program starts to run. */
+	/* A 10 second gap between bytes is reported as a timeout. */
 	const TickType_t timeout = pdMS_TO_TICKS(10000);
 
+	vStartUart2RxInterrupt();
+
 	while (1)
 	{
-		vStartUart2RxInterrupt(cUartRxData, EXPECTED_PKT_LEN);
+		if (spsc_ring_wait(&xUart2RxRing, timeout) == 0)
+		{
+			printf("Packet timeout\r\n");
+			continue;
+		}
 
-		if (xQueueSemaphoreTake(xUartRxDoneSemphr, timeout) == pdPASS)
+		ulRead = spsc_ring_read(&xUart2RxRing, ucChunk, sizeof(ucChunk));
+
+		for (x = 0; x < ulRead; x++)
 		{
-			if (EXPECTED_PKT_LEN == usRxItr)
+			lLen = frame_rx_put(&xUart2RxFrame, ucChunk[x]);
+
+			if (lLen >= 0)
 			{
-				sprintf(cUartRxCode, "received");
+				printf("Packet received (%ld bytes)\r\n", (long)lLen);
+				(void)ITM_write_word(ITM_PORT_METRICS, (uint32_t)lLen);
 			}
-			else
+			else if (lLen == FRAME_RX_ERROR)
 			{
-				sprintf(cUartRxCode, "length mismatch");
+				printf("Packet dropped (crc %lu, framing %lu, overflow %lu)\r\n",
+						xUart2RxFrame.xStats.ulCrcErrors,
+						xUart2RxFrame.xStats.ulFramingErrors,
+						xUart2RxFrame.xStats.ulOverflows);
 			}
 		}
-		else
-		{
-			sprintf(cUartRxCode, "timeout");
-		}
 	}
 }
 
 /**
  * @brief Starts UART2 Rx interrupt-based reception.
  * @param None.
- * @return 0 if successful, -1 otherwise.
+ * @return None.
  */
-int32_t vStartUart2RxInterrupt(char * buffer, uint_fast16_t len)
+void vStartUart2RxInterrupt(void)
 {
-	if ((buffer != NULL) && !iRxInProgress)
-	{
-		iRxInProgress = 1;
-		usRxLen = len;
-		pcRxBuffer = buffer;
-		usRxItr = 0;
-
-		USART2->CR1 |= (1U << 5);	/* Enable Rx interrupt. */
-		NVIC_SetPriority(USART2_IRQn, 6);
-		NVIC_EnableIRQ(USART2_IRQn);
-
-		return 0;
-	}
-
-	return -1;
+	USART2->CR1 |= (1U << 5);	/* Enable Rx interrupt. */
+	NVIC_SetPriority(USART2_IRQn, 6);
+	NVIC_EnableIRQ(USART2_IRQn);
 }
 
 /**
  * @brief USART2 IRQ handler.
  * @param None.
  * @return None.
+ * @note Bytes arriving while the ring is full are dropped.
  */
 void USART2_IRQHandler(void)
 {
@@ -147,18 +180,8 @@ void USART2_IRQHandler(void)
 
 	if (USART2->SR & (1U << 5))
 	{
-		uint8_t temp = (uint8_t)USART2->DR;
-
-		if (iRxInProgress)
-		{
-			pcRxBuffer[usRxItr++] =  temp;
-
-			if (usRxItr >= usRxLen)
-			{
-				iRxInProgress = 0;
-				xSemaphoreGiveFromISR(xUartRxDoneSemphr, &xHigherPriorityTaskWoken);
-			}
-		}
+		(void)spsc_ring_put(&xUart2RxRing, (uint8_t)USART2->DR);
+		spsc_ring_wake_from_isr(&xUart2RxRing, &xHigherPriorityTaskWoken);
 	}
 
 	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
@@ -170,44 +193,9 @@ void USART2_IRQHandler(void)
  */
 void SystemClock_Config(void)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
-
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-	{
-		Error_Handler();
-	}
-
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
@@ -34,6 +34,33 @@
 /* Variables */
 extern int __io_putchar(int ch) __attribute__((weak));
 extern int __io_getchar(void) __attribute__((weak));
+extern int __io_putbuf(char *ptr, int len) __attribute__((weak));
+extern int __io_putbuf_itm(char *ptr, int len) __attribute__((weak));
+extern int __io_putbuf_rtt(char *ptr, int len) __attribute__((weak));
+extern int __io_getbuf_rtt(char *ptr, int len) __attribute__((weak));
+
+/* Console sink of each output stream: USART2 (uart.c), the ITM text
+ * stimulus port (itm.c, SWO) or the RTT terminal ring (rtt.c, read by the
+ * probe). With SINK_ITM or SINK_RTT, the stream falls back to USART2 if the
+ * driver is not linked in. STDIN_SOURCE is SINK_UART or SINK_RTT. */
+#define SINK_UART 0
+#define SINK_ITM  1
+#define SINK_RTT  2
+
+/* USART2 only receives in this project: printf() goes out through SWO. */
+#define STDOUT_SINK SINK_ITM
+
+#ifndef STDOUT_SINK
+#define STDOUT_SINK SINK_UART
+#endif
+
+#ifndef STDERR_SINK
+#define STDERR_SINK SINK_UART
+#endif
+
+#ifndef STDIN_SOURCE
+#define STDIN_SOURCE SINK_UART
+#endif
 
 
 char *__env[1] = { 0 };
@@ -69,6 +96,11 @@ __attribute__((weak)) int _read(int file, char *ptr, int len)
   (void)file;
   int DataIdx;
 
+  if ((STDIN_SOURCE == SINK_RTT) && __io_getbuf_rtt)
+  {
+    return __io_getbuf_rtt(ptr, len);
+  }
+
   for (DataIdx = 0; DataIdx < len; DataIdx++)
   {
     *ptr++ = __io_getchar();
@@ -79,8 +111,24 @@ __attribute__((weak)) int _read(int file, char *ptr, int len)
 
 __attribute__((weak)) int _write(int file, char *ptr, int len)
 {
-  (void)file;
   int DataIdx;
+  int sink = (file == 2) ? STDERR_SINK : STDOUT_SINK;
+
+  if ((sink == SINK_ITM) && __io_putbuf_itm)
+  {
+    return __io_putbuf_itm(ptr, len);
+  }
+
+  if ((sink == SINK_RTT) && __io_putbuf_rtt)
+  {
+    return __io_putbuf_rtt(ptr, len);
+  }
+
+  /* Hand the whole buffer to a non-blocking sink when the driver has one. */
+  if (__io_putbuf)
+  {
+    return __io_putbuf(ptr, len);
+  }
 
   for (DataIdx = 0; DataIdx < len; DataIdx++)
   {
@@ -796,6 +796,159 @@ BaseType_t xMessageBufferReceiveCompletedFromISR( MessageBufferHandle_t xStreamB
  */
 #define xMessageBufferReceiveCompletedFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) xStreamBufferReceiveCompletedFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxHigherPriorityTaskWoken )
 
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferReserve( MessageBufferHandle_t xMessageBuffer, void **ppvData, size_t xLengthBytes, TickType_t xTicksToWait );
+size_t xMessageBufferCommit( MessageBufferHandle_t xMessageBuffer, size_t xLengthBytes );
+size_t xMessageBufferCommitFromISR( MessageBufferHandle_t xMessageBuffer, size_t xLengthBytes, BaseType_t *pxHigherPriorityTaskWoken );
+size_t xMessageBufferPeek( MessageBufferHandle_t xMessageBuffer, const void **ppvData, TickType_t xTicksToWait );
+size_t xMessageBufferConsume( MessageBufferHandle_t xMessageBuffer, size_t xLengthBytes );
+size_t xMessageBufferConsumeFromISR( MessageBufferHandle_t xMessageBuffer, size_t xLengthBytes, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Zero-copy access to a message buffer: a message is written in place between
+ * xMessageBufferReserve() and xMessageBufferCommit(), and read in place
+ * between xMessageBufferPeek() and xMessageBufferConsume().  A reservation
+ * covers the whole message and never wraps, so it can fail near the end of
+ * the storage area even with enough free space.  See xStreamBufferReserve(),
+ * xStreamBufferCommit(), xStreamBufferPeek() and xStreamBufferConsume().
+ * configUSE_STREAM_BUFFER_ZERO_COPY must be set to 1.
+ *
+ * \defgroup xMessageBufferReserve xMessageBufferReserve
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReserve( xMessageBuffer, ppvData, xLengthBytes, xTicksToWait ) xStreamBufferReserve( ( StreamBufferHandle_t ) xMessageBuffer, ppvData, xLengthBytes, xTicksToWait )
+#define xMessageBufferCommit( xMessageBuffer, xLengthBytes ) xStreamBufferCommit( ( StreamBufferHandle_t ) xMessageBuffer, xLengthBytes )
+#define xMessageBufferCommitFromISR( xMessageBuffer, xLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferCommitFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xLengthBytes, pxHigherPriorityTaskWoken )
+#define xMessageBufferPeek( xMessageBuffer, ppvData, xTicksToWait ) xStreamBufferPeek( ( StreamBufferHandle_t ) xMessageBuffer, ppvData, xTicksToWait )
+#define xMessageBufferConsume( xMessageBuffer, xLengthBytes ) xStreamBufferConsume( ( StreamBufferHandle_t ) xMessageBuffer, xLengthBytes )
+#define xMessageBufferConsumeFromISR( xMessageBuffer, xLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferConsumeFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xLengthBytes, pxHigherPriorityTaskWoken )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferSendV( MessageBufferHandle_t xMessageBuffer, const StreamBufferTxVector_t *pxVectors, UBaseType_t uxVectorCount, TickType_t xTicksToWait );
+size_t xMessageBufferSendVFromISR( MessageBufferHandle_t xMessageBuffer, const StreamBufferTxVector_t *pxVectors, UBaseType_t uxVectorCount, BaseType_t *pxHigherPriorityTaskWoken );
+size_t xMessageBufferReceiveV( MessageBufferHandle_t xMessageBuffer, const StreamBufferRxVector_t *pxVectors, UBaseType_t uxVectorCount, TickType_t xTicksToWait );
+size_t xMessageBufferReceiveVFromISR( MessageBufferHandle_t xMessageBuffer, const StreamBufferRxVector_t *pxVectors, UBaseType_t uxVectorCount, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Sends the fragments of pxVectors as one message, of their total length,
+ * and receives a message into several destinations.  The message is sent
+ * whole or not at all, and received whole or not at all.  See
+ * xStreamBufferSendV() and xStreamBufferReceiveV().
+ * configUSE_STREAM_BUFFER_VECTORS must be set to 1.
+ *
+ * \defgroup xMessageBufferSendV xMessageBufferSendV
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendV( xMessageBuffer, pxVectors, uxVectorCount, xTicksToWait ) xStreamBufferSendV( ( StreamBufferHandle_t ) xMessageBuffer, pxVectors, uxVectorCount, xTicksToWait )
+#define xMessageBufferSendVFromISR( xMessageBuffer, pxVectors, uxVectorCount, pxHigherPriorityTaskWoken ) xStreamBufferSendVFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxVectors, uxVectorCount, pxHigherPriorityTaskWoken )
+#define xMessageBufferReceiveV( xMessageBuffer, pxVectors, uxVectorCount, xTicksToWait ) xStreamBufferReceiveV( ( StreamBufferHandle_t ) xMessageBuffer, pxVectors, uxVectorCount, xTicksToWait )
+#define xMessageBufferReceiveVFromISR( xMessageBuffer, pxVectors, uxVectorCount, pxHigherPriorityTaskWoken ) xStreamBufferReceiveVFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxVectors, uxVectorCount, pxHigherPriorityTaskWoken )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferSendConcurrent( MessageBufferHandle_t xMessageBuffer, const void *pvTxData, size_t xDataLengthBytes );
+size_t xMessageBufferSendConcurrentFromISR( MessageBufferHandle_t xMessageBuffer, const void *pvTxData, size_t xDataLengthBytes, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Sends a message to a message buffer that has several writers, with no
+ * mutex around the sends.  The whole message is sent or nothing is, and the
+ * sends never block.  See xStreamBufferSendConcurrent().
+ * configUSE_STREAM_BUFFER_MULTI_PRODUCER must be set to 1.
+ *
+ * \defgroup xMessageBufferSendConcurrent xMessageBufferSendConcurrent
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendConcurrent( xMessageBuffer, pvTxData, xDataLengthBytes ) xStreamBufferSendConcurrent( ( StreamBufferHandle_t ) xMessageBuffer, pvTxData, xDataLengthBytes )
+#define xMessageBufferSendConcurrentFromISR( xMessageBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferSendConcurrentFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+void vMessageBufferAddToRegistry( MessageBufferHandle_t xMessageBuffer, const char *pcName );
+void vMessageBufferUnregister( MessageBufferHandle_t xMessageBuffer );
+const char *pcMessageBufferGetName( MessageBufferHandle_t xMessageBuffer );
+MessageBufferHandle_t xMessageBufferFindByName( const char *pcName );
+</pre>
+ *
+ * Object registry access for message buffers, which are registered as stream
+ * buffers.  See vStreamBufferAddToRegistry().  configUSE_OBJECT_REGISTRY must
+ * be set to 1.
+ *
+ * \defgroup vMessageBufferAddToRegistry vMessageBufferAddToRegistry
+ * \ingroup MessageBufferManagement
+ */
+#define vMessageBufferAddToRegistry( xMessageBuffer, pcName ) vStreamBufferAddToRegistry( ( StreamBufferHandle_t ) xMessageBuffer, pcName )
+#define vMessageBufferUnregister( xMessageBuffer ) vStreamBufferUnregister( ( StreamBufferHandle_t ) xMessageBuffer )
+#define pcMessageBufferGetName( xMessageBuffer ) pcStreamBufferGetName( ( StreamBufferHandle_t ) xMessageBuffer )
+#define xMessageBufferFindByName( pcName ) ( ( MessageBufferHandle_t ) xStreamBufferFindByName( pcName ) )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+MessageTimestamp_t xMessageBufferGetLastTimestamp( MessageBufferHandle_t xMessageBuffer );
+void vMessageBufferGetDelayStats( MessageBufferHandle_t xMessageBuffer, MessageBufferDelayStats_t *pxStats );
+void vMessageBufferResetDelayStats( MessageBufferHandle_t xMessageBuffer );
+</pre>
+ *
+ * With configUSE_MESSAGE_BUFFER_TIMESTAMPS set to 1, every message is stored
+ * with the time it was sent, read from configMESSAGE_BUFFER_TIMESTAMP(): at
+ * xMessageBufferSend() or xMessageBufferSendFromISR(), or at
+ * xMessageBufferCommit() for a message written in place.  Each message then
+ * takes sizeof( MessageTimestamp_t ) more bytes of the buffer.
+ *
+ * Receiving a message, or consuming one after xMessageBufferPeek(), records
+ * how long it was queued in the delay statistics of the message buffer.
+ * xMessageBufferGetLastTimestamp() then returns the time the message was
+ * sent, for the reader to trace its latency end to end, across further
+ * buffers or queues if it forwards the stamp with the data.
+ * vMessageBufferGetDelayStats() copies the statistics, and
+ * vMessageBufferResetDelayStats() clears them, as xMessageBufferReset() also
+ * does.  All three can be called from tasks and ISRs.
+ *
+ * @param xMessageBuffer The handle of the message buffer.
+ *
+ * @param pxStats Where the delay statistics are copied to.
+ *
+ * @return The time the last message received was sent, in microseconds, or
+ * 0 before the first message.
+ *
+ * Example use:
+<pre>
+void vReceiveSample( MessageBufferHandle_t xSamples )
+{
+uint8_t ucSample[ 32 ];
+MessageBufferDelayStats_t xStats;
+
+    if( xMessageBufferReceive( xSamples, ucSample, sizeof( ucSample ), portMAX_DELAY ) > 0 )
+    {
+        // The sample was captured when it was sent.
+        vProcessSample( ucSample, xMessageBufferGetLastTimestamp( xSamples ) );
+    }
+
+    vMessageBufferGetDelayStats( xSamples, &xStats );
+}
+</pre>
+ * \defgroup xMessageBufferGetLastTimestamp xMessageBufferGetLastTimestamp
+ * \ingroup MessageBufferManagement
+ */
+#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+	typedef StreamBufferDelayStats_t MessageBufferDelayStats_t;
+
+	#define xMessageBufferGetLastTimestamp( xMessageBuffer ) xStreamBufferGetLastTimestamp( ( StreamBufferHandle_t ) xMessageBuffer )
+	#define vMessageBufferGetDelayStats( xMessageBuffer, pxStats ) vStreamBufferGetDelayStats( ( StreamBufferHandle_t ) xMessageBuffer, pxStats )
+	#define vMessageBufferResetDelayStats( xMessageBuffer ) vStreamBufferResetDelayStats( ( StreamBufferHandle_t ) xMessageBuffer )
+#endif
+
 #if defined( __cplusplus )
 } /* extern "C" */
 #endif
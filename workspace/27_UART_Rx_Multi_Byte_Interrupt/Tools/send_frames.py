@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""Sends payloads to the board as COBS or SLIP frames with a CRC-32 trailer.
+
+Each payload is followed by its CRC, least significant byte first, then
+encoded as in frame.c. The CRC is the one of the STM32 CRC unit as crc.c uses
+it: polynomial 0x04C11DB7, initial value 0xFFFFFFFF, no reflection and no
+final XOR, over the whole words of the payload read as little-endian words,
+then over the remaining bytes one by one.
+
+Usage:
+    send_frames.py /dev/ttyACM0 hello world
+    send_frames.py /dev/ttyACM0 --corrupt hello
+    send_frames.py frames.bin --slip hello
+
+Each argument is one payload. A serial port is opened with pyserial when it is
+installed; any other path is written as a file, e.g. a port set up beforehand
+with 'stty -F /dev/ttyACM0 115200 raw'.
+"""
+
+import argparse
+import struct
+import sys
+
+POLYNOMIAL = 0x04C11DB7
+SLIP_END, SLIP_ESC, SLIP_ESC_END, SLIP_ESC_ESC = 0xC0, 0xDB, 0xDC, 0xDD
+
+
+def crc_shift(crc, bits):
+    for _ in range(bits):
+        crc = ((crc << 1) ^ POLYNOMIAL) if crc & 0x80000000 else (crc << 1)
+        crc &= 0xFFFFFFFF
+    return crc
+
+
+def crc32_stm32(data):
+    crc = 0xFFFFFFFF
+    whole = len(data) - len(data) % 4
+    for (word,) in struct.iter_unpack("<I", data[:whole]):
+        crc = crc_shift(crc ^ word, 32)
+    for byte in data[whole:]:
+        crc = crc_shift(crc ^ (byte << 24), 8)
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_pos, code = 0, 1
+    for byte in data:
+        if byte == 0:
+            out[code_pos] = code
+            code_pos, code = len(out), 1
+            out.append(0)
+            continue
+        out.append(byte)
+        code += 1
+        if code == 0xFF:
+            out[code_pos] = code
+            code_pos, code = len(out), 1
+            out.append(0)
+    out[code_pos] = code
+    out.append(0)
+    return bytes(out)
+
+
+def slip_encode(data):
+    out = bytearray([SLIP_END])
+    for byte in data:
+        if byte == SLIP_END:
+            out += bytes([SLIP_ESC, SLIP_ESC_END])
+        elif byte == SLIP_ESC:
+            out += bytes([SLIP_ESC, SLIP_ESC_ESC])
+        else:
+            out.append(byte)
+    out.append(SLIP_END)
+    return bytes(out)
+
+
+def encode(payload, slip=False, corrupt=False):
+    trailer = struct.pack("<I", crc32_stm32(payload))
+    if corrupt:
+        trailer = bytes([trailer[0] ^ 0x01]) + trailer[1:]
+    body = payload + trailer
+    return slip_encode(body) if slip else cobs_encode(body)
+
+
+def open_output(path, baudrate):
+    if path == "-":
+        return sys.stdout.buffer
+    try:
+        import serial
+        if path.startswith(("/dev/", "COM")):
+            return serial.Serial(path, baudrate)
+    except ImportError:
+        pass
+    return open(path, "wb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("output", help="serial port, file, or - for stdout")
+    parser.add_argument("payloads", nargs="+", help="payloads, sent as UTF-8")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--slip", action="store_true", help="SLIP instead of COBS")
+    parser.add_argument("--corrupt", action="store_true",
+                        help="flip a CRC bit, to see the board drop the frames")
+    options = parser.parse_args()
+
+    output = open_output(options.output, options.baudrate)
+    for payload in options.payloads:
+        output.write(encode(payload.encode(), options.slip, options.corrupt))
+    output.flush()
+
+
+if __name__ == "__main__":
+    main()
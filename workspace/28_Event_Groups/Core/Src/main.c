@@ -13,6 +13,7 @@
 #include <stdio.h>
 #include <string.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
 #include "uart.h"
 #include "exti.h"
@@ -21,18 +22,28 @@
 /* Macros --------------------------------------------------------------------*/
 #define TASK1_BIT (1UL << 0UL)
 #define TASK2_BIT (1UL << 1UL)
+#define BUTTON_BIT (1UL << 2UL)	/* Set by the B1 (PC13) button ISR. */
+#define BUTTON_DEBOUNCE_MS 20U
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 void vEventBitSetTask(void *pvParameters);
 void vEventBitReadTask(void *pvParameters);
+static void prvButtonPressed(uint32_t ulLine, uint32_t ulLevel, void *pvArg,
+		BaseType_t *pxHigherPriorityTaskWoken);
 
 /* Data types ----------------------------------------------------------------*/
 
 /* Variables -----------------------------------------------------------------*/
 EventGroupHandle_t xEventGroup;
 
+static const ExtiPin_t xButtonPins[] =
+{
+	{ B1_GPIO_Port, 13, EXTI_EDGE_FALLING, EXTI_PULL_NONE, BUTTON_DEBOUNCE_MS,
+			prvButtonPressed, NULL, NULL, 0 },
+};
+
 /**
  * @brief The application entry point.
  * @retval int
@@ -68,6 +79,13 @@ int main(void)
 
 	xEventGroup = xEventGroupCreate();
 
+	/* B1 button interrupt, handled by prvButtonPressed(). Enabled once the
+	 * event group exists. */
+	if (exti_init(xButtonPins, sizeof(xButtonPins) / sizeof(xButtonPins[0])) != 0)
+	{
+		Error_Handler();
+	}
+
 	vTaskStartScheduler();
 
 	/* Infinite loop */
@@ -111,7 +129,7 @@ void vEventBitReadTask(void *pvParameters)
 {
 	EventBits_t xEventGroupValue;
 
-	const EventBits_t xBitsToWaitFor = (TASK1_BIT | TASK2_BIT);
+	const EventBits_t xBitsToWaitFor = (TASK1_BIT | TASK2_BIT | BUTTON_BIT);
 	const TickType_t xDelay200ms = pdMS_TO_TICKS(200UL);
 
 	while (1)
@@ -132,54 +150,41 @@ void vEventBitReadTask(void *pvParameters)
 		{
 			printf("vEventBitReadTask: Event bit 1 set - Task 2\r\n");
 		}
+
+		if ((xEventGroupValue & BUTTON_BIT) != 0)
+		{
+			printf("vEventBitReadTask: Event bit 2 set - Button ISR\r\n");
+		}
 	}
 	vTaskDelay(xDelay200ms);
 }
 
+/**
+ * @brief Handles a debounced press of the B1 button (PC13), from the EXTI
+ * interrupt.
+ * @note With configUSE_EVENT_GROUPS_DIRECT_FROM_ISR the bit is set and
+ * vEventBitReadTask unblocked here, so the only context switch is to it.
+ * @param ulLine Unused.
+ * @param ulLevel Unused.
+ * @param pvArg Unused.
+ * @param pxHigherPriorityTaskWoken Set if vEventBitReadTask should run.
+ * @retval None
+ */
+static void prvButtonPressed(uint32_t ulLine, uint32_t ulLevel, void *pvArg,
+		BaseType_t *pxHigherPriorityTaskWoken)
+{
+	xEventGroupSetBitsFromISR(xEventGroup, BUTTON_BIT, pxHigherPriorityTaskWoken);
+}
+
 /**
  * @brief System Clock Configuration
  * @retval None
  */
 void SystemClock_Config(void)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
-
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-	{
-		Error_Handler();
-	}
-
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
@@ -4,57 +4,895 @@
  * @brief	Implementation of UART driver.
  * @author	Kyungjae Lee
  * @date	Mar 30, 2026
+ * @note	One driver for USART1 to USART6. A constant table gives each port
+ * 			its pins, APB bus, interrupts and DMA streams, and uart_open()
+ * 			gives it its buffers, so every port runs the same code:
+ * 			- TX: writers copy into a ring and the DMA sends the contiguous
+ * 			  region starting at the tail, so one wrap costs one extra
+ * 			  chunk, never a copy.
+ * 			- RX: the DMA writes the ring in circular mode and uart_read()
+ * 			  copies out of it directly. HT, TC and IDLE line events wake
+ * 			  the reader, and nothing runs per byte.
+ * 			A task blocked on a full TX ring or an empty RX ring waits on
+ * 			its notification UART_NOTIFY_INDEX.
+ *
+ * 			The TX path has UART_TX_LANES priority lanes, each a ring of its
+ * 			own: lane 0 is the one of UartConfig_t and the others are
+ * 			attached with uart_attach_tx_lane(). At every chunk boundary the
+ * 			DMA takes the highest lane with bytes queued, and once a lane
+ * 			above 0 is attached chunks are cut at UART_TX_LANE_CHUNK bytes,
+ * 			so an urgent line waits for one chunk at most, however much is
+ * 			queued on lane 0. Bytes a write gives up on are counted per lane.
+ *
+ * 			A port opened without an RX buffer can be read a byte at a time
+ * 			with uart_read_adaptive(). It spins on RXNE for a short window
+ * 			after each byte, which catches the next byte of a burst with no
+ * 			interrupt or context switch, then enables the RXNE interrupt and
+ * 			blocks once the line goes quiet. The window follows a running
+ * 			average of the gaps between the bytes of a burst, timed on the
+ * 			DWT cycle counter that the start-up code enables.
+ *
+ * 			The baud rate divider is computed from the current APB clock,
+ * 			rounded, with 16 times oversampling when the rate allows it and
+ * 			8 times (OVER8) above PCLK / 16. After a clock profile switch,
+ * 			clock.c calls clock_uart_retune(), which recomputes it for the
+ * 			same baud rate.
  *
  ******************************************************************************/
 
 /* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
 #include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clock.h"
+#include "clkgate.h"
+#include "uart.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define USART_SR_FE_OFS			1U
+#define USART_SR_NE_OFS			2U
+#define USART_SR_ORE_OFS		3U
+#define USART_SR_IDLE_OFS		4U
+#define USART_SR_RXNE_OFS		5U
+#define USART_SR_TC_OFS			6U
+#define USART_SR_TXE_OFS		7U
+#define USART_CR1_RE_OFS		2U
+#define USART_CR1_TE_OFS		3U
+#define USART_CR1_IDLEIE_OFS	4U
+#define USART_CR1_RXNEIE_OFS	5U
+#define USART_CR1_UE_OFS		13U
+#define USART_CR1_OVER8_OFS		15U
+#define USART_CR3_EIE_OFS		0U
+#define USART_CR3_DMAR_OFS		6U
+#define USART_CR3_DMAT_OFS		7U
+#define DMA_SxCR_EN_OFS			0U
+#define DMA_SxCR_HTIE_OFS		3U
+#define DMA_SxCR_TCIE_OFS		4U
+#define DMA_SxCR_DIR_OFS		6U
+#define DMA_SxCR_CIRC_OFS		8U
+#define DMA_SxCR_MINC_OFS		10U
+#define DMA_SxCR_PL_OFS			16U
+#define DMA_SxCR_CHSEL_OFS		25U
+#define DMA_FLAGS_MASK			0x3DU	/* FEIF, DMEIF, TEIF, HTIF, TCIF of a stream. */
+#define GPIO_PORT_STRIDE		0x400U
+#define PIN_MODE_AF				2U
+#define PIN_SPEED_FAST			2U
+#define PIN_PULL_UP				1U
+#define UART_RX_GAP_SHIFT		3U		/* Weight 1/8 of a new gap in the average. */
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	USART_TypeDef *pxUart;
+	DMA_TypeDef *pxDma;
+	uint8_t ucTxStream;				/* 0..7 on pxDma */
+	uint8_t ucRxStream;
+	uint8_t ucChannel;				/* Same for TX and RX. */
+	uint8_t ucOnApb2;
+	uint8_t ucClock;				/* ClkGate_t of the USART. */
+	uint8_t ucAf;
+	GPIO_TypeDef *pxTxPort;
+	uint8_t ucTxPin;
+	GPIO_TypeDef *pxRxPort;
+	uint8_t ucRxPin;
+	IRQn_Type xUartIrq;
+	IRQn_Type xTxIrq;
+	IRQn_Type xRxIrq;
+	uint8_t ucEnabled;				/* UART_USE_xxx */
+} UartHw_t;
+
+/* One TX ring. One slot is kept empty to tell a full ring from an empty one. */
+typedef struct
+{
+	uint8_t *pucRing;
+	uint16_t usSize;
+	volatile uint16_t usHead;		/* Next free slot (writers). */
+	volatile uint16_t usTail;		/* Oldest byte not yet sent. */
+	volatile TaskHandle_t xWaiter;	/* Writer blocked on a full ring. */
+} UartLane_t;
+
+typedef struct
+{
+	uint8_t ucOpen;
+	uint32_t ulRequestedBaudRate;	/* As passed in; 0 until the port is open. */
+	uint32_t ulActualBaudRate;		/* The one BRR gives at the current PCLK. */
+
+	UartLane_t xTxLanes[UART_TX_LANES];
+	volatile uint16_t usTxDmaLen;	/* Length of the chunk in flight. */
+	uint8_t ucTxLane;				/* Lane of the chunk in flight. */
+	uint8_t ucTxChunked;			/* A lane above 0 is attached: chunks are cut. */
+
+	uint8_t *pucRxRing;
+	uint16_t usRxSize;
+	uint16_t usRxDmaLast;			/* DMA write position at the last sync. */
+	volatile uint32_t ulRxHead;		/* Free-running, bytes written by the DMA. */
+	uint32_t ulRxTail;				/* Free-running, bytes consumed (reader). */
+	volatile TaskHandle_t xRxWaiter;	/* Also the uart_read_adaptive() one. */
+	uint32_t ulRxLastCycles;		/* CYCCNT at the last uart_read_adaptive() byte. */
+	uint32_t ulRxGapCycles;			/* Average gap between the bytes of a burst. */
+
+	UartStats_t xStats;
+} UartState_t;
+
+/* Held for good from the first open, kept apart from the state cleared by
+ * every open. */
+typedef struct
+{
+	ClkGateUser_t xUart;
+	ClkGateUser_t xTxPort;
+	ClkGateUser_t xRxPort;
+	ClkGateUser_t xDma;
+} UartClocks_t;
 
 /* Variables -----------------------------------------------------------------*/
-UART_HandleTypeDef huart2;
+/* DMA request mapping from RM0390 tables 28 and 29. */
+static const UartHw_t xUartHw[UART_PORTS] =
+{
+	{ USART1, DMA2, 7, 5, 4, 1, CLKGATE_USART1, 7, GPIOA, 9, GPIOA, 10,
+			USART1_IRQn, DMA2_Stream7_IRQn, DMA2_Stream5_IRQn, UART_USE_USART1 },
+	{ USART2, DMA1, 6, 5, 4, 0, CLKGATE_USART2, 7, GPIOA, 2, GPIOA, 3,
+			USART2_IRQn, DMA1_Stream6_IRQn, DMA1_Stream5_IRQn, UART_USE_USART2 },
+	{ USART3, DMA1, 3, 1, 4, 0, CLKGATE_USART3, 7, GPIOC, 10, GPIOC, 11,
+			USART3_IRQn, DMA1_Stream3_IRQn, DMA1_Stream1_IRQn, UART_USE_USART3 },
+	{ UART4, DMA1, 4, 2, 4, 0, CLKGATE_UART4, 8, GPIOA, 0, GPIOA, 1,
+			UART4_IRQn, DMA1_Stream4_IRQn, DMA1_Stream2_IRQn, UART_USE_UART4 },
+	{ UART5, DMA1, 7, 0, 4, 0, CLKGATE_UART5, 8, GPIOC, 12, GPIOD, 2,
+			UART5_IRQn, DMA1_Stream7_IRQn, DMA1_Stream0_IRQn, UART_USE_UART5 },
+	{ USART6, DMA2, 6, 1, 5, 1, CLKGATE_USART6, 8, GPIOC, 6, GPIOC, 7,
+			USART6_IRQn, DMA2_Stream6_IRQn, DMA2_Stream1_IRQn, UART_USE_USART6 }
+};
+
+static UartState_t xUartState[UART_PORTS];
+static UartClocks_t xUartClocks[UART_PORTS];
+
+/* Console TX ring, used by USART2_UART_Open(). */
+static uint8_t ucUsart2TxRing[UART_TX_RING_SIZE];
+#if (UART_TX_LANES > 1U) && (UART_TX_URGENT_RING_SIZE > 0)
+static uint8_t ucUsart2UrgentRing[UART_TX_URGENT_RING_SIZE];	/* Its urgent lane. */
+#endif
 
 /* Private function prototypes -----------------------------------------------*/
 int __io_putchar(int ch);
+int __io_putbuf(char *ptr, int len);
+static DMA_Stream_TypeDef *uart_dma_stream(const UartHw_t *pxHw, uint8_t ucStream);
+static uint32_t uart_dma_flags(const UartHw_t *pxHw, uint8_t ucStream);
+static void uart_dma_clear(const UartHw_t *pxHw, uint8_t ucStream);
+static void uart_dma_disable(DMA_Stream_TypeDef *pxStream);
+static void uart_pin_init(GPIO_TypeDef *pxPort, uint8_t ucPin, uint8_t ucAf, uint8_t ucPullUp);
+static void uart_tx_kick(UartPort_t xPort);
+static uint16_t uart_tx_free(const UartLane_t *pxLane);
+static void uart_rx_sync(UartPort_t xPort);
+static uint32_t uart_rx_spin_cycles(const UartState_t *pxState, uint32_t ulCyclesPerUs);
+static uint32_t uart_pclk(const UartHw_t *pxHw);
+static int32_t uart_compute_brr(uint32_t ulPclk, uint32_t ulBaud, uint32_t *pulBrr,
+		uint32_t *pulOver8, uint32_t *pulActual);
+static int32_t uart_apply_baud_rate(UartPort_t xPort, uint32_t ulBaud);
+static void uart_irq(UartPort_t xPort);
+static void uart_tx_dma_irq(UartPort_t xPort);
+static void uart_rx_dma_irq(UartPort_t xPort);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Opens a port full duplex.
+ * @param xPort Port, compiled in with its UART_USE_xxx.
+ * @param pxCfg Baud rate and buffers. Without a TX buffer, uart_write() polls;
+ * without an RX buffer, the receiver is enabled but left to the application
+ * (e.g. its own RXNE interrupt handler).
+ * @retval 0 if successful, -1 if the port is not compiled in, a buffer is
+ * smaller than 2 bytes, or the baud rate cannot be reached within
+ * UART_BAUD_TOLERANCE_PPM at the current APB clock. The port is then
+ * unchanged.
+ * @note Can be called again to re-open the port; what is queued is sent first,
+ * and what was received but not read is dropped. Lanes above 0 are detached.
+ */
+int32_t uart_open(UartPort_t xPort, const UartConfig_t *pxCfg)
+{
+	const UartHw_t *pxHw;
+	UartState_t *pxState;
+	UartClocks_t *pxClocks;
+	DMA_Stream_TypeDef *pxTxStream;
+	DMA_Stream_TypeDef *pxRxStream;
+	uint32_t ulBrr;
+	uint32_t ulOver8;
+	uint32_t ulActual;
+
+	if ((xPort >= UART_PORTS) || (pxCfg == NULL) || (xUartHw[xPort].ucEnabled == 0U)
+			|| ((pxCfg->pucTxBuf != NULL) && (pxCfg->usTxSize < 2U))
+			|| ((pxCfg->pucRxBuf != NULL) && (pxCfg->usRxSize < 2U)))
+	{
+		return -1;
+	}
+
+	pxHw = &xUartHw[xPort];
+	pxState = &xUartState[xPort];
+	pxClocks = &xUartClocks[xPort];
+
+	if (uart_compute_brr(uart_pclk(pxHw), pxCfg->ulBaudRate, &ulBrr, &ulOver8, &ulActual) != 0)
+	{
+		return -1;
+	}
+
+	pxTxStream = uart_dma_stream(pxHw, pxHw->ucTxStream);
+	pxRxStream = uart_dma_stream(pxHw, pxHw->ucRxStream);
+
+	if (pxState->ucOpen)
+	{
+		uart_flush(xPort);
+		NVIC_DisableIRQ(pxHw->xUartIrq);
+		NVIC_DisableIRQ(pxHw->xTxIrq);
+		NVIC_DisableIRQ(pxHw->xRxIrq);
+		pxState->ucOpen = 0;
+	}
+
+	/* Clocks: the USART, its pins' ports and its DMA controller. The holds
+	 * are the same on every open, so only the first one sets them up. */
+	if (pxClocks->xUart.ucHeld == 0U)
+	{
+		clkgate_user_init(&pxClocks->xUart, (ClkGate_t)pxHw->ucClock);
+		clkgate_user_init(&pxClocks->xTxPort, (ClkGate_t)(CLKGATE_GPIOA
+				+ (((uint32_t)pxHw->pxTxPort - GPIOA_BASE) / GPIO_PORT_STRIDE)));
+		clkgate_user_init(&pxClocks->xRxPort, (ClkGate_t)(CLKGATE_GPIOA
+				+ (((uint32_t)pxHw->pxRxPort - GPIOA_BASE) / GPIO_PORT_STRIDE)));
+		clkgate_user_init(&pxClocks->xDma, (pxHw->pxDma == DMA1) ? CLKGATE_DMA1 : CLKGATE_DMA2);
+	}
+
+	clkgate_acquire(&pxClocks->xUart);
+	clkgate_acquire(&pxClocks->xTxPort);
+	clkgate_acquire(&pxClocks->xRxPort);
+	clkgate_acquire(&pxClocks->xDma);
+
+	uart_pin_init(pxHw->pxTxPort, pxHw->ucTxPin, pxHw->ucAf, 0);
+	uart_pin_init(pxHw->pxRxPort, pxHw->ucRxPin, pxHw->ucAf, 1);
+
+	uart_dma_disable(pxTxStream);
+	uart_dma_disable(pxRxStream);
+
+	pxHw->pxUart->CR1 = 0;
+	pxHw->pxUart->CR2 = 0;
+	pxHw->pxUart->CR3 = 0;
+
+	memset(pxState, 0, sizeof(*pxState));
+	pxState->xTxLanes[UART_LANE_BULK].pucRing = pxCfg->pucTxBuf;
+	pxState->xTxLanes[UART_LANE_BULK].usSize = (pxCfg->pucTxBuf != NULL) ? pxCfg->usTxSize : 0U;
+	pxState->pucRxRing = pxCfg->pucRxBuf;
+	pxState->usRxSize = (pxCfg->pucRxBuf != NULL) ? pxCfg->usRxSize : 0U;
+
+	if (uart_apply_baud_rate(xPort, pxCfg->ulBaudRate) != 0)
+	{
+		return -1;
+	}
+
+	pxHw->pxUart->CR1 |= (1U << USART_CR1_TE_OFS) | (1U << USART_CR1_RE_OFS);
+
+	if (pxState->xTxLanes[UART_LANE_BULK].pucRing != NULL)
+	{
+		pxTxStream->PAR = (uint32_t)&pxHw->pxUart->DR;
+		pxTxStream->CR = ((uint32_t)pxHw->ucChannel << DMA_SxCR_CHSEL_OFS)
+				| (1U << DMA_SxCR_MINC_OFS)			/* Increment memory. */
+				| (1U << DMA_SxCR_DIR_OFS)			/* Memory-to-peripheral. */
+				| (1U << DMA_SxCR_TCIE_OFS);		/* TC interrupt. */
+		pxTxStream->FCR = 0;	/* Direct mode. */
+
+		/* Let the USART issue TX DMA requests. */
+		pxHw->pxUart->CR3 |= (1U << USART_CR3_DMAT_OFS);
+
+		NVIC_SetPriority(pxHw->xTxIrq, UART_IRQ_PRIORITY);
+		NVIC_EnableIRQ(pxHw->xTxIrq);
+	}
+
+	if (pxState->pucRxRing != NULL)
+	{
+		pxRxStream->PAR = (uint32_t)&pxHw->pxUart->DR;
+		pxRxStream->M0AR = (uint32_t)pxState->pucRxRing;
+		pxRxStream->NDTR = pxState->usRxSize;
+		pxRxStream->CR = ((uint32_t)pxHw->ucChannel << DMA_SxCR_CHSEL_OFS)
+				| (2U << DMA_SxCR_PL_OFS)			/* High priority. */
+				| (1U << DMA_SxCR_MINC_OFS)
+				| (1U << DMA_SxCR_CIRC_OFS)			/* Peripheral-to-memory, circular. */
+				| (1U << DMA_SxCR_TCIE_OFS)
+				| (1U << DMA_SxCR_HTIE_OFS);
+		pxRxStream->FCR = 0;
+		pxRxStream->CR |= (1U << DMA_SxCR_EN_OFS);
+
+		pxHw->pxUart->CR3 |= (1U << USART_CR3_DMAR_OFS) | (1U << USART_CR3_EIE_OFS);
+		pxHw->pxUart->CR1 |= (1U << USART_CR1_IDLEIE_OFS);
+
+		NVIC_SetPriority(pxHw->xRxIrq, UART_IRQ_PRIORITY);
+		NVIC_EnableIRQ(pxHw->xRxIrq);
+		NVIC_SetPriority(pxHw->xUartIrq, UART_IRQ_PRIORITY);
+		NVIC_EnableIRQ(pxHw->xUartIrq);
+	}
+
+	pxState->ucOpen = 1;
+
+	return 0;
+}
+
+/**
+ * @brief Queues bytes for transmission on lane 0.
+ * @param xPort Open port.
+ * @param pvData Bytes to send.
+ * @param ulLen Number of bytes.
+ * @param xTicksToWait How long a task waits for room in a full TX ring.
+ * @retval As uart_write_lane().
+ */
+int32_t uart_write(UartPort_t xPort, const void *pvData, uint32_t ulLen, TickType_t xTicksToWait)
+{
+	return uart_write_lane(xPort, UART_LANE_BULK, pvData, ulLen, xTicksToWait);
+}
+
+/**
+ * @brief Queues bytes for transmission on a lane.
+ * @param xPort Open port.
+ * @param ulLane UART_LANE_BULK, or a lane attached with uart_attach_tx_lane().
+ * @param pvData Bytes to send.
+ * @param ulLen Number of bytes.
+ * @param xTicksToWait How long a task waits for room in a full TX ring.
+ * @retval Number of bytes queued (or sent, without a TX ring), -1 if the port
+ * is not open or the lane not attached.
+ * @note Returns once the bytes are in the ring. From an ISR, before the
+ * scheduler starts or with interrupts masked, it spins on a full ring rather
+ * than block, so such callers must not let it fill up. One task at a time
+ * blocks on a lane; other writers poll it once per tick. Bytes left out when
+ * it gives up are counted as dropped on the lane.
+ */
+int32_t uart_write_lane(UartPort_t xPort, uint32_t ulLane, const void *pvData, uint32_t ulLen,
+		TickType_t xTicksToWait)
+{
+	const uint8_t *pucData = (const uint8_t *)pvData;
+	UartState_t *pxState;
+	UartLane_t *pxLane;
+	TimeOut_t xTimeOut;
+	uint32_t ulQueued = 0;
+	uint32_t ulPrimask;
+	uint16_t usFree;
+	BaseType_t xCanBlock;
+	BaseType_t xWaiting;
+
+	if ((xPort >= UART_PORTS) || (xUartState[xPort].ucOpen == 0U) || (ulLane >= UART_TX_LANES)
+			|| ((ulLane != UART_LANE_BULK) && (xUartState[xPort].xTxLanes[ulLane].pucRing == NULL)))
+	{
+		return -1;
+	}
+
+	pxState = &xUartState[xPort];
+	pxLane = &pxState->xTxLanes[ulLane];
+
+	if (pxLane->pucRing == NULL)
+	{
+		for (ulQueued = 0; ulQueued < ulLen; ulQueued++)
+		{
+			while (!(xUartHw[xPort].pxUart->SR & (1U << USART_SR_TXE_OFS))){}
+			xUartHw[xPort].pxUart->DR = pucData[ulQueued];
+		}
+
+		pxState->xStats.ulTxBytes += ulLen;
+
+		return (int32_t)ulLen;
+	}
+
+	xCanBlock = (__get_IPSR() == 0U) && (__get_PRIMASK() == 0U) && (__get_BASEPRI() == 0U)
+			&& (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING);
+	vTaskSetTimeOutState(&xTimeOut);
+
+	while (ulQueued < ulLen)
+	{
+		xWaiting = pdFALSE;
+
+		ulPrimask = __get_PRIMASK();
+		__disable_irq();
+
+		usFree = uart_tx_free(pxLane);
+
+		while ((usFree > 0U) && (ulQueued < ulLen))
+		{
+			pxLane->pucRing[pxLane->usHead] = pucData[ulQueued++];
+			pxLane->usHead = (uint16_t)((pxLane->usHead + 1U) % pxLane->usSize);
+			usFree--;
+		}
+
+		if (pxState->usTxDmaLen == 0U)
+		{
+			uart_tx_kick(xPort);
+		}
+
+		if ((ulQueued < ulLen) && (xTicksToWait != 0U) && xCanBlock
+				&& (pxLane->xWaiter == NULL))
+		{
+			pxLane->xWaiter = xTaskGetCurrentTaskHandle();
+			xWaiting = pdTRUE;
+		}
+
+		__set_PRIMASK(ulPrimask);
+
+		if (ulQueued == ulLen)
+		{
+			break;
+		}
+
+		if (xTicksToWait == 0U)
+		{
+			break;
+		}
+
+		/* Ring full: let the DMA make room before copying the rest. */
+		if (xCanBlock)
+		{
+			if (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE)
+			{
+				if (xWaiting)
+				{
+					pxLane->xWaiter = NULL;
+				}
+
+				break;
+			}
+
+			if (xWaiting)
+			{
+				(void)ulTaskNotifyTakeIndexed(UART_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+				pxLane->xWaiter = NULL;
+			}
+			else
+			{
+				vTaskDelay(1);
+			}
+		}
+	}
+
+	if (ulQueued < ulLen)
+	{
+		ulPrimask = __get_PRIMASK();
+		__disable_irq();
+		pxState->xStats.ulTxDropped[ulLane] += ulLen - ulQueued;
+		__set_PRIMASK(ulPrimask);
+	}
+
+	return (int32_t)ulQueued;
+}
+
+/**
+ * @brief Attaches a ring to a TX lane above 0.
+ * @param xPort Port opened with a TX buffer.
+ * @param ulLane 1 to UART_TX_LANES - 1; a higher lane goes first.
+ * @param pucBuf Ring, owned by the port until it is opened again.
+ * @param usSize Size of pucBuf, 2 or more.
+ * @retval 0 if successful, -1 if the port is not open or has no TX ring, or
+ * the lane is already attached.
+ * @note From then on, TX DMA chunks are cut at UART_TX_LANE_CHUNK bytes, so a
+ * write to a higher lane waits for one chunk at most. It can land inside a
+ * line of a lower lane, so it is best started with a line break.
+ */
+int32_t uart_attach_tx_lane(UartPort_t xPort, uint32_t ulLane, uint8_t *pucBuf, uint16_t usSize)
+{
+	UartLane_t *pxLane;
+	uint32_t ulPrimask;
+
+	if ((xPort >= UART_PORTS) || (xUartState[xPort].ucOpen == 0U)
+			|| (xUartState[xPort].xTxLanes[UART_LANE_BULK].pucRing == NULL)
+			|| (ulLane == UART_LANE_BULK) || (ulLane >= UART_TX_LANES)
+			|| (pucBuf == NULL) || (usSize < 2U)
+			|| (xUartState[xPort].xTxLanes[ulLane].pucRing != NULL))
+	{
+		return -1;
+	}
+
+	pxLane = &xUartState[xPort].xTxLanes[ulLane];
+
+	ulPrimask = __get_PRIMASK();
+	__disable_irq();
+
+	pxLane->usSize = usSize;
+	pxLane->usHead = 0;
+	pxLane->usTail = 0;
+	pxLane->pucRing = pucBuf;
+	xUartState[xPort].ucTxChunked = 1;
+
+	__set_PRIMASK(ulPrimask);
+
+	return 0;
+}
+
+/**
+ * @brief Reads received bytes.
+ * @param xPort Port opened with an RX buffer.
+ * @param pvData Buffer for the bytes.
+ * @param ulLen Size of pvData.
+ * @param xTicksToWait How long to wait for the first byte.
+ * @retval Number of bytes read, 0 on timeout, -1 if the port has no RX ring.
+ * @note Returns what has arrived, up to ulLen, as soon as there is any. One
+ * task reads a port. A reader more than a whole RX ring behind loses what it
+ * has not read and the overrun is counted.
+ */
+int32_t uart_read(UartPort_t xPort, void *pvData, uint32_t ulLen, TickType_t xTicksToWait)
+{
+	uint8_t *pucData = (uint8_t *)pvData;
+	UartState_t *pxState;
+	TimeOut_t xTimeOut;
+	uint32_t ulAvailable;
+	uint32_t ulOffset;
+	uint32_t ulFirst;
+
+	if ((xPort >= UART_PORTS) || (xUartState[xPort].ucOpen == 0U)
+			|| (xUartState[xPort].pucRxRing == NULL))
+	{
+		return -1;
+	}
+
+	pxState = &xUartState[xPort];
+	vTaskSetTimeOutState(&xTimeOut);
+
+	for (;;)
+	{
+		taskENTER_CRITICAL();
+		uart_rx_sync(xPort);
+		ulAvailable = pxState->ulRxHead - pxState->ulRxTail;
+
+		if (ulAvailable > pxState->usRxSize)
+		{
+			pxState->ulRxTail = pxState->ulRxHead;
+			pxState->xStats.ulRxOverruns++;
+			ulAvailable = 0;
+		}
+
+		pxState->xRxWaiter = (ulAvailable == 0U) ? xTaskGetCurrentTaskHandle() : NULL;
+		taskEXIT_CRITICAL();
+
+		if (ulAvailable == 0U)
+		{
+			if ((xTicksToWait == 0U) || (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE))
+			{
+				pxState->xRxWaiter = NULL;
+				return 0;
+			}
+
+			/* HT, TC or IDLE wakes the task; anything else just loops. */
+			(void)ulTaskNotifyTakeIndexed(UART_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+			continue;
+		}
+
+		if (ulAvailable > ulLen)
+		{
+			ulAvailable = ulLen;
+		}
+
+		ulOffset = pxState->ulRxTail % pxState->usRxSize;
+		ulFirst = pxState->usRxSize - ulOffset;
+
+		if (ulFirst > ulAvailable)
+		{
+			ulFirst = ulAvailable;
+		}
+
+		memcpy(pucData, &pxState->pucRxRing[ulOffset], ulFirst);
+		memcpy(&pucData[ulFirst], pxState->pucRxRing, ulAvailable - ulFirst);
+
+		/* The copy is valid if the DMA has not lapped the tail meanwhile. */
+		taskENTER_CRITICAL();
+		uart_rx_sync(xPort);
+
+		if ((pxState->ulRxHead - pxState->ulRxTail) > pxState->usRxSize)
+		{
+			pxState->ulRxTail = pxState->ulRxHead;
+			pxState->xStats.ulRxOverruns++;
+			taskEXIT_CRITICAL();
+			continue;
+		}
+
+		pxState->ulRxTail += ulAvailable;
+		pxState->xStats.ulRxBytes += ulAvailable;
+		taskEXIT_CRITICAL();
+
+		return (int32_t)ulAvailable;
+	}
+}
+
+/**
+ * @brief Reads one byte, spinning while a burst lasts and blocking between
+ * bursts.
+ * @param xPort Port opened without an RX buffer.
+ * @param pucByte Where to store the byte.
+ * @param xTicksToWait Longest time to block once the line is quiet.
+ * @retval 1 if a byte was read, 0 on time-out, -1 if the port is not open or
+ * has an RX buffer.
+ * @note The spin window ends UART_RX_SPIN_GAPS average gaps after the last
+ * byte, within UART_RX_SPIN_MIN_US and UART_RX_SPIN_MAX_US. A gap longer than
+ * UART_RX_SPIN_MAX_US ends a burst and is left out of the average, so an idle
+ * line neither widens the window nor is spun on. Spinning holds the CPU below
+ * the caller's priority, so give the reader a low one. One reader per port.
+ */
+int32_t uart_read_adaptive(UartPort_t xPort, uint8_t *pucByte, TickType_t xTicksToWait)
+{
+	USART_TypeDef *pxUart;
+	UartState_t *pxState;
+	TimeOut_t xTimeOut;
+	uint32_t ulCyclesPerUs;
+	uint32_t ulSpin;
+	uint32_t ulGap;
+	uint8_t ucWoken = 0;
+
+	if ((xPort >= UART_PORTS) || (xUartState[xPort].ucOpen == 0U)
+			|| (xUartState[xPort].pucRxRing != NULL) || (pucByte == NULL))
+	{
+		return -1;
+	}
+
+	pxUart = xUartHw[xPort].pxUart;
+	pxState = &xUartState[xPort];
+	ulCyclesPerUs = SystemCoreClock / 1000000U;
+	ulSpin = uart_rx_spin_cycles(pxState, ulCyclesPerUs);
+	vTaskSetTimeOutState(&xTimeOut);
+
+	/* Spin out what is left of the window opened by the last byte. */
+	while (!(pxUart->SR & (1U << USART_SR_RXNE_OFS))
+			&& ((DWT->CYCCNT - pxState->ulRxLastCycles) < ulSpin)) {}
+
+	while (!(pxUart->SR & (1U << USART_SR_RXNE_OFS)))
+	{
+		if ((xTicksToWait == 0U) || (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE))
+		{
+			return 0;
+		}
+
+		/* Set with RXNE already up, RXNEIE interrupts at once, so a byte
+		 * received meanwhile is not missed. uart_irq() clears it again. */
+		taskENTER_CRITICAL();
+		pxState->xRxWaiter = xTaskGetCurrentTaskHandle();
+		pxUart->CR1 |= (1U << USART_CR1_RXNEIE_OFS);
+		taskEXIT_CRITICAL();
+
+		NVIC_SetPriority(xUartHw[xPort].xUartIrq, UART_IRQ_PRIORITY);
+		NVIC_EnableIRQ(xUartHw[xPort].xUartIrq);
+
+		(void)ulTaskNotifyTakeIndexed(UART_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+
+		taskENTER_CRITICAL();
+		pxUart->CR1 &= ~(1U << USART_CR1_RXNEIE_OFS);
+		pxState->xRxWaiter = NULL;
+		taskEXIT_CRITICAL();
+
+		ucWoken = 1;
+	}
+
+	/* SR then DR read also clears ORE. */
+	*pucByte = (uint8_t)pxUart->DR;
+
+	ulGap = DWT->CYCCNT - pxState->ulRxLastCycles;
+	pxState->ulRxLastCycles += ulGap;
+
+	if (ulGap <= (UART_RX_SPIN_MAX_US * ulCyclesPerUs))
+	{
+		pxState->ulRxGapCycles = (uint32_t)((int32_t)pxState->ulRxGapCycles
+				+ (((int32_t)ulGap - (int32_t)pxState->ulRxGapCycles) >> UART_RX_GAP_SHIFT));
+	}
+
+	taskENTER_CRITICAL();
+	pxState->xStats.ulRxBytes++;
+
+	if (ucWoken)
+	{
+		pxState->xStats.ulRxWoken++;
+	}
+	else
+	{
+		pxState->xStats.ulRxSpun++;
+	}
+
+	taskEXIT_CRITICAL();
+
+	return 1;
+}
+
+/**
+ * @brief Waits until every queued byte has left the shift register.
+ * @param xPort Port.
+ * @retval None
+ * @note Busy-waits, so it also works with the scheduler suspended.
+ */
+void uart_flush(UartPort_t xPort)
+{
+	UartState_t *pxState;
+	const UartLane_t *pxLane;
+	uint32_t ulLane;
+
+	if ((xPort >= UART_PORTS) || (xUartState[xPort].ucOpen == 0U))
+	{
+		return;
+	}
+
+	pxState = &xUartState[xPort];
+
+	for (ulLane = 0; ulLane < UART_TX_LANES; ulLane++)
+	{
+		pxLane = &pxState->xTxLanes[ulLane];
+
+		while ((pxState->usTxDmaLen != 0U) || (pxLane->usHead != pxLane->usTail)){}
+	}
+
+	while (!(xUartHw[xPort].pxUart->SR & (1U << USART_SR_TC_OFS))){}
+}
+
+/**
+ * @brief Changes the baud rate of an open port, keeping everything else.
+ * @param xPort Port.
+ * @param ulBaudRate Baud rate, up to PCLK / 8.
+ * @retval 0 if successful, -1 if the baud rate cannot be reached, or the port
+ * is not open. The rate is then unchanged.
+ * @note Waits for the queued bytes to go out at the old rate first. A byte
+ * being received during the switch is lost.
+ */
+int32_t uart_set_baud_rate(UartPort_t xPort, uint32_t ulBaudRate)
+{
+	uint32_t ulBrr;
+	uint32_t ulOver8;
+	uint32_t ulActual;
+
+	if ((xPort >= UART_PORTS) || (xUartState[xPort].ucOpen == 0U)
+			|| (uart_compute_brr(uart_pclk(&xUartHw[xPort]), ulBaudRate, &ulBrr, &ulOver8,
+					&ulActual) != 0))
+	{
+		return -1;
+	}
+
+	uart_flush(xPort);
+
+	return uart_apply_baud_rate(xPort, ulBaudRate);
+}
+
+/**
+ * @brief Returns the baud rate in effect.
+ * @param xPort Port.
+ * @retval PCLK / USARTDIV, which differs from the requested rate by the
+ * rounding of BRR; 0 if the port is not open.
+ */
+uint32_t uart_get_baud_rate(UartPort_t xPort)
+{
+	if ((xPort >= UART_PORTS) || (xUartState[xPort].ucOpen == 0U))
+	{
+		return 0;
+	}
+
+	return xUartState[xPort].ulActualBaudRate;
+}
+
+/**
+ * @brief Reads the counters of a port since it was opened.
+ * @param xPort Port.
+ * @param pxStats Filled with the counters.
+ * @retval 0 if successful, -1 if the port is not open.
+ */
+int32_t uart_get_stats(UartPort_t xPort, UartStats_t *pxStats)
+{
+	if ((xPort >= UART_PORTS) || (xUartState[xPort].ucOpen == 0U) || (pxStats == NULL))
+	{
+		return -1;
+	}
+
+	taskENTER_CRITICAL();
+	*pxStats = xUartState[xPort].xStats;
+	taskEXIT_CRITICAL();
+
+	pxStats->ulRxSpinUs = uart_rx_spin_cycles(&xUartState[xPort], SystemCoreClock / 1000000U)
+			/ (SystemCoreClock / 1000000U);
+
+	return 0;
+}
+
+/**
+ * @brief Recomputes the baud rate divider of an open port after a clock switch.
+ * @param pxUart USART whose APB clock changed.
+ * @retval 0 if this driver opened pxUart and set its divider, -1 otherwise
+ * (clock.c then scales the old divider).
+ * @note Called by clock_set_profile() with the transmitters drained.
+ */
+int32_t clock_uart_retune(USART_TypeDef *pxUart)
+{
+	uint32_t x;
+
+	for (x = 0; x < UART_PORTS; x++)
+	{
+		if ((xUartHw[x].pxUart == pxUart) && (xUartState[x].ucOpen != 0U))
+		{
+			return uart_apply_baud_rate((UartPort_t)x, xUartState[x].ulRequestedBaudRate);
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Opens USART2 full duplex, with the console TX ring and its urgent
+ * lane.
+ * @param ulBaudRate Baud rate, up to PCLK1 / 8.
+ * @retval 0 if successful, -1 if the baud rate cannot be reached within
+ * UART_BAUD_TOLERANCE_PPM at the current PCLK1. USART2 is then unchanged.
+ * @note The receiver is left to the application. To change the rate without
+ * re-initializing, use USART2_set_baud_rate().
+ */
+int32_t USART2_UART_Open(uint32_t ulBaudRate)
+{
+	UartConfig_t xCfg = { ulBaudRate, ucUsart2TxRing, UART_TX_RING_SIZE, NULL, 0 };
+
+	if (uart_open(UART_PORT_2, &xCfg) != 0)
+	{
+		return -1;
+	}
+
+#if (UART_TX_LANES > 1U) && (UART_TX_URGENT_RING_SIZE > 0)
+	(void)uart_attach_tx_lane(UART_PORT_2, UART_LANE_URGENT, ucUsart2UrgentRing,
+			UART_TX_URGENT_RING_SIZE);
+#endif
+
+	return 0;
+}
+
+/**
+ * @brief Changes the USART2 baud rate, keeping everything else.
+ * @param ulBaudRate Baud rate, up to PCLK1 / 8.
+ * @retval As uart_set_baud_rate().
+ */
+int32_t USART2_set_baud_rate(uint32_t ulBaudRate)
+{
+	return uart_set_baud_rate(UART_PORT_2, ulBaudRate);
+}
+
+/**
+ * @brief Returns the USART2 baud rate in effect.
+ * @param None
+ * @retval As uart_get_baud_rate().
+ */
+uint32_t USART2_get_baud_rate(void)
+{
+	return uart_get_baud_rate(UART_PORT_2);
+}
 
 /**
  * @brief USART2 TX Initialization Function
  * @param None
  * @retval None
+ * @note Opens USART2 full duplex at UART_DEFAULT_BAUD_RATE.
  */
 void USART2_UART_TX_Init(void)
 {
-	huart2.Instance = USART2;
-	huart2.Init.BaudRate = 115200;
-	huart2.Init.WordLength = UART_WORDLENGTH_8B;
-	huart2.Init.StopBits = UART_STOPBITS_1;
-	huart2.Init.Parity = UART_PARITY_NONE;
-	huart2.Init.Mode = UART_MODE_TX;
-	huart2.Init.HwFlowCtl = UART_HWCONTROL_NONE;
-	huart2.Init.OverSampling = UART_OVERSAMPLING_16;
-	if (HAL_UART_Init(&huart2) != HAL_OK)
-	{
-		/* Do nothing */
-	}
+	(void)USART2_UART_Open(UART_DEFAULT_BAUD_RATE);
 }
 
 /**
  * @brief USART2 RX Initialization Function
  * @param None
  * @retval None
+ * @note The same as USART2_UART_TX_Init(): the receiver and the transmitter
+ * are both enabled, so printing keeps working. Does nothing if USART2 is
+ * already open.
  */
 void USART2_UART_RX_Init(void)
 {
-	huart2.Instance = USART2;
-	huart2.Init.BaudRate = 115200;
-	huart2.Init.WordLength = UART_WORDLENGTH_8B;
-	huart2.Init.StopBits = UART_STOPBITS_1;
-	huart2.Init.Parity = UART_PARITY_NONE;
-	huart2.Init.Mode = UART_MODE_RX;
-	huart2.Init.HwFlowCtl = UART_HWCONTROL_NONE;
-	huart2.Init.OverSampling = UART_OVERSAMPLING_16;
-	if (HAL_UART_Init(&huart2) != HAL_OK)
+	if (xUartState[UART_PORT_2].ucOpen == 0U)
 	{
-		/* Do nothing */
+		(void)USART2_UART_Open(UART_DEFAULT_BAUD_RATE);
 	}
 }
 
@@ -83,6 +921,21 @@ char USART2_read(void)
 	return USART2->DR;
 }
 
+/**
+ * @brief Reads a character over USART2, blocking while the line is quiet.
+ * @param None
+ * @retval Received character.
+ * @note See uart_read_adaptive().
+ */
+char USART2_read_adaptive(void)
+{
+	uint8_t ucByte = 0;
+
+	while (uart_read_adaptive(UART_PORT_2, &ucByte, portMAX_DELAY) == 0) {}
+
+	return (char)ucByte;
+}
+
 /**
  * @brief Retargets the C library printf function to UART.
  * @note This function is typically used when you want printf() output to be
@@ -96,3 +949,502 @@ int __io_putchar(int ch)
 
 	return ch;
 }
+
+/**
+ * @brief Queues a buffer for transmission over USART2 via DMA.
+ * @note Returns as soon as the bytes are in the TX ring. If the ring is full
+ * the caller waits for the DMA to drain it, so nothing is ever dropped. Before
+ * USART2 is open the bytes are written polled.
+ * @param ptr Bytes to send.
+ * @param len Number of bytes.
+ * @retval Number of bytes queued.
+ */
+int USART2_write_buffer(const char *ptr, int len)
+{
+	int iQueued;
+
+	if (xUartState[UART_PORT_2].ucOpen == 0U)
+	{
+		for (iQueued = 0; iQueued < len; iQueued++)
+		{
+			USART2_write(ptr[iQueued]);
+		}
+
+		return len;
+	}
+
+	return (int)uart_write(UART_PORT_2, ptr, (uint32_t)len, portMAX_DELAY);
+}
+
+/**
+ * @brief Queues a buffer on the USART2 urgent lane, ahead of whatever
+ * USART2_write_buffer() queued and the DMA has not started yet.
+ * @note Waits for room in the urgent ring only, which nothing but urgent
+ * output fills. Before USART2_UART_Open(), or without an urgent lane, it is
+ * USART2_write_buffer().
+ * @param ptr Bytes to send.
+ * @param len Number of bytes.
+ * @retval Number of bytes queued.
+ */
+int USART2_write_urgent(const char *ptr, int len)
+{
+#if (UART_TX_LANES > 1U) && (UART_TX_URGENT_RING_SIZE > 0)
+	if (xUartState[UART_PORT_2].xTxLanes[UART_LANE_URGENT].pucRing != NULL)
+	{
+		return (int)uart_write_lane(UART_PORT_2, UART_LANE_URGENT, ptr, (uint32_t)len,
+				portMAX_DELAY);
+	}
+#endif
+
+	return USART2_write_buffer(ptr, len);
+}
+
+/**
+ * @brief Waits until every queued byte has left the USART2 shift register.
+ * @param None
+ * @retval None
+ */
+void USART2_flush(void)
+{
+	uart_flush(UART_PORT_2);
+}
+
+/**
+ * @brief Buffer-level output hook called by _write() in syscalls.c.
+ * @param ptr Bytes to send.
+ * @param len Number of bytes.
+ * @retval Number of bytes queued.
+ */
+int __io_putbuf(char *ptr, int len)
+{
+	return USART2_write_buffer(ptr, len);
+}
+
+/* Interrupt handlers, one line each: the port table does the rest. The USART
+ * ones are weak so that projects with their own per-byte handler keep it. */
+#if (UART_USE_USART1 == 1)
+__attribute__((weak)) void USART1_IRQHandler(void) { uart_irq(UART_PORT_1); }
+void DMA2_Stream7_IRQHandler(void) { uart_tx_dma_irq(UART_PORT_1); }
+void DMA2_Stream5_IRQHandler(void) { uart_rx_dma_irq(UART_PORT_1); }
+#endif
+
+#if (UART_USE_USART2 == 1)
+__attribute__((weak)) void USART2_IRQHandler(void) { uart_irq(UART_PORT_2); }
+void DMA1_Stream6_IRQHandler(void) { uart_tx_dma_irq(UART_PORT_2); }
+void DMA1_Stream5_IRQHandler(void) { uart_rx_dma_irq(UART_PORT_2); }
+#endif
+
+#if (UART_USE_USART3 == 1)
+__attribute__((weak)) void USART3_IRQHandler(void) { uart_irq(UART_PORT_3); }
+void DMA1_Stream3_IRQHandler(void) { uart_tx_dma_irq(UART_PORT_3); }
+void DMA1_Stream1_IRQHandler(void) { uart_rx_dma_irq(UART_PORT_3); }
+#endif
+
+#if (UART_USE_UART4 == 1)
+__attribute__((weak)) void UART4_IRQHandler(void) { uart_irq(UART_PORT_4); }
+void DMA1_Stream4_IRQHandler(void) { uart_tx_dma_irq(UART_PORT_4); }
+void DMA1_Stream2_IRQHandler(void) { uart_rx_dma_irq(UART_PORT_4); }
+#endif
+
+#if (UART_USE_UART5 == 1)
+__attribute__((weak)) void UART5_IRQHandler(void) { uart_irq(UART_PORT_5); }
+void DMA1_Stream7_IRQHandler(void) { uart_tx_dma_irq(UART_PORT_5); }
+void DMA1_Stream0_IRQHandler(void) { uart_rx_dma_irq(UART_PORT_5); }
+#endif
+
+#if (UART_USE_USART6 == 1)
+__attribute__((weak)) void USART6_IRQHandler(void) { uart_irq(UART_PORT_6); }
+void DMA2_Stream6_IRQHandler(void) { uart_tx_dma_irq(UART_PORT_6); }
+void DMA2_Stream1_IRQHandler(void) { uart_rx_dma_irq(UART_PORT_6); }
+#endif
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Returns a stream of the port's DMA controller.
+ * @param pxHw Port.
+ * @param ucStream Stream number, 0 to 7.
+ * @retval Stream registers.
+ */
+static DMA_Stream_TypeDef *uart_dma_stream(const UartHw_t *pxHw, uint8_t ucStream)
+{
+	/* Streams follow the controller's interrupt registers, 0x18 bytes apart. */
+	return (DMA_Stream_TypeDef *)((uint32_t)pxHw->pxDma + 0x10U + (0x18U * ucStream));
+}
+
+/**
+ * @brief Returns the interrupt flags of a stream, shifted down to bit 0.
+ * @param pxHw Port.
+ * @param ucStream Stream number, 0 to 7.
+ * @retval FEIF (bit 0), DMEIF (2), TEIF (3), HTIF (4) and TCIF (5).
+ */
+static uint32_t uart_dma_flags(const UartHw_t *pxHw, uint8_t ucStream)
+{
+	static const uint8_t ucShift[4] = { 0, 6, 16, 22 };
+	uint32_t ulIsr = (ucStream < 4U) ? pxHw->pxDma->LISR : pxHw->pxDma->HISR;
+
+	return (ulIsr >> ucShift[ucStream & 3U]) & DMA_FLAGS_MASK;
+}
+
+/**
+ * @brief Clears the interrupt flags of a stream.
+ * @param pxHw Port.
+ * @param ucStream Stream number, 0 to 7.
+ * @retval None
+ */
+static void uart_dma_clear(const UartHw_t *pxHw, uint8_t ucStream)
+{
+	static const uint8_t ucShift[4] = { 0, 6, 16, 22 };
+
+	if (ucStream < 4U)
+	{
+		pxHw->pxDma->LIFCR = DMA_FLAGS_MASK << ucShift[ucStream];
+	}
+	else
+	{
+		pxHw->pxDma->HIFCR = DMA_FLAGS_MASK << ucShift[ucStream - 4U];
+	}
+}
+
+/**
+ * @brief Disables a stream and waits until it is really off.
+ * @param pxStream Stream.
+ * @retval None
+ */
+static void uart_dma_disable(DMA_Stream_TypeDef *pxStream)
+{
+	pxStream->CR &= ~(1U << DMA_SxCR_EN_OFS);
+	while (pxStream->CR & (1U << DMA_SxCR_EN_OFS)){}
+}
+
+/**
+ * @brief Switches a pin to its USART alternate function.
+ * @param pxPort GPIO port.
+ * @param ucPin Pin number.
+ * @param ucAf Alternate function number.
+ * @param ucPullUp 1 for the RX pin, which idles high.
+ * @retval None
+ */
+static void uart_pin_init(GPIO_TypeDef *pxPort, uint8_t ucPin, uint8_t ucAf, uint8_t ucPullUp)
+{
+	uint32_t ulShift2 = 2U * ucPin;
+	uint32_t ulShift4 = 4U * (ucPin & 7U);
+
+	pxPort->AFR[ucPin >> 3] = (pxPort->AFR[ucPin >> 3] & ~(0xFU << ulShift4))
+			| ((uint32_t)ucAf << ulShift4);
+	pxPort->OTYPER &= ~(1U << ucPin);
+	pxPort->OSPEEDR = (pxPort->OSPEEDR & ~(3U << ulShift2)) | (PIN_SPEED_FAST << ulShift2);
+	pxPort->PUPDR = (pxPort->PUPDR & ~(3U << ulShift2))
+			| ((ucPullUp ? PIN_PULL_UP : 0U) << ulShift2);
+	pxPort->MODER = (pxPort->MODER & ~(3U << ulShift2)) | (PIN_MODE_AF << ulShift2);
+}
+
+/**
+ * @brief Starts a DMA transfer of the next contiguous chunk of the highest
+ * lane with bytes queued, if any.
+ * @note Called with the ring locked or from the DMA ISR.
+ * @param xPort Port.
+ * @retval None
+ */
+static void uart_tx_kick(UartPort_t xPort)
+{
+	const UartHw_t *pxHw = &xUartHw[xPort];
+	UartState_t *pxState = &xUartState[xPort];
+	DMA_Stream_TypeDef *pxStream = uart_dma_stream(pxHw, pxHw->ucTxStream);
+	const UartLane_t *pxLane;
+	uint32_t ulLane;
+	uint16_t usHead;
+	uint16_t usTail;
+	uint16_t usLen;
+
+	/* The highest lane with bytes queued, lane 0 last. */
+	for (ulLane = UART_TX_LANES - 1U; ulLane > UART_LANE_BULK; ulLane--)
+	{
+		if (pxState->xTxLanes[ulLane].usHead != pxState->xTxLanes[ulLane].usTail)
+		{
+			break;
+		}
+	}
+
+	pxLane = &pxState->xTxLanes[ulLane];
+	usHead = pxLane->usHead;
+	usTail = pxLane->usTail;
+
+	if (usHead == usTail)
+	{
+		return;
+	}
+
+	usLen = (usHead > usTail) ? (usHead - usTail) : (pxLane->usSize - usTail);
+
+	if (pxState->ucTxChunked && (usLen > UART_TX_LANE_CHUNK))
+	{
+		usLen = UART_TX_LANE_CHUNK;
+	}
+
+	pxState->ucTxLane = (uint8_t)ulLane;
+	pxState->usTxDmaLen = usLen;
+	uart_dma_clear(pxHw, pxHw->ucTxStream);
+	pxStream->M0AR = (uint32_t)&pxLane->pucRing[usTail];
+	pxStream->NDTR = usLen;
+
+	/* Clear USART TC (rc_w0), then start the stream. */
+	pxHw->pxUart->SR = ~(1U << USART_SR_TC_OFS);
+	pxStream->CR |= (1U << DMA_SxCR_EN_OFS);
+}
+
+/**
+ * @brief Returns the number of free bytes in a TX lane.
+ * @note One slot is kept empty to tell a full ring from an empty one.
+ * @param pxLane Lane.
+ * @retval Free bytes.
+ */
+static uint16_t uart_tx_free(const UartLane_t *pxLane)
+{
+	return (uint16_t)((pxLane->usTail + pxLane->usSize - pxLane->usHead - 1U) % pxLane->usSize);
+}
+
+/**
+ * @brief Advances the RX head to the DMA write position.
+ * @param xPort Port opened with an RX buffer.
+ * @retval None
+ * @note Called in a critical section or from the port's interrupts. HT and TC
+ * fire at least twice per lap, so the position never moves by a whole ring
+ * between two calls.
+ */
+static void uart_rx_sync(UartPort_t xPort)
+{
+	const UartHw_t *pxHw = &xUartHw[xPort];
+	UartState_t *pxState = &xUartState[xPort];
+	uint16_t usPos = pxState->usRxSize - (uint16_t)uart_dma_stream(pxHw, pxHw->ucRxStream)->NDTR;
+
+	if (usPos >= pxState->usRxSize)
+	{
+		usPos = 0;
+	}
+
+	pxState->ulRxHead += (uint32_t)((usPos + pxState->usRxSize - pxState->usRxDmaLast)
+			% pxState->usRxSize);
+	pxState->usRxDmaLast = usPos;
+}
+
+/**
+ * @brief Computes the spin window of uart_read_adaptive().
+ * @param pxState Port state.
+ * @param ulCyclesPerUs Core clock cycles per microsecond.
+ * @retval Window in cycles: UART_RX_SPIN_GAPS average gaps, within
+ * UART_RX_SPIN_MIN_US and UART_RX_SPIN_MAX_US.
+ */
+static uint32_t uart_rx_spin_cycles(const UartState_t *pxState, uint32_t ulCyclesPerUs)
+{
+	uint32_t ulSpin = pxState->ulRxGapCycles * UART_RX_SPIN_GAPS;
+
+	if (ulSpin < (UART_RX_SPIN_MIN_US * ulCyclesPerUs))
+	{
+		ulSpin = UART_RX_SPIN_MIN_US * ulCyclesPerUs;
+	}
+	else if (ulSpin > (UART_RX_SPIN_MAX_US * ulCyclesPerUs))
+	{
+		ulSpin = UART_RX_SPIN_MAX_US * ulCyclesPerUs;
+	}
+
+	return ulSpin;
+}
+
+/**
+ * @brief Returns the clock of a port's APB bus.
+ * @param pxHw Port.
+ * @retval PCLK1 or PCLK2 in Hz.
+ */
+static uint32_t uart_pclk(const UartHw_t *pxHw)
+{
+	return pxHw->ucOnApb2 ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+}
+
+/**
+ * @brief Computes the USART divider for a baud rate.
+ * @param ulPclk USART clock (PCLK1 or PCLK2).
+ * @param ulBaud Baud rate.
+ * @param pulBrr Receives the BRR value.
+ * @param pulOver8 Receives 1 for 8 times oversampling, 0 for 16.
+ * @param pulActual Receives the resulting baud rate.
+ * @retval 0 if successful, -1 if the rate is above PCLK / 8 or off by more
+ * than UART_BAUD_TOLERANCE_PPM.
+ * @note USARTDIV is rounded to the nearest 1/16 (or 1/8), rather than
+ * truncated. 16 times oversampling tolerates more noise, so it is kept
+ * unless 8 times gives a rate within the tolerance that it does not.
+ */
+static int32_t uart_compute_brr(uint32_t ulPclk, uint32_t ulBaud, uint32_t *pulBrr,
+		uint32_t *pulOver8, uint32_t *pulActual)
+{
+	uint32_t ulOver8;
+	uint32_t ulDiv;
+	uint32_t ulActual;
+	uint32_t ulError;
+
+	if (ulBaud == 0U)
+	{
+		return -1;
+	}
+
+	for (ulOver8 = 0; ulOver8 < 2U; ulOver8++)
+	{
+		/* USARTDIV in 1/16 or 1/8 units, at least 1.0, 12 bits of mantissa. */
+		ulDiv = (uint32_t)((((uint64_t)ulPclk << ulOver8) + (ulBaud / 2U)) / ulBaud);
+
+		if ((ulDiv < (16U >> ulOver8)) || (ulDiv > (0xFFFFU >> ulOver8)))
+		{
+			continue;
+		}
+
+		ulActual = (uint32_t)((((uint64_t)ulPclk << ulOver8) + (ulDiv / 2U)) / ulDiv);
+		ulError = (ulActual > ulBaud) ? (ulActual - ulBaud) : (ulBaud - ulActual);
+
+		if (((uint64_t)ulError * 1000000U) > ((uint64_t)ulBaud * UART_BAUD_TOLERANCE_PPM))
+		{
+			continue;
+		}
+
+		*pulBrr = ulOver8 ? (((ulDiv >> 3) << 4) | (ulDiv & 0x7U)) : ulDiv;
+		*pulOver8 = ulOver8;
+		*pulActual = ulActual;
+
+		return 0;
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Programs a port for a baud rate at the current APB clock.
+ * @param xPort Port.
+ * @param ulBaud Baud rate.
+ * @retval 0 if successful, -1 if it cannot be reached (the port is unchanged).
+ * @note OVER8 can only change with the USART disabled, so it is disabled for
+ * the few cycles of the update. The transmitter must be idle.
+ */
+static int32_t uart_apply_baud_rate(UartPort_t xPort, uint32_t ulBaud)
+{
+	USART_TypeDef *pxUart = xUartHw[xPort].pxUart;
+	uint32_t ulBrr;
+	uint32_t ulOver8;
+	uint32_t ulActual;
+
+	if (uart_compute_brr(uart_pclk(&xUartHw[xPort]), ulBaud, &ulBrr, &ulOver8, &ulActual) != 0)
+	{
+		return -1;
+	}
+
+	pxUart->CR1 &= ~(1U << USART_CR1_UE_OFS);
+	pxUart->CR1 = (pxUart->CR1 & ~(1U << USART_CR1_OVER8_OFS)) | (ulOver8 << USART_CR1_OVER8_OFS);
+	pxUart->BRR = ulBrr;
+	pxUart->CR1 |= (1U << USART_CR1_UE_OFS);
+
+	xUartState[xPort].ulRequestedBaudRate = ulBaud;
+	xUartState[xPort].ulActualBaudRate = ulActual;
+
+	return 0;
+}
+
+/**
+ * @brief USART interrupt of a port: idle line and receive errors.
+ * @param xPort Port.
+ * @retval None
+ */
+static void uart_irq(UartPort_t xPort)
+{
+	USART_TypeDef *pxUart = xUartHw[xPort].pxUart;
+	UartState_t *pxState = &xUartState[xPort];
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	uint32_t ulSr = pxUart->SR;
+
+	/* The DMA's next read of DR completes the clearing sequence. */
+	if (ulSr & ((1U << USART_SR_ORE_OFS) | (1U << USART_SR_NE_OFS) | (1U << USART_SR_FE_OFS)))
+	{
+		pxState->xStats.ulRxErrors++;
+	}
+
+	/* uart_read_adaptive() is blocked: leave the byte to it. */
+	if ((pxUart->CR1 & (1U << USART_CR1_RXNEIE_OFS))
+			&& (ulSr & ((1U << USART_SR_RXNE_OFS) | (1U << USART_SR_ORE_OFS))))
+	{
+		pxUart->CR1 &= ~(1U << USART_CR1_RXNEIE_OFS);
+
+		if (pxState->xRxWaiter != NULL)
+		{
+			vTaskNotifyGiveIndexedFromISR(pxState->xRxWaiter, UART_NOTIFY_INDEX,
+					&xHigherPriorityTaskWoken);
+		}
+	}
+
+	if ((ulSr & (1U << USART_SR_IDLE_OFS)) && (pxState->pucRxRing != NULL))
+	{
+		(void)pxUart->DR;	/* SR then DR read clears IDLE. */
+		uart_rx_sync(xPort);
+
+		if (pxState->xRxWaiter != NULL)
+		{
+			vTaskNotifyGiveIndexedFromISR(pxState->xRxWaiter, UART_NOTIFY_INDEX,
+					&xHigherPriorityTaskWoken);
+		}
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief TX DMA interrupt of a port: a chunk has been sent.
+ * @note Retires the chunk that just finished, chains the next one and wakes
+ * a writer waiting for room.
+ * @param xPort Port.
+ * @retval None
+ */
+static void uart_tx_dma_irq(UartPort_t xPort)
+{
+	UartState_t *pxState = &xUartState[xPort];
+	UartLane_t *pxLane = &pxState->xTxLanes[pxState->ucTxLane];
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	uart_dma_clear(&xUartHw[xPort], xUartHw[xPort].ucTxStream);
+
+	pxLane->usTail = (uint16_t)((pxLane->usTail + pxState->usTxDmaLen) % pxLane->usSize);
+	pxState->xStats.ulTxBytes += pxState->usTxDmaLen;
+	pxState->usTxDmaLen = 0;
+
+	uart_tx_kick(xPort);
+
+	if (pxLane->xWaiter != NULL)
+	{
+		vTaskNotifyGiveIndexedFromISR(pxLane->xWaiter, UART_NOTIFY_INDEX,
+				&xHigherPriorityTaskWoken);
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief RX DMA interrupt of a port: half or full ring written.
+ * @param xPort Port.
+ * @retval None
+ */
+static void uart_rx_dma_irq(UartPort_t xPort)
+{
+	UartState_t *pxState = &xUartState[xPort];
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	if (uart_dma_flags(&xUartHw[xPort], xUartHw[xPort].ucRxStream) == 0U)
+	{
+		return;
+	}
+
+	uart_dma_clear(&xUartHw[xPort], xUartHw[xPort].ucRxStream);
+	uart_rx_sync(xPort);
+
+	if (pxState->xRxWaiter != NULL)
+	{
+		vTaskNotifyGiveIndexedFromISR(pxState->xRxWaiter, UART_NOTIFY_INDEX,
+				&xHigherPriorityTaskWoken);
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
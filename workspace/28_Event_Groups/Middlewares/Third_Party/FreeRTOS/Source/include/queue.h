@@ -61,6 +61,39 @@ typedef struct QueueDefinition * QueueSetHandle_t;
  */
 typedef struct QueueDefinition * QueueSetMemberHandle_t;
 
+#if( configUSE_QUEUE_METRICS == 1 )
+	/**
+	 * Counters kept by each queue, semaphore and mutex when
+	 * configUSE_QUEUE_METRICS is 1.  Read with vQueueGetMetrics() or, for the
+	 * queues in the registry, uxQueueGetRegistryMetrics().  They wrap at 2^32.
+	 */
+	typedef struct xQUEUE_METRICS
+	{
+		uint32_t ulSends;			/*< Items sent, or semaphores given. */
+		uint32_t ulReceives;		/*< Items received, or semaphores taken.  Peeks are not counted. */
+		uint32_t ulSendsBlocked;	/*< Times a sending task blocked because the queue was full. */
+		uint32_t ulReceivesBlocked;	/*< Times a receiving (or peeking) task blocked because the queue was empty. */
+		uint32_t ulSendTimeouts;	/*< Sends that gave up after blocking. */
+		uint32_t ulReceiveTimeouts;	/*< Receives (or peeks) that gave up after blocking. */
+		uint32_t ulFullDrops;		/*< Items not sent because the queue was full and no block time was given, ISRs included. */
+		uint32_t ulHighWaterMark;	/*< Most items ever held at once. */
+		uint32_t ulTicksBlocked;	/*< Ticks spent blocked, by senders and receivers together. */
+	} QueueMetrics_t;
+
+	/**
+	 * One queue of the registry, as filled in by uxQueueGetRegistryMetrics().
+	 */
+	typedef struct xQUEUE_REGISTRY_METRICS
+	{
+		const char *pcQueueName; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+		QueueHandle_t xHandle;
+		UBaseType_t uxLength;
+		UBaseType_t uxItemSize;		/*< Bytes per item, 0 for a semaphore or mutex. */
+		UBaseType_t uxMessagesWaiting;
+		QueueMetrics_t xMetrics;
+	} QueueRegistryMetrics_t;
+#endif
+
 /* For internal use only. */
 #define	queueSEND_TO_BACK		( ( BaseType_t ) 0 )
 #define	queueSEND_TO_FRONT		( ( BaseType_t ) 1 )
@@ -1413,6 +1446,8 @@ BaseType_t xQueueCRReceive( QueueHandle_t xQueue, void *pvBuffer, TickType_t xTi
  */
 QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType, StaticQueue_t *pxStaticQueue ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateCeilingMutex( const UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateCeilingMutexStatic( const UBaseType_t uxCeilingPriority, StaticQueue_t *pxStaticQueue ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount, const UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount, const UBaseType_t uxInitialCount, StaticQueue_t *pxStaticQueue ) PRIVILEGED_FUNCTION;
 BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
@@ -1445,6 +1480,9 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  * does not effect the number of queues, semaphores and mutexes that can be
  * created - just the number that the registry can hold.
  *
+ * With configUSE_OBJECT_REGISTRY set to 1 the registry has no size limit, and
+ * adding a queue that is already registered renames it (see registry.h).
+ *
  * @param xQueue The handle of the queue being added to the registry.  This
  * is the handle returned by a call to xQueueCreate().  Semaphore and mutex
  * handles can also be passed in here.
@@ -1487,6 +1525,64 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
 	const char *pcQueueGetName( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 #endif
 
+/*
+ * Looks up a queue, semaphore or mutex of the queue registry by the name it was
+ * registered with, the reverse of pcQueueGetName().  The search compares every
+ * name in the registry, or, with configUSE_OBJECT_REGISTRY set to 1, only those
+ * that share the hash bucket of pcQueueName (see registry.h).
+ *
+ * @param pcQueueName The name to look for.
+ * @return The handle of the first queue found under that name, or NULL if
+ * there is none.
+ */
+#if( configQUEUE_REGISTRY_SIZE > 0 )
+	QueueHandle_t xQueueFindByName( const char *pcQueueName ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+#endif
+
+/*
+ * Copies the counters of a queue, semaphore or mutex into *pxMetrics, all of
+ * them taken at the same instant.  configUSE_QUEUE_METRICS must be 1 in
+ * FreeRTOSConfig.h.
+ *
+ * Gives and takes that go through the mutex fast path
+ * (configUSE_MUTEX_FAST_PATH) are not counted.
+ *
+ * @param xQueue The handle of the queue to read.
+ *
+ * @param pxMetrics Where the counters are written.
+ */
+#if( configUSE_QUEUE_METRICS == 1 )
+	void vQueueGetMetrics( QueueHandle_t xQueue, QueueMetrics_t * const pxMetrics ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Clears the counters of a queue, semaphore or mutex.  The high-water mark
+ * restarts from the number of items currently in the queue.
+ *
+ * @param xQueue The handle of the queue to reset.
+ */
+#if( configUSE_QUEUE_METRICS == 1 )
+	void vQueueResetMetrics( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Fills pxArray with the name, length, item size, current fill level and
+ * counters of each queue in the queue registry, so that a task can report
+ * them all by name.  Each queue is copied within its own critical section.
+ * A queue must not be deleted while it is being read; vQueueDelete() removes
+ * it from the registry first.
+ *
+ * @param pxArray Where the entries are written.
+ *
+ * @param uxArraySize The number of entries pxArray can hold.  Up to
+ * configQUEUE_REGISTRY_SIZE are written.
+ *
+ * @return The number of entries written.
+ */
+#if( ( configUSE_QUEUE_METRICS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+	UBaseType_t uxQueueGetRegistryMetrics( QueueRegistryMetrics_t * const pxArray, const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Generic version of the function used to creaet a queue using dynamic memory
  * allocation.  This is called by other functions and macros that create other
@@ -1639,6 +1735,292 @@ QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet, const Ti
  */
 QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ QueueHandle_t xQueueCreateRef(
+							  UBaseType_t uxQueueLength
+						  );
+ * </pre>
+ *
+ * Creates a reference queue - a queue whose items are pointers to blocks the
+ * application owns, typically allocated from an osMemoryPoolNew() pool.
+ * Sending a block moves the pointer, not the block, so the copy cost is the
+ * same whatever the payload size.  Use xQueueSendRef()/xQueueReceiveRef() on
+ * the returned handle.  configUSE_QUEUE_REFERENCES must be set to 1.
+ *
+ * @param uxQueueLength The maximum number of references the queue can hold.
+ *
+ * @return A handle to the created queue, or NULL if it could not be created.
+ *
+ * Example usage:
+   <pre>
+ typedef struct { uint8_t ucSensor; int32_t lValue; } Sample_t;
+
+ osMemoryPoolId_t xPool;
+ QueueHandle_t xRefQueue;
+
+ void vProducer( void *pvParameters )
+ {
+ Sample_t *pxSample;
+
+	xPool = osMemoryPoolNew( 8, sizeof( Sample_t ), NULL );
+	xRefQueue = xQueueCreateRef( 8 );
+
+	for( ;; )
+	{
+		pxSample = osMemoryPoolAlloc( xPool, osWaitForever );
+		pxSample->lValue = lReadSensor();
+
+		// pxSample is NULL afterwards - the consumer owns the block now.
+		xQueueSendRef( xRefQueue, ( void ** ) &pxSample, portMAX_DELAY );
+	}
+ }
+
+ void vConsumer( void *pvParameters )
+ {
+ Sample_t *pxSample = NULL;
+
+	for( ;; )
+	{
+		if( xQueueReceiveRef( xRefQueue, ( void ** ) &pxSample, portMAX_DELAY ) == pdPASS )
+		{
+			vProcess( pxSample );
+			osMemoryPoolFree( xPool, pxSample );
+			pxSample = NULL;
+		}
+	}
+ }
+ </pre>
+ * \defgroup xQueueCreateRef xQueueCreateRef
+ * \ingroup QueueManagement
+ */
+#if( ( configUSE_QUEUE_REFERENCES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+	#define xQueueCreateRef( uxQueueLength ) xQueueGenericCreate( ( uxQueueLength ), sizeof( void * ), ( queueQUEUE_TYPE_BASE ) )
+#endif
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendRef(
+							QueueHandle_t xQueue,
+							void **ppvReference,
+							TickType_t xTicksToWait
+						);
+ * </pre>
+ *
+ * Transfers ownership of the block *ppvReference to a reference queue.  Only
+ * the pointer is copied.  On success *ppvReference is set to NULL so the
+ * sender cannot keep using a block it no longer owns.
+ *
+ * When configQUEUE_REFERENCE_OWNERSHIP_CHECK is 1 the call also asserts that
+ * the block is not already held by the queue (a double send, or use after
+ * hand-over).  The check walks the queue, so it is meant for debug builds.
+ *
+ * @param xQueue A queue created with xQueueCreateRef().
+ *
+ * @param ppvReference Address of the sender's pointer to the block.
+ *
+ * @param xTicksToWait The maximum time to block waiting for space.
+ *
+ * @return pdPASS if the reference was queued, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xQueueSendRef xQueueSendRef
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendRef( QueueHandle_t xQueue, void ** const ppvReference, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendRefFromISR(
+							QueueHandle_t xQueue,
+							void **ppvReference,
+							BaseType_t *pxHigherPriorityTaskWoken
+						);
+ * </pre>
+ *
+ * A version of xQueueSendRef() that can be called from an ISR.  The ownership
+ * check is not performed from interrupts.
+ *
+ * \defgroup xQueueSendRefFromISR xQueueSendRefFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendRefFromISR( QueueHandle_t xQueue, void ** const ppvReference, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueReceiveRef(
+							QueueHandle_t xQueue,
+							void **ppvReference,
+							TickType_t xTicksToWait
+						);
+ * </pre>
+ *
+ * Takes ownership of the oldest block in a reference queue.  The receiver is
+ * responsible for returning the block to its pool.  *ppvReference is set to
+ * NULL if nothing was received.
+ *
+ * When configQUEUE_REFERENCE_OWNERSHIP_CHECK is 1 the call asserts that
+ * *ppvReference is NULL on entry, catching receivers that overwrite a block
+ * they still own.
+ *
+ * @param xQueue A queue created with xQueueCreateRef().
+ *
+ * @param ppvReference Receives the pointer to the block.
+ *
+ * @param xTicksToWait The maximum time to block waiting for a reference.
+ *
+ * @return pdPASS if a reference was received, otherwise pdFAIL.
+ *
+ * \defgroup xQueueReceiveRef xQueueReceiveRef
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveRef( QueueHandle_t xQueue, void ** const ppvReference, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendMultiple(
+								QueueHandle_t xQueue,
+								const void *pvItems,
+								UBaseType_t uxItemCount,
+								TickType_t xTicksToWait
+							);
+ * </pre>
+ *
+ * Posts uxItemCount items, stored back to back at pvItems, to the back of a
+ * queue.  As many items as fit are copied under a single critical section and
+ * waiting receivers are woken in the same pass, with at most one context
+ * switch, instead of once per item as a loop of xQueueSend() calls would.
+ * If the queue fills part way through, the task blocks for space and carries
+ * on; the block time covers the whole batch.  configUSE_QUEUE_BATCH must be
+ * set to 1.
+ *
+ * Semaphores and mutexes cannot be used with this function.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to an array of uxItemCount items, each the size
+ * the queue was created with.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum time to block waiting for space.
+ *
+ * @return The number of items posted.  Less than uxItemCount only if the
+ * block time expired first.
+ *
+ * Example usage:
+   <pre>
+ int32_t lSamples[ 16 ];
+
+ void vProducer( void *pvParameters )
+ {
+ BaseType_t xSent;
+
+	for( ;; )
+	{
+		vReadSamples( lSamples, 16 );
+		xSent = xQueueSendMultiple( xQueue, lSamples, 16, pdMS_TO_TICKS( 10 ) );
+
+		if( xSent != 16 )
+		{
+			// The consumer is too slow - lSamples[ xSent ] onwards were
+			// dropped.
+		}
+	}
+ }
+ </pre>
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, UBaseType_t uxItemCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendMultipleFromISR(
+										QueueHandle_t xQueue,
+										const void *pvItems,
+										UBaseType_t uxItemCount,
+										BaseType_t *pxHigherPriorityTaskWoken
+									);
+ * </pre>
+ *
+ * A version of xQueueSendMultiple() that can be called from an ISR.  It never
+ * blocks - items that do not fit are not posted.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if posting the items
+ * unblocked a task with a priority higher than the interrupted task, in
+ * which case a context switch should be requested before the ISR exits.
+ *
+ * @return The number of items posted.
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueReceiveMultiple(
+									QueueHandle_t xQueue,
+									void *pvBuffer,
+									UBaseType_t uxMaxItems,
+									TickType_t xTicksToWait
+								);
+ * </pre>
+ *
+ * Receives up to uxMaxItems items from a queue into pvBuffer, oldest first,
+ * under a single critical section.  Blocks only while the queue is empty -
+ * the call returns as soon as at least one item is available, so a consumer
+ * drains whatever has built up without waiting for a full batch.  Tasks
+ * waiting for space are woken in the same pass.  configUSE_QUEUE_BATCH must
+ * be set to 1.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer A buffer with room for uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum time to block waiting for an item.
+ *
+ * @return The number of items received, 0 if the block time expired.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueReceiveMultipleFromISR(
+											QueueHandle_t xQueue,
+											void *pvBuffer,
+											UBaseType_t uxMaxItems,
+											BaseType_t *pxHigherPriorityTaskWoken
+										);
+ * </pre>
+ *
+ * A version of xQueueReceiveMultiple() that can be called from an ISR.  It
+ * never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if freeing space unblocked
+ * a task with a priority higher than the interrupted task.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /* Not public API functions. */
 void vQueueWaitForMessageRestricted( QueueHandle_t xQueue, TickType_t xTicksToWait, const BaseType_t xWaitIndefinitely ) PRIVILEGED_FUNCTION;
 BaseType_t xQueueGenericReset( QueueHandle_t xQueue, BaseType_t xNewQueue ) PRIVILEGED_FUNCTION;
@@ -14,15 +14,33 @@
 #include <stdio.h>
 #include <string.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
 #include "uart.h"
 #include "exti.h"
 #include "adc.h"
+#include "wide_event_groups.h"
 
 /* Macros --------------------------------------------------------------------*/
+#define EVENT_GROUP_WIDE 1	/* 0: EventBits_t, 24 bits, 1: WideEventBits_t, 64 bits */
+
+#if (EVENT_GROUP_WIDE == 1)
+/* Spread over the 64 bits, past the 24 of an EventBits_t. */
+#define TASK1_BIT_NUM 0U
+#define TASK2_BIT_NUM 31U
+#define TASK3_BIT_NUM 63U
+#define TASK1_BIT ((WideEventBits_t)1U << TASK1_BIT_NUM)
+#define TASK2_BIT ((WideEventBits_t)1U << TASK2_BIT_NUM)
+#define TASK3_BIT ((WideEventBits_t)1U << TASK3_BIT_NUM)
+#define EVENT_GROUP_NOTIFY_INDEX 0U
+#else
+#define TASK1_BIT_NUM 0U
+#define TASK2_BIT_NUM 1U
+#define TASK3_BIT_NUM 2U
 #define TASK1_BIT (1UL << 0UL)
 #define TASK2_BIT (1UL << 1UL)
 #define TASK3_BIT (1UL << 2UL)
+#endif
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
@@ -35,7 +53,12 @@ static void vOutputTask(void *pvParameters);
 /* Data types ----------------------------------------------------------------*/
 
 /* Variables -----------------------------------------------------------------*/
+#if (EVENT_GROUP_WIDE == 1)
+static StaticWideEventGroup_t xEventGroupBuffer;
+WideEventGroupHandle_t xEventGroup;
+#else
 EventGroupHandle_t xEventGroup;
+#endif
 const TickType_t xDelay500ms = pdMS_TO_TICKS(500UL);
 
 /**
@@ -85,7 +108,11 @@ int main(void)
 				1,
 				NULL);
 
+#if (EVENT_GROUP_WIDE == 1)
+	xEventGroup = xWideEventGroupCreateStatic(EVENT_GROUP_NOTIFY_INDEX, &xEventGroupBuffer);
+#else
 	xEventGroup = xEventGroupCreate();
+#endif
 
 	vTaskStartScheduler();
 
@@ -110,7 +137,11 @@ void vInputTask1(void *pvParameters)
 	while (1)
 	{
 		/* Do something. (e.g., sensor data reading, etc.) */
+#if (EVENT_GROUP_WIDE == 1)
+		xWideEventGroupSetBits(xEventGroup, TASK1_BIT);
+#else
 		xEventGroupSetBits(xEventGroup, TASK1_BIT);
+#endif
 	}
 }
 
@@ -128,7 +159,11 @@ void vInputTask2(void *pvParameters)
 	while (1)
 	{
 		/* Do something. (e.g., sensor data reading, etc.) */
+#if (EVENT_GROUP_WIDE == 1)
+		//xWideEventGroupSetBits(xEventGroup, TASK2_BIT);
+#else
 		//xEventGroupSetBits(xEventGroup, TASK2_BIT);
+#endif
 	}
 }
 
@@ -146,7 +181,11 @@ void vInputTask3(void *pvParameters)
 	while (1)
 	{
 		/* Do something. (e.g., sensor data reading, etc.) */
+#if (EVENT_GROUP_WIDE == 1)
+		xWideEventGroupSetBits(xEventGroup, TASK3_BIT);
+#else
 		xEventGroupSetBits(xEventGroup, TASK3_BIT);
+#endif
 	}
 }
 
@@ -158,13 +197,23 @@ void vInputTask3(void *pvParameters)
  */
 void vOutputTask(void *pvParameters)
 {
+#if (EVENT_GROUP_WIDE == 1)
+	const WideEventBits_t xBitsToWaitFor = (TASK1_BIT | TASK2_BIT | TASK3_BIT);
+
+	WideEventBits_t xEventGroupValue;
+#else
 	const EventBits_t xBitsToWaitFor = (TASK1_BIT | TASK2_BIT | TASK3_BIT);
 
 	EventBits_t xEventGroupValue;
+#endif
 
 	while (1)
 	{
+#if (EVENT_GROUP_WIDE == 1)
+		xEventGroupValue = xWideEventGroupWaitBits( /* Event group to read. */
+#else
 		xEventGroupValue = xEventGroupWaitBits( /* Event group to read. */
+#endif
 				xEventGroup,
 				xBitsToWaitFor,
 				pdTRUE,
@@ -173,17 +222,17 @@ void vOutputTask(void *pvParameters)
 
 		if ((xEventGroupValue & TASK1_BIT) != 0)
 		{
-			printf("vOutputTask: Event bit 0 was set - TASK1.\r\n");
+			printf("vOutputTask: Event bit %u was set - TASK1.\r\n", TASK1_BIT_NUM);
 		}
 
 		if ((xEventGroupValue & TASK2_BIT) != 0)
 		{
-			printf("vOutputTask: Event bit 1 was set - TASK2.\r\n");
+			printf("vOutputTask: Event bit %u was set - TASK2.\r\n", TASK2_BIT_NUM);
 		}
 
 		if ((xEventGroupValue & TASK3_BIT) != 0)
 		{
-			printf("vOutputTask: Event bit 2 was set - TASK3.\r\n");
+			printf("vOutputTask: Event bit %u was set - TASK3.\r\n", TASK3_BIT_NUM);
 		}
 	}
 }
@@ -194,44 +243,9 @@ void vOutputTask(void *pvParameters)
  */
 void SystemClock_Config(void)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
-
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-	{
-		Error_Handler();
-	}
-
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
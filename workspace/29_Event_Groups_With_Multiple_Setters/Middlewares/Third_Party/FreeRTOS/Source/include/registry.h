@@ -0,0 +1,145 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * The object registry lists the queues, semaphores, mutexes, stream buffers,
+ * message buffers and event groups the application gives a name to, so that a
+ * debugger, a diagnostics task or a console can find an object by its name and
+ * the name of an object from its handle.  It replaces the fixed array of the
+ * queue registry when configUSE_OBJECT_REGISTRY is set to 1:
+ *
+ *  + No size limit.  Each object carries its own registry item, so adding an
+ *    object allocates nothing and never fails, and configQUEUE_REGISTRY_SIZE
+ *    no longer caps the number of queues that can be registered.
+ *
+ *  + Names are hashed into configOBJECT_REGISTRY_BUCKETS buckets.  A lookup by
+ *    name only compares the names of one bucket, the name of a handle is read
+ *    from the object itself, and removing an object (vQueueDelete() and the
+ *    other delete functions do it) unlinks it from its bucket directly.
+ *
+ * The application uses the functions of each object type - vQueueAddToRegistry()
+ * and xQueueFindByName(), vStreamBufferAddToRegistry(),
+ * vEventGroupAddToRegistry() - the functions below are called by the kernel.
+ *
+ * ***NOTE***:  configQUEUE_REGISTRY_SIZE must still be greater than 0, as it
+ * enables the queue registry functions.  The xQueueRegistry array read by some
+ * kernel aware debuggers does not exist when the object registry is used.
+ * Names are only pointed to, so they must be persistent.  Registry functions
+ * must not be called from interrupts.
+ */
+
+#ifndef REGISTRY_H
+#define REGISTRY_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include registry.h"
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The kinds of objects in the registry. */
+#define registryTYPE_ANY				( ( uint8_t ) 0U )	/* For lookups only. */
+#define registryTYPE_QUEUE				( ( uint8_t ) 1U )	/* Queues, semaphores, mutexes and queue sets. */
+#define registryTYPE_STREAM_BUFFER		( ( uint8_t ) 2U )	/* Stream and message buffers. */
+#define registryTYPE_EVENT_GROUP		( ( uint8_t ) 3U )
+
+/*
+ * The registry item held in each object that can be registered.  Objects
+ * allocated statically hold a StaticRegistryItem_t of the same size.
+ */
+typedef struct xREGISTRY_ITEM
+{
+	const char *pcName;						/*< The name, or NULL if the object is not registered. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	void *pvObject;							/*< The handle of the object that holds the item. */
+	struct xREGISTRY_ITEM *pxNext;			/*< The next item of the same bucket. */
+	struct xREGISTRY_ITEM **ppxPrevious;	/*< The pointer to this item, in the bucket or in the previous item. */
+	uint8_t ucType;							/*< One of the registryTYPE_ values. */
+	uint8_t ucBucket;
+} RegistryItem_t;
+
+/*
+ * One registered object, as copied by uxRegistryGetObjects().
+ */
+typedef struct xREGISTRY_OBJECT
+{
+	const char *pcName; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	void *pvObject;
+	uint8_t ucType;
+} RegistryObject_t;
+
+/*
+ * Copies up to uxArraySize registered objects of type ucType (or of any type
+ * with registryTYPE_ANY) into pxArray, in no particular order.  Returns the
+ * number copied.
+ */
+UBaseType_t uxRegistryGetObjects( RegistryObject_t * const pxArray, const UBaseType_t uxArraySize, const uint8_t ucType ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of objects in the registry.
+ */
+UBaseType_t uxRegistryGetCount( void ) PRIVILEGED_FUNCTION;
+
+/* Functions below here are not part of the public API.  They are called by
+queue.c, stream_buffer.c and event_groups.c. */
+
+/*
+ * Marks an item as not registered.  Called once when its object is created.
+ */
+void vRegistryInitialiseItem( RegistryItem_t * const pxItem, void * const pvObject, const uint8_t ucType ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds the object of an item under pcName.  An object already registered is
+ * renamed, or removed if pcName is NULL.
+ */
+void vRegistryAdd( RegistryItem_t * const pxItem, const char *pcName ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/*
+ * Removes the object of an item, if it is registered.
+ */
+void vRegistryRemove( RegistryItem_t * const pxItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the handle of the first object of type ucType found under pcName,
+ * or NULL.
+ */
+void *pvRegistryFind( const char *pcName, const uint8_t ucType ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/*
+ * Walks the registry: returns the item after pxItem, or the first item if
+ * pxItem is NULL, or NULL after the last one.  The scheduler must be
+ * suspended for the whole walk.
+ */
+RegistryItem_t *pxRegistryGetNext( const RegistryItem_t * const pxItem ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* REGISTRY_H */
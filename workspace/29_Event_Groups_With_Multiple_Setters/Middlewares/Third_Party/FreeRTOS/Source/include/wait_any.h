@@ -0,0 +1,218 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A wait-any object lets one task, the owner, block until any of several
+ * queues, semaphores, mutexes or stream buffers (the members) can be read
+ * without blocking, and tells it which.  It is a lighter alternative to a queue
+ * set for that case:
+ *
+ *  + No second queue.  A queue set holds a handle per item in its members, so
+ *    it must be as long as all of them together, and every send is followed by
+ *    a second send of the member's handle into the set.  A member of a wait-any
+ *    object records one pointer; a send by a task costs one extra load, and
+ *    one task notification only while the owner is actually waiting.
+ *
+ *  + The result is a bitmask of every member that is ready now, worked out
+ *    from the members themselves, so it can never be stale or out of step with
+ *    the data.  Each member is one bit, in the order the members were added.
+ *
+ * The owner blocks on one entry of its task notification array (see
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES), which belongs to the wait-any object:
+ * the owner must not use it for anything else.  Index 0
+ * (tskDEFAULT_INDEX_TO_NOTIFY) is also used by the task notification functions
+ * that do not take an index, and by stream buffers.
+ *
+ * ***NOTE***:  Members are added before the owner first waits and stay members
+ * for the life of the object.  A queue or stream buffer can be the member of
+ * one wait-any object at a time (and of a queue set as well).
+ * configUSE_WAIT_ANY must be set to 1.
+ */
+
+#ifndef WAIT_ANY_H
+#define WAIT_ANY_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include wait_any.h"
+#endif
+
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * Function by which a member reports whether it can be read without blocking.
+ */
+typedef BaseType_t ( *WaitAnyIsReadyFunction_t )( void *pvMember );
+
+/**
+ * The storage of a wait-any object, declared by the application and passed to
+ * xWaitAnyCreateStatic().  Its members must not be accessed directly.
+ */
+typedef struct WaitAnyDef_t
+{
+	TaskHandle_t xOwner;
+	UBaseType_t uxIndex;
+	volatile UBaseType_t uxOwnerWaiting;
+	UBaseType_t uxMemberCount;
+	void *pvMembers[ configWAIT_ANY_MAX_MEMBERS ];
+	WaitAnyIsReadyFunction_t pxIsReady[ configWAIT_ANY_MAX_MEMBERS ];
+} StaticWaitAny_t;
+
+/**
+ * Type by which wait-any objects are referenced.
+ */
+typedef StaticWaitAny_t * WaitAnyHandle_t;
+
+/**
+ * wait_any.h
+ *
+<pre>
+WaitAnyHandle_t xWaitAnyCreateStatic( TaskHandle_t xOwner,
+                                      UBaseType_t uxIndex,
+                                      StaticWaitAny_t *pxWaitAnyBuffer );
+</pre>
+ *
+ * Creates a wait-any object with no members in pxWaitAnyBuffer.
+ *
+ * @param xOwner The only task that may wait on the object.
+ *
+ * @param uxIndex The owner's notification index used by the object, less than
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
+ * @param pxWaitAnyBuffer The storage of the object.
+ *
+ * @return A handle to the object.
+ *
+ * \defgroup xWaitAnyCreateStatic xWaitAnyCreateStatic
+ * \ingroup WaitAny
+ */
+WaitAnyHandle_t xWaitAnyCreateStatic( TaskHandle_t xOwner, UBaseType_t uxIndex, StaticWaitAny_t *pxWaitAnyBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * wait_any.h
+ *
+<pre>
+UBaseType_t uxWaitAnyAddQueue( WaitAnyHandle_t xWaitAny, QueueHandle_t xQueueOrSemaphore );
+UBaseType_t uxWaitAnyAddStreamBuffer( WaitAnyHandle_t xWaitAny, StreamBufferHandle_t xStreamBuffer );
+</pre>
+ *
+ * Adds a member.  A queue is ready while it holds an item, a semaphore while
+ * it can be taken, a mutex while it is free, a stream buffer while it holds at
+ * least its trigger level of bytes, and a message buffer while it holds a
+ * message.
+ *
+ * @param xWaitAny The wait-any object.
+ *
+ * @param xQueueOrSemaphore, xStreamBuffer The new member, not yet a member of
+ * any wait-any object.
+ *
+ * @return The bit that stands for the member in the values returned by
+ * uxWaitAnyWait(), or 0 if the object already has configWAIT_ANY_MAX_MEMBERS
+ * members.
+ *
+ * \defgroup uxWaitAnyAddQueue uxWaitAnyAddQueue
+ * \ingroup WaitAny
+ */
+UBaseType_t uxWaitAnyAddQueue( WaitAnyHandle_t xWaitAny, QueueHandle_t xQueueOrSemaphore ) PRIVILEGED_FUNCTION;
+UBaseType_t uxWaitAnyAddStreamBuffer( WaitAnyHandle_t xWaitAny, StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * wait_any.h
+ *
+<pre>
+UBaseType_t uxWaitAnyWait( WaitAnyHandle_t xWaitAny,
+                           UBaseType_t uxBitsToWaitFor,
+                           TickType_t xTicksToWait );
+</pre>
+ *
+ * Blocks the owner until at least one of the members in uxBitsToWaitFor is
+ * ready, or xTicksToWait expires.  Must only be called by the owner.  Nothing
+ * is read from the members: the owner then receives or takes from each member
+ * whose bit is set, without blocking.
+ *
+ * @param xWaitAny The wait-any object.
+ *
+ * @param uxBitsToWaitFor The bits, returned by uxWaitAnyAdd...(), of the
+ * members to wait for.
+ *
+ * @param xTicksToWait The maximum time to block.  0 only polls the members.
+ *
+ * @return The bits of the members in uxBitsToWaitFor that are ready, or 0 if
+ * the block time expired first.
+ *
+ * Example usage:
+<pre>
+StaticWaitAny_t xWaitAnyBuffer;
+
+void vReceiverTask( void *pvParameters )
+{
+WaitAnyHandle_t xWaitAny;
+UBaseType_t uxCommandBit, uxTickBit, uxReady;
+
+	xWaitAny = xWaitAnyCreateStatic( xTaskGetCurrentTaskHandle(), 1, &xWaitAnyBuffer );
+	uxCommandBit = uxWaitAnyAddQueue( xWaitAny, xCommandQueue );
+	uxTickBit = uxWaitAnyAddQueue( xWaitAny, xTickSemaphore );
+
+	for( ;; )
+	{
+		uxReady = uxWaitAnyWait( xWaitAny, uxCommandBit | uxTickBit, portMAX_DELAY );
+
+		if( ( uxReady & uxCommandBit ) != 0 )
+		{
+			xQueueReceive( xCommandQueue, &xCommand, 0 );
+			vProcessCommand( &xCommand );
+		}
+
+		if( ( uxReady & uxTickBit ) != 0 )
+		{
+			xSemaphoreTake( xTickSemaphore, 0 );
+			vTick();
+		}
+	}
+}
+</pre>
+ * \defgroup uxWaitAnyWait uxWaitAnyWait
+ * \ingroup WaitAny
+ */
+UBaseType_t uxWaitAnyWait( WaitAnyHandle_t xWaitAny, UBaseType_t uxBitsToWaitFor, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/* Functions below here are not part of the public API.  They are called by
+queue.c and stream_buffer.c. */
+UBaseType_t uxWaitAnyAddMember( WaitAnyHandle_t xWaitAny, void *pvMember, WaitAnyIsReadyFunction_t pxIsReady ) PRIVILEGED_FUNCTION;
+void vWaitAnyNotify( WaitAnyHandle_t xWaitAny ) PRIVILEGED_FUNCTION;
+void vWaitAnyNotifyFromISR( WaitAnyHandle_t xWaitAny, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* WAIT_ANY_H */
@@ -125,6 +125,7 @@ to exclude the API function. */
  * by the application thus the correct define need to be enabled below
  */
 #define USE_FreeRTOS_HEAP_4
+/* #define USE_FreeRTOS_HEAP_TLSF */	/* Instead of HEAP_4: heap_tlsf.c, O(1) malloc and free */
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -168,6 +169,36 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Port optimised task selection: the CM4F port finds the highest ready
+priority with CLZ on a ready-priority bitmap instead of walking the ready
+lists.  The 56 CMSIS-RTOS2 priorities take a two-level bitmap, so selection is
+two CLZs whatever the priorities in use (see README, Task Selection). */
+#undef configUSE_PORT_OPTIMISED_TASK_SELECTION
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
+/* The barrier of main.c (SYNC_WITH_BARRIER) wakes its waiters on notification
+index 0; the drivers keep the last index to themselves. */
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES    2
+/* No idle sleep: the DWT cycle counter stops while the core sleeps in WFI, so
+cpuload.c would count nothing but the idle task's awake time as idle, and
+report the CPU as loaded when it is not (see README, Overload Manager). */
+#define configUSE_IDLE_SLEEP                     0
+/* Run-time stats on the DWT cycle counter, extended to 64 bits (runstats.c). */
+#define configGENERATE_RUN_TIME_STATS            1
+#define configRUN_TIME_COUNTER_TYPE              uint64_t
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  void runstats_timer_init(void);
+  uint64_t runstats_get_counter(void);
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() runstats_timer_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()         runstats_get_counter()
+/* CPU load from the time the idle task runs, sampled by the tick hook
+(cpuload.c), for the overload manager of main.c (overload.c). */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  void cpuload_task_switched_in(int xIdle);
+#endif
+#define traceTASK_SWITCHED_IN() cpuload_task_switched_in((pxCurrentTCB == xIdleTaskHandle) ? 1 : 0)
+#undef configUSE_TICK_HOOK
+#define configUSE_TICK_HOOK                      1
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
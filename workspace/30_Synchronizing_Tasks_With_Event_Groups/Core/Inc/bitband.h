@@ -0,0 +1,216 @@
+/*******************************************************************************
+ *
+ * @file	bitband.h
+ * @brief	Atomic single-bit access through the Cortex-M4 bit-band aliases.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	The first 1 MB of SRAM (0x20000000) and of the peripherals
+ * 			(0x40000000) have each bit mapped to a word of an alias region
+ * 			(0x22000000 and 0x42000000). Writing 1 or 0 to the word sets or
+ * 			clears the bit, reading it returns the bit. The bus matrix does
+ * 			the read-modify-write of the containing word as one locked
+ * 			transfer, so an interrupt cannot come in between: a single bit
+ * 			can be changed from tasks and ISRs of any priority without a
+ * 			critical section, where 'REG |= BIT' is a load, an ORR and a
+ * 			store that an ISR writing the same register can interleave with.
+ *
+ * 			All the STM32F446 SRAM and the APB1, APB2 and AHB1 peripherals
+ * 			(GPIO, RCC, EXTI, timers, USARTs) are covered. AHB2 (USB OTG FS,
+ * 			DCMI) and the Cortex-M4 core peripherals (e.g. NVIC) are not.
+ *
+ * 			Do not use on registers with write-1-to-clear or read-to-clear
+ * 			bits (EXTI_PR, most status registers): the hardware writes
+ * 			back the whole word it read, which clears every other pending
+ * 			bit too.
+ *
+ * 			A bit-band write is a single store, so it only saves a critical
+ * 			section where a critical section was there to make one bit
+ * 			atomic. Counts, or several bits that have to change together,
+ * 			still need one.
+ *
+ ******************************************************************************/
+
+#ifndef BITBAND_H
+#define BITBAND_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define BITBAND_REGION_SIZE		0x100000UL	/* Bytes covered from each base. */
+
+/* Alias word of bit 'ulBit' of the word at 'ulAddr'. */
+#define BITBAND_PERIPH_ALIAS(ulAddr, ulBit) \
+	((volatile uint32_t *)(PERIPH_BB_BASE + (((uint32_t)(ulAddr) - PERIPH_BASE) * 32U) + ((uint32_t)(ulBit) * 4U)))
+#define BITBAND_SRAM_ALIAS(ulAddr, ulBit) \
+	((volatile uint32_t *)(SRAM_BB_BASE + (((uint32_t)(ulAddr) - SRAM_BASE) * 32U) + ((uint32_t)(ulBit) * 4U)))
+
+/* Whether a word can be reached through an alias. */
+#define BITBAND_IS_PERIPH(ulAddr) \
+	(((uint32_t)(ulAddr) - PERIPH_BASE) < BITBAND_REGION_SIZE)
+#define BITBAND_IS_SRAM(ulAddr) \
+	(((uint32_t)(ulAddr) - SRAM_BASE) < BITBAND_REGION_SIZE)
+
+/* Data types ----------------------------------------------------------------*/
+
+/* 32 event flags, each set, cleared and tested on its own by tasks and ISRs
+ * without a critical section. The word must be in SRAM (a global, static or
+ * stack variable), not in flash or the backup domain. */
+typedef struct
+{
+	volatile uint32_t ulFlags;
+} BitbandFlags_t;
+
+/* Function definitions ------------------------------------------------------*/
+
+/**
+ * @brief Sets a bit of a peripheral register.
+ * @param pulReg Register, in the peripheral bit-band region.
+ * @param ulBit Bit number, 0 to 31.
+ * @retval None
+ */
+static inline void bitband_periph_set(volatile uint32_t *pulReg, uint32_t ulBit)
+{
+	*BITBAND_PERIPH_ALIAS(pulReg, ulBit) = 1U;
+}
+
+/**
+ * @brief Clears a bit of a peripheral register.
+ * @param pulReg Register, in the peripheral bit-band region.
+ * @param ulBit Bit number, 0 to 31.
+ * @retval None
+ */
+static inline void bitband_periph_clear(volatile uint32_t *pulReg, uint32_t ulBit)
+{
+	*BITBAND_PERIPH_ALIAS(pulReg, ulBit) = 0U;
+}
+
+/**
+ * @brief Sets or clears a bit of a peripheral register.
+ * @param pulReg Register, in the peripheral bit-band region.
+ * @param ulBit Bit number, 0 to 31.
+ * @param ulValue 0 to clear, anything else to set.
+ * @retval None
+ */
+static inline void bitband_periph_write(volatile uint32_t *pulReg, uint32_t ulBit, uint32_t ulValue)
+{
+	*BITBAND_PERIPH_ALIAS(pulReg, ulBit) = (ulValue != 0U) ? 1U : 0U;
+}
+
+/**
+ * @brief Reads a bit of a peripheral register.
+ * @param pulReg Register, in the peripheral bit-band region.
+ * @param ulBit Bit number, 0 to 31.
+ * @retval 1 if the bit is set, 0 otherwise.
+ */
+static inline uint32_t bitband_periph_read(const volatile uint32_t *pulReg, uint32_t ulBit)
+{
+	return *BITBAND_PERIPH_ALIAS(pulReg, ulBit);
+}
+
+/**
+ * @brief Sets a bit of a word in SRAM.
+ * @param pulWord Word, in the SRAM bit-band region.
+ * @param ulBit Bit number, 0 to 31.
+ * @retval None
+ */
+static inline void bitband_sram_set(volatile uint32_t *pulWord, uint32_t ulBit)
+{
+	*BITBAND_SRAM_ALIAS(pulWord, ulBit) = 1U;
+}
+
+/**
+ * @brief Clears a bit of a word in SRAM.
+ * @param pulWord Word, in the SRAM bit-band region.
+ * @param ulBit Bit number, 0 to 31.
+ * @retval None
+ */
+static inline void bitband_sram_clear(volatile uint32_t *pulWord, uint32_t ulBit)
+{
+	*BITBAND_SRAM_ALIAS(pulWord, ulBit) = 0U;
+}
+
+/**
+ * @brief Reads a bit of a word in SRAM.
+ * @param pulWord Word, in the SRAM bit-band region.
+ * @param ulBit Bit number, 0 to 31.
+ * @retval 1 if the bit is set, 0 otherwise.
+ */
+static inline uint32_t bitband_sram_read(const volatile uint32_t *pulWord, uint32_t ulBit)
+{
+	return *BITBAND_SRAM_ALIAS(pulWord, ulBit);
+}
+
+/**
+ * @brief Initializes event flags, all clear.
+ * @param pxFlags Flags to initialize.
+ * @retval 0 if successful, -1 if they are not in the SRAM bit-band region.
+ */
+static inline int32_t bitband_flags_init(BitbandFlags_t *pxFlags)
+{
+	if ((pxFlags == NULL) || !BITBAND_IS_SRAM(&pxFlags->ulFlags))
+	{
+		return -1;
+	}
+
+	pxFlags->ulFlags = 0U;
+
+	return 0;
+}
+
+/**
+ * @brief Raises one event flag.
+ * @param pxFlags Event flags.
+ * @param ulFlag Flag number, 0 to 31.
+ * @retval None
+ */
+static inline void bitband_flags_set(BitbandFlags_t *pxFlags, uint32_t ulFlag)
+{
+	bitband_sram_set(&pxFlags->ulFlags, ulFlag);
+}
+
+/**
+ * @brief Lowers one event flag.
+ * @param pxFlags Event flags.
+ * @param ulFlag Flag number, 0 to 31.
+ * @retval None
+ */
+static inline void bitband_flags_clear(BitbandFlags_t *pxFlags, uint32_t ulFlag)
+{
+	bitband_sram_clear(&pxFlags->ulFlags, ulFlag);
+}
+
+/**
+ * @brief Tests one event flag.
+ * @param pxFlags Event flags.
+ * @param ulFlag Flag number, 0 to 31.
+ * @retval 1 if the flag is raised, 0 otherwise.
+ */
+static inline uint32_t bitband_flags_test(const BitbandFlags_t *pxFlags, uint32_t ulFlag)
+{
+	return bitband_sram_read(&pxFlags->ulFlags, ulFlag);
+}
+
+/**
+ * @brief Lowers all event flags and returns those that were raised.
+ * @param pxFlags Event flags.
+ * @retval The flags raised, bit n for flag n.
+ * @note A test followed by a clear loses a flag raised in between, so the
+ * consumer takes them all at once with an exclusive load and store. Whatever
+ * raises a flag in between, an ISR or another task, gets there through an
+ * exception, which makes the store fail and the read retry.
+ */
+static inline uint32_t bitband_flags_take(BitbandFlags_t *pxFlags)
+{
+	uint32_t ulFlags;
+
+	do
+	{
+		ulFlags = __LDREXW(&pxFlags->ulFlags);
+	} while (__STREXW(0U, &pxFlags->ulFlags) != 0U);
+
+	return ulFlags;
+}
+
+#endif /* BITBAND_H */
@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *
+ * @file	overload.h
+ * @brief	Interface of the overload manager.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef OVERLOAD_H
+#define OVERLOAD_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "cpuload.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef OVERLOAD_PERIOD_MS
+#define OVERLOAD_PERIOD_MS CPULOAD_SAMPLE_MS	/* One look per CPU load sample. */
+#endif
+
+#ifndef OVERLOAD_SHED_ABOVE
+#define OVERLOAD_SHED_ABOVE 9000U			/* Pressure, in 0.01 %, that sheds work. */
+#endif
+
+#ifndef OVERLOAD_RESTORE_BELOW
+#define OVERLOAD_RESTORE_BELOW 6000U		/* Pressure under which shed work comes back. */
+#endif
+
+#ifndef OVERLOAD_SHED_SAMPLES
+#define OVERLOAD_SHED_SAMPLES 3U			/* Looks in a row above, per action shed. */
+#endif
+
+#ifndef OVERLOAD_RESTORE_SAMPLES
+#define OVERLOAD_RESTORE_SAMPLES 20U		/* Looks in a row below, per action restored. */
+#endif
+
+#ifndef OVERLOAD_RESTORE_SAMPLES_MAX
+#define OVERLOAD_RESTORE_SAMPLES_MAX 640U	/* Longest restore hold after repeated flapping. */
+#endif
+
+#ifndef OVERLOAD_MAX_QUEUES
+#define OVERLOAD_MAX_QUEUES 4U				/* Queues whose fill counts as pressure. */
+#endif
+
+#ifndef OVERLOAD_STACK_WORDS
+#define OVERLOAD_STACK_WORDS 256U			/* printf() from overload_print() needs the headroom. */
+#endif
+
+#if (OVERLOAD_RESTORE_BELOW >= OVERLOAD_SHED_ABOVE)
+#error OVERLOAD_RESTORE_BELOW must be below OVERLOAD_SHED_ABOVE
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef void (*OverloadHook_t)(void *pvContext);
+
+/* Work that can be given up under overload, least needed first. */
+typedef struct OverloadAction
+{
+	const char *pcName;
+	OverloadHook_t pxShed;			/* Gives the work up; run by the manager task. */
+	OverloadHook_t pxRestore;		/* Takes it back. */
+	void *pvContext;
+	uint32_t ulSheds;				/* Times shed since start-up. */
+	struct OverloadAction *pxNext;
+} OverloadAction_t;
+
+typedef struct
+{
+	uint16_t usPressure;			/* Last look, in 0.01 %: CPU load or fullest queue. */
+	uint16_t usPeak;				/* Highest since start-up. */
+	uint32_t ulLevel;				/* Actions shed now. */
+	uint32_t ulSheds;				/* Since start-up, all actions. */
+	uint32_t ulRestores;
+	uint32_t ulRestoreHold;			/* Looks below needed for the next restore. */
+	uint32_t ulOverloaded;			/* Looks at or above OVERLOAD_SHED_ABOVE. */
+} OverloadStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+void overload_register(OverloadAction_t *pxAction, const char *pcName, OverloadHook_t pxShed,
+		OverloadHook_t pxRestore, void *pvContext);
+int32_t overload_watch_queue(QueueHandle_t xQueue);
+BaseType_t overload_start(UBaseType_t uxPriority);
+void overload_get_stats(OverloadStats_t *pxStats);
+void overload_print(void);
+
+#endif /* OVERLOAD_H */
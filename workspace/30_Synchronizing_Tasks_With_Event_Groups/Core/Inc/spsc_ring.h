@@ -0,0 +1,289 @@
+/*******************************************************************************
+ *
+ * @file	spsc_ring.h
+ * @brief	Lock-free single-producer/single-consumer byte ring.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Only the producer writes 'ulHead' and only the consumer writes
+ * 			'ulTail', so neither side needs a critical section, and
+ * 			spsc_ring_put() may be called from an ISR of any priority,
+ * 			including those above configMAX_SYSCALL_INTERRUPT_PRIORITY. A DMB
+ * 			orders the data against the index that publishes it.
+ *
+ * 			Optional wakeup: the consumer blocks in spsc_ring_wait() and the
+ * 			producer calls spsc_ring_wake_from_isr() after a put. That call
+ * 			uses the FreeRTOS API, so it is reserved for producers at or below
+ * 			configMAX_SYSCALL_INTERRUPT_PRIORITY; a consumer fed by a higher
+ * 			priority ISR polls with a timeout instead. The wakeup uses the
+ * 			consumer's last notification (SPSC_RING_NOTIFY_INDEX), which
+ * 			leaves index 0 to the application when
+ * 			configTASK_NOTIFICATION_ARRAY_ENTRIES is 2 or more.
+ *
+ ******************************************************************************/
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef SPSC_RING_NOTIFY_INDEX
+#define SPSC_RING_NOTIFY_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	volatile uint32_t ulHead;				/* Free-running, producer only. */
+	volatile uint32_t ulTail;				/* Free-running, consumer only. */
+	uint8_t *pucBuffer;
+	uint32_t ulMask;						/* Size - 1, size a power of two. */
+	TaskHandle_t xConsumer;					/* Set by spsc_ring_wait(). */
+	volatile uint32_t ulConsumerWaiting;	/* Consumer about to block. */
+} SpscRing_t;
+
+/* Function definitions ------------------------------------------------------*/
+
+/**
+ * @brief Initializes an empty ring.
+ * @param pxRing Ring to initialize.
+ * @param pucBuffer Storage of ulSize bytes.
+ * @param ulSize Capacity in bytes, a power of two.
+ * @retval 0 if successful, -1 otherwise.
+ */
+static inline int32_t spsc_ring_init(SpscRing_t *pxRing, uint8_t *pucBuffer, uint32_t ulSize)
+{
+	if ((pxRing == NULL) || (pucBuffer == NULL) || (ulSize == 0U)
+			|| ((ulSize & (ulSize - 1U)) != 0U))
+	{
+		return -1;
+	}
+
+	pxRing->ulHead = 0;
+	pxRing->ulTail = 0;
+	pxRing->pucBuffer = pucBuffer;
+	pxRing->ulMask = ulSize - 1U;
+	pxRing->xConsumer = NULL;
+	pxRing->ulConsumerWaiting = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Returns the number of bytes waiting in the ring.
+ * @param pxRing Ring.
+ * @retval Bytes the consumer can read.
+ */
+static inline uint32_t spsc_ring_count(const SpscRing_t *pxRing)
+{
+	return pxRing->ulHead - pxRing->ulTail;
+}
+
+/**
+ * @brief Appends a byte (producer side).
+ * @param pxRing Ring.
+ * @param ucByte Byte to append.
+ * @retval 0 if successful, -1 if the ring is full.
+ */
+static inline int32_t spsc_ring_put(SpscRing_t *pxRing, uint8_t ucByte)
+{
+	const uint32_t ulHead = pxRing->ulHead;
+
+	if ((ulHead - pxRing->ulTail) > pxRing->ulMask)
+	{
+		return -1;
+	}
+
+	pxRing->pucBuffer[ulHead & pxRing->ulMask] = ucByte;
+
+	/* The byte must be visible before the index that publishes it. */
+	__DMB();
+	pxRing->ulHead = ulHead + 1U;
+
+	return 0;
+}
+
+/**
+ * @brief Appends ulLen bytes, all or none (producer side).
+ * @param pxRing Ring.
+ * @param pucData Bytes to append.
+ * @param ulLen Number of bytes.
+ * @retval 0 if successful, -1 if they do not all fit.
+ * @note One index update publishes them all, so the consumer never sees a
+ * record half written.
+ */
+static inline int32_t spsc_ring_write(SpscRing_t *pxRing, const uint8_t *pucData, uint32_t ulLen)
+{
+	const uint32_t ulHead = pxRing->ulHead;
+	uint32_t i;
+
+	if ((pxRing->ulMask + 1U - (ulHead - pxRing->ulTail)) < ulLen)
+	{
+		return -1;
+	}
+
+	for (i = 0; i < ulLen; i++)
+	{
+		pxRing->pucBuffer[(ulHead + i) & pxRing->ulMask] = pucData[i];
+	}
+
+	/* The bytes must be visible before the index that publishes them. */
+	__DMB();
+	pxRing->ulHead = ulHead + ulLen;
+
+	return 0;
+}
+
+/**
+ * @brief Removes a byte (consumer side).
+ * @param pxRing Ring.
+ * @param pucByte Receives the byte.
+ * @retval 0 if successful, -1 if the ring is empty.
+ */
+static inline int32_t spsc_ring_get(SpscRing_t *pxRing, uint8_t *pucByte)
+{
+	const uint32_t ulTail = pxRing->ulTail;
+
+	if (pxRing->ulHead == ulTail)
+	{
+		return -1;
+	}
+
+	/* Read the byte only after seeing the index that published it. */
+	__DMB();
+	*pucByte = pxRing->pucBuffer[ulTail & pxRing->ulMask];
+
+	/* The byte must be read before its slot is handed back. */
+	__DMB();
+	pxRing->ulTail = ulTail + 1U;
+
+	return 0;
+}
+
+/**
+ * @brief Removes up to ulLen bytes (consumer side).
+ * @param pxRing Ring.
+ * @param pucData Receives the bytes.
+ * @param ulLen Maximum number of bytes.
+ * @retval Number of bytes read.
+ */
+static inline uint32_t spsc_ring_read(SpscRing_t *pxRing, uint8_t *pucData, uint32_t ulLen)
+{
+	const uint32_t ulTail = pxRing->ulTail;
+	uint32_t ulCount = pxRing->ulHead - ulTail;
+	uint32_t i;
+
+	if (ulCount > ulLen)
+	{
+		ulCount = ulLen;
+	}
+
+	__DMB();
+
+	for (i = 0; i < ulCount; i++)
+	{
+		pucData[i] = pxRing->pucBuffer[(ulTail + i) & pxRing->ulMask];
+	}
+
+	__DMB();
+	pxRing->ulTail = ulTail + ulCount;
+
+	return ulCount;
+}
+
+/**
+ * @brief Copies up to ulLen bytes without removing them (consumer side).
+ * @param pxRing Ring.
+ * @param pucData Receives the bytes.
+ * @param ulLen Maximum number of bytes.
+ * @retval Number of bytes copied.
+ */
+static inline uint32_t spsc_ring_peek(const SpscRing_t *pxRing, uint8_t *pucData, uint32_t ulLen)
+{
+	const uint32_t ulTail = pxRing->ulTail;
+	uint32_t ulCount = pxRing->ulHead - ulTail;
+	uint32_t i;
+
+	if (ulCount > ulLen)
+	{
+		ulCount = ulLen;
+	}
+
+	__DMB();
+
+	for (i = 0; i < ulCount; i++)
+	{
+		pucData[i] = pxRing->pucBuffer[(ulTail + i) & pxRing->ulMask];
+	}
+
+	return ulCount;
+}
+
+/**
+ * @brief Blocks the calling task until the ring is not empty (consumer side).
+ * @param pxRing Ring.
+ * @param xTicksToWait Maximum time to wait.
+ * @retval Number of bytes waiting, 0 on timeout.
+ * @note Uses the calling task's notification count at
+ * SPSC_RING_NOTIFY_INDEX. The waiting flag is set
+ * before the ring is checked again, so a byte put in between is never missed:
+ * either the check sees it or the producer sees the flag and notifies. A
+ * leftover notification only costs one more pass round the loop.
+ */
+static inline uint32_t spsc_ring_wait(SpscRing_t *pxRing, TickType_t xTicksToWait)
+{
+	TimeOut_t xTimeOut;
+	uint32_t ulCount;
+
+	vTaskSetTimeOutState(&xTimeOut);
+	pxRing->xConsumer = xTaskGetCurrentTaskHandle();
+
+	while ((ulCount = spsc_ring_count(pxRing)) == 0U)
+	{
+		pxRing->ulConsumerWaiting = 1;
+		__DMB();
+
+		if ((ulCount = spsc_ring_count(pxRing)) != 0U)
+		{
+			break;
+		}
+
+		if (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE)
+		{
+			break;
+		}
+
+		(void)ulTaskNotifyTakeIndexed(SPSC_RING_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+	}
+
+	pxRing->ulConsumerWaiting = 0;
+
+	return ulCount;
+}
+
+/**
+ * @brief Wakes the consumer if it is blocked in spsc_ring_wait() (producer
+ * side).
+ * @param pxRing Ring.
+ * @param pxHigherPriorityTaskWoken Set if the consumer must run on exit.
+ * @retval None
+ * @note Costs a barrier and a load when the consumer is not waiting. Only from
+ * ISRs at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+static inline void spsc_ring_wake_from_isr(SpscRing_t *pxRing, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	/* The new head must be visible before the flag is read. */
+	__DMB();
+
+	if (pxRing->ulConsumerWaiting != 0U)
+	{
+		pxRing->ulConsumerWaiting = 0;
+		vTaskNotifyGiveIndexedFromISR(pxRing->xConsumer, SPSC_RING_NOTIFY_INDEX, pxHigherPriorityTaskWoken);
+	}
+}
+
+#endif /* SPSC_RING_H */
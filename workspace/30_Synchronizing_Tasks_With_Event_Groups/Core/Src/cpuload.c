@@ -0,0 +1,203 @@
+/*******************************************************************************
+ *
+ * @file	cpuload.c
+ * @brief	CPU load measured as the time the idle task runs.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Hooked in from the 'USER CODE BEGIN Defines' section of
+ * 			'FreeRTOSConfig.h' and from main.c:
+ *
+ * 				traceTASK_SWITCHED_IN() cpuload_task_switched_in(...)
+ * 				vApplicationTickHook() calls cpuload_tick()
+ *
+ * 			Idle time is counted on portGET_RUN_TIME_COUNTER_VALUE(), the
+ * 			DWT cycle counter of runstats.c, from each switch to the idle task
+ * 			to the next switch away from it. No calibration is needed and the
+ * 			idle hook can do anything, idle jobs included (see idlejob.h).
+ * 			The time slept in STOP mode is added to the counter by
+ * 			lowpower.c, so it is idle time too.
+ *
+ * 			Every CPULOAD_SAMPLE_MS the tick hook takes the load of the
+ * 			window just ended, and folds it into two exponential moving
+ * 			averages, of 1 s and 10 s time constants. Ticks suppressed by
+ * 			tickless idle run no tick hook: the first tick after the sleep
+ * 			sees several windows at once, and counts each of them with their
+ * 			average load.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cpuload.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define CPULOAD_SAMPLE_TICKS	pdMS_TO_TICKS(CPULOAD_SAMPLE_MS)
+#define CPULOAD_1S_SAMPLES		(1000U / CPULOAD_SAMPLE_MS)
+#define CPULOAD_10S_SAMPLES		(10000U / CPULOAD_SAMPLE_MS)
+#define CPULOAD_EMA_SHIFT		16U		/* Fraction bits of the averages. */
+#define CPULOAD_MAX_FOLDS		(8U * CPULOAD_10S_SAMPLES)	/* Enough to converge. */
+
+/* Variables -----------------------------------------------------------------*/
+/* Written with interrupts masked up to configMAX_SYSCALL_INTERRUPT_PRIORITY,
+ * by the context switch and the tick interrupt. */
+static configRUN_TIME_COUNTER_TYPE xIdleTime = 0;		/* Until xLastSwitch. */
+static configRUN_TIME_COUNTER_TYPE xLastSwitch = 0;
+static uint8_t ucIdleRunning = 0;
+static configRUN_TIME_COUNTER_TYPE xSampleTime = 0;
+static configRUN_TIME_COUNTER_TYPE xSampleIdleTime = 0;
+static TickType_t xSampleTick = 0;
+static int32_t lLoad1s = 0;								/* Load << CPULOAD_EMA_SHIFT */
+static int32_t lLoad10s = 0;
+static CpuLoad_t xLoad;
+
+/* Private function prototypes -----------------------------------------------*/
+static void cpuload_reporter_task(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Reads the CPU load.
+ * @param pxLoad Where the loads are written, in units of 0.01 %.
+ * @retval None
+ * @note Cheap enough to call often from any task.
+ */
+void cpuload_get(CpuLoad_t *pxLoad)
+{
+	taskENTER_CRITICAL();
+	*pxLoad = xLoad;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Formats a load as a percentage with two decimals, e.g. "12.34%".
+ * @param usLoad Load in units of 0.01 %.
+ * @param pcBuffer Buffer of CPULOAD_STR_LEN characters.
+ * @retval pcBuffer.
+ */
+const char *cpuload_format(uint16_t usLoad, char *pcBuffer)
+{
+	(void)snprintf(pcBuffer, CPULOAD_STR_LEN, "%u.%02u%%",
+			(unsigned)(usLoad / 100U), (unsigned)(usLoad % 100U));
+
+	return pcBuffer;
+}
+
+/**
+ * @brief Creates a task that prints the CPU load periodically.
+ * @param ulPeriodMs Print period in milliseconds.
+ * @param uxPriority Priority of the reporter task.
+ * @retval pdPASS if the task was created.
+ */
+BaseType_t cpuload_start_reporter(uint32_t ulPeriodMs, UBaseType_t uxPriority)
+{
+	return xTaskCreate(cpuload_reporter_task,
+					   "CpuLoad",
+					   CPULOAD_REPORTER_STACK_WORDS,
+					   (void *)ulPeriodMs,
+					   uxPriority,
+					   NULL);
+}
+
+/**
+ * @brief Accounts the time up to a context switch (traceTASK_SWITCHED_IN).
+ * @param xIdle Nonzero if the task switched in is the idle task.
+ * @retval None
+ * @note Called by the kernel within vTaskSwitchContext().
+ */
+void cpuload_task_switched_in(int xIdle)
+{
+	const configRUN_TIME_COUNTER_TYPE xNow = portGET_RUN_TIME_COUNTER_VALUE();
+
+	if (ucIdleRunning != 0U)
+	{
+		xIdleTime += xNow - xLastSwitch;
+	}
+
+	xLastSwitch = xNow;
+	ucIdleRunning = (xIdle != 0) ? 1U : 0U;
+}
+
+/**
+ * @brief Samples the load every CPULOAD_SAMPLE_MS (vApplicationTickHook).
+ * @param None
+ * @retval None
+ */
+void cpuload_tick(void)
+{
+	configRUN_TIME_COUNTER_TYPE xNow;
+	configRUN_TIME_COUNTER_TYPE xIdleNow;
+	configRUN_TIME_COUNTER_TYPE xElapsed;
+	configRUN_TIME_COUNTER_TYPE xIdle;
+	const TickType_t xTicks = xTaskGetTickCountFromISR() - xSampleTick;
+	uint32_t ulWindows;
+	int32_t lSample;
+
+	if (xTicks < CPULOAD_SAMPLE_TICKS)
+	{
+		return;
+	}
+
+	ulWindows = xTicks / CPULOAD_SAMPLE_TICKS;
+	xSampleTick += ulWindows * CPULOAD_SAMPLE_TICKS;
+
+	/* The idle time includes the part of the current idle period so far. */
+	xNow = portGET_RUN_TIME_COUNTER_VALUE();
+	xIdleNow = xIdleTime + ((ucIdleRunning != 0U) ? (xNow - xLastSwitch) : 0U);
+	xElapsed = xNow - xSampleTime;
+	xIdle = xIdleNow - xSampleIdleTime;
+	xSampleTime = xNow;
+	xSampleIdleTime = xIdleNow;
+
+	if ((xElapsed == 0U) || (xIdle > xElapsed))
+	{
+		xIdle = xElapsed;
+	}
+
+	lSample = (xElapsed > 0U) ?
+			(int32_t)(CPULOAD_FULL - (uint32_t)((xIdle * CPULOAD_FULL) / xElapsed)) : 0;
+
+	if (ulWindows > CPULOAD_MAX_FOLDS)
+	{
+		ulWindows = CPULOAD_MAX_FOLDS;
+	}
+
+	/* One step of each average per window. */
+	while (ulWindows-- > 0U)
+	{
+		lLoad1s += ((lSample << CPULOAD_EMA_SHIFT) - lLoad1s) / (int32_t)CPULOAD_1S_SAMPLES;
+		lLoad10s += ((lSample << CPULOAD_EMA_SHIFT) - lLoad10s) / (int32_t)CPULOAD_10S_SAMPLES;
+	}
+
+	xLoad.usLoad100ms = (uint16_t)lSample;
+	xLoad.usLoad1s = (uint16_t)((lLoad1s + (1L << (CPULOAD_EMA_SHIFT - 1U))) >> CPULOAD_EMA_SHIFT);
+	xLoad.usLoad10s = (uint16_t)((lLoad10s + (1L << (CPULOAD_EMA_SHIFT - 1U))) >> CPULOAD_EMA_SHIFT);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Prints the CPU load every period.
+ * @param pvParameters Print period in milliseconds.
+ * @retval None
+ */
+static void cpuload_reporter_task(void *pvParameters)
+{
+	const TickType_t xPeriodTicks = pdMS_TO_TICKS((uint32_t)pvParameters);
+	TickType_t xLastWakeTicks = xTaskGetTickCount();
+	CpuLoad_t xNow;
+	char cLoad100ms[CPULOAD_STR_LEN];
+	char cLoad1s[CPULOAD_STR_LEN];
+	char cLoad10s[CPULOAD_STR_LEN];
+
+	while (1)
+	{
+		vTaskDelayUntil(&xLastWakeTicks, xPeriodTicks);
+		cpuload_get(&xNow);
+		printf("CPU load: %s (100 ms) %s (1 s) %s (10 s)\r\n",
+				cpuload_format(xNow.usLoad100ms, cLoad100ms),
+				cpuload_format(xNow.usLoad1s, cLoad1s),
+				cpuload_format(xNow.usLoad10s, cLoad10s));
+	}
+}
@@ -8,36 +8,78 @@
  * @note	'event_groups.h' must be included inside the 'cmsis_os.h' to use
  * 			event groups.
  *
+ * 			The three tasks never block but on each other, and vTask3 logs
+ * 			and busy-loops every round, so the CPU is always saturated. With
+ * 			OVERLOAD_MANAGER set, the overload manager (overload.h) sheds,
+ * 			in this order, the per-round log line, then the round rate:
+ * 			vTask3 then waits ROUND_PACE_MS after each round. Each comes
+ * 			back once the CPU load has stayed low for the restore hold.
+ * 			vTask3 prints the manager's state every OVERLOAD_PRINT_MS.
+ *
  ******************************************************************************/
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
 #include <string.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
 #include "uart.h"
 #include "exti.h"
 #include "adc.h"
+#include "barrier.h"
+#include "cpuload.h"
+#include "overload.h"
 
 /* Macros --------------------------------------------------------------------*/
+#define SYNC_WITH_BARRIER 1	/* 0: xEventGroupSync(), 1: barrier */
+
 #define TASK1_BIT (1UL << 0UL)
 #define TASK2_BIT (1UL << 1UL)
 #define TASK3_BIT (1UL << 2UL)
 
+#define SYNC_TASKS 3U
+#define BARRIER_NOTIFY_INDEX 0U
+
+#define OVERLOAD_MANAGER 1		/* 0: everything runs whatever the load, 1: shed under overload */
+#define OVERLOAD_PRIORITY 2U	/* Above the three tasks, whose work it sheds. */
+#define OVERLOAD_PRINT_MS 5000U
+#define ROUND_PACE_MS 50U		/* Wait of vTask3 after each round, when the round rate is shed. */
+
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 static void vTask1(void *pvParameters);
 static void vTask2(void *pvParameters);
 static void vTask3(void *pvParameters);
+#if (OVERLOAD_MANAGER == 1)
+static void vShedFlag(void *pvContext);
+static void vRestoreFlag(void *pvContext);
+#endif
 
 /* Data types ----------------------------------------------------------------*/
 
 /* Variables -----------------------------------------------------------------*/
+#if (SYNC_WITH_BARRIER == 1)
+/* The last task to arrive wakes the others, one notification each, instead of
+every arrival walking the event group's list of waiting tasks. */
+static StaticBarrier_t xBarrierBuffer;
+static TaskHandle_t xBarrierWaiters[SYNC_TASKS - 1U];
+BarrierHandle_t xBarrier;
+#else
 EventGroupHandle_t xEventGroup;
 EventBits_t uxAllSyncBits = (TASK1_BIT | TASK2_BIT | TASK3_BIT);
+#endif
 const TickType_t xDelay500ms = pdMS_TO_TICKS(500UL);
 
+#if (OVERLOAD_MANAGER == 1)
+/* Set by the overload manager, read by vTask3 every round. */
+static volatile uint32_t ulLogShed = 0;
+static volatile uint32_t ulPaceShed = 0;
+static OverloadAction_t xLogAction;
+static OverloadAction_t xPaceAction;
+#endif
+
 /**
  * @brief The application entry point.
  * @retval int
@@ -61,8 +103,22 @@ int main(void)
 	xTaskCreate(vTask2, "vTask2", 128, NULL, 1, NULL);
 	xTaskCreate(vTask3, "vTask3", 128, NULL, 1, NULL);
 
-
+#if (SYNC_WITH_BARRIER == 1)
+	xBarrier = xBarrierCreateStatic(SYNC_TASKS, BARRIER_NOTIFY_INDEX, xBarrierWaiters, &xBarrierBuffer);
+#else
 	xEventGroup = xEventGroupCreate();
+#endif
+
+#if (OVERLOAD_MANAGER == 1)
+	/* Least needed first: the log line goes before the round rate. */
+	overload_register(&xLogAction, "debug log", vShedFlag, vRestoreFlag, (void *)&ulLogShed);
+	overload_register(&xPaceAction, "round rate", vShedFlag, vRestoreFlag, (void *)&ulPaceShed);
+
+	if (overload_start(OVERLOAD_PRIORITY) != pdPASS)
+	{
+		Error_Handler();
+	}
+#endif
 
 	vTaskStartScheduler();
 
@@ -82,10 +138,13 @@ int main(void)
  */
 void vTask1(void *pvParameters)
 {
-	EventBits_t uxReturn;
-
 	while (1)
 	{
+#if (SYNC_WITH_BARRIER == 1)
+		if (xBarrierWait(xBarrier, portMAX_DELAY) == pdTRUE)
+#else
+		EventBits_t uxReturn;
+
 		uxReturn = xEventGroupSync(
 				xEventGroup,
 				TASK1_BIT,
@@ -93,6 +152,7 @@ void vTask1(void *pvParameters)
 				portMAX_DELAY);
 
 		if ((uxReturn & uxAllSyncBits) == uxAllSyncBits)
+#endif
 		{
 			/* Do something. */
 		}
@@ -108,10 +168,13 @@ void vTask1(void *pvParameters)
  */
 void vTask2(void *pvParameters)
 {
-	EventBits_t uxReturn;
-
 	while (1)
 	{
+#if (SYNC_WITH_BARRIER == 1)
+		if (xBarrierWait(xBarrier, portMAX_DELAY) == pdTRUE)
+#else
+		EventBits_t uxReturn;
+
 		uxReturn = xEventGroupSync(
 				xEventGroup,
 				TASK2_BIT,
@@ -119,6 +182,7 @@ void vTask2(void *pvParameters)
 				portMAX_DELAY);
 
 		if ((uxReturn & uxAllSyncBits) == uxAllSyncBits)
+#endif
 		{
 			/* Do something. */
 		}
@@ -136,10 +200,17 @@ void vTask2(void *pvParameters)
  */
 void vTask3(void *pvParameters)
 {
-	EventBits_t uxReturn;
+#if (OVERLOAD_MANAGER == 1)
+	TickType_t xLastPrint = xTaskGetTickCount();
+#endif
 
 	while (1)
 	{
+#if (SYNC_WITH_BARRIER == 1)
+		if (xBarrierWait(xBarrier, portMAX_DELAY) == pdTRUE)
+#else
+		EventBits_t uxReturn;
+
 		uxReturn = xEventGroupSync(
 				xEventGroup,
 				TASK3_BIT,
@@ -147,62 +218,79 @@ void vTask3(void *pvParameters)
 				portMAX_DELAY);
 
 		if ((uxReturn & uxAllSyncBits) == uxAllSyncBits)
+#endif
 		{
 			/* Do something. */
-			printf("All tasks' are set!\r\n");
+#if (OVERLOAD_MANAGER == 1)
+			if (ulLogShed == 0U)
+#endif
+			{
+				printf("All tasks' are set!\r\n");
+			}
 
 			for (int i = 0; i < 600000; i++)
 			{
 				/* Do nothing. */
 			}
+
+#if (OVERLOAD_MANAGER == 1)
+			if (ulPaceShed != 0U)
+			{
+				vTaskDelay(pdMS_TO_TICKS(ROUND_PACE_MS));
+			}
+
+			if ((xTaskGetTickCount() - xLastPrint) >= pdMS_TO_TICKS(OVERLOAD_PRINT_MS))
+			{
+				xLastPrint = xTaskGetTickCount();
+				overload_print();
+			}
+#endif
 		}
 	}
 }
 
+#if (OVERLOAD_MANAGER == 1)
 /**
- * @brief System Clock Configuration
+ * @brief Sheds the work behind a flag (overload manager).
+ * @param pvContext The flag, read by vTask3.
  * @retval None
  */
-void SystemClock_Config(void)
+static void vShedFlag(void *pvContext)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
+	*(volatile uint32_t *)pvContext = 1U;
+}
 
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-	{
-		Error_Handler();
-	}
+/**
+ * @brief Restores the work behind a flag (overload manager).
+ * @param pvContext The flag, read by vTask3.
+ * @retval None
+ */
+static void vRestoreFlag(void *pvContext)
+{
+	*(volatile uint32_t *)pvContext = 0U;
+}
+#endif
 
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+/**
+ * @brief A tick hook function to sample the CPU load.
+ * @retval None
+ * @note Called from the tick interrupt. 'configUSE_TICK_HOOK' must be enabled
+ * in 'FreeRTOSConfig.h' file for this function to be called.
+ */
+void vApplicationTickHook(void)
+{
+	cpuload_tick();
+}
 
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+/**
+ * @brief System Clock Configuration
+ * @retval None
+ */
+void SystemClock_Config(void)
+{
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
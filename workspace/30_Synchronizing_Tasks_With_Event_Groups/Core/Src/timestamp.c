@@ -0,0 +1,230 @@
+/*******************************************************************************
+ *
+ * @file	timestamp.c
+ * @brief	Monotonic 64-bit microsecond time source on TIM5.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	TIM5 is a free-running 32-bit counter at 1 MHz. It is extended to
+ * 			64 bits with a reference point (time, count): the time now is
+ * 			the reference time plus the count elapsed since the reference
+ * 			count, which is exact while the reference is less than 2^32 us
+ * 			old. Compare channel 2 fires every 2^31 us to move the reference
+ * 			forward, so it never gets that old.
+ *
+ * 			The reference is published as a latch, a seqlock with two
+ * 			copies: the writer updates one copy while readers use the
+ * 			other, and a reader only retries if the sequence number changed
+ * 			under it. A reader never waits for the writer, so
+ * 			timestamp_now_us() is safe from tasks and from ISRs of any
+ * 			priority, without a critical section.
+ *
+ * 			TIM5 is shared with hrtimer.c, which uses compare channel 1.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "timestamp.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define TIMESTAMP_TICK_HZ		1000000U
+#define TIMESTAMP_REFRESH_US	0x80000000U		/* Half the counter range. */
+#define TIM_CR1_CEN_OFS			0U
+#define TIM_CR1_URS_OFS			2U
+#define TIM_DIER_CC1IE_OFS		1U
+#define TIM_DIER_CC2IE_OFS		2U
+#define TIM_SR_CC1IF_OFS		1U
+#define TIM_SR_CC2IF_OFS		2U
+#define TIM_EGR_UG_OFS			0U
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint64_t ullTime;	/* Microseconds at ulCount. */
+	uint32_t ulCount;	/* TIM5 count at ullTime. */
+} TimestampRef_t;
+
+/* Variables -----------------------------------------------------------------*/
+static volatile uint32_t ulSequence = 0;
+static volatile TimestampRef_t xRef[2];
+
+/* Private function prototypes -----------------------------------------------*/
+static void timestamp_publish(uint64_t ullTime, uint32_t ulCount);
+static uint32_t timestamp_timer_clock(void);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Starts TIM5 as a free-running 1 MHz counter, or adapts its prescaler
+ * to the current bus clock if it is already running.
+ * @param None
+ * @retval 0 if successful, -1 if the timer clock is not a whole number of MHz.
+ * @note Time stays monotonic across a call made after changing the clock
+ * profile, but the counter restarts from 0, so compare deadlines set on it
+ * (hrtimer.c) must be set again.
+ */
+int32_t timestamp_init(void)
+{
+	const uint32_t ulClock = timestamp_timer_clock();
+	uint64_t ullNow = 0;
+	uint32_t ulPrimask;
+
+	if ((ulClock % TIMESTAMP_TICK_HZ) != 0U)
+	{
+		return -1;
+	}
+
+	ulPrimask = __get_PRIMASK();
+	__disable_irq();
+
+	if (TIM5->CR1 & (1U << TIM_CR1_CEN_OFS))
+	{
+		ullNow = timestamp_now_us();
+	}
+	else
+	{
+		/* Enable clock for TIM5. */
+		RCC->APB1ENR |= (1U << 3);
+
+		/* Only a UG event updates the prescaler, and it must not raise an
+		 * interrupt. */
+		TIM5->CR1 = (1U << TIM_CR1_URS_OFS);
+		TIM5->ARR = 0xFFFFFFFFU;
+		TIM5->CCMR1 = 0;	/* Channels 1 and 2 frozen: compare only, no output. */
+		TIM5->DIER = (1U << TIM_DIER_CC2IE_OFS);
+
+		NVIC_SetPriority(TIM5_IRQn, TIMESTAMP_IRQ_PRIORITY);
+		NVIC_EnableIRQ(TIM5_IRQn);
+	}
+
+	/* Load the prescaler, which also clears the counter. */
+	TIM5->PSC = (ulClock / TIMESTAMP_TICK_HZ) - 1U;
+	TIM5->EGR = (1U << TIM_EGR_UG_OFS);
+	timestamp_publish(ullNow, 0);
+	TIM5->CCR2 = TIMESTAMP_REFRESH_US;
+	TIM5->SR = ~(1U << TIM_SR_CC2IF_OFS);
+	TIM5->CR1 |= (1U << TIM_CR1_CEN_OFS);
+
+	__set_PRIMASK(ulPrimask);
+
+	return 0;
+}
+
+/**
+ * @brief Returns the microseconds elapsed since timestamp_init() was first
+ * called.
+ * @param None
+ * @retval Monotonic 64-bit time.
+ * @note Lock-free: callable from tasks and from ISRs of any priority.
+ */
+uint64_t timestamp_now_us(void)
+{
+	uint32_t ulSeq;
+	uint64_t ullTime;
+	uint32_t ulRefCount;
+	uint32_t ulCount;
+
+	do
+	{
+		ulSeq = ulSequence;
+		__DMB();
+		ullTime = xRef[ulSeq & 1U].ullTime;
+		ulRefCount = xRef[ulSeq & 1U].ulCount;
+		ulCount = TIM5->CNT;
+		__DMB();
+	} while (ulSeq != ulSequence);
+
+	return ullTime + (uint32_t)(ulCount - ulRefCount);
+}
+
+/**
+ * @brief Returns the low 32 bits of the time, which is the TIM5 count.
+ * @param None
+ * @retval Microseconds, wrapping every 2^32 us (about 71 minutes).
+ */
+uint32_t timestamp_now32(void)
+{
+	return TIM5->CNT;
+}
+
+/**
+ * @brief Called from the TIM5 interrupt on a compare channel 1 match.
+ * @param None
+ * @retval None
+ * @note Weak; hrtimer.c overrides it.
+ */
+__weak void timestamp_compare_callback(void)
+{
+}
+
+/**
+ * @brief TIM5 IRQ handler.
+ * @param None
+ * @retval None
+ */
+void TIM5_IRQHandler(void)
+{
+	const uint32_t ulStatus = TIM5->SR & TIM5->DIER;
+	const volatile TimestampRef_t *pxRef;
+	uint32_t ulCount;
+
+	if (ulStatus & (1U << TIM_SR_CC2IF_OFS))
+	{
+		TIM5->SR = ~(1U << TIM_SR_CC2IF_OFS);
+
+		/* Only this handler writes the reference, so the current copy is
+		 * stable here. */
+		pxRef = &xRef[ulSequence & 1U];
+		ulCount = TIM5->CNT;
+		timestamp_publish(pxRef->ullTime + (uint32_t)(ulCount - pxRef->ulCount), ulCount);
+		TIM5->CCR2 += TIMESTAMP_REFRESH_US;
+	}
+
+	if (ulStatus & (1U << TIM_SR_CC1IF_OFS))
+	{
+		TIM5->SR = ~(1U << TIM_SR_CC1IF_OFS);
+		timestamp_compare_callback();
+	}
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Publishes a new reference point.
+ * @param ullTime Microseconds at ulCount.
+ * @param ulCount TIM5 count.
+ * @retval None
+ * @note One writer at a time: timestamp_init() with interrupts masked, or the
+ * TIM5 interrupt. Readers switch to copy 1 while copy 0 is written, then back
+ * to copy 0 while copy 1 is written.
+ */
+static void timestamp_publish(uint64_t ullTime, uint32_t ulCount)
+{
+	ulSequence++;
+	__DMB();
+	xRef[0].ullTime = ullTime;
+	xRef[0].ulCount = ulCount;
+	__DMB();
+	ulSequence++;
+	__DMB();
+	xRef[1].ullTime = ullTime;
+	xRef[1].ulCount = ulCount;
+	__DMB();
+}
+
+/**
+ * @brief Returns the TIM5 kernel clock.
+ * @param None
+ * @retval PCLK1, doubled when APB1 is divided.
+ */
+static uint32_t timestamp_timer_clock(void)
+{
+	uint32_t ulClock = HAL_RCC_GetPCLK1Freq();
+
+	if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+	{
+		ulClock *= 2U;
+	}
+
+	return ulClock;
+}
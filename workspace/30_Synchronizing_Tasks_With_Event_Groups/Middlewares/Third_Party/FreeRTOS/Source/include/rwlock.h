@@ -0,0 +1,211 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Reader-writer locks let any number of reader tasks hold the lock at the
+ * same time, or one writer task on its own.  They suit read-mostly data, such
+ * as sensor state or configuration tables, that a mutex would needlessly
+ * serialise.
+ *
+ * A reader-writer lock is built from a mutex and a binary semaphore:
+ *
+ * - A writer holds the mutex for the whole write.  Readers only hold it while
+ *   they register themselves, so readers do not serialise each other.
+ *
+ * - Writers are preferred.  Once a writer holds the mutex, new readers and
+ *   writers queue on it, in priority order, while the writer waits on the
+ *   binary semaphore for the registered readers to leave.  The last reader
+ *   out gives the semaphore.
+ *
+ * - Tasks queued on the mutex raise the priority of the writer holding it,
+ *   as for any mutex.  Readers do not inherit priority: a writer waiting for
+ *   readers to leave waits at the readers' own priorities.
+ *
+ * ***NOTE***:  Read locks are not recursive.  A reader that takes the read
+ * lock again while a writer is waiting deadlocks with that writer.  Neither
+ * lock may be used from an interrupt.
+ */
+
+#ifndef RWLOCK_H
+#define RWLOCK_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include rwlock.h"
+#endif
+
+#include "semphr.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * The storage of a reader-writer lock, declared by the application and passed
+ * to xRWLockCreateStatic().  Its members must not be accessed directly.
+ */
+typedef struct RWLockDef_t
+{
+	SemaphoreHandle_t xWriteMutex;
+	SemaphoreHandle_t xReadersDone;
+	volatile UBaseType_t uxReaders;
+	volatile BaseType_t xWriterWaiting;
+	StaticSemaphore_t xWriteMutexBuffer;
+	StaticSemaphore_t xReadersDoneBuffer;
+} StaticRWLock_t;
+
+/**
+ * Type by which reader-writer locks are referenced.
+ */
+typedef StaticRWLock_t * RWLockHandle_t;
+
+/**
+ * rwlock.h
+ *
+<pre>
+RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t *pxRWLockBuffer );
+</pre>
+ *
+ * Creates a reader-writer lock in pxRWLockBuffer, held by nobody.
+ *
+ * @param pxRWLockBuffer The storage of the lock.
+ *
+ * @return A handle to the lock.
+ *
+ * Example usage:
+<pre>
+StaticRWLock_t xSensorLockBuffer;
+RWLockHandle_t xSensorLock;
+SensorState_t xSensorState;
+
+void vSetup( void )
+{
+	xSensorLock = xRWLockCreateStatic( &xSensorLockBuffer );
+}
+
+void vReader( void )
+{
+SensorState_t xCopy;
+
+	if( xRWLockTakeRead( xSensorLock, portMAX_DELAY ) == pdTRUE )
+	{
+		xCopy = xSensorState;
+		vRWLockGiveRead( xSensorLock );
+	}
+}
+</pre>
+ * \defgroup xRWLockCreateStatic xRWLockCreateStatic
+ * \ingroup RWLocks
+ */
+RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t *pxRWLockBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+<pre>
+BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait );
+</pre>
+ *
+ * Takes the lock for reading, blocking for up to xTicksToWait while a writer
+ * holds it or waits for it.
+ *
+ * @return pdTRUE if the lock was taken, pdFALSE if the block time expired
+ * first.
+ *
+ * \defgroup xRWLockTakeRead xRWLockTakeRead
+ * \ingroup RWLocks
+ */
+BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+<pre>
+void vRWLockGiveRead( RWLockHandle_t xRWLock );
+</pre>
+ *
+ * Releases a read lock taken with xRWLockTakeRead().  The last reader out
+ * unblocks a waiting writer.
+ *
+ * \defgroup vRWLockGiveRead vRWLockGiveRead
+ * \ingroup RWLocks
+ */
+void vRWLockGiveRead( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+<pre>
+BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait );
+</pre>
+ *
+ * Takes the lock for writing, blocking for up to xTicksToWait in total:
+ * first while another writer holds the lock, then while readers hold it.
+ * New readers are held off from the moment the writer starts waiting for the
+ * readers to leave.
+ *
+ * @return pdTRUE if the lock was taken, pdFALSE if the block time expired
+ * first.
+ *
+ * \defgroup xRWLockTakeWrite xRWLockTakeWrite
+ * \ingroup RWLocks
+ */
+BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+<pre>
+void vRWLockGiveWrite( RWLockHandle_t xRWLock );
+</pre>
+ *
+ * Releases a write lock taken with xRWLockTakeWrite().  Must be called by the
+ * task that took it.
+ *
+ * \defgroup vRWLockGiveWrite vRWLockGiveWrite
+ * \ingroup RWLocks
+ */
+void vRWLockGiveWrite( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+<pre>
+UBaseType_t uxRWLockGetReaderCount( RWLockHandle_t xRWLock );
+</pre>
+ *
+ * @return The number of tasks holding the lock for reading.
+ *
+ * \defgroup uxRWLockGetReaderCount uxRWLockGetReaderCount
+ * \ingroup RWLocks
+ */
+UBaseType_t uxRWLockGetReaderCount( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif	/* !defined( RWLOCK_H ) */
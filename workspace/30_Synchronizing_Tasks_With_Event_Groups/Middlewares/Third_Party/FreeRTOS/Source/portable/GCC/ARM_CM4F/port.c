@@ -58,6 +58,7 @@
 #define portNVIC_SYSTICK_COUNT_FLAG_BIT		( 1UL << 16UL )
 #define portNVIC_PENDSVCLEAR_BIT 			( 1UL << 27UL )
 #define portNVIC_PEND_SYSTICK_CLEAR_BIT		( 1UL << 25UL )
+#define portNVIC_PEND_SYSTICK_SET_BIT		( 1UL << 26UL )
 
 /* Constants used to detect a Cortex-M7 r0p1 core, which should use the ARM_CM7
 r0p1 port. */
@@ -81,6 +82,21 @@ r0p1 port. */
 /* Masks off all bits but the VECTACTIVE bits in the ICSR register. */
 #define portVECTACTIVE_MASK					( 0xFFUL )
 
+/* Constants required to program the MPU stack guard. */
+#define portMPU_CTRL_REG					( * ( ( volatile uint32_t * ) 0xe000ed94 ) )
+#define portMPU_RNR_REG						( * ( ( volatile uint32_t * ) 0xe000ed98 ) )
+#define portMPU_RASR_REG					( * ( ( volatile uint32_t * ) 0xe000eda0 ) )
+#define portMPU_CTRL_ENABLE_BIT				( 1UL << 0UL )
+#define portMPU_CTRL_PRIVDEFENA_BIT			( 1UL << 2UL )
+#define portMPU_RASR_STACK_GUARD			( ( 1UL << 28UL ) | ( 4UL << 1UL ) | 1UL ) /* XN, no access, 2^(4+1) bytes, enabled. */
+#define portSCB_SHCSR_REG					( * ( ( volatile uint32_t * ) 0xe000ed24 ) )
+#define portSCB_MEMFAULTENA_BIT				( 1UL << 16UL )
+#define portSCB_MMFSR_REG					( * ( ( volatile uint8_t * ) 0xe000ed28 ) )
+#define portSCB_MMFAR_REG					( * ( ( volatile uint32_t * ) 0xe000ed34 ) )
+#define portMMFSR_MSTKERR_BIT				( 1UL << 4UL )
+#define portMMFSR_MLSPERR_BIT				( 1UL << 5UL )
+#define portMMFSR_MMARVALID_BIT				( 1UL << 7UL )
+
 /* Constants required to manipulate the VFP. */
 #define portFPCCR							( ( volatile uint32_t * ) 0xe000ef34 ) /* Floating point context control register. */
 #define portASPEN_AND_LSPEN_BITS			( 0x3UL << 30UL )
@@ -139,6 +155,25 @@ static void vPortEnableVFP( void ) __attribute__ (( naked ));
  */
 static void prvTaskExitError( void );
 
+#if( configUSE_MPU_STACK_GUARD == 1 )
+
+	/*
+	 * Sets the size and attributes of the stack guard region and enables the
+	 * MPU and the MemManage fault.
+	 */
+	static void prvSetupStackGuard( void );
+
+#endif /* configUSE_MPU_STACK_GUARD */
+
+#if( configUSE_FAST_COOPERATIVE_YIELD == 1 )
+
+	/*
+	 * The thread mode context switch of vPortYield().
+	 */
+	static void prvPortSwitchInThreadMode( void ) __attribute__ (( naked ));
+
+#endif /* configUSE_FAST_COOPERATIVE_YIELD */
+
 /*-----------------------------------------------------------*/
 
 /* Each task maintains its own interrupt status in the critical nesting
@@ -168,6 +203,15 @@ static UBaseType_t uxCriticalNesting = 0xaaaaaaaa;
 	static uint32_t ulStoppedTimerCompensation = 0;
 #endif /* configUSE_TICKLESS_IDLE */
 
+/*
+ * Ticks per SysTick interrupt, and the number asked for by xPortSetTickRate(),
+ * which the next tick interrupt puts into effect.
+ */
+#if( configUSE_DYNAMIC_TICK_RATE == 1 )
+	static TickType_t xTicksPerInterrupt = 1;
+	static volatile TickType_t xNewTicksPerInterrupt = 1;
+#endif /* configUSE_DYNAMIC_TICK_RATE */
+
 /*
  * Used by the portASSERT_IF_INTERRUPT_PRIORITY_INVALID() macro to ensure
  * FreeRTOS API functions are not called from interrupts that have been assigned
@@ -246,6 +290,9 @@ void vPortSVCHandler( void )
 					"	ldr r1, [r3]					\n" /* Use pxCurrentTCBConst to get the pxCurrentTCB address. */
 					"	ldr r0, [r1]					\n" /* The first item in pxCurrentTCB is the task top of stack. */
 					"	ldmia r0!, {r4-r11, r14}		\n" /* Pop the registers that are not automatically saved on exception entry and the critical nesting count. */
+					"	tst r14, #0x10					\n" /* Never for the first task, but prvPortSwitchInThreadMode() resumes tasks with an FPU context here too. */
+					"	it eq							\n"
+					"	vldmiaeq r0!, {s16-s31}			\n"
 					"	msr psp, r0						\n" /* Restore the task stack pointer. */
 					"	isb								\n"
 					"	mov r0, #0 						\n"
@@ -369,6 +416,14 @@ BaseType_t xPortStartScheduler( void )
 	/* Initialise the critical nesting count ready for the first task. */
 	uxCriticalNesting = 0;
 
+	#if( configUSE_MPU_STACK_GUARD == 1 )
+	{
+		/* vTaskStartScheduler() has already set the guard base to the stack
+		of the first task. */
+		prvSetupStackGuard();
+	}
+	#endif
+
 	/* Ensure the VFP is enabled - it should be anyway. */
 	vPortEnableVFP();
 
@@ -400,7 +455,7 @@ void vPortEndScheduler( void )
 }
 /*-----------------------------------------------------------*/
 
-void vPortEnterCritical( void )
+KERNEL_RAM_FUNCTION void vPortEnterCritical( void )
 {
 	portDISABLE_INTERRUPTS();
 	uxCriticalNesting++;
@@ -413,22 +468,24 @@ void vPortEnterCritical( void )
 	if( uxCriticalNesting == 1 )
 	{
 		configASSERT( ( portNVIC_INT_CTRL_REG & portVECTACTIVE_MASK ) == 0 );
+		traceENTER_CRITICAL_SECTION( portGET_RETURN_ADDRESS() );
 	}
 }
 /*-----------------------------------------------------------*/
 
-void vPortExitCritical( void )
+KERNEL_RAM_FUNCTION void vPortExitCritical( void )
 {
 	configASSERT( uxCriticalNesting );
 	uxCriticalNesting--;
 	if( uxCriticalNesting == 0 )
 	{
+		traceEXIT_CRITICAL_SECTION();
 		portENABLE_INTERRUPTS();
 	}
 }
 /*-----------------------------------------------------------*/
 
-void xPortPendSVHandler( void )
+KERNEL_RAM_FUNCTION void xPortPendSVHandler( void )
 {
 	/* This is a naked function. */
 
@@ -485,8 +542,151 @@ void xPortPendSVHandler( void )
 }
 /*-----------------------------------------------------------*/
 
-void xPortSysTickHandler( void )
+#if( configUSE_FAST_COOPERATIVE_YIELD == 1 )
+
+	KERNEL_RAM_FUNCTION void vPortYield( void )
+	{
+	uint32_t ulIPSR, ulBASEPRI;
+
+		__asm volatile( "mrs %0, ipsr" : "=r"( ulIPSR ) :: "memory" );
+		__asm volatile( "mrs %0, basepri" : "=r"( ulBASEPRI ) :: "memory" );
+
+		/* The switch cannot be made now from an interrupt, or with interrupts
+		masked: the kernel yields inside critical sections and relies on the
+		PendSV being taken when they end.  uxCriticalNesting is not 0 before
+		the scheduler starts either. */
+		if( ( uxCriticalNesting == 0 ) && ( ulIPSR == 0 ) && ( ulBASEPRI == 0 ) )
+		{
+			prvPortSwitchInThreadMode();
+		}
+		else
+		{
+			portYIELD_PENDSV();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	KERNEL_RAM_FUNCTION static void prvPortSwitchInThreadMode( void )
+	{
+		/* This is a naked function, called from a task on its own stack, the
+		PSP, 8 byte aligned as at any call.
+
+		The context is saved as xPortPendSVHandler() would save it had the task
+		been interrupted at label 3, which returns to the caller.  R4-R11, LR,
+		S16-S31 and the FPSCR are the only registers a call has to preserve;
+		the slots of the others are left as they are.  A task that has not
+		used the FPU (CONTROL.FPCA clear) gets the basic frame and no FP
+		register is touched.  The interrupt mask is raised around
+		vTaskSwitchContext() as in xPortPendSVHandler(): interrupts change the
+		ready lists.
+
+		A task whose saved PC is label 3 was switched out here, or interrupted
+		at the "bx lr" there, and is resumed by loading its registers and
+		jumping to its LR.  Any other task can be in an IT block with state in
+		its xPSR, and is resumed by exception return through
+		vPortSVCHandler().  SVC has priority 0 so the raised mask does not hold
+		it off. */
+		__asm volatile
+		(
+		"	mov r0, %0							\n" /* Raise the interrupt mask. */
+		"	msr basepri, r0						\n"
+		"	dsb									\n"
+		"	isb									\n"
+		"	ldr r0, ulICSRConst3				\n" /* Clear a PendSV requested meanwhile: this is the switch. */
+		"	mov r1, #0x08000000					\n"
+		"	str r1, [r0]						\n"
+		"										\n"
+		"	mrs r1, control						\n"
+		"	adr r2, 3f							\n" /* Stacked PC: label 3. */
+		"	mov r3, #0x01000000					\n" /* Stacked xPSR: Thumb state. */
+		"	tst r1, #4							\n" /* FPCA: does the task have an FPU context? */
+		"	bne 1f								\n"
+		"	sub sp, sp, #32						\n" /* Basic frame: R0-R3, R12, LR, PC and xPSR. */
+		"	strd r2, r3, [sp, #24]				\n"
+		"	str lr, [sp, #20]					\n"
+		"	mvn lr, #2							\n" /* EXC_RETURN 0xFFFFFFFD: thread mode, PSP, no FPU frame. */
+		"	b 2f								\n"
+		"1:										\n"
+		"	sub sp, sp, #104					\n" /* Extended frame: also S0-S15, FPSCR and a reserved word. */
+		"	strd r2, r3, [sp, #24]				\n"
+		"	str lr, [sp, #20]					\n"
+		"	vmrs r0, fpscr						\n"
+		"	str r0, [sp, #96]					\n"
+		"	vstmdb sp!, {s16-s31}				\n"
+		"	mvn lr, #0x12						\n" /* EXC_RETURN 0xFFFFFFED: thread mode, PSP, FPU frame. */
+		"2:										\n"
+		"	stmdb sp!, {r4-r11, lr}				\n" /* Save the core registers. */
+		"	ldr r3, pxCurrentTCBConst3			\n"
+		"	ldr r2, [r3]						\n"
+		"	mov r0, sp							\n"
+		"	str r0, [r2]						\n" /* Save the new top of stack into the first member of the TCB. */
+		"										\n"
+		"	bl vTaskSwitchContext				\n"
+		"										\n"
+		"	mrs r1, control						\n" /* The FPU context is saved: clear FPCA, so it is not stacked */
+		"	bic r1, r1, #4						\n" /* again, and set again by the VLDM below if the next task has one. */
+		"	msr control, r1						\n"
+		"	isb									\n"
+		"	ldr r3, pxCurrentTCBConst3			\n"
+		"	ldr r1, [r3]						\n"
+		"	ldr r0, [r1]						\n" /* The first item in pxCurrentTCB is the task top of stack. */
+		"	ldr r2, [r0, #32]					\n" /* Its EXC_RETURN. */
+		"	tst r2, #0x10						\n"
+		"	ite eq								\n"
+		"	addeq r1, r0, #100					\n" /* Its hardware frame, after R4-R11, EXC_RETURN and S16-S31. */
+		"	addne r1, r0, #36					\n"
+		"	ldr r1, [r1, #24]					\n" /* Its stacked PC. */
+		"	adr r3, 3f							\n"
+		"	cmp r1, r3							\n"
+		"	bne 4f								\n"
+		"										\n"
+		"	ldmia r0!, {r4-r11, r14}			\n" /* Pop the core registers. */
+		"	tst r14, #0x10						\n"
+		"	bne 5f								\n"
+		"	vldmia r0!, {s16-s31}				\n" /* Pop the high vfp registers and the FPSCR. */
+		"	ldr r1, [r0, #96]					\n"
+		"	vmsr fpscr, r1						\n"
+		"5:										\n"
+		"	ldr r1, [r0, #20]					\n" /* Stacked LR: the return address. */
+		"	ldr r2, [r0, #28]					\n" /* Stacked xPSR. */
+		"	tst r14, #0x10						\n" /* Skip the hardware frame, extended or basic. */
+		"	ite eq								\n"
+		"	addeq r0, r0, #104					\n"
+		"	addne r0, r0, #32					\n"
+		"	tst r2, #0x200						\n" /* Skip the word the hardware may have added to align the frame. */
+		"	it ne								\n"
+		"	addne r0, r0, #4					\n"
+		"	mov sp, r0							\n"
+		"	mov r0, #0							\n"
+		"	msr basepri, r0						\n"
+		"	bx r1								\n"
+		"										\n"
+		"4:										\n"
+		"	svc 0								\n" /* Exception return into the task, with BASEPRI cleared. */
+		"3:										\n"
+		"	bx lr								\n"
+		"										\n"
+		"	.align 4							\n"
+		"pxCurrentTCBConst3: .word pxCurrentTCB	\n"
+		"ulICSRConst3: .word 0xe000ed04			\n"
+		::"i"(configMAX_SYSCALL_INTERRUPT_PRIORITY)
+		);
+	}
+
+#endif /* configUSE_FAST_COOPERATIVE_YIELD */
+/*-----------------------------------------------------------*/
+
+KERNEL_RAM_FUNCTION void xPortSysTickHandler( void )
 {
+#if( configUSE_TICK_STATS == 1 )
+	/* The SysTick counts down from its reload value, and requested this
+	interrupt when it reloaded, so the counts since are how late the tick is
+	taken. */
+	const uint32_t ulLoad = portNVIC_SYSTICK_LOAD_REG;
+	const uint32_t ulEntry = portNVIC_SYSTICK_CURRENT_VALUE_REG;
+	uint32_t ulExit;
+#endif
+
 	/* The SysTick runs at the lowest interrupt priority, so when this interrupt
 	executes all interrupts must be unmasked.  There is therefore no need to
 	save and then restore the interrupt mask value as its value is already
@@ -494,12 +694,49 @@ void xPortSysTickHandler( void )
 	portDISABLE_INTERRUPTS();
 	{
 		/* Increment the RTOS tick. */
+		#if( configUSE_DYNAMIC_TICK_RATE == 1 )
+		if( xTaskIncrementTickBy( xTicksPerInterrupt ) != pdFALSE )
+		#else
 		if( xTaskIncrementTick() != pdFALSE )
+		#endif
 		{
 			/* A context switch is required.  Context switching is performed in
 			the PendSV interrupt.  Pend the PendSV interrupt. */
 			portNVIC_INT_CTRL_REG = portNVIC_PENDSVSET_BIT;
 		}
+
+		#if( configUSE_TICK_STATS == 1 )
+		{
+			ulExit = portNVIC_SYSTICK_CURRENT_VALUE_REG;
+
+			/* A tick that ran past the next reload counted down through 0. */
+			if( ulExit > ulEntry )
+			{
+				vTaskRecordTickStats( ulLoad - ulEntry, ulEntry + ( ulLoad + 1UL ) - ulExit );
+			}
+			else
+			{
+				vTaskRecordTickStats( ulLoad - ulEntry, ulEntry - ulExit );
+			}
+		}
+		#endif /* configUSE_TICK_STATS */
+
+		#if( configUSE_DYNAMIC_TICK_RATE == 1 )
+		{
+			/* Change the rate at this tick boundary.  The period restarts
+			here, so only the few cycles since SysTick reloaded are lost. */
+			if( xNewTicksPerInterrupt != xTicksPerInterrupt )
+			{
+				xTicksPerInterrupt = xNewTicksPerInterrupt;
+				portNVIC_SYSTICK_LOAD_REG = ( xTicksPerInterrupt * ( configSYSTICK_CLOCK_HZ / configTICK_RATE_HZ ) ) - 1UL;
+				portNVIC_SYSTICK_CURRENT_VALUE_REG = 0UL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_DYNAMIC_TICK_RATE */
 	}
 	portENABLE_INTERRUPTS();
 }
@@ -771,5 +1008,122 @@ static void vPortEnableVFP( void )
 	}
 
 #endif /* configASSERT_DEFINED */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_DYNAMIC_TICK_RATE == 1 )
+
+	BaseType_t xPortSetTickRate( uint32_t ulTickRateHz )
+	{
+	TickType_t xTicks;
+
+		/* Whole ticks per interrupt, and a reload SysTick can hold. */
+		if( ( ulTickRateHz == 0UL ) || ( ulTickRateHz > configTICK_RATE_HZ ) || ( ( configTICK_RATE_HZ % ulTickRateHz ) != 0UL ) )
+		{
+			return pdFAIL;
+		}
+
+		xTicks = ( TickType_t ) ( configTICK_RATE_HZ / ulTickRateHz );
+
+		if( ( ( xTicks * ( configSYSTICK_CLOCK_HZ / configTICK_RATE_HZ ) ) - 1UL ) > portMAX_24_BIT_NUMBER )
+		{
+			return pdFAIL;
+		}
+
+		/* A single store, picked up by the next tick interrupt. */
+		xNewTicksPerInterrupt = xTicks;
+
+		return pdPASS;
+	}
+	/*-----------------------------------------------------------*/
+
+	uint32_t ulPortGetTickRate( void )
+	{
+		return ( uint32_t ) ( configTICK_RATE_HZ / xTicksPerInterrupt );
+	}
+
+#endif /* configUSE_DYNAMIC_TICK_RATE */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_IDLE_SLEEP == 1 )
+
+	void vPortIdleSleep( void )
+	{
+	uint32_t ulLoad, ulCount;
+
+		/* With interrupts masked, an interrupt still ends the WFI but is only
+		taken once they are unmasked again, so the SysTick can be read first. */
+		__asm volatile( "cpsid i" ::: "memory" );
+		__asm volatile( "dsb" ::: "memory" );
+		__asm volatile( "wfi" );
+
+		if( ( portNVIC_INT_CTRL_REG & portNVIC_PEND_SYSTICK_SET_BIT ) != 0UL )
+		{
+			/* The SysTick counts down from its reload value, and requested the
+			interrupt when it reloaded, so the counts since are the wake-up
+			latency. */
+			ulLoad = portNVIC_SYSTICK_LOAD_REG;
+			ulCount = portNVIC_SYSTICK_CURRENT_VALUE_REG;
+			vTaskRecordIdleSleep( pdTRUE, ulLoad - ulCount );
+		}
+		else
+		{
+			vTaskRecordIdleSleep( pdFALSE, 0UL );
+		}
 
+		__asm volatile( "cpsie i" ::: "memory" );
+		__asm volatile( "isb" );
+	}
+
+#endif /* configUSE_IDLE_SLEEP */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MPU_STACK_GUARD == 1 )
+
+	static void prvSetupStackGuard( void )
+	{
+		portMPU_RNR_REG = portSTACK_GUARD_REGION;
+		portMPU_RASR_REG = portMPU_RASR_STACK_GUARD;
+
+		/* The default memory map stays in place for privileged accesses, and
+		tasks run privileged: only the guard faults. */
+		portMPU_CTRL_REG = portMPU_CTRL_PRIVDEFENA_BIT | portMPU_CTRL_ENABLE_BIT;
+		portSCB_SHCSR_REG |= portSCB_MEMFAULTENA_BIT;
+		__asm volatile( "dsb\n" "isb" ::: "memory" );
+	}
+
+#endif /* configUSE_MPU_STACK_GUARD */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MPU_STACK_GUARD == 1 )
+
+	BaseType_t xPortIsStackGuardFault( void )
+	{
+	const uint32_t ulStatus = portSCB_MMFSR_REG;
+	uint32_t ulBase;
+	BaseType_t xReturn = pdFALSE;
+
+		if( ( ulStatus & ( portMMFSR_MSTKERR_BIT | portMMFSR_MLSPERR_BIT ) ) != 0UL )
+		{
+			/* Interrupt handlers stack on the main stack, which has no guard,
+			so a stacking fault is on the stack of the running task. */
+			xReturn = pdTRUE;
+		}
+		else if( ( ulStatus & portMMFSR_MMARVALID_BIT ) != 0UL )
+		{
+			/* RNR still selects the guard region, so RBAR reads its base. */
+			ulBase = portMPU_RBAR_REG & ~( portSTACK_GUARD_SIZE - 1UL );
+
+			if( ( portSCB_MMFAR_REG - ulBase ) < portSTACK_GUARD_SIZE )
+			{
+				xReturn = pdTRUE;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
 
+#endif /* configUSE_MPU_STACK_GUARD */
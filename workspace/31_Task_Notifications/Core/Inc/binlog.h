@@ -0,0 +1,60 @@
+/*******************************************************************************
+ *
+ * @file	binlog.h
+ * @brief	Interface of the deferred binary logger.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef BINLOG_H
+#define BINLOG_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef BINLOG_RING_WORDS
+#define BINLOG_RING_WORDS 256U		/* Record ring, a power of two. */
+#endif
+
+#ifndef BINLOG_MAX_ARGS
+#define BINLOG_MAX_ARGS 6U			/* Argument words kept per record. */
+#endif
+
+#ifndef BINLOG_DRAIN_PERIOD_MS
+#define BINLOG_DRAIN_PERIOD_MS 10U	/* How often the drain task runs. */
+#endif
+
+#ifndef BINLOG_DRAIN_PRIORITY
+#define BINLOG_DRAIN_PRIORITY 1U
+#endif
+
+/* Section holding the format strings. The linker script places it at address
+ * 0 as a non-loaded (INFO) section, so a string's address is its offset in the
+ * ELF section, which is what the host decoder looks up. */
+#define BINLOG_STR_SECTION __attribute__((section(".binlog_str"), used))
+
+/**
+ * @brief Logs a printf-style message without formatting it on the target.
+ * @note Only the format string's ID, a timestamp and the arguments are
+ * recorded; Tools/binlog_decode.py formats the text on the host. Arguments
+ * are integers (or chars) of at most 32 bits. pcFormat must be a string
+ * literal. Safe from tasks and from interrupts of any priority.
+ */
+#define BINLOG(pcFormat, ...)												\
+	do																		\
+	{																		\
+		static const char cBinlogFormat[] BINLOG_STR_SECTION = pcFormat;	\
+		const uint32_t ulBinlogArgs[] = { 0U, ##__VA_ARGS__ };				\
+		binlog_write(cBinlogFormat, &ulBinlogArgs[1],						\
+				(sizeof(ulBinlogArgs) / sizeof(uint32_t)) - 1U);			\
+	} while (0)
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t binlog_init(void);
+void binlog_write(const char *pcFormat, const uint32_t *pulArgs, uint32_t ulArgCount);
+uint32_t binlog_flush(void);
+uint32_t binlog_get_dropped(void);
+
+#endif /* BINLOG_H */
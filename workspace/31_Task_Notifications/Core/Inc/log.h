@@ -0,0 +1,158 @@
+/*******************************************************************************
+ *
+ * @file	log.h
+ * @brief	Leveled, per-module log macros filtered at compile time.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Each source file may define, before including this header:
+ *
+ * 				LOG_MODULE			name in each line, a string literal
+ * 				LOG_MODULE_LEVEL	highest level it logs (at most LOG_LEVEL)
+ * 				LOG_BACKEND			where its lines go
+ *
+ * 			A level above LOG_MODULE_LEVEL or LOG_LEVEL expands to an empty
+ * 			statement: no code, no format string, and the arguments are not
+ * 			evaluated. A variable used only by such a call may then trigger
+ * 			an unused-variable warning.
+ *
+ * 			An enabled level costs one byte compare with the runtime level
+ * 			(log_set_level()) before the backend is called. Every backend
+ * 			prints the same line, "<E|W|I|D> <module>: <message>\r\n": the
+ * 			prefix and line end are pasted into the format literal, so the
+ * 			deferred binary backend needs no string arguments for them.
+ *
+ ******************************************************************************/
+
+#ifndef LOG_H
+#define LOG_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macros --------------------------------------------------------------------*/
+#define LOG_LEVEL_NONE		0U
+#define LOG_LEVEL_ERROR		1U
+#define LOG_LEVEL_WARN		2U
+#define LOG_LEVEL_INFO		3U
+#define LOG_LEVEL_DEBUG		4U
+
+#define LOG_BACKEND_PRINTF	0U	/* printf(), wherever syscalls.c sends stdout. */
+#define LOG_BACKEND_ITM		1U	/* Formatted here, to ITM_PORT_TEXT. */
+#define LOG_BACKEND_BINLOG	2U	/* binlog.h, formatted on the host. */
+#define LOG_BACKEND_RING	3U	/* logring.h, merged by its logger task. */
+
+/* Highest level compiled in, for the whole project. The Debug configuration
+ * defines DEBUG; the Release one drops the debug and info lines. */
+#ifndef LOG_LEVEL
+#ifdef DEBUG
+#define LOG_LEVEL LOG_LEVEL_DEBUG
+#else
+#define LOG_LEVEL LOG_LEVEL_WARN
+#endif
+#endif
+
+#ifndef LOG_MODULE
+#define LOG_MODULE "app"
+#endif
+
+#ifndef LOG_MODULE_LEVEL
+#define LOG_MODULE_LEVEL LOG_LEVEL
+#endif
+
+#ifndef LOG_BACKEND
+#define LOG_BACKEND LOG_BACKEND_PRINTF
+#endif
+
+#ifndef LOG_LINE_BYTES
+#define LOG_LINE_BYTES 128U		/* Longest line of the ITM backend. */
+#endif
+
+#if (LOG_BACKEND == LOG_BACKEND_BINLOG)
+#include "binlog.h"
+#define LOG_WRITE(pcFormat, ...) BINLOG(pcFormat, ##__VA_ARGS__)
+#elif (LOG_BACKEND == LOG_BACKEND_RING)
+#include "logring.h"
+#define LOG_WRITE(pcFormat, ...) logring_printf(pcFormat, ##__VA_ARGS__)
+#elif (LOG_BACKEND == LOG_BACKEND_ITM)
+#include <stdarg.h>
+#include <stdio.h>
+#include "itm.h"
+#define LOG_WRITE(pcFormat, ...) log_itm_printf(pcFormat, ##__VA_ARGS__)
+#else
+#include <stdio.h>
+#define LOG_WRITE(pcFormat, ...) printf(pcFormat, ##__VA_ARGS__)
+#endif
+
+/* One line at ucLevel, if the runtime level lets it through. */
+#define LOG_EMIT(ucLevel, pcTag, pcFormat, ...)								\
+	do																		\
+	{																		\
+		if ((uint8_t)(ucLevel) <= ucLogLevel)								\
+		{																	\
+			LOG_WRITE(pcTag " " LOG_MODULE ": " pcFormat "\r\n", ##__VA_ARGS__);	\
+		}																	\
+	} while (0)
+
+#if ((LOG_LEVEL >= LOG_LEVEL_ERROR) && (LOG_MODULE_LEVEL >= LOG_LEVEL_ERROR))
+#define LOG_ERROR(pcFormat, ...) LOG_EMIT(LOG_LEVEL_ERROR, "E", pcFormat, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(pcFormat, ...) do { } while (0)
+#endif
+
+#if ((LOG_LEVEL >= LOG_LEVEL_WARN) && (LOG_MODULE_LEVEL >= LOG_LEVEL_WARN))
+#define LOG_WARN(pcFormat, ...) LOG_EMIT(LOG_LEVEL_WARN, "W", pcFormat, ##__VA_ARGS__)
+#else
+#define LOG_WARN(pcFormat, ...) do { } while (0)
+#endif
+
+#if ((LOG_LEVEL >= LOG_LEVEL_INFO) && (LOG_MODULE_LEVEL >= LOG_LEVEL_INFO))
+#define LOG_INFO(pcFormat, ...) LOG_EMIT(LOG_LEVEL_INFO, "I", pcFormat, ##__VA_ARGS__)
+#else
+#define LOG_INFO(pcFormat, ...) do { } while (0)
+#endif
+
+#if ((LOG_LEVEL >= LOG_LEVEL_DEBUG) && (LOG_MODULE_LEVEL >= LOG_LEVEL_DEBUG))
+#define LOG_DEBUG(pcFormat, ...) LOG_EMIT(LOG_LEVEL_DEBUG, "D", pcFormat, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(pcFormat, ...) do { } while (0)
+#endif
+
+/* Variables -----------------------------------------------------------------*/
+/* Runtime level, read by every enabled call; set it with log_set_level(). */
+extern uint8_t ucLogLevel;
+
+/* Function Prototypes -------------------------------------------------------*/
+void log_set_level(uint8_t ucLevel);
+uint8_t log_get_level(void);
+
+#if (LOG_BACKEND == LOG_BACKEND_ITM)
+/**
+ * @brief Formats a line on the stack and writes it to ITM_PORT_TEXT.
+ * @param pcFormat printf() format.
+ * @retval None
+ * @note Bypasses stdout, so its lines never mix with another task's partial
+ * printf() output. Lines are cut at LOG_LINE_BYTES - 1 characters.
+ */
+static inline void log_itm_printf(const char *pcFormat, ...)
+{
+	char cLine[LOG_LINE_BYTES];
+	va_list xArgs;
+	int iLength;
+
+	va_start(xArgs, pcFormat);
+	iLength = vsnprintf(cLine, sizeof(cLine), pcFormat, xArgs);
+	va_end(xArgs);
+
+	if (iLength > 0)
+	{
+		if (iLength >= (int)sizeof(cLine))
+		{
+			iLength = (int)sizeof(cLine) - 1;
+		}
+
+		(void)ITM_write_buffer(ITM_PORT_TEXT, cLine, iLength);
+	}
+}
+#endif
+
+#endif /* LOG_H */
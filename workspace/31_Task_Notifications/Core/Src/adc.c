@@ -1,20 +1,147 @@
 /*******************************************************************************
  *
- * @file	exti.c
+ * @file	adc.c
  * @brief	Implementation of ADC driver.
  * @author	Kyungjae Lee
  * @date	Mar 28, 2026
+ * @note	ADC1's regular group serves one mode at a time: single
+ * 			conversions (adc_init()), the PA1 stream (adc_stream_init())
+ * 			a multi-channel scan (adc_scan_init()) or, with ADC2 and ADC3,
+ * 			interleaved capture of one pin (adc_interleaved_init()). The
+ * 			injected group
+ * 			(adc_injected_init()) works alongside the first three, and pre-empts
+ * 			a regular conversion in progress, which is then restarted.
  *
  ******************************************************************************/
 
 /* Includes ------------------------------------------------------------------*/
 #include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clkgate.h"
+#include "adc.h"
 
 /* Macros --------------------------------------------------------------------*/
-#define ADC_SR_EOC_OFS 1U
+#define ADC_SR_EOC_OFS			1U
+#define ADC_SR_JEOC_OFS			2U
+#define ADC_SR_OVR_OFS			5U
+#define ADC_CR1_SCAN_OFS		8U
+#define ADC_CR1_OVRIE_OFS		26U
+#define ADC_CR2_ADON_OFS		0U
+#define ADC_CR2_CONT_OFS		1U
+#define ADC_CR2_DMA_OFS			8U
+#define ADC_CR2_DDS_OFS			9U
+#define ADC_CR2_EXTSEL_OFS		24U
+#define ADC_CR2_EXTEN_OFS		28U
+#define ADC_CR2_JEXTSEL_OFS		16U
+#define ADC_CR2_JEXTEN_OFS		20U
+#define ADC_CR2_JSWSTART_OFS	22U
+#define ADC_CR2_SWSTART_OFS		30U
+#define ADC_SQR1_L_OFS			20U
+#define ADC_JSQR_JL_OFS			20U
+#define ADC_CCR_MULTI_OFS		0U
+#define ADC_CCR_DELAY_OFS		8U
+#define ADC_CCR_DDS_OFS			13U
+#define ADC_CCR_DMA_OFS			14U
+#define ADC_CCR_ADCPRE_OFS		16U
+#define ADC_CCR_TSVREFE_OFS		23U
+#define ADC_CONVERSION_CYCLES	12U		/* Per conversion at 12 bits, after sampling. */
+#define ADC_CHANNEL_MAX			18U
+#define ADC_MULTI_TRIPLE_INTERLEAVED	0x17U
+#define ADC_MULTI_DMA_MODE2		2U		/* Two results per CDR read. */
+#define ADC_INTERLEAVED_DELAY	5U		/* ADC clocks between ADCs, the minimum (DELAY = 0). */
+#define ADC_CLOCK_MAX_HZ		36000000U
+#define ADC_INJECTED_SPIN_LIMIT	100000U	/* About 1 ms; a 4-channel sequence needs 8 us at most. */
+#define ADC_EXTSEL_TIM2_TRGO	6U
+#define TIM_CR1_CEN_OFS			0U
+#define TIM_CR2_MMS_OFS			4U
+#define TIM_MMS_UPDATE			2U
+#define DMA_SxCR_EN_OFS			0U
+#define DMA_SxCR_TEIE_OFS		2U
+#define DMA_SxCR_TCIE_OFS		4U
+#define DMA_SxCR_CIRC_OFS		8U
+#define DMA_SxCR_MINC_OFS		10U
+#define DMA_SxCR_PSIZE_OFS		11U
+#define DMA_SxCR_MSIZE_OFS		13U
+#define DMA_SxCR_PL_OFS			16U
+#define DMA_SxCR_DBM_OFS		18U
+#define DMA_SxCR_CT_OFS			19U
+#define DMA_SxCR_CHSEL_OFS		25U
+#define DMA_LISR_TEIF0_OFS		3U
+#define DMA_LISR_TCIF0_OFS		5U
+#define DMA_LIFCR_STREAM0_MASK	0x3DU	/* FEIF0, DMEIF0, TEIF0, HTIF0, TCIF0 */
+
+/* Notification values posted to the consumer task. */
+#define ADC_STREAM_NOTIFY_BUF0	1U
+#define ADC_STREAM_NOTIFY_BUF1	2U
+
+/* Users of DMA2 Stream0. */
+#define ADC_DMA_OWNER_STREAM	0U
+#define ADC_DMA_OWNER_SCAN		1U
+#define ADC_DMA_OWNER_INTERLEAVED 2U
 
 /* Variables -----------------------------------------------------------------*/
 
+/* Streaming: TIM2 TRGO starts each conversion and DMA2 Stream0 (channel 0 is
+ * ADC1) alternates between the two buffers in double buffer mode. When one
+ * fills, the consumer task is notified while the DMA carries on in the other,
+ * so the CPU only runs once per block. */
+static uint16_t *pusStreamBuf[2] = { NULL, NULL };
+static uint16_t usStreamBlockSize = 0;
+static uint32_t ulStreamSampleRateHz = 0;
+static TaskHandle_t xStreamTask = NULL;
+static volatile uint32_t ulStreamOverruns = 0;
+static uint8_t ucDmaOwner = ADC_DMA_OWNER_STREAM;
+
+/* Scan: each TIM2 TRGO converts the whole regular sequence, and DMA2 Stream0
+ * stores the results one after another in double buffer mode. Each buffer
+ * holds 2^ucOversampleLog2 sequences; when one fills, the interrupt sums them
+ * per channel into usScanValues and counts a block. Readers copy the values
+ * and retry if the block count moved meanwhile, so no lock is needed. */
+static AdcScanConfig_t xScan;
+static uint32_t ulScanBlockLength = 0;		/* Samples per buffer. */
+static volatile uint16_t usScanValues[ADC_SCAN_MAX_CHANNELS];
+static volatile uint32_t ulScanBlocks = 0;
+static volatile uint32_t ulScanOverruns = 0;
+static uint32_t ulInjectedCount = 0;
+
+/* Interleaved: ADC1, ADC2 and ADC3 convert the same channel in turn, each
+ * ADC_INTERLEAVED_DELAY ADC clocks after the previous one, so the pin is
+ * sampled three times faster than one ADC can. In DMA mode 2 each read of
+ * the common data register returns two results, and DMA2 Stream0 stores
+ * them as 32-bit words in double buffer mode, handed over like the stream's. */
+static uint32_t *pulInterleavedBuf[2] = { NULL, NULL };
+static uint16_t usInterleavedBlockWords = 0;
+static uint32_t ulInterleavedRateHz = 0;
+static TaskHandle_t xInterleavedTask = NULL;
+static volatile uint32_t ulInterleavedOverruns = 0;
+
+/* Clocks. ADC1 and the pins are held from their first use; TIM2, DMA2, ADC2
+ * and ADC3 only while the stream, the scan or the interleaved capture runs,
+ * and to configure them. */
+static ClkGateUser_t xGpioAClock = CLKGATE_USER(CLKGATE_GPIOA);
+static ClkGateUser_t xGpioBClock = CLKGATE_USER(CLKGATE_GPIOB);
+static ClkGateUser_t xGpioCClock = CLKGATE_USER(CLKGATE_GPIOC);
+static ClkGateUser_t xAdc1Clock = CLKGATE_USER(CLKGATE_ADC1);
+static ClkGateUser_t xAdc2Clock = CLKGATE_USER(CLKGATE_ADC2);
+static ClkGateUser_t xAdc3Clock = CLKGATE_USER(CLKGATE_ADC3);
+static ClkGateUser_t xDmaClock = CLKGATE_USER(CLKGATE_DMA2);
+static ClkGateUser_t xTimerClock = CLKGATE_USER(CLKGATE_TIM2);
+
+/* ADC clocks per sample time code (SMPRx). */
+static const uint16_t usSampleCycles[8] = { 3, 15, 28, 56, 84, 112, 144, 480 };
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t adc_stream_timer_clock(void);
+static void adc_dma_stop(void);
+static void adc_release(void);
+static void adc_gate_off(void);
+static int32_t adc_channels_init(const uint8_t *pucChannels, uint32_t ulCount,
+		uint32_t ulSampleTime);
+static void adc_scan_restart(void);
+static void adc_scan_decimate(const uint16_t *pusRaw);
+static void adc_interleaved_restart(void);
+
 /* Public function definitions -----------------------------------------------*/
 
 /**
@@ -24,12 +151,9 @@
  */
 void adc_init(void)
 {
-	/* Enable clock for AHB1 bus to use GPIOA. */
-	RCC->AHB1ENR |= (1U << 0);
-	/* Note: 1U << 0 -> shift 1 to bit position 0. */
-
-	/* Enable clock for APB2 bus to use ADC1. */
-	RCC->APB2ENR |= (1U << 8);
+	/* Hold the clocks of GPIOA (AHB1) and ADC1 (APB2). */
+	clkgate_acquire(&xGpioAClock);
+	clkgate_acquire(&xAdc1Clock);
 
 	/* Set the pin PA1 to analog mode. */
 	GPIOA->MODER |= (3U << 2);
@@ -48,7 +172,7 @@ void adc_init(void)
 uint32_t read_analog_sensor(void)
 {
 	/* Start ADC conversion. */
-	ADC1->CR2 |= (1U << 30);
+	ADC1->CR2 |= (1U << ADC_CR2_SWSTART_OFS);
 
 	while (!(ADC1->SR & (1U << ADC_SR_EOC_OFS)))
 	{
@@ -57,3 +181,1006 @@ uint32_t read_analog_sensor(void)
 
 	return ADC1->DR;
 }
+
+/**
+ * @brief Reads a block of consecutive samples from the analog sensor.
+ * @param pusSamples Buffer of ulCount samples.
+ * @param ulCount Number of samples to read.
+ * @retval None
+ * @note The 12-bit results are stored as halfwords, the layout the block
+ * filters consume two at a time.
+ */
+void read_analog_sensor_block(uint16_t *pusSamples, uint32_t ulCount)
+{
+	uint32_t i;
+
+	for (i = 0; i < ulCount; i++)
+	{
+		pusSamples[i] = (uint16_t)read_analog_sensor();
+	}
+}
+
+/**
+ * @brief Configures timer-triggered conversions of PA1 into a pair of buffers.
+ * @param ulSampleRateHz Conversions per second (TIM2 update rate).
+ * @param pusBuf0 First buffer of usBlockSize samples.
+ * @param pusBuf1 Second buffer of usBlockSize samples.
+ * @param usBlockSize Samples per buffer.
+ * @param xTask Task notified each time a buffer fills, normally the caller of
+ * adc_stream_wait(). Its notification value is used by the driver.
+ * @retval 0 if successful, -1 otherwise.
+ * @note Call adc_stream_start() to begin sampling.
+ */
+int32_t adc_stream_init(uint32_t ulSampleRateHz, uint16_t *pusBuf0, uint16_t *pusBuf1,
+		uint16_t usBlockSize, TaskHandle_t xTask)
+{
+	if ((ulSampleRateHz == 0U) || (pusBuf0 == NULL) || (pusBuf1 == NULL)
+			|| (usBlockSize == 0U) || (xTask == NULL))
+	{
+		return -1;
+	}
+
+	pusStreamBuf[0] = pusBuf0;
+	pusStreamBuf[1] = pusBuf1;
+	usStreamBlockSize = usBlockSize;
+	ulStreamSampleRateHz = ulSampleRateHz;
+	adc_release();
+
+	xStreamTask = xTask;
+	ulStreamOverruns = 0;
+	ucDmaOwner = ADC_DMA_OWNER_STREAM;
+
+	adc_init();
+	ADC1->CR1 &= ~(1U << ADC_CR1_OVRIE_OFS);
+
+	/* Clocks for DMA2 and TIM2, gated again once they are configured. */
+	clkgate_acquire(&xDmaClock);
+	clkgate_acquire(&xTimerClock);
+
+	/* ADC clock = PCLK2 / 4, within the 36 MHz limit for every clock profile. */
+	ADC->CCR = (ADC->CCR & ~(3U << ADC_CCR_ADCPRE_OFS)) | (1U << ADC_CCR_ADCPRE_OFS);
+
+	/* Convert on the rising edge of TIM2 TRGO and raise a DMA request for every
+	 * result, indefinitely. */
+	ADC1->CR2 = (1U << ADC_CR2_EXTEN_OFS)
+			| (ADC_EXTSEL_TIM2_TRGO << ADC_CR2_EXTSEL_OFS)
+			| (1U << ADC_CR2_DDS_OFS)
+			| (1U << ADC_CR2_DMA_OFS)
+			| (1U << ADC_CR2_ADON_OFS);
+
+	/* TIM2 update event drives TRGO. */
+	TIM2->CR1 = 0;
+	TIM2->CR2 = (TIM_MMS_UPDATE << TIM_CR2_MMS_OFS);
+	TIM2->PSC = 0;
+
+	NVIC_SetPriority(DMA2_Stream0_IRQn, 6);
+	NVIC_EnableIRQ(DMA2_Stream0_IRQn);
+
+	/* The registers keep their values until adc_stream_start(). */
+	adc_gate_off();
+
+	return 0;
+}
+
+/**
+ * @brief Starts (or restarts) streaming from the first buffer.
+ * @param None
+ * @retval 0 if successful, -1 if adc_stream_init() was not called or the
+ * sample rate is out of reach.
+ * @note The timer period is computed from the current bus clock, so call this
+ * again after changing the clock profile.
+ */
+int32_t adc_stream_start(void)
+{
+	uint32_t ulPeriod;
+
+	if ((xStreamTask == NULL) || (ucDmaOwner != ADC_DMA_OWNER_STREAM))
+	{
+		return -1;
+	}
+
+	ulPeriod = adc_stream_timer_clock() / ulStreamSampleRateHz;
+
+	if (ulPeriod < 2U)
+	{
+		return -1;
+	}
+
+	clkgate_acquire(&xDmaClock);
+	clkgate_acquire(&xTimerClock);
+	adc_dma_stop();
+
+	DMA2_Stream0->PAR = (uint32_t)&ADC1->DR;
+	DMA2_Stream0->M0AR = (uint32_t)pusStreamBuf[0];
+	DMA2_Stream0->M1AR = (uint32_t)pusStreamBuf[1];
+	DMA2_Stream0->NDTR = usStreamBlockSize;
+	DMA2_Stream0->CR = (0U << DMA_SxCR_CHSEL_OFS)		/* Channel 0. */
+			| (1U << DMA_SxCR_DBM_OFS)					/* Double buffer. */
+			| (2U << DMA_SxCR_PL_OFS)					/* High priority. */
+			| (1U << DMA_SxCR_MSIZE_OFS)				/* 16-bit memory. */
+			| (1U << DMA_SxCR_PSIZE_OFS)				/* 16-bit peripheral. */
+			| (1U << DMA_SxCR_MINC_OFS)					/* Increment memory. */
+			| (1U << DMA_SxCR_CIRC_OFS)					/* Required by DBM. */
+			| (1U << DMA_SxCR_TCIE_OFS)					/* Buffer full. */
+			| (1U << DMA_SxCR_TEIE_OFS);				/* Transfer error. */
+	DMA2_Stream0->FCR = 0;	/* Direct mode. */
+	DMA2_Stream0->CR |= (1U << DMA_SxCR_EN_OFS);
+
+	/* Clear a stale overrun, then re-arm the DMA requests. */
+	ADC1->SR &= ~(1U << ADC_SR_OVR_OFS);
+	ADC1->CR2 &= ~(1U << ADC_CR2_DMA_OFS);
+	ADC1->CR2 |= (1U << ADC_CR2_DMA_OFS);
+
+	TIM2->ARR = ulPeriod - 1U;
+	TIM2->CNT = 0;
+	TIM2->CR1 |= (1U << TIM_CR1_CEN_OFS);
+
+	return 0;
+}
+
+/**
+ * @brief Stops the sampling timer and the DMA stream, and gates their clocks
+ * off.
+ * @param None
+ * @retval None
+ */
+void adc_stream_stop(void)
+{
+	adc_dma_stop();
+	adc_gate_off();
+}
+
+/**
+ * @brief Blocks until a buffer is full.
+ * @param xTicksToWait Maximum time to wait.
+ * @retval The full buffer (usBlockSize samples), or NULL on timeout. It stays
+ * valid until the DMA comes back to it, one block period later.
+ */
+uint16_t *adc_stream_wait(TickType_t xTicksToWait)
+{
+	uint32_t ulValue;
+
+	if (xTaskNotifyWait(0, ADC_STREAM_NOTIFY_BUF0 | ADC_STREAM_NOTIFY_BUF1,
+			&ulValue, xTicksToWait) != pdTRUE)
+	{
+		return NULL;
+	}
+
+	return (ulValue & ADC_STREAM_NOTIFY_BUF1) ? pusStreamBuf[1] : pusStreamBuf[0];
+}
+
+/**
+ * @brief Returns the number of blocks the consumer did not pick up in time.
+ * @param None
+ * @retval Missed blocks (and DMA transfer errors) since adc_stream_init().
+ */
+uint32_t adc_stream_get_overruns(void)
+{
+	return ulStreamOverruns;
+}
+
+/**
+ * @brief Configures timer-triggered scans of a sequence of channels, with
+ * oversampling.
+ * @param pxConfig Channels, sample time, oversampling, rate, DMA buffer and
+ * the task to notify. Copied, but the channel list and the buffer must stay
+ * valid.
+ * @retval 0 if successful, -1 if the configuration is invalid or the results
+ * would not fit in 16 bits.
+ * @note Each result is the sum of 2^ucOversampleLog2 conversions shifted
+ * right by ucShift: ucShift = ucOversampleLog2 gives the average, and
+ * ucShift = ucOversampleLog2 / 2 gives ucOversampleLog2 / 2 extra bits of
+ * resolution when the input has a little noise. Channels 0..15 are set to
+ * analog mode (PA0-PA7, PB0-PB1, PC0-PC5); 17 and 18 enable the internal
+ * sources. Call adc_scan_start() to begin.
+ */
+int32_t adc_scan_init(const AdcScanConfig_t *pxConfig)
+{
+	uint32_t i;
+
+	if ((pxConfig == NULL) || (pxConfig->pucChannels == NULL) || (pxConfig->pusRaw == NULL)
+			|| (pxConfig->ucCount == 0U) || (pxConfig->ucCount > ADC_SCAN_MAX_CHANNELS)
+			|| (pxConfig->ucOversampleLog2 > ADC_SCAN_MAX_OVERSAMPLE_LOG2)
+			|| ((12U + pxConfig->ucOversampleLog2) > (16U + pxConfig->ucShift))
+			|| (pxConfig->ulRateHz == 0U))
+	{
+		return -1;
+	}
+
+	adc_release();
+
+	if (adc_channels_init(pxConfig->pucChannels, pxConfig->ucCount, pxConfig->ucSampleTime) != 0)
+	{
+		return -1;
+	}
+
+	xScan = *pxConfig;
+	ulScanBlockLength = (uint32_t)pxConfig->ucCount << pxConfig->ucOversampleLog2;
+	ulScanBlocks = 0;
+	ulScanOverruns = 0;
+	ucDmaOwner = ADC_DMA_OWNER_SCAN;
+
+	/* Clocks for DMA2 and TIM2, gated again once they are configured. */
+	clkgate_acquire(&xDmaClock);
+	clkgate_acquire(&xTimerClock);
+
+	/* Regular sequence, in order. */
+	ADC1->SQR1 = ((uint32_t)(pxConfig->ucCount - 1U) << ADC_SQR1_L_OFS);
+	ADC1->SQR2 = 0;
+	ADC1->SQR3 = 0;
+
+	for (i = 0; i < pxConfig->ucCount; i++)
+	{
+		if (i < 6U)
+		{
+			ADC1->SQR3 |= ((uint32_t)pxConfig->pucChannels[i] << (5U * i));
+		}
+		else if (i < 12U)
+		{
+			ADC1->SQR2 |= ((uint32_t)pxConfig->pucChannels[i] << (5U * (i - 6U)));
+		}
+		else
+		{
+			ADC1->SQR1 |= ((uint32_t)pxConfig->pucChannels[i] << (5U * (i - 12U)));
+		}
+	}
+
+	/* Scan the sequence on each rising edge of TIM2 TRGO, with a DMA request
+	 * for every result, indefinitely. An overrun interrupts, so the scan can
+	 * be realigned. */
+	ADC1->CR1 |= (1U << ADC_CR1_SCAN_OFS) | (1U << ADC_CR1_OVRIE_OFS);
+	/* Keep the injected trigger. */
+	ADC1->CR2 = (ADC1->CR2 & ((0xFU << ADC_CR2_JEXTSEL_OFS) | (3U << ADC_CR2_JEXTEN_OFS)))
+			| (1U << ADC_CR2_EXTEN_OFS)
+			| (ADC_EXTSEL_TIM2_TRGO << ADC_CR2_EXTSEL_OFS)
+			| (1U << ADC_CR2_DDS_OFS)
+			| (1U << ADC_CR2_DMA_OFS)
+			| (1U << ADC_CR2_ADON_OFS);
+
+	/* TIM2 update event drives TRGO. */
+	TIM2->CR1 = 0;
+	TIM2->CR2 = (TIM_MMS_UPDATE << TIM_CR2_MMS_OFS);
+	TIM2->PSC = 0;
+
+	NVIC_SetPriority(DMA2_Stream0_IRQn, ADC_IRQ_PRIORITY);
+	NVIC_EnableIRQ(DMA2_Stream0_IRQn);
+	NVIC_SetPriority(ADC_IRQn, ADC_IRQ_PRIORITY);
+	NVIC_EnableIRQ(ADC_IRQn);
+
+	/* The registers keep their values until the capture starts. */
+	adc_gate_off();
+
+	return 0;
+}
+
+/**
+ * @brief Starts (or restarts) scanning.
+ * @param None
+ * @retval 0 if successful, -1 if adc_scan_init() was not called, the rate is
+ * out of reach, or a sequence takes longer than the scan period.
+ * @note The timer period is computed from the current bus clock, so call this
+ * again after changing the clock profile.
+ */
+int32_t adc_scan_start(void)
+{
+	uint32_t ulPeriod;
+	uint32_t ulSequenceCycles;
+
+	if ((ucDmaOwner != ADC_DMA_OWNER_SCAN) || (ulScanBlockLength == 0U))
+	{
+		return -1;
+	}
+
+	ulPeriod = adc_stream_timer_clock() / xScan.ulRateHz;
+	ulSequenceCycles = (uint32_t)xScan.ucCount
+			* (usSampleCycles[xScan.ucSampleTime] + ADC_CONVERSION_CYCLES);
+
+	/* ADC clock = PCLK2 / 4 (adc_channels_init()). */
+	if ((ulPeriod < 2U)
+			|| (((uint64_t)ulSequenceCycles * xScan.ulRateHz) > (HAL_RCC_GetPCLK2Freq() / 4U)))
+	{
+		return -1;
+	}
+
+	clkgate_acquire(&xDmaClock);
+	clkgate_acquire(&xTimerClock);
+	TIM2->ARR = ulPeriod - 1U;
+	adc_scan_restart();
+
+	return 0;
+}
+
+/**
+ * @brief Stops the scan timer and the DMA stream, and gates their clocks off.
+ * @param None
+ * @retval None
+ * @note The last values stay readable.
+ */
+void adc_scan_stop(void)
+{
+	adc_dma_stop();
+	adc_gate_off();
+}
+
+/**
+ * @brief Copies the latest scan results.
+ * @param pusValues Receives one value per channel of the sequence, in order.
+ * @retval Blocks completed since adc_scan_init(); 0 if none yet, in which case
+ * the values are all 0.
+ * @note May be called from any task or ISR, without a scheduler.
+ */
+uint32_t adc_scan_get_latest(uint16_t *pusValues)
+{
+	uint32_t ulBlocks;
+	uint32_t i;
+
+	do
+	{
+		ulBlocks = ulScanBlocks;
+
+		for (i = 0; i < xScan.ucCount; i++)
+		{
+			pusValues[i] = usScanValues[i];
+		}
+	} while (ulBlocks != ulScanBlocks);
+
+	return ulBlocks;
+}
+
+/**
+ * @brief Blocks until the next result block, then copies it.
+ * @param pusValues Receives one value per channel of the sequence, in order.
+ * @param xTicksToWait Maximum time to wait.
+ * @retval 0 if successful, -1 on timeout or if no task was configured.
+ * @note Only for the task given in the configuration. Blocks it did not wait
+ * for in time are merged: the values are always the latest.
+ */
+int32_t adc_scan_wait(uint16_t *pusValues, TickType_t xTicksToWait)
+{
+	if ((xScan.xTask == NULL) || (ulTaskNotifyTake(pdTRUE, xTicksToWait) == 0U))
+	{
+		return -1;
+	}
+
+	(void)adc_scan_get_latest(pusValues);
+
+	return 0;
+}
+
+/**
+ * @brief Returns the number of times the scan lost samples.
+ * @param None
+ * @retval ADC overruns and DMA transfer errors since adc_scan_init(). Each
+ * one realigns the scan on a new block.
+ */
+uint32_t adc_scan_get_overruns(void)
+{
+	return ulScanOverruns;
+}
+
+/**
+ * @brief Configures ADC1, ADC2 and ADC3 to sample one channel interleaved.
+ * @param ulChannel Channel on all three ADCs: 0..3 (PA0-PA3) or 10..13
+ * (PC0-PC3).
+ * @param pulBuf0 First buffer of usBlockWords words.
+ * @param pulBuf1 Second buffer of usBlockWords words.
+ * @param usBlockWords 32-bit words per buffer, two samples each.
+ * @param xTask Task notified each time a buffer fills, normally the caller of
+ * adc_interleaved_wait(). Its notification value is used by the driver.
+ * @retval 0 if successful, -1 otherwise.
+ * @note Samples are taken for 3 ADC clocks, so the source must have a low
+ * impedance. Call adc_interleaved_start() to begin.
+ */
+int32_t adc_interleaved_init(uint32_t ulChannel, uint32_t *pulBuf0, uint32_t *pulBuf1,
+		uint16_t usBlockWords, TaskHandle_t xTask)
+{
+	const uint8_t ucChannel = (uint8_t)ulChannel;
+	ADC_TypeDef * const pxAdcs[3] = { ADC1, ADC2, ADC3 };
+	uint32_t i;
+
+	if ((ulChannel > 13U) || ((ulChannel > 3U) && (ulChannel < 10U))
+			|| (pulBuf0 == NULL) || (pulBuf1 == NULL) || (usBlockWords == 0U) || (xTask == NULL))
+	{
+		return -1;
+	}
+
+	adc_release();
+
+	/* PA0-PA3 or PC0-PC3 to analog mode, shortest sample time. */
+	(void)adc_channels_init(&ucChannel, 1U, 0U);
+
+	pulInterleavedBuf[0] = pulBuf0;
+	pulInterleavedBuf[1] = pulBuf1;
+	usInterleavedBlockWords = usBlockWords;
+	xInterleavedTask = xTask;
+	ulInterleavedOverruns = 0;
+	ucDmaOwner = ADC_DMA_OWNER_INTERLEAVED;
+
+	/* Clocks for DMA2, ADC2 and ADC3 (ADC1 is held), gated again once they
+	 * are configured. */
+	clkgate_acquire(&xDmaClock);
+	clkgate_acquire(&xAdc2Clock);
+	clkgate_acquire(&xAdc3Clock);
+
+	/* The same single-channel sequence on each ADC, 12 bits, software
+	 * trigger; adc_interleaved_start() switches them on. An overrun
+	 * interrupts, so the capture can be realigned. */
+	for (i = 0; i < 3U; i++)
+	{
+		pxAdcs[i]->CR1 = (1U << ADC_CR1_OVRIE_OFS);
+		pxAdcs[i]->CR2 = 0;
+		pxAdcs[i]->SQR1 = 0;
+		pxAdcs[i]->SQR3 = ulChannel;
+		pxAdcs[i]->SMPR1 = ADC1->SMPR1;
+		pxAdcs[i]->SMPR2 = ADC1->SMPR2;
+	}
+
+	NVIC_SetPriority(DMA2_Stream0_IRQn, ADC_IRQ_PRIORITY);
+	NVIC_EnableIRQ(DMA2_Stream0_IRQn);
+	NVIC_SetPriority(ADC_IRQn, ADC_IRQ_PRIORITY);
+	NVIC_EnableIRQ(ADC_IRQn);
+
+	/* The registers keep their values until the capture starts. */
+	adc_gate_off();
+
+	return 0;
+}
+
+/**
+ * @brief Starts (or restarts) interleaved capture from the first buffer.
+ * @param None
+ * @retval 0 if successful, -1 if adc_interleaved_init() was not called.
+ * @note The ADC clock is the fastest division of PCLK2 within 36 MHz, and
+ * the rate one fifth of it: 4.5 MHz with the 180 MHz profile (PCLK2 / 4),
+ * 7.2 MHz at most (PCLK2 = 72 MHz, / 2). Call this again after changing the
+ * clock profile.
+ */
+int32_t adc_interleaved_start(void)
+{
+	const uint32_t ulPclk2 = HAL_RCC_GetPCLK2Freq();
+	uint32_t ulPrescaler;
+
+	if ((xInterleavedTask == NULL) || (ucDmaOwner != ADC_DMA_OWNER_INTERLEAVED))
+	{
+		return -1;
+	}
+
+	/* ADCPRE n divides by 2 * (n + 1). */
+	for (ulPrescaler = 0; ulPrescaler < 3U; ulPrescaler++)
+	{
+		if ((ulPclk2 / (2U * (ulPrescaler + 1U))) <= ADC_CLOCK_MAX_HZ)
+		{
+			break;
+		}
+	}
+
+	ulInterleavedRateHz = ulPclk2 / (2U * (ulPrescaler + 1U)) / ADC_INTERLEAVED_DELAY;
+
+	adc_interleaved_stop();
+	clkgate_acquire(&xDmaClock);
+	clkgate_acquire(&xAdc2Clock);
+	clkgate_acquire(&xAdc3Clock);
+
+	ADC->CCR = (ulPrescaler << ADC_CCR_ADCPRE_OFS)
+			| (ADC_MULTI_DMA_MODE2 << ADC_CCR_DMA_OFS)
+			| (1U << ADC_CCR_DDS_OFS)
+			| ((ADC_INTERLEAVED_DELAY - 5U) << ADC_CCR_DELAY_OFS)
+			| (ADC_MULTI_TRIPLE_INTERLEAVED << ADC_CCR_MULTI_OFS)
+			| (ADC->CCR & (1U << ADC_CCR_TSVREFE_OFS));
+
+	ADC1->CR2 |= (1U << ADC_CR2_ADON_OFS);
+	ADC2->CR2 |= (1U << ADC_CR2_ADON_OFS);
+	ADC3->CR2 |= (1U << ADC_CR2_ADON_OFS);
+
+	/* tSTAB: 3 us for the ADCs to power up. */
+	HAL_Delay(1);
+
+	/* ADC1 leads and converts continuously; ADC2 and ADC3 follow. */
+
+	adc_interleaved_restart();
+
+	return 0;
+}
+
+/**
+ * @brief Stops interleaved capture and returns the ADCs to independent mode.
+ * @param None
+ * @retval None
+ * @note The three ADCs are switched off, and the clocks of DMA2, ADC2 and
+ * ADC3 gated off; the other modes switch ADC1 back on when they are
+ * configured.
+ */
+void adc_interleaved_stop(void)
+{
+	ADC1->CR2 &= ~((1U << ADC_CR2_CONT_OFS) | (1U << ADC_CR2_ADON_OFS));
+	ADC2->CR2 &= ~(1U << ADC_CR2_ADON_OFS);
+	ADC3->CR2 &= ~(1U << ADC_CR2_ADON_OFS);
+	ADC->CCR &= ~((0x1FU << ADC_CCR_MULTI_OFS) | (3U << ADC_CCR_DMA_OFS) | (1U << ADC_CCR_DDS_OFS));
+
+	adc_dma_stop();
+	adc_gate_off();
+}
+
+/**
+ * @brief Blocks until a buffer is full.
+ * @param xTicksToWait Maximum time to wait.
+ * @retval The full buffer (usBlockWords words, or 2 * usBlockWords 12-bit
+ * samples in order when read as halfwords), or NULL on timeout. It stays
+ * valid until the DMA comes back to it, one block period later.
+ */
+uint32_t *adc_interleaved_wait(TickType_t xTicksToWait)
+{
+	uint32_t ulValue;
+
+	if (xTaskNotifyWait(0, ADC_STREAM_NOTIFY_BUF0 | ADC_STREAM_NOTIFY_BUF1,
+			&ulValue, xTicksToWait) != pdTRUE)
+	{
+		return NULL;
+	}
+
+	return (ulValue & ADC_STREAM_NOTIFY_BUF1) ? pulInterleavedBuf[1] : pulInterleavedBuf[0];
+}
+
+/**
+ * @brief Returns the aggregate sample rate of the interleaved capture.
+ * @param None
+ * @retval Samples per second, or 0 before adc_interleaved_start().
+ */
+uint32_t adc_interleaved_get_rate(void)
+{
+	return ulInterleavedRateHz;
+}
+
+/**
+ * @brief Returns the number of times the interleaved capture lost samples.
+ * @param None
+ * @retval Missed blocks, ADC overruns and DMA transfer errors since
+ * adc_interleaved_init().
+ */
+uint32_t adc_interleaved_get_overruns(void)
+{
+	return ulInterleavedOverruns;
+}
+
+/**
+ * @brief Configures the injected group.
+ * @param pucChannels Sequence of ulCount channels, 0..18.
+ * @param ulCount 1..ADC_INJECTED_MAX_CHANNELS
+ * @param ulSampleTime SMPR code 0..7 (3 to 480 ADC clocks). For a channel also
+ * in the regular sequence, this becomes its sample time there too.
+ * @retval 0 if successful, -1 otherwise.
+ * @note Can be called before or after configuring the regular group.
+ */
+int32_t adc_injected_init(const uint8_t *pucChannels, uint32_t ulCount, uint32_t ulSampleTime)
+{
+	uint32_t ulJsqr;
+	uint32_t i;
+
+	if ((pucChannels == NULL) || (ulCount == 0U) || (ulCount > ADC_INJECTED_MAX_CHANNELS)
+			|| (adc_channels_init(pucChannels, ulCount, ulSampleTime) != 0))
+	{
+		return -1;
+	}
+
+	/* With fewer than 4 channels, the sequence ends at JSQ4: rank r goes in
+	 * JSQ(r + 4 - ulCount), and its result in JDRr. */
+	ulJsqr = ((ulCount - 1U) << ADC_JSQR_JL_OFS);
+
+	for (i = 0; i < ulCount; i++)
+	{
+		ulJsqr |= ((uint32_t)pucChannels[i] << (5U * (i + ADC_INJECTED_MAX_CHANNELS - ulCount)));
+	}
+
+	ADC1->JSQR = ulJsqr;
+	ulInjectedCount = ulCount;
+
+	/* Software trigger; scan mode walks the injected sequence. */
+	ADC1->CR2 &= ~((0xFU << ADC_CR2_JEXTSEL_OFS) | (3U << ADC_CR2_JEXTEN_OFS));
+	ADC1->CR1 |= (1U << ADC_CR1_SCAN_OFS);
+	ADC1->CR2 |= (1U << ADC_CR2_ADON_OFS);
+
+	return 0;
+}
+
+/**
+ * @brief Converts the injected sequence now.
+ * @param pusValues Receives one 12-bit value per injected channel, in order.
+ * @retval 0 if successful, -1 if adc_injected_init() was not called or the
+ * conversion did not complete.
+ * @note The conversion pre-empts a regular one in progress, so it starts at
+ * once. It is waited for by polling: a few microseconds, less than two
+ * context switches. Callers must not overlap.
+ */
+int32_t adc_injected_read(uint16_t *pusValues)
+{
+	uint32_t ulSpin = 0;
+	uint32_t i;
+
+	if (ulInjectedCount == 0U)
+	{
+		return -1;
+	}
+
+	ADC1->SR &= ~(1U << ADC_SR_JEOC_OFS);
+	ADC1->CR2 |= (1U << ADC_CR2_JSWSTART_OFS);
+
+	while (!(ADC1->SR & (1U << ADC_SR_JEOC_OFS)))
+	{
+		if (++ulSpin > ADC_INJECTED_SPIN_LIMIT)
+		{
+			return -1;
+		}
+	}
+
+	for (i = 0; i < ulInjectedCount; i++)
+	{
+		pusValues[i] = (uint16_t)(&ADC1->JDR1)[i];
+	}
+
+	return 0;
+}
+
+/**
+ * @brief DMA2 Stream0 IRQ handler (ADC1 buffer full).
+ * @note CT already points at the buffer the DMA moved on to, so the full one
+ * is the other. For the stream, a block the consumer has not yet taken is
+ * counted as an overrun rather than overwriting its notification. For the
+ * scan, the block is decimated here and the task's notification counts it.
+ * @param None
+ * @retval None
+ */
+void DMA2_Stream0_IRQHandler(void)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	const uint32_t ulStatus = DMA2->LISR;
+	uint32_t ulFull;
+
+	DMA2->LIFCR = DMA_LIFCR_STREAM0_MASK;
+
+	if (ucDmaOwner == ADC_DMA_OWNER_SCAN)
+	{
+		if (ulStatus & (1U << DMA_LISR_TEIF0_OFS))
+		{
+			/* The stream is now disabled. */
+			ulScanOverruns++;
+			adc_scan_restart();
+		}
+		else if (ulStatus & (1U << DMA_LISR_TCIF0_OFS))
+		{
+			ulFull = (DMA2_Stream0->CR & (1U << DMA_SxCR_CT_OFS)) ? 0U : 1U;
+			adc_scan_decimate(&xScan.pusRaw[ulFull * ulScanBlockLength]);
+
+			if (xScan.xTask != NULL)
+			{
+				vTaskNotifyGiveFromISR(xScan.xTask, &xHigherPriorityTaskWoken);
+			}
+		}
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+		return;
+	}
+
+	if (ucDmaOwner == ADC_DMA_OWNER_INTERLEAVED)
+	{
+		if (ulStatus & (1U << DMA_LISR_TEIF0_OFS))
+		{
+			ulInterleavedOverruns++;
+			adc_interleaved_restart();
+		}
+		else if (ulStatus & (1U << DMA_LISR_TCIF0_OFS))
+		{
+			ulFull = (DMA2_Stream0->CR & (1U << DMA_SxCR_CT_OFS)) ?
+					ADC_STREAM_NOTIFY_BUF0 : ADC_STREAM_NOTIFY_BUF1;
+
+			if (xTaskNotifyFromISR(xInterleavedTask, ulFull, eSetValueWithoutOverwrite,
+					&xHigherPriorityTaskWoken) != pdPASS)
+			{
+				ulInterleavedOverruns++;
+			}
+		}
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+		return;
+	}
+
+	if (ulStatus & (1U << DMA_LISR_TEIF0_OFS))
+	{
+		ulStreamOverruns++;
+	}
+
+	if (ulStatus & (1U << DMA_LISR_TCIF0_OFS))
+	{
+		ulFull = (DMA2_Stream0->CR & (1U << DMA_SxCR_CT_OFS)) ?
+				ADC_STREAM_NOTIFY_BUF0 : ADC_STREAM_NOTIFY_BUF1;
+
+		if (xTaskNotifyFromISR(xStreamTask, ulFull, eSetValueWithoutOverwrite,
+				&xHigherPriorityTaskWoken) != pdPASS)
+		{
+			ulStreamOverruns++;
+		}
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief ADC IRQ handler (regular overrun during a scan or interleaved
+ * capture).
+ * @note A conversion was lost, so the samples after it would be stored one
+ * slot early: the capture restarts on a new block instead.
+ * @param None
+ * @retval None
+ */
+void ADC_IRQHandler(void)
+{
+	if (ucDmaOwner == ADC_DMA_OWNER_INTERLEAVED)
+	{
+		if ((ADC->CSR & (ADC_CSR_OVR1 | ADC_CSR_OVR2 | ADC_CSR_OVR3)) != 0U)
+		{
+			ulInterleavedOverruns++;
+			adc_interleaved_restart();
+		}
+
+		return;
+	}
+
+	if (ADC1->SR & (1U << ADC_SR_OVR_OFS))
+	{
+		ADC1->SR &= ~(1U << ADC_SR_OVR_OFS);
+
+		if (ucDmaOwner == ADC_DMA_OWNER_SCAN)
+		{
+			ulScanOverruns++;
+			adc_scan_restart();
+		}
+	}
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Returns the TIM2 kernel clock.
+ * @param None
+ * @retval PCLK1, doubled when APB1 is divided.
+ */
+static uint32_t adc_stream_timer_clock(void)
+{
+	uint32_t ulClock = HAL_RCC_GetPCLK1Freq();
+
+	if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+	{
+		ulClock *= 2U;
+	}
+
+	return ulClock;
+}
+
+/**
+ * @brief Stops TIM2 and DMA2 Stream0, for whichever mode uses them.
+ * @param None
+ * @retval None
+ */
+static void adc_dma_stop(void)
+{
+	TIM2->CR1 &= ~(1U << TIM_CR1_CEN_OFS);
+
+	/* Disable the stream and wait until it is really off. */
+	DMA2_Stream0->CR &= ~(1U << DMA_SxCR_EN_OFS);
+	while (DMA2_Stream0->CR & (1U << DMA_SxCR_EN_OFS)){}
+
+	DMA2->LIFCR = DMA_LIFCR_STREAM0_MASK;
+}
+
+/**
+ * @brief Stops whichever mode uses TIM2 and DMA2 Stream0, and returns ADC1
+ * to independent mode.
+ * @param None
+ * @retval None
+ */
+static void adc_release(void)
+{
+	if (ucDmaOwner == ADC_DMA_OWNER_INTERLEAVED)
+	{
+		ucDmaOwner = ADC_DMA_OWNER_STREAM;
+		adc_interleaved_stop();
+		ADC1->CR1 &= ~(1U << ADC_CR1_OVRIE_OFS);
+	}
+	else
+	{
+		adc_dma_stop();
+	}
+
+	adc_gate_off();
+}
+
+/**
+ * @brief Gates off the clocks only a running capture needs: TIM2, DMA2, ADC2
+ * and ADC3.
+ * @param None
+ * @retval None
+ * @note TIM2 and the DMA stream must be stopped. A clock this driver does not
+ * hold is left alone, and so is DMA2 while another driver holds it.
+ */
+static void adc_gate_off(void)
+{
+	clkgate_release(&xTimerClock);
+	clkgate_release(&xDmaClock);
+	clkgate_release(&xAdc2Clock);
+	clkgate_release(&xAdc3Clock);
+}
+
+/**
+ * @brief Prepares channels for conversion.
+ * @param pucChannels Channels, 0..18.
+ * @param ulCount Number of channels.
+ * @param ulSampleTime SMPR code 0..7, for each of them.
+ * @retval 0 if successful, -1 if a channel or the sample time is invalid.
+ * Nothing is configured then.
+ */
+static int32_t adc_channels_init(const uint8_t *pucChannels, uint32_t ulCount,
+		uint32_t ulSampleTime)
+{
+	uint32_t ulChannel;
+	uint32_t i;
+
+	if (ulSampleTime >= (sizeof(usSampleCycles) / sizeof(usSampleCycles[0])))
+	{
+		return -1;
+	}
+
+	for (i = 0; i < ulCount; i++)
+	{
+		if ((pucChannels[i] > ADC_CHANNEL_MAX) || (pucChannels[i] == 16U))
+		{
+			return -1;	/* Channel 16 is the temperature sensor of other parts. */
+		}
+	}
+
+	/* Hold the clock of ADC1. ADC clock = PCLK2 / 4, within the 36 MHz limit
+	 * for every clock profile. */
+	clkgate_acquire(&xAdc1Clock);
+	ADC->CCR = (ADC->CCR & ~(3U << ADC_CCR_ADCPRE_OFS)) | (1U << ADC_CCR_ADCPRE_OFS);
+
+	for (i = 0; i < ulCount; i++)
+	{
+		ulChannel = pucChannels[i];
+
+		/* Pins to analog mode: PA0-PA7, PB0-PB1, PC0-PC5. */
+		if (ulChannel < 8U)
+		{
+			clkgate_acquire(&xGpioAClock);
+			GPIOA->MODER |= (3U << (ulChannel * 2U));
+		}
+		else if (ulChannel < 10U)
+		{
+			clkgate_acquire(&xGpioBClock);
+			GPIOB->MODER |= (3U << ((ulChannel - 8U) * 2U));
+		}
+		else if (ulChannel < 16U)
+		{
+			clkgate_acquire(&xGpioCClock);
+			GPIOC->MODER |= (3U << ((ulChannel - 10U) * 2U));
+		}
+		else
+		{
+			/* VREFINT and the temperature sensor. */
+			ADC->CCR |= (1U << ADC_CCR_TSVREFE_OFS);
+		}
+
+		if (ulChannel < 10U)
+		{
+			ADC1->SMPR2 = (ADC1->SMPR2 & ~(7U << (3U * ulChannel)))
+					| (ulSampleTime << (3U * ulChannel));
+		}
+		else
+		{
+			ADC1->SMPR1 = (ADC1->SMPR1 & ~(7U << (3U * (ulChannel - 10U))))
+					| (ulSampleTime << (3U * (ulChannel - 10U)));
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Restarts the scan from the first slot of the first buffer.
+ * @param None
+ * @retval None
+ * @note Called by adc_scan_start() and, after an overrun, by the interrupts.
+ */
+static void adc_scan_restart(void)
+{
+	adc_dma_stop();
+
+	DMA2_Stream0->PAR = (uint32_t)&ADC1->DR;
+	DMA2_Stream0->M0AR = (uint32_t)&xScan.pusRaw[0];
+	DMA2_Stream0->M1AR = (uint32_t)&xScan.pusRaw[ulScanBlockLength];
+	DMA2_Stream0->NDTR = ulScanBlockLength;
+	DMA2_Stream0->CR = (0U << DMA_SxCR_CHSEL_OFS)		/* Channel 0. */
+			| (1U << DMA_SxCR_DBM_OFS)					/* Double buffer. */
+			| (2U << DMA_SxCR_PL_OFS)					/* High priority. */
+			| (1U << DMA_SxCR_MSIZE_OFS)				/* 16-bit memory. */
+			| (1U << DMA_SxCR_PSIZE_OFS)				/* 16-bit peripheral. */
+			| (1U << DMA_SxCR_MINC_OFS)					/* Increment memory. */
+			| (1U << DMA_SxCR_CIRC_OFS)					/* Required by DBM. */
+			| (1U << DMA_SxCR_TCIE_OFS)					/* Buffer full. */
+			| (1U << DMA_SxCR_TEIE_OFS);				/* Transfer error. */
+	DMA2_Stream0->FCR = 0;	/* Direct mode. */
+	DMA2_Stream0->CR |= (1U << DMA_SxCR_EN_OFS);
+
+	/* Clear a stale overrun, then re-arm the DMA requests. */
+	ADC1->SR &= ~(1U << ADC_SR_OVR_OFS);
+	ADC1->CR2 &= ~(1U << ADC_CR2_DMA_OFS);
+	ADC1->CR2 |= (1U << ADC_CR2_DMA_OFS);
+
+	TIM2->CNT = 0;
+	TIM2->CR1 |= (1U << TIM_CR1_CEN_OFS);
+}
+
+/**
+ * @brief Sums the sequences of a full buffer per channel and publishes them.
+ * @param pusRaw Full buffer of ulScanBlockLength samples.
+ * @retval None
+ * @note Runs in the DMA interrupt. The block count is bumped last, so a
+ * reader that saw it unchanged across its copy has consistent values.
+ */
+static void adc_scan_decimate(const uint16_t *pusRaw)
+{
+	const uint32_t ulCount = xScan.ucCount;
+	uint32_t ulSum;
+	uint32_t ulChannel;
+	uint32_t i;
+
+	for (ulChannel = 0; ulChannel < ulCount; ulChannel++)
+	{
+		ulSum = 0;
+
+		for (i = ulChannel; i < ulScanBlockLength; i += ulCount)
+		{
+			ulSum += pusRaw[i];
+		}
+
+		usScanValues[ulChannel] = (uint16_t)(ulSum >> xScan.ucShift);
+	}
+
+	ulScanBlocks++;
+}
+
+/**
+ * @brief Restarts interleaved capture from the first word of the first buffer.
+ * @param None
+ * @retval None
+ * @note Called by adc_interleaved_start() and, after an overrun, by the
+ * interrupts. The conversions stop first, so ADC1 leads again.
+ */
+static void adc_interleaved_restart(void)
+{
+	ADC1->CR2 &= ~(1U << ADC_CR2_CONT_OFS);
+	adc_dma_stop();
+
+	DMA2_Stream0->PAR = (uint32_t)&ADC->CDR;
+	DMA2_Stream0->M0AR = (uint32_t)pulInterleavedBuf[0];
+	DMA2_Stream0->M1AR = (uint32_t)pulInterleavedBuf[1];
+	DMA2_Stream0->NDTR = usInterleavedBlockWords;
+	DMA2_Stream0->CR = (0U << DMA_SxCR_CHSEL_OFS)		/* Channel 0. */
+			| (1U << DMA_SxCR_DBM_OFS)					/* Double buffer. */
+			| (3U << DMA_SxCR_PL_OFS)					/* Very high: 2 words per us. */
+			| (2U << DMA_SxCR_MSIZE_OFS)				/* 32-bit memory. */
+			| (2U << DMA_SxCR_PSIZE_OFS)				/* 32-bit peripheral. */
+			| (1U << DMA_SxCR_MINC_OFS)					/* Increment memory. */
+			| (1U << DMA_SxCR_CIRC_OFS)					/* Required by DBM. */
+			| (1U << DMA_SxCR_TCIE_OFS)					/* Buffer full. */
+			| (1U << DMA_SxCR_TEIE_OFS);				/* Transfer error. */
+	DMA2_Stream0->FCR = 0;	/* Direct mode. */
+	DMA2_Stream0->CR |= (1U << DMA_SxCR_EN_OFS);
+
+	/* Clear stale overruns, re-arm the DMA requests, and start ADC1. */
+	ADC1->SR &= ~(1U << ADC_SR_OVR_OFS);
+	ADC2->SR &= ~(1U << ADC_SR_OVR_OFS);
+	ADC3->SR &= ~(1U << ADC_SR_OVR_OFS);
+	ADC->CCR &= ~(3U << ADC_CCR_DMA_OFS);
+	ADC->CCR |= (ADC_MULTI_DMA_MODE2 << ADC_CCR_DMA_OFS);
+
+	ADC1->CR2 |= (1U << ADC_CR2_CONT_OFS);
+	ADC1->CR2 |= (1U << ADC_CR2_SWSTART_OFS);
+}
@@ -0,0 +1,260 @@
+/*******************************************************************************
+ *
+ * @file	binlog.c
+ * @brief	Deferred binary logger: records are formatted on the host.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	A record is (2 + n) little-endian words:
+ *
+ * 				word 0	0xA5 | n << 8 | ID << 16
+ * 				word 1	DWT CYCCNT when the record was written
+ * 				word 2+	the n arguments
+ *
+ * 			ID is the offset of the format string in the '.binlog_str'
+ * 			section of the ELF, which is never loaded into flash.
+ * 			ID 0xFFFF reports dropped records, its argument being the count.
+ *
+ * 			Writers reserve space in the ring with LDREX/STREX on the head
+ * 			index and write the header word last. The drain task only
+ * 			consumes records whose header is non-zero, and zeroes the words
+ * 			it has consumed, so a writer preempted between its reservation
+ * 			and its header just holds back the records reserved after it.
+ * 			No lock is taken and interrupts are never masked.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "uart.h"
+#include "binlog.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define BINLOG_RING_MASK		(BINLOG_RING_WORDS - 1U)
+#define BINLOG_HEADER_WORDS		2U
+#define BINLOG_SYNC				0xA5U
+#define BINLOG_NARGS_OFS		8U
+#define BINLOG_NARGS_MASK		0xFU
+#define BINLOG_ID_OFS			16U
+#define BINLOG_ID_DROPPED		0xFFFFU
+#define BINLOG_STAGING_WORDS	64U		/* Words handed to the UART at once. */
+#define BINLOG_STACK_SIZE		128U
+
+#if ((BINLOG_RING_WORDS & BINLOG_RING_MASK) != 0U)
+#error BINLOG_RING_WORDS must be a power of two
+#endif
+
+#if (BINLOG_MAX_ARGS > BINLOG_NARGS_MASK) || ((BINLOG_HEADER_WORDS + BINLOG_MAX_ARGS) > BINLOG_STAGING_WORDS)
+#error BINLOG_MAX_ARGS is too large
+#endif
+
+/* Variables -----------------------------------------------------------------*/
+static volatile uint32_t ulBinlogRing[BINLOG_RING_WORDS];
+static volatile uint32_t ulBinlogHead = 0;		/* Free-running, writers. */
+static volatile uint32_t ulBinlogTail = 0;		/* Free-running, drain task. */
+static volatile uint32_t ulBinlogDropped = 0;
+static uint32_t ulBinlogDroppedReported = 0;
+static uint32_t ulBinlogStaging[BINLOG_STAGING_WORDS];
+
+/* Private function prototypes -----------------------------------------------*/
+static void binlog_count_drop(void);
+static uint32_t binlog_send(uint32_t ulWords);
+static void binlog_drain_task(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Starts the cycle counter used for timestamps and creates the drain
+ * task.
+ * @param None
+ * @retval 0 if successful, -1 otherwise.
+ * @note USART2 TX must be initialized first.
+ */
+int32_t binlog_init(void)
+{
+	/* Enable the trace and debug blocks, DWT included. */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	if (xTaskCreate(binlog_drain_task, "binlog", BINLOG_STACK_SIZE, NULL,
+			BINLOG_DRAIN_PRIORITY, NULL) != pdPASS)
+	{
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Appends a record to the ring (normally through the BINLOG() macro).
+ * @param pcFormat Format string placed in the '.binlog_str' section.
+ * @param pulArgs Argument words.
+ * @param ulArgCount Number of arguments, truncated to BINLOG_MAX_ARGS.
+ * @retval None
+ * @note The record is dropped, and counted, if the ring is full.
+ */
+void binlog_write(const char *pcFormat, const uint32_t *pulArgs, uint32_t ulArgCount)
+{
+	uint32_t ulWords;
+	uint32_t ulHead;
+	uint32_t i;
+
+	if (ulArgCount > BINLOG_MAX_ARGS)
+	{
+		ulArgCount = BINLOG_MAX_ARGS;
+	}
+
+	ulWords = BINLOG_HEADER_WORDS + ulArgCount;
+
+	/* Reserve ulWords words at the head. */
+	do
+	{
+		ulHead = __LDREXW(&ulBinlogHead);
+
+		if ((ulHead + ulWords - ulBinlogTail) > BINLOG_RING_WORDS)
+		{
+			__CLREX();
+			binlog_count_drop();
+			return;
+		}
+	} while (__STREXW(ulHead + ulWords, &ulBinlogHead) != 0U);
+
+	ulBinlogRing[(ulHead + 1U) & BINLOG_RING_MASK] = DWT->CYCCNT;
+
+	for (i = 0; i < ulArgCount; i++)
+	{
+		ulBinlogRing[(ulHead + BINLOG_HEADER_WORDS + i) & BINLOG_RING_MASK] = pulArgs[i];
+	}
+
+	/* Publish: the body must be visible before the header. */
+	__DMB();
+	ulBinlogRing[ulHead & BINLOG_RING_MASK] = BINLOG_SYNC
+			| (ulArgCount << BINLOG_NARGS_OFS)
+			| (((uint32_t)pcFormat & 0xFFFFU) << BINLOG_ID_OFS);
+}
+
+/**
+ * @brief Sends every committed record to USART2.
+ * @param None
+ * @retval Number of bytes queued for transmission.
+ * @note Called by the drain task; only one caller at a time.
+ */
+uint32_t binlog_flush(void)
+{
+	uint32_t ulTail = ulBinlogTail;
+	uint32_t ulStaged = 0;
+	uint32_t ulBytes = 0;
+	uint32_t ulHeader;
+	uint32_t ulWords;
+	uint32_t ulDropped;
+	uint32_t i;
+
+	ulDropped = ulBinlogDropped;
+
+	if (ulDropped != ulBinlogDroppedReported)
+	{
+		ulBinlogStaging[ulStaged++] = BINLOG_SYNC | (1U << BINLOG_NARGS_OFS)
+				| (BINLOG_ID_DROPPED << BINLOG_ID_OFS);
+		ulBinlogStaging[ulStaged++] = DWT->CYCCNT;
+		ulBinlogStaging[ulStaged++] = ulDropped - ulBinlogDroppedReported;
+		ulBinlogDroppedReported = ulDropped;
+	}
+
+	while (ulTail != ulBinlogHead)
+	{
+		ulHeader = ulBinlogRing[ulTail & BINLOG_RING_MASK];
+
+		if (ulHeader == 0U)
+		{
+			/* Reserved, not yet committed. */
+			break;
+		}
+
+		/* Read the body only after seeing the header. */
+		__DMB();
+
+		ulWords = BINLOG_HEADER_WORDS + ((ulHeader >> BINLOG_NARGS_OFS) & BINLOG_NARGS_MASK);
+
+		if ((ulStaged + ulWords) > BINLOG_STAGING_WORDS)
+		{
+			ulBytes += binlog_send(ulStaged);
+			ulStaged = 0;
+		}
+
+		for (i = 0; i < ulWords; i++)
+		{
+			ulBinlogStaging[ulStaged++] = ulBinlogRing[(ulTail + i) & BINLOG_RING_MASK];
+			ulBinlogRing[(ulTail + i) & BINLOG_RING_MASK] = 0;
+		}
+
+		ulTail += ulWords;
+
+		/* The zeroed words must be visible before the space is released. */
+		__DMB();
+		ulBinlogTail = ulTail;
+	}
+
+	ulBytes += binlog_send(ulStaged);
+
+	return ulBytes;
+}
+
+/**
+ * @brief Returns the number of records dropped because the ring was full.
+ * @param None
+ * @retval Dropped records since start-up.
+ */
+uint32_t binlog_get_dropped(void)
+{
+	return ulBinlogDropped;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Increments the dropped record count, from any context.
+ * @param None
+ * @retval None
+ */
+static void binlog_count_drop(void)
+{
+	uint32_t ulDropped;
+
+	do
+	{
+		ulDropped = __LDREXW(&ulBinlogDropped);
+	} while (__STREXW(ulDropped + 1U, &ulBinlogDropped) != 0U);
+}
+
+/**
+ * @brief Queues the staged words for transmission.
+ * @param ulWords Number of staged words.
+ * @retval Number of bytes queued.
+ */
+static uint32_t binlog_send(uint32_t ulWords)
+{
+	if (ulWords == 0U)
+	{
+		return 0;
+	}
+
+	/* Little-endian core: the words go out byte by byte in wire order. */
+	return (uint32_t)USART2_write_buffer((const char *)ulBinlogStaging,
+			(int)(ulWords * sizeof(uint32_t)));
+}
+
+/**
+ * @brief Periodically drains the ring to USART2.
+ * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
+ * task function signature.
+ * @retval None
+ */
+static void binlog_drain_task(void *pvParameters)
+{
+	while (1)
+	{
+		(void)binlog_flush();
+		vTaskDelay(pdMS_TO_TICKS(BINLOG_DRAIN_PERIOD_MS));
+	}
+}
@@ -0,0 +1,39 @@
+/*******************************************************************************
+ *
+ * @file	log.c
+ * @brief	Runtime level of the log macros in log.h.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	The levels above LOG_LEVEL are removed at compile time; this only
+ * 			narrows the ones compiled in.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "log.h"
+
+/* Variables -----------------------------------------------------------------*/
+uint8_t ucLogLevel = (uint8_t)LOG_LEVEL;	/* Everything compiled in is on. */
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Sets the highest level that is printed.
+ * @param ucLevel LOG_LEVEL_NONE to LOG_LEVEL_DEBUG.
+ * @retval None
+ * @note A byte store, so tasks and ISRs can change it at any time.
+ */
+void log_set_level(uint8_t ucLevel)
+{
+	ucLogLevel = ucLevel;
+}
+
+/**
+ * @brief Returns the highest level that is printed.
+ * @param None
+ * @retval LOG_LEVEL_NONE to LOG_LEVEL_DEBUG.
+ */
+uint8_t log_get_level(void)
+{
+	return ucLogLevel;
+}
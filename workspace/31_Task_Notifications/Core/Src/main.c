@@ -13,28 +13,70 @@
  * 			2. ISR-safe
  * 			3. Can replace semaphores (binary / counting)
  *
+ * 			The button ISR does not notify a task of its own: it posts a
+ * 			work item to the urgent lane of the work queue (workq.c), whose
+ * 			worker blocks on its notification count. The lanes' latency is
+ * 			logged from the background lane after each press.
+ *
+ * 			The button is debounced by exti.c, so each press is one post.
+ * 			With BUTTON_COALESCE 1, exti.c coalesces the edges of a press
+ * 			instead: the bounces in the window are counted in the interrupt
+ * 			and reported as one batch, whose size and span are logged.
+ *
+ * 			Lines go through the log macros of log.h to the binary logger:
+ * 			each press is a debug line and the statistics are info lines,
+ * 			so a Release build (no DEBUG) compiles neither in.
+ *
  ******************************************************************************/
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
 #include "uart.h"
 #include "exti.h"
 #include "adc.h"
+#include "binlog.h"
+#include "workq.h"
 
-#define STACK_SIZE 128	// 128 * 4 = 512 bytes
+#define LOG_MODULE			"main"
+#define LOG_BACKEND			LOG_BACKEND_BINLOG
+#include "log.h"
+
+#define LANE_URGENT			0U
+#define LANE_BACKGROUND		1U
+#define LANE_URGENT_PRIORITY		3U
+#define LANE_BACKGROUND_PRIORITY	1U
+#define BUTTON_DEBOUNCE_MS			20U
+#define BUTTON_COALESCE				1	/* 0: debounce the button, 1: count the edges of each press */
+#define BUTTON_LINE					13U
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 int __io_putchar(int ch);
-void vHandlerTask(void *pvParameters);
+static void prvButtonWork(void *pvArg);
+static void prvReportWork(void *pvArg);
+static void prvButtonPressed(uint32_t ulLine, uint32_t ulLevel, void *pvArg,
+		BaseType_t *pxHigherPriorityTaskWoken);
 
 /* Data types ----------------------------------------------------------------*/
 
 /* Variables -----------------------------------------------------------------*/
-static TaskHandle_t xHandlerTask = NULL;
+static uint32_t ulButtonPresses = 0;	/* Urgent lane only. */
+
+static const ExtiPin_t xButtonPins[] =
+{
+#if (BUTTON_COALESCE == 1)
+	{ B1_GPIO_Port, BUTTON_LINE, EXTI_EDGE_FALLING, EXTI_PULL_NONE, 0,
+			prvButtonPressed, NULL, NULL, 0,
+			EXTI_COALESCE_WINDOW, BUTTON_DEBOUNCE_MS * 1000U },
+#else
+	{ B1_GPIO_Port, BUTTON_LINE, EXTI_EDGE_FALLING, EXTI_PULL_NONE, BUTTON_DEBOUNCE_MS,
+			prvButtonPressed, NULL, NULL, 0 },
+#endif
+};
 
 /**
  * @brief The application entry point.
@@ -51,16 +93,24 @@ int main(void)
 	MX_GPIO_Init();
 	USART2_UART_TX_Init();
 	gpio_init();
-	gpio_pc13_interrupt_init();
 
-	/* Create tasks. */
-	xTaskCreate(
-			vHandlerTask,
-			"vHandlerTask",
-			STACK_SIZE,
-			NULL,
-			3,
-			&xHandlerTask);
+	if (exti_init(xButtonPins, sizeof(xButtonPins) / sizeof(xButtonPins[0])) != 0)
+	{
+		Error_Handler();
+	}
+
+	/* Log records are formatted on the host (Tools/binlog_decode.py). */
+	if (binlog_init() != 0)
+	{
+		Error_Handler();
+	}
+
+	/* Two worker tasks serve every interrupt source. */
+	if ((workq_start_lane(LANE_URGENT, LANE_URGENT_PRIORITY) != 0)
+			|| (workq_start_lane(LANE_BACKGROUND, LANE_BACKGROUND_PRIORITY) != 0))
+	{
+		Error_Handler();
+	}
 
 	vTaskStartScheduler();
 
@@ -71,39 +121,75 @@ int main(void)
 	}
 }
 
-void vHandlerTask(void *pvParameters)
+/**
+ * @brief Handles a button press (urgent lane).
+ * @param pvArg Unused.
+ * @retval None
+ */
+static void prvButtonWork(void *pvArg)
 {
-	const TickType_t xMaxExpectedBlockTime = pdMS_TO_TICKS(100UL);
+	ExtiBatch_t xBatch;
 
-	while (1)
+	/* Every report posts, so a batch is empty if an earlier post took it. */
+	if (exti_take_batch(BUTTON_LINE, &xBatch) == 0U)
 	{
-		if (ulTaskNotifyTake(pdFALSE, xMaxExpectedBlockTime) != 0)
-		{
-			/* NOTE:
-			 * 	- pdFALSE: Decrement the notification count by 1.
-			 * 	- pdTRUE: Reset the notification count to 0. */
-
-			/* Do something. */
-			printf("Handler task - Processing event.\r\n");
-		}
-		else
-		{
-			/* Handle timeout. */
-		}
+		return;
 	}
+
+	ulButtonPresses++;
+	LOG_DEBUG("Urgent lane - Button press %lu, %lu edges over %lu us.",
+			ulButtonPresses,
+			xBatch.ulCount,
+			xBatch.ulLastUs - xBatch.ulFirstUs);
+
+	/* Reporting can wait behind anything more urgent. */
+	(void)workq_post(LANE_BACKGROUND, prvReportWork, NULL);
 }
 
-void EXIT15_10_IRQHandler(void)
+/**
+ * @brief Logs the statistics of every lane (background lane).
+ * @param pvArg Unused.
+ * @retval None
+ */
+static void prvReportWork(void *pvArg)
 {
-	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	WorkqStats_t xStats;
+	uint32_t ulLane;
 
-	vTaskNotifyGiveFromISR(xHandlerTask, &xHigherPriorityTaskWoken);
+	for (ulLane = 0; ulLane < WORKQ_LANES; ulLane++)
+	{
+		if ((workq_get_stats(ulLane, &xStats) != 0) || (xStats.ulDone == 0U))
+		{
+			continue;
+		}
 
-	/* Clear interrupt pending flag. */
-	EXTI->PR = 0x2000;
+		/* Two records: BINLOG_MAX_ARGS is 6. */
+		LOG_INFO("Lane %lu - %lu done, %lu dropped, peak depth %lu.",
+				ulLane,
+				xStats.ulDone,
+				xStats.ulDropped,
+				xStats.ulPeakDepth);
+		LOG_INFO("Lane %lu - Latency min/avg/max %lu/%lu/%lu cycles.",
+				ulLane,
+				xStats.ulMinCycles,
+				(uint32_t)(xStats.ullTotalCycles / xStats.ulDone),
+				xStats.ulMaxCycles);
+	}
+}
 
-	/* Request a context switch. */
-	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+/**
+ * @brief Handles a debounced or coalesced press of the B1 button (PC13), from
+ * the EXTI or TIM5 interrupt.
+ * @param ulLine Unused.
+ * @param ulLevel Unused.
+ * @param pvArg Unused.
+ * @param pxHigherPriorityTaskWoken Set if the urgent lane should run.
+ * @retval None
+ */
+static void prvButtonPressed(uint32_t ulLine, uint32_t ulLevel, void *pvArg,
+		BaseType_t *pxHigherPriorityTaskWoken)
+{
+	(void)workq_post_from_isr(LANE_URGENT, prvButtonWork, NULL, pxHigherPriorityTaskWoken);
 }
 
 /**
@@ -112,44 +198,9 @@ void EXIT15_10_IRQHandler(void)
  */
 void SystemClock_Config(void)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
-
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-	{
-		Error_Handler();
-	}
-
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
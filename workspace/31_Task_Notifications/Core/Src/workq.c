@@ -0,0 +1,322 @@
+/*******************************************************************************
+ *
+ * @file	workq.c
+ * @brief	Deferred interrupt work queue: ISRs post (function, argument)
+ * 			work items to a few worker tasks instead of waking a task each.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Each lane is one worker task at its own priority, fed by a
+ * 			lock-free multiple-producer/single-consumer ring. Urgent work goes
+ * 			to a high priority lane and the rest to a low one, so twenty
+ * 			interrupt sources can share two or three stacks instead of
+ * 			having a task each, and none of them waits behind the timer
+ * 			service task as with xTimerPendFunctionCallFromISR().
+ *
+ * 			Every slot of a ring carries a sequence number. A producer claims
+ * 			the slot at 'ulHead' with one LDREX/STREX pair, fills it, and
+ * 			publishes it by setting its sequence to head + 1; the worker only
+ * 			runs a slot whose sequence says it is published, and hands it
+ * 			back to the producers by advancing the sequence one lap. A
+ * 			producer interrupted between claim and publish (by a higher
+ * 			priority ISR posting to the same lane) only holds back the items
+ * 			claimed after it until it resumes. Interrupts are never masked.
+ *
+ * 			Posting notifies the worker through the FreeRTOS API, so
+ * 			producers must run at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ * 			Work functions run in the worker task and may block, but that
+ * 			holds up the rest of the lane.
+ *
+ * 			Latency, from the post to the start of the work function, is
+ * 			measured per lane with the DWT cycle counter.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "workq.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define WORKQ_RING_MASK		(WORKQ_RING_SIZE - 1U)
+
+#if ((WORKQ_RING_SIZE & WORKQ_RING_MASK) != 0U)
+#error WORKQ_RING_SIZE must be a power of two
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	volatile uint32_t ulSequence;	/* Position + 1 once published. */
+	WorkqFunction_t pxFunction;
+	void *pvArg;
+	uint32_t ulPostCycles;			/* CYCCNT when posted. */
+} WorkqItem_t;
+
+typedef struct
+{
+	WorkqItem_t xItems[WORKQ_RING_SIZE];
+	volatile uint32_t ulHead;		/* Free-running, producers (LDREX/STREX). */
+	volatile uint32_t ulTail;		/* Free-running, worker only. */
+	volatile uint32_t ulDropped;	/* Producers (LDREX/STREX). */
+	WorkqStats_t xStats;			/* Worker only, ulDropped aside. */
+	TaskHandle_t xWorker;
+	StaticTask_t xWorkerTcb;
+	StackType_t xWorkerStack[WORKQ_STACK_WORDS];
+} WorkqLane_t;
+
+/* Variables -----------------------------------------------------------------*/
+static WorkqLane_t xWorkqLanes[WORKQ_LANES];
+
+/* Private function prototypes -----------------------------------------------*/
+static int32_t workq_push(WorkqLane_t *pxLane, WorkqFunction_t pxFunction, void *pvArg);
+static void workq_count_drop(WorkqLane_t *pxLane);
+static void workq_worker_task(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Initializes a lane and creates its worker task.
+ * @param ulLane Lane, below WORKQ_LANES.
+ * @param uxPriority Priority of the worker task.
+ * @retval 0 if successful, -1 otherwise.
+ * @note Call before posting to the lane, from a task or before the scheduler
+ * starts. The worker's stack and TCB are static.
+ */
+int32_t workq_start_lane(uint32_t ulLane, UBaseType_t uxPriority)
+{
+	WorkqLane_t *pxLane;
+	uint32_t i;
+
+	if ((ulLane >= WORKQ_LANES) || (xWorkqLanes[ulLane].xWorker != NULL))
+	{
+		return -1;
+	}
+
+	/* Latency is measured in core clock cycles. */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	pxLane = &xWorkqLanes[ulLane];
+
+	for (i = 0; i < WORKQ_RING_SIZE; i++)
+	{
+		pxLane->xItems[i].ulSequence = i;
+	}
+
+	pxLane->ulHead = 0;
+	pxLane->ulTail = 0;
+	pxLane->ulDropped = 0;
+	pxLane->xStats.ulDone = 0;
+	pxLane->xStats.ulDropped = 0;
+	pxLane->xStats.ulPeakDepth = 0;
+	pxLane->xStats.ulMinCycles = UINT32_MAX;
+	pxLane->xStats.ulMaxCycles = 0;
+	pxLane->xStats.ullTotalCycles = 0;
+
+	pxLane->xWorker = xTaskCreateStatic(workq_worker_task,
+										"vWorkqWorker",
+										WORKQ_STACK_WORDS,
+										pxLane,
+										uxPriority,
+										pxLane->xWorkerStack,
+										&pxLane->xWorkerTcb);
+
+	return (pxLane->xWorker != NULL) ? 0 : -1;
+}
+
+/**
+ * @brief Posts a work item from a task.
+ * @param ulLane Lane started with workq_start_lane().
+ * @param pxFunction Function the worker calls.
+ * @param pvArg Its argument.
+ * @retval 0 if successful, -1 if the lane's ring was full.
+ */
+int32_t workq_post(uint32_t ulLane, WorkqFunction_t pxFunction, void *pvArg)
+{
+	WorkqLane_t *pxLane;
+
+	configASSERT(ulLane < WORKQ_LANES);
+	pxLane = &xWorkqLanes[ulLane];
+
+	if (workq_push(pxLane, pxFunction, pvArg) != 0)
+	{
+		return -1;
+	}
+
+	(void)xTaskNotifyGiveIndexed(pxLane->xWorker, WORKQ_NOTIFY_INDEX);
+
+	return 0;
+}
+
+/**
+ * @brief Posts a work item from an ISR.
+ * @param ulLane Lane started with workq_start_lane().
+ * @param pxFunction Function the worker calls.
+ * @param pvArg Its argument.
+ * @param pxHigherPriorityTaskWoken Set if the worker must run on exit.
+ * @retval 0 if successful, -1 if the lane's ring was full.
+ * @note Only from ISRs at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+int32_t workq_post_from_isr(uint32_t ulLane, WorkqFunction_t pxFunction, void *pvArg,
+		BaseType_t *pxHigherPriorityTaskWoken)
+{
+	WorkqLane_t *pxLane;
+
+	configASSERT(ulLane < WORKQ_LANES);
+	pxLane = &xWorkqLanes[ulLane];
+
+	if (workq_push(pxLane, pxFunction, pvArg) != 0)
+	{
+		return -1;
+	}
+
+	vTaskNotifyGiveIndexedFromISR(pxLane->xWorker, WORKQ_NOTIFY_INDEX, pxHigherPriorityTaskWoken);
+
+	return 0;
+}
+
+/**
+ * @brief Copies the statistics of a lane.
+ * @param ulLane Lane.
+ * @param pxStats Receives the statistics. ulMinCycles is UINT32_MAX until
+ * the first item has run.
+ * @retval 0 if successful, -1 otherwise.
+ * @note From tasks only.
+ */
+int32_t workq_get_stats(uint32_t ulLane, WorkqStats_t *pxStats)
+{
+	if ((ulLane >= WORKQ_LANES) || (pxStats == NULL))
+	{
+		return -1;
+	}
+
+	taskENTER_CRITICAL();
+	*pxStats = xWorkqLanes[ulLane].xStats;
+	pxStats->ulDropped = xWorkqLanes[ulLane].ulDropped;
+	taskEXIT_CRITICAL();
+
+	return 0;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Claims, fills and publishes the next slot of a lane.
+ * @param pxLane Lane.
+ * @param pxFunction Function the worker calls.
+ * @param pvArg Its argument.
+ * @retval 0 if successful, -1 if the ring was full.
+ */
+static int32_t workq_push(WorkqLane_t *pxLane, WorkqFunction_t pxFunction, void *pvArg)
+{
+	WorkqItem_t *pxItem;
+	uint32_t ulHead;
+
+	/* An exception between the two clears the exclusive monitor and makes the
+	 * store fail, so no other producer can claim the slot in between. */
+	do
+	{
+		ulHead = __LDREXW(&pxLane->ulHead);
+		pxItem = &pxLane->xItems[ulHead & WORKQ_RING_MASK];
+
+		/* Still holding the item of the previous lap. */
+		if (pxItem->ulSequence != ulHead)
+		{
+			__CLREX();
+			workq_count_drop(pxLane);
+			return -1;
+		}
+	} while (__STREXW(ulHead + 1U, &pxLane->ulHead) != 0U);
+
+	pxItem->pxFunction = pxFunction;
+	pxItem->pvArg = pvArg;
+	pxItem->ulPostCycles = DWT->CYCCNT;
+
+	/* The worker must see the item before the sequence that publishes it. */
+	__DMB();
+	pxItem->ulSequence = ulHead + 1U;
+
+	return 0;
+}
+
+/**
+ * @brief Counts a refused post.
+ * @param pxLane Lane.
+ * @retval None
+ */
+static void workq_count_drop(WorkqLane_t *pxLane)
+{
+	uint32_t ulDropped;
+
+	do
+	{
+		ulDropped = __LDREXW(&pxLane->ulDropped);
+	} while (__STREXW(ulDropped + 1U, &pxLane->ulDropped) != 0U);
+}
+
+/**
+ * @brief Runs the work items of one lane as they are published.
+ * @param pvParameters The lane.
+ * @retval None
+ */
+static void workq_worker_task(void *pvParameters)
+{
+	WorkqLane_t *pxLane = pvParameters;
+	WorkqItem_t *pxItem;
+	WorkqFunction_t pxFunction;
+	void *pvArg;
+	uint32_t ulTail;
+	uint32_t ulCycles;
+	uint32_t ulDepth;
+
+	while (1)
+	{
+		/* One notification per post, so a post published after the ring
+		 * looked empty below is not missed. */
+		(void)ulTaskNotifyTakeIndexed(WORKQ_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+
+		ulTail = pxLane->ulTail;
+		pxItem = &pxLane->xItems[ulTail & WORKQ_RING_MASK];
+
+		while (pxItem->ulSequence == (ulTail + 1U))
+		{
+			/* Read the item only after seeing it published. */
+			__DMB();
+			pxFunction = pxItem->pxFunction;
+			pvArg = pxItem->pvArg;
+			ulCycles = DWT->CYCCNT - pxItem->ulPostCycles;
+			ulDepth = pxLane->ulHead - ulTail;
+
+			/* And hand the slot back only after reading it. */
+			__DMB();
+			pxItem->ulSequence = ulTail + WORKQ_RING_SIZE;
+			pxLane->ulTail = ++ulTail;
+
+			/* A reader preempting the worker must not see half an update. */
+			taskENTER_CRITICAL();
+			pxLane->xStats.ulDone++;
+			pxLane->xStats.ullTotalCycles += ulCycles;
+
+			if (ulCycles < pxLane->xStats.ulMinCycles)
+			{
+				pxLane->xStats.ulMinCycles = ulCycles;
+			}
+
+			if (ulCycles > pxLane->xStats.ulMaxCycles)
+			{
+				pxLane->xStats.ulMaxCycles = ulCycles;
+			}
+
+			if (ulDepth > pxLane->xStats.ulPeakDepth)
+			{
+				pxLane->xStats.ulPeakDepth = ulDepth;
+			}
+			taskEXIT_CRITICAL();
+
+			pxFunction(pvArg);
+
+			pxItem = &pxLane->xItems[ulTail & WORKQ_RING_MASK];
+		}
+	}
+}
@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+"""Decodes the binary log stream written by binlog.c.
+
+The format strings are read from the '.binlog_str' section of the firmware
+ELF; the serial stream only carries their IDs (offsets in that section), a
+cycle-count timestamp and the raw argument words.
+
+Usage:
+    binlog_decode.py Debug/31_Task_Notifications.elf /dev/ttyACM0
+    binlog_decode.py Debug/31_Task_Notifications.elf capture.bin
+    cat /dev/ttyACM0 | binlog_decode.py Debug/31_Task_Notifications.elf -
+
+A serial port is opened with pyserial when it is installed; otherwise set it
+up beforehand (e.g. 'stty -F /dev/ttyACM0 115200 raw') and pass its path.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SECTION = ".binlog_str"
+SYNC = 0xA5
+ID_DROPPED = 0xFFFF
+
+# %[flags][width][.precision][length]conversion
+CONVERSION = re.compile(r"%([-+ 0#]*)(\d*)(?:\.(\d+))?(hh|h|ll|l|z|j|t)?([diouxXcsp%])")
+
+
+def read_section(path, name):
+    """Returns the contents of an ELF section."""
+    with open(path, "rb") as f:
+        elf = f.read()
+
+    if elf[:4] != b"\x7fELF":
+        sys.exit(f"{path}: not an ELF file")
+
+    is64 = elf[4] == 2
+    endian = "<" if elf[5] == 1 else ">"
+
+    if is64:
+        shoff, = struct.unpack_from(endian + "Q", elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", elf, 0x3A)
+    else:
+        shoff, = struct.unpack_from(endian + "I", elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", elf, 0x2E)
+
+    def header(index):
+        base = shoff + index * shentsize
+        if is64:
+            sh_name, = struct.unpack_from(endian + "I", elf, base)
+            sh_offset, sh_size = struct.unpack_from(endian + "QQ", elf, base + 0x18)
+        else:
+            sh_name, = struct.unpack_from(endian + "I", elf, base)
+            sh_offset, sh_size = struct.unpack_from(endian + "II", elf, base + 0x10)
+        return sh_name, sh_offset, sh_size
+
+    _, strtab_offset, _ = header(shstrndx)
+
+    for index in range(shnum):
+        sh_name, sh_offset, sh_size = header(index)
+        start = strtab_offset + sh_name
+        if elf[start:elf.index(b"\0", start)].decode() == name:
+            return elf[sh_offset:sh_offset + sh_size]
+
+    sys.exit(f"{path}: no {name} section (is the linker script up to date?)")
+
+
+def format_string(strings, fmt_id):
+    """Returns the NUL-terminated format string at offset fmt_id."""
+    if fmt_id >= len(strings) or (fmt_id > 0 and strings[fmt_id - 1] != 0):
+        return None
+    end = strings.index(b"\0", fmt_id)
+    return strings[fmt_id:end].decode("utf-8", errors="replace")
+
+
+def render(fmt, args):
+    """Formats fmt with 32-bit argument words, as printf would on the target."""
+    words = iter(args)
+
+    def substitute(match):
+        flags, width, precision, _, conversion = match.groups()
+        if conversion == "%":
+            return "%"
+        word = next(words, 0)
+        spec = "%" + flags + width + ("." + precision if precision else "")
+        if conversion in "di":
+            return (spec + "d") % (word - (1 << 32) if word & 0x80000000 else word)
+        if conversion == "c":
+            return (spec + "c") % chr(word & 0xFF)
+        if conversion == "p":
+            return (spec + "s") % f"0x{word:08x}"
+        if conversion == "s":
+            # Only the pointer is recorded; the string stays on the target.
+            return (spec + "s") % f"<str@0x{word:08x}>"
+        if conversion == "u":
+            return (spec + "d") % word
+        return (spec + conversion) % word
+
+    return CONVERSION.sub(substitute, fmt)
+
+
+def records(stream):
+    """Yields (header, timestamp, args) and resynchronizes on SYNC bytes."""
+    buffer = b""
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            return
+        buffer += chunk
+        while len(buffer) >= 8:
+            if buffer[0] != SYNC:
+                buffer = buffer[1:]
+                continue
+            header, timestamp = struct.unpack_from("<II", buffer)
+            nargs = (header >> 8) & 0xF
+            size = 8 + 4 * nargs
+            if len(buffer) < size:
+                break
+            args = struct.unpack_from("<%dI" % nargs, buffer, 8)
+            yield header, timestamp, args, buffer[:size]
+            buffer = buffer[size:]
+
+
+def open_input(path, baudrate):
+    if path == "-":
+        return sys.stdin.buffer
+    try:
+        import serial
+        if path.startswith(("/dev/", "COM")):
+            return serial.Serial(path, baudrate)
+    except ImportError:
+        pass
+    return open(path, "rb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf", help="firmware ELF with the .binlog_str section")
+    parser.add_argument("input", help="serial port, capture file, or - for stdin")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--cpu-hz", type=float, default=84e6,
+                        help="core clock, to print timestamps in seconds")
+    options = parser.parse_args()
+
+    strings = read_section(options.elf, SECTION)
+    stream = open_input(options.input, options.baudrate)
+    wrap = 0
+    last = 0
+
+    for header, timestamp, args, raw in records(stream):
+        fmt_id = header >> 16
+
+        # CYCCNT wraps every 2^32 cycles; records arrive in order.
+        if timestamp < last:
+            wrap += 1 << 32
+        last = timestamp
+        seconds = (wrap + timestamp) / options.cpu_hz
+
+        if fmt_id == ID_DROPPED:
+            text = f"<{args[0] if args else '?'} records dropped>\n"
+        else:
+            fmt = format_string(strings, fmt_id)
+            if fmt is None:
+                # Not a string start: a false SYNC inside corrupted data.
+                print(f"[{seconds:12.6f}] <bad record {raw.hex()}>")
+                continue
+            text = render(fmt, args)
+
+        sys.stdout.write(f"[{seconds:12.6f}] {text.rstrip()}\n")
+        sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main()
@@ -126,6 +126,7 @@ to exclude the API function. */
  * by the application thus the correct define need to be enabled below
  */
 #define USE_FreeRTOS_HEAP_4
+/* #define USE_FreeRTOS_HEAP_TLSF */	/* Instead of HEAP_4: heap_tlsf.c, O(1) malloc and free */
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -169,6 +170,31 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Port optimised task selection: the CM4F port finds the highest ready
+priority with CLZ on a ready-priority bitmap instead of walking the ready
+lists.  The 56 CMSIS-RTOS2 priorities take a two-level bitmap, so selection is
+two CLZs whatever the priorities in use (see README, Task Selection). */
+#undef configUSE_PORT_OPTIMISED_TASK_SELECTION
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
+/* Per-task round robin quanta (vTaskSetTimeSlice()); they take effect once
+configUSE_TIME_SLICING is set to 1 (see README, Time Slice Quanta). */
+#define configUSE_TASK_TIME_SLICE_QUANTA         1
+/* Voluntary and involuntary context switches, counted per task in
+TaskStatus_t (see README, Switch Accounting). */
+#define configUSE_SWITCH_STATS                   1
+/* Preemption thresholds (vTaskPreemptionThresholdSet()): the Sampler task
+shares its window with the Reporter task without a mutex (see README,
+Preemption Thresholds). */
+#define configUSE_PREEMPTION_THRESHOLD           1
+/* Kernel trace recorder (ktrace.c): the trace hooks write timestamped events
+to a RAM ring that a task drains to USART2 (see README, Kernel Trace). Remove
+this include to build without tracing. */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  #include "ktrace.h"
+#endif
+/* The idle task sleeps the CPU until the next interrupt instead of spinning
+between ticks (see README, Idle Sleep). */
+#define configUSE_IDLE_SLEEP                     1
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,559 @@
+/*******************************************************************************
+ *
+ * @file	ktrace.c
+ * @brief	Kernel trace recorder: timestamped binary events in a RAM ring.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	An event is two little-endian words:
+ *
+ * 				word 0	DWT CYCCNT when the event was recorded
+ * 				word 1	ID | context << 8 | argument << 16
+ *
+ * 			The context is the running task's number (uxTCBNumber, 1..127),
+ * 			0x80 | the exception number in an ISR, or 0 before the scheduler
+ * 			starts. The argument depends on the ID (see ktrace.h): a task
+ * 			number, a priority, a tick count, or the object ID of a queue,
+ * 			which is its address / 4, truncated to 16 bits.
+ *
+ * 			Two records are not events. KTRACE_EV_SYNC has the magic "KTRC"
+ * 			in word 0, the format version as context and the core clock in
+ * 			MHz as argument. KTRACE_EV_TASK_NAME carries 4 bytes of a task
+ * 			name in word 0, the task as context and the byte offset / 4 as
+ * 			argument. The drain sends both every KTRACE_SYNC_PERIOD_MS, so a
+ * 			host can join a running stream.
+ *
+ * 			Writers take the timestamp and claim a slot with the same
+ * 			LDREX/STREX pair. An exception in between makes the STREX fail,
+ * 			so slots are in timestamp order whoever preempts whom. Word 1,
+ * 			never 0 for a real event, is written last and commits the slot.
+ * 			No lock is taken and interrupts are never masked.
+ *
+ * 			In stream mode a writer drops the event, and counts it, when the
+ * 			drain has not caught up. In snapshot mode the ring keeps the last
+ * 			KTRACE_RING_EVENTS events until ktrace_stop(), then the drain
+ * 			sends them once.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "uart.h"
+#include "ktrace.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define KTRACE_RING_MASK		(KTRACE_RING_EVENTS - 1U)
+#define KTRACE_MAGIC			0x4352544BUL	/* "KTRC" */
+#define KTRACE_VERSION			1U
+#define KTRACE_CONTEXT_OFS		8U
+#define KTRACE_ARG_OFS			16U
+#define KTRACE_CONTEXT_ISR		0x80U
+#define KTRACE_TASK_MAX			0x7FU			/* Larger numbers are clamped. */
+#define KTRACE_NAME_WORDS		((configMAX_TASK_NAME_LEN + 3U) / 4U)
+#define KTRACE_STAGING_EVENTS	16U				/* Events handed to the UART at once. */
+#define KTRACE_STACK_SIZE		128U
+
+#if ((KTRACE_RING_EVENTS & KTRACE_RING_MASK) != 0U)
+#error KTRACE_RING_EVENTS must be a power of two
+#endif
+
+#if (KTRACE_MAX_TASKS > KTRACE_TASK_MAX)
+#error KTRACE_MAX_TASKS must not exceed 127
+#endif
+
+#if (configUSE_TRACE_FACILITY != 1)
+#error ktrace.c needs configUSE_TRACE_FACILITY set to 1
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulTime;
+	uint32_t ulInfo;		/* 0 while the slot is being written. */
+} KtraceEvent_t;
+
+/* Variables -----------------------------------------------------------------*/
+static volatile KtraceEvent_t xKtraceRing[KTRACE_RING_EVENTS];
+static volatile uint32_t ulKtraceHead = 0;		/* Free-running, writers. */
+static volatile uint32_t ulKtraceTail = 0;		/* Free-running, drain task. */
+static volatile uint32_t ulKtraceRunning = 0;
+static volatile uint32_t ulKtraceDropped = 0;
+static volatile uint32_t ulKtraceCurrentTask = 0;
+static uint32_t ulKtraceDroppedReported = 0;
+static uint32_t ulKtraceDumped = 0;
+static TickType_t xKtraceLastSync = 0;
+static uint32_t ulKtraceNames[KTRACE_MAX_TASKS + 1U][KTRACE_NAME_WORDS];
+static volatile uint32_t ulKtraceTasks = 0;		/* Highest named task number. */
+static KtraceEvent_t xKtraceStaging[KTRACE_STAGING_EVENTS];
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t ktrace_context(void);
+static void ktrace_write(uint32_t ulContext, uint32_t ulEvent, uint32_t ulArg);
+static void ktrace_count_drop(void);
+static uint32_t ktrace_stage(uint32_t ulStaged, uint32_t ulTime, uint32_t ulInfo, uint32_t *pulBytes);
+static uint32_t ktrace_sync(void);
+static uint32_t ktrace_send(uint32_t ulEvents);
+static void ktrace_drain_task(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Starts the cycle counter used for timestamps, starts recording and
+ * creates the drain task.
+ * @param None
+ * @retval 0 if successful, -1 otherwise.
+ * @note Call before creating the tasks and queues to trace. With
+ * KTRACE_EXPORT_UART, USART2 TX must be initialized first.
+ */
+int32_t ktrace_init(void)
+{
+	/* Enable the trace and debug blocks, DWT (and ITM) included. */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	ktrace_start();
+
+	if (xTaskCreate(ktrace_drain_task, "ktrace", KTRACE_STACK_SIZE, NULL,
+			KTRACE_DRAIN_PRIORITY, NULL) != pdPASS)
+	{
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Empties the ring and (re)starts recording.
+ * @param None
+ * @retval None
+ * @note From a task. In snapshot mode, this re-arms the recorder after a dump.
+ */
+void ktrace_start(void)
+{
+	uint32_t i;
+
+	ulKtraceRunning = 0;
+	__DMB();
+
+	for (i = 0; i < KTRACE_RING_EVENTS; i++)
+	{
+		xKtraceRing[i].ulInfo = 0;
+	}
+
+	ulKtraceHead = 0;
+	ulKtraceTail = 0;
+	ulKtraceDumped = 0;
+	__DMB();
+	ulKtraceRunning = 1;
+}
+
+/**
+ * @brief Stops recording. In snapshot mode, the drain task then sends the
+ * ring once.
+ * @param None
+ * @retval None
+ * @note Safe from tasks and from interrupts of any priority, e.g. from a fault
+ * or assert handler to keep the events that led there.
+ */
+void ktrace_stop(void)
+{
+	ulKtraceRunning = 0;
+}
+
+/**
+ * @brief Sends the recorded events (normally called by the drain task).
+ * @param None
+ * @retval Number of bytes sent.
+ * @note Stream mode sends at most KTRACE_FLUSH_EVENTS committed events per call.
+ * Snapshot mode sends nothing until ktrace_stop(), then the whole ring once.
+ * Only one caller at a time.
+ */
+uint32_t ktrace_flush(void)
+{
+	uint32_t ulBytes = 0;
+	uint32_t ulStaged = 0;
+	uint32_t ulTail;
+	uint32_t ulHead;
+	uint32_t ulInfo;
+	uint32_t ulDropped;
+	uint32_t ulCount = 0;
+
+#if (KTRACE_MODE == KTRACE_MODE_SNAPSHOT)
+	if ((ulKtraceRunning != 0U) || (ulKtraceDumped != 0U))
+	{
+		return 0;
+	}
+
+	ulBytes += ktrace_sync();
+
+	/* Oldest slot first. Slots never written, or claimed by a writer that was
+	 * mid-event when recording stopped, read 0 and are skipped. */
+	ulHead = ulKtraceHead;
+
+	for (ulTail = ulHead; ulCount < KTRACE_RING_EVENTS; ulTail++, ulCount++)
+	{
+		ulInfo = xKtraceRing[ulTail & KTRACE_RING_MASK].ulInfo;
+
+		if (ulInfo != 0U)
+		{
+			__DMB();
+			ulStaged = ktrace_stage(ulStaged, xKtraceRing[ulTail & KTRACE_RING_MASK].ulTime,
+					ulInfo, &ulBytes);
+		}
+	}
+
+	ulKtraceDumped = 1;
+#else
+	if ((xKtraceLastSync == 0U)
+			|| ((xTaskGetTickCount() - xKtraceLastSync) >= pdMS_TO_TICKS(KTRACE_SYNC_PERIOD_MS)))
+	{
+		/* Never 0 once set, so the first call always sends one. */
+		xKtraceLastSync = xTaskGetTickCount() | 1U;
+		ulBytes += ktrace_sync();
+	}
+
+	ulTail = ulKtraceTail;
+	ulHead = ulKtraceHead;
+
+	while ((ulTail != ulHead) && (ulCount < KTRACE_FLUSH_EVENTS))
+	{
+		ulInfo = xKtraceRing[ulTail & KTRACE_RING_MASK].ulInfo;
+
+		if (ulInfo == 0U)
+		{
+			/* Claimed, not yet committed. */
+			break;
+		}
+
+		/* Read the timestamp only after seeing the commit. */
+		__DMB();
+		ulStaged = ktrace_stage(ulStaged, xKtraceRing[ulTail & KTRACE_RING_MASK].ulTime,
+				ulInfo, &ulBytes);
+		xKtraceRing[ulTail & KTRACE_RING_MASK].ulInfo = 0;
+		ulTail++;
+		ulCount++;
+
+		/* The slot must read as free before the space is released. */
+		__DMB();
+		ulKtraceTail = ulTail;
+	}
+#endif
+
+	ulDropped = ulKtraceDropped;
+
+	if (ulDropped != ulKtraceDroppedReported)
+	{
+		ulStaged = ktrace_stage(ulStaged, DWT->CYCCNT, KTRACE_EV_DROPPED
+				| (((ulDropped - ulKtraceDroppedReported) & 0xFFFFU) << KTRACE_ARG_OFS),
+				&ulBytes);
+		ulKtraceDroppedReported = ulDropped;
+	}
+
+	ulBytes += ktrace_send(ulStaged);
+
+	return ulBytes;
+}
+
+/**
+ * @brief Returns the number of events dropped because the ring was full.
+ * @param None
+ * @retval Dropped events since start-up (stream mode only).
+ */
+uint32_t ktrace_get_dropped(void)
+{
+	return ulKtraceDropped;
+}
+
+/**
+ * @brief Records the entry of the current interrupt handler.
+ * @param None
+ * @retval None
+ * @note The kernel has no ISR hooks; call this first in a handler to see it on
+ * the host, and ktrace_isr_exit() last.
+ */
+void ktrace_isr_enter(void)
+{
+	ktrace_write(ktrace_context(), KTRACE_EV_ISR_ENTER, __get_IPSR());
+}
+
+/**
+ * @brief Records the exit of the current interrupt handler.
+ * @param None
+ * @retval None
+ */
+void ktrace_isr_exit(void)
+{
+	ktrace_write(ktrace_context(), KTRACE_EV_ISR_EXIT, __get_IPSR());
+}
+
+/**
+ * @brief Records an application marker.
+ * @param ulId Marker ID shown on the host, 16 bits.
+ * @retval None
+ * @note Safe from tasks and from interrupts of any priority.
+ */
+void ktrace_mark(uint32_t ulId)
+{
+	ktrace_write(ktrace_context(), KTRACE_EV_MARK, ulId);
+}
+
+/**
+ * @brief Records a kernel event in the current context.
+ * @param ulEvent Event ID.
+ * @param ulArg Argument, truncated to 16 bits.
+ * @retval None
+ */
+void ktrace_event(uint32_t ulEvent, uint32_t ulArg)
+{
+	ktrace_write(ktrace_context(), ulEvent, ulArg);
+}
+
+/**
+ * @brief Records a kernel event on a queue, semaphore or mutex.
+ * @param ulEvent Event ID.
+ * @param pvObject The object; its ID is its address / 4 (16 bits).
+ * @retval None
+ */
+void ktrace_object(uint32_t ulEvent, const void *pvObject)
+{
+	ktrace_write(ktrace_context(), ulEvent, (uint32_t)pvObject >> 2);
+}
+
+/**
+ * @brief Records a task creation and keeps the task's name for the host.
+ * @param ulTask Number of the new task.
+ * @param ulPriority Its priority.
+ * @param pcName Its name.
+ * @retval None
+ * @note Called in a critical section (traceTASK_CREATE()).
+ */
+void ktrace_task_create(uint32_t ulTask, uint32_t ulPriority, const char *pcName)
+{
+	if ((ulTask != 0U) && (ulTask <= KTRACE_MAX_TASKS))
+	{
+		(void)strncpy((char *)ulKtraceNames[ulTask], pcName, sizeof(ulKtraceNames[ulTask]));
+
+		if (ulTask > ulKtraceTasks)
+		{
+			ulKtraceTasks = ulTask;
+		}
+	}
+
+	ktrace_write(ktrace_context(), KTRACE_EV_TASK_CREATE,
+			((ulTask > KTRACE_TASK_MAX) ? KTRACE_TASK_MAX : ulTask) | (ulPriority << 8));
+}
+
+/**
+ * @brief Records a context switch.
+ * @param ulTask Number of the task now running.
+ * @param ulPriority Its priority.
+ * @retval None
+ * @note Called from PendSV (traceTASK_SWITCHED_IN()); the event is attributed
+ * to the incoming task.
+ */
+void ktrace_task_switched_in(uint32_t ulTask, uint32_t ulPriority)
+{
+	if (ulTask > KTRACE_TASK_MAX)
+	{
+		ulTask = KTRACE_TASK_MAX;
+	}
+
+	ulKtraceCurrentTask = ulTask;
+	ktrace_write(ulTask, KTRACE_EV_TASK_SWITCHED_IN, ulPriority);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Returns the context field of an event recorded now.
+ * @param None
+ * @retval 0x80 | exception number in a handler, the running task otherwise.
+ */
+static uint32_t ktrace_context(void)
+{
+	uint32_t ulIpsr = __get_IPSR();
+
+	if (ulIpsr != 0U)
+	{
+		return KTRACE_CONTEXT_ISR | (ulIpsr & 0x7FU);
+	}
+
+	return ulKtraceCurrentTask;
+}
+
+/**
+ * @brief Claims a slot, timestamps it and commits the event.
+ * @param ulContext Context field.
+ * @param ulEvent Event ID.
+ * @param ulArg Argument, truncated to 16 bits.
+ * @retval None
+ */
+static void ktrace_write(uint32_t ulContext, uint32_t ulEvent, uint32_t ulArg)
+{
+	volatile KtraceEvent_t *pxEvent;
+	uint32_t ulHead;
+	uint32_t ulTime;
+
+	if (ulKtraceRunning == 0U)
+	{
+		return;
+	}
+
+	do
+	{
+		ulHead = __LDREXW(&ulKtraceHead);
+
+#if (KTRACE_MODE == KTRACE_MODE_STREAM)
+		if ((ulHead - ulKtraceTail) >= KTRACE_RING_EVENTS)
+		{
+			__CLREX();
+			ktrace_count_drop();
+			return;
+		}
+#endif
+
+		/* Read inside the exclusive pair: a later slot never has an earlier
+		 * timestamp. */
+		ulTime = DWT->CYCCNT;
+	} while (__STREXW(ulHead + 1U, &ulKtraceHead) != 0U);
+
+	pxEvent = &xKtraceRing[ulHead & KTRACE_RING_MASK];
+
+#if (KTRACE_MODE == KTRACE_MODE_SNAPSHOT)
+	/* The slot holds an event from the previous lap: uncommit it first. */
+	pxEvent->ulInfo = 0;
+	__DMB();
+#endif
+
+	pxEvent->ulTime = ulTime;
+
+	/* Publish: the timestamp must be visible before the commit. */
+	__DMB();
+	pxEvent->ulInfo = ulEvent | (ulContext << KTRACE_CONTEXT_OFS)
+			| ((ulArg & 0xFFFFU) << KTRACE_ARG_OFS);
+}
+
+/**
+ * @brief Increments the dropped event count, from any context.
+ * @param None
+ * @retval None
+ */
+static void ktrace_count_drop(void)
+{
+	uint32_t ulDropped;
+
+	do
+	{
+		ulDropped = __LDREXW(&ulKtraceDropped);
+	} while (__STREXW(ulDropped + 1U, &ulKtraceDropped) != 0U);
+}
+
+/**
+ * @brief Appends a record to the staging buffer, sending it when full.
+ * @param ulStaged Records already staged.
+ * @param ulTime Word 0.
+ * @param ulInfo Word 1.
+ * @param pulBytes Incremented by the number of bytes sent.
+ * @retval Records staged now.
+ */
+static uint32_t ktrace_stage(uint32_t ulStaged, uint32_t ulTime, uint32_t ulInfo, uint32_t *pulBytes)
+{
+	if (ulStaged == KTRACE_STAGING_EVENTS)
+	{
+		*pulBytes += ktrace_send(ulStaged);
+		ulStaged = 0;
+	}
+
+	xKtraceStaging[ulStaged].ulTime = ulTime;
+	xKtraceStaging[ulStaged].ulInfo = ulInfo;
+
+	return ulStaged + 1U;
+}
+
+/**
+ * @brief Sends a sync record followed by the name of every task seen so far.
+ * @param None
+ * @retval Number of bytes sent.
+ */
+static uint32_t ktrace_sync(void)
+{
+	uint32_t ulBytes = 0;
+	uint32_t ulStaged = 0;
+	uint32_t ulTask;
+	uint32_t i;
+
+	ulStaged = ktrace_stage(ulStaged, KTRACE_MAGIC, KTRACE_EV_SYNC
+			| (KTRACE_VERSION << KTRACE_CONTEXT_OFS)
+			| ((SystemCoreClock / 1000000U) << KTRACE_ARG_OFS), &ulBytes);
+
+	for (ulTask = 1; ulTask <= ulKtraceTasks; ulTask++)
+	{
+		for (i = 0; (i < KTRACE_NAME_WORDS) && (ulKtraceNames[ulTask][i] != 0U); i++)
+		{
+			ulStaged = ktrace_stage(ulStaged, ulKtraceNames[ulTask][i], KTRACE_EV_TASK_NAME
+					| (ulTask << KTRACE_CONTEXT_OFS) | (i << KTRACE_ARG_OFS), &ulBytes);
+		}
+	}
+
+	return ulBytes + ktrace_send(ulStaged);
+}
+
+/**
+ * @brief Sends the staged records.
+ * @param ulEvents Number of staged records.
+ * @retval Number of bytes sent.
+ */
+static uint32_t ktrace_send(uint32_t ulEvents)
+{
+	uint32_t ulWords = ulEvents * 2U;
+#if (KTRACE_EXPORT == KTRACE_EXPORT_ITM)
+	const uint32_t *pulWords = (const uint32_t *)xKtraceStaging;
+	uint32_t i;
+#endif
+
+	if (ulWords == 0U)
+	{
+		return 0;
+	}
+
+#if (KTRACE_EXPORT == KTRACE_EXPORT_ITM)
+	/* Without a debugger enabling the port, the records are discarded. */
+	if (((ITM->TCR & ITM_TCR_ITMENA_Msk) == 0U) || ((ITM->TER & (1UL << KTRACE_ITM_PORT)) == 0U))
+	{
+		return 0;
+	}
+
+	for (i = 0; i < ulWords; i++)
+	{
+		while (ITM->PORT[KTRACE_ITM_PORT].u32 == 0UL)
+		{
+			/* Stimulus FIFO full. */
+		}
+
+		ITM->PORT[KTRACE_ITM_PORT].u32 = pulWords[i];
+	}
+
+	return ulWords * sizeof(uint32_t);
+#else
+	/* Little-endian core: the words go out byte by byte in wire order. */
+	return (uint32_t)USART2_write_buffer((const char *)xKtraceStaging,
+			(int)(ulWords * sizeof(uint32_t)));
+#endif
+}
+
+/**
+ * @brief Periodically drains the ring.
+ * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
+ * task function signature.
+ * @retval None
+ */
+static void ktrace_drain_task(void *pvParameters)
+{
+	while (1)
+	{
+		(void)ktrace_flush();
+		vTaskDelay(pdMS_TO_TICKS(KTRACE_DRAIN_PERIOD_MS));
+	}
+}
@@ -17,12 +17,51 @@
  *       	When time slicing is enabled, tasks with the same highest priority
  *       	will share CPU time and run in a round-robin manner.
  *
+ *       	Each task runs for its own quantum per turn. The Red task is given
+ *       	10 ticks with 'vTaskSetTimeSlice()', so it is switched out a tenth
+ *       	as often and gets ten times the CPU time of the Green task, which
+ *       	keeps the default of 1 tick.
+ *
+ *       	Every context switch is recorded by ktrace.c and streamed to
+ *       	USART2. 'Tools/ktrace_convert.py' turns the capture into a trace
+ *       	that https://ui.perfetto.dev shows as a timeline.
+ *
+ *       	LD2 is lit while the Red task runs: each task drives it on every
+ *       	pass of its busy loop, the Red task on and the others off, so its
+ *       	brightness is the Red task's share of the CPU. The tasks write
+ *       	the same ODR without a critical section; a bit-band store
+ *       	(bitband.h) changes PA5 alone, so neither a task switch nor an
+ *       	interrupt in the middle can write back a stale copy of the other
+ *       	pins.
+ *
+ *       	The Sampler task keeps a window of the Red task's recent loop
+ *       	counts that the Reporter task, one priority above, reads. They
+ *       	share it without a mutex: with SAMPLER_THRESHOLD set, the Sampler
+ *       	task's preemption threshold is the Reporter task's priority, so
+ *       	the Reporter task never runs in the middle of an update
+ *       	(ulTornReads stays 0) and is switched in once the update is done
+ *       	instead of twice. The ktrace drain task, above the threshold,
+ *       	still preempts either.
+ *
  ******************************************************************************/
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
+#include "uart.h"
+#include "bitband.h"
+#include "ktrace.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define LD2_BIT 5U				/* LD2_Pin is GPIO_PIN_5. */
+#define SAMPLER_THRESHOLD 1		/* 0: the Reporter task may preempt an update of the window */
+#define SAMPLER_PRIORITY 3
+#define REPORTER_PRIORITY 4
+#define SAMPLER_PERIOD_MS 2U
+#define REPORTER_PERIOD_MS 3U
+#define WINDOW_SIZE 32U			/* Red task loop counts kept. */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
@@ -32,15 +71,29 @@ void vOrangeLedControllerTask(void *pvParameters);
 void vRedLedControllerTask(void *pvParameters);
 void vGreenLedControllerTask(void *pvParameters);
 void vBlueLedControllerTask(void *pvParameters);
+void vSamplerTask(void *pvParameters);
+void vReporterTask(void *pvParameters);
 
 /* Data types ----------------------------------------------------------------*/
 typedef uint32_t TaskProfiler_t;
 
+/* Written by the Sampler task only. An update that the Reporter task has
+ * read half of leaves ulSeqBegin and ulSeqEnd different. */
+typedef struct
+{
+	uint32_t ulSeqBegin;
+	TaskProfiler_t xRed[WINDOW_SIZE];	/* Newest first. */
+	uint32_t ulSeqEnd;
+} RedWindow_t;
+
 /* Variables -----------------------------------------------------------------*/
 TaskProfiler_t Orange_TaskProfiler;
 TaskProfiler_t Red_TaskProfiler;
 TaskProfiler_t Green_TaskProfiler;
 TaskProfiler_t Blue_TaskProfiler;
+volatile RedWindow_t xRedWindow;
+volatile uint32_t ulRedRate;		/* Red task loops over the window, as last read. */
+volatile uint32_t ulTornReads;		/* Reads that overlapped an update. */
 
 /**
  * @brief The application entry point.
@@ -48,6 +101,9 @@ TaskProfiler_t Blue_TaskProfiler;
  */
 int main(void)
 {
+	TaskHandle_t xRedTask;
+	TaskHandle_t xSamplerTask;
+
 	HAL_Init();
 
 	/* Configure the system clock */
@@ -55,6 +111,13 @@ int main(void)
 
 	/* Initialize all configured peripherals */
 	MX_GPIO_Init();
+	USART2_UART_TX_Init();
+
+	/* Context switches are streamed to USART2; see README, Kernel Trace. */
+	if (ktrace_init() != 0)
+	{
+		Error_Handler();
+	}
 
 	/* Create tasks. */
 	xTaskCreate(
@@ -71,7 +134,7 @@ int main(void)
 			100,
 			NULL,
 			2,
-			NULL);
+			&xRedTask);
 
 	xTaskCreate(
 			vGreenLedControllerTask,
@@ -89,6 +152,32 @@ int main(void)
 			1,
 			NULL);
 
+	xTaskCreate(
+			vSamplerTask,
+			"vSamplerTask",
+			100,
+			NULL,
+			SAMPLER_PRIORITY,
+			&xSamplerTask);
+
+	xTaskCreate(
+			vReporterTask,
+			"vReporterTask",
+			100,
+			NULL,
+			REPORTER_PRIORITY,
+			NULL);
+
+	/* A compute-heavy task: rotate it out every 10 ticks instead of every
+	 * tick. */
+	vTaskSetTimeSlice(xRedTask, pdMS_TO_TICKS(10));
+
+#if (SAMPLER_THRESHOLD == 1)
+	/* In place of a mutex around the window: the Reporter task waits for an
+	 * update to end. */
+	vTaskPreemptionThresholdSet(xSamplerTask, REPORTER_PRIORITY);
+#endif
+
 	vTaskStartScheduler();
 
 	/* Infinite loop */
@@ -105,7 +194,7 @@ void vOrangeLedControllerTask(void *pvParameters)
 		Orange_TaskProfiler++;
 		for (int i = 0; i < 1000000; i++)
 		{
-			/* Do nothing. */
+			bitband_periph_clear(&LD2_GPIO_Port->ODR, LD2_BIT);
 		}
 	}
 }
@@ -117,7 +206,7 @@ void vRedLedControllerTask(void *pvParameters)
 		Red_TaskProfiler++;
 		for (int i = 0; i < 1000000; i++)
 		{
-			/* Do nothing. */
+			bitband_periph_set(&LD2_GPIO_Port->ODR, LD2_BIT);
 		}
 	}
 }
@@ -129,7 +218,7 @@ void vGreenLedControllerTask(void *pvParameters)
 		Green_TaskProfiler++;
 		for (int i = 0; i < 1000000; i++)
 		{
-			/* Do nothing. */
+			bitband_periph_clear(&LD2_GPIO_Port->ODR, LD2_BIT);
 		}
 	}
 }
@@ -141,55 +230,65 @@ void vBlueLedControllerTask(void *pvParameters)
 		Blue_TaskProfiler++;
 		for (int i = 0; i < 1000000; i++)
 		{
-			/* Do nothing. */
+			bitband_periph_clear(&LD2_GPIO_Port->ODR, LD2_BIT);
 		}
 	}
 }
 
-/**
- * @brief System Clock Configuration
- * @retval None
- */
-void SystemClock_Config(void)
+void vSamplerTask(void *pvParameters)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
+	TickType_t xLastWake = xTaskGetTickCount();
+	uint32_t i;
 
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+	while (1)
 	{
-		Error_Handler();
+		vTaskDelayUntil(&xLastWake, pdMS_TO_TICKS(SAMPLER_PERIOD_MS));
+
+		xRedWindow.ulSeqBegin++;
+		for (i = WINDOW_SIZE - 1U; i > 0U; i--)
+		{
+			xRedWindow.xRed[i] = xRedWindow.xRed[i - 1U];
+		}
+		xRedWindow.xRed[0] = Red_TaskProfiler;
+		xRedWindow.ulSeqEnd = xRedWindow.ulSeqBegin;
 	}
+}
+
+void vReporterTask(void *pvParameters)
+{
+	TickType_t xLastWake = xTaskGetTickCount();
+	uint32_t ulSeq;
+	uint32_t ulRate;
+
+	while (1)
+	{
+		vTaskDelayUntil(&xLastWake, pdMS_TO_TICKS(REPORTER_PERIOD_MS));
 
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+		/* The Sampler task cannot run in the middle of this read, being of a
+		 * lower priority. */
+		ulSeq = xRedWindow.ulSeqEnd;
+		ulRate = xRedWindow.xRed[0] - xRedWindow.xRed[WINDOW_SIZE - 1U];
 
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+		if (xRedWindow.ulSeqBegin != ulSeq)
+		{
+			ulTornReads++;
+		}
+		else
+		{
+			ulRedRate = ulRate;
+		}
+	}
+}
+
+/**
+ * @brief System Clock Configuration
+ * @retval None
+ */
+void SystemClock_Config(void)
+{
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
@@ -84,6 +84,23 @@
 #define configUSE_OS2_MUTEX                   configUSE_MUTEXES
 #endif
 
+/*
+  Option to honour msg_prio in CMSIS-RTOS2 Message Queue functions: osMessageQueueGet
+  returns the oldest message of the highest priority. When disabled, message queues
+  map onto FreeRTOS queues and msg_prio is ignored.
+*/
+#ifndef configUSE_OS2_MESSAGE_PRIORITY
+#define configUSE_OS2_MESSAGE_PRIORITY        1
+#endif
+
+/*
+  Number of message priority buckets, a power of two from 1 to 32. msg_prio values
+  0 to 255 are spread evenly over them; messages within a bucket are kept in order.
+*/
+#ifndef configOS2_MESSAGE_PRIORITY_LEVELS
+#define configOS2_MESSAGE_PRIORITY_LEVELS     32
+#endif
+
 
 /*
   CMSIS-RTOS2 FreeRTOS configuration check (FreeRTOSConfig.h).
@@ -266,6 +283,18 @@
   #endif
 #endif
 
+#if (configUSE_OS2_MESSAGE_PRIORITY == 1)
+  #if ((configOS2_MESSAGE_PRIORITY_LEVELS < 1) || (configOS2_MESSAGE_PRIORITY_LEVELS > 32) || \
+       ((configOS2_MESSAGE_PRIORITY_LEVELS & (configOS2_MESSAGE_PRIORITY_LEVELS - 1)) != 0))
+    /*
+      CMSIS-RTOS2 Message Queue functions find the highest priority message with one CLZ
+      on a 32-bit bitmap of the non-empty priority buckets.
+      Set #define configOS2_MESSAGE_PRIORITY_LEVELS to a power of two from 1 to 32.
+    */
+    #error "Definition configOS2_MESSAGE_PRIORITY_LEVELS must be a power of two from 1 to 32."
+  #endif
+#endif
+
 #if (configUSE_TRACE_FACILITY == 0)
   /*
     CMSIS-RTOS2 function osThreadEnumerate requires FreeRTOS function uxTaskGetSystemState
@@ -290,21 +319,19 @@
   #error "Definition configUSE_16_BIT_TICKS must be zero to implement CMSIS-RTOS2 API."
 #endif
 
-#if (configMAX_PRIORITIES != 56)
+#if (configMAX_PRIORITIES == 32) && (configUSE_PORT_OPTIMISED_TASK_SELECTION == 1)
+  /*
+    32-priority profile: only osPriorityIdle..osPriorityNormal7 exist. osThreadNew and
+    osThreadSetPriority reject osPriorityAboveNormal and higher.
+  */
+#elif (configMAX_PRIORITIES != 56)
   /*
     CMSIS-RTOS2 defines 56 different priorities (see osPriority_t) and portable CMSIS-RTOS2
-    implementation should implement the same number of priorities.
+    implementation should implement the same number of priorities. The port optimised
+    selection handles them with a two-level ready bitmap (tasks.c).
     Set #define configMAX_PRIORITIES 56 to fix this error.
   */
   #error "Definition configMAX_PRIORITIES must equal 56 to implement Thread Management API."
 #endif
-#if (configUSE_PORT_OPTIMISED_TASK_SELECTION != 0)
-  /*
-    CMSIS-RTOS2 requires handling of 56 different priorities (see osPriority_t) while FreeRTOS port
-    optimised selection for Cortex core only handles 32 different priorities.
-    Set #define configUSE_PORT_OPTIMISED_TASK_SELECTION 0 to fix this error.
-  */
-  #error "Definition configUSE_PORT_OPTIMISED_TASK_SELECTION must be zero to implement Thread Management API."
-#endif
 
 #endif /* FREERTOS_OS2_H_ */
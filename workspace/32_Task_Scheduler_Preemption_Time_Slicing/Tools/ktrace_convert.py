@@ -0,0 +1,357 @@
+#!/usr/bin/env python3
+"""Converts the event stream written by ktrace.c into a Perfetto trace.
+
+The output is the Chrome JSON trace format, which https://ui.perfetto.dev and
+chrome://tracing open directly. The "CPU" track shows which task or handler
+was running; each task also gets its own track, with its kernel events
+(queue operations, notifications, delays, readiness) as instant events.
+
+Usage:
+    ktrace_convert.py /dev/ttyACM0 --seconds 10 -o trace.json
+    ktrace_convert.py capture.bin -o trace.json
+    ktrace_convert.py swo.bin --itm 1 -o trace.json
+    ktrace_convert.py capture.bin --text
+
+A serial port is opened with pyserial when it is installed; otherwise set it
+up beforehand (e.g. 'stty -F /dev/ttyACM0 115200 raw') and pass its path.
+With --itm, the input is a raw SWO capture and the records are taken from
+that ITM stimulus port.
+"""
+
+import argparse
+import json
+import struct
+import sys
+import time
+
+MAGIC = 0x4352544B
+VERSION = 1
+SRAM_BASE = 0x20000000
+
+EV_SYNC = 0x01
+EV_DROPPED = 0x02
+EV_TASK_NAME = 0x03
+EV_TASK_CREATE = 0x10
+EV_TASK_DELETE = 0x11
+EV_TASK_SWITCHED_IN = 0x12
+EV_TASK_READY = 0x13
+EV_TASK_DELAY = 0x14
+EV_TASK_DELAY_UNTIL = 0x15
+EV_TASK_NOTIFY = 0x16
+EV_TASK_NOTIFY_WAIT = 0x17
+EV_TICK = 0x18
+EV_QUEUE_CREATE = 0x20
+EV_QUEUE_SEND = 0x28
+EV_QUEUE_SEND_FAILED = 0x29
+EV_QUEUE_RECEIVE = 0x2A
+EV_QUEUE_RECEIVE_FAILED = 0x2B
+EV_QUEUE_BLOCK_SEND = 0x2C
+EV_QUEUE_BLOCK_RECEIVE = 0x2D
+EV_ISR_ENTER = 0x30
+EV_ISR_EXIT = 0x31
+EV_MARK = 0x40
+
+QUEUE_TYPES = ["queue", "mutex", "counting semaphore", "binary semaphore",
+               "recursive mutex"]
+
+QUEUE_EVENTS = {
+    EV_QUEUE_SEND: "send",
+    EV_QUEUE_SEND_FAILED: "send failed",
+    EV_QUEUE_RECEIVE: "receive",
+    EV_QUEUE_RECEIVE_FAILED: "receive failed",
+    EV_QUEUE_BLOCK_SEND: "block on send",
+    EV_QUEUE_BLOCK_RECEIVE: "block on receive",
+}
+
+EXCEPTIONS = {2: "NMI", 3: "HardFault", 11: "SVCall", 14: "PendSV",
+              15: "SysTick"}
+
+KNOWN = {EV_SYNC, EV_DROPPED, EV_TASK_NAME, EV_TASK_CREATE, EV_TASK_DELETE,
+         EV_TASK_SWITCHED_IN, EV_TASK_READY, EV_TASK_DELAY,
+         EV_TASK_DELAY_UNTIL, EV_TASK_NOTIFY, EV_TASK_NOTIFY_WAIT, EV_TICK,
+         EV_ISR_ENTER, EV_ISR_EXIT, EV_MARK} | set(QUEUE_EVENTS) | set(
+             range(EV_QUEUE_CREATE, EV_QUEUE_CREATE + len(QUEUE_TYPES)))
+
+MAIN_TID = 999      # Events before the scheduler starts (track 0 is the CPU).
+ISR_TID = 1000      # Track of exception n is ISR_TID + n.
+
+
+def itm_payload(stream, port):
+    """Yields the bytes written to one ITM stimulus port in a SWO capture."""
+    while True:
+        header = stream.read(1)
+        if not header:
+            return
+        header = header[0]
+        size = (0, 1, 2, 4)[header & 3]
+        if size:
+            # Source packet: software (bit 2 clear) or hardware.
+            payload = stream.read(size)
+            if not (header & 4) and (header >> 3) == port:
+                yield payload
+        elif header & 0x80 and header & 0x0F == 0:
+            # Local timestamp with continuation bytes.
+            while True:
+                byte = stream.read(1)
+                if not byte or not byte[0] & 0x80:
+                    break
+        # Sync (0x00 ... 0x80) and overflow (0x70) packets carry no data.
+
+
+class Reader:
+    """Turns a byte stream into records, resynchronizing on sync records."""
+
+    def __init__(self, stream, port=None):
+        self.stream = stream
+        self.itm = itm_payload(stream, port) if port is not None else None
+
+    def read(self, size):
+        if self.itm is None:
+            return self.stream.read(size)
+        return next(self.itm, b"")
+
+    def records(self):
+        buffer = b""
+        synced = False
+        magic = struct.pack("<I", MAGIC)
+        while True:
+            chunk = self.read(256)
+            if not chunk:
+                return
+            buffer += chunk
+            while len(buffer) >= 8:
+                if not synced:
+                    start = buffer.find(magic)
+                    if start < 0:
+                        buffer = buffer[-3:]
+                        break
+                    buffer = buffer[start:]
+                    if len(buffer) < 8:
+                        break
+                word0, word1 = struct.unpack_from("<II", buffer)
+                event = word1 & 0xFF
+                if word0 == MAGIC and event == EV_SYNC:
+                    synced = True
+                elif event not in KNOWN:
+                    # Lost bytes: look for the next sync record.
+                    synced = False
+                    buffer = buffer[1:]
+                    continue
+                if synced:
+                    yield word0, word1
+                buffer = buffer[8:]
+
+
+def open_input(path, baudrate):
+    if path == "-":
+        return sys.stdin.buffer
+    try:
+        import serial
+        if path.startswith(("/dev/", "COM")):
+            return serial.Serial(path, baudrate)
+    except ImportError:
+        pass
+    return open(path, "rb")
+
+
+class Converter:
+    """Builds trace events from records; timestamps in microseconds."""
+
+    def __init__(self, cpu_hz):
+        self.cpu_hz = cpu_hz or 84e6
+        self.cpu_hz_forced = cpu_hz is not None
+        self.base = None
+        self.last = 0
+        self.cycles = 0
+        self.names = {}
+        self.priorities = {}
+        self.queues = {}
+        self.running = None     # (tid, name, start)
+        self.isr_stack = []     # What each nested handler interrupted.
+        self.events = []
+        self.lines = []
+
+    def task_name(self, task):
+        if task == 0:
+            return "main"
+        if task & 0x80:
+            exception = task & 0x7F
+            if exception >= 16:
+                return f"IRQ{exception - 16}"
+            return EXCEPTIONS.get(exception, f"Exception{exception}")
+        return self.names.get(task, f"Task {task}")
+
+    def tid(self, context):
+        if context & 0x80:
+            return ISR_TID + (context & 0x7F)
+        return context or MAIN_TID
+
+    def queue_name(self, object_id):
+        address = SRAM_BASE | (object_id << 2)
+        kind = self.queues.get(object_id, "queue")
+        return f"{kind} 0x{address:08x}"
+
+    def timestamp(self, cycles):
+        # CYCCNT wraps every 2^32 cycles. Records are in timestamp order,
+        # and the drain task runs often enough that no gap reaches a wrap.
+        if self.base is None:
+            self.base = cycles
+            self.cycles = 0
+        else:
+            self.cycles += (cycles - self.last) & 0xFFFFFFFF
+        self.last = cycles
+        return self.cycles * 1e6 / self.cpu_hz
+
+    def instant(self, ts, context, name, args=None, scope="t"):
+        event = {"ph": "i", "s": scope, "pid": 1, "tid": self.tid(context),
+                 "ts": ts, "name": name}
+        if args:
+            event["args"] = args
+        self.events.append(event)
+        self.lines.append(f"[{ts / 1e6:12.6f}] {self.task_name(context)}: "
+                          f"{name}{' ' + str(args) if args else ''}")
+
+    def run(self, ts, tid, name):
+        """Closes the slice on the CPU track and opens the next one."""
+        if self.running is not None:
+            prev_tid, prev_name, start = self.running
+            for track in (0, prev_tid):
+                self.events.append({"ph": "X", "pid": 1, "tid": track,
+                                    "ts": start, "dur": ts - start,
+                                    "name": prev_name})
+        self.running = (tid, name, ts)
+
+    def record(self, word0, word1):
+        event = word1 & 0xFF
+        context = (word1 >> 8) & 0xFF
+        arg = word1 >> 16
+
+        if event == EV_SYNC:
+            if context != VERSION:
+                sys.exit(f"unsupported stream version {context}")
+            if arg and not self.cpu_hz_forced:
+                self.cpu_hz = arg * 1e6
+            return
+        if event == EV_TASK_NAME:
+            name = self.names.get(context, "") if arg else ""
+            self.names[context] = (name + word0.to_bytes(4, "little")
+                                   .split(b"\0")[0].decode(errors="replace"))
+            return
+
+        ts = self.timestamp(word0)
+
+        if event == EV_TASK_SWITCHED_IN:
+            self.priorities[context] = arg
+            self.run(ts, self.tid(context), self.task_name(context))
+            self.lines.append(f"[{ts / 1e6:12.6f}] switch to "
+                              f"{self.task_name(context)} (priority {arg})")
+        elif event == EV_ISR_ENTER:
+            self.isr_stack.append(self.running)
+            self.run(ts, self.tid(context), self.task_name(context))
+        elif event == EV_ISR_EXIT:
+            interrupted = self.isr_stack.pop() if self.isr_stack else None
+            if interrupted is not None:
+                self.run(ts, interrupted[0], interrupted[1])
+        elif event == EV_DROPPED:
+            self.instant(ts, 0, f"{arg} events dropped", scope="g")
+        elif event == EV_TASK_CREATE:
+            task, priority = arg & 0xFF, arg >> 8
+            self.instant(ts, context, "create",
+                         {"task": self.task_name(task), "priority": priority})
+        elif event == EV_TASK_DELETE:
+            self.instant(ts, context, "delete", {"task": self.task_name(arg)})
+        elif event == EV_TASK_READY:
+            self.events.append({"ph": "i", "s": "t", "pid": 1,
+                                "tid": self.tid(arg), "ts": ts,
+                                "name": "ready",
+                                "args": {"by": self.task_name(context)}})
+        elif event == EV_TASK_DELAY:
+            self.instant(ts, context, "vTaskDelay", {"ticks": arg})
+        elif event == EV_TASK_DELAY_UNTIL:
+            self.instant(ts, context, "delay until", {"tick (low 16 bits)": arg})
+        elif event == EV_TASK_NOTIFY:
+            self.instant(ts, context, "notify", {"task": self.task_name(arg)})
+        elif event == EV_TASK_NOTIFY_WAIT:
+            self.instant(ts, context, "block on notification")
+        elif event == EV_TICK:
+            self.instant(ts, context, "tick", {"count (low 16 bits)": arg})
+        elif EV_QUEUE_CREATE <= event < EV_QUEUE_CREATE + len(QUEUE_TYPES):
+            self.queues[arg] = QUEUE_TYPES[event - EV_QUEUE_CREATE]
+            self.instant(ts, context, "create " + self.queue_name(arg))
+        elif event in QUEUE_EVENTS:
+            self.instant(ts, context, QUEUE_EVENTS[event],
+                         {"object": self.queue_name(arg)})
+        elif event == EV_MARK:
+            self.instant(ts, context, f"mark {arg}")
+
+    def metadata(self):
+        tracks = {0: "CPU"}
+        for event in self.events:
+            tid = event["tid"]
+            if tid and tid not in tracks:
+                context = 0x80 | (tid - ISR_TID) if tid >= ISR_TID else tid % MAIN_TID
+                name = self.task_name(context)
+                if tid in self.priorities:
+                    name += f" (priority {self.priorities[tid]})"
+                tracks[tid] = name
+        meta = [{"ph": "M", "pid": 1, "name": "process_name",
+                 "args": {"name": "STM32F446RE"}}]
+        for tid, name in tracks.items():
+            meta.append({"ph": "M", "pid": 1, "tid": tid, "name": "thread_name",
+                         "args": {"name": name}})
+            # CPU first, then tasks by priority, then handlers.
+            order = -1 if tid == 0 else (
+                tid if tid >= MAIN_TID else -self.priorities.get(tid, 0) * 256 + tid)
+            meta.append({"ph": "M", "pid": 1, "tid": tid,
+                         "name": "thread_sort_index", "args": {"sort_index": order}})
+        return meta
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="serial port, capture file, or - for stdin")
+    parser.add_argument("-o", "--output", default="trace.json",
+                        help="Perfetto / Chrome JSON trace to write")
+    parser.add_argument("--text", action="store_true",
+                        help="print the events instead of writing a trace")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--seconds", type=float, default=0,
+                        help="stop after this long (serial capture)")
+    parser.add_argument("--itm", type=int, metavar="PORT",
+                        help="input is a raw SWO capture; use this stimulus port")
+    parser.add_argument("--cpu-hz", type=float,
+                        help="core clock (default: from the sync records)")
+    options = parser.parse_args()
+
+    converter = Converter(options.cpu_hz)
+    reader = Reader(open_input(options.input, options.baudrate), options.itm)
+    deadline = time.monotonic() + options.seconds if options.seconds else None
+
+    try:
+        for word0, word1 in reader.records():
+            converter.record(word0, word1)
+            if options.text:
+                for line in converter.lines:
+                    print(line)
+                converter.lines.clear()
+            if deadline is not None and time.monotonic() >= deadline:
+                break
+    except KeyboardInterrupt:
+        pass
+
+    if options.text:
+        return
+
+    if converter.running is not None:
+        # Close the last slice at the last timestamp.
+        converter.run(converter.cycles * 1e6 / converter.cpu_hz, 0, "")
+
+    trace = {"traceEvents": converter.metadata() + converter.events,
+             "displayTimeUnit": "ns"}
+    with open(options.output, "w") as f:
+        json.dump(trace, f)
+    sys.stderr.write(f"{options.output}: {len(converter.events)} events\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -126,6 +126,7 @@ to exclude the API function. */
  * by the application thus the correct define need to be enabled below
  */
 #define USE_FreeRTOS_HEAP_4
+/* #define USE_FreeRTOS_HEAP_TLSF */	/* Instead of HEAP_4: heap_tlsf.c, O(1) malloc and free */
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -169,6 +170,36 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Port optimised task selection: the CM4F port finds the highest ready
+priority with CLZ on a ready-priority bitmap instead of walking the ready
+lists.  The 56 CMSIS-RTOS2 priorities take a two-level bitmap, so selection is
+two CLZs whatever the priorities in use (see README, Task Selection). */
+#undef configUSE_PORT_OPTIMISED_TASK_SELECTION
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
+/* Run-time stats on the DWT cycle counter, extended to 64 bits (runstats.c). */
+#define configGENERATE_RUN_TIME_STATS            1
+#define configRUN_TIME_COUNTER_TYPE              uint64_t
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  void runstats_timer_init(void);
+  uint64_t runstats_get_counter(void);
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() runstats_timer_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()         runstats_get_counter()
+/* Voluntary and involuntary context switches, counted per task in
+TaskStatus_t (see README, Switch Accounting). */
+#define configUSE_SWITCH_STATS                   1
+/* Critical section profiler (csprof.c): times each critical section and
+scheduler suspension on the DWT cycle counter, per call site (see README,
+Critical Section Profile). Remove this include to build without it. */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  #include "csprof.h"
+#endif
+/* The idle task sleeps the CPU until the next interrupt instead of spinning
+between ticks (see README, Idle Sleep). */
+#define configUSE_IDLE_SLEEP                     1
+/* Interrupts timed with irq_profile_start() are listed after the tasks in
+runstats_print() (see README, Interrupt Profile). */
+#define RUNSTATS_IRQ_PROFILE                     1
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ *
+ * @file	frame.h
+ * @brief	Interface of the COBS and SLIP framing with a CRC-32 trailer.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef FRAME_H
+#define FRAME_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macros --------------------------------------------------------------------*/
+#define FRAME_CRC_LEN 4U				/* crc.c CRC of the payload, LSB first. */
+
+#define FRAME_COBS_DELIMITER 0x00U
+#define FRAME_SLIP_END 0xC0U
+#define FRAME_SLIP_ESC 0xDBU
+#define FRAME_SLIP_ESC_END 0xDCU
+#define FRAME_SLIP_ESC_ESC 0xDDU
+
+/* Worst-case encoded size of a payload, delimiters included. */
+#define FRAME_COBS_MAX_ENCODED(len) ((len) + FRAME_CRC_LEN + (((len) + FRAME_CRC_LEN) / 254U) + 2U)
+#define FRAME_SLIP_MAX_ENCODED(len) ((2U * ((len) + FRAME_CRC_LEN)) + 2U)
+
+/* frame_rx_put() results other than a payload length. */
+#define FRAME_RX_MORE (-1)				/* No frame ended with this byte. */
+#define FRAME_RX_ERROR (-2)				/* A frame ended but was dropped. */
+
+/* Data types ----------------------------------------------------------------*/
+typedef enum
+{
+	FRAME_COBS = 0U,					/* Zero-free body, ended by 0x00. */
+	FRAME_SLIP = 1U						/* RFC 1055 escapes, ended by 0xC0. */
+} FrameMode_t;
+
+typedef struct
+{
+	uint32_t ulFrames;					/* Frames with a valid CRC. */
+	uint32_t ulCrcErrors;
+	uint32_t ulFramingErrors;			/* Bad COBS code or SLIP escape, or too short. */
+	uint32_t ulOverflows;				/* Longer than the receive buffer. */
+} FrameStats_t;
+
+/* Receiver state, owned by one task. */
+typedef struct
+{
+	uint8_t *pucBuf;					/* The payload is here once a frame ends. */
+	uint16_t usSize;
+	uint16_t usLen;
+	uint8_t ucMode;						/* FrameMode_t */
+	uint8_t ucEscape;					/* SLIP: the last byte was ESC. */
+	uint8_t ucDiscard;					/* Skip to the next delimiter. */
+	FrameStats_t xStats;
+} FrameRx_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t frame_encode(FrameMode_t xMode, const uint8_t *pucPayload, uint32_t ulLen,
+		uint8_t *pucOut, uint32_t ulSize);
+int32_t frame_rx_init(FrameRx_t *pxRx, FrameMode_t xMode, uint8_t *pucBuf, uint16_t usSize);
+int32_t frame_rx_put(FrameRx_t *pxRx, uint8_t ucByte);
+
+#endif /* FRAME_H */
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ *
+ * @file	irq.h
+ * @brief	Interface of the SRAM vector table and run-time interrupt binding.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef IRQ_H
+#define IRQ_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define IRQ_SYSTEM_VECTORS 16U				/* Initial SP and the core exceptions. */
+#define IRQ_DEVICE_VECTORS ((uint32_t)FMPI2C1_ER_IRQn + 1U)
+#define IRQ_VECTORS (IRQ_SYSTEM_VECTORS + IRQ_DEVICE_VECTORS)
+
+/* VTOR takes the table size rounded up to a power of two as its alignment. */
+#define IRQ_TABLE_ALIGN 512U
+
+/* Interrupts irq_profile_start() can time at once; 0 builds without the
+ * profiler. */
+#ifndef IRQ_PROFILE_SLOTS
+#define IRQ_PROFILE_SLOTS 8U
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+/* Called in the interrupt with the pvContext given to irq_bind(). */
+typedef void (*IrqHandler_t)(void *pvContext);
+
+typedef struct
+{
+	uint32_t ulBound;				/* Device vectors bound with irq_bind(). */
+	uint32_t ulDirect;				/* Device vectors bound with irq_bind_direct(). */
+	uint32_t ulRebinds;				/* irq_bind*() and irq_unbind() calls. */
+	uint32_t ulProfiled;			/* Device vectors timed with irq_profile_start(). */
+} IrqStats_t;
+
+/* Cycles are DWT CYCCNT counts, less those of the timed interrupts nested in
+ * the handler. */
+typedef struct
+{
+	const char *pcName;				/* As given to irq_profile_start(). */
+	IRQn_Type xIrq;
+	uint32_t ulCount;				/* Runs of the handler. */
+	uint64_t ullCycles;				/* Cycles in all runs. */
+	uint32_t ulMaxCycles;			/* Cycles in the longest run. */
+	uint32_t ulMaxDepth;			/* Deepest nesting of timed handlers it ran at, 1 at the bottom. */
+	uint32_t ulPreempted;			/* Runs a timed handler of higher priority broke into. */
+} IrqProfile_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t irq_init(void);
+int32_t irq_bind(IRQn_Type xIrq, IrqHandler_t pxHandler, void *pvContext);
+int32_t irq_bind_direct(IRQn_Type xIrq, void (*pxHandler)(void));
+int32_t irq_unbind(IRQn_Type xIrq);
+int32_t irq_get_stats(IrqStats_t *pxStats);
+#if (IRQ_PROFILE_SLOTS > 0U)
+int32_t irq_profile_start(IRQn_Type xIrq, const char *pcName);
+int32_t irq_profile_stop(IRQn_Type xIrq);
+int32_t irq_profile_read(uint32_t ulSlot, IrqProfile_t *pxProfile);
+void irq_profile_reset(void);
+#endif
+
+#endif /* IRQ_H */
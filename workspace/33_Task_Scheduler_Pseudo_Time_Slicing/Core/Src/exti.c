@@ -4,46 +4,311 @@
  * @brief	Implementation of External Interrupt driver.
  * @author	Kyungjae Lee
  * @date	Mar 28, 2026
+ * @note	Pins are described by a const table passed to exti_init(): the
+ * 			port and pin, the edges, the pull, a debounce time and where
+ * 			events go, a callback or a task notification:
+ *
+ * 				static const ExtiPin_t xPins[] =
+ * 				{
+ * 					{ GPIOC, 13, EXTI_EDGE_FALLING, EXTI_PULL_NONE, 20,
+ * 							prvButton, NULL, NULL, 0 },
+ * 				};
+ *
+ * 				exti_init(xPins, 1);
+ *
+ * 			Each pin number is one EXTI line, so two pins in the table must
+ * 			have different numbers. This file defines the line interrupt
+ * 			handlers, EXTI0_IRQHandler() to EXTI15_10_IRQHandler(), and
+ * 			callbacks run in them, so they may only use the FromISR API.
+ *
+ * 			Debouncing masks the line at the first edge, which is reported
+ * 			at once, and unmasks it after usDebounceMs on a one-shot hrtimer
+ * 			(TIM5, shared with every other hrtimer): a bouncing contact
+ * 			costs one interrupt per window, not one per bounce. If the level
+ * 			at the end of the window is across an edge that is selected but
+ * 			was swallowed (a short press on EXTI_EDGE_BOTH), that edge is
+ * 			reported then, and a new window starts.
+ *
+ * 			A bursty source can instead have its edges coalesced, so a
+ * 			storm wakes the handler once per window rather than once per
+ * 			edge:
+ * 			- EXTI_COALESCE_WINDOW: the first edge opens a window of
+ * 			  ulCoalesceUs. Each edge in it only counts and is time-stamped
+ * 			  in the interrupt, without a report, and the end of the window
+ * 			  reports them all at once. Every edge still costs an interrupt,
+ * 			  but no wakeup or context switch.
+ * 			- EXTI_COALESCE_HOLDOFF: the first edge is reported at once and
+ * 			  masks the line for ulCoalesceUs. If an edge was latched by the
+ * 			  end, it is reported then and the holdoff starts again, so a
+ * 			  storm costs two interrupts per holdoff. The pending bit holds
+ * 			  one edge, so the count is a lower bound.
+ * 			The handler reads the count and the time of the first and last
+ * 			edge with exti_take_batch().
  *
  ******************************************************************************/
 
 /* Includes ------------------------------------------------------------------*/
+#include <string.h>
 #include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hrtimer.h"
+#include "clkgate.h"
+#include "bitband.h"
+#include "exti.h"
 
 /* Macros --------------------------------------------------------------------*/
+#define GPIO_PORT_STRIDE			0x400U
+#define EXTI_LINES_9_5				0x03E0U
+#define EXTI_LINES_15_10			0xFC00U
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	const ExtiPin_t *pxPin;			/* NULL for a line not in the table. */
+	HrTimer_t xDebounce;			/* Debounce, coalescing window or holdoff. */
+	uint8_t ucLevel;				/* Level when last reported. */
+	uint8_t ucEnabled;
+	ExtiBatch_t xWindow;			/* EXTI_COALESCE_WINDOW: edges not yet reported. */
+	ExtiBatch_t xBatch;				/* Reported, not yet taken. */
+	ExtiStats_t xStats;
+	ClkGateUser_t xPortClock;		/* Held for good once in the table. */
+} ExtiLine_t;
 
 /* Variables -----------------------------------------------------------------*/
+static ExtiLine_t xLines[EXTI_LINES];
+static ClkGateUser_t xSyscfgClock = CLKGATE_USER(CLKGATE_SYSCFG);
+static ClkGateUser_t xGpioCClock = CLKGATE_USER(CLKGATE_GPIOC);	/* gpio_init() */
+
+/* Private function prototypes -----------------------------------------------*/
+static void exti_irq(uint32_t ulLines);
+static void exti_event(ExtiLine_t *pxLine, uint32_t ulLine, uint32_t ulLevel,
+		const ExtiBatch_t *pxEdges, BaseType_t *pxHigherPriorityTaskWoken);
+static void exti_add_edges(ExtiBatch_t *pxBatch, const ExtiBatch_t *pxEdges);
+static void exti_debounce_expired(HrTimer_t *pxTimer, void *pvArg);
+static void exti_window_expired(ExtiLine_t *pxLine, BaseType_t *pxHigherPriorityTaskWoken);
+static void exti_holdoff_expired(ExtiLine_t *pxLine, BaseType_t *pxHigherPriorityTaskWoken);
+static void exti_set_mask(uint32_t ulLine, uint32_t ulUnmasked);
+static IRQn_Type exti_irqn(uint32_t ulLine);
 
 /* Public function definitions -----------------------------------------------*/
 
 /**
- * @brief Configures PC13 pin interrupt.
- * @param None
+ * @brief Configures the pins of a table as EXTI inputs and enables them.
+ * @param pxPins Pin table; must stay valid, usually a static const.
+ * @param ulCount Number of pins in the table.
+ * @retval 0 if successful, -1 if an entry is invalid, its line is already
+ * used, or the debounce and coalescing timer could not be started. Nothing is
+ * configured then.
+ * @note Can be called again with another table for other lines.
+ */
+int32_t exti_init(const ExtiPin_t *pxPins, uint32_t ulCount)
+{
+	const ExtiPin_t *pxPin;
+	uint32_t ulUsedLines = 0;
+	uint32_t ulDebounce = 0;
+	uint32_t ulPort;
+	uint32_t ulLine;
+	uint32_t i;
+
+	for (i = 0; i < ulCount; i++)
+	{
+		pxPin = &pxPins[i];
+
+		if ((pxPin->pxPort == NULL) || (pxPin->ucPin >= EXTI_LINES)
+				|| (pxPin->ucEdge < EXTI_EDGE_RISING) || (pxPin->ucEdge > EXTI_EDGE_BOTH)
+				|| (pxPin->ucPull > EXTI_PULL_DOWN)
+				|| (pxPin->ucCoalesce > EXTI_COALESCE_HOLDOFF)
+				|| ((pxPin->ucCoalesce != EXTI_COALESCE_NONE)
+						&& ((pxPin->ulCoalesceUs == 0U) || (pxPin->usDebounceMs != 0U)))
+				|| (xLines[pxPin->ucPin].pxPin != NULL)
+				|| ((ulUsedLines & (1U << pxPin->ucPin)) != 0U))
+		{
+			return -1;
+		}
+
+		ulUsedLines |= (1U << pxPin->ucPin);
+		ulDebounce |= pxPin->usDebounceMs | pxPin->ucCoalesce;
+	}
+
+	if ((ulDebounce != 0U) && (hrtimer_init() != 0))
+	{
+		return -1;
+	}
+
+	/* Hold the clock of SYSCFG, for the line selection. */
+	clkgate_acquire(&xSyscfgClock);
+
+	for (i = 0; i < ulCount; i++)
+	{
+		pxPin = &pxPins[i];
+		ulLine = pxPin->ucPin;
+		ulPort = ((uint32_t)pxPin->pxPort - GPIOA_BASE) / GPIO_PORT_STRIDE;
+
+		/* Hold the port's clock, and configure the pin for input. */
+		memset(&xLines[ulLine], 0, sizeof(xLines[ulLine]));
+		clkgate_user_init(&xLines[ulLine].xPortClock, (ClkGate_t)(CLKGATE_GPIOA + ulPort));
+		clkgate_acquire(&xLines[ulLine].xPortClock);
+		pxPin->pxPort->MODER &= ~(3U << (ulLine * 2U));
+		pxPin->pxPort->PUPDR = (pxPin->pxPort->PUPDR & ~(3U << (ulLine * 2U)))
+				| ((uint32_t)pxPin->ucPull << (ulLine * 2U));
+
+		/* Select the port for the line. */
+		SYSCFG->EXTICR[ulLine / 4U] = (SYSCFG->EXTICR[ulLine / 4U] & ~(0xFU << ((ulLine % 4U) * 4U)))
+				| (ulPort << ((ulLine % 4U) * 4U));
+
+		/* Select the edges. */
+		bitband_periph_write(&EXTI->RTSR, ulLine, pxPin->ucEdge & EXTI_EDGE_RISING);
+		bitband_periph_write(&EXTI->FTSR, ulLine, pxPin->ucEdge & EXTI_EDGE_FALLING);
+
+		hrtimer_setup(&xLines[ulLine].xDebounce, exti_debounce_expired, &xLines[ulLine]);
+		xLines[ulLine].pxPin = pxPin;
+
+		NVIC_SetPriority(exti_irqn(ulLine), EXTI_IRQ_PRIORITY);
+		NVIC_EnableIRQ(exti_irqn(ulLine));
+
+		exti_enable(ulLine);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Unmasks a line, discarding any edge seen while it was disabled.
+ * @param ulLine EXTI line, i.e. pin number, of a pin in the table.
  * @retval None
+ * @note Tasks and ISRs at or below configMAX_SYSCALL_INTERRUPT_PRIORITY. A
+ * line in a debounce window or holdoff is unmasked at the end of it.
  */
-void gpio_pc13_interrupt_init(void)
+void exti_enable(uint32_t ulLine)
 {
-	/* Enable clock for GPIOC. */
-	RCC->AHB1ENR |= (1U << 3);
+	ExtiLine_t *pxLine;
+	UBaseType_t uxSavedInterruptStatus;
+
+	if ((ulLine >= EXTI_LINES) || (xLines[ulLine].pxPin == NULL))
+	{
+		return;
+	}
+
+	pxLine = &xLines[ulLine];
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		pxLine->ucEnabled = 1U;
 
-	/* Enable clock for SYSCFG. */
-	RCC->APB2ENR |= (4U << 12);
+		/* A coalescing window leaves the line unmasked. */
+		if ((hrtimer_is_active(&pxLine->xDebounce) == 0U)
+				|| (pxLine->pxPin->ucCoalesce == EXTI_COALESCE_WINDOW))
+		{
+			EXTI->PR = (1U << ulLine);
+			pxLine->ucLevel = (uint8_t)exti_read(ulLine);
+			exti_set_mask(ulLine, 1U);
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+/**
+ * @brief Masks a line and ends its window, if any. Edges of a coalescing
+ * window not yet reported are discarded.
+ * @param ulLine EXTI line of a pin in the table.
+ * @retval None
+ * @note Tasks and ISRs at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+void exti_disable(uint32_t ulLine)
+{
+	UBaseType_t uxSavedInterruptStatus;
 
-	/* Clear port selection for EXTI13. */
-	SYSCFG->EXTICR[3] &= ~(0xFU << 4);
+	if ((ulLine >= EXTI_LINES) || (xLines[ulLine].pxPin == NULL))
+	{
+		return;
+	}
 
-	/* Select port C for EXTI13. */
-	SYSCFG->EXTICR[3] |= (2U << 4);
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		xLines[ulLine].ucEnabled = 0U;
+		exti_set_mask(ulLine, 0U);
+		hrtimer_stop(&xLines[ulLine].xDebounce);
+		xLines[ulLine].xWindow.ulCount = 0;
+	}
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
 
-	/* Unmask EXTI13. */
-	EXTI->IMR |= (2U << 12);
+/**
+ * @brief Reads the level of the pin of a line.
+ * @param ulLine EXTI line of a pin in the table.
+ * @retval 1 if high, 0 if low or not in the table.
+ */
+uint32_t exti_read(uint32_t ulLine)
+{
+	const ExtiPin_t *pxPin;
 
-	/* Select falling edge trigger. */
-	EXTI->FTSR |= (2U << 12);
+	if ((ulLine >= EXTI_LINES) || (xLines[ulLine].pxPin == NULL))
+	{
+		return 0;
+	}
 
-	NVIC_SetPriority(EXTI15_10_IRQn, 6);
+	pxPin = xLines[ulLine].pxPin;
 
-	NVIC_EnableIRQ(EXTI15_10_IRQn);
+	return (pxPin->pxPort->IDR >> pxPin->ucPin) & 1U;
+}
+
+/**
+ * @brief Takes the edges reported on a line since the last call.
+ * @param ulLine EXTI line of a pin in the table.
+ * @param pxBatch Receives the count and times; NULL to only clear them.
+ * @retval Number of edges, 0 if none or the line is not in the table.
+ * @note Tasks and ISRs at or below configMAX_SYSCALL_INTERRUPT_PRIORITY,
+ * usually the handler after its notification or the callback. The times are 0
+ * unless a pin of a table given to exti_init() is debounced or coalesced,
+ * which starts TIM5.
+ */
+uint32_t exti_take_batch(uint32_t ulLine, ExtiBatch_t *pxBatch)
+{
+	UBaseType_t uxSavedInterruptStatus;
+	uint32_t ulCount;
+
+	if ((ulLine >= EXTI_LINES) || (xLines[ulLine].pxPin == NULL))
+	{
+		return 0;
+	}
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		ulCount = xLines[ulLine].xBatch.ulCount;
+
+		if (pxBatch != NULL)
+		{
+			*pxBatch = xLines[ulLine].xBatch;
+		}
+
+		xLines[ulLine].xBatch.ulCount = 0;
+	}
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	return ulCount;
+}
+
+/**
+ * @brief Copies the event, edge and bounce counts of a line.
+ * @param ulLine EXTI line of a pin in the table.
+ * @param pxStats Receives the counts.
+ * @retval 0 if successful, -1 if the line is not in the table.
+ */
+int32_t exti_get_stats(uint32_t ulLine, ExtiStats_t *pxStats)
+{
+	UBaseType_t uxSavedInterruptStatus;
+
+	if ((ulLine >= EXTI_LINES) || (xLines[ulLine].pxPin == NULL))
+	{
+		return -1;
+	}
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	*pxStats = xLines[ulLine].xStats;
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	return 0;
 }
 
 /**
@@ -53,8 +318,8 @@ void gpio_pc13_interrupt_init(void)
  */
 void gpio_init(void)
 {
-	/* Enable clock for GPIOC. */
-	RCC->AHB1ENR |= (1U << 3);
+	/* Hold the clock of GPIOC. */
+	clkgate_acquire(&xGpioCClock);
 
 	/* Configure PC13 for input pin. */
 	GPIOC->MODER &= ~(3U << 26);
@@ -76,3 +341,367 @@ uint8_t read_digital_sensor(void)
 		return 0;
 	}
 }
+
+/**
+ * @brief EXTI line 0 IRQ handler.
+ * @param None
+ * @retval None
+ */
+void EXTI0_IRQHandler(void)
+{
+	exti_irq(1U << 0);
+}
+
+/**
+ * @brief EXTI line 1 IRQ handler.
+ * @param None
+ * @retval None
+ */
+void EXTI1_IRQHandler(void)
+{
+	exti_irq(1U << 1);
+}
+
+/**
+ * @brief EXTI line 2 IRQ handler.
+ * @param None
+ * @retval None
+ */
+void EXTI2_IRQHandler(void)
+{
+	exti_irq(1U << 2);
+}
+
+/**
+ * @brief EXTI line 3 IRQ handler.
+ * @param None
+ * @retval None
+ */
+void EXTI3_IRQHandler(void)
+{
+	exti_irq(1U << 3);
+}
+
+/**
+ * @brief EXTI line 4 IRQ handler.
+ * @param None
+ * @retval None
+ */
+void EXTI4_IRQHandler(void)
+{
+	exti_irq(1U << 4);
+}
+
+/**
+ * @brief EXTI line 9..5 IRQ handler.
+ * @param None
+ * @retval None
+ */
+void EXTI9_5_IRQHandler(void)
+{
+	exti_irq(EXTI_LINES_9_5);
+}
+
+/**
+ * @brief EXTI line 15..10 IRQ handler (B1 button on PC13).
+ * @param None
+ * @retval None
+ */
+void EXTI15_10_IRQHandler(void)
+{
+	exti_irq(EXTI_LINES_15_10);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Handles the pending, unmasked lines among those of an interrupt.
+ * @param ulLines Lines of the interrupt.
+ * @retval None
+ */
+static void exti_irq(uint32_t ulLines)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	UBaseType_t uxSavedInterruptStatus;
+	ExtiLine_t *pxLine;
+	ExtiBatch_t xEdge;
+	uint32_t ulPending = EXTI->PR & EXTI->IMR & ulLines;
+	uint32_t ulLine;
+
+	while (ulPending != 0U)
+	{
+		ulLine = 31U - __CLZ(ulPending);
+		ulPending &= ~(1U << ulLine);
+		pxLine = &xLines[ulLine];
+
+		/* Clear interrupt pending flag. */
+		EXTI->PR = (1U << ulLine);
+
+		if (pxLine->pxPin == NULL)
+		{
+			continue;
+		}
+
+		xEdge.ulCount = 1;
+		xEdge.ulFirstUs = hrtimer_now();
+		xEdge.ulLastUs = xEdge.ulFirstUs;
+
+		if (pxLine->pxPin->ucCoalesce == EXTI_COALESCE_WINDOW)
+		{
+			/* Count only; the TIM5 interrupt may end the window meanwhile. */
+			uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+			exti_add_edges(&pxLine->xWindow, &xEdge);
+
+			if (pxLine->xWindow.ulCount == 1U)
+			{
+				(void)hrtimer_start(&pxLine->xDebounce, pxLine->pxPin->ulCoalesceUs, 0);
+			}
+
+			taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+			continue;
+		}
+
+		/* The window starts before the event is reported, so a callback
+		 * may disable the line. */
+		if (pxLine->pxPin->ucCoalesce == EXTI_COALESCE_HOLDOFF)
+		{
+			exti_set_mask(ulLine, 0U);
+			(void)hrtimer_start(&pxLine->xDebounce, pxLine->pxPin->ulCoalesceUs, 0);
+		}
+		else if (pxLine->pxPin->usDebounceMs != 0U)
+		{
+			exti_set_mask(ulLine, 0U);
+			(void)hrtimer_start(&pxLine->xDebounce, (uint32_t)pxLine->pxPin->usDebounceMs * 1000U, 0);
+		}
+
+		pxLine->ucLevel = (uint8_t)exti_read(ulLine);
+		exti_event(pxLine, ulLine, pxLine->ucLevel, &xEdge, &xHigherPriorityTaskWoken);
+	}
+
+	/* Request a context switch. */
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Reports an event to the callback or the task of its pin.
+ * @param pxLine Line.
+ * @param ulLine Its number.
+ * @param ulLevel Pin level.
+ * @param pxEdges Edges of the event, added to the batch of the line.
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a context switch is due.
+ * @retval None
+ */
+static void exti_event(ExtiLine_t *pxLine, uint32_t ulLine, uint32_t ulLevel,
+		const ExtiBatch_t *pxEdges, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	const ExtiPin_t *pxPin = pxLine->pxPin;
+	UBaseType_t uxSavedInterruptStatus;
+
+	/* Before the report, so the handler finds them. */
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	exti_add_edges(&pxLine->xBatch, pxEdges);
+	pxLine->xStats.ulEvents++;
+	pxLine->xStats.ulEdges += pxEdges->ulCount;
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	if (pxPin->pxCallback != NULL)
+	{
+		pxPin->pxCallback(ulLine, ulLevel, pxPin->pvArg, pxHigherPriorityTaskWoken);
+	}
+	else if ((pxPin->pxNotifyTask != NULL) && (*pxPin->pxNotifyTask != NULL))
+	{
+		if (pxPin->ulNotifyBits != 0U)
+		{
+			(void)xTaskNotifyFromISR(*pxPin->pxNotifyTask, pxPin->ulNotifyBits, eSetBits,
+					pxHigherPriorityTaskWoken);
+		}
+		else
+		{
+			vTaskNotifyGiveFromISR(*pxPin->pxNotifyTask, pxHigherPriorityTaskWoken);
+		}
+	}
+}
+
+/**
+ * @brief Adds edges to a batch.
+ * @param pxBatch Batch, empty if its count is 0.
+ * @param pxEdges Edges to add, later than those already in it.
+ * @retval None
+ * @note Called with the EXTI and TIM5 interrupts masked.
+ */
+static void exti_add_edges(ExtiBatch_t *pxBatch, const ExtiBatch_t *pxEdges)
+{
+	if (pxBatch->ulCount == 0U)
+	{
+		pxBatch->ulFirstUs = pxEdges->ulFirstUs;
+	}
+
+	pxBatch->ulCount += pxEdges->ulCount;
+	pxBatch->ulLastUs = pxEdges->ulLastUs;
+}
+
+/**
+ * @brief Ends the debounce window, coalescing window or holdoff of a line
+ * (TIM5 interrupt).
+ * @param pxTimer The line's timer.
+ * @param pvArg The line.
+ * @retval None
+ */
+static void exti_debounce_expired(HrTimer_t *pxTimer, void *pvArg)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	ExtiLine_t *pxLine = (ExtiLine_t *)pvArg;
+	const ExtiPin_t *pxPin = pxLine->pxPin;
+	uint32_t ulLine = pxPin->ucPin;
+	ExtiBatch_t xEdge;
+	uint32_t ulLevel;
+	uint32_t ulEdge;
+
+	if (pxPin->ucCoalesce == EXTI_COALESCE_WINDOW)
+	{
+		exti_window_expired(pxLine, &xHigherPriorityTaskWoken);
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+		return;
+	}
+
+	if (pxPin->ucCoalesce == EXTI_COALESCE_HOLDOFF)
+	{
+		exti_holdoff_expired(pxLine, &xHigherPriorityTaskWoken);
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+		return;
+	}
+
+	/* Edges latched while masked were bounces. */
+	if ((EXTI->PR & (1U << ulLine)) != 0U)
+	{
+		EXTI->PR = (1U << ulLine);
+		pxLine->xStats.ulBounces++;
+	}
+
+	if (pxLine->ucEnabled == 0U)
+	{
+		return;
+	}
+
+	ulLevel = exti_read(ulLine);
+	ulEdge = (ulLevel != 0U) ? EXTI_EDGE_RISING : EXTI_EDGE_FALLING;
+
+	if ((ulLevel != pxLine->ucLevel) && ((pxPin->ucEdge & ulEdge) != 0U))
+	{
+		/* The level settled across a selected edge the window swallowed. */
+		pxLine->ucLevel = (uint8_t)ulLevel;
+		(void)hrtimer_start(pxTimer, (uint32_t)pxPin->usDebounceMs * 1000U, 0);
+		xEdge.ulCount = 1;
+		xEdge.ulFirstUs = hrtimer_now();
+		xEdge.ulLastUs = xEdge.ulFirstUs;
+		exti_event(pxLine, ulLine, ulLevel, &xEdge, &xHigherPriorityTaskWoken);
+	}
+	else
+	{
+		pxLine->ucLevel = (uint8_t)ulLevel;
+		exti_set_mask(ulLine, 1U);
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Reports the edges of a coalescing window that ended (TIM5 interrupt).
+ * @param pxLine Line.
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a context switch is due.
+ * @retval None
+ * @note An edge after the window was taken opens the next one.
+ */
+static void exti_window_expired(ExtiLine_t *pxLine, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	UBaseType_t uxSavedInterruptStatus;
+	uint32_t ulLine = pxLine->pxPin->ucPin;
+	ExtiBatch_t xEdges;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	xEdges = pxLine->xWindow;
+	pxLine->xWindow.ulCount = 0;
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	if ((xEdges.ulCount == 0U) || (pxLine->ucEnabled == 0U))
+	{
+		return;
+	}
+
+	pxLine->ucLevel = (uint8_t)exti_read(ulLine);
+	exti_event(pxLine, ulLine, pxLine->ucLevel, &xEdges, pxHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Ends the holdoff of a line (TIM5 interrupt).
+ * @param pxLine Line.
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a context switch is due.
+ * @retval None
+ * @note A latched edge is reported, as one edge at the end of the holdoff, and
+ * starts the next holdoff. Otherwise the line is unmasked.
+ */
+static void exti_holdoff_expired(ExtiLine_t *pxLine, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	uint32_t ulLine = pxLine->pxPin->ucPin;
+	ExtiBatch_t xEdge;
+
+	if ((EXTI->PR & (1U << ulLine)) == 0U)
+	{
+		if (pxLine->ucEnabled != 0U)
+		{
+			exti_set_mask(ulLine, 1U);
+		}
+
+		return;
+	}
+
+	EXTI->PR = (1U << ulLine);
+
+	if (pxLine->ucEnabled == 0U)
+	{
+		return;
+	}
+
+	(void)hrtimer_start(&pxLine->xDebounce, pxLine->pxPin->ulCoalesceUs, 0);
+
+	xEdge.ulCount = 1;
+	xEdge.ulFirstUs = hrtimer_now();
+	xEdge.ulLastUs = xEdge.ulFirstUs;
+	pxLine->ucLevel = (uint8_t)exti_read(ulLine);
+	exti_event(pxLine, ulLine, pxLine->ucLevel, &xEdge, pxHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Masks or unmasks a line.
+ * @param ulLine EXTI line.
+ * @param ulUnmasked 1 to unmask, 0 to mask.
+ * @retval None
+ * @note EXTI_IMR is shared by every line and written from the EXTI and TIM5
+ * interrupts. The bit-band write changes the line's bit alone, so it needs no
+ * critical section.
+ */
+static void exti_set_mask(uint32_t ulLine, uint32_t ulUnmasked)
+{
+	bitband_periph_write(&EXTI->IMR, ulLine, ulUnmasked);
+}
+
+/**
+ * @brief Returns the interrupt of a line.
+ * @param ulLine EXTI line.
+ * @retval IRQ number.
+ */
+static IRQn_Type exti_irqn(uint32_t ulLine)
+{
+	if (ulLine <= 4U)
+	{
+		return (IRQn_Type)(EXTI0_IRQn + (int32_t)ulLine);
+	}
+	else if (ulLine <= 9U)
+	{
+		return EXTI9_5_IRQn;
+	}
+	else
+	{
+		return EXTI15_10_IRQn;
+	}
+}
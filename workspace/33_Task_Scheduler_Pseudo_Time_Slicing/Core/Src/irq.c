@@ -0,0 +1,477 @@
+/*******************************************************************************
+ *
+ * @file	irq.c
+ * @brief	Implementation of the SRAM vector table and run-time interrupt
+ * 			binding.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	irq_init() copies the linked vector table from flash to SRAM and
+ * 			points SCB->VTOR at the copy. Every handler linked by name, such
+ * 			as USART2_IRQHandler(), keeps working, but the core now fetches
+ * 			the vector from SRAM, with no flash wait states (5 at 180 MHz)
+ * 			on an ART miss. Call it first in main(), before any interrupt is
+ * 			enabled; .bss is cleared after SystemInit(), so it cannot go
+ * 			there.
+ *
+ * 			A device interrupt can then be bound at run time:
+ *
+ * 				irq_bind(USART2_IRQn, prvUartDma, &xUart);
+ *
+ * 			The vector is set to irq_dispatch(), which takes the interrupt
+ * 			number from IPSR and calls the handler with its context, so one
+ * 			handler can serve several instances. irq_bind_direct() writes a
+ * 			plain handler into the vector itself, for no dispatch cost, and
+ * 			irq_unbind() restores the one from flash. A driver can swap
+ * 			between its polled, DMA and coalesced handlers this way without
+ * 			a rebuild, and a handler bound by its IRQn_Type cannot be
+ * 			misnamed into Default_Handler().
+ *
+ * 			A swap masks interrupts for a few instructions, so it is safe
+ * 			from tasks and interrupts alike: the interrupt is taken either
+ * 			by the old handler or by the new one with its new context. The
+ * 			old handler may still be running when irq_bind() returns if it
+ * 			is called from a higher priority interrupt.
+ *
+ * 			irq_profile_start() times a device interrupt on the DWT cycle
+ * 			counter without touching its handler:
+ *
+ * 				irq_profile_start(TIM1_UP_TIM10_IRQn, "TIM1_UP_TIM10");
+ *
+ * 			The vector is set to irq_profile_entry(), which calls the one it
+ * 			replaced and counts the runs, the cycles of each and the nesting.
+ * 			The cycles of a timed interrupt nested in another are charged to
+ * 			the nested one only, so the totals add up to the CPU time spent
+ * 			in interrupts; an untimed one is charged to the handler it broke
+ * 			into. It costs about 40 cycles per interrupt. irq_bind() and
+ * 			irq_unbind() on a timed interrupt change the handler being timed,
+ * 			and irq_profile_stop() puts it back in the vector. Only device
+ * 			interrupts can be timed, not SysTick or PendSV, and not a naked
+ * 			handler that reads its exception frame, such as TIM7_IRQHandler()
+ * 			in pcprof.c: it would find the frame of irq_profile_entry().
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "stm32f4xx_hal.h"
+#include "irq.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define IRQ_IPSR_MASK 0x1FFU				/* Exception number in IPSR. */
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	IrqHandler_t pxHandler;
+	void *pvContext;
+} IrqSlot_t;
+
+/* Variables -----------------------------------------------------------------*/
+static uint32_t ulRamVectors[IRQ_VECTORS] __attribute__((aligned(IRQ_TABLE_ALIGN)));
+static const uint32_t *pulFlashVectors;		/* The linked table, for irq_unbind(). */
+static IrqSlot_t xSlots[IRQ_DEVICE_VECTORS];
+static uint32_t ulRebinds;
+
+#if (IRQ_PROFILE_SLOTS > 0U)
+static struct
+{
+	uint32_t ulVector;						/* The handler timed, 0 if free. */
+	IrqProfile_t xProfile;
+} xProfiles[IRQ_PROFILE_SLOTS];
+static uint8_t ucProfileOf[IRQ_DEVICE_VECTORS];	/* Slot + 1, 0 if not timed. */
+static uint32_t ulProfileDepth;				/* Timed handlers running. */
+static uint32_t ulProfileNested;			/* Cycles of those nested in the top one. */
+
+_Static_assert(IRQ_PROFILE_SLOTS < 256U, "IRQ_PROFILE_SLOTS too large");
+#endif
+
+_Static_assert(sizeof(ulRamVectors) <= IRQ_TABLE_ALIGN, "IRQ_TABLE_ALIGN too small");
+
+/* Private function prototypes -----------------------------------------------*/
+static void irq_dispatch(void);
+static int32_t irq_set_vector(IRQn_Type xIrq, uint32_t ulVector, IrqHandler_t pxHandler,
+		void *pvContext);
+#if (IRQ_PROFILE_SLOTS > 0U)
+static void irq_profile_entry(void);
+#endif
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Copies the vector table to SRAM and points VTOR at it.
+ * @param None
+ * @retval 0 on success, -1 if it was already done.
+ */
+int32_t irq_init(void)
+{
+	uint32_t ulPrimask;
+
+	if (SCB->VTOR == (uint32_t)ulRamVectors)
+	{
+		return -1;
+	}
+
+	ulPrimask = __get_PRIMASK();
+	__disable_irq();
+
+	pulFlashVectors = (const uint32_t *)SCB->VTOR;
+	(void)memcpy(ulRamVectors, pulFlashVectors, sizeof(ulRamVectors));
+	__DSB();
+	SCB->VTOR = (uint32_t)ulRamVectors;
+	__DSB();
+	__ISB();
+
+	__set_PRIMASK(ulPrimask);
+
+	return 0;
+}
+
+/**
+ * @brief Binds a device interrupt to a handler with a context.
+ * @param xIrq The interrupt, 0 or above.
+ * @param pxHandler Called in the interrupt as pxHandler(pvContext).
+ * @param pvContext Its argument.
+ * @retval 0 on success, -1 before irq_init() or on a bad argument.
+ */
+int32_t irq_bind(IRQn_Type xIrq, IrqHandler_t pxHandler, void *pvContext)
+{
+	if (pxHandler == NULL)
+	{
+		return -1;
+	}
+
+	return irq_set_vector(xIrq, (uint32_t)irq_dispatch, pxHandler, pvContext);
+}
+
+/**
+ * @brief Writes a plain handler into the vector of a device interrupt.
+ * @note The core calls it directly, as it does a linked handler.
+ * @param xIrq The interrupt, 0 or above.
+ * @param pxHandler The handler.
+ * @retval 0 on success, -1 before irq_init() or on a bad argument.
+ */
+int32_t irq_bind_direct(IRQn_Type xIrq, void (*pxHandler)(void))
+{
+	if (pxHandler == NULL)
+	{
+		return -1;
+	}
+
+	return irq_set_vector(xIrq, (uint32_t)pxHandler, NULL, NULL);
+}
+
+/**
+ * @brief Restores the linked handler of a device interrupt.
+ * @param xIrq The interrupt, 0 or above.
+ * @retval 0 on success, -1 before irq_init() or on a bad argument.
+ */
+int32_t irq_unbind(IRQn_Type xIrq)
+{
+	if ((pulFlashVectors == NULL) || ((int32_t)xIrq < 0)
+			|| ((uint32_t)xIrq >= IRQ_DEVICE_VECTORS))
+	{
+		return -1;
+	}
+
+	return irq_set_vector(xIrq, pulFlashVectors[IRQ_SYSTEM_VECTORS + (uint32_t)xIrq], NULL,
+			NULL);
+}
+
+/**
+ * @brief Returns how many device vectors are bound.
+ * @param pxStats Where to copy them.
+ * @retval 0 on success, -1 before irq_init().
+ */
+int32_t irq_get_stats(IrqStats_t *pxStats)
+{
+	uint32_t i;
+	uint32_t ulVector;
+
+	if ((pxStats == NULL) || (pulFlashVectors == NULL))
+	{
+		return -1;
+	}
+
+	(void)memset(pxStats, 0, sizeof(*pxStats));
+
+	for (i = 0U; i < IRQ_DEVICE_VECTORS; i++)
+	{
+		ulVector = ulRamVectors[IRQ_SYSTEM_VECTORS + i];
+
+#if (IRQ_PROFILE_SLOTS > 0U)
+		if (ucProfileOf[i] != 0U)
+		{
+			pxStats->ulProfiled++;
+			ulVector = xProfiles[ucProfileOf[i] - 1U].ulVector;
+		}
+#endif
+
+		if (ulVector == (uint32_t)irq_dispatch)
+		{
+			pxStats->ulBound++;
+		}
+		else if (ulVector != pulFlashVectors[IRQ_SYSTEM_VECTORS + i])
+		{
+			pxStats->ulDirect++;
+		}
+	}
+
+	pxStats->ulRebinds = ulRebinds;
+
+	return 0;
+}
+
+#if (IRQ_PROFILE_SLOTS > 0U)
+/**
+ * @brief Starts timing a device interrupt.
+ * @note Its counts start from zero. CYCCNT is started if it is not running.
+ * @param xIrq The interrupt, 0 or above.
+ * @param pcName Its name in the profile, kept by reference.
+ * @retval 0 on success, -1 before irq_init(), on a bad argument, if it is
+ * already timed or if all IRQ_PROFILE_SLOTS are in use.
+ */
+int32_t irq_profile_start(IRQn_Type xIrq, const char *pcName)
+{
+	uint32_t ulPrimask;
+	uint32_t i;
+	int32_t lResult = -1;
+
+	if ((pulFlashVectors == NULL) || (pcName == NULL) || ((int32_t)xIrq < 0)
+			|| ((uint32_t)xIrq >= IRQ_DEVICE_VECTORS))
+	{
+		return -1;
+	}
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	ulPrimask = __get_PRIMASK();
+	__disable_irq();
+
+	for (i = 0U; (i < IRQ_PROFILE_SLOTS) && (ucProfileOf[xIrq] == 0U); i++)
+	{
+		if (xProfiles[i].ulVector == 0U)
+		{
+			(void)memset(&xProfiles[i].xProfile, 0, sizeof(xProfiles[i].xProfile));
+			xProfiles[i].xProfile.pcName = pcName;
+			xProfiles[i].xProfile.xIrq = xIrq;
+			xProfiles[i].ulVector = ulRamVectors[IRQ_SYSTEM_VECTORS + (uint32_t)xIrq];
+			ucProfileOf[xIrq] = (uint8_t)(i + 1U);
+			ulRamVectors[IRQ_SYSTEM_VECTORS + (uint32_t)xIrq] = (uint32_t)irq_profile_entry;
+			__DSB();
+			lResult = 0;
+		}
+	}
+
+	__set_PRIMASK(ulPrimask);
+
+	return lResult;
+}
+
+/**
+ * @brief Stops timing a device interrupt and frees its slot.
+ * @param xIrq The interrupt, 0 or above.
+ * @retval 0 on success, -1 on a bad argument or if it is not timed.
+ */
+int32_t irq_profile_stop(IRQn_Type xIrq)
+{
+	uint32_t ulPrimask;
+	uint32_t ulSlot;
+
+	if (((int32_t)xIrq < 0) || ((uint32_t)xIrq >= IRQ_DEVICE_VECTORS)
+			|| (ucProfileOf[xIrq] == 0U))
+	{
+		return -1;
+	}
+
+	ulPrimask = __get_PRIMASK();
+	__disable_irq();
+
+	ulSlot = ucProfileOf[xIrq] - 1U;
+	ulRamVectors[IRQ_SYSTEM_VECTORS + (uint32_t)xIrq] = xProfiles[ulSlot].ulVector;
+	__DSB();
+	ucProfileOf[xIrq] = 0U;
+	xProfiles[ulSlot].ulVector = 0U;
+
+	__set_PRIMASK(ulPrimask);
+
+	return 0;
+}
+
+/**
+ * @brief Copies the profile of one slot.
+ * @note Slots go from 0 to IRQ_PROFILE_SLOTS - 1, in no particular order.
+ * @param ulSlot The slot.
+ * @param pxProfile Where to copy it.
+ * @retval 0 on success, -1 if the slot is free or out of range.
+ */
+int32_t irq_profile_read(uint32_t ulSlot, IrqProfile_t *pxProfile)
+{
+	uint32_t ulPrimask;
+	int32_t lResult = -1;
+
+	if ((pxProfile == NULL) || (ulSlot >= IRQ_PROFILE_SLOTS))
+	{
+		return -1;
+	}
+
+	ulPrimask = __get_PRIMASK();
+	__disable_irq();
+
+	if (xProfiles[ulSlot].ulVector != 0U)
+	{
+		*pxProfile = xProfiles[ulSlot].xProfile;
+		lResult = 0;
+	}
+
+	__set_PRIMASK(ulPrimask);
+
+	return lResult;
+}
+
+/**
+ * @brief Clears the counts of every timed interrupt.
+ * @param None
+ * @retval None
+ */
+void irq_profile_reset(void)
+{
+	uint32_t ulPrimask;
+	uint32_t i;
+
+	ulPrimask = __get_PRIMASK();
+	__disable_irq();
+
+	for (i = 0U; i < IRQ_PROFILE_SLOTS; i++)
+	{
+		xProfiles[i].xProfile.ulCount = 0U;
+		xProfiles[i].xProfile.ullCycles = 0U;
+		xProfiles[i].xProfile.ulMaxCycles = 0U;
+		xProfiles[i].xProfile.ulMaxDepth = 0U;
+		xProfiles[i].xProfile.ulPreempted = 0U;
+	}
+
+	__set_PRIMASK(ulPrimask);
+}
+#endif /* IRQ_PROFILE_SLOTS > 0U */
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Vector of the interrupts bound with irq_bind().
+ * @note In SRAM, like the table, so the only flash fetch left is the one of
+ * the handler.
+ * @param None
+ * @retval None
+ */
+__RAM_FUNC static void irq_dispatch(void)
+{
+	const IrqSlot_t *pxSlot = &xSlots[(__get_IPSR() & IRQ_IPSR_MASK) - IRQ_SYSTEM_VECTORS];
+
+	pxSlot->pxHandler(pxSlot->pvContext);
+}
+
+#if (IRQ_PROFILE_SLOTS > 0U)
+/**
+ * @brief Vector of the interrupts timed with irq_profile_start().
+ * @note PRIMASK is always clear on entry to a device interrupt, so it is
+ * set and cleared around the bookkeeping without saving it. The cycles of the
+ * nested timed handlers are passed up through ulProfileNested and taken off
+ * this run; on return, this run as a whole is passed up to the one it broke
+ * into.
+ * @param None
+ * @retval None
+ */
+__RAM_FUNC static void irq_profile_entry(void)
+{
+	uint32_t ulIrq = (__get_IPSR() & IRQ_IPSR_MASK) - IRQ_SYSTEM_VECTORS;
+	uint32_t ulSlot = ucProfileOf[ulIrq] - 1U;
+	IrqProfile_t *pxProfile = &xProfiles[ulSlot].xProfile;
+	uint32_t ulOuterNested;
+	uint32_t ulDepth;
+	uint32_t ulStart;
+	uint32_t ulCycles;
+	uint32_t ulSelf;
+
+	__disable_irq();
+	ulOuterNested = ulProfileNested;
+	ulProfileNested = 0U;
+	ulDepth = ++ulProfileDepth;
+	ulStart = DWT->CYCCNT;
+	__enable_irq();
+
+	((void (*)(void))xProfiles[ulSlot].ulVector)();
+
+	__disable_irq();
+	ulCycles = DWT->CYCCNT - ulStart;
+
+	if (ulProfileNested != 0U)
+	{
+		pxProfile->ulPreempted++;
+	}
+
+	ulSelf = ulCycles - ulProfileNested;
+	pxProfile->ulCount++;
+	pxProfile->ullCycles += ulSelf;
+
+	if (ulSelf > pxProfile->ulMaxCycles)
+	{
+		pxProfile->ulMaxCycles = ulSelf;
+	}
+
+	if (ulDepth > pxProfile->ulMaxDepth)
+	{
+		pxProfile->ulMaxDepth = ulDepth;
+	}
+
+	ulProfileNested = ulOuterNested + ulCycles;
+	ulProfileDepth--;
+	__enable_irq();
+}
+#endif
+
+/**
+ * @brief Sets the slot and the vector of a device interrupt in one step.
+ * @param xIrq The interrupt, 0 or above.
+ * @param ulVector Its new vector.
+ * @param pxHandler Handler called by irq_dispatch(), or NULL.
+ * @param pvContext Its argument.
+ * @retval 0 on success, -1 before irq_init() or on a bad argument.
+ */
+static int32_t irq_set_vector(IRQn_Type xIrq, uint32_t ulVector, IrqHandler_t pxHandler,
+		void *pvContext)
+{
+	uint32_t ulPrimask;
+
+	if ((pulFlashVectors == NULL) || ((int32_t)xIrq < 0)
+			|| ((uint32_t)xIrq >= IRQ_DEVICE_VECTORS))
+	{
+		return -1;
+	}
+
+	ulPrimask = __get_PRIMASK();
+	__disable_irq();
+
+	xSlots[xIrq].pxHandler = pxHandler;
+	xSlots[xIrq].pvContext = pvContext;
+
+#if (IRQ_PROFILE_SLOTS > 0U)
+	/* A timed interrupt keeps irq_profile_entry() and times the new handler. */
+	if (ucProfileOf[xIrq] != 0U)
+	{
+		xProfiles[ucProfileOf[xIrq] - 1U].ulVector = ulVector;
+	}
+	else
+#endif
+	{
+		ulRamVectors[IRQ_SYSTEM_VECTORS + (uint32_t)xIrq] = ulVector;
+	}
+	ulRebinds++;
+
+	/* The vector fetch of an interrupt taken next must see the new entry. */
+	__DSB();
+
+	__set_PRIMASK(ulPrimask);
+
+	return 0;
+}
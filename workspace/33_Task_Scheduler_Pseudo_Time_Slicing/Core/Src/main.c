@@ -14,12 +14,48 @@
  *       	By adding 'vTaskDelay()' to each task, all tasks get a chance to
  *       	run. Note that this is not an accurate time slicing though.
  *
+ *       	The PC-sampling profiler (pcprof.c) prints a histogram every 10 s;
+ *       	'Tools/pcprof_report.py' maps it to functions and tasks.
+ *
+ *       	The critical section profiler (csprof.c) prints, every 10 s, the
+ *       	longest and total time each call site kept interrupts masked or
+ *       	the scheduler suspended; 'Tools/csprof_report.py' names the call
+ *       	sites and ranks them.
+ *
+ *       	With TELEMETRY_STREAM 1, USART2 carries binary telemetry frames
+ *       	(telemetry.c) instead of these reports: the CPU time and stack
+ *       	of each task, the heap and the task profiler counters, sampled
+ *       	at TELEMETRY_RATE_HZ. 'Tools/telemetry_decode.py' prints them
+ *       	live.
+ *
+ *       	LD2 is lit while the Red task runs: each task drives it on every
+ *       	pass of its busy loop, the Red task on and the others off, so its
+ *       	brightness is the Red task's share of the CPU. The tasks write
+ *       	the same ODR without a critical section; a bit-band store
+ *       	(bitband.h) changes PA5 alone, so neither a task switch nor an
+ *       	interrupt in the middle can write back a stale copy of the other
+ *       	pins.
+ *
  ******************************************************************************/
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
+#include "uart.h"
+#include "bitband.h"
+#include "runstats.h"
+#include "pcprof.h"
+#include "csprof.h"
+#include "irq.h"
+#include "crc.h"
+#include "telemetry.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define LD2_BIT 5U				/* LD2_Pin is GPIO_PIN_5. */
+#define TELEMETRY_STREAM 0		/* 0: text reports, 1: binary telemetry frames on USART2 */
+#define TELEMETRY_RATE_HZ 50U	/* Samples per second, up to about 100 at 115200 baud. */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
@@ -46,6 +82,9 @@ const TickType_t _50ms = pdMS_TO_TICKS(50UL);
  */
 int main(void)
 {
+	/* Vectors in SRAM, so the interrupts can be timed (irq.c). */
+	irq_init();
+
 	HAL_Init();
 
 	/* Configure the system clock */
@@ -53,6 +92,7 @@ int main(void)
 
 	/* Initialize all configured peripherals */
 	MX_GPIO_Init();
+	USART2_UART_TX_Init();
 
 	/* Create tasks. */
 	xTaskCreate(
@@ -87,6 +127,44 @@ int main(void)
 			1,
 			NULL);
 
+	/* Sample the PC at 4993 Hz, off the 1 kHz tick. */
+	if (pcprof_start(4993) != 0)
+	{
+		Error_Handler();
+	}
+
+	/* Time the critical sections and scheduler suspensions. */
+	csprof_start();
+
+	/* Time the HAL tick and the telemetry DMA next to the tasks. TIM7 is left
+	 * out: its naked handler reads the frame it interrupted (pcprof.c). */
+	if ((irq_profile_start(TIM1_UP_TIM10_IRQn, "TIM1_UP_TIM10") != 0)
+			|| (irq_profile_start(DMA1_Stream6_IRQn, "DMA1_Stream6") != 0))
+	{
+		Error_Handler();
+	}
+
+#if (TELEMETRY_STREAM == 1)
+	/* The frames are checked with the CRC unit (frame.c). */
+	crc_init();
+
+	telemetry_add_counter("Orange", &Orange_TaskProfiler);
+	telemetry_add_counter("Red", &Red_TaskProfiler);
+	telemetry_add_counter("Green", &Green_TaskProfiler);
+	telemetry_add_counter("Blue", &Blue_TaskProfiler);
+
+	if (telemetry_start(TELEMETRY_RATE_HZ, 2) != pdPASS)
+	{
+		Error_Handler();
+	}
+#else
+	/* Print each task's share of the CPU every 2 s, and dump the PC histogram
+	 * and the critical section profile every 10 s. */
+	runstats_start_reporter(2000, 2);
+	pcprof_start_reporter(10000, 2);
+	csprof_start_reporter(10000, 2);
+#endif
+
 	vTaskStartScheduler();
 
 	/* Infinite loop */
@@ -103,7 +181,7 @@ void vOrangeLedControllerTask(void *pvParameters)
 		Orange_TaskProfiler++;
 		for (int i = 0; i < 1000000; i++)
 		{
-			/* Do nothing. */
+			bitband_periph_clear(&LD2_GPIO_Port->ODR, LD2_BIT);
 		}
 
 		vTaskDelay(_50ms);
@@ -117,7 +195,7 @@ void vRedLedControllerTask(void *pvParameters)
 		Red_TaskProfiler++;
 		for (int i = 0; i < 1000000; i++)
 		{
-			/* Do nothing. */
+			bitband_periph_set(&LD2_GPIO_Port->ODR, LD2_BIT);
 		}
 
 		vTaskDelay(_50ms);
@@ -131,7 +209,7 @@ void vGreenLedControllerTask(void *pvParameters)
 		Green_TaskProfiler++;
 		for (int i = 0; i < 1000000; i++)
 		{
-			/* Do nothing. */
+			bitband_periph_clear(&LD2_GPIO_Port->ODR, LD2_BIT);
 		}
 
 		vTaskDelay(_50ms);
@@ -145,7 +223,7 @@ void vBlueLedControllerTask(void *pvParameters)
 		Blue_TaskProfiler++;
 		for (int i = 0; i < 1000000; i++)
 		{
-			/* Do nothing. */
+			bitband_periph_clear(&LD2_GPIO_Port->ODR, LD2_BIT);
 		}
 
 		vTaskDelay(_50ms);
@@ -158,44 +236,9 @@ void vBlueLedControllerTask(void *pvParameters)
  */
 void SystemClock_Config(void)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
-
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-	{
-		Error_Handler();
-	}
-
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
@@ -0,0 +1,297 @@
+/*******************************************************************************
+ *
+ * @file	runstats.c
+ * @brief	Run-time stats backend on the DWT cycle counter (CYCCNT).
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Enabled from the 'USER CODE BEGIN Defines' section of
+ * 			'FreeRTOSConfig.h':
+ *
+ * 				configGENERATE_RUN_TIME_STATS 1
+ * 				configRUN_TIME_COUNTER_TYPE uint64_t
+ * 				portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() runstats_timer_init()
+ * 				portGET_RUN_TIME_COUNTER_VALUE() runstats_get_counter()
+ *
+ * 			CYCCNT is 32 bits wide and wraps every 2^32 / 84 MHz = 51 s. It is
+ * 			extended to 64 bits in software by counting the wraps each time it
+ * 			is read. The kernel reads it on every context switch, so a wrap
+ * 			is only missed if one task runs for over 51 s without a switch.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "runstats.h"
+#if (RUNSTATS_IRQ_PROFILE == 1)
+#include "irq.h"
+#endif
+
+/* Macros --------------------------------------------------------------------*/
+#define RUNSTATS_U64_DIGITS 21U		/* 20 digits for 2^64 - 1, plus NUL. */
+
+/* Variables -----------------------------------------------------------------*/
+static uint32_t ulLastCyccnt = 0;
+static uint64_t ullCounterHigh = 0;	/* Wraps of CYCCNT plus any advance. */
+
+/* Private function prototypes -----------------------------------------------*/
+static const char *runstats_u64_to_str(uint64_t ullValue, char *pcBuffer);
+static void runstats_reporter_task(void *pvParameters);
+#if (RUNSTATS_IRQ_PROFILE == 1)
+static void runstats_print_irqs(uint64_t ullTotalRunTime);
+#endif
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Starts the DWT cycle counter (portCONFIGURE_TIMER_FOR_RUN_TIME_STATS).
+ * @param None
+ * @retval None
+ */
+void runstats_timer_init(void)
+{
+	/* Enable the trace and debug blocks, DWT included. */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+	DWT->CYCCNT = 0;
+	ulLastCyccnt = 0;
+	ullCounterHigh = 0;
+
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief Returns the cycle count extended to 64 bits
+ * (portGET_RUN_TIME_COUNTER_VALUE).
+ * @param None
+ * @retval Core clock cycles since runstats_timer_init().
+ * @note Called from the context switch (with interrupts masked up to
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY) and from tasks, so the wrap check is
+ * made under the same mask.
+ */
+uint64_t runstats_get_counter(void)
+{
+	UBaseType_t uxSavedInterruptStatus;
+	uint32_t ulNow;
+	uint64_t ullCounter;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+	ulNow = DWT->CYCCNT;
+
+	if (ulNow < ulLastCyccnt)
+	{
+		ullCounterHigh += (1ULL << 32);
+	}
+
+	ulLastCyccnt = ulNow;
+	ullCounter = ullCounterHigh + ulNow;
+
+	portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+
+	return ullCounter;
+}
+
+/**
+ * @brief Adds cycles the counter could not see.
+ * @param ullCycles Core clock cycles to add.
+ * @retval None
+ * @note CYCCNT stops with the core clock in STOP mode. The tickless idle code
+ * calls this with the time slept, so it is charged to the idle task.
+ */
+void runstats_advance(uint64_t ullCycles)
+{
+	UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	ullCounterHigh += ullCycles;
+	portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+}
+
+/**
+ * @brief Prints the cycles and CPU share of every task over USART2.
+ * @param None
+ * @retval None
+ * @note Like vTaskGetRunTimeStats(), but without the sprintf() buffer, with
+ * 64-bit counters and with the share to 0.01%. With configUSE_SWITCH_STATS,
+ * each task also shows the switches away from it that it asked for
+ * (voluntary) and those it did not (involuntary), and the total line the
+ * switches of all tasks. With RUNSTATS_IRQ_PROFILE, the timed interrupts
+ * follow, with their share of the same total. The cycles of a task include
+ * those of the interrupts that broke into it, so the shares of the tasks and
+ * of the interrupts overlap rather than add up to 100%.
+ */
+void runstats_print(void)
+{
+	TaskStatus_t *pxTaskStatusArray;
+	UBaseType_t uxArraySize;
+	UBaseType_t x;
+	uint64_t ullTotalRunTime;
+	uint32_t ulShare;
+	char cDigits[RUNSTATS_U64_DIGITS];
+
+	/* Allow for a task being created between the two calls. */
+	uxArraySize = uxTaskGetNumberOfTasks() + 1U;
+	pxTaskStatusArray = pvPortMalloc(uxArraySize * sizeof(TaskStatus_t));
+
+	if (pxTaskStatusArray == NULL)
+	{
+		printf("Error: Run-time stats could not be allocated.\r\n");
+		return;
+	}
+
+	uxArraySize = uxTaskGetSystemState(pxTaskStatusArray, uxArraySize, &ullTotalRunTime);
+
+#if (configUSE_SWITCH_STATS == 1)
+	printf("%-*s %20s %8s %10s %10s\r\n", configMAX_TASK_NAME_LEN, "Task", "Cycles", "CPU",
+			"Voluntary", "Involuntary");
+#else
+	printf("%-*s %20s %8s\r\n", configMAX_TASK_NAME_LEN, "Task", "Cycles", "CPU");
+#endif
+
+	for (x = 0; x < uxArraySize; x++)
+	{
+		/* Share in units of 0.01%. */
+		ulShare = (ullTotalRunTime > 0U) ?
+				(uint32_t)((pxTaskStatusArray[x].ulRunTimeCounter * 10000U) / ullTotalRunTime) : 0U;
+
+#if (configUSE_SWITCH_STATS == 1)
+		printf("%-*s %20s %4lu.%02lu%% %10lu %10lu\r\n",
+				configMAX_TASK_NAME_LEN,
+				pxTaskStatusArray[x].pcTaskName,
+				runstats_u64_to_str(pxTaskStatusArray[x].ulRunTimeCounter, cDigits),
+				ulShare / 100U,
+				ulShare % 100U,
+				pxTaskStatusArray[x].ulVoluntarySwitches,
+				pxTaskStatusArray[x].ulInvoluntarySwitches);
+#else
+		printf("%-*s %20s %4lu.%02lu%%\r\n",
+				configMAX_TASK_NAME_LEN,
+				pxTaskStatusArray[x].pcTaskName,
+				runstats_u64_to_str(pxTaskStatusArray[x].ulRunTimeCounter, cDigits),
+				ulShare / 100U,
+				ulShare % 100U);
+#endif
+	}
+
+#if (configUSE_SWITCH_STATS == 1)
+	printf("%-*s %20s %8s %21lu\r\n", configMAX_TASK_NAME_LEN, "Total",
+			runstats_u64_to_str(ullTotalRunTime, cDigits), "", ulTaskGetSwitchCount());
+#else
+	printf("%-*s %20s\r\n", configMAX_TASK_NAME_LEN, "Total",
+			runstats_u64_to_str(ullTotalRunTime, cDigits));
+#endif
+
+#if (RUNSTATS_IRQ_PROFILE == 1)
+	runstats_print_irqs(ullTotalRunTime);
+#endif
+
+	vPortFree(pxTaskStatusArray);
+}
+
+/**
+ * @brief Creates a task that prints the run-time stats periodically.
+ * @param ulPeriodMs Print period in milliseconds.
+ * @param uxPriority Priority of the reporter task. Above the tasks being
+ * measured if they never block.
+ * @retval pdPASS if the task was created.
+ */
+BaseType_t runstats_start_reporter(uint32_t ulPeriodMs, UBaseType_t uxPriority)
+{
+	return xTaskCreate(runstats_reporter_task,
+					   "RunStats",
+					   RUNSTATS_REPORTER_STACK_WORDS,
+					   (void *)ulPeriodMs,
+					   uxPriority,
+					   NULL);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Formats a 64-bit value in decimal (newlib-nano printf lacks %llu).
+ * @param ullValue Value to format.
+ * @param pcBuffer Buffer of RUNSTATS_U64_DIGITS characters.
+ * @retval Pointer to the first digit within pcBuffer.
+ */
+static const char *runstats_u64_to_str(uint64_t ullValue, char *pcBuffer)
+{
+	char *pcDigit = &pcBuffer[RUNSTATS_U64_DIGITS - 1U];
+
+	*pcDigit = '\0';
+
+	do
+	{
+		*--pcDigit = (char)('0' + (ullValue % 10U));
+		ullValue /= 10U;
+	} while (ullValue > 0U);
+
+	return pcDigit;
+}
+
+#if (RUNSTATS_IRQ_PROFILE == 1)
+/**
+ * @brief Prints the cycles, CPU share, runs, longest run, deepest nesting and
+ * preemptions of every timed interrupt.
+ * @param ullTotalRunTime Total of the task table, for the share.
+ * @retval None
+ */
+static void runstats_print_irqs(uint64_t ullTotalRunTime)
+{
+	IrqProfile_t xProfile;
+	uint64_t ullIrqCycles = 0U;
+	uint32_t ulShare;
+	uint32_t i;
+	char cDigits[RUNSTATS_U64_DIGITS];
+
+	printf("%-*s %20s %8s %10s %10s %5s %10s\r\n", configMAX_TASK_NAME_LEN, "Interrupt",
+			"Cycles", "CPU", "Runs", "Max", "Depth", "Preempted");
+
+	for (i = 0U; i < IRQ_PROFILE_SLOTS; i++)
+	{
+		if (irq_profile_read(i, &xProfile) != 0)
+		{
+			continue;
+		}
+
+		ullIrqCycles += xProfile.ullCycles;
+		ulShare = (ullTotalRunTime > 0U) ?
+				(uint32_t)((xProfile.ullCycles * 10000U) / ullTotalRunTime) : 0U;
+
+		printf("%-*s %20s %4lu.%02lu%% %10lu %10lu %5lu %10lu\r\n",
+				configMAX_TASK_NAME_LEN,
+				xProfile.pcName,
+				runstats_u64_to_str(xProfile.ullCycles, cDigits),
+				ulShare / 100U,
+				ulShare % 100U,
+				xProfile.ulCount,
+				xProfile.ulMaxCycles,
+				xProfile.ulMaxDepth,
+				xProfile.ulPreempted);
+	}
+
+	ulShare = (ullTotalRunTime > 0U) ? (uint32_t)((ullIrqCycles * 10000U) / ullTotalRunTime) : 0U;
+
+	printf("%-*s %20s %4lu.%02lu%%\r\n", configMAX_TASK_NAME_LEN, "Total",
+			runstats_u64_to_str(ullIrqCycles, cDigits), ulShare / 100U, ulShare % 100U);
+}
+#endif
+
+/**
+ * @brief Prints the run-time stats every period.
+ * @param pvParameters Print period in milliseconds.
+ * @retval None
+ */
+static void runstats_reporter_task(void *pvParameters)
+{
+	const TickType_t xPeriodTicks = pdMS_TO_TICKS((uint32_t)pvParameters);
+	TickType_t xLastWakeTicks = xTaskGetTickCount();
+
+	while (1)
+	{
+		vTaskDelayUntil(&xLastWakeTicks, xPeriodTicks);
+		runstats_print();
+	}
+}
@@ -0,0 +1,703 @@
+/*******************************************************************************
+ *
+ * @file	telemetry.c
+ * @brief	Binary telemetry stream of kernel and system metrics.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	A low-priority task samples, at a fixed rate, the run time and
+ * 			stack high-water mark of every task, the free and least ever
+ * 			free heap, the depth of the queues given to
+ * 			telemetry_add_queue() and the counters given to
+ * 			telemetry_add_counter(). Each sample is one frame (frame.c,
+ * 			COBS with a CRC-32 trailer), written to the UART TX DMA ring or
+ * 			to an ITM stimulus port. 'Tools/telemetry_decode.py' decodes
+ * 			the stream on the host.
+ *
+ * 			Every frame starts with a 10-byte header, little-endian:
+ *
+ * 				u8 version, u8 type, u8 schema, u8 channels,
+ * 				u16 sequence, u32 tick count
+ *
+ * 			A sample is one 32-bit value per channel. A key frame carries
+ * 			them as varints (7 bits per byte, LSB first). A delta frame
+ * 			carries the difference from the previous sample, zigzag-encoded
+ * 			first, so most channels take a byte and a run-time counter
+ * 			three. Every TELEMETRY_KEY_INTERVAL samples, and after a frame
+ * 			the output dropped, the frame is a key frame: the decoder only
+ * 			applies a delta frame whose sequence follows the last one.
+ *
+ * 			The schema frames name the channels: the tick and run-time
+ * 			counter rates (u32 each), the index of the first channel in the
+ * 			frame (u8), then per channel its kind (u8), a varint parameter
+ * 			(task number, queue length) and its name (u8 length, bytes).
+ * 			They are sent when the set of tasks or channels changes, with a
+ * 			new schema number, and every TELEMETRY_SCHEMA_INTERVAL samples
+ * 			for a decoder that starts late.
+ *
+ * 			uxTaskGetSystemState() suspends the scheduler while it walks
+ * 			the task lists and stacks, for roughly the free stack of all
+ * 			tasks in bytes times a few cycles. Interrupts are not masked.
+ * 			The run-time counters are sent as their low 32 bits, so the
+ * 			period must stay below their wrap time (23 s at 180 MHz).
+ *
+ * 			The output must have no other writer, or the bytes of both
+ * 			interleave and the decoder drops the frames they land in.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "frame.h"
+#include "telemetry.h"
+#if (TELEMETRY_BACKEND == TELEMETRY_BACKEND_ITM)
+#include "itm.h"
+#else
+#include "uart.h"
+#endif
+
+/* Macros --------------------------------------------------------------------*/
+#if (configGENERATE_RUN_TIME_STATS == 1)
+#define TELEMETRY_RUNTIME_CHANNELS 1U	/* Total, and per task. */
+#else
+#define TELEMETRY_RUNTIME_CHANNELS 0U
+#endif
+
+#define TELEMETRY_TASK_CHANNELS (TELEMETRY_RUNTIME_CHANNELS + 1U)
+#define TELEMETRY_MAX_CHANNELS (TELEMETRY_RUNTIME_CHANNELS \
+		+ (TELEMETRY_TASK_CHANNELS * TELEMETRY_MAX_TASKS) + 2U \
+		+ TELEMETRY_MAX_QUEUES + TELEMETRY_MAX_COUNTERS)
+
+#if (TELEMETRY_MAX_CHANNELS > 255U)
+#error TELEMETRY_MAX_TASKS, _QUEUES and _COUNTERS give over 255 channels
+#endif
+
+#define TELEMETRY_HEADER_LEN 10U
+#define TELEMETRY_VARINT_MAX 5U			/* Bytes of a varint of 32 bits. */
+#define TELEMETRY_NAME_LEN configMAX_TASK_NAME_LEN	/* Longer names are cut. */
+#define TELEMETRY_SCHEMA_LEN 9U			/* Rates and first channel. */
+#define TELEMETRY_ENTRY_MAX (2U + TELEMETRY_VARINT_MAX + TELEMETRY_NAME_LEN)
+
+/* A sample of every channel fits one frame, and so does a schema entry. */
+#define TELEMETRY_PAYLOAD_SIZE (TELEMETRY_HEADER_LEN \
+		+ (TELEMETRY_VARINT_MAX * TELEMETRY_MAX_CHANNELS) \
+		+ TELEMETRY_SCHEMA_LEN + TELEMETRY_ENTRY_MAX)
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	QueueHandle_t xQueue;
+	const char *pcName;
+} TelemetryQueue_t;
+
+typedef struct
+{
+	const volatile uint32_t *pulCounter;
+	const char *pcName;
+} TelemetryCounter_t;
+
+/* Variables -----------------------------------------------------------------*/
+static TelemetryQueue_t xTelemetryQueues[TELEMETRY_MAX_QUEUES];
+static TelemetryCounter_t xTelemetryCounters[TELEMETRY_MAX_COUNTERS];
+static volatile UBaseType_t uxTelemetryQueueCount = 0;
+static volatile UBaseType_t uxTelemetryCounterCount = 0;
+
+/* Owned by the sampling task. */
+static TaskStatus_t xTelemetryTasks[TELEMETRY_MAX_TASKS];
+static UBaseType_t uxTelemetryTaskNumbers[TELEMETRY_MAX_TASKS];	/* Of the schema. */
+static UBaseType_t uxTelemetryTaskCount = 0;
+static UBaseType_t uxTelemetrySchemaQueues = 0;
+static UBaseType_t uxTelemetrySchemaCounters = 0;
+static UBaseType_t uxTelemetrySampleQueues = 0;	/* Read by the last snapshot. */
+static UBaseType_t uxTelemetrySampleCounters = 0;
+static uint32_t ulTelemetryValues[TELEMETRY_MAX_CHANNELS];
+static uint32_t ulTelemetryPrevious[TELEMETRY_MAX_CHANNELS];
+static uint8_t ucTelemetryPayload[TELEMETRY_PAYLOAD_SIZE];
+static uint8_t ucTelemetryFrame[FRAME_COBS_MAX_ENCODED(TELEMETRY_PAYLOAD_SIZE)];
+static uint8_t ucTelemetrySchema = 0;
+static uint8_t ucTelemetryChannels = 0;
+static uint16_t usTelemetrySequence = 0;
+static uint32_t ulTelemetrySinceKey = 0;
+static uint32_t ulTelemetrySinceSchema = 0;
+static BaseType_t xTelemetryNeedSchema = pdTRUE;
+static BaseType_t xTelemetryNeedKey = pdTRUE;
+
+static volatile TickType_t xTelemetryPeriodTicks = 0;
+static TelemetryStats_t xTelemetryStats;
+
+/* Private function prototypes -----------------------------------------------*/
+static void telemetry_task(void *pvParameters);
+static void telemetry_sample(void);
+static UBaseType_t telemetry_snapshot(void);
+static BaseType_t telemetry_schema_changed(UBaseType_t uxTasks);
+static void telemetry_send_schema(void);
+static uint32_t telemetry_entry(uint8_t *pucOut, UBaseType_t uxChannel);
+static uint32_t telemetry_header(uint8_t ucType);
+static uint32_t telemetry_put_varint(uint8_t *pucOut, uint32_t ulValue);
+static uint32_t telemetry_put_name(uint8_t *pucOut, const char *pcName);
+static BaseType_t telemetry_emit(uint32_t ulLen);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Adds the depth of a queue, semaphore or mutex to the samples.
+ * @param xQueue Queue to sample. It must not be deleted afterwards.
+ * @param pcName Channel name, kept by reference.
+ * @retval 0 if successful, -1 if invalid or TELEMETRY_MAX_QUEUES are in use.
+ * @note From tasks, before or after telemetry_start(). The next sample sends a
+ * new schema.
+ */
+int32_t telemetry_add_queue(QueueHandle_t xQueue, const char *pcName)
+{
+	int32_t lResult = -1;
+
+	if ((xQueue == NULL) || (pcName == NULL))
+	{
+		return -1;
+	}
+
+	taskENTER_CRITICAL();
+
+	if (uxTelemetryQueueCount < TELEMETRY_MAX_QUEUES)
+	{
+		xTelemetryQueues[uxTelemetryQueueCount].xQueue = xQueue;
+		xTelemetryQueues[uxTelemetryQueueCount].pcName = pcName;
+		uxTelemetryQueueCount++;
+		lResult = 0;
+	}
+
+	taskEXIT_CRITICAL();
+
+	return lResult;
+}
+
+/**
+ * @brief Adds an application counter to the samples.
+ * @param pcName Channel name, kept by reference.
+ * @param pulCounter Counter, read once per sample without a lock.
+ * @retval 0 if successful, -1 if invalid or TELEMETRY_MAX_COUNTERS are in use.
+ * @note From tasks, before or after telemetry_start(). The next sample sends a
+ * new schema.
+ */
+int32_t telemetry_add_counter(const char *pcName, const volatile uint32_t *pulCounter)
+{
+	int32_t lResult = -1;
+
+	if ((pulCounter == NULL) || (pcName == NULL))
+	{
+		return -1;
+	}
+
+	taskENTER_CRITICAL();
+
+	if (uxTelemetryCounterCount < TELEMETRY_MAX_COUNTERS)
+	{
+		xTelemetryCounters[uxTelemetryCounterCount].pulCounter = pulCounter;
+		xTelemetryCounters[uxTelemetryCounterCount].pcName = pcName;
+		uxTelemetryCounterCount++;
+		lResult = 0;
+	}
+
+	taskEXIT_CRITICAL();
+
+	return lResult;
+}
+
+/**
+ * @brief Creates the sampling task.
+ * @param ulRateHz Samples per second, 1 to configTICK_RATE_HZ.
+ * @param uxPriority Priority of the sampling task, below the real-time tasks.
+ * @retval pdPASS if the task was created.
+ * @note The output must be set up first: the UART port opened with a TX ring,
+ * or ITM_SWO_Init(). frame.c needs crc_init().
+ */
+BaseType_t telemetry_start(uint32_t ulRateHz, UBaseType_t uxPriority)
+{
+	if (telemetry_set_rate(ulRateHz) != 0)
+	{
+		return pdFAIL;
+	}
+
+	return xTaskCreate(telemetry_task,
+					   "Telemetry",
+					   TELEMETRY_STACK_WORDS,
+					   NULL,
+					   uxPriority,
+					   NULL);
+}
+
+/**
+ * @brief Changes the sample rate.
+ * @param ulRateHz Samples per second, 1 to configTICK_RATE_HZ. Rounded to a
+ * whole number of ticks per sample.
+ * @retval 0 if successful, -1 if out of range.
+ * @note Takes effect after the next sample.
+ */
+int32_t telemetry_set_rate(uint32_t ulRateHz)
+{
+	if ((ulRateHz == 0U) || (ulRateHz > configTICK_RATE_HZ))
+	{
+		return -1;
+	}
+
+	xTelemetryPeriodTicks = (TickType_t)(configTICK_RATE_HZ / ulRateHz);
+
+	return 0;
+}
+
+/**
+ * @brief Copies the statistics of the stream.
+ * @param pxStats Statistics output.
+ * @retval None
+ */
+void telemetry_get_stats(TelemetryStats_t *pxStats)
+{
+	taskENTER_CRITICAL();
+	*pxStats = xTelemetryStats;
+	taskEXIT_CRITICAL();
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Samples every period.
+ * @param pvParameters Not used.
+ * @retval None
+ */
+static void telemetry_task(void *pvParameters)
+{
+	TickType_t xLastWakeTicks = xTaskGetTickCount();
+
+	(void)pvParameters;
+
+	while (1)
+	{
+		vTaskDelayUntil(&xLastWakeTicks, xTelemetryPeriodTicks);
+		telemetry_sample();
+	}
+}
+
+/**
+ * @brief Takes one sample and sends it, after the schema if it changed.
+ * @param None
+ * @retval None
+ */
+static void telemetry_sample(void)
+{
+	UBaseType_t uxTasks;
+	UBaseType_t uxChannel;
+	uint32_t ulDiff;
+	uint32_t ulLen;
+	uint8_t ucType;
+
+	uxTasks = telemetry_snapshot();
+
+	if (telemetry_schema_changed(uxTasks) != pdFALSE)
+	{
+		ucTelemetrySchema++;
+		xTelemetryNeedSchema = pdTRUE;
+	}
+
+	if ((xTelemetryNeedSchema != pdFALSE) || (ulTelemetrySinceSchema >= TELEMETRY_SCHEMA_INTERVAL))
+	{
+		telemetry_send_schema();
+		ulTelemetrySinceSchema = 0;
+		xTelemetryNeedSchema = pdFALSE;
+		xTelemetryNeedKey = pdTRUE;
+	}
+
+	ucType = ((xTelemetryNeedKey != pdFALSE) || (ulTelemetrySinceKey >= TELEMETRY_KEY_INTERVAL)) ?
+			TELEMETRY_FRAME_KEY : TELEMETRY_FRAME_DELTA;
+
+	ulLen = telemetry_header(ucType);
+
+	for (uxChannel = 0; uxChannel < ucTelemetryChannels; uxChannel++)
+	{
+		if (ucType == TELEMETRY_FRAME_KEY)
+		{
+			ulLen += telemetry_put_varint(&ucTelemetryPayload[ulLen], ulTelemetryValues[uxChannel]);
+		}
+		else
+		{
+			/* Zigzag: small differences of either sign take few bytes. */
+			ulDiff = ulTelemetryValues[uxChannel] - ulTelemetryPrevious[uxChannel];
+			ulDiff = (ulDiff << 1) ^ (uint32_t)((int32_t)ulDiff >> 31);
+			ulLen += telemetry_put_varint(&ucTelemetryPayload[ulLen], ulDiff);
+		}
+
+		ulTelemetryPrevious[uxChannel] = ulTelemetryValues[uxChannel];
+	}
+
+	if (telemetry_emit(ulLen) != pdFALSE)
+	{
+		ulTelemetrySinceKey = (ucType == TELEMETRY_FRAME_KEY) ? 1U : (ulTelemetrySinceKey + 1U);
+		xTelemetryNeedKey = pdFALSE;
+	}
+	else
+	{
+		/* The decoder lost this frame, so the next delta would not apply. */
+		xTelemetryNeedKey = pdTRUE;
+	}
+
+	ulTelemetrySinceSchema++;
+
+	taskENTER_CRITICAL();
+	xTelemetryStats.ulSamples++;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Reads every channel into ulTelemetryValues, in schema order.
+ * @param None
+ * @retval Number of tasks in xTelemetryTasks, sorted by task number.
+ */
+static UBaseType_t telemetry_snapshot(void)
+{
+	configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0;
+	TaskStatus_t xTask;
+	UBaseType_t uxTasks;
+	UBaseType_t uxCount;
+	UBaseType_t x;
+	UBaseType_t y;
+	uint32_t ulChannel = 0;
+
+	uxTasks = uxTaskGetSystemState(xTelemetryTasks, TELEMETRY_MAX_TASKS, &ulTotalRunTime);
+
+	if (uxTasks == 0U)
+	{
+		/* More tasks than the array holds: report the other channels. */
+		taskENTER_CRITICAL();
+		xTelemetryStats.ulTaskOverflows++;
+		taskEXIT_CRITICAL();
+	}
+
+	/* Insertion sort: the kernel lists them by state, not in a fixed order. */
+	for (x = 1; x < uxTasks; x++)
+	{
+		xTask = xTelemetryTasks[x];
+
+		for (y = x; (y > 0U) && (xTelemetryTasks[y - 1U].xTaskNumber > xTask.xTaskNumber); y--)
+		{
+			xTelemetryTasks[y] = xTelemetryTasks[y - 1U];
+		}
+
+		xTelemetryTasks[y] = xTask;
+	}
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+	ulTelemetryValues[ulChannel++] = (uint32_t)ulTotalRunTime;
+#endif
+
+	for (x = 0; x < uxTasks; x++)
+	{
+#if (configGENERATE_RUN_TIME_STATS == 1)
+		ulTelemetryValues[ulChannel++] = (uint32_t)xTelemetryTasks[x].ulRunTimeCounter;
+#endif
+		ulTelemetryValues[ulChannel++] = (uint32_t)xTelemetryTasks[x].usStackHighWaterMark;
+	}
+
+	ulTelemetryValues[ulChannel++] = (uint32_t)xPortGetFreeHeapSize();
+	ulTelemetryValues[ulChannel++] = (uint32_t)xPortGetMinimumEverFreeHeapSize();
+
+	uxCount = uxTelemetryQueueCount;
+	uxTelemetrySampleQueues = uxCount;
+
+	for (x = 0; x < uxCount; x++)
+	{
+		ulTelemetryValues[ulChannel++] = (uint32_t)uxQueueMessagesWaiting(xTelemetryQueues[x].xQueue);
+	}
+
+	uxCount = uxTelemetryCounterCount;
+	uxTelemetrySampleCounters = uxCount;
+
+	for (x = 0; x < uxCount; x++)
+	{
+		ulTelemetryValues[ulChannel++] = *xTelemetryCounters[x].pulCounter;
+	}
+
+	return uxTasks;
+}
+
+/**
+ * @brief Checks the snapshot against the last schema, and adopts it if it
+ * differs.
+ * @param uxTasks Number of tasks in the snapshot.
+ * @retval pdTRUE if a task, queue or counter came or went.
+ * @note Compares the queue and counter counts the snapshot read, so one added
+ * since then waits for the next sample.
+ */
+static BaseType_t telemetry_schema_changed(UBaseType_t uxTasks)
+{
+	BaseType_t xChanged = pdFALSE;
+	UBaseType_t x;
+
+	if (uxTasks != uxTelemetryTaskCount)
+	{
+		xChanged = pdTRUE;
+	}
+
+	for (x = 0; (x < uxTasks) && (xChanged == pdFALSE); x++)
+	{
+		if (xTelemetryTasks[x].xTaskNumber != uxTelemetryTaskNumbers[x])
+		{
+			xChanged = pdTRUE;
+		}
+	}
+
+	if ((uxTelemetrySampleQueues != uxTelemetrySchemaQueues)
+			|| (uxTelemetrySampleCounters != uxTelemetrySchemaCounters))
+	{
+		xChanged = pdTRUE;
+	}
+
+	if (xChanged != pdFALSE)
+	{
+		for (x = 0; x < uxTasks; x++)
+		{
+			uxTelemetryTaskNumbers[x] = xTelemetryTasks[x].xTaskNumber;
+		}
+
+		uxTelemetryTaskCount = uxTasks;
+		uxTelemetrySchemaQueues = uxTelemetrySampleQueues;
+		uxTelemetrySchemaCounters = uxTelemetrySampleCounters;
+		ucTelemetryChannels = (uint8_t)(TELEMETRY_RUNTIME_CHANNELS + (uxTasks * TELEMETRY_TASK_CHANNELS)
+				+ 2U + uxTelemetrySampleQueues + uxTelemetrySampleCounters);
+	}
+
+	return xChanged;
+}
+
+/**
+ * @brief Sends the schema, in as many frames as it takes.
+ * @param None
+ * @retval None
+ * @note The task names are read from the snapshot just taken.
+ */
+static void telemetry_send_schema(void)
+{
+	uint8_t ucEntry[TELEMETRY_ENTRY_MAX];
+	UBaseType_t uxChannel = 0;
+	uint32_t ulEntryLen;
+	uint32_t ulLen;
+	uint32_t ulRateHz;
+
+	do
+	{
+		ulLen = telemetry_header(TELEMETRY_FRAME_SCHEMA);
+
+		ulRateHz = configTICK_RATE_HZ;
+		ucTelemetryPayload[ulLen++] = (uint8_t)ulRateHz;
+		ucTelemetryPayload[ulLen++] = (uint8_t)(ulRateHz >> 8);
+		ucTelemetryPayload[ulLen++] = (uint8_t)(ulRateHz >> 16);
+		ucTelemetryPayload[ulLen++] = (uint8_t)(ulRateHz >> 24);
+
+		/* runstats.c counts core clock cycles. */
+#if (configGENERATE_RUN_TIME_STATS == 1)
+		ulRateHz = configCPU_CLOCK_HZ;
+#else
+		ulRateHz = 0;
+#endif
+		ucTelemetryPayload[ulLen++] = (uint8_t)ulRateHz;
+		ucTelemetryPayload[ulLen++] = (uint8_t)(ulRateHz >> 8);
+		ucTelemetryPayload[ulLen++] = (uint8_t)(ulRateHz >> 16);
+		ucTelemetryPayload[ulLen++] = (uint8_t)(ulRateHz >> 24);
+
+		ucTelemetryPayload[ulLen++] = (uint8_t)uxChannel;
+
+		while (uxChannel < ucTelemetryChannels)
+		{
+			ulEntryLen = telemetry_entry(ucEntry, uxChannel);
+
+			if ((ulLen + ulEntryLen) > TELEMETRY_PAYLOAD_SIZE)
+			{
+				break;
+			}
+
+			memcpy(&ucTelemetryPayload[ulLen], ucEntry, ulEntryLen);
+			ulLen += ulEntryLen;
+			uxChannel++;
+		}
+
+		(void)telemetry_emit(ulLen);
+
+		taskENTER_CRITICAL();
+		xTelemetryStats.ulSchemas++;
+		taskEXIT_CRITICAL();
+	} while (uxChannel < ucTelemetryChannels);
+}
+
+/**
+ * @brief Writes the schema entry of one channel.
+ * @param pucOut Output, TELEMETRY_ENTRY_MAX bytes.
+ * @param uxChannel Channel index.
+ * @retval Bytes written.
+ */
+static uint32_t telemetry_entry(uint8_t *pucOut, UBaseType_t uxChannel)
+{
+	UBaseType_t uxTask;
+	uint32_t ulLen = 1;
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+	if (uxChannel == 0U)
+	{
+		pucOut[0] = TELEMETRY_KIND_RUNTIME;
+		ulLen += telemetry_put_varint(&pucOut[ulLen], 0);
+		return ulLen + telemetry_put_name(&pucOut[ulLen], "total");
+	}
+
+	uxChannel -= TELEMETRY_RUNTIME_CHANNELS;
+#endif
+
+	if (uxChannel < (uxTelemetryTaskCount * TELEMETRY_TASK_CHANNELS))
+	{
+		uxTask = uxChannel / TELEMETRY_TASK_CHANNELS;
+		pucOut[0] = ((uxChannel % TELEMETRY_TASK_CHANNELS) == (TELEMETRY_TASK_CHANNELS - 1U)) ?
+				TELEMETRY_KIND_TASK_STACK : TELEMETRY_KIND_TASK_RUNTIME;
+		ulLen += telemetry_put_varint(&pucOut[ulLen], (uint32_t)xTelemetryTasks[uxTask].xTaskNumber);
+		return ulLen + telemetry_put_name(&pucOut[ulLen], xTelemetryTasks[uxTask].pcTaskName);
+	}
+
+	uxChannel -= uxTelemetryTaskCount * TELEMETRY_TASK_CHANNELS;
+
+	if (uxChannel < 2U)
+	{
+		pucOut[0] = (uxChannel == 0U) ? TELEMETRY_KIND_HEAP_FREE : TELEMETRY_KIND_HEAP_MIN;
+		ulLen += telemetry_put_varint(&pucOut[ulLen], (uint32_t)configTOTAL_HEAP_SIZE);
+		return ulLen + telemetry_put_name(&pucOut[ulLen], "heap");
+	}
+
+	uxChannel -= 2U;
+
+	if (uxChannel < uxTelemetrySchemaQueues)
+	{
+		pucOut[0] = TELEMETRY_KIND_QUEUE_DEPTH;
+		ulLen += telemetry_put_varint(&pucOut[ulLen],
+				(uint32_t)(uxQueueMessagesWaiting(xTelemetryQueues[uxChannel].xQueue)
+						+ uxQueueSpacesAvailable(xTelemetryQueues[uxChannel].xQueue)));
+		return ulLen + telemetry_put_name(&pucOut[ulLen], xTelemetryQueues[uxChannel].pcName);
+	}
+
+	uxChannel -= uxTelemetrySchemaQueues;
+
+	pucOut[0] = TELEMETRY_KIND_COUNTER;
+	ulLen += telemetry_put_varint(&pucOut[ulLen], 0);
+	return ulLen + telemetry_put_name(&pucOut[ulLen], xTelemetryCounters[uxChannel].pcName);
+}
+
+/**
+ * @brief Starts a frame in ucTelemetryPayload.
+ * @param ucType TELEMETRY_FRAME_ type.
+ * @retval Header length.
+ */
+static uint32_t telemetry_header(uint8_t ucType)
+{
+	TickType_t xNow = xTaskGetTickCount();
+
+	ucTelemetryPayload[0] = TELEMETRY_VERSION;
+	ucTelemetryPayload[1] = ucType;
+	ucTelemetryPayload[2] = ucTelemetrySchema;
+	ucTelemetryPayload[3] = ucTelemetryChannels;
+	ucTelemetryPayload[4] = (uint8_t)usTelemetrySequence;
+	ucTelemetryPayload[5] = (uint8_t)(usTelemetrySequence >> 8);
+	ucTelemetryPayload[6] = (uint8_t)xNow;
+	ucTelemetryPayload[7] = (uint8_t)(xNow >> 8);
+	ucTelemetryPayload[8] = (uint8_t)(xNow >> 16);
+	ucTelemetryPayload[9] = (uint8_t)(xNow >> 24);
+
+	usTelemetrySequence++;
+
+	return TELEMETRY_HEADER_LEN;
+}
+
+/**
+ * @brief Writes an unsigned varint.
+ * @param pucOut Output, TELEMETRY_VARINT_MAX bytes.
+ * @param ulValue Value.
+ * @retval Bytes written, 1 to 5.
+ */
+static uint32_t telemetry_put_varint(uint8_t *pucOut, uint32_t ulValue)
+{
+	uint32_t ulLen = 0;
+
+	while (ulValue >= 0x80U)
+	{
+		pucOut[ulLen++] = (uint8_t)(ulValue | 0x80U);
+		ulValue >>= 7;
+	}
+
+	pucOut[ulLen++] = (uint8_t)ulValue;
+
+	return ulLen;
+}
+
+/**
+ * @brief Writes a name as a length byte and up to TELEMETRY_NAME_LEN bytes.
+ * @param pucOut Output, TELEMETRY_NAME_LEN + 1 bytes.
+ * @param pcName NUL-terminated name.
+ * @retval Bytes written.
+ */
+static uint32_t telemetry_put_name(uint8_t *pucOut, const char *pcName)
+{
+	uint32_t ulLen = 0;
+
+	while ((ulLen < TELEMETRY_NAME_LEN) && (pcName[ulLen] != '\0'))
+	{
+		pucOut[1U + ulLen] = (uint8_t)pcName[ulLen];
+		ulLen++;
+	}
+
+	pucOut[0] = (uint8_t)ulLen;
+
+	return ulLen + 1U;
+}
+
+/**
+ * @brief Frames ucTelemetryPayload and writes it to the output.
+ * @param ulLen Payload length.
+ * @retval pdTRUE if the output took the whole frame.
+ * @note The UART write waits for ring space for up to a period, so a slow link
+ * delays the next sample instead of tearing this frame.
+ */
+static BaseType_t telemetry_emit(uint32_t ulLen)
+{
+	int32_t lFrameLen;
+	BaseType_t xSent;
+#if (TELEMETRY_BACKEND == TELEMETRY_BACKEND_ITM)
+	uint32_t ulDropped;
+#endif
+
+	lFrameLen = frame_encode(FRAME_COBS, ucTelemetryPayload, ulLen,
+			ucTelemetryFrame, sizeof(ucTelemetryFrame));
+
+	if (lFrameLen < 0)
+	{
+		return pdFALSE;
+	}
+
+#if (TELEMETRY_BACKEND == TELEMETRY_BACKEND_ITM)
+	ulDropped = ITM_get_dropped(TELEMETRY_ITM_PORT);
+	(void)ITM_write_buffer(TELEMETRY_ITM_PORT, (const char *)ucTelemetryFrame, (int)lFrameLen);
+	xSent = (ITM_get_dropped(TELEMETRY_ITM_PORT) == ulDropped) ? pdTRUE : pdFALSE;
+#else
+	xSent = (uart_write(TELEMETRY_UART_PORT, ucTelemetryFrame, (uint32_t)lFrameLen,
+			xTelemetryPeriodTicks) == lFrameLen) ? pdTRUE : pdFALSE;
+#endif
+
+	taskENTER_CRITICAL();
+
+	if (xSent != pdFALSE)
+	{
+		xTelemetryStats.ulBytes += (uint32_t)lFrameLen;
+	}
+	else
+	{
+		xTelemetryStats.ulDropped++;
+	}
+
+	taskEXIT_CRITICAL();
+
+	return xSent;
+}
@@ -727,6 +727,99 @@ osStatus_t osMessageQueueReset (osMessageQueueId_t mq_id);
 osStatus_t osMessageQueueDelete (osMessageQueueId_t mq_id);
 
 
+//  ==== Context-Specific Functions ====
+//  The calls above read IPSR on every call to choose between the task and the
+//  ISR implementation. The variants below are that choice made by the caller:
+//  they skip the check, but are only correct from the context in their name.
+//  The FromISR variants take no timeout, as an ISR must not block.
+
+/// Set the specified Thread Flags of a thread, from a thread.
+/// \param[in]     thread_id     thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+/// \param[in]     flags         specifies the flags of the thread that shall be set.
+/// \return thread flags after setting or error code if highest bit set.
+uint32_t osThreadFlagsSetFromTask (osThreadId_t thread_id, uint32_t flags);
+
+/// Set the specified Thread Flags of a thread, from an ISR.
+/// \param[in]     thread_id     thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+/// \param[in]     flags         specifies the flags of the thread that shall be set.
+/// \return thread flags after setting or error code if highest bit set.
+uint32_t osThreadFlagsSetFromISR (osThreadId_t thread_id, uint32_t flags);
+
+/// Set the specified Event Flags, from a thread.
+/// \param[in]     ef_id         event flags ID obtained by \ref osEventFlagsNew.
+/// \param[in]     flags         specifies the flags that shall be set.
+/// \return event flags after setting or error code if highest bit set.
+uint32_t osEventFlagsSetFromTask (osEventFlagsId_t ef_id, uint32_t flags);
+
+/// Set the specified Event Flags, from an ISR.
+/// \param[in]     ef_id         event flags ID obtained by \ref osEventFlagsNew.
+/// \param[in]     flags         specifies the flags that shall be set.
+/// \return event flags after setting or error code if highest bit set.
+uint32_t osEventFlagsSetFromISR (osEventFlagsId_t ef_id, uint32_t flags);
+
+/// Acquire a Mutex or timeout if it is locked, from a thread.
+/// \param[in]     mutex_id      mutex ID obtained by \ref osMutexNew.
+/// \param[in]     timeout       \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osMutexAcquireFromTask (osMutexId_t mutex_id, uint32_t timeout);
+
+/// Release a Mutex that was acquired by \ref osMutexAcquire, from a thread.
+/// \param[in]     mutex_id      mutex ID obtained by \ref osMutexNew.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osMutexReleaseFromTask (osMutexId_t mutex_id);
+
+/// Acquire a Semaphore token or timeout if no tokens are available, from a thread.
+/// \param[in]     semaphore_id  semaphore ID obtained by \ref osSemaphoreNew.
+/// \param[in]     timeout       \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osSemaphoreAcquireFromTask (osSemaphoreId_t semaphore_id, uint32_t timeout);
+
+/// Acquire a Semaphore token if one is available, from an ISR.
+/// \param[in]     semaphore_id  semaphore ID obtained by \ref osSemaphoreNew.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osSemaphoreAcquireFromISR (osSemaphoreId_t semaphore_id);
+
+/// Release a Semaphore token up to the initial maximum count, from a thread.
+/// \param[in]     semaphore_id  semaphore ID obtained by \ref osSemaphoreNew.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osSemaphoreReleaseFromTask (osSemaphoreId_t semaphore_id);
+
+/// Release a Semaphore token up to the initial maximum count, from an ISR.
+/// \param[in]     semaphore_id  semaphore ID obtained by \ref osSemaphoreNew.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osSemaphoreReleaseFromISR (osSemaphoreId_t semaphore_id);
+
+/// Put a Message into a Queue or timeout if Queue is full, from a thread.
+/// \param[in]     mq_id         message queue ID obtained by \ref osMessageQueueNew.
+/// \param[in]     msg_ptr       pointer to buffer with message to put into a queue.
+/// \param[in]     msg_prio      message priority.
+/// \param[in]     timeout       \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osMessageQueuePutFromTask (osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout);
+
+/// Put a Message into a Queue if it is not full, from an ISR.
+/// \param[in]     mq_id         message queue ID obtained by \ref osMessageQueueNew.
+/// \param[in]     msg_ptr       pointer to buffer with message to put into a queue.
+/// \param[in]     msg_prio      message priority.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osMessageQueuePutFromISR (osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio);
+
+/// Get a Message from a Queue or timeout if Queue is empty, from a thread.
+/// \param[in]     mq_id         message queue ID obtained by \ref osMessageQueueNew.
+/// \param[out]    msg_ptr       pointer to buffer for message to get from a queue.
+/// \param[out]    msg_prio      pointer to buffer for message priority or NULL.
+/// \param[in]     timeout       \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osMessageQueueGetFromTask (osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout);
+
+/// Get a Message from a Queue if it is not empty, from an ISR.
+/// \param[in]     mq_id         message queue ID obtained by \ref osMessageQueueNew.
+/// \param[out]    msg_ptr       pointer to buffer for message to get from a queue.
+/// \param[out]    msg_prio      pointer to buffer for message priority or NULL.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osMessageQueueGetFromISR (osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio);
+
+
 #ifdef  __cplusplus
 }
 #endif
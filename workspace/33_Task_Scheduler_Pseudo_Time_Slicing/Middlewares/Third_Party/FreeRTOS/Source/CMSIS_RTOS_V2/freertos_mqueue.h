@@ -0,0 +1,76 @@
+/* --------------------------------------------------------------------------
+ * Copyright (c) 2013-2020 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *      Name:    freertos_mqueue.h
+ *      Purpose: CMSIS RTOS2 wrapper for FreeRTOS
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef FREERTOS_MQUEUE_H_
+#define FREERTOS_MQUEUE_H_
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "freertos_os2.h"
+
+#if (configUSE_OS2_MESSAGE_PRIORITY == 1)
+
+/* Message Queue implementation definitions */
+#define MQUEUE_STATUS             0x3E550000U
+#define MQUEUE_LEVELS             configOS2_MESSAGE_PRIORITY_LEVELS
+#define MQUEUE_NIL                0xFFFFU   /* No slot */
+
+/* Message slot header, followed by the message */
+typedef struct {
+  uint16_t next;                /* Next slot in the same list */
+  uint8_t  prio;                /* Message priority           */
+  uint8_t  reserved;
+} MsgQueueSlot_t;
+
+/* Message Queue control block */
+typedef struct MsgQueueDef_t {
+  SemaphoreHandle_t  msg_sem;           /* Counts queued messages            */
+  SemaphoreHandle_t  spc_sem;           /* Counts free slots                 */
+  uint8_t           *mem_arr;           /* Slot array                        */
+  uint32_t           msg_sz;            /* Size of a message                 */
+  uint32_t           msg_cnt;           /* Number of slots                   */
+  uint32_t           slot_sz;           /* Size of a slot, header included   */
+  uint32_t           bitmap;            /* Bit n set: bucket n not empty     */
+  uint16_t           free;              /* First free slot                   */
+  uint16_t           head[MQUEUE_LEVELS]; /* Oldest message of each bucket   */
+  uint16_t           tail[MQUEUE_LEVELS]; /* Newest message of each bucket   */
+  volatile uint32_t  status;            /* Object status flags               */
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+  StaticSemaphore_t  msg_sem_mem;       /* Semaphore object memory           */
+  StaticSemaphore_t  spc_sem_mem;       /* Semaphore object memory           */
+#endif
+} MsgQueue_t;
+
+/* No need to hide static object type, just align to coding style */
+#define StaticMsgQueue_t          MsgQueue_t
+
+/* Define message queue control block size */
+#define MQUEUE_CB_SIZE            (sizeof(StaticMsgQueue_t))
+
+/* Define size of the byte array required to hold count of messages of given size */
+#define MQUEUE_ARR_SIZE(msg_count, msg_size) \
+  ((sizeof(MsgQueueSlot_t) + ((((msg_size) + (4 - 1)) / 4) * 4))*(msg_count))
+
+#endif /* configUSE_OS2_MESSAGE_PRIORITY == 1 */
+
+#endif /* FREERTOS_MQUEUE_H_ */
@@ -13,12 +13,34 @@
  *
  *       	By adding 'taskYIELD()' to each task, all tasks get a chance to	run.
  *
+ *       	With 'configUSE_FAST_COOPERATIVE_YIELD 1', each 'taskYIELD()' is a
+ *       	direct switch in thread mode rather than a PendSV exception.
+ *
+ *       	Every context switch is recorded by ktrace.c and streamed to
+ *       	USART2. 'Tools/ktrace_convert.py' turns the capture into a trace
+ *       	that https://ui.perfetto.dev shows as a timeline.
+ *
+ *       	LD2 is lit while the Red task runs: each task drives it on every
+ *       	pass of its busy loop, the Red task on and the others off, so its
+ *       	brightness is the Red task's share of the CPU. The tasks write
+ *       	the same ODR without a critical section; a bit-band store
+ *       	(bitband.h) changes PA5 alone, so neither a task switch nor an
+ *       	interrupt in the middle can write back a stale copy of the other
+ *       	pins.
+ *
  ******************************************************************************/
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
 #include "main.h"
+#include "clock.h"
 #include "cmsis_os.h"
+#include "uart.h"
+#include "bitband.h"
+#include "ktrace.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define LD2_BIT 5U				/* LD2_Pin is GPIO_PIN_5. */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
@@ -52,6 +74,13 @@ int main(void)
 
 	/* Initialize all configured peripherals */
 	MX_GPIO_Init();
+	USART2_UART_TX_Init();
+
+	/* Context switches are streamed to USART2; see README, Kernel Trace. */
+	if (ktrace_init() != 0)
+	{
+		Error_Handler();
+	}
 
 	/* Create tasks. */
 	xTaskCreate(
@@ -102,7 +131,7 @@ void vOrangeLedControllerTask(void *pvParameters)
 		Orange_TaskProfiler++;
 		for (int i = 0; i < 1000000; i++)
 		{
-			/* Do nothing. */
+			bitband_periph_clear(&LD2_GPIO_Port->ODR, LD2_BIT);
 		}
 
 		taskYIELD();
@@ -116,7 +145,7 @@ void vRedLedControllerTask(void *pvParameters)
 		Red_TaskProfiler++;
 		for (int i = 0; i < 1000000; i++)
 		{
-			/* Do nothing. */
+			bitband_periph_set(&LD2_GPIO_Port->ODR, LD2_BIT);
 		}
 
 		taskYIELD();
@@ -130,7 +159,7 @@ void vGreenLedControllerTask(void *pvParameters)
 		Green_TaskProfiler++;
 		for (int i = 0; i < 1000000; i++)
 		{
-			/* Do nothing. */
+			bitband_periph_clear(&LD2_GPIO_Port->ODR, LD2_BIT);
 		}
 
 		taskYIELD();
@@ -144,7 +173,7 @@ void vBlueLedControllerTask(void *pvParameters)
 		Blue_TaskProfiler++;
 		for (int i = 0; i < 1000000; i++)
 		{
-			/* Do nothing. */
+			bitband_periph_clear(&LD2_GPIO_Port->ODR, LD2_BIT);
 		}
 
 		taskYIELD();
@@ -157,44 +186,9 @@ void vBlueLedControllerTask(void *pvParameters)
  */
 void SystemClock_Config(void)
 {
-	RCC_OscInitTypeDef RCC_OscInitStruct =
-	{ 0 };
-	RCC_ClkInitTypeDef RCC_ClkInitStruct =
-	{ 0 };
-
-	/** Configure the main internal regulator output voltage
-	 */
-	__HAL_RCC_PWR_CLK_ENABLE();
-	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE3);
-
-	/** Initializes the RCC Oscillators according to the specified parameters
-	 * in the RCC_OscInitTypeDef structure.
-	 */
-	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-	RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-	RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-	RCC_OscInitStruct.PLL.PLLM = 16;
-	RCC_OscInitStruct.PLL.PLLN = 336;
-	RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-	RCC_OscInitStruct.PLL.PLLQ = 2;
-	RCC_OscInitStruct.PLL.PLLR = 2;
-	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-	{
-		Error_Handler();
-	}
-
-	/** Initializes the CPU, AHB and APB buses clocks
-	 */
-	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
-			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
 	{
 		Error_Handler();
 	}
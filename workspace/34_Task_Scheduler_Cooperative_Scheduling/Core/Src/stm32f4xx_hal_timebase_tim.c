@@ -3,6 +3,13 @@
   ******************************************************************************
   * @file    stm32f4xx_hal_timebase_tim.c
   * @brief   HAL time base based on the hardware TIM.
+  * @note    With configUSE_HAL_TIMEBASE_RTOS_TICK set to 1 in FreeRTOSConfig.h,
+  *          TIM1 is left off and HAL_GetTick() follows the RTOS tick count, so
+  *          SysTick is the only periodic interrupt and tickless idle is not
+  *          woken every millisecond. Where the tick count stands still (before
+  *          the scheduler starts, with the scheduler suspended or interrupts
+  *          masked), HAL_GetTick() counts on the DWT cycle counter instead,
+  *          which Reset_Handler starts, so HAL timeouts still expire.
   ******************************************************************************
   * @attention
   *
@@ -20,15 +27,125 @@
 /* Includes ------------------------------------------------------------------*/
 #include "stm32f4xx_hal.h"
 #include "stm32f4xx_hal_tim.h"
+#include "FreeRTOS.h"
+#include "task.h"
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
+/* RTOS ticks to HAL milliseconds; the identity at the usual 1 kHz tick. */
+#define TIMEBASE_TICKS_TO_MS(x)   ((configTICK_RATE_HZ == 1000U) ? (uint32_t)(x) : \
+                                   (uint32_t)(((uint64_t)(x) * 1000U) / configTICK_RATE_HZ))
 /* Private variables ---------------------------------------------------------*/
 TIM_HandleTypeDef        htim1;
+#if (configUSE_HAL_TIMEBASE_RTOS_TICK == 1)
+static uint32_t uwTickMs = 0U;            /* Last value of HAL_GetTick() */
+static uint32_t uwTickCycles = 0U;        /* CYCCNT at that call */
+static uint32_t uwTickRemainder = 0U;     /* Cycles short of the next ms */
+static uint32_t uwTickOffset = 0U;        /* HAL ms at RTOS tick count 0 */
+static uint8_t  ucTickOffsetSet = 0U;
+#endif
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 
+#if (configUSE_HAL_TIMEBASE_RTOS_TICK == 1)
+
+/**
+  * @brief  Keeps the tick priority only: no timer is started, HAL_GetTick()
+  *         follows the RTOS tick.
+  * @note   Called by HAL_Init() and HAL_RCC_ClockConfig(), as the TIM1 version.
+  * @param  TickPriority: Tick interrupt priority, returned by HAL_GetTickPrio().
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
+{
+  if (TickPriority >= (1UL << __NVIC_PRIO_BITS))
+  {
+    return HAL_ERROR;
+  }
+
+  uwTickPrio = TickPriority;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Provides a tick value in milliseconds.
+  * @note   The later of two counts since the last call: the milliseconds
+  *         counted on CYCCNT at the current SystemCoreClock, and, once the
+  *         scheduler has started, the RTOS tick count. The tick count is a
+  *         32-bit load, atomic from any context, and vTaskStepTick() moves it
+  *         across tickless idle, when CYCCNT stops with the core clock.
+  *         CYCCNT keeps HAL_GetTick() moving when the tick count does not.
+  *         It is only read here, so calls must not be more than 2^32 cycles
+  *         apart (23 s at 180 MHz) while the tick count stands still; the HAL
+  *         polling loops call it continuously.
+  * @retval tick value
+  */
+uint32_t HAL_GetTick(void)
+{
+  uint32_t uwPrimask;
+  uint32_t uwCycles;
+  uint32_t uwCyclesPerMs;
+  uint32_t uwRtosMs;
+
+  uwPrimask = __get_PRIMASK();
+  __disable_irq();
+
+  uwCycles = DWT->CYCCNT;
+  uwCyclesPerMs = SystemCoreClock / 1000U;
+  uwTickRemainder += uwCycles - uwTickCycles;
+  uwTickCycles = uwCycles;
+  uwTickMs += uwTickRemainder / uwCyclesPerMs;
+  uwTickRemainder %= uwCyclesPerMs;
+
+  if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+  {
+    uwRtosMs = TIMEBASE_TICKS_TO_MS(xTaskGetTickCount());
+
+    /* Continue from the CYCCNT count at the first call under the scheduler. */
+    if (ucTickOffsetSet == 0U)
+    {
+      uwTickOffset = uwTickMs - uwRtosMs;
+      ucTickOffsetSet = 1U;
+    }
+
+    uwRtosMs += uwTickOffset;
+
+    if ((int32_t)(uwRtosMs - uwTickMs) > 0)
+    {
+      uwTickMs = uwRtosMs;
+      uwTickRemainder = 0U;
+    }
+  }
+
+  __set_PRIMASK(uwPrimask);
+
+  return uwTickMs;
+}
+
+/**
+  * @brief  Suspend Tick increment.
+  * @note   Nothing to do: the RTOS tick is suspended by tickless idle.
+  * @param  None
+  * @retval None
+  */
+void HAL_SuspendTick(void)
+{
+}
+
+/**
+  * @brief  Resume Tick increment.
+  * @note   Nothing to do: the RTOS tick is resumed by tickless idle.
+  * @param  None
+  * @retval None
+  */
+void HAL_ResumeTick(void)
+{
+}
+
+#else /* configUSE_HAL_TIMEBASE_RTOS_TICK */
+
 /**
   * @brief  This function configures the TIM1 as a time base source.
   *         The time source is configured  to have 1ms time base with a dedicated
@@ -42,6 +159,7 @@ HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
 {
   RCC_ClkInitTypeDef    clkconfig;
   uint32_t              uwTimclock = 0U;
+  uint32_t              uwAPB2Prescaler = 0U;
 
   uint32_t              uwPrescalerValue = 0U;
   uint32_t              pFLatency;
@@ -54,8 +172,18 @@ HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
   /* Get clock configuration */
   HAL_RCC_GetClockConfig(&clkconfig, &pFLatency);
 
-  /* Compute TIM1 clock */
-      uwTimclock = HAL_RCC_GetPCLK2Freq();
+  /* Get APB2 prescaler */
+  uwAPB2Prescaler = clkconfig.APB2CLKDivider;
+
+  /* Compute TIM1 clock: twice PCLK2 when APB2 is divided (clock profiles) */
+  if (uwAPB2Prescaler == RCC_HCLK_DIV1)
+  {
+    uwTimclock = HAL_RCC_GetPCLK2Freq();
+  }
+  else
+  {
+    uwTimclock = 2UL * HAL_RCC_GetPCLK2Freq();
+  }
 
   /* Compute the prescaler value to have TIM1 counter clock equal to 1MHz */
   uwPrescalerValue = (uint32_t) ((uwTimclock / 1000000U) - 1U);
@@ -126,3 +254,4 @@ void HAL_ResumeTick(void)
   __HAL_TIM_ENABLE_IT(&htim1, TIM_IT_UPDATE);
 }
 
+#endif /* configUSE_HAL_TIMEBASE_RTOS_TICK */
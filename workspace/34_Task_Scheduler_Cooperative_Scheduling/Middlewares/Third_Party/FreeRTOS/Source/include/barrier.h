@@ -0,0 +1,189 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A barrier is a rendezvous of a fixed number of tasks, the parties: each
+ * task that reaches it blocks until all the parties have, and the last one
+ * to arrive releases them all.  It replaces xEventGroupSync() with one bit
+ * per task, which walks the list of every waiting task on each arrival, with
+ * the scheduler suspended.
+ *
+ * - An arrival is a counter increment and the record of the task handle, in
+ *   a short critical section.  Nothing is walked.
+ *
+ * - The last arrival starts a new generation and notifies each recorded task
+ *   in one pass, with the scheduler suspended so the released tasks run in
+ *   priority order once it is done.  The barrier is then ready for the next
+ *   round straight away.
+ *
+ * - Waiting tasks block on one entry of their task notification array (see
+ *   configTASK_NOTIFICATION_ARRAY_ENTRIES), the same index for all the
+ *   parties.  The index belongs to the barrier - the parties must not use it
+ *   for anything else.  Index 0 (tskDEFAULT_INDEX_TO_NOTIFY) is also used by
+ *   the task notification functions that do not take an index, and by stream
+ *   buffers.
+ *
+ * - A task whose block time expires leaves, and the barrier waits for another
+ *   arrival in its place.
+ *
+ * Barriers cannot be used from an interrupt.
+ */
+
+#ifndef BARRIER_H
+#define BARRIER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include barrier.h"
+#endif
+
+#include "task.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * The storage of a barrier, declared by the application and passed to
+ * xBarrierCreateStatic().  Its members must not be accessed directly.
+ */
+typedef struct BarrierDef_t
+{
+	TaskHandle_t *pxWaiters;				/* uxParties - 1 handles. */
+	UBaseType_t uxParties;
+	UBaseType_t uxIndex;
+	volatile UBaseType_t uxArrived;
+	volatile UBaseType_t uxGeneration;
+} StaticBarrier_t;
+
+/**
+ * Type by which barriers are referenced.
+ */
+typedef StaticBarrier_t * BarrierHandle_t;
+
+/**
+ * barrier.h
+ *
+<pre>
+BarrierHandle_t xBarrierCreateStatic( UBaseType_t uxParties,
+                                      UBaseType_t uxIndex,
+                                      TaskHandle_t *pxWaiters,
+                                      StaticBarrier_t *pxBarrierBuffer );
+</pre>
+ *
+ * Creates a barrier for uxParties tasks in pxBarrierBuffer.
+ *
+ * @param uxParties The number of tasks that meet at the barrier, at least 2.
+ *
+ * @param uxIndex The notification index the parties wait on.
+ *
+ * @param pxWaiters An array of uxParties - 1 task handles, for the tasks
+ * waiting for the last one.
+ *
+ * @param pxBarrierBuffer The storage of the barrier.
+ *
+ * @return A handle to the barrier.
+ *
+ * Example usage:
+<pre>
+#define PARTIES 3
+
+static TaskHandle_t xWaiters[ PARTIES - 1 ];
+static StaticBarrier_t xBarrierBuffer;
+BarrierHandle_t xBarrier;
+
+void vSetup( void )
+{
+	xBarrier = xBarrierCreateStatic( PARTIES, 1, xWaiters, &xBarrierBuffer );
+}
+
+void vParty( void *pvParameters )
+{
+	for( ;; )
+	{
+		vPrepare();
+		( void ) xBarrierWait( xBarrier, portMAX_DELAY );
+		vProceed();
+	}
+}
+</pre>
+ * \defgroup xBarrierCreateStatic xBarrierCreateStatic
+ * \ingroup Barriers
+ */
+BarrierHandle_t xBarrierCreateStatic( UBaseType_t uxParties, UBaseType_t uxIndex, TaskHandle_t *pxWaiters, StaticBarrier_t *pxBarrierBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * barrier.h
+ *
+<pre>
+BaseType_t xBarrierWait( BarrierHandle_t xBarrier, TickType_t xTicksToWait );
+</pre>
+ *
+ * Arrives at the barrier and blocks for up to xTicksToWait until all the
+ * parties have arrived.  The last party does not block.
+ *
+ * @return pdTRUE if all the parties arrived, pdFALSE if the block time expired
+ * first.  The task then no longer counts as arrived.
+ *
+ * \defgroup xBarrierWait xBarrierWait
+ * \ingroup Barriers
+ */
+BaseType_t xBarrierWait( BarrierHandle_t xBarrier, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * barrier.h
+ *
+<pre>
+UBaseType_t uxBarrierGetArrivedCount( BarrierHandle_t xBarrier );
+</pre>
+ *
+ * @return The number of tasks waiting at the barrier.
+ *
+ * \defgroup uxBarrierGetArrivedCount uxBarrierGetArrivedCount
+ * \ingroup Barriers
+ */
+UBaseType_t uxBarrierGetArrivedCount( BarrierHandle_t xBarrier ) PRIVILEGED_FUNCTION;
+
+/**
+ * barrier.h
+ *
+<pre>
+UBaseType_t uxBarrierGetGeneration( BarrierHandle_t xBarrier );
+</pre>
+ *
+ * @return The number of times the barrier released its parties, modulo the
+ * range of a UBaseType_t.
+ *
+ * \defgroup uxBarrierGetGeneration uxBarrierGetGeneration
+ * \ingroup Barriers
+ */
+UBaseType_t uxBarrierGetGeneration( BarrierHandle_t xBarrier ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif	/* !defined( BARRIER_H ) */
@@ -0,0 +1,54 @@
+/*******************************************************************************
+ *
+ * @file	bench.h
+ * @brief	Interface of the cycle-count statistics used by the benchmarks.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef BENCH_HISTOGRAM_BINS
+#define BENCH_HISTOGRAM_BINS 4096U	/* One cycle per bin. */
+#endif
+
+/* Function Prototypes -------------------------------------------------------*/
+void bench_init(void);
+void bench_begin(const char *pcName);
+void bench_record(uint32_t ulCycles);
+void bench_end(void);
+
+/* Rate of bench_cycles(), printed in the cpu_mhz column. */
+#define BENCH_CYCLES_MHZ (SystemCoreClock / 1000000UL)
+
+/**
+ * @brief Starts the DWT cycle counter from 0.
+ * @param None
+ * @retval None
+ */
+static inline void bench_cycles_start(void)
+{
+	/* Enable the trace and debug blocks, DWT included. */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief Returns the DWT cycle counter.
+ * @param None
+ * @retval Core clock cycles, wrapping every 2^32.
+ */
+static inline uint32_t bench_cycles(void)
+{
+	return DWT->CYCCNT;
+}
+
+#endif /* BENCH_H */
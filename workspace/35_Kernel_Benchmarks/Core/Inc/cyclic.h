@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *
+ * @file	cyclic.h
+ * @brief	Interface of the time-triggered cyclic executive.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef CYCLIC_H
+#define CYCLIC_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef CYCLIC_MAX_SLOTS
+#define CYCLIC_MAX_SLOTS 16U		/* Slots of all the minor frames together. */
+#endif
+
+/* The minor frame timer: an APB2 timer, which counts at the core clock. The
+ * handler is defined by cyclic.c. */
+#ifndef CYCLIC_TIM
+#define CYCLIC_TIM				TIM8
+#define CYCLIC_TIM_IRQn			TIM8_UP_TIM13_IRQn
+#define CYCLIC_TIM_IRQHandler	TIM8_UP_TIM13_IRQHandler
+#define CYCLIC_TIM_RCC_EN		(1U << 1)	/* RCC->APB2ENR */
+#endif
+
+/* Above every other interrupt, so nothing delays or preempts a frame. It is
+ * in the zero-latency tier, so slots must not call the FreeRTOS API. */
+#ifndef CYCLIC_IRQ_PRIORITY
+#define CYCLIC_IRQ_PRIORITY 0U
+#endif
+
+/* Each frame starts this long after its timer update event, whatever the
+ * interrupt entry latency was: longer than the worst entry, or the releases
+ * that come late count in ulLateReleases. */
+#ifndef CYCLIC_RELEASE_OFFSET_NS
+#define CYCLIC_RELEASE_OFFSET_NS 500U
+#endif
+
+#define CYCLIC_FRAME(axSlots) { (axSlots), sizeof(axSlots) / sizeof((axSlots)[0]) }
+
+/* Data types ----------------------------------------------------------------*/
+typedef void (*CyclicFunction_t)(void *pvArg);
+
+typedef struct
+{
+	CyclicFunction_t pxFunction;	/* Must not call the FreeRTOS API. */
+	void *pvArg;
+	uint32_t ulBudgetNs;			/* Longest allowed run. */
+} CyclicSlot_t;
+
+typedef struct
+{
+	const CyclicSlot_t *pxSlots;	/* Run back to back from the release. */
+	uint32_t ulSlotCount;
+} CyclicFrame_t;
+
+typedef struct
+{
+	uint32_t ulMinorPeriodUs;		/* Timer period: one minor frame. */
+	const CyclicFrame_t *pxFrames;	/* The minor frames of a major frame. */
+	uint32_t ulFrameCount;
+} CyclicSchedule_t;
+
+typedef struct
+{
+	uint32_t ulFrames;				/* Minor frames run. */
+	uint32_t ulFrameOverruns;		/* Frames that ran into the next release. */
+	uint32_t ulSlotOverruns;		/* Slots that ran past their budget. */
+	uint32_t ulLateReleases;		/* Entries after the release point. */
+	uint32_t ulEntryMaxCycles;		/* Longest entry, from the update event. */
+	uint32_t ulSlotMaxCycles[CYCLIC_MAX_SLOTS];	/* Longest run, in table order. */
+} CyclicStats_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+int32_t cyclic_init(const CyclicSchedule_t *pxSchedule);
+void cyclic_start(void);
+void cyclic_stop(void);
+void cyclic_set_overrun_channel(uint32_t ulChannel);
+uint32_t cyclic_release_cycles(void);
+void cyclic_get_stats(CyclicStats_t *pxStats);
+void cyclic_reset_stats(void);
+
+#endif /* CYCLIC_H */
@@ -0,0 +1,36 @@
+/*******************************************************************************
+ *
+ * @file	heap_bench.h
+ * @brief	Interface of the allocator benchmarks replaying allocation traces.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef HEAP_BENCH_H
+#define HEAP_BENCH_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef HEAP_BENCH_ALLOCATOR
+#define HEAP_BENCH_ALLOCATOR "heap_4"	/* Printed in the header line; set by Host/Makefile. */
+#endif
+
+#ifndef HEAP_BENCH_OPS
+#define HEAP_BENCH_OPS 20000U			/* Allocations and frees replayed per trace. */
+#endif
+
+#ifndef HEAP_BENCH_SAMPLE_OPS
+#define HEAP_BENCH_SAMPLE_OPS 1000U		/* Operations between two fragmentation samples. */
+#endif
+
+#ifndef HEAP_BENCH_ARENA_BYTES
+#define HEAP_BENCH_ARENA_BYTES 8192U	/* Free heap the traces run in, the same on every build. */
+#endif
+
+/* Function Prototypes -------------------------------------------------------*/
+void heap_bench_run(void);
+
+#endif /* HEAP_BENCH_H */
@@ -0,0 +1,52 @@
+/*******************************************************************************
+ *
+ * @file	isr_rate_bench.h
+ * @brief	Interface of the ISR-to-task event capacity benchmark.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef ISR_RATE_BENCH_H
+#define ISR_RATE_BENCH_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macros --------------------------------------------------------------------*/
+/* The rate starts at ISR_RATE_BENCH_START_HZ and grows by
+ * ISR_RATE_BENCH_STEP_PERCENT per step, up to ISR_RATE_BENCH_MAX_HZ. */
+#ifndef ISR_RATE_BENCH_START_HZ
+#define ISR_RATE_BENCH_START_HZ 10000U
+#endif
+
+#ifndef ISR_RATE_BENCH_STEP_PERCENT
+#define ISR_RATE_BENCH_STEP_PERCENT 25U
+#endif
+
+#ifndef ISR_RATE_BENCH_MAX_HZ
+#define ISR_RATE_BENCH_MAX_HZ 1000000U
+#endif
+
+#ifndef ISR_RATE_BENCH_STEP_MS
+#define ISR_RATE_BENCH_STEP_MS 200U			/* Interrupts per step: rate * this. */
+#endif
+
+#ifndef ISR_RATE_BENCH_DEPTH
+#define ISR_RATE_BENCH_DEPTH 32U			/* Events buffered by every primitive. */
+#endif
+
+/* A step is sustained if no event was lost, no interrupt was merged into
+ * the next one and at least this much CPU was left to the background. */
+#ifndef ISR_RATE_BENCH_IDLE_PERCENT
+#define ISR_RATE_BENCH_IDLE_PERCENT 5U
+#endif
+
+#ifndef ISR_RATE_BENCH_IRQ_PRIORITY
+#define ISR_RATE_BENCH_IRQ_PRIORITY 6U		/* At or below configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+#endif
+
+/* Function Prototypes -------------------------------------------------------*/
+void isr_rate_bench_run(void);
+
+#endif /* ISR_RATE_BENCH_H */
@@ -0,0 +1,24 @@
+/*******************************************************************************
+ *
+ * @file	kernel_bench.h
+ * @brief	Interface of the FreeRTOS primitive micro-benchmarks.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef KERNEL_BENCH_H
+#define KERNEL_BENCH_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef KERNEL_BENCH_ITERATIONS
+#define KERNEL_BENCH_ITERATIONS 10000U	/* Samples per benchmark. */
+#endif
+
+/* Function Prototypes -------------------------------------------------------*/
+void kernel_bench_run(void);
+
+#endif /* KERNEL_BENCH_H */
@@ -0,0 +1,58 @@
+/*******************************************************************************
+ *
+ * @file	sched_bench.h
+ * @brief	Interface of the scheduling policy benchmark.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ *
+ ******************************************************************************/
+
+#ifndef SCHED_BENCH_H
+#define SCHED_BENCH_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef SCHED_BENCH_DURATION_MS
+#define SCHED_BENCH_DURATION_MS 2000U		/* Length of one run of the workload. */
+#endif
+
+/* Periodic control: SCHED_BENCH_CONTROL_WORK_US of computation every period,
+ * due by the next release. */
+#ifndef SCHED_BENCH_CONTROL_PERIOD_MS
+#define SCHED_BENCH_CONTROL_PERIOD_MS 1U
+#endif
+
+#ifndef SCHED_BENCH_CONTROL_WORK_US
+#define SCHED_BENCH_CONTROL_WORK_US 150U
+#endif
+
+/* Bursty I/O: SCHED_BENCH_IO_BURST events at once every period, each
+ * handled with SCHED_BENCH_IO_WORK_US of computation. */
+#ifndef SCHED_BENCH_IO_PERIOD_MS
+#define SCHED_BENCH_IO_PERIOD_MS 7U
+#endif
+
+#ifndef SCHED_BENCH_IO_BURST
+#define SCHED_BENCH_IO_BURST 8U
+#endif
+
+#ifndef SCHED_BENCH_IO_WORK_US
+#define SCHED_BENCH_IO_WORK_US 40U
+#endif
+
+#ifndef SCHED_BENCH_IO_QUEUE_LENGTH
+#define SCHED_BENCH_IO_QUEUE_LENGTH 16U		/* Events pending before one is dropped. */
+#endif
+
+/* Background compute: two tasks of the same priority, in chunks of
+ * SCHED_BENCH_CHUNK_US. */
+#ifndef SCHED_BENCH_CHUNK_US
+#define SCHED_BENCH_CHUNK_US 500U
+#endif
+
+/* Function Prototypes -------------------------------------------------------*/
+void sched_bench_run(void);
+
+#endif /* SCHED_BENCH_H */
@@ -0,0 +1,46 @@
+/*******************************************************************************
+ *
+ * @file	zli.h
+ * @brief	Interface of the zero-latency interrupt tier.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ *
+ ******************************************************************************/
+
+#ifndef ZLI_H
+#define ZLI_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define ZLI_MAX_CHANNELS 32U			/* One bit each in the pending mask. */
+
+/* The interrupt zli_defer() pends. Any vector whose peripheral is unused will
+ * do; the handler is defined by zli.c. */
+#ifndef ZLI_DEFER_IRQn
+#define ZLI_DEFER_IRQn			SPDIF_RX_IRQn
+#define ZLI_DEFER_IRQHandler	SPDIF_RX_IRQHandler
+#endif
+
+/* The most urgent priority still allowed to call the FreeRTOS API. */
+#define ZLI_DEFER_IRQ_PRIORITY	configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+
+/* Priorities 0 to configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY - 1 are never
+ * masked by the kernel. */
+#define ZLI_IS_ZERO_LATENCY(ulPriority) ((ulPriority) < configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY)
+
+/* Data types ----------------------------------------------------------------*/
+/* Runs in the deferred interrupt, so it may use the FromISR FreeRTOS API. */
+typedef void (*ZliHandler_t)(void *pvArg, BaseType_t *pxHigherPriorityTaskWoken);
+
+/* Function Prototypes -------------------------------------------------------*/
+void zli_init(void);
+int32_t zli_irq_enable(IRQn_Type eIrq, uint32_t ulPriority);
+int32_t zli_register(uint32_t ulChannel, ZliHandler_t pxHandler, void *pvArg);
+void zli_defer(uint32_t ulChannel);
+void zli_wake_ring(void *pvRing, BaseType_t *pxHigherPriorityTaskWoken);
+
+#endif /* ZLI_H */
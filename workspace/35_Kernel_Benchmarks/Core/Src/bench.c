@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * @file	bench.c
+ * @brief	Cycle-count statistics for the benchmarks, reported as CSV.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	One benchmark is measured at a time: bench_begin() clears the
+ * 			statistics, bench_record() adds a sample and bench_end() prints
+ * 			one CSV row:
+ *
+ * 				cpu_mhz,benchmark,samples,min,avg,p99,max
+ *
+ * 			All times are in core clock cycles. p99 comes from a histogram
+ * 			of BENCH_HISTOGRAM_BINS one-cycle bins; when it falls beyond the
+ * 			last bin, max is reported instead, as an upper bound. Lines
+ * 			starting with '#' are comments.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "bench.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define BENCH_PERCENTILE		99U
+
+/* Variables -----------------------------------------------------------------*/
+static const char *pcBenchName = "";
+static uint32_t ulBenchSamples = 0;
+static uint32_t ulBenchMin = 0;
+static uint32_t ulBenchMax = 0;
+static uint64_t ullBenchSum = 0;
+static uint32_t ulBenchHistogram[BENCH_HISTOGRAM_BINS];
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Starts the cycle counter and prints the CSV header.
+ * @param None
+ * @retval None
+ */
+void bench_init(void)
+{
+	bench_cycles_start();
+
+	printf("cpu_mhz,benchmark,samples,min,avg,p99,max\r\n");
+}
+
+/**
+ * @brief Starts a new benchmark.
+ * @param pcName Name printed in the benchmark column.
+ * @retval None
+ */
+void bench_begin(const char *pcName)
+{
+	uint32_t i;
+
+	pcBenchName = pcName;
+	ulBenchSamples = 0;
+	ulBenchMin = UINT32_MAX;
+	ulBenchMax = 0;
+	ullBenchSum = 0;
+
+	for (i = 0; i < BENCH_HISTOGRAM_BINS; i++)
+	{
+		ulBenchHistogram[i] = 0;
+	}
+}
+
+/**
+ * @brief Adds a sample to the current benchmark.
+ * @param ulCycles Measured cycles.
+ * @retval None
+ */
+void bench_record(uint32_t ulCycles)
+{
+	ulBenchSamples++;
+	ullBenchSum += ulCycles;
+
+	if (ulCycles < ulBenchMin)
+	{
+		ulBenchMin = ulCycles;
+	}
+
+	if (ulCycles > ulBenchMax)
+	{
+		ulBenchMax = ulCycles;
+	}
+
+	if (ulCycles < BENCH_HISTOGRAM_BINS)
+	{
+		ulBenchHistogram[ulCycles]++;
+	}
+}
+
+/**
+ * @brief Prints the CSV row of the current benchmark.
+ * @param None
+ * @retval None
+ */
+void bench_end(void)
+{
+	const uint32_t ulRank = (uint32_t)(((uint64_t)ulBenchSamples * BENCH_PERCENTILE + 99U) / 100U);
+	uint32_t ulP99 = ulBenchMax;
+	uint32_t ulSeen = 0;
+	uint32_t i;
+
+	if (ulBenchSamples == 0U)
+	{
+		printf("# %s: no samples\r\n", pcBenchName);
+		return;
+	}
+
+	for (i = 0; i < BENCH_HISTOGRAM_BINS; i++)
+	{
+		ulSeen += ulBenchHistogram[i];
+
+		if (ulSeen >= ulRank)
+		{
+			ulP99 = i;
+			break;
+		}
+	}
+
+	printf("%lu,%s,%lu,%lu,%lu,%lu,%lu\r\n",
+			(unsigned long)BENCH_CYCLES_MHZ,
+			pcBenchName,
+			(unsigned long)ulBenchSamples,
+			(unsigned long)ulBenchMin,
+			(unsigned long)(ullBenchSum / ulBenchSamples),
+			(unsigned long)ulP99,
+			(unsigned long)ulBenchMax);
+}
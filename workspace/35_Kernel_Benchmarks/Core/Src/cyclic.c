@@ -0,0 +1,336 @@
+/*******************************************************************************
+ *
+ * @file	cyclic.c
+ * @brief	Time-triggered cyclic executive, run by a hardware timer above the
+ * 			kernel.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	A schedule is a constant table: a major frame of minor frames,
+ * 			each a list of slots run back to back. CYCLIC_TIM interrupts
+ * 			once per minor frame, at CYCLIC_IRQ_PRIORITY, in the zero-latency
+ * 			tier (zli.c): no kernel critical section holds it back, and no
+ * 			other interrupt preempts it, so a slot runs at the same point of
+ * 			every major frame whatever the tasks do.
+ *
+ * 			What is left of the jitter is the interrupt entry, which depends
+ * 			on the instruction interrupted, flash wait states and tail-
+ * 			chaining. The handler takes it out by waiting, on the timer
+ * 			count, for a release point CYCLIC_RELEASE_OFFSET_NS after the
+ * 			update event, so every frame starts within one timer count of
+ * 			it: one core cycle with the timer at the core clock.
+ *
+ * 			The budget of each slot is checked on the DWT cycle counter,
+ * 			and cyclic_init() rejects a schedule whose budgets do not fit in
+ * 			the minor frame. A frame still running at the next update event
+ * 			is a frame overrun: the next frame is skipped, so the ones after
+ * 			keep their phase, and the overrun channel, if any, is deferred.
+ *
+ * 			Slots must not call the FreeRTOS API. They hand their data to
+ * 			tasks through lock-free rings (spsc_ring.h) and zli_defer().
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "cyclic.h"
+#include "zli.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define TIM_CR1_CEN_OFS			0U
+#define TIM_CR1_URS_OFS			2U
+#define TIM_DIER_UIE_OFS		0U
+#define TIM_SR_UIF_OFS			0U
+#define TIM_EGR_UG_OFS			0U
+#define CYCLIC_TIM_MAX_COUNTS	65536U		/* 16-bit counter. */
+
+/* Variables -----------------------------------------------------------------*/
+static const CyclicSchedule_t *pxCyclicSchedule = NULL;
+static uint32_t ulBudgetCycles[CYCLIC_MAX_SLOTS];
+static uint32_t ulCyclesPerCount = 1;
+static uint32_t ulReleaseCount = 0;
+static uint32_t ulOverrunChannel = ZLI_MAX_CHANNELS;
+static uint32_t ulFrameIndex = 0;
+static uint32_t ulSlotBase = 0;			/* Table index of the frame's first slot. */
+static CyclicStats_t xCyclicStats;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t cyclic_timer_clock(void);
+static void cyclic_next_frame(void);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Sets up CYCLIC_TIM and its interrupt for a schedule, stopped.
+ * @param pxSchedule Schedule, which must stay valid while it runs.
+ * @retval 0 if successful, -1 if the minor period is not a whole number of
+ * timer counts, or a frame's budgets and the release offset do not fit in it.
+ * @note Call again after changing the clock profile.
+ */
+int32_t cyclic_init(const CyclicSchedule_t *pxSchedule)
+{
+	const uint32_t ulTimerClock = cyclic_timer_clock();
+	uint64_t ullPeriodTicks;
+	uint64_t ullFrameNs;
+	uint32_t ulTicksPerCount;
+	uint32_t ulSlots = 0;
+	uint32_t i;
+	uint32_t j;
+
+	if ((pxSchedule == NULL) || (pxSchedule->pxFrames == NULL) || (pxSchedule->ulFrameCount == 0U)
+			|| (pxSchedule->ulMinorPeriodUs == 0U) || ((SystemCoreClock % ulTimerClock) != 0U))
+	{
+		return -1;
+	}
+
+	ullPeriodTicks = (uint64_t)ulTimerClock * pxSchedule->ulMinorPeriodUs;
+
+	if ((ullPeriodTicks % 1000000U) != 0U)
+	{
+		return -1;
+	}
+
+	ullPeriodTicks /= 1000000U;
+
+	/* The smallest prescaler that fits the period in the counter. */
+	ulTicksPerCount = (uint32_t)((ullPeriodTicks - 1U) / CYCLIC_TIM_MAX_COUNTS) + 1U;
+
+	if ((ulTicksPerCount > CYCLIC_TIM_MAX_COUNTS) || ((ullPeriodTicks % ulTicksPerCount) != 0U))
+	{
+		return -1;
+	}
+
+	/* Every frame must fit in the minor period with its worst case. */
+	for (i = 0; i < pxSchedule->ulFrameCount; i++)
+	{
+		ullFrameNs = CYCLIC_RELEASE_OFFSET_NS;
+
+		for (j = 0; j < pxSchedule->pxFrames[i].ulSlotCount; j++)
+		{
+			if ((ulSlots >= CYCLIC_MAX_SLOTS) || (pxSchedule->pxFrames[i].pxSlots[j].pxFunction == NULL))
+			{
+				return -1;
+			}
+
+			ullFrameNs += pxSchedule->pxFrames[i].pxSlots[j].ulBudgetNs;
+			ulBudgetCycles[ulSlots] = (uint32_t)(((uint64_t)pxSchedule->pxFrames[i].pxSlots[j].ulBudgetNs
+					* SystemCoreClock) / 1000000000U);
+			ulSlots++;
+		}
+
+		if (ullFrameNs > ((uint64_t)pxSchedule->ulMinorPeriodUs * 1000U))
+		{
+			return -1;
+		}
+	}
+
+	cyclic_stop();
+
+	/* Enable the trace and debug blocks, DWT included. */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	pxCyclicSchedule = pxSchedule;
+	ulCyclesPerCount = (SystemCoreClock / ulTimerClock) * ulTicksPerCount;
+	ulReleaseCount = (uint32_t)((((uint64_t)CYCLIC_RELEASE_OFFSET_NS * ulTimerClock) / 1000000000U
+			+ ulTicksPerCount - 1U) / ulTicksPerCount);
+	cyclic_reset_stats();
+
+	RCC->APB2ENR |= CYCLIC_TIM_RCC_EN;
+
+	/* Only a UG event updates the prescaler, and it must not raise an
+	 * interrupt. */
+	CYCLIC_TIM->CR1 = (1U << TIM_CR1_URS_OFS);
+	CYCLIC_TIM->PSC = ulTicksPerCount - 1U;
+	CYCLIC_TIM->ARR = (uint32_t)(ullPeriodTicks / ulTicksPerCount) - 1U;
+	CYCLIC_TIM->EGR = (1U << TIM_EGR_UG_OFS);
+	CYCLIC_TIM->SR = 0;
+	CYCLIC_TIM->DIER = (1U << TIM_DIER_UIE_OFS);
+
+	NVIC_SetPriority(CYCLIC_TIM_IRQn, CYCLIC_IRQ_PRIORITY);
+	NVIC_ClearPendingIRQ(CYCLIC_TIM_IRQn);
+	NVIC_EnableIRQ(CYCLIC_TIM_IRQn);
+
+	return 0;
+}
+
+/**
+ * @brief Starts the schedule from its first minor frame, one period from now.
+ * @param None
+ * @retval None
+ */
+void cyclic_start(void)
+{
+	ulFrameIndex = 0;
+	ulSlotBase = 0;
+
+	CYCLIC_TIM->EGR = (1U << TIM_EGR_UG_OFS);
+	CYCLIC_TIM->SR = 0;
+	CYCLIC_TIM->CR1 |= (1U << TIM_CR1_CEN_OFS);
+}
+
+/**
+ * @brief Stops the schedule after the frame in progress, if any.
+ * @param None
+ * @retval None
+ */
+void cyclic_stop(void)
+{
+	CYCLIC_TIM->CR1 &= ~(1U << TIM_CR1_CEN_OFS);
+	CYCLIC_TIM->SR = 0;
+	NVIC_ClearPendingIRQ(CYCLIC_TIM_IRQn);
+}
+
+/**
+ * @brief Sets the zli.c channel deferred on each frame overrun.
+ * @param ulChannel Registered channel, or ZLI_MAX_CHANNELS for none.
+ * @retval None
+ */
+void cyclic_set_overrun_channel(uint32_t ulChannel)
+{
+	ulOverrunChannel = ulChannel;
+}
+
+/**
+ * @brief Returns the time since the update event of the current minor frame.
+ * @param None
+ * @retval Core clock cycles, to a timer count.
+ * @note For a slot to time its own release.
+ */
+uint32_t cyclic_release_cycles(void)
+{
+	return CYCLIC_TIM->CNT * ulCyclesPerCount;
+}
+
+/**
+ * @brief Copies the statistics.
+ * @param pxStats Receives them.
+ * @retval None
+ */
+void cyclic_get_stats(CyclicStats_t *pxStats)
+{
+	const uint32_t ulPrimask = __get_PRIMASK();
+
+	/* CYCLIC_IRQ_PRIORITY is above what BASEPRI masks. */
+	__disable_irq();
+	*pxStats = xCyclicStats;
+	__set_PRIMASK(ulPrimask);
+}
+
+/**
+ * @brief Clears the statistics.
+ * @param None
+ * @retval None
+ */
+void cyclic_reset_stats(void)
+{
+	const uint32_t ulPrimask = __get_PRIMASK();
+
+	__disable_irq();
+	memset(&xCyclicStats, 0, sizeof(xCyclicStats));
+	__set_PRIMASK(ulPrimask);
+}
+
+/**
+ * @brief CYCLIC_TIM update IRQ handler: runs the slots of one minor frame.
+ * @param None
+ * @retval None
+ */
+void CYCLIC_TIM_IRQHandler(void)
+{
+	/* Timer counts since the update event that raised the interrupt. */
+	const uint32_t ulEntry = CYCLIC_TIM->CNT;
+	const CyclicFrame_t * const pxFrame = &pxCyclicSchedule->pxFrames[ulFrameIndex];
+	uint32_t ulStart;
+	uint32_t ulCycles;
+	uint32_t i;
+
+	CYCLIC_TIM->SR = ~(1U << TIM_SR_UIF_OFS);
+
+	if ((ulEntry * ulCyclesPerCount) > xCyclicStats.ulEntryMaxCycles)
+	{
+		xCyclicStats.ulEntryMaxCycles = ulEntry * ulCyclesPerCount;
+	}
+
+	if (ulEntry > ulReleaseCount)
+	{
+		xCyclicStats.ulLateReleases++;
+	}
+
+	/* The release point: the same count whatever the entry took. */
+	while (CYCLIC_TIM->CNT < ulReleaseCount)
+	{
+	}
+
+	for (i = 0; i < pxFrame->ulSlotCount; i++)
+	{
+		ulStart = DWT->CYCCNT;
+		pxFrame->pxSlots[i].pxFunction(pxFrame->pxSlots[i].pvArg);
+		ulCycles = DWT->CYCCNT - ulStart;
+
+		if (ulCycles > xCyclicStats.ulSlotMaxCycles[ulSlotBase + i])
+		{
+			xCyclicStats.ulSlotMaxCycles[ulSlotBase + i] = ulCycles;
+		}
+
+		if (ulCycles > ulBudgetCycles[ulSlotBase + i])
+		{
+			xCyclicStats.ulSlotOverruns++;
+		}
+	}
+
+	xCyclicStats.ulFrames++;
+	cyclic_next_frame();
+
+	if ((CYCLIC_TIM->SR & (1U << TIM_SR_UIF_OFS)) != 0U)
+	{
+		/* The next release went by: skip its frame rather than run it
+		 * late, so the frames after it keep their phase. */
+		CYCLIC_TIM->SR = ~(1U << TIM_SR_UIF_OFS);
+		NVIC_ClearPendingIRQ(CYCLIC_TIM_IRQn);
+		xCyclicStats.ulFrameOverruns++;
+		cyclic_next_frame();
+
+		if (ulOverrunChannel < ZLI_MAX_CHANNELS)
+		{
+			zli_defer(ulOverrunChannel);
+		}
+	}
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Returns the clock of the APB2 timers.
+ * @param None
+ * @retval Timer clock in Hz.
+ */
+static uint32_t cyclic_timer_clock(void)
+{
+	uint32_t ulClock = HAL_RCC_GetPCLK2Freq();
+
+	/* The timer clock is PCLK2, doubled when APB2 is divided. */
+	if ((RCC->CFGR & RCC_CFGR_PPRE2) != RCC_CFGR_PPRE2_DIV1)
+	{
+		ulClock *= 2U;
+	}
+
+	return ulClock;
+}
+
+/**
+ * @brief Moves to the next minor frame, back to the first after the last.
+ * @param None
+ * @retval None
+ */
+static void cyclic_next_frame(void)
+{
+	ulSlotBase += pxCyclicSchedule->pxFrames[ulFrameIndex].ulSlotCount;
+	ulFrameIndex++;
+
+	if (ulFrameIndex >= pxCyclicSchedule->ulFrameCount)
+	{
+		ulFrameIndex = 0;
+		ulSlotBase = 0;
+	}
+}
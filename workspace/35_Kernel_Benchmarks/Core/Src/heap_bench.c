@@ -0,0 +1,641 @@
+/*******************************************************************************
+ *
+ * @file	heap_bench.c
+ * @brief	Allocator benchmarks replaying allocation traces, in core clock
+ * 			cycles.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Each trace is a deterministic sequence of pvPortMalloc() and
+ * 			vPortFree() calls, generated from a fixed seed so that every
+ * 			allocator sees the same requests in the same order:
+ *
+ * 			- task_churn: tasks created and deleted as in 10_Delete_Task, a
+ * 			  stack of 100 to 256 words then a TCB, freed in the order
+ * 			  prvDeleteTCB() frees them, with the odd semaphore outliving
+ * 			  its task and pinning the memory around it.
+ * 			- message_churn: messages the size of the DataType_t of
+ * 			  16_Send_Complex_Data_With_Queues, and now and then a larger
+ * 			  frame, allocated by a producer and freed in order by a
+ * 			  consumer up to 16 behind.
+ * 			- mixed: 16 to 1023 byte blocks of random lifetime, up to three
+ * 			  quarters of the arena live, the worst case of first fit.
+ *
+ * 			Every trace is replayed twice. The first pass times each
+ * 			pvPortMalloc() and samples the free heap every
+ * 			HEAP_BENCH_SAMPLE_OPS operations; the second times each
+ * 			vPortFree(). The rows are heap_<trace>_malloc and
+ * 			heap_<trace>_free (see bench.c), and comment lines give the
+ * 			samples and a summary per trace:
+ *
+ * 				# heap_frag,<trace>,<op>,<free>,<largest_free>,<free_blocks>,<frag_pct>
+ * 				# heap_trace,<trace>,mallocs=..,failed=..,peak_live=..,largest_min=..,frag_peak=..
+ *
+ * 			Fragmentation is the share of the free bytes outside the
+ * 			largest free block: how much of the heap a request of the size
+ * 			of the whole free heap could not use.
+ *
+ * 			Before the traces, ballast blocks take everything above
+ * 			HEAP_BENCH_ARENA_BYTES, so the traces run in the same arena on
+ * 			the board and on the host whatever the heap size, and a failed
+ * 			allocation counts the same on both. A failed allocation leaves
+ * 			its slot empty and the trace goes on. With configUSE_HEAP_SLABS,
+ * 			the slabs carved by one trace stay carved for the next ones,
+ * 			and their largest free block starts smaller.
+ *
+ * 			Only the allocator configured at build time is measured: rerun
+ * 			with configUSE_HEAP_SLABS, configUSE_HEAP_REGIONS or another
+ * 			MemMang source to compare ('make heap' in Host/ builds them
+ * 			all, and Tools/heap_bench_report.py lines them up).
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bench.h"
+#include "heap_bench.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define HEAP_BENCH_SLOTS			32U		/* Blocks live at once, at most. */
+#define HEAP_BENCH_MAX_BURST		2U		/* Operations one trace step emits. */
+#define HEAP_BENCH_SAMPLES			((HEAP_BENCH_OPS / HEAP_BENCH_SAMPLE_OPS) + 1U)
+#define HEAP_BENCH_BALLAST_BLOCKS	8U
+#define HEAP_BENCH_BALLAST_SLACK	64U		/* Leaves room for headers and alignment. */
+#define HEAP_BENCH_FRAG_FULL		10000U	/* 100.00 % */
+
+#define CHURN_TASKS					4U
+#define CHURN_STACK_SLOT(k)			(2U * (k))
+#define CHURN_TCB_SLOT(k)			((2U * (k)) + 1U)
+#define CHURN_SEMAPHORE_SLOT(k)		((2U * CHURN_TASKS) + (k))
+#define CHURN_STACK_BYTES(words)	((size_t)(words) * 4U)	/* StackType_t of the ARM_CM4F port, also on the host. */
+
+#define MESSAGE_SIZE				8U		/* sizeof(DataType_t) of 16_Send_Complex_Data_With_Queues. */
+#define MESSAGE_FIFO_DEPTH			16U
+#define MESSAGE_FRAME_MIN			128U
+#define MESSAGE_FRAME_MAX			256U
+
+#define MIXED_MIN_SHIFT				4U		/* 16 bytes */
+#define MIXED_SHIFTS				6U		/* Up to 1023 bytes. */
+
+#if (HEAP_BENCH_SAMPLE_OPS == 0)
+#error HEAP_BENCH_SAMPLE_OPS must not be 0
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+
+/* An allocation of xSize bytes into slot ulSlot, or, with an xSize of 0, the
+ * free of the block in it. */
+typedef struct
+{
+	uint32_t ulSlot;
+	size_t xSize;
+} HeapBenchOp_t;
+
+typedef struct
+{
+	uint32_t ulRandom;						/* xorshift32 state. */
+	void *pvSlots[HEAP_BENCH_SLOTS];		/* NULL if empty. */
+	size_t xSizes[HEAP_BENCH_SLOTS];
+	size_t xLiveBytes;						/* Requested bytes in the slots. */
+	uint32_t ulHead;						/* message_churn: next slot to fill... */
+	uint32_t ulTail;						/* ... and to free. */
+} HeapBenchState_t;
+
+/* Emits the next one to HEAP_BENCH_MAX_BURST operations of a trace and
+ * returns how many. Only ever frees a slot in use and fills an empty one. */
+typedef uint32_t (*HeapBenchNext_t)(HeapBenchState_t *pxState, HeapBenchOp_t *pxOps);
+
+typedef struct
+{
+	const char *pcName;
+	HeapBenchNext_t pxNext;
+	uint32_t ulSeed;
+} HeapBenchTrace_t;
+
+typedef struct
+{
+	uint32_t ulOp;
+	size_t xFree;
+	size_t xLargest;
+	size_t xBlocks;
+} HeapBenchSample_t;
+
+typedef struct
+{
+	uint32_t ulMallocs;
+	uint32_t ulFailed;
+	size_t xPeakLive;
+	uint32_t ulSamples;
+	HeapBenchSample_t xSamples[HEAP_BENCH_SAMPLES];
+} HeapBenchResult_t;
+
+/* Private function prototypes -----------------------------------------------*/
+static void prvMeasureTrace(const HeapBenchTrace_t *pxTrace);
+static void prvReplay(const HeapBenchTrace_t *pxTrace, BaseType_t xTimeFrees);
+static void prvApply(const HeapBenchOp_t *pxOp, BaseType_t xTimeFrees);
+static void prvSample(uint32_t ulOp);
+static void prvReport(const HeapBenchTrace_t *pxTrace);
+static uint32_t prvFragmentation(size_t xFree, size_t xLargest);
+static void prvReserveArena(void);
+static void prvReleaseArena(void);
+static uint32_t prvRandom(HeapBenchState_t *pxState);
+static uint32_t prvNextTaskChurn(HeapBenchState_t *pxState, HeapBenchOp_t *pxOps);
+static uint32_t prvNextMessageChurn(HeapBenchState_t *pxState, HeapBenchOp_t *pxOps);
+static uint32_t prvNextMixed(HeapBenchState_t *pxState, HeapBenchOp_t *pxOps);
+
+/* Variables -----------------------------------------------------------------*/
+static const HeapBenchTrace_t xTraces[] =
+{
+	{ "task_churn", prvNextTaskChurn, 0x10DE1E7EUL },
+	{ "message_churn", prvNextMessageChurn, 0x16DA7A00UL },
+	{ "mixed", prvNextMixed, 0x5EED0001UL },
+};
+
+static const uint16_t usChurnStackWords[] = { 100U, 100U, 128U, 256U };
+
+static HeapBenchState_t xState;
+static HeapBenchResult_t xResult;
+static void *pvBallast[HEAP_BENCH_BALLAST_BLOCKS];
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Replays every trace against the allocator of this build.
+ * @param None
+ * @retval None
+ * @note Frees everything it allocated before returning, the ballast
+ * included.
+ */
+void heap_bench_run(void)
+{
+	uint32_t i;
+
+	/* The heap initialises itself on the first allocation. */
+	vPortFree(pvPortMalloc(1U));
+
+	prvReserveArena();
+
+	printf("# heap allocator=%s slabs=%d regions=%d arena=%lu ops=%lu\r\n",
+			HEAP_BENCH_ALLOCATOR,
+			configUSE_HEAP_SLABS,
+			configUSE_HEAP_REGIONS,
+			(unsigned long)xPortGetFreeHeapSize(),
+			(unsigned long)HEAP_BENCH_OPS);
+
+	for (i = 0; i < (sizeof(xTraces) / sizeof(xTraces[0])); i++)
+	{
+		prvMeasureTrace(&xTraces[i]);
+	}
+
+	prvReleaseArena();
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Replays a trace timing the allocations, then again timing the frees.
+ * @param pxTrace Trace.
+ * @retval None
+ */
+static void prvMeasureTrace(const HeapBenchTrace_t *pxTrace)
+{
+	static char cName[40];
+
+	(void)snprintf(cName, sizeof(cName), "heap_%s_malloc", pxTrace->pcName);
+	bench_begin(cName);
+	prvReplay(pxTrace, pdFALSE);
+	bench_end();
+
+	prvReport(pxTrace);
+
+	(void)snprintf(cName, sizeof(cName), "heap_%s_free", pxTrace->pcName);
+	bench_begin(cName);
+	prvReplay(pxTrace, pdTRUE);
+	bench_end();
+}
+
+/**
+ * @brief Runs HEAP_BENCH_OPS operations of a trace from its seed, then frees
+ * what is left.
+ * @param pxTrace Trace.
+ * @param xTimeFrees pdFALSE to time the allocations and sample the heap,
+ * pdTRUE to time the frees.
+ * @retval None
+ */
+static void prvReplay(const HeapBenchTrace_t *pxTrace, BaseType_t xTimeFrees)
+{
+	HeapBenchOp_t xOps[HEAP_BENCH_MAX_BURST];
+	uint32_t ulOp = 0;
+	uint32_t ulCount;
+	uint32_t i;
+
+	for (i = 0; i < HEAP_BENCH_SLOTS; i++)
+	{
+		xState.pvSlots[i] = NULL;
+		xState.xSizes[i] = 0;
+	}
+
+	xState.ulRandom = pxTrace->ulSeed;
+	xState.xLiveBytes = 0;
+	xState.ulHead = 0;
+	xState.ulTail = 0;
+
+	xResult.ulMallocs = 0;
+	xResult.ulFailed = 0;
+	xResult.xPeakLive = 0;
+	xResult.ulSamples = 0;
+
+	if (xTimeFrees == pdFALSE)
+	{
+		prvSample(0);
+	}
+
+	while (ulOp < HEAP_BENCH_OPS)
+	{
+		ulCount = pxTrace->pxNext(&xState, xOps);
+
+		for (i = 0; (i < ulCount) && (ulOp < HEAP_BENCH_OPS); i++)
+		{
+			prvApply(&xOps[i], xTimeFrees);
+			ulOp++;
+
+			if ((xTimeFrees == pdFALSE) && ((ulOp % HEAP_BENCH_SAMPLE_OPS) == 0U))
+			{
+				prvSample(ulOp);
+			}
+		}
+	}
+
+	for (i = 0; i < HEAP_BENCH_SLOTS; i++)
+	{
+		vPortFree(xState.pvSlots[i]);
+		xState.pvSlots[i] = NULL;
+	}
+}
+
+/**
+ * @brief Carries out one operation, timing it if it is of the kind measured.
+ * @param pxOp Operation.
+ * @param xTimeFrees pdFALSE to time an allocation, pdTRUE to time a free.
+ * @retval None
+ */
+static void prvApply(const HeapBenchOp_t *pxOp, BaseType_t xTimeFrees)
+{
+	void *pvBlock;
+	uint32_t ulStart;
+	uint32_t ulCycles;
+
+	if (pxOp->xSize != 0U)
+	{
+		ulStart = bench_cycles();
+		pvBlock = pvPortMalloc(pxOp->xSize);
+		ulCycles = bench_cycles() - ulStart;
+
+		if (xTimeFrees == pdFALSE)
+		{
+			bench_record(ulCycles);
+		}
+
+		xResult.ulMallocs++;
+
+		if (pvBlock == NULL)
+		{
+			xResult.ulFailed++;
+			return;
+		}
+
+		xState.pvSlots[pxOp->ulSlot] = pvBlock;
+		xState.xSizes[pxOp->ulSlot] = pxOp->xSize;
+		xState.xLiveBytes += pxOp->xSize;
+
+		if (xState.xLiveBytes > xResult.xPeakLive)
+		{
+			xResult.xPeakLive = xState.xLiveBytes;
+		}
+	}
+	else if (xState.pvSlots[pxOp->ulSlot] != NULL)
+	{
+		pvBlock = xState.pvSlots[pxOp->ulSlot];
+
+		ulStart = bench_cycles();
+		vPortFree(pvBlock);
+		ulCycles = bench_cycles() - ulStart;
+
+		if (xTimeFrees != pdFALSE)
+		{
+			bench_record(ulCycles);
+		}
+
+		xState.pvSlots[pxOp->ulSlot] = NULL;
+		xState.xLiveBytes -= xState.xSizes[pxOp->ulSlot];
+	}
+	else
+	{
+		/* Its allocation failed: nothing to free. */
+	}
+}
+
+/**
+ * @brief Records the free heap, its largest block and the number of blocks.
+ * @param ulOp Operations replayed so far.
+ * @retval None
+ * @note vPortGetHeapStats() walks the free list; it is never timed.
+ */
+static void prvSample(uint32_t ulOp)
+{
+	HeapBenchSample_t *pxSample;
+	HeapStats_t xStats;
+
+	if (xResult.ulSamples >= HEAP_BENCH_SAMPLES)
+	{
+		return;
+	}
+
+	vPortGetHeapStats(&xStats);
+
+	pxSample = &xResult.xSamples[xResult.ulSamples++];
+	pxSample->ulOp = ulOp;
+	pxSample->xFree = xStats.xAvailableHeapSpaceInBytes;
+	pxSample->xLargest = xStats.xSizeOfLargestFreeBlockInBytes;
+	pxSample->xBlocks = xStats.xNumberOfFreeBlocks;
+}
+
+/**
+ * @brief Prints the samples and the summary of the allocation pass.
+ * @param pxTrace Trace.
+ * @retval None
+ * @note After the pass, so that printf() does not run between the samples.
+ */
+static void prvReport(const HeapBenchTrace_t *pxTrace)
+{
+	const HeapBenchSample_t *pxSample;
+	size_t xLargestMin = (size_t)-1;
+	uint32_t ulFrag;
+	uint32_t ulFragPeak = 0;
+	uint32_t i;
+
+	for (i = 0; i < xResult.ulSamples; i++)
+	{
+		pxSample = &xResult.xSamples[i];
+		ulFrag = prvFragmentation(pxSample->xFree, pxSample->xLargest);
+
+		if (ulFrag > ulFragPeak)
+		{
+			ulFragPeak = ulFrag;
+		}
+
+		if (pxSample->xLargest < xLargestMin)
+		{
+			xLargestMin = pxSample->xLargest;
+		}
+
+		printf("# heap_frag,%s,%lu,%lu,%lu,%lu,%lu.%02lu\r\n",
+				pxTrace->pcName,
+				(unsigned long)pxSample->ulOp,
+				(unsigned long)pxSample->xFree,
+				(unsigned long)pxSample->xLargest,
+				(unsigned long)pxSample->xBlocks,
+				(unsigned long)(ulFrag / 100U),
+				(unsigned long)(ulFrag % 100U));
+	}
+
+	printf("# heap_trace,%s,mallocs=%lu,failed=%lu,peak_live=%lu,largest_min=%lu,frag_peak=%lu.%02lu\r\n",
+			pxTrace->pcName,
+			(unsigned long)xResult.ulMallocs,
+			(unsigned long)xResult.ulFailed,
+			(unsigned long)xResult.xPeakLive,
+			(unsigned long)((xResult.ulSamples != 0U) ? xLargestMin : 0U),
+			(unsigned long)(ulFragPeak / 100U),
+			(unsigned long)(ulFragPeak % 100U));
+}
+
+/**
+ * @brief Returns the share of the free bytes outside the largest free block.
+ * @param xFree Free bytes.
+ * @param xLargest Bytes of the largest free block.
+ * @retval Fragmentation, 0 to HEAP_BENCH_FRAG_FULL.
+ */
+static uint32_t prvFragmentation(size_t xFree, size_t xLargest)
+{
+	if ((xFree == 0U) || (xLargest >= xFree))
+	{
+		return 0;
+	}
+
+	return HEAP_BENCH_FRAG_FULL - (uint32_t)(((uint64_t)xLargest * HEAP_BENCH_FRAG_FULL) / xFree);
+}
+
+/**
+ * @brief Allocates ballast blocks until no more than HEAP_BENCH_ARENA_BYTES
+ * are free.
+ * @param None
+ * @retval None
+ * @note Each block is the largest free one, or what is left above the arena.
+ * With several regions, a heap already fragmented by earlier benchmarks, or
+ * heap_tlsf.c, it can take a few.
+ */
+static void prvReserveArena(void)
+{
+	HeapStats_t xStats;
+	size_t xExcess;
+	uint32_t i;
+
+	for (i = 0; i < HEAP_BENCH_BALLAST_BLOCKS; i++)
+	{
+		vPortGetHeapStats(&xStats);
+
+		if ((xStats.xAvailableHeapSpaceInBytes <= HEAP_BENCH_ARENA_BYTES)
+				|| (xStats.xSizeOfLargestFreeBlockInBytes <= HEAP_BENCH_BALLAST_SLACK))
+		{
+			break;
+		}
+
+		xExcess = xStats.xAvailableHeapSpaceInBytes - HEAP_BENCH_ARENA_BYTES;
+
+		if (xExcess > (xStats.xSizeOfLargestFreeBlockInBytes - HEAP_BENCH_BALLAST_SLACK))
+		{
+			xExcess = xStats.xSizeOfLargestFreeBlockInBytes - HEAP_BENCH_BALLAST_SLACK;
+		}
+
+		pvBallast[i] = pvPortMalloc(xExcess);
+
+		/* heap_tlsf.c rounds requests up to a size class, and can refuse one for
+		 * just under the largest free block: ask for less. */
+		while ((pvBallast[i] == NULL) && (xExcess > HEAP_BENCH_BALLAST_SLACK))
+		{
+			xExcess -= xExcess / 8U;
+			pvBallast[i] = pvPortMalloc(xExcess);
+		}
+
+		if (pvBallast[i] == NULL)
+		{
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Frees the ballast blocks.
+ * @param None
+ * @retval None
+ */
+static void prvReleaseArena(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < HEAP_BENCH_BALLAST_BLOCKS; i++)
+	{
+		vPortFree(pvBallast[i]);
+		pvBallast[i] = NULL;
+	}
+}
+
+/**
+ * @brief Returns the next pseudo-random number of the trace (xorshift32).
+ * @param pxState Trace state.
+ * @retval A number, never 0.
+ */
+static uint32_t prvRandom(HeapBenchState_t *pxState)
+{
+	uint32_t x = pxState->ulRandom;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	pxState->ulRandom = x;
+
+	return x;
+}
+
+/**
+ * @brief task_churn: creates or deletes one of CHURN_TASKS tasks, or lets a
+ * semaphore outlive its task go.
+ * @param pxState Trace state.
+ * @param pxOps Receives the operations.
+ * @retval Number of operations.
+ * @note xTaskCreate() allocates the stack then the TCB on a port whose stack
+ * grows down; prvDeleteTCB() frees them in the same order.
+ */
+static uint32_t prvNextTaskChurn(HeapBenchState_t *pxState, HeapBenchOp_t *pxOps)
+{
+	const uint32_t ulRandom = prvRandom(pxState);
+	const uint32_t ulTask = ulRandom % CHURN_TASKS;
+	const uint32_t ulSemaphore = CHURN_SEMAPHORE_SLOT(ulTask);
+
+	if (pxState->pvSlots[ulSemaphore] != NULL)
+	{
+		/* Let go at one visit of its task in 16. */
+		if (((ulRandom >> 8) % 16U) == 0U)
+		{
+			pxOps[0].ulSlot = ulSemaphore;
+			pxOps[0].xSize = 0;
+			return 1;
+		}
+	}
+	else if (((ulRandom >> 8) % 8U) == 0U)
+	{
+		pxOps[0].ulSlot = ulSemaphore;
+		pxOps[0].xSize = sizeof(StaticQueue_t);
+		return 1;
+	}
+
+	if ((pxState->pvSlots[CHURN_STACK_SLOT(ulTask)] != NULL)
+			|| (pxState->pvSlots[CHURN_TCB_SLOT(ulTask)] != NULL))
+	{
+		pxOps[0].ulSlot = CHURN_STACK_SLOT(ulTask);
+		pxOps[0].xSize = 0;
+		pxOps[1].ulSlot = CHURN_TCB_SLOT(ulTask);
+		pxOps[1].xSize = 0;
+		return 2;
+	}
+
+	pxOps[0].ulSlot = CHURN_STACK_SLOT(ulTask);
+	pxOps[0].xSize = CHURN_STACK_BYTES(usChurnStackWords[(ulRandom >> 16) % (sizeof(usChurnStackWords) / sizeof(usChurnStackWords[0]))]);
+	pxOps[1].ulSlot = CHURN_TCB_SLOT(ulTask);
+	pxOps[1].xSize = sizeof(StaticTask_t);
+
+	return 2;
+}
+
+/**
+ * @brief message_churn: the producer allocates a message, or the consumer
+ * frees the oldest one.
+ * @param pxState Trace state.
+ * @param pxOps Receives the operation.
+ * @retval Number of operations.
+ * @note The backlog is a random walk between 0 and MESSAGE_FIFO_DEPTH. One
+ * message in 16 is a frame of MESSAGE_FRAME_MIN to MESSAGE_FRAME_MAX bytes.
+ */
+static uint32_t prvNextMessageChurn(HeapBenchState_t *pxState, HeapBenchOp_t *pxOps)
+{
+	const uint32_t ulRandom = prvRandom(pxState);
+	const uint32_t ulBacklog = pxState->ulHead - pxState->ulTail;
+
+	if ((ulBacklog == MESSAGE_FIFO_DEPTH) || ((ulBacklog != 0U) && ((ulRandom & 1U) != 0U)))
+	{
+		pxOps[0].ulSlot = pxState->ulTail % MESSAGE_FIFO_DEPTH;
+		pxOps[0].xSize = 0;
+		pxState->ulTail++;
+		return 1;
+	}
+
+	pxOps[0].ulSlot = pxState->ulHead % MESSAGE_FIFO_DEPTH;
+
+	if (((ulRandom >> 1) % 16U) == 0U)
+	{
+		pxOps[0].xSize = MESSAGE_FRAME_MIN + ((ulRandom >> 8) % (MESSAGE_FRAME_MAX - MESSAGE_FRAME_MIN + 1U));
+	}
+	else
+	{
+		pxOps[0].xSize = MESSAGE_SIZE;
+	}
+
+	pxState->ulHead++;
+
+	return 1;
+}
+
+/**
+ * @brief mixed: frees a random block, or allocates one of a random size.
+ * @param pxState Trace state.
+ * @param pxOps Receives the operation.
+ * @retval Number of operations.
+ * @note Sizes are spread evenly over the doublings from 16 to 1023 bytes, so
+ * small blocks are common and large ones rare. A slot in use is freed; an
+ * empty one is filled unless it would take the live bytes over three quarters
+ * of the arena, in which case the next slot in use is freed instead.
+ */
+static uint32_t prvNextMixed(HeapBenchState_t *pxState, HeapBenchOp_t *pxOps)
+{
+	const uint32_t ulRandom = prvRandom(pxState);
+	const uint32_t ulShift = MIXED_MIN_SHIFT + ((ulRandom >> 8) % MIXED_SHIFTS);
+	const size_t xSize = ((size_t)1U << ulShift) + ((ulRandom >> 16) % ((size_t)1U << ulShift));
+	uint32_t ulSlot = ulRandom % HEAP_BENCH_SLOTS;
+	uint32_t i;
+
+	if (pxState->pvSlots[ulSlot] == NULL)
+	{
+		if ((pxState->xLiveBytes + xSize) <= ((HEAP_BENCH_ARENA_BYTES * 3U) / 4U))
+		{
+			pxOps[0].ulSlot = ulSlot;
+			pxOps[0].xSize = xSize;
+			return 1;
+		}
+
+		for (i = 1; i < HEAP_BENCH_SLOTS; i++)
+		{
+			if (pxState->pvSlots[(ulSlot + i) % HEAP_BENCH_SLOTS] != NULL)
+			{
+				ulSlot = (ulSlot + i) % HEAP_BENCH_SLOTS;
+				break;
+			}
+		}
+	}
+
+	pxOps[0].ulSlot = ulSlot;
+	pxOps[0].xSize = 0;
+
+	return 1;
+}
@@ -0,0 +1,457 @@
+/*******************************************************************************
+ *
+ * @file	hrtimer.c
+ * @brief	Microsecond one-shot and periodic timers multiplexed onto TIM5.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	TIM5 is the free-running 1 MHz counter of timestamp.c. Active
+ * 			timers are kept in a binary min-heap ordered by deadline, and
+ * 			compare channel 1 is always loaded with the deadline at the top
+ * 			of the heap, so the interrupt only fires when a timer is due.
+ *
+ * 			Callbacks run in the TIM5 interrupt, at TIMESTAMP_IRQ_PRIORITY.
+ * 			They must be short, and may only use the FromISR FreeRTOS API.
+ * 			They may start and stop timers, their own included.
+ *
+ * 			The API may be called from tasks and from ISRs at or below
+ * 			configMAX_SYSCALL_INTERRUPT_PRIORITY. It masks those interrupts
+ * 			while the heap is updated, for O(log HRTIMER_MAX_TIMERS).
+ *
+ * 			hrtimer_delay_us() blocks the calling task on a timer of its own
+ * 			stack, and is woken through its notification count at
+ * 			HRTIMER_DELAY_NOTIFY_INDEX: the last index, which leaves index 0
+ * 			to the application when configTASK_NOTIFICATION_ARRAY_ENTRIES is
+ * 			2 or more.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timestamp.h"
+#include "hrtimer.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define TIM_DIER_CC1IE_OFS		1U
+#define TIM_SR_CC1IF_OFS		1U
+#define TIM_EGR_CC1G_OFS		1U
+
+/* Wrap-safe deadline order on the free-running counter. */
+#define HRTIMER_IS_BEFORE(ulA, ulB)		((int32_t)((ulA) - (ulB)) < 0)
+
+/* Variables -----------------------------------------------------------------*/
+static HrTimer_t *pxHeap[HRTIMER_MAX_TIMERS];
+static uint32_t ulHeapCount = 0;
+static volatile uint32_t ulOverruns = 0;
+
+/* Private function prototypes -----------------------------------------------*/
+static void hrtimer_heap_insert(HrTimer_t *pxTimer);
+static void hrtimer_heap_remove(HrTimer_t *pxTimer);
+static void hrtimer_heap_place(uint32_t ulIndex, HrTimer_t *pxTimer);
+static void hrtimer_program_compare(void);
+static void hrtimer_delay_expired(HrTimer_t *pxTimer, void *pvArg);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Starts the time source if needed and enables the compare interrupt.
+ * @param None
+ * @retval 0 if successful, -1 otherwise.
+ * @note Calling timestamp_init() again after changing the clock profile
+ * restarts the counter, so restart the active timers after it.
+ */
+int32_t hrtimer_init(void)
+{
+	if (timestamp_init() != 0)
+	{
+		return -1;
+	}
+
+	TIM5->SR = ~(1U << TIM_SR_CC1IF_OFS);
+	TIM5->DIER |= (1U << TIM_DIER_CC1IE_OFS);
+
+	return 0;
+}
+
+/**
+ * @brief Initializes a stopped timer whose callback runs in the interrupt.
+ * @param pxTimer Timer to initialize.
+ * @param pxCallback Function called on expiry.
+ * @param pvArg Argument passed to pxCallback.
+ * @retval None
+ */
+void hrtimer_setup(HrTimer_t *pxTimer, HrTimerCallback_t pxCallback, void *pvArg)
+{
+	pxTimer->ulDeadline = 0;
+	pxTimer->ulPeriodUs = 0;
+	pxTimer->pxCallback = pxCallback;
+	pxTimer->pvArg = pvArg;
+	pxTimer->xTask = NULL;
+	pxTimer->ulNotifyBits = 0;
+	pxTimer->ulHeapIndex = HRTIMER_INACTIVE;
+}
+
+/**
+ * @brief Initializes a stopped timer that sets notification bits of a task
+ * on expiry.
+ * @param pxTimer Timer to initialize.
+ * @param xTask Task to notify.
+ * @param ulNotifyBits Bits set in the task's notification value.
+ * @retval None
+ */
+void hrtimer_setup_notify(HrTimer_t *pxTimer, TaskHandle_t xTask, uint32_t ulNotifyBits)
+{
+	hrtimer_setup(pxTimer, NULL, NULL);
+	pxTimer->xTask = xTask;
+	pxTimer->ulNotifyBits = ulNotifyBits;
+}
+
+/**
+ * @brief Starts (or restarts) a timer relative to now.
+ * @param pxTimer Timer set up with hrtimer_setup() or hrtimer_setup_notify().
+ * @param ulDelayUs Time until the first expiry.
+ * @param ulPeriodUs Time between later expiries, 0 for a one-shot timer.
+ * @retval 0 if successful, -1 if a time is out of range or too many timers
+ * are active.
+ */
+int32_t hrtimer_start(HrTimer_t *pxTimer, uint32_t ulDelayUs, uint32_t ulPeriodUs)
+{
+	if (ulDelayUs > HRTIMER_MAX_DELAY_US)
+	{
+		return -1;
+	}
+
+	return hrtimer_start_at(pxTimer, TIM5->CNT + ulDelayUs, ulPeriodUs);
+}
+
+/**
+ * @brief Starts (or restarts) a timer at an absolute counter value.
+ * @param pxTimer Timer set up with hrtimer_setup() or hrtimer_setup_notify().
+ * @param ulDeadline hrtimer_now() value of the first expiry, at most
+ * HRTIMER_MAX_DELAY_US ahead. A deadline already passed expires at once.
+ * @param ulPeriodUs Time between later expiries, 0 for a one-shot timer.
+ * @retval 0 if successful, -1 if a time is out of range or too many timers
+ * are active.
+ * @note Periodic deadlines advance by ulPeriodUs from ulDeadline, so they do
+ * not drift with interrupt latency.
+ */
+int32_t hrtimer_start_at(HrTimer_t *pxTimer, uint32_t ulDeadline, uint32_t ulPeriodUs)
+{
+	UBaseType_t uxSavedInterruptStatus;
+	int32_t lReturn = 0;
+
+	if ((pxTimer == NULL) || (ulPeriodUs > HRTIMER_MAX_DELAY_US))
+	{
+		return -1;
+	}
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		if (pxTimer->ulHeapIndex != HRTIMER_INACTIVE)
+		{
+			hrtimer_heap_remove(pxTimer);
+		}
+
+		if (ulHeapCount < HRTIMER_MAX_TIMERS)
+		{
+			pxTimer->ulDeadline = ulDeadline;
+			pxTimer->ulPeriodUs = ulPeriodUs;
+			hrtimer_heap_insert(pxTimer);
+			hrtimer_program_compare();
+		}
+		else
+		{
+			lReturn = -1;
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+	return lReturn;
+}
+
+/**
+ * @brief Stops a timer. Does nothing if it is not active.
+ * @param pxTimer Timer to stop.
+ * @retval None
+ */
+void hrtimer_stop(HrTimer_t *pxTimer)
+{
+	UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		if (pxTimer->ulHeapIndex != HRTIMER_INACTIVE)
+		{
+			hrtimer_heap_remove(pxTimer);
+			hrtimer_program_compare();
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+/**
+ * @brief Tells whether a timer is waiting to expire.
+ * @param pxTimer Timer.
+ * @retval 1 if active, 0 otherwise.
+ */
+uint32_t hrtimer_is_active(const HrTimer_t *pxTimer)
+{
+	return (pxTimer->ulHeapIndex != HRTIMER_INACTIVE) ? 1U : 0U;
+}
+
+/**
+ * @brief Returns the free-running microsecond counter.
+ * @param None
+ * @retval TIM5 count, wrapping every 2^32 us (about 71 minutes).
+ */
+uint32_t hrtimer_now(void)
+{
+	return timestamp_now32();
+}
+
+/**
+ * @brief Returns the number of periodic expiries that were skipped because the
+ * interrupt ran more than one period late.
+ * @param None
+ * @retval Skipped expiries since start-up.
+ */
+uint32_t hrtimer_get_overruns(void)
+{
+	return ulOverruns;
+}
+
+/**
+ * @brief Blocks the calling task for a number of microseconds, leaving the CPU
+ * to other tasks, unlike a busy loop.
+ * @param ulDelayUs Delay, at most HRTIMER_MAX_DELAY_US.
+ * @retval 0 if successful, -1 if the delay is out of range.
+ * @note Tasks only. Resolution is the 1 us counter; the task is made ready by
+ * the TIM5 interrupt and runs after it if it has the highest priority, a few
+ * microseconds late. Delays below HRTIMER_DELAY_SPIN_US, which would not
+ * cover the two context switches, busy-wait on the counter, as do delays
+ * before the scheduler starts or when HRTIMER_MAX_TIMERS timers are active.
+ */
+int32_t hrtimer_delay_us(uint32_t ulDelayUs)
+{
+	const uint32_t ulDeadline = TIM5->CNT + ulDelayUs;
+	HrTimer_t xTimer;
+
+	if (ulDelayUs > HRTIMER_MAX_DELAY_US)
+	{
+		return -1;
+	}
+
+	if ((ulDelayUs >= HRTIMER_DELAY_SPIN_US)
+			&& (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING))
+	{
+		hrtimer_setup(&xTimer, hrtimer_delay_expired, xTaskGetCurrentTaskHandle());
+		(void)xTaskNotifyStateClearIndexed(NULL, HRTIMER_DELAY_NOTIFY_INDEX);
+		(void)ulTaskNotifyValueClearIndexed(NULL, HRTIMER_DELAY_NOTIFY_INDEX, 0xFFFFFFFFUL);
+
+		if (hrtimer_start_at(&xTimer, ulDeadline, 0) == 0)
+		{
+			/* A stray give on the index must not return with xTimer, on this
+			 * stack, still in the heap. */
+			while (hrtimer_is_active(&xTimer) != 0U)
+			{
+				(void)ulTaskNotifyTakeIndexed(HRTIMER_DELAY_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+			}
+
+			return 0;
+		}
+	}
+
+	while (HRTIMER_IS_BEFORE(TIM5->CNT, ulDeadline))
+	{
+		/* Busy-wait. */
+	}
+
+	return 0;
+}
+
+/**
+ * @brief TIM5 compare channel 1 match (the nearest deadline), called from
+ * TIM5_IRQHandler() in timestamp.c.
+ * @note Every timer that is due is expired before returning. The heap is only
+ * locked while it changes, so callbacks run with interrupts enabled.
+ * @param None
+ * @retval None
+ */
+void timestamp_compare_callback(void)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	UBaseType_t uxSavedInterruptStatus;
+	HrTimer_t *pxTimer;
+
+	while (1)
+	{
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+		if ((ulHeapCount == 0U) || HRTIMER_IS_BEFORE(TIM5->CNT, pxHeap[0]->ulDeadline))
+		{
+			hrtimer_program_compare();
+			taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+			break;
+		}
+
+		pxTimer = pxHeap[0];
+		hrtimer_heap_remove(pxTimer);
+
+		if (pxTimer->ulPeriodUs != 0U)
+		{
+			pxTimer->ulDeadline += pxTimer->ulPeriodUs;
+
+			/* More than a period late: skip the missed expiries rather than
+			 * run them back to back. */
+			if (!HRTIMER_IS_BEFORE(TIM5->CNT, pxTimer->ulDeadline))
+			{
+				pxTimer->ulDeadline = TIM5->CNT + pxTimer->ulPeriodUs;
+				ulOverruns++;
+			}
+
+			hrtimer_heap_insert(pxTimer);
+		}
+
+		taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+		if (pxTimer->pxCallback != NULL)
+		{
+			pxTimer->pxCallback(pxTimer, pxTimer->pvArg);
+		}
+		else if (pxTimer->xTask != NULL)
+		{
+			(void)xTaskNotifyFromISR(pxTimer->xTask, pxTimer->ulNotifyBits, eSetBits,
+					&xHigherPriorityTaskWoken);
+		}
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Adds a timer to the heap. The heap must not be full.
+ * @param pxTimer Timer with its deadline set.
+ * @retval None
+ */
+static void hrtimer_heap_insert(HrTimer_t *pxTimer)
+{
+	uint32_t ulIndex = ulHeapCount++;
+	uint32_t ulParent;
+
+	/* Sift up. */
+	while (ulIndex > 0U)
+	{
+		ulParent = (ulIndex - 1U) / 2U;
+
+		if (!HRTIMER_IS_BEFORE(pxTimer->ulDeadline, pxHeap[ulParent]->ulDeadline))
+		{
+			break;
+		}
+
+		hrtimer_heap_place(ulIndex, pxHeap[ulParent]);
+		ulIndex = ulParent;
+	}
+
+	hrtimer_heap_place(ulIndex, pxTimer);
+}
+
+/**
+ * @brief Removes an active timer from the heap.
+ * @param pxTimer Timer to remove.
+ * @retval None
+ */
+static void hrtimer_heap_remove(HrTimer_t *pxTimer)
+{
+	uint32_t ulIndex = pxTimer->ulHeapIndex;
+	HrTimer_t *pxLast;
+	uint32_t ulChild;
+
+	pxTimer->ulHeapIndex = HRTIMER_INACTIVE;
+	pxLast = pxHeap[--ulHeapCount];
+
+	if (pxLast == pxTimer)
+	{
+		return;
+	}
+
+	/* The last timer fills the hole. It may have to move up past the
+	 * removed timer's ancestors, or down past its descendants. */
+	while ((ulIndex > 0U)
+			&& HRTIMER_IS_BEFORE(pxLast->ulDeadline, pxHeap[(ulIndex - 1U) / 2U]->ulDeadline))
+	{
+		hrtimer_heap_place(ulIndex, pxHeap[(ulIndex - 1U) / 2U]);
+		ulIndex = (ulIndex - 1U) / 2U;
+	}
+
+	while ((ulChild = (2U * ulIndex) + 1U) < ulHeapCount)
+	{
+		if (((ulChild + 1U) < ulHeapCount)
+				&& HRTIMER_IS_BEFORE(pxHeap[ulChild + 1U]->ulDeadline, pxHeap[ulChild]->ulDeadline))
+		{
+			ulChild++;
+		}
+
+		if (!HRTIMER_IS_BEFORE(pxHeap[ulChild]->ulDeadline, pxLast->ulDeadline))
+		{
+			break;
+		}
+
+		hrtimer_heap_place(ulIndex, pxHeap[ulChild]);
+		ulIndex = ulChild;
+	}
+
+	hrtimer_heap_place(ulIndex, pxLast);
+}
+
+/**
+ * @brief Stores a timer at a heap position and records the position in it.
+ * @param ulIndex Heap position.
+ * @param pxTimer Timer.
+ * @retval None
+ */
+static void hrtimer_heap_place(uint32_t ulIndex, HrTimer_t *pxTimer)
+{
+	pxHeap[ulIndex] = pxTimer;
+	pxTimer->ulHeapIndex = ulIndex;
+}
+
+/**
+ * @brief Expiry of a hrtimer_delay_us() timer: makes the delayed task ready.
+ * @param pxTimer Unused.
+ * @param pvArg Handle of the delayed task.
+ * @retval None
+ */
+static void hrtimer_delay_expired(HrTimer_t *pxTimer, void *pvArg)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	vTaskNotifyGiveIndexedFromISR((TaskHandle_t)pvArg, HRTIMER_DELAY_NOTIFY_INDEX,
+			&xHigherPriorityTaskWoken);
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Loads compare channel 1 with the nearest deadline.
+ * @param None
+ * @retval None
+ * @note A deadline that passed before it was loaded would not match for
+ * another 2^32 us, so the compare event is forced instead. Called with the
+ * heap locked.
+ */
+static void hrtimer_program_compare(void)
+{
+	if (ulHeapCount == 0U)
+	{
+		return;
+	}
+
+	TIM5->CCR1 = pxHeap[0]->ulDeadline;
+
+	if (!HRTIMER_IS_BEFORE(TIM5->CNT, pxHeap[0]->ulDeadline))
+	{
+		TIM5->EGR = (1U << TIM_EGR_CC1G_OFS);
+	}
+}
@@ -0,0 +1,581 @@
+/*******************************************************************************
+ *
+ * @file	isr_rate_bench.c
+ * @brief	ISR-to-task event capacity benchmark: the highest interrupt rate
+ * 			each hand-off primitive sustains.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	Must be called from the highest priority task. TIM14 interrupts
+ * 			at a rate that starts at ISR_RATE_BENCH_START_HZ and grows by
+ * 			ISR_RATE_BENCH_STEP_PERCENT per step, and its ISR hands one event
+ * 			per interrupt to a consumer task through one primitive:
+ *
+ * 				queue			xQueueSendFromISR() of a 4-byte sequence
+ * 								number, one xQueueReceive() per event, as
+ * 								in 26_UART_Rx_Single_Byte_Interrupt.
+ * 				semaphore		xSemaphoreGiveFromISR() on a counting
+ * 								semaphore, one xSemaphoreTake() per event,
+ * 								as in 27_UART_Rx_Multi_Byte_Interrupt.
+ * 				notify			vTaskNotifyGiveFromISR(), and
+ * 								ulTaskNotifyTake(pdTRUE) takes every pending
+ * 								event at once, as in 31_Task_Notifications.
+ * 				stream_buffer	xStreamBufferSendFromISR() of the sequence
+ * 								number, read back in as many as fit.
+ * 				spsc_ring		spsc_ring_put() of the sequence number and
+ * 								spsc_ring_wake_from_isr(), read back in as
+ * 								many as are there.
+ *
+ * 			Every primitive holds ISR_RATE_BENCH_DEPTH events, so each one
+ * 			gets the same slack; the notification count has no limit of
+ * 			its own, so the ISR drops an event that would make it deeper.
+ * 			The consumer does no work per event, so the results are the
+ * 			ceiling of the primitive, with no application on top.
+ *
+ * 			A step lasts ISR_RATE_BENCH_STEP_MS worth of interrupts, and is
+ * 			sustained if:
+ * 			- no event was dropped for lack of room (loss),
+ * 			- the interrupts took no longer than the timer periods, so
+ * 			  none was merged into the next one (isr), and
+ * 			- a spinning task at the lowest priority still got
+ * 			  ISR_RATE_BENCH_IDLE_PERCENT of the CPU, against a run with
+ * 			  no interrupts (cpu).
+ * 			The ISR stops the timer itself after the last interrupt, so a
+ * 			rate that leaves no time to any task still ends.
+ *
+ * 			Each step is a comment line, and each primitive ends with a
+ * 			summary of the highest sustained rate and what stopped it:
+ *
+ * 				# isr_rate_summary primitive=queue cpu_mhz=84 max_rate_hz=...
+ * 						limit=cpu
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "bench.h"
+#include "spsc_ring.h"
+#include "isr_rate_bench.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define RATE_STACK_SIZE			configMINIMAL_STACK_SIZE
+#define RATE_SPIN_PRIORITY		(tskIDLE_PRIORITY + 1)
+#define RATE_CONSUMER_PRIORITY	(tskIDLE_PRIORITY + 2)
+#define RATE_EVENT_BYTES		sizeof(uint32_t)
+#define RATE_RING_SIZE			(ISR_RATE_BENCH_DEPTH * RATE_EVENT_BYTES)
+#define RATE_DRAIN_TICKS		pdMS_TO_TICKS(10U)
+#define RATE_OVERRUN_PERMILLE	10U			/* Slack on the timer periods. */
+
+#if ((ISR_RATE_BENCH_DEPTH & (ISR_RATE_BENCH_DEPTH - 1U)) != 0U)
+#error "ISR_RATE_BENCH_DEPTH must be a power of two (spsc_ring.h)"
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef enum
+{
+	RATE_QUEUE = 0,
+	RATE_SEMAPHORE,
+	RATE_NOTIFY,
+	RATE_STREAM_BUFFER,
+	RATE_SPSC_RING,
+	RATE_PRIMITIVE_COUNT,
+	RATE_NONE = RATE_PRIMITIVE_COUNT
+} RatePrimitive_t;
+
+typedef struct
+{
+	uint32_t ulRateHz;				/* From the timer settings. */
+	uint32_t ulEvents;				/* Accepted by the primitive. */
+	uint32_t ulLost;				/* Dropped for lack of room. */
+	uint32_t ulBacklog;				/* Still not consumed after the drain. */
+	uint32_t ulFreePercent;			/* CPU left to the spinning task. */
+	BaseType_t xOverrun;			/* Interrupts merged. */
+} RateStep_t;
+
+/* Variables -----------------------------------------------------------------*/
+static const char * const pcPrimitiveNames[RATE_PRIMITIVE_COUNT] =
+{
+	[RATE_QUEUE] = "queue",
+	[RATE_SEMAPHORE] = "semaphore",
+	[RATE_NOTIFY] = "notify",
+	[RATE_STREAM_BUFFER] = "stream_buffer",
+	[RATE_SPSC_RING] = "spsc_ring",
+};
+
+static StaticQueue_t xQueueBuffer;
+static uint8_t ucQueueStorage[ISR_RATE_BENCH_DEPTH * RATE_EVENT_BYTES];
+static QueueHandle_t xQueue = NULL;
+static StaticSemaphore_t xSemaphoreBuffer;
+static SemaphoreHandle_t xSemaphore = NULL;
+static StaticStreamBuffer_t xStreamBufferBuffer;
+static uint8_t ucStreamStorage[(ISR_RATE_BENCH_DEPTH * RATE_EVENT_BYTES) + 1U];
+static StreamBufferHandle_t xStreamBuffer = NULL;
+static SpscRing_t xRing;
+static uint8_t ucRingStorage[RATE_RING_SIZE];
+
+static StaticTask_t xConsumerTcb;
+static StackType_t xConsumerStack[RATE_STACK_SIZE];
+static TaskHandle_t xConsumerTask = NULL;
+static StaticTask_t xSpinTcb;
+static StackType_t xSpinStack[RATE_STACK_SIZE];
+static TaskHandle_t xSpinTask = NULL;
+
+/* Written by the ISR, read by the benchmark once it is done. */
+static volatile RatePrimitive_t eActive = RATE_NONE;
+static volatile uint32_t ulIsrCount = 0;
+static volatile uint32_t ulIsrTarget = 0;
+static volatile uint32_t ulAccepted = 0;
+static volatile uint32_t ulLost = 0;
+static volatile uint32_t ulEndCycles = 0;
+static volatile uint32_t ulEndSpins = 0;
+static volatile BaseType_t xDone = pdFALSE;
+
+static volatile uint32_t ulReceived = 0;	/* Consumer only. */
+static volatile uint32_t ulSpins = 0;		/* Spinning task only. */
+
+/* Spins per cycle with no interrupts, as a ratio. */
+static uint32_t ulBaseSpins = 0;
+static uint32_t ulBaseCycles = 0;
+
+/* Private function prototypes -----------------------------------------------*/
+static void prvCreateObjects(void);
+static void prvResetPrimitive(RatePrimitive_t ePrimitive);
+static void prvMeasureBaseline(void);
+static void prvRunStep(uint32_t ulRateHz, RateStep_t *pxStep);
+static uint32_t prvTimerClock(void);
+static uint32_t prvTimerStart(uint32_t ulRateHz, uint32_t *pulPeriodTicks);
+static void prvTimerStop(void);
+static void vConsumerTask(void *pvParameters);
+static void vSpinTask(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Runs every primitive at increasing rates at the current clock and
+ * prints its results.
+ * @param None
+ * @retval None
+ */
+void isr_rate_bench_run(void)
+{
+	RatePrimitive_t ePrimitive;
+	RateStep_t xStep;
+	const char *pcLimit;
+	uint32_t ulRateHz;
+	uint32_t ulBestHz;
+
+	printf("# isr_rate depth=%lu step_ms=%lu idle_percent=%lu start_hz=%lu step_percent=%lu\r\n",
+			(unsigned long)ISR_RATE_BENCH_DEPTH, (unsigned long)ISR_RATE_BENCH_STEP_MS,
+			(unsigned long)ISR_RATE_BENCH_IDLE_PERCENT, (unsigned long)ISR_RATE_BENCH_START_HZ,
+			(unsigned long)ISR_RATE_BENCH_STEP_PERCENT);
+
+	prvCreateObjects();
+
+	ulSpins = 0;
+	xSpinTask = xTaskCreateStatic(vSpinTask, "vRateSpin", RATE_STACK_SIZE, NULL,
+			RATE_SPIN_PRIORITY, xSpinStack, &xSpinTcb);
+
+	prvMeasureBaseline();
+
+	for (ePrimitive = RATE_QUEUE; ePrimitive < RATE_PRIMITIVE_COUNT; ePrimitive++)
+	{
+		prvResetPrimitive(ePrimitive);
+		eActive = ePrimitive;
+		xConsumerTask = xTaskCreateStatic(vConsumerTask, "vRateConsumer", RATE_STACK_SIZE, NULL,
+				RATE_CONSUMER_PRIORITY, xConsumerStack, &xConsumerTcb);
+
+		ulRateHz = ISR_RATE_BENCH_START_HZ;
+		ulBestHz = 0;
+		pcLimit = "none";
+
+		while (ulRateHz <= ISR_RATE_BENCH_MAX_HZ)
+		{
+			prvRunStep(ulRateHz, &xStep);
+
+			printf("# isr_rate_step primitive=%s rate_hz=%lu events=%lu lost=%lu backlog=%lu isr_overrun=%ld cpu_free_pct=%lu\r\n",
+					pcPrimitiveNames[ePrimitive], (unsigned long)xStep.ulRateHz,
+					(unsigned long)xStep.ulEvents, (unsigned long)xStep.ulLost,
+					(unsigned long)xStep.ulBacklog, (long)xStep.xOverrun,
+					(unsigned long)xStep.ulFreePercent);
+
+			if ((xStep.ulLost != 0U) || (xStep.ulBacklog != 0U))
+			{
+				pcLimit = "loss";
+				break;
+			}
+			else if (xStep.xOverrun != pdFALSE)
+			{
+				pcLimit = "isr";
+				break;
+			}
+			else if (xStep.ulFreePercent < ISR_RATE_BENCH_IDLE_PERCENT)
+			{
+				pcLimit = "cpu";
+				break;
+			}
+
+			ulBestHz = xStep.ulRateHz;
+			ulRateHz += (ulRateHz * ISR_RATE_BENCH_STEP_PERCENT) / 100U;
+		}
+
+		/* Blocked on an empty primitive, so it can go at once. */
+		vTaskDelete(xConsumerTask);
+		xConsumerTask = NULL;
+		eActive = RATE_NONE;
+
+		printf("# isr_rate_summary primitive=%s cpu_mhz=%lu max_rate_hz=%lu limit=%s\r\n",
+				pcPrimitiveNames[ePrimitive], (unsigned long)BENCH_CYCLES_MHZ,
+				(unsigned long)ulBestHz, pcLimit);
+	}
+
+	vTaskDelete(xSpinTask);
+	xSpinTask = NULL;
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Creates the primitives on their static storage, once.
+ * @param None
+ * @retval None
+ */
+static void prvCreateObjects(void)
+{
+	if (xQueue != NULL)
+	{
+		return;
+	}
+
+	xQueue = xQueueCreateStatic(ISR_RATE_BENCH_DEPTH, RATE_EVENT_BYTES, ucQueueStorage,
+			&xQueueBuffer);
+	xSemaphore = xSemaphoreCreateCountingStatic(ISR_RATE_BENCH_DEPTH, 0, &xSemaphoreBuffer);
+
+	/* Woken by every event, like the others. */
+	xStreamBuffer = xStreamBufferCreateStatic(sizeof(ucStreamStorage) - 1U, RATE_EVENT_BYTES,
+			ucStreamStorage, &xStreamBufferBuffer);
+}
+
+/**
+ * @brief Empties a primitive and clears the counters before its first step.
+ * @param ePrimitive Primitive.
+ * @retval None
+ */
+static void prvResetPrimitive(RatePrimitive_t ePrimitive)
+{
+	switch (ePrimitive)
+	{
+	case RATE_QUEUE:
+		(void)xQueueReset(xQueue);
+		break;
+
+	case RATE_SEMAPHORE:
+		/* A semaphore is a queue of no items: this zeroes its count. */
+		(void)xQueueReset((QueueHandle_t)xSemaphore);
+		break;
+
+	case RATE_STREAM_BUFFER:
+		(void)xStreamBufferReset(xStreamBuffer);
+		break;
+
+	case RATE_SPSC_RING:
+		(void)spsc_ring_init(&xRing, ucRingStorage, sizeof(ucRingStorage));
+		break;
+
+	default:
+		/* The notification count is the new consumer's, from 0. */
+		break;
+	}
+
+	ulAccepted = 0;
+	ulReceived = 0;
+}
+
+/**
+ * @brief Counts the spins of the spinning task over one step with no
+ * interrupts.
+ * @param None
+ * @retval None
+ */
+static void prvMeasureBaseline(void)
+{
+	const uint32_t ulStartSpins = ulSpins;
+	const uint32_t ulStart = bench_cycles();
+
+	vTaskDelay(pdMS_TO_TICKS(ISR_RATE_BENCH_STEP_MS));
+
+	ulBaseSpins = ulSpins - ulStartSpins;
+	ulBaseCycles = bench_cycles() - ulStart;
+}
+
+/**
+ * @brief Runs one step at a rate and collects its results.
+ * @param ulRateHz Requested interrupt rate.
+ * @param pxStep Where to put the results.
+ * @retval None
+ * @note The consumer has drained the previous step, so the primitive is
+ * empty.
+ */
+static void prvRunStep(uint32_t ulRateHz, RateStep_t *pxStep)
+{
+	uint32_t ulPeriodTicks;
+	uint32_t ulStartSpins;
+	uint32_t ulStart;
+	uint32_t ulElapsed;
+	uint64_t ullExpected;
+	uint64_t ullFree;
+	TickType_t xDrain;
+
+	ulIsrCount = 0;
+	ulLost = 0;
+	ulAccepted = 0;
+	ulReceived = 0;
+	xDone = pdFALSE;
+	ulIsrTarget = (uint32_t)(((uint64_t)ulRateHz * ISR_RATE_BENCH_STEP_MS) / 1000U);
+
+	ulStartSpins = ulSpins;
+	ulStart = bench_cycles();
+	pxStep->ulRateHz = prvTimerStart(ulRateHz, &ulPeriodTicks);
+
+	vTaskDelay(pdMS_TO_TICKS(ISR_RATE_BENCH_STEP_MS));
+
+	while (xDone == pdFALSE)
+	{
+		vTaskDelay(1);
+	}
+
+	/* Let the consumer catch up with what the primitive still holds. */
+	for (xDrain = 0; (xDrain < RATE_DRAIN_TICKS) && (ulReceived != ulAccepted); xDrain++)
+	{
+		vTaskDelay(1);
+	}
+
+	ulElapsed = ulEndCycles - ulStart;
+
+	/* ulIsrTarget timer periods, in core clock cycles. */
+	ullExpected = ((uint64_t)ulIsrTarget * ulPeriodTicks * SystemCoreClock) / prvTimerClock();
+
+	pxStep->ulEvents = ulAccepted;
+	pxStep->ulLost = ulLost;
+	pxStep->ulBacklog = ulAccepted - ulReceived;
+	pxStep->xOverrun = ((uint64_t)ulElapsed * 1000U > ullExpected * (1000U + RATE_OVERRUN_PERMILLE))
+			? pdTRUE : pdFALSE;
+
+	ullFree = ((uint64_t)(ulEndSpins - ulStartSpins) * ulBaseCycles * 100U);
+	ullFree /= ((uint64_t)ulBaseSpins * ulElapsed) + 1U;
+	pxStep->ulFreePercent = (ullFree > 100U) ? 100U : (uint32_t)ullFree;
+}
+
+/**
+ * @brief Returns the clock of the APB1 timers.
+ * @param None
+ * @retval Timer clock in Hz.
+ */
+static uint32_t prvTimerClock(void)
+{
+	uint32_t ulClock = HAL_RCC_GetPCLK1Freq();
+
+	/* The timer clock is PCLK1, doubled when APB1 is divided. */
+	if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+	{
+		ulClock *= 2U;
+	}
+
+	return ulClock;
+}
+
+/**
+ * @brief Starts TIM14 interrupting at about a rate.
+ * @param ulRateHz Requested rate.
+ * @param pulPeriodTicks Where to put the timer clocks per interrupt.
+ * @retval Rate set, in Hz.
+ */
+static uint32_t prvTimerStart(uint32_t ulRateHz, uint32_t *pulPeriodTicks)
+{
+	const uint32_t ulClock = prvTimerClock();
+	const uint32_t ulTicks = ulClock / ulRateHz;
+	const uint32_t ulPrescaler = ((ulTicks - 1U) >> 16) + 1U;	/* TIM14 is 16-bit. */
+	const uint32_t ulReload = ulTicks / ulPrescaler;
+
+	RCC->APB1ENR |= RCC_APB1ENR_TIM14EN;
+	(void)RCC->APB1ENR;
+
+	TIM14->CR1 = TIM_CR1_URS;
+	TIM14->PSC = ulPrescaler - 1U;
+	TIM14->ARR = ulReload - 1U;
+	TIM14->EGR = TIM_EGR_UG;
+	TIM14->SR = 0;
+	TIM14->DIER = TIM_DIER_UIE;
+
+	NVIC_SetPriority(TIM8_TRG_COM_TIM14_IRQn, ISR_RATE_BENCH_IRQ_PRIORITY);
+	NVIC_ClearPendingIRQ(TIM8_TRG_COM_TIM14_IRQn);
+	NVIC_EnableIRQ(TIM8_TRG_COM_TIM14_IRQn);
+
+	TIM14->CR1 |= TIM_CR1_CEN;
+
+	*pulPeriodTicks = ulPrescaler * ulReload;
+
+	return ulClock / (ulPrescaler * ulReload);
+}
+
+/**
+ * @brief Stops TIM14 and discards an interrupt still pending.
+ * @param None
+ * @retval None
+ * @note Called from the ISR, after the last interrupt of a step.
+ */
+static void prvTimerStop(void)
+{
+	TIM14->CR1 &= ~TIM_CR1_CEN;
+	TIM14->DIER = 0;
+	TIM14->SR = 0;
+	NVIC_DisableIRQ(TIM8_TRG_COM_TIM14_IRQn);
+	NVIC_ClearPendingIRQ(TIM8_TRG_COM_TIM14_IRQn);
+}
+
+/**
+ * @brief Takes the events of the active primitive as fast as they come.
+ * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
+ * task function signature.
+ * @retval None
+ */
+static void vConsumerTask(void *pvParameters)
+{
+	uint32_t ulEvents[ISR_RATE_BENCH_DEPTH];
+	uint32_t ulCount;
+
+	for (;;)
+	{
+		switch (eActive)
+		{
+		case RATE_QUEUE:
+			if (xQueueReceive(xQueue, &ulEvents[0], portMAX_DELAY) == pdPASS)
+			{
+				ulReceived++;
+			}
+			break;
+
+		case RATE_SEMAPHORE:
+			if (xSemaphoreTake(xSemaphore, portMAX_DELAY) == pdPASS)
+			{
+				ulReceived++;
+			}
+			break;
+
+		case RATE_NOTIFY:
+			ulReceived += ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+			break;
+
+		case RATE_STREAM_BUFFER:
+			ulCount = xStreamBufferReceive(xStreamBuffer, ulEvents, sizeof(ulEvents), portMAX_DELAY);
+			ulReceived += ulCount / RATE_EVENT_BYTES;
+			break;
+
+		case RATE_SPSC_RING:
+			/* Whole events only: the ISR may be half way through one. */
+			ulCount = spsc_ring_wait(&xRing, portMAX_DELAY) & ~(RATE_EVENT_BYTES - 1U);
+			ulCount = spsc_ring_read(&xRing, (uint8_t *)ulEvents, ulCount);
+			ulReceived += ulCount / RATE_EVENT_BYTES;
+			break;
+
+		default:
+			vTaskSuspend(NULL);
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Counts while nothing else wants the CPU.
+ * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
+ * task function signature.
+ * @retval None
+ */
+static void vSpinTask(void *pvParameters)
+{
+	for (;;)
+	{
+		ulSpins++;
+	}
+}
+
+/**
+ * @brief TIM14 IRQ handler: hands one event to the active primitive, and
+ * stops the timer after the last interrupt of the step.
+ * @param None
+ * @retval None
+ */
+void TIM8_TRG_COM_TIM14_IRQHandler(void)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	const uint32_t ulSequence = ulIsrCount;
+	BaseType_t xAccepted = pdFALSE;
+	uint32_t i;
+
+	TIM14->SR = ~(1U << TIM_SR_UIF_Pos);
+
+	switch (eActive)
+	{
+	case RATE_QUEUE:
+		xAccepted = xQueueSendFromISR(xQueue, &ulSequence, &xHigherPriorityTaskWoken);
+		break;
+
+	case RATE_SEMAPHORE:
+		xAccepted = xSemaphoreGiveFromISR(xSemaphore, &xHigherPriorityTaskWoken);
+		break;
+
+	case RATE_NOTIFY:
+		if ((ulAccepted - ulReceived) < ISR_RATE_BENCH_DEPTH)
+		{
+			vTaskNotifyGiveFromISR(xConsumerTask, &xHigherPriorityTaskWoken);
+			xAccepted = pdTRUE;
+		}
+		break;
+
+	case RATE_STREAM_BUFFER:
+		xAccepted = (xStreamBufferSendFromISR(xStreamBuffer, &ulSequence, RATE_EVENT_BYTES,
+				&xHigherPriorityTaskWoken) == RATE_EVENT_BYTES) ? pdTRUE : pdFALSE;
+		break;
+
+	case RATE_SPSC_RING:
+		if ((RATE_RING_SIZE - spsc_ring_count(&xRing)) >= RATE_EVENT_BYTES)
+		{
+			for (i = 0; i < RATE_EVENT_BYTES; i++)
+			{
+				(void)spsc_ring_put(&xRing, (uint8_t)(ulSequence >> (8U * i)));
+			}
+
+			spsc_ring_wake_from_isr(&xRing, &xHigherPriorityTaskWoken);
+			xAccepted = pdTRUE;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	if (xAccepted != pdFALSE)
+	{
+		ulAccepted++;
+	}
+	else
+	{
+		ulLost++;
+	}
+
+	ulIsrCount = ulSequence + 1U;
+
+	if (ulIsrCount >= ulIsrTarget)
+	{
+		prvTimerStop();
+		ulEndCycles = bench_cycles();
+		ulEndSpins = ulSpins;
+		xDone = pdTRUE;
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
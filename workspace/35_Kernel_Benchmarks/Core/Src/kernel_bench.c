@@ -0,0 +1,1850 @@
+/*******************************************************************************
+ *
+ * @file	kernel_bench.c
+ * @brief	Micro-benchmarks of the FreeRTOS primitives, in core clock cycles.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Must be called from the highest priority task. Each benchmark
+ * 			takes KERNEL_BENCH_ITERATIONS samples and prints one CSV row
+ * 			(see bench.c). Round trips between two tasks include both
+ * 			context switches.
+ *
+ * 			Helper tasks are created statically for one benchmark and
+ * 			deleted at its end, so the heap only holds the objects under
+ * 			test. The kernel configuration the results depend on is printed
+ * 			as a comment line first: rebuild with another task selection,
+ * 			timer backend or queue batch or copy setting to compare.
+ *
+ * 			Only the kernel API and Error_Handler() are used, so the same
+ * 			file also runs on the host simulator port (Host/Makefile).
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "timers.h"
+#include "atomic.h"
+#include "light_semphr.h"
+#include "light_channel.h"
+#include "barrier.h"
+#include "notify_group.h"
+#include "bench.h"
+#include "kernel_bench.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define HELPER_STACK_SIZE			configMINIMAL_STACK_SIZE
+#define HELPER_MAX_TASKS			3U
+#define HELPER_LOW_PRIORITY			(tskIDLE_PRIORITY + 1)
+#define SYNC_MAX_TASKS				16U		/* Helpers run on the parked task stacks. */
+#define BARRIER_INDEX				1U		/* Free once the light semaphores are done. */
+#define FANOUT_INDEX				1U		/* Free once the barriers are done. */
+#define STREAM_BUFFER_SIZE			256U
+#define STREAM_CHUNK_SIZE			64U
+#define STREAM_TRICKLE_SIZE			4U
+#define STREAM_HOLD_TRIGGER			64U		/* 16 writes per wakeup of the reader. */
+#define STREAM_HOLD_TICKS			pdMS_TO_TICKS(2)
+#define MESSAGE_SIZE				16U
+#define FRAME_HEADER_SIZE			4U
+#define FRAME_PAYLOAD_SIZE			(STREAM_CHUNK_SIZE - FRAME_HEADER_SIZE)	/* One chunk per frame. */
+#define QUEUE_MAX_ITEM_SIZE			64U
+#define QUEUE_BATCH_ITEMS			16U
+#define TIMER_MAX_COUNT				1000U
+#define TIMER_ITERATIONS			1000U
+#define TIMER_BASE_PERIOD			pdMS_TO_TICKS(600000)	/* Never expires during a run. */
+#define LIGHT_SEMAPHORE_INDEX		1U
+#define LIGHT_CHANNEL_INDEX			1U		/* Free once the light semaphores are done. */
+#define LIGHT_CHANNEL_RING_LENGTH	3U		/* Holds 4 items, as the stream queue does. */
+#define STREAM_QUEUE_LENGTH			4U
+#define PARKED_MAX_TASKS			32U
+#define BLOCK_TIMEOUT_TICKS			(2U * TIMER_BASE_PERIOD)	/* Later than every parked task. */
+
+#if (configUSE_TIMER_WHEEL == 1)
+#define TIMER_BACKEND				"wheel"
+#else
+#define TIMER_BACKEND				"list"
+#endif
+
+#if (configUSE_PORT_OPTIMISED_TASK_SELECTION == 0)
+#define SELECT_BACKEND				"generic"
+#elif (configMAX_PRIORITIES > portREADY_BITMAP_BITS)
+#define SELECT_BACKEND				"clz2"		/* Two-level bitmap. */
+#else
+#define SELECT_BACKEND				"clz"
+#endif
+
+#if (configUSE_DELAYED_TASK_WHEEL == 1)
+#define DELAY_BACKEND				"wheel"
+#else
+#define DELAY_BACKEND				"list"
+#endif
+
+#if (configUSE_TASK_NAME_INDEX == 1)
+#define NAME_BACKEND				"index"
+#else
+#define NAME_BACKEND				"lists"
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulValue;		/* Item size, task count, timer count, ... */
+	const char *pcName;
+} BenchCase_t;
+
+/* Private function prototypes -----------------------------------------------*/
+static void prvMeasureCounterOverhead(void);
+static void prvMeasureYield(void);
+static void prvMeasureSemaphorePingPong(void);
+static void prvMeasureQueuePingPong(void);
+static void prvMeasureLightSemaphorePingPong(void);
+static void prvMeasureLightChannelPingPong(void);
+static void prvMeasureItemStream(void);
+static void prvMeasureNotifyPingPong(const char *pcName, UBaseType_t uxHelperPriority);
+static void prvMeasureMutex(void);
+static void prvMeasureMutexContended(void);
+static void prvMeasureAtomic(void);
+static void prvMeasureQueue(const BenchCase_t *pxCase);
+static void prvMeasureQueueBatch(void);
+static void prvMeasureStreamBuffer(void);
+static void prvMeasureStreamTrickle(void);
+static void prvMeasureMessageBuffer(void);
+static void prvMeasureMessageFraming(BaseType_t xVectors);
+static void prvMeasureEventGroupSync(const BenchCase_t *pxCase);
+static void prvMeasureBarrierSync(const BenchCase_t *pxCase);
+static void prvMeasureNotifyFanout(const BenchCase_t *pxCase, BaseType_t xGroup);
+static void prvMeasureHeap(const BenchCase_t *pxCase);
+static void prvMeasureTimerReset(const BenchCase_t *pxCase);
+static void prvMeasureBlockTimeout(const BenchCase_t *pxCase);
+static void prvMeasureTaskGetHandle(void);
+static TaskHandle_t prvStartHelper(uint32_t ulIndex, TaskFunction_t pxTask, void *pvParameter, UBaseType_t uxPriority);
+static void prvStopHelpers(void);
+static void prvStartSyncHelpers(uint32_t ulParties, TaskFunction_t pxTask);
+static void prvStopSyncHelpers(uint32_t ulParties);
+static void vYieldHelper(void *pvParameters);
+static void vSemaphoreHelper(void *pvParameters);
+static void vQueueHelper(void *pvParameters);
+static void vLightSemaphoreHelper(void *pvParameters);
+static void vLightChannelHelper(void *pvParameters);
+static void vQueueDrainHelper(void *pvParameters);
+static void vLightChannelDrainHelper(void *pvParameters);
+static void vNotifyHelper(void *pvParameters);
+static void vTimeoutNotifyHelper(void *pvParameters);
+static void vParkedTask(void *pvParameters);
+static void vMutexHelper(void *pvParameters);
+static void vStreamHelper(void *pvParameters);
+static void vTrickleHelper(void *pvParameters);
+static void vSyncHelper(void *pvParameters);
+static void vBarrierHelper(void *pvParameters);
+static void vFanoutHelper(void *pvParameters);
+static void prvTimerCallback(TimerHandle_t xTimer);
+
+/* Variables -----------------------------------------------------------------*/
+
+#if (configUSE_KERNEL_RAM_FUNCTIONS == 1)
+/* Kernel functions copied to SRAM (STM32F446RETX_FLASH.ld). */
+extern uint8_t _skernel_ramfunc[];
+extern uint8_t _ekernel_ramfunc[];
+#define KERNEL_RAM_BYTES			((unsigned long)(_ekernel_ramfunc - _skernel_ramfunc))
+#else
+#define KERNEL_RAM_BYTES			0UL
+#endif
+
+static const BenchCase_t xQueueCases[] =
+{
+	{ 1U, "queue_send_receive_1b" },
+	{ 4U, "queue_send_receive_4b" },
+	{ 8U, "queue_send_receive_8b" },
+	{ 16U, "queue_send_receive_16b" },
+	{ 64U, "queue_send_receive_64b" },
+};
+
+static const BenchCase_t xSyncCases[] =
+{
+	{ 2U, "event_group_sync_2" },
+	{ 4U, "event_group_sync_4" },
+	{ SYNC_MAX_TASKS, "event_group_sync_16" },
+};
+
+static const BenchCase_t xBarrierCases[] =
+{
+	{ 2U, "barrier_sync_2" },
+	{ 4U, "barrier_sync_4" },
+	{ SYNC_MAX_TASKS, "barrier_sync_16" },
+};
+
+/* Tasks notified, each case once per notification order. */
+static const BenchCase_t xFanoutCases[] =
+{
+	{ 4U, "notify_fanout_single_4" },
+	{ 4U, "notify_fanout_group_4" },
+	{ SYNC_MAX_TASKS - 1U, "notify_fanout_single_15" },
+	{ SYNC_MAX_TASKS - 1U, "notify_fanout_group_15" },
+};
+
+static const BenchCase_t xHeapCases[] =
+{
+	{ 16U, "malloc_free_16b" },
+	{ 64U, "malloc_free_64b" },
+	{ 256U, "malloc_free_256b" },
+};
+
+static const BenchCase_t xTimerCases[] =
+{
+	{ 10U, "timer_reset_" TIMER_BACKEND "_10" },
+	{ 100U, "timer_reset_" TIMER_BACKEND "_100" },
+	{ TIMER_MAX_COUNT, "timer_reset_" TIMER_BACKEND "_1000" },
+};
+
+static const BenchCase_t xBlockCases[] =
+{
+	{ 0U, "block_timeout_" DELAY_BACKEND "_0" },
+	{ 8U, "block_timeout_" DELAY_BACKEND "_8" },
+	{ PARKED_MAX_TASKS, "block_timeout_" DELAY_BACKEND "_32" },
+};
+
+static TaskHandle_t xBenchTask = NULL;
+static TaskHandle_t xHelperTasks[HELPER_MAX_TASKS];
+static StaticTask_t xHelperTcbs[HELPER_MAX_TASKS];
+static StackType_t xHelperStacks[HELPER_MAX_TASKS][HELPER_STACK_SIZE];
+static StaticTimer_t xTimerBuffers[TIMER_MAX_COUNT];
+static TimerHandle_t xTimers[TIMER_MAX_COUNT];
+static TaskHandle_t xParkedTasks[PARKED_MAX_TASKS];
+static StaticTask_t xParkedTcbs[PARKED_MAX_TASKS];
+static StackType_t xParkedStacks[PARKED_MAX_TASKS][HELPER_STACK_SIZE];
+static uint8_t ucTxBuffer[QUEUE_MAX_ITEM_SIZE];
+static uint8_t ucRxBuffer[QUEUE_MAX_ITEM_SIZE];
+static uint32_t ulBatchItems[QUEUE_BATCH_ITEMS];
+
+static SemaphoreHandle_t xPingSemaphore = NULL;
+static SemaphoreHandle_t xPongSemaphore = NULL;
+static QueueHandle_t xPingQueue = NULL;
+static QueueHandle_t xPongQueue = NULL;
+static StaticLightSemaphore_t xLightPingBuffer;
+static StaticLightSemaphore_t xLightPongBuffer;
+static LightSemaphoreHandle_t xLightPing = NULL;
+static LightSemaphoreHandle_t xLightPong = NULL;
+static StaticLightChannel_t xChannelPingBuffer;
+static StaticLightChannel_t xChannelPongBuffer;
+static LightChannelHandle_t xChannelPing = NULL;
+static LightChannelHandle_t xChannelPong = NULL;
+static uint32_t ulChannelRing[LIGHT_CHANNEL_RING_LENGTH];
+static QueueHandle_t xStreamQueue = NULL;
+static SemaphoreHandle_t xBenchMutex = NULL;
+static StreamBufferHandle_t xBenchStream = NULL;
+static volatile uint32_t ulTrickleBytes = 0;
+static EventGroupHandle_t xSyncGroup = NULL;
+static EventBits_t xSyncAllBits = 0;
+static StaticBarrier_t xBarrierBuffer;
+static TaskHandle_t xBarrierWaiters[SYNC_MAX_TASKS - 1U];
+static BarrierHandle_t xBenchBarrier = NULL;
+#if (configUSE_NOTIFY_GROUPS == 1)
+static StaticNotifyGroup_t xFanoutGroupBuffer;
+static TaskHandle_t xFanoutMembers[SYNC_MAX_TASKS - 1U];
+#endif
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Runs every kernel primitive benchmark once at the current clock.
+ * @param None
+ * @retval None
+ */
+void kernel_bench_run(void)
+{
+	uint32_t i;
+
+	xBenchTask = xTaskGetCurrentTaskHandle();
+
+	printf("# task_selection=%s timers=%s delayed_tasks=%s task_names=%s notify_groups=%d stream_vectors=%d queue_fast_path=%d queue_batch=%d queue_fast_copy=%d stream_zero_copy=%d stream_hold=%d stream_multi_producer=%d message_timestamps=%d heap_slabs=%d mutex_fast_path=%d atomic_exclusive=%d kernel_ram_bytes=%lu\r\n",
+			SELECT_BACKEND,
+			TIMER_BACKEND,
+			DELAY_BACKEND,
+			NAME_BACKEND,
+			configUSE_NOTIFY_GROUPS,
+			configUSE_STREAM_BUFFER_VECTORS,
+			configUSE_QUEUE_FAST_PATH,
+			configUSE_QUEUE_BATCH,
+			configUSE_QUEUE_FAST_COPY,
+			configUSE_STREAM_BUFFER_ZERO_COPY,
+			configUSE_STREAM_BUFFER_HOLD_TIME,
+			configUSE_STREAM_BUFFER_MULTI_PRODUCER,
+			configUSE_MESSAGE_BUFFER_TIMESTAMPS,
+			configUSE_HEAP_SLABS,
+			configUSE_MUTEX_FAST_PATH,
+			configUSE_ATOMIC_EXCLUSIVE_ACCESS,
+			KERNEL_RAM_BYTES);
+
+	prvMeasureCounterOverhead();
+	prvMeasureYield();
+	prvMeasureSemaphorePingPong();
+	prvMeasureQueuePingPong();
+	prvMeasureLightSemaphorePingPong();
+	prvMeasureLightChannelPingPong();
+	prvMeasureNotifyPingPong("task_notify_ping_pong", uxTaskPriorityGet(NULL));
+	prvMeasureNotifyPingPong("task_notify_priority_gap", HELPER_LOW_PRIORITY);
+	prvMeasureMutex();
+	prvMeasureMutexContended();
+	prvMeasureAtomic();
+
+	for (i = 0; i < (sizeof(xQueueCases) / sizeof(xQueueCases[0])); i++)
+	{
+		prvMeasureQueue(&xQueueCases[i]);
+	}
+
+	prvMeasureQueueBatch();
+	prvMeasureItemStream();
+	prvMeasureStreamBuffer();
+	prvMeasureStreamTrickle();
+	prvMeasureMessageBuffer();
+	prvMeasureMessageFraming(pdFALSE);
+#if (configUSE_STREAM_BUFFER_VECTORS == 1)
+	prvMeasureMessageFraming(pdTRUE);
+#endif
+
+	for (i = 0; i < (sizeof(xSyncCases) / sizeof(xSyncCases[0])); i++)
+	{
+		prvMeasureEventGroupSync(&xSyncCases[i]);
+	}
+
+	for (i = 0; i < (sizeof(xBarrierCases) / sizeof(xBarrierCases[0])); i++)
+	{
+		prvMeasureBarrierSync(&xBarrierCases[i]);
+	}
+
+	for (i = 0; i < (sizeof(xFanoutCases) / sizeof(xFanoutCases[0])); i += 2U)
+	{
+		prvMeasureNotifyFanout(&xFanoutCases[i], pdFALSE);
+#if (configUSE_NOTIFY_GROUPS == 1)
+		prvMeasureNotifyFanout(&xFanoutCases[i + 1U], pdTRUE);
+#endif
+	}
+
+	for (i = 0; i < (sizeof(xHeapCases) / sizeof(xHeapCases[0])); i++)
+	{
+		prvMeasureHeap(&xHeapCases[i]);
+	}
+
+	for (i = 0; i < (sizeof(xTimerCases) / sizeof(xTimerCases[0])); i++)
+	{
+		prvMeasureTimerReset(&xTimerCases[i]);
+	}
+
+	for (i = 0; i < (sizeof(xBlockCases) / sizeof(xBlockCases[0])); i++)
+	{
+		prvMeasureBlockTimeout(&xBlockCases[i]);
+	}
+
+	prvMeasureTaskGetHandle();
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Measures two back-to-back reads of CYCCNT, the floor of every other
+ * result.
+ * @param None
+ * @retval None
+ */
+static void prvMeasureCounterOverhead(void)
+{
+	uint32_t ulStart;
+	uint32_t i;
+
+	bench_begin("cycle_counter_read");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+}
+
+/**
+ * @brief Measures taskYIELD() to a task of the same priority, which yields
+ * straight back.
+ * @param None
+ * @retval None
+ * @note Recorded per switch: half the round trip.
+ */
+static void prvMeasureYield(void)
+{
+	uint32_t ulStart;
+	uint32_t i;
+
+	prvStartHelper(0, vYieldHelper, NULL, uxTaskPriorityGet(NULL));
+
+	bench_begin("task_yield");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		taskYIELD();
+		bench_record((bench_cycles() - ulStart) / 2U);
+	}
+
+	bench_end();
+
+	prvStopHelpers();
+}
+
+/**
+ * @brief Measures a round trip through two binary semaphores between two
+ * tasks of the same priority.
+ * @param None
+ * @retval None
+ */
+static void prvMeasureSemaphorePingPong(void)
+{
+	uint32_t ulStart;
+	uint32_t i;
+
+	xPingSemaphore = xSemaphoreCreateBinary();
+	xPongSemaphore = xSemaphoreCreateBinary();
+
+	if ((xPingSemaphore == NULL) || (xPongSemaphore == NULL))
+	{
+		Error_Handler();
+	}
+
+	prvStartHelper(0, vSemaphoreHelper, NULL, uxTaskPriorityGet(NULL));
+
+	bench_begin("semaphore_ping_pong");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)xSemaphoreGive(xPingSemaphore);
+		(void)xSemaphoreTake(xPongSemaphore, portMAX_DELAY);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	prvStopHelpers();
+	vSemaphoreDelete(xPingSemaphore);
+	vSemaphoreDelete(xPongSemaphore);
+}
+
+/**
+ * @brief Measures a round trip of a 4-byte item through two queues between
+ * two tasks of the same priority, as in 15_Sync_Using_Queues.
+ * @param None
+ * @retval None
+ */
+static void prvMeasureQueuePingPong(void)
+{
+	uint32_t ulStart;
+	uint32_t ulItem;
+	uint32_t i;
+
+	xPingQueue = xQueueCreate(1, sizeof(uint32_t));
+	xPongQueue = xQueueCreate(1, sizeof(uint32_t));
+
+	if ((xPingQueue == NULL) || (xPongQueue == NULL))
+	{
+		Error_Handler();
+	}
+
+	prvStartHelper(0, vQueueHelper, NULL, uxTaskPriorityGet(NULL));
+
+	bench_begin("queue_ping_pong");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)xQueueSendToBack(xPingQueue, &i, portMAX_DELAY);
+		(void)xQueueReceive(xPongQueue, &ulItem, portMAX_DELAY);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	prvStopHelpers();
+	vQueueDelete(xPingQueue);
+	vQueueDelete(xPongQueue);
+}
+
+/**
+ * @brief Measures the semaphore ping-pong with light semaphores, each owned by
+ * the task that takes it.
+ * @param None
+ * @retval None
+ */
+static void prvMeasureLightSemaphorePingPong(void)
+{
+	TaskHandle_t xHelper;
+	uint32_t ulStart;
+	uint32_t i;
+
+	/* The helper must not run before the semaphore it takes exists. */
+	vTaskSuspendAll();
+	xHelper = prvStartHelper(0, vLightSemaphoreHelper, NULL, uxTaskPriorityGet(NULL));
+	xLightPing = xLightSemaphoreCreateBinaryStatic(xHelper, LIGHT_SEMAPHORE_INDEX, &xLightPingBuffer);
+	xLightPong = xLightSemaphoreCreateBinaryStatic(xBenchTask, LIGHT_SEMAPHORE_INDEX, &xLightPongBuffer);
+	(void)xTaskResumeAll();
+
+	bench_begin("light_semaphore_ping_pong");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)xLightSemaphoreGive(xLightPing);
+		(void)xLightSemaphoreTake(xLightPong, portMAX_DELAY);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	prvStopHelpers();
+}
+
+/**
+ * @brief Measures the queue ping-pong with light channels, each owned by the
+ * task that receives from it.
+ * @param None
+ * @retval None
+ */
+static void prvMeasureLightChannelPingPong(void)
+{
+	TaskHandle_t xHelper;
+	uint32_t ulStart;
+	uint32_t ulItem;
+	uint32_t i;
+
+	/* The helper must not run before the channel it receives from exists. */
+	vTaskSuspendAll();
+	xHelper = prvStartHelper(0, vLightChannelHelper, NULL, uxTaskPriorityGet(NULL));
+	xChannelPing = xLightChannelCreateStatic(xHelper, LIGHT_CHANNEL_INDEX, 0, NULL, &xChannelPingBuffer);
+	xChannelPong = xLightChannelCreateStatic(xBenchTask, LIGHT_CHANNEL_INDEX, 0, NULL, &xChannelPongBuffer);
+	(void)xTaskResumeAll();
+
+	bench_begin("light_channel_ping_pong");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)xLightChannelSend(xChannelPing, i, portMAX_DELAY);
+		(void)xLightChannelReceive(xChannelPong, &ulItem, portMAX_DELAY);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	prvStopHelpers();
+}
+
+/**
+ * @brief Measures a round trip through direct-to-task notifications.
+ * @param pcName Benchmark name.
+ * @param uxHelperPriority Priority of the task notified back. At the lowest
+ * application priority, both switches select a task across all the empty
+ * priorities in between, which exposes the task selection method.
+ * @retval None
+ */
+static void prvMeasureNotifyPingPong(const char *pcName, UBaseType_t uxHelperPriority)
+{
+	TaskHandle_t xHelper;
+	uint32_t ulStart;
+	uint32_t i;
+
+	xHelper = prvStartHelper(0, vNotifyHelper, NULL, uxHelperPriority);
+
+	bench_begin(pcName);
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		xTaskNotifyGive(xHelper);
+		(void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	prvStopHelpers();
+}
+
+/**
+ * @brief Measures taking and giving a mutex nobody else wants.
+ * @param None
+ * @retval None
+ */
+static void prvMeasureMutex(void)
+{
+	uint32_t ulStart;
+	uint32_t i;
+
+	xBenchMutex = xSemaphoreCreateMutex();
+
+	if (xBenchMutex == NULL)
+	{
+		Error_Handler();
+	}
+
+	bench_begin("mutex_lock_unlock");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)xSemaphoreTake(xBenchMutex, portMAX_DELAY);
+		(void)xSemaphoreGive(xBenchMutex);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	vSemaphoreDelete(xBenchMutex);
+}
+
+/**
+ * @brief Measures an atomic increment and an atomic compare-and-swap.
+ * @param None
+ * @retval None
+ * @note Uncontended. With configUSE_ATOMIC_EXCLUSIVE_ACCESS they are exclusive
+ * access loops; otherwise they mask interrupts, for as long as these rows.
+ */
+static void prvMeasureAtomic(void)
+{
+	static uint32_t volatile ulAtomicValue = 0;
+	uint32_t ulStart;
+	uint32_t i;
+
+	bench_begin("atomic_increment");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)Atomic_Increment_u32(&ulAtomicValue);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	bench_begin("atomic_compare_and_swap");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)Atomic_CompareAndSwap_u32(&ulAtomicValue, i + 1U, i);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+}
+
+/**
+ * @brief Measures taking a mutex held by a low priority task.
+ * @param None
+ * @retval None
+ * @note The take blocks and lends the holder this task's priority; the
+ * holder gives the mutex back at once, which restores its priority and
+ * switches back here. Both switches and the inheritance are included.
+ */
+static void prvMeasureMutexContended(void)
+{
+	TaskHandle_t xHelper;
+	uint32_t ulStart;
+	uint32_t i;
+
+	xBenchMutex = xSemaphoreCreateMutex();
+
+	if (xBenchMutex == NULL)
+	{
+		Error_Handler();
+	}
+
+	xHelper = prvStartHelper(0, vMutexHelper, NULL, HELPER_LOW_PRIORITY);
+
+	bench_begin("mutex_contended_lock");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		/* Wait for the helper to hold the mutex. */
+		xTaskNotifyGive(xHelper);
+		(void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+		ulStart = bench_cycles();
+		(void)xSemaphoreTake(xBenchMutex, portMAX_DELAY);
+		bench_record(bench_cycles() - ulStart);
+
+		(void)xSemaphoreGive(xBenchMutex);
+	}
+
+	bench_end();
+
+	prvStopHelpers();
+	vSemaphoreDelete(xBenchMutex);
+}
+
+/**
+ * @brief Measures sending an item to an empty queue and receiving it back,
+ * without blocking.
+ * @param pxCase Item size and benchmark name.
+ * @retval None
+ */
+static void prvMeasureQueue(const BenchCase_t *pxCase)
+{
+	QueueHandle_t xQueue;
+	uint32_t ulStart;
+	uint32_t i;
+
+	xQueue = xQueueCreate(1, pxCase->ulValue);
+
+	if (xQueue == NULL)
+	{
+		Error_Handler();
+	}
+
+	bench_begin(pxCase->pcName);
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)xQueueSendToBack(xQueue, ucTxBuffer, 0);
+		(void)xQueueReceive(xQueue, ucRxBuffer, 0);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	vQueueDelete(xQueue);
+}
+
+/**
+ * @brief Measures moving QUEUE_BATCH_ITEMS 4-byte items through a queue one
+ * at a time and, with configUSE_QUEUE_BATCH, as one batch each way.
+ * @param None
+ * @retval None
+ * @note Items per second = QUEUE_BATCH_ITEMS * cpu_mhz * 1e6 / avg.
+ */
+static void prvMeasureQueueBatch(void)
+{
+	QueueHandle_t xQueue;
+	uint32_t ulStart;
+	uint32_t i;
+	uint32_t j;
+
+	xQueue = xQueueCreate(QUEUE_BATCH_ITEMS, sizeof(uint32_t));
+
+	if (xQueue == NULL)
+	{
+		Error_Handler();
+	}
+
+	bench_begin("queue_single_16x4b");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+
+		for (j = 0; j < QUEUE_BATCH_ITEMS; j++)
+		{
+			(void)xQueueSendToBack(xQueue, &ulBatchItems[j], 0);
+		}
+
+		for (j = 0; j < QUEUE_BATCH_ITEMS; j++)
+		{
+			(void)xQueueReceive(xQueue, &ulBatchItems[j], 0);
+		}
+
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+#if (configUSE_QUEUE_BATCH == 1)
+	bench_begin("queue_batch_16x4b");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)xQueueSendMultiple(xQueue, ulBatchItems, QUEUE_BATCH_ITEMS, 0);
+		(void)xQueueReceiveMultiple(xQueue, ulBatchItems, QUEUE_BATCH_ITEMS, 0);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+#endif
+
+	vQueueDelete(xQueue);
+}
+
+/**
+ * @brief Measures sending 4-byte items to a task of the same priority that
+ * drains them, through a queue of STREAM_QUEUE_LENGTH items and through a
+ * light channel of the same capacity.
+ * @param None
+ * @retval None
+ * @note The sender blocks whenever the channel is full, as in the stream
+ * buffer rows, so the average is the steady-state cost per item, the
+ * receiver's share included. The light channel row also covers its overflow
+ * ring and its blocking send.
+ */
+static void prvMeasureItemStream(void)
+{
+	TaskHandle_t xHelper;
+	uint32_t ulStart;
+	uint32_t i;
+
+	xStreamQueue = xQueueCreate(STREAM_QUEUE_LENGTH, sizeof(uint32_t));
+
+	if (xStreamQueue == NULL)
+	{
+		Error_Handler();
+	}
+
+	prvStartHelper(0, vQueueDrainHelper, NULL, uxTaskPriorityGet(NULL));
+
+	bench_begin("queue_4b_stream");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)xQueueSendToBack(xStreamQueue, &i, portMAX_DELAY);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	prvStopHelpers();
+	vQueueDelete(xStreamQueue);
+
+	vTaskSuspendAll();
+	xHelper = prvStartHelper(0, vLightChannelDrainHelper, NULL, uxTaskPriorityGet(NULL));
+	xChannelPing = xLightChannelCreateStatic(xHelper, LIGHT_CHANNEL_INDEX, LIGHT_CHANNEL_RING_LENGTH,
+			ulChannelRing, &xChannelPingBuffer);
+	(void)xTaskResumeAll();
+
+	bench_begin("light_channel_4b_stream");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)xLightChannelSend(xChannelPing, i, portMAX_DELAY);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	prvStopHelpers();
+}
+
+/**
+ * @brief Measures sending STREAM_CHUNK_SIZE-byte chunks to a task of the same
+ * priority that drains the stream buffer, copying and, with
+ * configUSE_STREAM_BUFFER_ZERO_COPY, in place.
+ * @param None
+ * @retval None
+ * @note The buffer holds four chunks, so the sender blocks whenever it is
+ * full and the receiver's work lands in the sender's samples. The average is
+ * the steady-state cost per chunk: bytes per second =
+ * STREAM_CHUNK_SIZE * cpu_mhz * 1e6 / avg. The zero-copy row leaves out
+ * only the two copies: a real producer would write the bytes at the reserved
+ * pointer where it now writes them to ucTxBuffer. The concurrent row, with
+ * configUSE_STREAM_BUFFER_MULTI_PRODUCER, sends through the lock-free
+ * reservation, which never blocks.
+ */
+static void prvMeasureStreamBuffer(void)
+{
+	uint32_t ulStart;
+	uint32_t i;
+#if (configUSE_STREAM_BUFFER_ZERO_COPY == 1)
+	void *pvChunk;
+	size_t xLeft;
+#endif
+#if (configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1)
+	size_t xSent;
+#endif
+
+	xBenchStream = xStreamBufferCreate(STREAM_BUFFER_SIZE, 1);
+
+	if (xBenchStream == NULL)
+	{
+		Error_Handler();
+	}
+
+	prvStartHelper(0, vStreamHelper, NULL, uxTaskPriorityGet(NULL));
+
+	bench_begin("stream_buffer_64b_chunk");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)xStreamBufferSend(xBenchStream, ucTxBuffer, STREAM_CHUNK_SIZE, portMAX_DELAY);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	prvStopHelpers();
+
+#if (configUSE_STREAM_BUFFER_ZERO_COPY == 1)
+	/* A fresh buffer: the deleted helper may still be recorded as its
+	 * waiting reader. */
+	vStreamBufferDelete(xBenchStream);
+	xBenchStream = xStreamBufferCreate(STREAM_BUFFER_SIZE, 1);
+
+	if (xBenchStream == NULL)
+	{
+		Error_Handler();
+	}
+
+	prvStartHelper(0, vStreamHelper, xBenchStream, uxTaskPriorityGet(NULL));
+
+	bench_begin("stream_buffer_64b_zero_copy");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+
+		/* A chunk that reaches the end of the storage area takes two
+		 * reservations. */
+		for (xLeft = STREAM_CHUNK_SIZE; xLeft > 0U; )
+		{
+			xLeft -= xStreamBufferCommit(xBenchStream,
+					xStreamBufferReserve(xBenchStream, &pvChunk, xLeft, portMAX_DELAY));
+		}
+
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	prvStopHelpers();
+#endif
+
+#if (configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1)
+	vStreamBufferDelete(xBenchStream);
+	xBenchStream = xStreamBufferCreate(STREAM_BUFFER_SIZE, 1);
+
+	if (xBenchStream == NULL)
+	{
+		Error_Handler();
+	}
+
+	prvStartHelper(0, vStreamHelper, NULL, uxTaskPriorityGet(NULL));
+
+	bench_begin("stream_buffer_64b_concurrent");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+
+		/* The send never blocks, so a full buffer yields to the reader in
+		 * its place. */
+		for (xSent = 0U; xSent < STREAM_CHUNK_SIZE; )
+		{
+			xSent += xStreamBufferSendConcurrent(xBenchStream, &ucTxBuffer[xSent],
+					STREAM_CHUNK_SIZE - xSent);
+
+			if (xSent < STREAM_CHUNK_SIZE)
+			{
+				taskYIELD();
+			}
+		}
+
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	prvStopHelpers();
+#endif
+
+	vStreamBufferDelete(xBenchStream);
+}
+
+/**
+ * @brief Measures STREAM_TRICKLE_SIZE-byte writes, each followed by a yield,
+ * to a task of the same priority, with a trigger level of 1 and, with
+ * configUSE_STREAM_BUFFER_HOLD_TIME, with a trigger level of
+ * STREAM_HOLD_TRIGGER and a hold time of STREAM_HOLD_TICKS.
+ * @param None
+ * @retval None
+ * @note The yield runs the reader whenever a write has woken it, so each
+ * sample holds the reader's share: a wakeup per write at a trigger level of
+ * 1, one per STREAM_HOLD_TRIGGER / STREAM_TRICKLE_SIZE writes with the hold.
+ * The hold row then goes quiet and checks that the bytes left below the
+ * trigger level, and a lone write after them, are received within the hold
+ * time.
+ */
+static void prvMeasureStreamTrickle(void)
+{
+	uint32_t ulStart;
+	uint32_t i;
+
+	xBenchStream = xStreamBufferCreate(STREAM_BUFFER_SIZE, 1);
+
+	if (xBenchStream == NULL)
+	{
+		Error_Handler();
+	}
+
+	prvStartHelper(0, vTrickleHelper, NULL, uxTaskPriorityGet(NULL));
+
+	bench_begin("stream_buffer_4b_trigger_1");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)xStreamBufferSend(xBenchStream, ucTxBuffer, STREAM_TRICKLE_SIZE, portMAX_DELAY);
+		taskYIELD();
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	prvStopHelpers();
+	vStreamBufferDelete(xBenchStream);
+
+#if (configUSE_STREAM_BUFFER_HOLD_TIME == 1)
+	xBenchStream = xStreamBufferCreate(STREAM_BUFFER_SIZE, STREAM_HOLD_TRIGGER);
+
+	if ((xBenchStream == NULL) || (xStreamBufferSetHoldTime(xBenchStream, STREAM_HOLD_TICKS) != pdPASS))
+	{
+		Error_Handler();
+	}
+
+	ulTrickleBytes = 0;
+	prvStartHelper(0, vTrickleHelper, NULL, uxTaskPriorityGet(NULL));
+
+	bench_begin("stream_buffer_4b_trigger_64_hold");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)xStreamBufferSend(xBenchStream, ucTxBuffer, STREAM_TRICKLE_SIZE, portMAX_DELAY);
+		taskYIELD();
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	/* Neither the tail of the run nor a write to the empty buffer reaches
+	 * the trigger level. */
+	vTaskDelay(STREAM_HOLD_TICKS + 2U);
+	(void)xStreamBufferSend(xBenchStream, ucTxBuffer, STREAM_TRICKLE_SIZE, portMAX_DELAY);
+	vTaskDelay(STREAM_HOLD_TICKS + 2U);
+
+	if (ulTrickleBytes != ((KERNEL_BENCH_ITERATIONS + 1U) * STREAM_TRICKLE_SIZE))
+	{
+		Error_Handler();
+	}
+
+	prvStopHelpers();
+	vStreamBufferDelete(xBenchStream);
+#endif
+}
+
+/**
+ * @brief Measures sending MESSAGE_SIZE-byte messages to a task of the same
+ * priority that drains the message buffer and, with
+ * configUSE_MESSAGE_BUFFER_TIMESTAMPS, prints how long they were queued.
+ * @param None
+ * @retval None
+ * @note As in prvMeasureStreamBuffer(), the sender blocks whenever the buffer
+ * is full, so the average holds the receive. With timestamps each message
+ * stores 8 more bytes and both sides read the clock; the delay comment lists
+ * the histogram buckets in order: 0 us, then below 2, 4, 8 ... us.
+ */
+static void prvMeasureMessageBuffer(void)
+{
+	uint32_t ulStart;
+	uint32_t i;
+#if (configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1)
+	MessageBufferDelayStats_t xStats;
+#endif
+
+	xBenchStream = (StreamBufferHandle_t)xMessageBufferCreate(STREAM_BUFFER_SIZE);
+
+	if (xBenchStream == NULL)
+	{
+		Error_Handler();
+	}
+
+	prvStartHelper(0, vStreamHelper, NULL, uxTaskPriorityGet(NULL));
+
+	bench_begin("message_buffer_16b");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)xMessageBufferSend(xBenchStream, ucTxBuffer, MESSAGE_SIZE, portMAX_DELAY);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	/* Let the reader drain the buffer. */
+	while (xMessageBufferIsEmpty(xBenchStream) == pdFALSE)
+	{
+		taskYIELD();
+	}
+
+	prvStopHelpers();
+
+#if (configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1)
+	vMessageBufferGetDelayStats(xBenchStream, &xStats);
+
+	if (xStats.ulMessages != KERNEL_BENCH_ITERATIONS)
+	{
+		Error_Handler();
+	}
+
+	printf("# message_buffer_delay_us messages=%lu max=%lu histogram=",
+			(unsigned long)xStats.ulMessages,
+			(unsigned long)xStats.ulMaxDelayUs);
+
+	for (i = 0; i < configMESSAGE_BUFFER_DELAY_BUCKETS; i++)
+	{
+		printf("%s%lu", (i == 0U) ? "" : "/", (unsigned long)xStats.ulDelayHistogram[i]);
+	}
+
+	printf("\r\n");
+#endif
+
+	vMessageBufferDelete(xBenchStream);
+}
+
+/**
+ * @brief Measures sending frames of a FRAME_HEADER_SIZE-byte header and a
+ * FRAME_PAYLOAD_SIZE-byte payload, each one message, to a task of the same
+ * priority that drains the message buffer.
+ * @param xVectors pdFALSE to copy the header and the payload into a staging
+ * buffer and send that, pdTRUE to send both fragments with
+ * xMessageBufferSendV(), which copies them straight into the buffer.
+ * @retval None
+ */
+static void prvMeasureMessageFraming(BaseType_t xVectors)
+{
+	uint32_t ulSequence = 0;
+	uint32_t ulStart;
+	uint32_t i;
+#if (configUSE_STREAM_BUFFER_VECTORS == 1)
+	StreamBufferTxVector_t xFrame[2];
+
+	xFrame[0].pvData = &ulSequence;
+	xFrame[0].xLengthBytes = FRAME_HEADER_SIZE;
+	xFrame[1].pvData = ucRxBuffer;
+	xFrame[1].xLengthBytes = FRAME_PAYLOAD_SIZE;
+#endif
+
+	xBenchStream = (StreamBufferHandle_t)xMessageBufferCreate(STREAM_BUFFER_SIZE);
+
+	if (xBenchStream == NULL)
+	{
+		Error_Handler();
+	}
+
+	prvStartHelper(0, vStreamHelper, NULL, uxTaskPriorityGet(NULL));
+
+	bench_begin((xVectors == pdFALSE) ? "message_buffer_frame_staged" : "message_buffer_frame_vector");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+
+		if (xVectors == pdFALSE)
+		{
+			memcpy(ucTxBuffer, &ulSequence, FRAME_HEADER_SIZE);
+			memcpy(&ucTxBuffer[FRAME_HEADER_SIZE], ucRxBuffer, FRAME_PAYLOAD_SIZE);
+			(void)xMessageBufferSend(xBenchStream, ucTxBuffer, FRAME_HEADER_SIZE + FRAME_PAYLOAD_SIZE, portMAX_DELAY);
+		}
+#if (configUSE_STREAM_BUFFER_VECTORS == 1)
+		else
+		{
+			(void)xMessageBufferSendV(xBenchStream, xFrame, 2, portMAX_DELAY);
+		}
+#endif
+
+		bench_record(bench_cycles() - ulStart);
+		ulSequence++;
+	}
+
+	bench_end();
+
+	/* Let the reader drain the buffer. */
+	while (xMessageBufferIsEmpty(xBenchStream) == pdFALSE)
+	{
+		taskYIELD();
+	}
+
+	prvStopHelpers();
+	vMessageBufferDelete(xBenchStream);
+}
+
+/**
+ * @brief Measures xEventGroupSync() rendezvous of this task and helpers of the
+ * same priority.
+ * @param pxCase Number of tasks, this one included, and benchmark name.
+ * @retval None
+ */
+static void prvMeasureEventGroupSync(const BenchCase_t *pxCase)
+{
+	uint32_t ulStart;
+	uint32_t i;
+
+	xSyncGroup = xEventGroupCreate();
+
+	if (xSyncGroup == NULL)
+	{
+		Error_Handler();
+	}
+
+	/* Bit 0 is this task, bit i the helper i - 1. */
+	xSyncAllBits = (EventBits_t)((1UL << pxCase->ulValue) - 1U);
+
+	prvStartSyncHelpers(pxCase->ulValue, vSyncHelper);
+
+	bench_begin(pxCase->pcName);
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)xEventGroupSync(xSyncGroup, (EventBits_t)1U, xSyncAllBits, portMAX_DELAY);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	prvStopSyncHelpers(pxCase->ulValue);
+	vEventGroupDelete(xSyncGroup);
+}
+
+/**
+ * @brief Measures xBarrierWait() rendezvous of this task and helpers of the
+ * same priority, to compare with prvMeasureEventGroupSync().
+ * @param pxCase Number of tasks, this one included, and benchmark name.
+ * @retval None
+ */
+static void prvMeasureBarrierSync(const BenchCase_t *pxCase)
+{
+	uint32_t ulStart;
+	uint32_t i;
+
+	xBenchBarrier = xBarrierCreateStatic((UBaseType_t)pxCase->ulValue, BARRIER_INDEX,
+			xBarrierWaiters, &xBarrierBuffer);
+
+	prvStartSyncHelpers(pxCase->ulValue, vBarrierHelper);
+
+	bench_begin(pxCase->pcName);
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)xBarrierWait(xBenchBarrier, portMAX_DELAY);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	prvStopSyncHelpers(pxCase->ulValue);
+}
+
+/**
+ * @brief Measures the wakeup of helpers of a higher priority than this task,
+ * from the first notification until all have run and blocked again.
+ * @param pxCase Number of helpers and benchmark name.
+ * @param xGroup pdFALSE to notify the helpers one by one, each preempting
+ * this task in turn, pdTRUE to notify them with xTaskNotifyGroup(), which
+ * readies them all before the one context switch.
+ * @retval None
+ */
+static void prvMeasureNotifyFanout(const BenchCase_t *pxCase, BaseType_t xGroup)
+{
+	UBaseType_t uxPriority;
+	uint32_t ulStart;
+	uint32_t i;
+	uint32_t j;
+#if (configUSE_NOTIFY_GROUPS == 1)
+	NotifyGroupHandle_t xFanoutGroup;
+
+	xFanoutGroup = xNotifyGroupCreateStatic(FANOUT_INDEX, xFanoutMembers,
+			(UBaseType_t)pxCase->ulValue, &xFanoutGroupBuffer);
+#endif
+
+	prvStartSyncHelpers(pxCase->ulValue + 1U, vFanoutHelper);
+
+#if (configUSE_NOTIFY_GROUPS == 1)
+	for (i = 0; i < pxCase->ulValue; i++)
+	{
+		(void)xNotifyGroupSubscribe(xFanoutGroup, xParkedTasks[i]);
+	}
+#endif
+
+	/* Below the helpers, which block on their first run. */
+	uxPriority = uxTaskPriorityGet(NULL);
+	vTaskPrioritySet(NULL, HELPER_LOW_PRIORITY);
+
+	bench_begin(pxCase->pcName);
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+
+		if (xGroup == pdFALSE)
+		{
+			for (j = 0; j < pxCase->ulValue; j++)
+			{
+				(void)xTaskNotifyGiveIndexed(xParkedTasks[j], FANOUT_INDEX);
+			}
+		}
+#if (configUSE_NOTIFY_GROUPS == 1)
+		else
+		{
+			(void)xTaskNotifyGroup(xFanoutGroup, 0, eIncrement);
+		}
+#endif
+
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	vTaskPrioritySet(NULL, uxPriority);
+	prvStopSyncHelpers(pxCase->ulValue + 1U);
+}
+
+/**
+ * @brief Measures pvPortMalloc() followed by vPortFree() of one block.
+ * @param pxCase Block size and benchmark name.
+ * @retval None
+ */
+static void prvMeasureHeap(const BenchCase_t *pxCase)
+{
+	void *pvBlock;
+	uint32_t ulStart;
+	uint32_t i;
+
+	bench_begin(pxCase->pcName);
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		pvBlock = pvPortMalloc(pxCase->ulValue);
+		vPortFree(pvBlock);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+}
+
+/**
+ * @brief Measures xTimerReset() of the latest-expiring of N active timers,
+ * up to the timer service task having processed it.
+ * @param pxCase Number of active timers and benchmark name.
+ * @retval None
+ * @note This task drops below the timer service task for the benchmark, so
+ * each command is processed as soon as it is sent. The sample includes the
+ * queue send, both switches, and the timer service re-inserting the timer:
+ * a walk of the active list, or one slot with configUSE_TIMER_WHEEL.
+ */
+static void prvMeasureTimerReset(const BenchCase_t *pxCase)
+{
+	const UBaseType_t uxPriority = uxTaskPriorityGet(NULL);
+	uint32_t ulStart;
+	uint32_t i;
+
+	vTaskPrioritySet(NULL, configTIMER_TASK_PRIORITY - 1);
+
+	for (i = 0; i < pxCase->ulValue; i++)
+	{
+		xTimers[i] = xTimerCreateStatic("BenchTimer", TIMER_BASE_PERIOD + i, pdFALSE, NULL,
+				prvTimerCallback, &xTimerBuffers[i]);
+		(void)xTimerStart(xTimers[i], portMAX_DELAY);
+	}
+
+	bench_begin(pxCase->pcName);
+
+	for (i = 0; i < TIMER_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		(void)xTimerReset(xTimers[pxCase->ulValue - 1U], portMAX_DELAY);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	for (i = 0; i < pxCase->ulValue; i++)
+	{
+		(void)xTimerDelete(xTimers[i], portMAX_DELAY);
+	}
+
+	vTaskPrioritySet(NULL, uxPriority);
+}
+
+/**
+ * @brief Measures the notification ping-pong with both tasks blocking with a
+ * timeout, while pxCase->ulValue other tasks are delayed.
+ * @param pxCase Number of delayed tasks.
+ * @retval None
+ * @note The delayed tasks wake before either timeout, so a sorted delayed list
+ * is walked past all of them on each of the two blocks of a round trip.
+ */
+static void prvMeasureBlockTimeout(const BenchCase_t *pxCase)
+{
+	TaskHandle_t xHelper;
+	uint32_t ulStart;
+	uint32_t i;
+
+	for (i = 0; i < pxCase->ulValue; i++)
+	{
+		xParkedTasks[i] = xTaskCreateStatic(
+				vParkedTask,
+				"vBenchParked",
+				HELPER_STACK_SIZE,
+				(void *)(uintptr_t)(TIMER_BASE_PERIOD + i),
+				HELPER_LOW_PRIORITY,
+				xParkedStacks[i],
+				&xParkedTcbs[i]);
+	}
+
+	/* Let the parked tasks run once and block. */
+	vTaskDelay(1);
+
+	xHelper = prvStartHelper(0, vTimeoutNotifyHelper, NULL, uxTaskPriorityGet(NULL));
+
+	bench_begin(pxCase->pcName);
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+		xTaskNotifyGive(xHelper);
+		(void)ulTaskNotifyTake(pdTRUE, BLOCK_TIMEOUT_TICKS);
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	prvStopHelpers();
+
+	for (i = 0; i < pxCase->ulValue; i++)
+	{
+		vTaskDelete(xParkedTasks[i]);
+	}
+}
+
+/**
+ * @brief Measures xTaskGetHandle() of a delayed task, while PARKED_MAX_TASKS
+ * other tasks are delayed.
+ * @param None
+ * @retval None
+ * @note The task looked up wakes after every other one, so the walk of the
+ * task lists reaches it last.
+ */
+static void prvMeasureTaskGetHandle(void)
+{
+	TaskHandle_t xTarget;
+	uint32_t ulStart;
+	uint32_t i;
+
+	for (i = 0; i < PARKED_MAX_TASKS; i++)
+	{
+		xParkedTasks[i] = xTaskCreateStatic(
+				vParkedTask,
+				"vBenchParked",
+				HELPER_STACK_SIZE,
+				(void *)(uintptr_t)(TIMER_BASE_PERIOD + i),
+				HELPER_LOW_PRIORITY,
+				xParkedStacks[i],
+				&xParkedTcbs[i]);
+	}
+
+	xTarget = prvStartHelper(0, vParkedTask, (void *)(uintptr_t)BLOCK_TIMEOUT_TICKS, HELPER_LOW_PRIORITY);
+
+	/* Let them all run once and block. */
+	vTaskDelay(1);
+
+	bench_begin("task_get_handle_" NAME_BACKEND "_32");
+
+	for (i = 0; i < KERNEL_BENCH_ITERATIONS; i++)
+	{
+		ulStart = bench_cycles();
+
+		if (xTaskGetHandle("vBenchHelper") != xTarget)
+		{
+			Error_Handler();
+		}
+
+		bench_record(bench_cycles() - ulStart);
+	}
+
+	bench_end();
+
+	prvStopHelpers();
+
+	for (i = 0; i < PARKED_MAX_TASKS; i++)
+	{
+		vTaskDelete(xParkedTasks[i]);
+	}
+}
+
+/**
+ * @brief Creates helper task ulIndex on its static stack.
+ * @param ulIndex Helper slot, below HELPER_MAX_TASKS.
+ * @param pxTask Task function.
+ * @param pvParameter Task parameter.
+ * @param uxPriority Task priority.
+ * @retval The helper's handle.
+ */
+static TaskHandle_t prvStartHelper(uint32_t ulIndex, TaskFunction_t pxTask, void *pvParameter, UBaseType_t uxPriority)
+{
+	xHelperTasks[ulIndex] = xTaskCreateStatic(
+			pxTask,
+			"vBenchHelper",
+			HELPER_STACK_SIZE,
+			pvParameter,
+			uxPriority,
+			xHelperStacks[ulIndex],
+			&xHelperTcbs[ulIndex]);
+
+	return xHelperTasks[ulIndex];
+}
+
+/**
+ * @brief Deletes every helper task.
+ * @param None
+ * @retval None
+ * @note Helpers are always Ready or Blocked here, never running, so they are
+ * removed at once and their static memory can be reused straight away.
+ */
+static void prvStopHelpers(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < HELPER_MAX_TASKS; i++)
+	{
+		if (xHelperTasks[i] != NULL)
+		{
+			vTaskDelete(xHelperTasks[i]);
+			xHelperTasks[i] = NULL;
+		}
+	}
+}
+
+/**
+ * @brief Creates the rendezvous helpers on the parked task stacks, at the
+ * priority of this task.
+ * @param ulParties Number of tasks, this one included, up to SYNC_MAX_TASKS.
+ * @param pxTask Task function, given helper i its event bit 1 << (i + 1).
+ * @retval None
+ */
+static void prvStartSyncHelpers(uint32_t ulParties, TaskFunction_t pxTask)
+{
+	uint32_t i;
+
+	for (i = 0; i < (ulParties - 1U); i++)
+	{
+		xParkedTasks[i] = xTaskCreateStatic(
+				pxTask,
+				"vBenchSync",
+				HELPER_STACK_SIZE,
+				(void *)(uintptr_t)(1UL << (i + 1U)),
+				uxTaskPriorityGet(NULL),
+				xParkedStacks[i],
+				&xParkedTcbs[i]);
+	}
+}
+
+/**
+ * @brief Deletes the helpers of prvStartSyncHelpers().
+ * @param ulParties Number of tasks given to prvStartSyncHelpers().
+ * @retval None
+ */
+static void prvStopSyncHelpers(uint32_t ulParties)
+{
+	uint32_t i;
+
+	for (i = 0; i < (ulParties - 1U); i++)
+	{
+		vTaskDelete(xParkedTasks[i]);
+	}
+}
+
+/**
+ * @brief Yields back to the benchmark task forever.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void vYieldHelper(void *pvParameters)
+{
+	for (;;)
+	{
+		taskYIELD();
+	}
+}
+
+/**
+ * @brief Answers every ping with a pong.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void vSemaphoreHelper(void *pvParameters)
+{
+	for (;;)
+	{
+		(void)xSemaphoreTake(xPingSemaphore, portMAX_DELAY);
+		(void)xSemaphoreGive(xPongSemaphore);
+	}
+}
+
+/**
+ * @brief Sends every item received on the ping queue back on the pong queue.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void vQueueHelper(void *pvParameters)
+{
+	uint32_t ulItem;
+
+	for (;;)
+	{
+		(void)xQueueReceive(xPingQueue, &ulItem, portMAX_DELAY);
+		(void)xQueueSendToBack(xPongQueue, &ulItem, portMAX_DELAY);
+	}
+}
+
+/**
+ * @brief Answers every light ping with a light pong.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void vLightSemaphoreHelper(void *pvParameters)
+{
+	for (;;)
+	{
+		(void)xLightSemaphoreTake(xLightPing, portMAX_DELAY);
+		(void)xLightSemaphoreGive(xLightPong);
+	}
+}
+
+/**
+ * @brief Sends every item received on the ping channel back on the pong
+ * channel.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void vLightChannelHelper(void *pvParameters)
+{
+	uint32_t ulItem;
+
+	for (;;)
+	{
+		(void)xLightChannelReceive(xChannelPing, &ulItem, portMAX_DELAY);
+		(void)xLightChannelSend(xChannelPong, ulItem, portMAX_DELAY);
+	}
+}
+
+/**
+ * @brief Drains the stream queue, checking that the items arrive in order.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void vQueueDrainHelper(void *pvParameters)
+{
+	uint32_t ulExpected = 0;
+	uint32_t ulItem;
+
+	for (;;)
+	{
+		(void)xQueueReceive(xStreamQueue, &ulItem, portMAX_DELAY);
+
+		if (ulItem != ulExpected++)
+		{
+			Error_Handler();
+		}
+	}
+}
+
+/**
+ * @brief Drains the light channel, checking that the items arrive in order.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void vLightChannelDrainHelper(void *pvParameters)
+{
+	uint32_t ulExpected = 0;
+	uint32_t ulItem;
+
+	for (;;)
+	{
+		(void)xLightChannelReceive(xChannelPing, &ulItem, portMAX_DELAY);
+
+		if (ulItem != ulExpected++)
+		{
+			Error_Handler();
+		}
+	}
+}
+
+/**
+ * @brief Answers every notification from the benchmark task with one.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void vNotifyHelper(void *pvParameters)
+{
+	for (;;)
+	{
+		(void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		xTaskNotifyGive(xBenchTask);
+	}
+}
+
+/**
+ * @brief Answers every notification with a notification, blocking with a
+ * timeout rather than indefinitely.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void vTimeoutNotifyHelper(void *pvParameters)
+{
+	for (;;)
+	{
+		(void)ulTaskNotifyTake(pdTRUE, BLOCK_TIMEOUT_TICKS);
+		xTaskNotifyGive(xBenchTask);
+	}
+}
+
+/**
+ * @brief Stays delayed for the whole benchmark.
+ * @param pvParameters Delay in ticks.
+ * @retval None
+ */
+static void vParkedTask(void *pvParameters)
+{
+	for (;;)
+	{
+		vTaskDelay((TickType_t)(uintptr_t)pvParameters);
+	}
+}
+
+/**
+ * @brief On each notification, takes the mutex, tells the benchmark task,
+ * and gives it back once the benchmark task blocks on it.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void vMutexHelper(void *pvParameters)
+{
+	for (;;)
+	{
+		(void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		(void)xSemaphoreTake(xBenchMutex, portMAX_DELAY);
+
+		/* Preempted here by the benchmark task, which then blocks on the
+		 * mutex and lends this task its priority. */
+		xTaskNotifyGive(xBenchTask);
+
+		(void)xSemaphoreGive(xBenchMutex);
+	}
+}
+
+/**
+ * @brief Drains the benchmark stream or message buffer.
+ * @param pvParameters NULL to copy the bytes out, non-NULL to consume them in
+ * place.
+ * @retval None
+ */
+static void vStreamHelper(void *pvParameters)
+{
+	static uint8_t ucChunk[STREAM_CHUNK_SIZE];
+#if (configUSE_STREAM_BUFFER_ZERO_COPY == 1)
+	const void *pvChunk;
+
+	if (pvParameters != NULL)
+	{
+		for (;;)
+		{
+			(void)xStreamBufferConsume(xBenchStream,
+					xStreamBufferPeek(xBenchStream, &pvChunk, portMAX_DELAY));
+		}
+	}
+#endif
+
+	for (;;)
+	{
+		(void)xStreamBufferReceive(xBenchStream, ucChunk, sizeof(ucChunk), portMAX_DELAY);
+	}
+}
+
+/**
+ * @brief Drains the benchmark stream buffer and counts the bytes.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void vTrickleHelper(void *pvParameters)
+{
+	static uint8_t ucChunk[STREAM_HOLD_TRIGGER];
+
+	for (;;)
+	{
+		ulTrickleBytes += xStreamBufferReceive(xBenchStream, ucChunk, sizeof(ucChunk), portMAX_DELAY);
+	}
+}
+
+/**
+ * @brief Joins every event group rendezvous.
+ * @param pvParameters This helper's event bit.
+ * @retval None
+ */
+static void vSyncHelper(void *pvParameters)
+{
+	const EventBits_t xBit = (EventBits_t)(uintptr_t)pvParameters;
+
+	for (;;)
+	{
+		(void)xEventGroupSync(xSyncGroup, xBit, xSyncAllBits, portMAX_DELAY);
+	}
+}
+
+/**
+ * @brief Joins every barrier rendezvous.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void vBarrierHelper(void *pvParameters)
+{
+	(void)pvParameters;
+
+	for (;;)
+	{
+		(void)xBarrierWait(xBenchBarrier, portMAX_DELAY);
+	}
+}
+
+/**
+ * @brief Takes every fan-out notification.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void vFanoutHelper(void *pvParameters)
+{
+	(void)pvParameters;
+
+	for (;;)
+	{
+		(void)ulTaskNotifyTakeIndexed(FANOUT_INDEX, pdTRUE, portMAX_DELAY);
+	}
+}
+
+/**
+ * @brief Timer callback of the timer benchmark; never called.
+ * @param xTimer Unused.
+ * @retval None
+ */
+static void prvTimerCallback(TimerHandle_t xTimer)
+{
+	(void)xTimer;
+}
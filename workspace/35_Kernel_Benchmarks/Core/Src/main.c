@@ -0,0 +1,1101 @@
+/*******************************************************************************
+ *
+ * @file	main.c
+ * @brief	Measures the cost of FreeRTOS primitives in core clock cycles.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Results are printed over USART2 as CSV (see bench.c), once with
+ * 			the 84 MHz clock profile and once with the 180 MHz one.
+ *
+ * 			ISR-to-task latency: TIM3 interrupts at BENCH_IRQ_RATE_HZ. The
+ * 			ISR reads DWT CYCCNT on entry and wakes vBenchmarkTask through
+ * 			one primitive (task notification, binary semaphore, light
+ * 			semaphore, queue, light channel or event group); the task reads
+ * 			CYCCNT again as soon as it runs.
+ * 			The difference is the hand-off latency, including the context
+ * 			switch, over BENCH_LATENCY_ITERATIONS interrupts per primitive.
+ *
+ * 			ISR-to-task capacity: isr_rate_bench.c raises the TIM14 rate
+ * 			step by step until a queue, counting semaphore, notification,
+ * 			stream buffer or SPSC ring loses events, merges interrupts or
+ * 			leaves no CPU, and prints the highest rate each one sustained.
+ *
+ * 			Zero-latency interrupts: TIM4 interrupts at ZLI_BENCH_RATE_HZ, and
+ * 			its ISR reads the timer counter on entry, the time since the
+ * 			update event, and passes it through a lock-free ring and the
+ * 			deferred interrupt of zli.c to vBenchmarkTask. This is measured at
+ * 			priority ZLI_BENCH_IRQ_PRIORITY, above
+ * 			configMAX_SYSCALL_INTERRUPT_PRIORITY, and at BENCH_IRQ_PRIORITY,
+ * 			each time with and without vKernelLoadTask running kernel critical
+ * 			sections. Only the kernel-aware rows should spread with the load.
+ *
+ * 			ADC throughput: ADC1, ADC2 and ADC3 sample PA1 interleaved
+ * 			(adc.c) for ADC_BENCH_BLOCKS blocks. One row gives the cycles
+ * 			between block hand-offs, the next the cycles the task spends on
+ * 			a block, and a comment the nominal rate and the overruns;
+ * 			Tools/bench_throughput.py turns them into samples per second
+ * 			and CPU load.
+ *
+ * 			Allocators: heap_bench.c replays allocation traces modelled on
+ * 			10_Delete_Task and 16_Send_Complex_Data_With_Queues through
+ * 			pvPortMalloc() and vPortFree(), and prints the cycles of each
+ * 			and the fragmentation over the trace for the allocator of this
+ * 			build; Tools/heap_bench_report.py compares builds.
+ *
+ * 			Boot time: the startup code starts CYCCNT at reset, so main()
+ * 			reads the cycles spent in SystemInit(), the .data copy, the
+ * 			.bss clear and the C library constructors, at the 16 MHz reset
+ * 			clock.
+ *
+ * 			Scheduling policy: sched_bench.c runs a mix of periodic control,
+ * 			bursty I/O and background compute under the policy the build
+ * 			was configured with (SCHED_BENCH_POLICY in 'FreeRTOSConfig.h'),
+ * 			for response times, deadline misses, throughput and context
+ * 			switches; Tools/sched_compare.py compares builds.
+ *
+ * 			Tick cost: with configUSE_TICK_STATS, every tick interrupt of
+ * 			the run is timed by the kernel, and a comment gives the share
+ * 			of the CPU it took, its longest run, how late it was taken and
+ * 			how many tasks it unblocked, with the histograms. With
+ * 			configUSE_DYNAMIC_TICK_RATE, the same comments follow for an
+ * 			idle TICK_STEP_WINDOW_MS at TICK_STEP_RATE_HZ, each interrupt
+ * 			stepping over several ticks, to compare with the full rate.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "main.h"
+#include "clock.h"
+#include "cmsis_os.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "light_semphr.h"
+#include "light_channel.h"
+#include "uart.h"
+#include "adc.h"
+#include "bench.h"
+#include "kernel_bench.h"
+#include "heap_bench.h"
+#include "sched_bench.h"
+#include "isr_rate_bench.h"
+#include "timestamp.h"
+#include "spsc_ring.h"
+#include "zli.h"
+#include "cyclic.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define STACK_SIZE					256	// 256 * 4 = 1024 bytes
+#define BENCH_TASK_PRIORITY			(configMAX_PRIORITIES - 1)
+#define BENCH_IRQ_RATE_HZ			10000U
+#define BENCH_IRQ_PRIORITY			6U
+#define BENCH_LATENCY_ITERATIONS	100000U
+#define BENCH_WARMUP_ITERATIONS		16U
+#define BENCH_EVENT_BIT				(1UL << 0)
+#define BENCH_LIGHT_SEMAPHORE_INDEX	1U
+#define BENCH_LIGHT_CHANNEL_INDEX	2U
+#define TIM_CR1_CEN_OFS				0U
+#define TIM_CR1_URS_OFS				2U
+#define TIM_DIER_UIE_OFS			0U
+#define TIM_SR_UIF_OFS				0U
+#define TIM_EGR_UG_OFS				0U
+#define ZLI_BENCH_IRQ_PRIORITY		2U		/* Never masked by the kernel. */
+#define ZLI_BENCH_RATE_HZ			10000U
+#define ZLI_BENCH_ITERATIONS		100000U
+#define ZLI_BENCH_CHANNEL			0U
+#define ZLI_BENCH_RING_SIZE			256U	/* 128 samples of 2 bytes. */
+#define ZLI_BENCH_TIMEOUT_MS		10U
+#define LOAD_TASK_PRIORITY			(tskIDLE_PRIORITY + 1)
+#define CYCLIC_BENCH_PERIOD_US		100U	/* 10 kHz minor frames. */
+#define CYCLIC_BENCH_ITERATIONS		100000U
+#define CYCLIC_BENCH_BUDGET_NS		5000U
+#define ADC_BENCH_CHANNEL			1U		/* PA1 */
+#define ADC_BENCH_BLOCK_WORDS		2048U	/* 4096 samples, about 1 ms. */
+#define ADC_BENCH_BLOCKS			1000U
+#define ADC_BENCH_TIMEOUT_MS		10U
+#define TICK_STEP_RATE_HZ			(configTICK_RATE_HZ / 10U)	/* 10 ticks per interrupt. */
+#define TICK_STEP_WINDOW_MS			1000U
+
+/* Data types ----------------------------------------------------------------*/
+typedef enum
+{
+	BENCH_HANDOFF_NOTIFY = 0,
+	BENCH_HANDOFF_SEMAPHORE,
+	BENCH_HANDOFF_LIGHT_SEMAPHORE,
+	BENCH_HANDOFF_QUEUE,
+	BENCH_HANDOFF_LIGHT_CHANNEL,
+	BENCH_HANDOFF_EVENT_GROUP,
+	BENCH_HANDOFF_COUNT
+} BenchHandoff_t;
+
+/* Private function prototypes -----------------------------------------------*/
+void SystemClock_Config(void);
+static void MX_GPIO_Init(void);
+int __io_putchar(int ch);
+void vBenchmarkTask(void *pvParameters);
+static void prvRunBenchmarks(void);
+static void prvMeasureIsrLatency(BenchHandoff_t eHandoff);
+static uint32_t prvWaitForHandoff(BenchHandoff_t eHandoff);
+static void prvIrqTimerStart(void);
+static void prvIrqTimerStop(void);
+static uint32_t prvApb1TimerClock(void);
+static void prvMeasureEntryJitter(const char *pcName, uint32_t ulIrqPriority, BaseType_t xKernelLoad);
+static void prvMeasureCyclic(const char *pcName, BaseType_t xKernelLoad);
+static void prvCyclicControl(void *pvArg);
+static void prvCyclicHousekeeping(void *pvArg);
+static void vKernelLoadTask(void *pvParameters);
+static void prvMeasureAdcThroughput(void);
+static uint32_t prvAdcBlockPeakToPeak(const uint16_t *pusSamples, uint32_t ulCount);
+#if (configUSE_TICK_STATS == 1)
+static void prvReportTickStats(const char *pcName);
+static void prvPrintHistogram(const char *pcName, const char *pcHistogram, const uint32_t *pulBuckets);
+#endif
+#if (configUSE_DYNAMIC_TICK_RATE == 1) && (configUSE_TICK_STATS == 1)
+static void prvMeasureSteppedTick(void);
+#endif
+
+/* Variables -----------------------------------------------------------------*/
+static const char * const pcHandoffNames[BENCH_HANDOFF_COUNT] =
+{
+	[BENCH_HANDOFF_NOTIFY] = "isr_to_task_notify",
+	[BENCH_HANDOFF_SEMAPHORE] = "isr_to_task_semaphore",
+	[BENCH_HANDOFF_LIGHT_SEMAPHORE] = "isr_to_task_light_semaphore",
+	[BENCH_HANDOFF_QUEUE] = "isr_to_task_queue",
+	[BENCH_HANDOFF_LIGHT_CHANNEL] = "isr_to_task_light_channel",
+	[BENCH_HANDOFF_EVENT_GROUP] = "isr_to_task_event_group",
+};
+
+static TaskHandle_t xBenchmarkTask = NULL;
+static SemaphoreHandle_t xHandoffSemaphore = NULL;
+static StaticLightSemaphore_t xHandoffLightSemaphoreBuffer;
+static LightSemaphoreHandle_t xHandoffLightSemaphore = NULL;
+static QueueHandle_t xHandoffQueue = NULL;
+static StaticLightChannel_t xHandoffLightChannelBuffer;
+static LightChannelHandle_t xHandoffLightChannel = NULL;
+static EventGroupHandle_t xHandoffEventGroup = NULL;
+static volatile BenchHandoff_t eActiveHandoff = BENCH_HANDOFF_COUNT;
+static volatile uint32_t ulIsrEntryCycles = 0;
+static uint32_t ulAdcBenchBuf[2][ADC_BENCH_BLOCK_WORDS];
+static volatile uint32_t ulAdcPeakToPeak = 0;
+static SpscRing_t xEntryRing;
+static volatile int32_t lCyclicState = 0;
+static volatile uint32_t ulCyclicMajorFrames = 0;
+
+/* A 10 kHz control slot in every minor frame, and a 2.5 kHz one after it in
+ * the first of every four. */
+static const CyclicSlot_t xCyclicFirstSlots[] =
+{
+	{ prvCyclicControl, NULL, CYCLIC_BENCH_BUDGET_NS },
+	{ prvCyclicHousekeeping, NULL, CYCLIC_BENCH_BUDGET_NS },
+};
+
+static const CyclicSlot_t xCyclicSlots[] =
+{
+	{ prvCyclicControl, NULL, CYCLIC_BENCH_BUDGET_NS },
+};
+
+static const CyclicFrame_t xCyclicFrames[] =
+{
+	CYCLIC_FRAME(xCyclicFirstSlots),
+	CYCLIC_FRAME(xCyclicSlots),
+	CYCLIC_FRAME(xCyclicSlots),
+	CYCLIC_FRAME(xCyclicSlots),
+};
+
+static const CyclicSchedule_t xCyclicSchedule =
+{
+	CYCLIC_BENCH_PERIOD_US,
+	xCyclicFrames,
+	sizeof(xCyclicFrames) / sizeof(xCyclicFrames[0]),
+};
+static uint8_t ucEntryRingBuf[ZLI_BENCH_RING_SIZE];
+static volatile uint32_t ulEntryOverruns = 0;
+
+/* Symbols defined in the linker script. */
+extern uint8_t _sdata[], _edata[], _sbss[], _ebss[], _snoinit[], _enoinit[];
+
+/**
+ * @brief The application entry point.
+ * @retval int
+ */
+int main(void)
+{
+	/* Started from 0 by Reset_Handler. */
+	const uint32_t ulBootCycles = DWT->CYCCNT;
+
+	HAL_Init();
+
+	/* Configure the system clock */
+	SystemClock_Config();
+
+	/* Initialize all configured peripherals */
+	MX_GPIO_Init();
+	USART2_UART_TX_Init();
+
+	printf("# FreeRTOS %s kernel benchmarks\r\n", tskKERNEL_VERSION_NUMBER);
+	printf("# boot_cycles=%lu data_bytes=%lu bss_bytes=%lu noinit_bytes=%lu\r\n",
+			ulBootCycles,
+			(unsigned long)(_edata - _sdata),
+			(unsigned long)(_ebss - _sbss),
+			(unsigned long)(_enoinit - _snoinit));
+
+	xHandoffSemaphore = xSemaphoreCreateBinary();
+	xHandoffQueue = xQueueCreate(1, sizeof(uint32_t));
+	xHandoffEventGroup = xEventGroupCreate();
+
+	if ((xHandoffSemaphore == NULL) || (xHandoffQueue == NULL) || (xHandoffEventGroup == NULL))
+	{
+		Error_Handler();
+	}
+
+	/* Create tasks. */
+	xTaskCreate(
+			vBenchmarkTask,
+			"vBenchmarkTask",
+			STACK_SIZE,
+			NULL,
+			BENCH_TASK_PRIORITY,
+			&xBenchmarkTask);
+
+	/* TIM4 hands its samples over through the ring and the deferred
+	 * interrupt. */
+	if ((spsc_ring_init(&xEntryRing, ucEntryRingBuf, sizeof(ucEntryRingBuf)) != 0)
+			|| (zli_register(ZLI_BENCH_CHANNEL, zli_wake_ring, &xEntryRing) != 0))
+	{
+		Error_Handler();
+	}
+
+	zli_init();
+
+	/* Only vBenchmarkTask takes it, so it can live in its notifications. */
+	xHandoffLightSemaphore = xLightSemaphoreCreateBinaryStatic(xBenchmarkTask,
+			BENCH_LIGHT_SEMAPHORE_INDEX, &xHandoffLightSemaphoreBuffer);
+
+	/* The same for the channel, which needs no ring: the ISR sends one
+	 * timestamp per wakeup. */
+	xHandoffLightChannel = xLightChannelCreateStatic(xBenchmarkTask,
+			BENCH_LIGHT_CHANNEL_INDEX, 0, NULL, &xHandoffLightChannelBuffer);
+
+	vTaskStartScheduler();
+
+	/* Infinite loop */
+	while (1)
+	{
+		/* Do nothing. */
+	}
+}
+
+/**
+ * @brief Runs every benchmark at 84 MHz, then at 180 MHz.
+ * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
+ * task function signature.
+ * @retval None
+ */
+void vBenchmarkTask(void *pvParameters)
+{
+	bench_init();
+
+	prvRunBenchmarks();
+
+	if (clock_set_profile(CLOCK_PROFILE_MAX_PERFORMANCE) == 0)
+	{
+		prvRunBenchmarks();
+	}
+	else
+	{
+		printf("# 180 MHz profile unavailable (no HSE)\r\n");
+	}
+
+	printf("# done\r\n");
+
+	vTaskSuspend(NULL);
+}
+
+/**
+ * @brief Runs every benchmark once at the current clock.
+ * @param None
+ * @retval None
+ */
+static void prvRunBenchmarks(void)
+{
+	BenchHandoff_t eHandoff;
+
+#if (configUSE_TICK_STATS == 1)
+	vTaskResetTickStats();
+#endif
+
+#if (configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1)
+	/* Message buffer timestamps: TIM5 at 1 MHz from the new bus clock. */
+	if (timestamp_init() != 0)
+	{
+		Error_Handler();
+	}
+#endif
+
+	kernel_bench_run();
+	heap_bench_run();
+
+	for (eHandoff = BENCH_HANDOFF_NOTIFY; eHandoff < BENCH_HANDOFF_COUNT; eHandoff++)
+	{
+		prvMeasureIsrLatency(eHandoff);
+	}
+
+	isr_rate_bench_run();
+
+	prvMeasureEntryJitter("isr_entry_zero_latency", ZLI_BENCH_IRQ_PRIORITY, pdFALSE);
+	prvMeasureEntryJitter("isr_entry_zero_latency_loaded", ZLI_BENCH_IRQ_PRIORITY, pdTRUE);
+	prvMeasureEntryJitter("isr_entry_kernel_aware", BENCH_IRQ_PRIORITY, pdFALSE);
+	prvMeasureEntryJitter("isr_entry_kernel_aware_loaded", BENCH_IRQ_PRIORITY, pdTRUE);
+	prvMeasureCyclic("cyclic_release_10khz", pdFALSE);
+	prvMeasureCyclic("cyclic_release_10khz_loaded", pdTRUE);
+
+	prvMeasureAdcThroughput();
+
+	sched_bench_run();
+
+#if (configUSE_TICK_STATS == 1)
+	prvReportTickStats("tick");
+#endif
+
+#if (configUSE_DYNAMIC_TICK_RATE == 1) && (configUSE_TICK_STATS == 1)
+	prvMeasureSteppedTick();
+#endif
+}
+
+/**
+ * @brief Measures the latency from TIM3 ISR entry to the woken task running.
+ * @param eHandoff Primitive the ISR uses to wake the task.
+ * @retval None
+ * @note The task has the highest priority, so it runs straight out of the
+ * ISR; the next interrupt only comes after it has blocked again.
+ */
+static void prvMeasureIsrLatency(BenchHandoff_t eHandoff)
+{
+	uint32_t ulCycles;
+	uint32_t i;
+
+	bench_begin(pcHandoffNames[eHandoff]);
+
+	eActiveHandoff = eHandoff;
+	prvIrqTimerStart();
+
+	for (i = 0; i < (BENCH_WARMUP_ITERATIONS + BENCH_LATENCY_ITERATIONS); i++)
+	{
+		ulCycles = prvWaitForHandoff(eHandoff);
+
+		if (i >= BENCH_WARMUP_ITERATIONS)
+		{
+			bench_record(ulCycles);
+		}
+	}
+
+	prvIrqTimerStop();
+	eActiveHandoff = BENCH_HANDOFF_COUNT;
+
+	bench_end();
+}
+
+/**
+ * @brief Measures the entry latency of the TIM4 interrupt at a priority.
+ * @param pcName Benchmark name.
+ * @param ulIrqPriority Priority of TIM4. Below
+ * configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, it is in the zero-latency
+ * tier.
+ * @param xKernelLoad pdTRUE to run vKernelLoadTask meanwhile.
+ * @retval None
+ * @note The latency is the TIM4 count read first thing in the ISR, converted
+ * to core clock cycles. Its spread is the jitter: the kernel critical sections
+ * add to it only when TIM4 is at a priority they mask.
+ */
+static void prvMeasureEntryJitter(const char *pcName, uint32_t ulIrqPriority, BaseType_t xKernelLoad)
+{
+	const uint32_t ulTimerClock = prvApb1TimerClock();
+	const uint32_t ulCyclesPerTick = SystemCoreClock / ulTimerClock;
+	TaskHandle_t xLoadTask = NULL;
+	QueueHandle_t xLoadQueue = NULL;
+	uint8_t ucSample[2];
+	uint32_t i = 0;
+
+	if (xKernelLoad != pdFALSE)
+	{
+		xLoadQueue = xQueueCreate(1, sizeof(uint32_t));
+
+		if ((xLoadQueue == NULL)
+				|| (xTaskCreate(vKernelLoadTask, "vKernelLoadTask", configMINIMAL_STACK_SIZE,
+						xLoadQueue, LOAD_TASK_PRIORITY, &xLoadTask) != pdPASS))
+		{
+			Error_Handler();
+		}
+	}
+
+	bench_begin(pcName);
+	ulEntryOverruns = 0;
+
+	/* Enable clock for TIM4. */
+	RCC->APB1ENR |= (1U << 2);
+
+	TIM4->CR1 = (1U << TIM_CR1_URS_OFS);
+	TIM4->PSC = 0;
+	TIM4->ARR = (ulTimerClock / ZLI_BENCH_RATE_HZ) - 1U;
+	TIM4->EGR = (1U << TIM_EGR_UG_OFS);
+	TIM4->SR = 0;
+	TIM4->DIER = (1U << TIM_DIER_UIE_OFS);
+
+	if (ZLI_IS_ZERO_LATENCY(ulIrqPriority))
+	{
+		(void)zli_irq_enable(TIM4_IRQn, ulIrqPriority);
+	}
+	else
+	{
+		NVIC_SetPriority(TIM4_IRQn, ulIrqPriority);
+		NVIC_EnableIRQ(TIM4_IRQn);
+	}
+
+	TIM4->CR1 |= (1U << TIM_CR1_CEN_OFS);
+
+	while (i < (BENCH_WARMUP_ITERATIONS + ZLI_BENCH_ITERATIONS))
+	{
+		if (spsc_ring_wait(&xEntryRing, pdMS_TO_TICKS(ZLI_BENCH_TIMEOUT_MS)) == 0U)
+		{
+			break;
+		}
+
+		/* The ISR puts both bytes of a sample before this task can run. */
+		while ((spsc_ring_count(&xEntryRing) >= 2U) && (i < (BENCH_WARMUP_ITERATIONS + ZLI_BENCH_ITERATIONS)))
+		{
+			(void)spsc_ring_read(&xEntryRing, ucSample, 2U);
+
+			if (i >= BENCH_WARMUP_ITERATIONS)
+			{
+				bench_record(((uint32_t)ucSample[0] | ((uint32_t)ucSample[1] << 8)) * ulCyclesPerTick);
+			}
+
+			i++;
+		}
+	}
+
+	TIM4->CR1 &= ~(1U << TIM_CR1_CEN_OFS);
+	TIM4->DIER = 0;
+	NVIC_DisableIRQ(TIM4_IRQn);
+	TIM4->SR = 0;
+	NVIC_ClearPendingIRQ(TIM4_IRQn);
+
+	bench_end();
+
+	printf("# %s irq_priority=%lu overruns=%lu\r\n", pcName, ulIrqPriority, ulEntryOverruns);
+
+	if (xLoadTask != NULL)
+	{
+		vTaskDelete(xLoadTask);
+		vQueueDelete(xLoadQueue);
+	}
+
+	/* Samples of the last interrupts. */
+	while (spsc_ring_get(&xEntryRing, ucSample) == 0)
+	{
+	}
+}
+
+/**
+ * @brief Measures when the cyclic executive starts its minor frames.
+ * @param pcName Benchmark name.
+ * @param xKernelLoad pdTRUE to run vKernelLoadTask meanwhile.
+ * @retval None
+ * @note The samples are the cycles from each update event of the frame timer
+ * to the start of the control slot, read by the slot and handed over through
+ * the ring and the deferred interrupt, as in prvMeasureEntryJitter(). The
+ * spread is the release jitter left after the executive waits for its
+ * release point; the comment line has its statistics, the worst entry
+ * latency among them.
+ */
+static void prvMeasureCyclic(const char *pcName, BaseType_t xKernelLoad)
+{
+	TaskHandle_t xLoadTask = NULL;
+	QueueHandle_t xLoadQueue = NULL;
+	CyclicStats_t xStats;
+	uint8_t ucSample[2];
+	uint32_t i = 0;
+
+	if (cyclic_init(&xCyclicSchedule) != 0)
+	{
+		printf("# %s unavailable\r\n", pcName);
+		return;
+	}
+
+	if (xKernelLoad != pdFALSE)
+	{
+		xLoadQueue = xQueueCreate(1, sizeof(uint32_t));
+
+		if ((xLoadQueue == NULL)
+				|| (xTaskCreate(vKernelLoadTask, "vKernelLoadTask", configMINIMAL_STACK_SIZE,
+						xLoadQueue, LOAD_TASK_PRIORITY, &xLoadTask) != pdPASS))
+		{
+			Error_Handler();
+		}
+	}
+
+	bench_begin(pcName);
+	ulEntryOverruns = 0;
+	cyclic_start();
+
+	while (i < (BENCH_WARMUP_ITERATIONS + CYCLIC_BENCH_ITERATIONS))
+	{
+		if (spsc_ring_wait(&xEntryRing, pdMS_TO_TICKS(ZLI_BENCH_TIMEOUT_MS)) == 0U)
+		{
+			break;
+		}
+
+		while ((spsc_ring_count(&xEntryRing) >= 2U) && (i < (BENCH_WARMUP_ITERATIONS + CYCLIC_BENCH_ITERATIONS)))
+		{
+			(void)spsc_ring_read(&xEntryRing, ucSample, 2U);
+
+			if (i >= BENCH_WARMUP_ITERATIONS)
+			{
+				bench_record((uint32_t)ucSample[0] | ((uint32_t)ucSample[1] << 8));
+			}
+
+			i++;
+		}
+	}
+
+	cyclic_stop();
+	bench_end();
+
+	cyclic_get_stats(&xStats);
+	printf("# %s frames=%lu major_frames=%lu frame_overruns=%lu slot_overruns=%lu late_releases=%lu entry_max=%lu control_max=%lu ring_overruns=%lu\r\n",
+			pcName,
+			xStats.ulFrames,
+			ulCyclicMajorFrames,
+			xStats.ulFrameOverruns,
+			xStats.ulSlotOverruns,
+			xStats.ulLateReleases,
+			xStats.ulEntryMaxCycles,
+			xStats.ulSlotMaxCycles[0],
+			ulEntryOverruns);
+
+	if (xLoadTask != NULL)
+	{
+		vTaskDelete(xLoadTask);
+		vQueueDelete(xLoadQueue);
+	}
+
+	/* Samples of the last frames. */
+	while (spsc_ring_get(&xEntryRing, ucSample) == 0)
+	{
+	}
+}
+
+/**
+ * @brief Control slot of the cyclic executive: times its release, then runs
+ * a fixed-point PI step.
+ * @param pvArg Unused.
+ * @retval None
+ */
+static void prvCyclicControl(void *pvArg)
+{
+	/* First thing, before the slot does anything that could vary. */
+	const uint32_t ulRelease = cyclic_release_cycles();
+	int32_t lError;
+
+	if ((ZLI_BENCH_RING_SIZE - spsc_ring_count(&xEntryRing)) >= 2U)
+	{
+		(void)spsc_ring_put(&xEntryRing, (uint8_t)ulRelease);
+		(void)spsc_ring_put(&xEntryRing, (uint8_t)(ulRelease >> 8));
+	}
+	else
+	{
+		ulEntryOverruns++;
+	}
+
+	zli_defer(ZLI_BENCH_CHANNEL);
+
+	/* Q16 PI toward 1.0: the control work of the slot. */
+	lError = 65536 - lCyclicState;
+	lCyclicState += (lError >> 3) + (lError >> 6);
+}
+
+/**
+ * @brief Housekeeping slot of the cyclic executive: counts major frames.
+ * @param pvArg Unused.
+ * @retval None
+ */
+static void prvCyclicHousekeeping(void *pvArg)
+{
+	ulCyclicMajorFrames++;
+}
+
+/**
+ * @brief Runs kernel critical sections back to back, below every other task.
+ * @param pvParameters Queue of one uint32_t to send to and receive from.
+ * @retval None
+ */
+static void vKernelLoadTask(void *pvParameters)
+{
+	QueueHandle_t xQueue = (QueueHandle_t)pvParameters;
+	uint32_t ulItem = 0;
+
+	while (1)
+	{
+		(void)xQueueSend(xQueue, &ulItem, 0);
+		(void)xQueueReceive(xQueue, &ulItem, 0);
+		vTaskSuspendAll();
+		(void)xTaskResumeAll();
+		ulItem++;
+	}
+}
+
+/**
+ * @brief Measures interleaved ADC capture: the interval between blocks, and
+ * the cost of processing one.
+ * @param None
+ * @retval None
+ * @note The rate is 4.2 MHz at 84 MHz and 4.5 MHz at 180 MHz (adc.c), so a
+ * block interval of block_samples * cpu_mhz / rate cycles means no sample was
+ * lost. The processing row is the share of that interval the task uses.
+ */
+static void prvMeasureAdcThroughput(void)
+{
+	uint32_t *pulBlock;
+	uint32_t ulLast;
+	uint32_t ulNow;
+	uint32_t i;
+
+	/* Notifications left over from the hand-off benchmarks. */
+	(void)xTaskNotifyStateClear(NULL);
+	(void)ulTaskNotifyTake(pdTRUE, 0);
+
+	if ((adc_interleaved_init(ADC_BENCH_CHANNEL, ulAdcBenchBuf[0], ulAdcBenchBuf[1],
+			ADC_BENCH_BLOCK_WORDS, xBenchmarkTask) != 0)
+			|| (adc_interleaved_start() != 0))
+	{
+		printf("# adc_interleaved unavailable\r\n");
+		return;
+	}
+
+	/* The first block includes the start-up. */
+	(void)adc_interleaved_wait(pdMS_TO_TICKS(ADC_BENCH_TIMEOUT_MS));
+	ulLast = bench_cycles();
+
+	bench_begin("adc_interleaved_block");
+
+	for (i = 0; i < ADC_BENCH_BLOCKS; i++)
+	{
+		if (adc_interleaved_wait(pdMS_TO_TICKS(ADC_BENCH_TIMEOUT_MS)) == NULL)
+		{
+			break;
+		}
+
+		ulNow = bench_cycles();
+		bench_record(ulNow - ulLast);
+		ulLast = ulNow;
+	}
+
+	bench_end();
+
+	bench_begin("adc_interleaved_process");
+
+	for (i = 0; i < ADC_BENCH_BLOCKS; i++)
+	{
+		pulBlock = adc_interleaved_wait(pdMS_TO_TICKS(ADC_BENCH_TIMEOUT_MS));
+
+		if (pulBlock == NULL)
+		{
+			break;
+		}
+
+		ulNow = bench_cycles();
+		ulAdcPeakToPeak = prvAdcBlockPeakToPeak((const uint16_t *)pulBlock,
+				2U * ADC_BENCH_BLOCK_WORDS);
+		bench_record(bench_cycles() - ulNow);
+	}
+
+	bench_end();
+
+	printf("# adc_interleaved rate_hz=%lu block_samples=%lu overruns=%lu\r\n",
+			adc_interleaved_get_rate(), 2UL * ADC_BENCH_BLOCK_WORDS,
+			adc_interleaved_get_overruns());
+
+	adc_interleaved_stop();
+}
+
+/**
+ * @brief Returns the peak-to-peak amplitude of a block, the vibration level.
+ * @param pusSamples 12-bit samples.
+ * @param ulCount Number of samples.
+ * @retval Largest minus smallest sample.
+ */
+static uint32_t prvAdcBlockPeakToPeak(const uint16_t *pusSamples, uint32_t ulCount)
+{
+	uint32_t ulMin = UINT16_MAX;
+	uint32_t ulMax = 0;
+	uint32_t i;
+
+	for (i = 0; i < ulCount; i++)
+	{
+		if (pusSamples[i] < ulMin)
+		{
+			ulMin = pusSamples[i];
+		}
+
+		if (pusSamples[i] > ulMax)
+		{
+			ulMax = pusSamples[i];
+		}
+	}
+
+	return ulMax - ulMin;
+}
+
+#if (configUSE_TICK_STATS == 1)
+/**
+ * @brief Prints the cost of the tick interrupts since the tick statistics were
+ * last reset.
+ * @param pcName Name of the comment line, and prefix of its histograms.
+ * @retval None
+ * @note cpu_permille is the time in the tick over the time between ticks,
+ * SysTick->LOAD + 1 cycles.
+ */
+static void prvReportTickStats(const char *pcName)
+{
+	TickStats_t xStats;
+	uint32_t ulPermille = 0;
+
+	vTaskGetTickStats(&xStats);
+
+	if (xStats.ulTicks != 0U)
+	{
+		ulPermille = (uint32_t)((xStats.ullTotalCycles * 1000U)
+				/ ((uint64_t)xStats.ulTicks * (SysTick->LOAD + 1U)));
+	}
+
+	printf("# %s cpu_mhz=%lu ticks=%lu mean=%lu max=%lu cpu_permille=%lu latency_max=%lu unblocked_max=%lu\r\n",
+			pcName, (unsigned long)BENCH_CYCLES_MHZ, (unsigned long)xStats.ulTicks,
+			(unsigned long)((xStats.ulTicks != 0U) ? (xStats.ullTotalCycles / xStats.ulTicks) : 0U),
+			(unsigned long)xStats.ulMaxCycles, (unsigned long)ulPermille,
+			(unsigned long)xStats.ulMaxLatencyCycles, (unsigned long)xStats.ulMaxUnblocked);
+
+	prvPrintHistogram(pcName, "cycles", xStats.ulCycleHistogram);
+	prvPrintHistogram(pcName, "latency_cycles", xStats.ulLatencyHistogram);
+	prvPrintHistogram(pcName, "unblocked", xStats.ulUnblockedHistogram);
+}
+
+/**
+ * @brief Prints one tick histogram as a comment, buckets separated by '/'.
+ * @param pcName Prefix, the name of the tick statistics.
+ * @param pcHistogram Name of the histogram.
+ * @param pulBuckets Its configTICK_STATS_BUCKETS buckets.
+ * @retval None
+ */
+static void prvPrintHistogram(const char *pcName, const char *pcHistogram, const uint32_t *pulBuckets)
+{
+	uint32_t i;
+
+	printf("# %s_%s histogram=", pcName, pcHistogram);
+
+	for (i = 0; i < configTICK_STATS_BUCKETS; i++)
+	{
+		printf("%s%lu", (i == 0U) ? "" : "/", (unsigned long)pulBuckets[i]);
+	}
+
+	printf("\r\n");
+}
+#endif /* configUSE_TICK_STATS */
+
+#if (configUSE_DYNAMIC_TICK_RATE == 1) && (configUSE_TICK_STATS == 1)
+/**
+ * @brief Prints the cost of the tick interrupts over an idle
+ * TICK_STEP_WINDOW_MS at TICK_STEP_RATE_HZ, then goes back to the full rate.
+ * @param None
+ * @retval None
+ * @note Each interrupt advances the tick count by configTICK_RATE_HZ /
+ * TICK_STEP_RATE_HZ ticks through xTaskIncrementTickBy(), so ticks= counts
+ * interrupts, and cpu_permille is comparable with the full rate line.
+ */
+static void prvMeasureSteppedTick(void)
+{
+	if (xPortSetTickRate(TICK_STEP_RATE_HZ) != pdPASS)
+	{
+		Error_Handler();
+	}
+
+	/* The next tick interrupt puts the rate into effect. */
+	vTaskDelay(1);
+	vTaskResetTickStats();
+
+	vTaskDelay(pdMS_TO_TICKS(TICK_STEP_WINDOW_MS));
+	prvReportTickStats("tick_stepped");
+
+	(void)xPortSetTickRate(configTICK_RATE_HZ);
+	vTaskDelay(1);
+}
+#endif /* configUSE_DYNAMIC_TICK_RATE && configUSE_TICK_STATS */
+
+/**
+ * @brief Blocks until the ISR hands off, then returns the cycles since its
+ * entry.
+ * @param eHandoff Primitive to wait on.
+ * @retval Cycles from ISR entry to the task running.
+ */
+static uint32_t prvWaitForHandoff(BenchHandoff_t eHandoff)
+{
+	uint32_t ulEntry = 0;
+
+	switch (eHandoff)
+	{
+	case BENCH_HANDOFF_NOTIFY:
+		(void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		ulEntry = ulIsrEntryCycles;
+		break;
+
+	case BENCH_HANDOFF_SEMAPHORE:
+		(void)xSemaphoreTake(xHandoffSemaphore, portMAX_DELAY);
+		ulEntry = ulIsrEntryCycles;
+		break;
+
+	case BENCH_HANDOFF_LIGHT_SEMAPHORE:
+		(void)xLightSemaphoreTake(xHandoffLightSemaphore, portMAX_DELAY);
+		ulEntry = ulIsrEntryCycles;
+		break;
+
+	case BENCH_HANDOFF_QUEUE:
+		/* The queue carries the timestamp itself. */
+		(void)xQueueReceive(xHandoffQueue, &ulEntry, portMAX_DELAY);
+		break;
+
+	case BENCH_HANDOFF_LIGHT_CHANNEL:
+		/* So does the channel. */
+		(void)xLightChannelReceive(xHandoffLightChannel, &ulEntry, portMAX_DELAY);
+		break;
+
+	case BENCH_HANDOFF_EVENT_GROUP:
+		(void)xEventGroupWaitBits(xHandoffEventGroup, BENCH_EVENT_BIT, pdTRUE, pdFALSE, portMAX_DELAY);
+		ulEntry = ulIsrEntryCycles;
+		break;
+
+	default:
+		break;
+	}
+
+	return bench_cycles() - ulEntry;
+}
+
+/**
+ * @brief TIM3 IRQ handler: timestamps its entry and wakes vBenchmarkTask.
+ * @param None
+ * @retval None
+ */
+void TIM3_IRQHandler(void)
+{
+	const uint32_t ulEntry = bench_cycles();
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	TIM3->SR = ~(1U << TIM_SR_UIF_OFS);
+	ulIsrEntryCycles = ulEntry;
+
+	switch (eActiveHandoff)
+	{
+	case BENCH_HANDOFF_NOTIFY:
+		vTaskNotifyGiveFromISR(xBenchmarkTask, &xHigherPriorityTaskWoken);
+		break;
+
+	case BENCH_HANDOFF_SEMAPHORE:
+		(void)xSemaphoreGiveFromISR(xHandoffSemaphore, &xHigherPriorityTaskWoken);
+		break;
+
+	case BENCH_HANDOFF_LIGHT_SEMAPHORE:
+		(void)xLightSemaphoreGiveFromISR(xHandoffLightSemaphore, &xHigherPriorityTaskWoken);
+		break;
+
+	case BENCH_HANDOFF_QUEUE:
+		(void)xQueueSendToBackFromISR(xHandoffQueue, &ulEntry, &xHigherPriorityTaskWoken);
+		break;
+
+	case BENCH_HANDOFF_LIGHT_CHANNEL:
+		(void)xLightChannelSendFromISR(xHandoffLightChannel, ulEntry, &xHigherPriorityTaskWoken);
+		break;
+
+	case BENCH_HANDOFF_EVENT_GROUP:
+		(void)xEventGroupSetBitsFromISR(xHandoffEventGroup, BENCH_EVENT_BIT, &xHigherPriorityTaskWoken);
+		break;
+
+	default:
+		break;
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief TIM4 IRQ handler, in the zero-latency tier or not: passes its entry
+ * latency to vBenchmarkTask without the FreeRTOS API.
+ * @param None
+ * @retval None
+ */
+void TIM4_IRQHandler(void)
+{
+	/* Timer ticks since the update event that raised the interrupt. */
+	const uint32_t ulTicks = TIM4->CNT;
+
+	TIM4->SR = ~(1U << TIM_SR_UIF_OFS);
+
+	if ((ZLI_BENCH_RING_SIZE - spsc_ring_count(&xEntryRing)) >= 2U)
+	{
+		(void)spsc_ring_put(&xEntryRing, (uint8_t)ulTicks);
+		(void)spsc_ring_put(&xEntryRing, (uint8_t)(ulTicks >> 8));
+	}
+	else
+	{
+		ulEntryOverruns++;
+	}
+
+	zli_defer(ZLI_BENCH_CHANNEL);
+}
+
+/**
+ * @brief Returns the clock of the APB1 timers.
+ * @param None
+ * @retval Timer clock in Hz.
+ */
+static uint32_t prvApb1TimerClock(void)
+{
+	uint32_t ulClock = HAL_RCC_GetPCLK1Freq();
+
+	/* The timer clock is PCLK1, doubled when APB1 is divided. */
+	if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+	{
+		ulClock *= 2U;
+	}
+
+	return ulClock;
+}
+
+/**
+ * @brief Starts TIM3 interrupting at BENCH_IRQ_RATE_HZ for the current clock.
+ * @param None
+ * @retval None
+ */
+static void prvIrqTimerStart(void)
+{
+	const uint32_t ulClock = prvApb1TimerClock();
+
+	/* Enable clock for TIM3. */
+	RCC->APB1ENR |= (1U << 1);
+
+	TIM3->CR1 = (1U << TIM_CR1_URS_OFS);
+	TIM3->PSC = 0;
+	TIM3->ARR = (ulClock / BENCH_IRQ_RATE_HZ) - 1U;
+	TIM3->EGR = (1U << TIM_EGR_UG_OFS);
+	TIM3->SR = 0;
+	TIM3->DIER = (1U << TIM_DIER_UIE_OFS);
+
+	NVIC_SetPriority(TIM3_IRQn, BENCH_IRQ_PRIORITY);
+	NVIC_EnableIRQ(TIM3_IRQn);
+
+	TIM3->CR1 |= (1U << TIM_CR1_CEN_OFS);
+}
+
+/**
+ * @brief Stops TIM3 and discards a hand-off still pending.
+ * @param None
+ * @retval None
+ */
+static void prvIrqTimerStop(void)
+{
+	TIM3->CR1 &= ~(1U << TIM_CR1_CEN_OFS);
+	TIM3->DIER = 0;
+	NVIC_DisableIRQ(TIM3_IRQn);
+	TIM3->SR = 0;
+	NVIC_ClearPendingIRQ(TIM3_IRQn);
+}
+
+/**
+ * @brief System Clock Configuration
+ * @retval None
+ */
+void SystemClock_Config(void)
+{
+	/* PLL, regulator scale, flash wait states and bus dividers come from the
+	 * profile table in clock.c. */
+	if (clock_set_profile(CLOCK_PROFILE_DEFAULT) != 0)
+	{
+		Error_Handler();
+	}
+}
+
+/**
+ * @brief GPIO Initialization Function
+ * @param None
+ * @retval None
+ */
+static void MX_GPIO_Init(void)
+{
+	GPIO_InitTypeDef GPIO_InitStruct =
+	{ 0 };
+	/* USER CODE BEGIN MX_GPIO_Init_1 */
+
+	/* USER CODE END MX_GPIO_Init_1 */
+
+	/* GPIO Ports Clock Enable */
+	__HAL_RCC_GPIOC_CLK_ENABLE();
+	__HAL_RCC_GPIOH_CLK_ENABLE();
+	__HAL_RCC_GPIOA_CLK_ENABLE();
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+
+	/*Configure GPIO pin Output Level */
+	HAL_GPIO_WritePin(LD2_GPIO_Port, LD2_Pin, GPIO_PIN_RESET);
+
+	/*Configure GPIO pin : B1_Pin */
+	GPIO_InitStruct.Pin = B1_Pin;
+	GPIO_InitStruct.Mode = GPIO_MODE_IT_FALLING;
+	GPIO_InitStruct.Pull = GPIO_NOPULL;
+	HAL_GPIO_Init(B1_GPIO_Port, &GPIO_InitStruct);
+
+	/*Configure GPIO pin : LD2_Pin */
+	GPIO_InitStruct.Pin = LD2_Pin;
+	GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+	GPIO_InitStruct.Pull = GPIO_NOPULL;
+	GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+	HAL_GPIO_Init(LD2_GPIO_Port, &GPIO_InitStruct);
+
+	/* USER CODE BEGIN MX_GPIO_Init_2 */
+
+	/* USER CODE END MX_GPIO_Init_2 */
+}
+
+/**
+ * @brief  Period elapsed callback in non blocking mode
+ * @note   This function is called  when TIM1 interrupt took place, inside
+ * HAL_TIM_IRQHandler(). It makes a direct call to HAL_IncTick() to increment
+ * a global variable "uwTick" used as application time base.
+ * @param  htim : TIM handle
+ * @retval None
+ */
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+	/* USER CODE BEGIN Callback 0 */
+
+	/* USER CODE END Callback 0 */
+	if (htim->Instance == TIM1)
+	{
+		HAL_IncTick();
+	}
+	/* USER CODE BEGIN Callback 1 */
+
+	/* USER CODE END Callback 1 */
+}
+
+/**
+ * @brief  This function is executed in case of error occurrence.
+ * @retval None
+ */
+void Error_Handler(void)
+{
+	/* USER CODE BEGIN Error_Handler_Debug */
+	/* User can add his own implementation to report the HAL error return state */
+	__disable_irq();
+	while (1)
+	{
+	}
+	/* USER CODE END Error_Handler_Debug */
+}
@@ -0,0 +1,422 @@
+/*******************************************************************************
+ *
+ * @file	sched_bench.c
+ * @brief	Scheduling policy benchmark: one mixed workload, measured under
+ * 			the scheduling policy of the build.
+ * @author	Kyungjae Lee
+ * @date	Oct 15, 2026
+ * @note	Must be called from the highest priority task. For
+ * 			SCHED_BENCH_DURATION_MS it runs, from the highest priority down:
+ *
+ * 				source		every SCHED_BENCH_IO_PERIOD_MS, queues a burst
+ * 							of SCHED_BENCH_IO_BURST events, as a device
+ * 							would.
+ * 				control		every SCHED_BENCH_CONTROL_PERIOD_MS, computes
+ * 							for SCHED_BENCH_CONTROL_WORK_US, due by its
+ * 							next release.
+ * 				io			handles the events one by one, for
+ * 							SCHED_BENCH_IO_WORK_US each.
+ * 				background	two tasks of the same priority, computing in
+ * 							chunks of SCHED_BENCH_CHUNK_US without end.
+ *
+ * 			The policy is the kernel's configuration, chosen by
+ * 			SCHED_BENCH_POLICY in 'FreeRTOSConfig.h': rebuild under each
+ * 			and compare the logs with Tools/sched_compare.py. The task code
+ * 			is the same in every build, except that the background tasks
+ * 			yield after each chunk when cooperative, as they would have to
+ * 			in a product.
+ *
+ * 			Response times run from the release, the tick a job was due
+ * 			at, read back from the tick count and SysTick, so a task that
+ * 			starts late is charged with it. They are printed as two CSV
+ * 			rows of bench.c's format, sched_control_response and
+ * 			sched_io_response, from perfhist.c histograms, since they run
+ * 			past bench.c's one-cycle bins. A comment line then gives the
+ * 			throughput (control jobs, I/O events, background chunks of each
+ * 			task), the control deadline misses, the dropped events and,
+ * 			with configUSE_SWITCH_STATS, the context switches.
+ *
+ * 			Computation is a loop calibrated at the start of each run, so
+ * 			the work is the same time at any clock.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "bench.h"
+#include "perfhist.h"
+#include "sched_bench.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define SCHED_STACK_SIZE			configMINIMAL_STACK_SIZE
+#define SCHED_BACKGROUND_PRIORITY	(tskIDLE_PRIORITY + 2)
+#define SCHED_IO_PRIORITY			(tskIDLE_PRIORITY + 3)
+#define SCHED_CONTROL_PRIORITY		(tskIDLE_PRIORITY + 4)
+#define SCHED_SOURCE_PRIORITY		(tskIDLE_PRIORITY + 5)
+#define SCHED_CAL_ITERATIONS		10000U
+#define SCHED_REGION_CONTROL		0U		/* perfhist.h regions. */
+#define SCHED_REGION_IO				1U
+
+#if (configUSE_PREEMPTION == 0)
+#define SCHED_POLICY_NAME			"cooperative"
+#elif (configUSE_TIME_SLICING == 1)
+#define SCHED_POLICY_NAME			"preemptive_time_sliced"
+#else
+#define SCHED_POLICY_NAME			"preemptive"
+#endif
+
+/* Data types ----------------------------------------------------------------*/
+typedef enum
+{
+	SCHED_TASK_SOURCE = 0,
+	SCHED_TASK_CONTROL,
+	SCHED_TASK_IO,
+	SCHED_TASK_BACKGROUND_0,
+	SCHED_TASK_BACKGROUND_1,
+	SCHED_TASK_COUNT
+} SchedTask_t;
+
+/* Variables -----------------------------------------------------------------*/
+static StaticTask_t xTcbs[SCHED_TASK_COUNT];
+static StackType_t xStacks[SCHED_TASK_COUNT][SCHED_STACK_SIZE];
+static TaskHandle_t xTasks[SCHED_TASK_COUNT];
+
+/* Release cycles of the pending events. */
+static StaticQueue_t xIoQueueBuffer;
+static uint8_t ucIoQueueStorage[SCHED_BENCH_IO_QUEUE_LENGTH * sizeof(uint32_t)];
+static QueueHandle_t xIoQueue = NULL;
+
+/* Loop iterations of each piece of work, and the control deadline. */
+static uint32_t ulControlIterations = 0;
+static uint32_t ulIoIterations = 0;
+static uint32_t ulChunkIterations = 0;
+static uint32_t ulControlDeadline = 0;
+
+static volatile uint32_t ulControlJobs = 0;
+static volatile uint32_t ulControlMisses = 0;
+static volatile uint32_t ulIoEvents = 0;
+static volatile uint32_t ulIoDropped = 0;
+static volatile uint32_t ulBackgroundChunks[2] = { 0 };
+
+/* Private function prototypes -----------------------------------------------*/
+static void prvStartTask(SchedTask_t eTask, TaskFunction_t pxTask, const char *pcName,
+		void *pvParameter, UBaseType_t uxPriority);
+static void prvCalibrate(void);
+static void prvWork(uint32_t ulIterations);
+static uint32_t prvCyclesSince(TickType_t xTick);
+static void prvPrintRow(const char *pcName, uint32_t ulRegion);
+static void vSourceTask(void *pvParameters);
+static void vControlTask(void *pvParameters);
+static void vIoTask(void *pvParameters);
+static void vBackgroundTask(void *pvParameters);
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Runs the workload once at the current clock and prints its results.
+ * @param None
+ * @retval None
+ */
+void sched_bench_run(void)
+{
+	uint32_t ulVoluntary = 0;
+	uint32_t ulInvoluntary = 0;
+	uint32_t ulSwitches = 0;
+	uint32_t i;
+
+	printf("# sched policy=%s duration_ms=%lu control_period_ms=%lu control_work_us=%lu io_period_ms=%lu io_burst=%lu io_work_us=%lu chunk_us=%lu\r\n",
+			SCHED_POLICY_NAME, (unsigned long)SCHED_BENCH_DURATION_MS,
+			(unsigned long)SCHED_BENCH_CONTROL_PERIOD_MS, (unsigned long)SCHED_BENCH_CONTROL_WORK_US,
+			(unsigned long)SCHED_BENCH_IO_PERIOD_MS, (unsigned long)SCHED_BENCH_IO_BURST,
+			(unsigned long)SCHED_BENCH_IO_WORK_US, (unsigned long)SCHED_BENCH_CHUNK_US);
+
+	if (xIoQueue == NULL)
+	{
+		xIoQueue = xQueueCreateStatic(SCHED_BENCH_IO_QUEUE_LENGTH, sizeof(uint32_t),
+				ucIoQueueStorage, &xIoQueueBuffer);
+	}
+	else
+	{
+		(void)xQueueReset(xIoQueue);
+	}
+
+	prvCalibrate();
+	ulControlDeadline = SCHED_BENCH_CONTROL_PERIOD_MS * 1000U * BENCH_CYCLES_MHZ;
+	ulControlJobs = 0;
+	ulControlMisses = 0;
+	ulIoEvents = 0;
+	ulIoDropped = 0;
+	ulBackgroundChunks[0] = 0;
+	ulBackgroundChunks[1] = 0;
+	perfhist_init();
+
+#if (configUSE_SWITCH_STATS == 1)
+	ulSwitches = ulTaskGetSwitchCount();
+#endif
+
+	prvStartTask(SCHED_TASK_BACKGROUND_0, vBackgroundTask, "vSchedBackground", (void *)0U, SCHED_BACKGROUND_PRIORITY);
+	prvStartTask(SCHED_TASK_BACKGROUND_1, vBackgroundTask, "vSchedBackground", (void *)1U, SCHED_BACKGROUND_PRIORITY);
+	prvStartTask(SCHED_TASK_IO, vIoTask, "vSchedIo", NULL, SCHED_IO_PRIORITY);
+	prvStartTask(SCHED_TASK_CONTROL, vControlTask, "vSchedControl", NULL, SCHED_CONTROL_PRIORITY);
+	prvStartTask(SCHED_TASK_SOURCE, vSourceTask, "vSchedSource", NULL, SCHED_SOURCE_PRIORITY);
+
+	vTaskDelay(pdMS_TO_TICKS(SCHED_BENCH_DURATION_MS));
+
+	/* The workload is Ready or Blocked, never running, while this task is:
+	 * its counters hold still and its tasks are deleted at once. */
+	for (i = 0; i < SCHED_TASK_COUNT; i++)
+	{
+#if (configUSE_SWITCH_STATS == 1)
+		TaskStatus_t xStatus;
+
+		vTaskGetInfo(xTasks[i], &xStatus, pdFALSE, eInvalid);
+		ulVoluntary += xStatus.ulVoluntarySwitches;
+		ulInvoluntary += xStatus.ulInvoluntarySwitches;
+#endif
+		vTaskDelete(xTasks[i]);
+		xTasks[i] = NULL;
+	}
+
+#if (configUSE_SWITCH_STATS == 1)
+	ulSwitches = ulTaskGetSwitchCount() - ulSwitches;
+#endif
+
+	prvPrintRow("sched_control_response", SCHED_REGION_CONTROL);
+	prvPrintRow("sched_io_response", SCHED_REGION_IO);
+
+	printf("# sched_summary policy=%s cpu_mhz=%lu control_jobs=%lu control_misses=%lu control_p50=%lu control_p90=%lu io_events=%lu io_dropped=%lu io_p50=%lu io_p90=%lu bg_chunks=%lu/%lu switches=%lu voluntary=%lu involuntary=%lu\r\n",
+			SCHED_POLICY_NAME, (unsigned long)BENCH_CYCLES_MHZ,
+			(unsigned long)ulControlJobs, (unsigned long)ulControlMisses,
+			(unsigned long)perfhist_percentile(SCHED_REGION_CONTROL, 500U),
+			(unsigned long)perfhist_percentile(SCHED_REGION_CONTROL, 900U),
+			(unsigned long)ulIoEvents, (unsigned long)ulIoDropped,
+			(unsigned long)perfhist_percentile(SCHED_REGION_IO, 500U),
+			(unsigned long)perfhist_percentile(SCHED_REGION_IO, 900U),
+			(unsigned long)ulBackgroundChunks[0], (unsigned long)ulBackgroundChunks[1],
+			(unsigned long)ulSwitches, (unsigned long)ulVoluntary, (unsigned long)ulInvoluntary);
+}
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief Creates workload task eTask on its static stack.
+ * @param eTask Task slot.
+ * @param pxTask Task function.
+ * @param pcName Task name.
+ * @param pvParameter Task parameter.
+ * @param uxPriority Task priority.
+ * @retval None
+ */
+static void prvStartTask(SchedTask_t eTask, TaskFunction_t pxTask, const char *pcName,
+		void *pvParameter, UBaseType_t uxPriority)
+{
+	xTasks[eTask] = xTaskCreateStatic(
+			pxTask,
+			pcName,
+			SCHED_STACK_SIZE,
+			pvParameter,
+			uxPriority,
+			xStacks[eTask],
+			&xTcbs[eTask]);
+}
+
+/**
+ * @brief Times the work loop and sizes each piece of work from it.
+ * @param None
+ * @retval None
+ * @note Called from the highest priority task, before the workload starts.
+ */
+static void prvCalibrate(void)
+{
+	const uint32_t ulStart = bench_cycles();
+	uint32_t ulCycles;
+
+	prvWork(SCHED_CAL_ITERATIONS);
+	ulCycles = bench_cycles() - ulStart;
+
+	ulControlIterations = (uint32_t)(((uint64_t)SCHED_BENCH_CONTROL_WORK_US * BENCH_CYCLES_MHZ
+			* SCHED_CAL_ITERATIONS) / ulCycles);
+	ulIoIterations = (uint32_t)(((uint64_t)SCHED_BENCH_IO_WORK_US * BENCH_CYCLES_MHZ
+			* SCHED_CAL_ITERATIONS) / ulCycles);
+	ulChunkIterations = (uint32_t)(((uint64_t)SCHED_BENCH_CHUNK_US * BENCH_CYCLES_MHZ
+			* SCHED_CAL_ITERATIONS) / ulCycles);
+}
+
+/**
+ * @brief Computes for a number of loop iterations.
+ * @param ulIterations Iterations.
+ * @retval None
+ */
+static void prvWork(uint32_t ulIterations)
+{
+	volatile uint32_t ulState = ulIterations;
+
+	while (ulIterations-- != 0U)
+	{
+		ulState = (ulState * 1664525UL) + 1013904223UL;
+	}
+}
+
+/**
+ * @brief Measures the time since a tick.
+ * @param xTick Tick count at that tick.
+ * @retval Core clock cycles.
+ * @note The tick count and SysTick are read in a critical section, which
+ * holds off the tick interrupt. If SysTick has reloaded but its interrupt is
+ * still pending, the tick count is one behind: SysTick is read again and the
+ * tick counted.
+ */
+static uint32_t prvCyclesSince(TickType_t xTick)
+{
+	uint32_t ulLoad;
+	uint32_t ulValue;
+	TickType_t xNow;
+
+	taskENTER_CRITICAL();
+	{
+		ulLoad = SysTick->LOAD;
+		ulValue = SysTick->VAL;
+		xNow = xTaskGetTickCount();
+
+		if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0U)
+		{
+			ulValue = SysTick->VAL;
+			xNow++;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return ((xNow - xTick) * (ulLoad + 1U)) + (ulLoad - ulValue);
+}
+
+/**
+ * @brief Prints a response time row in bench.c's CSV format.
+ * @param pcName Benchmark column.
+ * @param ulRegion perfhist.h region of the samples.
+ * @retval None
+ */
+static void prvPrintRow(const char *pcName, uint32_t ulRegion)
+{
+	PerfhistStats_t xStats;
+
+	(void)perfhist_get(ulRegion, &xStats);
+
+	if (xStats.ulCount == 0U)
+	{
+		printf("# %s: no samples\r\n", pcName);
+		return;
+	}
+
+	printf("%lu,%s,%lu,%lu,%lu,%lu,%lu\r\n",
+			(unsigned long)BENCH_CYCLES_MHZ, pcName,
+			(unsigned long)xStats.ulCount, (unsigned long)xStats.ulMin,
+			(unsigned long)xStats.ulMean, (unsigned long)xStats.ulP99,
+			(unsigned long)xStats.ulMax);
+}
+
+/**
+ * @brief Queues a burst of events every SCHED_BENCH_IO_PERIOD_MS.
+ * @param pvParameters Unused.
+ * @retval None
+ * @note Each event carries the cycle count of its release, the tick the
+ * burst was due at, however late this task ran.
+ */
+static void vSourceTask(void *pvParameters)
+{
+	TickType_t xRelease = xTaskGetTickCount();
+	uint32_t ulReleaseCycles;
+	uint32_t i;
+
+	(void)pvParameters;
+
+	while (1)
+	{
+		vTaskDelayUntil(&xRelease, pdMS_TO_TICKS(SCHED_BENCH_IO_PERIOD_MS));
+		ulReleaseCycles = bench_cycles() - prvCyclesSince(xRelease);
+
+		for (i = 0; i < SCHED_BENCH_IO_BURST; i++)
+		{
+			if (xQueueSend(xIoQueue, &ulReleaseCycles, 0) != pdPASS)
+			{
+				ulIoDropped++;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Runs a control job every SCHED_BENCH_CONTROL_PERIOD_MS.
+ * @param pvParameters Unused.
+ * @retval None
+ * @note A job that ends after the next release misses its deadline; the jobs
+ * it delayed still run, back to back.
+ */
+static void vControlTask(void *pvParameters)
+{
+	TickType_t xRelease = xTaskGetTickCount();
+	uint32_t ulCycles;
+
+	(void)pvParameters;
+
+	while (1)
+	{
+		vTaskDelayUntil(&xRelease, pdMS_TO_TICKS(SCHED_BENCH_CONTROL_PERIOD_MS));
+		prvWork(ulControlIterations);
+		ulCycles = prvCyclesSince(xRelease);
+
+		perfhist_record(SCHED_REGION_CONTROL, ulCycles);
+		ulControlJobs++;
+
+		if (ulCycles > ulControlDeadline)
+		{
+			ulControlMisses++;
+		}
+	}
+}
+
+/**
+ * @brief Handles the queued events, one at a time.
+ * @param pvParameters Unused.
+ * @retval None
+ */
+static void vIoTask(void *pvParameters)
+{
+	uint32_t ulReleaseCycles;
+
+	(void)pvParameters;
+
+	while (1)
+	{
+		if (xQueueReceive(xIoQueue, &ulReleaseCycles, portMAX_DELAY) == pdPASS)
+		{
+			prvWork(ulIoIterations);
+			perfhist_record(SCHED_REGION_IO, bench_cycles() - ulReleaseCycles);
+			ulIoEvents++;
+		}
+	}
+}
+
+/**
+ * @brief Computes in chunks, without end.
+ * @param pvParameters Index of the task, 0 or 1.
+ * @retval None
+ */
+static void vBackgroundTask(void *pvParameters)
+{
+	const uint32_t ulIndex = (uint32_t)pvParameters;
+
+	while (1)
+	{
+		prvWork(ulChunkIterations);
+		ulBackgroundChunks[ulIndex]++;
+
+#if (configUSE_PREEMPTION == 0)
+		/* Nothing else would ever run. */
+		taskYIELD();
+#endif
+	}
+}
@@ -0,0 +1,257 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    stm32f4xx_hal_timebase_tim.c
+  * @brief   HAL time base based on the hardware TIM.
+  * @note    With configUSE_HAL_TIMEBASE_RTOS_TICK set to 1 in FreeRTOSConfig.h,
+  *          TIM1 is left off and HAL_GetTick() follows the RTOS tick count, so
+  *          SysTick is the only periodic interrupt and tickless idle is not
+  *          woken every millisecond. Where the tick count stands still (before
+  *          the scheduler starts, with the scheduler suspended or interrupts
+  *          masked), HAL_GetTick() counts on the DWT cycle counter instead,
+  *          which Reset_Handler starts, so HAL timeouts still expire.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "stm32f4xx_hal_tim.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* RTOS ticks to HAL milliseconds; the identity at the usual 1 kHz tick. */
+#define TIMEBASE_TICKS_TO_MS(x)   ((configTICK_RATE_HZ == 1000U) ? (uint32_t)(x) : \
+                                   (uint32_t)(((uint64_t)(x) * 1000U) / configTICK_RATE_HZ))
+/* Private variables ---------------------------------------------------------*/
+TIM_HandleTypeDef        htim1;
+#if (configUSE_HAL_TIMEBASE_RTOS_TICK == 1)
+static uint32_t uwTickMs = 0U;            /* Last value of HAL_GetTick() */
+static uint32_t uwTickCycles = 0U;        /* CYCCNT at that call */
+static uint32_t uwTickRemainder = 0U;     /* Cycles short of the next ms */
+static uint32_t uwTickOffset = 0U;        /* HAL ms at RTOS tick count 0 */
+static uint8_t  ucTickOffsetSet = 0U;
+#endif
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+#if (configUSE_HAL_TIMEBASE_RTOS_TICK == 1)
+
+/**
+  * @brief  Keeps the tick priority only: no timer is started, HAL_GetTick()
+  *         follows the RTOS tick.
+  * @note   Called by HAL_Init() and HAL_RCC_ClockConfig(), as the TIM1 version.
+  * @param  TickPriority: Tick interrupt priority, returned by HAL_GetTickPrio().
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
+{
+  if (TickPriority >= (1UL << __NVIC_PRIO_BITS))
+  {
+    return HAL_ERROR;
+  }
+
+  uwTickPrio = TickPriority;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Provides a tick value in milliseconds.
+  * @note   The later of two counts since the last call: the milliseconds
+  *         counted on CYCCNT at the current SystemCoreClock, and, once the
+  *         scheduler has started, the RTOS tick count. The tick count is a
+  *         32-bit load, atomic from any context, and vTaskStepTick() moves it
+  *         across tickless idle, when CYCCNT stops with the core clock.
+  *         CYCCNT keeps HAL_GetTick() moving when the tick count does not.
+  *         It is only read here, so calls must not be more than 2^32 cycles
+  *         apart (23 s at 180 MHz) while the tick count stands still; the HAL
+  *         polling loops call it continuously.
+  * @retval tick value
+  */
+uint32_t HAL_GetTick(void)
+{
+  uint32_t uwPrimask;
+  uint32_t uwCycles;
+  uint32_t uwCyclesPerMs;
+  uint32_t uwRtosMs;
+
+  uwPrimask = __get_PRIMASK();
+  __disable_irq();
+
+  uwCycles = DWT->CYCCNT;
+  uwCyclesPerMs = SystemCoreClock / 1000U;
+  uwTickRemainder += uwCycles - uwTickCycles;
+  uwTickCycles = uwCycles;
+  uwTickMs += uwTickRemainder / uwCyclesPerMs;
+  uwTickRemainder %= uwCyclesPerMs;
+
+  if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+  {
+    uwRtosMs = TIMEBASE_TICKS_TO_MS(xTaskGetTickCount());
+
+    /* Continue from the CYCCNT count at the first call under the scheduler. */
+    if (ucTickOffsetSet == 0U)
+    {
+      uwTickOffset = uwTickMs - uwRtosMs;
+      ucTickOffsetSet = 1U;
+    }
+
+    uwRtosMs += uwTickOffset;
+
+    if ((int32_t)(uwRtosMs - uwTickMs) > 0)
+    {
+      uwTickMs = uwRtosMs;
+      uwTickRemainder = 0U;
+    }
+  }
+
+  __set_PRIMASK(uwPrimask);
+
+  return uwTickMs;
+}
+
+/**
+  * @brief  Suspend Tick increment.
+  * @note   Nothing to do: the RTOS tick is suspended by tickless idle.
+  * @param  None
+  * @retval None
+  */
+void HAL_SuspendTick(void)
+{
+}
+
+/**
+  * @brief  Resume Tick increment.
+  * @note   Nothing to do: the RTOS tick is resumed by tickless idle.
+  * @param  None
+  * @retval None
+  */
+void HAL_ResumeTick(void)
+{
+}
+
+#else /* configUSE_HAL_TIMEBASE_RTOS_TICK */
+
+/**
+  * @brief  This function configures the TIM1 as a time base source.
+  *         The time source is configured  to have 1ms time base with a dedicated
+  *         Tick interrupt priority.
+  * @note   This function is called  automatically at the beginning of program after
+  *         reset by HAL_Init() or at any time when clock is configured, by HAL_RCC_ClockConfig().
+  * @param  TickPriority: Tick interrupt priority.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
+{
+  RCC_ClkInitTypeDef    clkconfig;
+  uint32_t              uwTimclock = 0U;
+  uint32_t              uwAPB2Prescaler = 0U;
+
+  uint32_t              uwPrescalerValue = 0U;
+  uint32_t              pFLatency;
+
+  HAL_StatusTypeDef     status;
+
+  /* Enable TIM1 clock */
+  __HAL_RCC_TIM1_CLK_ENABLE();
+
+  /* Get clock configuration */
+  HAL_RCC_GetClockConfig(&clkconfig, &pFLatency);
+
+  /* Get APB2 prescaler */
+  uwAPB2Prescaler = clkconfig.APB2CLKDivider;
+
+  /* Compute TIM1 clock: twice PCLK2 when APB2 is divided (clock profiles) */
+  if (uwAPB2Prescaler == RCC_HCLK_DIV1)
+  {
+    uwTimclock = HAL_RCC_GetPCLK2Freq();
+  }
+  else
+  {
+    uwTimclock = 2UL * HAL_RCC_GetPCLK2Freq();
+  }
+
+  /* Compute the prescaler value to have TIM1 counter clock equal to 1MHz */
+  uwPrescalerValue = (uint32_t) ((uwTimclock / 1000000U) - 1U);
+
+  /* Initialize TIM1 */
+  htim1.Instance = TIM1;
+
+  /* Initialize TIMx peripheral as follow:
+   * Period = [(TIM1CLK/1000) - 1]. to have a (1/1000) s time base.
+   * Prescaler = (uwTimclock/1000000 - 1) to have a 1MHz counter clock.
+   * ClockDivision = 0
+   * Counter direction = Up
+   */
+  htim1.Init.Period = (1000000U / 1000U) - 1U;
+  htim1.Init.Prescaler = uwPrescalerValue;
+  htim1.Init.ClockDivision = 0;
+  htim1.Init.CounterMode = TIM_COUNTERMODE_UP;
+  htim1.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+
+  status = HAL_TIM_Base_Init(&htim1);
+  if (status == HAL_OK)
+  {
+    /* Start the TIM time Base generation in interrupt mode */
+    status = HAL_TIM_Base_Start_IT(&htim1);
+    if (status == HAL_OK)
+    {
+    /* Enable the TIM1 global Interrupt */
+        HAL_NVIC_EnableIRQ(TIM1_UP_TIM10_IRQn);
+      /* Configure the SysTick IRQ priority */
+      if (TickPriority < (1UL << __NVIC_PRIO_BITS))
+      {
+        /* Configure the TIM IRQ priority */
+        HAL_NVIC_SetPriority(TIM1_UP_TIM10_IRQn, TickPriority, 0U);
+        uwTickPrio = TickPriority;
+      }
+      else
+      {
+        status = HAL_ERROR;
+      }
+    }
+  }
+
+ /* Return function status */
+  return status;
+}
+
+/**
+  * @brief  Suspend Tick increment.
+  * @note   Disable the tick increment by disabling TIM1 update interrupt.
+  * @param  None
+  * @retval None
+  */
+void HAL_SuspendTick(void)
+{
+  /* Disable TIM1 update Interrupt */
+  __HAL_TIM_DISABLE_IT(&htim1, TIM_IT_UPDATE);
+}
+
+/**
+  * @brief  Resume Tick increment.
+  * @note   Enable the tick increment by Enabling TIM1 update interrupt.
+  * @param  None
+  * @retval None
+  */
+void HAL_ResumeTick(void)
+{
+  /* Enable TIM1 Update interrupt */
+  __HAL_TIM_ENABLE_IT(&htim1, TIM_IT_UPDATE);
+}
+
+#endif /* configUSE_HAL_TIMEBASE_RTOS_TICK */
@@ -0,0 +1,221 @@
+/**
+ ******************************************************************************
+ * @file      syscalls.c
+ * @author    Auto-generated by STM32CubeIDE
+ * @brief     STM32CubeIDE Minimal System calls file
+ *
+ *            For more information about which c-functions
+ *            need which of these lowlevel functions
+ *            please consult the Newlib libc-manual
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2020-2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Includes */
+#include <sys/stat.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <stdio.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/times.h>
+
+
+/* Variables */
+extern int __io_putchar(int ch) __attribute__((weak));
+extern int __io_getchar(void) __attribute__((weak));
+extern int __io_putbuf(char *ptr, int len) __attribute__((weak));
+extern int __io_putbuf_itm(char *ptr, int len) __attribute__((weak));
+extern int __io_putbuf_rtt(char *ptr, int len) __attribute__((weak));
+extern int __io_getbuf_rtt(char *ptr, int len) __attribute__((weak));
+
+/* Console sink of each output stream: USART2 (uart.c), the ITM text
+ * stimulus port (itm.c, SWO) or the RTT terminal ring (rtt.c, read by the
+ * probe). With SINK_ITM or SINK_RTT, the stream falls back to USART2 if the
+ * driver is not linked in. STDIN_SOURCE is SINK_UART or SINK_RTT. */
+#define SINK_UART 0
+#define SINK_ITM  1
+#define SINK_RTT  2
+
+#ifndef STDOUT_SINK
+#define STDOUT_SINK SINK_UART
+#endif
+
+#ifndef STDERR_SINK
+#define STDERR_SINK SINK_UART
+#endif
+
+#ifndef STDIN_SOURCE
+#define STDIN_SOURCE SINK_UART
+#endif
+
+
+char *__env[1] = { 0 };
+char **environ = __env;
+
+
+/* Functions */
+void initialise_monitor_handles()
+{
+}
+
+int _getpid(void)
+{
+  return 1;
+}
+
+int _kill(int pid, int sig)
+{
+  (void)pid;
+  (void)sig;
+  errno = EINVAL;
+  return -1;
+}
+
+void _exit (int status)
+{
+  _kill(status, -1);
+  while (1) {}    /* Make sure we hang here */
+}
+
+__attribute__((weak)) int _read(int file, char *ptr, int len)
+{
+  (void)file;
+  int DataIdx;
+
+  if ((STDIN_SOURCE == SINK_RTT) && __io_getbuf_rtt)
+  {
+    return __io_getbuf_rtt(ptr, len);
+  }
+
+  for (DataIdx = 0; DataIdx < len; DataIdx++)
+  {
+    *ptr++ = __io_getchar();
+  }
+
+  return len;
+}
+
+__attribute__((weak)) int _write(int file, char *ptr, int len)
+{
+  int DataIdx;
+  int sink = (file == 2) ? STDERR_SINK : STDOUT_SINK;
+
+  if ((sink == SINK_ITM) && __io_putbuf_itm)
+  {
+    return __io_putbuf_itm(ptr, len);
+  }
+
+  if ((sink == SINK_RTT) && __io_putbuf_rtt)
+  {
+    return __io_putbuf_rtt(ptr, len);
+  }
+
+  /* Hand the whole buffer to a non-blocking sink when the driver has one. */
+  if (__io_putbuf)
+  {
+    return __io_putbuf(ptr, len);
+  }
+
+  for (DataIdx = 0; DataIdx < len; DataIdx++)
+  {
+    __io_putchar(*ptr++);
+  }
+  return len;
+}
+
+int _close(int file)
+{
+  (void)file;
+  return -1;
+}
+
+
+int _fstat(int file, struct stat *st)
+{
+  (void)file;
+  st->st_mode = S_IFCHR;
+  return 0;
+}
+
+int _isatty(int file)
+{
+  (void)file;
+  return 1;
+}
+
+int _lseek(int file, int ptr, int dir)
+{
+  (void)file;
+  (void)ptr;
+  (void)dir;
+  return 0;
+}
+
+int _open(char *path, int flags, ...)
+{
+  (void)path;
+  (void)flags;
+  /* Pretend like we always fail */
+  return -1;
+}
+
+int _wait(int *status)
+{
+  (void)status;
+  errno = ECHILD;
+  return -1;
+}
+
+int _unlink(char *name)
+{
+  (void)name;
+  errno = ENOENT;
+  return -1;
+}
+
+int _times(struct tms *buf)
+{
+  (void)buf;
+  return -1;
+}
+
+int _stat(char *file, struct stat *st)
+{
+  (void)file;
+  st->st_mode = S_IFCHR;
+  return 0;
+}
+
+int _link(char *old, char *new)
+{
+  (void)old;
+  (void)new;
+  errno = EMLINK;
+  return -1;
+}
+
+int _fork(void)
+{
+  errno = EAGAIN;
+  return -1;
+}
+
+int _execve(char *name, char **argv, char **env)
+{
+  (void)name;
+  (void)argv;
+  (void)env;
+  errno = ENOMEM;
+  return -1;
+}
@@ -0,0 +1,197 @@
+/**
+ ******************************************************************************
+ * @file      sysmem.c
+ * @author    Generated by STM32CubeIDE
+ * @brief     STM32CubeIDE System Memory calls file
+ *
+ *            For more information about which C functions
+ *            need which of these lowlevel functions
+ *            please consult the newlib libc manual
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Includes */
+#include <errno.h>
+#include <stdint.h>
+#include <reent.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * Pointer to the current high watermark of the heap usage
+ */
+static uint8_t *__sbrk_heap_end = NULL;
+
+/**
+ * @brief _sbrk() allocates memory to the newlib heap and is used by malloc
+ *        and others from the C library
+ *
+ * @verbatim
+ * ############################################################################
+ * #  .data  #  .bss  #       newlib heap       #          MSP stack          #
+ * #         #        #                         # Reserved by _Min_Stack_Size #
+ * ############################################################################
+ * ^-- RAM start      ^-- _end                             _estack, RAM end --^
+ * @endverbatim
+ *
+ * This implementation starts allocating at the '_end' linker symbol
+ * The '_Min_Stack_Size' linker symbol reserves a memory for the MSP stack
+ * The implementation considers '_estack' linker symbol to be RAM end
+ * NOTE: If the MSP stack, at any point during execution, grows larger than the
+ * reserved size, please increase the '_Min_Stack_Size'.
+ * A linker script that gives the space above the newlib heap to the FreeRTOS
+ * heap (heap_regions.c) defines '_newlib_heap_end', where the heap stops.
+ *
+ * @param incr Memory size
+ * @return Pointer to allocated memory
+ */
+void *_sbrk(ptrdiff_t incr)
+{
+  extern uint8_t _end; /* Symbol defined in the linker script */
+  extern uint8_t _estack; /* Symbol defined in the linker script */
+  extern uint32_t _Min_Stack_Size; /* Symbol defined in the linker script */
+  extern uint8_t _newlib_heap_end __attribute__((weak)); /* Optional linker symbol */
+  const uint32_t stack_limit = (uint32_t)&_estack - (uint32_t)&_Min_Stack_Size;
+  const uint8_t *max_heap = (&_newlib_heap_end != NULL) ? &_newlib_heap_end : (uint8_t *)stack_limit;
+  uint8_t *prev_heap_end;
+
+  /* Initialize heap end at first call */
+  if (NULL == __sbrk_heap_end)
+  {
+    __sbrk_heap_end = &_end;
+  }
+
+  /* Protect heap from growing into the reserved MSP stack */
+  if (__sbrk_heap_end + incr > max_heap)
+  {
+    errno = ENOMEM;
+    return (void *)-1;
+  }
+
+  prev_heap_end = __sbrk_heap_end;
+  __sbrk_heap_end += incr;
+
+  return (void *)prev_heap_end;
+}
+
+/**
+ * @brief __malloc_lock() and __malloc_unlock() serialize newlib's allocator
+ *        between tasks. newlib calls them around every malloc(), free() and
+ *        realloc(), nested when one calls another, so they must be recursive
+ *
+ * Suspending the scheduler nests and leaves interrupts enabled. Before the
+ * scheduler starts there is only one thread, so nothing is locked: this also
+ * keeps a printf() in main() from masking interrupts, as a kernel call would.
+ * newlib's allocator must not be called from an ISR.
+ *
+ * @param r Reentrancy structure of the caller (unused)
+ */
+void __malloc_lock(struct _reent *r)
+{
+  (void)r;
+  configASSERT(xPortIsInsideInterrupt() == pdFALSE);
+
+  if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+  {
+    vTaskSuspendAll();
+  }
+}
+
+void __malloc_unlock(struct _reent *r)
+{
+  (void)r;
+
+  if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+  {
+    (void)xTaskResumeAll();
+  }
+}
+
+#if (configUSE_NEWLIB_MALLOC_HEAP == 1)
+
+/**
+ * @brief With configUSE_NEWLIB_MALLOC_HEAP set to 1, the malloc() family and
+ *        the _r variants newlib calls internally (stdio buffers, strdup(),
+ *        ...) are served by pvPortMalloc() and vPortFree(). There is then a
+ *        single heap, configTOTAL_HEAP_SIZE, and _sbrk() is never called:
+ *        set '_Min_Heap_Size' to 0 in the linker script
+ *
+ * heap_4.c serializes itself, so __malloc_lock() is not involved. A failed
+ * allocation sets errno to ENOMEM and calls vApplicationMallocFailedHook()
+ * if configUSE_MALLOC_FAILED_HOOK is 1.
+ */
+void *_malloc_r(struct _reent *r, size_t size)
+{
+  void *ptr = pvPortMalloc(size);
+
+  if ((NULL == ptr) && (size != 0U))
+  {
+    r->_errno = ENOMEM;
+  }
+
+  return ptr;
+}
+
+void _free_r(struct _reent *r, void *ptr)
+{
+  (void)r;
+  vPortFree(ptr);
+}
+
+void *_calloc_r(struct _reent *r, size_t nmemb, size_t size)
+{
+  /* Skips clearing what the heap knows to be clear */
+  void *ptr = pvPortCalloc(nmemb, size);
+
+  if ((NULL == ptr) && (nmemb != 0U) && (size != 0U))
+  {
+    r->_errno = ENOMEM;
+  }
+
+  return ptr;
+}
+
+void *_realloc_r(struct _reent *r, void *ptr, size_t size)
+{
+  /* Grows in place when it can, so rarely copies */
+  void *new_ptr = pvPortRealloc(ptr, size);
+
+  if ((NULL == new_ptr) && (size != 0U))
+  {
+    r->_errno = ENOMEM;
+  }
+
+  return new_ptr;
+}
+
+void *malloc(size_t size)
+{
+  return _malloc_r(_REENT, size);
+}
+
+void free(void *ptr)
+{
+  _free_r(_REENT, ptr);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+  return _calloc_r(_REENT, nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+  return _realloc_r(_REENT, ptr, size);
+}
+
+#endif /* configUSE_NEWLIB_MALLOC_HEAP */
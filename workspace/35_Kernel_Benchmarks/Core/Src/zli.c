@@ -0,0 +1,171 @@
+/*******************************************************************************
+ *
+ * @file	zli.c
+ * @brief	Zero-latency interrupts, above configMAX_SYSCALL_INTERRUPT_PRIORITY,
+ * 			with a deferred interrupt to reach the kernel from them.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Every kernel critical section sets BASEPRI to
+ * 			configMAX_SYSCALL_INTERRUPT_PRIORITY, which holds back interrupts
+ * 			of priorities configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY to 15
+ * 			for as long as it lasts. Interrupts of priorities 0 to
+ * 			configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY - 1 are never held
+ * 			back, so their entry latency does not depend on what the kernel
+ * 			is doing; in exchange they must not call the FreeRTOS API at all,
+ * 			FromISR functions included.
+ *
+ * 			Such an interrupt hands its data over through a lock-free ring
+ * 			(spsc_ring.h) or any other structure that needs no lock, and
+ * 			calls zli_defer() with a channel. zli_defer() sets the channel's
+ * 			bit with an exclusive access and pends ZLI_DEFER_IRQn, which runs
+ * 			at ZLI_DEFER_IRQ_PRIORITY once no more urgent interrupt is active,
+ * 			and calls the handler of every pending channel, highest first.
+ * 			The handlers may use the FromISR API, to wake a task for instance
+ * 			(zli_wake_ring()), and one context switch follows if needed.
+ *
+ * 			A channel deferred several times before its handler runs is
+ * 			handled once, so handlers drain everything that is waiting.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "zli.h"
+#include "spsc_ring.h"
+
+/* Data types ----------------------------------------------------------------*/
+typedef struct
+{
+	ZliHandler_t pxHandler;
+	void *pvArg;
+} ZliChannel_t;
+
+/* Variables -----------------------------------------------------------------*/
+static volatile uint32_t ulZliPending = 0;
+static ZliChannel_t xZliChannels[ZLI_MAX_CHANNELS];
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Enables the deferred interrupt.
+ * @param None
+ * @retval None
+ */
+void zli_init(void)
+{
+	NVIC_SetPriority(ZLI_DEFER_IRQn, ZLI_DEFER_IRQ_PRIORITY);
+	NVIC_ClearPendingIRQ(ZLI_DEFER_IRQn);
+	NVIC_EnableIRQ(ZLI_DEFER_IRQn);
+}
+
+/**
+ * @brief Enables an interrupt in the zero-latency tier.
+ * @param eIrq Interrupt.
+ * @param ulPriority Priority, below configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+ * @retval 0 if successful, -1 if the priority is one the kernel masks.
+ * @note The handler must not call the FreeRTOS API; it uses zli_defer().
+ */
+int32_t zli_irq_enable(IRQn_Type eIrq, uint32_t ulPriority)
+{
+	if (!ZLI_IS_ZERO_LATENCY(ulPriority))
+	{
+		return -1;
+	}
+
+	NVIC_SetPriority(eIrq, ulPriority);
+	NVIC_EnableIRQ(eIrq);
+
+	return 0;
+}
+
+/**
+ * @brief Sets the handler of a channel.
+ * @param ulChannel Channel, below ZLI_MAX_CHANNELS.
+ * @param pxHandler Called in the deferred interrupt after zli_defer().
+ * @param pvArg Argument of the handler.
+ * @retval 0 if successful, -1 otherwise.
+ * @note Before the channel is first deferred.
+ */
+int32_t zli_register(uint32_t ulChannel, ZliHandler_t pxHandler, void *pvArg)
+{
+	if ((ulChannel >= ZLI_MAX_CHANNELS) || (pxHandler == NULL))
+	{
+		return -1;
+	}
+
+	xZliChannels[ulChannel].pvArg = pvArg;
+	xZliChannels[ulChannel].pxHandler = pxHandler;
+
+	return 0;
+}
+
+/**
+ * @brief Runs the handler of a channel from the deferred interrupt.
+ * @param ulChannel Registered channel.
+ * @retval None
+ * @note From any context, zero-latency interrupts included: no critical
+ * section, only an exclusive access that is retried if another interrupt
+ * deferred in between.
+ */
+void zli_defer(uint32_t ulChannel)
+{
+	const uint32_t ulBit = 1UL << ulChannel;
+	uint32_t ulPending;
+
+	do
+	{
+		ulPending = __LDREXW(&ulZliPending);
+
+		/* Nothing to store if the channel is already pending. */
+		if ((ulPending & ulBit) != 0U)
+		{
+			__CLREX();
+			break;
+		}
+	} while (__STREXW(ulPending | ulBit, &ulZliPending) != 0U);
+
+	NVIC_SetPendingIRQ(ZLI_DEFER_IRQn);
+}
+
+/**
+ * @brief ZliHandler_t that wakes the consumer of an spsc_ring.h ring.
+ * @param pvRing SpscRing_t filled by a zero-latency interrupt.
+ * @param pxHigherPriorityTaskWoken Set if the consumer must run on exit.
+ * @retval None
+ */
+void zli_wake_ring(void *pvRing, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	spsc_ring_wake_from_isr((SpscRing_t *)pvRing, pxHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Deferred interrupt: calls the handler of each pending channel.
+ * @param None
+ * @retval None
+ */
+void ZLI_DEFER_IRQHandler(void)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	uint32_t ulPending;
+	uint32_t ulChannel;
+
+	/* Taken and cleared at once: a channel deferred from now on pends this
+	 * interrupt again. */
+	do
+	{
+		ulPending = __LDREXW(&ulZliPending);
+	} while (__STREXW(0U, &ulZliPending) != 0U);
+
+	while (ulPending != 0U)
+	{
+		ulChannel = 31U - __CLZ(ulPending);
+		ulPending &= ~(1UL << ulChannel);
+
+		if (xZliChannels[ulChannel].pxHandler != NULL)
+		{
+			xZliChannels[ulChannel].pxHandler(xZliChannels[ulChannel].pvArg, &xHigherPriorityTaskWoken);
+		}
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
@@ -0,0 +1,148 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Portion Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ * Portion Copyright (C) 2019 StMicroelectronics, Inc.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Host simulator build of 35_Kernel_Benchmarks (see Host/Makefile).
+ *
+ * The kernel options the benchmark results depend on are the ones of
+ * Core/Inc/FreeRTOSConfig.h, so a host run and a board run measure the same
+ * code paths.  The exceptions are the hardware specific options: there is no
+ * SRAM section to run from, no .noinit section, and the mutex fast path
+ * stores the owner as a 32-bit word, which a 64-bit host pointer does not fit.
+ *
+ * Stacks are in 8-byte words and also hold the ucontext and the C library
+ * frames of the host, hence the larger sizes.
+ *----------------------------------------------------------*/
+
+#include <stdint.h>
+
+#define configUSE_PREEMPTION                     1
+#define configSUPPORT_STATIC_ALLOCATION          1
+#define configSUPPORT_DYNAMIC_ALLOCATION         1
+#define configUSE_IDLE_HOOK                      1	/* Calls vPortSimulateTick(). */
+#define configUSE_TICK_HOOK                      0
+#define configCPU_CLOCK_HZ                       ( 1000000000UL )
+#define configTICK_RATE_HZ                       ((TickType_t)1000)
+#define configMAX_PRIORITIES                     ( 32 )
+#define configMINIMAL_STACK_SIZE                 ((uint16_t)2048)
+#define configTOTAL_HEAP_SIZE                    ((size_t)(512 * 1024))
+#define configHEAP_TLSF_FL_MAX                   18	/* heap_tlsf.c: blocks below 512 KB. */
+#define configMAX_TASK_NAME_LEN                  ( 16 )
+#define configUSE_TRACE_FACILITY                 1
+#define configUSE_16_BIT_TICKS                   0
+#define configUSE_MUTEXES                        1
+#define configQUEUE_REGISTRY_SIZE                8
+#define configUSE_RECURSIVE_MUTEXES              1
+#define configUSE_COUNTING_SEMAPHORES            1
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
+#endif
+#define configUSE_TASK_NOTIFICATIONS             1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES    2
+#define configMESSAGE_BUFFER_LENGTH_TYPE         size_t
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES                    0
+#define configMAX_CO_ROUTINE_PRIORITIES          ( 2 )
+
+/* Software timer definitions. */
+#define configUSE_TIMERS                         1
+#define configTIMER_TASK_PRIORITY                ( 2 )
+#define configTIMER_QUEUE_LENGTH                 10
+#define configTIMER_TASK_STACK_DEPTH             configMINIMAL_STACK_SIZE
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+#define INCLUDE_vTaskPrioritySet             1
+#define INCLUDE_uxTaskPriorityGet            1
+#define INCLUDE_vTaskDelete                  1
+#define INCLUDE_vTaskCleanUpResources        0
+#define INCLUDE_vTaskSuspend                 1
+#define INCLUDE_vTaskDelayUntil              1
+#define INCLUDE_vTaskDelay                   1
+#define INCLUDE_xTaskGetSchedulerState       1
+#define INCLUDE_xTimerPendFunctionCall       1
+#define INCLUDE_xQueueGetMutexHolder         1
+#define INCLUDE_uxTaskGetStackHighWaterMark  1
+#define INCLUDE_xTaskGetCurrentTaskHandle    1
+#define INCLUDE_eTaskGetState                1
+#define INCLUDE_xTaskGetHandle               1
+
+/* Kernel options of Core/Inc/FreeRTOSConfig.h.  Each can be overridden from
+the make command line to compare two builds, e.g.
+make clean run DEFS=-DconfigUSE_DELAYED_TASK_WHEEL=0. */
+#ifndef configUSE_EVENT_GROUPS_DIRECT_FROM_ISR
+#define configUSE_EVENT_GROUPS_DIRECT_FROM_ISR   1
+#endif
+#ifndef configUSE_QUEUE_BATCH
+#define configUSE_QUEUE_BATCH                    1
+#endif
+#ifndef configUSE_STREAM_BUFFER_ZERO_COPY
+#define configUSE_STREAM_BUFFER_ZERO_COPY        1
+#endif
+#ifndef configUSE_STREAM_BUFFER_HOLD_TIME
+#define configUSE_STREAM_BUFFER_HOLD_TIME        1
+#endif
+#ifndef configUSE_STREAM_BUFFER_MULTI_PRODUCER
+#define configUSE_STREAM_BUFFER_MULTI_PRODUCER   1
+#endif
+/* Timed by the tick count, as the default is: the delays read 0 or whole
+ticks. */
+#ifndef configUSE_MESSAGE_BUFFER_TIMESTAMPS
+#define configUSE_MESSAGE_BUFFER_TIMESTAMPS      1
+#endif
+#ifndef configUSE_DELAYED_TASK_WHEEL
+#define configUSE_DELAYED_TASK_WHEEL             1
+#endif
+#ifndef configUSE_TASK_NAME_INDEX
+#define configUSE_TASK_NAME_INDEX                1
+#endif
+#define configTASK_NAME_INDEX_SIZE               64
+#ifndef configUSE_NOTIFY_GROUPS
+#define configUSE_NOTIFY_GROUPS                  1
+#endif
+#ifndef configUSE_STREAM_BUFFER_VECTORS
+#define configUSE_STREAM_BUFFER_VECTORS          1
+#endif
+#ifndef configUSE_QUEUE_FAST_PATH
+#define configUSE_QUEUE_FAST_PATH                1
+#endif
+
+/* Hardware specific options, see above. */
+#define configUSE_MUTEX_FAST_PATH                0
+#define configUSE_KERNEL_RAM_FUNCTIONS           0
+#define configHEAP_NOINIT                        0
+
+/* Prints the failed assertion and aborts the run (main.c). */
+extern void vAssertCalled( const char *pcFile, int iLine );
+#define configASSERT( x ) if ((x) == 0) { vAssertCalled( __FILE__, __LINE__ ); }
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,57 @@
+/*******************************************************************************
+ *
+ * @file	bench.h
+ * @brief	Host simulator counterpart of Core/Inc/bench.h.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	bench_cycles() counts nanoseconds of CLOCK_MONOTONIC, so the
+ * 			cpu_mhz column reads 1000: the throughput formulas of the
+ * 			board rows apply unchanged.
+ *
+ ******************************************************************************/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <time.h>
+
+/* Macros --------------------------------------------------------------------*/
+#ifndef BENCH_HISTOGRAM_BINS
+#define BENCH_HISTOGRAM_BINS 65536U	/* One nanosecond per bin. */
+#endif
+
+/* Rate of bench_cycles(), printed in the cpu_mhz column. */
+#define BENCH_CYCLES_MHZ 1000UL
+
+/* Function Prototypes -------------------------------------------------------*/
+void bench_init(void);
+void bench_begin(const char *pcName);
+void bench_record(uint32_t ulCycles);
+void bench_end(void);
+
+/**
+ * @brief Nothing to start: the monotonic clock always runs.
+ * @param None
+ * @retval None
+ */
+static inline void bench_cycles_start(void)
+{
+}
+
+/**
+ * @brief Returns the monotonic clock.
+ * @param None
+ * @retval Nanoseconds, wrapping every 2^32.
+ */
+static inline uint32_t bench_cycles(void)
+{
+	struct timespec xNow;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &xNow);
+
+	return (uint32_t)((uint64_t)xNow.tv_sec * 1000000000ULL + (uint64_t)xNow.tv_nsec);
+}
+
+#endif /* BENCH_H */
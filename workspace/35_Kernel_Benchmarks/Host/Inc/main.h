@@ -0,0 +1,17 @@
+/*******************************************************************************
+ *
+ * @file	main.h
+ * @brief	Host simulator counterpart of Core/Inc/main.h.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Only declares what the shared benchmark sources use.
+ *
+ ******************************************************************************/
+
+#ifndef MAIN_H
+#define MAIN_H
+
+/* Function Prototypes -------------------------------------------------------*/
+void Error_Handler(void);
+
+#endif /* MAIN_H */
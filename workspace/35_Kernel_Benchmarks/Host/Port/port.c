@@ -0,0 +1,310 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the host simulator.
+ *----------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <ucontext.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The context of a task lives at the top of its own stack, and
+pxPortInitialiseStack() returns its address as the top of stack.  The first
+member of the TCB is that pointer, which is how the CM4F port finds the stack
+of pxCurrentTCB too. */
+typedef struct PortContext
+{
+	ucontext_t xContext;
+	TaskFunction_t pxCode;
+	void *pvParameters;
+} PortContext_t;
+
+/* makecontext() only needs the top of the stack, which pxPortInitialiseStack()
+knows; the bottom is the kernel's to check (configCHECK_FOR_STACK_OVERFLOW).
+The size given to makecontext() is nominal. */
+#define portCONTEXT_ALIGNMENT		( ( uintptr_t ) 64 )
+#define portNOMINAL_STACK_BYTES		( ( size_t ) configMINIMAL_STACK_SIZE * sizeof( StackType_t ) )
+
+#define portCURRENT_CONTEXT()		( *( PortContext_t ** ) pxCurrentTCB )
+
+/* The task running, from tasks.c. */
+extern void * volatile pxCurrentTCB;
+
+/* The thread's own context, resumed by vPortEndScheduler(). */
+static ucontext_t xSchedulerContext;
+
+/* As in the CM4F port, one nesting count serves all tasks: a switch only
+happens with it at 0. */
+static volatile UBaseType_t uxCriticalNesting = 0;
+
+/* The "interrupt mask": set by portDISABLE_INTERRUPTS() and critical
+sections.  A yield requested while it is set is held in xYieldPending. */
+static volatile BaseType_t xInterruptsMasked = pdTRUE;
+static volatile BaseType_t xYieldPending = pdFALSE;
+
+/* Ticks per simulated tick, and the number asked for by xPortSetTickRate(),
+which the next simulated tick puts into effect, as SysTick does. */
+#if( configUSE_DYNAMIC_TICK_RATE == 1 )
+	static TickType_t xTicksPerInterrupt = 1;
+	static TickType_t xNewTicksPerInterrupt = 1;
+#endif /* configUSE_DYNAMIC_TICK_RATE */
+
+/*
+ * Selects the next task and switches to it, if it is another one.
+ */
+static void prvSwitchContext( void );
+
+/*
+ * Starts a task: calls its function with its parameter.
+ */
+static void prvTaskEntry( void );
+
+/*
+ * Used to catch tasks that attempt to return from their implementing function.
+ */
+static void prvTaskExitError( void );
+
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+PortContext_t *pxContext;
+uintptr_t uxAddress;
+
+	uxAddress = ( ( uintptr_t ) pxTopOfStack ) - sizeof( PortContext_t );
+	uxAddress &= ~( portCONTEXT_ALIGNMENT - 1U );
+	pxContext = ( PortContext_t * ) uxAddress;
+
+	pxContext->pxCode = pxCode;
+	pxContext->pvParameters = pvParameters;
+
+	if( getcontext( &( pxContext->xContext ) ) != 0 )
+	{
+		configASSERT( 0 );
+	}
+
+	/* The task stack grows down from just below the context. */
+	pxContext->xContext.uc_stack.ss_sp = ( void * ) ( uxAddress - portNOMINAL_STACK_BYTES );
+	pxContext->xContext.uc_stack.ss_size = portNOMINAL_STACK_BYTES;
+	pxContext->xContext.uc_link = NULL;
+	makecontext( &( pxContext->xContext ), prvTaskEntry, 0 );
+
+	return ( StackType_t * ) pxContext;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskEntry( void )
+{
+PortContext_t *pxContext = portCURRENT_CONTEXT();
+
+	pxContext->pxCode( pxContext->pvParameters );
+	prvTaskExitError();
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskExitError( void )
+{
+	/* A function that implements a task must not exit or attempt to return to
+	its caller as there is nothing to return to.  If a task wants to exit it
+	should instead call vTaskDelete( NULL ). */
+	fprintf( stderr, "FreeRTOS: a task returned from its function\n" );
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+	/* vTaskStartScheduler() masked interrupts; the first task runs with them
+	enabled. */
+	uxCriticalNesting = 0;
+	xInterruptsMasked = pdFALSE;
+	xYieldPending = pdFALSE;
+
+	if( swapcontext( &xSchedulerContext, &( portCURRENT_CONTEXT()->xContext ) ) != 0 )
+	{
+		return pdFALSE;
+	}
+
+	/* Back from vPortEndScheduler(). */
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	/* Returns from xPortStartScheduler(), then vTaskStartScheduler(), on the
+	thread's own stack.  The tasks are abandoned as they are. */
+	( void ) setcontext( &xSchedulerContext );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+	if( xInterruptsMasked != pdFALSE )
+	{
+		/* Like PendSV, the switch waits for interrupts to be enabled. */
+		xYieldPending = pdTRUE;
+	}
+	else
+	{
+		prvSwitchContext();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchContext( void )
+{
+PortContext_t *pxPrevious = portCURRENT_CONTEXT();
+PortContext_t *pxNext;
+
+	xYieldPending = pdFALSE;
+
+	vTaskSwitchContext();
+	pxNext = portCURRENT_CONTEXT();
+
+	if( pxNext != pxPrevious )
+	{
+		/* A task that deleted itself saves its context into its own stack,
+		which the idle task frees only after this switch. */
+		if( swapcontext( &( pxPrevious->xContext ), &( pxNext->xContext ) ) != 0 )
+		{
+			configASSERT( 0 );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	xInterruptsMasked = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	xInterruptsMasked = pdFALSE;
+
+	if( xYieldPending != pdFALSE )
+	{
+		prvSwitchContext();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	portDISABLE_INTERRUPTS();
+	uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	configASSERT( uxCriticalNesting );
+	uxCriticalNesting--;
+
+	if( uxCriticalNesting == 0 )
+	{
+		portENABLE_INTERRUPTS();
+	}
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortSetInterruptMask( void )
+{
+UBaseType_t uxSavedMask = ( UBaseType_t ) xInterruptsMasked;
+
+	xInterruptsMasked = pdTRUE;
+
+	return uxSavedMask;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( UBaseType_t uxSavedMask )
+{
+	if( uxSavedMask == ( UBaseType_t ) pdFALSE )
+	{
+		portENABLE_INTERRUPTS();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulateTick( void )
+{
+UBaseType_t uxSavedMask;
+
+	/* What xPortSysTickHandler() does; the switch, if any, is taken when the
+	mask is cleared. */
+	uxSavedMask = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		#if( configUSE_DYNAMIC_TICK_RATE == 1 )
+		if( xTaskIncrementTickBy( xTicksPerInterrupt ) != pdFALSE )
+		#else
+		if( xTaskIncrementTick() != pdFALSE )
+		#endif
+		{
+			xYieldPending = pdTRUE;
+		}
+
+		#if( configUSE_DYNAMIC_TICK_RATE == 1 )
+		{
+			xTicksPerInterrupt = xNewTicksPerInterrupt;
+		}
+		#endif
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedMask );
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_DYNAMIC_TICK_RATE == 1 )
+
+	BaseType_t xPortSetTickRate( uint32_t ulTickRateHz )
+	{
+		/* Whole ticks per simulated tick.  There is no reload to fit. */
+		if( ( ulTickRateHz == 0UL ) || ( ulTickRateHz > configTICK_RATE_HZ ) || ( ( configTICK_RATE_HZ % ulTickRateHz ) != 0UL ) )
+		{
+			return pdFAIL;
+		}
+
+		xNewTicksPerInterrupt = ( TickType_t ) ( configTICK_RATE_HZ / ulTickRateHz );
+
+		return pdPASS;
+	}
+	/*-----------------------------------------------------------*/
+
+	uint32_t ulPortGetTickRate( void )
+	{
+		return ( uint32_t ) ( configTICK_RATE_HZ / xTicksPerInterrupt );
+	}
+
+#endif /* configUSE_DYNAMIC_TICK_RATE */
+/*-----------------------------------------------------------*/
@@ -0,0 +1,201 @@
+/*******************************************************************************
+ *
+ * @file	main.c
+ * @brief	Runs the kernel primitive and allocator benchmarks on the host
+ * 			simulator port.
+ * @author	Kyungjae Lee
+ * @date	Oct 14, 2026
+ * @note	Builds Core/Src/kernel_bench.c, Core/Src/heap_bench.c and
+ * 			Core/Src/bench.c against the kernel sources of this project and
+ * 			Port/port.c, and prints the same CSV as the board (see
+ * 			bench.c), in nanoseconds instead of cycles. The ISR latency and
+ * 			ADC rows need the hardware and are not run.
+ *
+ * 			With configUSE_DYNAMIC_TICK_RATE, the benchmarks run at
+ * 			BENCH_TICK_RATE_HZ, each simulated tick stepping the tick count
+ * 			over several ticks (xTaskIncrementTickBy()).
+ *
+ * 			Exits with 0 after the "# done" line, or 1 on Error_Handler()
+ * 			or a failed configASSERT().
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bench.h"
+#include "kernel_bench.h"
+#include "heap_bench.h"
+
+/* Macros --------------------------------------------------------------------*/
+#define STACK_SIZE					(4U * configMINIMAL_STACK_SIZE)	// printf() runs on it
+#define BENCH_TASK_PRIORITY			(configMAX_PRIORITIES - 1)
+#define HEAP_REGION_SRAM2_SIZE		(16U * 1024U)	/* As the board's SRAM2. */
+#define BENCH_TICK_RATE_HZ			(configTICK_RATE_HZ / 10U)	/* configUSE_DYNAMIC_TICK_RATE */
+
+/* Function Prototypes -------------------------------------------------------*/
+void vBenchmarkTask(void *pvParameters);
+
+/* Variables -----------------------------------------------------------------*/
+static StaticTask_t xIdleTcb;
+static StackType_t xIdleStack[configMINIMAL_STACK_SIZE];
+static StaticTask_t xTimerTcb;
+static StackType_t xTimerStack[configTIMER_TASK_STACK_DEPTH];
+
+#if (configUSE_HEAP_REGIONS == 1)
+/* Two regions of the size of ucHeap between them, the second one as small as
+ * the board's SRAM2. */
+static uint8_t ucHeapRegion1[configTOTAL_HEAP_SIZE - HEAP_REGION_SRAM2_SIZE];
+static uint8_t ucHeapRegion2[HEAP_REGION_SRAM2_SIZE];
+static HeapRegion_t xHeapRegions[3];
+#endif
+
+/* Public function definitions -----------------------------------------------*/
+
+/**
+ * @brief Creates the benchmark task and runs the scheduler until it ends.
+ * @param None
+ * @retval 0 once every benchmark has run.
+ */
+int main(void)
+{
+	BaseType_t xStatus;
+
+	/* One line at a time, also when redirected to a file. */
+	setvbuf(stdout, NULL, _IOLBF, 0);
+
+	xStatus = xTaskCreate(
+			vBenchmarkTask,
+			"vBenchmarkTask",
+			STACK_SIZE,
+			NULL,
+			BENCH_TASK_PRIORITY,
+			NULL);
+
+	if (xStatus != pdPASS)
+	{
+		Error_Handler();
+	}
+
+	/* Returns after vTaskEndScheduler(). */
+	vTaskStartScheduler();
+
+	return 0;
+}
+
+/**
+ * @brief Runs every kernel benchmark once, then stops the scheduler.
+ * @param pvParameters Unused parameter, included for compatibility with FreeRTOS
+ * task function signature.
+ * @retval None
+ */
+void vBenchmarkTask(void *pvParameters)
+{
+	bench_init();
+
+#if (configUSE_DYNAMIC_TICK_RATE == 1)
+	if (xPortSetTickRate(BENCH_TICK_RATE_HZ) != pdPASS)
+	{
+		Error_Handler();
+	}
+
+	/* The next simulated tick puts the rate into effect. */
+	vTaskDelay(1);
+
+	printf("# tick_rate_hz=%lu\r\n", (unsigned long)ulPortGetTickRate());
+#endif
+
+	kernel_bench_run();
+	heap_bench_run();
+
+	printf("# done\r\n");
+
+	vTaskEndScheduler();
+}
+
+/**
+ * @brief Plays the tick interrupt whenever every task is blocked.
+ * @param None
+ * @retval None
+ */
+void vApplicationIdleHook(void)
+{
+	vPortSimulateTick();
+}
+
+/**
+ * @brief Provides the memory of the idle task (configSUPPORT_STATIC_ALLOCATION).
+ * @param ppxIdleTaskTCBBuffer Receives the TCB.
+ * @param ppxIdleTaskStackBuffer Receives the stack.
+ * @param pulIdleTaskStackSize Receives the stack depth, in words.
+ * @retval None
+ */
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize)
+{
+	*ppxIdleTaskTCBBuffer = &xIdleTcb;
+	*ppxIdleTaskStackBuffer = xIdleStack;
+	*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+/**
+ * @brief Provides the memory of the timer service task.
+ * @param ppxTimerTaskTCBBuffer Receives the TCB.
+ * @param ppxTimerTaskStackBuffer Receives the stack.
+ * @param pulTimerTaskStackSize Receives the stack depth, in words.
+ * @retval None
+ */
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize)
+{
+	*ppxTimerTaskTCBBuffer = &xTimerTcb;
+	*ppxTimerTaskStackBuffer = xTimerStack;
+	*pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+
+#if (configUSE_HEAP_REGIONS == 1)
+/**
+ * @brief Provides the regions of the heap (configUSE_HEAP_REGIONS).
+ * @param ppxHeapRegions Receives the regions, by ascending address and
+ * terminated by a zero size one.
+ * @retval None
+ * @note The linker places the two arrays in either order.
+ */
+void vApplicationGetHeapRegions(const HeapRegion_t **ppxHeapRegions)
+{
+	const BaseType_t xFirst = ((uintptr_t)ucHeapRegion1 < (uintptr_t)ucHeapRegion2) ? 0 : 1;
+
+	xHeapRegions[xFirst].pucStartAddress = ucHeapRegion1;
+	xHeapRegions[xFirst].xSizeInBytes = sizeof(ucHeapRegion1);
+	xHeapRegions[1 - xFirst].pucStartAddress = ucHeapRegion2;
+	xHeapRegions[1 - xFirst].xSizeInBytes = sizeof(ucHeapRegion2);
+	xHeapRegions[2].pucStartAddress = NULL;
+	xHeapRegions[2].xSizeInBytes = 0;
+
+	*ppxHeapRegions = xHeapRegions;
+}
+#endif
+
+/**
+ * @brief Reports a failed configASSERT() and ends the run.
+ * @param pcFile Source file of the assertion.
+ * @param iLine Line of the assertion.
+ * @retval None
+ */
+void vAssertCalled(const char *pcFile, int iLine)
+{
+	printf("# assert %s:%d\r\n", pcFile, iLine);
+	exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief Ends the run on an unrecoverable error.
+ * @param None
+ * @retval None
+ */
+void Error_Handler(void)
+{
+	printf("# error\r\n");
+	exit(EXIT_FAILURE);
+}
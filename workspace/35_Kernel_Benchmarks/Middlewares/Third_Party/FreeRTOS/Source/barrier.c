@@ -0,0 +1,192 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "barrier.h"
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build barrier.c
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/*
+ * Removes the calling task from the waiters of a barrier whose block time
+ * expired.  Called in a critical section, in the generation it arrived in.
+ */
+static void prvLeave( BarrierHandle_t xBarrier, TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+BarrierHandle_t xBarrierCreateStatic( UBaseType_t uxParties, UBaseType_t uxIndex, TaskHandle_t *pxWaiters, StaticBarrier_t *pxBarrierBuffer )
+{
+	configASSERT( pxBarrierBuffer );
+	configASSERT( pxWaiters );
+	configASSERT( uxParties >= ( UBaseType_t ) 2 );
+	configASSERT( uxIndex < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+	pxBarrierBuffer->pxWaiters = pxWaiters;
+	pxBarrierBuffer->uxParties = uxParties;
+	pxBarrierBuffer->uxIndex = uxIndex;
+	pxBarrierBuffer->uxArrived = ( UBaseType_t ) 0;
+	pxBarrierBuffer->uxGeneration = ( UBaseType_t ) 0;
+
+	return pxBarrierBuffer;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xBarrierWait( BarrierHandle_t xBarrier, TickType_t xTicksToWait )
+{
+TaskHandle_t xTask;
+TimeOut_t xTimeOut;
+UBaseType_t uxGeneration, uxWaiters = ( UBaseType_t ) 0, uxWaiter;
+BaseType_t xLast = pdFALSE, xReturn;
+
+	configASSERT( xBarrier );
+
+	xTask = xTaskGetCurrentTaskHandle();
+
+	taskENTER_CRITICAL();
+	{
+		uxGeneration = xBarrier->uxGeneration;
+
+		if( ( xBarrier->uxArrived + ( UBaseType_t ) 1 ) < xBarrier->uxParties )
+		{
+			xBarrier->pxWaiters[ xBarrier->uxArrived ] = xTask;
+			( xBarrier->uxArrived )++;
+		}
+		else
+		{
+			/* The last party.  The waiters are released with the scheduler
+			suspended, so none of them can arrive again, and overwrite a
+			handle not yet notified, before all have been. */
+			vTaskSuspendAll();
+			xLast = pdTRUE;
+			uxWaiters = xBarrier->uxArrived;
+			xBarrier->uxArrived = ( UBaseType_t ) 0;
+			( xBarrier->uxGeneration )++;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xLast != pdFALSE )
+	{
+		for( uxWaiter = 0; uxWaiter < uxWaiters; uxWaiter++ )
+		{
+			( void ) xTaskNotifyGiveIndexed( xBarrier->pxWaiters[ uxWaiter ], xBarrier->uxIndex );
+		}
+
+		( void ) xTaskResumeAll();
+
+		return pdTRUE;
+	}
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTakeIndexed( xBarrier->uxIndex, pdTRUE, xTicksToWait );
+
+		/* A wake-up is only a release if the generation moved on. */
+		if( xBarrier->uxGeneration != uxGeneration )
+		{
+			xReturn = pdTRUE;
+			break;
+		}
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( xBarrier->uxGeneration == uxGeneration )
+				{
+					prvLeave( xBarrier, xTask );
+					xReturn = pdFALSE;
+				}
+				else
+				{
+					/* Released as the block time expired.  The release was
+					complete before this task could run, so its notification
+					is pending: clear it. */
+					( void ) ulTaskNotifyValueClearIndexed( xTask, xBarrier->uxIndex, ~( ( uint32_t ) 0 ) );
+					( void ) xTaskNotifyStateClearIndexed( xTask, xBarrier->uxIndex );
+					xReturn = pdTRUE;
+				}
+			}
+			taskEXIT_CRITICAL();
+			break;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvLeave( BarrierHandle_t xBarrier, TaskHandle_t xTask )
+{
+UBaseType_t uxWaiter;
+
+	/* Only on a timeout, so the walk is not on the arrival path.  The order of
+	the waiters does not matter: the last one takes the freed place. */
+	for( uxWaiter = 0; uxWaiter < xBarrier->uxArrived; uxWaiter++ )
+	{
+		if( xBarrier->pxWaiters[ uxWaiter ] == xTask )
+		{
+			( xBarrier->uxArrived )--;
+			xBarrier->pxWaiters[ uxWaiter ] = xBarrier->pxWaiters[ xBarrier->uxArrived ];
+			break;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxBarrierGetArrivedCount( BarrierHandle_t xBarrier )
+{
+	configASSERT( xBarrier );
+
+	return xBarrier->uxArrived;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxBarrierGetGeneration( BarrierHandle_t xBarrier )
+{
+	configASSERT( xBarrier );
+
+	return xBarrier->uxGeneration;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,296 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*-----------------------------------------------------------
+ * Portable layer API.  Each function must be defined for each port.
+ *----------------------------------------------------------*/
+
+#ifndef PORTABLE_H
+#define PORTABLE_H
+
+/* Each FreeRTOS port has a unique portmacro.h header file.  Originally a
+pre-processor definition was used to ensure the pre-processor found the correct
+portmacro.h file for the port being used.  That scheme was deprecated in favour
+of setting the compiler's include path such that it found the correct
+portmacro.h file - removing the need for the constant and allowing the
+portmacro.h file to be located anywhere in relation to the port being used.
+Purely for reasons of backward compatibility the old method is still valid, but
+to make it clear that new projects should not use it, support for the port
+specific constants has been moved into the deprecated_definitions.h header
+file. */
+#include "deprecated_definitions.h"
+
+/* If portENTER_CRITICAL is not defined then including deprecated_definitions.h
+did not result in a portmacro.h header file being included - and it should be
+included here.  In this case the path to the correct portmacro.h header file
+must be set in the compiler's include path. */
+#ifndef portENTER_CRITICAL
+	#include "portmacro.h"
+#endif
+
+#if portBYTE_ALIGNMENT == 32
+	#define portBYTE_ALIGNMENT_MASK ( 0x001f )
+#endif
+
+#if portBYTE_ALIGNMENT == 16
+	#define portBYTE_ALIGNMENT_MASK ( 0x000f )
+#endif
+
+#if portBYTE_ALIGNMENT == 8
+	#define portBYTE_ALIGNMENT_MASK ( 0x0007 )
+#endif
+
+#if portBYTE_ALIGNMENT == 4
+	#define portBYTE_ALIGNMENT_MASK	( 0x0003 )
+#endif
+
+#if portBYTE_ALIGNMENT == 2
+	#define portBYTE_ALIGNMENT_MASK	( 0x0001 )
+#endif
+
+#if portBYTE_ALIGNMENT == 1
+	#define portBYTE_ALIGNMENT_MASK	( 0x0000 )
+#endif
+
+#ifndef portBYTE_ALIGNMENT_MASK
+	#error "Invalid portBYTE_ALIGNMENT definition"
+#endif
+
+#ifndef portNUM_CONFIGURABLE_REGIONS
+	#define portNUM_CONFIGURABLE_REGIONS 1
+#endif
+
+#ifndef portHAS_STACK_OVERFLOW_CHECKING
+	#define portHAS_STACK_OVERFLOW_CHECKING 0
+#endif
+
+#ifndef portARCH_NAME
+	#define portARCH_NAME NULL
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mpu_wrappers.h"
+
+/*
+ * Setup the stack of a new task so it is ready to be placed under the
+ * scheduler control.  The registers have to be placed on the stack in
+ * the order that the port expects to find them.
+ *
+ */
+#if( portUSING_MPU_WRAPPERS == 1 )
+	#if( portHAS_STACK_OVERFLOW_CHECKING == 1 )
+		StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, StackType_t *pxEndOfStack, TaskFunction_t pxCode, void *pvParameters, BaseType_t xRunPrivileged ) PRIVILEGED_FUNCTION;
+	#else
+		StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters, BaseType_t xRunPrivileged ) PRIVILEGED_FUNCTION;
+	#endif
+#else
+	#if( portHAS_STACK_OVERFLOW_CHECKING == 1 )
+		StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, StackType_t *pxEndOfStack, TaskFunction_t pxCode, void *pvParameters ) PRIVILEGED_FUNCTION;
+	#else
+		StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters ) PRIVILEGED_FUNCTION;
+	#endif
+#endif
+
+/* Used by heap_5.c to define the start address and size of each memory region
+that together comprise the total FreeRTOS heap space. */
+typedef struct HeapRegion
+{
+	uint8_t *pucStartAddress;
+	size_t xSizeInBytes;
+} HeapRegion_t;
+
+/* Used to pass information about the heap out of vPortGetHeapStats(). */
+typedef struct xHeapStats
+{
+	size_t xAvailableHeapSpaceInBytes;		/* The total heap size currently available - this is the sum of all the free blocks, not the largest block that can be allocated. */
+	size_t xSizeOfLargestFreeBlockInBytes; 	/* The maximum size, in bytes, of all the free blocks within the heap at the time vPortGetHeapStats() is called. */
+	size_t xSizeOfSmallestFreeBlockInBytes; /* The minimum size, in bytes, of all the free blocks within the heap at the time vPortGetHeapStats() is called. */
+	size_t xNumberOfFreeBlocks;				/* The number of free memory blocks within the heap at the time vPortGetHeapStats() is called. */
+	size_t xMinimumEverFreeBytesRemaining;	/* The minimum amount of total free memory (sum of all free blocks) there has been in the heap since the system booted. */
+	size_t xNumberOfSuccessfulAllocations;	/* The number of calls to pvPortMalloc() that have returned a valid memory block. */
+	size_t xNumberOfSuccessfulFrees;		/* The number of calls to vPortFree() that has successfully freed a block of memory. */
+} HeapStats_t;
+
+/* Used to pass information about each heap_4.c slab class out of
+uxPortGetSlabStats() when configUSE_HEAP_SLABS is 1. */
+typedef struct xSlabStats
+{
+	size_t xObjectSizeInBytes;			/* The exact request size served by the class. */
+	size_t xNumberOfSlabs;				/* The number of slabs taken from the heap for the class.  They are never given back. */
+	size_t xNumberOfObjects;			/* The number of objects in those slabs, free or in use. */
+	size_t xObjectsInUse;				/* The number of objects currently allocated. */
+	size_t xMaximumEverObjectsInUse;	/* The most objects there have been allocated at once since the system booted. */
+} SlabStats_t;
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	/* One entry of HeapInstrumentation_t.xCallers[]. */
+	typedef struct xHeapCallerStats
+	{
+		void *pvCaller;							/* Return address of the pvPortMalloc() call.  NULL in the last entry, which collects the callers that did not fit. */
+		size_t xOutstandingBytes;				/* Bytes, headers and padding included, allocated from here and not yet freed. */
+		size_t xOutstandingBlocks;				/* Blocks allocated from here and not yet freed. */
+		size_t xMaximumEverOutstandingBytes;	/* The most xOutstandingBytes has been since the system booted. */
+	} HeapCallerStats_t;
+
+	/* Used to pass the heap_4.c instrumentation out of
+	vPortGetHeapInstrumentation(). */
+	typedef struct xHeapInstrumentation
+	{
+		size_t xAllocationsBySize[ configHEAP_HISTOGRAM_BUCKETS ];	/* Successful pvPortMalloc() calls by requested size.  Bucket n counts sizes of up to 16 << n bytes, the last bucket everything larger. */
+		size_t xOutstandingBySize[ configHEAP_HISTOGRAM_BUCKETS ];	/* Of those, the blocks not yet freed. */
+		HeapCallerStats_t xCallers[ configHEAP_INSTRUMENTATION_CALLERS ];
+		size_t xOutstandingBytes;				/* Bytes allocated and not yet freed, headers and padding included. */
+		size_t xMaximumEverOutstandingBytes;	/* The most xOutstandingBytes has been since the system booted.  configTOTAL_HEAP_SIZE needs to be at least this, plus room for fragmentation. */
+		size_t xFailedAllocations;				/* The number of calls to pvPortMalloc() that returned NULL. */
+	} HeapInstrumentation_t;
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
+/*
+ * Used to define multiple heap regions for use by heap_5.c.  This function
+ * must be called before any calls to pvPortMalloc() - not creating a task,
+ * queue, semaphore, mutex, software timer, event group, etc. will result in
+ * pvPortMalloc being called.
+ *
+ * pxHeapRegions passes in an array of HeapRegion_t structures - each of which
+ * defines a region of memory that can be used as the heap.  The array is
+ * terminated by a HeapRegions_t structure that has a size of 0.  The region
+ * with the lowest start address must appear first in the array.
+ */
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
+
+/*
+ * Only provided by heap_4.c, and only when configUSE_HEAP_REGIONS is 1.  The
+ * heap is then made of up to configHEAP_MAX_REGIONS regions, given to
+ * vPortDefineHeapRegions() before the first allocation or, failing that,
+ * returned by vApplicationGetHeapRegions() when the first allocation is made.
+ * Regions are numbered from 0 in array order.
+ *
+ * pvPortMalloc() takes the first fit in any region, lowest address first.
+ * pvPortMallocRegion() only allocates from region xRegion, for memory that
+ * must be in a given bank, such as DMA buffers.  Both are freed with
+ * vPortFree().  xPortGetFreeHeapSizeRegion() returns the free bytes of one
+ * region.
+ */
+#if( configUSE_HEAP_REGIONS == 1 )
+	void vApplicationGetHeapRegions( const HeapRegion_t **ppxHeapRegions );
+	void *pvPortMallocRegion( size_t xWantedSize, BaseType_t xRegion ) PRIVILEGED_FUNCTION;
+	size_t xPortGetFreeHeapSizeRegion( BaseType_t xRegion ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Returns a HeapStats_t structure filled with information about the current
+ * heap state.
+ */
+void vPortGetHeapStats( HeapStats_t *pxHeapStats );
+
+/*
+ * Fills up to uxArraySize SlabStats_t structures, one per slab class, and
+ * returns the number filled.  Only provided by heap_4.c, and only when
+ * configUSE_HEAP_SLABS is 1.  Free objects held by a class are
+ * xNumberOfObjects - xObjectsInUse; fragmentation of the heap itself is
+ * reported by vPortGetHeapStats().
+ */
+UBaseType_t uxPortGetSlabStats( SlabStats_t *pxSlabStats, UBaseType_t uxArraySize );
+
+/*
+ * Only provided by heap_4.c, and only when configUSE_HEAP_INSTRUMENTATION is 1.
+ * vPortGetHeapInstrumentation() takes a consistent copy of the allocation size
+ * histogram and the per caller totals.  vPortHeapReport() writes them as text,
+ * together with the vPortGetHeapStats() and slab figures, to pcWriteBuffer.
+ * The report is truncated to xBufferLength - 1 characters; 1024 bytes is
+ * enough for the default number of callers.
+ */
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	void vPortGetHeapInstrumentation( HeapInstrumentation_t *pxHeapInstrumentation );
+	void vPortHeapReport( char *pcWriteBuffer, size_t xBufferLength );
+#endif
+
+/*
+ * Map to the memory management routines required for the port.
+ */
+void *pvPortMalloc( size_t xSize ) PRIVILEGED_FUNCTION;
+void vPortFree( void *pv ) PRIVILEGED_FUNCTION;
+void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
+size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
+size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Only provided by heap_4.c.  Returns the number of bytes the caller may use
+ * in a block returned by pvPortMalloc(), which can be more than it asked for,
+ * or 0 if pv is NULL.  realloc() needs it when newlib's allocator is routed to
+ * the FreeRTOS heap (configUSE_NEWLIB_MALLOC_HEAP).
+ */
+size_t xPortGetAllocationSize( void *pv ) PRIVILEGED_FUNCTION;
+
+/*
+ * pvPortRealloc() resizes a block returned by pvPortMalloc() as realloc()
+ * does, and pvPortCalloc() allocates xNum * xSize zeroed bytes, or returns NULL
+ * if the product overflows.  heap_4.c shrinks a block in place, and grows it in
+ * place when the block just above it is free and large enough, so only copies
+ * as a last resort.  When its heap is a static array, which the C startup
+ * code clears, pvPortCalloc() only clears the part of the block that has been
+ * written since boot.
+ */
+void *pvPortRealloc( void *pv, size_t xWantedSize ) PRIVILEGED_FUNCTION;
+void *pvPortCalloc( size_t xNum, size_t xSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Setup the hardware ready for the scheduler to take control.  This generally
+ * sets up a tick interrupt and sets timers for the correct tick frequency.
+ */
+BaseType_t xPortStartScheduler( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Undo any hardware/ISR setup that was performed by xPortStartScheduler() so
+ * the hardware is left in its original condition after the scheduler stops
+ * executing.
+ */
+void vPortEndScheduler( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * The structures and methods of manipulating the MPU are contained within the
+ * port layer.
+ *
+ * Fills the xMPUSettings structure with the memory region information
+ * contained in xRegions.
+ */
+#if( portUSING_MPU_WRAPPERS == 1 )
+	struct xMEMORY_REGION;
+	void vPortStoreTaskMPUSettings( xMPU_SETTINGS *xMPUSettings, const struct xMEMORY_REGION * const xRegions, StackType_t *pxBottomOfStack, uint32_t ulStackDepth ) PRIVILEGED_FUNCTION;
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTABLE_H */
+
@@ -0,0 +1,369 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * The settings in this file configure FreeRTOS correctly for the
+ * given hardware and compiler.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	uint32_t
+#define portBASE_TYPE	long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffff
+#elif( configUSE_64_BIT_TICKS == 1 )
+	typedef uint64_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffffffffffULL
+
+	/* Two loads, so not atomic.  xTaskGetTickCount() reads the high word twice
+	instead of entering a critical section (see tasks.c). */
+	#define portTICK_TYPE_IS_ATOMIC 0
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+
+	/* 32-bit tick type on a 32-bit architecture, so reads of the tick count do
+	not need to be guarded with a critical section. */
+	#define portTICK_TYPE_IS_ATOMIC 1
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+/*-----------------------------------------------------------*/
+
+/* Scheduler utilities. */
+#define portYIELD_PENDSV() 														\
+{																				\
+	/* Set a PendSV to request a context switch. */								\
+	portNVIC_INT_CTRL_REG = portNVIC_PENDSVSET_BIT;								\
+																				\
+	/* Barriers are normally not required but do ensure the code is completely	\
+	within the specified behaviour for the architecture. */						\
+	__asm volatile( "dsb" ::: "memory" );										\
+	__asm volatile( "isb" );													\
+}
+
+/* With configUSE_FAST_COOPERATIVE_YIELD set to 1, a task that yields or
+blocks switches to the next task in thread mode, without PendSV: vPortYield()
+saves only what a function call has to preserve, in the layout of
+xPortPendSVHandler(), and returns straight into the next task if that task was
+switched out the same way.  Interrupts still request switches with PendSV.
+Only available with configUSE_PREEMPTION 0, where all switches but those are
+voluntary. */
+#ifndef configUSE_FAST_COOPERATIVE_YIELD
+	#define configUSE_FAST_COOPERATIVE_YIELD 0
+#endif
+
+#if( configUSE_FAST_COOPERATIVE_YIELD == 1 )
+	#if( configUSE_PREEMPTION != 0 )
+		#error configUSE_FAST_COOPERATIVE_YIELD can only be set to 1 when configUSE_PREEMPTION is 0.
+	#endif
+
+	extern void vPortYield( void );
+	#define portYIELD()				vPortYield()
+#else
+	#define portYIELD()				portYIELD_PENDSV()
+#endif
+
+#define portNVIC_INT_CTRL_REG		( * ( ( volatile uint32_t * ) 0xe000ed04 ) )
+#define portNVIC_PENDSVSET_BIT		( 1UL << 28UL )
+#define portEND_SWITCHING_ISR( xSwitchRequired ) if( xSwitchRequired != pdFALSE ) portYIELD_PENDSV()
+#define portYIELD_FROM_ISR( x ) portEND_SWITCHING_ISR( x )
+/*-----------------------------------------------------------*/
+
+/* Critical section management. */
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+#define portSET_INTERRUPT_MASK_FROM_ISR()		ulPortRaiseBASEPRI()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortSetBASEPRI(x)
+#define portDISABLE_INTERRUPTS()				vPortRaiseBASEPRI()
+#define portENABLE_INTERRUPTS()					vPortSetBASEPRI(0)
+#define portENTER_CRITICAL()					vPortEnterCritical()
+#define portEXIT_CRITICAL()						vPortExitCritical()
+
+/* Call sites of critical sections, for the trace macros. */
+#define portGET_RETURN_ADDRESS()				__builtin_return_address( 0 )
+
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site.  These are
+not necessary for to use this port.  They are defined so the common demo files
+(which build with all the ports) will build. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+/*-----------------------------------------------------------*/
+
+/* FPU context.  xPortPendSVHandler() saves and restores S16-S31 only for a
+task whose EXC_RETURN shows an FPU frame, which the hardware sets once the task
+has executed a floating point instruction.  S0-S15 and the FPSCR are stacked
+lazily by the hardware on exception entry, for tasks and interrupts alike, so
+integer only tasks pay nothing.
+
+With configUSE_TASK_FPU_DECLARATION set to 1, tasks that use the FPU are
+declared by OR'ing portTASK_USES_FPU_BIT into the priority passed to
+xTaskCreate(), and the kernel asserts if any other task acquires an FPU
+context.  portTASK_HAS_FPU_CONTEXT() reads the EXC_RETURN saved by
+xPortPendSVHandler() after R4-R11 at the top of a switched out task's stack. */
+#define portTASK_USES_FPU_BIT						( ( UBaseType_t ) 0x40000000UL )
+#define portTASK_HAS_FPU_CONTEXT( pxTopOfStack )	( ( ( ( ( const uint32_t * ) ( pxTopOfStack ) )[ 8 ] & 0x10UL ) == 0UL ) ? pdTRUE : pdFALSE )
+/*-----------------------------------------------------------*/
+
+/* MPU stack guard (configUSE_MPU_STACK_GUARD).  MPU region 7, the highest
+priority region, is a 32 byte no access region at the lowest aligned address
+of the running task's stack.  Its size and attributes are set once by
+xPortStartScheduler(), so moving it to the stack of the task switched in is a
+single store to RBAR, with the VALID bit selecting the region.  The exception
+return that ends the switch makes the new base take effect; in the thread mode
+switch of vPortYield() the old base may hold for a few instructions, which
+only delays the check. */
+#define portSTACK_GUARD_SIZE			( 32UL )
+#define portSTACK_GUARD_REGION			( 7UL )
+#define portMPU_RBAR_REG				( * ( ( volatile uint32_t * ) 0xe000ed9c ) )
+#define portMPU_RBAR_VALID_BIT			( 1UL << 4UL )
+
+#define portSTACK_GUARD_BASE( pxStack )	( ( ( uint32_t ) ( pxStack ) + ( portSTACK_GUARD_SIZE - 1UL ) ) & ~( portSTACK_GUARD_SIZE - 1UL ) )
+#define portSTACK_GUARD_END( pxStack )	( portSTACK_GUARD_BASE( pxStack ) + portSTACK_GUARD_SIZE )
+#define portSET_STACK_GUARD( pxStack )	portMPU_RBAR_REG = ( portSTACK_GUARD_BASE( pxStack ) | portMPU_RBAR_VALID_BIT | portSTACK_GUARD_REGION )
+
+/* Called from MemManage_Handler(): pdTRUE if the fault is an access to the
+guard, by the running task or by the exception entry stacking its context. */
+BaseType_t xPortIsStackGuardFault( void );
+/*-----------------------------------------------------------*/
+
+/* Run-time tick rate, with configUSE_DYNAMIC_TICK_RATE.  xPortSetTickRate()
+takes a rate that divides configTICK_RATE_HZ and returns pdFAIL otherwise, or
+if the SysTick reload would not fit 24 bits.  The next tick interrupt puts it
+into effect; ulPortGetTickRate() returns the rate in effect. */
+#if( configUSE_DYNAMIC_TICK_RATE == 1 )
+	BaseType_t xPortSetTickRate( uint32_t ulTickRateHz );
+	uint32_t ulPortGetTickRate( void );
+#endif
+/*-----------------------------------------------------------*/
+
+/* Idle sleep, with configUSE_IDLE_SLEEP.  A WFI with interrupts masked, so
+the wake-up can be timed on the SysTick before the interrupt that ended it is
+taken. */
+#if( configUSE_IDLE_SLEEP == 1 )
+	void vPortIdleSleep( void );
+	#define portIDLE_SLEEP() vPortIdleSleep()
+#endif
+/*-----------------------------------------------------------*/
+
+/* Tickless idle/low power functionality. */
+#ifndef portSUPPRESS_TICKS_AND_SLEEP
+	extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specific optimisations. */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+#endif
+
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Generic helper function. */
+	__attribute__( ( always_inline ) ) static inline uint8_t ucPortCountLeadingZeros( uint32_t ulBitmap )
+	{
+	uint8_t ucReturn;
+
+		__asm volatile ( "clz %0, %1" : "=r" ( ucReturn ) : "r" ( ulBitmap ) : "memory" );
+		return ucReturn;
+	}
+
+	/* The bit map is one 32-bit word.  tasks.c keeps more than 32 priorities,
+	such as the 56 of CMSIS-RTOS2, in two levels of such words. */
+	#define portREADY_BITMAP_BITS 32
+
+	/* Store/clear the ready priorities in a bit map. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	/*-----------------------------------------------------------*/
+
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31UL - ( uint32_t ) ucPortCountLeadingZeros( ( uxReadyPriorities ) ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+/*-----------------------------------------------------------*/
+
+#ifdef configASSERT
+	void vPortValidateInterruptPriority( void );
+	#define portASSERT_IF_INTERRUPT_PRIORITY_INVALID() 	vPortValidateInterruptPriority()
+#endif
+
+/* portNOP() is not required by this port. */
+#define portNOP()
+
+#define portINLINE	__inline
+
+/* Places a kernel function in SRAM (configUSE_KERNEL_RAM_FUNCTIONS).  The
+section is matched by the .RamFunc* pattern of the linker script, so the
+startup code copies it from flash together with .data.  Calls between flash
+and SRAM are out of BL range and go through veneers added by the linker. */
+#define portRAM_FUNCTION __attribute__(( section( ".RamFunc.kernel" ) ))
+
+/* Places zero initialised data in the .noinit section of the linker script,
+which is kept out of .bss so the startup code does not clear it. */
+#define portNOINIT_DATA __attribute__(( section( ".noinit" ) ))
+
+#ifndef portFORCE_INLINE
+	#define portFORCE_INLINE inline __attribute__(( always_inline))
+#endif
+
+portFORCE_INLINE static BaseType_t xPortIsInsideInterrupt( void )
+{
+uint32_t ulCurrentInterrupt;
+BaseType_t xReturn;
+
+	/* Obtain the number of the currently executing interrupt. */
+	__asm volatile( "mrs %0, ipsr" : "=r"( ulCurrentInterrupt ) :: "memory" );
+
+	if( ulCurrentInterrupt == 0 )
+	{
+		xReturn = pdFALSE;
+	}
+	else
+	{
+		xReturn = pdTRUE;
+	}
+
+	return xReturn;
+}
+
+/*-----------------------------------------------------------*/
+
+portFORCE_INLINE static void vPortRaiseBASEPRI( void )
+{
+uint32_t ulNewBASEPRI;
+
+	__asm volatile
+	(
+		"	mov %0, %1												\n"	\
+		"	msr basepri, %0											\n" \
+		"	isb														\n" \
+		"	dsb														\n" \
+		:"=r" (ulNewBASEPRI) : "i" ( configMAX_SYSCALL_INTERRUPT_PRIORITY ) : "memory"
+	);
+}
+
+/*-----------------------------------------------------------*/
+
+portFORCE_INLINE static uint32_t ulPortRaiseBASEPRI( void )
+{
+uint32_t ulOriginalBASEPRI, ulNewBASEPRI;
+
+	__asm volatile
+	(
+		"	mrs %0, basepri											\n" \
+		"	mov %1, %2												\n"	\
+		"	msr basepri, %1											\n" \
+		"	isb														\n" \
+		"	dsb														\n" \
+		:"=r" (ulOriginalBASEPRI), "=r" (ulNewBASEPRI) : "i" ( configMAX_SYSCALL_INTERRUPT_PRIORITY ) : "memory"
+	);
+
+	/* This return will not be reached but is necessary to prevent compiler
+	warnings. */
+	return ulOriginalBASEPRI;
+}
+/*-----------------------------------------------------------*/
+
+portFORCE_INLINE static void vPortSetBASEPRI( uint32_t ulNewMaskValue )
+{
+	__asm volatile
+	(
+		"	msr basepri, %0	" :: "r" ( ulNewMaskValue ) : "memory"
+	);
+}
+/*-----------------------------------------------------------*/
+
+/* Exclusive access, used by the mutex fast path (configUSE_MUTEX_FAST_PATH)
+and by atomic.h (configUSE_ATOMIC_EXCLUSIVE_ACCESS).  Exception entry and
+return clear the local monitor, so a store exclusive fails if the task was
+interrupted or switched out since the matching load. */
+portFORCE_INLINE static uint32_t ulPortLoadExclusive( volatile uint32_t *pulAddress )
+{
+uint32_t ulValue;
+
+	__asm volatile( "ldrex %0, [%1]" : "=r" ( ulValue ) : "r" ( pulAddress ) : "memory" );
+
+	return ulValue;
+}
+/*-----------------------------------------------------------*/
+
+portFORCE_INLINE static uint32_t ulPortStoreExclusive( volatile uint32_t *pulAddress, uint32_t ulValue )
+{
+uint32_t ulFailed;
+
+	__asm volatile( "strex %0, %2, [%1]" : "=&r" ( ulFailed ) : "r" ( pulAddress ), "r" ( ulValue ) : "memory" );
+
+	return ulFailed;
+}
+/*-----------------------------------------------------------*/
+
+#define portLOAD_EXCLUSIVE( pulAddress )				ulPortLoadExclusive( ( pulAddress ) )
+#define portSTORE_EXCLUSIVE( pulAddress, ulValue )		ulPortStoreExclusive( ( pulAddress ), ( ulValue ) )
+#define portCLEAR_EXCLUSIVE()							__asm volatile( "clrex" ::: "memory" )
+
+#define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
+#define portDATA_MEMORY_BARRIER() __asm volatile( "dmb" ::: "memory" )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
+
@@ -0,0 +1,1868 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that combines
+ * (coalescences) adjacent memory blocks as they are freed, and in so doing
+ * limits memory fragmentation.
+ *
+ * See heap_1.c, heap_2.c and heap_3.c for alternative implementations, and the
+ * memory management pages of http://www.FreeRTOS.org for more information.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* heap_tlsf.c replaces this file when USE_FreeRTOS_HEAP_TLSF is defined. */
+#if !defined( USE_FreeRTOS_HEAP_TLSF )
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	/* For vPortHeapReport(). */
+	#include <stdarg.h>
+	#include <stdio.h>
+#endif
+
+/* Without dynamic allocation there is no heap at all: ucHeap and the
+allocator are not built, so a project can leave this file in its build and
+still have every byte of kernel RAM fixed at link time.  Only the stubs at the
+end of the file remain. */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+/* Block sizes must not get too small. */
+#define heapMINIMUM_BLOCK_SIZE	( ( size_t ) ( xHeapStructSize << 1 ) )
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE		( ( size_t ) 8 )
+
+/* Passed to prvHeapMalloc() when the block can come from any region. */
+#define heapANY_REGION			( ( BaseType_t ) -1 )
+
+/* A plain static heap array is cleared by the C startup code, and first fit
+hands blocks out from the lowest address up, so for a long time the top of the
+heap has never been written.  pvPortCalloc() then only clears the part of a
+block below the highest byte ever handed out or written into a header. */
+#if( ( configUSE_HEAP_REGIONS == 0 ) && ( configAPPLICATION_ALLOCATED_HEAP == 0 ) && ( configHEAP_NOINIT == 0 ) )
+	#define heapZEROED_AT_BOOT		1
+#else
+	#define heapZEROED_AT_BOOT		0
+#endif
+
+/* Allocate the memory for the heap. */
+#if( configUSE_HEAP_REGIONS == 1 )
+	/* The heap is made of the regions given by the application instead, as in
+	heap_5.c.  They share one address ordered free list: each region ends with
+	a zero size marker that links to the first block of the next region, and
+	as no block is ever adjacent to a block of another region, blocks are
+	never merged across regions.  The bounds of each region are kept so the
+	first fit search can be restricted to one of them. */
+	typedef struct A_HEAP_REGION_BOUNDS
+	{
+		uint8_t *pucStart;		/*<< First byte of the region, aligned. */
+		uint8_t *pucEnd;		/*<< The region's end marker. */
+	} HeapRegionBounds_t;
+
+	static HeapRegionBounds_t xRegionBounds[ configHEAP_MAX_REGIONS ];
+	static BaseType_t xRegionCount = 0;
+	static size_t xHeapRegionsBytes = 0;	/*<< Free bytes once defined, for vPortHeapReport(). */
+
+	#define heapTOTAL_BYTES		xHeapRegionsBytes
+#else
+	#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+		/* The application writer has already defined the array used for the RTOS
+		heap - probably so it can be placed in a special segment or address. */
+		extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+	#elif( configHEAP_NOINIT == 1 )
+		/* Not cleared at boot: prvHeapInit() writes all the heap needs. */
+		static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ] portNOINIT_DATA;
+	#else
+		static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+	#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+	#define heapTOTAL_BYTES		( ( size_t ) configTOTAL_HEAP_SIZE )
+#endif /* configUSE_HEAP_REGIONS */
+
+/* Define the linked list structure.  This is used to link free blocks in order
+of their memory address. */
+typedef struct A_BLOCK_LINK
+{
+	struct A_BLOCK_LINK *pxNextFreeBlock;	/*<< The next free block in the list. */
+	size_t xBlockSize;						/*<< The size of the free block. */
+	#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+		uint16_t usCaller;					/*<< Index into xHeapCallers[] of the allocating caller. */
+		uint16_t usSizeBucket;				/*<< Histogram bucket of the requested size. */
+	#endif
+} BlockLink_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Inserts a block of memory that is being freed into the correct position in
+ * the list of free memory blocks.  The block being freed will be merged with
+ * the block in front it and/or the block behind it if the memory blocks are
+ * adjacent to each other.
+ */
+static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert );
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void );
+
+/*
+ * The first fit allocator itself.  pvPortMalloc() and vPortFree() call these
+ * directly, or via the slab layer when configUSE_HEAP_SLABS is 1.  xRegion is
+ * heapANY_REGION, or the only region the block may come from.
+ */
+static void *prvHeapMalloc( size_t xWantedSize, BaseType_t xRegion );
+static void prvHeapFree( void *pv );
+
+/*
+ * pvPortMalloc() and vPortFree() without the instrumentation, so
+ * pvPortRealloc() and pvPortCalloc() can charge their own caller.
+ */
+static void *prvMalloc( size_t xWantedSize );
+static void prvFree( void *pv );
+
+/*
+ * Makes the allocated block pxLink hold xWantedSize bytes without moving it:
+ * a slab object if it already does, a first fit block by giving its tail back
+ * or by taking in the free block just above it.  pdFALSE if it cannot.
+ */
+static BaseType_t prvResizeInPlace( BlockLink_t *pxLink, size_t xWantedSize );
+
+#if( heapZEROED_AT_BOOT == 1 )
+
+	/*
+	 * Raises the line below which the heap may have been written to pucEnd.
+	 * Called with the scheduler suspended.
+	 */
+	static void prvMarkWritten( const uint8_t *pucEnd );
+
+#else
+
+	/* The heap is not known to be clear to begin with. */
+	#define prvMarkWritten( pucEnd )	( ( void ) ( pucEnd ) )
+
+#endif /* heapZEROED_AT_BOOT */
+
+#if( configUSE_HEAP_REGIONS == 1 )
+
+	/*
+	 * Builds the free list from an array of regions, as vPortDefineHeapRegions()
+	 * of heap_5.c does.  Called with the scheduler suspended, or before it
+	 * starts.
+	 */
+	static void prvDefineHeapRegions( const HeapRegion_t * const pxHeapRegions );
+
+	/*
+	 * pdTRUE if pxBlock lies in region xRegion, or xRegion is heapANY_REGION.
+	 */
+	static BaseType_t prvBlockIsInRegion( const BlockLink_t *pxBlock, BaseType_t xRegion );
+
+#else
+
+	/* There is only one region. */
+	#define prvBlockIsInRegion( pxBlock, xRegion )	( ( ( void ) ( xRegion ) ), pdTRUE )
+
+#endif /* configUSE_HEAP_REGIONS */
+
+/*-----------------------------------------------------------*/
+
+/* The size of the structure placed at the beginning of each allocated memory
+block must by correctly byte aligned. */
+static const size_t xHeapStructSize	= ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* Create a couple of list links to mark the start and end of the list. */
+static BlockLink_t xStart, *pxEnd = NULL;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+number of free bytes remaining, but says nothing about fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+#if( heapZEROED_AT_BOOT == 1 )
+	/* No byte from here to the end of the heap has been written since boot.
+	NULL until the heap is initialised. */
+	static uint8_t *pucHeapUntouched = NULL;
+#endif
+
+/* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize
+member of an BlockLink_t structure is set then the block belongs to the
+application.  When the bit is free the block is still part of the free heap
+space. */
+static size_t xBlockAllocatedBit = 0;
+
+#if( configUSE_HEAP_SLABS == 1 )
+
+	/* Kernel objects are allocated and freed far more often than anything else
+	once tasks are created and deleted at run time, and each size is always the
+	same.  Requests of exactly one of the sizes below are therefore served from
+	a per size free list of objects that are carved from the heap a slab at a
+	time and never given back, so they cannot fragment it.  Everything else
+	(stacks, queue storage, application buffers) still uses the first fit
+	allocator.
+
+	Slab objects keep a header the size of BlockLink_t in front of them so
+	vPortFree() can tell the two apart.  The second word takes the place of
+	xBlockSize and holds one of the markers below, which never have
+	xBlockAllocatedBit set, so cannot be mistaken for a heap_4 block.  The first
+	word points to the next free object while the object is free, or to the
+	owning class while it is in use. */
+	#define heapSLAB_OBJECT_FREE		( ( size_t ) 0x51AB0000UL )
+	#define heapSLAB_OBJECT_IN_USE		( ( size_t ) 0x51AB0001UL )
+
+	#define heapALIGN_UP( x )			( ( ( size_t ) ( x ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+	#define heapSLAB_STRIDE( x )		( heapALIGN_UP( sizeof( BlockLink_t ) ) + heapALIGN_UP( x ) )
+
+	typedef struct A_SLAB_OBJECT
+	{
+		void *pvLink;					/*<< Next free object, or the owning class while in use. */
+		size_t xMarker;					/*<< heapSLAB_OBJECT_FREE or heapSLAB_OBJECT_IN_USE. */
+		#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+			uint16_t usCaller;			/*<< As BlockLink_t. */
+			uint16_t usSizeBucket;		/*<< As BlockLink_t. */
+		#endif
+	} SlabObject_t;
+
+	typedef struct A_SLAB_CLASS
+	{
+		size_t xObjectSize;				/*<< The exact request size this class serves. */
+		size_t xStride;					/*<< Header plus object, aligned. */
+		SlabObject_t *pxFreeList;		/*<< Free objects, most recently freed first. */
+		size_t xSlabs;					/*<< Slabs carved from the heap. */
+		size_t xObjects;				/*<< Objects carved, free or in use. */
+		size_t xObjectsInUse;
+		size_t xMaxObjectsInUse;
+	} SlabClass_t;
+
+	#define heapSLAB_CLASS( xSize )	{ ( xSize ), heapSLAB_STRIDE( xSize ), NULL, 0, 0, 0, 0 }
+
+	/* The Static..._t structures are the same size as the private TCB_t,
+	Queue_t, Timer_t and EventGroup_t.  Semaphores and mutexes are queues with
+	no storage area, so use the queue class. */
+	static SlabClass_t xSlabClasses[] =
+	{
+		heapSLAB_CLASS( sizeof( StaticTask_t ) ),
+		heapSLAB_CLASS( sizeof( StaticQueue_t ) ),
+		#if( configUSE_TIMERS == 1 )
+			heapSLAB_CLASS( sizeof( StaticTimer_t ) ),
+		#endif
+		heapSLAB_CLASS( sizeof( StaticEventGroup_t ) )
+	};
+
+	#define heapNUM_SLAB_CLASSES		( sizeof( xSlabClasses ) / sizeof( xSlabClasses[ 0 ] ) )
+
+	/*
+	 * Returns the class that serves requests of xWantedSize bytes, or NULL if
+	 * the request should go to the first fit allocator.
+	 */
+	static SlabClass_t *prvSlabClassForSize( size_t xWantedSize );
+
+	/*
+	 * Takes an object from pxClass, carving a new slab from the heap first if
+	 * the class has none free.  Called with the scheduler suspended.
+	 */
+	static void *prvSlabMalloc( SlabClass_t *pxClass );
+
+#endif /* configUSE_HEAP_SLABS */
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	/* The return address of the pvPortMalloc() call, so the report can say
+	where the heap went.  Objects allocated by the kernel on behalf of the
+	application (TCBs, stacks, queues...) are charged to the kernel function
+	that allocated them. */
+	#ifndef configHEAP_CALLER_ADDRESS
+		#if defined( __GNUC__ )
+			#define configHEAP_CALLER_ADDRESS()	__builtin_return_address( 0 )
+		#else
+			#define configHEAP_CALLER_ADDRESS()	NULL
+		#endif
+	#endif
+
+	/* Bucket n of the histogram counts requests of up to
+	heapHISTOGRAM_SMALLEST_BUCKET << n bytes. */
+	#define heapHISTOGRAM_SMALLEST_BUCKET	( ( size_t ) 16 )
+
+	/* The last entry of xHeapCallers[] collects every caller that does not fit
+	in the others. */
+	#define heapOTHER_CALLERS				( configHEAP_INSTRUMENTATION_CALLERS - 1 )
+
+	static HeapInstrumentation_t xHeapInstrumentation;
+
+	/*
+	 * Charges a successful allocation to its size bucket and caller and stores
+	 * both in the block header for vPortFree(), or counts a failed one.
+	 */
+	static void prvRecordMalloc( void *pv, size_t xWantedSize, void *pvCaller );
+
+	/*
+	 * Reverses prvRecordMalloc() for a block that is about to be freed.
+	 */
+	static void prvRecordFree( void *pv );
+
+	/*
+	 * The bytes a live block takes from the heap, header and padding included.
+	 */
+	static size_t prvBlockBytes( const BlockLink_t *pxLink );
+
+	/*
+	 * Charges a block pvPortRealloc() resized or moved to the caller and size
+	 * bucket of the original allocation, which took xOldBytes, or counts a
+	 * failed resize if pv is NULL.
+	 */
+	static void prvRecordRealloc( void *pv, uint16_t usCaller, uint16_t usSizeBucket, size_t xOldBytes );
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+void *pvReturn;
+
+	pvReturn = prvMalloc( xWantedSize );
+
+	#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	{
+		/* Must be evaluated here, in the function the application called. */
+		prvRecordMalloc( pvReturn, xWantedSize, configHEAP_CALLER_ADDRESS() );
+	}
+	#endif
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+	#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	{
+		/* While the header is still intact. */
+		prvRecordFree( pv );
+	}
+	#endif
+
+	prvFree( pv );
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortRealloc( void *pv, size_t xWantedSize )
+{
+void *pvReturn = NULL;
+BlockLink_t *pxLink;
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	uint16_t usCaller, usSizeBucket;
+	size_t xOldBytes;
+#endif
+
+	if( pv == NULL )
+	{
+		pvReturn = prvMalloc( xWantedSize );
+
+		#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+		{
+			prvRecordMalloc( pvReturn, xWantedSize, configHEAP_CALLER_ADDRESS() );
+		}
+		#endif
+	}
+	else if( xWantedSize == 0 )
+	{
+		vPortFree( pv );
+	}
+	else
+	{
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxLink = ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
+
+		#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+		{
+			/* The block keeps the caller that first allocated it. */
+			usCaller = pxLink->usCaller;
+			usSizeBucket = pxLink->usSizeBucket;
+			xOldBytes = prvBlockBytes( pxLink );
+		}
+		#endif
+
+		if( prvResizeInPlace( pxLink, xWantedSize ) != pdFALSE )
+		{
+			pvReturn = pv;
+		}
+		else
+		{
+			/* Last resort.  A failed resize leaves the block as it was, as
+			realloc() does. */
+			pvReturn = prvMalloc( xWantedSize );
+
+			if( pvReturn != NULL )
+			{
+				/* The block could not hold xWantedSize, so is smaller. */
+				( void ) memcpy( pvReturn, pv, xPortGetAllocationSize( pv ) );
+				prvFree( pv );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+		{
+			prvRecordRealloc( pvReturn, usCaller, usSizeBucket, xOldBytes );
+		}
+		#endif
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortCalloc( size_t xNum, size_t xSize )
+{
+void *pvReturn = NULL;
+size_t xWantedSize, xToClear;
+#if( heapZEROED_AT_BOOT == 1 )
+	const uint8_t *pucUntouched;
+#endif
+
+	if( ( xSize == 0 ) || ( xNum <= ( ( ( size_t ) -1 ) / xSize ) ) )
+	{
+		xWantedSize = xNum * xSize;
+		xToClear = xWantedSize;
+
+		#if( heapZEROED_AT_BOOT == 1 )
+		{
+			/* The line as it was just before the block was carved: the part of
+			the block above it is still clear.  The allocation nests its own
+			suspension in this one. */
+			vTaskSuspendAll();
+			{
+				pucUntouched = pucHeapUntouched;
+				pvReturn = prvMalloc( xWantedSize );
+			}
+			( void ) xTaskResumeAll();
+
+			if( pvReturn != NULL )
+			{
+				/* NULL if this was the first allocation, when nothing but
+				headers had been written. */
+				if( ( pucUntouched == NULL ) || ( pucUntouched <= ( const uint8_t * ) pvReturn ) )
+				{
+					xToClear = 0;
+				}
+				else if( ( size_t ) ( pucUntouched - ( const uint8_t * ) pvReturn ) < xWantedSize )
+				{
+					xToClear = ( size_t ) ( pucUntouched - ( const uint8_t * ) pvReturn );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
+		{
+			pvReturn = prvMalloc( xWantedSize );
+		}
+		#endif /* heapZEROED_AT_BOOT */
+
+		if( pvReturn != NULL )
+		{
+			( void ) memset( pvReturn, 0, xToClear );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+		{
+			prvRecordMalloc( pvReturn, xWantedSize, configHEAP_CALLER_ADDRESS() );
+		}
+		#endif
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvMalloc( size_t xWantedSize )
+{
+void *pvReturn;
+
+#if( configUSE_HEAP_SLABS == 1 )
+	SlabClass_t *pxClass;
+
+	pxClass = prvSlabClassForSize( xWantedSize );
+
+	if( pxClass != NULL )
+	{
+		vTaskSuspendAll();
+		{
+			pvReturn = prvSlabMalloc( pxClass );
+			traceMALLOC( pvReturn, xWantedSize );
+		}
+		( void ) xTaskResumeAll();
+
+		/* prvSlabMalloc() only fails if prvHeapMalloc() did, which has already
+		called the malloc failed hook. */
+	}
+	else
+	{
+		pvReturn = prvHeapMalloc( xWantedSize, heapANY_REGION );
+	}
+#else
+	pvReturn = prvHeapMalloc( xWantedSize, heapANY_REGION );
+#endif /* configUSE_HEAP_SLABS */
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFree( void *pv )
+{
+#if( configUSE_HEAP_SLABS == 1 )
+	SlabObject_t *pxObject;
+	SlabClass_t *pxClass;
+#endif
+
+#if( configUSE_HEAP_SLABS == 1 )
+	if( pv != NULL )
+	{
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxObject = ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
+
+		/* A second free of a slab object. */
+		configASSERT( pxObject->xMarker != heapSLAB_OBJECT_FREE );
+
+		if( pxObject->xMarker == heapSLAB_OBJECT_IN_USE )
+		{
+			pxClass = ( SlabClass_t * ) pxObject->pvLink;
+			configASSERT( ( pxClass >= &xSlabClasses[ 0 ] ) && ( pxClass < &xSlabClasses[ heapNUM_SLAB_CLASSES ] ) );
+
+			vTaskSuspendAll();
+			{
+				pxObject->xMarker = heapSLAB_OBJECT_FREE;
+				pxObject->pvLink = pxClass->pxFreeList;
+				pxClass->pxFreeList = pxObject;
+				pxClass->xObjectsInUse--;
+				xNumberOfSuccessfulFrees++;
+				traceFREE( pv, pxClass->xObjectSize );
+			}
+			( void ) xTaskResumeAll();
+
+			return;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+#endif /* configUSE_HEAP_SLABS */
+
+	prvHeapFree( pv );
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_REGIONS == 1 )
+
+	void *pvPortMallocRegion( size_t xWantedSize, BaseType_t xRegion )
+	{
+	void *pvReturn = NULL;
+
+		/* Slab objects come from any region, so never from here. */
+		if( xRegion >= ( BaseType_t ) 0 )
+		{
+			pvReturn = prvHeapMalloc( xWantedSize, xRegion );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+		{
+			prvRecordMalloc( pvReturn, xWantedSize, configHEAP_CALLER_ADDRESS() );
+		}
+		#endif
+
+		return pvReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	size_t xPortGetFreeHeapSizeRegion( BaseType_t xRegion )
+	{
+	BlockLink_t *pxBlock;
+	size_t xFree = 0;
+
+		vTaskSuspendAll();
+		{
+			if( ( pxEnd != NULL ) && ( xRegion >= ( BaseType_t ) 0 ) && ( xRegion < xRegionCount ) )
+			{
+				for( pxBlock = xStart.pxNextFreeBlock; pxBlock != pxEnd; pxBlock = pxBlock->pxNextFreeBlock )
+				{
+					if( prvBlockIsInRegion( pxBlock, xRegion ) != pdFALSE )
+					{
+						xFree += pxBlock->xBlockSize;
+					}
+				}
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return xFree;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+	{
+		/* Only once, before the first allocation. */
+		configASSERT( pxEnd == NULL );
+
+		vTaskSuspendAll();
+		{
+			prvDefineHeapRegions( pxHeapRegions );
+		}
+		( void ) xTaskResumeAll();
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_REGIONS */
+
+static void *prvHeapMalloc( size_t xWantedSize, BaseType_t xRegion )
+{
+BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc then the heap will require
+		initialisation to setup the list of free blocks. */
+		if( pxEnd == NULL )
+		{
+			prvHeapInit();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Check the requested block size is not so large that the top bit is
+		set.  The top bit of the block size member of the BlockLink_t structure
+		is used to determine who owns the block - the application or the
+		kernel, so it must be free. */
+		if( ( xWantedSize & xBlockAllocatedBit ) == 0 )
+		{
+			/* The wanted size is increased so it can contain a BlockLink_t
+			structure in addition to the requested amount of bytes. */
+			if( xWantedSize > 0 )
+			{
+				xWantedSize += xHeapStructSize;
+
+				/* Ensure that blocks are always aligned to the required number
+				of bytes. */
+				if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+				{
+					/* Byte alignment required. */
+					xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+					configASSERT( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) == 0 );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+			{
+				/* Traverse the list from the start	(lowest address) block until
+				one	of adequate size is found, in the wanted region. */
+				pxPreviousBlock = &xStart;
+				pxBlock = xStart.pxNextFreeBlock;
+				while( ( ( pxBlock->xBlockSize < xWantedSize ) || ( prvBlockIsInRegion( pxBlock, xRegion ) == pdFALSE ) ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+				{
+					pxPreviousBlock = pxBlock;
+					pxBlock = pxBlock->pxNextFreeBlock;
+				}
+
+				/* If the end marker was reached then a block of adequate size
+				was	not found. */
+				if( pxBlock != pxEnd )
+				{
+					/* Return the memory space pointed to - jumping over the
+					BlockLink_t structure at its start. */
+					pvReturn = ( void * ) ( ( ( uint8_t * ) pxPreviousBlock->pxNextFreeBlock ) + xHeapStructSize );
+
+					/* This block is being returned for use so must be taken out
+					of the list of free blocks. */
+					pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+					/* If the block is larger than required it can be split into
+					two. */
+					if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+					{
+						/* This block is to be split into two.  Create a new
+						block following the number of bytes requested. The void
+						cast is used to prevent byte alignment warnings from the
+						compiler. */
+						pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+						configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+						/* Calculate the sizes of two blocks split from the
+						single block. */
+						pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+						pxBlock->xBlockSize = xWantedSize;
+
+						/* Insert the new block into the list of free blocks. */
+						prvInsertBlockIntoFreeList( pxNewBlockLink );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+					/* The application may write all of the block, and a split
+					has written the header that follows it. */
+					prvMarkWritten( ( ( uint8_t * ) pxBlock ) + pxBlock->xBlockSize + xHeapStructSize );
+
+					if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+					{
+						xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* The block is being returned - it is allocated and owned
+					by the application and has no "next" block. */
+					pxBlock->xBlockSize |= xBlockAllocatedBit;
+					pxBlock->pxNextFreeBlock = NULL;
+					xNumberOfSuccessfulAllocations++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+BlockLink_t *pxLink;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have an BlockLink_t structure immediately
+		before it. */
+		puc -= xHeapStructSize;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxLink = ( void * ) puc;
+
+		/* Check the block is actually allocated. */
+		configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+		configASSERT( pxLink->pxNextFreeBlock == NULL );
+
+		if( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 )
+		{
+			if( pxLink->pxNextFreeBlock == NULL )
+			{
+				/* The block is being returned to the heap - it is no longer
+				allocated. */
+				pxLink->xBlockSize &= ~xBlockAllocatedBit;
+
+				vTaskSuspendAll();
+				{
+					/* Add this block to the list of free blocks. */
+					xFreeBytesRemaining += pxLink->xBlockSize;
+					traceFREE( pv, pxLink->xBlockSize );
+					prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
+					xNumberOfSuccessfulFrees++;
+				}
+				( void ) xTaskResumeAll();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvResizeInPlace( BlockLink_t *pxLink, size_t xWantedSize )
+{
+BlockLink_t *pxPreviousBlock, *pxNextBlock, *pxNewBlockLink;
+size_t xBlockSize;
+BaseType_t xReturn = pdFALSE;
+
+	#if( configUSE_HEAP_SLABS == 1 )
+	{
+		/* A slab object cannot change size. */
+		if( ( ( SlabObject_t * ) pxLink )->xMarker == heapSLAB_OBJECT_IN_USE )
+		{
+			return ( xWantedSize <= ( ( SlabClass_t * ) ( ( SlabObject_t * ) pxLink )->pvLink )->xObjectSize ) ? pdTRUE : pdFALSE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	/* Check the block is actually allocated. */
+	configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+	configASSERT( pxLink->pxNextFreeBlock == NULL );
+
+	if( ( xWantedSize & xBlockAllocatedBit ) != 0 )
+	{
+		return pdFALSE;
+	}
+
+	/* The block size prvHeapMalloc() would have given the request. */
+	xWantedSize += xHeapStructSize;
+
+	if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+	{
+		xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	vTaskSuspendAll();
+	{
+		xBlockSize = pxLink->xBlockSize & ~xBlockAllocatedBit;
+
+		if( xWantedSize <= xBlockSize )
+		{
+			/* Shrinking: the tail goes back to the free list if it is large
+			enough to be a block, merged with a free block just above it. */
+			if( ( xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+			{
+				pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxLink ) + xWantedSize );
+				pxNewBlockLink->xBlockSize = xBlockSize - xWantedSize;
+				pxLink->xBlockSize = xWantedSize | xBlockAllocatedBit;
+
+				xFreeBytesRemaining += pxNewBlockLink->xBlockSize;
+				prvInsertBlockIntoFreeList( pxNewBlockLink );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			/* Growing: only into a free block that starts where this one
+			ends.  The free list is in address order, so that is the first free
+			block at or above the end of this one, if it is free at all.  End
+			markers have a size of 0, so are never taken. */
+			pxNextBlock = ( void * ) ( ( ( uint8_t * ) pxLink ) + xBlockSize );
+
+			for( pxPreviousBlock = &xStart; pxPreviousBlock->pxNextFreeBlock < pxNextBlock; pxPreviousBlock = pxPreviousBlock->pxNextFreeBlock )
+			{
+				/* Nothing to do here, just iterate to the right position. */
+			}
+
+			if( ( pxPreviousBlock->pxNextFreeBlock == pxNextBlock ) && ( pxNextBlock->xBlockSize != 0 ) && ( ( xBlockSize + pxNextBlock->xBlockSize ) >= xWantedSize ) )
+			{
+				/* Take the whole free block out of the list first, as the
+				split below may write over its header. */
+				pxPreviousBlock->pxNextFreeBlock = pxNextBlock->pxNextFreeBlock;
+				xFreeBytesRemaining -= pxNextBlock->xBlockSize;
+				xBlockSize += pxNextBlock->xBlockSize;
+
+				if( ( xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+				{
+					/* The rest stays free, in the list where the free block
+					was.  That block was merged with anything free above it,
+					so the rest cannot be merged either. */
+					pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxLink ) + xWantedSize );
+					pxNewBlockLink->xBlockSize = xBlockSize - xWantedSize;
+					pxNewBlockLink->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
+					pxPreviousBlock->pxNextFreeBlock = pxNewBlockLink;
+
+					xFreeBytesRemaining += pxNewBlockLink->xBlockSize;
+					xBlockSize = xWantedSize;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxLink->xBlockSize = xBlockSize | xBlockAllocatedBit;
+				prvMarkWritten( ( ( uint8_t * ) pxLink ) + xBlockSize + xHeapStructSize );
+
+				if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+				{
+					xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if( heapZEROED_AT_BOOT == 1 )
+
+	static void prvMarkWritten( const uint8_t *pucEnd )
+	{
+		if( pucEnd > pucHeapUntouched )
+		{
+			pucHeapUntouched = ( uint8_t * ) pucEnd;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* heapZEROED_AT_BOOT */
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetAllocationSize( void *pv )
+{
+const BlockLink_t *pxLink;
+size_t xSize = 0;
+
+	if( pv != NULL )
+	{
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxLink = ( const void * ) ( ( ( const uint8_t * ) pv ) - xHeapStructSize );
+
+	#if( configUSE_HEAP_SLABS == 1 )
+		/* A slab object holds exactly the size of its class. */
+		if( ( ( const SlabObject_t * ) pxLink )->xMarker == heapSLAB_OBJECT_IN_USE )
+		{
+			xSize = ( ( const SlabClass_t * ) ( ( const SlabObject_t * ) pxLink )->pvLink )->xObjectSize;
+		}
+		else
+	#endif /* configUSE_HEAP_SLABS */
+		{
+			configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+			xSize = ( pxLink->xBlockSize & ~xBlockAllocatedBit ) - xHeapStructSize;
+		}
+	}
+
+	return xSize;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_REGIONS == 1 )
+
+static void prvHeapInit( void )
+{
+const HeapRegion_t *pxHeapRegions = NULL;
+
+	vApplicationGetHeapRegions( &pxHeapRegions );
+	configASSERT( pxHeapRegions != NULL );
+	prvDefineHeapRegions( pxHeapRegions );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+{
+BlockLink_t *pxFirstFreeBlockInRegion, *pxPreviousFreeBlock = NULL;
+const HeapRegion_t *pxHeapRegion;
+size_t xAlignedHeap, xTotalRegionSize, xTotalHeapSize = 0;
+size_t xAddress;
+BaseType_t xDefinedRegions = 0;
+
+	pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+
+	while( pxHeapRegion->xSizeInBytes > 0 )
+	{
+		configASSERT( xDefinedRegions < ( BaseType_t ) configHEAP_MAX_REGIONS );
+
+		xTotalRegionSize = pxHeapRegion->xSizeInBytes;
+
+		/* Ensure the heap region starts on a correctly aligned boundary. */
+		xAddress = ( size_t ) pxHeapRegion->pucStartAddress;
+		if( ( xAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+		{
+			xAddress += ( portBYTE_ALIGNMENT - 1 );
+			xAddress &= ~portBYTE_ALIGNMENT_MASK;
+
+			/* Adjust the size for the bytes lost to alignment. */
+			xTotalRegionSize -= xAddress - ( size_t ) pxHeapRegion->pucStartAddress;
+		}
+
+		xAlignedHeap = xAddress;
+
+		if( xDefinedRegions == 0 )
+		{
+			/* xStart is used to hold a pointer to the first item in the list
+			of free blocks. */
+			xStart.pxNextFreeBlock = ( BlockLink_t * ) xAlignedHeap;
+			xStart.xBlockSize = ( size_t ) 0;
+		}
+		else
+		{
+			/* Regions must be given in address order. */
+			configASSERT( xAddress > ( size_t ) pxEnd );
+		}
+
+		/* pxEnd is used to mark the end of the list of free blocks and is
+		inserted at the end of the region space. */
+		xAddress = xAlignedHeap + xTotalRegionSize;
+		xAddress -= xHeapStructSize;
+		xAddress &= ~portBYTE_ALIGNMENT_MASK;
+		pxEnd = ( BlockLink_t * ) xAddress;
+		pxEnd->xBlockSize = 0;
+		pxEnd->pxNextFreeBlock = NULL;
+
+		/* To start with there is a single free block in this region that is
+		sized to take up the entire heap region minus the space taken by the
+		free block structure. */
+		pxFirstFreeBlockInRegion = ( BlockLink_t * ) xAlignedHeap;
+		pxFirstFreeBlockInRegion->xBlockSize = xAddress - ( size_t ) pxFirstFreeBlockInRegion;
+		pxFirstFreeBlockInRegion->pxNextFreeBlock = pxEnd;
+
+		/* If this is not the first region that makes up the entire heap space
+		then link the previous region to this region. */
+		if( pxPreviousFreeBlock != NULL )
+		{
+			pxPreviousFreeBlock->pxNextFreeBlock = pxFirstFreeBlockInRegion;
+		}
+
+		xRegionBounds[ xDefinedRegions ].pucStart = ( uint8_t * ) xAlignedHeap;
+		xRegionBounds[ xDefinedRegions ].pucEnd = ( uint8_t * ) pxEnd;
+
+		xTotalHeapSize += pxFirstFreeBlockInRegion->xBlockSize;
+
+		/* Move onto the next HeapRegion_t structure. */
+		pxPreviousFreeBlock = pxEnd;
+		xDefinedRegions++;
+		pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+	}
+
+	/* Check something was actually defined before it is accessed. */
+	configASSERT( xTotalHeapSize );
+
+	xRegionCount = xDefinedRegions;
+	xHeapRegionsBytes = xTotalHeapSize;
+	xMinimumEverFreeBytesRemaining = xTotalHeapSize;
+	xFreeBytesRemaining = xTotalHeapSize;
+
+	/* Work out the position of the top bit in a size_t variable. */
+	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvBlockIsInRegion( const BlockLink_t *pxBlock, BaseType_t xRegion )
+{
+const uint8_t *pucBlock = ( const uint8_t * ) pxBlock;
+BaseType_t xReturn = pdTRUE;
+
+	if( xRegion != heapANY_REGION )
+	{
+		/* Free blocks never span regions, so their start is enough. */
+		xReturn = ( ( xRegion < xRegionCount )
+				&& ( pucBlock >= xRegionBounds[ xRegion ].pucStart )
+				&& ( pucBlock < xRegionBounds[ xRegion ].pucEnd ) ) ? pdTRUE : pdFALSE;
+	}
+
+	return xReturn;
+}
+
+#else /* configUSE_HEAP_REGIONS */
+
+static void prvHeapInit( void )
+{
+BlockLink_t *pxFirstFreeBlock;
+uint8_t *pucAlignedHeap;
+size_t uxAddress;
+size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+	/* Ensure the heap starts on a correctly aligned boundary. */
+	uxAddress = ( size_t ) ucHeap;
+
+	if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+	{
+		uxAddress += ( portBYTE_ALIGNMENT - 1 );
+		uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		xTotalHeapSize -= uxAddress - ( size_t ) ucHeap;
+	}
+
+	pucAlignedHeap = ( uint8_t * ) uxAddress;
+
+	/* xStart is used to hold a pointer to the first item in the list of free
+	blocks.  The void cast is used to prevent compiler warnings. */
+	xStart.pxNextFreeBlock = ( void * ) pucAlignedHeap;
+	xStart.xBlockSize = ( size_t ) 0;
+
+	/* pxEnd is used to mark the end of the list of free blocks and is inserted
+	at the end of the heap space. */
+	uxAddress = ( ( size_t ) pucAlignedHeap ) + xTotalHeapSize;
+	uxAddress -= xHeapStructSize;
+	uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	pxEnd = ( void * ) uxAddress;
+	pxEnd->xBlockSize = 0;
+	pxEnd->pxNextFreeBlock = NULL;
+
+	/* To start with there is a single free block that is sized to take up the
+	entire heap space, minus the space taken by pxEnd. */
+	pxFirstFreeBlock = ( void * ) pucAlignedHeap;
+	pxFirstFreeBlock->xBlockSize = uxAddress - ( size_t ) pxFirstFreeBlock;
+	pxFirstFreeBlock->pxNextFreeBlock = pxEnd;
+
+	/* Only one block exists - and it covers the entire usable heap space. */
+	xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+	xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+
+	#if( heapZEROED_AT_BOOT == 1 )
+	{
+		/* Only the header of the first block has been written below pxEnd. */
+		pucHeapUntouched = pucAlignedHeap + xHeapStructSize;
+	}
+	#endif
+
+	/* Work out the position of the top bit in a size_t variable. */
+	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+}
+
+#endif /* configUSE_HEAP_REGIONS */
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert )
+{
+BlockLink_t *pxIterator;
+uint8_t *puc;
+
+	/* Iterate through the list until a block is found that has a higher address
+	than the block being inserted. */
+	for( pxIterator = &xStart; pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
+	{
+		/* Nothing to do here, just iterate to the right position. */
+	}
+
+	/* Do the block being inserted, and the block it is being inserted after
+	make a contiguous block of memory? */
+	puc = ( uint8_t * ) pxIterator;
+	if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
+	{
+		pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+		pxBlockToInsert = pxIterator;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Do the block being inserted, and the block it is being inserted before
+	make a contiguous block of memory? */
+	puc = ( uint8_t * ) pxBlockToInsert;
+	if( ( puc + pxBlockToInsert->xBlockSize ) == ( uint8_t * ) pxIterator->pxNextFreeBlock )
+	{
+		if( pxIterator->pxNextFreeBlock != pxEnd )
+		{
+			/* Form one big block from the two blocks. */
+			pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
+			pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
+		}
+		else
+		{
+			pxBlockToInsert->pxNextFreeBlock = pxEnd;
+		}
+	}
+	else
+	{
+		pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+	}
+
+	/* If the block being inserted plugged a gab, so was merged with the block
+	before and the block after, then it's pxNextFreeBlock pointer will have
+	already been set, and should not be set here as that would make it point
+	to itself. */
+	if( pxIterator != pxBlockToInsert )
+	{
+		pxIterator->pxNextFreeBlock = pxBlockToInsert;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+BlockLink_t *pxBlock;
+size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+	vTaskSuspendAll();
+	{
+		pxBlock = xStart.pxNextFreeBlock;
+
+		/* pxBlock will be NULL if the heap has not been initialised.  The heap
+		is initialised automatically when the first allocation is made. */
+		if( pxBlock != NULL )
+		{
+			do
+			{
+				/* The end markers of all but the last heap region are in the
+				list too; they are not free memory. */
+				if( pxBlock->xBlockSize == 0 )
+				{
+					pxBlock = pxBlock->pxNextFreeBlock;
+					continue;
+				}
+
+				/* Increment the number of blocks and record the largest block seen
+				so far. */
+				xBlocks++;
+
+				if( pxBlock->xBlockSize > xMaxSize )
+				{
+					xMaxSize = pxBlock->xBlockSize;
+				}
+
+				if( pxBlock->xBlockSize < xMinSize )
+				{
+					xMinSize = pxBlock->xBlockSize;
+				}
+
+				/* Move to the next block in the chain until the last block is
+				reached. */
+				pxBlock = pxBlock->pxNextFreeBlock;
+			} while( pxBlock != pxEnd );
+		}
+	}
+	xTaskResumeAll();
+
+	pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+	pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+	pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+	taskENTER_CRITICAL();
+	{
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+	}
+	taskEXIT_CRITICAL();
+}
+
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_SLABS == 1 )
+
+	static SlabClass_t *prvSlabClassForSize( size_t xWantedSize )
+	{
+	SlabClass_t *pxClass = NULL;
+	size_t x;
+
+		/* A handful of classes, so a bounded search. */
+		for( x = 0; x < heapNUM_SLAB_CLASSES; x++ )
+		{
+			if( xSlabClasses[ x ].xObjectSize == xWantedSize )
+			{
+				pxClass = &xSlabClasses[ x ];
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return pxClass;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void *prvSlabMalloc( SlabClass_t *pxClass )
+	{
+	SlabObject_t *pxObject;
+	uint8_t *pucSlab;
+	size_t x;
+	void *pvReturn = NULL;
+
+		if( pxClass->pxFreeList == NULL )
+		{
+			/* The slab is a single heap_4 block that is never freed.  Its
+			start is aligned and the stride is a multiple of the alignment, so
+			every object in it is aligned too. */
+			pucSlab = ( uint8_t * ) prvHeapMalloc( pxClass->xStride * ( size_t ) configHEAP_SLAB_OBJECTS_PER_SLAB, heapANY_REGION );
+
+			if( pucSlab != NULL )
+			{
+				for( x = 0; x < ( size_t ) configHEAP_SLAB_OBJECTS_PER_SLAB; x++ )
+				{
+					pxObject = ( void * ) ( pucSlab + ( x * pxClass->xStride ) );
+					pxObject->xMarker = heapSLAB_OBJECT_FREE;
+					pxObject->pvLink = pxClass->pxFreeList;
+					pxClass->pxFreeList = pxObject;
+				}
+
+				pxClass->xSlabs++;
+				pxClass->xObjects += ( size_t ) configHEAP_SLAB_OBJECTS_PER_SLAB;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxObject = pxClass->pxFreeList;
+
+		if( pxObject != NULL )
+		{
+			configASSERT( pxObject->xMarker == heapSLAB_OBJECT_FREE );
+
+			pxClass->pxFreeList = ( SlabObject_t * ) pxObject->pvLink;
+			pxObject->pvLink = pxClass;
+			pxObject->xMarker = heapSLAB_OBJECT_IN_USE;
+
+			pxClass->xObjectsInUse++;
+
+			if( pxClass->xObjectsInUse > pxClass->xMaxObjectsInUse )
+			{
+				pxClass->xMaxObjectsInUse = pxClass->xObjectsInUse;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xNumberOfSuccessfulAllocations++;
+			pvReturn = ( void * ) ( ( ( uint8_t * ) pxObject ) + xHeapStructSize );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pvReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxPortGetSlabStats( SlabStats_t *pxSlabStats, UBaseType_t uxArraySize )
+	{
+	UBaseType_t x = 0;
+
+		vTaskSuspendAll();
+		{
+			for( x = 0; ( x < uxArraySize ) && ( x < ( UBaseType_t ) heapNUM_SLAB_CLASSES ); x++ )
+			{
+				pxSlabStats[ x ].xObjectSizeInBytes = xSlabClasses[ x ].xObjectSize;
+				pxSlabStats[ x ].xNumberOfSlabs = xSlabClasses[ x ].xSlabs;
+				pxSlabStats[ x ].xNumberOfObjects = xSlabClasses[ x ].xObjects;
+				pxSlabStats[ x ].xObjectsInUse = xSlabClasses[ x ].xObjectsInUse;
+				pxSlabStats[ x ].xMaximumEverObjectsInUse = xSlabClasses[ x ].xMaxObjectsInUse;
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return x;
+	}
+
+#endif /* configUSE_HEAP_SLABS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	static size_t prvBlockBytes( const BlockLink_t *pxLink )
+	{
+		#if( configUSE_HEAP_SLABS == 1 )
+		{
+			const SlabObject_t *pxObject = ( const void * ) pxLink;
+
+			if( pxObject->xMarker == heapSLAB_OBJECT_IN_USE )
+			{
+				return ( ( const SlabClass_t * ) pxObject->pvLink )->xStride;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		return pxLink->xBlockSize & ~xBlockAllocatedBit;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvRecordMalloc( void *pv, size_t xWantedSize, void *pvCaller )
+	{
+	BlockLink_t *pxLink;
+	HeapCallerStats_t *pxCaller;
+	size_t xBucket, xBucketLimit, xCaller, xBytes;
+
+		vTaskSuspendAll();
+		{
+			if( pv != NULL )
+			{
+				/* This casting is to keep the compiler from issuing warnings. */
+				pxLink = ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
+				xBytes = prvBlockBytes( pxLink );
+
+				xBucket = 0;
+				xBucketLimit = heapHISTOGRAM_SMALLEST_BUCKET;
+				while( ( xBucket < ( size_t ) ( configHEAP_HISTOGRAM_BUCKETS - 1 ) ) && ( xWantedSize > xBucketLimit ) )
+				{
+					xBucket++;
+					xBucketLimit <<= 1;
+				}
+
+				/* Find the caller's entry, or claim a free one.  The table is
+				small and only ever grows, so a linear search is enough. */
+				for( xCaller = 0; xCaller < ( size_t ) heapOTHER_CALLERS; xCaller++ )
+				{
+					pxCaller = &( xHeapInstrumentation.xCallers[ xCaller ] );
+
+					if( ( pxCaller->pvCaller == pvCaller ) || ( pxCaller->pvCaller == NULL ) )
+					{
+						pxCaller->pvCaller = pvCaller;
+						break;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+
+				pxCaller = &( xHeapInstrumentation.xCallers[ xCaller ] );
+				pxCaller->xOutstandingBytes += xBytes;
+				pxCaller->xOutstandingBlocks++;
+
+				if( pxCaller->xOutstandingBytes > pxCaller->xMaximumEverOutstandingBytes )
+				{
+					pxCaller->xMaximumEverOutstandingBytes = pxCaller->xOutstandingBytes;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xHeapInstrumentation.xAllocationsBySize[ xBucket ]++;
+				xHeapInstrumentation.xOutstandingBySize[ xBucket ]++;
+				xHeapInstrumentation.xOutstandingBytes += xBytes;
+
+				if( xHeapInstrumentation.xOutstandingBytes > xHeapInstrumentation.xMaximumEverOutstandingBytes )
+				{
+					xHeapInstrumentation.xMaximumEverOutstandingBytes = xHeapInstrumentation.xOutstandingBytes;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxLink->usCaller = ( uint16_t ) xCaller;
+				pxLink->usSizeBucket = ( uint16_t ) xBucket;
+			}
+			else
+			{
+				xHeapInstrumentation.xFailedAllocations++;
+			}
+		}
+		( void ) xTaskResumeAll();
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvRecordFree( void *pv )
+	{
+	BlockLink_t *pxLink;
+	HeapCallerStats_t *pxCaller;
+	BaseType_t xIsLive;
+	size_t xBytes;
+
+		if( pv != NULL )
+		{
+			/* This casting is to keep the compiler from issuing warnings. */
+			pxLink = ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
+
+			/* Leave blocks vPortFree() is going to reject to its asserts. */
+			xIsLive = ( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 ) && ( pxLink->pxNextFreeBlock == NULL );
+
+			#if( configUSE_HEAP_SLABS == 1 )
+			{
+				if( pxLink->xBlockSize == heapSLAB_OBJECT_IN_USE )
+				{
+					xIsLive = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+
+			if( ( xIsLive != pdFALSE ) && ( pxLink->usCaller < ( uint16_t ) configHEAP_INSTRUMENTATION_CALLERS ) && ( pxLink->usSizeBucket < ( uint16_t ) configHEAP_HISTOGRAM_BUCKETS ) )
+			{
+				vTaskSuspendAll();
+				{
+					xBytes = prvBlockBytes( pxLink );
+					pxCaller = &( xHeapInstrumentation.xCallers[ pxLink->usCaller ] );
+
+					pxCaller->xOutstandingBytes -= xBytes;
+					pxCaller->xOutstandingBlocks--;
+					xHeapInstrumentation.xOutstandingBySize[ pxLink->usSizeBucket ]--;
+					xHeapInstrumentation.xOutstandingBytes -= xBytes;
+				}
+				( void ) xTaskResumeAll();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvRecordRealloc( void *pv, uint16_t usCaller, uint16_t usSizeBucket, size_t xOldBytes )
+	{
+	BlockLink_t *pxLink;
+	HeapCallerStats_t *pxCaller;
+	size_t xBytes;
+
+		vTaskSuspendAll();
+		{
+			if( pv != NULL )
+			{
+				/* This casting is to keep the compiler from issuing warnings. */
+				pxLink = ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
+				pxLink->usCaller = usCaller;
+				pxLink->usSizeBucket = usSizeBucket;
+
+				if( ( usCaller < ( uint16_t ) configHEAP_INSTRUMENTATION_CALLERS ) && ( usSizeBucket < ( uint16_t ) configHEAP_HISTOGRAM_BUCKETS ) )
+				{
+					/* Unsigned arithmetic, so a block that shrank works too. */
+					xBytes = prvBlockBytes( pxLink );
+					pxCaller = &( xHeapInstrumentation.xCallers[ usCaller ] );
+					pxCaller->xOutstandingBytes = ( pxCaller->xOutstandingBytes - xOldBytes ) + xBytes;
+					xHeapInstrumentation.xOutstandingBytes = ( xHeapInstrumentation.xOutstandingBytes - xOldBytes ) + xBytes;
+
+					if( pxCaller->xOutstandingBytes > pxCaller->xMaximumEverOutstandingBytes )
+					{
+						pxCaller->xMaximumEverOutstandingBytes = pxCaller->xOutstandingBytes;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					if( xHeapInstrumentation.xOutstandingBytes > xHeapInstrumentation.xMaximumEverOutstandingBytes )
+					{
+						xHeapInstrumentation.xMaximumEverOutstandingBytes = xHeapInstrumentation.xOutstandingBytes;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				xHeapInstrumentation.xFailedAllocations++;
+			}
+		}
+		( void ) xTaskResumeAll();
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortGetHeapInstrumentation( HeapInstrumentation_t *pxHeapInstrumentation )
+	{
+		vTaskSuspendAll();
+		{
+			*pxHeapInstrumentation = xHeapInstrumentation;
+		}
+		( void ) xTaskResumeAll();
+	}
+	/*-----------------------------------------------------------*/
+
+	/*
+	 * snprintf() into what is left of the report buffer.  Returns the new
+	 * length, which stops growing once the buffer is full.
+	 */
+	static size_t prvReportAppend( char *pcWriteBuffer, size_t xBufferLength, size_t xUsed, const char *pcFormat, ... )
+	{
+	va_list xArgs;
+	int iWritten;
+
+		if( xUsed < xBufferLength )
+		{
+			va_start( xArgs, pcFormat );
+			iWritten = vsnprintf( &( pcWriteBuffer[ xUsed ] ), xBufferLength - xUsed, pcFormat, xArgs );
+			va_end( xArgs );
+
+			if( iWritten > 0 )
+			{
+				xUsed += ( size_t ) iWritten;
+
+				if( xUsed >= xBufferLength )
+				{
+					/* Truncated - vsnprintf() has terminated the string. */
+					xUsed = xBufferLength;
+				}
+			}
+		}
+
+		return xUsed;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortHeapReport( char *pcWriteBuffer, size_t xBufferLength )
+	{
+	/* Static to keep the snapshot off the calling task's stack.  The report is
+	not expected to be generated from two tasks at once. */
+	static HeapInstrumentation_t xSnapshot;
+	HeapStats_t xHeapStats;
+	size_t x, xUsed = 0, xBucketLimit = heapHISTOGRAM_SMALLEST_BUCKET;
+
+		if( ( pcWriteBuffer == NULL ) || ( xBufferLength == 0 ) )
+		{
+			return;
+		}
+
+		pcWriteBuffer[ 0 ] = 0x00;
+
+		vPortGetHeapStats( &xHeapStats );
+		vPortGetHeapInstrumentation( &xSnapshot );
+
+		xUsed = prvReportAppend( pcWriteBuffer, xBufferLength, xUsed, "Heap %lu: free %lu, minimum ever free %lu, largest free block %lu, free blocks %lu\r\n",
+								( unsigned long ) heapTOTAL_BYTES,
+								( unsigned long ) xHeapStats.xAvailableHeapSpaceInBytes,
+								( unsigned long ) xHeapStats.xMinimumEverFreeBytesRemaining,
+								( unsigned long ) xHeapStats.xSizeOfLargestFreeBlockInBytes,
+								( unsigned long ) xHeapStats.xNumberOfFreeBlocks );
+
+		xUsed = prvReportAppend( pcWriteBuffer, xBufferLength, xUsed, "Allocated %lu, peak %lu, failed allocations %lu\r\n",
+								( unsigned long ) xSnapshot.xOutstandingBytes,
+								( unsigned long ) xSnapshot.xMaximumEverOutstandingBytes,
+								( unsigned long ) xSnapshot.xFailedAllocations );
+
+		xUsed = prvReportAppend( pcWriteBuffer, xBufferLength, xUsed, "%10s %8s %8s\r\n", "Size", "Allocs", "Live" );
+
+		for( x = 0; x < ( size_t ) configHEAP_HISTOGRAM_BUCKETS; x++ )
+		{
+			if( xSnapshot.xAllocationsBySize[ x ] != 0 )
+			{
+				xUsed = prvReportAppend( pcWriteBuffer, xBufferLength, xUsed, "%s%8lu %8lu %8lu\r\n",
+										( x == ( size_t ) ( configHEAP_HISTOGRAM_BUCKETS - 1 ) ) ? " >" : "<=",
+										( unsigned long ) ( ( x == ( size_t ) ( configHEAP_HISTOGRAM_BUCKETS - 1 ) ) ? ( xBucketLimit >> 1 ) : xBucketLimit ),
+										( unsigned long ) xSnapshot.xAllocationsBySize[ x ],
+										( unsigned long ) xSnapshot.xOutstandingBySize[ x ] );
+			}
+
+			xBucketLimit <<= 1;
+		}
+
+		xUsed = prvReportAppend( pcWriteBuffer, xBufferLength, xUsed, "%10s %8s %8s %8s\r\n", "Caller", "Bytes", "Blocks", "Peak" );
+
+		for( x = 0; x < ( size_t ) configHEAP_INSTRUMENTATION_CALLERS; x++ )
+		{
+			if( xSnapshot.xCallers[ x ].xMaximumEverOutstandingBytes != 0 )
+			{
+				if( x == ( size_t ) heapOTHER_CALLERS )
+				{
+					xUsed = prvReportAppend( pcWriteBuffer, xBufferLength, xUsed, "%10s", "other" );
+				}
+				else
+				{
+					xUsed = prvReportAppend( pcWriteBuffer, xBufferLength, xUsed, "0x%08lx", ( unsigned long ) xSnapshot.xCallers[ x ].pvCaller );
+				}
+
+				xUsed = prvReportAppend( pcWriteBuffer, xBufferLength, xUsed, " %8lu %8lu %8lu\r\n",
+										( unsigned long ) xSnapshot.xCallers[ x ].xOutstandingBytes,
+										( unsigned long ) xSnapshot.xCallers[ x ].xOutstandingBlocks,
+										( unsigned long ) xSnapshot.xCallers[ x ].xMaximumEverOutstandingBytes );
+			}
+		}
+
+		#if( configUSE_HEAP_SLABS == 1 )
+		{
+			SlabStats_t xSlabStats[ heapNUM_SLAB_CLASSES ];
+			UBaseType_t uxClasses;
+
+			uxClasses = uxPortGetSlabStats( xSlabStats, ( UBaseType_t ) heapNUM_SLAB_CLASSES );
+
+			xUsed = prvReportAppend( pcWriteBuffer, xBufferLength, xUsed, "%10s %8s %8s %8s\r\n", "Slab", "Objects", "In use", "Peak" );
+
+			for( x = 0; x < ( size_t ) uxClasses; x++ )
+			{
+				xUsed = prvReportAppend( pcWriteBuffer, xBufferLength, xUsed, "%10lu %8lu %8lu %8lu\r\n",
+										( unsigned long ) xSlabStats[ x ].xObjectSizeInBytes,
+										( unsigned long ) xSlabStats[ x ].xNumberOfObjects,
+										( unsigned long ) xSlabStats[ x ].xObjectsInUse,
+										( unsigned long ) xSlabStats[ x ].xMaximumEverObjectsInUse );
+			}
+		}
+		#endif
+	}
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
+#else /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+/* The CMSIS-RTOS2 layer still calls the allocator from the few functions that
+need a heap whatever their attributes, such as osTimerNew().  Without a heap
+they fail as if it were exhausted. */
+void *pvPortMalloc( size_t xWantedSize )
+{
+	( void ) xWantedSize;
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		extern void vApplicationMallocFailedHook( void );
+		vApplicationMallocFailedHook();
+	}
+	#endif
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+	/* Nothing can have been allocated. */
+	configASSERT( pv == NULL );
+	( void ) pv;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetAllocationSize( void *pv )
+{
+	configASSERT( pv == NULL );
+	( void ) pv;
+
+	return 0;
+}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+#endif /* USE_FreeRTOS_HEAP_TLSF */
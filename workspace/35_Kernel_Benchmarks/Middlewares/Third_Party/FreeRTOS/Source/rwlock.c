@@ -0,0 +1,221 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "rwlock.h"
+
+#if( configUSE_MUTEXES != 1 )
+	#error configUSE_MUTEXES must be set to 1 to build rwlock.c
+#endif
+
+#if( configSUPPORT_STATIC_ALLOCATION != 1 )
+	#error configSUPPORT_STATIC_ALLOCATION must be set to 1 to build rwlock.c
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/*-----------------------------------------------------------*/
+
+RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t *pxRWLockBuffer )
+{
+	configASSERT( pxRWLockBuffer );
+
+	pxRWLockBuffer->uxReaders = ( UBaseType_t ) 0;
+	pxRWLockBuffer->xWriterWaiting = pdFALSE;
+	pxRWLockBuffer->xWriteMutex = xSemaphoreCreateMutexStatic( &( pxRWLockBuffer->xWriteMutexBuffer ) );
+	pxRWLockBuffer->xReadersDone = xSemaphoreCreateBinaryStatic( &( pxRWLockBuffer->xReadersDoneBuffer ) );
+
+	return pxRWLockBuffer;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait )
+{
+	configASSERT( xRWLock );
+
+	/* The mutex is only free when no writer holds the lock or waits for it,
+	and while it is not, readers queue on it behind the writer. */
+	if( xSemaphoreTake( xRWLock->xWriteMutex, xTicksToWait ) == pdFALSE )
+	{
+		return pdFALSE;
+	}
+
+	/* Readers leave without the mutex, so the count is always updated in a
+	critical section. */
+	taskENTER_CRITICAL();
+	{
+		( xRWLock->uxReaders )++;
+	}
+	taskEXIT_CRITICAL();
+
+	( void ) xSemaphoreGive( xRWLock->xWriteMutex );
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vRWLockGiveRead( RWLockHandle_t xRWLock )
+{
+BaseType_t xLastReader = pdFALSE;
+
+	configASSERT( xRWLock );
+
+	taskENTER_CRITICAL();
+	{
+		configASSERT( xRWLock->uxReaders != ( UBaseType_t ) 0 );
+		( xRWLock->uxReaders )--;
+
+		if( ( xRWLock->uxReaders == ( UBaseType_t ) 0 ) && ( xRWLock->xWriterWaiting != pdFALSE ) )
+		{
+			/* Clearing the flag commits this reader to giving the semaphore,
+			which the writer relies on if its wait times out meanwhile. */
+			xRWLock->xWriterWaiting = pdFALSE;
+			xLastReader = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xLastReader != pdFALSE )
+	{
+		( void ) xSemaphoreGive( xRWLock->xReadersDone );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait )
+{
+TimeOut_t xTimeOut;
+BaseType_t xWaitForReaders, xReturn = pdTRUE;
+
+	configASSERT( xRWLock );
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	/* Holding the mutex keeps new readers and writers out. */
+	if( xSemaphoreTake( xRWLock->xWriteMutex, xTicksToWait ) == pdFALSE )
+	{
+		return pdFALSE;
+	}
+
+	taskENTER_CRITICAL();
+	{
+		if( xRWLock->uxReaders != ( UBaseType_t ) 0 )
+		{
+			xRWLock->xWriterWaiting = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xWaitForReaders = xRWLock->xWriterWaiting;
+	}
+	taskEXIT_CRITICAL();
+
+	if( xWaitForReaders != pdFALSE )
+	{
+		/* Wait for the readers with what is left of the block time. */
+		( void ) xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait );
+
+		if( xSemaphoreTake( xRWLock->xReadersDone, xTicksToWait ) == pdFALSE )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( xRWLock->xWriterWaiting != pdFALSE )
+				{
+					/* Readers still hold the lock. */
+					xRWLock->xWriterWaiting = pdFALSE;
+					xReturn = pdFALSE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xReturn != pdFALSE )
+			{
+				/* The last reader left as the wait timed out and is about to
+				give the semaphore.  Consume it so the next writer does not
+				find it given. */
+				( void ) xSemaphoreTake( xRWLock->xReadersDone, portMAX_DELAY );
+			}
+			else
+			{
+				( void ) xSemaphoreGive( xRWLock->xWriteMutex );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vRWLockGiveWrite( RWLockHandle_t xRWLock )
+{
+	configASSERT( xRWLock );
+
+	( void ) xSemaphoreGive( xRWLock->xWriteMutex );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxRWLockGetReaderCount( RWLockHandle_t xRWLock )
+{
+	configASSERT( xRWLock );
+
+	return xRWLock->uxReaders;
+}
+/*-----------------------------------------------------------*/
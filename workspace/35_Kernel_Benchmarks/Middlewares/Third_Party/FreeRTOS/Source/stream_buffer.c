@@ -0,0 +1,3373 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+#if( configUSE_WAIT_ANY == 1 )
+	#include "wait_any.h"
+#endif
+
+#if( configUSE_OBJECT_REGISTRY == 1 )
+	#include "registry.h"
+#endif
+
+#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+	#include "atomic.h"
+#endif
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build stream_buffer.c
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* If the user has not provided application specific Rx notification macros,
+or #defined the notification macros away, them provide default implementations
+that uses task notifications. */
+/*lint -save -e9026 Function like macros allowed and needed here so they can be overidden. */
+#ifndef sbRECEIVE_COMPLETED
+	#define sbRECEIVE_COMPLETED( pxStreamBuffer )										\
+		vTaskSuspendAll();																\
+		{																				\
+			if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )						\
+			{																			\
+				( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToSend,			\
+									  ( uint32_t ) 0,									\
+									  eNoAction );										\
+				( pxStreamBuffer )->xTaskWaitingToSend = NULL;							\
+			}																			\
+		}																				\
+		( void ) xTaskResumeAll();
+#endif /* sbRECEIVE_COMPLETED */
+
+#ifndef sbRECEIVE_COMPLETED_FROM_ISR
+	#define sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer,								\
+										  pxHigherPriorityTaskWoken )					\
+	{																					\
+	UBaseType_t uxSavedInterruptStatus;													\
+																						\
+		uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();		\
+		{																				\
+			if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )						\
+			{																			\
+				( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToSend,	\
+											 ( uint32_t ) 0,							\
+											 eNoAction,									\
+											 pxHigherPriorityTaskWoken );				\
+				( pxStreamBuffer )->xTaskWaitingToSend = NULL;							\
+			}																			\
+		}																				\
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );					\
+	}
+#endif /* sbRECEIVE_COMPLETED_FROM_ISR */
+
+/* If the user has not provided an application specific Tx notification macro,
+or #defined the notification macro away, them provide a default implementation
+that uses task notifications. */
+#ifndef sbSEND_COMPLETED
+	#define sbSEND_COMPLETED( pxStreamBuffer )											\
+		vTaskSuspendAll();																\
+		{																				\
+			if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )						\
+			{																			\
+				( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToReceive,		\
+									  ( uint32_t ) 0,									\
+									  eNoAction );										\
+				( pxStreamBuffer )->xTaskWaitingToReceive = NULL;						\
+			}																			\
+		}																				\
+		( void ) xTaskResumeAll();
+#endif /* sbSEND_COMPLETED */
+
+#ifndef sbSEND_COMPLETE_FROM_ISR
+	#define sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken )		\
+	{																					\
+	UBaseType_t uxSavedInterruptStatus;													\
+																						\
+		uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();		\
+		{																				\
+			if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )						\
+			{																			\
+				( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToReceive,	\
+											 ( uint32_t ) 0,							\
+											 eNoAction,									\
+											 pxHigherPriorityTaskWoken );				\
+				( pxStreamBuffer )->xTaskWaitingToReceive = NULL;						\
+			}																			\
+		}																				\
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );					\
+	}
+#endif /* sbSEND_COMPLETE_FROM_ISR */
+/*lint -restore (9026) */
+
+#if( configUSE_WAIT_ANY == 1 )
+	/* A stream buffer that reached its trigger level tells the wait-any object
+	it is a member of, if any. */
+	#define sbNOTIFY_WAIT_ANY( pxStreamBuffer )										\
+		if( ( pxStreamBuffer )->pxWaitAny != NULL )									\
+		{																			\
+			vWaitAnyNotify( ( pxStreamBuffer )->pxWaitAny );						\
+		}
+	#define sbNOTIFY_WAIT_ANY_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken )	\
+		if( ( pxStreamBuffer )->pxWaitAny != NULL )									\
+		{																			\
+			vWaitAnyNotifyFromISR( ( pxStreamBuffer )->pxWaitAny, ( pxHigherPriorityTaskWoken ) ); \
+		}
+#else
+	#define sbNOTIFY_WAIT_ANY( pxStreamBuffer )
+	#define sbNOTIFY_WAIT_ANY_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken )
+#endif /* configUSE_WAIT_ANY */
+
+/* The number of bytes used to hold the length of a message in the buffer. */
+#define sbBYTES_TO_STORE_MESSAGE_LENGTH ( sizeof( configMESSAGE_BUFFER_LENGTH_TYPE ) )
+
+/* The number of bytes used to hold the time a message was sent, which follows
+its length. */
+#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+	#define sbBYTES_TO_STORE_MESSAGE_TIMESTAMP ( sizeof( MessageTimestamp_t ) )
+#else
+	#define sbBYTES_TO_STORE_MESSAGE_TIMESTAMP ( ( size_t ) 0 )
+#endif
+
+/* The number of bytes stored in front of each message. */
+#define sbBYTES_TO_STORE_MESSAGE_HEADER ( sbBYTES_TO_STORE_MESSAGE_LENGTH + sbBYTES_TO_STORE_MESSAGE_TIMESTAMP )
+
+/* Bits stored in the ucFlags field of the stream buffer. */
+#define sbFLAGS_IS_MESSAGE_BUFFER		( ( uint8_t ) 1 ) /* Set if the stream buffer was created as a message buffer, in which case it holds discrete messages rather than a stream. */
+#define sbFLAGS_IS_STATICALLY_ALLOCATED ( ( uint8_t ) 2 ) /* Set if the stream buffer was created using statically allocated memory. */
+
+/*-----------------------------------------------------------*/
+
+/* Structure that hold state information on the buffer. */
+typedef struct StreamBufferDef_t /*lint !e9058 Style convention uses tag. */
+{
+	volatile size_t xTail;				/* Index to the next item to read within the buffer. */
+	volatile size_t xHead;				/* Index to the next item to write within the buffer. */
+	size_t xLength;						/* The length of the buffer pointed to by pucBuffer. */
+	size_t xTriggerLevelBytes;			/* The number of bytes that must be in the stream buffer before a task that is waiting for data is unblocked. */
+	volatile TaskHandle_t xTaskWaitingToReceive; /* Holds the handle of a task waiting for data, or NULL if no tasks are waiting. */
+	volatile TaskHandle_t xTaskWaitingToSend;	/* Holds the handle of a task waiting to send data to a message buffer that is full. */
+	uint8_t *pucBuffer;					/* Points to the buffer itself - that is - the RAM that stores the data passed through the buffer. */
+	uint8_t ucFlags;
+
+	#if ( configUSE_TRACE_FACILITY == 1 )
+		UBaseType_t uxStreamBufferNumber;		/* Used for tracing purposes. */
+	#endif
+
+	#if ( configUSE_WAIT_ANY == 1 )
+		struct WaitAnyDef_t *pxWaitAny;			/* The wait-any object the stream buffer is a member of, or NULL. */
+	#endif
+
+	#if ( configUSE_OBJECT_REGISTRY == 1 )
+		RegistryItem_t xRegistryItem;			/* Links the stream buffer into the object registry once it has a name. */
+	#endif
+
+	#if ( configUSE_STREAM_BUFFER_HOLD_TIME == 1 )
+		TickType_t xHoldTicks;					/* The longest the oldest byte waits for the trigger level, or 0 for no limit. */
+		volatile TickType_t xFirstByteTime;		/* The tick count when bytes were last written to the empty buffer. */
+	#endif
+
+	#if ( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+		MessageTimestamp_t xLastTimestamp;		/* The time the last message received was sent. */
+		StreamBufferDelayStats_t xDelayStats;	/* How long the messages received were queued. */
+	#endif
+
+	#if ( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+		volatile uint32_t ulReserveHead;		/* Index to the next byte a concurrent send reserves.  xHead only reaches it once every reserved byte is written. */
+		volatile uint32_t ulWriters;			/* The number of concurrent sends between their reservation and their return. */
+	#endif
+} StreamBuffer_t;
+
+/*
+ * The number of bytes available to be read from the buffer.
+ */
+static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add xCount bytes from pucData into the pxStreamBuffer message buffer.
+ * Returns the number of bytes written, which will either equal xCount in the
+ * success case, or 0 if there was not enough space in the buffer (in which case
+ * no data is written into the buffer).
+ */
+static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies xCount bytes from pucData into the storage area from index xIndex,
+ * wrapping to the start if needed, without moving the head.  Returns the index
+ * after the last byte written.
+ */
+static size_t prvCopyBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, size_t xIndex, const uint8_t *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * If the stream buffer is being used as a message buffer, then reads an entire
+ * message out of the buffer.  If the stream buffer is being used as a stream
+ * buffer then read as many bytes as possible from the buffer.
+ * prvReadBytesFromBuffer() is called to actually extract the bytes from the
+ * buffer's data storage area.
+ */
+static size_t prvReadMessageFromBuffer( StreamBuffer_t *pxStreamBuffer,
+										void *pvRxData,
+										size_t xBufferLengthBytes,
+										size_t xBytesAvailable,
+										size_t xBytesToStoreMessageLength ) PRIVILEGED_FUNCTION;
+
+/*
+ * If the stream buffer is being used as a message buffer, then writes an entire
+ * message to the buffer.  If the stream buffer is being used as a stream
+ * buffer then write as many bytes as possible to the buffer.
+ * prvWriteBytestoBuffer() is called to actually send the bytes to the buffer's
+ * data storage area.
+ */
+static size_t prvWriteMessageToBuffer(  StreamBuffer_t * const pxStreamBuffer,
+										const void * pvTxData,
+										size_t xDataLengthBytes,
+										size_t xSpace,
+										size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
+
+/*
+ * Read xMaxCount bytes from the pxStreamBuffer message buffer and write them
+ * to pucData.
+ */
+static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer,
+									  uint8_t *pucData,
+									  size_t xMaxCount,
+									  size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
+ * initialise the members of the newly created stream buffer structure.
+ */
+static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
+										  uint8_t * const pucBuffer,
+										  size_t xBufferSizeBytes,
+										  size_t xTriggerLevelBytes,
+										  uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_STREAM_BUFFER_HOLD_TIME == 1 )
+	/*
+	 * Called by a writer before it adds bytes.  If the buffer has a hold time
+	 * and is empty, the bytes about to be written will be the oldest, so the
+	 * hold starts at xTickCount.  Returns pdTRUE in that case: the reader must
+	 * then be woken whatever the trigger level, to time the hold.
+	 */
+	static BaseType_t prvStartHold( StreamBuffer_t * const pxStreamBuffer, TickType_t xTickCount ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * xStreamBufferReceive() on a stream buffer with a hold time.  Blocks until
+	 * the trigger level is reached, the oldest byte has been held for the hold
+	 * time, or xTicksToWait expires, and returns the bytes then available.
+	 */
+	static size_t prvWaitForHeldBytes( StreamBuffer_t * const pxStreamBuffer, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif /* configUSE_STREAM_BUFFER_HOLD_TIME */
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	/*
+	 * The number of free bytes that can be written in one piece starting at
+	 * index xFrom, which must lie within the free part of the buffer.
+	 */
+	static size_t prvContiguousSpace( const StreamBuffer_t * const pxStreamBuffer, size_t xFrom ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Reads the length of the message stored at index *pxIndex without moving
+	 * the tail, and advances *pxIndex past the header to the first byte of the
+	 * message.
+	 */
+	static size_t prvPeekMessageLength( const StreamBuffer_t * const pxStreamBuffer, size_t *pxIndex ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Makes xLengthBytes written in place after xStreamBufferReserve() visible
+	 * to the reader, preceded by their length for a message buffer.
+	 */
+	static size_t prvCommitReservedBytes( StreamBuffer_t * const pxStreamBuffer, size_t xLengthBytes ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Removes xLengthBytes read in place after xStreamBufferPeek(), or the
+	 * whole next message for a message buffer.
+	 */
+	static size_t prvConsumePeekedBytes( StreamBuffer_t * const pxStreamBuffer, size_t xLengthBytes ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
+#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+
+	/*
+	 * Reserves space for xDataLengthBytes (plus a message header), copies them
+	 * in, and publishes them with prvPublishConcurrentBytes().  Returns the
+	 * number of data bytes sent, and sets *pxPublished to pdTRUE if xHead was
+	 * moved.
+	 */
+	static size_t prvSendConcurrent( StreamBuffer_t * const pxStreamBuffer,
+									 const void *pvTxData,
+									 size_t xDataLengthBytes,
+									 BaseType_t * const pxPublished ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by every concurrent send once its bytes are written.  The last
+	 * send still writing moves xHead up to ulReserveHead, so the reader sees
+	 * the bytes of all of them, in the order they were reserved.  Returns
+	 * pdTRUE if xHead was moved.
+	 */
+	static BaseType_t prvPublishConcurrentBytes( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+
+#if( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+	/*
+	 * The total length of the fragments of xStreamBufferSendV() and of the
+	 * destinations of xStreamBufferReceiveV().
+	 */
+	static size_t prvTxVectorLength( const StreamBufferTxVector_t *pxVectors, UBaseType_t uxVectorCount ) PRIVILEGED_FUNCTION;
+	static size_t prvRxVectorLength( const StreamBufferRxVector_t *pxVectors, UBaseType_t uxVectorCount ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * prvWriteMessageToBuffer() of the fragments of pxVectors, xDataLengthBytes
+	 * in all.  The fragments are copied one after the other from the head,
+	 * which is only moved once the last is in.
+	 */
+	static size_t prvWriteVectorsToBuffer( StreamBuffer_t * const pxStreamBuffer,
+										   const StreamBufferTxVector_t *pxVectors,
+										   UBaseType_t uxVectorCount,
+										   size_t xDataLengthBytes,
+										   size_t xSpace,
+										   size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * prvReadMessageFromBuffer() into the destinations of pxVectors, filled
+	 * in turn.
+	 */
+	static size_t prvReadMessageToVectors( StreamBuffer_t *pxStreamBuffer,
+										   const StreamBufferRxVector_t *pxVectors,
+										   UBaseType_t uxVectorCount,
+										   size_t xBytesAvailable,
+										   size_t xBytesToStoreMessageLength ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+
+#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+
+	/*
+	 * Called once a message sent at xTimestamp has been received.  Keeps
+	 * xTimestamp for the reader and adds how long the message was queued to
+	 * the delay statistics.
+	 */
+	static void prvRecordMessageDelay( StreamBuffer_t * const pxStreamBuffer, MessageTimestamp_t xTimestamp ) PRIVILEGED_FUNCTION;
+
+	#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+		/*
+		 * Reads the time the message stored at index xIndex was sent, without
+		 * moving the tail.
+		 */
+		static MessageTimestamp_t prvPeekMessageTimestamp( const StreamBuffer_t * const pxStreamBuffer, size_t xIndex ) PRIVILEGED_FUNCTION;
+
+	#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
+#endif /* configUSE_MESSAGE_BUFFER_TIMESTAMPS */
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer )
+	{
+	uint8_t *pucAllocatedMemory;
+	uint8_t ucFlags;
+
+		/* In case the stream buffer is going to be used as a message buffer
+		(that is, it will hold discrete messages with a little meta data that
+		says how big the next message is) check the buffer will be large enough
+		to hold at least one message. */
+		if( xIsMessageBuffer == pdTRUE )
+		{
+			/* Is a message buffer but not statically allocated. */
+			ucFlags = sbFLAGS_IS_MESSAGE_BUFFER;
+			configASSERT( xBufferSizeBytes > sbBYTES_TO_STORE_MESSAGE_HEADER );
+		}
+		else
+		{
+			/* Not a message buffer and not statically allocated. */
+			ucFlags = 0;
+			configASSERT( xBufferSizeBytes > 0 );
+		}
+		configASSERT( xTriggerLevelBytes <= xBufferSizeBytes );
+
+		/* A trigger level of 0 would cause a waiting task to unblock even when
+		the buffer was empty. */
+		if( xTriggerLevelBytes == ( size_t ) 0 )
+		{
+			xTriggerLevelBytes = ( size_t ) 1;
+		}
+
+		/* A stream buffer requires a StreamBuffer_t structure and a buffer.
+		Both are allocated in a single call to pvPortMalloc().  The
+		StreamBuffer_t structure is placed at the start of the allocated memory
+		and the buffer follows immediately after.  The requested size is
+		incremented so the free space is returned as the user would expect -
+		this is a quirk of the implementation that means otherwise the free
+		space would be reported as one byte smaller than would be logically
+		expected. */
+		xBufferSizeBytes++;
+		pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( xBufferSizeBytes + sizeof( StreamBuffer_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+		if( pucAllocatedMemory != NULL )
+		{
+			prvInitialiseNewStreamBuffer( ( StreamBuffer_t * ) pucAllocatedMemory, /* Structure at the start of the allocated memory. */ /*lint !e9087 Safe cast as allocated memory is aligned. */ /*lint !e826 Area is not too small and alignment is guaranteed provided malloc() behaves as expected and returns aligned buffer. */
+										   pucAllocatedMemory + sizeof( StreamBuffer_t ),  /* Storage area follows. */ /*lint !e9016 Indexing past structure valid for uint8_t pointer, also storage area has no alignment requirement. */
+										   xBufferSizeBytes,
+										   xTriggerLevelBytes,
+										   ucFlags );
+
+			#if( configUSE_OBJECT_REGISTRY == 1 )
+			{
+				vRegistryInitialiseItem( &( ( ( StreamBuffer_t * ) pucAllocatedMemory )->xRegistryItem ), pucAllocatedMemory, registryTYPE_STREAM_BUFFER ); /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+			}
+			#endif
+
+			traceSTREAM_BUFFER_CREATE( ( ( StreamBuffer_t * ) pucAllocatedMemory ), xIsMessageBuffer );
+		}
+		else
+		{
+			traceSTREAM_BUFFER_CREATE_FAILED( xIsMessageBuffer );
+		}
+
+		return ( StreamBufferHandle_t ) pucAllocatedMemory; /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
+														   size_t xTriggerLevelBytes,
+														   BaseType_t xIsMessageBuffer,
+														   uint8_t * const pucStreamBufferStorageArea,
+														   StaticStreamBuffer_t * const pxStaticStreamBuffer )
+	{
+	StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) pxStaticStreamBuffer; /*lint !e740 !e9087 Safe cast as StaticStreamBuffer_t is opaque Streambuffer_t. */
+	StreamBufferHandle_t xReturn;
+	uint8_t ucFlags;
+
+		configASSERT( pucStreamBufferStorageArea );
+		configASSERT( pxStaticStreamBuffer );
+		configASSERT( xTriggerLevelBytes <= xBufferSizeBytes );
+
+		/* A trigger level of 0 would cause a waiting task to unblock even when
+		the buffer was empty. */
+		if( xTriggerLevelBytes == ( size_t ) 0 )
+		{
+			xTriggerLevelBytes = ( size_t ) 1;
+		}
+
+		if( xIsMessageBuffer != pdFALSE )
+		{
+			/* Statically allocated message buffer. */
+			ucFlags = sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_STATICALLY_ALLOCATED;
+		}
+		else
+		{
+			/* Statically allocated stream buffer. */
+			ucFlags = sbFLAGS_IS_STATICALLY_ALLOCATED;
+		}
+
+		/* In case the stream buffer is going to be used as a message buffer
+		(that is, it will hold discrete messages with a little meta data that
+		says how big the next message is) check the buffer will be large enough
+		to hold at least one message. */
+		configASSERT( xBufferSizeBytes > sbBYTES_TO_STORE_MESSAGE_HEADER );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticStreamBuffer_t equals the size of the real
+			message buffer structure. */
+			volatile size_t xSize = sizeof( StaticStreamBuffer_t );
+			configASSERT( xSize == sizeof( StreamBuffer_t ) );
+		} /*lint !e529 xSize is referenced is configASSERT() is defined. */
+		#endif /* configASSERT_DEFINED */
+
+		if( ( pucStreamBufferStorageArea != NULL ) && ( pxStaticStreamBuffer != NULL ) )
+		{
+			prvInitialiseNewStreamBuffer( pxStreamBuffer,
+										  pucStreamBufferStorageArea,
+										  xBufferSizeBytes,
+										  xTriggerLevelBytes,
+										  ucFlags );
+
+			/* Remember this was statically allocated in case it is ever deleted
+			again. */
+			pxStreamBuffer->ucFlags |= sbFLAGS_IS_STATICALLY_ALLOCATED;
+
+			#if( configUSE_OBJECT_REGISTRY == 1 )
+			{
+				vRegistryInitialiseItem( &( pxStreamBuffer->xRegistryItem ), pxStreamBuffer, registryTYPE_STREAM_BUFFER );
+			}
+			#endif
+
+			traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xIsMessageBuffer );
+
+			xReturn = ( StreamBufferHandle_t ) pxStaticStreamBuffer; /*lint !e9087 Data hiding requires cast to opaque type. */
+		}
+		else
+		{
+			xReturn = NULL;
+			traceSTREAM_BUFFER_CREATE_STATIC_FAILED( xReturn, xIsMessageBuffer );
+		}
+
+		return xReturn;
+	}
+
+#endif /* ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+void vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer )
+{
+StreamBuffer_t * pxStreamBuffer = xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+
+	traceSTREAM_BUFFER_DELETE( xStreamBuffer );
+
+	#if( configUSE_OBJECT_REGISTRY == 1 )
+	{
+		vRegistryRemove( &( pxStreamBuffer->xRegistryItem ) );
+	}
+	#endif
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
+	{
+		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			/* Both the structure and the buffer were allocated using a single call
+			to pvPortMalloc(), hence only one call to vPortFree() is required. */
+			vPortFree( ( void * ) pxStreamBuffer ); /*lint !e9087 Standard free() semantics require void *, plus pxStreamBuffer was allocated by pvPortMalloc(). */
+		}
+		#else
+		{
+			/* Should not be possible to get here, ucFlags must be corrupt.
+			Force an assert. */
+			configASSERT( xStreamBuffer == ( StreamBufferHandle_t ) ~0 );
+		}
+		#endif
+	}
+	else
+	{
+		/* The structure and buffer were not allocated dynamically and cannot be
+		freed - just scrub the structure so future use will assert. */
+		( void ) memset( pxStreamBuffer, 0x00, sizeof( StreamBuffer_t ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+BaseType_t xReturn = pdFAIL;
+
+#if( configUSE_TRACE_FACILITY == 1 )
+	UBaseType_t uxStreamBufferNumber;
+#endif
+
+#if( configUSE_WAIT_ANY == 1 )
+	struct WaitAnyDef_t *pxWaitAny;
+#endif
+
+#if( configUSE_OBJECT_REGISTRY == 1 )
+	RegistryItem_t xRegistryItem;
+#endif
+
+#if( configUSE_STREAM_BUFFER_HOLD_TIME == 1 )
+	TickType_t xHoldTicks;
+#endif
+
+	configASSERT( pxStreamBuffer );
+
+	#if( configUSE_TRACE_FACILITY == 1 )
+	{
+		/* Store the stream buffer number so it can be restored after the
+		reset. */
+		uxStreamBufferNumber = pxStreamBuffer->uxStreamBufferNumber;
+	}
+	#endif
+
+	#if( configUSE_WAIT_ANY == 1 )
+	{
+		/* A reset does not end membership of a wait-any object either. */
+		pxWaitAny = pxStreamBuffer->pxWaitAny;
+	}
+	#endif
+
+	#if( configUSE_STREAM_BUFFER_HOLD_TIME == 1 )
+	{
+		/* The hold time is kept, as the trigger level is. */
+		xHoldTicks = pxStreamBuffer->xHoldTicks;
+	}
+	#endif
+
+	/* Can only reset a message buffer if there are no tasks blocked on it. */
+	taskENTER_CRITICAL();
+	{
+		if( pxStreamBuffer->xTaskWaitingToReceive == NULL )
+		{
+			if( pxStreamBuffer->xTaskWaitingToSend == NULL )
+			{
+				#if( configUSE_OBJECT_REGISTRY == 1 )
+				{
+					xRegistryItem = pxStreamBuffer->xRegistryItem;
+				}
+				#endif
+
+				prvInitialiseNewStreamBuffer( pxStreamBuffer,
+											  pxStreamBuffer->pucBuffer,
+											  pxStreamBuffer->xLength,
+											  pxStreamBuffer->xTriggerLevelBytes,
+											  pxStreamBuffer->ucFlags );
+				xReturn = pdPASS;
+
+				#if( configUSE_TRACE_FACILITY == 1 )
+				{
+					pxStreamBuffer->uxStreamBufferNumber = uxStreamBufferNumber;
+				}
+				#endif
+
+				#if( configUSE_WAIT_ANY == 1 )
+				{
+					pxStreamBuffer->pxWaitAny = pxWaitAny;
+				}
+				#endif
+
+				#if( configUSE_STREAM_BUFFER_HOLD_TIME == 1 )
+				{
+					pxStreamBuffer->xHoldTicks = xHoldTicks;
+				}
+				#endif
+
+				#if( configUSE_OBJECT_REGISTRY == 1 )
+				{
+					/* Nor does it remove the stream buffer from the registry.
+					The item is put back at the same address, so its links
+					stay valid. */
+					pxStreamBuffer->xRegistryItem = xRegistryItem;
+				}
+				#endif
+
+				traceSTREAM_BUFFER_RESET( xStreamBuffer );
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+BaseType_t xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	/* It is not valid for the trigger level to be 0. */
+	if( xTriggerLevel == ( size_t ) 0 )
+	{
+		xTriggerLevel = ( size_t ) 1;
+	}
+
+	/* The trigger level is the number of bytes that must be in the stream
+	buffer before a task that is waiting for data is unblocked. */
+	if( xTriggerLevel <= pxStreamBuffer->xLength )
+	{
+		pxStreamBuffer->xTriggerLevelBytes = xTriggerLevel;
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_HOLD_TIME == 1 )
+
+	BaseType_t xStreamBufferSetHoldTime( StreamBufferHandle_t xStreamBuffer, TickType_t xHoldTicks )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	BaseType_t xReturn;
+
+		configASSERT( pxStreamBuffer );
+
+		/* Every message unblocks the reader of a message buffer. */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 )
+		{
+			pxStreamBuffer->xHoldTicks = xHoldTicks;
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_HOLD_TIME */
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer )
+{
+const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xSpace;
+
+	configASSERT( pxStreamBuffer );
+
+	xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
+	xSpace -= pxStreamBuffer->xHead;
+	xSpace -= ( size_t ) 1;
+
+	if( xSpace >= pxStreamBuffer->xLength )
+	{
+		xSpace -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xSpace;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer )
+{
+const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	xReturn = prvBytesInBuffer( pxStreamBuffer );
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
+						  const void *pvTxData,
+						  size_t xDataLengthBytes,
+						  TickType_t xTicksToWait )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xReturn, xSpace = 0;
+size_t xRequiredSpace = xDataLengthBytes;
+TimeOut_t xTimeOut;
+BaseType_t xStartsHold = pdFALSE;
+
+	configASSERT( pvTxData );
+	configASSERT( pxStreamBuffer );
+
+	/* This send function is used to write to both message buffers and stream
+	buffers.  If this is a message buffer then the space needed must be
+	increased by the amount of bytes needed to store the length of the
+	message. */
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_HEADER;
+
+		/* Overflow? */
+		configASSERT( xRequiredSpace > xDataLengthBytes );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xTicksToWait != ( TickType_t ) 0 )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+
+		do
+		{
+			/* Wait until the required number of bytes are free in the message
+			buffer. */
+			taskENTER_CRITICAL();
+			{
+				xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+				if( xSpace < xRequiredSpace )
+				{
+					/* Clear notification state as going to wait for space. */
+					( void ) xTaskNotifyStateClear( NULL );
+
+					/* Should only be one writer. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+					pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+				}
+				else
+				{
+					taskEXIT_CRITICAL();
+					break;
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToSend = NULL;
+
+		} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xSpace == ( size_t ) 0 )
+	{
+		xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	#if( configUSE_STREAM_BUFFER_HOLD_TIME == 1 )
+	{
+		xStartsHold = prvStartHold( pxStreamBuffer, xTaskGetTickCount() );
+	}
+	#endif
+
+	xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+		/* Was a task waiting for the data? */
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETED( pxStreamBuffer );
+			sbNOTIFY_WAIT_ANY( pxStreamBuffer );
+		}
+		else if( xStartsHold != pdFALSE )
+		{
+			/* Below the trigger level, the reader only starts timing the
+			hold. */
+			sbSEND_COMPLETED( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+		traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
+								 const void *pvTxData,
+								 size_t xDataLengthBytes,
+								 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xReturn, xSpace;
+size_t xRequiredSpace = xDataLengthBytes;
+BaseType_t xStartsHold = pdFALSE;
+
+	configASSERT( pvTxData );
+	configASSERT( pxStreamBuffer );
+
+	/* This send function is used to write to both message buffers and stream
+	buffers.  If this is a message buffer then the space needed must be
+	increased by the amount of bytes needed to store the length of the
+	message. */
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_HEADER;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	#if( configUSE_STREAM_BUFFER_HOLD_TIME == 1 )
+	{
+		xStartsHold = prvStartHold( pxStreamBuffer, xTaskGetTickCountFromISR() );
+	}
+	#endif
+
+	xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+	xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		/* Was a task waiting for the data? */
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			sbNOTIFY_WAIT_ANY_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		}
+		else if( xStartsHold != pdFALSE )
+		{
+			/* Below the trigger level, the reader only starts timing the
+			hold. */
+			sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
+									   const void * pvTxData,
+									   size_t xDataLengthBytes,
+									   size_t xSpace,
+									   size_t xRequiredSpace )
+{
+	BaseType_t xShouldWrite;
+	size_t xReturn;
+
+	if( xSpace == ( size_t ) 0 )
+	{
+		/* Doesn't matter if this is a stream buffer or a message buffer, there
+		is no space to write. */
+		xShouldWrite = pdFALSE;
+	}
+	else if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 )
+	{
+		/* This is a stream buffer, as opposed to a message buffer, so writing a
+		stream of bytes rather than discrete messages.  Write as many bytes as
+		possible. */
+		xShouldWrite = pdTRUE;
+		xDataLengthBytes = configMIN( xDataLengthBytes, xSpace );
+	}
+	else if( xSpace >= xRequiredSpace )
+	{
+		/* This is a message buffer, as opposed to a stream buffer, and there
+		is enough space to write both the message length and the message itself
+		into the buffer.  Start by writing the length of the data, the data
+		itself will be written later in this function. */
+		xShouldWrite = pdTRUE;
+		( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH );
+
+		#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+		{
+			/* Then the time it is sent.  The reader only sees the message
+			once the data follows, as until then the bytes available do not
+			exceed the header. */
+			const MessageTimestamp_t xTimestamp = configMESSAGE_BUFFER_TIMESTAMP();
+			( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &xTimestamp, sbBYTES_TO_STORE_MESSAGE_TIMESTAMP );
+		}
+		#endif /* configUSE_MESSAGE_BUFFER_TIMESTAMPS */
+	}
+	else
+	{
+		/* There is space available, but not enough space. */
+		xShouldWrite = pdFALSE;
+	}
+
+	if( xShouldWrite != pdFALSE )
+	{
+		/* Writes the data itself. */
+		xReturn = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alighment and access. */
+	}
+	else
+	{
+		xReturn = 0;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
+							 void *pvRxData,
+							 size_t xBufferLengthBytes,
+							 TickType_t xTicksToWait )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
+
+	configASSERT( pvRxData );
+	configASSERT( pxStreamBuffer );
+
+	/* This receive function is used by both message buffers, which store
+	discrete messages, and stream buffers, which store a continuous stream of
+	bytes.  Discrete messages include an additional
+	sbBYTES_TO_STORE_MESSAGE_HEADER bytes that hold the length (and the send
+	time) of the message. */
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_HEADER;
+	}
+	else
+	{
+		xBytesToStoreMessageLength = 0;
+	}
+
+	#if( configUSE_STREAM_BUFFER_HOLD_TIME == 1 )
+	if( ( pxStreamBuffer->xHoldTicks != ( TickType_t ) 0 ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+	{
+		/* Only stream buffers have a hold time, so there is no length. */
+		xBytesAvailable = prvWaitForHeldBytes( pxStreamBuffer, xTicksToWait );
+	}
+	else
+	#endif /* configUSE_STREAM_BUFFER_HOLD_TIME */
+	if( xTicksToWait != ( TickType_t ) 0 )
+	{
+		/* Checking if there is data and clearing the notification state must be
+		performed atomically. */
+		taskENTER_CRITICAL();
+		{
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+			/* If this function was invoked by a message buffer read then
+			xBytesToStoreMessageLength holds the number of bytes used to hold
+			the length of the next discrete message.  If this function was
+			invoked by a stream buffer read then xBytesToStoreMessageLength will
+			be 0. */
+			if( xBytesAvailable <= xBytesToStoreMessageLength )
+			{
+				/* Clear notification state as going to wait for data. */
+				( void ) xTaskNotifyStateClear( NULL );
+
+				/* Should only be one reader. */
+				configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+				pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBytesAvailable <= xBytesToStoreMessageLength )
+		{
+			/* Wait for data to be available. */
+			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+			/* Recheck the data available after blocking. */
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+	}
+
+	/* Whether receiving a discrete message (where xBytesToStoreMessageLength
+	holds the number of bytes used to store the message length) or a stream of
+	bytes (where xBytesToStoreMessageLength is zero), the number of bytes
+	available must be greater than xBytesToStoreMessageLength to be able to
+	read bytes from the buffer. */
+	if( xBytesAvailable > xBytesToStoreMessageLength )
+	{
+		xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable, xBytesToStoreMessageLength );
+
+		/* Was a task waiting for space in the buffer? */
+		if( xReceivedLength != ( size_t ) 0 )
+		{
+			traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
+			sbRECEIVE_COMPLETED( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xReturn, xBytesAvailable, xOriginalTail;
+configMESSAGE_BUFFER_LENGTH_TYPE xTempReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	/* Ensure the stream buffer is being used as a message buffer. */
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+		if( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_HEADER )
+		{
+			/* The number of bytes available is greater than the number of bytes
+			required to hold the length of the next message, so another message
+			is available.  Return its length without removing the length bytes
+			from the buffer.  A copy of the tail is stored so the buffer can be
+			returned to its prior state as the message is not actually being
+			removed from the buffer. */
+			xOriginalTail = pxStreamBuffer->xTail;
+			( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempReturn, sbBYTES_TO_STORE_MESSAGE_LENGTH, xBytesAvailable );
+			xReturn = ( size_t ) xTempReturn;
+			pxStreamBuffer->xTail = xOriginalTail;
+		}
+		else
+		{
+			/* The minimum amount of bytes in a message buffer is
+			( sbBYTES_TO_STORE_MESSAGE_HEADER + 1 ), so if xBytesAvailable is
+			less than sbBYTES_TO_STORE_MESSAGE_HEADER the only other valid
+			value is 0. */
+			configASSERT( xBytesAvailable == 0 );
+			xReturn = 0;
+		}
+	}
+	else
+	{
+		xReturn = 0;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
+									void *pvRxData,
+									size_t xBufferLengthBytes,
+									BaseType_t * const pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
+
+	configASSERT( pvRxData );
+	configASSERT( pxStreamBuffer );
+
+	/* This receive function is used by both message buffers, which store
+	discrete messages, and stream buffers, which store a continuous stream of
+	bytes.  Discrete messages include an additional
+	sbBYTES_TO_STORE_MESSAGE_HEADER bytes that hold the length (and the send
+	time) of the message. */
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_HEADER;
+	}
+	else
+	{
+		xBytesToStoreMessageLength = 0;
+	}
+
+	xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+	/* Whether receiving a discrete message (where xBytesToStoreMessageLength
+	holds the number of bytes used to store the message length) or a stream of
+	bytes (where xBytesToStoreMessageLength is zero), the number of bytes
+	available must be greater than xBytesToStoreMessageLength to be able to
+	read bytes from the buffer. */
+	if( xBytesAvailable > xBytesToStoreMessageLength )
+	{
+		xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable, xBytesToStoreMessageLength );
+
+		/* Was a task waiting for space in the buffer? */
+		if( xReceivedLength != ( size_t ) 0 )
+		{
+			sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength );
+
+	return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadMessageFromBuffer( StreamBuffer_t *pxStreamBuffer,
+										void *pvRxData,
+										size_t xBufferLengthBytes,
+										size_t xBytesAvailable,
+										size_t xBytesToStoreMessageLength )
+{
+size_t xOriginalTail, xReceivedLength, xNextMessageLength;
+configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
+#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+	MessageTimestamp_t xTimestamp = 0;
+#endif
+
+	if( xBytesToStoreMessageLength != ( size_t ) 0 )
+	{
+		/* A discrete message is being received.  First receive the length
+		of the message.  A copy of the tail is stored so the buffer can be
+		returned to its prior state if the length of the message is too
+		large for the provided buffer. */
+		xOriginalTail = pxStreamBuffer->xTail;
+		( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xBytesAvailable );
+		xNextMessageLength = ( size_t ) xTempNextMessageLength;
+
+		#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+		{
+			/* Then the time the message was sent. */
+			( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTimestamp, sbBYTES_TO_STORE_MESSAGE_TIMESTAMP, xBytesAvailable - sbBYTES_TO_STORE_MESSAGE_LENGTH );
+		}
+		#endif /* configUSE_MESSAGE_BUFFER_TIMESTAMPS */
+
+		/* Reduce the number of bytes available by the number of bytes just
+		read out. */
+		xBytesAvailable -= xBytesToStoreMessageLength;
+
+		/* Check there is enough space in the buffer provided by the
+		user. */
+		if( xNextMessageLength > xBufferLengthBytes )
+		{
+			/* The user has provided insufficient space to read the message
+			so return the buffer to its previous state (so the length of
+			the message is in the buffer again). */
+			pxStreamBuffer->xTail = xOriginalTail;
+			xNextMessageLength = 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		/* A stream of bytes is being received (as opposed to a discrete
+		message), so read as many bytes as possible. */
+		xNextMessageLength = xBufferLengthBytes;
+	}
+
+	/* Read the actual data. */
+	xReceivedLength = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xNextMessageLength, xBytesAvailable ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+
+	#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+	{
+		if( ( xBytesToStoreMessageLength != ( size_t ) 0 ) && ( xReceivedLength != ( size_t ) 0 ) )
+		{
+			prvRecordMessageDelay( pxStreamBuffer, xTimestamp );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_MESSAGE_BUFFER_TIMESTAMPS */
+
+	return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
+{
+const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+BaseType_t xReturn;
+size_t xTail;
+
+	configASSERT( pxStreamBuffer );
+
+	/* True if no bytes are available. */
+	xTail = pxStreamBuffer->xTail;
+	if( pxStreamBuffer->xHead == xTail )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer )
+{
+BaseType_t xReturn;
+size_t xBytesToStoreMessageLength;
+const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+
+	/* This generic version of the receive function is used by both message
+	buffers, which store discrete messages, and stream buffers, which store a
+	continuous stream of bytes.  Discrete messages include an additional
+	sbBYTES_TO_STORE_MESSAGE_HEADER bytes that hold the length (and the send
+	time) of the message. */
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_HEADER;
+	}
+	else
+	{
+		xBytesToStoreMessageLength = 0;
+	}
+
+	/* True if the available space equals zero. */
+	if( xStreamBufferSpacesAvailable( xStreamBuffer ) <= xBytesToStoreMessageLength )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+BaseType_t xReturn;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxStreamBuffer );
+
+	uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )
+		{
+			( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToReceive,
+										 ( uint32_t ) 0,
+										 eNoAction,
+										 pxHigherPriorityTaskWoken );
+			( pxStreamBuffer )->xTaskWaitingToReceive = NULL;
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+BaseType_t xReturn;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxStreamBuffer );
+
+	uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )
+		{
+			( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToSend,
+										 ( uint32_t ) 0,
+										 eNoAction,
+										 pxHigherPriorityTaskWoken );
+			( pxStreamBuffer )->xTaskWaitingToSend = NULL;
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+								 void **ppvData,
+								 size_t xLengthBytes,
+								 TickType_t xTicksToWait )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn = 0, xSpace, xStart;
+	size_t xRequiredSpace = xLengthBytes;
+	TimeOut_t xTimeOut;
+
+		configASSERT( ppvData );
+		configASSERT( pxStreamBuffer );
+		configASSERT( xLengthBytes > ( size_t ) 0 );
+
+		*ppvData = NULL;
+
+		/* A message also needs room for its length, as in xStreamBufferSend(). */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_HEADER;
+
+			/* Overflow? */
+			configASSERT( xRequiredSpace > xLengthBytes );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xTicksToWait != ( TickType_t ) 0 )
+		{
+			vTaskSetTimeOutState( &xTimeOut );
+
+			do
+			{
+				/* Wait with the same condition as xStreamBufferSend(). */
+				taskENTER_CRITICAL();
+				{
+					xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+					if( xSpace < xRequiredSpace )
+					{
+						( void ) xTaskNotifyStateClear( NULL );
+
+						/* Should only be one writer. */
+						configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+						pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+					}
+					else
+					{
+						taskEXIT_CRITICAL();
+						break;
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+				( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+				pxStreamBuffer->xTaskWaitingToSend = NULL;
+
+			} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+		xStart = pxStreamBuffer->xHead;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			/* All or nothing: a message is only reserved if it fits in one
+			piece after its length, which may itself wrap. */
+			if( xSpace >= xRequiredSpace )
+			{
+				xStart += sbBYTES_TO_STORE_MESSAGE_HEADER;
+
+				if( xStart >= pxStreamBuffer->xLength )
+				{
+					xStart -= pxStreamBuffer->xLength;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( prvContiguousSpace( pxStreamBuffer, xStart ) >= xLengthBytes )
+				{
+					xReturn = xLengthBytes;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else if( xSpace > ( size_t ) 0 )
+		{
+			/* As many bytes as are free before the end of the storage area.
+			Once they are committed the rest is reserved from the start. */
+			xReturn = configMIN( prvContiguousSpace( pxStreamBuffer, xStart ), xLengthBytes );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xReturn > ( size_t ) 0 )
+		{
+			*ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ xStart ] );
+		}
+		else
+		{
+			traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer, size_t xLengthBytes )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn;
+	BaseType_t xStartsHold = pdFALSE;
+
+		configASSERT( pxStreamBuffer );
+
+		#if( configUSE_STREAM_BUFFER_HOLD_TIME == 1 )
+		{
+			xStartsHold = prvStartHold( pxStreamBuffer, xTaskGetTickCount() );
+		}
+		#endif
+
+		xReturn = prvCommitReservedBytes( pxStreamBuffer, xLengthBytes );
+
+		if( xReturn > ( size_t ) 0 )
+		{
+			traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+			/* Was a task waiting for the data? */
+			if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+			{
+				sbSEND_COMPLETED( pxStreamBuffer );
+				sbNOTIFY_WAIT_ANY( pxStreamBuffer );
+			}
+			else if( xStartsHold != pdFALSE )
+			{
+				/* Below the trigger level, the reader only starts timing
+				the hold. */
+				sbSEND_COMPLETED( pxStreamBuffer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+									   size_t xLengthBytes,
+									   BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn;
+	BaseType_t xStartsHold = pdFALSE;
+
+		configASSERT( pxStreamBuffer );
+
+		#if( configUSE_STREAM_BUFFER_HOLD_TIME == 1 )
+		{
+			xStartsHold = prvStartHold( pxStreamBuffer, xTaskGetTickCountFromISR() );
+		}
+		#endif
+
+		xReturn = prvCommitReservedBytes( pxStreamBuffer, xLengthBytes );
+
+		if( xReturn > ( size_t ) 0 )
+		{
+			/* Was a task waiting for the data? */
+			if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+			{
+				sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+				sbNOTIFY_WAIT_ANY_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			}
+			else if( xStartsHold != pdFALSE )
+			{
+				/* Below the trigger level, the reader only starts timing
+				the hold. */
+				sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	size_t xStreamBufferPeek( StreamBufferHandle_t xStreamBuffer,
+							  const void **ppvData,
+							  TickType_t xTicksToWait )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn = 0, xBytesAvailable, xBytesToStoreMessageLength, xTail;
+
+		configASSERT( ppvData );
+		configASSERT( pxStreamBuffer );
+
+		*ppvData = NULL;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_HEADER;
+		}
+		else
+		{
+			xBytesToStoreMessageLength = 0;
+		}
+
+		if( xTicksToWait != ( TickType_t ) 0 )
+		{
+			/* Wait with the same condition as xStreamBufferReceive(). */
+			taskENTER_CRITICAL();
+			{
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+				if( xBytesAvailable <= xBytesToStoreMessageLength )
+				{
+					( void ) xTaskNotifyStateClear( NULL );
+
+					/* Should only be one reader. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+					pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xBytesAvailable <= xBytesToStoreMessageLength )
+			{
+				traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+				( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+				pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+		}
+
+		if( xBytesAvailable > xBytesToStoreMessageLength )
+		{
+			xTail = pxStreamBuffer->xTail;
+
+			if( xBytesToStoreMessageLength != ( size_t ) 0 )
+			{
+				/* The whole next message.  One written by xStreamBufferSend()
+				may wrap, so it can only be received with a copy. */
+				xReturn = prvPeekMessageLength( pxStreamBuffer, &xTail );
+
+				if( xReturn <= ( pxStreamBuffer->xLength - xTail ) )
+				{
+					*ppvData = ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* As many bytes as are stored before the end of the storage
+				area.  Once they are consumed the rest is peeked from the
+				start. */
+				xReturn = configMIN( xBytesAvailable, pxStreamBuffer->xLength - xTail );
+				*ppvData = ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] );
+			}
+		}
+		else
+		{
+			traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer, size_t xLengthBytes )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn;
+
+		configASSERT( pxStreamBuffer );
+
+		xReturn = prvConsumePeekedBytes( pxStreamBuffer, xLengthBytes );
+
+		/* Was a task waiting for space in the buffer? */
+		if( xReturn > ( size_t ) 0 )
+		{
+			traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReturn );
+			sbRECEIVE_COMPLETED( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+										size_t xLengthBytes,
+										BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn;
+
+		configASSERT( pxStreamBuffer );
+
+		xReturn = prvConsumePeekedBytes( pxStreamBuffer, xLengthBytes );
+
+		/* Was a task waiting for space in the buffer? */
+		if( xReturn > ( size_t ) 0 )
+		{
+			sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReturn );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+
+	size_t xStreamBufferSendConcurrent( StreamBufferHandle_t xStreamBuffer,
+										const void *pvTxData,
+										size_t xDataLengthBytes )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn;
+	BaseType_t xPublished;
+
+		configASSERT( pvTxData );
+		configASSERT( pxStreamBuffer );
+
+		xReturn = prvSendConcurrent( pxStreamBuffer, pvTxData, xDataLengthBytes, &xPublished );
+
+		if( xReturn > ( size_t ) 0 )
+		{
+			traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+		}
+		else
+		{
+			traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+		}
+
+		/* Only the send that published wakes the reader, for the bytes of
+		all the sends it published. */
+		if( ( xPublished != pdFALSE ) && ( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes ) )
+		{
+			sbSEND_COMPLETED( pxStreamBuffer );
+			sbNOTIFY_WAIT_ANY( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+
+	size_t xStreamBufferSendConcurrentFromISR( StreamBufferHandle_t xStreamBuffer,
+											   const void *pvTxData,
+											   size_t xDataLengthBytes,
+											   BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn;
+	BaseType_t xPublished;
+
+		configASSERT( pvTxData );
+		configASSERT( pxStreamBuffer );
+
+		xReturn = prvSendConcurrent( pxStreamBuffer, pvTxData, xDataLengthBytes, &xPublished );
+
+		if( ( xPublished != pdFALSE ) && ( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes ) )
+		{
+			sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			sbNOTIFY_WAIT_ANY_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+	size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+							   const StreamBufferTxVector_t *pxVectors,
+							   UBaseType_t uxVectorCount,
+							   TickType_t xTicksToWait )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn, xSpace, xDataLengthBytes, xRequiredSpace;
+	TimeOut_t xTimeOut;
+	BaseType_t xStartsHold = pdFALSE;
+
+		configASSERT( ( pxVectors != NULL ) || ( uxVectorCount == ( UBaseType_t ) 0 ) );
+		configASSERT( pxStreamBuffer );
+
+		xDataLengthBytes = prvTxVectorLength( pxVectors, uxVectorCount );
+		xRequiredSpace = xDataLengthBytes;
+
+		/* A message also needs room for its length, as in xStreamBufferSend(). */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_HEADER;
+
+			/* Overflow? */
+			configASSERT( xRequiredSpace > xDataLengthBytes );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xTicksToWait != ( TickType_t ) 0 )
+		{
+			vTaskSetTimeOutState( &xTimeOut );
+
+			do
+			{
+				/* Wait with the same condition as xStreamBufferSend(), for
+				all the fragments. */
+				taskENTER_CRITICAL();
+				{
+					xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+					if( xSpace < xRequiredSpace )
+					{
+						( void ) xTaskNotifyStateClear( NULL );
+
+						/* Should only be one writer. */
+						configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+						pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+					}
+					else
+					{
+						taskEXIT_CRITICAL();
+						break;
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+				( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+				pxStreamBuffer->xTaskWaitingToSend = NULL;
+
+			} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+		#if( configUSE_STREAM_BUFFER_HOLD_TIME == 1 )
+		{
+			xStartsHold = prvStartHold( pxStreamBuffer, xTaskGetTickCount() );
+		}
+		#endif
+
+		xReturn = prvWriteVectorsToBuffer( pxStreamBuffer, pxVectors, uxVectorCount, xDataLengthBytes, xSpace, xRequiredSpace );
+
+		if( xReturn > ( size_t ) 0 )
+		{
+			traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+			/* Was a task waiting for the data? */
+			if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+			{
+				sbSEND_COMPLETED( pxStreamBuffer );
+				sbNOTIFY_WAIT_ANY( pxStreamBuffer );
+			}
+			else if( xStartsHold != pdFALSE )
+			{
+				/* Below the trigger level, the reader only starts timing
+				the hold. */
+				sbSEND_COMPLETED( pxStreamBuffer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+	size_t xStreamBufferSendVFromISR( StreamBufferHandle_t xStreamBuffer,
+									  const StreamBufferTxVector_t *pxVectors,
+									  UBaseType_t uxVectorCount,
+									  BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn, xSpace, xDataLengthBytes, xRequiredSpace;
+	BaseType_t xStartsHold = pdFALSE;
+
+		configASSERT( ( pxVectors != NULL ) || ( uxVectorCount == ( UBaseType_t ) 0 ) );
+		configASSERT( pxStreamBuffer );
+
+		xDataLengthBytes = prvTxVectorLength( pxVectors, uxVectorCount );
+		xRequiredSpace = xDataLengthBytes;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_HEADER;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if( configUSE_STREAM_BUFFER_HOLD_TIME == 1 )
+		{
+			xStartsHold = prvStartHold( pxStreamBuffer, xTaskGetTickCountFromISR() );
+		}
+		#endif
+
+		xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+		xReturn = prvWriteVectorsToBuffer( pxStreamBuffer, pxVectors, uxVectorCount, xDataLengthBytes, xSpace, xRequiredSpace );
+
+		if( xReturn > ( size_t ) 0 )
+		{
+			/* Was a task waiting for the data? */
+			if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+			{
+				sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+				sbNOTIFY_WAIT_ANY_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			}
+			else if( xStartsHold != pdFALSE )
+			{
+				/* Below the trigger level, the reader only starts timing
+				the hold. */
+				sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+	size_t xStreamBufferReceiveV( StreamBufferHandle_t xStreamBuffer,
+								  const StreamBufferRxVector_t *pxVectors,
+								  UBaseType_t uxVectorCount,
+								  TickType_t xTicksToWait )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
+
+		configASSERT( ( pxVectors != NULL ) || ( uxVectorCount == ( UBaseType_t ) 0 ) );
+		configASSERT( pxStreamBuffer );
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_HEADER;
+		}
+		else
+		{
+			xBytesToStoreMessageLength = 0;
+		}
+
+		/* Wait as xStreamBufferReceive() does. */
+		#if( configUSE_STREAM_BUFFER_HOLD_TIME == 1 )
+		if( ( pxStreamBuffer->xHoldTicks != ( TickType_t ) 0 ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+		{
+			xBytesAvailable = prvWaitForHeldBytes( pxStreamBuffer, xTicksToWait );
+		}
+		else
+		#endif /* configUSE_STREAM_BUFFER_HOLD_TIME */
+		if( xTicksToWait != ( TickType_t ) 0 )
+		{
+			taskENTER_CRITICAL();
+			{
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+				if( xBytesAvailable <= xBytesToStoreMessageLength )
+				{
+					( void ) xTaskNotifyStateClear( NULL );
+
+					/* Should only be one reader. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+					pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xBytesAvailable <= xBytesToStoreMessageLength )
+			{
+				traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+				( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+				pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+		}
+
+		if( xBytesAvailable > xBytesToStoreMessageLength )
+		{
+			xReceivedLength = prvReadMessageToVectors( pxStreamBuffer, pxVectors, uxVectorCount, xBytesAvailable, xBytesToStoreMessageLength );
+
+			/* Was a task waiting for space in the buffer? */
+			if( xReceivedLength != ( size_t ) 0 )
+			{
+				traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
+				sbRECEIVE_COMPLETED( pxStreamBuffer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+		}
+
+		return xReceivedLength;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+	size_t xStreamBufferReceiveVFromISR( StreamBufferHandle_t xStreamBuffer,
+										 const StreamBufferRxVector_t *pxVectors,
+										 UBaseType_t uxVectorCount,
+										 BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
+
+		configASSERT( ( pxVectors != NULL ) || ( uxVectorCount == ( UBaseType_t ) 0 ) );
+		configASSERT( pxStreamBuffer );
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_HEADER;
+		}
+		else
+		{
+			xBytesToStoreMessageLength = 0;
+		}
+
+		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+		if( xBytesAvailable > xBytesToStoreMessageLength )
+		{
+			xReceivedLength = prvReadMessageToVectors( pxStreamBuffer, pxVectors, uxVectorCount, xBytesAvailable, xBytesToStoreMessageLength );
+
+			/* Was a task waiting for space in the buffer? */
+			if( xReceivedLength != ( size_t ) 0 )
+			{
+				sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength );
+
+		return xReceivedLength;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount )
+{
+	pxStreamBuffer->xHead = prvCopyBytesToBuffer( pxStreamBuffer, pxStreamBuffer->xHead, pucData, xCount );
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCopyBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, size_t xIndex, const uint8_t *pucData, size_t xCount )
+{
+size_t xNextHead = xIndex, xFirstLength;
+
+	configASSERT( xCount > ( size_t ) 0 );
+
+	/* Calculate the number of bytes that can be added in the first write -
+	which may be less than the total number of bytes that need to be added if
+	the buffer will wrap back to the beginning. */
+	xFirstLength = configMIN( pxStreamBuffer->xLength - xNextHead, xCount );
+
+	/* Write as many bytes as can be written in the first write. */
+	configASSERT( ( xNextHead + xFirstLength ) <= pxStreamBuffer->xLength );
+	configSTREAM_BUFFER_COPY( ( void* ) ( &( pxStreamBuffer->pucBuffer[ xNextHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+	/* If the number of bytes written was less than the number that could be
+	written in the first write... */
+	if( xCount > xFirstLength )
+	{
+		/* ...then write the remaining bytes to the start of the buffer. */
+		configASSERT( ( xCount - xFirstLength ) <= pxStreamBuffer->xLength );
+		configSTREAM_BUFFER_COPY( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xNextHead += xCount;
+	if( xNextHead >= pxStreamBuffer->xLength )
+	{
+		xNextHead -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xNextHead;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer, uint8_t *pucData, size_t xMaxCount, size_t xBytesAvailable )
+{
+size_t xCount, xFirstLength, xNextTail;
+
+	/* Use the minimum of the wanted bytes and the available bytes. */
+	xCount = configMIN( xBytesAvailable, xMaxCount );
+
+	if( xCount > ( size_t ) 0 )
+	{
+		xNextTail = pxStreamBuffer->xTail;
+
+		/* Calculate the number of bytes that can be read - which may be
+		less than the number wanted if the data wraps around to the start of
+		the buffer. */
+		xFirstLength = configMIN( pxStreamBuffer->xLength - xNextTail, xCount );
+
+		/* Obtain the number of bytes it is possible to obtain in the first
+		read.  Asserts check bounds of read and write. */
+		configASSERT( xFirstLength <= xMaxCount );
+		configASSERT( ( xNextTail + xFirstLength ) <= pxStreamBuffer->xLength );
+		configSTREAM_BUFFER_COPY( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xNextTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+		/* If the total number of wanted bytes is greater than the number
+		that could be read in the first read... */
+		if( xCount > xFirstLength )
+		{
+			/*...then read the remaining bytes from the start of the buffer. */
+			configASSERT( xCount <= xMaxCount );
+			configSTREAM_BUFFER_COPY( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Move the tail pointer to effectively remove the data read from
+		the buffer. */
+		xNextTail += xCount;
+
+		if( xNextTail >= pxStreamBuffer->xLength )
+		{
+			xNextTail -= pxStreamBuffer->xLength;
+		}
+
+		pxStreamBuffer->xTail = xNextTail;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
+{
+/* Returns the distance between xTail and xHead. */
+size_t xCount;
+
+	xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
+	xCount -= pxStreamBuffer->xTail;
+	if ( xCount >= pxStreamBuffer->xLength )
+	{
+		xCount -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+
+	static size_t prvSendConcurrent( StreamBuffer_t * const pxStreamBuffer,
+									 const void *pvTxData,
+									 size_t xDataLengthBytes,
+									 BaseType_t * const pxPublished )
+	{
+	size_t xRequiredSpace = xDataLengthBytes, xSpace, xCount, xIndex;
+	uint32_t ulHead, ulNextHead;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_HEADER;
+
+			/* Overflow? */
+			configASSERT( xRequiredSpace > xDataLengthBytes );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Counted before the reservation, so a send that finishes first
+		leaves these bytes to this one to publish. */
+		( void ) Atomic_Increment_u32( &( pxStreamBuffer->ulWriters ) );
+
+		/* Move ulReserveHead past the bytes, unless another send moved it
+		first, in which case try again from where it now is.  The reader may
+		move xTail meanwhile, which only frees more space. */
+		do
+		{
+			ulHead = pxStreamBuffer->ulReserveHead;
+
+			xSpace = pxStreamBuffer->xLength + ( size_t ) ulHead - pxStreamBuffer->xTail;
+			if( xSpace >= pxStreamBuffer->xLength )
+			{
+				xSpace -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+			xSpace = pxStreamBuffer->xLength - xSpace - ( size_t ) 1;
+
+			if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 )
+			{
+				/* As many bytes as fit, as xStreamBufferSend(). */
+				xCount = configMIN( xDataLengthBytes, xSpace );
+			}
+			else if( xSpace >= xRequiredSpace )
+			{
+				xCount = xRequiredSpace;
+			}
+			else
+			{
+				xCount = 0;
+			}
+
+			if( xCount == ( size_t ) 0 )
+			{
+				break;
+			}
+
+			ulNextHead = ulHead + ( uint32_t ) xCount;
+			if( ulNextHead >= ( uint32_t ) pxStreamBuffer->xLength )
+			{
+				ulNextHead -= ( uint32_t ) pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		} while( Atomic_CompareAndSwap_u32( &( pxStreamBuffer->ulReserveHead ), ulNextHead, ulHead ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS );
+
+		/* The reserved bytes belong to this send alone, so they are copied in
+		while other sends copy theirs. */
+		if( xCount > ( size_t ) 0 )
+		{
+			xIndex = ( size_t ) ulHead;
+
+			if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+			{
+				xIndex = prvCopyBytesToBuffer( pxStreamBuffer, xIndex, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH );
+
+				#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+				{
+					const MessageTimestamp_t xTimestamp = configMESSAGE_BUFFER_TIMESTAMP();
+					xIndex = prvCopyBytesToBuffer( pxStreamBuffer, xIndex, ( const uint8_t * ) &xTimestamp, sbBYTES_TO_STORE_MESSAGE_TIMESTAMP );
+				}
+				#endif /* configUSE_MESSAGE_BUFFER_TIMESTAMPS */
+
+				xCount = xDataLengthBytes;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			( void ) prvCopyBytesToBuffer( pxStreamBuffer, xIndex, ( const uint8_t * ) pvTxData, xCount ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alighment and access. */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Even a send that reserved nothing may be the last one writing, and
+		have to publish the bytes of the others. */
+		*pxPublished = prvPublishConcurrentBytes( pxStreamBuffer );
+
+		return xCount;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+
+	static BaseType_t prvPublishConcurrentBytes( StreamBuffer_t * const pxStreamBuffer )
+	{
+	uint32_t ulHead, ulWriters;
+	BaseType_t xPublished = pdFALSE;
+
+		for( ;; )
+		{
+			/* Read before ulWriters: a send that reserved bytes up to here
+			has counted itself already. */
+			ulHead = pxStreamBuffer->ulReserveHead;
+			ulWriters = pxStreamBuffer->ulWriters;
+
+			if( ulWriters > ( uint32_t ) 1 )
+			{
+				/* Another send has not finished writing.  Leave these bytes
+				to it, unless it finishes first and leaves them to this one:
+				the compare and swap then fails and the count is read again. */
+				if( Atomic_CompareAndSwap_u32( &( pxStreamBuffer->ulWriters ), ulWriters - ( uint32_t ) 1, ulWriters ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+				{
+					break;
+				}
+				else
+				{
+					continue;
+				}
+			}
+
+			/* The only send left, so every byte reserved up to ulHead has
+			been written.  While this one is counted no other send publishes,
+			so xHead only moves forward. */
+			portMEMORY_BARRIER();
+
+			if( pxStreamBuffer->xHead != ( size_t ) ulHead )
+			{
+				pxStreamBuffer->xHead = ( size_t ) ulHead;
+				xPublished = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			( void ) Atomic_Decrement_u32( &( pxStreamBuffer->ulWriters ) );
+
+			/* A send that reserved bytes after ulHead was read may have left
+			them to this one.  Count this one again and publish them too. */
+			if( pxStreamBuffer->ulReserveHead == ulHead )
+			{
+				break;
+			}
+			else
+			{
+				( void ) Atomic_Increment_u32( &( pxStreamBuffer->ulWriters ) );
+			}
+		}
+
+		return xPublished;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+	static size_t prvTxVectorLength( const StreamBufferTxVector_t *pxVectors, UBaseType_t uxVectorCount )
+	{
+	size_t xLength = 0;
+	UBaseType_t x;
+
+		for( x = 0; x < uxVectorCount; x++ )
+		{
+			xLength += pxVectors[ x ].xLengthBytes;
+		}
+
+		return xLength;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+	static size_t prvRxVectorLength( const StreamBufferRxVector_t *pxVectors, UBaseType_t uxVectorCount )
+	{
+	size_t xLength = 0;
+	UBaseType_t x;
+
+		for( x = 0; x < uxVectorCount; x++ )
+		{
+			xLength += pxVectors[ x ].xLengthBytes;
+		}
+
+		return xLength;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+	static size_t prvWriteVectorsToBuffer( StreamBuffer_t * const pxStreamBuffer,
+										   const StreamBufferTxVector_t *pxVectors,
+										   UBaseType_t uxVectorCount,
+										   size_t xDataLengthBytes,
+										   size_t xSpace,
+										   size_t xRequiredSpace )
+	{
+	size_t xNextHead = pxStreamBuffer->xHead, xRemaining, xCount;
+	configMESSAGE_BUFFER_LENGTH_TYPE xTempLength;
+	UBaseType_t x;
+
+		if( ( xSpace == ( size_t ) 0 ) || ( xDataLengthBytes == ( size_t ) 0 ) )
+		{
+			return 0;
+		}
+		else if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 )
+		{
+			/* As many bytes as fit, as prvWriteMessageToBuffer(). */
+			xDataLengthBytes = configMIN( xDataLengthBytes, xSpace );
+		}
+		else if( xSpace >= xRequiredSpace )
+		{
+			/* One header for the fragments together. */
+			xTempLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes;
+			xNextHead = prvCopyBytesToBuffer( pxStreamBuffer, xNextHead, ( const uint8_t * ) &xTempLength, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+
+			#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+			{
+				const MessageTimestamp_t xTimestamp = configMESSAGE_BUFFER_TIMESTAMP();
+				xNextHead = prvCopyBytesToBuffer( pxStreamBuffer, xNextHead, ( const uint8_t * ) &xTimestamp, sbBYTES_TO_STORE_MESSAGE_TIMESTAMP );
+			}
+			#endif /* configUSE_MESSAGE_BUFFER_TIMESTAMPS */
+		}
+		else
+		{
+			/* There is space available, but not enough for the message. */
+			return 0;
+		}
+
+		xRemaining = xDataLengthBytes;
+
+		for( x = 0; ( x < uxVectorCount ) && ( xRemaining > ( size_t ) 0 ); x++ )
+		{
+			xCount = configMIN( pxVectors[ x ].xLengthBytes, xRemaining );
+
+			if( xCount > ( size_t ) 0 )
+			{
+				xNextHead = prvCopyBytesToBuffer( pxStreamBuffer, xNextHead, ( const uint8_t * ) pxVectors[ x ].pvData, xCount );
+				xRemaining -= xCount;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		/* The reader sees none of the fragments before it sees them all. */
+		pxStreamBuffer->xHead = xNextHead;
+
+		return xDataLengthBytes;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+	static size_t prvReadMessageToVectors( StreamBuffer_t *pxStreamBuffer,
+										   const StreamBufferRxVector_t *pxVectors,
+										   UBaseType_t uxVectorCount,
+										   size_t xBytesAvailable,
+										   size_t xBytesToStoreMessageLength )
+	{
+	size_t xOriginalTail, xBufferLengthBytes, xNextMessageLength, xReceivedLength = 0;
+	configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
+	UBaseType_t x;
+	#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+		MessageTimestamp_t xTimestamp = 0;
+	#endif
+
+		xBufferLengthBytes = prvRxVectorLength( pxVectors, uxVectorCount );
+
+		if( xBytesToStoreMessageLength != ( size_t ) 0 )
+		{
+			/* The header first, as prvReadMessageFromBuffer() reads it. */
+			xOriginalTail = pxStreamBuffer->xTail;
+			( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xBytesAvailable );
+			xNextMessageLength = ( size_t ) xTempNextMessageLength;
+
+			#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+			{
+				( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTimestamp, sbBYTES_TO_STORE_MESSAGE_TIMESTAMP, xBytesAvailable - sbBYTES_TO_STORE_MESSAGE_LENGTH );
+			}
+			#endif /* configUSE_MESSAGE_BUFFER_TIMESTAMPS */
+
+			xBytesAvailable -= xBytesToStoreMessageLength;
+
+			if( xNextMessageLength > xBufferLengthBytes )
+			{
+				/* The message does not fit in all the destinations together,
+				so leave it in the buffer. */
+				pxStreamBuffer->xTail = xOriginalTail;
+				xNextMessageLength = 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			xNextMessageLength = configMIN( xBufferLengthBytes, xBytesAvailable );
+		}
+
+		/* Fill each destination in turn. */
+		for( x = 0; ( x < uxVectorCount ) && ( xReceivedLength < xNextMessageLength ); x++ )
+		{
+			xReceivedLength += prvReadBytesFromBuffer( pxStreamBuffer,
+													   ( uint8_t * ) pxVectors[ x ].pvData,
+													   configMIN( pxVectors[ x ].xLengthBytes, xNextMessageLength - xReceivedLength ),
+													   xBytesAvailable - xReceivedLength );
+		}
+
+		#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+		{
+			if( ( xBytesToStoreMessageLength != ( size_t ) 0 ) && ( xReceivedLength != ( size_t ) 0 ) )
+			{
+				prvRecordMessageDelay( pxStreamBuffer, xTimestamp );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_MESSAGE_BUFFER_TIMESTAMPS */
+
+		return xReceivedLength;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_WAIT_ANY == 1 )
+
+	static BaseType_t prvStreamBufferIsReady( void *pvStreamBuffer )
+	{
+	const StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) pvStreamBuffer;
+	size_t xBytes;
+
+		xBytes = prvBytesInBuffer( pxStreamBuffer );
+
+		/* A message is only ever added whole, so any bytes in a message buffer
+		mean a message can be read. */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			return ( xBytes > ( size_t ) 0 ) ? pdTRUE : pdFALSE;
+		}
+		else
+		{
+			return ( ( xBytes > ( size_t ) 0 ) && ( xBytes >= pxStreamBuffer->xTriggerLevelBytes ) ) ? pdTRUE : pdFALSE;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxWaitAnyAddStreamBuffer( WaitAnyHandle_t xWaitAny, StreamBufferHandle_t xStreamBuffer )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	UBaseType_t uxReturn;
+
+		configASSERT( pxStreamBuffer );
+
+		taskENTER_CRITICAL();
+		{
+			/* Cannot be a member of more than one wait-any object. */
+			configASSERT( pxStreamBuffer->pxWaitAny == NULL );
+
+			uxReturn = uxWaitAnyAddMember( xWaitAny, pxStreamBuffer, prvStreamBufferIsReady );
+
+			if( uxReturn != ( UBaseType_t ) 0 )
+			{
+				pxStreamBuffer->pxWaitAny = xWaitAny;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_WAIT_ANY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	static size_t prvContiguousSpace( const StreamBuffer_t * const pxStreamBuffer, size_t xFrom )
+	{
+	size_t xCount;
+	const size_t xTail = pxStreamBuffer->xTail;
+
+		if( xTail > xFrom )
+		{
+			/* Up to, but not including, the byte before the tail, as the
+			buffer is never filled completely. */
+			xCount = xTail - xFrom - ( size_t ) 1;
+		}
+		else
+		{
+			/* Up to the end of the storage area, less one byte if the tail
+			is at its start. */
+			xCount = pxStreamBuffer->xLength - xFrom;
+
+			if( xTail == ( size_t ) 0 )
+			{
+				xCount -= ( size_t ) 1;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xCount;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	static size_t prvPeekMessageLength( const StreamBuffer_t * const pxStreamBuffer, size_t *pxIndex )
+	{
+	configMESSAGE_BUFFER_LENGTH_TYPE xTempLength;
+	uint8_t * const pucLength = ( uint8_t * ) &xTempLength;
+	size_t x, xIndex = *pxIndex;
+
+		/* Byte by byte, as the length itself may wrap. */
+		for( x = 0; x < sbBYTES_TO_STORE_MESSAGE_LENGTH; x++ )
+		{
+			pucLength[ x ] = pxStreamBuffer->pucBuffer[ xIndex ];
+
+			xIndex++;
+			if( xIndex >= pxStreamBuffer->xLength )
+			{
+				xIndex = 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+		{
+			/* Skip the time the message was sent. */
+			xIndex += sbBYTES_TO_STORE_MESSAGE_TIMESTAMP;
+			if( xIndex >= pxStreamBuffer->xLength )
+			{
+				xIndex -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_MESSAGE_BUFFER_TIMESTAMPS */
+
+		*pxIndex = xIndex;
+
+		return ( size_t ) xTempLength;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	static size_t prvCommitReservedBytes( StreamBuffer_t * const pxStreamBuffer, size_t xLengthBytes )
+	{
+	configMESSAGE_BUFFER_LENGTH_TYPE xTempLength;
+	const uint8_t * const pucLength = ( const uint8_t * ) &xTempLength;
+	size_t x, xNextHead;
+	#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+		MessageTimestamp_t xTimestamp;
+		const uint8_t * const pucTimestamp = ( const uint8_t * ) &xTimestamp;
+	#endif
+
+		/* Committing nothing abandons the reservation. */
+		if( xLengthBytes == ( size_t ) 0 )
+		{
+			return 0;
+		}
+
+		xNextHead = pxStreamBuffer->xHead;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			configASSERT( xStreamBufferSpacesAvailable( pxStreamBuffer ) >= ( xLengthBytes + sbBYTES_TO_STORE_MESSAGE_HEADER ) );
+
+			/* Write the length in front of the message.  The head only moves
+			once both are in place, so the reader never sees a length without
+			its message. */
+			xTempLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xLengthBytes;
+
+			for( x = 0; x < sbBYTES_TO_STORE_MESSAGE_LENGTH; x++ )
+			{
+				pxStreamBuffer->pucBuffer[ xNextHead ] = pucLength[ x ];
+
+				xNextHead++;
+				if( xNextHead >= pxStreamBuffer->xLength )
+				{
+					xNextHead = 0;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+			{
+				/* Then the time of the commit, as the message is only sent
+				now. */
+				xTimestamp = configMESSAGE_BUFFER_TIMESTAMP();
+
+				for( x = 0; x < sbBYTES_TO_STORE_MESSAGE_TIMESTAMP; x++ )
+				{
+					pxStreamBuffer->pucBuffer[ xNextHead ] = pucTimestamp[ x ];
+
+					xNextHead++;
+					if( xNextHead >= pxStreamBuffer->xLength )
+					{
+						xNextHead = 0;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			#endif /* configUSE_MESSAGE_BUFFER_TIMESTAMPS */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* No more than xStreamBufferReserve() returned. */
+		configASSERT( xLengthBytes <= prvContiguousSpace( pxStreamBuffer, xNextHead ) );
+
+		xNextHead += xLengthBytes;
+		if( xNextHead >= pxStreamBuffer->xLength )
+		{
+			xNextHead -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxStreamBuffer->xHead = xNextHead;
+
+		return xLengthBytes;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	static size_t prvConsumePeekedBytes( StreamBuffer_t * const pxStreamBuffer, size_t xLengthBytes )
+	{
+	size_t xNextTail, xBytesToRemove = xLengthBytes;
+
+		if( xLengthBytes == ( size_t ) 0 )
+		{
+			return 0;
+		}
+
+		xNextTail = pxStreamBuffer->xTail;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			/* Messages are consumed whole, length included. */
+			configASSERT( prvBytesInBuffer( pxStreamBuffer ) > sbBYTES_TO_STORE_MESSAGE_HEADER );
+			configASSERT( prvPeekMessageLength( pxStreamBuffer, &xNextTail ) == xLengthBytes );
+			xNextTail = pxStreamBuffer->xTail;
+			xBytesToRemove += sbBYTES_TO_STORE_MESSAGE_HEADER;
+
+			#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+			{
+				prvRecordMessageDelay( pxStreamBuffer, prvPeekMessageTimestamp( pxStreamBuffer, xNextTail ) );
+			}
+			#endif /* configUSE_MESSAGE_BUFFER_TIMESTAMPS */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		configASSERT( xBytesToRemove <= prvBytesInBuffer( pxStreamBuffer ) );
+
+		xNextTail += xBytesToRemove;
+		if( xNextTail >= pxStreamBuffer->xLength )
+		{
+			xNextTail -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxStreamBuffer->xTail = xNextTail;
+
+		return xLengthBytes;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_OBJECT_REGISTRY == 1 )
+
+	void vStreamBufferAddToRegistry( StreamBufferHandle_t xStreamBuffer, const char *pcName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+		configASSERT( pxStreamBuffer );
+		vRegistryAdd( &( pxStreamBuffer->xRegistryItem ), pcName );
+	}
+
+#endif /* configUSE_OBJECT_REGISTRY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_OBJECT_REGISTRY == 1 )
+
+	void vStreamBufferUnregister( StreamBufferHandle_t xStreamBuffer )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+		configASSERT( pxStreamBuffer );
+		vRegistryRemove( &( pxStreamBuffer->xRegistryItem ) );
+	}
+
+#endif /* configUSE_OBJECT_REGISTRY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_OBJECT_REGISTRY == 1 )
+
+	const char *pcStreamBufferGetName( StreamBufferHandle_t xStreamBuffer ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	{
+	const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+		configASSERT( pxStreamBuffer );
+
+		/* NULL while the stream buffer is not registered. */
+		return pxStreamBuffer->xRegistryItem.pcName;
+	}
+
+#endif /* configUSE_OBJECT_REGISTRY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_OBJECT_REGISTRY == 1 )
+
+	StreamBufferHandle_t xStreamBufferFindByName( const char *pcName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	{
+		configASSERT( pcName );
+		return ( StreamBufferHandle_t ) pvRegistryFind( pcName, registryTYPE_STREAM_BUFFER );
+	}
+
+#endif /* configUSE_OBJECT_REGISTRY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_HOLD_TIME == 1 )
+
+	static BaseType_t prvStartHold( StreamBuffer_t * const pxStreamBuffer, TickType_t xTickCount )
+	{
+	BaseType_t xReturn;
+
+		/* Stamped before the head moves, so the reader never sees the new
+		bytes with the time of older ones.  If the reader empties the buffer
+		meanwhile the bytes keep an older time, and are received early. */
+		if( ( pxStreamBuffer->xHoldTicks != ( TickType_t ) 0 ) && ( prvBytesInBuffer( pxStreamBuffer ) == ( size_t ) 0 ) )
+		{
+			pxStreamBuffer->xFirstByteTime = xTickCount;
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_HOLD_TIME */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_HOLD_TIME == 1 )
+
+	static size_t prvWaitForHeldBytes( StreamBuffer_t * const pxStreamBuffer, TickType_t xTicksToWait )
+	{
+	size_t xBytesAvailable;
+	TickType_t xHeldFor, xWait;
+	TimeOut_t xTimeOut;
+	BaseType_t xReady;
+
+		vTaskSetTimeOutState( &xTimeOut );
+
+		for( ;; )
+		{
+			xWait = xTicksToWait;
+			xReady = pdFALSE;
+
+			/* Checking the data and clearing the notification state must be
+			performed atomically, as in xStreamBufferReceive(). */
+			taskENTER_CRITICAL();
+			{
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+				if( xBytesAvailable >= pxStreamBuffer->xTriggerLevelBytes )
+				{
+					xReady = pdTRUE;
+				}
+				else if( xBytesAvailable > ( size_t ) 0 )
+				{
+					xHeldFor = xTaskGetTickCount() - pxStreamBuffer->xFirstByteTime;
+
+					if( xHeldFor >= pxStreamBuffer->xHoldTicks )
+					{
+						xReady = pdTRUE;
+					}
+					else
+					{
+						/* The block time runs out when the hold does, unless
+						the trigger level is reached first. */
+						xWait = configMIN( xWait, pxStreamBuffer->xHoldTicks - xHeldFor );
+					}
+				}
+				else
+				{
+					/* Empty: the first write wakes this task to time the
+					hold. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( xReady == pdFALSE )
+				{
+					( void ) xTaskNotifyStateClear( NULL );
+
+					/* Should only be one reader. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+					pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xReady != pdFALSE )
+			{
+				break;
+			}
+
+			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( pxStreamBuffer );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xWait );
+			pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+			{
+				/* Out of time: whatever is there, as without a hold time. */
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+				break;
+			}
+		}
+
+		return xBytesAvailable;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_HOLD_TIME */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+
+	static void prvRecordMessageDelay( StreamBuffer_t * const pxStreamBuffer, MessageTimestamp_t xTimestamp )
+	{
+	const MessageTimestamp_t xDelay = configMESSAGE_BUFFER_TIMESTAMP() - xTimestamp;
+	uint32_t ulDelay;
+	UBaseType_t uxBucket = 0, uxSavedInterruptStatus;
+
+		/* Over an hour saturates. */
+		if( xDelay > ( MessageTimestamp_t ) 0xffffffffUL )
+		{
+			ulDelay = 0xffffffffUL;
+		}
+		else
+		{
+			ulDelay = ( uint32_t ) xDelay;
+		}
+
+		/* Bucket 0 counts delays of 0, bucket n delays from 2^(n-1) to
+		2^n - 1 microseconds, and the last bucket every longer delay too. */
+		while( ( uxBucket < ( UBaseType_t ) ( configMESSAGE_BUFFER_DELAY_BUCKETS - 1 ) ) && ( ( ulDelay >> uxBucket ) != 0UL ) )
+		{
+			uxBucket++;
+		}
+
+		/* Masked as the statistics are also read and reset by other tasks,
+		and the reader may be an ISR. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			pxStreamBuffer->xLastTimestamp = xTimestamp;
+			( pxStreamBuffer->xDelayStats.ulMessages )++;
+			( pxStreamBuffer->xDelayStats.ulDelayHistogram[ uxBucket ] )++;
+
+			if( ulDelay > pxStreamBuffer->xDelayStats.ulMaxDelayUs )
+			{
+				pxStreamBuffer->xDelayStats.ulMaxDelayUs = ulDelay;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+#endif /* configUSE_MESSAGE_BUFFER_TIMESTAMPS */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 ) && ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 ) )
+
+	static MessageTimestamp_t prvPeekMessageTimestamp( const StreamBuffer_t * const pxStreamBuffer, size_t xIndex )
+	{
+	MessageTimestamp_t xTimestamp;
+	uint8_t * const pucTimestamp = ( uint8_t * ) &xTimestamp;
+	size_t x;
+
+		/* The stamp follows the length, and either may wrap. */
+		xIndex += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		if( xIndex >= pxStreamBuffer->xLength )
+		{
+			xIndex -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		for( x = 0; x < sbBYTES_TO_STORE_MESSAGE_TIMESTAMP; x++ )
+		{
+			pucTimestamp[ x ] = pxStreamBuffer->pucBuffer[ xIndex ];
+
+			xIndex++;
+			if( xIndex >= pxStreamBuffer->xLength )
+			{
+				xIndex = 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xTimestamp;
+	}
+
+#endif /* configUSE_MESSAGE_BUFFER_TIMESTAMPS && configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+
+	MessageTimestamp_t xStreamBufferGetLastTimestamp( StreamBufferHandle_t xStreamBuffer )
+	{
+	const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	MessageTimestamp_t xReturn;
+	UBaseType_t uxSavedInterruptStatus;
+
+		configASSERT( pxStreamBuffer );
+
+		/* 64 bits are not read in one access. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			xReturn = pxStreamBuffer->xLastTimestamp;
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MESSAGE_BUFFER_TIMESTAMPS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+
+	void vStreamBufferGetDelayStats( StreamBufferHandle_t xStreamBuffer, StreamBufferDelayStats_t *pxStats )
+	{
+	const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	UBaseType_t uxSavedInterruptStatus;
+
+		configASSERT( pxStreamBuffer );
+		configASSERT( pxStats );
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			*pxStats = pxStreamBuffer->xDelayStats;
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+#endif /* configUSE_MESSAGE_BUFFER_TIMESTAMPS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MESSAGE_BUFFER_TIMESTAMPS == 1 )
+
+	void vStreamBufferResetDelayStats( StreamBufferHandle_t xStreamBuffer )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	UBaseType_t uxSavedInterruptStatus;
+
+		configASSERT( pxStreamBuffer );
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			( void ) memset( ( void * ) &( pxStreamBuffer->xDelayStats ), 0x00, sizeof( pxStreamBuffer->xDelayStats ) ); /*lint !e9087 memset() requires void *. */
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+#endif /* configUSE_MESSAGE_BUFFER_TIMESTAMPS */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
+										  uint8_t * const pucBuffer,
+										  size_t xBufferSizeBytes,
+										  size_t xTriggerLevelBytes,
+										  uint8_t ucFlags )
+{
+	/* Assert here is deliberately writing to the entire buffer to ensure it can
+	be written to without generating exceptions, and is setting the buffer to a
+	known value to assist in development/debugging. */
+	#if( configASSERT_DEFINED == 1 )
+	{
+		/* The value written just has to be identifiable when looking at the
+		memory.  Don't use 0xA5 as that is the stack fill value and could
+		result in confusion as to what is actually being observed. */
+		const BaseType_t xWriteValue = 0x55;
+		configASSERT( memset( pucBuffer, ( int ) xWriteValue, xBufferSizeBytes ) == pucBuffer );
+	} /*lint !e529 !e438 xWriteValue is only used if configASSERT() is defined. */
+	#endif
+
+	( void ) memset( ( void * ) pxStreamBuffer, 0x00, sizeof( StreamBuffer_t ) ); /*lint !e9087 memset() requires void *. */
+	pxStreamBuffer->pucBuffer = pucBuffer;
+	pxStreamBuffer->xLength = xBufferSizeBytes;
+	pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
+	pxStreamBuffer->ucFlags = ucFlags;
+}
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	UBaseType_t uxStreamBufferGetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer )
+	{
+		return xStreamBuffer->uxStreamBufferNumber;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	void vStreamBufferSetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer, UBaseType_t uxStreamBufferNumber )
+	{
+		xStreamBuffer->uxStreamBufferNumber = uxStreamBufferNumber;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	uint8_t ucStreamBufferGetStreamBufferType( StreamBufferHandle_t xStreamBuffer )
+	{
+		return ( xStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER );
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
@@ -0,0 +1,1843 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+
+#if ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 0 )
+	#error configUSE_TIMERS must be set to 1 to make the xTimerPendFunctionCall() function available.
+#endif
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e9021 !e961 !e750. */
+
+
+/* This entire source file will be skipped if the application is not configured
+to include software timer functionality.  This #if is closed at the very bottom
+of this file.  If you want to include software timer functionality then ensure
+configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_TIMERS == 1 )
+
+/* Misc definitions. */
+#define tmrNO_DELAY		( TickType_t ) 0U
+
+/* The name assigned to the timer service task.  This can be overridden by
+defining trmTIMER_SERVICE_TASK_NAME in FreeRTOSConfig.h. */
+#ifndef configTIMER_SERVICE_TASK_NAME
+	#define configTIMER_SERVICE_TASK_NAME "Tmr Svc"
+#endif
+
+/* Bit definitions used in the ucStatus member of a timer structure. */
+#define tmrSTATUS_IS_ACTIVE					( ( uint8_t ) 0x01 )
+#define tmrSTATUS_IS_STATICALLY_ALLOCATED	( ( uint8_t ) 0x02 )
+#define tmrSTATUS_IS_AUTORELOAD				( ( uint8_t ) 0x04 )
+#define tmrSTATUS_WHEEL_ERA					( ( uint8_t ) 0x08 )
+
+#if( configUSE_TIMER_WHEEL == 1 )
+	#if( ( configTIMER_WHEEL_SLOTS & ( configTIMER_WHEEL_SLOTS - 1 ) ) != 0 )
+		#error configTIMER_WHEEL_SLOTS must be a power of two.
+	#endif
+
+	#define tmrWHEEL_SLOT_MASK	( ( TickType_t ) configTIMER_WHEEL_SLOTS - ( TickType_t ) 1 )
+#endif
+
+#if( configTIMER_DAEMONS < 1 ) || ( configTIMER_DAEMONS > 255 )
+	#error configTIMER_DAEMONS must be between 1 and 255.
+#endif
+
+/* The time callbacks are measured in for the daemon statistics. */
+#if( configUSE_TIMER_DAEMON_STATS == 1 )
+	#if( configGENERATE_RUN_TIME_STATS == 1 )
+		#define tmrGET_CALLBACK_TIME()	( ( configRUN_TIME_COUNTER_TYPE ) portGET_RUN_TIME_COUNTER_VALUE() )
+	#else
+		#define tmrGET_CALLBACK_TIME()	( ( configRUN_TIME_COUNTER_TYPE ) xTaskGetTickCount() )
+	#endif
+#endif
+
+/* The definition of the timers themselves. */
+typedef struct tmrTimerControl /* The old naming convention is used to prevent breaking kernel aware debuggers. */
+{
+	const char				*pcTimerName;		/*<< Text name.  This is not used by the kernel, it is included simply to make debugging easier. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	ListItem_t				xTimerListItem;		/*<< Standard linked list item as used by all kernel features for event management. */
+	TickType_t				xTimerPeriodInTicks;/*<< How quickly and often the timer expires. */
+	#if( configUSE_TIMER_SLACK == 1 )
+		TickType_t			xTimerSlack;		/*<< How late the callback may run so its daemon wakes for several timers at once, see vTimerSetSlack(). */
+	#endif
+	void 					*pvTimerID;			/*<< An ID to identify the timer.  This allows the timer to be identified when the same callback is used for multiple timers. */
+	TimerCallbackFunction_t	pxCallbackFunction;	/*<< The function that will be called when the timer expires. */
+	#if( configUSE_TRACE_FACILITY == 1 )
+		UBaseType_t			uxTimerNumber;		/*<< An ID assigned by trace tools such as FreeRTOS+Trace */
+	#endif
+	uint8_t 				ucStatus;			/*<< Holds bits to say if the timer was statically allocated or not, and if it is active or not. */
+	uint8_t					ucDaemon;			/*<< The timer service task that runs the timer, see vTimerSetDaemon(). */
+} xTIMER;
+
+/* The old xTIMER name is maintained above then typedefed to the new Timer_t
+name below to enable the use of older kernel aware debuggers. */
+typedef xTIMER Timer_t;
+
+/* The definition of messages that can be sent and received on the timer queue.
+Two types of message can be queued - messages that manipulate a software timer,
+and messages that request the execution of a non-timer related callback.  The
+two message types are defined in two separate structures, xTimerParametersType
+and xCallbackParametersType respectively. */
+typedef struct tmrTimerParameters
+{
+	TickType_t			xMessageValue;		/*<< An optional value used by a subset of commands, for example, when changing the period of a timer. */
+	Timer_t *			pxTimer;			/*<< The timer to which the command will be applied. */
+} TimerParameter_t;
+
+
+typedef struct tmrCallbackParameters
+{
+	PendedFunction_t	pxCallbackFunction;	/* << The callback function to execute. */
+	void *pvParameter1;						/* << The value that will be used as the callback functions first parameter. */
+	uint32_t ulParameter2;					/* << The value that will be used as the callback functions second parameter. */
+} CallbackParameters_t;
+
+/* The structure that contains the two message types, along with an identifier
+that is used to determine which message type is valid. */
+typedef struct tmrTimerQueueMessage
+{
+	BaseType_t			xMessageID;			/*<< The command being sent to the timer service task. */
+	union
+	{
+		TimerParameter_t xTimerParameters;
+
+		/* Don't include xCallbackParameters if it is not going to be used as
+		it makes the structure (and therefore the timer queue) larger. */
+		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
+			CallbackParameters_t xCallbackParameters;
+		#endif /* INCLUDE_xTimerPendFunctionCall */
+	} u;
+} DaemonTaskMessage_t;
+
+/* The state of one timer service task.  There are configTIMER_DAEMONS of them,
+each with its own priority, command queue and active timers, so a slow callback
+only delays the timers of its own daemon.  Daemon 0 is the one of
+configTIMER_TASK_PRIORITY, which also runs the pended function calls. */
+typedef struct tmrTimerDaemon
+{
+	/* The list in which active timers are stored.  Timers are referenced in
+	expire time order, with the nearest expiry time at the front of the list.
+	Only the timer service task is allowed to access these lists. */
+	#if( configUSE_TIMER_WHEEL == 0 )
+		List_t xActiveTimerList1;
+		List_t xActiveTimerList2;
+		List_t *pxCurrentTimerList;
+		List_t *pxOverflowTimerList;
+	#else
+		/* With configUSE_TIMER_WHEEL set the active timers are instead kept,
+		unsorted, in the wheel slot selected by the low bits of their expiry
+		time.  The two timer lists become two eras: a timer in the current era
+		expires before the tick count next overflows, one in the overflow era
+		after it.  The tmrSTATUS_WHEEL_ERA bit of ucStatus records the era of
+		each timer, so switching the lists is just a matter of flipping
+		ucCurrentTimerEra.  No active timer of the current era expires before
+		xTimerWheelCursor. */
+		List_t xTimerWheel[ configTIMER_WHEEL_SLOTS ];
+		UBaseType_t uxTimersInEra[ 2 ];
+		uint8_t ucCurrentTimerEra;
+		TickType_t xTimerWheelCursor;
+	#endif
+
+	/* A queue that is used to send commands to the timer service task. */
+	QueueHandle_t xTimerQueue;
+	TaskHandle_t xTimerTaskHandle;
+
+	/* The tick count when prvSampleTimeNow() last ran. */
+	TickType_t xLastTime;
+
+	#if( configUSE_TIMER_DAEMON_STATS == 1 )
+		TimerDaemonStats_t xStats;
+	#endif
+} TimerDaemon_t;
+
+/*lint -save -e956 A manual analysis and inspection has been used to determine
+which static variables must be declared volatile. */
+
+/* The daemons could be at function scope but that breaks some kernel aware
+debuggers, and debuggers that reply on removing the static qualifier. */
+PRIVILEGED_DATA static TimerDaemon_t xTimerDaemons[ configTIMER_DAEMONS ];
+
+/* Set once the daemons have been initialised. */
+PRIVILEGED_DATA static BaseType_t xTimerDaemonsInitialised = pdFALSE;
+
+/*lint -restore */
+
+/* The priority of each daemon. */
+static const UBaseType_t uxTimerDaemonPriorities[ configTIMER_DAEMONS ] = configTIMER_DAEMON_PRIORITIES;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/* If static allocation is supported then the application must provide the
+	following callback function - which enables the application to optionally
+	provide the memory that will be used by the timer task as the task's stack
+	and TCB. */
+	extern void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize );
+
+#endif
+
+/*
+ * Initialise the infrastructure used by the timer service task if it has not
+ * been initialised already.
+ */
+static void prvCheckForValidListAndQueue( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * The timer service task (daemon).  Timer functionality is controlled by this
+ * task.  Other tasks communicate with the timer service task using the
+ * xTimerQueue queue.
+ */
+static portTASK_FUNCTION_PROTO( prvTimerTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Creates the task of one timer service task.
+ */
+static BaseType_t prvCreateDaemonTask( const UBaseType_t uxDaemon ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the timer service task to interpret and process a command it
+ * received on the timer queue.
+ */
+static void prvProcessReceivedCommands( TimerDaemon_t * const pxDaemon ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
+ * depending on if the expire time causes a timer counter overflow.
+ */
+static BaseType_t prvInsertTimerInActiveList( TimerDaemon_t * const pxDaemon, Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * An active timer has reached its expire time.  Reload the timer if it is an
+ * auto-reload timer, then call its callback.
+ */
+static void prvProcessExpiredTimer( TimerDaemon_t * const pxDaemon, const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Call the callback of an expired timer, timing it if
+ * configUSE_TIMER_DAEMON_STATS is 1.
+ */
+static void prvCallTimerCallback( TimerDaemon_t * const pxDaemon, Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TIMER_DAEMON_STATS == 1 )
+
+	/*
+	 * Account for a callback that started at xStartTime.
+	 */
+	static void prvRecordCallbackTime( TimerDaemon_t * const pxDaemon, const configRUN_TIME_COUNTER_TYPE xStartTime ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * The tick count has overflowed.  Switch the timer lists after ensuring the
+ * current timer list does not still reference some timers.  Not needed with
+ * configUSE_64_BIT_TICKS, as the tick count never overflows.
+ */
+#if( configUSE_64_BIT_TICKS == 0 )
+	static void prvSwitchTimerLists( TimerDaemon_t * const pxDaemon ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
+ * if a tick count overflow occurred since prvSampleTimeNow() was last called.
+ */
+static TickType_t prvSampleTimeNow( TimerDaemon_t * const pxDaemon, BaseType_t * const pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
+
+/*
+ * If the timer list contains any active timers then return the expire time of
+ * the timer that will expire first and set *pxListWasEmpty to false.  If the
+ * timer list does not contain any timers then return 0 and set *pxListWasEmpty
+ * to pdTRUE.
+ */
+static TickType_t prvGetNextExpireTime( TimerDaemon_t * const pxDaemon, BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TIMER_SLACK == 1 )
+
+	/*
+	 * Returns the latest tick the timer service task can sleep until without
+	 * running any timer later than its expiry time plus its slack.
+	 * xNextExpireTime is the earliest expiry time, in the current list.
+	 */
+	static TickType_t prvGetCoalescedWakeTime( TimerDaemon_t * const pxDaemon, const TickType_t xNextExpireTime ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The expiry time of a timer plus its slack, clamped to the current tick
+	 * count era.
+	 */
+	static TickType_t prvGetTimerDeadline( const Timer_t * const pxTimer, const TickType_t xExpiryTime ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * If a timer has expired, process it.  Otherwise, block the timer service task
+ * until either a timer does expire or a command is received.
+ */
+static void prvProcessTimerOrBlockTask( TimerDaemon_t * const pxDaemon, const TickType_t xNextExpireTime, BaseType_t xListWasEmpty ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called after a Timer_t structure has been allocated either statically or
+ * dynamically to fill in the structure's members.
+ */
+static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+									const TickType_t xTimerPeriodInTicks,
+									const UBaseType_t uxAutoReload,
+									void * const pvTimerID,
+									TimerCallbackFunction_t pxCallbackFunction,
+									Timer_t *pxNewTimer ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	/*
+	 * Add the timer to the wheel slot of its expiry time, in the current era
+	 * or, if xInOverflowEra is pdTRUE, in the overflow era.
+	 */
+	static void prvWheelInsert( TimerDaemon_t * const pxDaemon, Timer_t * const pxTimer, const BaseType_t xInOverflowEra ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Remove the timer from its wheel slot.
+	 */
+	static void prvWheelRemove( TimerDaemon_t * const pxDaemon, Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return the timer of the current era that will expire first, or NULL if
+	 * the current era contains no timers.
+	 */
+	static Timer_t *prvWheelGetNextTimer( TimerDaemon_t * const pxDaemon ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerCreateTimerTask( void )
+{
+BaseType_t xReturn = pdPASS;
+UBaseType_t uxDaemon;
+
+	/* This function is called when the scheduler is started if
+	configUSE_TIMERS is set to 1.  Check that the infrastructure used by the
+	timer service tasks has been created/initialised.  If timers have already
+	been created then the initialisation will already have been performed. */
+	prvCheckForValidListAndQueue();
+
+	for( uxDaemon = ( UBaseType_t ) 0; uxDaemon < ( UBaseType_t ) configTIMER_DAEMONS; uxDaemon++ )
+	{
+		if( prvCreateDaemonTask( uxDaemon ) == pdFAIL )
+		{
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	configASSERT( xReturn );
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCreateDaemonTask( const UBaseType_t uxDaemon )
+{
+TimerDaemon_t * const pxDaemon = &( xTimerDaemons[ uxDaemon ] );
+BaseType_t xReturn = pdFAIL;
+
+	/* Daemon 0 keeps the name it always had. */
+	#if( configTIMER_DAEMONS > 1 )
+		static const char * const pcDaemonNames[ 2 ] = { configTIMER_SERVICE_TASK_NAME, configTIMER_SERVICE_TASK_NAME " N" };
+		const char * const pcName = pcDaemonNames[ ( uxDaemon == ( UBaseType_t ) 0 ) ? 0 : 1 ];
+	#else
+		const char * const pcName = configTIMER_SERVICE_TASK_NAME;
+	#endif
+
+	if( pxDaemon->xTimerQueue != NULL )
+	{
+		#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+			StaticTask_t *pxTimerTaskTCBBuffer = NULL;
+			StackType_t *pxTimerTaskStackBuffer = NULL;
+			uint32_t ulTimerTaskStackSize;
+
+			#if( configTIMER_DAEMONS > 1 )
+				/* The extra daemons are allocated statically here, in case
+				configSUPPORT_DYNAMIC_ALLOCATION is 0, as their queues are. */
+				static StaticTask_t xStaticDaemonTCBs[ configTIMER_DAEMONS - 1 ]; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+				static StackType_t xStaticDaemonStacks[ configTIMER_DAEMONS - 1 ][ configTIMER_TASK_STACK_DEPTH ]; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+			#endif
+
+			if( uxDaemon == ( UBaseType_t ) 0 )
+			{
+				vApplicationGetTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &ulTimerTaskStackSize );
+			}
+			#if( configTIMER_DAEMONS > 1 )
+			else
+			{
+				pxTimerTaskTCBBuffer = &( xStaticDaemonTCBs[ uxDaemon - 1U ] );
+				pxTimerTaskStackBuffer = &( xStaticDaemonStacks[ uxDaemon - 1U ][ 0 ] );
+				ulTimerTaskStackSize = ( uint32_t ) configTIMER_TASK_STACK_DEPTH;
+			}
+			#endif
+
+			pxDaemon->xTimerTaskHandle = xTaskCreateStatic(	prvTimerTask,
+															pcName,
+															ulTimerTaskStackSize,
+															( void * ) pxDaemon,
+															uxTimerDaemonPriorities[ uxDaemon ] | portPRIVILEGE_BIT,
+															pxTimerTaskStackBuffer,
+															pxTimerTaskTCBBuffer );
+
+			if( pxDaemon->xTimerTaskHandle != NULL )
+			{
+				xReturn = pdPASS;
+			}
+		}
+		#else
+		{
+			xReturn = xTaskCreate(	prvTimerTask,
+									pcName,
+									configTIMER_TASK_STACK_DEPTH,
+									( void * ) pxDaemon,
+									uxTimerDaemonPriorities[ uxDaemon ] | portPRIVILEGE_BIT,
+									&( pxDaemon->xTimerTaskHandle ) );
+		}
+		#endif /* configSUPPORT_STATIC_ALLOCATION */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	TimerHandle_t xTimerCreate(	const char * const pcTimerName,			/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+								const TickType_t xTimerPeriodInTicks,
+								const UBaseType_t uxAutoReload,
+								void * const pvTimerID,
+								TimerCallbackFunction_t pxCallbackFunction )
+	{
+	Timer_t *pxNewTimer;
+
+		pxNewTimer = ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of Timer_t is always a pointer to the timer's mame. */
+
+		if( pxNewTimer != NULL )
+		{
+			/* Status is thus far zero as the timer is not created statically
+			and has not been started.  The auto-reload bit may get set in
+			prvInitialiseNewTimer. */
+			pxNewTimer->ucStatus = 0x00;
+			prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction, pxNewTimer );
+		}
+
+		return pxNewTimer;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	TimerHandle_t xTimerCreateStatic(	const char * const pcTimerName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+										const TickType_t xTimerPeriodInTicks,
+										const UBaseType_t uxAutoReload,
+										void * const pvTimerID,
+										TimerCallbackFunction_t pxCallbackFunction,
+										StaticTimer_t *pxTimerBuffer )
+	{
+	Timer_t *pxNewTimer;
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticTimer_t equals the size of the real timer
+			structure. */
+			volatile size_t xSize = sizeof( StaticTimer_t );
+			configASSERT( xSize == sizeof( Timer_t ) );
+			( void ) xSize; /* Keeps lint quiet when configASSERT() is not defined. */
+		}
+		#endif /* configASSERT_DEFINED */
+
+		/* A pointer to a StaticTimer_t structure MUST be provided, use it. */
+		configASSERT( pxTimerBuffer );
+		pxNewTimer = ( Timer_t * ) pxTimerBuffer; /*lint !e740 !e9087 StaticTimer_t is a pointer to a Timer_t, so guaranteed to be aligned and sized correctly (checked by an assert()), so this is safe. */
+
+		if( pxNewTimer != NULL )
+		{
+			/* Timers can be created statically or dynamically so note this
+			timer was created statically in case it is later deleted.  The
+			auto-reload bit may get set in prvInitialiseNewTimer(). */
+			pxNewTimer->ucStatus = tmrSTATUS_IS_STATICALLY_ALLOCATED;
+
+			prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction, pxNewTimer );
+		}
+
+		return pxNewTimer;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+									const TickType_t xTimerPeriodInTicks,
+									const UBaseType_t uxAutoReload,
+									void * const pvTimerID,
+									TimerCallbackFunction_t pxCallbackFunction,
+									Timer_t *pxNewTimer )
+{
+	/* 0 is not a valid value for xTimerPeriodInTicks. */
+	configASSERT( ( xTimerPeriodInTicks > 0 ) );
+
+	if( pxNewTimer != NULL )
+	{
+		/* Ensure the infrastructure used by the timer service task has been
+		created/initialised. */
+		prvCheckForValidListAndQueue();
+
+		/* Initialise the timer structure members using the function
+		parameters. */
+		pxNewTimer->pcTimerName = pcTimerName;
+		pxNewTimer->xTimerPeriodInTicks = xTimerPeriodInTicks;
+		pxNewTimer->pvTimerID = pvTimerID;
+		pxNewTimer->pxCallbackFunction = pxCallbackFunction;
+		pxNewTimer->ucDaemon = ( uint8_t ) 0;
+		#if( configUSE_TIMER_SLACK == 1 )
+		{
+			pxNewTimer->xTimerSlack = ( TickType_t ) 0U;
+		}
+		#endif
+		vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+		if( uxAutoReload != pdFALSE )
+		{
+			pxNewTimer->ucStatus |= tmrSTATUS_IS_AUTORELOAD;
+		}
+		traceTIMER_CREATE( pxNewTimer );
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerGenericCommand( TimerHandle_t xTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait )
+{
+BaseType_t xReturn = pdFAIL;
+DaemonTaskMessage_t xMessage;
+QueueHandle_t xTimerQueue;
+
+	configASSERT( xTimer );
+
+	/* Send a message to the timer service task of the timer to perform a
+	particular action on a particular timer definition. */
+	xTimerQueue = xTimerDaemons[ xTimer->ucDaemon ].xTimerQueue;
+
+	if( xTimerQueue != NULL )
+	{
+		/* Send a command to the timer service task to start the xTimer timer. */
+		xMessage.xMessageID = xCommandID;
+		xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
+		xMessage.u.xTimerParameters.pxTimer = xTimer;
+
+		if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+		{
+			if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+			{
+				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+			}
+			else
+			{
+				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+			}
+		}
+		else
+		{
+			xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+		}
+
+		traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xTimerGetTimerDaemonTaskHandle( void )
+{
+	return xTimerGetDaemonTaskHandle( ( UBaseType_t ) 0 );
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xTimerGetDaemonTaskHandle( UBaseType_t uxDaemon )
+{
+	configASSERT( uxDaemon < ( UBaseType_t ) configTIMER_DAEMONS );
+
+	/* If xTimerGetDaemonTaskHandle() is called before the scheduler has been
+	started, then xTimerTaskHandle will be NULL. */
+	configASSERT( ( xTimerDaemons[ uxDaemon ].xTimerTaskHandle != NULL ) );
+	return xTimerDaemons[ uxDaemon ].xTimerTaskHandle;
+}
+/*-----------------------------------------------------------*/
+
+void vTimerSetDaemon( TimerHandle_t xTimer, UBaseType_t uxDaemon )
+{
+Timer_t *pxTimer = xTimer;
+
+	configASSERT( xTimer );
+	configASSERT( uxDaemon < ( UBaseType_t ) configTIMER_DAEMONS );
+
+	taskENTER_CRITICAL();
+	{
+		/* The active lists of the old daemon must no longer reference the
+		timer. */
+		configASSERT( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) == 0 );
+		configASSERT( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) != pdFALSE );
+		pxTimer->ucDaemon = ( uint8_t ) uxDaemon;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxTimerGetDaemon( TimerHandle_t xTimer )
+{
+Timer_t *pxTimer = xTimer;
+
+	configASSERT( xTimer );
+	return ( UBaseType_t ) pxTimer->ucDaemon;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_DAEMON_STATS == 1 )
+
+	void vTimerGetDaemonStats( UBaseType_t uxDaemon, TimerDaemonStats_t *pxStats )
+	{
+		configASSERT( uxDaemon < ( UBaseType_t ) configTIMER_DAEMONS );
+		configASSERT( pxStats );
+
+		taskENTER_CRITICAL();
+		{
+			*pxStats = xTimerDaemons[ uxDaemon ].xStats;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TIMER_DAEMON_STATS */
+/*-----------------------------------------------------------*/
+
+TickType_t xTimerGetPeriod( TimerHandle_t xTimer )
+{
+Timer_t *pxTimer = xTimer;
+
+	configASSERT( xTimer );
+	return pxTimer->xTimerPeriodInTicks;
+}
+/*-----------------------------------------------------------*/
+
+void vTimerSetReloadMode( TimerHandle_t xTimer, const UBaseType_t uxAutoReload )
+{
+Timer_t * pxTimer =  xTimer;
+
+	configASSERT( xTimer );
+	taskENTER_CRITICAL();
+	{
+		if( uxAutoReload != pdFALSE )
+		{
+			pxTimer->ucStatus |= tmrSTATUS_IS_AUTORELOAD;
+		}
+		else
+		{
+			pxTimer->ucStatus &= ~tmrSTATUS_IS_AUTORELOAD;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxTimerGetReloadMode( TimerHandle_t xTimer )
+{
+Timer_t * pxTimer =  xTimer;
+UBaseType_t uxReturn;
+
+	configASSERT( xTimer );
+	taskENTER_CRITICAL();
+	{
+		if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) == 0 )
+		{
+			/* Not an auto-reload timer. */
+			uxReturn = ( UBaseType_t ) pdFALSE;
+		}
+		else
+		{
+			/* Is an auto-reload timer. */
+			uxReturn = ( UBaseType_t ) pdTRUE;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_SLACK == 1 )
+
+	void vTimerSetSlack( TimerHandle_t xTimer, const TickType_t xSlack )
+	{
+	Timer_t *pxTimer = xTimer;
+
+		configASSERT( xTimer );
+
+		/* Only the timer service task reads the slack, when it next computes
+		how long to block for. */
+		taskENTER_CRITICAL();
+		{
+			pxTimer->xTimerSlack = xSlack;
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	TickType_t xTimerGetSlack( TimerHandle_t xTimer )
+	{
+	Timer_t *pxTimer = xTimer;
+
+		configASSERT( xTimer );
+		return pxTimer->xTimerSlack;
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TIMER_SLACK */
+
+
+TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer )
+{
+Timer_t * pxTimer =  xTimer;
+TickType_t xReturn;
+
+	configASSERT( xTimer );
+	xReturn = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+const char * pcTimerGetName( TimerHandle_t xTimer ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+{
+Timer_t *pxTimer = xTimer;
+
+	configASSERT( xTimer );
+	return pxTimer->pcTimerName;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessExpiredTimer( TimerDaemon_t * const pxDaemon, const TickType_t xNextExpireTime, const TickType_t xTimeNow )
+{
+BaseType_t xResult;
+#if( configUSE_TIMER_WHEEL == 1 )
+	Timer_t * const pxTimer = prvWheelGetNextTimer( pxDaemon );
+#else
+	Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDaemon->pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+#endif
+
+	/* Remove the timer from the list of active timers.  A check has already
+	been performed to ensure the list is not empty. */
+	#if( configUSE_TIMER_WHEEL == 1 )
+	{
+		prvWheelRemove( pxDaemon, pxTimer );
+	}
+	#else
+	{
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+	}
+	#endif
+	traceTIMER_EXPIRED( pxTimer );
+
+	/* If the timer is an auto-reload timer then calculate the next
+	expiry time and re-insert the timer in the list of active timers. */
+	if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+	{
+		/* The timer is inserted into a list using a time relative to anything
+		other than the current time.  It will therefore be inserted into the
+		correct list relative to the time this task thinks it is now. */
+		if( prvInsertTimerInActiveList( pxDaemon, pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) != pdFALSE )
+		{
+			/* The timer expired before it was added to the active timer
+			list.  Reload it now.  */
+			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
+			configASSERT( xResult );
+			( void ) xResult;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Call the timer callback. */
+	prvCallTimerCallback( pxDaemon, pxTimer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCallTimerCallback( TimerDaemon_t * const pxDaemon, Timer_t * const pxTimer )
+{
+	#if( configUSE_TIMER_DAEMON_STATS == 1 )
+	{
+		const configRUN_TIME_COUNTER_TYPE xStartTime = tmrGET_CALLBACK_TIME();
+
+		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+		prvRecordCallbackTime( pxDaemon, xStartTime );
+	}
+	#else
+	{
+		( void ) pxDaemon;
+		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_DAEMON_STATS == 1 )
+
+	static void prvRecordCallbackTime( TimerDaemon_t * const pxDaemon, const configRUN_TIME_COUNTER_TYPE xStartTime )
+	{
+	const configRUN_TIME_COUNTER_TYPE xDuration = tmrGET_CALLBACK_TIME() - xStartTime;
+
+		/* Only this daemon writes its statistics, but vTimerGetDaemonStats()
+		may read them from another task. */
+		taskENTER_CRITICAL();
+		{
+			( pxDaemon->xStats.ulCallbacks )++;
+			pxDaemon->xStats.xTotalCallbackTime += xDuration;
+
+			if( xDuration > pxDaemon->xStats.xMaxCallbackTime )
+			{
+				pxDaemon->xStats.xMaxCallbackTime = xDuration;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TIMER_DAEMON_STATS */
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvTimerTask, pvParameters )
+{
+TickType_t xNextExpireTime;
+BaseType_t xListWasEmpty;
+TimerDaemon_t * const pxDaemon = ( TimerDaemon_t * ) pvParameters;
+
+	#if( configUSE_DAEMON_TASK_STARTUP_HOOK == 1 )
+	if( pxDaemon == &( xTimerDaemons[ 0 ] ) )
+	{
+		extern void vApplicationDaemonTaskStartupHook( void );
+
+		/* Allow the application writer to execute some code in the context of
+		this task at the point the task starts executing.  This is useful if the
+		application includes initialisation code that would benefit from
+		executing after the scheduler has been started. */
+		vApplicationDaemonTaskStartupHook();
+	}
+	#endif /* configUSE_DAEMON_TASK_STARTUP_HOOK */
+
+	for( ;; )
+	{
+		/* Query the timers list to see if it contains any timers, and if so,
+		obtain the time at which the next timer will expire. */
+		xNextExpireTime = prvGetNextExpireTime( pxDaemon, &xListWasEmpty );
+
+		/* If a timer has expired, process it.  Otherwise, block this task
+		until either a timer does expire, or a command is received. */
+		prvProcessTimerOrBlockTask( pxDaemon, xNextExpireTime, xListWasEmpty );
+
+		/* Empty the command queue. */
+		prvProcessReceivedCommands( pxDaemon );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessTimerOrBlockTask( TimerDaemon_t * const pxDaemon, const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
+{
+TickType_t xTimeNow;
+TickType_t xWakeTime;
+BaseType_t xTimerListsWereSwitched;
+
+	vTaskSuspendAll();
+	{
+		/* Obtain the time now to make an assessment as to whether the timer
+		has expired or not.  If obtaining the time causes the lists to switch
+		then don't process this timer as any timers that remained in the list
+		when the lists were switched will have been processed within the
+		prvSampleTimeNow() function. */
+		xTimeNow = prvSampleTimeNow( pxDaemon, &xTimerListsWereSwitched );
+		if( xTimerListsWereSwitched == pdFALSE )
+		{
+			/* The tick count has not overflowed, has the timer expired? */
+			if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+			{
+				( void ) xTaskResumeAll();
+				prvProcessExpiredTimer( pxDaemon, xNextExpireTime, xTimeNow );
+			}
+			else
+			{
+				/* The tick count has not overflowed, and the next expire
+				time has not been reached yet.  This task should therefore
+				block to wait for the next expire time or a command to be
+				received - whichever comes first.  The following line cannot
+				be reached unless xNextExpireTime > xTimeNow, except in the
+				case when the current timer list is empty. */
+				xWakeTime = xNextExpireTime;
+
+				if( xListWasEmpty != pdFALSE )
+				{
+					/* The current timer list is empty - is the overflow list
+					also empty? */
+					#if( configUSE_TIMER_WHEEL == 1 )
+					{
+						xListWasEmpty = ( pxDaemon->uxTimersInEra[ pxDaemon->ucCurrentTimerEra ^ 1U ] == ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+					}
+					#else
+					{
+						xListWasEmpty = listLIST_IS_EMPTY( pxDaemon->pxOverflowTimerList );
+					}
+					#endif
+				}
+				#if( configUSE_TIMER_SLACK == 1 )
+				else
+				{
+					/* Sleep on past the next expiry time while the slack of
+					every timer allows it, so that timers expiring close
+					together are run by one wakeup.  The longer block also
+					lengthens the expected idle time in tickless idle. */
+					xWakeTime = prvGetCoalescedWakeTime( pxDaemon, xNextExpireTime );
+				}
+				#endif
+
+				vQueueWaitForMessageRestricted( pxDaemon->xTimerQueue, ( xWakeTime - xTimeNow ), xListWasEmpty );
+
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					/* Yield to wait for either a command to arrive, or the
+					block time to expire.  If a command arrived between the
+					critical section being exited and this yield then the yield
+					will not cause the task to block. */
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			( void ) xTaskResumeAll();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvGetNextExpireTime( TimerDaemon_t * const pxDaemon, BaseType_t * const pxListWasEmpty )
+{
+TickType_t xNextExpireTime;
+#if( configUSE_TIMER_WHEEL == 1 )
+	Timer_t *pxNextTimer;
+#endif
+
+	/* Timers are listed in expiry time order, with the head of the list
+	referencing the task that will expire first.  Obtain the time at which
+	the timer with the nearest expiry time will expire.  If there are no
+	active timers then just set the next expire time to 0.  That will cause
+	this task to unblock when the tick count overflows, at which point the
+	timer lists will be switched and the next expiry time can be
+	re-assessed.  */
+	#if( configUSE_TIMER_WHEEL == 1 )
+	{
+		pxNextTimer = prvWheelGetNextTimer( pxDaemon );
+		*pxListWasEmpty = ( pxNextTimer == NULL ) ? pdTRUE : pdFALSE;
+	}
+	#else
+	{
+		*pxListWasEmpty = listLIST_IS_EMPTY( pxDaemon->pxCurrentTimerList );
+	}
+	#endif
+	if( *pxListWasEmpty == pdFALSE )
+	{
+		#if( configUSE_TIMER_WHEEL == 1 )
+		{
+			xNextExpireTime = listGET_LIST_ITEM_VALUE( &( pxNextTimer->xTimerListItem ) );
+		}
+		#else
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDaemon->pxCurrentTimerList );
+		}
+		#endif
+	}
+	else
+	{
+		/* Ensure the task unblocks when the tick count rolls over. */
+		xNextExpireTime = ( TickType_t ) 0U;
+	}
+
+	return xNextExpireTime;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_SLACK == 1 )
+
+	static TickType_t prvGetTimerDeadline( const Timer_t * const pxTimer, const TickType_t xExpiryTime )
+	{
+	TickType_t xDeadline;
+
+		/* A timer of the current list is due before the tick count overflows,
+		so do not sleep past the overflow either. */
+		if( pxTimer->xTimerSlack > ( ( TickType_t ) portMAX_DELAY - xExpiryTime ) )
+		{
+			xDeadline = ( TickType_t ) portMAX_DELAY;
+		}
+		else
+		{
+			xDeadline = xExpiryTime + pxTimer->xTimerSlack;
+		}
+
+		return xDeadline;
+	}
+	/*-----------------------------------------------------------*/
+
+	static TickType_t prvGetCoalescedWakeTime( TimerDaemon_t * const pxDaemon, const TickType_t xNextExpireTime )
+	{
+	TickType_t xWakeTime = ( TickType_t ) portMAX_DELAY;
+	TickType_t xExpiryTime;
+	TickType_t xDeadline;
+	const Timer_t *pxTimer;
+	const ListItem_t *pxItem;
+	const ListItem_t *pxEndMarker;
+
+		#if( configUSE_TIMER_WHEEL == 1 )
+		{
+		const List_t *pxSlot;
+		TickType_t xTick = xNextExpireTime;
+		UBaseType_t uxSlot;
+		const uint8_t ucEraBit = ( pxDaemon->ucCurrentTimerEra != ( uint8_t ) 0 ) ? tmrSTATUS_WHEEL_ERA : ( uint8_t ) 0;
+
+			/* Visit the slots of the ticks from the next expiry time up to the
+			wake time found so far, which can only move closer, at most one
+			revolution of the wheel.  After a whole revolution every timer has
+			been seen, hence the test on the expiry time rather than on the
+			tick. */
+			for( uxSlot = ( UBaseType_t ) 0; ( uxSlot < ( UBaseType_t ) configTIMER_WHEEL_SLOTS ) && ( xTick < xWakeTime ); uxSlot++ )
+			{
+				pxSlot = &( pxDaemon->xTimerWheel[ xTick & tmrWHEEL_SLOT_MASK ] );
+				pxEndMarker = listGET_END_MARKER( pxSlot );
+
+				for( pxItem = listGET_HEAD_ENTRY( pxSlot ); pxItem != pxEndMarker; pxItem = listGET_NEXT( pxItem ) )
+				{
+					pxTimer = ( const Timer_t * ) listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+					xExpiryTime = listGET_LIST_ITEM_VALUE( pxItem );
+
+					if( ( ( pxTimer->ucStatus & tmrSTATUS_WHEEL_ERA ) == ucEraBit ) && ( xExpiryTime < xWakeTime ) )
+					{
+						xDeadline = prvGetTimerDeadline( pxTimer, xExpiryTime );
+
+						if( xDeadline < xWakeTime )
+						{
+							xWakeTime = xDeadline;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+				}
+
+				xTick++;
+			}
+		}
+		#else
+		{
+			/* The list is sorted by expiry time, so the walk can stop at the
+			first timer that expires after the wake time found so far. */
+			pxEndMarker = listGET_END_MARKER( pxDaemon->pxCurrentTimerList );
+
+			for( pxItem = listGET_HEAD_ENTRY( pxDaemon->pxCurrentTimerList ); pxItem != pxEndMarker; pxItem = listGET_NEXT( pxItem ) )
+			{
+				xExpiryTime = listGET_LIST_ITEM_VALUE( pxItem );
+
+				if( xExpiryTime >= xWakeTime )
+				{
+					break;
+				}
+
+				pxTimer = ( const Timer_t * ) listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				xDeadline = prvGetTimerDeadline( pxTimer, xExpiryTime );
+
+				if( xDeadline < xWakeTime )
+				{
+					xWakeTime = xDeadline;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		#endif /* configUSE_TIMER_WHEEL */
+
+		/* The head timer itself is always seen. */
+		configASSERT( xWakeTime >= xNextExpireTime );
+
+		return xWakeTime;
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TIMER_SLACK */
+
+static TickType_t prvSampleTimeNow( TimerDaemon_t * const pxDaemon, BaseType_t * const pxTimerListsWereSwitched )
+{
+TickType_t xTimeNow;
+
+	xTimeNow = xTaskGetTickCount();
+
+	#if( configUSE_64_BIT_TICKS == 0 )
+	{
+		if( xTimeNow < pxDaemon->xLastTime )
+		{
+			prvSwitchTimerLists( pxDaemon );
+			*pxTimerListsWereSwitched = pdTRUE;
+		}
+		else
+		{
+			*pxTimerListsWereSwitched = pdFALSE;
+		}
+	}
+	#else
+	{
+		/* A 64-bit tick count never wraps. */
+		*pxTimerListsWereSwitched = pdFALSE;
+	}
+	#endif /* configUSE_64_BIT_TICKS */
+
+	pxDaemon->xLastTime = xTimeNow;
+
+	return xTimeNow;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvInsertTimerInActiveList( TimerDaemon_t * const pxDaemon, Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime )
+{
+BaseType_t xProcessTimerNow = pdFALSE;
+
+	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+	if( xNextExpiryTime <= xTimeNow )
+	{
+		/* Has the expiry time elapsed between the command to start/reset a
+		timer was issued, and the time the command was processed? */
+		if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		{
+			/* The time between a command being issued and the command being
+			processed actually exceeds the timers period.  */
+			xProcessTimerNow = pdTRUE;
+		}
+		else
+		{
+			#if( configUSE_TIMER_WHEEL == 1 )
+			{
+				prvWheelInsert( pxDaemon, pxTimer, pdTRUE );
+			}
+			#else
+			{
+				vListInsert( pxDaemon->pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			}
+			#endif
+		}
+	}
+	else
+	{
+		if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+		{
+			/* If, since the command was issued, the tick count has overflowed
+			but the expiry time has not, then the timer must have already passed
+			its expiry time and should be processed immediately. */
+			xProcessTimerNow = pdTRUE;
+		}
+		else
+		{
+			#if( configUSE_TIMER_WHEEL == 1 )
+			{
+				prvWheelInsert( pxDaemon, pxTimer, pdFALSE );
+			}
+			#else
+			{
+				vListInsert( pxDaemon->pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			}
+			#endif
+		}
+	}
+
+	return xProcessTimerNow;
+}
+/*-----------------------------------------------------------*/
+
+static void	prvProcessReceivedCommands( TimerDaemon_t * const pxDaemon )
+{
+DaemonTaskMessage_t xMessage;
+Timer_t *pxTimer;
+BaseType_t xTimerListsWereSwitched, xResult;
+TickType_t xTimeNow;
+
+	while( xQueueReceive( pxDaemon->xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+	{
+		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
+		{
+			/* Negative commands are pended function calls rather than timer
+			commands. */
+			if( xMessage.xMessageID < ( BaseType_t ) 0 )
+			{
+				const CallbackParameters_t * const pxCallback = &( xMessage.u.xCallbackParameters );
+
+				/* The timer uses the xCallbackParameters member to request a
+				callback be executed.  Check the callback is not NULL. */
+				configASSERT( pxCallback );
+
+				/* Call the function. */
+				#if( configUSE_TIMER_DAEMON_STATS == 1 )
+				{
+					const configRUN_TIME_COUNTER_TYPE xStartTime = tmrGET_CALLBACK_TIME();
+
+					pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
+					prvRecordCallbackTime( pxDaemon, xStartTime );
+				}
+				#else
+				{
+					pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
+				}
+				#endif
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* INCLUDE_xTimerPendFunctionCall */
+
+		/* Commands that are positive are timer commands rather than pended
+		function calls. */
+		if( xMessage.xMessageID >= ( BaseType_t ) 0 )
+		{
+			/* The messages uses the xTimerParameters member to work on a
+			software timer. */
+			pxTimer = xMessage.u.xTimerParameters.pxTimer;
+
+			if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+			{
+				/* The timer is in a list, remove it. */
+				#if( configUSE_TIMER_WHEEL == 1 )
+				{
+					prvWheelRemove( pxDaemon, pxTimer );
+				}
+				#else
+				{
+					( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				}
+				#endif
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
+
+			/* In this case the xTimerListsWereSwitched parameter is not used, but
+			it must be present in the function call.  prvSampleTimeNow() must be
+			called after the message is received from xTimerQueue so there is no
+			possibility of a higher priority task adding a message to the message
+			queue with a time that is ahead of the timer daemon task (because it
+			pre-empted the timer daemon task after the xTimeNow value was set). */
+			xTimeNow = prvSampleTimeNow( pxDaemon, &xTimerListsWereSwitched );
+
+			switch( xMessage.xMessageID )
+			{
+				case tmrCOMMAND_START :
+				case tmrCOMMAND_START_FROM_ISR :
+				case tmrCOMMAND_RESET :
+				case tmrCOMMAND_RESET_FROM_ISR :
+				case tmrCOMMAND_START_DONT_TRACE :
+					/* Start or restart a timer. */
+					pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+					if( prvInsertTimerInActiveList( pxDaemon, pxTimer,  xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
+					{
+						/* The timer expired before it was added to the active
+						timer list.  Process it now. */
+						prvCallTimerCallback( pxDaemon, pxTimer );
+						traceTIMER_EXPIRED( pxTimer );
+
+						if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+						{
+							xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
+							configASSERT( xResult );
+							( void ) xResult;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+					break;
+
+				case tmrCOMMAND_STOP :
+				case tmrCOMMAND_STOP_FROM_ISR :
+					/* The timer has already been removed from the active list. */
+					pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+					break;
+
+				case tmrCOMMAND_CHANGE_PERIOD :
+				case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
+					pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+					pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
+					configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+					/* The new period does not really have a reference, and can
+					be longer or shorter than the old one.  The command time is
+					therefore set to the current time, and as the period cannot
+					be zero the next expiry time can only be in the future,
+					meaning (unlike for the xTimerStart() case above) there is
+					no fail case that needs to be handled here. */
+					( void ) prvInsertTimerInActiveList( pxDaemon, pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+					break;
+
+				case tmrCOMMAND_DELETE :
+					#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+					{
+						/* The timer has already been removed from the active list,
+						just free up the memory if the memory was dynamically
+						allocated. */
+						if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+						{
+							vPortFree( pxTimer );
+						}
+						else
+						{
+							pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+						}
+					}
+					#else
+					{
+						/* If dynamic allocation is not enabled, the memory
+						could not have been dynamically allocated. So there is
+						no need to free the memory - just mark the timer as
+						"not active". */
+						pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+					}
+					#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+					break;
+
+				default	:
+					/* Don't expect to get here. */
+					break;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_64_BIT_TICKS == 0 )
+
+	static void prvSwitchTimerLists( TimerDaemon_t * const pxDaemon )
+	{
+	TickType_t xNextExpireTime, xReloadTime;
+	#if( configUSE_TIMER_WHEEL == 0 )
+		List_t *pxTemp;
+	#endif
+	Timer_t *pxTimer;
+	BaseType_t xResult;
+
+		/* The tick count has overflowed.  The timer lists must be switched.
+		If there are any timers still referenced from the current timer list
+		then they must have expired and should be processed before the lists
+		are switched. */
+		#if( configUSE_TIMER_WHEEL == 1 )
+		while( ( pxTimer = prvWheelGetNextTimer( pxDaemon ) ) != NULL )
+		{
+			xNextExpireTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+
+			/* Remove the timer from the wheel. */
+			prvWheelRemove( pxDaemon, pxTimer );
+		#else
+		while( listLIST_IS_EMPTY( pxDaemon->pxCurrentTimerList ) == pdFALSE )
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDaemon->pxCurrentTimerList );
+
+			/* Remove the timer from the list. */
+			pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDaemon->pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+		#endif
+			traceTIMER_EXPIRED( pxTimer );
+
+			/* Execute its callback, then send a command to restart the timer if
+			it is an auto-reload timer.  It cannot be restarted here as the lists
+			have not yet been switched. */
+			prvCallTimerCallback( pxDaemon, pxTimer );
+
+			if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+			{
+				/* Calculate the reload value, and if the reload value results in
+				the timer going into the same timer list then it has already expired
+				and the timer should be re-inserted into the current list so it is
+				processed again within this loop.  Otherwise a command should be sent
+				to restart the timer to ensure it is only inserted into a list after
+				the lists have been swapped. */
+				xReloadTime = ( xNextExpireTime + pxTimer->xTimerPeriodInTicks );
+				if( xReloadTime > xNextExpireTime )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
+					listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+					#if( configUSE_TIMER_WHEEL == 1 )
+					{
+						prvWheelInsert( pxDaemon, pxTimer, pdFALSE );
+					}
+					#else
+					{
+						vListInsert( pxDaemon->pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+					}
+					#endif
+				}
+				else
+				{
+					xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
+					configASSERT( xResult );
+					( void ) xResult;
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		#if( configUSE_TIMER_WHEEL == 1 )
+		{
+			/* The overflow era becomes the current era, which starts at tick 0. */
+			pxDaemon->ucCurrentTimerEra ^= 1U;
+			pxDaemon->xTimerWheelCursor = ( TickType_t ) 0U;
+		}
+		#else
+		{
+			pxTemp = pxDaemon->pxCurrentTimerList;
+			pxDaemon->pxCurrentTimerList = pxDaemon->pxOverflowTimerList;
+			pxDaemon->pxOverflowTimerList = pxTemp;
+		}
+		#endif
+	}
+
+#endif /* configUSE_64_BIT_TICKS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	static void prvWheelInsert( TimerDaemon_t * const pxDaemon, Timer_t * const pxTimer, const BaseType_t xInOverflowEra )
+	{
+	const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+	const uint8_t ucEra = ( xInOverflowEra != pdFALSE ) ? ( uint8_t ) ( pxDaemon->ucCurrentTimerEra ^ 1U ) : pxDaemon->ucCurrentTimerEra;
+
+		if( ucEra != ( uint8_t ) 0 )
+		{
+			pxTimer->ucStatus |= tmrSTATUS_WHEEL_ERA;
+		}
+		else
+		{
+			pxTimer->ucStatus &= ~tmrSTATUS_WHEEL_ERA;
+		}
+
+		/* Keep the cursor at or before the earliest timer of the current
+		era. */
+		if( ucEra == pxDaemon->ucCurrentTimerEra )
+		{
+			if( ( pxDaemon->uxTimersInEra[ ucEra ] == ( UBaseType_t ) 0 ) || ( xExpiryTime < pxDaemon->xTimerWheelCursor ) )
+			{
+				pxDaemon->xTimerWheelCursor = xExpiryTime;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Slots are not sorted.  Inserting at the end keeps timers that
+		expire on the same tick in the order they were started, as
+		vListInsert() does. */
+		vListInsertEnd( &( pxDaemon->xTimerWheel[ xExpiryTime & tmrWHEEL_SLOT_MASK ] ), &( pxTimer->xTimerListItem ) );
+		( pxDaemon->uxTimersInEra[ ucEra ] )++;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvWheelRemove( TimerDaemon_t * const pxDaemon, Timer_t * const pxTimer )
+	{
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+		if( ( pxTimer->ucStatus & tmrSTATUS_WHEEL_ERA ) != ( uint8_t ) 0 )
+		{
+			( pxDaemon->uxTimersInEra[ 1 ] )--;
+		}
+		else
+		{
+			( pxDaemon->uxTimersInEra[ 0 ] )--;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static Timer_t *prvWheelGetNextTimer( TimerDaemon_t * const pxDaemon )
+	{
+	Timer_t *pxTimer;
+	Timer_t *pxNextTimer = NULL;
+	const List_t *pxSlot;
+	const ListItem_t *pxItem;
+	const ListItem_t *pxEndMarker;
+	TickType_t xTick;
+	UBaseType_t uxSlot;
+	const uint8_t ucEraBit = ( pxDaemon->ucCurrentTimerEra != ( uint8_t ) 0 ) ? tmrSTATUS_WHEEL_ERA : ( uint8_t ) 0;
+
+		if( pxDaemon->uxTimersInEra[ pxDaemon->ucCurrentTimerEra ] != ( UBaseType_t ) 0 )
+		{
+			/* Visit the slots one tick at a time from the cursor.  The first
+			timer of the current era found with an expiry time equal to the
+			tick being visited is the next to expire.  Timers of the current
+			era never expire after portMAX_DELAY, so the walk stops there. */
+			xTick = pxDaemon->xTimerWheelCursor;
+
+			for( uxSlot = ( UBaseType_t ) 0; uxSlot < ( UBaseType_t ) configTIMER_WHEEL_SLOTS; uxSlot++ )
+			{
+				pxSlot = &( pxDaemon->xTimerWheel[ xTick & tmrWHEEL_SLOT_MASK ] );
+				pxEndMarker = listGET_END_MARKER( pxSlot );
+
+				for( pxItem = listGET_HEAD_ENTRY( pxSlot ); pxItem != pxEndMarker; pxItem = listGET_NEXT( pxItem ) )
+				{
+					pxTimer = ( Timer_t * ) listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+					if( ( ( pxTimer->ucStatus & tmrSTATUS_WHEEL_ERA ) == ucEraBit ) && ( listGET_LIST_ITEM_VALUE( pxItem ) == xTick ) )
+					{
+						pxNextTimer = pxTimer;
+						break;
+					}
+				}
+
+				if( ( pxNextTimer != NULL ) || ( xTick == portMAX_DELAY ) )
+				{
+					break;
+				}
+
+				xTick++;
+			}
+
+			if( pxNextTimer == NULL )
+			{
+				/* No timer expires within one revolution of the wheel, so look
+				for the earliest expiry time among all the timers of the
+				current era.  The cursor then points at it, so this only
+				happens once per such timer. */
+				for( uxSlot = ( UBaseType_t ) 0; uxSlot < ( UBaseType_t ) configTIMER_WHEEL_SLOTS; uxSlot++ )
+				{
+					pxSlot = &( pxDaemon->xTimerWheel[ uxSlot ] );
+					pxEndMarker = listGET_END_MARKER( pxSlot );
+
+					for( pxItem = listGET_HEAD_ENTRY( pxSlot ); pxItem != pxEndMarker; pxItem = listGET_NEXT( pxItem ) )
+					{
+						pxTimer = ( Timer_t * ) listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+						if( ( pxTimer->ucStatus & tmrSTATUS_WHEEL_ERA ) == ucEraBit )
+						{
+							if( ( pxNextTimer == NULL ) || ( listGET_LIST_ITEM_VALUE( pxItem ) < listGET_LIST_ITEM_VALUE( &( pxNextTimer->xTimerListItem ) ) ) )
+							{
+								pxNextTimer = pxTimer;
+							}
+						}
+					}
+				}
+			}
+
+			configASSERT( pxNextTimer );
+			pxDaemon->xTimerWheelCursor = listGET_LIST_ITEM_VALUE( &( pxNextTimer->xTimerListItem ) );
+		}
+
+		return pxNextTimer;
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TIMER_WHEEL */
+
+static void prvCheckForValidListAndQueue( void )
+{
+TimerDaemon_t *pxDaemon;
+UBaseType_t uxDaemon;
+
+	/* Check that the lists from which active timers are referenced, and the
+	queues used to communicate with the timer service tasks, have been
+	initialised. */
+	taskENTER_CRITICAL();
+	{
+		if( xTimerDaemonsInitialised == pdFALSE )
+		{
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+				/* The timer queues are allocated statically in case
+				configSUPPORT_DYNAMIC_ALLOCATION is 0. */
+				static StaticQueue_t xStaticTimerQueues[ configTIMER_DAEMONS ]; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+				static uint8_t ucStaticTimerQueueStorage[ configTIMER_DAEMONS ][ ( size_t ) configTIMER_QUEUE_LENGTH * sizeof( DaemonTaskMessage_t ) ]; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+			#endif
+
+			for( uxDaemon = ( UBaseType_t ) 0; uxDaemon < ( UBaseType_t ) configTIMER_DAEMONS; uxDaemon++ )
+			{
+				pxDaemon = &( xTimerDaemons[ uxDaemon ] );
+
+				#if( configUSE_TIMER_WHEEL == 1 )
+				{
+				UBaseType_t uxSlot;
+
+					for( uxSlot = ( UBaseType_t ) 0; uxSlot < ( UBaseType_t ) configTIMER_WHEEL_SLOTS; uxSlot++ )
+					{
+						vListInitialise( &( pxDaemon->xTimerWheel[ uxSlot ] ) );
+					}
+
+					pxDaemon->uxTimersInEra[ 0 ] = ( UBaseType_t ) 0;
+					pxDaemon->uxTimersInEra[ 1 ] = ( UBaseType_t ) 0;
+					pxDaemon->ucCurrentTimerEra = ( uint8_t ) 0;
+					pxDaemon->xTimerWheelCursor = ( TickType_t ) 0U;
+				}
+				#else
+				{
+					vListInitialise( &( pxDaemon->xActiveTimerList1 ) );
+					vListInitialise( &( pxDaemon->xActiveTimerList2 ) );
+					pxDaemon->pxCurrentTimerList = &( pxDaemon->xActiveTimerList1 );
+					pxDaemon->pxOverflowTimerList = &( pxDaemon->xActiveTimerList2 );
+				}
+				#endif
+
+				pxDaemon->xTimerTaskHandle = NULL;
+				pxDaemon->xLastTime = ( TickType_t ) 0U;
+
+				#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+				{
+					pxDaemon->xTimerQueue = xQueueCreateStatic( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ), &( ucStaticTimerQueueStorage[ uxDaemon ][ 0 ] ), &( xStaticTimerQueues[ uxDaemon ] ) );
+				}
+				#else
+				{
+					pxDaemon->xTimerQueue = xQueueCreate( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, sizeof( DaemonTaskMessage_t ) );
+				}
+				#endif
+
+				#if ( configQUEUE_REGISTRY_SIZE > 0 )
+				{
+					if( pxDaemon->xTimerQueue != NULL )
+					{
+						vQueueAddToRegistry( pxDaemon->xTimerQueue, "TmrQ" );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configQUEUE_REGISTRY_SIZE */
+			}
+
+			xTimerDaemonsInitialised = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerIsTimerActive( TimerHandle_t xTimer )
+{
+BaseType_t xReturn;
+Timer_t *pxTimer = xTimer;
+
+	configASSERT( xTimer );
+
+	/* Is the timer in the list of active timers? */
+	taskENTER_CRITICAL();
+	{
+		if( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) == 0 )
+		{
+			xReturn = pdFALSE;
+		}
+		else
+		{
+			xReturn = pdTRUE;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+} /*lint !e818 Can't be pointer to const due to the typedef. */
+/*-----------------------------------------------------------*/
+
+void *pvTimerGetTimerID( const TimerHandle_t xTimer )
+{
+Timer_t * const pxTimer = xTimer;
+void *pvReturn;
+
+	configASSERT( xTimer );
+
+	taskENTER_CRITICAL();
+	{
+		pvReturn = pxTimer->pvTimerID;
+	}
+	taskEXIT_CRITICAL();
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTimerSetTimerID( TimerHandle_t xTimer, void *pvNewID )
+{
+Timer_t * const pxTimer = xTimer;
+
+	configASSERT( xTimer );
+
+	taskENTER_CRITICAL();
+	{
+		pxTimer->pvTimerID = pvNewID;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+#if( INCLUDE_xTimerPendFunctionCall == 1 )
+
+	BaseType_t xTimerPendFunctionCallFromISR( PendedFunction_t xFunctionToPend, void *pvParameter1, uint32_t ulParameter2, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	DaemonTaskMessage_t xMessage;
+	BaseType_t xReturn;
+
+		/* Complete the message with the function parameters and post it to the
+		daemon task. */
+		xMessage.xMessageID = tmrCOMMAND_EXECUTE_CALLBACK_FROM_ISR;
+		xMessage.u.xCallbackParameters.pxCallbackFunction = xFunctionToPend;
+		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
+		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
+
+		xReturn = xQueueSendFromISR( xTimerDaemons[ 0 ].xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+
+		tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
+
+		return xReturn;
+	}
+
+#endif /* INCLUDE_xTimerPendFunctionCall */
+/*-----------------------------------------------------------*/
+
+#if( INCLUDE_xTimerPendFunctionCall == 1 )
+
+	BaseType_t xTimerPendFunctionCall( PendedFunction_t xFunctionToPend, void *pvParameter1, uint32_t ulParameter2, TickType_t xTicksToWait )
+	{
+	DaemonTaskMessage_t xMessage;
+	BaseType_t xReturn;
+
+		/* This function can only be called after a timer has been created or
+		after the scheduler has been started because, until then, the timer
+		queue does not exist. */
+		configASSERT( xTimerDaemons[ 0 ].xTimerQueue );
+
+		/* Complete the message with the function parameters and post it to the
+		daemon task. */
+		xMessage.xMessageID = tmrCOMMAND_EXECUTE_CALLBACK;
+		xMessage.u.xCallbackParameters.pxCallbackFunction = xFunctionToPend;
+		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
+		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
+
+		xReturn = xQueueSendToBack( xTimerDaemons[ 0 ].xTimerQueue, &xMessage, xTicksToWait );
+
+		tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
+
+		return xReturn;
+	}
+
+#endif /* INCLUDE_xTimerPendFunctionCall */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	UBaseType_t uxTimerGetTimerNumber( TimerHandle_t xTimer )
+	{
+		return ( ( Timer_t * ) xTimer )->uxTimerNumber;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	void vTimerSetTimerNumber( TimerHandle_t xTimer, UBaseType_t uxTimerNumber )
+	{
+		( ( Timer_t * ) xTimer )->uxTimerNumber = uxTimerNumber;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include software timer functionality.  If you want to include software timer
+functionality then ensure configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_TIMERS == 1 */
+
+
+
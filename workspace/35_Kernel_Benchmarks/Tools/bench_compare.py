@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""Compares two runs of the kernel benchmarks and flags the rows that slowed down.
+
+Both inputs are the CSV printed by the firmware or by the host build
+(Host/Makefile), one row per benchmark and clock:
+
+    cpu_mhz,benchmark,samples,min,avg,p99,max
+    1000,queue_ping_pong,10000,692,750,1026,18180
+
+Rows are matched on cpu_mhz and benchmark. For each one the tool prints the
+chosen column of both runs, the operations per second it stands for
+(cpu_mhz * 10^6 / value) and the change. A row is a regression when it is more
+than --threshold slower. The default column is min: on a host, avg and max
+also count the time other processes took, while an O(n) list walk raises all
+of them.
+
+Rows named <family>_<N>, such as timer_reset_list_1000, are also reported as
+a family: the growth from the smallest N to the largest, in both runs. A flat
+family is O(1); one growing with N walks something.
+
+Usage:
+    bench_compare.py baseline.csv current.csv
+    bench_compare.py --column avg --threshold 0.1 board_before.log board_after.log
+
+Exits with 1 if any row regressed, so it can gate a build.
+"""
+
+import argparse
+import re
+import sys
+
+COLUMNS = {"min": 3, "avg": 4, "p99": 5, "max": 6}
+FAMILY = re.compile(r"^(.*)_(\d+)$")
+
+
+def read_rows(path, column):
+    rows = {}
+    with (sys.stdin if path == "-" else open(path, errors="replace")) as lines:
+        for line in lines:
+            columns = line.strip().split(",")
+            if len(columns) != 7 or not columns[0].isdigit():
+                continue
+            rows[(int(columns[0]), columns[1])] = int(columns[COLUMNS[column]])
+    return rows
+
+
+def families(rows):
+    """Groups (cpu_mhz, family) -> sorted [(N, value)]."""
+    groups = {}
+    for (cpu_mhz, name), value in rows.items():
+        match = FAMILY.match(name)
+        if match:
+            groups.setdefault((cpu_mhz, match.group(1)), []).append((int(match.group(2)), value))
+    return {key: sorted(points) for key, points in groups.items() if len(points) > 1}
+
+
+def growth(points):
+    return points[-1][1] / points[0][1] if points[0][1] else float("inf")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline", help="CSV or console log of the reference run")
+    parser.add_argument("current", help="CSV or console log of the run to check, or -")
+    parser.add_argument("--column", choices=sorted(COLUMNS), default="min")
+    parser.add_argument("--threshold", type=float, default=0.25,
+                        help="slowdown counted as a regression (default 0.25, i.e. 25%%)")
+    options = parser.parse_args()
+
+    baseline = read_rows(options.baseline, options.column)
+    current = read_rows(options.current, options.column)
+    regressions = 0
+
+    print("%7s %-32s %10s %10s %12s %8s" % (
+        "cpu_mhz", "benchmark", "baseline", "current", "ops/s", "change"))
+    for key in sorted(current):
+        cpu_mhz, name = key
+        value = current[key]
+        ops = ("%12.0f" % (cpu_mhz * 1e6 / value)) if value else "%12s" % "-"
+        if key not in baseline:
+            print("%7d %-32s %10s %10d %s %8s" % (cpu_mhz, name, "-", value, ops, "new"))
+            continue
+        reference = baseline[key]
+        change = (value - reference) / reference if reference else 0.0
+        flag = ""
+        if change > options.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print("%7d %-32s %10d %10d %s %+7.1f%%%s" % (
+            cpu_mhz, name, reference, value, ops, 100.0 * change, flag))
+
+    for key in sorted(set(baseline) - set(current)):
+        print("%7d %-32s %10d %10s %12s %8s" % (key[0], key[1], baseline[key], "-", "-", "missing"))
+
+    baseline_families = families(baseline)
+    current_families = families(current)
+    if current_families:
+        print()
+        print("%7s %-32s %10s %10s" % ("cpu_mhz", "family (smallest to largest N)", "baseline", "current"))
+        for key in sorted(current_families):
+            points = current_families[key]
+            reference = baseline_families.get(key)
+            label = "%s_%d..%d" % (key[1], points[0][0], points[-1][0])
+            print("%7d %-32s %10s %9.2fx" % (
+                key[0], label, "-" if reference is None else "%9.2fx" % growth(reference),
+                growth(points)))
+
+    print()
+    print("%d regression(s) over %.0f%% in %s" % (regressions, 100.0 * options.threshold, options.column))
+    sys.exit(1 if regressions else 0)
+
+
+if __name__ == "__main__":
+    main()
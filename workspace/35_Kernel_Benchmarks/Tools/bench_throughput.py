@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""Turns the capture rows of the kernel benchmarks into throughput and CPU load.
+
+For each capture, the firmware prints a row of cycles between block
+hand-offs (<name>_block), a row of cycles spent processing a block
+(<name>_process), and a comment with the nominal rate:
+
+    84,adc_interleaved_block,1000,81672,81920,81920,82301
+    84,adc_interleaved_process,1000,20511,20514,20514,20519
+    # adc_interleaved rate_hz=4200000 block_samples=4096 overruns=0
+
+The measured rate is block_samples * cpu_mhz / avg. It should equal the
+nominal rate: a lower one means samples were lost. The load is the share of a
+block interval the task spends processing it.
+
+Usage:
+    bench_throughput.py /dev/ttyACM0
+    bench_throughput.py console.log
+
+A serial port is opened with pyserial when it is installed; otherwise set it
+up beforehand (e.g. 'stty -F /dev/ttyACM0 115200 raw') and pass its path.
+Reading stops at the "# done" line.
+"""
+
+import argparse
+import sys
+
+BLOCK_SUFFIX = "_block"
+PROCESS_SUFFIX = "_process"
+
+
+def open_input(path, baudrate):
+    if path == "-":
+        return sys.stdin
+    try:
+        import serial
+        if path.startswith(("/dev/", "COM")):
+            port = serial.Serial(path, baudrate)
+            return (line.decode(errors="replace") for line in port)
+    except ImportError:
+        pass
+    return open(path, errors="replace")
+
+
+class Captures:
+    def __init__(self):
+        self.rows = {}        # (cpu_mhz, benchmark) -> (samples, min, avg, max)
+        self.results = []     # (cpu_mhz, name, {key: value})
+        self.cpu_mhz = None
+
+    def line(self, line):
+        """Parses one console line; returns True at the end of the run."""
+        line = line.strip()
+        if line.startswith("#"):
+            fields = line[1:].split()
+            if fields == ["done"]:
+                return True
+            values = dict(field.split("=", 1) for field in fields[1:] if "=" in field)
+            if fields and "rate_hz" in values and "block_samples" in values \
+                    and self.cpu_mhz is not None:
+                self.results.append((self.cpu_mhz, fields[0],
+                                     {key: int(value) for key, value in values.items()}))
+            return False
+
+        columns = line.split(",")
+        if len(columns) != 7 or not columns[0].isdigit():
+            return False
+        cpu_mhz, benchmark = int(columns[0]), columns[1]
+        samples, minimum, average, _, maximum = (int(column) for column in columns[2:])
+        self.rows[(cpu_mhz, benchmark)] = (samples, minimum, average, maximum)
+        self.cpu_mhz = cpu_mhz
+        return False
+
+    def report(self):
+        if not self.results:
+            print("no captures found")
+            return
+
+        print("%7s %-20s %10s %10s %10s %7s %6s %9s" % (
+            "cpu_mhz", "capture", "nominal", "measured", "worst", "ratio", "load", "overruns"))
+        for cpu_mhz, name, values in self.results:
+            block = self.rows.get((cpu_mhz, name + BLOCK_SUFFIX))
+            process = self.rows.get((cpu_mhz, name + PROCESS_SUFFIX))
+            if block is None or block[2] == 0:
+                print("%7d %-20s no block row" % (cpu_mhz, name))
+                continue
+
+            cycles_per_second = cpu_mhz * 1e6
+            samples = values["block_samples"]
+            measured = samples * cycles_per_second / block[2]
+            worst = samples * cycles_per_second / block[3]
+            load = "-" if process is None else "%5.1f%%" % (100.0 * process[2] / block[2])
+            print("%7d %-20s %10.0f %10.0f %10.0f %7.4f %6s %9d" % (
+                cpu_mhz, name, values["rate_hz"], measured, worst,
+                measured / values["rate_hz"], load, values.get("overruns", 0)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="serial port, console log, or - for stdin")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    options = parser.parse_args()
+
+    captures = Captures()
+    try:
+        for line in open_input(options.input, options.baudrate):
+            if captures.line(line):
+                break
+    except KeyboardInterrupt:
+        pass
+    captures.report()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""Lines up the allocator benchmarks of several builds, trace by trace.
+
+Each input is the output of one build, from the firmware or from the host
+(Host/Makefile, 'make heap'). Core/Src/heap_bench.c prints, per build and
+clock:
+
+    # heap allocator=heap_4 slabs=0 regions=0 arena=8192 ops=20000
+    cpu_mhz,benchmark,samples,min,avg,p99,max          (heap_<trace>_malloc/_free)
+    # heap_frag,<trace>,<op>,<free>,<largest_free>,<free_blocks>,<frag_pct>
+    # heap_trace,<trace>,mallocs=..,failed=..,peak_live=..,largest_min=..,frag_peak=..
+
+For each trace the tool prints one line per build: the min, avg, p99 and max
+of pvPortMalloc() and vPortFree() (cycles, or nanoseconds on the host), the
+failed allocations, the peak fragmentation, and the largest free block at the
+start, at its smallest and at the end of the trace. A largest free block that
+keeps shrinking while the live bytes do not grow is fragmentation building
+up; the worst case columns are what a deadline has to budget for.
+
+With --series, the largest free block of every sample is printed too, one
+column per build, to plot its decay over the trace.
+
+Usage:
+    heap_bench_report.py build/heap/*.csv
+    heap_bench_report.py --series board_heap_4.log board_tlsf.log
+"""
+
+import argparse
+import re
+import sys
+
+HEADER = re.compile(r"^# heap allocator=(\S+)")
+ROW = re.compile(r"^(\d+),heap_(.+)_(malloc|free),(\d+),(\d+),(\d+),(\d+),(\d+)$")
+
+
+def read_runs(path):
+    """Returns [(label, cpu_mhz, {trace: {...}})], one entry per header line."""
+    runs = []
+    run = None
+    with (sys.stdin if path == "-" else open(path, errors="replace")) as lines:
+        for line in lines:
+            line = line.strip()
+            match = HEADER.match(line)
+            if match:
+                run = {"label": match.group(1), "cpu_mhz": None, "traces": {}}
+                runs.append(run)
+                continue
+            if run is None:
+                continue
+            match = ROW.match(line)
+            if match:
+                run["cpu_mhz"] = int(match.group(1))
+                trace = run["traces"].setdefault(match.group(2), {"samples": []})
+                trace[match.group(3)] = [int(value) for value in match.group(5, 6, 7, 8)]
+                continue
+            if line.startswith("# heap_frag,"):
+                columns = line[2:].split(",")
+                trace = run["traces"].setdefault(columns[1], {"samples": []})
+                trace["samples"].append((int(columns[2]), int(columns[4]), float(columns[6])))
+            elif line.startswith("# heap_trace,"):
+                columns = line[2:].split(",")
+                trace = run["traces"].setdefault(columns[1], {"samples": []})
+                trace.update(dict(field.split("=", 1) for field in columns[2:]))
+    return runs
+
+
+def label_runs(paths):
+    """Reads every input; adds the clock to the label when a file holds several."""
+    labelled = []
+    for path in paths:
+        runs = read_runs(path)
+        clocks = {run["cpu_mhz"] for run in runs}
+        for run in runs:
+            label = run["label"]
+            if len(clocks) > 1:
+                label += "@%dMHz" % run["cpu_mhz"]
+            labelled.append((label, run))
+    return labelled
+
+
+def timing(values):
+    return "%6s %6s %6s %7s" % tuple(values) if values else "%6s %6s %6s %7s" % ("-",) * 4
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("inputs", nargs="+", help="CSV or console log of one build each, or -")
+    parser.add_argument("--series", action="store_true",
+                        help="also print the largest free block of every sample")
+    options = parser.parse_args()
+
+    runs = label_runs(options.inputs)
+    if not runs:
+        sys.exit("no '# heap allocator=' line in the inputs")
+
+    traces = []
+    for _, run in runs:
+        for name in run["traces"]:
+            if name not in traces:
+                traces.append(name)
+
+    units = {run["cpu_mhz"] for _, run in runs}
+    print("times in %s" % ("ns" if units == {1000} else "cycles"))
+
+    for name in traces:
+        print()
+        print("%s" % name)
+        print("  %-20s %-28s %-28s %6s %9s %21s" % (
+            "allocator", "malloc min/avg/p99/max", "free min/avg/p99/max",
+            "failed", "frag_peak", "largest start/min/end"))
+        for label, run in runs:
+            trace = run["traces"].get(name)
+            if trace is None:
+                continue
+            samples = trace["samples"]
+            largest = "%6d %6d %7d" % (samples[0][1], min(s[1] for s in samples), samples[-1][1]) \
+                if samples else "%21s" % "-"
+            print("  %-20s %-28s %-28s %6s %8s%% %s" % (
+                label, timing(trace.get("malloc")), timing(trace.get("free")),
+                trace.get("failed", "-"), trace.get("frag_peak", "-"), largest))
+
+        if options.series:
+            columns = [(label, run["traces"].get(name, {}).get("samples", [])) for label, run in runs]
+            print()
+            print("  %8s %s" % ("op", " ".join("%14s" % label[:14] for label, _ in columns)))
+            for index in range(max(len(samples) for _, samples in columns)):
+                op = next(samples[index][0] for _, samples in columns if index < len(samples))
+                print("  %8d %s" % (op, " ".join(
+                    "%14d" % samples[index][1] if index < len(samples) else "%14s" % "-"
+                    for _, samples in columns)))
+
+
+if __name__ == "__main__":
+    main()